@@ -139,6 +139,54 @@ if(CASS_USE_ZLIB)
   endif()
 endif()
 
+#------------------------
+# LZ4
+#------------------------
+
+if(CASS_USE_LZ4)
+  if(NOT LZ4_ROOT_DIR)
+    if(EXISTS "${PROJECT_SOURCE_DIR}/lib/lz4/")
+      set(LZ4_ROOT_DIR "${PROJECT_SOURCE_DIR}/lib/lz4/")
+    elseif(EXISTS "${PROJECT_SOURCE_DIR}/build/libs/lz4/")
+      set(LZ4_ROOT_DIR "${PROJECT_SOURCE_DIR}/build/libs/lz4/")
+    endif()
+  endif()
+
+  # Ensure lz4 was found (assign lz4 include/libraries or present warning)
+  find_package(LZ4)
+  if(LZ4_FOUND)
+    set(CASS_INCLUDES ${CASS_INCLUDES} ${LZ4_INCLUDE_DIRS})
+    set(CASS_LIBS ${CASS_LIBS} ${LZ4_LIBRARIES})
+    set(HAVE_LZ4 On)
+  else()
+    message(WARNING "lz4 libraries will not be linked into build (LZ4 compression will be unavailable)")
+  endif()
+endif()
+
+#------------------------
+# Snappy
+#------------------------
+
+if(CASS_USE_SNAPPY)
+  if(NOT SNAPPY_ROOT_DIR)
+    if(EXISTS "${PROJECT_SOURCE_DIR}/lib/snappy/")
+      set(SNAPPY_ROOT_DIR "${PROJECT_SOURCE_DIR}/lib/snappy/")
+    elseif(EXISTS "${PROJECT_SOURCE_DIR}/build/libs/snappy/")
+      set(SNAPPY_ROOT_DIR "${PROJECT_SOURCE_DIR}/build/libs/snappy/")
+    endif()
+  endif()
+
+  # Ensure snappy was found (assign snappy include/libraries or present warning)
+  find_package(Snappy)
+  if(SNAPPY_FOUND)
+    set(CASS_INCLUDES ${CASS_INCLUDES} ${SNAPPY_INCLUDE_DIRS})
+    set(CASS_LIBS ${CASS_LIBS} ${SNAPPY_LIBRARIES})
+    set(HAVE_SNAPPY On)
+  else()
+    message(WARNING "snappy libraries will not be linked into build (Snappy compression will be unavailable)")
+  endif()
+endif()
+
 #------------------------
 # Kerberos
 #------------------------
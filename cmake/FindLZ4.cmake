@@ -0,0 +1,61 @@
+# Try to find the lz4 library; once done this will define:
+#
+# LZ4_FOUND         - True if lz4 was found, false otherwise.
+# LZ4_INCLUDE_DIRS  - Include directories needed to include lz4 headers.
+# LZ4_LIBRARIES     - Libraries needed to link to lz4.
+
+if(UNIX)
+  find_package(PkgConfig QUIET)
+  pkg_check_modules(_LZ4 QUIET lz4)
+endif()
+
+set(_LZ4_ROOT_HINTS ${LZ4_ROOT_DIR} $ENV{LZ4_ROOT_DIR})
+if(NOT WIN32)
+  set(_LZ4_ROOT_PATHS "/usr/"
+                      "/usr/local/")
+  if(_LZ4_FOUND)
+    set(_LZ4_ROOT_PATHS ${_LZ4_ROOT_PATHS}
+                        ${_LZ4_LIBDIR})
+  endif()
+endif()
+set(_LZ4_ROOT_HINTS_AND_PATHS
+    HINTS ${_LZ4_ROOT_HINTS}
+    PATHS ${_LZ4_ROOT_PATHS})
+
+find_path(LZ4_INCLUDE_DIR
+  NAMES lz4.h
+  ${_LZ4_ROOT_HINTS_AND_PATHS}
+  PATH_SUFFIXES include
+  NO_DEFAULT_PATH)
+
+if(CASS_USE_STATIC_LIBS)
+  set(_LZ4_ORIG_CMAKE_FIND_LIBRARY_SUFFIXES ${CMAKE_FIND_LIBRARY_SUFFIXES})
+  if(WIN32)
+    set(CMAKE_FIND_LIBRARY_SUFFIXES .lib .a ${CMAKE_FIND_LIBRARY_SUFFIXES})
+  else()
+    set(CMAKE_FIND_LIBRARY_SUFFIXES .a)
+  endif()
+endif()
+find_library(LZ4_LIBRARY
+  NAMES lz4 liblz4
+  ${_LZ4_ROOT_HINTS_AND_PATHS}
+  PATH_SUFFIXES lib lib/${CMAKE_LIBRARY_ARCHITECTURE}
+  NO_DEFAULT_PATH)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(LZ4
+  "Could NOT find lz4, try to set the path to lz4 root folder in the system variable LZ4_ROOT_DIR"
+  LZ4_LIBRARY
+  LZ4_INCLUDE_DIR)
+
+if(LZ4_FOUND)
+  set(LZ4_INCLUDE_DIRS ${LZ4_INCLUDE_DIR})
+  set(LZ4_LIBRARIES ${LZ4_LIBRARY})
+endif()
+mark_as_advanced(LZ4_INCLUDE_DIRS
+                 LZ4_LIBRARIES)
+
+# Restore the original find library ordering
+if(CASS_USE_STATIC_LIBS)
+  set(CMAKE_FIND_LIBRARY_SUFFIXES ${_LZ4_ORIG_CMAKE_FIND_LIBRARY_SUFFIXES})
+endif()
@@ -0,0 +1,61 @@
+# Try to find the snappy library; once done this will define:
+#
+# SNAPPY_FOUND         - True if snappy was found, false otherwise.
+# SNAPPY_INCLUDE_DIRS  - Include directories needed to include snappy headers.
+# SNAPPY_LIBRARIES     - Libraries needed to link to snappy.
+
+if(UNIX)
+  find_package(PkgConfig QUIET)
+  pkg_check_modules(_SNAPPY QUIET snappy)
+endif()
+
+set(_SNAPPY_ROOT_HINTS ${SNAPPY_ROOT_DIR} $ENV{SNAPPY_ROOT_DIR})
+if(NOT WIN32)
+  set(_SNAPPY_ROOT_PATHS "/usr/"
+                         "/usr/local/")
+  if(_SNAPPY_FOUND)
+    set(_SNAPPY_ROOT_PATHS ${_SNAPPY_ROOT_PATHS}
+                           ${_SNAPPY_LIBDIR})
+  endif()
+endif()
+set(_SNAPPY_ROOT_HINTS_AND_PATHS
+    HINTS ${_SNAPPY_ROOT_HINTS}
+    PATHS ${_SNAPPY_ROOT_PATHS})
+
+find_path(SNAPPY_INCLUDE_DIR
+  NAMES snappy-c.h
+  ${_SNAPPY_ROOT_HINTS_AND_PATHS}
+  PATH_SUFFIXES include
+  NO_DEFAULT_PATH)
+
+if(CASS_USE_STATIC_LIBS)
+  set(_SNAPPY_ORIG_CMAKE_FIND_LIBRARY_SUFFIXES ${CMAKE_FIND_LIBRARY_SUFFIXES})
+  if(WIN32)
+    set(CMAKE_FIND_LIBRARY_SUFFIXES .lib .a ${CMAKE_FIND_LIBRARY_SUFFIXES})
+  else()
+    set(CMAKE_FIND_LIBRARY_SUFFIXES .a)
+  endif()
+endif()
+find_library(SNAPPY_LIBRARY
+  NAMES snappy libsnappy
+  ${_SNAPPY_ROOT_HINTS_AND_PATHS}
+  PATH_SUFFIXES lib lib/${CMAKE_LIBRARY_ARCHITECTURE}
+  NO_DEFAULT_PATH)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(Snappy
+  "Could NOT find snappy, try to set the path to snappy root folder in the system variable SNAPPY_ROOT_DIR"
+  SNAPPY_LIBRARY
+  SNAPPY_INCLUDE_DIR)
+
+if(SNAPPY_FOUND)
+  set(SNAPPY_INCLUDE_DIRS ${SNAPPY_INCLUDE_DIR})
+  set(SNAPPY_LIBRARIES ${SNAPPY_LIBRARY})
+endif()
+mark_as_advanced(SNAPPY_INCLUDE_DIRS
+                 SNAPPY_LIBRARIES)
+
+# Restore the original find library ordering
+if(CASS_USE_STATIC_LIBS)
+  set(CMAKE_FIND_LIBRARY_SUFFIXES ${_SNAPPY_ORIG_CMAKE_FIND_LIBRARY_SUFFIXES})
+endif()
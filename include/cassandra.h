@@ -199,6 +199,56 @@ typedef struct CassBatch_ CassBatch;
  */
 typedef struct CassFuture_ CassFuture;
 
+/**
+ * A completion queue for many futures. Completed futures are drained from the
+ * group in batches instead of waiting on each future individually.
+ *
+ * @struct CassFutureGroup
+ */
+typedef struct CassFutureGroup_ CassFutureGroup;
+
+/**
+ * A future's callback that's been submitted to an application's callback
+ * executor.
+ *
+ * @struct CassCallbackTask
+ *
+ * @see cass_cluster_set_callback_executor()
+ */
+typedef struct CassCallbackTask_ CassCallbackTask;
+
+/**
+ * A full table scan that's split into one query per token range. The
+ * queries are sent to the ranges' replicas in parallel and their pages are
+ * returned one at a time.
+ *
+ * @struct CassTableScan
+ */
+typedef struct CassTableScan_ CassTableScan;
+
+/**
+ * Writes a stream of rows bound from the same prepared statement using
+ * unlogged, single partition batches with a bounded number of in-flight
+ * batches per replica.
+ *
+ * @struct CassBulkWriter
+ */
+typedef struct CassBulkWriter_ CassBulkWriter;
+
+/**
+ * A request that took longer than the session's slow request threshold.
+ *
+ * @struct CassSlowRequest
+ */
+typedef struct CassSlowRequest_ CassSlowRequest;
+
+/**
+ * An event in the execution of a request that's passed to a request tracer.
+ *
+ * @struct CassRequestTraceEvent
+ */
+typedef struct CassRequestTraceEvent_ CassRequestTraceEvent;
+
 /**
  * A statement that has been prepared cluster-side (It has been pre-parsed
  * and cached).
@@ -210,6 +260,45 @@ typedef struct CassFuture_ CassFuture;
  */
 typedef struct CassPrepared_ CassPrepared;
 
+/**
+ * An immutable snapshot of a bound statement's settings and values. Bound
+ * statements created from a template share its pre-encoded request
+ * parameters, so only the values that change need to be bound and encoded
+ * for each execution.
+ *
+ * A statement template is read-only and it is thread-safe to concurrently
+ * bind new statements.
+ *
+ * @struct CassStatementTemplate
+ */
+typedef struct CassStatementTemplate_ CassStatementTemplate;
+
+/**
+ * A parameter or column name resolved to its indices once, so that values can
+ * be bound and columns retrieved without looking the name up every time.
+ *
+ * A column handle is read-only and is thread-safe to use concurrently.
+ *
+ * @struct CassColumnHandle
+ *
+ * @see cass_prepared_parameter_handle()
+ * @see cass_result_column_handle()
+ */
+typedef struct CassColumnHandle_ CassColumnHandle;
+
+/**
+ * Encodes user defined type or tuple values directly from the memory of an
+ * application's structs using a layout that maps the type's fields to offsets
+ * in the struct.
+ *
+ * A struct encoder is thread-safe to use concurrently once its fields are set.
+ *
+ * @struct CassStructEncoder
+ *
+ * @see cass_struct_encoder_new()
+ */
+typedef struct CassStructEncoder_ CassStructEncoder;
+
 /**
  * The result of a query.
  *
@@ -249,6 +338,17 @@ typedef struct CassIterator_ CassIterator;
  */
 typedef struct CassRow_ CassRow;
 
+/**
+ * A reusable group of rows decoded from a result in a single pass. All the
+ * rows in a batch remain valid until the batch is decoded again so they can be
+ * read concurrently by multiple threads.
+ *
+ * @struct CassRowBatch
+ *
+ * @see cass_row_batch_new()
+ */
+typedef struct CassRowBatch_ CassRowBatch;
+
 /**
  * A single primitive value or a collection of values.
  *
@@ -387,6 +487,14 @@ typedef struct CassUuidGen_ CassUuidGen;
  */
 typedef struct CassTimestampGen_ CassTimestampGen;
 
+/**
+ * The threads of the driver (the IO threads and the thread that runs the
+ * control connections) shared by the sessions of one or more cluster objects.
+ *
+ * @struct CassRuntime
+ */
+typedef struct CassRuntime_ CassRuntime;
+
 /**
  * @struct CassRetryPolicy
  */
@@ -451,6 +559,320 @@ typedef struct CassSpeculativeExecutionMetrics_ {
   cass_double_t percentage; /**< Fraction of requests that are aborted speculative retries */
 } CassSpeculativeExecutionMetrics;
 
+/**
+ * A snapshot of the session's buffer pool metrics. Each I/O thread has a pool
+ * used to allocate socket read buffers and response bodies.
+ *
+ * @struct CassBufferPoolMetrics
+ */
+typedef struct CassBufferPoolMetrics_ {
+  cass_uint64_t hits; /**< The number of buffers reused from a pool */
+  cass_uint64_t misses; /**< The number of buffers that required an allocation */
+} CassBufferPoolMetrics;
+
+/**
+ * A snapshot of the session's result cache metrics.
+ *
+ * @struct CassResultCacheMetrics
+ *
+ * @see cass_cluster_set_result_cache_size()
+ */
+typedef struct CassResultCacheMetrics_ {
+  cass_uint64_t entries; /**< The number of cached results */
+  cass_uint64_t max_entries; /**< The maximum number of cached results */
+  cass_uint64_t hits; /**< The number of executions served from the cache */
+  cass_uint64_t misses; /**< The number of cacheable executions not in the cache (or expired) */
+  cass_uint64_t evictions; /**< The number of results evicted to make room for others */
+} CassResultCacheMetrics;
+
+/**
+ * A snapshot of a bulk writer's progress.
+ *
+ * @struct CassBulkWriterMetrics
+ *
+ * @see cass_bulk_writer_get_metrics()
+ */
+typedef struct CassBulkWriterMetrics_ {
+  cass_uint64_t rows_written; /**< The number of rows written */
+  cass_uint64_t rows_failed; /**< The number of rows in batches that failed */
+  cass_uint64_t batches_written; /**< The number of batches written */
+  cass_uint64_t retries; /**< The number of batches retried after a timeout */
+  cass_uint64_t pending_rows; /**< The number of rows waiting for their batch to fill up */
+  cass_uint64_t inflight_batches; /**< The number of batches in flight */
+  cass_double_t rows_per_second; /**< The mean number of rows written per second */
+} CassBulkWriterMetrics;
+
+/**
+ * A snapshot of the number of requests sent to hosts in the local rack, in the
+ * other racks of the local datacenter and in remote datacenters. Retries and
+ * speculative executions are counted for each host they're sent to.
+ *
+ * The local datacenter and rack are the ones provided when connecting (e.g.
+ * using a cloud secure connection bundle) or, if not provided, the ones of the
+ * host the session first connected to. Requests to the local datacenter are
+ * counted as other racks if the local rack isn't known.
+ *
+ * @struct CassRackMetrics
+ */
+typedef struct CassRackMetrics_ {
+  cass_uint64_t local_rack_requests; /**< Requests sent to hosts in the local rack */
+  cass_uint64_t local_dc_requests; /**< Requests sent to other racks in the local datacenter */
+  cass_uint64_t remote_dc_requests; /**< Requests sent to remote datacenters */
+} CassRackMetrics;
+
+/**
+ * A snapshot of the number of retries decided by the retry policies and the
+ * number of them that were denied by the retry budget.
+ *
+ * @struct CassRetryMetrics
+ */
+typedef struct CassRetryMetrics_ {
+  cass_uint64_t retries; /**< The number of retries */
+  cass_uint64_t denied_retries; /**< The number of retries denied by the retry budget */
+} CassRetryMetrics;
+
+/**
+ * A snapshot of the number of connections that were rejected because a host
+ * doesn't support their protocol version, and the number of connections that
+ * started with the lower protocol version remembered for their host instead
+ * of repeating a rejected handshake.
+ *
+ * @struct CassProtocolMetrics
+ *
+ * @see cass_session_get_protocol_metrics()
+ */
+typedef struct CassProtocolMetrics_ {
+  cass_uint64_t protocol_downgrades; /**< Connections rejected because of their protocol version */
+  cass_uint64_t downgraded_connections; /**< Connections that used a host's lower protocol version */
+} CassProtocolMetrics;
+
+/**
+ * A snapshot of the number of successful SSL handshakes that negotiated a new
+ * session and that resumed a cached session. The ratio of resumed handshakes
+ * is the session cache's hit rate.
+ *
+ * @struct CassSslSessionMetrics
+ *
+ * @see cass_ssl_get_session_metrics()
+ */
+typedef struct CassSslSessionMetrics_ {
+  cass_uint64_t full_handshakes; /**< Handshakes that negotiated a new session */
+  cass_uint64_t resumed_handshakes; /**< Handshakes that resumed a cached session */
+} CassSslSessionMetrics;
+
+/**
+ * A snapshot of the wire statistics of a host's connections, over the
+ * connection pools of all the session's I/O threads. Comparing the number of
+ * flushed requests to the number of flushes shows how effective coalescing
+ * is, and a high in-flight request high-water mark shows when stream IDs are
+ * the bottleneck.
+ *
+ * @struct CassConnectionMetrics
+ *
+ * @see cass_session_get_connection_metrics()
+ */
+typedef struct CassConnectionMetrics_ {
+  cass_uint64_t connections; /**< The number of open connections */
+  cass_uint64_t bytes_written; /**< Bytes written to the host */
+  cass_uint64_t bytes_read; /**< Bytes read from the host */
+  cass_uint64_t flushes; /**< Socket writes of coalesced requests */
+  cass_uint64_t flushed_requests; /**< Requests written by the flushes */
+  cass_uint64_t max_inflight_requests; /**< The highest number of in-flight requests (stream IDs in
+                                            use) on a single connection */
+  cass_uint64_t max_write_queue_bytes; /**< The largest number of bytes waiting in a socket's
+                                            write queue when requests were flushed */
+} CassConnectionMetrics;
+
+/**
+ * A snapshot of the latencies of a host's responses or of an execution
+ * profile's requests. All values are in microseconds.
+ *
+ * @struct CassLatencyMetrics
+ *
+ * @see cass_session_get_host_metrics()
+ * @see cass_session_get_execution_profile_metrics()
+ */
+typedef struct CassLatencyMetrics_ {
+  cass_uint64_t min; /**< Minimum in microseconds */
+  cass_uint64_t max; /**< Maximum in microseconds */
+  cass_uint64_t mean; /**< Mean in microseconds */
+  cass_uint64_t stddev; /**< Standard deviation in microseconds */
+  cass_uint64_t median; /**< Median in microseconds */
+  cass_uint64_t percentile_75th; /**< 75th percentile in microseconds */
+  cass_uint64_t percentile_95th; /**< 95th percentile in microseconds */
+  cass_uint64_t percentile_98th; /**< 98th percentile in microseconds */
+  cass_uint64_t percentile_99th; /**< 99th percentile in microseconds */
+  cass_uint64_t percentile_999th; /**< 99.9th percentile in microseconds */
+} CassLatencyMetrics;
+
+/**
+ * A recorded latency and the number of times it was recorded during an
+ * interval.
+ *
+ * @struct CassHistogramBucket
+ *
+ * @see cass_session_get_interval_metrics()
+ */
+typedef struct CassHistogramBucket_ {
+  cass_int64_t value; /**< The latency in microseconds */
+  cass_int64_t count; /**< The number of requests with the latency */
+} CassHistogramBucket;
+
+/**
+ * A snapshot of the latencies of the stages of the session's requests. This
+ * shows where the time of slow requests goes.
+ *
+ * @struct CassRequestStageMetrics
+ *
+ * @see cass_session_get_request_stage_metrics()
+ */
+typedef struct CassRequestStageMetrics_ {
+  CassLatencyMetrics queue; /**< From executing a request until an I/O thread starts it, including
+                                 waiting for the in-flight limit */
+  CassLatencyMetrics write; /**< From writing a request to a connection until the socket write
+                                 completes, including the coalescing delay */
+  CassLatencyMetrics server; /**< From the completed write until the response is read */
+  CassLatencyMetrics callback; /**< Setting the response on the future, including running the
+                                    future's callback */
+} CassRequestStageMetrics;
+
+/**
+ * A snapshot of an I/O thread's utilization. Comparing these across I/O
+ * threads shows how evenly the load is spread.
+ *
+ * @struct CassEventLoopMetrics
+ */
+typedef struct CassEventLoopMetrics_ {
+  cass_uint64_t busy_time_us; /**< Time spent processing events and tasks in microseconds */
+  cass_uint64_t idle_time_us; /**< Time spent waiting for events in microseconds */
+  cass_uint64_t tasks_run; /**< The number of tasks run, including stolen tasks */
+  cass_uint64_t tasks_stolen; /**< The number of tasks stolen from other I/O threads */
+  cass_double_t utilization; /**< The fraction of the last ~100 milliseconds spent busy (0.0 - 1.0) */
+  cass_uint64_t pending_tasks; /**< The number of tasks waiting to run */
+} CassEventLoopMetrics;
+
+/**
+ * A snapshot of an I/O thread's request load.
+ *
+ * @struct CassRequestProcessorMetrics
+ */
+typedef struct CassRequestProcessorMetrics_ {
+  cass_uint64_t queued_requests; /**< Requests waiting in the I/O thread's queue */
+  cass_uint64_t inflight_requests; /**< Requests started but not yet completed */
+  cass_uint64_t batches; /**< Coalesced batches of requests written and flushed together */
+  cass_uint64_t batched_requests; /**< Requests written in the batches. Dividing this by the
+                                       number of batches gives the average batch size */
+} CassRequestProcessorMetrics;
+
+/**
+ * The time spent in each step of connecting a session. With parallel startup
+ * the schema query overlaps with connecting the connection pools.
+ *
+ * @struct CassStartupTimings
+ *
+ * @see cass_cluster_set_use_parallel_startup()
+ */
+typedef struct CassStartupTimings_ {
+  cass_uint64_t resolve_us; /**< Resolving the contact points in microseconds */
+  cass_uint64_t control_connection_us; /**< Connecting the control connection in microseconds */
+  cass_uint64_t hosts_query_us; /**< Querying the local and peers tables in microseconds */
+  cass_uint64_t schema_query_us; /**< Querying the schema metadata in microseconds */
+  cass_uint64_t metadata_us; /**< Building the initial metadata and token map in microseconds */
+  cass_uint64_t connection_pools_us; /**< Connecting the connection pools in microseconds */
+  cass_uint64_t total_us; /**< Connecting the session in microseconds */
+} CassStartupTimings;
+
+/**
+ * A snapshot of the session's token map. Keyspaces with the same replication
+ * settings share a single replica vector.
+ *
+ * @struct CassTokenMapMetrics
+ */
+typedef struct CassTokenMapMetrics_ {
+  cass_uint64_t keyspaces; /**< Keyspaces with replicas */
+  cass_uint64_t replica_vectors; /**< Distinct replica vectors shared by the keyspaces */
+  cass_uint64_t tokens; /**< Tokens owned by the cluster's hosts */
+  cass_uint64_t memory_bytes; /**< Estimated memory used by the tokens and replicas */
+} CassTokenMapMetrics;
+
+/**
+ * A snapshot of the prepared statements kept by the session for preparing
+ * statements on hosts that come up or that don't have a statement.
+ *
+ * @struct CassPreparedMetadataMetrics
+ *
+ * @see cass_cluster_set_max_prepared_statements()
+ */
+typedef struct CassPreparedMetadataMetrics_ {
+  cass_uint64_t entries; /**< The number of prepared statements */
+  cass_uint64_t max_entries; /**< The maximum number of prepared statements (zero if unbounded) */
+  cass_uint64_t evictions; /**< The number of prepared statements evicted by the limit */
+} CassPreparedMetadataMetrics;
+
+/**
+ * A snapshot of the memory used by the driver's larger subsystems. The buffer
+ * and SSL counts are process-wide, over all sessions; the token map is the
+ * session's.
+ *
+ * @struct CassMemoryMetrics
+ *
+ * @see cass_cluster_set_memory_limit()
+ */
+typedef struct CassMemoryMetrics_ {
+  cass_uint64_t request_buffer_bytes; /**< Encoded requests and bound values */
+  cass_uint64_t response_buffer_bytes; /**< Socket reads and response bodies, including the
+                                            buffers kept by the I/O threads' buffer pools */
+  cass_uint64_t metadata_bytes; /**< Encoded schema metadata values */
+  cass_uint64_t token_map_bytes; /**< Estimated memory used by the token map */
+  cass_uint64_t ssl_buffer_bytes; /**< The buffers of SSL connections */
+  cass_uint64_t memory_limit; /**< The session's memory limit (zero if unlimited) */
+} CassMemoryMetrics;
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+/**
+ * The schema of an Apache Arrow array as defined by the Arrow C data
+ * interface.
+ *
+ * @struct ArrowSchema
+ */
+struct ArrowSchema {
+  const char* format;
+  const char* name;
+  const char* metadata;
+  cass_int64_t flags;
+  cass_int64_t n_children;
+  struct ArrowSchema** children;
+  struct ArrowSchema* dictionary;
+  void (*release)(struct ArrowSchema*);
+  void* private_data;
+};
+
+/**
+ * The data of an Apache Arrow array as defined by the Arrow C data interface.
+ *
+ * @struct ArrowArray
+ */
+struct ArrowArray {
+  cass_int64_t length;
+  cass_int64_t null_count;
+  cass_int64_t offset;
+  cass_int64_t n_buffers;
+  cass_int64_t n_children;
+  const void** buffers;
+  struct ArrowArray** children;
+  struct ArrowArray* dictionary;
+  void (*release)(struct ArrowArray*);
+  void* private_data;
+};
+
+#endif /* ARROW_C_DATA_INTERFACE */
+
 typedef enum CassConsistency_ {
   CASS_CONSISTENCY_UNKNOWN      = 0xFFFF,
   CASS_CONSISTENCY_ANY          = 0x0000,
@@ -597,7 +1019,8 @@ typedef enum CassIteratorType_ {
   CASS_ITERATOR_TYPE_AGGREGATE_META,
   CASS_ITERATOR_TYPE_COLUMN_META,
   CASS_ITERATOR_TYPE_INDEX_META,
-  CASS_ITERATOR_TYPE_MATERIALIZED_VIEW_META
+  CASS_ITERATOR_TYPE_MATERIALIZED_VIEW_META,
+  CASS_ITERATOR_TYPE_PAGED_RESULT
 } CassIteratorType;
 
 #define CASS_LOG_LEVEL_MAPPING(XX) \
@@ -647,6 +1070,44 @@ typedef enum CassProtocolVersion_ {
                                            driver with DataStax Enterprise */
 } CassProtocolVersion;
 
+typedef enum CassCompressionType_ {
+  CASS_COMPRESSION_NONE   = 0x00,
+  CASS_COMPRESSION_LZ4    = 0x01,
+  CASS_COMPRESSION_SNAPPY = 0x02,
+  CASS_COMPRESSION_AUTO   = 0x03 /**< Prefer LZ4, fall back to Snappy */
+} CassCompressionType;
+
+typedef enum CassCoalesceMode_ {
+  CASS_COALESCE_MODE_FIXED    = 0x00, /**< Always use the configured coalesce delay */
+  CASS_COALESCE_MODE_ADAPTIVE = 0x01  /**< Size the coalesce delay from the observed load */
+} CassCoalesceMode;
+
+typedef enum CassConnectionSelection_ {
+  CASS_CONNECTION_SELECTION_LEAST_BUSY           = 0x00, /**< Scan all connections */
+  CASS_CONNECTION_SELECTION_POWER_OF_TWO_CHOICES = 0x01  /**< Compare two random connections */
+} CassConnectionSelection;
+
+typedef enum CassBackpressureMode_ {
+  CASS_BACKPRESSURE_MODE_FAIL = 0x00, /**< Fail requests over the in-flight limit */
+  CASS_BACKPRESSURE_MODE_WAIT = 0x01  /**< Start requests over the in-flight limit once
+                                           running requests complete */
+} CassBackpressureMode;
+
+typedef enum CassRequestPriority_ {
+  CASS_REQUEST_PRIORITY_UNSET  = 0x00, /**< Use the execution profile's priority */
+  CASS_REQUEST_PRIORITY_NORMAL = 0x01, /**< Latency-sensitive requests */
+  CASS_REQUEST_PRIORITY_LOW    = 0x02  /**< Background requests, e.g. batch jobs */
+} CassRequestPriority;
+
+typedef enum CassRequestTraceEventType_ {
+  CASS_REQUEST_TRACE_EVENT_START                 = 0x00, /**< The request was executed */
+  CASS_REQUEST_TRACE_EVENT_ATTEMPT               = 0x01, /**< The request was sent to a host */
+  CASS_REQUEST_TRACE_EVENT_RETRY                 = 0x02, /**< The request is being retried */
+  CASS_REQUEST_TRACE_EVENT_SPECULATIVE_EXECUTION = 0x03, /**< A speculative execution was
+                                                              started */
+  CASS_REQUEST_TRACE_EVENT_FINISH                = 0x04  /**< The request's future was set */
+} CassRequestTraceEventType;
+
 typedef enum  CassErrorSource_ {
   CASS_ERROR_SOURCE_NONE,
   CASS_ERROR_SOURCE_LIB,
@@ -745,6 +1206,80 @@ typedef enum CassError_ {
 typedef void (*CassFutureCallback)(CassFuture* future,
                                    void* data);
 
+/**
+ * A function that submits a future's callback to an application's executor,
+ * e.g. a thread pool. The task must be run, exactly once, using
+ * cass_callback_task_run().
+ *
+ * @param[in] task
+ * @param[in] data user defined data provided when the executor
+ * was set.
+ *
+ * @see cass_cluster_set_callback_executor()
+ */
+typedef void (*CassCallbackExecutorSubmit)(CassCallbackTask* task,
+                                           void* data);
+
+/**
+ * A callback that's notified for each page of a table scan, and once more
+ * with a NULL result when the scan is finished.
+ *
+ * @param[in] scan
+ * @param[in] result A page of the scan or NULL if the scan is finished. The
+ * result is only valid until the callback returns and must not be freed.
+ * @param[in] data user defined data provided when the callback
+ * was registered.
+ *
+ * @see cass_table_scan_set_callback()
+ */
+typedef void (*CassTableScanCallback)(CassTableScan* scan,
+                                      const CassResult* result,
+                                      void* data);
+
+/**
+ * A callback that's notified for each slow request. The callback is run on
+ * the I/O thread that finished the request so it must not block.
+ *
+ * @param[in] request The slow request. It's only valid until the callback
+ * returns and must not be freed.
+ * @param[in] data user defined data provided when the callback
+ * was registered.
+ *
+ * @see cass_cluster_set_slow_request_callback()
+ */
+typedef void (*CassSlowRequestCallback)(const CassSlowRequest* request,
+                                        void* data);
+
+/**
+ * A callback that's notified of the events in the execution of each
+ * request. The start event is run on the application thread that executed
+ * the request, so the tracer can find the caller's current span, and the
+ * other events are run on the I/O threads so the callback must not block.
+ *
+ * @param[in] event The event. It's only valid until the callback returns.
+ * @param[in] data user defined data provided when the callback
+ * was registered.
+ *
+ * @see cass_cluster_set_request_tracer()
+ */
+typedef void (*CassRequestTracerCallback)(CassRequestTraceEvent* event,
+                                          void* data);
+
+/**
+ * A callback that's notified for each row of a statement's result as soon as
+ * the row has been received, before the rest of the page has arrived. The
+ * callback is run on the I/O thread that's receiving the result so it must not
+ * block.
+ *
+ * @param[in] row The row. It's only valid until the callback returns.
+ * @param[in] data user defined data provided when the callback
+ * was registered.
+ *
+ * @see cass_statement_set_row_callback()
+ */
+typedef void (*CassRowCallback)(const CassRow* row,
+                                void* data);
+
 /**
  * Maximum size of a log message
  */
@@ -777,6 +1312,18 @@ typedef struct CassLogMessage_ {
 typedef void (*CassLogCallback)(const CassLogMessage* message,
                                 void* data);
 
+/**
+ * A callback that's used to release the memory of a value bound by
+ * reference. It's called once the driver no longer references the value,
+ * which can be on any thread.
+ *
+ * @param[in] data user defined data provided when the value was bound.
+ *
+ * @see cass_statement_bind_bytes_ref()
+ * @see cass_statement_bind_string_ref()
+ */
+typedef void (*CassValueReleaseCallback)(void* data);
+
 /**
  * A custom malloc function. This function should allocate "size" bytes and
  * return a pointer to that memory
@@ -817,6 +1364,20 @@ typedef void* (*CassReallocFunction)(void* ptr, size_t size);
  */
 typedef void (*CassFreeFunction)(void* ptr);
 
+/**
+ * Counters for the driver's object cache. Small driver objects (futures,
+ * request handlers, responses and buffers) are cached in per-thread magazines
+ * of freed objects that are exchanged with a shared depot.
+ *
+ * @see cass_alloc_get_object_cache_stats()
+ */
+typedef struct CassObjectCacheStats_ {
+  cass_uint64_t hits; /**< Allocations served from a cached object */
+  cass_uint64_t misses; /**< Allocations that called the allocation function */
+  cass_uint64_t depot_magazines; /**< Full magazines held by the shared depot */
+  cass_uint64_t thread_caches; /**< Threads that have used the cache */
+} CassObjectCacheStats;
+
 /**
  * An authenticator.
  *
@@ -1139,89 +1700,202 @@ cass_execution_profile_set_token_aware_routing_shuffle_replicas(CassExecProfile*
                                                                 cass_bool_t enabled);
 
 /**
- * Configures the execution profile to use latency-aware request routing or not.
+ * Configures the execution profile's token-aware routing to try the least
+ * loaded replicas first. Replicas are ranked by their in-flight requests
+ * across all of the session's connections and then by their recent average
+ * latency, so busy or slow replicas (e.g. replicas running compactions) are
+ * only tried after the others. If replica shuffling is also enabled then
+ * equally loaded replicas are tried in a random order.
  *
- * <b>Note:</b> Execution profiles use the cluster-level load balancing policy
- * unless enabled. This setting is not applicable unless a load balancing policy
- * is enabled on the execution profile.
+ * <b>Note:</b> Token-aware routing must be enabled and a load balancing policy
+ * must be enabled on the execution profile for the setting to be applicable.
  *
  * <b>Default:</b> cass_false (disabled).
  *
- * This routing policy is a top-level routing policy. It uses the
- * base routing policy to determine locality (dc-aware) and/or
- * placement (token-aware) before considering the latency.
- *
  * @public @memberof CassExecProfile
  *
  * @param[in] profile
  * @param[in] enabled
  * @return CASS_OK if successful, otherwise an error occurred.
  *
- * @see cass_cluster_set_latency_aware_routing()
+ * @see cass_cluster_set_token_aware_routing_least_loaded_replicas()
  */
 CASS_EXPORT CassError
-cass_execution_profile_set_latency_aware_routing(CassExecProfile* profile,
-                                                 cass_bool_t enabled);
+cass_execution_profile_set_token_aware_routing_least_loaded_replicas(CassExecProfile* profile,
+                                                                     cass_bool_t enabled);
 
 /**
- * Configures the execution profile's settings for latency-aware request
- * routing.
- *
- * <b>Note:</b> Execution profiles use the cluster-level load balancing policy
- * unless enabled. This setting is not applicable unless a load balancing policy
- * is enabled on the execution profile.
+ * Sets how a connection is selected from a host's connection pool for the
+ * execution profile's requests.
  *
- * <b>Defaults:</b>
- *
- * <ul>
- *   <li>exclusion_threshold: 2.0</li>
- *   <li>scale_ms: 100 milliseconds</li>
- *   <li>retry_period_ms: 10,000 milliseconds (10 seconds)</li>
- *   <li>update_rate_ms: 100 milliseconds</li>
- *   <li>min_measured: 50</li>
- * </ul>
+ * <b>Default:</b> CASS_CONNECTION_SELECTION_LEAST_BUSY
  *
  * @public @memberof CassExecProfile
  *
  * @param[in] profile
- * @param[in] exclusion_threshold Controls how much worse the latency must be
- * compared to the average latency of the best performing node before it
- * penalized.
- * @param[in] scale_ms Controls the weight given to older latencies when
- * calculating the average latency of a node. A bigger scale will give more
- * weight to older latency measurements.
- * @param[in] retry_period_ms The amount of time a node is penalized by the
- * policy before being given a second chance when the current average latency
- * exceeds the calculated threshold
- * (exclusion_threshold * best_average_latency).
- * @param[in] update_rate_ms The rate at  which the best average latency is
- * recomputed.
- * @param[in] min_measured The minimum number of measurements per-host required
- * to be considered by the policy.
+ * @param[in] selection
  * @return CASS_OK if successful, otherwise an error occurred.
  *
- * @see cass_cluster_set_latency_aware_routing_settings()
+ * @see cass_cluster_set_connection_selection()
  */
 CASS_EXPORT CassError
-cass_execution_profile_set_latency_aware_routing_settings(CassExecProfile* profile,
-                                                          cass_double_t exclusion_threshold,
-                                                          cass_uint64_t scale_ms,
-                                                          cass_uint64_t retry_period_ms,
-                                                          cass_uint64_t update_rate_ms,
-                                                          cass_uint64_t min_measured);
+cass_execution_profile_set_connection_selection(CassExecProfile* profile,
+                                                CassConnectionSelection selection);
 
 /**
- * Sets/Appends whitelist hosts for the execution profile. The first call sets
- * the whitelist hosts and any subsequent calls appends additional hosts.
- * Passing an empty string will clear and disable the whitelist. White space is
- * striped from the hosts.
+ * Sets the priority of the execution profile's requests. Each I/O thread
+ * queues low priority requests separately and only starts them in between
+ * normal priority requests, and low priority requests can't use a
+ * connection's reserved stream IDs.
  *
- * This policy filters requests to all other policies, only allowing requests
- * to the hosts contained in the whitelist. Any host not in the whitelist will
- * be ignored and a connection will not be established. This policy is useful
- * for ensuring that the driver will only connect to a predefined set of hosts.
+ * <b>Default:</b> CASS_REQUEST_PRIORITY_NORMAL
  *
- * Examples: "127.0.0.1" "127.0.0.1,127.0.0.2"
+ * @public @memberof CassExecProfile
+ *
+ * @param[in] profile
+ * @param[in] priority
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_set_priority()
+ * @see cass_cluster_set_low_priority_weight()
+ * @see cass_cluster_set_reserved_streams()
+ */
+CASS_EXPORT CassError
+cass_execution_profile_set_priority(CassExecProfile* profile,
+                                    CassRequestPriority priority);
+
+/**
+ * Limits the rate the execution profile's requests are started. Requests over
+ * the rate aren't failed; they're delayed until they fit the rate. A burst of
+ * requests can start at the same time after the profile has been idle. Each
+ * session has its own limit.
+ *
+ * <b>Note:</b> The request timeout starts once a request is started so
+ * delayed requests aren't timed out while they wait. Use
+ * cass_cluster_set_max_inflight_requests() to bound the number of waiting
+ * requests.
+ *
+ * <b>Default:</b> 0.0 (disabled)
+ *
+ * @public @memberof CassExecProfile
+ *
+ * @param[in] profile
+ * @param[in] requests_per_second The maximum rate, or 0.0 to disable the limit.
+ * @param[in] burst The number of requests that can start at the same time.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_rate_limit()
+ */
+CASS_EXPORT CassError
+cass_execution_profile_set_rate_limit(CassExecProfile* profile,
+                                      cass_double_t requests_per_second,
+                                      unsigned burst);
+
+/**
+ * Sets the probability that the execution profile's requests are traced.
+ * Sampled requests are traced as if cass_statement_set_tracing() was enabled
+ * on their statements. This can be used to collect the traces of a small
+ * fraction of the production requests.
+ *
+ * <b>Default:</b> The cluster's tracing probability
+ *
+ * @public @memberof CassExecProfile
+ *
+ * @param[in] profile
+ * @param[in] probability A probability between 0.0 (never) and 1.0 (always).
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_tracing_probability()
+ * @see cass_future_tracing_data()
+ */
+CASS_EXPORT CassError
+cass_execution_profile_set_tracing_probability(CassExecProfile* profile,
+                                               cass_double_t probability);
+
+/**
+ * Configures the execution profile to use latency-aware request routing or not.
+ *
+ * <b>Note:</b> Execution profiles use the cluster-level load balancing policy
+ * unless enabled. This setting is not applicable unless a load balancing policy
+ * is enabled on the execution profile.
+ *
+ * <b>Default:</b> cass_false (disabled).
+ *
+ * This routing policy is a top-level routing policy. It uses the
+ * base routing policy to determine locality (dc-aware) and/or
+ * placement (token-aware) before considering the latency.
+ *
+ * @public @memberof CassExecProfile
+ *
+ * @param[in] profile
+ * @param[in] enabled
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_latency_aware_routing()
+ */
+CASS_EXPORT CassError
+cass_execution_profile_set_latency_aware_routing(CassExecProfile* profile,
+                                                 cass_bool_t enabled);
+
+/**
+ * Configures the execution profile's settings for latency-aware request
+ * routing.
+ *
+ * <b>Note:</b> Execution profiles use the cluster-level load balancing policy
+ * unless enabled. This setting is not applicable unless a load balancing policy
+ * is enabled on the execution profile.
+ *
+ * <b>Defaults:</b>
+ *
+ * <ul>
+ *   <li>exclusion_threshold: 2.0</li>
+ *   <li>scale_ms: 100 milliseconds</li>
+ *   <li>retry_period_ms: 10,000 milliseconds (10 seconds)</li>
+ *   <li>update_rate_ms: 100 milliseconds</li>
+ *   <li>min_measured: 50</li>
+ * </ul>
+ *
+ * @public @memberof CassExecProfile
+ *
+ * @param[in] profile
+ * @param[in] exclusion_threshold Controls how much worse the latency must be
+ * compared to the average latency of the best performing node before it
+ * penalized.
+ * @param[in] scale_ms Controls the weight given to older latencies when
+ * calculating the average latency of a node. A bigger scale will give more
+ * weight to older latency measurements.
+ * @param[in] retry_period_ms The amount of time a node is penalized by the
+ * policy before being given a second chance when the current average latency
+ * exceeds the calculated threshold
+ * (exclusion_threshold * best_average_latency).
+ * @param[in] update_rate_ms The rate at  which the best average latency is
+ * recomputed.
+ * @param[in] min_measured The minimum number of measurements per-host required
+ * to be considered by the policy.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_latency_aware_routing_settings()
+ */
+CASS_EXPORT CassError
+cass_execution_profile_set_latency_aware_routing_settings(CassExecProfile* profile,
+                                                          cass_double_t exclusion_threshold,
+                                                          cass_uint64_t scale_ms,
+                                                          cass_uint64_t retry_period_ms,
+                                                          cass_uint64_t update_rate_ms,
+                                                          cass_uint64_t min_measured);
+
+/**
+ * Sets/Appends whitelist hosts for the execution profile. The first call sets
+ * the whitelist hosts and any subsequent calls appends additional hosts.
+ * Passing an empty string will clear and disable the whitelist. White space is
+ * striped from the hosts.
+ *
+ * This policy filters requests to all other policies, only allowing requests
+ * to the hosts contained in the whitelist. Any host not in the whitelist will
+ * be ignored and a connection will not be established. This policy is useful
+ * for ensuring that the driver will only connect to a predefined set of hosts.
+ *
+ * Examples: "127.0.0.1" "127.0.0.1,127.0.0.2"
  *
  * <b>Note:</b> Execution profiles use the cluster-level load balancing policy
  * unless enabled. This setting is not applicable unless a load balancing policy
@@ -1432,6 +2106,40 @@ cass_execution_profile_set_constant_speculative_execution_policy(CassExecProfile
                                                                  cass_int64_t constant_delay_ms,
                                                                  int max_speculative_executions);
 
+/**
+ * Enable speculative executions with a delay that follows the observed
+ * request latencies for the execution profile.
+ *
+ * The delay before each speculative execution is the given percentile of the
+ * recent latencies of the requests that use the execution profile
+ * (e.g. 95.0 to speculate once a request takes longer than 95% of the recent
+ * requests). The delay is recomputed every second and no speculative
+ * executions are started until enough latencies have been recorded.
+ *
+ * The number of speculative executions is limited to a fraction of the number
+ * of requests so that a latency spike doesn't multiply the load on the
+ * cluster.
+ *
+ * <b>Note:</b> Profile-based speculative execution policy is disabled by
+ * default; cluster speculative execution policy is used when profile does not
+ * contain a policy.
+ *
+ * @public @memberof CassExecProfile
+ *
+ * @param[in] profile
+ * @param[in] percentile The latency percentile to use as the delay (0.0 - 100.0).
+ * @param[in] max_speculative_executions
+ * @param[in] max_speculative_ratio The maximum fraction of requests that can
+ * start a speculative execution (0.0 - 1.0).
+ * @return CASS_OK if successful, otherwise an error occurred
+ *
+ * @see cass_cluster_set_percentile_speculative_execution_policy()
+ */
+CASS_EXPORT CassError
+cass_execution_profile_set_percentile_speculative_execution_policy(
+    CassExecProfile* profile, cass_double_t percentile, int max_speculative_executions,
+    cass_double_t max_speculative_ratio);
+
 /**
  * Disable speculative executions for the execution profile.
  *
@@ -1564,6 +2272,50 @@ cass_cluster_set_local_address_n(CassCluster* cluster,
                                  const char* name,
                                  size_t name_length);
 
+/**
+ * Sets multiple local addresses to bind when connecting to the cluster. The
+ * connections are spread across the addresses, round-robin, using the
+ * addresses of the same family (IPv4 or IPv6) as the host. Each address has
+ * its own range of local ports so this avoids exhausting the ephemeral ports
+ * when opening many connections to the same hosts.
+ *
+ * This replaces the address set by cass_cluster_set_local_address().
+ *
+ * <b>Default:</b> No binding
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] addresses A comma delimited list of IP addresses to bind, or an
+ * empty string for no binding. Only numeric addresses are supported; no
+ * resolution is done.
+ * @return CASS_OK if successful, otherwise an error occurred. The addresses
+ * are unchanged if any of them is invalid.
+ *
+ * @see cass_cluster_set_local_address()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_local_addresses(CassCluster* cluster,
+                                 const char* addresses);
+
+/**
+ * Same as cass_cluster_set_local_addresses(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] addresses
+ * @param[in] addresses_length
+ * @return same as cass_cluster_set_local_addresses()
+ *
+ * @see cass_cluster_set_local_addresses()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_local_addresses_n(CassCluster* cluster,
+                                   const char* addresses,
+                                   size_t addresses_length);
+
 /**
  * Sets the SSL context and enables SSL.
  *
@@ -1678,302 +2430,419 @@ cass_cluster_set_num_threads_io(CassCluster* cluster,
                                 unsigned num_threads);
 
 /**
- * Sets the size of the fixed size queue that stores
- * pending requests.
+ * Enables work stealing between the IO threads. Work that isn't tied to a
+ * specific IO thread's connections can be run by an idle IO thread instead
+ * of waiting behind a busy one. This is currently the decoding of the large
+ * result bodies that are offloaded from the IO threads.
  *
- * <b>Default:</b> 8192
+ * <b>Default:</b> cass_false (disabled).
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] queue_size
+ * @param[in] enabled
  * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_result_decode_offload_threshold()
+ * @see cass_session_get_event_loop_metrics()
  */
 CASS_EXPORT CassError
-cass_cluster_set_queue_size_io(CassCluster* cluster,
-                               unsigned queue_size);
+cass_cluster_set_work_stealing(CassCluster* cluster,
+                               cass_bool_t enabled);
 
 /**
- * Sets the size of the fixed size queue that stores
- * events.
+ * Enables the io_uring socket backend (Linux only). The IO threads' connections
+ * receive into buffers registered with the kernel and the writes queued during
+ * an iteration of an IO thread's event loop are submitted using a single
+ * system call. An IO thread falls back to the default backend if the kernel
+ * doesn't support io_uring (Linux 6.0+ is required).
  *
- * <b>Default:</b> 8192
+ * <b>Default:</b> cass_false (disabled).
  *
  * @public @memberof CassCluster
  *
- * @deprecated This is no longer useful and does nothing. Expect this to be
- * removed in a future release.
- *
  * @param[in] cluster
- * @param[in] queue_size
+ * @param[in] enabled
  * @return CASS_OK if successful, otherwise an error occurred.
+ * CASS_ERROR_LIB_NOT_IMPLEMENTED is returned if the driver was built without
+ * io_uring support.
  */
-CASS_EXPORT CASS_DEPRECATED(CassError
-cass_cluster_set_queue_size_event(CassCluster* cluster,
-                                  unsigned queue_size));
+CASS_EXPORT CassError
+cass_cluster_set_io_uring(CassCluster* cluster,
+                          cass_bool_t enabled);
 
 /**
- * Sets the number of connections made to each server in each
- * IO thread.
+ * Enables busy polling. The IO threads spin checking for socket events and
+ * new requests instead of sleeping until they're woken up. This lowers the
+ * latency of requests at the cost of keeping a core per IO thread fully busy.
  *
- * <b>Default:</b> 1
+ * <b>Default:</b> cass_false (disabled) and 0 for the socket busy poll time.
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] num_connections
+ * @param[in] enabled
+ * @param[in] socket_busy_poll_us The time, in microseconds, that a read from a
+ * socket busy polls the network device for data (SO_BUSY_POLL, Linux only).
+ * Use 0 to leave it to the system's setting. Times above the system's
+ * setting (net.core.busy_read) require the CAP_NET_ADMIN capability.
  * @return CASS_OK if successful, otherwise an error occurred.
+ * CASS_ERROR_LIB_NOT_IMPLEMENTED is returned if a socket busy poll time is
+ * used on a system that doesn't support it.
+ *
+ * @see cass_cluster_set_io_thread_cpus()
  */
 CASS_EXPORT CassError
-cass_cluster_set_core_connections_per_host(CassCluster* cluster,
-                                           unsigned num_connections);
+cass_cluster_set_busy_poll(CassCluster* cluster,
+                           cass_bool_t enabled,
+                           unsigned socket_busy_poll_us);
 
 /**
- * Sets the maximum number of connections made to each server in each
- * IO thread.
+ * Sets the number of driver-managed threads that run the callbacks of the
+ * futures returned by a session's execute and prepare functions. Otherwise,
+ * the callbacks run on the IO threads, where a slow callback delays the
+ * requests of all the connections on that thread. Each callback thread runs
+ * its queued callbacks in batches.
  *
- * <b>Default:</b> 2
+ * <b>Note:</b> When the callbacks run on other threads, threads waiting on
+ * a future can be woken up before its callback has run.
  *
- * @public @memberof CassCluster
+ * <b>Default:</b> 0 (Callbacks run on the IO threads)
  *
- * @deprecated This is no longer useful and does nothing. Expect this to be
- * removed in a future release.
+ * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] num_connections
+ * @param[in] num_threads
  * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_callback_executor()
  */
-CASS_EXPORT CASS_DEPRECATED(CassError
-cass_cluster_set_max_connections_per_host(CassCluster* cluster,
-                                          unsigned num_connections));
+CASS_EXPORT CassError
+cass_cluster_set_num_threads_callback(CassCluster* cluster,
+                                      unsigned num_threads);
 
 /**
- * Sets the amount of time to wait before attempting to reconnect.
+ * Sets a function that submits the callbacks of the futures returned by a
+ * session's execute and prepare functions to an application's executor,
+ * instead of running them on the IO threads. This takes precedence over the
+ * driver-managed callback threads.
  *
- * @public @memberof CassCluster
+ * <b>Default:</b> NULL (Callbacks run on the IO threads)
  *
- * @deprecated This is being replaced with cass_cluster_set_constant_reconnect().
- * Expect this to be removed in a future release.
+ * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] wait_time
+ * @param[in] submit The submit function or NULL to stop using an
+ * application's executor.
+ * @param[in] data user defined data passed to the submit function.
+ *
+ * @see cass_callback_task_run()
+ * @see cass_cluster_set_num_threads_callback()
  */
-CASS_EXPORT CASS_DEPRECATED(void
-cass_cluster_set_reconnect_wait_time(CassCluster* cluster,
-                                     unsigned wait_time));
+CASS_EXPORT void
+cass_cluster_set_callback_executor(CassCluster* cluster,
+                                   CassCallbackExecutorSubmit submit,
+                                   void* data);
 
 /**
- * Configures the cluster to use a reconnection policy that waits a constant
- * time between each reconnection attempt.
+ * Pins the IO threads to CPUs. The first IO thread is pinned to the first
+ * CPU, the second IO thread to the second CPU and so on. The CPUs are reused,
+ * in order, if there are more IO threads than CPUs.
+ *
+ * <b>Default:</b> The IO threads aren't pinned.
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] delay_ms Time in milliseconds to delay attempting a reconnection;
- * 0 to perform a reconnection immediately.
+ * @param[in] cpus The CPU numbers. Use NULL, with a count of 0, to stop
+ * pinning the IO threads.
+ * @param[in] cpus_count The number of CPUs.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ * CASS_ERROR_LIB_NOT_IMPLEMENTED is returned if the driver was built with a
+ * version of libuv that can't pin threads (before 1.45).
+ *
+ * @see cass_cluster_set_num_threads_io()
+ * @see cass_cluster_set_io_thread_cpu_sets()
  */
-CASS_EXPORT void
-cass_cluster_set_constant_reconnect(CassCluster* cluster,
-                                    cass_uint64_t delay_ms);
+CASS_EXPORT CassError
+cass_cluster_set_io_thread_cpus(CassCluster* cluster,
+                                const unsigned* cpus,
+                                size_t cpus_count);
 
 /**
- * Configures the cluster to use a reconnection policy that waits exponentially
- * longer between each reconnection attempt; however will maintain a constant
- * delay once the maximum delay is reached.
- *
- * <b>Default:</b>
- * <ul>
- *   <li>2000 milliseconds base delay</li>
- *   <li>60000 milliseconds max delay</li>
- * </ul>
+ * Pins the IO threads to sets of CPUs, e.g. the CPUs of a NUMA node. The
+ * first IO thread is pinned to the first set, the second IO thread to the
+ * second set and so on. The sets are reused, in order, if there are more IO
+ * threads than sets.
  *
- * <p>
- *   <b>Note:</b> A random amount of jitter (+/- 15%) will be added to the pure
- *   exponential delay value. This helps to prevent situations where multiple
- *   connections are in the reconnection process at exactly the same time. The
- *   jitter will never cause the delay to be less than the base delay, or more
- *   than the max delay.
- * </p>
+ * <b>Default:</b> The IO threads aren't pinned.
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] base_delay_ms The base delay (in milliseconds) to use for
- * scheduling reconnection attempts.
- * @param[in] max_delay_ms The maximum delay to wait between two reconnection
- * attempts.
- * @return CASS_OK if successful, otherwise error occurred.
+ * @param[in] cpus The CPU numbers of all the sets, one set after another.
+ * @param[in] cpu_set_sizes The number of CPUs in each set.
+ * @param[in] cpu_sets_count The number of sets. Use 0 to stop pinning the IO
+ * threads.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ * CASS_ERROR_LIB_NOT_IMPLEMENTED is returned if the driver was built with a
+ * version of libuv that can't pin threads (before 1.45).
+ *
+ * @see cass_cluster_set_io_thread_cpus()
+ * @see cass_cluster_set_io_thread_numa_local()
  */
 CASS_EXPORT CassError
-cass_cluster_set_exponential_reconnect(CassCluster* cluster,
-                                       cass_uint64_t base_delay_ms,
-                                       cass_uint64_t max_delay_ms);
+cass_cluster_set_io_thread_cpu_sets(CassCluster* cluster,
+                                    const unsigned* cpus,
+                                    const size_t* cpu_set_sizes,
+                                    size_t cpu_sets_count);
 
 /**
- * Sets the amount of time, in microseconds, to wait for new requests to
- * coalesce into a single system call. This should be set to a value around
- * the latency SLA of your application's requests while also considering the
- * request's roundtrip time. Larger values should be used for throughput
- * bound workloads and lower values should be used for latency bound
- * workloads.
+ * Allocates each IO thread's buffer pools (socket read buffers, response
+ * bodies and SSL buffers) up front, on the IO thread itself, once it's been
+ * pinned. The memory is therefore placed on the NUMA node of the IO thread's
+ * CPUs instead of wherever it's first used. This increases the memory used by
+ * each IO thread by a few megabytes.
  *
- * <b>Default:</b> 200 us
+ * <b>Note:</b> This is only useful when the IO threads are pinned to the CPUs
+ * of a single NUMA node and the system uses a local (first touch) memory
+ * policy, which is the default on Linux.
+ *
+ * <b>Default:</b> cass_false (disabled)
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] delay_us
- * @return CASS_OK if successful, otherwise an error occurred.
+ * @param[in] enabled
+ *
+ * @see cass_cluster_set_io_thread_cpu_sets()
  */
-CASS_EXPORT CassError
-cass_cluster_set_coalesce_delay(CassCluster* cluster,
-                                cass_int64_t delay_us);
+CASS_EXPORT void
+cass_cluster_set_io_thread_numa_local(CassCluster* cluster,
+                                      cass_bool_t enabled);
 
 /**
- * Sets the ratio of time spent processing new requests versus handling the I/O
- * and processing of outstanding requests. The range of this setting is 1 to 100,
- * where larger values allocate more time to processing new requests and smaller
- * values allocate more time to processing outstanding requests.
+ * Places each IO thread's pooled buffers (socket read buffers, response
+ * bodies and SSL buffers) in memory backed by 2 MB huge pages. This reduces
+ * the TLB misses of IO-heavy applications. Explicit huge pages are used if
+ * the system has reserved some (e.g. using vm.nr_hugepages), otherwise
+ * transparent huge pages are requested using madvise(). This increases the
+ * memory used by each IO thread by a few megabytes.
  *
- * <b>Default:</b> 50
+ * <b>Note:</b> This is only supported on Linux. Buffers are allocated as
+ * usual elsewhere or if the memory can't be mapped.
+ *
+ * <b>Default:</b> cass_false (disabled)
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] ratio
- * @return CASS_OK if successful, otherwise an error occurred.
+ * @param[in] enabled
+ *
+ * @see cass_cluster_set_io_thread_numa_local()
  */
-CASS_EXPORT CassError
-cass_cluster_set_new_request_ratio(CassCluster* cluster,
-                                   cass_int32_t ratio);
+CASS_EXPORT void
+cass_cluster_set_huge_page_buffers(CassCluster* cluster,
+                                   cass_bool_t enabled);
 
 /**
- * Sets the maximum number of connections that will be created concurrently.
- * Connections are created when the current connections are unable to keep up with
- * request throughput.
+ * Shares the driver's threads between the sessions connected using the
+ * cluster object: the IO threads and the thread that runs the control
+ * connections. Without it, every session starts its own threads. The threads
+ * are started by the first session that connects, using the IO thread
+ * settings of that moment (the number of IO threads, work stealing, busy
+ * polling and CPU pinning), and they're stopped once all the sessions and the
+ * cluster object have been freed.
  *
- * <b>Default:</b> 1
+ * Each session still has its own control connection, connection pools and
+ * token map because these depend on the session's keyspace, policies and
+ * settings.
  *
- * @public @memberof CassCluster
+ * <b>Note:</b> Don't free a session from one of its callbacks when the
+ * threads are shared, the session waits for the shared threads to finish
+ * running its callbacks.
  *
- * @deprecated This is no longer useful and does nothing. Expect this to be
- * removed in a future release.
+ * <b>Default:</b> cass_false (disabled)
+ *
+ * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] num_connections
- * @return CASS_OK if successful, otherwise an error occurred.
+ * @param[in] enabled
+ *
+ * @see cass_cluster_set_num_threads_io()
+ * @see cass_cluster_set_runtime()
  */
-CASS_EXPORT CASS_DEPRECATED(CassError
-cass_cluster_set_max_concurrent_creation(CassCluster* cluster,
-                                         unsigned num_connections));
+CASS_EXPORT void
+cass_cluster_set_shared_runtime(CassCluster* cluster,
+                                cass_bool_t enabled);
 
 /**
- * Sets the threshold for the maximum number of concurrent requests in-flight
- * on a connection before creating a new connection. The number of new connections
- * created will not exceed max_connections_per_host.
+ * Sets the runtime whose threads are used by the sessions connected using the
+ * cluster object. The same runtime can be set on the cluster objects of
+ * different clusters. The number of IO threads is the runtime's, if it was
+ * given one, otherwise, it's that of the first connecting session's cluster
+ * object. The other IO thread settings (work stealing, busy polling and CPU
+ * pinning) are those of the first connecting session's cluster object.
  *
- * <b>Default:</b> 100
+ * <b>Default:</b> NULL (Each session starts its own threads.)
  *
  * @public @memberof CassCluster
  *
- * @deprecated This is no longer useful and does nothing. Expect this to be
- * removed in a future release.
+ * @param[in] cluster
+ * @param[in] runtime The runtime or NULL to stop sharing threads. The cluster
+ * object keeps a reference so the runtime can be freed after this call.
+ *
+ * @see cass_runtime_new()
+ * @see cass_cluster_set_shared_runtime()
+ */
+CASS_EXPORT void
+cass_cluster_set_runtime(CassCluster* cluster,
+                         CassRuntime* runtime);
+
+/**
+ * Sets the size of the fixed size queue that stores
+ * pending requests. Requests that don't fit fail with
+ * CASS_ERROR_LIB_REQUEST_QUEUE_FULL unless the wait backpressure mode is
+ * used, in which case they're held in an unbounded overflow list.
+ *
+ * <b>Default:</b> 8192
+ *
+ * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] num_requests
+ * @param[in] queue_size
  * @return CASS_OK if successful, otherwise an error occurred.
  */
-CASS_EXPORT CASS_DEPRECATED(CassError
-cass_cluster_set_max_concurrent_requests_threshold(CassCluster* cluster,
-                                                   unsigned num_requests));
+CASS_EXPORT CassError
+cass_cluster_set_queue_size_io(CassCluster* cluster,
+                               unsigned queue_size);
 
 /**
- * Sets the maximum number of requests processed by an IO worker
- * per flush.
+ * Sets the maximum number of requests that can be in-flight for a session,
+ * across all of its I/O threads. Requests over the limit are handled using the
+ * backpressure mode.
  *
- * <b>Default:</b> 128
+ * <b>Default:</b> 0 (unlimited)
  *
  * @public @memberof CassCluster
  *
- * @deprecated This is no longer useful and does nothing. Expect this to be
- * removed in a future release.
- *
  * @param[in] cluster
  * @param[in] num_requests
  * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_backpressure_mode()
+ * @see cass_session_get_request_processor_metrics()
  */
-CASS_EXPORT CASS_DEPRECATED(CassError
-cass_cluster_set_max_requests_per_flush(CassCluster* cluster,
-                                        unsigned num_requests));
+CASS_EXPORT CassError
+cass_cluster_set_max_inflight_requests(CassCluster* cluster,
+                                       unsigned num_requests);
 
 /**
- * Sets the high water mark for the number of bytes outstanding
- * on a connection. Disables writes to a connection if the number
- * of bytes queued exceed this value.
+ * Sets how requests over the session's in-flight limit are handled. The fail
+ * mode completes their futures immediately with
+ * CASS_ERROR_LIB_REQUEST_QUEUE_FULL. The wait mode holds them, without
+ * failing, until running requests complete and their futures complete
+ * normally once they've been run.
  *
- * <b>Default:</b> 64 KB
+ * The mode also applies to requests that don't fit into an I/O thread's
+ * request queue: the wait mode holds them in an overflow list instead of
+ * failing them.
  *
- * @public @memberof CassCluster
+ * <b>Default:</b> CASS_BACKPRESSURE_MODE_FAIL
  *
- * @deprecated This is no longer useful and does nothing. Expect this to be
- * removed in a future release.
+ * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] num_bytes
+ * @param[in] mode
  * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_max_inflight_requests()
+ * @see cass_cluster_set_queue_size_io()
  */
-CASS_EXPORT CASS_DEPRECATED(CassError
-cass_cluster_set_write_bytes_high_water_mark(CassCluster* cluster,
-                                             unsigned num_bytes));
+CASS_EXPORT CassError
+cass_cluster_set_backpressure_mode(CassCluster* cluster,
+                                   CassBackpressureMode mode);
 
 /**
- * Sets the low water mark for number of bytes outstanding on a
- * connection. After exceeding high water mark bytes, writes will
- * only resume once the number of bytes fall below this value.
+ * Sets the number of application threads, per I/O thread, that are given
+ * their own request queue (lane). A thread is given a lane the first time it
+ * executes a request and the I/O thread takes requests from the lanes in
+ * turn. This avoids the contention of many threads adding requests to the
+ * same shared queue. Threads after the first num_lanes, and requests that
+ * don't fit into a full lane, use the shared queue.
  *
- * <b>Default:</b> 32 KB
+ * <b>Note:</b> A lane isn't released when its thread exits so this is
+ * intended for applications with long-lived threads.
  *
- * @public @memberof CassCluster
+ * <b>Default:</b> 0 (disabled)
  *
- * @deprecated This is no longer useful and does nothing. Expect this to be
- * removed in a future release.
+ * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] num_bytes
+ * @param[in] num_lanes
  * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_queue_size_io()
  */
-CASS_EXPORT CASS_DEPRECATED(CassError
-cass_cluster_set_write_bytes_low_water_mark(CassCluster* cluster,
-                                            unsigned num_bytes));
+CASS_EXPORT CassError
+cass_cluster_set_producer_lanes(CassCluster* cluster,
+                                unsigned num_lanes);
 
 /**
- * Sets the high water mark for the number of requests queued waiting
- * for a connection in a connection pool. Disables writes to a
- * host on an IO worker if the number of requests queued exceed this
- * value.
+ * Sets a limit on the memory used by request and response buffers. New
+ * requests are handled using the backpressure mode while the buffers use
+ * more than the limit: they either fail with
+ * CASS_ERROR_LIB_REQUEST_QUEUE_FULL or wait for running requests to
+ * complete. A request is always started if the session has no other
+ * requests in flight, so the session makes progress even if the memory is
+ * held elsewhere (e.g. by results that haven't been freed).
  *
- * <b>Default:</b> 256
+ * <b>Note:</b> The buffers are counted over all the sessions of the process
+ * and include the buffers kept by the I/O threads' buffer pools, so the limit
+ * should leave room for them.
+ *
+ * <b>Default:</b> 0 (unlimited)
  *
  * @public @memberof CassCluster
  *
- * @deprecated This is no longer useful and does nothing. Expect this to be
- * removed in a future release.
+ * @param[in] cluster
+ * @param[in] limit_bytes
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_backpressure_mode()
+ * @see cass_session_get_memory_metrics()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_memory_limit(CassCluster* cluster,
+                              cass_uint64_t limit_bytes);
+
+/**
+ * Sets the size of a per-request arena. When enabled, a request's future,
+ * handler and executions are allocated from a single block of memory that's
+ * freed once all of them, including the future held by the application,
+ * have been freed. This reduces the number of calls to the allocator for
+ * each request, which helps when a custom allocator with a global lock is
+ * used (see cass_alloc_set_functions()). Objects that don't fit in the arena
+ * are allocated individually.
+ *
+ * <b>Default:</b> 0 (disabled)
+ *
+ * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] num_requests
+ * @param[in] size The size of the arena in bytes. 2048 bytes is
+ * enough for a request and a few retries or speculative executions.
  * @return CASS_OK if successful, otherwise an error occurred.
  */
-CASS_EXPORT CASS_DEPRECATED(CassError
-cass_cluster_set_pending_requests_high_water_mark(CassCluster* cluster,
-                                                  unsigned num_requests));
+CASS_EXPORT CassError
+cass_cluster_set_request_arena_size(CassCluster* cluster,
+                                    unsigned size);
 
 /**
- * Sets the low water mark for the number of requests queued waiting
- * for a connection in a connection pool. After exceeding high water mark
- * requests, writes to a host will only resume once the number of requests
- * fall below this value.
+ * Sets the size of the fixed size queue that stores
+ * events.
  *
- * <b>Default:</b> 128
+ * <b>Default:</b> 8192
  *
  * @public @memberof CassCluster
  *
@@ -1981,3124 +2850,6163 @@ cass_cluster_set_pending_requests_high_water_mark(CassCluster* cluster,
  * removed in a future release.
  *
  * @param[in] cluster
- * @param[in] num_requests
+ * @param[in] queue_size
  * @return CASS_OK if successful, otherwise an error occurred.
  */
 CASS_EXPORT CASS_DEPRECATED(CassError
-cass_cluster_set_pending_requests_low_water_mark(CassCluster* cluster,
-                                                 unsigned num_requests));
+cass_cluster_set_queue_size_event(CassCluster* cluster,
+                                  unsigned queue_size));
 
 /**
- * Sets the timeout for connecting to a node.
+ * Sets the number of connections made to each server in each
+ * IO thread.
  *
- * <b>Default:</b> 5000 milliseconds
+ * <b>Default:</b> 1
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] timeout_ms Connect timeout in milliseconds
+ * @param[in] num_connections
+ * @return CASS_OK if successful, otherwise an error occurred.
  */
-CASS_EXPORT void
-cass_cluster_set_connect_timeout(CassCluster* cluster,
-                                 unsigned timeout_ms);
+CASS_EXPORT CassError
+cass_cluster_set_core_connections_per_host(CassCluster* cluster,
+                                           unsigned num_connections);
 
 /**
- * Sets the timeout for waiting for a response from a node.
+ * Sets the number of connections made to each remote server in each IO
+ * thread. A server is remote if the load balancing policies don't consider
+ * it local, e.g. the servers of other data centers with the DC-aware policy,
+ * or the servers of other racks and data centers with the rack-aware policy.
  *
- * <b>Default:</b> 12000 milliseconds
+ * <b>Default:</b> The number of connections per host set by
+ * cass_cluster_set_core_connections_per_host().
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] timeout_ms Request timeout in milliseconds. Use 0 for no timeout.
+ * @param[in] num_connections
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_core_connections_per_host()
+ * @see cass_cluster_set_lazy_remote_pools()
  */
-CASS_EXPORT void
-cass_cluster_set_request_timeout(CassCluster* cluster,
-                                 unsigned timeout_ms);
+CASS_EXPORT CassError
+cass_cluster_set_core_connections_per_remote_host(CassCluster* cluster,
+                                                  unsigned num_connections);
 
 /**
- * Sets the timeout for waiting for DNS name resolution.
+ * Sets the maximum number of connections made to each server in each
+ * IO thread. When this is larger than the core number of connections, a pool
+ * grows while its connections stay above the threshold set by
+ * cass_cluster_set_max_concurrent_requests_threshold() and shrinks back to
+ * the core number of connections once the extra connections are idle.
  *
- * <b>Default:</b> 2000 milliseconds
+ * <b>Default:</b> 0 (the pool is never grown beyond the core connections)
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] timeout_ms Request timeout in milliseconds
+ * @param[in] num_connections
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_core_connections_per_host()
  */
-CASS_EXPORT void
-cass_cluster_set_resolve_timeout(CassCluster* cluster,
-                                 unsigned timeout_ms);
+CASS_EXPORT CassError
+cass_cluster_set_max_connections_per_host(CassCluster* cluster,
+                                          unsigned num_connections);
 
 /**
- * Sets the maximum time to wait for schema agreement after a schema change
- * is made (e.g. creating, altering, dropping a table/keyspace/view/index etc).
- *
- * <b>Default:</b> 10000 milliseconds
+ * Sets the amount of time to wait before attempting to reconnect.
  *
  * @public @memberof CassCluster
  *
+ * @deprecated This is being replaced with cass_cluster_set_constant_reconnect().
+ * Expect this to be removed in a future release.
+ *
  * @param[in] cluster
- * @param[in] wait_time_ms Wait time in milliseconds
+ * @param[in] wait_time
  */
-CASS_EXPORT void
-cass_cluster_set_max_schema_wait_time(CassCluster* cluster,
-                                      unsigned wait_time_ms);
-
+CASS_EXPORT CASS_DEPRECATED(void
+cass_cluster_set_reconnect_wait_time(CassCluster* cluster,
+                                     unsigned wait_time));
 
 /**
- * Sets the maximum time to wait for tracing data to become available.
+ * Configures the cluster to use a reconnection policy that waits a constant
+ * time between each reconnection attempt.
  *
- * <b>Default:</b> 15 milliseconds
+ * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] max_wait_time_ms
+ * @param[in] delay_ms Time in milliseconds to delay attempting a reconnection;
+ * 0 to perform a reconnection immediately.
  */
 CASS_EXPORT void
-cass_cluster_set_tracing_max_wait_time(CassCluster* cluster,
-                                       unsigned max_wait_time_ms);
+cass_cluster_set_constant_reconnect(CassCluster* cluster,
+                                    cass_uint64_t delay_ms);
 
 /**
- * Sets the amount of time to wait between attempts to check to see if tracing is
- * available.
+ * Configures the cluster to use a reconnection policy that waits exponentially
+ * longer between each reconnection attempt; however will maintain a constant
+ * delay once the maximum delay is reached.
  *
- * <b>Default:</b> 3 milliseconds
+ * <b>Default:</b>
+ * <ul>
+ *   <li>2000 milliseconds base delay</li>
+ *   <li>60000 milliseconds max delay</li>
+ * </ul>
+ *
+ * <p>
+ *   <b>Note:</b> A random amount of jitter (+/- 15%) will be added to the pure
+ *   exponential delay value. This helps to prevent situations where multiple
+ *   connections are in the reconnection process at exactly the same time. The
+ *   jitter will never cause the delay to be less than the base delay, or more
+ *   than the max delay.
+ * </p>
+ *
+ * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] retry_wait_time_ms
+ * @param[in] base_delay_ms The base delay (in milliseconds) to use for
+ * scheduling reconnection attempts.
+ * @param[in] max_delay_ms The maximum delay to wait between two reconnection
+ * attempts.
+ * @return CASS_OK if successful, otherwise error occurred.
  */
-CASS_EXPORT void
-cass_cluster_set_tracing_retry_wait_time(CassCluster* cluster,
-                                         unsigned retry_wait_time_ms);
+CASS_EXPORT CassError
+cass_cluster_set_exponential_reconnect(CassCluster* cluster,
+                                       cass_uint64_t base_delay_ms,
+                                       cass_uint64_t max_delay_ms);
 
 /**
- * Sets the consistency level to use for checking to see if tracing data is
- * available.
+ * Configures the cluster to use a reconnection policy with "decorrelated
+ * jitter": each delay is chosen at random between the base delay and three
+ * times the previous delay, and is never more than the max delay.
  *
- * <b>Default:</b> CASS_CONSISTENCY_ONE
+ * Every I/O thread has its own connection pool to each host. With this policy
+ * the reconnection attempts of the pools to a restarting host spread out over
+ * time instead of staying close together as they do with the exponential
+ * policy's small amount of jitter.
+ *
+ * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] consistency
+ * @param[in] base_delay_ms The base (and minimum) delay in milliseconds.
+ * @param[in] max_delay_ms The maximum delay in milliseconds.
+ * @return CASS_OK if successful, otherwise error occurred.
+ *
+ * @see cass_cluster_set_max_concurrent_connect_attempts_per_host()
  */
-CASS_EXPORT void
-cass_cluster_set_tracing_consistency(CassCluster* cluster,
-                                     CassConsistency consistency);
-
+CASS_EXPORT CassError
+cass_cluster_set_decorrelated_jitter_reconnect(CassCluster* cluster,
+                                               cass_uint64_t base_delay_ms,
+                                               cass_uint64_t max_delay_ms);
 
 /**
- * Sets credentials for plain text authentication.
+ * Sets the maximum number of connection attempts in progress to a single
+ * host, over all the session's connection pools. Pools that reconnect to a
+ * host while the limit is reached wait for an attempt to finish. This avoids
+ * opening all of the session's connections to a restarting host at once.
+ *
+ * <b>Default:</b> 0 (no limit)
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] username
- * @param[in] password
+ * @param[in] max_attempts The maximum number of attempts or zero for no
+ * limit.
  */
 CASS_EXPORT void
-cass_cluster_set_credentials(CassCluster* cluster,
-                             const char* username,
-                             const char* password);
+cass_cluster_set_max_concurrent_connect_attempts_per_host(CassCluster* cluster,
+                                                           unsigned max_attempts);
 
 /**
- * Same as cass_cluster_set_credentials(), but with lengths for string
- * parameters.
+ * Sets the duration of the warm-up of a host that's reconnected after being
+ * down. During the warm-up the share of requests that use the host as their
+ * first choice grows linearly from none to all of them. The other requests
+ * only use the host after the other hosts of their query plan. This gives a
+ * restarted host, with cold caches, time to warm up before it gets its full
+ * share of the traffic.
+ *
+ * <b>Default:</b> 0 (disabled)
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] username
- * @param[in] username_length
- * @param[in] password
- * @param[in] password_length
- * @return same as cass_cluster_set_credentials()
- *
- * @see cass_cluster_set_credentials();
+ * @param[in] duration_ms The warm-up duration in milliseconds or zero to
+ * disable warm-ups.
  */
 CASS_EXPORT void
-cass_cluster_set_credentials_n(CassCluster* cluster,
-                               const char* username,
-                               size_t username_length,
-                               const char* password,
-                               size_t password_length);
+cass_cluster_set_host_warmup_duration(CassCluster* cluster,
+                                      cass_uint64_t duration_ms);
 
 /**
- * Configures the cluster to use round-robin load balancing.
+ * Sets the number of warm-up requests sent on each connection of a new
+ * connection pool before the pool is used. New connections start with small
+ * TCP congestion windows and a restarted host has cold caches; the warm-up
+ * requests absorb the first, slower round trips instead of the application's
+ * requests. The requests of a connection are sent concurrently and failed
+ * warm-up requests don't fail the pool.
  *
- * The driver discovers all nodes in a cluster and cycles through
- * them per request. All are considered 'local'.
+ * <b>Note:</b> Use cass_cluster_set_host_warmup_duration() to also ramp up
+ * the share of the requests sent to a reconnected host.
+ *
+ * <b>Default:</b> 0 (disabled)
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
+ * @param[in] requests_per_connection The number of warm-up requests per
+ * connection or zero to disable warm-ups.
+ * @param[in] query The query of the warm-up requests or NULL to send OPTIONS
+ * requests, which don't touch the host's storage.
+ *
+ * @see cass_cluster_set_host_warmup_duration()
  */
 CASS_EXPORT void
-cass_cluster_set_load_balance_round_robin(CassCluster* cluster);
+cass_cluster_set_connection_warmup(CassCluster* cluster,
+                                   unsigned requests_per_connection,
+                                   const char* query);
 
 /**
- * Configures the cluster to use DC-aware load balancing.
- * For each query, all live nodes in a primary 'local' DC are tried first,
- * followed by any node from other DCs.
- *
- * <b>Note:</b> This is the default, and does not need to be called unless
- * switching an existing from another policy or changing settings.
- * Without further configuration, a default local_dc is chosen from the
- * first connected contact point, and no remote hosts are considered in
- * query plans. If relying on this mechanism, be sure to use only contact
- * points from the local DC.
- *
- * @deprecated The remote DC settings for DC-aware are not suitable for most
- * scenarios that require DC failover. There is also unhandled gap between
- * replication factor number of nodes failing and the full cluster failing. Only
- * the remote DC settings are being deprecated.
+ * Same as cass_cluster_set_connection_warmup(), but with lengths for string
+ * parameters.
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] local_dc The primary data center to try first
- * @param[in] used_hosts_per_remote_dc The number of hosts used in each remote
- * DC if no hosts are available in the local dc (<b>deprecated</b>)
- * @param[in] allow_remote_dcs_for_local_cl Allows remote hosts to be used if no
- * local dc hosts are available and the consistency level is LOCAL_ONE or
- * LOCAL_QUORUM (<b>deprecated</b>)
- * @return CASS_OK if successful, otherwise an error occurred
+ * @param[in] requests_per_connection
+ * @param[in] query
+ * @param[in] query_length
+ *
+ * @see cass_cluster_set_connection_warmup()
  */
-CASS_EXPORT CassError
-cass_cluster_set_load_balance_dc_aware(CassCluster* cluster,
-                                       const char* local_dc,
-                                       unsigned used_hosts_per_remote_dc,
-                                       cass_bool_t allow_remote_dcs_for_local_cl);
-
+CASS_EXPORT void
+cass_cluster_set_connection_warmup_n(CassCluster* cluster,
+                                     unsigned requests_per_connection,
+                                     const char* query,
+                                     size_t query_length);
 
 /**
- * Same as cass_cluster_set_load_balance_dc_aware(), but with lengths for string
- * parameters.
+ * Enable/Disable shard awareness. Some hosts partition their data per CPU
+ * core (shard) and advertise their sharding when a connection is opened. If
+ * enabled, the connection pool of such a host keeps a connection per shard,
+ * instead of the core number of connections, and a request is written to the
+ * connection of the shard that owns its partition. This avoids forwarding the
+ * request between the host's cores.
  *
- * @deprecated The remote DC settings for DC-aware are not suitable for most
- * scenarios that require DC failover. There is also unhandled gap between
- * replication factor number of nodes failing and the full cluster failing. Only
- * the remote DC settings are being deprecated.
+ * If the host has a shard-aware port then the connections are opened to that
+ * port from a local port that selects their shard. Otherwise, the host
+ * assigns the connections to its shards and some shards might not have a
+ * connection.
+ *
+ * <b>Note:</b> Hosts that don't advertise a sharding aren't affected.
+ *
+ * <b>Default:</b> cass_true (enabled).
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] local_dc
- * @param[in] local_dc_length
- * @param[in] used_hosts_per_remote_dc (<b>deprecated</b>)
- * @param[in] allow_remote_dcs_for_local_cl (<b>deprecated</b>)
- * @return same as cass_cluster_set_load_balance_dc_aware()
+ * @param[in] enabled
  *
- * @see cass_cluster_set_load_balance_dc_aware()
+ * @see cass_cluster_set_core_connections_per_host()
  */
-CASS_EXPORT CassError
-cass_cluster_set_load_balance_dc_aware_n(CassCluster* cluster,
-                                         const char* local_dc,
-                                         size_t local_dc_length,
-                                         unsigned used_hosts_per_remote_dc,
-                                         cass_bool_t allow_remote_dcs_for_local_cl);
+CASS_EXPORT void
+cass_cluster_set_shard_awareness(CassCluster* cluster,
+                                 cass_bool_t enabled);
 
 /**
- * Configures the cluster to use Rack-aware load balancing.
- * For each query, all live nodes in a primary 'local' rack are tried first,
- * followed by nodes from local DC and then nodes from other DCs.
+ * Sets the interval between probes of hosts that are down. A probe is a
+ * single connection to the host that's closed as soon as the host answers
+ * its OPTIONS and STARTUP requests. When a probe succeeds the connection
+ * pools immediately attempt to reconnect to the host instead of waiting for
+ * their next scheduled reconnection attempt, which can be a long time after
+ * a short outage when the reconnection delays have grown.
  *
- * With empty local_rack and local_dc,  default local_dc and local_rack
- * is chosen from the first connected contact point,
- * and no remote hosts are considered in query plans.
- * If relying on this mechanism, be sure to use only contact
- * points from the local rack.
+ * <b>Default:</b> 0 (disabled)
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] local_dc The primary data center to try first
- * @param[in] local_rack The primary rack to try first
- * @return CASS_OK if successful, otherwise an error occurred
+ * @param[in] interval_ms The probe interval in milliseconds or zero to
+ * disable probes.
  */
-CASS_EXPORT CassError
-cass_cluster_set_load_balance_rack_aware(CassCluster* cluster,
-                                       const char* local_dc,
-                                       const char* local_rack);
-
+CASS_EXPORT void
+cass_cluster_set_host_probe_interval(CassCluster* cluster,
+                                     unsigned interval_ms);
 
 /**
- * Same as cass_cluster_set_load_balance_rack_aware(), but with lengths for string
- * parameters.
+ * Sets the window used to coalesce bursts of node and schema change events
+ * from the control connection, such as the ones sent during a rolling
+ * restart. The refreshes of new or moved nodes received during the window
+ * are done with a single query of the peers table, repeated changes to the
+ * same schema object are refreshed once, and the token map is rebuilt and
+ * handed to the I/O threads at most once per window.
+ *
+ * <b>Default:</b> 0 (disabled, events are handled as soon as they're received)
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] local_dc
- * @param[in] local_dc_length
- * @return same as cass_cluster_set_load_balance_dc_aware()
- *
- * @see cass_cluster_set_load_balance_dc_aware()
+ * @param[in] window_ms The window in milliseconds or zero to disable
+ * coalescing.
  */
-CASS_EXPORT CassError
-cass_cluster_set_load_balance_rack_aware_n(CassCluster* cluster,
-                                         const char* local_dc,
-                                         size_t local_dc_length,
-                                         const char* local_rack,
-                                         size_t local_rack_length);
+CASS_EXPORT void
+cass_cluster_set_event_debounce_window(CassCluster* cluster,
+                                       unsigned window_ms);
 
 /**
- * Configures the cluster to use token-aware request routing or not.
- *
- * <b>Important:</b> Token-aware routing depends on keyspace metadata.
- * For this reason enabling token-aware routing will also enable retrieving
- * and updating keyspace schema metadata.
- *
- * <b>Default:</b> cass_true (enabled).
+ * Sets the amount of time, in microseconds, to wait for new requests to
+ * coalesce into a single system call. This should be set to a value around
+ * the latency SLA of your application's requests while also considering the
+ * request's roundtrip time. Larger values should be used for throughput
+ * bound workloads and lower values should be used for latency bound
+ * workloads.
  *
- * This routing policy composes the base routing policy, routing
- * requests first to replicas on nodes considered 'local' by
- * the base load balancing policy.
+ * <b>Default:</b> 200 us
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] enabled
+ * @param[in] delay_us
+ * @return CASS_OK if successful, otherwise an error occurred.
  */
-CASS_EXPORT void
-cass_cluster_set_token_aware_routing(CassCluster* cluster,
-                                     cass_bool_t enabled);
-
+CASS_EXPORT CassError
+cass_cluster_set_coalesce_delay(CassCluster* cluster,
+                                cass_int64_t delay_us);
 
 /**
- * Configures token-aware routing to randomly shuffle replicas. This can reduce
- * the effectiveness of server-side caching, but it can better distribute load over
- * replicas for a given partition key.
- *
- * <b>Note:</b> Token-aware routing must be enabled for the setting to
- * be applicable.
+ * Sets the ratio of time spent processing new requests versus handling the I/O
+ * and processing of outstanding requests. The range of this setting is 1 to 100,
+ * where larger values allocate more time to processing new requests and smaller
+ * values allocate more time to processing outstanding requests.
  *
- * <b>Default:</b> cass_true (enabled).
+ * <b>Default:</b> 50
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] enabled
+ * @param[in] ratio
+ * @return CASS_OK if successful, otherwise an error occurred.
  */
-CASS_EXPORT void
-cass_cluster_set_token_aware_routing_shuffle_replicas(CassCluster* cluster,
-                                                      cass_bool_t enabled);
+CASS_EXPORT CassError
+cass_cluster_set_new_request_ratio(CassCluster* cluster,
+                                   cass_int32_t ratio);
 
 /**
- * Configures the cluster to use latency-aware request routing or not.
- *
- * <b>Default:</b> cass_false (disabled).
+ * Sets how the amount of time to wait for new requests to coalesce is
+ * determined. The fixed mode always waits for the delay set by
+ * cass_cluster_set_coalesce_delay(). The adaptive mode shrinks the delay when
+ * the load is low, to avoid adding latency, and grows it when requests are
+ * backing up, to get larger writes, while staying within the latency budget
+ * set by cass_cluster_set_coalesce_latency_budget().
  *
- * This routing policy is a top-level routing policy. It uses the
- * base routing policy to determine locality (dc-aware) and/or
- * placement (token-aware) before considering the latency.
+ * <b>Default:</b> CASS_COALESCE_MODE_FIXED
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] enabled
+ * @param[in] mode
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_coalesce_delay()
+ * @see cass_cluster_set_coalesce_latency_budget()
  */
-CASS_EXPORT void
-cass_cluster_set_latency_aware_routing(CassCluster* cluster,
-                                       cass_bool_t enabled);
+CASS_EXPORT CassError
+cass_cluster_set_coalesce_mode(CassCluster* cluster,
+                               CassCoalesceMode mode);
 
 /**
- * Configures the settings for latency-aware request routing.
- *
- * <b>Defaults:</b>
+ * Sets the target p99 latency budget, in microseconds, that's spent
+ * coalescing and writing new requests when using the adaptive coalesce mode.
+ * The coalesce delay never exceeds half of this budget.
  *
- * <ul>
- *   <li>exclusion_threshold: 2.0</li>
- *   <li>scale_ms: 100 milliseconds</li>
- *   <li>retry_period_ms: 10,000 milliseconds (10 seconds)</li>
- *   <li>update_rate_ms: 100 milliseconds</li>
- *   <li>min_measured: 50</li>
- * </ul>
+ * <b>Default:</b> 2000 us
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] exclusion_threshold Controls how much worse the latency must be compared to the
- * average latency of the best performing node before it penalized.
- * @param[in] scale_ms Controls the weight given to older latencies when calculating the average
- * latency of a node. A bigger scale will give more weight to older latency measurements.
- * @param[in] retry_period_ms The amount of time a node is penalized by the policy before
- * being given a second chance when the current average latency exceeds the calculated
- * threshold (exclusion_threshold * best_average_latency).
- * @param[in] update_rate_ms The rate at  which the best average latency is recomputed.
- * @param[in] min_measured The minimum number of measurements per-host required to
- * be considered by the policy.
+ * @param[in] budget_us
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_coalesce_mode()
  */
-CASS_EXPORT void
-cass_cluster_set_latency_aware_routing_settings(CassCluster* cluster,
-                                                cass_double_t exclusion_threshold,
-                                                cass_uint64_t scale_ms,
-                                                cass_uint64_t retry_period_ms,
-                                                cass_uint64_t update_rate_ms,
-                                                cass_uint64_t min_measured);
+CASS_EXPORT CassError
+cass_cluster_set_coalesce_latency_budget(CassCluster* cluster,
+                                         cass_uint64_t budget_us);
 
 /**
- * Sets/Appends whitelist hosts. The first call sets the whitelist hosts and
- * any subsequent calls appends additional hosts. Passing an empty string will
- * clear and disable the whitelist. White space is striped from the hosts.
- *
- * This policy filters requests to all other policies, only allowing requests
- * to the hosts contained in the whitelist. Any host not in the whitelist will
- * be ignored and a connection will not be established. This policy is useful
- * for ensuring that the driver will only connect to a predefined set of hosts.
+ * Sets the maximum number of connections that will be created concurrently.
+ * Connections are created when the current connections are unable to keep up with
+ * request throughput.
  *
- * Examples: "127.0.0.1" "127.0.0.1,127.0.0.2"
+ * <b>Default:</b> 1
  *
  * @public @memberof CassCluster
  *
+ * @deprecated This is no longer useful and does nothing. Expect this to be
+ * removed in a future release.
+ *
  * @param[in] cluster
- * @param[in] hosts A comma delimited list of addresses. An empty string will
- * clear the whitelist hosts. The string is copied into the cluster
- * configuration; the memory pointed to by this parameter can be freed after
- * this call.
+ * @param[in] num_connections
+ * @return CASS_OK if successful, otherwise an error occurred.
  */
-CASS_EXPORT void
-cass_cluster_set_whitelist_filtering(CassCluster* cluster,
-                                     const char* hosts);
+CASS_EXPORT CASS_DEPRECATED(CassError
+cass_cluster_set_max_concurrent_creation(CassCluster* cluster,
+                                         unsigned num_connections));
 
 /**
- * Same as cass_cluster_set_whitelist_filtering(), but with lengths for
- * string parameters.
+ * Sets the threshold for the average number of concurrent requests in-flight
+ * on a pool's connections before creating a new connection. The number of
+ * connections created will not exceed max_connections_per_host.
+ *
+ * <b>Default:</b> 100
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] hosts
- * @param[in] hosts_length
- * @return same as cass_cluster_set_whitelist_filtering()
+ * @param[in] num_requests
+ * @return CASS_OK if successful, otherwise an error occurred.
  *
- * @see cass_cluster_set_whitelist_filtering()
+ * @see cass_cluster_set_max_connections_per_host()
  */
-CASS_EXPORT void
-cass_cluster_set_whitelist_filtering_n(CassCluster* cluster,
-                                       const char* hosts,
-                                       size_t hosts_length);
+CASS_EXPORT CassError
+cass_cluster_set_max_concurrent_requests_threshold(CassCluster* cluster,
+                                                   unsigned num_requests);
 
 /**
- * Sets/Appends blacklist hosts. The first call sets the blacklist hosts and
- * any subsequent calls appends additional hosts. Passing an empty string will
- * clear and disable the blacklist. White space is striped from the hosts.
- *
- * This policy filters requests to all other policies, only allowing requests
- * to the hosts not contained in the blacklist. Any host in the blacklist will
- * be ignored and a connection will not be established. This policy is useful
- * for ensuring that the driver will not connect to a predefined set of hosts.
+ * Sets the maximum number of requests processed by an IO worker
+ * per flush.
  *
- * Examples: "127.0.0.1" "127.0.0.1,127.0.0.2"
+ * <b>Default:</b> 128
  *
  * @public @memberof CassCluster
  *
+ * @deprecated This is no longer useful and does nothing. Expect this to be
+ * removed in a future release.
+ *
  * @param[in] cluster
- * @param[in] hosts A comma delimited list of addresses. An empty string will
- * clear the blacklist hosts. The string is copied into the cluster
- * configuration; the memory pointed to by this parameter can be freed after
- * this call.
+ * @param[in] num_requests
+ * @return CASS_OK if successful, otherwise an error occurred.
  */
-CASS_EXPORT void
-cass_cluster_set_blacklist_filtering(CassCluster* cluster,
-                                     const char* hosts);
+CASS_EXPORT CASS_DEPRECATED(CassError
+cass_cluster_set_max_requests_per_flush(CassCluster* cluster,
+                                        unsigned num_requests));
 
 /**
- * Same as cass_cluster_set_blacklist_filtering_hosts(), but with lengths for
- * string parameters.
+ * Sets the high water mark for the number of bytes outstanding
+ * on a connection. Disables writes to a connection if the number
+ * of bytes queued exceed this value.
+ *
+ * <b>Default:</b> 64 KB
  *
  * @public @memberof CassCluster
  *
- * @param[in] cluster
- * @param[in] hosts
- * @param[in] hosts_length
- * @return same as cass_cluster_set_blacklist_filtering()
+ * @deprecated This is no longer useful and does nothing. Expect this to be
+ * removed in a future release.
  *
- * @see cass_cluster_set_blacklist_filtering()
+ * @param[in] cluster
+ * @param[in] num_bytes
+ * @return CASS_OK if successful, otherwise an error occurred.
  */
-CASS_EXPORT void
-cass_cluster_set_blacklist_filtering_n(CassCluster* cluster,
-                                       const char* hosts,
-                                       size_t hosts_length);
+CASS_EXPORT CASS_DEPRECATED(CassError
+cass_cluster_set_write_bytes_high_water_mark(CassCluster* cluster,
+                                             unsigned num_bytes));
 
 /**
- * Same as cass_cluster_set_whitelist_filtering(), but whitelist all hosts of a dc
+ * Sets the low water mark for number of bytes outstanding on a
+ * connection. After exceeding high water mark bytes, writes will
+ * only resume once the number of bytes fall below this value.
  *
- * Examples: "dc1", "dc1,dc2"
+ * <b>Default:</b> 32 KB
  *
  * @public @memberof CassCluster
  *
- * @param[in] cluster
- * @param[in] dcs A comma delimited list of dcs. An empty string will clear the
- * whitelist dcs. The string is copied into the cluster configuration; the
- * memory pointed to by this parameter can be freed after this call.
- */
-CASS_EXPORT void
-cass_cluster_set_whitelist_dc_filtering(CassCluster* cluster,
-                                        const char* dcs);
-
-/**
- * Same as cass_cluster_set_whitelist_dc_filtering(), but with lengths for
- * string parameters.
- *
- * @public @memberof CassCluster
+ * @deprecated This is no longer useful and does nothing. Expect this to be
+ * removed in a future release.
  *
  * @param[in] cluster
- * @param[in] dcs
- * @param[in] dcs_length
- * @return same as cass_cluster_set_whitelist_dc_filtering()
- *
- * @see cass_cluster_set_whitelist_dc_filtering()
+ * @param[in] num_bytes
+ * @return CASS_OK if successful, otherwise an error occurred.
  */
-CASS_EXPORT void
-cass_cluster_set_whitelist_dc_filtering_n(CassCluster* cluster,
-                                          const char* dcs,
-                                          size_t dcs_length);
+CASS_EXPORT CASS_DEPRECATED(CassError
+cass_cluster_set_write_bytes_low_water_mark(CassCluster* cluster,
+                                            unsigned num_bytes));
 
 /**
- * Same as cass_cluster_set_blacklist_filtering(), but blacklist all hosts of a dc
+ * Sets the high water mark for the number of requests queued waiting
+ * for a connection in a connection pool. Disables writes to a
+ * host on an IO worker if the number of requests queued exceed this
+ * value.
  *
- * Examples: "dc1", "dc1,dc2"
+ * <b>Default:</b> 256
  *
  * @public @memberof CassCluster
  *
+ * @deprecated This is no longer useful and does nothing. Expect this to be
+ * removed in a future release.
+ *
  * @param[in] cluster
- * @param[in] dcs A comma delimited list of dcs. An empty string will clear the
- * blacklist dcs. The string is copied into the cluster configuration; the
- * memory pointed to by this parameter can be freed after this call.
+ * @param[in] num_requests
+ * @return CASS_OK if successful, otherwise an error occurred.
  */
-CASS_EXPORT void
-cass_cluster_set_blacklist_dc_filtering(CassCluster* cluster,
-                                        const char* dcs);
+CASS_EXPORT CASS_DEPRECATED(CassError
+cass_cluster_set_pending_requests_high_water_mark(CassCluster* cluster,
+                                                  unsigned num_requests));
 
 /**
- * Same as cass_cluster_set_blacklist_dc_filtering(), but with lengths for
- * string parameters.
+ * Sets the low water mark for the number of requests queued waiting
+ * for a connection in a connection pool. After exceeding high water mark
+ * requests, writes to a host will only resume once the number of requests
+ * fall below this value.
+ *
+ * <b>Default:</b> 128
  *
  * @public @memberof CassCluster
  *
- * @param[in] cluster
- * @param[in] dcs
- * @param[in] dcs_length
- * @return same as cass_cluster_set_blacklist_dc_filtering()
+ * @deprecated This is no longer useful and does nothing. Expect this to be
+ * removed in a future release.
  *
- * @see cass_cluster_set_blacklist_dc_filtering()
+ * @param[in] cluster
+ * @param[in] num_requests
+ * @return CASS_OK if successful, otherwise an error occurred.
  */
-CASS_EXPORT void
-cass_cluster_set_blacklist_dc_filtering_n(CassCluster* cluster,
-                                          const char* dcs,
-                                          size_t dcs_length);
+CASS_EXPORT CASS_DEPRECATED(CassError
+cass_cluster_set_pending_requests_low_water_mark(CassCluster* cluster,
+                                                 unsigned num_requests));
 
 /**
- * Enable/Disable Nagle's algorithm on connections.
+ * Sets the maximum number of bytes that can be outstanding on a connection.
+ * These are the bytes of the requests written to the connection that haven't
+ * been written to the network yet, e.g. because the host isn't reading them
+ * fast enough. A request isn't written to a connection that is over this
+ * limit. It's sent to the next host of its query plan instead, and it fails
+ * with CASS_ERROR_LIB_NO_HOSTS_AVAILABLE if every host is saturated.
  *
- * <b>Default:</b> cass_true (disables Nagle's algorithm).
+ * This replaces the deprecated write bytes and pending requests high water
+ * marks.
+ *
+ * <b>Default:</b> 0 (No limit)
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] enabled
+ * @param[in] num_bytes The maximum number of outstanding bytes or 0 for no
+ * limit.
  */
 CASS_EXPORT void
-cass_cluster_set_tcp_nodelay(CassCluster* cluster,
-                             cass_bool_t enabled);
+cass_cluster_set_max_outstanding_write_bytes_per_connection(CassCluster* cluster,
+                                                            unsigned num_bytes);
 
 /**
- * Enable/Disable TCP keep-alive
+ * Sets the timeout for connecting to a node.
  *
- * <b>Default:</b> cass_false (disabled).
+ * <b>Default:</b> 5000 milliseconds
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] enabled
- * @param[in] delay_secs The initial delay in seconds, ignored when
- * `enabled` is false.
+ * @param[in] timeout_ms Connect timeout in milliseconds
  */
 CASS_EXPORT void
-cass_cluster_set_tcp_keepalive(CassCluster* cluster,
-                               cass_bool_t enabled,
-                               unsigned delay_secs);
+cass_cluster_set_connect_timeout(CassCluster* cluster,
+                                 unsigned timeout_ms);
+
 /**
- * Sets the timestamp generator used to assign timestamps to all requests
- * unless overridden by setting the timestamp on a statement or a batch.
- *
- * <b>Default:</b> Monotonically increasing, client-side timestamp generator.
+ * Sets the timeout for waiting for a response from a node.
  *
- * @cassandra{2.1+}
+ * <b>Default:</b> 12000 milliseconds
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] timestamp_gen
- *
- * @see cass_statement_set_timestamp()
- * @see cass_batch_set_timestamp()
+ * @param[in] timeout_ms Request timeout in milliseconds. Use 0 for no timeout.
  */
 CASS_EXPORT void
-cass_cluster_set_timestamp_gen(CassCluster* cluster,
-                               CassTimestampGen* timestamp_gen);
+cass_cluster_set_request_timeout(CassCluster* cluster,
+                                 unsigned timeout_ms);
 
 /**
- * Sets the amount of time between heartbeat messages and controls the amount
- * of time the connection must be idle before sending heartbeat messages. This
- * is useful for preventing intermediate network devices from dropping
- * connections.
+ * Sets the timeout for waiting for DNS name resolution.
  *
- * <b>Default:</b> 30 seconds
+ * <b>Default:</b> 2000 milliseconds
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] interval_secs Use 0 to disable heartbeat messages
+ * @param[in] timeout_ms Request timeout in milliseconds
  */
 CASS_EXPORT void
-cass_cluster_set_connection_heartbeat_interval(CassCluster* cluster,
-                                               unsigned interval_secs);
+cass_cluster_set_resolve_timeout(CassCluster* cluster,
+                                 unsigned timeout_ms);
 
 /**
- * Sets the amount of time a connection is allowed to be without a successful
- * heartbeat response before being terminated and scheduled for reconnection.
+ * Sets the time a closing session waits for its in-flight and queued
+ * requests to finish before its connections are closed anyway. The requests
+ * that haven't been started by then fail with
+ * CASS_ERROR_LIB_REQUEST_TIMED_OUT and the requests still waiting for a
+ * response fail once their connections are closed. This bounds the time it
+ * takes to close a session, and to free it, when requests are slow or have
+ * no request timeout.
  *
- * <b>Default:</b> 60 seconds
+ * <b>Default:</b> 0 (Wait for all the requests to finish.)
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] timeout_secs
+ * @param[in] timeout_ms Close timeout in milliseconds. Use 0 for no timeout.
+ *
+ * @see cass_session_close()
+ * @see cass_cluster_set_request_timeout()
  */
 CASS_EXPORT void
-cass_cluster_set_connection_idle_timeout(CassCluster* cluster,
-                                         unsigned timeout_secs);
+cass_cluster_set_close_timeout(CassCluster* cluster,
+                               unsigned timeout_ms);
 
 /**
- * Sets the retry policy used for all requests unless overridden by setting
- * a retry policy on a statement or a batch.
+ * Sets the time the connections to a host that's removed from the cluster
+ * are drained before they're closed. New requests are no longer sent to
+ * the host, but the requests already written to its connections are given
+ * this long to finish. The connections are closed as soon as they have no
+ * more requests in-flight and the requests that are still in-flight once
+ * the timeout expires are failed (or retried on the next host if they're
+ * idempotent).
  *
- * <b>Default:</b> The same policy as would be created by the function:
- * cass_retry_policy_default_new(). This policy will retry on a read timeout
- * if there was enough replicas, but no data present, on a write timeout if a
- * logged batch request failed to write the batch log, and on a unavailable
- * error it retries using a new host. In all other cases the default policy
- * will return an error.
+ * <b>Default:</b> 0 (Close the connections immediately.)
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] retry_policy
+ * @param[in] timeout_ms Drain timeout in milliseconds. Use 0 to close the
+ * connections immediately.
  *
- * @see cass_retry_policy_default_new()
- * @see cass_statement_set_retry_policy()
- * @see cass_batch_set_retry_policy()
+ * @see cass_cluster_set_close_timeout()
  */
 CASS_EXPORT void
-cass_cluster_set_retry_policy(CassCluster* cluster,
-                              CassRetryPolicy* retry_policy);
+cass_cluster_set_host_drain_timeout(CassCluster* cluster,
+                                    unsigned timeout_ms);
 
 /**
- * Enable/Disable retrieving and updating schema metadata. If disabled
- * this is allows the driver to skip over retrieving and updating schema
- * metadata and cass_session_get_schema_meta() will always return an empty object.
- * This can be useful for reducing the startup overhead of short-lived sessions.
+ * Enables connecting the connection pools of remote hosts on first use.
+ * The hosts that all of the load balancing policies consider remote (e.g.
+ * the hosts of other datacenters with the DC-aware policy) aren't connected
+ * when the session connects. A remote host's pool is connected the first
+ * time a request's query plan reaches the host, usually because the local
+ * hosts are unavailable, and the request moves on to the next host of its
+ * query plan while the pool connects. If an idle timeout is set, a remote
+ * host's pool is closed again once it hasn't been used for that long.
  *
- * <b>Default:</b> cass_true (enabled).
+ * <b>Default:</b> cass_false (Connect to all hosts when the session
+ * connects.)
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
  * @param[in] enabled
+ * @param[in] idle_timeout_secs The time, in seconds, a remote host's pool is
+ * unused before it's closed. Use 0 to keep the pools open once they're
+ * connected.
  *
- * @see cass_session_get_schema_meta()
+ * @see cass_cluster_set_load_balance_dc_aware()
  */
 CASS_EXPORT void
-cass_cluster_set_use_schema(CassCluster* cluster,
-                            cass_bool_t enabled);
+cass_cluster_set_lazy_remote_pools(CassCluster* cluster,
+                                   cass_bool_t enabled,
+                                   unsigned idle_timeout_secs);
 
 /**
- * Enable/Disable retrieving hostnames for IP addresses using reverse IP lookup.
+ * Sets the time the results of DNS name resolution are cached. This includes
+ * the addresses of contact points and other hostnames and, if hostname
+ * resolution is enabled, the hostnames of the hosts' addresses. Failed
+ * lookups are cached for a separate time so that an unresolvable name
+ * doesn't cause a slow lookup for every reconnection attempt. Timed out
+ * lookups aren't cached.
  *
- * @deprecated Do not use. Using reverse DNS lookup to verify the certificate
- * does not protect against man-in-the-middle attacks. 
+ * The cache is shared by the sessions connected using the cluster object.
  *
- * <b>Default:</b> cass_false (disabled).
+ * <b>Default:</b> 0, 0 (Disabled. Every lookup is resolved.)
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] enabled
- * @return CASS_OK if successful, otherwise an error occurred
+ * @param[in] ttl_ms The time successful lookups are cached in milliseconds.
+ * @param[in] negative_ttl_ms The time failed lookups are cached in
+ * milliseconds.
  *
  * @see cass_cluster_set_resolve_timeout()
+ * @see cass_cluster_set_use_hostname_resolution()
  */
-CASS_EXPORT CASS_DEPRECATED(CassError
-cass_cluster_set_use_hostname_resolution(CassCluster* cluster,
-                                         cass_bool_t enabled));
+CASS_EXPORT void
+cass_cluster_set_resolve_cache_ttl(CassCluster* cluster,
+                                   unsigned ttl_ms,
+                                   unsigned negative_ttl_ms);
 
 /**
- * Enable/Disable the randomization of the contact points list.
- *
- * <b>Default:</b> cass_true (enabled).
+ * Sets the maximum time to wait for schema agreement after a schema change
+ * is made (e.g. creating, altering, dropping a table/keyspace/view/index etc).
  *
- * <b>Important:</b> This setting should only be disabled for debugging or
- * tests.
+ * <b>Default:</b> 10000 milliseconds
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] enabled
- * @return CASS_OK if successful, otherwise an error occurred
+ * @param[in] wait_time_ms Wait time in milliseconds
  */
-CASS_EXPORT CassError
-cass_cluster_set_use_randomized_contact_points(CassCluster* cluster,
-                                               cass_bool_t enabled);
+CASS_EXPORT void
+cass_cluster_set_max_schema_wait_time(CassCluster* cluster,
+                                      unsigned wait_time_ms);
 
 /**
- * Enable constant speculative executions with the supplied settings.
+ * Sets the intervals between the checks for schema agreement after a schema
+ * change. The first check is done right away, the next one after the
+ * initial interval and then the interval doubles after every check, up to
+ * the maximum interval. After the first check only the nodes that didn't
+ * agree yet are queried again.
+ *
+ * <b>Default:</b> 10 milliseconds (initial interval) and 200 milliseconds
+ * (maximum interval)
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] constant_delay_ms
- * @param[in] max_speculative_executions
- * @return CASS_OK if successful, otherwise an error occurred
+ * @param[in] interval_ms The initial interval in milliseconds. Must be
+ * greater than zero.
+ * @param[in] max_interval_ms The maximum interval in milliseconds. Must not
+ * be less than the initial interval.
+ * @return CASS_OK if successful, otherwise an error occurred.
  */
 CASS_EXPORT CassError
-cass_cluster_set_constant_speculative_execution_policy(CassCluster* cluster,
-                                                       cass_int64_t constant_delay_ms,
-                                                       int max_speculative_executions);
+cass_cluster_set_schema_agreement_interval(CassCluster* cluster,
+                                           unsigned interval_ms,
+                                           unsigned max_interval_ms);
+
 
 /**
- * Disable speculative executions
- *
- * <b>Default:</b> This is the default speculative execution policy.
+ * Sets the maximum time to wait for tracing data to become available.
  *
- * @public @memberof CassCluster
+ * <b>Default:</b> 15 milliseconds
  *
  * @param[in] cluster
- * @return CASS_OK if successful, otherwise an error occurred
+ * @param[in] max_wait_time_ms
  */
-CASS_EXPORT CassError
-cass_cluster_set_no_speculative_execution_policy(CassCluster* cluster);
+CASS_EXPORT void
+cass_cluster_set_tracing_max_wait_time(CassCluster* cluster,
+                                       unsigned max_wait_time_ms);
 
 /**
- * Sets the maximum number of "pending write" objects that will be
- * saved for re-use for marshalling new requests. These objects may
- * hold on to a significant amount of memory and reducing the
- * number of these objects may reduce memory usage of the application.
+ * Sets the amount of time to wait between attempts to check to see if tracing is
+ * available.
  *
- * The cost of reducing the value of this setting is potentially slower
- * marshalling of requests prior to sending.
+ * <b>Default:</b> 3 milliseconds
  *
- * <b>Default:</b> Max unsigned integer value
+ * @param[in] cluster
+ * @param[in] retry_wait_time_ms
+ */
+CASS_EXPORT void
+cass_cluster_set_tracing_retry_wait_time(CassCluster* cluster,
+                                         unsigned retry_wait_time_ms);
+
+/**
+ * Sets the consistency level to use for checking to see if tracing data is
+ * available.
  *
- * @public @memberof CassCluster
+ * <b>Default:</b> CASS_CONSISTENCY_ONE
  *
  * @param[in] cluster
- * @param[in] num_objects
- * @return CASS_OK if successful, otherwise an error occurred.
+ * @param[in] consistency
  */
-CASS_EXPORT CassError
-cass_cluster_set_max_reusable_write_objects(CassCluster* cluster,
-                                            unsigned num_objects);
+CASS_EXPORT void
+cass_cluster_set_tracing_consistency(CassCluster* cluster,
+                                     CassConsistency consistency);
 
 /**
- * Associates a named execution profile which can be utilized during execution.
+ * Sets whether the future of a traced request waits for its tracing data to
+ * become available. If disabled, the future is set as soon as the response is
+ * received and the tracing data is waited for in the background. Use
+ * cass_future_tracing_data() to get a future that's set once the tracing data
+ * is available.
  *
- * <b>Note:</b> Once the execution profile is added to a cluster, it is
- * immutable and any changes made to the execution profile must be re-assigned
- * to the cluster before a session connection is established in order for those
- * settings to be utilized during query execution.
+ * <b>Default:</b> cass_true
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] name
- * @param[in] profile
- * @return CASS_OK if successful, otherwise an error occurred
+ * @param[in] enabled
  *
- * @see cass_batch_set_execution_profile()
- * @see cass_statement_set_execution_profile()
+ * @see cass_future_tracing_data()
  */
-CASS_EXPORT CassError
-cass_cluster_set_execution_profile(CassCluster* cluster,
-                                   const char* name,
-                                   CassExecProfile* profile);
+CASS_EXPORT void
+cass_cluster_set_tracing_wait_for_data(CassCluster* cluster,
+                                       cass_bool_t enabled);
 
 /**
- * Same as cass_cluster_add_execution_profile(), but with lengths for string
- * parameters.
+ * Sets the probability that the requests that use the cluster's default
+ * settings are traced. Sampled requests are traced as if
+ * cass_statement_set_tracing() was enabled on their statements. Execution
+ * profiles use this probability unless they set their own.
+ *
+ * <b>Default:</b> 0.0 (never)
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] name
- * @param[in] name_length
- * @param[in] profile
- * @return same as cass_cluster_set_execution_profile()
+ * @param[in] probability A probability between 0.0 (never) and 1.0 (always).
+ * @return CASS_OK if successful, otherwise an error occurred.
  *
- * @see cass_batch_set_execution_profile()
- * @see cass_statement_set_execution_profile()
+ * @see cass_execution_profile_set_tracing_probability()
  */
 CASS_EXPORT CassError
-cass_cluster_set_execution_profile_n(CassCluster* cluster,
-                                     const char* name,
-                                     size_t name_length,
-                                     CassExecProfile* profile);
+cass_cluster_set_tracing_probability(CassCluster* cluster,
+                                     cass_double_t probability);
+
 
 /**
- * Prepare statements on all available hosts.
- *
- * <b>Default:</b> cass_true
+ * Sets credentials for plain text authentication.
  *
  * @public @memberof CassCluster
  *
- * @param cluster
- * @param enabled
- * @return CASS_OK if successful, otherwise an error occurred
+ * @param[in] cluster
+ * @param[in] username
+ * @param[in] password
  */
-CASS_EXPORT CassError
-cass_cluster_set_prepare_on_all_hosts(CassCluster* cluster,
-                                      cass_bool_t enabled);
+CASS_EXPORT void
+cass_cluster_set_credentials(CassCluster* cluster,
+                             const char* username,
+                             const char* password);
 
 /**
- * Enable pre-preparing cached prepared statements when existing hosts become
- * available again or when new hosts are added to the cluster.
+ * Same as cass_cluster_set_credentials(), but with lengths for string
+ * parameters.
  *
- * This can help mitigate request latency when executing prepared statements
- * by avoiding an extra round trip in cases where the statement is
- * unprepared on a freshly started server. The main tradeoff is extra background
- * network traffic is required to prepare the statements on hosts as they become
- * available.
+ * @public @memberof CassCluster
  *
- * <b>Default:</b> cass_true
+ * @param[in] cluster
+ * @param[in] username
+ * @param[in] username_length
+ * @param[in] password
+ * @param[in] password_length
+ * @return same as cass_cluster_set_credentials()
  *
- * @param cluster
- * @param enabled
- * @return CASS_OK if successful, otherwise an error occurred
+ * @see cass_cluster_set_credentials();
  */
-CASS_EXPORT CassError
-cass_cluster_set_prepare_on_up_or_add_host(CassCluster* cluster,
-                                           cass_bool_t enabled);
+CASS_EXPORT void
+cass_cluster_set_credentials_n(CassCluster* cluster,
+                               const char* username,
+                               size_t username_length,
+                               const char* password,
+                               size_t password_length);
 
 /**
- * Enable the <b>NO_COMPACT</b> startup option.
- *
- * This can help facilitate uninterrupted cluster upgrades where tables using
- * <b>COMPACT_STORAGE</b> will operate in "compatibility mode" for
- * <b>BATCH</b>, <b>DELETE</b>, <b>SELECT</b>, and <b>UPDATE</b> CQL operations.
- *
- * <b>Default:</b> cass_false
+ * Configures the cluster to use round-robin load balancing.
  *
- * @cassandra{3.0.16+}
- * @cassandra{3.11.2+}
- * @cassandra{4.0+}
+ * The driver discovers all nodes in a cluster and cycles through
+ * them per request. All are considered 'local'.
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] enabled
  */
-CASS_EXPORT CassError
-cass_cluster_set_no_compact(CassCluster* cluster,
-                            cass_bool_t enabled);
+CASS_EXPORT void
+cass_cluster_set_load_balance_round_robin(CassCluster* cluster);
 
 /**
- * Sets a callback for handling host state changes in the cluster.
+ * Configures the cluster to use DC-aware load balancing.
+ * For each query, all live nodes in a primary 'local' DC are tried first,
+ * followed by any node from other DCs.
  *
- * <b>Note:</b> The callback is invoked only when state changes in the cluster
- * are applicable to the configured load balancing policy(s).
+ * <b>Note:</b> This is the default, and does not need to be called unless
+ * switching an existing from another policy or changing settings.
+ * Without further configuration, a default local_dc is chosen from the
+ * first connected contact point, and no remote hosts are considered in
+ * query plans. If relying on this mechanism, be sure to use only contact
+ * points from the local DC.
+ *
+ * @deprecated The remote DC settings for DC-aware are not suitable for most
+ * scenarios that require DC failover. There is also unhandled gap between
+ * replication factor number of nodes failing and the full cluster failing. Only
+ * the remote DC settings are being deprecated.
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] callback
- * @param[in] data
- * @return CASS_OK if successful, otherwise and error occurred
+ * @param[in] local_dc The primary data center to try first
+ * @param[in] used_hosts_per_remote_dc The number of hosts used in each remote
+ * DC if no hosts are available in the local dc (<b>deprecated</b>)
+ * @param[in] allow_remote_dcs_for_local_cl Allows remote hosts to be used if no
+ * local dc hosts are available and the consistency level is LOCAL_ONE or
+ * LOCAL_QUORUM (<b>deprecated</b>)
+ * @return CASS_OK if successful, otherwise an error occurred
  */
 CASS_EXPORT CassError
-cass_cluster_set_host_listener_callback(CassCluster* cluster,
-                                        CassHostListenerCallback callback,
-                                        void* data);
+cass_cluster_set_load_balance_dc_aware(CassCluster* cluster,
+                                       const char* local_dc,
+                                       unsigned used_hosts_per_remote_dc,
+                                       cass_bool_t allow_remote_dcs_for_local_cl);
+
 
 /**
- * Sets the secure connection bundle path for processing DBaaS credentials.
+ * Same as cass_cluster_set_load_balance_dc_aware(), but with lengths for string
+ * parameters.
  *
- * This will pre-configure a cluster using the credentials format provided by
- * the DBaaS cloud provider.
+ * @deprecated The remote DC settings for DC-aware are not suitable for most
+ * scenarios that require DC failover. There is also unhandled gap between
+ * replication factor number of nodes failing and the full cluster failing. Only
+ * the remote DC settings are being deprecated.
+ *
+ * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] path Absolute path to DBaaS credentials file.
- * @return CASS_OK if successful, otherwise error occured.
+ * @param[in] local_dc
+ * @param[in] local_dc_length
+ * @param[in] used_hosts_per_remote_dc (<b>deprecated</b>)
+ * @param[in] allow_remote_dcs_for_local_cl (<b>deprecated</b>)
+ * @return same as cass_cluster_set_load_balance_dc_aware()
+ *
+ * @see cass_cluster_set_load_balance_dc_aware()
  */
 CASS_EXPORT CassError
-cass_cluster_set_cloud_secure_connection_bundle(CassCluster* cluster,
-                                                const char* path);
+cass_cluster_set_load_balance_dc_aware_n(CassCluster* cluster,
+                                         const char* local_dc,
+                                         size_t local_dc_length,
+                                         unsigned used_hosts_per_remote_dc,
+                                         cass_bool_t allow_remote_dcs_for_local_cl);
 
 /**
- * Same as cass_cluster_set_cloud_secure_connection_bundle(), but with lengths
- * for string parameters.
+ * Configures the cluster to use Rack-aware load balancing.
+ * For each query, all live nodes in a primary 'local' rack are tried first,
+ * followed by nodes from local DC and then nodes from other DCs.
  *
- * @see cass_cluster_set_cloud_secure_connection_bundle()
+ * With empty local_rack and local_dc,  default local_dc and local_rack
+ * is chosen from the first connected contact point,
+ * and no remote hosts are considered in query plans.
+ * If relying on this mechanism, be sure to use only contact
+ * points from the local rack.
+ *
+ * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] path Absolute path to DBaaS credentials file.
- * @param[in] path_length Length of path variable.
- * @return CASS_OK if successful, otherwise error occured.
+ * @param[in] local_dc The primary data center to try first
+ * @param[in] local_rack The primary rack to try first
+ * @return CASS_OK if successful, otherwise an error occurred
  */
 CASS_EXPORT CassError
-cass_cluster_set_cloud_secure_connection_bundle_n(CassCluster* cluster,
-                                                  const char* path,
-                                                  size_t path_length);
+cass_cluster_set_load_balance_rack_aware(CassCluster* cluster,
+                                       const char* local_dc,
+                                       const char* local_rack);
+
 
 /**
- * Same as cass_cluster_set_cloud_secure_connection_bundle(), but it does not
- * initialize the underlying SSL library implementation. The SSL library still
- * needs to be initialized, but it's up to the client application to handle
- * initialization. This is similar to the function cass_ssl_new_no_lib_init(),
- * and its documentation should be used as a reference to properly initialize
- * the underlying SSL library.
+ * Same as cass_cluster_set_load_balance_rack_aware(), but with lengths for string
+ * parameters.
  *
- * @see cass_ssl_new_no_lib_init()
- * @see cass_cluster_set_cloud_secure_connection_bundle()
+ * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] path Absolute path to DBaaS credentials file.
- * @return CASS_OK if successful, otherwise error occured.
+ * @param[in] local_dc
+ * @param[in] local_dc_length
+ * @return same as cass_cluster_set_load_balance_dc_aware()
+ *
+ * @see cass_cluster_set_load_balance_dc_aware()
  */
 CASS_EXPORT CassError
-cass_cluster_set_cloud_secure_connection_bundle_no_ssl_lib_init(CassCluster* cluster,
-                                                                const char* path);
+cass_cluster_set_load_balance_rack_aware_n(CassCluster* cluster,
+                                         const char* local_dc,
+                                         size_t local_dc_length,
+                                         const char* local_rack,
+                                         size_t local_rack_length);
 
 /**
- * Same as cass_cluster_set_cloud_secure_connection_bundle_no_ssl_lib_init(),
- * but with lengths for string parameters.
+ * Configures the cluster to use token-aware request routing or not.
  *
- * @see cass_cluster_set_cloud_secure_connection_bundle_no_ssl_lib_init()
+ * <b>Important:</b> Token-aware routing depends on keyspace metadata.
+ * For this reason enabling token-aware routing will also enable retrieving
+ * and updating keyspace schema metadata.
+ *
+ * <b>Default:</b> cass_true (enabled).
+ *
+ * This routing policy composes the base routing policy, routing
+ * requests first to replicas on nodes considered 'local' by
+ * the base load balancing policy.
+ *
+ * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] path Absolute path to DBaaS credentials file.
- * @param[in] path_length Length of path variable.
- * @return CASS_OK if successful, otherwise error occured.
+ * @param[in] enabled
  */
-CASS_EXPORT CassError
-cass_cluster_set_cloud_secure_connection_bundle_no_ssl_lib_init_n(CassCluster* cluster,
-                                                                  const char* path,
-                                                                  size_t path_length);
+CASS_EXPORT void
+cass_cluster_set_token_aware_routing(CassCluster* cluster,
+                                     cass_bool_t enabled);
+
 
 /**
- * Set the application name.
+ * Configures token-aware routing to randomly shuffle replicas. This can reduce
+ * the effectiveness of server-side caching, but it can better distribute load over
+ * replicas for a given partition key.
  *
- * This is optional; however it provides the server with the application name
- * that can aid in debugging issues with larger clusters where there are a lot
- * of client (or application) connections.
+ * <b>Note:</b> Token-aware routing must be enabled for the setting to
+ * be applicable.
+ *
+ * <b>Default:</b> cass_true (enabled).
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] application_name
+ * @param[in] enabled
  */
 CASS_EXPORT void
-cass_cluster_set_application_name(CassCluster* cluster,
-                                  const char* application_name);
+cass_cluster_set_token_aware_routing_shuffle_replicas(CassCluster* cluster,
+                                                      cass_bool_t enabled);
 
 /**
- * Same as cass_cluster_set_application_name(), but with lengths for string
- * parameters.
+ * Configures token-aware routing to try the least loaded replicas first.
+ * Replicas are ranked by their in-flight requests across all of the session's
+ * connections and then by their recent average latency, so busy or slow
+ * replicas (e.g. replicas running compactions) are only tried after the
+ * others. If replica shuffling is also enabled then equally loaded replicas
+ * are tried in a random order.
+ *
+ * <b>Note:</b> Token-aware routing must be enabled for the setting to
+ * be applicable.
+ *
+ * <b>Default:</b> cass_false (disabled).
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] application_name
- * @param[in] application_name_length
+ * @param[in] enabled
+ *
+ * @see cass_cluster_set_token_aware_routing_shuffle_replicas()
  */
 CASS_EXPORT void
-cass_cluster_set_application_name_n(CassCluster* cluster,
-                                    const char* application_name,
-                                    size_t application_name_length);
+cass_cluster_set_token_aware_routing_least_loaded_replicas(CassCluster* cluster,
+                                                           cass_bool_t enabled);
 
 /**
- * Set the application version.
+ * Sets how a connection is selected from a host's connection pool. The least
+ * busy selection scans every connection in the pool for the one with the
+ * fewest in-flight requests. The power of two choices selection compares two
+ * randomly chosen connections, which costs the same for any pool size and is
+ * nearly as well balanced, so it's better suited to many connections per
+ * host.
  *
- * This is optional; however it provides the server with the application
- * version that can aid in debugging issues with large clusters where there are
- * a lot of client (or application) connections that may have different
- * versions in use.
+ * <b>Default:</b> CASS_CONNECTION_SELECTION_LEAST_BUSY
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] application_version
+ * @param[in] selection
+ *
+ * @see cass_execution_profile_set_connection_selection()
  */
-
 CASS_EXPORT void
-cass_cluster_set_application_version(CassCluster* cluster,
-                                     const char* application_version);
+cass_cluster_set_connection_selection(CassCluster* cluster,
+                                      CassConnectionSelection selection);
 
 /**
- * Same as cass_cluster_set_application_version(), but with lengths for string
- * parameters.
+ * Limits the rate the requests that use the cluster's default settings are
+ * started. Requests over the rate aren't failed; they're delayed until they
+ * fit the rate. A burst of requests can start at the same time after the
+ * session has been idle. Each session has its own limit and requests that use
+ * an execution profile are limited by the profile's rate limit instead.
+ *
+ * <b>Note:</b> The request timeout starts once a request is started so
+ * delayed requests aren't timed out while they wait. Use
+ * cass_cluster_set_max_inflight_requests() to bound the number of waiting
+ * requests.
+ *
+ * <b>Default:</b> 0.0 (disabled)
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] application_version
- * @param[in] application_version_length
+ * @param[in] requests_per_second The maximum rate, or 0.0 to disable the limit.
+ * @param[in] burst The number of requests that can start at the same time.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_execution_profile_set_rate_limit()
  */
-CASS_EXPORT void
-cass_cluster_set_application_version_n(CassCluster* cluster,
-                                       const char* application_version,
-                                       size_t application_version_length);
+CASS_EXPORT CassError
+cass_cluster_set_rate_limit(CassCluster* cluster,
+                            cass_double_t requests_per_second,
+                            unsigned burst);
 
 /**
- * Set the client id.
+ * Configures the cluster to use latency-aware request routing or not.
  *
- * This is optional; however it provides the server with the client ID that can
- * aid in debugging issues with large clusters where there are a lot of client
- * connections.
+ * <b>Default:</b> cass_false (disabled).
  *
- * Default: UUID v4 generated (@see cass_session_get_client_id())
+ * This routing policy is a top-level routing policy. It uses the
+ * base routing policy to determine locality (dc-aware) and/or
+ * placement (token-aware) before considering the latency.
+ *
+ * A node's latency includes the time waited by requests that timed out on
+ * the node and it's penalized by the node's in-flight requests per
+ * connection.
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] client_id
+ * @param[in] enabled
  */
 CASS_EXPORT void
-cass_cluster_set_client_id(CassCluster* cluster, CassUuid client_id);
+cass_cluster_set_latency_aware_routing(CassCluster* cluster,
+                                       cass_bool_t enabled);
 
 /**
- * Sets the amount of time between monitor reporting event messages.
+ * Configures the settings for latency-aware request routing.
  *
- * <b>Default:</b> 300 seconds.
+ * <b>Defaults:</b>
+ *
+ * <ul>
+ *   <li>exclusion_threshold: 2.0</li>
+ *   <li>scale_ms: 100 milliseconds</li>
+ *   <li>retry_period_ms: 10,000 milliseconds (10 seconds)</li>
+ *   <li>update_rate_ms: 100 milliseconds</li>
+ *   <li>min_measured: 50</li>
+ * </ul>
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] interval_secs Use 0 to disable monitor reporting event messages.
+ * @param[in] exclusion_threshold Controls how much worse the latency must be compared to the
+ * average latency of the best performing node before it penalized.
+ * @param[in] scale_ms Controls the weight given to older latencies when calculating the average
+ * latency of a node. A bigger scale will give more weight to older latency measurements.
+ * @param[in] retry_period_ms The amount of time a node is penalized by the policy before
+ * being given a second chance when the current average latency exceeds the calculated
+ * threshold (exclusion_threshold * best_average_latency).
+ * @param[in] update_rate_ms The rate at  which the best average latency is recomputed.
+ * @param[in] min_measured The minimum number of measurements per-host required to
+ * be considered by the policy.
  */
 CASS_EXPORT void
-cass_cluster_set_monitor_reporting_interval(CassCluster* cluster,
-                                            unsigned interval_secs);
-
-/***********************************************************************************
- *
- * Session
- *
- ***********************************************************************************/
+cass_cluster_set_latency_aware_routing_settings(CassCluster* cluster,
+                                                cass_double_t exclusion_threshold,
+                                                cass_uint64_t scale_ms,
+                                                cass_uint64_t retry_period_ms,
+                                                cass_uint64_t update_rate_ms,
+                                                cass_uint64_t min_measured);
 
 /**
- * Creates a new session.
+ * Sets/Appends whitelist hosts. The first call sets the whitelist hosts and
+ * any subsequent calls appends additional hosts. Passing an empty string will
+ * clear and disable the whitelist. White space is striped from the hosts.
  *
- * @public @memberof CassSession
+ * This policy filters requests to all other policies, only allowing requests
+ * to the hosts contained in the whitelist. Any host not in the whitelist will
+ * be ignored and a connection will not be established. This policy is useful
+ * for ensuring that the driver will only connect to a predefined set of hosts.
  *
- * @return Returns a session that must be freed.
+ * Examples: "127.0.0.1" "127.0.0.1,127.0.0.2"
  *
- * @see cass_session_free()
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] hosts A comma delimited list of addresses. An empty string will
+ * clear the whitelist hosts. The string is copied into the cluster
+ * configuration; the memory pointed to by this parameter can be freed after
+ * this call.
  */
-CASS_EXPORT CassSession*
-cass_session_new();
+CASS_EXPORT void
+cass_cluster_set_whitelist_filtering(CassCluster* cluster,
+                                     const char* hosts);
 
 /**
- * Frees a session instance. If the session is still connected it will be synchronously
- * closed before being deallocated.
+ * Same as cass_cluster_set_whitelist_filtering(), but with lengths for
+ * string parameters.
  *
- * Important: Do not free a session in a future callback. Freeing a session in a future
- * callback will cause a deadlock.
+ * @public @memberof CassCluster
  *
- * @public @memberof CassSession
+ * @param[in] cluster
+ * @param[in] hosts
+ * @param[in] hosts_length
+ * @return same as cass_cluster_set_whitelist_filtering()
  *
- * @param[in] session
+ * @see cass_cluster_set_whitelist_filtering()
  */
 CASS_EXPORT void
-cass_session_free(CassSession* session);
+cass_cluster_set_whitelist_filtering_n(CassCluster* cluster,
+                                       const char* hosts,
+                                       size_t hosts_length);
 
 /**
- * Connects a session.
+ * Sets/Appends blacklist hosts. The first call sets the blacklist hosts and
+ * any subsequent calls appends additional hosts. Passing an empty string will
+ * clear and disable the blacklist. White space is striped from the hosts.
  *
- * @public @memberof CassSession
+ * This policy filters requests to all other policies, only allowing requests
+ * to the hosts not contained in the blacklist. Any host in the blacklist will
+ * be ignored and a connection will not be established. This policy is useful
+ * for ensuring that the driver will not connect to a predefined set of hosts.
  *
- * @param[in] session
- * @param[in] cluster The cluster configuration is copied into the session and
- * is immutable after connection.
- * @return A future that must be freed.
+ * Examples: "127.0.0.1" "127.0.0.1,127.0.0.2"
  *
- * @see cass_session_close()
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] hosts A comma delimited list of addresses. An empty string will
+ * clear the blacklist hosts. The string is copied into the cluster
+ * configuration; the memory pointed to by this parameter can be freed after
+ * this call.
  */
-CASS_EXPORT CassFuture*
-cass_session_connect(CassSession* session,
-                     const CassCluster* cluster);
+CASS_EXPORT void
+cass_cluster_set_blacklist_filtering(CassCluster* cluster,
+                                     const char* hosts);
 
 /**
- * Connects a session and sets the keyspace.
+ * Same as cass_cluster_set_blacklist_filtering_hosts(), but with lengths for
+ * string parameters.
  *
- * @public @memberof CassSession
+ * @public @memberof CassCluster
  *
- * @param[in] session
- * @param[in] cluster The cluster configuration is copied into the session and
- * is immutable after connection.
- * @param[in] keyspace
- * @return A future that must be freed.
+ * @param[in] cluster
+ * @param[in] hosts
+ * @param[in] hosts_length
+ * @return same as cass_cluster_set_blacklist_filtering()
  *
- * @see cass_session_close()
+ * @see cass_cluster_set_blacklist_filtering()
  */
-CASS_EXPORT CassFuture*
-cass_session_connect_keyspace(CassSession* session,
-                              const CassCluster* cluster,
-                              const char* keyspace);
+CASS_EXPORT void
+cass_cluster_set_blacklist_filtering_n(CassCluster* cluster,
+                                       const char* hosts,
+                                       size_t hosts_length);
 
 /**
- * Same as cass_session_connect_keyspace(), but with lengths for string
- * parameters.
+ * Same as cass_cluster_set_whitelist_filtering(), but whitelist all hosts of a dc
  *
- * @public @memberof CassSession
+ * Examples: "dc1", "dc1,dc2"
  *
- * @param[in] session
- * @param[in] cluster
- * @param[in] keyspace
- * @param[in] keyspace_length
- * @return same as cass_session_connect_keyspace()
+ * @public @memberof CassCluster
  *
- * @see cass_session_connect_keyspace()
+ * @param[in] cluster
+ * @param[in] dcs A comma delimited list of dcs. An empty string will clear the
+ * whitelist dcs. The string is copied into the cluster configuration; the
+ * memory pointed to by this parameter can be freed after this call.
  */
-CASS_EXPORT CassFuture*
-cass_session_connect_keyspace_n(CassSession* session,
-                                const CassCluster* cluster,
-                                const char* keyspace,
-                                size_t keyspace_length);
+CASS_EXPORT void
+cass_cluster_set_whitelist_dc_filtering(CassCluster* cluster,
+                                        const char* dcs);
 
 /**
- * Closes the session instance, outputs a close future which can
- * be used to determine when the session has been terminated. This allows
- * in-flight requests to finish.
+ * Same as cass_cluster_set_whitelist_dc_filtering(), but with lengths for
+ * string parameters.
  *
- * @public @memberof CassSession
+ * @public @memberof CassCluster
  *
- * @param[in] session
- * @return A future that must be freed.
+ * @param[in] cluster
+ * @param[in] dcs
+ * @param[in] dcs_length
+ * @return same as cass_cluster_set_whitelist_dc_filtering()
+ *
+ * @see cass_cluster_set_whitelist_dc_filtering()
  */
-CASS_EXPORT CassFuture*
-cass_session_close(CassSession* session);
+CASS_EXPORT void
+cass_cluster_set_whitelist_dc_filtering_n(CassCluster* cluster,
+                                          const char* dcs,
+                                          size_t dcs_length);
 
 /**
- * Create a prepared statement.
+ * Same as cass_cluster_set_blacklist_filtering(), but blacklist all hosts of a dc
  *
- * @public @memberof CassSession
+ * Examples: "dc1", "dc1,dc2"
  *
- * @param[in] session
- * @param[in] query The query is copied into the statement object; the
- * memory pointed to by this parameter can be freed after this call.
- * @return A future that must be freed.
+ * @public @memberof CassCluster
  *
- * @see cass_future_get_prepared()
+ * @param[in] cluster
+ * @param[in] dcs A comma delimited list of dcs. An empty string will clear the
+ * blacklist dcs. The string is copied into the cluster configuration; the
+ * memory pointed to by this parameter can be freed after this call.
  */
-CASS_EXPORT CassFuture*
-cass_session_prepare(CassSession* session,
-                     const char* query);
+CASS_EXPORT void
+cass_cluster_set_blacklist_dc_filtering(CassCluster* cluster,
+                                        const char* dcs);
 
 /**
- * Same as cass_session_prepare(), but with lengths for string
- * parameters.
+ * Same as cass_cluster_set_blacklist_dc_filtering(), but with lengths for
+ * string parameters.
  *
- * @public @memberof CassSession
+ * @public @memberof CassCluster
  *
- * @param[in] session
- * @param[in] query
- * @param[in] query_length
- * @return same as cass_session_prepare()
+ * @param[in] cluster
+ * @param[in] dcs
+ * @param[in] dcs_length
+ * @return same as cass_cluster_set_blacklist_dc_filtering()
  *
- * @see cass_session_prepare()
+ * @see cass_cluster_set_blacklist_dc_filtering()
  */
-CASS_EXPORT CassFuture*
-cass_session_prepare_n(CassSession* session,
-                       const char* query,
-                       size_t query_length);
+CASS_EXPORT void
+cass_cluster_set_blacklist_dc_filtering_n(CassCluster* cluster,
+                                          const char* dcs,
+                                          size_t dcs_length);
 
 /**
- * Create a prepared statement from an existing statement.
- *
- * <b>Note:</b> Bound statements will inherit the keyspace, consistency,
- * serial consistency, request timeout and retry policy of the existing
- * statement.
+ * Enable/Disable Nagle's algorithm on connections.
  *
- * @public @memberof CassSession
+ * <b>Default:</b> cass_true (disables Nagle's algorithm).
  *
- * @param[in] session
- * @param[in] statement
- * @return A future that must be freed.
+ * @public @memberof CassCluster
  *
- * @see cass_future_get_prepared()
+ * @param[in] cluster
+ * @param[in] enabled
  */
-CASS_EXPORT CassFuture*
-cass_session_prepare_from_existing(CassSession* session,
-                                   CassStatement* statement);
+CASS_EXPORT void
+cass_cluster_set_tcp_nodelay(CassCluster* cluster,
+                             cass_bool_t enabled);
 
 /**
- * Execute a query or bound statement.
+ * Enable/Disable TCP keep-alive
  *
- * @public @memberof CassSession
+ * <b>Default:</b> cass_false (disabled).
  *
- * @param[in] session
- * @param[in] statement
- * @return A future that must be freed.
+ * @public @memberof CassCluster
  *
- * @see cass_future_get_result()
+ * @param[in] cluster
+ * @param[in] enabled
+ * @param[in] delay_secs The initial delay in seconds, ignored when
+ * `enabled` is false.
  */
-CASS_EXPORT CassFuture*
-cass_session_execute(CassSession* session,
-                     const CassStatement* statement);
+CASS_EXPORT void
+cass_cluster_set_tcp_keepalive(CassCluster* cluster,
+                               cass_bool_t enabled,
+                               unsigned delay_secs);
 
 /**
- * Execute a batch statement.
- *
- * @cassandra{2.0+}
+ * Sets the sizes of the connections' socket receive and send buffers
+ * (SO_RCVBUF and SO_SNDBUF). Larger buffers increase the throughput of
+ * connections with a high bandwidth-delay product, e.g. reads of large
+ * results from a remote datacenter. The buffers are sized before connecting
+ * so that the TCP window scale accounts for them.
  *
- * @public @memberof CassSession
+ * <b>Default:</b> 0 for both (the system's default sizes, which are
+ * usually auto-tuned).
  *
- * @param[in] session
- * @param[in] batch
- * @return A future that must be freed.
+ * @public @memberof CassCluster
  *
- * @see cass_future_get_result()
+ * @param[in] cluster
+ * @param[in] receive_buffer_size The size of the receive buffer in bytes. Use
+ * 0 for the system's default. The system caps it (net.core.rmem_max on Linux).
+ * @param[in] send_buffer_size The size of the send buffer in bytes. Use 0 for
+ * the system's default. The system caps it (net.core.wmem_max on Linux).
  */
-CASS_EXPORT CassFuture*
-cass_session_execute_batch(CassSession* session,
-                           const CassBatch* batch);
+CASS_EXPORT void
+cass_cluster_set_socket_buffer_sizes(CassCluster* cluster,
+                                     unsigned receive_buffer_size,
+                                     unsigned send_buffer_size);
 
 /**
- * Gets a snapshot of this session's schema metadata. The returned
- * snapshot of the schema metadata is not updated. This function
- * must be called again to retrieve any schema changes since the
- * previous call.
+ * Sets the maximum number of bytes written to a connection's socket that
+ * haven't been sent yet (TCP_NOTSENT_LOWAT). Beyond it, requests stay queued
+ * in the driver, where they are coalesced, instead of waiting behind
+ * megabytes of bulk writes in the kernel's send buffer. This lowers the
+ * latency of requests written while the connection is busy with large
+ * requests.
  *
- * @public @memberof CassSession
+ * <b>Default:</b> 0 (disabled)
  *
- * @param[in] session
- * @return A schema instance that must be freed.
+ * @public @memberof CassCluster
  *
- * @see cass_schema_meta_free()
+ * @param[in] cluster
+ * @param[in] bytes The low watermark of unsent bytes. Use 0 to disable it.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ * CASS_ERROR_LIB_NOT_IMPLEMENTED is returned if a low watermark is used on a
+ * system that doesn't support it.
+ *
+ * @see cass_cluster_set_socket_buffer_sizes()
  */
-CASS_EXPORT const CassSchemaMeta*
-cass_session_get_schema_meta(const CassSession* session);
-
+CASS_EXPORT CassError
+cass_cluster_set_tcp_notsent_lowat(CassCluster* cluster,
+                                   unsigned bytes);
 /**
- * Gets a copy of this session's performance/diagnostic metrics.
+ * Sets the timestamp generator used to assign timestamps to all requests
+ * unless overridden by setting the timestamp on a statement or a batch.
  *
- * @public @memberof CassSession
+ * <b>Default:</b> Monotonically increasing, client-side timestamp generator.
  *
- * @param[in] session
- * @param[out] output
+ * @cassandra{2.1+}
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] timestamp_gen
+ *
+ * @see cass_statement_set_timestamp()
+ * @see cass_batch_set_timestamp()
  */
 CASS_EXPORT void
-cass_session_get_metrics(const CassSession* session,
-                         CassMetrics* output);
+cass_cluster_set_timestamp_gen(CassCluster* cluster,
+                               CassTimestampGen* timestamp_gen);
 
 /**
- * Gets a copy of this session's speculative execution metrics.
+ * Sets the amount of time between heartbeat messages and controls the amount
+ * of time the connection must be idle before sending heartbeat messages. This
+ * is useful for preventing intermediate network devices from dropping
+ * connections.
  *
- * @public @memberof CassSession
+ * <b>Default:</b> 30 seconds
  *
- * @param[in] session
- * @param[out] output
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] interval_secs Use 0 to disable heartbeat messages
  */
 CASS_EXPORT void
-cass_session_get_speculative_execution_metrics(const CassSession* session,
-                                               CassSpeculativeExecutionMetrics* output);
+cass_cluster_set_connection_heartbeat_interval(CassCluster* cluster,
+                                               unsigned interval_secs);
 
 /**
- * Gets the current count of inflight request to all hosts.
+ * Sets the amount of time a connection is allowed to be without a successful
+ * heartbeat response before being terminated and scheduled for reconnection.
  *
- * @public @memberof CassSession
+ * <b>Default:</b> 60 seconds
  *
- * @param[in] session
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] timeout_secs
  */
-CASS_EXPORT cass_uint64_t
-cass_session_get_inflight_request_count(const CassSession* session);
+CASS_EXPORT void
+cass_cluster_set_connection_idle_timeout(CassCluster* cluster,
+                                         unsigned timeout_secs);
 
 /**
- * Get the client id.
+ * Sets the retry policy used for all requests unless overridden by setting
+ * a retry policy on a statement or a batch.
  *
- * @public @memberof CassSession
+ * <b>Default:</b> The same policy as would be created by the function:
+ * cass_retry_policy_default_new(). This policy will retry on a read timeout
+ * if there was enough replicas, but no data present, on a write timeout if a
+ * logged batch request failed to write the batch log, and on a unavailable
+ * error it retries using a new host. In all other cases the default policy
+ * will return an error.
  *
- * @param[in] session
- * @return Client id.
- */
-CASS_EXPORT CassUuid
-cass_session_get_client_id(CassSession* session);
-
-/***********************************************************************************
+ * @public @memberof CassCluster
  *
- * Schema Metadata
+ * @param[in] cluster
+ * @param[in] retry_policy
  *
- ***********************************************************************************/
+ * @see cass_retry_policy_default_new()
+ * @see cass_statement_set_retry_policy()
+ * @see cass_batch_set_retry_policy()
+ */
+CASS_EXPORT void
+cass_cluster_set_retry_policy(CassCluster* cluster,
+                              CassRetryPolicy* retry_policy);
 
 /**
- * Frees a schema metadata instance.
+ * Sets a budget that limits the number of retries decided by the retry
+ * policies to a fraction of the number of requests. The budget is shared by
+ * all the session's requests and lets up to 10 retries be saved up. Once it's
+ * used up the error is returned instead of retrying, so that a struggling
+ * cluster isn't flooded with retries.
  *
- * @public @memberof CassSchemaMeta
+ * <b>Default:</b> 0.0 (disabled, all retries are allowed)
  *
- * @param[in] schema_meta
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] ratio The maximum fraction of requests that can be retried
+ * (0.0 - 1.0), e.g. 0.1 for 10%. Use 0.0 to disable the budget.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_session_get_retry_metrics()
  */
-CASS_EXPORT void
-cass_schema_meta_free(const CassSchemaMeta* schema_meta);
+CASS_EXPORT CassError
+cass_cluster_set_retry_budget(CassCluster* cluster,
+                              cass_double_t ratio);
 
 /**
- * Gets the version of the schema metadata snapshot.
+ * Enable a per-host circuit breaker. A host's circuit opens after a number of
+ * consecutive read/write timeouts, request timeouts, unavailable or
+ * overloaded errors. While a host's circuit is open the host is moved to the
+ * end of every query plan so it's only used once the other hosts have been
+ * tried. After the open duration a single probe request is sent to the host
+ * and a successful response closes the circuit.
  *
- * @public @memberof CassSchemaMeta
+ * <b>Default:</b> 0 (disabled), 1000 milliseconds
  *
- * @param[in] schema_meta
+ * @public @memberof CassCluster
  *
- * @return The snapshot version.
+ * @param[in] cluster
+ * @param[in] failure_threshold The number of consecutive failures that opens
+ * a host's circuit. Use 0 to disable the circuit breaker.
+ * @param[in] open_duration_ms The time in milliseconds a host's circuit stays
+ * open before a probe request is sent to it.
+ * @return CASS_OK if successful, otherwise an error occurred.
  */
-CASS_EXPORT cass_uint32_t
-cass_schema_meta_snapshot_version(const CassSchemaMeta* schema_meta);
+CASS_EXPORT CassError
+cass_cluster_set_circuit_breaker(CassCluster* cluster,
+                                 unsigned failure_threshold,
+                                 cass_uint64_t open_duration_ms);
 
 /**
- * Gets the version of the connected Cassandra cluster.
+ * Enable a per-host adaptive concurrency limiter. Each host's limit on the
+ * number of in-flight requests starts at the minimum limit and is adjusted
+ * using additive increase, multiplicative decrease (AIMD): it grows by one
+ * for each response received within the latency threshold while the host is
+ * busy and shrinks by 10% for each slower response, request timeout,
+ * read/write timeout, unavailable or overloaded error. Hosts at their limit are moved to
+ * the end of every query plan so requests go to the hosts with spare capacity
+ * first, which keeps latencies flat when a host degrades.
  *
- * @public @memberof CassSchemaMeta
+ * <b>Default:</b> 20, 0 (disabled), 100 milliseconds
  *
- * @param[in] schema_meta
+ * @public @memberof CassCluster
  *
- * @return Cassandra's version
+ * @param[in] cluster
+ * @param[in] min_limit The lowest and initial limit of each host.
+ * @param[in] max_limit The highest limit of each host. Use 0 to disable the
+ * concurrency limiter.
+ * @param[in] latency_threshold_ms The latency in milliseconds above which a
+ * response lowers the host's limit.
+ * @return CASS_OK if successful, otherwise an error occurred.
  */
-CASS_EXPORT CassVersion
-cass_schema_meta_version(const CassSchemaMeta* schema_meta);
+CASS_EXPORT CassError
+cass_cluster_set_concurrency_limiter(CassCluster* cluster,
+                                     unsigned min_limit,
+                                     unsigned max_limit,
+                                     cass_uint64_t latency_threshold_ms);
 
 /**
- * Gets the keyspace metadata for the provided keyspace name.
+ * Capture the frames sent and received by all connections, with their
+ * timestamps, to a binary file so the traffic can be replayed offline by the
+ * replay mock server (cassandra-replay-server) to reproduce a performance
+ * issue. The frames are kept in a ring of two files, the path and the path
+ * with a ".1" suffix, that together use at most the maximum size: the oldest
+ * frames are dropped first.
  *
- * @public @memberof CassSchemaMeta
+ * <b>Warning:</b> The frames are written on the I/O threads and contain the
+ * requests' values and the results' rows (and credentials exchanged during
+ * authentication). This is meant for diagnostics only.
  *
- * @param[in] schema_meta
- * @param[in] keyspace
+ * <b>Default:</b> NULL (disabled)
  *
- * @return The metadata for a keyspace. NULL if keyspace does not exist.
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] path The path of the capture file. Any existing file is replaced.
+ * Use NULL or an empty string to disable capturing.
+ * @param[in] max_size_bytes The maximum size of both capture files in bytes.
+ * @return CASS_OK if successful, otherwise an error occurred (e.g. the file
+ * couldn't be created).
  */
-CASS_EXPORT const CassKeyspaceMeta*
-cass_schema_meta_keyspace_by_name(const CassSchemaMeta* schema_meta,
-                                  const char* keyspace);
+CASS_EXPORT CassError
+cass_cluster_set_frame_capture(CassCluster* cluster,
+                               const char* path,
+                               size_t max_size_bytes);
 
 /**
- * Same as cass_schema_meta_keyspace_by_name(), but with lengths for string
+ * Same as cass_cluster_set_frame_capture(), but with lengths for string
  * parameters.
  *
- * @public @memberof CassSchemaMeta
+ * @public @memberof CassCluster
  *
- * @param[in] schema_meta
- * @param[in] keyspace
- * @param[in] keyspace_length
- * @return same as cass_schema_meta_keyspace_by_name()
+ * @param[in] cluster
+ * @param[in] path
+ * @param[in] path_length
+ * @param[in] max_size_bytes
+ * @return same as cass_cluster_set_frame_capture()
  *
- * @see cass_schema_meta_keyspace_by_name()
+ * @see cass_cluster_set_frame_capture()
  */
-CASS_EXPORT const CassKeyspaceMeta*
-cass_schema_meta_keyspace_by_name_n(const CassSchemaMeta* schema_meta,
-                                    const char* keyspace,
-                                    size_t keyspace_length);
+CASS_EXPORT CassError
+cass_cluster_set_frame_capture_n(CassCluster* cluster,
+                                 const char* path,
+                                 size_t path_length,
+                                 size_t max_size_bytes);
 
 /**
- * Gets the name of the keyspace.
+ * Enable/Disable recording latency histograms for each host and each
+ * execution profile, in addition to the session's histogram. Each histogram
+ * uses memory for every I/O thread so this is disabled by default.
  *
- * @public @memberof CassKeyspaceMeta
+ * <b>Default:</b> cass_false
  *
- * @param[in] keyspace_meta
- * @param[out] name
- * @param[out] name_length
- */
-CASS_EXPORT void
-cass_keyspace_meta_name(const CassKeyspaceMeta* keyspace_meta,
-                        const char** name,
-                        size_t* name_length);
-
-
-/**
- * Determine if the keyspace is a virtual keyspace.
+ * @public @memberof CassCluster
  *
- * @public @memberof CassKeyspaceMeta
+ * @param[in] cluster
+ * @param[in] enabled
  *
- * @param[in] keyspace_meta
- * @return cass_true is the keyspace is virtual, otherwise cass_false
+ * @see cass_session_get_host_metrics()
+ * @see cass_session_get_execution_profile_metrics()
  */
-CASS_EXPORT cass_bool_t
-cass_keyspace_meta_is_virtual(const CassKeyspaceMeta* keyspace_meta);
+CASS_EXPORT void
+cass_cluster_set_host_and_profile_metrics(CassCluster* cluster,
+                                          cass_bool_t enabled);
 
 /**
- * Gets the table metadata for the provided table name.
+ * Enable/Disable recording the latencies of the stages of each request: the
+ * request processor queue, the socket write, the server and the future's
+ * callback. This reads the clock a few more times per request so it's
+ * disabled by default.
  *
- * @public @memberof CassKeyspaceMeta
+ * <b>Default:</b> cass_false
  *
- * @param[in] keyspace_meta
- * @param[in] table
+ * @public @memberof CassCluster
  *
- * @return The metadata for a table. NULL if table does not exist.
+ * @param[in] cluster
+ * @param[in] enabled
+ *
+ * @see cass_session_get_request_stage_metrics()
  */
-CASS_EXPORT const CassTableMeta*
-cass_keyspace_meta_table_by_name(const CassKeyspaceMeta* keyspace_meta,
-                                 const char* table);
+CASS_EXPORT void
+cass_cluster_set_request_stage_metrics(CassCluster* cluster,
+                                       cass_bool_t enabled);
 
 /**
- * Same as cass_keyspace_meta_table_by_name(), but with lengths for string
- * parameters.
+ * Sets how the latency histograms are merged and read. Each IO thread records
+ * latencies into its own histogram and these are merged into the session's
+ * histograms when a snapshot is taken. With many IO threads and frequent
+ * reads of the metrics the merging can be expensive.
  *
- * @public @memberof CassKeyspaceMeta
+ * A merge interval merges the threads' histograms on the session's
+ * control thread periodically so that each merge has less to do. A maximum
+ * snapshot age reuses a snapshot that was taken less than that long ago
+ * instead of merging the histograms and computing the percentiles again, so
+ * the metrics can be out of date by up to that long.
  *
- * @param[in] keyspace_meta
- * @param[in] table
- * @param[in] table_length
- * @return same as cass_keyspace_meta_table_by_name()
+ * <b>Default:</b> 0 (disabled), 0 (snapshots are always up to date)
  *
- * @see cass_keyspace_meta_table_by_name()
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] merge_interval_ms The interval between merges of the threads'
+ * histograms or 0 to only merge them when a snapshot is taken.
+ * @param[in] max_age_ms The maximum age of a reused snapshot or 0 to always
+ * take a new snapshot.
+ *
+ * @see cass_session_get_metrics()
  */
-CASS_EXPORT const CassTableMeta*
-cass_keyspace_meta_table_by_name_n(const CassKeyspaceMeta* keyspace_meta,
-                                   const char* table,
-                                   size_t table_length);
+CASS_EXPORT void
+cass_cluster_set_metrics_snapshot_caching(CassCluster* cluster,
+                                          unsigned merge_interval_ms,
+                                          unsigned max_age_ms);
 
 /**
- * Gets the materialized view metadata for the provided view name.
+ * Enable a log of slow requests. Each request (including its retries and
+ * speculative executions) that takes longer than the threshold is recorded
+ * with its query, its coordinator, the hosts it was sent to, its number of
+ * retries and speculative executions and the time spent in each of its
+ * stages. The requests are kept for the application to take using
+ * cass_session_get_slow_request() unless a callback is set. When the log is
+ * full newer slow requests are dropped.
  *
- * @cassandra{3.0+}
+ * <b>Default:</b> 0 (disabled), 1024 requests
  *
- * @public @memberof CassKeyspaceMeta
+ * @public @memberof CassCluster
  *
- * @param[in] keyspace_meta
- * @param[in] view
+ * @param[in] cluster
+ * @param[in] threshold_ms The latency in milliseconds above which requests
+ * are logged. Use 0 to disable the log.
+ * @param[in] capacity The maximum number of slow requests kept in the log
+ * (rounded up to a power of 2 of at least 2).
+ * @return CASS_OK if successful, otherwise an error occurred.
  *
- * @return The metadata for a view. NULL if view does not exist.
+ * @see cass_cluster_set_slow_request_callback()
  */
-CASS_EXPORT const CassMaterializedViewMeta*
-cass_keyspace_meta_materialized_view_by_name(const CassKeyspaceMeta* keyspace_meta,
-                                             const char* view);
+CASS_EXPORT CassError
+cass_cluster_set_slow_request_log(CassCluster* cluster,
+                                  cass_uint64_t threshold_ms,
+                                  unsigned capacity);
 
 /**
- * Same as cass_keyspace_meta_materialized_view_by_name(), but with lengths for string
- * parameters.
+ * Sets a callback that's notified of each slow request instead of keeping
+ * the slow requests in the log.
  *
- * @cassandra{3.0+}
+ * <b>Default:</b> NULL (the slow requests are kept in the log)
  *
- * @public @memberof CassKeyspaceMeta
+ * @public @memberof CassCluster
  *
- * @param[in] keyspace_meta
- * @param[in] view
- * @param[in] view_length
- * @return same as cass_keyspace_meta_materialized_view_by_name()
+ * @param[in] cluster
+ * @param[in] callback The callback or NULL to keep the slow requests in the
+ * log.
+ * @param[in] data
  *
- * @see cass_keyspace_meta_materialized_view_by_name()
+ * @see cass_cluster_set_slow_request_log()
  */
-CASS_EXPORT const CassMaterializedViewMeta*
-cass_keyspace_meta_materialized_view_by_name_n(const CassKeyspaceMeta* keyspace_meta,
-                                               const char* view,
-                                               size_t view_length);
+CASS_EXPORT void
+cass_cluster_set_slow_request_callback(CassCluster* cluster,
+                                       CassSlowRequestCallback callback,
+                                       void* data);
 
 /**
- * Gets the data type for the provided type name.
- *
- * @cassandra{2.1+}
+ * Sets a tracer that's notified when each request starts, when it's sent to
+ * a host, when it's retried, when a speculative execution is started and
+ * when it finishes. This can be used to record the driver's part of a
+ * distributed trace (e.g. with OpenTelemetry) without enabling tracing on
+ * the server. Requests aren't traced when no tracer is set.
  *
- * @public @memberof CassKeyspaceMeta
+ * <b>Default:</b> NULL (disabled)
  *
- * @param[in] keyspace_meta
- * @param[in] type
+ * @public @memberof CassCluster
  *
- * @return The data type for a user defined type. NULL if type does not exist.
+ * @param[in] cluster
+ * @param[in] callback The tracer or NULL to disable tracing.
+ * @param[in] data
  */
-CASS_EXPORT const CassDataType*
-cass_keyspace_meta_user_type_by_name(const CassKeyspaceMeta* keyspace_meta,
-                                     const char* type);
+CASS_EXPORT void
+cass_cluster_set_request_tracer(CassCluster* cluster,
+                                CassRequestTracerCallback callback,
+                                void* data);
 
 /**
- * Same as cass_keyspace_meta_type_by_name(), but with lengths for string
- * parameters.
+ * Enable/Disable retrieving and updating schema metadata. If disabled
+ * this is allows the driver to skip over retrieving and updating schema
+ * metadata and cass_session_get_schema_meta() will always return an empty object.
+ * This can be useful for reducing the startup overhead of short-lived sessions.
  *
- * @cassandra{2.1+}
+ * <b>Default:</b> cass_true (enabled).
  *
- * @public @memberof CassKeyspaceMeta
+ * @public @memberof CassCluster
  *
- * @param[in] keyspace_meta
- * @param[in] type
- * @param[in] type_length
- * @return same as cass_keyspace_meta_type_by_name()
+ * @param[in] cluster
+ * @param[in] enabled
  *
- * @see cass_keyspace_meta_type_by_name()
+ * @see cass_session_get_schema_meta()
  */
-CASS_EXPORT const CassDataType*
-cass_keyspace_meta_user_type_by_name_n(const CassKeyspaceMeta* keyspace_meta,
-                                       const char* type,
-                                       size_t type_length);
+CASS_EXPORT void
+cass_cluster_set_use_schema(CassCluster* cluster,
+                            cass_bool_t enabled);
 
 /**
- * Gets the function metadata for the provided function name.
+ * Enable/Disable lazily building schema metadata. If enabled the rows
+ * retrieved for a keyspace's tables, materialized views, user types, functions
+ * and aggregates are retained and only built into metadata the first time the
+ * keyspace's metadata is accessed, e.g. using
+ * cass_schema_meta_keyspace_by_name(). This reduces the startup cost of
+ * clusters with many tables when only a few keyspaces are used.
  *
- * @cassandra{2.2+}
+ * <b>Default:</b> cass_false (disabled).
  *
- * @public @memberof CassKeyspaceMeta
+ * @public @memberof CassCluster
  *
- * @param[in] keyspace_meta
- * @param[in] name
- * @param[in] arguments A comma delimited list of CQL types (e.g "text,int,...")
- * describing the function's signature.
+ * @param[in] cluster
+ * @param[in] enabled
  *
- * @return The data function for a user defined function. NULL if function does not exist.
+ * @see cass_cluster_set_use_schema()
+ * @see cass_cluster_set_schema_keyspace_filtering()
  */
-CASS_EXPORT const CassFunctionMeta*
-cass_keyspace_meta_function_by_name(const CassKeyspaceMeta* keyspace_meta,
-                                    const char* name,
-                                    const char* arguments);
+CASS_EXPORT void
+cass_cluster_set_use_lazy_schema(CassCluster* cluster,
+                                 cass_bool_t enabled);
 
 /**
- * Same as cass_keyspace_meta_function_by_name(), but with lengths for string
- * parameters.
+ * Sets the keyspaces to retrieve schema metadata for. The tables, materialized
+ * views, user types, functions and aggregates of other keyspaces are not
+ * retrieved. All keyspaces (and their replication settings) are still
+ * retrieved because they're required for token-aware routing.
  *
- * @cassandra{2.2+}
+ * Examples: "keyspace1", "keyspace1,keyspace2"
  *
- * @public @memberof CassKeyspaceMeta
+ * <b>Default:</b> All keyspaces
  *
- * @param[in] keyspace_meta
- * @param[in] name
- * @param[in] name_length
- * @param[in] arguments
- * @param[in] arguments_length
- * @return same as cass_keyspace_meta_function_by_name()
+ * @public @memberof CassCluster
  *
- * @see cass_keyspace_meta_function_by_name()
+ * @param[in] cluster
+ * @param[in] keyspaces A comma delimited list of keyspaces. An empty string
+ * will clear the filter. The string is copied into the cluster configuration;
+ * the memory pointed to by this parameter can be freed after this call.
+ *
+ * @see cass_cluster_set_use_schema()
  */
-CASS_EXPORT const CassFunctionMeta*
-cass_keyspace_meta_function_by_name_n(const CassKeyspaceMeta* keyspace_meta,
-                                      const char* name,
-                                      size_t name_length,
-                                      const char* arguments,
-                                      size_t arguments_length);
+CASS_EXPORT void
+cass_cluster_set_schema_keyspace_filtering(CassCluster* cluster,
+                                           const char* keyspaces);
 
 /**
- * Gets the aggregate metadata for the provided aggregate name.
- *
- * @cassandra{2.2+}
+ * Same as cass_cluster_set_schema_keyspace_filtering(), but with lengths for
+ * string parameters.
  *
- * @public @memberof CassKeyspaceMeta
+ * @public @memberof CassCluster
  *
- * @param[in] keyspace_meta
- * @param[in] name
- * @param[in] arguments A comma delimited list of CQL types (e.g "text,int,...")
- * describing the aggregate's signature.
+ * @param[in] cluster
+ * @param[in] keyspaces
+ * @param[in] keyspaces_length
  *
- * @return The data aggregate for a user defined aggregate. NULL if aggregate does not exist.
+ * @see cass_cluster_set_schema_keyspace_filtering()
  */
-CASS_EXPORT const CassAggregateMeta*
-cass_keyspace_meta_aggregate_by_name(const CassKeyspaceMeta* keyspace_meta,
-                                     const char* name,
-                                     const char* arguments);
+CASS_EXPORT void
+cass_cluster_set_schema_keyspace_filtering_n(CassCluster* cluster,
+                                             const char* keyspaces,
+                                             size_t keyspaces_length);
 
 /**
- * Same as cass_keyspace_meta_aggregate_by_name(), but with lengths for string
- * parameters.
+ * Enable/Disable connecting the connection pools in parallel with retrieving
+ * the schema metadata. If enabled the control connection only retrieves the
+ * hosts and keyspaces (for the token map) before the connection pools start
+ * connecting and the rest of the schema metadata is retrieved at the same
+ * time. Connecting the session still waits for both to complete.
  *
- * @cassandra{2.2+}
+ * <b>Default:</b> cass_false (disabled).
  *
- * @public @memberof CassKeyspaceMeta
+ * @public @memberof CassCluster
  *
- * @param[in] keyspace_meta
- * @param[in] name
- * @param[in] name_length
- * @param[in] arguments
- * @param[in] arguments_length
- * @return same as cass_keyspace_meta_aggregate_by_name()
+ * @param[in] cluster
+ * @param[in] enabled
  *
- * @see cass_keyspace_meta_aggregate_by_name()
+ * @see cass_session_get_startup_timings()
  */
-CASS_EXPORT const CassAggregateMeta*
-cass_keyspace_meta_aggregate_by_name_n(const CassKeyspaceMeta* keyspace_meta,
-                                       const char* name,
-                                       size_t name_length,
-                                       const char* arguments,
-                                       size_t arguments_length);
+CASS_EXPORT void
+cass_cluster_set_use_parallel_startup(CassCluster* cluster,
+                                      cass_bool_t enabled);
 
 /**
- * Gets a metadata field for the provided name. Metadata fields allow direct
- * access to the column data found in the underlying "keyspaces" metadata table.
+ * Enable/Disable splitting unlogged batches by replica set. If enabled an
+ * unlogged batch whose statements route to different replicas is split into
+ * one batch per replica set and the batches are executed in parallel, each
+ * routed directly to one of its replicas. The batch's future is set once all
+ * of the batches complete; if any of them fail it's set to one of the errors.
+ * Logged and counter batches, and unlogged batches whose statements all share
+ * the same replicas, are executed unchanged.
  *
- * @public @memberof CassKeyspaceMeta
+ * <b>Note:</b> Splitting a batch gives up its atomicity across the split
+ * batches and requires the token map (token aware routing) to be enabled.
  *
- * @param[in] keyspace_meta
- * @param[in] name
- * @return A metadata field value. NULL if the field does not exist.
- */
-CASS_EXPORT const CassValue*
-cass_keyspace_meta_field_by_name(const CassKeyspaceMeta* keyspace_meta,
-                                 const char* name);
-
-/**
- * Same as cass_keyspace_meta_field_by_name(), but with lengths for string
- * parameters.
+ * <b>Default:</b> cass_false (disabled).
  *
- * @public @memberof CassKeyspaceMeta
+ * @public @memberof CassCluster
  *
- * @param[in] keyspace_meta
- * @param[in] name
- * @param[in] name_length
- * @return same as cass_keyspace_meta_field_by_name()
+ * @param[in] cluster
+ * @param[in] enabled
  *
- * @see cass_keyspace_meta_field_by_name()
+ * @see cass_cluster_set_token_aware_routing()
  */
-CASS_EXPORT const CassValue*
-cass_keyspace_meta_field_by_name_n(const CassKeyspaceMeta* keyspace_meta,
-                                   const char* name,
-                                   size_t name_length);
+CASS_EXPORT void
+cass_cluster_set_token_aware_batch_splitting(CassCluster* cluster,
+                                             cass_bool_t enabled);
 
 /**
- * Gets the name of the table.
+ * Enable/Disable coalescing identical reads. If enabled, executing an
+ * idempotent bound statement while an identical one (the same prepared
+ * statement, bound values, consistency, serial consistency, page size,
+ * tracing, execution profile, target host and custom payload) is in flight
+ * doesn't send another request. Its future is set with the in-flight
+ * request's result (or error) instead, and the result is shared, not copied.
  *
- * @public @memberof CassTableMeta
+ * <b>Note:</b> Only prepared statements that return rows (e.g. SELECT) are
+ * coalesced. Statements with paging prefetch enabled aren't coalesced.
  *
- * @param[in] table_meta
- * @param[out] name
- * @param[out] name_length
+ * <b>Default:</b> cass_false (disabled).
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ *
+ * @see cass_statement_set_is_idempotent()
  */
 CASS_EXPORT void
-cass_table_meta_name(const CassTableMeta* table_meta,
-                     const char** name,
-                     size_t* name_length);
+cass_cluster_set_read_coalescing(CassCluster* cluster,
+                                 cass_bool_t enabled);
 
 /**
- * Determine if the table is a virtual table.
+ * Sets the maximum encoded size of the statements in a batch. An unlogged or
+ * counter batch whose statements are larger is split, keeping the order of
+ * its statements, into batches that are under the limit and the batches are
+ * executed in parallel. The batch's future is set once all of the batches
+ * complete; if any of them fail it's set to one of the errors. Logged batches
+ * are never split. Use a limit under the server's
+ * "batch_size_fail_threshold" to avoid batches that are rejected for their
+ * size.
  *
- * @public @memberof CassTableMeta
+ * When this is enabled the driver also executes its own copy of each batch
+ * and encodes its statements only once, rather than again for every retry
+ * and speculative execution.
  *
- * @param[in] table_meta
- * @return cass_true is the table is virtual, otherwise cass_false
+ * <b>Note:</b> The size of a statement is computed when it's added to the
+ * batch so its values should be bound first. Splitting a batch gives up its
+ * atomicity across the split batches.
+ *
+ * <b>Default:</b> 0 (disabled)
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] size The maximum size in bytes or 0 to disable splitting.
+ *
+ * @see cass_batch_add_statement()
  */
-CASS_EXPORT cass_bool_t
-cass_table_meta_is_virtual(const CassTableMeta* table_meta);
+CASS_EXPORT void
+cass_cluster_set_batch_split_size(CassCluster* cluster,
+                                  unsigned size);
 
 /**
- * Gets the column metadata for the provided column name.
+ * Sets the number of normal priority requests each I/O thread starts for each
+ * low priority request while both are queued. Low priority requests are
+ * started as soon as there are no queued normal priority requests.
  *
- * @public @memberof CassTableMeta
+ * <b>Default:</b> 8
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] weight
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_execution_profile_set_priority()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_low_priority_weight(CassCluster* cluster,
+                                     unsigned weight);
+
+/**
+ * Sets the number of stream IDs of each connection that are reserved for
+ * normal priority requests. A low priority request isn't written to a
+ * connection with this many, or fewer, available stream IDs so low priority
+ * requests can never use all of a connection's stream IDs. At most half of a
+ * connection's stream IDs are reserved.
+ *
+ * <b>Default:</b> 1024
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] count
+ *
+ * @see cass_execution_profile_set_priority()
+ */
+CASS_EXPORT void
+cass_cluster_set_reserved_streams(CassCluster* cluster,
+                                  unsigned count);
+
+/**
+ * Enable/Disable retrieving hostnames for IP addresses using reverse IP lookup.
+ *
+ * @deprecated Do not use. Using reverse DNS lookup to verify the certificate
+ * does not protect against man-in-the-middle attacks. 
+ *
+ * <b>Default:</b> cass_false (disabled).
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ * @return CASS_OK if successful, otherwise an error occurred
+ *
+ * @see cass_cluster_set_resolve_timeout()
+ */
+CASS_EXPORT CASS_DEPRECATED(CassError
+cass_cluster_set_use_hostname_resolution(CassCluster* cluster,
+                                         cass_bool_t enabled));
+
+/**
+ * Enable/Disable the randomization of the contact points list.
+ *
+ * <b>Default:</b> cass_true (enabled).
+ *
+ * <b>Important:</b> This setting should only be disabled for debugging or
+ * tests.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ * @return CASS_OK if successful, otherwise an error occurred
+ */
+CASS_EXPORT CassError
+cass_cluster_set_use_randomized_contact_points(CassCluster* cluster,
+                                               cass_bool_t enabled);
+
+/**
+ * Enable constant speculative executions with the supplied settings.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] constant_delay_ms
+ * @param[in] max_speculative_executions
+ * @return CASS_OK if successful, otherwise an error occurred
+ */
+CASS_EXPORT CassError
+cass_cluster_set_constant_speculative_execution_policy(CassCluster* cluster,
+                                                       cass_int64_t constant_delay_ms,
+                                                       int max_speculative_executions);
+
+/**
+ * Enable speculative executions with a delay that follows the observed
+ * request latencies.
+ *
+ * The delay before each speculative execution is the given percentile of the
+ * recent latencies of the requests that use the cluster's settings
+ * (e.g. 95.0 to speculate once a request takes longer than 95% of the recent
+ * requests). The delay is recomputed every second and no speculative
+ * executions are started until enough latencies have been recorded.
+ *
+ * The number of speculative executions is limited to a fraction of the number
+ * of requests so that a latency spike doesn't multiply the load on the
+ * cluster.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] percentile The latency percentile to use as the delay (0.0 - 100.0).
+ * @param[in] max_speculative_executions
+ * @param[in] max_speculative_ratio The maximum fraction of requests that can
+ * start a speculative execution (0.0 - 1.0).
+ * @return CASS_OK if successful, otherwise an error occurred
+ *
+ * @see cass_cluster_set_constant_speculative_execution_policy()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_percentile_speculative_execution_policy(CassCluster* cluster,
+                                                         cass_double_t percentile,
+                                                         int max_speculative_executions,
+                                                         cass_double_t max_speculative_ratio);
+
+/**
+ * Disable speculative executions
+ *
+ * <b>Default:</b> This is the default speculative execution policy.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @return CASS_OK if successful, otherwise an error occurred
+ */
+CASS_EXPORT CassError
+cass_cluster_set_no_speculative_execution_policy(CassCluster* cluster);
+
+/**
+ * Sets the maximum number of "pending write" objects that will be
+ * saved for re-use for marshalling new requests. These objects may
+ * hold on to a significant amount of memory and reducing the
+ * number of these objects may reduce memory usage of the application.
+ *
+ * The cost of reducing the value of this setting is potentially slower
+ * marshalling of requests prior to sending.
+ *
+ * <b>Default:</b> Max unsigned integer value
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] num_objects
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_cluster_set_max_reusable_write_objects(CassCluster* cluster,
+                                            unsigned num_objects);
+
+/**
+ * Associates a named execution profile which can be utilized during execution.
+ *
+ * <b>Note:</b> Once the execution profile is added to a cluster, it is
+ * immutable and any changes made to the execution profile must be re-assigned
+ * to the cluster before a session connection is established in order for those
+ * settings to be utilized during query execution.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] name
+ * @param[in] profile
+ * @return CASS_OK if successful, otherwise an error occurred
+ *
+ * @see cass_batch_set_execution_profile()
+ * @see cass_statement_set_execution_profile()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_execution_profile(CassCluster* cluster,
+                                   const char* name,
+                                   CassExecProfile* profile);
+
+/**
+ * Same as cass_cluster_add_execution_profile(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] name
+ * @param[in] name_length
+ * @param[in] profile
+ * @return same as cass_cluster_set_execution_profile()
+ *
+ * @see cass_batch_set_execution_profile()
+ * @see cass_statement_set_execution_profile()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_execution_profile_n(CassCluster* cluster,
+                                     const char* name,
+                                     size_t name_length,
+                                     CassExecProfile* profile);
+
+/**
+ * Prepare statements on all available hosts.
+ *
+ * <b>Default:</b> cass_true
+ *
+ * @public @memberof CassCluster
+ *
+ * @param cluster
+ * @param enabled
+ * @return CASS_OK if successful, otherwise an error occurred
+ */
+CASS_EXPORT CassError
+cass_cluster_set_prepare_on_all_hosts(CassCluster* cluster,
+                                      cass_bool_t enabled);
+
+/**
+ * Enable pre-preparing cached prepared statements when existing hosts become
+ * available again or when new hosts are added to the cluster.
+ *
+ * This can help mitigate request latency when executing prepared statements
+ * by avoiding an extra round trip in cases where the statement is
+ * unprepared on a freshly started server. The main tradeoff is extra background
+ * network traffic is required to prepare the statements on hosts as they become
+ * available.
+ *
+ * <b>Default:</b> cass_true
+ *
+ * @param cluster
+ * @param enabled
+ * @return CASS_OK if successful, otherwise an error occurred
+ */
+CASS_EXPORT CassError
+cass_cluster_set_prepare_on_up_or_add_host(CassCluster* cluster,
+                                           cass_bool_t enabled);
+
+/**
+ * Enable preparing all the cached prepared statements on a host in the
+ * background as soon as the host responds to a request with an UNPREPARED
+ * error, e.g. because it was restarted and lost its prepared statement cache
+ * without being seen as down.
+ *
+ * Without this, the first execution of each statement on each connection to
+ * the host is prepared again separately, adding a round trip to each of those
+ * requests. While the statements are being prepared again, requests for
+ * prepared statements use the host only after the other hosts of their query
+ * plans.
+ *
+ * <b>Default:</b> cass_true
+ *
+ * @param cluster
+ * @param enabled
+ * @return CASS_OK if successful, otherwise an error occurred
+ *
+ * @see cass_cluster_set_prepare_on_up_or_add_host()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_prepare_on_unprepared_host(CassCluster* cluster,
+                                            cass_bool_t enabled);
+
+/**
+ * Enable the <b>NO_COMPACT</b> startup option.
+ *
+ * This can help facilitate uninterrupted cluster upgrades where tables using
+ * <b>COMPACT_STORAGE</b> will operate in "compatibility mode" for
+ * <b>BATCH</b>, <b>DELETE</b>, <b>SELECT</b>, and <b>UPDATE</b> CQL operations.
+ *
+ * <b>Default:</b> cass_false
+ *
+ * @cassandra{3.0.16+}
+ * @cassandra{3.11.2+}
+ * @cassandra{4.0+}
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ */
+CASS_EXPORT CassError
+cass_cluster_set_no_compact(CassCluster* cluster,
+                            cass_bool_t enabled);
+
+/**
+ * Enable writing the "USE <keyspace>" request of a new connection right after
+ * its STARTUP request, without waiting for the READY response, which saves a
+ * round trip for each connection of a session connected with a keyspace.
+ *
+ * The requests are only pipelined when no authentication provider is set,
+ * the connection doesn't register for events and the protocol version doesn't
+ * use segment framing (v5+). Only enable this for servers that process the
+ * requests of a connection in order during the handshake.
+ *
+ * <b>Note:</b> The OPTIONS request is always skipped, regardless of this
+ * setting, once a host's SUPPORTED response has been received by one of its
+ * connections (unless the response includes per-connection shard
+ * information).
+ *
+ * <b>Default:</b> cass_false
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_cluster_set_pipelined_startup(CassCluster* cluster,
+                                   cass_bool_t enabled);
+
+/**
+ * Sets the compression algorithm used for native protocol frames. The
+ * algorithm is negotiated with each host during the connection's STARTUP
+ * exchange and connections fall back to no compression if the host doesn't
+ * support the requested algorithm.
+ *
+ * <b>Note:</b> LZ4 and Snappy are only available if the driver was built with
+ * the corresponding library (see the CASS_USE_LZ4 and CASS_USE_SNAPPY CMake
+ * options).
+ *
+ * <b>Default:</b> CASS_COMPRESSION_NONE
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] type
+ * @return CASS_OK if successful, CASS_ERROR_LIB_NOT_IMPLEMENTED if
+ * the requested algorithm is not available in this build.
+ *
+ * @see cass_cluster_set_compression_threshold()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_compression(CassCluster* cluster,
+                             CassCompressionType type);
+
+/**
+ * Sets the minimum size, in bytes, of a request body before it's compressed.
+ * Smaller requests are sent uncompressed because the savings rarely
+ * outweigh the cost of compressing them.
+ *
+ * <b>Default:</b> 512 bytes
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] threshold_bytes
+ *
+ * @see cass_cluster_set_compression()
+ */
+CASS_EXPORT void
+cass_cluster_set_compression_threshold(CassCluster* cluster,
+                                       unsigned threshold_bytes);
+
+/**
+ * Sets the minimum size, in bytes, of a RESULT response body that's decoded
+ * on a worker thread instead of the connection's IO thread. The IO thread
+ * only frames these responses and then continues serving its other
+ * connections while the body is decompressed and decoded by libuv's
+ * thread pool (see the UV_THREADPOOL_SIZE environment variable). If work
+ * stealing is enabled, the body is decoded by an idle IO thread instead.
+ *
+ * Offloading adds a thread hand-off to each large response so it's only
+ * useful for large result pages (e.g. several megabytes) that would otherwise
+ * delay the other connections on the same IO thread.
+ *
+ * <b>Default:</b> 0 (disabled)
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] threshold_bytes The minimum body size or zero to decode all
+ * responses on the IO thread.
+ */
+CASS_EXPORT void
+cass_cluster_set_result_decode_offload_threshold(CassCluster* cluster,
+                                                 unsigned threshold_bytes);
+
+/**
+ * Sets a file used to persist prepared statements between runs of the
+ * application. The file is loaded when the session connects and is written
+ * when the session is closed. Statements found in the file, for the same
+ * query and session keyspace, are returned by cass_session_prepare() without
+ * contacting the cluster.
+ *
+ * Cached statements are validated lazily: a host that doesn't have the
+ * statement responds with UNPREPARED when it's executed and the statement is
+ * transparently prepared again on that host. Statements saved using a
+ * different protocol version are ignored.
+ *
+ * <b>Default:</b> Empty string (disabled)
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] path The file's path or an empty string to disable the cache.
+ */
+CASS_EXPORT void
+cass_cluster_set_prepared_cache_file(CassCluster* cluster,
+                                     const char* path);
+
+/**
+ * Same as cass_cluster_set_prepared_cache_file(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] path
+ * @param[in] path_length
+ *
+ * @see cass_cluster_set_prepared_cache_file()
+ */
+CASS_EXPORT void
+cass_cluster_set_prepared_cache_file_n(CassCluster* cluster,
+                                       const char* path,
+                                       size_t path_length);
+
+/**
+ * Sets the maximum number of prepared statements the session keeps for
+ * preparing statements on hosts that come up or that respond that they don't
+ * have a statement. Once the limit is reached the least recently used
+ * statements are evicted (approximately). An evicted statement can still be
+ * executed; it's prepared again on demand using its bound statement.
+ *
+ * Use this for applications that prepare dynamic queries, which otherwise
+ * grow the session's prepared statements without bound.
+ *
+ * <b>Default:</b> 0 (unbounded)
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] count The maximum number of prepared statements or zero for no
+ * limit.
+ *
+ * @see cass_session_get_prepared_metadata_metrics()
+ */
+CASS_EXPORT void
+cass_cluster_set_max_prepared_statements(CassCluster* cluster,
+                                         unsigned count);
+
+/**
+ * Sets the maximum number of results kept in the session's result cache. The
+ * results of bound statements with a result cache TTL are cached, keyed by
+ * the prepared statement and the bound values, and executing the same
+ * statement again is served from the cache until the TTL expires. Cached
+ * results are shared, not copied, by the futures that they're returned to.
+ * Results are evicted, least recently used first, once the limit is reached.
+ *
+ * <b>Default:</b> 0 (The results aren't cached)
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] max_entries
+ *
+ * @see cass_statement_set_result_cache_ttl()
+ * @see cass_session_get_result_cache_metrics()
+ */
+CASS_EXPORT void
+cass_cluster_set_result_cache_size(CassCluster* cluster,
+                                   unsigned max_entries);
+
+/**
+ * Sets a callback for handling host state changes in the cluster.
+ *
+ * <b>Note:</b> The callback is invoked only when state changes in the cluster
+ * are applicable to the configured load balancing policy(s).
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] callback
+ * @param[in] data
+ * @return CASS_OK if successful, otherwise and error occurred
+ */
+CASS_EXPORT CassError
+cass_cluster_set_host_listener_callback(CassCluster* cluster,
+                                        CassHostListenerCallback callback,
+                                        void* data);
+
+/**
+ * Sets the secure connection bundle path for processing DBaaS credentials.
+ *
+ * This will pre-configure a cluster using the credentials format provided by
+ * the DBaaS cloud provider.
+ *
+ * @param[in] cluster
+ * @param[in] path Absolute path to DBaaS credentials file.
+ * @return CASS_OK if successful, otherwise error occured.
+ */
+CASS_EXPORT CassError
+cass_cluster_set_cloud_secure_connection_bundle(CassCluster* cluster,
+                                                const char* path);
+
+/**
+ * Same as cass_cluster_set_cloud_secure_connection_bundle(), but with lengths
+ * for string parameters.
+ *
+ * @see cass_cluster_set_cloud_secure_connection_bundle()
+ *
+ * @param[in] cluster
+ * @param[in] path Absolute path to DBaaS credentials file.
+ * @param[in] path_length Length of path variable.
+ * @return CASS_OK if successful, otherwise error occured.
+ */
+CASS_EXPORT CassError
+cass_cluster_set_cloud_secure_connection_bundle_n(CassCluster* cluster,
+                                                  const char* path,
+                                                  size_t path_length);
+
+/**
+ * Same as cass_cluster_set_cloud_secure_connection_bundle(), but it does not
+ * initialize the underlying SSL library implementation. The SSL library still
+ * needs to be initialized, but it's up to the client application to handle
+ * initialization. This is similar to the function cass_ssl_new_no_lib_init(),
+ * and its documentation should be used as a reference to properly initialize
+ * the underlying SSL library.
+ *
+ * @see cass_ssl_new_no_lib_init()
+ * @see cass_cluster_set_cloud_secure_connection_bundle()
+ *
+ * @param[in] cluster
+ * @param[in] path Absolute path to DBaaS credentials file.
+ * @return CASS_OK if successful, otherwise error occured.
+ */
+CASS_EXPORT CassError
+cass_cluster_set_cloud_secure_connection_bundle_no_ssl_lib_init(CassCluster* cluster,
+                                                                const char* path);
+
+/**
+ * Same as cass_cluster_set_cloud_secure_connection_bundle_no_ssl_lib_init(),
+ * but with lengths for string parameters.
+ *
+ * @see cass_cluster_set_cloud_secure_connection_bundle_no_ssl_lib_init()
+ *
+ * @param[in] cluster
+ * @param[in] path Absolute path to DBaaS credentials file.
+ * @param[in] path_length Length of path variable.
+ * @return CASS_OK if successful, otherwise error occured.
+ */
+CASS_EXPORT CassError
+cass_cluster_set_cloud_secure_connection_bundle_no_ssl_lib_init_n(CassCluster* cluster,
+                                                                  const char* path,
+                                                                  size_t path_length);
+
+/**
+ * Sets a file used to cache the cloud metadata (the contact points, local DC
+ * and SNI proxy) retrieved from the metadata service of a cluster configured
+ * using cass_cluster_set_cloud_secure_connection_bundle().
+ *
+ * When the file has the metadata for the same bundle the session starts
+ * connecting using it right away instead of waiting for the metadata
+ * service. The metadata is still retrieved in the background and the file is
+ * updated for the next time. The file is written whenever the metadata is
+ * retrieved successfully.
+ *
+ * <b>Note:</b> If the cached metadata is out of date the connection can
+ * fail. The metadata is refreshed in the background so connecting again
+ * uses the new metadata.
+ *
+ * <b>Default:</b> Empty string (disabled)
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] path The file's path or an empty string to disable the cache.
+ */
+CASS_EXPORT void
+cass_cluster_set_cloud_metadata_cache_file(CassCluster* cluster,
+                                           const char* path);
+
+/**
+ * Same as cass_cluster_set_cloud_metadata_cache_file(), but with lengths for
+ * string parameters.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] path
+ * @param[in] path_length
+ *
+ * @see cass_cluster_set_cloud_metadata_cache_file()
+ */
+CASS_EXPORT void
+cass_cluster_set_cloud_metadata_cache_file_n(CassCluster* cluster,
+                                             const char* path,
+                                             size_t path_length);
+
+/**
+ * Set the application name.
+ *
+ * This is optional; however it provides the server with the application name
+ * that can aid in debugging issues with larger clusters where there are a lot
+ * of client (or application) connections.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] application_name
+ */
+CASS_EXPORT void
+cass_cluster_set_application_name(CassCluster* cluster,
+                                  const char* application_name);
+
+/**
+ * Same as cass_cluster_set_application_name(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] application_name
+ * @param[in] application_name_length
+ */
+CASS_EXPORT void
+cass_cluster_set_application_name_n(CassCluster* cluster,
+                                    const char* application_name,
+                                    size_t application_name_length);
+
+/**
+ * Set the application version.
+ *
+ * This is optional; however it provides the server with the application
+ * version that can aid in debugging issues with large clusters where there are
+ * a lot of client (or application) connections that may have different
+ * versions in use.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] application_version
+ */
+
+CASS_EXPORT void
+cass_cluster_set_application_version(CassCluster* cluster,
+                                     const char* application_version);
+
+/**
+ * Same as cass_cluster_set_application_version(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] application_version
+ * @param[in] application_version_length
+ */
+CASS_EXPORT void
+cass_cluster_set_application_version_n(CassCluster* cluster,
+                                       const char* application_version,
+                                       size_t application_version_length);
+
+/**
+ * Set the client id.
+ *
+ * This is optional; however it provides the server with the client ID that can
+ * aid in debugging issues with large clusters where there are a lot of client
+ * connections.
+ *
+ * Default: UUID v4 generated (@see cass_session_get_client_id())
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] client_id
+ */
+CASS_EXPORT void
+cass_cluster_set_client_id(CassCluster* cluster, CassUuid client_id);
+
+/**
+ * Sets the amount of time between monitor reporting event messages.
+ *
+ * <b>Default:</b> 300 seconds.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] interval_secs Use 0 to disable monitor reporting event messages.
+ */
+CASS_EXPORT void
+cass_cluster_set_monitor_reporting_interval(CassCluster* cluster,
+                                            unsigned interval_secs);
+
+/***********************************************************************************
+ *
+ * Session
+ *
+ ***********************************************************************************/
+
+/**
+ * Creates a new session.
+ *
+ * @public @memberof CassSession
+ *
+ * @return Returns a session that must be freed.
+ *
+ * @see cass_session_free()
+ */
+CASS_EXPORT CassSession*
+cass_session_new();
+
+/**
+ * Frees a session instance. If the session is still connected it will be synchronously
+ * closed before being deallocated.
+ *
+ * Important: Do not free a session in a future callback. Freeing a session in a future
+ * callback will cause a deadlock.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ */
+CASS_EXPORT void
+cass_session_free(CassSession* session);
+
+/**
+ * Connects a session.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] cluster The cluster configuration is copied into the session and
+ * is immutable after connection.
+ * @return A future that must be freed.
+ *
+ * @see cass_session_close()
+ */
+CASS_EXPORT CassFuture*
+cass_session_connect(CassSession* session,
+                     const CassCluster* cluster);
+
+/**
+ * Connects a session and sets the keyspace.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] cluster The cluster configuration is copied into the session and
+ * is immutable after connection.
+ * @param[in] keyspace
+ * @return A future that must be freed.
+ *
+ * @see cass_session_close()
+ */
+CASS_EXPORT CassFuture*
+cass_session_connect_keyspace(CassSession* session,
+                              const CassCluster* cluster,
+                              const char* keyspace);
+
+/**
+ * Same as cass_session_connect_keyspace(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] cluster
+ * @param[in] keyspace
+ * @param[in] keyspace_length
+ * @return same as cass_session_connect_keyspace()
+ *
+ * @see cass_session_connect_keyspace()
+ */
+CASS_EXPORT CassFuture*
+cass_session_connect_keyspace_n(CassSession* session,
+                                const CassCluster* cluster,
+                                const char* keyspace,
+                                size_t keyspace_length);
+
+/**
+ * Closes the session instance, outputs a close future which can
+ * be used to determine when the session has been terminated. This allows
+ * in-flight requests to finish.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @return A future that must be freed.
+ */
+CASS_EXPORT CassFuture*
+cass_session_close(CassSession* session);
+
+/**
+ * Create a prepared statement.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] query The query is copied into the statement object; the
+ * memory pointed to by this parameter can be freed after this call.
+ * @return A future that must be freed.
+ *
+ * @see cass_future_get_prepared()
+ */
+CASS_EXPORT CassFuture*
+cass_session_prepare(CassSession* session,
+                     const char* query);
+
+/**
+ * Same as cass_session_prepare(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] query
+ * @param[in] query_length
+ * @return same as cass_session_prepare()
+ *
+ * @see cass_session_prepare()
+ */
+CASS_EXPORT CassFuture*
+cass_session_prepare_n(CassSession* session,
+                       const char* query,
+                       size_t query_length);
+
+/**
+ * Create a prepared statement from an existing statement.
+ *
+ * <b>Note:</b> Bound statements will inherit the keyspace, consistency,
+ * serial consistency, request timeout, retry policy and priority of the
+ * existing statement.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] statement
+ * @return A future that must be freed.
+ *
+ * @see cass_future_get_prepared()
+ */
+CASS_EXPORT CassFuture*
+cass_session_prepare_from_existing(CassSession* session,
+                                   CassStatement* statement);
+
+/**
+ * Execute a query or bound statement.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] statement
+ * @return A future that must be freed.
+ *
+ * @see cass_future_get_result()
+ */
+CASS_EXPORT CassFuture*
+cass_session_execute(CassSession* session,
+                     const CassStatement* statement);
+
+/**
+ * Gets the future for the next page of a statement executed with paging
+ * prefetch enabled. This waits for the current page. The next page can only
+ * be taken once and taking it allows the page after it to be prefetched.
+ *
+ * @cassandra{2.0+}
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] future The future for the current page.
+ * @return A future that must be freed or NULL if there are no more pages,
+ * paging prefetch isn't enabled for the statement or the next page has
+ * already been taken.
+ *
+ * @see cass_statement_set_paging_prefetch()
+ */
+CASS_EXPORT CassFuture*
+cass_session_get_next_page(CassSession* session,
+                           CassFuture* future);
+
+/**
+ * Execute a batch statement.
+ *
+ * @cassandra{2.0+}
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] batch
+ * @return A future that must be freed.
+ *
+ * @see cass_future_get_result()
+ */
+CASS_EXPORT CassFuture*
+cass_session_execute_batch(CassSession* session,
+                           const CassBatch* batch);
+
+/**
+ * Execute statements bound from the same prepared statement, e.g. reads of
+ * many partition keys, as a single operation. The statements are grouped by
+ * the replica that owns their partition and each group is handed to an I/O
+ * thread at once, which costs less than executing the statements one at a
+ * time and spreads the reads over the replicas unlike a large `IN` clause.
+ *
+ * The future's result has the rows of all of the statements, in the order of
+ * the statements. Only the first page of each statement's rows is included
+ * so the statements' paging size must be large enough for their partitions.
+ * If a statement fails, the future has the first error in the order of the
+ * statements.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] statements The statements. They must not be modified until the
+ * future is set.
+ * @param[in] statements_count
+ * @return A future that must be freed. Its error is
+ * CASS_ERROR_LIB_BAD_PARAMS if there are no statements or they aren't all
+ * bound from the same prepared statement.
+ *
+ * @see cass_prepared_bind()
+ * @see cass_future_get_result()
+ */
+CASS_EXPORT CassFuture*
+cass_session_execute_many(CassSession* session,
+                          const CassStatement* const* statements,
+                          size_t statements_count);
+
+/**
+ * Executes independent statements. This is the same as calling
+ * cass_session_execute() for each statement except that all of the
+ * statements are handed to the same I/O thread with a single queue
+ * operation and a single wake-up, which costs less when many statements are
+ * executed at once.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] statements The statements. They must not be modified until
+ * their futures are set.
+ * @param[in] statements_count
+ * @param[out] futures The statements' futures, in the order of the
+ * statements. It must have room for statements_count futures and each future
+ * must be freed.
+ *
+ * @see cass_session_execute()
+ */
+CASS_EXPORT void
+cass_session_execute_all(CassSession* session,
+                         const CassStatement* const* statements,
+                         size_t statements_count,
+                         CassFuture** futures);
+
+/**
+ * Gets a snapshot of this session's schema metadata. The returned
+ * snapshot of the schema metadata is not updated. This function
+ * must be called again to retrieve any schema changes since the
+ * previous call.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @return A schema instance that must be freed.
+ *
+ * @see cass_schema_meta_free()
+ */
+CASS_EXPORT const CassSchemaMeta*
+cass_session_get_schema_meta(const CassSession* session);
+
+/**
+ * Refreshes a snapshot of this session's schema metadata. If the snapshot is
+ * still up-to-date it's returned as is, without taking any lock or
+ * allocating, otherwise it's freed and a new snapshot is returned.
+ *
+ * This allows hot paths to keep a snapshot (e.g. one per thread) and check
+ * it before each use instead of getting a new snapshot every time. Metadata
+ * retrieved from a snapshot, like a column's data type, stays valid as long
+ * as the snapshot isn't freed, so it can be cached while this function keeps
+ * returning the same snapshot.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] schema_meta A snapshot from a previous call to this function or
+ * to cass_session_get_schema_meta(), or NULL to get a new snapshot. It must
+ * not be used after this call unless it's returned.
+ * @return A schema instance that must be freed.
+ *
+ * @see cass_session_get_schema_meta()
+ * @see cass_schema_meta_free()
+ */
+CASS_EXPORT const CassSchemaMeta*
+cass_session_refresh_schema_meta(const CassSession* session,
+                                 const CassSchemaMeta* schema_meta);
+
+/**
+ * Gets a copy of this session's performance/diagnostic metrics.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output
+ */
+CASS_EXPORT void
+cass_session_get_metrics(const CassSession* session,
+                         CassMetrics* output);
+
+/**
+ * Gets a copy of this session's speculative execution metrics.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output
+ */
+CASS_EXPORT void
+cass_session_get_speculative_execution_metrics(const CassSession* session,
+                                               CassSpeculativeExecutionMetrics* output);
+
+/**
+ * Gets a copy of this session's buffer pool metrics.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output
+ */
+CASS_EXPORT void
+cass_session_get_buffer_pool_metrics(const CassSession* session,
+                                     CassBufferPoolMetrics* output);
+
+/**
+ * Gets a copy of this session's result cache metrics.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output
+ *
+ * @see cass_cluster_set_result_cache_size()
+ */
+CASS_EXPORT void
+cass_session_get_result_cache_metrics(const CassSession* session,
+                                      CassResultCacheMetrics* output);
+
+/**
+ * Gets a copy of this session's per rack request counts. Use with
+ * rack-aware and token-aware routing to keep requests in the local rack.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output
+ *
+ * @see cass_cluster_set_load_balance_rack_aware()
+ * @see cass_cluster_set_token_aware_routing()
+ */
+CASS_EXPORT void
+cass_session_get_rack_metrics(const CassSession* session,
+                              CassRackMetrics* output);
+
+/**
+ * Gets a copy of this session's retry counts.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output
+ *
+ * @see cass_cluster_set_retry_budget()
+ */
+CASS_EXPORT void
+cass_session_get_retry_metrics(const CassSession* session,
+                               CassRetryMetrics* output);
+
+/**
+ * Gets a copy of this session's protocol version downgrade metrics. A host's
+ * connections use the protocol version negotiated by its last connection, so
+ * only the first connection to a host that doesn't support the session's
+ * protocol version is rejected.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output
+ */
+CASS_EXPORT void
+cass_session_get_protocol_metrics(const CassSession* session,
+                                  CassProtocolMetrics* output);
+
+/**
+ * Gets a copy of the latencies of the stages of this session's requests.
+ * This requires request stage metrics to be enabled, otherwise all the
+ * values are zero.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output
+ *
+ * @see cass_cluster_set_request_stage_metrics()
+ */
+CASS_EXPORT void
+cass_session_get_request_stage_metrics(const CassSession* session,
+                                       CassRequestStageMetrics* output);
+
+/**
+ * Takes the oldest request from the session's slow request log.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @return The slow request or NULL if the log is empty (or disabled). The
+ * request must be freed using cass_slow_request_free().
+ *
+ * @see cass_cluster_set_slow_request_log()
+ */
+CASS_EXPORT CassSlowRequest*
+cass_session_get_slow_request(CassSession* session);
+
+/**
+ * Gets the number of slow requests that were dropped because the session's
+ * slow request log was full.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @return The number of dropped slow requests.
+ */
+CASS_EXPORT cass_uint64_t
+cass_session_get_dropped_slow_request_count(const CassSession* session);
+
+/**
+ * Gets a snapshot of the session's request latencies since the last call
+ * (or since the session connected) and starts a new interval. Unlike
+ * cass_session_get_metrics(), which covers the session's lifetime, this shows
+ * recent changes in the latencies.
+ *
+ * The interval's recorded values can also be copied, e.g. to write the
+ * interval to an HdrHistogram log.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output
+ * @param[out] buckets An array for the interval's recorded values. This can
+ * be NULL.
+ * @param[in] bucket_count The size of the array.
+ * @return The number of distinct values recorded during the interval. Only
+ * the first bucket_count of them are copied.
+ */
+CASS_EXPORT size_t
+cass_session_get_interval_metrics(const CassSession* session,
+                                  CassLatencyMetrics* output,
+                                  CassHistogramBucket* buckets,
+                                  size_t bucket_count);
+
+/**
+ * Renders all of the session's metrics in the OpenMetrics (Prometheus) text
+ * format, e.g. to answer a Prometheus scrape. This includes the request
+ * latencies and rates, the connection, timeout, retry and buffer pool
+ * counters, the request processors' queues, the event loops and the per host
+ * and per execution profile metrics. Latencies are in seconds.
+ *
+ * The output is null-terminated and is truncated if the buffer is too small.
+ * The returned length can be used to size the buffer and render the metrics
+ * again.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output A buffer for the metrics. This can be NULL if
+ * output_size is 0.
+ * @param[in] output_size The size of the buffer.
+ * @return The length of the metrics, not including the null-terminator, or 0
+ * if the session isn't connected.
+ */
+CASS_EXPORT size_t
+cass_session_get_open_metrics(const CassSession* session,
+                              char* output,
+                              size_t output_size);
+
+/**
+ * Gets a copy of the wire statistics of a host's connections.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] host The host's IP address.
+ * @param[in] port The host's port.
+ * @param[out] output
+ * @return CASS_OK if successful, otherwise CASS_ERROR_LIB_NO_HOSTS_AVAILABLE
+ * if the host isn't part of the cluster.
+ */
+CASS_EXPORT CassError
+cass_session_get_connection_metrics(const CassSession* session,
+                                    const char* host,
+                                    int port,
+                                    CassConnectionMetrics* output);
+
+/**
+ * Same as cass_session_get_connection_metrics(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] host
+ * @param[in] host_length
+ * @param[in] port
+ * @param[out] output
+ * @return same as cass_session_get_connection_metrics()
+ *
+ * @see cass_session_get_connection_metrics()
+ */
+CASS_EXPORT CassError
+cass_session_get_connection_metrics_n(const CassSession* session,
+                                      const char* host,
+                                      size_t host_length,
+                                      int port,
+                                      CassConnectionMetrics* output);
+
+/**
+ * Gets a copy of the latencies of a host's responses. This requires per host
+ * and per execution profile metrics to be enabled.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] host The host's IP address.
+ * @param[in] port The host's port.
+ * @param[out] output
+ * @return CASS_OK if successful, otherwise CASS_ERROR_LIB_NO_HOSTS_AVAILABLE
+ * if there are no metrics for the host.
+ *
+ * @see cass_cluster_set_host_and_profile_metrics()
+ */
+CASS_EXPORT CassError
+cass_session_get_host_metrics(const CassSession* session,
+                              const char* host,
+                              int port,
+                              CassLatencyMetrics* output);
+
+/**
+ * Same as cass_session_get_host_metrics(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] host
+ * @param[in] host_length
+ * @param[in] port
+ * @param[out] output
+ * @return same as cass_session_get_host_metrics()
+ *
+ * @see cass_session_get_host_metrics()
+ */
+CASS_EXPORT CassError
+cass_session_get_host_metrics_n(const CassSession* session,
+                                const char* host,
+                                size_t host_length,
+                                int port,
+                                CassLatencyMetrics* output);
+
+/**
+ * Gets a copy of the latencies of an execution profile's requests. This
+ * requires per host and per execution profile metrics to be enabled.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] name The execution profile's name.
+ * @param[out] output
+ * @return CASS_OK if successful, otherwise
+ * CASS_ERROR_LIB_EXECUTION_PROFILE_INVALID if there are no metrics for the
+ * profile.
+ *
+ * @see cass_cluster_set_host_and_profile_metrics()
+ */
+CASS_EXPORT CassError
+cass_session_get_execution_profile_metrics(const CassSession* session,
+                                           const char* name,
+                                           CassLatencyMetrics* output);
+
+/**
+ * Same as cass_session_get_execution_profile_metrics(), but with lengths for
+ * string parameters.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] name
+ * @param[in] name_length
+ * @param[out] output
+ * @return same as cass_session_get_execution_profile_metrics()
+ *
+ * @see cass_session_get_execution_profile_metrics()
+ */
+CASS_EXPORT CassError
+cass_session_get_execution_profile_metrics_n(const CassSession* session,
+                                             const char* name,
+                                             size_t name_length,
+                                             CassLatencyMetrics* output);
+
+/**
+ * Gets a copy of the utilization metrics for each of this session's I/O
+ * threads.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output An array with room for at least count entries.
+ * @param[in] count
+ * @return The number of I/O threads. This can be larger than count, in which
+ * case only the first count entries are copied.
+ *
+ * @see cass_cluster_set_num_threads_io()
+ */
+CASS_EXPORT size_t
+cass_session_get_event_loop_metrics(const CassSession* session,
+                                    CassEventLoopMetrics* output,
+                                    size_t count);
+
+/**
+ * Gets the current count of inflight request to all hosts.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ */
+CASS_EXPORT cass_uint64_t
+cass_session_get_inflight_request_count(const CassSession* session);
+
+/**
+ * Gets the request load of each of the session's I/O threads.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output An array with room for count metrics.
+ * @param[in] count
+ * @return The number of I/O threads. Only the first count are copied.
+ *
+ * @see cass_session_get_waiting_request_count()
+ */
+CASS_EXPORT size_t
+cass_session_get_request_processor_metrics(const CassSession* session,
+                                           CassRequestProcessorMetrics* output,
+                                           size_t count);
+
+/**
+ * Gets the time spent in each step of connecting the session. The timings are
+ * only complete after the session is connected.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output
+ *
+ * @see cass_cluster_set_use_parallel_startup()
+ */
+CASS_EXPORT void
+cass_session_get_startup_timings(const CassSession* session,
+                                 CassStartupTimings* output);
+
+/**
+ * Gets the metrics of the session's token map. These are all zero if the
+ * session isn't connected or token aware routing is disabled.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output
+ *
+ * @see cass_cluster_set_token_aware_routing()
+ */
+CASS_EXPORT void
+cass_session_get_token_map_metrics(const CassSession* session,
+                                   CassTokenMapMetrics* output);
+
+/**
+ * Gets the metrics of the session's prepared statements. These are all zero
+ * if the session isn't connected.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output
+ *
+ * @see cass_cluster_set_max_prepared_statements()
+ */
+CASS_EXPORT void
+cass_session_get_prepared_metadata_metrics(const CassSession* session,
+                                           CassPreparedMetadataMetrics* output);
+
+/**
+ * Gets the memory used by the driver's request and response buffers, schema
+ * metadata, SSL buffers and the session's token map.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output
+ *
+ * @see cass_cluster_set_memory_limit()
+ */
+CASS_EXPORT void
+cass_session_get_memory_metrics(const CassSession* session,
+                                CassMemoryMetrics* output);
+
+/**
+ * Gets the number of requests waiting for the session's in-flight limit.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @return The number of waiting requests. This is always 0 if neither the
+ * in-flight limit nor the memory limit is set or the fail backpressure mode
+ * is used.
+ *
+ * @see cass_cluster_set_max_inflight_requests()
+ * @see cass_cluster_set_memory_limit()
+ * @see cass_cluster_set_backpressure_mode()
+ */
+CASS_EXPORT cass_uint64_t
+cass_session_get_waiting_request_count(const CassSession* session);
+
+/**
+ * Get the client id.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @return Client id.
+ */
+CASS_EXPORT CassUuid
+cass_session_get_client_id(CassSession* session);
+
+/**
+ * Gets the handle of an execution profile. A statement or a batch that
+ * references its execution profile by handle doesn't have its profile looked
+ * up by name each time it's executed.
+ *
+ * The handle is only valid for the profiles of the cluster the session was
+ * connected with.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] name
+ * @param[out] handle
+ * @return CASS_OK if successful, otherwise CASS_ERROR_LIB_EXECUTION_PROFILE_INVALID
+ * if the session isn't connected or it doesn't have the profile.
+ *
+ * @see cass_statement_set_execution_profile_handle()
+ * @see cass_batch_set_execution_profile_handle()
+ */
+CASS_EXPORT CassError
+cass_session_get_execution_profile_handle(const CassSession* session,
+                                          const char* name,
+                                          cass_int32_t* handle);
+
+/**
+ * Same as cass_session_get_execution_profile_handle(), but with lengths for
+ * string parameters.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] name
+ * @param[in] name_length
+ * @param[out] handle
+ * @return same as cass_session_get_execution_profile_handle()
+ *
+ * @see cass_session_get_execution_profile_handle()
+ */
+CASS_EXPORT CassError
+cass_session_get_execution_profile_handle_n(const CassSession* session,
+                                            const char* name,
+                                            size_t name_length,
+                                            cass_int32_t* handle);
+
+/**
+ * Replaces one of a connected session's named execution profiles without
+ * reconnecting or preparing statements again, e.g. to change timeouts,
+ * consistency levels or the load balancing policy while the session is
+ * running. The profile's unset settings are taken from the cluster's default
+ * settings, like the profiles set with cass_cluster_set_execution_profile().
+ *
+ * The new profile is used by the requests started after each I/O thread
+ * switches to it; the requests that are already running keep the previous
+ * settings. The profile keeps its handle. The profile's request priority
+ * isn't changed, and hosts that were ignored by all of the session's load
+ * balancing policies don't get connections.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] name The name of an existing execution profile.
+ * @param[in] profile The new execution profile. It can be freed once this
+ * function returns.
+ * @return CASS_OK if successful, CASS_ERROR_LIB_EXECUTION_PROFILE_INVALID if
+ * the session doesn't have the profile or CASS_ERROR_LIB_NO_HOSTS_AVAILABLE if
+ * the session isn't connected.
+ *
+ * @see cass_cluster_set_execution_profile()
+ */
+CASS_EXPORT CassError
+cass_session_update_execution_profile(CassSession* session,
+                                      const char* name,
+                                      const CassExecProfile* profile);
+
+/**
+ * Same as cass_session_update_execution_profile(), but with lengths for
+ * string parameters.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] name
+ * @param[in] name_length
+ * @param[in] profile
+ * @return same as cass_session_update_execution_profile()
+ *
+ * @see cass_session_update_execution_profile()
+ */
+CASS_EXPORT CassError
+cass_session_update_execution_profile_n(CassSession* session,
+                                        const char* name,
+                                        size_t name_length,
+                                        const CassExecProfile* profile);
+
+/***********************************************************************************
+ *
+ * Schema Metadata
+ *
+ ***********************************************************************************/
+
+/**
+ * Frees a schema metadata instance.
+ *
+ * @public @memberof CassSchemaMeta
+ *
+ * @param[in] schema_meta
+ */
+CASS_EXPORT void
+cass_schema_meta_free(const CassSchemaMeta* schema_meta);
+
+/**
+ * Gets the version of the schema metadata snapshot.
+ *
+ * @public @memberof CassSchemaMeta
+ *
+ * @param[in] schema_meta
+ *
+ * @return The snapshot version.
+ */
+CASS_EXPORT cass_uint32_t
+cass_schema_meta_snapshot_version(const CassSchemaMeta* schema_meta);
+
+/**
+ * Gets the version of the connected Cassandra cluster.
+ *
+ * @public @memberof CassSchemaMeta
+ *
+ * @param[in] schema_meta
+ *
+ * @return Cassandra's version
+ */
+CASS_EXPORT CassVersion
+cass_schema_meta_version(const CassSchemaMeta* schema_meta);
+
+/**
+ * Gets the keyspace metadata for the provided keyspace name.
+ *
+ * @public @memberof CassSchemaMeta
+ *
+ * @param[in] schema_meta
+ * @param[in] keyspace
+ *
+ * @return The metadata for a keyspace. NULL if keyspace does not exist.
+ */
+CASS_EXPORT const CassKeyspaceMeta*
+cass_schema_meta_keyspace_by_name(const CassSchemaMeta* schema_meta,
+                                  const char* keyspace);
+
+/**
+ * Same as cass_schema_meta_keyspace_by_name(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassSchemaMeta
+ *
+ * @param[in] schema_meta
+ * @param[in] keyspace
+ * @param[in] keyspace_length
+ * @return same as cass_schema_meta_keyspace_by_name()
+ *
+ * @see cass_schema_meta_keyspace_by_name()
+ */
+CASS_EXPORT const CassKeyspaceMeta*
+cass_schema_meta_keyspace_by_name_n(const CassSchemaMeta* schema_meta,
+                                    const char* keyspace,
+                                    size_t keyspace_length);
+
+/**
+ * Gets the name of the keyspace.
+ *
+ * @public @memberof CassKeyspaceMeta
+ *
+ * @param[in] keyspace_meta
+ * @param[out] name
+ * @param[out] name_length
+ */
+CASS_EXPORT void
+cass_keyspace_meta_name(const CassKeyspaceMeta* keyspace_meta,
+                        const char** name,
+                        size_t* name_length);
+
+
+/**
+ * Determine if the keyspace is a virtual keyspace.
+ *
+ * @public @memberof CassKeyspaceMeta
+ *
+ * @param[in] keyspace_meta
+ * @return cass_true is the keyspace is virtual, otherwise cass_false
+ */
+CASS_EXPORT cass_bool_t
+cass_keyspace_meta_is_virtual(const CassKeyspaceMeta* keyspace_meta);
+
+/**
+ * Gets the table metadata for the provided table name.
+ *
+ * @public @memberof CassKeyspaceMeta
+ *
+ * @param[in] keyspace_meta
+ * @param[in] table
+ *
+ * @return The metadata for a table. NULL if table does not exist.
+ */
+CASS_EXPORT const CassTableMeta*
+cass_keyspace_meta_table_by_name(const CassKeyspaceMeta* keyspace_meta,
+                                 const char* table);
+
+/**
+ * Same as cass_keyspace_meta_table_by_name(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassKeyspaceMeta
+ *
+ * @param[in] keyspace_meta
+ * @param[in] table
+ * @param[in] table_length
+ * @return same as cass_keyspace_meta_table_by_name()
+ *
+ * @see cass_keyspace_meta_table_by_name()
+ */
+CASS_EXPORT const CassTableMeta*
+cass_keyspace_meta_table_by_name_n(const CassKeyspaceMeta* keyspace_meta,
+                                   const char* table,
+                                   size_t table_length);
+
+/**
+ * Gets the materialized view metadata for the provided view name.
+ *
+ * @cassandra{3.0+}
+ *
+ * @public @memberof CassKeyspaceMeta
+ *
+ * @param[in] keyspace_meta
+ * @param[in] view
+ *
+ * @return The metadata for a view. NULL if view does not exist.
+ */
+CASS_EXPORT const CassMaterializedViewMeta*
+cass_keyspace_meta_materialized_view_by_name(const CassKeyspaceMeta* keyspace_meta,
+                                             const char* view);
+
+/**
+ * Same as cass_keyspace_meta_materialized_view_by_name(), but with lengths for string
+ * parameters.
+ *
+ * @cassandra{3.0+}
+ *
+ * @public @memberof CassKeyspaceMeta
+ *
+ * @param[in] keyspace_meta
+ * @param[in] view
+ * @param[in] view_length
+ * @return same as cass_keyspace_meta_materialized_view_by_name()
+ *
+ * @see cass_keyspace_meta_materialized_view_by_name()
+ */
+CASS_EXPORT const CassMaterializedViewMeta*
+cass_keyspace_meta_materialized_view_by_name_n(const CassKeyspaceMeta* keyspace_meta,
+                                               const char* view,
+                                               size_t view_length);
+
+/**
+ * Gets the data type for the provided type name.
+ *
+ * @cassandra{2.1+}
+ *
+ * @public @memberof CassKeyspaceMeta
+ *
+ * @param[in] keyspace_meta
+ * @param[in] type
+ *
+ * @return The data type for a user defined type. NULL if type does not exist.
+ */
+CASS_EXPORT const CassDataType*
+cass_keyspace_meta_user_type_by_name(const CassKeyspaceMeta* keyspace_meta,
+                                     const char* type);
+
+/**
+ * Same as cass_keyspace_meta_type_by_name(), but with lengths for string
+ * parameters.
+ *
+ * @cassandra{2.1+}
+ *
+ * @public @memberof CassKeyspaceMeta
+ *
+ * @param[in] keyspace_meta
+ * @param[in] type
+ * @param[in] type_length
+ * @return same as cass_keyspace_meta_type_by_name()
+ *
+ * @see cass_keyspace_meta_type_by_name()
+ */
+CASS_EXPORT const CassDataType*
+cass_keyspace_meta_user_type_by_name_n(const CassKeyspaceMeta* keyspace_meta,
+                                       const char* type,
+                                       size_t type_length);
+
+/**
+ * Gets the function metadata for the provided function name.
+ *
+ * @cassandra{2.2+}
+ *
+ * @public @memberof CassKeyspaceMeta
+ *
+ * @param[in] keyspace_meta
+ * @param[in] name
+ * @param[in] arguments A comma delimited list of CQL types (e.g "text,int,...")
+ * describing the function's signature.
+ *
+ * @return The data function for a user defined function. NULL if function does not exist.
+ */
+CASS_EXPORT const CassFunctionMeta*
+cass_keyspace_meta_function_by_name(const CassKeyspaceMeta* keyspace_meta,
+                                    const char* name,
+                                    const char* arguments);
+
+/**
+ * Same as cass_keyspace_meta_function_by_name(), but with lengths for string
+ * parameters.
+ *
+ * @cassandra{2.2+}
+ *
+ * @public @memberof CassKeyspaceMeta
+ *
+ * @param[in] keyspace_meta
+ * @param[in] name
+ * @param[in] name_length
+ * @param[in] arguments
+ * @param[in] arguments_length
+ * @return same as cass_keyspace_meta_function_by_name()
+ *
+ * @see cass_keyspace_meta_function_by_name()
+ */
+CASS_EXPORT const CassFunctionMeta*
+cass_keyspace_meta_function_by_name_n(const CassKeyspaceMeta* keyspace_meta,
+                                      const char* name,
+                                      size_t name_length,
+                                      const char* arguments,
+                                      size_t arguments_length);
+
+/**
+ * Gets the aggregate metadata for the provided aggregate name.
+ *
+ * @cassandra{2.2+}
+ *
+ * @public @memberof CassKeyspaceMeta
+ *
+ * @param[in] keyspace_meta
+ * @param[in] name
+ * @param[in] arguments A comma delimited list of CQL types (e.g "text,int,...")
+ * describing the aggregate's signature.
+ *
+ * @return The data aggregate for a user defined aggregate. NULL if aggregate does not exist.
+ */
+CASS_EXPORT const CassAggregateMeta*
+cass_keyspace_meta_aggregate_by_name(const CassKeyspaceMeta* keyspace_meta,
+                                     const char* name,
+                                     const char* arguments);
+
+/**
+ * Same as cass_keyspace_meta_aggregate_by_name(), but with lengths for string
+ * parameters.
+ *
+ * @cassandra{2.2+}
+ *
+ * @public @memberof CassKeyspaceMeta
+ *
+ * @param[in] keyspace_meta
+ * @param[in] name
+ * @param[in] name_length
+ * @param[in] arguments
+ * @param[in] arguments_length
+ * @return same as cass_keyspace_meta_aggregate_by_name()
+ *
+ * @see cass_keyspace_meta_aggregate_by_name()
+ */
+CASS_EXPORT const CassAggregateMeta*
+cass_keyspace_meta_aggregate_by_name_n(const CassKeyspaceMeta* keyspace_meta,
+                                       const char* name,
+                                       size_t name_length,
+                                       const char* arguments,
+                                       size_t arguments_length);
+
+/**
+ * Gets a metadata field for the provided name. Metadata fields allow direct
+ * access to the column data found in the underlying "keyspaces" metadata table.
+ *
+ * @public @memberof CassKeyspaceMeta
+ *
+ * @param[in] keyspace_meta
+ * @param[in] name
+ * @return A metadata field value. NULL if the field does not exist.
+ */
+CASS_EXPORT const CassValue*
+cass_keyspace_meta_field_by_name(const CassKeyspaceMeta* keyspace_meta,
+                                 const char* name);
+
+/**
+ * Same as cass_keyspace_meta_field_by_name(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassKeyspaceMeta
+ *
+ * @param[in] keyspace_meta
+ * @param[in] name
+ * @param[in] name_length
+ * @return same as cass_keyspace_meta_field_by_name()
+ *
+ * @see cass_keyspace_meta_field_by_name()
+ */
+CASS_EXPORT const CassValue*
+cass_keyspace_meta_field_by_name_n(const CassKeyspaceMeta* keyspace_meta,
+                                   const char* name,
+                                   size_t name_length);
+
+/**
+ * Gets the name of the table.
+ *
+ * @public @memberof CassTableMeta
+ *
+ * @param[in] table_meta
+ * @param[out] name
+ * @param[out] name_length
+ */
+CASS_EXPORT void
+cass_table_meta_name(const CassTableMeta* table_meta,
+                     const char** name,
+                     size_t* name_length);
+
+/**
+ * Determine if the table is a virtual table.
+ *
+ * @public @memberof CassTableMeta
+ *
+ * @param[in] table_meta
+ * @return cass_true is the table is virtual, otherwise cass_false
+ */
+CASS_EXPORT cass_bool_t
+cass_table_meta_is_virtual(const CassTableMeta* table_meta);
+
+/**
+ * Gets the column metadata for the provided column name.
+ *
+ * @public @memberof CassTableMeta
+ *
+ * @param[in] table_meta
+ * @param[in] column
+ *
+ * @return The metadata for a column. NULL if column does not exist.
+ */
+CASS_EXPORT const CassColumnMeta*
+cass_table_meta_column_by_name(const CassTableMeta* table_meta,
+                               const char* column);
+
+/**
+ * Same as cass_table_meta_column_by_name(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassTableMeta
+ *
+ * @param[in] table_meta
+ * @param[in] column
+ * @param[in] column_length
+ * @return same as cass_table_meta_column_by_name()
+ *
+ * @see cass_table_meta_column_by_name()
+ */
+CASS_EXPORT const CassColumnMeta*
+cass_table_meta_column_by_name_n(const CassTableMeta* table_meta,
+                                 const char* column,
+                                 size_t column_length);
+
+/**
+ * Gets the total number of columns for the table.
+ *
+ * @public @memberof CassTableMeta
+ *
+ * @param[in] table_meta
+ * @return The total column count.
+ */
+CASS_EXPORT size_t
+cass_table_meta_column_count(const CassTableMeta* table_meta);
+
+/**
+ * Gets the column metadata for the provided index.
+ *
+ * @public @memberof CassTableMeta
+ *
+ * @param[in] table_meta
+ * @param[in] index
+ * @return The metadata for a column. NULL returned if the index is out of range.
+ */
+CASS_EXPORT const CassColumnMeta*
+cass_table_meta_column(const CassTableMeta* table_meta,
+                       size_t index);
+
+/**
+ * Gets the index metadata for the provided index name.
+ *
+ * @public @memberof CassTableMeta
+ *
+ * @param[in] table_meta
+ * @param[in] index
+ *
+ * @return The metadata for a index. NULL if index does not exist.
+ */
+CASS_EXPORT const CassIndexMeta*
+cass_table_meta_index_by_name(const CassTableMeta* table_meta,
+                               const char* index);
+
+/**
+ * Same as cass_table_meta_index_by_name(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassTableMeta
+ *
+ * @param[in] table_meta
+ * @param[in] index
+ * @param[in] index_length
+ * @return same as cass_table_meta_index_by_name()
+ *
+ * @see cass_table_meta_index_by_name()
+ */
+CASS_EXPORT const CassIndexMeta*
+cass_table_meta_index_by_name_n(const CassTableMeta* table_meta,
+                                 const char* index,
+                                 size_t index_length);
+
+/**
+ * Gets the total number of indexes for the table.
+ *
+ * @public @memberof CassTableMeta
+ *
+ * @param[in] table_meta
+ * @return The total index count.
+ */
+CASS_EXPORT size_t
+cass_table_meta_index_count(const CassTableMeta* table_meta);
+
+/**
+ * Gets the index metadata for the provided index.
+ *
+ * @public @memberof CassTableMeta
+ *
+ * @param[in] table_meta
+ * @param[in] index
+ * @return The metadata for a index. NULL returned if the index is out of range.
+ */
+CASS_EXPORT const CassIndexMeta*
+cass_table_meta_index(const CassTableMeta* table_meta,
+                      size_t index);
+
+/**
+ * Gets the materialized view metadata for the provided view name.
+ *
+ * @cassandra{3.0+}
+ *
+ * @public @memberof CassTableMeta
+ *
+ * @param[in] table_meta
+ * @param[in] view
+ *
+ * @return The metadata for a view. NULL if view does not exist.
+ */
+CASS_EXPORT const CassMaterializedViewMeta*
+cass_table_meta_materialized_view_by_name(const CassTableMeta* table_meta,
+                                          const char* view);
+
+/**
+ * Same as cass_table_meta_materialized_view_by_name(), but with lengths for string
+ * parameters.
+ *
+ * @cassandra{3.0+}
+ *
+ * @public @memberof CassTableMeta
+ *
+ * @param[in] table_meta
+ * @param[in] view
+ * @param[in] view_length
+ * @return same as cass_table_meta_materialized_view_by_name()
+ *
+ * @see cass_table_meta_materialized_view_by_name()
+ */
+CASS_EXPORT const CassMaterializedViewMeta*
+cass_table_meta_materialized_view_by_name_n(const CassTableMeta* table_meta,
+                                            const char* view,
+                                            size_t view_length);
+
+/**
+ * Gets the total number of views for the table.
+ *
+ * @cassandra{3.0+}
+ *
+ * @public @memberof CassTableMeta
+ *
+ * @param[in] table_meta
+ * @return The total view count.
+ */
+CASS_EXPORT size_t
+cass_table_meta_materialized_view_count(const CassTableMeta* table_meta);
+
+/**
+ * Gets the materialized view metadata for the provided index.
+ *
+ * @cassandra{3.0+}
+ *
+ * @public @memberof CassTableMeta
+ *
+ * @param[in] table_meta
+ * @param[in] index
+ * @return The metadata for a view. NULL returned if the index is out of range.
+ */
+CASS_EXPORT const CassMaterializedViewMeta*
+cass_table_meta_materialized_view(const CassTableMeta* table_meta,
+                                  size_t index);
+
+/**
+ * Gets the number of columns for the table's partition key.
+ *
+ * @public @memberof CassTableMeta
+ *
+ * @param[in] table_meta
+ * @return The count for the number of columns in the partition key.
+ */
+CASS_EXPORT size_t
+cass_table_meta_partition_key_count(const CassTableMeta* table_meta);
+
+/**
+ * Gets the partition key column metadata for the provided index.
+ *
+ * @public @memberof CassTableMeta
+ *
+ * @param[in] table_meta
+ * @param[in] index
+ * @return The metadata for a column. NULL returned if the index is out of range.
+ *
+ * @see cass_table_meta_partition_key_count()
+ */
+CASS_EXPORT const CassColumnMeta*
+cass_table_meta_partition_key(const CassTableMeta* table_meta,
+                              size_t index);
+
+/**
+ * Gets the number of columns for the table's clustering key.
+ *
+ * @public @memberof CassTableMeta
+ *
+ * @param[in] table_meta
+ * @return The count for the number of columns in the clustering key.
+ */
+CASS_EXPORT size_t
+cass_table_meta_clustering_key_count(const CassTableMeta* table_meta);
+
+/**
+ * Gets the clustering key column metadata for the provided index.
+ *
+ * @public @memberof CassTableMeta
  *
  * @param[in] table_meta
+ * @param[in] index
+ * @return The metadata for a column. NULL returned if the index is out of range.
+ *
+ * @see cass_table_meta_clustering_key_count()
+ */
+CASS_EXPORT const CassColumnMeta*
+cass_table_meta_clustering_key(const CassTableMeta* table_meta,
+                               size_t index);
+
+/**
+ * Gets the clustering order column metadata for the provided index.
+ *
+ * @public @memberof CassTableMeta
+ *
+ * @param[in] table_meta
+ * @param[in] index
+ * @return The clustering order for a column.
+ * CASS_CLUSTERING_ORDER_NONE returned if the index is out of range.
+ *
+ * @see cass_table_meta_clustering_key_count()
+ */
+CASS_EXPORT CassClusteringOrder
+cass_table_meta_clustering_key_order(const CassTableMeta* table_meta,
+                                     size_t index);
+
+/**
+ * Gets a metadata field for the provided name. Metadata fields allow direct
+ * access to the column data found in the underlying "tables" metadata table.
+ *
+ * @public @memberof CassTableMeta
+ *
+ * @param[in] table_meta
+ * @param[in] name
+ * @return A metadata field value. NULL if the field does not exist.
+ */
+CASS_EXPORT const CassValue*
+cass_table_meta_field_by_name(const CassTableMeta* table_meta,
+                              const char* name);
+
+/**
+ * Same as cass_table_meta_field_by_name(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassTableMeta
+ *
+ * @param[in] table_meta
+ * @param[in] name
+ * @param[in] name_length
+ * @return same as cass_table_meta_field_by_name()
+ *
+ * @see cass_table_meta_field_by_name()
+ */
+CASS_EXPORT const CassValue*
+cass_table_meta_field_by_name_n(const CassTableMeta* table_meta,
+                                const char* name,
+                                size_t name_length);
+
+/**
+ * Gets the column metadata for the provided column name.
+ *
+ * @cassandra{3.0+}
+ *
+ * @public @memberof CassMaterializedViewMeta
+ *
+ * @param[in] view_meta
+ * @param[in] column
+ *
+ * @return The metadata for a column. NULL if column does not exist.
+ */
+CASS_EXPORT const CassColumnMeta*
+cass_materialized_view_meta_column_by_name(const CassMaterializedViewMeta* view_meta,
+                                           const char* column);
+
+/**
+ * Same as cass_materialized_view_meta_column_by_name(), but with lengths for string
+ * parameters.
+ *
+ * @cassandra{3.0+}
+ *
+ * @public @memberof CassMaterializedViewMeta
+ *
+ * @param[in] view_meta
  * @param[in] column
+ * @param[in] column_length
+ * @return same as cass_materialized_view_meta_column_by_name()
+ *
+ * @see cass_materialized_view_meta_column_by_name()
+ */
+CASS_EXPORT const CassColumnMeta*
+cass_materialized_view_meta_column_by_name_n(const CassMaterializedViewMeta* view_meta,
+                                             const char* column,
+                                             size_t column_length);
+
+/**
+ * Gets the name of the view.
+ *
+ * @cassandra{3.0+}
+ *
+ * @public @memberof CassMaterializedViewMeta
+ *
+ * @param[in] view_meta
+ * @param[out] name
+ * @param[out] name_length
+ */
+CASS_EXPORT void
+cass_materialized_view_meta_name(const CassMaterializedViewMeta* view_meta,
+                                 const char** name,
+                                 size_t* name_length);
+
+/**
+ * Gets the base table of the view.
+ *
+ * @cassandra{3.0+}
+ *
+ * @public @memberof CassMaterializedViewMeta
+ *
+ * @param[in] view_meta
+ *
+ * @return The base table for the view.
+ */
+CASS_EXPORT const CassTableMeta*
+cass_materialized_view_meta_base_table(const CassMaterializedViewMeta* view_meta);
+
+/**
+ * Gets the total number of columns for the view.
+ *
+ * @cassandra{3.0+}
+ *
+ * @public @memberof CassMaterializedViewMeta
+ *
+ * @param[in] view_meta
+ * @return The total column count.
+ */
+CASS_EXPORT size_t
+cass_materialized_view_meta_column_count(const CassMaterializedViewMeta* view_meta);
+
+/**
+ * Gets the column metadata for the provided index.
+ *
+ * @cassandra{3.0+}
+ *
+ * @public @memberof CassMaterializedViewMeta
+ *
+ * @param[in] view_meta
+ * @param[in] index
+ * @return The metadata for a column. NULL returned if the index is out of range.
+ */
+CASS_EXPORT const CassColumnMeta*
+cass_materialized_view_meta_column(const CassMaterializedViewMeta* view_meta,
+                                   size_t index);
+
+/**
+ * Gets the number of columns for the view's partition key.
+ *
+ * @cassandra{3.0+}
+ *
+ * @public @memberof CassMaterializedViewMeta
+ *
+ * @param[in] view_meta
+ * @return The count for the number of columns in the partition key.
+ */
+CASS_EXPORT size_t
+cass_materialized_view_meta_partition_key_count(const CassMaterializedViewMeta* view_meta);
+
+/**
+ * Gets the partition key column metadata for the provided index.
+ *
+ * @cassandra{3.0+}
+ *
+ * @public @memberof CassMaterializedViewMeta
+ *
+ * @param[in] view_meta
+ * @param[in] index
+ * @return The metadata for a column. NULL returned if the index is out of range.
+ */
+CASS_EXPORT const CassColumnMeta*
+cass_materialized_view_meta_partition_key(const CassMaterializedViewMeta* view_meta,
+                                          size_t index);
+
+/**
+ * Gets the number of columns for the view's clustering key.
+ *
+ * @cassandra{3.0+}
+ *
+ * @public @memberof CassMaterializedViewMeta
+ *
+ * @param[in] view_meta
+ * @return The count for the number of columns in the clustering key.
+ */
+CASS_EXPORT size_t
+cass_materialized_view_meta_clustering_key_count(const CassMaterializedViewMeta* view_meta);
+
+/**
+ * Gets the clustering key column metadata for the provided index.
+ *
+ * @cassandra{3.0+}
+ *
+ * @public @memberof CassMaterializedViewMeta
+ *
+ * @param[in] view_meta
+ * @param[in] index
+ * @return The metadata for a column. NULL returned if the index is out of range.
+ */
+CASS_EXPORT const CassColumnMeta*
+cass_materialized_view_meta_clustering_key(const CassMaterializedViewMeta* view_meta,
+                                           size_t index);
+
+/**
+ * Gets the clustering order column metadata for the provided index.
+ *
+ * @public @memberof CassMaterializedViewMeta
+ *
+ * @param[in] view_meta
+ * @param[in] index
+ * @return The clustering order for a column.
+ * CASS_CLUSTERING_ORDER_NONE returned if the index is out of range.
+ *
+ * @see cass_materialized_view_meta_clustering_key_count()
+ */
+CASS_EXPORT CassClusteringOrder
+cass_materialized_view_meta_clustering_key_order(const CassMaterializedViewMeta* view_meta,
+                                                 size_t index);
+
+/**
+ * Gets a metadata field for the provided name. Metadata fields allow direct
+ * access to the column data found in the underlying "views" metadata view.
+ *
+ * @cassandra{3.0+}
+ *
+ * @public @memberof CassMaterializedViewMeta
+ *
+ * @param[in] view_meta
+ * @param[in] name
+ * @return A metadata field value. NULL if the field does not exist.
+ */
+CASS_EXPORT const CassValue*
+cass_materialized_view_meta_field_by_name(const CassMaterializedViewMeta* view_meta,
+                                          const char* name);
+
+/**
+ * Same as cass_materialized_view_meta_field_by_name(), but with lengths for string
+ * parameters.
+ *
+ * @cassandra{3.0+}
+ *
+ * @public @memberof CassMaterializedViewMeta
+ *
+ * @param[in] view_meta
+ * @param[in] name
+ * @param[in] name_length
+ * @return same as cass_materialized_view_meta_field_by_name()
+ *
+ * @see cass_materialized_view_meta_field_by_name()
+ */
+CASS_EXPORT const CassValue*
+cass_materialized_view_meta_field_by_name_n(const CassMaterializedViewMeta* view_meta,
+                                            const char* name,
+                                            size_t name_length);
+
+/**
+ * Gets the name of the column.
+ *
+ * @public @memberof CassColumnMeta
+ *
+ * @param[in] column_meta
+ * @param[out] name
+ * @param[out] name_length
+ */
+CASS_EXPORT void
+cass_column_meta_name(const CassColumnMeta* column_meta,
+                      const char** name,
+                      size_t* name_length);
+
+/**
+ * Gets the type of the column.
+ *
+ * @public @memberof CassColumnMeta
+ *
+ * @param[in] column_meta
+ * @return The column's type.
+ */
+CASS_EXPORT CassColumnType
+cass_column_meta_type(const CassColumnMeta* column_meta);
+
+/**
+ * Gets the data type of the column.
+ *
+ * @public @memberof CassColumnMeta
+ *
+ * @param[in] column_meta
+ * @return The column's data type.
+ */
+CASS_EXPORT const CassDataType*
+cass_column_meta_data_type(const CassColumnMeta* column_meta);
+
+/**
+ * Gets a metadata field for the provided name. Metadata fields allow direct
+ * access to the column data found in the underlying "columns" metadata table.
+ *
+ * @public @memberof CassColumnMeta
+ *
+ * @param[in] column_meta
+ * @param[in] name
+ * @return A metadata field value. NULL if the field does not exist.
+ */
+CASS_EXPORT const CassValue*
+cass_column_meta_field_by_name(const CassColumnMeta* column_meta,
+                               const char* name);
+
+/**
+ * Same as cass_column_meta_field_by_name(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassColumnMeta
+ *
+ * @param[in] column_meta
+ * @param[in] name
+ * @param[in] name_length
+ * @return same as cass_column_meta_field_by_name()
+ *
+ * @see cass_column_meta_field_by_name()
+ */
+CASS_EXPORT const CassValue*
+cass_column_meta_field_by_name_n(const CassColumnMeta* column_meta,
+                                 const char* name,
+                                 size_t name_length);
+
+/**
+ * Gets the name of the index.
+ *
+ * @public @memberof CassIndexMeta
+ *
+ * @param[in] index_meta
+ * @param[out] name
+ * @param[out] name_length
+ */
+CASS_EXPORT void
+cass_index_meta_name(const CassIndexMeta* index_meta,
+                      const char** name,
+                      size_t* name_length);
+
+/**
+ * Gets the type of the index.
+ *
+ * @public @memberof CassIndexMeta
+ *
+ * @param[in] index_meta
+ * @return The index's type.
+ */
+CASS_EXPORT CassIndexType
+cass_index_meta_type(const CassIndexMeta* index_meta);
+
+/**
+ * Gets the target of the index.
+ *
+ * @public @memberof CassIndexMeta
+ *
+ * @param[in] index_meta
+ * @param[out] target
+ * @param[out] target_length
+ */
+CASS_EXPORT void
+cass_index_meta_target(const CassIndexMeta* index_meta,
+                       const char** target,
+                       size_t* target_length);
+
+/**
+ * Gets the options of the index.
+ *
+ * @public @memberof CassIndexMeta
+ *
+ * @param[in] index_meta
+ * @return The index's options.
+ */
+CASS_EXPORT const CassValue*
+cass_index_meta_options(const CassIndexMeta* index_meta);
+
+/**
+ * Gets a metadata field for the provided name. Metadata fields allow direct
+ * access to the index data found in the underlying "indexes" metadata table.
+ *
+ * @public @memberof CassIndexMeta
+ *
+ * @param[in] index_meta
+ * @param[in] name
+ * @return A metadata field value. NULL if the field does not exist.
+ */
+CASS_EXPORT const CassValue*
+cass_index_meta_field_by_name(const CassIndexMeta* index_meta,
+                               const char* name);
+
+/**
+ * Same as cass_index_meta_field_by_name(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassIndexMeta
+ *
+ * @param[in] index_meta
+ * @param[in] name
+ * @param[in] name_length
+ * @return same as cass_index_meta_field_by_name()
+ *
+ * @see cass_index_meta_field_by_name()
+ */
+CASS_EXPORT const CassValue*
+cass_index_meta_field_by_name_n(const CassIndexMeta* index_meta,
+                                 const char* name,
+                                 size_t name_length);
+
+/**
+ * Gets the name of the function.
+ *
+ * @cassandra{2.2+}
+ *
+ * @public @memberof CassFunctionMeta
+ *
+ * @param[in] function_meta
+ * @param[out] name
+ * @param[out] name_length
+ */
+CASS_EXPORT void
+cass_function_meta_name(const CassFunctionMeta* function_meta,
+                        const char** name,
+                        size_t* name_length);
+
+/**
+ * Gets the full name of the function. The full name includes the
+ * function's name and the function's signature:
+ * "name(type1 type2.. typeN)".
+ *
+ * @cassandra{2.2+}
+ *
+ * @public @memberof CassFunctionMeta
+ *
+ * @param[in] function_meta
+ * @param[out] full_name
+ * @param[out] full_name_length
+ */
+CASS_EXPORT void
+cass_function_meta_full_name(const CassFunctionMeta* function_meta,
+                             const char** full_name,
+                             size_t* full_name_length);
+
+/**
+ * Gets the body of the function.
+ *
+ * @cassandra{2.2+}
+ *
+ * @public @memberof CassFunctionMeta
  *
- * @return The metadata for a column. NULL if column does not exist.
+ * @param[in] function_meta
+ * @param[out] body
+ * @param[out] body_length
  */
-CASS_EXPORT const CassColumnMeta*
-cass_table_meta_column_by_name(const CassTableMeta* table_meta,
-                               const char* column);
+CASS_EXPORT void
+cass_function_meta_body(const CassFunctionMeta* function_meta,
+                        const char** body,
+                        size_t* body_length);
 
 /**
- * Same as cass_table_meta_column_by_name(), but with lengths for string
- * parameters.
+ * Gets the language of the function.
  *
- * @public @memberof CassTableMeta
+ * @cassandra{2.2+}
  *
- * @param[in] table_meta
- * @param[in] column
- * @param[in] column_length
- * @return same as cass_table_meta_column_by_name()
+ * @public @memberof CassFunctionMeta
  *
- * @see cass_table_meta_column_by_name()
+ * @param[in] function_meta
+ * @param[out] language
+ * @param[out] language_length
  */
-CASS_EXPORT const CassColumnMeta*
-cass_table_meta_column_by_name_n(const CassTableMeta* table_meta,
-                                 const char* column,
-                                 size_t column_length);
+CASS_EXPORT void
+cass_function_meta_language(const CassFunctionMeta* function_meta,
+                            const char** language,
+                            size_t* language_length);
 
 /**
- * Gets the total number of columns for the table.
+ * Gets whether a function is called on "null".
  *
- * @public @memberof CassTableMeta
+ * @cassandra{2.2+}
  *
- * @param[in] table_meta
- * @return The total column count.
+ * @public @memberof CassFunctionMeta
+ *
+ * @param[in] function_meta
+ * @return cass_true if a function is called on null, otherwise cass_false.
+ */
+CASS_EXPORT cass_bool_t
+cass_function_meta_called_on_null_input(const CassFunctionMeta* function_meta);
+
+/**
+ * Gets the number of arguments this function takes.
+ *
+ * @cassandra{2.2+}
+ *
+ * @public @memberof CassFunctionMeta
+ *
+ * @param[in] function_meta
+ * @return The number of arguments.
  */
 CASS_EXPORT size_t
-cass_table_meta_column_count(const CassTableMeta* table_meta);
+cass_function_meta_argument_count(const CassFunctionMeta* function_meta);
 
 /**
- * Gets the column metadata for the provided index.
+ * Gets the function's argument name and type for the provided index.
  *
- * @public @memberof CassTableMeta
+ * @cassandra{2.2+}
  *
- * @param[in] table_meta
+ * @public @memberof CassFunctionMeta
+ *
+ * @param[in] function_meta
  * @param[in] index
- * @return The metadata for a column. NULL returned if the index is out of range.
+ * @param[out] name
+ * @param[out] name_length
+ * @param[out] type
+ * @return CASS_OK if successful, otherwise an error occurred
  */
-CASS_EXPORT const CassColumnMeta*
-cass_table_meta_column(const CassTableMeta* table_meta,
-                       size_t index);
+CASS_EXPORT CassError
+cass_function_meta_argument(const CassFunctionMeta* function_meta,
+                            size_t index,
+                            const char** name,
+                            size_t* name_length,
+                            const CassDataType** type);
 
 /**
- * Gets the index metadata for the provided index name.
+ * Gets the function's argument and type for the provided name.
  *
- * @public @memberof CassTableMeta
+ * @cassandra{2.2+}
  *
- * @param[in] table_meta
- * @param[in] index
+ * @public @memberof CassFunctionMeta
  *
- * @return The metadata for a index. NULL if index does not exist.
+ * @param[in] function_meta
+ * @param[in] name
+ * @return A data type. NULL if the argument does not exist.
  */
-CASS_EXPORT const CassIndexMeta*
-cass_table_meta_index_by_name(const CassTableMeta* table_meta,
-                               const char* index);
+CASS_EXPORT const CassDataType*
+cass_function_meta_argument_type_by_name(const CassFunctionMeta* function_meta,
+                                         const char* name);
 
 /**
- * Same as cass_table_meta_index_by_name(), but with lengths for string
+ * Same as cass_function_meta_argument_type_by_name(), but with lengths for string
  * parameters.
  *
- * @public @memberof CassTableMeta
+ * @cassandra{2.2+}
  *
- * @param[in] table_meta
- * @param[in] index
- * @param[in] index_length
- * @return same as cass_table_meta_index_by_name()
+ * @public @memberof CassFunctionMeta
  *
- * @see cass_table_meta_index_by_name()
+ * @param[in] function_meta
+ * @param[in] name
+ * @param[in] name_length
+ * @return same as cass_function_meta_argument_type_by_name()
+ *
+ * @see cass_function_meta_argument_type_by_name()
  */
-CASS_EXPORT const CassIndexMeta*
-cass_table_meta_index_by_name_n(const CassTableMeta* table_meta,
-                                 const char* index,
-                                 size_t index_length);
+CASS_EXPORT const CassDataType*
+cass_function_meta_argument_type_by_name_n(const CassFunctionMeta* function_meta,
+                                           const char* name,
+                                           size_t name_length);
 
 /**
- * Gets the total number of indexes for the table.
+ * Gets the return type of the function.
  *
- * @public @memberof CassTableMeta
+ * @cassandra{2.2+}
  *
- * @param[in] table_meta
- * @return The total index count.
+ * @public @memberof CassFunctionMeta
+ *
+ * @param[in] function_meta
+ * @return The data type returned by the function.
  */
-CASS_EXPORT size_t
-cass_table_meta_index_count(const CassTableMeta* table_meta);
+CASS_EXPORT const CassDataType*
+cass_function_meta_return_type(const CassFunctionMeta* function_meta);
 
 /**
- * Gets the index metadata for the provided index.
+ * Gets a metadata field for the provided name. Metadata fields allow direct
+ * access to the column data found in the underlying "functions" metadata table.
  *
- * @public @memberof CassTableMeta
+ * @cassandra{2.2+}
  *
- * @param[in] table_meta
- * @param[in] index
- * @return The metadata for a index. NULL returned if the index is out of range.
+ * @public @memberof CassFunctionMeta
+ *
+ * @param[in] function_meta
+ * @param[in] name
+ * @return A metadata field value. NULL if the field does not exist.
  */
-CASS_EXPORT const CassIndexMeta*
-cass_table_meta_index(const CassTableMeta* table_meta,
-                      size_t index);
+CASS_EXPORT const CassValue*
+cass_function_meta_field_by_name(const CassFunctionMeta* function_meta,
+                                 const char* name);
 
 /**
- * Gets the materialized view metadata for the provided view name.
+ * Same as cass_function_meta_field_by_name(), but with lengths for string
+ * parameters.
  *
- * @cassandra{3.0+}
+ * @cassandra{2.2+}
  *
- * @public @memberof CassTableMeta
+ * @public @memberof CassFunctionMeta
  *
- * @param[in] table_meta
- * @param[in] view
+ * @param[in] function_meta
+ * @param[in] name
+ * @param[in] name_length
+ * @return same as cass_function_meta_field_by_name()
  *
- * @return The metadata for a view. NULL if view does not exist.
+ * @see cass_function_meta_field_by_name()
  */
-CASS_EXPORT const CassMaterializedViewMeta*
-cass_table_meta_materialized_view_by_name(const CassTableMeta* table_meta,
-                                          const char* view);
+CASS_EXPORT const CassValue*
+cass_function_meta_field_by_name_n(const CassFunctionMeta* function_meta,
+                                   const char* name,
+                                   size_t name_length);
 
 /**
- * Same as cass_table_meta_materialized_view_by_name(), but with lengths for string
- * parameters.
+ * Gets the name of the aggregate.
  *
- * @cassandra{3.0+}
+ * @cassandra{2.2+}
  *
- * @public @memberof CassTableMeta
+ * @public @memberof CassAggregateMeta
  *
- * @param[in] table_meta
- * @param[in] view
- * @param[in] view_length
- * @return same as cass_table_meta_materialized_view_by_name()
+ * @param[in] aggregate_meta
+ * @param[out] name
+ * @param[out] name_length
+ */
+CASS_EXPORT void
+cass_aggregate_meta_name(const CassAggregateMeta* aggregate_meta,
+                         const char** name,
+                         size_t* name_length);
+
+/**
+ * Gets the full name of the aggregate. The full name includes the
+ * aggregate's name and the aggregate's signature:
+ * "name(type1 type2.. typeN)".
  *
- * @see cass_table_meta_materialized_view_by_name()
+ * @cassandra{2.2+}
+ *
+ * @public @memberof CassAggregateMeta
+ *
+ * @param[in] aggregate_meta
+ * @param[out] full_name
+ * @param[out] full_name_length
  */
-CASS_EXPORT const CassMaterializedViewMeta*
-cass_table_meta_materialized_view_by_name_n(const CassTableMeta* table_meta,
-                                            const char* view,
-                                            size_t view_length);
+CASS_EXPORT void
+cass_aggregate_meta_full_name(const CassAggregateMeta* aggregate_meta,
+                              const char** full_name,
+                              size_t* full_name_length);
 
 /**
- * Gets the total number of views for the table.
+ * Gets the number of arguments this aggregate takes.
  *
- * @cassandra{3.0+}
+ * @cassandra{2.2+}
  *
- * @public @memberof CassTableMeta
+ * @public @memberof CassAggregateMeta
  *
- * @param[in] table_meta
- * @return The total view count.
+ * @param[in] aggregate_meta
+ * @return The number of arguments.
  */
 CASS_EXPORT size_t
-cass_table_meta_materialized_view_count(const CassTableMeta* table_meta);
+cass_aggregate_meta_argument_count(const CassAggregateMeta* aggregate_meta);
 
 /**
- * Gets the materialized view metadata for the provided index.
+ * Gets the aggregate's argument type for the provided index.
  *
- * @cassandra{3.0+}
+ * @cassandra{2.2+}
  *
- * @public @memberof CassTableMeta
+ * @public @memberof CassAggregateMeta
  *
- * @param[in] table_meta
+ * @param[in] aggregate_meta
  * @param[in] index
- * @return The metadata for a view. NULL returned if the index is out of range.
+ * @return The data type for argument. NULL returned if the index is out of range.
  */
-CASS_EXPORT const CassMaterializedViewMeta*
-cass_table_meta_materialized_view(const CassTableMeta* table_meta,
+CASS_EXPORT const CassDataType*
+cass_aggregate_meta_argument_type(const CassAggregateMeta* aggregate_meta,
                                   size_t index);
 
 /**
- * Gets the number of columns for the table's partition key.
+ * Gets the return type of the aggregate.
  *
- * @public @memberof CassTableMeta
+ * @cassandra{2.2+}
  *
- * @param[in] table_meta
- * @return The count for the number of columns in the partition key.
+ * @public @memberof CassAggregateMeta
+ *
+ * @param[in] aggregate_meta
+ * @return The data type returned by the aggregate.
  */
-CASS_EXPORT size_t
-cass_table_meta_partition_key_count(const CassTableMeta* table_meta);
+CASS_EXPORT const CassDataType*
+cass_aggregate_meta_return_type(const CassAggregateMeta* aggregate_meta);
 
 /**
- * Gets the partition key column metadata for the provided index.
+ * Gets the state type of the aggregate.
  *
- * @public @memberof CassTableMeta
+ * @cassandra{2.2+}
  *
- * @param[in] table_meta
- * @param[in] index
- * @return The metadata for a column. NULL returned if the index is out of range.
+ * @public @memberof CassAggregateMeta
  *
- * @see cass_table_meta_partition_key_count()
+ * @param[in] aggregate_meta
+ * @return The data type of the aggregate's state.
  */
-CASS_EXPORT const CassColumnMeta*
-cass_table_meta_partition_key(const CassTableMeta* table_meta,
-                              size_t index);
+CASS_EXPORT const CassDataType*
+cass_aggregate_meta_state_type(const CassAggregateMeta* aggregate_meta);
 
 /**
- * Gets the number of columns for the table's clustering key.
+ * Gets the function metadata for the aggregate's state function.
  *
- * @public @memberof CassTableMeta
+ * @cassandra{2.2+}
  *
- * @param[in] table_meta
- * @return The count for the number of columns in the clustering key.
+ * @public @memberof CassAggregateMeta
+ *
+ * @param[in] aggregate_meta
+ * @return The function metadata for the state function.
  */
-CASS_EXPORT size_t
-cass_table_meta_clustering_key_count(const CassTableMeta* table_meta);
+CASS_EXPORT const CassFunctionMeta*
+cass_aggregate_meta_state_func(const CassAggregateMeta* aggregate_meta);
 
 /**
- * Gets the clustering key column metadata for the provided index.
+ * Gets the function metadata for the aggregates's final function.
  *
- * @public @memberof CassTableMeta
+ * @cassandra{2.2+}
  *
- * @param[in] table_meta
- * @param[in] index
- * @return The metadata for a column. NULL returned if the index is out of range.
+ * @public @memberof CassAggregateMeta
  *
- * @see cass_table_meta_clustering_key_count()
+ * @param[in] aggregate_meta
+ * @return The function metadata for the final function.
  */
-CASS_EXPORT const CassColumnMeta*
-cass_table_meta_clustering_key(const CassTableMeta* table_meta,
-                               size_t index);
+CASS_EXPORT const CassFunctionMeta*
+cass_aggregate_meta_final_func(const CassAggregateMeta* aggregate_meta);
 
 /**
- * Gets the clustering order column metadata for the provided index.
+ * Gets the initial condition value for the aggregate.
  *
- * @public @memberof CassTableMeta
+ * @cassandra{2.2+}
  *
- * @param[in] table_meta
- * @param[in] index
- * @return The clustering order for a column.
- * CASS_CLUSTERING_ORDER_NONE returned if the index is out of range.
+ * <b>Note:</b> The value of the initial condition will always be
+ * a "varchar" type for Cassandra 3.0+.
  *
- * @see cass_table_meta_clustering_key_count()
+ * @public @memberof CassAggregateMeta
+ *
+ * @param[in] aggregate_meta
+ * @return The value of the initial condition.
  */
-CASS_EXPORT CassClusteringOrder
-cass_table_meta_clustering_key_order(const CassTableMeta* table_meta,
-                                     size_t index);
+CASS_EXPORT const CassValue*
+cass_aggregate_meta_init_cond(const CassAggregateMeta* aggregate_meta);
 
 /**
  * Gets a metadata field for the provided name. Metadata fields allow direct
- * access to the column data found in the underlying "tables" metadata table.
+ * access to the column data found in the underlying "aggregates" metadata table.
  *
- * @public @memberof CassTableMeta
+ * @cassandra{2.2+}
  *
- * @param[in] table_meta
+ * @public @memberof CassAggregateMeta
+ *
+ * @param[in] aggregate_meta
  * @param[in] name
  * @return A metadata field value. NULL if the field does not exist.
  */
 CASS_EXPORT const CassValue*
-cass_table_meta_field_by_name(const CassTableMeta* table_meta,
-                              const char* name);
+cass_aggregate_meta_field_by_name(const CassAggregateMeta* aggregate_meta,
+                                  const char* name);
 
 /**
- * Same as cass_table_meta_field_by_name(), but with lengths for string
+ * Same as cass_aggregate_meta_field_by_name(), but with lengths for string
  * parameters.
  *
- * @public @memberof CassTableMeta
+ * @cassandra{2.2+}
  *
- * @param[in] table_meta
+ * @public @memberof CassAggregateMeta
+ *
+ * @param[in] aggregate_meta
  * @param[in] name
  * @param[in] name_length
- * @return same as cass_table_meta_field_by_name()
+ * @return same as cass_aggregate_meta_field_by_name()
  *
- * @see cass_table_meta_field_by_name()
+ * @see cass_aggregate_meta_field_by_name()
  */
 CASS_EXPORT const CassValue*
-cass_table_meta_field_by_name_n(const CassTableMeta* table_meta,
-                                const char* name,
-                                size_t name_length);
+cass_aggregate_meta_field_by_name_n(const CassAggregateMeta* aggregate_meta,
+                                    const char* name,
+                                    size_t name_length);
 
-/**
- * Gets the column metadata for the provided column name.
+/***********************************************************************************
  *
- * @cassandra{3.0+}
+ * SSL
  *
- * @public @memberof CassMaterializedViewMeta
+ ************************************************************************************/
+
+/**
+ * Creates a new SSL context.
  *
- * @param[in] view_meta
- * @param[in] column
+ * @public @memberof CassSsl
  *
- * @return The metadata for a column. NULL if column does not exist.
+ * @return Returns a SSL context that must be freed.
+ *
+ * @see cass_ssl_free()
  */
-CASS_EXPORT const CassColumnMeta*
-cass_materialized_view_meta_column_by_name(const CassMaterializedViewMeta* view_meta,
-                                           const char* column);
+CASS_EXPORT CassSsl*
+cass_ssl_new();
 
 /**
- * Same as cass_materialized_view_meta_column_by_name(), but with lengths for string
- * parameters.
+ * Creates a new SSL context <b>without</b> initializing the underlying library
+ * implementation. The integrating application is responsible for
+ * initializing the underlying SSL implementation. The driver uses the SSL
+ * implmentation from several threads concurrently so it's important that it's
+ * properly setup for multithreaded use e.g. lock callbacks for OpenSSL.
  *
- * @cassandra{3.0+}
+ * <b>Important:</b> The SSL library must be initialized before calling this
+ * function.
  *
- * @public @memberof CassMaterializedViewMeta
+ * When using OpenSSL the following components need to be initialized:
  *
- * @param[in] view_meta
- * @param[in] column
- * @param[in] column_length
- * @return same as cass_materialized_view_meta_column_by_name()
+ * SSL_library_init();
+ * SSL_load_error_strings();
+ * OpenSSL_add_all_algorithms();
  *
- * @see cass_materialized_view_meta_column_by_name()
- */
-CASS_EXPORT const CassColumnMeta*
-cass_materialized_view_meta_column_by_name_n(const CassMaterializedViewMeta* view_meta,
-                                             const char* column,
-                                             size_t column_length);
-
-/**
- * Gets the name of the view.
+ * The following thread-safety callbacks also need to be set:
  *
- * @cassandra{3.0+}
+ * CRYPTO_set_locking_callback(...);
+ * CRYPTO_set_id_callback(...);
  *
- * @public @memberof CassMaterializedViewMeta
+ * @public @memberof CassSsl
  *
- * @param[in] view_meta
- * @param[out] name
- * @param[out] name_length
+ * @return Returns a SSL context that must be freed.
+ *
+ * @see cass_ssl_new()
+ * @see cass_ssl_free()
  */
-CASS_EXPORT void
-cass_materialized_view_meta_name(const CassMaterializedViewMeta* view_meta,
-                                 const char** name,
-                                 size_t* name_length);
+CASS_EXPORT CassSsl*
+cass_ssl_new_no_lib_init();
 
 /**
- * Gets the base table of the view.
- *
- * @cassandra{3.0+}
- *
- * @public @memberof CassMaterializedViewMeta
+ * Frees a SSL context instance.
  *
- * @param[in] view_meta
+ * @public @memberof CassSsl
  *
- * @return The base table for the view.
+ * @param[in] ssl
  */
-CASS_EXPORT const CassTableMeta*
-cass_materialized_view_meta_base_table(const CassMaterializedViewMeta* view_meta);
+CASS_EXPORT void
+cass_ssl_free(CassSsl* ssl);
 
 /**
- * Gets the total number of columns for the view.
- *
- * @cassandra{3.0+}
+ * Adds a trusted certificate. This is used to verify
+ * the peer's certificate.
  *
- * @public @memberof CassMaterializedViewMeta
+ * @public @memberof CassSsl
  *
- * @param[in] view_meta
- * @return The total column count.
+ * @param[in] ssl
+ * @param[in] cert PEM formatted certificate string
+ * @return CASS_OK if successful, otherwise an error occurred
  */
-CASS_EXPORT size_t
-cass_materialized_view_meta_column_count(const CassMaterializedViewMeta* view_meta);
+CASS_EXPORT CassError
+cass_ssl_add_trusted_cert(CassSsl* ssl,
+                          const char* cert);
 
 /**
- * Gets the column metadata for the provided index.
+ * Same as cass_ssl_add_trusted_cert(), but with lengths for string
+ * parameters.
  *
- * @cassandra{3.0+}
+ * @public @memberof CassSsl
  *
- * @public @memberof CassMaterializedViewMeta
+ * @param[in] ssl
+ * @param[in] cert
+ * @param[in] cert_length
+ * @return same as cass_ssl_add_trusted_cert()
  *
- * @param[in] view_meta
- * @param[in] index
- * @return The metadata for a column. NULL returned if the index is out of range.
+ * @see cass_ssl_add_trusted_cert()
  */
-CASS_EXPORT const CassColumnMeta*
-cass_materialized_view_meta_column(const CassMaterializedViewMeta* view_meta,
-                                   size_t index);
+CASS_EXPORT CassError
+cass_ssl_add_trusted_cert_n(CassSsl* ssl,
+                            const char* cert,
+                            size_t cert_length);
 
 /**
- * Gets the number of columns for the view's partition key.
+ * Sets verification performed on the peer's certificate.
  *
- * @cassandra{3.0+}
+ * CASS_SSL_VERIFY_NONE - No verification is performed
+ * CASS_SSL_VERIFY_PEER_CERT - Certificate is present and valid
+ * CASS_SSL_VERIFY_PEER_IDENTITY - IP address matches the certificate's
+ * common name or one of its subject alternative names. This implies the
+ * certificate is also present.
+ * CASS_SSL_VERIFY_PEER_IDENTITY_DNS -  Do not use. This option requires the
+ * use of reverse DNS lookup which is not sufficient to protect against
+ * man-in-the-middle attacks.
  *
- * @public @memberof CassMaterializedViewMeta
+ * <b>Default:</b> CASS_SSL_VERIFY_PEER_CERT
+ *
+ * @public @memberof CassSsl
+ *
+ * @param[in] ssl
+ * @param[in] flags
+ * @return CASS_OK if successful, otherwise an error occurred
  *
- * @param[in] view_meta
- * @return The count for the number of columns in the partition key.
  */
-CASS_EXPORT size_t
-cass_materialized_view_meta_partition_key_count(const CassMaterializedViewMeta* view_meta);
+CASS_EXPORT void
+cass_ssl_set_verify_flags(CassSsl* ssl,
+                          int flags);
 
 /**
- * Gets the partition key column metadata for the provided index.
- *
- * @cassandra{3.0+}
+ * Set client-side certificate chain. This is used to authenticate
+ * the client on the server-side. This should contain the entire
+ * Certificate chain starting with the certificate itself.
  *
- * @public @memberof CassMaterializedViewMeta
+ * @public @memberof CassSsl
  *
- * @param[in] view_meta
- * @param[in] index
- * @return The metadata for a column. NULL returned if the index is out of range.
+ * @param[in] ssl
+ * @param[in] cert PEM formatted certificate string
+ * @return CASS_OK if successful, otherwise an error occurred
  */
-CASS_EXPORT const CassColumnMeta*
-cass_materialized_view_meta_partition_key(const CassMaterializedViewMeta* view_meta,
-                                          size_t index);
+CASS_EXPORT CassError
+cass_ssl_set_cert(CassSsl* ssl,
+                  const char* cert);
 
 /**
- * Gets the number of columns for the view's clustering key.
+ * Same as cass_ssl_set_cert(), but with lengths for string
+ * parameters.
  *
- * @cassandra{3.0+}
+ * @public @memberof CassSsl
  *
- * @public @memberof CassMaterializedViewMeta
+ * @param[in] ssl
+ * @param[in] cert
+ * @param[in] cert_length
+ * @return same as cass_ssl_set_cert()
  *
- * @param[in] view_meta
- * @return The count for the number of columns in the clustering key.
+ * @see cass_ssl_set_cert()
  */
-CASS_EXPORT size_t
-cass_materialized_view_meta_clustering_key_count(const CassMaterializedViewMeta* view_meta);
+CASS_EXPORT CassError
+cass_ssl_set_cert_n(CassSsl* ssl,
+                    const char* cert,
+                    size_t cert_length);
 
 /**
- * Gets the clustering key column metadata for the provided index.
- *
- * @cassandra{3.0+}
+ * Set client-side private key. This is used to authenticate
+ * the client on the server-side.
  *
- * @public @memberof CassMaterializedViewMeta
+ * @public @memberof CassSsl
  *
- * @param[in] view_meta
- * @param[in] index
- * @return The metadata for a column. NULL returned if the index is out of range.
+ * @param[in] ssl
+ * @param[in] key PEM formatted key string
+ * @param[in] password used to decrypt key
+ * @return CASS_OK if successful, otherwise an error occurred
  */
-CASS_EXPORT const CassColumnMeta*
-cass_materialized_view_meta_clustering_key(const CassMaterializedViewMeta* view_meta,
-                                           size_t index);
+CASS_EXPORT CassError
+cass_ssl_set_private_key(CassSsl* ssl,
+                         const char* key,
+                         const char* password);
 
 /**
- * Gets the clustering order column metadata for the provided index.
+ * Same as cass_ssl_set_private_key(), but with lengths for string
+ * parameters.
  *
- * @public @memberof CassMaterializedViewMeta
+ * @public @memberof CassSsl
  *
- * @param[in] view_meta
- * @param[in] index
- * @return The clustering order for a column.
- * CASS_CLUSTERING_ORDER_NONE returned if the index is out of range.
+ * @param[in] ssl
+ * @param[in] key
+ * @param[in] key_length
+ * @param[in] password
+ * @param[in] password_length
+ * @return same as cass_ssl_set_private_key()
  *
- * @see cass_materialized_view_meta_clustering_key_count()
+ * @see cass_ssl_set_private_key()
  */
-CASS_EXPORT CassClusteringOrder
-cass_materialized_view_meta_clustering_key_order(const CassMaterializedViewMeta* view_meta,
-                                                 size_t index);
+CASS_EXPORT CassError
+cass_ssl_set_private_key_n(CassSsl* ssl,
+                           const char* key,
+                           size_t key_length,
+                           const char* password,
+                           size_t password_length);
 
 /**
- * Gets a metadata field for the provided name. Metadata fields allow direct
- * access to the column data found in the underlying "views" metadata view.
- *
- * @cassandra{3.0+}
+ * Set minimum supported client-side protocol version. This will prevent the
+ * connection using protocol versions earlier than the specified one. Useful
+ * for preventing TLS downgrade attacks.
  *
- * @public @memberof CassMaterializedViewMeta
+ * @public @memberof CassSsl
  *
- * @param[in] view_meta
- * @param[in] name
- * @return A metadata field value. NULL if the field does not exist.
+ * @param[in] ssl
+ * @param[in] min_version
+ * @return CASS_OK if successful, otherwise an error occurred.
  */
-CASS_EXPORT const CassValue*
-cass_materialized_view_meta_field_by_name(const CassMaterializedViewMeta* view_meta,
-                                          const char* name);
+CASS_EXPORT CassError
+cass_ssl_set_min_protocol_version(CassSsl* ssl, CassSslTlsVersion min_version);
 
 /**
- * Same as cass_materialized_view_meta_field_by_name(), but with lengths for string
- * parameters.
+ * Enable kernel TLS (Linux kTLS) offload. After the handshake, the keys of
+ * the outgoing records are installed on the socket and the kernel encrypts
+ * the requests, which avoids encrypting and copying them in the driver.
+ * Responses are still decrypted by the driver.
  *
- * @cassandra{3.0+}
+ * This requires the "tls" kernel module, TLS 1.2 and an AES-GCM cipher. The
+ * driver encrypts the requests itself for connections where kernel TLS is
+ * unavailable.
  *
- * @public @memberof CassMaterializedViewMeta
+ * <b>Default:</b> cass_false
  *
- * @param[in] view_meta
- * @param[in] name
- * @param[in] name_length
- * @return same as cass_materialized_view_meta_field_by_name()
+ * @public @memberof CassSsl
  *
- * @see cass_materialized_view_meta_field_by_name()
+ * @param[in] ssl
+ * @param[in] enabled
+ * @return CASS_OK if successful, otherwise CASS_ERROR_LIB_NOT_IMPLEMENTED if
+ * the driver was built without kernel TLS support.
  */
-CASS_EXPORT const CassValue*
-cass_materialized_view_meta_field_by_name_n(const CassMaterializedViewMeta* view_meta,
-                                            const char* name,
-                                            size_t name_length);
+CASS_EXPORT CassError
+cass_ssl_set_kernel_tls(CassSsl* ssl, cass_bool_t enabled);
 
 /**
- * Gets the name of the column.
+ * Enable SSL session resumption. The session of each host's last successful
+ * handshake is cached and the next connection to the host tries to resume
+ * it using an abbreviated handshake. This makes connecting pools and
+ * reconnecting cheaper for the driver and the servers. A connection to a host
+ * behind an SNI proxy (e.g. a cloud database) that doesn't have a cached
+ * session tries to resume the last session of the proxy's other hosts.
  *
- * @public @memberof CassColumnMeta
+ * <b>Default:</b> cass_true
  *
- * @param[in] column_meta
- * @param[out] name
- * @param[out] name_length
+ * @public @memberof CassSsl
+ *
+ * @param[in] ssl
+ * @param[in] enabled
+ *
+ * @see cass_ssl_get_session_metrics()
  */
 CASS_EXPORT void
-cass_column_meta_name(const CassColumnMeta* column_meta,
-                      const char** name,
-                      size_t* name_length);
+cass_ssl_set_session_resumption(CassSsl* ssl, cass_bool_t enabled);
 
 /**
- * Gets the type of the column.
+ * Sets the maximum number of handshakes in progress with an endpoint. The
+ * connections to the hosts behind an SNI proxy share the proxy's limit. A
+ * connection that waits for the other handshakes can resume one of their
+ * sessions instead of doing a full handshake so connecting many pools at
+ * once is faster and cheaper for the servers.
  *
- * @public @memberof CassColumnMeta
+ * <b>Default:</b> 0 (no limit) or 8 for the cloud secure connection bundle's
+ * SSL context
  *
- * @param[in] column_meta
- * @return The column's type.
- */
-CASS_EXPORT CassColumnType
-cass_column_meta_type(const CassColumnMeta* column_meta);
-
-/**
- * Gets the data type of the column.
+ * @public @memberof CassSsl
  *
- * @public @memberof CassColumnMeta
+ * @param[in] ssl
+ * @param[in] max_handshakes The maximum number of handshakes or zero for no
+ * limit.
  *
- * @param[in] column_meta
- * @return The column's data type.
+ * @see cass_ssl_set_session_resumption()
+ * @see cass_cluster_set_cloud_secure_connection_bundle()
  */
-CASS_EXPORT const CassDataType*
-cass_column_meta_data_type(const CassColumnMeta* column_meta);
+CASS_EXPORT void
+cass_ssl_set_max_concurrent_handshakes(CassSsl* ssl, unsigned max_handshakes);
 
 /**
- * Gets a metadata field for the provided name. Metadata fields allow direct
- * access to the column data found in the underlying "columns" metadata table.
+ * Gets a copy of the handshake counts of the connections using this SSL
+ * context.
  *
- * @public @memberof CassColumnMeta
+ * @public @memberof CassSsl
  *
- * @param[in] column_meta
- * @param[in] name
- * @return A metadata field value. NULL if the field does not exist.
+ * @param[in] ssl
+ * @param[out] output
+ *
+ * @see cass_ssl_set_session_resumption()
  */
-CASS_EXPORT const CassValue*
-cass_column_meta_field_by_name(const CassColumnMeta* column_meta,
-                               const char* name);
+CASS_EXPORT void
+cass_ssl_get_session_metrics(const CassSsl* ssl, CassSslSessionMetrics* output);
 
 /**
- * Same as cass_column_meta_field_by_name(), but with lengths for string
- * parameters.
+ * Sets the size of the buffers holding a connection's encrypted data. The
+ * buffers are allocated from a pool shared by the connections on the same
+ * I/O thread. Larger buffers let a large response be read with fewer system
+ * calls and fewer buffers, at the cost of more memory for each connection.
  *
- * @public @memberof CassColumnMeta
+ * <b>Default:</b> 16389 (the maximum size of a TLS record)
  *
- * @param[in] column_meta
- * @param[in] name
- * @param[in] name_length
- * @return same as cass_column_meta_field_by_name()
+ * @public @memberof CassSsl
  *
- * @see cass_column_meta_field_by_name()
+ * @param[in] ssl
+ * @param[in] size The size of the buffers in bytes. This must be at least
+ * 16389 bytes.
+ * @return CASS_OK if successful, otherwise CASS_ERROR_LIB_BAD_PARAMS if the size
+ * is too small.
  */
-CASS_EXPORT const CassValue*
-cass_column_meta_field_by_name_n(const CassColumnMeta* column_meta,
-                                 const char* name,
-                                 size_t name_length);
+CASS_EXPORT CassError
+cass_ssl_set_buffer_size(CassSsl* ssl, size_t size);
+
+/***********************************************************************************
+ *
+ * Authenticator
+ *
+ ************************************************************************************/
 
 /**
- * Gets the name of the index.
+ * Gets the IP address of the host being authenticated.
  *
- * @public @memberof CassIndexMeta
+ * @param[in] auth
+ * @param[out] address
  *
- * @param[in] index_meta
- * @param[out] name
- * @param[out] name_length
+ * @public @memberof CassAuthenticator
  */
 CASS_EXPORT void
-cass_index_meta_name(const CassIndexMeta* index_meta,
-                      const char** name,
-                      size_t* name_length);
+cass_authenticator_address(const CassAuthenticator* auth,
+                           CassInet* address);
 
 /**
- * Gets the type of the index.
+ * Gets the hostname of the host being authenticated.
  *
- * @public @memberof CassIndexMeta
+ * @public @memberof CassAuthenticator
  *
- * @param[in] index_meta
- * @return The index's type.
+ * @param[in] auth
+ * @param[out] length
+ * @return A null-terminated string.
  */
-CASS_EXPORT CassIndexType
-cass_index_meta_type(const CassIndexMeta* index_meta);
+CASS_EXPORT const char*
+cass_authenticator_hostname(const CassAuthenticator* auth,
+                            size_t* length);
 
 /**
- * Gets the target of the index.
+ * Gets the class name for the server-side IAuthentication implementation.
  *
- * @public @memberof CassIndexMeta
+ * @public @memberof CassAuthenticator
  *
- * @param[in] index_meta
- * @param[out] target
- * @param[out] target_length
+ * @param[in] auth
+ * @param[out] length
+ * @return A null-terminated string.
  */
-CASS_EXPORT void
-cass_index_meta_target(const CassIndexMeta* index_meta,
-                       const char** target,
-                       size_t* target_length);
+CASS_EXPORT const char*
+cass_authenticator_class_name(const CassAuthenticator* auth,
+                              size_t* length);
 
 /**
- * Gets the options of the index.
+ * Gets the user data created during the authenticator exchange. This
+ * is set using cass_authenticator_set_exchange_data().
  *
- * @public @memberof CassIndexMeta
+ * @public @memberof CassAuthenticator
  *
- * @param[in] index_meta
- * @return The index's options.
+ * @param[in] auth
+ * @return User specified exchange data previously set by
+ * cass_authenticator_set_exchange_data().
+ *
+ * @see cass_authenticator_set_exchange_data()
  */
-CASS_EXPORT const CassValue*
-cass_index_meta_options(const CassIndexMeta* index_meta);
+CASS_EXPORT void*
+cass_authenticator_exchange_data(CassAuthenticator* auth);
 
 /**
- * Gets a metadata field for the provided name. Metadata fields allow direct
- * access to the index data found in the underlying "indexes" metadata table.
+ * Sets the user data to be used during the authenticator exchange.
  *
- * @public @memberof CassIndexMeta
+ * @public @memberof CassAuthenticator
  *
- * @param[in] index_meta
- * @param[in] name
- * @return A metadata field value. NULL if the field does not exist.
- */
-CASS_EXPORT const CassValue*
-cass_index_meta_field_by_name(const CassIndexMeta* index_meta,
-                               const char* name);
+ * @param[in] auth
+ * @param[in] exchange_data
+ *
+ * @see cass_authenticator_exchange_data()
+ */
+CASS_EXPORT void
+cass_authenticator_set_exchange_data(CassAuthenticator* auth,
+                                     void* exchange_data);
 
 /**
- * Same as cass_index_meta_field_by_name(), but with lengths for string
- * parameters.
- *
- * @public @memberof CassIndexMeta
+ * Gets a response token buffer of the provided size.
  *
- * @param[in] index_meta
- * @param[in] name
- * @param[in] name_length
- * @return same as cass_index_meta_field_by_name()
+ * @public @memberof CassAuthenticator
  *
- * @see cass_index_meta_field_by_name()
+ * @param[in] auth
+ * @param[in] size
+ * @return A buffer to copy the response token.
  */
-CASS_EXPORT const CassValue*
-cass_index_meta_field_by_name_n(const CassIndexMeta* index_meta,
-                                 const char* name,
-                                 size_t name_length);
+CASS_EXPORT char*
+cass_authenticator_response(CassAuthenticator* auth,
+                            size_t size);
 
 /**
- * Gets the name of the function.
- *
- * @cassandra{2.2+}
+ * Sets the response token.
  *
- * @public @memberof CassFunctionMeta
+ * @public @memberof CassAuthenticator
  *
- * @param[in] function_meta
- * @param[out] name
- * @param[out] name_length
+ * @param[in] auth
+ * @param[in] response
+ * @param[in] response_size
  */
 CASS_EXPORT void
-cass_function_meta_name(const CassFunctionMeta* function_meta,
-                        const char** name,
-                        size_t* name_length);
+cass_authenticator_set_response(CassAuthenticator* auth,
+                                const char* response,
+                                size_t response_size);
 
 /**
- * Gets the full name of the function. The full name includes the
- * function's name and the function's signature:
- * "name(type1 type2.. typeN)".
- *
- * @cassandra{2.2+}
+ * Sets an error for the authenticator exchange.
  *
- * @public @memberof CassFunctionMeta
+ * @public @memberof CassAuthenticator
  *
- * @param[in] function_meta
- * @param[out] full_name
- * @param[out] full_name_length
+ * @param[in] auth
+ * @param[in] message
  */
 CASS_EXPORT void
-cass_function_meta_full_name(const CassFunctionMeta* function_meta,
-                             const char** full_name,
-                             size_t* full_name_length);
+cass_authenticator_set_error(CassAuthenticator* auth,
+                             const char* message);
 
 /**
- * Gets the body of the function.
+ * Same as cass_authenticator_set_error(), but with lengths for string
+ * parameters.
  *
- * @cassandra{2.2+}
+ * @public @memberof CassAuthenticator
  *
- * @public @memberof CassFunctionMeta
+ * @param[in] auth
+ * @param[in] message
+ * @param[in] message_length
  *
- * @param[in] function_meta
- * @param[out] body
- * @param[out] body_length
+ * @see cass_authenticator_set_error()
  */
 CASS_EXPORT void
-cass_function_meta_body(const CassFunctionMeta* function_meta,
-                        const char** body,
-                        size_t* body_length);
+cass_authenticator_set_error_n(CassAuthenticator* auth,
+                               const char* message,
+                               size_t message_length);
 
-/**
- * Gets the language of the function.
+/***********************************************************************************
  *
- * @cassandra{2.2+}
+ * Future
  *
- * @public @memberof CassFunctionMeta
+ ***********************************************************************************/
+
+/**
+ * Frees a future instance. A future can be freed anytime.
  *
- * @param[in] function_meta
- * @param[out] language
- * @param[out] language_length
+ * @public @memberof CassFuture
  */
 CASS_EXPORT void
-cass_function_meta_language(const CassFunctionMeta* function_meta,
-                            const char** language,
-                            size_t* language_length);
+cass_future_free(CassFuture* future);
 
 /**
- * Gets whether a function is called on "null".
+ * Sets a callback that is called when a future is set
  *
- * @cassandra{2.2+}
+ * @public @memberof CassFuture
  *
- * @public @memberof CassFunctionMeta
+ * @param[in] future
+ * @param[in] callback
+ * @param[in] data
+ * @return CASS_OK if successful, otherwise an error occurred
+ */
+CASS_EXPORT CassError
+cass_future_set_callback(CassFuture* future,
+                         CassFutureCallback callback,
+                         void* data);
+
+/**
+ * Gets the set status of the future.
  *
- * @param[in] function_meta
- * @return cass_true if a function is called on null, otherwise cass_false.
+ * @public @memberof CassFuture
+ *
+ * @param[in] future
+ * @return true if set
  */
 CASS_EXPORT cass_bool_t
-cass_function_meta_called_on_null_input(const CassFunctionMeta* function_meta);
+cass_future_ready(CassFuture* future);
 
 /**
- * Gets the number of arguments this function takes.
+ * Wait for the future to be set with either a result or error.
  *
- * @cassandra{2.2+}
+ * <b>Important:</b> Do not wait in a future callback. Waiting in a future
+ * callback will cause a deadlock.
  *
- * @public @memberof CassFunctionMeta
+ * @public @memberof CassFuture
  *
- * @param[in] function_meta
- * @return The number of arguments.
+ * @param[in] future
  */
-CASS_EXPORT size_t
-cass_function_meta_argument_count(const CassFunctionMeta* function_meta);
+CASS_EXPORT void
+cass_future_wait(CassFuture* future);
 
 /**
- * Gets the function's argument name and type for the provided index.
- *
- * @cassandra{2.2+}
+ * Wait for the future to be set or timeout.
  *
- * @public @memberof CassFunctionMeta
+ * @public @memberof CassFuture
  *
- * @param[in] function_meta
- * @param[in] index
- * @param[out] name
- * @param[out] name_length
- * @param[out] type
- * @return CASS_OK if successful, otherwise an error occurred
+ * @param[in] future
+ * @param[in] timeout_us wait time in microseconds
+ * @return false if returned due to timeout
  */
-CASS_EXPORT CassError
-cass_function_meta_argument(const CassFunctionMeta* function_meta,
-                            size_t index,
-                            const char** name,
-                            size_t* name_length,
-                            const CassDataType** type);
+CASS_EXPORT cass_bool_t
+cass_future_wait_timed(CassFuture* future,
+                       cass_duration_t timeout_us);
 
 /**
- * Gets the function's argument and type for the provided name.
+ * Gets the result of a successful future. If the future is not ready this method will
+ * wait for the future to be set.
  *
- * @cassandra{2.2+}
+ * @public @memberof CassFuture
  *
- * @public @memberof CassFunctionMeta
+ * @param[in] future
+ * @return CassResult instance if successful, otherwise NULL for error. The return instance
+ * must be freed using cass_result_free().
  *
- * @param[in] function_meta
- * @param[in] name
- * @return A data type. NULL if the argument does not exist.
+ * @see cass_session_execute() and cass_session_execute_batch()
  */
-CASS_EXPORT const CassDataType*
-cass_function_meta_argument_type_by_name(const CassFunctionMeta* function_meta,
-                                         const char* name);
+CASS_EXPORT const CassResult*
+cass_future_get_result(CassFuture* future);
 
 /**
- * Same as cass_function_meta_argument_type_by_name(), but with lengths for string
- * parameters.
- *
- * @cassandra{2.2+}
+ * Gets the error result from a future that failed as a result of a server error. If the
+ * future is not ready this method will wait for the future to be set.
  *
- * @public @memberof CassFunctionMeta
+ * @public @memberof CassFuture
  *
- * @param[in] function_meta
- * @param[in] name
- * @param[in] name_length
- * @return same as cass_function_meta_argument_type_by_name()
+ * @param[in] future
+ * @return CassErrorResult instance if the request failed with a server error,
+ * otherwise NULL if the request was successful or the failure was not caused by
+ * a server error. The return instance must be freed using cass_error_result_free().
  *
- * @see cass_function_meta_argument_type_by_name()
+ * @see cass_session_execute() and cass_session_execute_batch()
  */
-CASS_EXPORT const CassDataType*
-cass_function_meta_argument_type_by_name_n(const CassFunctionMeta* function_meta,
-                                           const char* name,
-                                           size_t name_length);
+CASS_EXPORT const CassErrorResult*
+cass_future_get_error_result(CassFuture* future);
 
 /**
- * Gets the return type of the function.
+ * Gets the result of a successful future. If the future is not ready this method will
+ * wait for the future to be set. The first successful call consumes the future, all
+ * subsequent calls will return NULL.
  *
- * @cassandra{2.2+}
+ * @public @memberof CassFuture
  *
- * @public @memberof CassFunctionMeta
+ * @param[in] future
+ * @return CassPrepared instance if successful, otherwise NULL for error. The return instance
+ * must be freed using cass_prepared_free().
  *
- * @param[in] function_meta
- * @return The data type returned by the function.
+ * @see cass_session_prepare()
  */
-CASS_EXPORT const CassDataType*
-cass_function_meta_return_type(const CassFunctionMeta* function_meta);
+CASS_EXPORT const CassPrepared*
+cass_future_get_prepared(CassFuture* future);
 
 /**
- * Gets a metadata field for the provided name. Metadata fields allow direct
- * access to the column data found in the underlying "functions" metadata table.
+ * Gets the error code from future. If the future is not ready this method will
+ * wait for the future to be set.
  *
- * @cassandra{2.2+}
+ * @public @memberof CassFuture
  *
- * @public @memberof CassFunctionMeta
+ * @param[in] future
+ * @return CASS_OK if successful, otherwise an error occurred.
  *
- * @param[in] function_meta
- * @param[in] name
- * @return A metadata field value. NULL if the field does not exist.
+ * @see cass_error_desc()
  */
-CASS_EXPORT const CassValue*
-cass_function_meta_field_by_name(const CassFunctionMeta* function_meta,
-                                 const char* name);
+CASS_EXPORT CassError
+cass_future_error_code(CassFuture* future);
 
 /**
- * Same as cass_function_meta_field_by_name(), but with lengths for string
- * parameters.
- *
- * @cassandra{2.2+}
- *
- * @public @memberof CassFunctionMeta
+ * Gets the error message from future. If the future is not ready this method will
+ * wait for the future to be set.
  *
- * @param[in] function_meta
- * @param[in] name
- * @param[in] name_length
- * @return same as cass_function_meta_field_by_name()
+ * @public @memberof CassFuture
  *
- * @see cass_function_meta_field_by_name()
+ * @param[in] future
+ * @param[out] message Empty string returned if successful, otherwise
+ * a message describing the error is returned.
+ * @param[out] message_length
  */
-CASS_EXPORT const CassValue*
-cass_function_meta_field_by_name_n(const CassFunctionMeta* function_meta,
-                                   const char* name,
-                                   size_t name_length);
+CASS_EXPORT void
+cass_future_error_message(CassFuture* future,
+                          const char** message,
+                          size_t* message_length);
 
 /**
- * Gets the name of the aggregate.
- *
- * @cassandra{2.2+}
+ * Gets the tracing ID associated with the request.
  *
- * @public @memberof CassAggregateMeta
+ * @public @memberof CassFuture
  *
- * @param[in] aggregate_meta
- * @param[out] name
- * @param[out] name_length
+ * @param[in] future
+ * @param[out] tracing_id
+ * @return CASS_OK if successful, otherwise an error occurred.
  */
-CASS_EXPORT void
-cass_aggregate_meta_name(const CassAggregateMeta* aggregate_meta,
-                         const char** name,
-                         size_t* name_length);
+CASS_EXPORT CassError
+cass_future_tracing_id(CassFuture* future,
+                       CassUuid* tracing_id);
 
 /**
- * Gets the full name of the aggregate. The full name includes the
- * aggregate's name and the aggregate's signature:
- * "name(type1 type2.. typeN)".
+ * Gets a future that's set once the tracing data of the request is available
+ * in the system_traces tables. The future is set with an error if the tracing
+ * data isn't available within the tracing maximum wait time. The future is
+ * already set if the response future waited for the tracing data.
  *
- * @cassandra{2.2+}
+ * <b>Note:</b> The returned future must be freed using cass_future_free().
  *
- * @public @memberof CassAggregateMeta
+ * @public @memberof CassFuture
  *
- * @param[in] aggregate_meta
- * @param[out] full_name
- * @param[out] full_name_length
+ * @param[in] future
+ * @param[out] tracing_data_future
+ * @return CASS_OK if successful, otherwise error occurred
+ *
+ * @see cass_cluster_set_tracing_wait_for_data()
  */
-CASS_EXPORT void
-cass_aggregate_meta_full_name(const CassAggregateMeta* aggregate_meta,
-                              const char** full_name,
-                              size_t* full_name_length);
+CASS_EXPORT CassError
+cass_future_tracing_data(CassFuture* future,
+                         CassFuture** tracing_data_future);
 
 /**
- * Gets the number of arguments this aggregate takes.
+ * Gets a the number of custom payload items from a response future. If the future is not
+ * ready this method will wait for the future to be set.
  *
  * @cassandra{2.2+}
  *
- * @public @memberof CassAggregateMeta
+ * @public @memberof CassFuture
  *
- * @param[in] aggregate_meta
- * @return The number of arguments.
+ * @param[in] future
+ * @return the number of custom payload items.
  */
 CASS_EXPORT size_t
-cass_aggregate_meta_argument_count(const CassAggregateMeta* aggregate_meta);
+cass_future_custom_payload_item_count(CassFuture* future);
 
 /**
- * Gets the aggregate's argument type for the provided index.
+ * Gets a custom payload item from a response future at the specified index. If the future is not
+ * ready this method will wait for the future to be set.
  *
  * @cassandra{2.2+}
  *
- * @public @memberof CassAggregateMeta
+ * @public @memberof CassFuture
  *
- * @param[in] aggregate_meta
+ * @param[in] future
  * @param[in] index
- * @return The data type for argument. NULL returned if the index is out of range.
+ * @param[out] name
+ * @param[out] name_length
+ * @param[out] value
+ * @param[out] value_size
+ * @return CASS_OK if successful, otherwise an error occurred.
  */
-CASS_EXPORT const CassDataType*
-cass_aggregate_meta_argument_type(const CassAggregateMeta* aggregate_meta,
-                                  size_t index);
+CASS_EXPORT CassError
+cass_future_custom_payload_item(CassFuture* future,
+                                size_t index,
+                                const char** name,
+                                size_t* name_length,
+                                const cass_byte_t** value,
+                                size_t* value_size);
 
 /**
- * Gets the return type of the aggregate.
+ * Gets the node that acted as coordinator for this query. If the future is not
+ * ready this method will wait for the future to be set.
  *
- * @cassandra{2.2+}
+ * @public @memberof CassFuture
  *
- * @public @memberof CassAggregateMeta
+ * @param future
+ * @return The coordinator node that handled the query. The lifetime of this
+ * object is the same as the result object it came from. NULL can be returned
+ * if the future is not a response future or if an error occurs before a
+ * coordinator responds.
  *
- * @param[in] aggregate_meta
- * @return The data type returned by the aggregate.
+ * @see cass_statement_set_node()
  */
-CASS_EXPORT const CassDataType*
-cass_aggregate_meta_return_type(const CassAggregateMeta* aggregate_meta);
+CASS_EXPORT const CassNode*
+cass_future_coordinator(CassFuture* future);
 
-/**
- * Gets the state type of the aggregate.
- *
- * @cassandra{2.2+}
+/***********************************************************************************
  *
- * @public @memberof CassAggregateMeta
+ * Future Group
  *
- * @param[in] aggregate_meta
- * @return The data type of the aggregate's state.
- */
-CASS_EXPORT const CassDataType*
-cass_aggregate_meta_state_type(const CassAggregateMeta* aggregate_meta);
+ ***********************************************************************************/
 
 /**
- * Gets the function metadata for the aggregate's state function.
+ * Creates a new future group. Futures added to the group are posted to the
+ * group's queue when they're set and can then be drained in batches using
+ * cass_future_group_wait().
  *
- * @cassandra{2.2+}
+ * @public @memberof CassFutureGroup
  *
- * @public @memberof CassAggregateMeta
+ * @param[in] queue_size The expected maximum number of completed futures that
+ * haven't been drained. Completed futures that don't fit in the queue are
+ * still kept, but are slower to post and drain.
+ * @return Returns a future group that must be freed.
  *
- * @param[in] aggregate_meta
- * @return The function metadata for the state function.
+ * @see cass_future_group_free()
  */
-CASS_EXPORT const CassFunctionMeta*
-cass_aggregate_meta_state_func(const CassAggregateMeta* aggregate_meta);
+CASS_EXPORT CassFutureGroup*
+cass_future_group_new(size_t queue_size);
 
 /**
- * Gets the function metadata for the aggregates's final function.
+ * Frees a future group instance. Futures that were added to the group, but
+ * never drained, are freed with it.
  *
- * @cassandra{2.2+}
- *
- * @public @memberof CassAggregateMeta
+ * @public @memberof CassFutureGroup
  *
- * @param[in] aggregate_meta
- * @return The function metadata for the final function.
+ * @param[in] group
  */
-CASS_EXPORT const CassFunctionMeta*
-cass_aggregate_meta_final_func(const CassAggregateMeta* aggregate_meta);
+CASS_EXPORT void
+cass_future_group_free(CassFutureGroup* group);
 
 /**
- * Gets the initial condition value for the aggregate.
- *
- * @cassandra{2.2+}
+ * Adds a future to the group. This uses the future's callback so a future
+ * that already has a callback can't be added. The group keeps its own
+ * reference to the future; the future can be freed after it's been added.
  *
- * <b>Note:</b> The value of the initial condition will always be
- * a "varchar" type for Cassandra 3.0+.
+ * @public @memberof CassFutureGroup
  *
- * @public @memberof CassAggregateMeta
+ * @param[in] group
+ * @param[in] future
+ * @return CASS_OK if successful, otherwise CASS_ERROR_LIB_CALLBACK_ALREADY_SET
+ * if the future already has a callback.
  *
- * @param[in] aggregate_meta
- * @return The value of the initial condition.
+ * @see cass_future_set_callback()
  */
-CASS_EXPORT const CassValue*
-cass_aggregate_meta_init_cond(const CassAggregateMeta* aggregate_meta);
+CASS_EXPORT CassError
+cass_future_group_add(CassFutureGroup* group,
+                      CassFuture* future);
 
 /**
- * Gets a metadata field for the provided name. Metadata fields allow direct
- * access to the column data found in the underlying "aggregates" metadata table.
+ * Drains up to count completed futures from the group. If no futures have
+ * completed this waits up to the timeout for a future to complete.
  *
- * @cassandra{2.2+}
+ * <b>Important:</b> Each future that's returned must be freed using
+ * cass_future_free().
  *
- * @public @memberof CassAggregateMeta
+ * @public @memberof CassFutureGroup
  *
- * @param[in] aggregate_meta
- * @param[in] name
- * @return A metadata field value. NULL if the field does not exist.
+ * @param[in] group
+ * @param[out] futures An array with room for at least count futures.
+ * @param[in] count
+ * @param[in] timeout_us The time to wait for a future to complete if no
+ * futures are available. Use 0 to return immediately.
+ * @return The number of futures drained. This is 0 if the timeout expired.
  */
-CASS_EXPORT const CassValue*
-cass_aggregate_meta_field_by_name(const CassAggregateMeta* aggregate_meta,
-                                  const char* name);
+CASS_EXPORT size_t
+cass_future_group_wait(CassFutureGroup* group,
+                       CassFuture** futures,
+                       size_t count,
+                       cass_duration_t timeout_us);
 
 /**
- * Same as cass_aggregate_meta_field_by_name(), but with lengths for string
- * parameters.
+ * Runs a future's callback that was submitted to an application's executor
+ * and frees the task.
  *
- * @cassandra{2.2+}
- *
- * @public @memberof CassAggregateMeta
+ * @public @memberof CassCallbackTask
  *
- * @param[in] aggregate_meta
- * @param[in] name
- * @param[in] name_length
- * @return same as cass_aggregate_meta_field_by_name()
+ * @param[in] task
  *
- * @see cass_aggregate_meta_field_by_name()
+ * @see cass_cluster_set_callback_executor()
  */
-CASS_EXPORT const CassValue*
-cass_aggregate_meta_field_by_name_n(const CassAggregateMeta* aggregate_meta,
-                                    const char* name,
-                                    size_t name_length);
+CASS_EXPORT void
+cass_callback_task_run(CassCallbackTask* task);
 
 /***********************************************************************************
  *
- * SSL
+ * Request Trace Event
  *
- ************************************************************************************/
+ ***********************************************************************************/
 
 /**
- * Creates a new SSL context.
- *
- * @public @memberof CassSsl
+ * Gets the type of a request trace event.
  *
- * @return Returns a SSL context that must be freed.
+ * @public @memberof CassRequestTraceEvent
  *
- * @see cass_ssl_free()
+ * @param[in] event
+ * @return The event's type.
  */
-CASS_EXPORT CassSsl*
-cass_ssl_new();
+CASS_EXPORT CassRequestTraceEventType
+cass_request_trace_event_type(const CassRequestTraceEvent* event);
 
 /**
- * Creates a new SSL context <b>without</b> initializing the underlying library
- * implementation. The integrating application is responsible for
- * initializing the underlying SSL implementation. The driver uses the SSL
- * implmentation from several threads concurrently so it's important that it's
- * properly setup for multithreaded use e.g. lock callbacks for OpenSSL.
- *
- * <b>Important:</b> The SSL library must be initialized before calling this
- * function.
- *
- * When using OpenSSL the following components need to be initialized:
- *
- * SSL_library_init();
- * SSL_load_error_strings();
- * OpenSSL_add_all_algorithms();
- *
- * The following thread-safety callbacks also need to be set:
+ * Gets the ID of the request of an event. The IDs are unique within a
+ * session.
  *
- * CRYPTO_set_locking_callback(...);
- * CRYPTO_set_id_callback(...);
+ * @public @memberof CassRequestTraceEvent
  *
- * @public @memberof CassSsl
+ * @param[in] event
+ * @return The request's ID.
+ */
+CASS_EXPORT cass_uint64_t
+cass_request_trace_event_request_id(const CassRequestTraceEvent* event);
+
+/**
+ * Gets the time of an event from a monotonic clock.
  *
- * @return Returns a SSL context that must be freed.
+ * @public @memberof CassRequestTraceEvent
  *
- * @see cass_ssl_new()
- * @see cass_ssl_free()
+ * @param[in] event
+ * @return The time in nanoseconds.
  */
-CASS_EXPORT CassSsl*
-cass_ssl_new_no_lib_init();
+CASS_EXPORT cass_uint64_t
+cass_request_trace_event_timestamp(const CassRequestTraceEvent* event);
 
 /**
- * Frees a SSL context instance.
+ * Gets the host of an event: the host a request was sent to for attempts,
+ * the host a request is retried on for retries and the host that finished a
+ * request for finish events.
  *
- * @public @memberof CassSsl
+ * @public @memberof CassRequestTraceEvent
  *
- * @param[in] ssl
+ * @param[in] event
+ * @param[out] address
+ * @return CASS_OK if successful, otherwise CASS_ERROR_LIB_NO_HOSTS_AVAILABLE
+ * if the event isn't for a host.
  */
-CASS_EXPORT void
-cass_ssl_free(CassSsl* ssl);
+CASS_EXPORT CassError
+cass_request_trace_event_host(const CassRequestTraceEvent* event,
+                              CassInet* address);
 
 /**
- * Adds a trusted certificate. This is used to verify
- * the peer's certificate.
+ * Gets the error of a finished request.
  *
- * @public @memberof CassSsl
+ * @public @memberof CassRequestTraceEvent
  *
- * @param[in] ssl
- * @param[in] cert PEM formatted certificate string
- * @return CASS_OK if successful, otherwise an error occurred
+ * @param[in] event
+ * @return CASS_OK for other events or if the request succeeded, otherwise
+ * the request's error.
  */
 CASS_EXPORT CassError
-cass_ssl_add_trusted_cert(CassSsl* ssl,
-                          const char* cert);
+cass_request_trace_event_error_code(const CassRequestTraceEvent* event);
 
 /**
- * Same as cass_ssl_add_trusted_cert(), but with lengths for string
- * parameters.
+ * Gets the query of the request of an event (see cass_slow_request_query()).
+ * The query is only built when it's used.
  *
- * @public @memberof CassSsl
+ * @public @memberof CassRequestTraceEvent
  *
- * @param[in] ssl
- * @param[in] cert
- * @param[in] cert_length
- * @return same as cass_ssl_add_trusted_cert()
+ * @param[in] event
+ * @param[out] query
+ * @param[out] query_length
+ */
+CASS_EXPORT void
+cass_request_trace_event_query(CassRequestTraceEvent* event,
+                               const char** query,
+                               size_t* query_length);
+
+/**
+ * Sets the tracer's data for the request of an event, e.g. the span that's
+ * started for the request. The data is passed to all of the request's later
+ * events.
  *
- * @see cass_ssl_add_trusted_cert()
+ * @public @memberof CassRequestTraceEvent
+ *
+ * @param[in] event
+ * @param[in] span
  */
-CASS_EXPORT CassError
-cass_ssl_add_trusted_cert_n(CassSsl* ssl,
-                            const char* cert,
-                            size_t cert_length);
+CASS_EXPORT void
+cass_request_trace_event_set_span(CassRequestTraceEvent* event,
+                                  void* span);
 
 /**
- * Sets verification performed on the peer's certificate.
+ * Gets the tracer's data for the request of an event.
  *
- * CASS_SSL_VERIFY_NONE - No verification is performed
- * CASS_SSL_VERIFY_PEER_CERT - Certificate is present and valid
- * CASS_SSL_VERIFY_PEER_IDENTITY - IP address matches the certificate's
- * common name or one of its subject alternative names. This implies the
- * certificate is also present.
- * CASS_SSL_VERIFY_PEER_IDENTITY_DNS -  Do not use. This option requires the
- * use of reverse DNS lookup which is not sufficient to protect against
- * man-in-the-middle attacks.
+ * @public @memberof CassRequestTraceEvent
+ *
+ * @param[in] event
+ * @return The data set by cass_request_trace_event_set_span() or NULL.
+ */
+CASS_EXPORT void*
+cass_request_trace_event_span(const CassRequestTraceEvent* event);
+
+/***********************************************************************************
  *
- * <b>Default:</b> CASS_SSL_VERIFY_PEER_CERT
+ * Slow Request
  *
- * @public @memberof CassSsl
+ ***********************************************************************************/
+
+/**
+ * Frees a slow request taken from a session's slow request log.
  *
- * @param[in] ssl
- * @param[in] flags
- * @return CASS_OK if successful, otherwise an error occurred
+ * @public @memberof CassSlowRequest
  *
+ * @param[in] request
  */
 CASS_EXPORT void
-cass_ssl_set_verify_flags(CassSsl* ssl,
-                          int flags);
+cass_slow_request_free(CassSlowRequest* request);
 
 /**
- * Set client-side certificate chain. This is used to authenticate
- * the client on the server-side. This should contain the entire
- * Certificate chain starting with the certificate itself.
+ * Gets the query of a slow request: the query of a simple statement, the
+ * prepared query of a bound statement or the queries of a batch's
+ * statements. Long queries are truncated.
  *
- * @public @memberof CassSsl
+ * @public @memberof CassSlowRequest
  *
- * @param[in] ssl
- * @param[in] cert PEM formatted certificate string
- * @return CASS_OK if successful, otherwise an error occurred
+ * @param[in] request
+ * @param[out] query
+ * @param[out] query_length
  */
-CASS_EXPORT CassError
-cass_ssl_set_cert(CassSsl* ssl,
-                  const char* cert);
+CASS_EXPORT void
+cass_slow_request_query(const CassSlowRequest* request,
+                        const char** query,
+                        size_t* query_length);
 
 /**
- * Same as cass_ssl_set_cert(), but with lengths for string
- * parameters.
- *
- * @public @memberof CassSsl
+ * Gets the error of a slow request.
  *
- * @param[in] ssl
- * @param[in] cert
- * @param[in] cert_length
- * @return same as cass_ssl_set_cert()
+ * @public @memberof CassSlowRequest
  *
- * @see cass_ssl_set_cert()
+ * @param[in] request
+ * @return CASS_OK if the request succeeded, otherwise the request's error.
  */
 CASS_EXPORT CassError
-cass_ssl_set_cert_n(CassSsl* ssl,
-                    const char* cert,
-                    size_t cert_length);
+cass_slow_request_error_code(const CassSlowRequest* request);
 
 /**
- * Set client-side private key. This is used to authenticate
- * the client on the server-side.
+ * Gets the address of the host that finished a slow request.
  *
- * @public @memberof CassSsl
+ * @public @memberof CassSlowRequest
  *
- * @param[in] ssl
- * @param[in] key PEM formatted key string
- * @param[in] password used to decrypt key
- * @return CASS_OK if successful, otherwise an error occurred
+ * @param[in] request
+ * @param[out] address
+ * @return CASS_OK if successful, otherwise CASS_ERROR_LIB_NO_HOSTS_AVAILABLE
+ * if no host responded to the request.
  */
 CASS_EXPORT CassError
-cass_ssl_set_private_key(CassSsl* ssl,
-                         const char* key,
-                         const char* password);
+cass_slow_request_coordinator(const CassSlowRequest* request,
+                              CassInet* address);
 
 /**
- * Same as cass_ssl_set_private_key(), but with lengths for string
- * parameters.
- *
- * @public @memberof CassSsl
+ * Gets the number of times a slow request was sent to a host, including its
+ * retries and speculative executions.
  *
- * @param[in] ssl
- * @param[in] key
- * @param[in] key_length
- * @param[in] password
- * @param[in] password_length
- * @return same as cass_ssl_set_private_key()
+ * @public @memberof CassSlowRequest
  *
- * @see cass_ssl_set_private_key()
+ * @param[in] request
+ * @return The number of attempted hosts.
  */
-CASS_EXPORT CassError
-cass_ssl_set_private_key_n(CassSsl* ssl,
-                           const char* key,
-                           size_t key_length,
-                           const char* password,
-                           size_t password_length);
+CASS_EXPORT size_t
+cass_slow_request_attempted_host_count(const CassSlowRequest* request);
 
 /**
- * Set minimum supported client-side protocol version. This will prevent the
- * connection using protocol versions earlier than the specified one. Useful
- * for preventing TLS downgrade attacks.
+ * Gets the address of a host a slow request was sent to, in the order the
+ * request was sent.
  *
- * @public @memberof CassSsl
+ * @public @memberof CassSlowRequest
  *
- * @param[in] ssl
- * @param[in] min_version
- * @return CASS_OK if successful, otherwise an error occurred.
+ * @param[in] request
+ * @param[in] index
+ * @param[out] address
+ * @return CASS_OK if successful, otherwise CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS.
  */
 CASS_EXPORT CassError
-cass_ssl_set_min_protocol_version(CassSsl* ssl, CassSslTlsVersion min_version);
+cass_slow_request_attempted_host(const CassSlowRequest* request,
+                                 size_t index,
+                                 CassInet* address);
 
-/***********************************************************************************
+/**
+ * Gets the number of retries of a slow request.
  *
- * Authenticator
+ * @public @memberof CassSlowRequest
  *
- ************************************************************************************/
+ * @param[in] request
+ * @return The number of retries.
+ */
+CASS_EXPORT unsigned
+cass_slow_request_retries(const CassSlowRequest* request);
 
 /**
- * Gets the IP address of the host being authenticated.
+ * Gets the number of speculative executions started for a slow request.
  *
- * @param[in] auth
- * @param[out] address
+ * @public @memberof CassSlowRequest
  *
- * @public @memberof CassAuthenticator
+ * @param[in] request
+ * @return The number of speculative executions.
  */
-CASS_EXPORT void
-cass_authenticator_address(const CassAuthenticator* auth,
-                           CassInet* address);
+CASS_EXPORT unsigned
+cass_slow_request_speculative_executions(const CassSlowRequest* request);
 
 /**
- * Gets the hostname of the host being authenticated.
+ * Gets the latency of a slow request, from the time it was executed until
+ * it was finished.
  *
- * @public @memberof CassAuthenticator
+ * @public @memberof CassSlowRequest
  *
- * @param[in] auth
- * @param[out] length
- * @return A null-terminated string.
+ * @param[in] request
+ * @return The latency in microseconds.
  */
-CASS_EXPORT const char*
-cass_authenticator_hostname(const CassAuthenticator* auth,
-                            size_t* length);
+CASS_EXPORT cass_uint64_t
+cass_slow_request_latency(const CassSlowRequest* request);
 
 /**
- * Gets the class name for the server-side IAuthentication implementation.
+ * Gets the time a slow request waited in the request processor's queue.
  *
- * @public @memberof CassAuthenticator
+ * @public @memberof CassSlowRequest
  *
- * @param[in] auth
- * @param[out] length
- * @return A null-terminated string.
+ * @param[in] request
+ * @return The time in microseconds.
  */
-CASS_EXPORT const char*
-cass_authenticator_class_name(const CassAuthenticator* auth,
-                              size_t* length);
+CASS_EXPORT cass_uint64_t
+cass_slow_request_queue_time(const CassSlowRequest* request);
 
 /**
- * Gets the user data created during the authenticator exchange. This
- * is set using cass_authenticator_set_exchange_data().
+ * Gets the time spent writing a slow request to the socket. This is the
+ * time of the execution that finished the request.
  *
- * @public @memberof CassAuthenticator
+ * @public @memberof CassSlowRequest
  *
- * @param[in] auth
- * @return User specified exchange data previously set by
- * cass_authenticator_set_exchange_data().
+ * @param[in] request
+ * @return The time in microseconds or 0 if no host responded.
+ */
+CASS_EXPORT cass_uint64_t
+cass_slow_request_write_time(const CassSlowRequest* request);
+
+/**
+ * Gets the time between writing a slow request and reading its response.
+ * This is the time of the execution that finished the request.
  *
- * @see cass_authenticator_set_exchange_data()
+ * @public @memberof CassSlowRequest
+ *
+ * @param[in] request
+ * @return The time in microseconds or 0 if no host responded.
  */
-CASS_EXPORT void*
-cass_authenticator_exchange_data(CassAuthenticator* auth);
+CASS_EXPORT cass_uint64_t
+cass_slow_request_server_time(const CassSlowRequest* request);
+
+/***********************************************************************************
+ *
+ * Table Scan
+ *
+ ***********************************************************************************/
 
 /**
- * Sets the user data to be used during the authenticator exchange.
+ * Creates a new scan of all the rows of a table. The table is split into the
+ * token ranges of the session's token map and each range is queried using a
+ * "token(<partition key>)" restriction, so token aware routing must be
+ * enabled.
  *
- * @public @memberof CassAuthenticator
+ * @public @memberof CassTableScan
  *
- * @param[in] auth
- * @param[in] exchange_data
+ * @param[in] keyspace
+ * @param[in] table
+ * @return Returns a table scan that must be freed.
  *
- * @see cass_authenticator_exchange_data()
+ * @see cass_table_scan_free()
+ * @see cass_session_scan_table()
  */
-CASS_EXPORT void
-cass_authenticator_set_exchange_data(CassAuthenticator* auth,
-                                     void* exchange_data);
+CASS_EXPORT CassTableScan*
+cass_table_scan_new(const char* keyspace,
+                    const char* table);
 
 /**
- * Gets a response token buffer of the provided size.
+ * Same as cass_table_scan_new(), but with lengths for string
+ * parameters.
  *
- * @public @memberof CassAuthenticator
+ * @public @memberof CassTableScan
  *
- * @param[in] auth
- * @param[in] size
- * @return A buffer to copy the response token.
+ * @param[in] keyspace
+ * @param[in] keyspace_length
+ * @param[in] table
+ * @param[in] table_length
+ * @return same as cass_table_scan_new()
+ *
+ * @see cass_table_scan_new()
  */
-CASS_EXPORT char*
-cass_authenticator_response(CassAuthenticator* auth,
-                            size_t size);
+CASS_EXPORT CassTableScan*
+cass_table_scan_new_n(const char* keyspace,
+                      size_t keyspace_length,
+                      const char* table,
+                      size_t table_length);
 
 /**
- * Sets the response token.
+ * Frees a table scan instance. A scan that's still running is stopped once
+ * its in-flight queries complete.
  *
- * @public @memberof CassAuthenticator
+ * @public @memberof CassTableScan
  *
- * @param[in] auth
- * @param[in] response
- * @param[in] response_size
+ * @param[in] scan
  */
 CASS_EXPORT void
-cass_authenticator_set_response(CassAuthenticator* auth,
-                                const char* response,
-                                size_t response_size);
+cass_table_scan_free(CassTableScan* scan);
 
 /**
- * Sets an error for the authenticator exchange.
+ * Sets the columns selected by the scan. This is used as-is in the scan's
+ * "SELECT" queries.
  *
- * @public @memberof CassAuthenticator
+ * <b>Default:</b> "*" (all columns)
  *
- * @param[in] auth
- * @param[in] message
+ * @public @memberof CassTableScan
+ *
+ * @param[in] scan
+ * @param[in] columns
+ * @return CASS_OK if successful, otherwise an error occurred.
  */
-CASS_EXPORT void
-cass_authenticator_set_error(CassAuthenticator* auth,
-                             const char* message);
+CASS_EXPORT CassError
+cass_table_scan_set_columns(CassTableScan* scan,
+                            const char* columns);
 
 /**
- * Same as cass_authenticator_set_error(), but with lengths for string
+ * Same as cass_table_scan_set_columns(), but with lengths for string
  * parameters.
  *
- * @public @memberof CassAuthenticator
+ * @public @memberof CassTableScan
  *
- * @param[in] auth
- * @param[in] message
- * @param[in] message_length
+ * @param[in] scan
+ * @param[in] columns
+ * @param[in] columns_length
+ * @return same as cass_table_scan_set_columns()
  *
- * @see cass_authenticator_set_error()
+ * @see cass_table_scan_set_columns()
  */
-CASS_EXPORT void
-cass_authenticator_set_error_n(CassAuthenticator* auth,
-                               const char* message,
-                               size_t message_length);
+CASS_EXPORT CassError
+cass_table_scan_set_columns_n(CassTableScan* scan,
+                              const char* columns,
+                              size_t columns_length);
 
-/***********************************************************************************
+/**
+ * Sets the maximum number of token ranges that are scanned at the same time.
+ * This also bounds the number of pages that are buffered by the scan.
  *
- * Future
+ * <b>Default:</b> 4
  *
- ***********************************************************************************/
+ * @public @memberof CassTableScan
+ *
+ * @param[in] scan
+ * @param[in] concurrency
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_table_scan_set_concurrency(CassTableScan* scan,
+                                unsigned concurrency);
 
 /**
- * Frees a future instance. A future can be freed anytime.
+ * Sets the number of rows in each page of the scan.
  *
- * @public @memberof CassFuture
+ * <b>Default:</b> 5000
+ *
+ * @public @memberof CassTableScan
+ *
+ * @param[in] scan
+ * @param[in] paging_size
+ * @return CASS_OK if successful, otherwise an error occurred.
  */
-CASS_EXPORT void
-cass_future_free(CassFuture* future);
+CASS_EXPORT CassError
+cass_table_scan_set_paging_size(CassTableScan* scan,
+                                int paging_size);
 
 /**
- * Sets a callback that is called when a future is set
+ * Sets the consistency level of the scan's queries.
  *
- * @public @memberof CassFuture
+ * <b>Default:</b> The session's default consistency level.
  *
- * @param[in] future
+ * @public @memberof CassTableScan
+ *
+ * @param[in] scan
+ * @param[in] consistency
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_table_scan_set_consistency(CassTableScan* scan,
+                                CassConsistency consistency);
+
+/**
+ * Sets a callback that's called with each page of the scan instead of
+ * queuing the pages for cass_table_scan_next_page(). The callback is called
+ * on the driver's I/O threads, possibly concurrently, and a range's next page
+ * is requested after the callback returns.
+ *
+ * @public @memberof CassTableScan
+ *
+ * @param[in] scan
  * @param[in] callback
  * @param[in] data
- * @return CASS_OK if successful, otherwise an error occurred
+ * @return CASS_OK if successful, otherwise an error occurred.
  */
 CASS_EXPORT CassError
-cass_future_set_callback(CassFuture* future,
-                         CassFutureCallback callback,
-                         void* data);
+cass_table_scan_set_callback(CassTableScan* scan,
+                             CassTableScanCallback callback,
+                             void* data);
 
 /**
- * Gets the set status of the future.
+ * Starts scanning a table. Each token range's query is sent to one of the
+ * range's replicas in the local datacenter. The session must stay connected
+ * until the scan is finished.
  *
- * @public @memberof CassFuture
+ * <b>Note:</b> The scan's table and its partition key are looked up in the
+ * session's schema metadata.
  *
- * @param[in] future
- * @return true if set
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] scan
+ * @return CASS_OK if the scan was started, otherwise an error occurred. Use
+ * cass_table_scan_error_message() for the details.
  */
-CASS_EXPORT cass_bool_t
-cass_future_ready(CassFuture* future);
+CASS_EXPORT CassError
+cass_session_scan_table(CassSession* session,
+                        CassTableScan* scan);
 
 /**
- * Wait for the future to be set with either a result or error.
+ * Waits for the next page of a table scan. The pages of different token
+ * ranges are returned in the order they arrive. This can't be used with a
+ * callback.
  *
- * <b>Important:</b> Do not wait in a future callback. Waiting in a future
- * callback will cause a deadlock.
+ * @public @memberof CassTableScan
+ *
+ * @param[in] scan
+ * @return The next page, which must be freed using cass_result_free(), or
+ * NULL if the scan is finished or failed. Use cass_table_scan_error_code()
+ * to determine if the scan failed.
+ */
+CASS_EXPORT const CassResult*
+cass_table_scan_next_page(CassTableScan* scan);
+
+/**
+ * Gets the error code of a table scan.
+ *
+ * @public @memberof CassTableScan
+ *
+ * @param[in] scan
+ * @return CASS_OK if the scan hasn't failed, otherwise the first error.
+ */
+CASS_EXPORT CassError
+cass_table_scan_error_code(CassTableScan* scan);
+
+/**
+ * Gets the error message of a table scan.
+ *
+ * @public @memberof CassTableScan
+ *
+ * @param[in] scan
+ * @param[out] message Empty string returned if the scan hasn't failed.
+ * @param[out] message_length
+ */
+CASS_EXPORT void
+cass_table_scan_error_message(CassTableScan* scan,
+                              const char** message,
+                              size_t* message_length);
+
+/***********************************************************************************
+ *
+ * Bulk Writer
+ *
+ ***********************************************************************************/
+
+/**
+ * Creates a new bulk writer of the rows bound from a prepared statement,
+ * usually an "INSERT". The rows are grouped by partition, using their routing
+ * keys and the session's token map, into unlogged batches that each write a
+ * single partition.
+ *
+ * @public @memberof CassBulkWriter
+ *
+ * @param[in] prepared
+ * @return Returns a bulk writer that must be freed.
+ *
+ * @see cass_bulk_writer_free()
+ * @see cass_session_start_bulk_writer()
+ */
+CASS_EXPORT CassBulkWriter*
+cass_bulk_writer_new(const CassPrepared* prepared);
+
+/**
+ * Frees a bulk writer instance. Rows that haven't been flushed are discarded
+ * and in-flight batches complete in the background.
+ *
+ * @public @memberof CassBulkWriter
  *
- * @public @memberof CassFuture
+ * @param[in] writer
  *
- * @param[in] future
+ * @see cass_bulk_writer_flush()
  */
 CASS_EXPORT void
-cass_future_wait(CassFuture* future);
+cass_bulk_writer_free(CassBulkWriter* writer);
 
 /**
- * Wait for the future to be set or timeout.
+ * Sets the maximum number of rows in each batch. A partition's batch is sent
+ * as soon as it has this many rows.
  *
- * @public @memberof CassFuture
+ * <b>Default:</b> 32
  *
- * @param[in] future
- * @param[in] timeout_us wait time in microseconds
- * @return false if returned due to timeout
+ * @public @memberof CassBulkWriter
+ *
+ * @param[in] writer
+ * @param[in] batch_size
+ * @return CASS_OK if successful, otherwise an error occurred.
  */
-CASS_EXPORT cass_bool_t
-cass_future_wait_timed(CassFuture* future,
-                       cass_duration_t timeout_us);
+CASS_EXPORT CassError
+cass_bulk_writer_set_batch_size(CassBulkWriter* writer,
+                                unsigned batch_size);
 
 /**
- * Gets the result of a successful future. If the future is not ready this method will
- * wait for the future to be set.
+ * Sets the maximum number of in-flight batches for each replica. Adding a row
+ * blocks while the replica of its partition has this many batches in flight.
  *
- * @public @memberof CassFuture
+ * <b>Default:</b> 8
  *
- * @param[in] future
- * @return CassResult instance if successful, otherwise NULL for error. The return instance
- * must be freed using cass_result_free().
+ * @public @memberof CassBulkWriter
  *
- * @see cass_session_execute() and cass_session_execute_batch()
+ * @param[in] writer
+ * @param[in] max_requests
+ * @return CASS_OK if successful, otherwise an error occurred.
  */
-CASS_EXPORT const CassResult*
-cass_future_get_result(CassFuture* future);
+CASS_EXPORT CassError
+cass_bulk_writer_set_max_requests_per_host(CassBulkWriter* writer,
+                                           unsigned max_requests);
 
 /**
- * Gets the error result from a future that failed as a result of a server error. If the
- * future is not ready this method will wait for the future to be set.
+ * Sets the maximum number of rows waiting in partially filled batches. All of
+ * the partially filled batches are sent once there are this many rows.
  *
- * @public @memberof CassFuture
+ * <b>Default:</b> 16384
  *
- * @param[in] future
- * @return CassErrorResult instance if the request failed with a server error,
- * otherwise NULL if the request was successful or the failure was not caused by
- * a server error. The return instance must be freed using cass_error_result_free().
+ * @public @memberof CassBulkWriter
  *
- * @see cass_session_execute() and cass_session_execute_batch()
+ * @param[in] writer
+ * @param[in] max_rows
+ * @return CASS_OK if successful, otherwise an error occurred.
  */
-CASS_EXPORT const CassErrorResult*
-cass_future_get_error_result(CassFuture* future);
+CASS_EXPORT CassError
+cass_bulk_writer_set_max_pending_rows(CassBulkWriter* writer,
+                                      unsigned max_rows);
 
 /**
- * Gets the result of a successful future. If the future is not ready this method will
- * wait for the future to be set. The first successful call consumes the future, all
- * subsequent calls will return NULL.
+ * Sets the maximum number of times a batch is retried after a client-side
+ * timeout, a write timeout or an overloaded error. Retries use the batch's
+ * original client-side timestamp.
  *
- * @public @memberof CassFuture
+ * <b>Default:</b> 3
  *
- * @param[in] future
- * @return CassPrepared instance if successful, otherwise NULL for error. The return instance
- * must be freed using cass_prepared_free().
+ * @public @memberof CassBulkWriter
  *
- * @see cass_session_prepare()
+ * @param[in] writer
+ * @param[in] max_retries
+ * @return CASS_OK if successful, otherwise an error occurred.
  */
-CASS_EXPORT const CassPrepared*
-cass_future_get_prepared(CassFuture* future);
+CASS_EXPORT CassError
+cass_bulk_writer_set_max_retries(CassBulkWriter* writer,
+                                 unsigned max_retries);
 
 /**
- * Gets the error code from future. If the future is not ready this method will
- * wait for the future to be set.
+ * Sets the consistency level of the writer's batches.
  *
- * @public @memberof CassFuture
+ * <b>Default:</b> The session's default consistency level.
  *
- * @param[in] future
- * @return CASS_OK if successful, otherwise an error occurred.
+ * @public @memberof CassBulkWriter
  *
- * @see cass_error_desc()
+ * @param[in] writer
+ * @param[in] consistency
+ * @return CASS_OK if successful, otherwise an error occurred.
  */
 CASS_EXPORT CassError
-cass_future_error_code(CassFuture* future);
+cass_bulk_writer_set_consistency(CassBulkWriter* writer,
+                                 CassConsistency consistency);
 
 /**
- * Gets the error message from future. If the future is not ready this method will
- * wait for the future to be set.
+ * Starts a bulk writer. The writer's settings can't be changed once it's
+ * started and the session must stay connected until the writer is flushed.
  *
- * @public @memberof CassFuture
+ * @public @memberof CassSession
  *
- * @param[in] future
- * @param[out] message Empty string returned if successful, otherwise
- * a message describing the error is returned.
- * @param[out] message_length
+ * @param[in] session
+ * @param[in] writer
+ * @return CASS_OK if the writer was started, otherwise an error occurred.
  */
-CASS_EXPORT void
-cass_future_error_message(CassFuture* future,
-                          const char** message,
-                          size_t* message_length);
+CASS_EXPORT CassError
+cass_session_start_bulk_writer(CassSession* session,
+                               CassBulkWriter* writer);
 
 /**
- * Gets the tracing ID associated with the request.
+ * Adds a row to a bulk writer. The row's partition batch is sent once it's
+ * full, which blocks while the partition's replica has the maximum number of
+ * in-flight batches.
  *
- * @public @memberof CassFuture
+ * <b>Note:</b> This must not be called from a future's callback.
  *
- * @param[in] future
- * @param[out] tracing_id
- * @return CASS_OK if successful, otherwise an error occurred.
+ * @public @memberof CassBulkWriter
+ *
+ * @param[in] writer
+ * @param[in] statement A statement bound from the writer's prepared
+ * statement. The writer keeps a reference so the statement can be freed
+ * immediately, but it must not be modified.
+ * @return CASS_OK if the row was added, otherwise an error occurred.
  */
 CASS_EXPORT CassError
-cass_future_tracing_id(CassFuture* future,
-                       CassUuid* tracing_id);
+cass_bulk_writer_add_row(CassBulkWriter* writer,
+                         CassStatement* statement);
 
 /**
- * Gets a the number of custom payload items from a response future. If the future is not
- * ready this method will wait for the future to be set.
- *
- * @cassandra{2.2+}
+ * Sends the partially filled batches of a bulk writer and waits for all of its
+ * in-flight batches.
  *
- * @public @memberof CassFuture
+ * @public @memberof CassBulkWriter
  *
- * @param[in] future
- * @return the number of custom payload items.
+ * @param[in] writer
+ * @return CASS_OK if all of the rows have been written, otherwise the first
+ * error. Use cass_bulk_writer_error_message() for the details.
  */
-CASS_EXPORT size_t
-cass_future_custom_payload_item_count(CassFuture* future);
+CASS_EXPORT CassError
+cass_bulk_writer_flush(CassBulkWriter* writer);
 
 /**
- * Gets a custom payload item from a response future at the specified index. If the future is not
- * ready this method will wait for the future to be set.
+ * Gets a snapshot of a bulk writer's progress and throughput.
  *
- * @cassandra{2.2+}
+ * @public @memberof CassBulkWriter
  *
- * @public @memberof CassFuture
+ * @param[in] writer
+ * @param[out] metrics
+ */
+CASS_EXPORT void
+cass_bulk_writer_get_metrics(CassBulkWriter* writer,
+                             CassBulkWriterMetrics* metrics);
+
+/**
+ * Gets the error code of a bulk writer.
  *
- * @param[in] future
- * @param[in] index
- * @param[out] name
- * @param[out] name_length
- * @param[out] value
- * @param[out] value_size
- * @return CASS_OK if successful, otherwise an error occurred.
+ * @public @memberof CassBulkWriter
+ *
+ * @param[in] writer
+ * @return CASS_OK if no batch has failed, otherwise the first error.
  */
 CASS_EXPORT CassError
-cass_future_custom_payload_item(CassFuture* future,
-                                size_t index,
-                                const char** name,
-                                size_t* name_length,
-                                const cass_byte_t** value,
-                                size_t* value_size);
+cass_bulk_writer_error_code(CassBulkWriter* writer);
 
 /**
- * Gets the node that acted as coordinator for this query. If the future is not
- * ready this method will wait for the future to be set.
- *
- * @public @memberof CassFuture
+ * Gets the error message of a bulk writer.
  *
- * @param future
- * @return The coordinator node that handled the query. The lifetime of this
- * object is the same as the result object it came from. NULL can be returned
- * if the future is not a response future or if an error occurs before a
- * coordinator responds.
+ * @public @memberof CassBulkWriter
  *
- * @see cass_statement_set_node()
+ * @param[in] writer
+ * @param[out] message Empty string returned if no batch has failed.
+ * @param[out] message_length
  */
-CASS_EXPORT const CassNode*
-cass_future_coordinator(CassFuture* future);
+CASS_EXPORT void
+cass_bulk_writer_error_message(CassBulkWriter* writer,
+                               const char** message,
+                               size_t* message_length);
 
 /***********************************************************************************
  *
@@ -5310,6 +9218,58 @@ cass_statement_set_paging_state_token(CassStatement* statement,
                                       const char* paging_state,
                                       size_t paging_state_size);
 
+/**
+ * Sets whether the next page of a paged query is requested as soon as the
+ * current page is received instead of waiting for the application to request
+ * it. At most one page is prefetched ahead of the pages taken by the
+ * application.
+ *
+ * <b>Default:</b> cass_false
+ *
+ * @cassandra{2.0+}
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] enabled
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_set_paging_size()
+ * @see cass_session_get_next_page()
+ * @see cass_iterator_from_paged_future()
+ */
+CASS_EXPORT CassError
+cass_statement_set_paging_prefetch(CassStatement* statement,
+                                   cass_bool_t enabled);
+
+/**
+ * Sets a callback that's notified of each row of the statement's result as
+ * soon as the row is received. The rows of a large page are delivered while
+ * the rest of the page is still being received, which lowers the time to the
+ * first row. Each row of a page is delivered exactly once, in order, before
+ * the statement's future is set. The future's result still contains all the
+ * rows of the page.
+ *
+ * The rows of compressed frames and of DSE continuous paging pages are only
+ * delivered once the whole page is received. Statements with a row callback
+ * bypass the result cache and read coalescing.
+ *
+ * <b>Default:</b> NULL (disabled)
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] callback The callback or NULL to disable streaming the rows.
+ * @param[in] data User data passed to the callback.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_set_paging_size()
+ */
+CASS_EXPORT CassError
+cass_statement_set_row_callback(CassStatement* statement,
+                                CassRowCallback callback,
+                                void* data);
+
 /**
  * Sets the statement's timestamp.
  *
@@ -5343,6 +9303,28 @@ CASS_EXPORT CassError
 cass_statement_set_request_timeout(CassStatement* statement,
                                    cass_uint64_t timeout_ms);
 
+/**
+ * Sets an absolute deadline for the statement. The statement is failed with
+ * CASS_ERROR_LIB_REQUEST_TIMED_OUT, without being written, if the deadline
+ * has passed before it's sent to a node, retried or speculatively executed.
+ * The request timeout is also shortened so that it doesn't extend past the
+ * deadline.
+ *
+ * <b>Default:</b> 0 (no deadline)
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] deadline_ms The deadline in milliseconds since the Unix epoch.
+ * Use 0 for no deadline.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_set_request_timeout()
+ */
+CASS_EXPORT CassError
+cass_statement_set_deadline(CassStatement* statement,
+                            cass_uint64_t deadline_ms);
+
 /**
  * Sets whether the statement is idempotent. Idempotent statements are able to be
  * automatically retried after timeouts/errors and can be speculatively executed.
@@ -5360,6 +9342,74 @@ CASS_EXPORT CassError
 cass_statement_set_is_idempotent(CassStatement* statement,
                                  cass_bool_t is_idempotent);
 
+/**
+ * Sets the statement's priority. This overrides the execution profile's
+ * priority.
+ *
+ * <b>Default:</b> CASS_REQUEST_PRIORITY_UNSET (the execution profile's
+ * priority)
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] priority
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_execution_profile_set_priority()
+ */
+CASS_EXPORT CassError
+cass_statement_set_priority(CassStatement* statement,
+                            CassRequestPriority priority);
+
+/**
+ * Sets how long the result of a bound statement is served from the session's
+ * result cache. Only single page results of rows are cached and statements
+ * with a paging state aren't served from the cache. This should only be used
+ * for reads of data that rarely changes because writes aren't seen until
+ * the cached result expires.
+ *
+ * <b>Default:</b> 0 (The result isn't cached)
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] ttl_ms The time to cache the result in milliseconds.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ * CASS_ERROR_LIB_BAD_PARAMS is returned if the statement isn't a bound
+ * statement.
+ *
+ * @see cass_cluster_set_result_cache_size()
+ */
+CASS_EXPORT CassError
+cass_statement_set_result_cache_ttl(CassStatement* statement,
+                                    cass_uint64_t ttl_ms);
+
+/**
+ * Sets whether a bound statement is reusable. A reusable statement is
+ * executed as a copy of its current values and options, so it can be rebound
+ * and executed again without waiting for, or affecting, its previous
+ * executions. The statement keeps the copies and reuses them, with their
+ * allocations, once their executions complete. This avoids allocating a new
+ * statement for every execution of frequently executed queries.
+ *
+ * <b>Note:</b> Values bound with cass_statement_bind_bytes_ref()
+ * and cass_statement_bind_string_ref() are referenced, not copied, and must
+ * remain valid until the executions that use them complete.
+ *
+ * <b>Default:</b> cass_false
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] reusable
+ * @return CASS_OK if successful, otherwise an error occurred.
+ * CASS_ERROR_LIB_BAD_PARAMS is returned if the statement isn't a bound
+ * statement.
+ */
+CASS_EXPORT CassError
+cass_statement_set_reusable(CassStatement* statement,
+                            cass_bool_t reusable);
+
 /**
  * Sets the statement's retry policy.
  *
@@ -5423,6 +9473,24 @@ cass_statement_set_execution_profile_n(CassStatement* statement,
                                        const char* name,
                                        size_t name_length);
 
+/**
+ * Sets the execution profile to execute the statement with by its handle.
+ * This replaces the profile set by name, if any.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] handle A handle returned by
+ * cass_session_get_execution_profile_handle(). Use -1 to clear the execution
+ * profile from the statement.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_session_get_execution_profile_handle()
+ */
+CASS_EXPORT CassError
+cass_statement_set_execution_profile_handle(CassStatement* statement,
+                                            cass_int32_t handle);
+
 /**
  * Sets whether the statement should use tracing.
  *
@@ -5557,6 +9625,23 @@ cass_statement_bind_null_by_name_n(CassStatement* statement,
                                    const char* name,
                                    size_t name_length);
 
+/**
+ * Same as cass_statement_bind_null_by_name(), but using a column handle instead
+ * of a name.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] column_handle
+ * @return same as cass_statement_bind_null_by_name()
+ *
+ * @see cass_statement_bind_null_by_name()
+ * @see cass_prepared_parameter_handle()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_null_by_handle(CassStatement* statement,
+                                   const CassColumnHandle* column_handle);
+
 /**
  * Binds a "tinyint" to a query or bound statement at the specified index.
  *
@@ -5613,6 +9698,27 @@ cass_statement_bind_int8_by_name_n(CassStatement* statement,
                                    size_t name_length,
                                    cass_int8_t value);
 
+/**
+ * Same as cass_statement_bind_int8_by_name(), but using a column handle instead
+ * of a name.
+ *
+ * @cassandra{2.2+}
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] column_handle
+ * @param[in] value
+ * @return same as cass_statement_bind_int8_by_name()
+ *
+ * @see cass_statement_bind_int8_by_name()
+ * @see cass_prepared_parameter_handle()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_int8_by_handle(CassStatement* statement,
+                                   const CassColumnHandle* column_handle,
+                                   cass_int8_t value);
+
 /**
  * Binds an "smallint" to a query or bound statement at the specified index.
  *
@@ -5648,25 +9754,46 @@ cass_statement_bind_int16_by_name(CassStatement* statement,
                                   cass_int16_t value);
 
 /**
- * Same as cass_statement_bind_int16_by_name(), but with lengths for string
- * parameters.
+ * Same as cass_statement_bind_int16_by_name(), but with lengths for string
+ * parameters.
+ *
+ * @cassandra{2.2+}
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] name
+ * @param[in] name_length
+ * @param[in] value
+ * @return same as cass_statement_bind_int16_by_name()
+ *
+ * @see cass_statement_bind_int16_by_name()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_int16_by_name_n(CassStatement* statement,
+                                    const char* name,
+                                    size_t name_length,
+                                    cass_int16_t value);
+
+/**
+ * Same as cass_statement_bind_int16_by_name(), but using a column handle
+ * instead of a name.
  *
  * @cassandra{2.2+}
  *
  * @public @memberof CassStatement
  *
  * @param[in] statement
- * @param[in] name
- * @param[in] name_length
+ * @param[in] column_handle
  * @param[in] value
  * @return same as cass_statement_bind_int16_by_name()
  *
  * @see cass_statement_bind_int16_by_name()
+ * @see cass_prepared_parameter_handle()
  */
 CASS_EXPORT CassError
-cass_statement_bind_int16_by_name_n(CassStatement* statement,
-                                    const char* name,
-                                    size_t name_length,
+cass_statement_bind_int16_by_handle(CassStatement* statement,
+                                    const CassColumnHandle* column_handle,
                                     cass_int16_t value);
 
 /**
@@ -5722,6 +9849,25 @@ cass_statement_bind_int32_by_name_n(CassStatement* statement,
                                     size_t name_length,
                                     cass_int32_t value);
 
+/**
+ * Same as cass_statement_bind_int32_by_name(), but using a column handle
+ * instead of a name.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] column_handle
+ * @param[in] value
+ * @return same as cass_statement_bind_int32_by_name()
+ *
+ * @see cass_statement_bind_int32_by_name()
+ * @see cass_prepared_parameter_handle()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_int32_by_handle(CassStatement* statement,
+                                    const CassColumnHandle* column_handle,
+                                    cass_int32_t value);
+
 /**
  * Binds a "date" to a query or bound statement at the specified index.
  *
@@ -5778,6 +9924,27 @@ cass_statement_bind_uint32_by_name_n(CassStatement* statement,
                                      size_t name_length,
                                      cass_uint32_t value);
 
+/**
+ * Same as cass_statement_bind_uint32_by_name(), but using a column handle
+ * instead of a name.
+ *
+ * @cassandra{2.2+}
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] column_handle
+ * @param[in] value
+ * @return same as cass_statement_bind_uint32_by_name()
+ *
+ * @see cass_statement_bind_uint32_by_name()
+ * @see cass_prepared_parameter_handle()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_uint32_by_handle(CassStatement* statement,
+                                     const CassColumnHandle* column_handle,
+                                     cass_uint32_t value);
+
 /**
  * Binds a "bigint", "counter", "timestamp" or "time" to a query or
  * bound statement at the specified index.
@@ -5833,6 +10000,25 @@ cass_statement_bind_int64_by_name_n(CassStatement* statement,
                                     size_t name_length,
                                     cass_int64_t value);
 
+/**
+ * Same as cass_statement_bind_int64_by_name(), but using a column handle
+ * instead of a name.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] column_handle
+ * @param[in] value
+ * @return same as cass_statement_bind_int64_by_name()
+ *
+ * @see cass_statement_bind_int64_by_name()
+ * @see cass_prepared_parameter_handle()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_int64_by_handle(CassStatement* statement,
+                                    const CassColumnHandle* column_handle,
+                                    cass_int64_t value);
+
 /**
  * Binds a "float" to a query or bound statement at the specified index.
  *
@@ -5886,6 +10072,25 @@ cass_statement_bind_float_by_name_n(CassStatement* statement,
                                     size_t name_length,
                                     cass_float_t value);
 
+/**
+ * Same as cass_statement_bind_float_by_name(), but using a column handle
+ * instead of a name.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] column_handle
+ * @param[in] value
+ * @return same as cass_statement_bind_float_by_name()
+ *
+ * @see cass_statement_bind_float_by_name()
+ * @see cass_prepared_parameter_handle()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_float_by_handle(CassStatement* statement,
+                                    const CassColumnHandle* column_handle,
+                                    cass_float_t value);
+
 /**
  * Binds a "double" to a query or bound statement at the specified index.
  *
@@ -5939,6 +10144,25 @@ cass_statement_bind_double_by_name_n(CassStatement* statement,
                                      size_t name_length,
                                      cass_double_t value);
 
+/**
+ * Same as cass_statement_bind_double_by_name(), but using a column handle
+ * instead of a name.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] column_handle
+ * @param[in] value
+ * @return same as cass_statement_bind_double_by_name()
+ *
+ * @see cass_statement_bind_double_by_name()
+ * @see cass_prepared_parameter_handle()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_double_by_handle(CassStatement* statement,
+                                     const CassColumnHandle* column_handle,
+                                     cass_double_t value);
+
 /**
  * Binds a "boolean" to a query or bound statement at the specified index.
  *
@@ -5992,6 +10216,25 @@ cass_statement_bind_bool_by_name_n(CassStatement* statement,
                                    size_t name_length,
                                    cass_bool_t value);
 
+/**
+ * Same as cass_statement_bind_bool_by_name(), but using a column handle instead
+ * of a name.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] column_handle
+ * @param[in] value
+ * @return same as cass_statement_bind_bool_by_name()
+ *
+ * @see cass_statement_bind_bool_by_name()
+ * @see cass_prepared_parameter_handle()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_bool_by_handle(CassStatement* statement,
+                                   const CassColumnHandle* column_handle,
+                                   cass_bool_t value);
+
 /**
  * Binds an "ascii", "text" or "varchar" to a query or bound statement
  * at the specified index.
@@ -6050,69 +10293,313 @@ cass_statement_bind_string_by_name(CassStatement* statement,
                                    const char* value);
 
 /**
- * Same as cass_statement_bind_string_by_name(), but with lengths for string
- * parameters.
+ * Same as cass_statement_bind_string_by_name(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] name
+ * @param[in] name_length
+ * @param[in] value
+ * @param[in] value_length
+ * @return same as cass_statement_bind_string_by_name()
+ *
+ * @see cass_statement_bind_string_by_name()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_string_by_name_n(CassStatement* statement,
+                                     const char* name,
+                                     size_t name_length,
+                                     const char* value,
+                                     size_t value_length);
+
+/**
+ * Same as cass_statement_bind_string_by_name(), but using a column handle
+ * instead of a name.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] column_handle
+ * @param[in] value The value is copied into the statement object; the
+ * @return same as cass_statement_bind_string_by_name()
+ *
+ * @see cass_statement_bind_string_by_name()
+ * @see cass_prepared_parameter_handle()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_string_by_handle(CassStatement* statement,
+                                     const CassColumnHandle* column_handle,
+                                     const char* value);
+
+/**
+ * Same as cass_statement_bind_string_by_name_n(), but using a column handle
+ * instead of a name.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] column_handle
+ * @param[in] value
+ * @param[in] value_length
+ * @return same as cass_statement_bind_string_by_name_n()
+ *
+ * @see cass_statement_bind_string_by_name_n()
+ * @see cass_prepared_parameter_handle()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_string_by_handle_n(CassStatement* statement,
+                                       const CassColumnHandle* column_handle,
+                                       const char* value,
+                                       size_t value_length);
+
+/**
+ * Binds a "ascii", "text" or "varchar" to a query or bound statement at the specified index
+ * without copying the value. The value's memory must stay valid and
+ * unmodified until the release callback is called. The callback is called
+ * once the driver no longer references the value: after the statement is
+ * freed and the requests it was written to have been sent. If the bind fails
+ * the callback is called before this function returns.
+ *
+ * <b>Note:</b> Values are still copied when the connection uses SSL,
+ * compression or protocol v5 framing.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] index
+ * @param[in] value
+ * @param[in] value_length
+ * @param[in] release_callback Called once the value is no longer referenced.
+ * May be NULL.
+ * @param[in] data User data passed to the release callback.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_bind_string()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_string_ref(CassStatement* statement,
+                               size_t index,
+                               const char* value,
+                               size_t value_length,
+                               CassValueReleaseCallback release_callback,
+                               void* data);
+
+/**
+ * Same as cass_statement_bind_string_ref(), but binds the value by name.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] name
+ * @param[in] value
+ * @param[in] value_length
+ * @param[in] release_callback
+ * @param[in] data
+ * @return same as cass_statement_bind_string_ref()
+ *
+ * @see cass_statement_bind_string_ref()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_string_ref_by_name(CassStatement* statement,
+                                       const char* name,
+                                       const char* value,
+                                       size_t value_length,
+                                       CassValueReleaseCallback release_callback,
+                                       void* data);
+
+/**
+ * Same as cass_statement_bind_string_ref_by_name(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] name
+ * @param[in] name_length
+ * @param[in] value
+ * @param[in] value_length
+ * @param[in] release_callback
+ * @param[in] data
+ * @return same as cass_statement_bind_string_ref()
+ *
+ * @see cass_statement_bind_string_ref_by_name()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_string_ref_by_name_n(CassStatement* statement,
+                                         const char* name,
+                                         size_t name_length,
+                                         const char* value,
+                                         size_t value_length,
+                                         CassValueReleaseCallback release_callback,
+                                         void* data);
+
+/**
+ * Same as cass_statement_bind_string_ref_by_name(), but using a column handle
+ * instead of a name.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] column_handle
+ * @param[in] value
+ * @param[in] value_length
+ * @param[in] release_callback
+ * @param[in] data
+ * @return same as cass_statement_bind_string_ref()
+ *
+ * @see cass_statement_bind_string_ref_by_name()
+ * @see cass_prepared_parameter_handle()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_string_ref_by_handle(CassStatement* statement,
+                                         const CassColumnHandle* column_handle,
+                                         const char* value,
+                                         size_t value_length,
+                                         CassValueReleaseCallback release_callback,
+                                         void* data);
+
+/**
+ * Binds a "blob", "varint" or "custom" to a query or bound statement at the specified index.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] index
+ * @param[in] value The value is copied into the statement object; the
+ * memory pointed to by this parameter can be freed after this call.
+ * @param[in] value_size
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_statement_bind_bytes(CassStatement* statement,
+                          size_t index,
+                          const cass_byte_t* value,
+                          size_t value_size);
+
+/**
+ * Binds a "blob", "varint" or "custom" to all the values with the
+ * specified name.
+ *
+ * This can only be used with statements created by
+ * cass_prepared_bind() when using Cassandra 2.0 or earlier.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] name
+ * @param[in] value The value is copied into the statement object; the
+ * memory pointed to by this parameter can be freed after this call.
+ * @param[in] value_size
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_statement_bind_bytes_by_name(CassStatement* statement,
+                                  const char* name,
+                                  const cass_byte_t* value,
+                                  size_t value_size);
+
+/**
+ * Same as cass_statement_bind_bytes_by_name(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] name
+ * @param[in] name_length
+ * @param[in] value
+ * @param[in] value_size
+ * @return same as cass_statement_bind_bytes_by_name()
+ *
+ * @see cass_statement_bind_bytes_by_name()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_bytes_by_name_n(CassStatement* statement,
+                                    const char* name,
+                                    size_t name_length,
+                                    const cass_byte_t* value,
+                                    size_t value_size);
+
+/**
+ * Same as cass_statement_bind_bytes_by_name(), but using a column handle
+ * instead of a name.
  *
  * @public @memberof CassStatement
  *
  * @param[in] statement
- * @param[in] name
- * @param[in] name_length
+ * @param[in] column_handle
  * @param[in] value
- * @param[in] value_length
- * @return same as cass_statement_bind_string_by_name()
+ * @param[in] value_size
+ * @return same as cass_statement_bind_bytes_by_name()
  *
- * @see cass_statement_bind_string_by_name()
+ * @see cass_statement_bind_bytes_by_name()
+ * @see cass_prepared_parameter_handle()
  */
 CASS_EXPORT CassError
-cass_statement_bind_string_by_name_n(CassStatement* statement,
-                                     const char* name,
-                                     size_t name_length,
-                                     const char* value,
-                                     size_t value_length);
+cass_statement_bind_bytes_by_handle(CassStatement* statement,
+                                    const CassColumnHandle* column_handle,
+                                    const cass_byte_t* value,
+                                    size_t value_size);
 
 /**
- * Binds a "blob", "varint" or "custom" to a query or bound statement at the specified index.
+ * Binds a "blob", "varint" or "custom" to a query or bound statement at the specified index
+ * without copying the value. The value's memory must stay valid and
+ * unmodified until the release callback is called. The callback is called
+ * once the driver no longer references the value: after the statement is
+ * freed and the requests it was written to have been sent. If the bind fails
+ * the callback is called before this function returns.
+ *
+ * <b>Note:</b> Values are still copied when the connection uses SSL,
+ * compression or protocol v5 framing.
  *
  * @public @memberof CassStatement
  *
  * @param[in] statement
  * @param[in] index
- * @param[in] value The value is copied into the statement object; the
- * memory pointed to by this parameter can be freed after this call.
+ * @param[in] value
  * @param[in] value_size
+ * @param[in] release_callback Called once the value is no longer referenced.
+ * May be NULL.
+ * @param[in] data User data passed to the release callback.
  * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_bind_bytes()
  */
 CASS_EXPORT CassError
-cass_statement_bind_bytes(CassStatement* statement,
-                          size_t index,
-                          const cass_byte_t* value,
-                          size_t value_size);
+cass_statement_bind_bytes_ref(CassStatement* statement,
+                              size_t index,
+                              const cass_byte_t* value,
+                              size_t value_size,
+                              CassValueReleaseCallback release_callback,
+                              void* data);
 
 /**
- * Binds a "blob", "varint" or "custom" to all the values with the
- * specified name.
- *
- * This can only be used with statements created by
- * cass_prepared_bind() when using Cassandra 2.0 or earlier.
+ * Same as cass_statement_bind_bytes_ref(), but binds the value by name.
  *
  * @public @memberof CassStatement
  *
  * @param[in] statement
  * @param[in] name
- * @param[in] value The value is copied into the statement object; the
- * memory pointed to by this parameter can be freed after this call.
+ * @param[in] value
  * @param[in] value_size
- * @return CASS_OK if successful, otherwise an error occurred.
+ * @param[in] release_callback
+ * @param[in] data
+ * @return same as cass_statement_bind_bytes_ref()
+ *
+ * @see cass_statement_bind_bytes_ref()
  */
 CASS_EXPORT CassError
-cass_statement_bind_bytes_by_name(CassStatement* statement,
-                                  const char* name,
-                                  const cass_byte_t* value,
-                                  size_t value_size);
+cass_statement_bind_bytes_ref_by_name(CassStatement* statement,
+                                      const char* name,
+                                      const cass_byte_t* value,
+                                      size_t value_size,
+                                      CassValueReleaseCallback release_callback,
+                                      void* data);
 
 /**
- * Same as cass_statement_bind_bytes_by_name(), but with lengths for string
+ * Same as cass_statement_bind_bytes_ref_by_name(), but with lengths for string
  * parameters.
  *
  * @public @memberof CassStatement
@@ -6122,16 +10609,45 @@ cass_statement_bind_bytes_by_name(CassStatement* statement,
  * @param[in] name_length
  * @param[in] value
  * @param[in] value_size
- * @return same as cass_statement_bind_bytes_by_name()
+ * @param[in] release_callback
+ * @param[in] data
+ * @return same as cass_statement_bind_bytes_ref()
  *
- * @see cass_statement_bind_bytes_by_name()
+ * @see cass_statement_bind_bytes_ref_by_name()
  */
 CASS_EXPORT CassError
-cass_statement_bind_bytes_by_name_n(CassStatement* statement,
-                                    const char* name,
-                                    size_t name_length,
-                                    const cass_byte_t* value,
-                                    size_t value_size);
+cass_statement_bind_bytes_ref_by_name_n(CassStatement* statement,
+                                        const char* name,
+                                        size_t name_length,
+                                        const cass_byte_t* value,
+                                        size_t value_size,
+                                        CassValueReleaseCallback release_callback,
+                                        void* data);
+
+/**
+ * Same as cass_statement_bind_bytes_ref_by_name(), but using a column handle
+ * instead of a name.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] column_handle
+ * @param[in] value
+ * @param[in] value_size
+ * @param[in] release_callback
+ * @param[in] data
+ * @return same as cass_statement_bind_bytes_ref()
+ *
+ * @see cass_statement_bind_bytes_ref_by_name()
+ * @see cass_prepared_parameter_handle()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_bytes_ref_by_handle(CassStatement* statement,
+                                        const CassColumnHandle* column_handle,
+                                        const cass_byte_t* value,
+                                        size_t value_size,
+                                        CassValueReleaseCallback release_callback,
+                                        void* data);
 
 /**
  * Binds a "custom" to a query or bound statement at the specified index.
@@ -6224,6 +10740,54 @@ cass_statement_bind_custom_by_name_n(CassStatement* statement,
                                      const cass_byte_t* value,
                                      size_t value_size);
 
+/**
+ * Same as cass_statement_bind_custom_by_name(), but using a column handle
+ * instead of a name.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] column_handle
+ * @param[in] class_name
+ * @param[in] value The value is copied into the statement object; the
+ * @param[in] value_size
+ * @return same as cass_statement_bind_custom_by_name()
+ *
+ * @see cass_statement_bind_custom_by_name()
+ * @see cass_prepared_parameter_handle()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_custom_by_handle(CassStatement* statement,
+                                     const CassColumnHandle* column_handle,
+                                     const char* class_name,
+                                     const cass_byte_t* value,
+                                     size_t value_size);
+
+/**
+ * Same as cass_statement_bind_custom_by_name_n(), but using a column handle
+ * instead of a name.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] column_handle
+ * @param[in] class_name
+ * @param[in] class_name_length
+ * @param[in] value
+ * @param[in] value_size
+ * @return same as cass_statement_bind_custom_by_name_n()
+ *
+ * @see cass_statement_bind_custom_by_name_n()
+ * @see cass_prepared_parameter_handle()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_custom_by_handle_n(CassStatement* statement,
+                                       const CassColumnHandle* column_handle,
+                                       const char* class_name,
+                                       size_t class_name_length,
+                                       const cass_byte_t* value,
+                                       size_t value_size);
+
 /**
  * Binds a "uuid" or "timeuuid" to a query or bound statement at the specified index.
  *
@@ -6278,6 +10842,25 @@ cass_statement_bind_uuid_by_name_n(CassStatement* statement,
                                    size_t name_length,
                                    CassUuid value);
 
+/**
+ * Same as cass_statement_bind_uuid_by_name(), but using a column handle instead
+ * of a name.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] column_handle
+ * @param[in] value
+ * @return same as cass_statement_bind_uuid_by_name()
+ *
+ * @see cass_statement_bind_uuid_by_name()
+ * @see cass_prepared_parameter_handle()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_uuid_by_handle(CassStatement* statement,
+                                   const CassColumnHandle* column_handle,
+                                   CassUuid value);
+
 /**
  * Binds an "inet" to a query or bound statement at the specified index.
  *
@@ -6331,6 +10914,25 @@ cass_statement_bind_inet_by_name_n(CassStatement* statement,
                                    size_t name_length,
                                    CassInet value);
 
+/**
+ * Same as cass_statement_bind_inet_by_name(), but using a column handle instead
+ * of a name.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] column_handle
+ * @param[in] value
+ * @return same as cass_statement_bind_inet_by_name()
+ *
+ * @see cass_statement_bind_inet_by_name()
+ * @see cass_prepared_parameter_handle()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_inet_by_handle(CassStatement* statement,
+                                   const CassColumnHandle* column_handle,
+                                   CassInet value);
+
 /**
  * Bind a "decimal" to a query or bound statement at the specified index.
  *
@@ -6398,6 +11000,29 @@ cass_statement_bind_decimal_by_name_n(CassStatement* statement,
                                       size_t varint_size,
                                       cass_int32_t scale);
 
+/**
+ * Same as cass_statement_bind_decimal_by_name(), but using a column handle
+ * instead of a name.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] column_handle
+ * @param[in] varint
+ * @param[in] varint_size
+ * @param[in] scale
+ * @return same as cass_statement_bind_decimal_by_name()
+ *
+ * @see cass_statement_bind_decimal_by_name()
+ * @see cass_prepared_parameter_handle()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_decimal_by_handle(CassStatement* statement,
+                                      const CassColumnHandle* column_handle,
+                                      const cass_byte_t* varint,
+                                      size_t varint_size,
+                                      cass_int32_t scale);
+
 /**
  * Binds a "duration" to a query or bound statement at the specified index.
  *
@@ -6406,65 +11031,199 @@ cass_statement_bind_decimal_by_name_n(CassStatement* statement,
  * @public @memberof CassStatement
  *
  * @param[in] statement
- * @param[in] index
- * @param[in] months
- * @param[in] days
- * @param[in] nanos
- * @return CASS_OK if successful, otherwise an error occurred.
+ * @param[in] index
+ * @param[in] months
+ * @param[in] days
+ * @param[in] nanos
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_statement_bind_duration(CassStatement* statement,
+                             size_t index,
+                             cass_int32_t months,
+                             cass_int32_t days,
+                             cass_int64_t nanos);
+
+/**
+ * Binds a "duration" to all the values with the specified name.
+ *
+ * @cassandra{3.10+}
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] name
+ * @param[in] months
+ * @param[in] days
+ * @param[in] nanos
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_statement_bind_duration_by_name(CassStatement* statement,
+                                     const char* name,
+                                     cass_int32_t months,
+                                     cass_int32_t days,
+                                     cass_int64_t nanos);
+
+/**
+ * Same as cass_statement_bind_duration_by_name(), but with lengths for string
+ * parameters.
+ *
+ * @cassandra{3.10+}
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] name
+ * @param[in] name_length
+ * @param[in] months
+ * @param[in] days
+ * @param[in] nanos
+ * @return same as cass_statement_bind_duration_by_name()
+ *
+ * @see cass_statement_bind_duration_by_name()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_duration_by_name_n(CassStatement* statement,
+                                       const char* name,
+                                       size_t name_length,
+                                       cass_int32_t months,
+                                       cass_int32_t days,
+                                       cass_int64_t nanos);
+
+/**
+ * Same as cass_statement_bind_duration_by_name(), but using a column handle
+ * instead of a name.
+ *
+ * @cassandra{3.10+}
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] column_handle
+ * @param[in] months
+ * @param[in] days
+ * @param[in] nanos
+ * @return same as cass_statement_bind_duration_by_name()
+ *
+ * @see cass_statement_bind_duration_by_name()
+ * @see cass_prepared_parameter_handle()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_duration_by_handle(CassStatement* statement,
+                                       const CassColumnHandle* column_handle,
+                                       cass_int32_t months,
+                                       cass_int32_t days,
+                                       cass_int64_t nanos);
+
+/**
+ * Binds a user defined type or tuple encoded from a struct to a query or
+ * bound statement at the specified index.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] index
+ * @param[in] encoder The struct encoder for the parameter's type.
+ * @param[in] data The struct. It's encoded into the statement object; the
+ * memory pointed to by this parameter can be freed after this call.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_struct_encoder_new()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_struct(CassStatement* statement,
+                           size_t index,
+                           const CassStructEncoder* encoder,
+                           const void* data);
+
+/**
+ * Binds a user defined type or tuple encoded from a struct to all the values
+ * with the specified name.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] name
+ * @param[in] encoder
+ * @param[in] data
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_bind_struct()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_struct_by_name(CassStatement* statement,
+                                   const char* name,
+                                   const CassStructEncoder* encoder,
+                                   const void* data);
+
+/**
+ * Same as cass_statement_bind_struct_by_name(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] name
+ * @param[in] name_length
+ * @param[in] encoder
+ * @param[in] data
+ * @return same as cass_statement_bind_struct_by_name()
+ *
+ * @see cass_statement_bind_struct_by_name()
  */
 CASS_EXPORT CassError
-cass_statement_bind_duration(CassStatement* statement,
-                             size_t index,
-                             cass_int32_t months,
-                             cass_int32_t days,
-                             cass_int64_t nanos);
+cass_statement_bind_struct_by_name_n(CassStatement* statement,
+                                     const char* name,
+                                     size_t name_length,
+                                     const CassStructEncoder* encoder,
+                                     const void* data);
 
 /**
- * Binds a "duration" to all the values with the specified name.
- *
- * @cassandra{3.10+}
+ * Same as cass_statement_bind_struct_by_name(), but using a column handle
+ * instead of a name.
  *
  * @public @memberof CassStatement
  *
  * @param[in] statement
- * @param[in] name
- * @param[in] months
- * @param[in] days
- * @param[in] nanos
- * @return CASS_OK if successful, otherwise an error occurred.
+ * @param[in] column_handle
+ * @param[in] encoder
+ * @param[in] data
+ * @return same as cass_statement_bind_struct_by_name()
+ *
+ * @see cass_statement_bind_struct_by_name()
+ * @see cass_prepared_parameter_handle()
  */
 CASS_EXPORT CassError
-cass_statement_bind_duration_by_name(CassStatement* statement,
-                                     const char* name,
-                                     cass_int32_t months,
-                                     cass_int32_t days,
-                                     cass_int64_t nanos);
+cass_statement_bind_struct_by_handle(CassStatement* statement,
+                                     const CassColumnHandle* column_handle,
+                                     const CassStructEncoder* encoder,
+                                     const void* data);
 
 /**
- * Same as cass_statement_bind_duration_by_name(), but with lengths for string
- * parameters.
+ * Binds values that are already encoded in the native protocol's format to
+ * a query or bound statement, starting at the first parameter. Each value is
+ * a 4-byte, big-endian length followed by the value's bytes; a length of -1
+ * binds null and -2 leaves the parameter unset.
  *
- * @cassandra{3.10+}
+ * The values' types aren't checked against the statement's parameters. This
+ * is used by the typed binders in cassandra_binding.hpp which check the types
+ * once per prepared statement instead of once per value.
  *
  * @public @memberof CassStatement
  *
  * @param[in] statement
- * @param[in] name
- * @param[in] name_length
- * @param[in] months
- * @param[in] days
- * @param[in] nanos
- * @return same as cass_statement_bind_duration_by_name()
- *
- * @see cass_statement_bind_duration_by_name()
+ * @param[in] values The encoded values. They're copied into the statement
+ * object; the memory can be freed after this call.
+ * @param[in] values_size The size of the encoded values in bytes.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ * CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS if there are more values than parameters
+ * and CASS_ERROR_LIB_BAD_PARAMS if the values are truncated.
  */
 CASS_EXPORT CassError
-cass_statement_bind_duration_by_name_n(CassStatement* statement,
-                                       const char* name,
-                                       size_t name_length,
-                                       cass_int32_t months,
-                                       cass_int32_t days,
-                                       cass_int64_t nanos);
+cass_statement_bind_encoded_values(CassStatement* statement,
+                                   const cass_byte_t* values,
+                                   size_t values_size);
 
 /**
  * Bind a "list", "map" or "set" to a query or bound statement at the
@@ -6521,6 +11280,25 @@ cass_statement_bind_collection_by_name_n(CassStatement* statement,
                                          size_t name_length,
                                          const CassCollection* collection);
 
+/**
+ * Same as cass_statement_bind_collection_by_name(), but using a column handle
+ * instead of a name.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] column_handle
+ * @param[in] collection
+ * @return same as cass_statement_bind_collection_by_name()
+ *
+ * @see cass_statement_bind_collection_by_name()
+ * @see cass_prepared_parameter_handle()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_collection_by_handle(CassStatement* statement,
+                                         const CassColumnHandle* column_handle,
+                                         const CassCollection* collection);
+
 /**
  * Bind a "tuple" to a query or bound statement at the specified index.
  *
@@ -6577,6 +11355,27 @@ cass_statement_bind_tuple_by_name_n(CassStatement* statement,
                                     size_t name_length,
                                     const CassTuple* tuple);
 
+/**
+ * Same as cass_statement_bind_tuple_by_name(), but using a column handle
+ * instead of a name.
+ *
+ * @cassandra{2.1+}
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] column_handle
+ * @param[in] tuple
+ * @return same as cass_statement_bind_tuple_by_name()
+ *
+ * @see cass_statement_bind_tuple_by_name()
+ * @see cass_prepared_parameter_handle()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_tuple_by_handle(CassStatement* statement,
+                                    const CassColumnHandle* column_handle,
+                                    const CassTuple* tuple);
+
 /**
  * Bind a user defined type to a query or bound statement at the
  * specified index.
@@ -6634,6 +11433,27 @@ cass_statement_bind_user_type_by_name_n(CassStatement* statement,
                                         size_t name_length,
                                         const CassUserType* user_type);
 
+/**
+ * Same as cass_statement_bind_user_type_by_name(), but using a column handle
+ * instead of a name.
+ *
+ * @cassandra{2.1+}
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] column_handle
+ * @param[in] user_type
+ * @return same as cass_statement_bind_user_type_by_name()
+ *
+ * @see cass_statement_bind_user_type_by_name()
+ * @see cass_prepared_parameter_handle()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_user_type_by_handle(CassStatement* statement,
+                                        const CassColumnHandle* column_handle,
+                                        const CassUserType* user_type);
+
 /***********************************************************************************
  *
  * Prepared
@@ -6663,6 +11483,57 @@ cass_prepared_free(const CassPrepared* prepared);
 CASS_EXPORT CassStatement*
 cass_prepared_bind(const CassPrepared* prepared);
 
+/***********************************************************************************
+ *
+ * Statement Template
+ *
+ ***********************************************************************************/
+
+/**
+ * Creates a statement template from a bound statement. The template captures
+ * the statement's consistency, serial consistency, page size, timestamp,
+ * request timeout, retry policy, idempotence, tracing, execution profile,
+ * custom payload and currently bound values. Later changes to the statement
+ * don't affect the template.
+ *
+ * @public @memberof CassStatementTemplate
+ *
+ * @param[in] statement A bound statement created by cass_prepared_bind().
+ * @return Returns a statement template that must be freed or NULL if the
+ * statement isn't a bound statement.
+ *
+ * @see cass_statement_template_free()
+ */
+CASS_EXPORT CassStatementTemplate*
+cass_statement_template_new(const CassStatement* statement);
+
+/**
+ * Frees a statement template instance.
+ *
+ * @public @memberof CassStatementTemplate
+ *
+ * @param[in] statement_template
+ */
+CASS_EXPORT void
+cass_statement_template_free(const CassStatementTemplate* statement_template);
+
+/**
+ * Creates a bound statement from a statement template. The statement starts
+ * with the template's settings and values and any of them can be changed
+ * before it's executed. The template's pre-encoded request parameters are
+ * used, including for retries and speculative executions, unless the
+ * statement's page size is changed or a paging state is set.
+ *
+ * @public @memberof CassStatementTemplate
+ *
+ * @param[in] statement_template
+ * @return Returns a bound statement that must be freed.
+ *
+ * @see cass_statement_free()
+ */
+CASS_EXPORT CassStatement*
+cass_statement_template_bind(const CassStatementTemplate* statement_template);
+
 /**
  * Gets the name of a parameter at the specified index.
  *
@@ -6727,6 +11598,54 @@ cass_prepared_parameter_data_type_by_name_n(const CassPrepared* prepared,
                                             const char* name,
                                             size_t name_length);
 
+/**
+ * Resolves a parameter name to a column handle that's used to bind values to
+ * the statements bound from the prepared without looking up the name for
+ * every value, e.g. using cass_statement_bind_int32_by_handle(). The handle
+ * can be used with statements bound from other prepared statements, but the
+ * name is then looked up again.
+ *
+ * @public @memberof CassPrepared
+ *
+ * @param[in] prepared
+ * @param[in] name
+ * @return Returns a column handle that must be freed or NULL if the prepared
+ * has no parameter with the specified name.
+ *
+ * @see cass_column_handle_free()
+ */
+CASS_EXPORT CassColumnHandle*
+cass_prepared_parameter_handle(const CassPrepared* prepared,
+                               const char* name);
+
+/**
+ * Same as cass_prepared_parameter_handle(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassPrepared
+ *
+ * @param[in] prepared
+ * @param[in] name
+ * @param[in] name_length
+ * @return same as cass_prepared_parameter_handle()
+ *
+ * @see cass_prepared_parameter_handle()
+ */
+CASS_EXPORT CassColumnHandle*
+cass_prepared_parameter_handle_n(const CassPrepared* prepared,
+                                 const char* name,
+                                 size_t name_length);
+
+/**
+ * Frees a column handle instance.
+ *
+ * @public @memberof CassColumnHandle
+ *
+ * @param[in] column_handle
+ */
+CASS_EXPORT void
+cass_column_handle_free(const CassColumnHandle* column_handle);
+
 /***********************************************************************************
  *
  * Batch
@@ -6861,6 +11780,28 @@ CASS_EXPORT CassError
 cass_batch_set_request_timeout(CassBatch* batch,
                                cass_uint64_t timeout_ms);
 
+/**
+ * Sets an absolute deadline for the batch. The batch is failed with
+ * CASS_ERROR_LIB_REQUEST_TIMED_OUT, without being written, if the deadline
+ * has passed before it's sent to a node, retried or speculatively executed.
+ * The request timeout is also shortened so that it doesn't extend past the
+ * deadline.
+ *
+ * <b>Default:</b> 0 (no deadline)
+ *
+ * @public @memberof CassBatch
+ *
+ * @param[in] batch
+ * @param[in] deadline_ms The deadline in milliseconds since the Unix epoch.
+ * Use 0 for no deadline.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_batch_set_request_timeout()
+ */
+CASS_EXPORT CassError
+cass_batch_set_deadline(CassBatch* batch,
+                        cass_uint64_t deadline_ms);
+
 /**
  * Sets whether the statements in a batch are idempotent. Idempotent batches
  * are able to be automatically retried after timeouts/errors and can be
@@ -6879,6 +11820,24 @@ CASS_EXPORT CassError
 cass_batch_set_is_idempotent(CassBatch* batch,
                              cass_bool_t is_idempotent);
 
+/**
+ * Sets the batch's priority. This overrides the execution profile's priority.
+ *
+ * <b>Default:</b> CASS_REQUEST_PRIORITY_UNSET (the execution profile's
+ * priority)
+ *
+ * @public @memberof CassBatch
+ *
+ * @param[in] batch
+ * @param[in] priority
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_execution_profile_set_priority()
+ */
+CASS_EXPORT CassError
+cass_batch_set_priority(CassBatch* batch,
+                        CassRequestPriority priority);
+
 /**
  * Sets the batch's retry policy.
  *
@@ -6974,6 +11933,24 @@ cass_batch_set_execution_profile_n(CassBatch* batch,
                                    const char* name,
                                    size_t name_length);
 
+/**
+ * Sets the execution profile to execute the batch with by its handle. This
+ * replaces the profile set by name, if any.
+ *
+ * @public @memberof CassBatch
+ *
+ * @param[in] batch
+ * @param[in] handle A handle returned by
+ * cass_session_get_execution_profile_handle(). Use -1 to clear the execution
+ * profile from the batch.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_session_get_execution_profile_handle()
+ */
+CASS_EXPORT CassError
+cass_batch_set_execution_profile_handle(CassBatch* batch,
+                                        cass_int32_t handle);
+
 /***********************************************************************************
  *
  * Data type
@@ -7560,6 +12537,79 @@ CASS_EXPORT CassError
 cass_collection_append_double(CassCollection* collection,
                               cass_double_t value);
 
+/**
+ * Appends an array of "int" values to the collection. The values are encoded
+ * directly into the collection without a separate allocation per value.
+ *
+ * @public @memberof CassCollection
+ *
+ * @param[in] collection
+ * @param[in] values
+ * @param[in] values_count
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_collection_append_int32()
+ */
+CASS_EXPORT CassError
+cass_collection_append_int32_array(CassCollection* collection,
+                                   const cass_int32_t* values,
+                                   size_t values_count);
+
+/**
+ * Appends an array of "bigint", "counter", "timestamp" or "time" values to
+ * the collection. The values are encoded directly into the collection without
+ * a separate allocation per value.
+ *
+ * @public @memberof CassCollection
+ *
+ * @param[in] collection
+ * @param[in] values
+ * @param[in] values_count
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_collection_append_int64()
+ */
+CASS_EXPORT CassError
+cass_collection_append_int64_array(CassCollection* collection,
+                                   const cass_int64_t* values,
+                                   size_t values_count);
+
+/**
+ * Appends an array of "float" values to the collection. The values are encoded
+ * directly into the collection without a separate allocation per value.
+ *
+ * @public @memberof CassCollection
+ *
+ * @param[in] collection
+ * @param[in] values
+ * @param[in] values_count
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_collection_append_float()
+ */
+CASS_EXPORT CassError
+cass_collection_append_float_array(CassCollection* collection,
+                                   const cass_float_t* values,
+                                   size_t values_count);
+
+/**
+ * Appends an array of "double" values to the collection. The values are encoded
+ * directly into the collection without a separate allocation per value.
+ *
+ * @public @memberof CassCollection
+ *
+ * @param[in] collection
+ * @param[in] values
+ * @param[in] values_count
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_collection_append_double()
+ */
+CASS_EXPORT CassError
+cass_collection_append_double_array(CassCollection* collection,
+                                    const cass_double_t* values,
+                                    size_t values_count);
+
 /**
  * Appends a "boolean" to the collection.
  *
@@ -7725,6 +12775,47 @@ cass_collection_append_duration(CassCollection* collection,
                                 cass_int32_t days,
                                 cass_int64_t nanos);
 
+/**
+ * Appends a user defined type or tuple encoded from a struct to the
+ * collection.
+ *
+ * @public @memberof CassCollection
+ *
+ * @param[in] collection
+ * @param[in] encoder The struct encoder for the collection's item type.
+ * @param[in] data The struct.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_struct_encoder_new()
+ */
+CASS_EXPORT CassError
+cass_collection_append_struct(CassCollection* collection,
+                              const CassStructEncoder* encoder,
+                              const void* data);
+
+/**
+ * Appends an array of user defined types or tuples encoded from structs to
+ * the collection. Each struct is encoded directly into the collection.
+ *
+ * @public @memberof CassCollection
+ *
+ * @param[in] collection
+ * @param[in] encoder The struct encoder for the collection's item type.
+ * @param[in] data The first struct.
+ * @param[in] struct_size The distance between the structs in bytes, usually
+ * the struct's sizeof().
+ * @param[in] count The number of structs.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_collection_append_struct()
+ */
+CASS_EXPORT CassError
+cass_collection_append_struct_array(CassCollection* collection,
+                                    const CassStructEncoder* encoder,
+                                    const void* data,
+                                    size_t struct_size,
+                                    size_t count);
+
 /**
  * Appends a "list", "map" or "set" to the collection.
  *
@@ -8162,6 +13253,26 @@ cass_tuple_set_duration(CassTuple* tuple,
                         cass_int32_t days,
                         cass_int64_t nanos);
 
+/**
+ * Sets a user defined type or tuple encoded from a struct in a tuple at the
+ * specified index.
+ *
+ * @public @memberof CassTuple
+ *
+ * @param[in] tuple
+ * @param[in] index
+ * @param[in] encoder
+ * @param[in] data
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_struct_encoder_new()
+ */
+CASS_EXPORT CassError
+cass_tuple_set_struct(CassTuple* tuple,
+                      size_t index,
+                      const CassStructEncoder* encoder,
+                      const void* data);
+
 /**
  * Sets a "list", "map" or "set" in a tuple at the specified index.
  *
@@ -9242,6 +14353,68 @@ cass_user_type_set_duration_by_name_n(CassUserType* user_type,
                                       cass_int32_t days,
                                       cass_int64_t nanos);
 
+/**
+ * Sets a user defined type or tuple encoded from a struct in a user defined
+ * type at the specified index.
+ *
+ * @public @memberof CassUserType
+ *
+ * @param[in] user_type
+ * @param[in] index
+ * @param[in] encoder
+ * @param[in] data
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_struct_encoder_new()
+ */
+CASS_EXPORT CassError
+cass_user_type_set_struct(CassUserType* user_type,
+                          size_t index,
+                          const CassStructEncoder* encoder,
+                          const void* data);
+
+/**
+ * Sets a user defined type or tuple encoded from a struct in a user defined
+ * type at the specified name.
+ *
+ * @public @memberof CassUserType
+ *
+ * @param[in] user_type
+ * @param[in] name
+ * @param[in] encoder
+ * @param[in] data
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_user_type_set_struct()
+ */
+CASS_EXPORT CassError
+cass_user_type_set_struct_by_name(CassUserType* user_type,
+                                  const char* name,
+                                  const CassStructEncoder* encoder,
+                                  const void* data);
+
+/**
+ * Same as cass_user_type_set_struct_by_name(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassUserType
+ *
+ * @param[in] user_type
+ * @param[in] name
+ * @param[in] name_length
+ * @param[in] encoder
+ * @param[in] data
+ * @return same as cass_user_type_set_struct_by_name()
+ *
+ * @see cass_user_type_set_struct_by_name()
+ */
+CASS_EXPORT CassError
+cass_user_type_set_struct_by_name_n(CassUserType* user_type,
+                                    const char* name,
+                                    size_t name_length,
+                                    const CassStructEncoder* encoder,
+                                    const void* data);
+
 /**
  * Sets a "list", "map" or "set" in a user defined type at the
  * specified index.
@@ -9412,6 +14585,101 @@ cass_user_type_set_user_type_by_name_n(CassUserType* user_type,
                                        size_t name_length,
                                        const CassUserType* value);
 
+/***********************************************************************************
+ *
+ * Struct encoder
+ *
+ ***********************************************************************************/
+
+/**
+ * Creates a new struct encoder for a user defined type or tuple. The type's
+ * fields are mapped to the members of a struct using
+ * cass_struct_encoder_set_field() and the fields that aren't mapped are
+ * encoded as null.
+ *
+ * The struct's members use the same C types as the bind functions:
+ * "tinyint" is a cass_int8_t, "smallint" a cass_int16_t, "int" a
+ * cass_int32_t, "date" a cass_uint32_t, "bigint", "counter", "timestamp" and
+ * "time" a cass_int64_t, "float" a cass_float_t, "double" a cass_double_t,
+ * "boolean" a cass_bool_t, "uuid" and "timeuuid" a CassUuid and "inet" a
+ * CassInet. "ascii", "text" and "varchar" are a const char* to a
+ * null-terminated string or NULL for a null value.
+ *
+ * @public @memberof CassStructEncoder
+ *
+ * @param[in] data_type A user defined type or a tuple.
+ * @return Returns a struct encoder that must be freed. NULL is returned if
+ * the data type is not a user defined type or a tuple.
+ *
+ * @see cass_struct_encoder_free()
+ */
+CASS_EXPORT CassStructEncoder*
+cass_struct_encoder_new(const CassDataType* data_type);
+
+/**
+ * Frees a struct encoder instance.
+ *
+ * @public @memberof CassStructEncoder
+ *
+ * @param[in] encoder
+ */
+CASS_EXPORT void
+cass_struct_encoder_free(CassStructEncoder* encoder);
+
+/**
+ * Maps a field of the encoder's type to a member of the struct.
+ *
+ * @public @memberof CassStructEncoder
+ *
+ * @param[in] encoder
+ * @param[in] index The field's index in the type.
+ * @param[in] offset The member's offset in the struct, usually offsetof().
+ * @return CASS_OK if successful, otherwise an error occurred.
+ * CASS_ERROR_LIB_INVALID_VALUE_TYPE is returned if the field's type can't be
+ * encoded from a struct.
+ */
+CASS_EXPORT CassError
+cass_struct_encoder_set_field(CassStructEncoder* encoder,
+                              size_t index,
+                              size_t offset);
+
+/**
+ * Maps the fields with the specified name to a member of the struct.
+ *
+ * @public @memberof CassStructEncoder
+ *
+ * @param[in] encoder
+ * @param[in] name
+ * @param[in] offset
+ * @return same as cass_struct_encoder_set_field()
+ *
+ * @see cass_struct_encoder_set_field()
+ */
+CASS_EXPORT CassError
+cass_struct_encoder_set_field_by_name(CassStructEncoder* encoder,
+                                      const char* name,
+                                      size_t offset);
+
+/**
+ * Same as cass_struct_encoder_set_field_by_name(), but with lengths for
+ * string parameters.
+ *
+ * @public @memberof CassStructEncoder
+ *
+ * @param[in] encoder
+ * @param[in] name
+ * @param[in] name_length
+ * @param[in] offset
+ * @return same as cass_struct_encoder_set_field()
+ *
+ * @see cass_struct_encoder_set_field_by_name()
+ */
+CASS_EXPORT CassError
+cass_struct_encoder_set_field_by_name_n(CassStructEncoder* encoder,
+                                        const char* name,
+                                        size_t name_length,
+                                        size_t offset);
+
 /***********************************************************************************
  *
  * Result
@@ -9470,6 +14738,44 @@ cass_result_column_name(const CassResult *result,
                         const char** name,
                         size_t* name_length);
 
+/**
+ * Resolves a column name to a column handle that's used to get the column
+ * from rows without looking up the name for every row, using
+ * cass_row_get_column_by_handle(). The handle can be used with the rows of
+ * other results that have the same columns, e.g. the following pages of the
+ * query. If a column has moved, its name is looked up again.
+ *
+ * @public @memberof CassResult
+ *
+ * @param[in] result
+ * @param[in] name
+ * @return Returns a column handle that must be freed or NULL if the result
+ * has no column with the specified name.
+ *
+ * @see cass_column_handle_free()
+ */
+CASS_EXPORT CassColumnHandle*
+cass_result_column_handle(const CassResult* result,
+                          const char* name);
+
+/**
+ * Same as cass_result_column_handle(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassResult
+ *
+ * @param[in] result
+ * @param[in] name
+ * @param[in] name_length
+ * @return same as cass_result_column_handle()
+ *
+ * @see cass_result_column_handle()
+ */
+CASS_EXPORT CassColumnHandle*
+cass_result_column_handle_n(const CassResult* result,
+                            const char* name,
+                            size_t name_length);
+
 /**
  * Gets the column type at index for the specified result.
  *
@@ -9490,12 +14796,378 @@ cass_result_column_type(const CassResult* result,
  * @public @memberof CassResult
  *
  * @param[in] result
- * @param[in] index
- * @return The column type at the specified index. NULL is returned if the
- * index is out of bounds.
+ * @param[in] index
+ * @return The column type at the specified index. NULL is returned if the
+ * index is out of bounds.
+ */
+CASS_EXPORT const CassDataType*
+cass_result_column_data_type(const CassResult* result, size_t index);
+
+/**
+ * Copies all the values of an int column into a contiguous buffer without
+ * decoding the other columns of the result. Null values are copied
+ * as 0.
+ *
+ * The first call for a result scans its rows once to index the position of
+ * every value. Subsequent calls for any column of the same result reuse the
+ * index.
+ *
+ * @public @memberof CassResult
+ *
+ * @param[in] result
+ * @param[in] index The column index.
+ * @param[out] output A buffer with room for cass_result_row_count() values.
+ * @param[out] is_null An optional buffer with room for cass_result_row_count()
+ * values that's set to cass_true for null values. This can be NULL.
+ * @param[in] output_size The number of values the buffers can hold.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_result_row_count()
+ */
+CASS_EXPORT CassError
+cass_result_column_get_int32(const CassResult* result,
+                             size_t index,
+                             cass_int32_t* output,
+                             cass_bool_t* is_null,
+                             size_t output_size);
+
+/**
+ * Copies all the values of a bigint, counter, timestamp or time column into a
+ * contiguous buffer without decoding the other columns of the result. Null
+ * values are copied as 0.
+ *
+ * The first call for a result scans its rows once to index the position of
+ * every value. Subsequent calls for any column of the same result reuse the
+ * index.
+ *
+ * @public @memberof CassResult
+ *
+ * @param[in] result
+ * @param[in] index The column index.
+ * @param[out] output A buffer with room for cass_result_row_count() values.
+ * @param[out] is_null An optional buffer with room for cass_result_row_count()
+ * values that's set to cass_true for null values. This can be NULL.
+ * @param[in] output_size The number of values the buffers can hold.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_result_row_count()
+ */
+CASS_EXPORT CassError
+cass_result_column_get_int64(const CassResult* result,
+                             size_t index,
+                             cass_int64_t* output,
+                             cass_bool_t* is_null,
+                             size_t output_size);
+
+/**
+ * Copies all the values of a float column into a contiguous buffer without
+ * decoding the other columns of the result. Null values are copied
+ * as 0.
+ *
+ * The first call for a result scans its rows once to index the position of
+ * every value. Subsequent calls for any column of the same result reuse the
+ * index.
+ *
+ * @public @memberof CassResult
+ *
+ * @param[in] result
+ * @param[in] index The column index.
+ * @param[out] output A buffer with room for cass_result_row_count() values.
+ * @param[out] is_null An optional buffer with room for cass_result_row_count()
+ * values that's set to cass_true for null values. This can be NULL.
+ * @param[in] output_size The number of values the buffers can hold.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_result_row_count()
+ */
+CASS_EXPORT CassError
+cass_result_column_get_float(const CassResult* result,
+                             size_t index,
+                             cass_float_t* output,
+                             cass_bool_t* is_null,
+                             size_t output_size);
+
+/**
+ * Copies all the values of a double column into a contiguous buffer without
+ * decoding the other columns of the result. Null values are copied
+ * as 0.
+ *
+ * The first call for a result scans its rows once to index the position of
+ * every value. Subsequent calls for any column of the same result reuse the
+ * index.
+ *
+ * @public @memberof CassResult
+ *
+ * @param[in] result
+ * @param[in] index The column index.
+ * @param[out] output A buffer with room for cass_result_row_count() values.
+ * @param[out] is_null An optional buffer with room for cass_result_row_count()
+ * values that's set to cass_true for null values. This can be NULL.
+ * @param[in] output_size The number of values the buffers can hold.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_result_row_count()
+ */
+CASS_EXPORT CassError
+cass_result_column_get_double(const CassResult* result,
+                              size_t index,
+                              cass_double_t* output,
+                              cass_bool_t* is_null,
+                              size_t output_size);
+
+/**
+ * Copies all the values of a boolean column into a contiguous buffer without
+ * decoding the other columns of the result. Null values are copied
+ * as cass_false.
+ *
+ * The first call for a result scans its rows once to index the position of
+ * every value. Subsequent calls for any column of the same result reuse the
+ * index.
+ *
+ * @public @memberof CassResult
+ *
+ * @param[in] result
+ * @param[in] index The column index.
+ * @param[out] output A buffer with room for cass_result_row_count() values.
+ * @param[out] is_null An optional buffer with room for cass_result_row_count()
+ * values that's set to cass_true for null values. This can be NULL.
+ * @param[in] output_size The number of values the buffers can hold.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_result_row_count()
+ */
+CASS_EXPORT CassError
+cass_result_column_get_bool(const CassResult* result,
+                            size_t index,
+                            cass_bool_t* output,
+                            cass_bool_t* is_null,
+                            size_t output_size);
+
+/**
+ * Gets all the values of a column as strings without decoding the other
+ * columns of the result. The strings reference the result's data and are
+ * valid until the result is freed. Null values have a NULL pointer.
+ *
+ * The first call for a result scans its rows once to index the position of
+ * every value. Subsequent calls for any column of the same result reuse the
+ * index.
+ *
+ * @public @memberof CassResult
+ *
+ * @param[in] result
+ * @param[in] index The column index.
+ * @param[out] output A buffer with room for cass_result_row_count() strings.
+ * @param[out] output_length A buffer with room for cass_result_row_count()
+ * string lengths.
+ * @param[in] output_size The number of values the buffers can hold.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_result_row_count()
+ */
+CASS_EXPORT CassError
+cass_result_column_get_string(const CassResult* result,
+                              size_t index,
+                              const char** output,
+                              size_t* output_length,
+                              size_t output_size);
+
+/**
+ * Validates all the values of an "ascii", "text" or "varchar" column in the
+ * result. "text" and "varchar" values must be valid UTF-8 and "ascii" values
+ * must only contain ASCII characters. Runs of ASCII characters are checked
+ * many bytes at a time using SIMD instructions when they're available.
+ *
+ * The column is only validated by the first call for a result, later calls
+ * return the cached result. Applications that need validated strings can
+ * call this once per column per page instead of validating every value.
+ *
+ * @public @memberof CassResult
+ *
+ * @param[in] result
+ * @param[in] index The column's index.
+ * @param[out] is_valid cass_true if all the column's values are valid.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ * CASS_ERROR_LIB_INVALID_VALUE_TYPE is returned if the column isn't a text
+ * column.
+ *
+ * @see cass_result_column_get_string()
+ */
+CASS_EXPORT CassError
+cass_result_column_is_valid_utf8(const CassResult* result,
+                                 size_t index,
+                                 cass_bool_t* is_valid);
+
+/**
+ * Copies all the values of an int column into a contiguous buffer and
+ * converts them to host byte order in bulk. This is faster than
+ * cass_result_column_get_int32() for large results.
+ *
+ * @public @memberof CassResult
+ *
+ * @param[in] result
+ * @param[in] index The column index.
+ * @param[out] output A buffer with room for cass_result_row_count() values.
+ * Null values are copied as 0.
+ * @param[out] validity An optional bitmap of (cass_result_row_count() + 7) / 8
+ * bytes. The bit for each row, starting at the least significant bit of the
+ * first byte, is set if the row's value isn't null. This can be NULL.
+ * @param[in] output_size The number of values the output buffer can hold.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_result_column_get_int32()
+ */
+CASS_EXPORT CassError
+cass_result_column_get_int32_array(const CassResult* result,
+                                   size_t index,
+                                   cass_int32_t* output,
+                                   cass_uint8_t* validity,
+                                   size_t output_size);
+
+/**
+ * Copies all the values of a bigint, counter, timestamp or time column into a
+ * contiguous buffer and converts them to host byte order in bulk. This is faster than
+ * cass_result_column_get_int64() for large results.
+ *
+ * @public @memberof CassResult
+ *
+ * @param[in] result
+ * @param[in] index The column index.
+ * @param[out] output A buffer with room for cass_result_row_count() values.
+ * Null values are copied as 0.
+ * @param[out] validity An optional bitmap of (cass_result_row_count() + 7) / 8
+ * bytes. The bit for each row, starting at the least significant bit of the
+ * first byte, is set if the row's value isn't null. This can be NULL.
+ * @param[in] output_size The number of values the output buffer can hold.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_result_column_get_int64()
+ */
+CASS_EXPORT CassError
+cass_result_column_get_int64_array(const CassResult* result,
+                                   size_t index,
+                                   cass_int64_t* output,
+                                   cass_uint8_t* validity,
+                                   size_t output_size);
+
+/**
+ * Copies all the values of a float column into a contiguous buffer and
+ * converts them to host byte order in bulk. This is faster than
+ * cass_result_column_get_float() for large results.
+ *
+ * @public @memberof CassResult
+ *
+ * @param[in] result
+ * @param[in] index The column index.
+ * @param[out] output A buffer with room for cass_result_row_count() values.
+ * Null values are copied as 0.
+ * @param[out] validity An optional bitmap of (cass_result_row_count() + 7) / 8
+ * bytes. The bit for each row, starting at the least significant bit of the
+ * first byte, is set if the row's value isn't null. This can be NULL.
+ * @param[in] output_size The number of values the output buffer can hold.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_result_column_get_float()
+ */
+CASS_EXPORT CassError
+cass_result_column_get_float_array(const CassResult* result,
+                                   size_t index,
+                                   cass_float_t* output,
+                                   cass_uint8_t* validity,
+                                   size_t output_size);
+
+/**
+ * Copies all the values of a double column into a contiguous buffer and
+ * converts them to host byte order in bulk. This is faster than
+ * cass_result_column_get_double() for large results.
+ *
+ * @public @memberof CassResult
+ *
+ * @param[in] result
+ * @param[in] index The column index.
+ * @param[out] output A buffer with room for cass_result_row_count() values.
+ * Null values are copied as 0.
+ * @param[out] validity An optional bitmap of (cass_result_row_count() + 7) / 8
+ * bytes. The bit for each row, starting at the least significant bit of the
+ * first byte, is set if the row's value isn't null. This can be NULL.
+ * @param[in] output_size The number of values the output buffer can hold.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_result_column_get_double()
+ */
+CASS_EXPORT CassError
+cass_result_column_get_double_array(const CassResult* result,
+                                    size_t index,
+                                    cass_double_t* output,
+                                    cass_uint8_t* validity,
+                                    size_t output_size);
+
+/**
+ * Decodes all the values of a duration column into contiguous buffers of
+ * months, days and nanoseconds. This is faster than getting each row's value
+ * using cass_value_get_duration() for large results.
+ *
+ * @public @memberof CassResult
+ *
+ * @param[in] result
+ * @param[in] index The column index.
+ * @param[out] months A buffer with room for cass_result_row_count() values.
+ * @param[out] days A buffer with room for cass_result_row_count() values.
+ * @param[out] nanos A buffer with room for cass_result_row_count() values.
+ * Null values are decoded as 0 months, days and nanoseconds.
+ * @param[out] validity An optional bitmap of (cass_result_row_count() + 7) / 8
+ * bytes. The bit for each row, starting at the least significant bit of the
+ * first byte, is set if the row's value isn't null. This can be NULL.
+ * @param[in] output_size The number of values the output buffers can hold.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_value_get_duration()
+ */
+CASS_EXPORT CassError
+cass_result_column_get_duration(const CassResult* result,
+                                size_t index,
+                                cass_int32_t* months,
+                                cass_int32_t* days,
+                                cass_int64_t* nanos,
+                                cass_uint8_t* validity,
+                                size_t output_size);
+
+/**
+ * Exports the rows of a result as an Apache Arrow record batch using the
+ * Arrow C data interface. The batch is a struct array with a child array
+ * for each column and is built with a single pass over the result's rows.
+ *
+ * Columns are converted to the following Arrow types:
+ *
+ * <ul>
+ *   <li>tinyint, smallint, int, bigint and counter: signed integers</li>
+ *   <li>float and double: floating point</li>
+ *   <li>boolean: boolean</li>
+ *   <li>ascii, text and varchar: utf8</li>
+ *   <li>timestamp: timestamp in milliseconds (UTC)</li>
+ *   <li>date: date32</li>
+ *   <li>time: time64 in nanoseconds</li>
+ *   <li>uuid and timeuuid: fixed size binary of 16 bytes</li>
+ *   <li>All other types: binary containing the value's native protocol
+ *   encoding</li>
+ * </ul>
+ *
+ * The exported structures own copies of the data and don't reference the
+ * result, so the result can be freed before they're released.
+ *
+ * @public @memberof CassResult
+ *
+ * @param[in] result
+ * @param[out] array The record batch's data. This must be released by calling
+ * its release callback.
+ * @param[out] schema The record batch's schema. This must be released by
+ * calling its release callback.
+ * @return CASS_OK if successful, otherwise an error occurred. The output
+ * structures are not modified if an error occurred.
  */
-CASS_EXPORT const CassDataType*
-cass_result_column_data_type(const CassResult* result, size_t index);
+CASS_EXPORT CassError
+cass_result_export_arrow(const CassResult* result,
+                         struct ArrowArray* array,
+                         struct ArrowSchema* schema);
 
 /**
  * Gets the first row of the result.
@@ -9508,6 +15180,30 @@ cass_result_column_data_type(const CassResult* result, size_t index);
 CASS_EXPORT const CassRow*
 cass_result_first_row(const CassResult* result);
 
+/**
+ * Gets the rows of the result as they were encoded by the server: each row
+ * is a sequence of values, one per column, and each value is a 4-byte,
+ * big-endian length followed by the value's bytes (a negative length is a
+ * null value). The rows aren't validated.
+ *
+ * This is used by the typed row decoders in cassandra_row_decoder.hpp which
+ * check the columns' types once per result instead of once per value.
+ *
+ * @public @memberof CassResult
+ *
+ * @param[in] result
+ * @param[out] rows The encoded rows. They're valid until the result is freed.
+ * @param[out] rows_size The size of the encoded rows in bytes.
+ * @return CASS_OK if successful, otherwise CASS_ERROR_LIB_INVALID_STATE if the
+ * result doesn't have rows or their metadata.
+ *
+ * @see cass_result_row_count()
+ */
+CASS_EXPORT CassError
+cass_result_encoded_rows(const CassResult* result,
+                         const cass_byte_t** rows,
+                         size_t* rows_size);
+
 /**
  * Returns true if there are more pages.
  *
@@ -9821,6 +15517,44 @@ cass_iterator_type(CassIterator* iterator);
 CASS_EXPORT CassIterator*
 cass_iterator_from_result(const CassResult* result);
 
+/**
+ * Creates a new iterator over the rows of all the pages of a statement
+ * executed with paging prefetch enabled. The iterator waits for each page as
+ * it crosses page boundaries. Use cass_iterator_get_paging_error() to
+ * determine whether iteration stopped because of an error.
+ *
+ * <b>Note:</b> The pages are taken from the future and can't be retrieved
+ * with cass_session_get_next_page() while the iterator is in use.
+ *
+ * @cassandra{2.0+}
+ *
+ * @public @memberof CassFuture
+ *
+ * @param[in] session
+ * @param[in] future The future for the first page.
+ * @return A new iterator that must be freed.
+ *
+ * @see cass_statement_set_paging_prefetch()
+ * @see cass_iterator_free()
+ */
+CASS_EXPORT CassIterator*
+cass_iterator_from_paged_future(CassSession* session,
+                                CassFuture* future);
+
+/**
+ * Gets the error that stopped a paged result iterator.
+ *
+ * @public @memberof CassIterator
+ *
+ * @param[in] iterator
+ * @return CASS_OK if the iterator reached the end of the last page, otherwise
+ * the error of the page that failed.
+ *
+ * @see cass_iterator_from_paged_future()
+ */
+CASS_EXPORT CassError
+cass_iterator_get_paging_error(const CassIterator* iterator);
+
 /**
  * Creates a new iterator for the specified row. This can be
  * used to iterate over columns in a row.
@@ -10514,6 +16248,120 @@ cass_row_get_column_by_name_n(const CassRow* row,
                               const char* name,
                               size_t name_length);
 
+/**
+ * Same as cass_row_get_column_by_name(), but using a column handle instead of
+ * a name.
+ *
+ * @public @memberof CassRow
+ *
+ * @param[in] row
+ * @param[in] column_handle
+ * @return same as cass_row_get_column_by_name()
+ *
+ * @see cass_row_get_column_by_name()
+ * @see cass_result_column_handle()
+ */
+CASS_EXPORT const CassValue*
+cass_row_get_column_by_handle(const CassRow* row,
+                              const CassColumnHandle* column_handle);
+
+/***********************************************************************************
+ *
+ * Row batch
+ *
+ ***********************************************************************************/
+
+/**
+ * Creates a new row batch that decodes up to a maximum number of rows at once.
+ * The batch is reused for each group of rows to avoid allocating per row.
+ *
+ * @public @memberof CassRowBatch
+ *
+ * @param[in] capacity The maximum number of rows decoded at once.
+ * @return Returns a row batch that must be freed. NULL is returned if the
+ * capacity is zero.
+ *
+ * @see cass_row_batch_free()
+ */
+CASS_EXPORT CassRowBatch*
+cass_row_batch_new(size_t capacity);
+
+/**
+ * Frees a row batch instance.
+ *
+ * @public @memberof CassRowBatch
+ *
+ * @param[in] batch
+ */
+CASS_EXPORT void
+cass_row_batch_free(CassRowBatch* batch);
+
+/**
+ * Decodes up to the batch's capacity of rows from a result starting at
+ * a row. Rows previously decoded into the batch are replaced.
+ *
+ * The decoded rows point into the result's data and must not be used after
+ * the result is freed. Once decoded, the rows and their values can be read
+ * concurrently by multiple threads.
+ *
+ * <b>Example:</b>
+ *
+ * @code{.c}
+ * CassRowBatch* batch = cass_row_batch_new(256);
+ * size_t start_row = 0;
+ *
+ * while (cass_row_batch_decode(batch, result, start_row) == CASS_OK &&
+ *        cass_row_batch_row_count(batch) > 0) {
+ *   size_t i, count = cass_row_batch_row_count(batch);
+ *   for (i = 0; i < count; ++i) {
+ *     const CassRow* row = cass_row_batch_get_row(batch, i);
+ *     // Process the row...
+ *   }
+ *   start_row += count;
+ * }
+ *
+ * cass_row_batch_free(batch);
+ * @endcode
+ *
+ * @public @memberof CassRowBatch
+ *
+ * @param[in] batch
+ * @param[in] result
+ * @param[in] start_row The index of the first row to decode.
+ * @return CASS_OK if successful, otherwise an error occurred and the batch
+ * is empty. CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS is returned if the start row is
+ * past the result's row count.
+ */
+CASS_EXPORT CassError
+cass_row_batch_decode(CassRowBatch* batch,
+                      const CassResult* result,
+                      size_t start_row);
+
+/**
+ * Gets the number of rows decoded by the last call to cass_row_batch_decode().
+ *
+ * @public @memberof CassRowBatch
+ *
+ * @param[in] batch
+ * @return The number of rows in the batch.
+ */
+CASS_EXPORT size_t
+cass_row_batch_row_count(const CassRowBatch* batch);
+
+/**
+ * Gets a row from the batch.
+ *
+ * @public @memberof CassRowBatch
+ *
+ * @param[in] batch
+ * @param[in] index
+ * @return The row at the specified index. NULL is returned if the index is
+ * out of bounds.
+ */
+CASS_EXPORT const CassRow*
+cass_row_batch_get_row(const CassRowBatch* batch,
+                       size_t index);
+
 /***********************************************************************************
  *
  * Value
@@ -10815,6 +16663,142 @@ cass_value_primary_sub_type(const CassValue* collection);
 CASS_EXPORT CassValueType
 cass_value_secondary_sub_type(const CassValue* collection);
 
+/**
+ * Gets all the items of a list or set of int, or all the values of a map
+ * with values of that type, in a single call. The items are decoded directly
+ * into the output array, which is faster than iterating over large
+ * collections item by item.
+ *
+ * @public @memberof CassValue
+ *
+ * @param[in] collection
+ * @param[out] output An array for the items. It must have at least as many
+ * elements as the collection has items, see cass_value_item_count().
+ * @param[in] output_count The number of elements in the output array.
+ * @param[out] item_count The number of items in the collection. This is set
+ * even if the output array is too small. Can be NULL.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ * CASS_ERROR_LIB_BAD_PARAMS is returned if the output array is too small and
+ * CASS_ERROR_LIB_NULL_VALUE if the collection, or one of its items, is null.
+ *
+ * @see cass_value_get_int32()
+ */
+CASS_EXPORT CassError
+cass_value_get_int32_items(const CassValue* collection,
+                           cass_int32_t* output,
+                           size_t output_count,
+                           size_t* item_count);
+
+/**
+ * Gets all the items of a list or set of bigint, counter, timestamp or time,
+ * or all the values of a map with values of those types, in a single call.
+ * The items are decoded directly into the output array, which is faster than
+ * iterating over large collections item by item.
+ *
+ * @public @memberof CassValue
+ *
+ * @param[in] collection
+ * @param[out] output An array for the items. It must have at least as many
+ * elements as the collection has items, see cass_value_item_count().
+ * @param[in] output_count The number of elements in the output array.
+ * @param[out] item_count The number of items in the collection. This is set
+ * even if the output array is too small. Can be NULL.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ * CASS_ERROR_LIB_BAD_PARAMS is returned if the output array is too small and
+ * CASS_ERROR_LIB_NULL_VALUE if the collection, or one of its items, is null.
+ *
+ * @see cass_value_get_int64()
+ */
+CASS_EXPORT CassError
+cass_value_get_int64_items(const CassValue* collection,
+                           cass_int64_t* output,
+                           size_t output_count,
+                           size_t* item_count);
+
+/**
+ * Gets all the items of a list or set of float, or all the values of a map
+ * with values of that type, in a single call. The items are decoded directly
+ * into the output array, which is faster than iterating over large
+ * collections item by item.
+ *
+ * @public @memberof CassValue
+ *
+ * @param[in] collection
+ * @param[out] output An array for the items. It must have at least as many
+ * elements as the collection has items, see cass_value_item_count().
+ * @param[in] output_count The number of elements in the output array.
+ * @param[out] item_count The number of items in the collection. This is set
+ * even if the output array is too small. Can be NULL.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ * CASS_ERROR_LIB_BAD_PARAMS is returned if the output array is too small and
+ * CASS_ERROR_LIB_NULL_VALUE if the collection, or one of its items, is null.
+ *
+ * @see cass_value_get_float()
+ */
+CASS_EXPORT CassError
+cass_value_get_float_items(const CassValue* collection,
+                           cass_float_t* output,
+                           size_t output_count,
+                           size_t* item_count);
+
+/**
+ * Gets all the items of a list or set of double, or all the values of a map
+ * with values of that type, in a single call. The items are decoded directly
+ * into the output array, which is faster than iterating over large
+ * collections item by item.
+ *
+ * @public @memberof CassValue
+ *
+ * @param[in] collection
+ * @param[out] output An array for the items. It must have at least as many
+ * elements as the collection has items, see cass_value_item_count().
+ * @param[in] output_count The number of elements in the output array.
+ * @param[out] item_count The number of items in the collection. This is set
+ * even if the output array is too small. Can be NULL.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ * CASS_ERROR_LIB_BAD_PARAMS is returned if the output array is too small and
+ * CASS_ERROR_LIB_NULL_VALUE if the collection, or one of its items, is null.
+ *
+ * @see cass_value_get_double()
+ */
+CASS_EXPORT CassError
+cass_value_get_double_items(const CassValue* collection,
+                            cass_double_t* output,
+                            size_t output_count,
+                            size_t* item_count);
+
+/**
+ * Gets references to the encoded bytes of all the items of a collection in a
+ * single pass. The items of a map are its keys and values, alternating, like
+ * the items of a collection iterator. The references point into the result
+ * and are only valid as long as the result is.
+ *
+ * @public @memberof CassValue
+ *
+ * @param[in] collection
+ * @param[out] items An array for the items' bytes. A null item is set to
+ * NULL.
+ * @param[out] item_sizes An array for the sizes of the items' bytes. The size
+ * of a null item is -1.
+ * @param[in] output_count The number of elements in both the output arrays.
+ * It must be at least the number of items in the collection (twice the item
+ * count for a map).
+ * @param[out] item_count The number of items in the collection (twice the
+ * item count for a map). This is set even if the output arrays are too
+ * small. Can be NULL.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ * CASS_ERROR_LIB_BAD_PARAMS is returned if the output arrays are too small.
+ *
+ * @see cass_iterator_from_collection()
+ * @see cass_iterator_from_map()
+ */
+CASS_EXPORT CassError
+cass_value_get_item_refs(const CassValue* collection,
+                         const cass_byte_t** items,
+                         cass_int32_t* item_sizes,
+                         size_t output_count,
+                         size_t* item_count);
+
 
 /***********************************************************************************
  *
@@ -10856,6 +16840,44 @@ cass_uuid_gen_new();
 CASS_EXPORT CassUuidGen*
 cass_uuid_gen_new_with_node(cass_uint64_t node);
 
+/**
+ * Creates a new UUID generator that reserves the timestamps of time-based
+ * UUIDs in batches per thread. A thread only updates the generator's shared
+ * state when its batch is used up or has fallen behind the clock, so many
+ * threads can generate time-based UUIDs concurrently without contending. The
+ * UUIDs are unique and each thread's UUIDs are monotonic, but UUIDs generated
+ * by different threads aren't ordered with respect to each other.
+ *
+ * <b>Note:</b> This object is thread-safe. It is best practice to create and reuse
+ * a single object per application.
+ *
+ * @public @memberof CassUuidGen
+ *
+ * @param[in] batch_size The number of timestamps (100 nanosecond intervals)
+ * reserved by a thread at a time. A value of 0 uses the default of 1024.
+ * @return Returns a UUID generator that must be freed.
+ *
+ * @see cass_uuid_gen_free()
+ * @see cass_uuid_gen_new_per_thread_with_node()
+ */
+CASS_EXPORT CassUuidGen*
+cass_uuid_gen_new_per_thread(unsigned batch_size);
+
+/**
+ * Same as cass_uuid_gen_new_per_thread(), but with custom node information.
+ *
+ * @public @memberof CassUuidGen
+ *
+ * @param[in] node
+ * @param[in] batch_size
+ * @return Returns a UUID generator that must be freed.
+ *
+ * @see cass_uuid_gen_new_per_thread()
+ */
+CASS_EXPORT CassUuidGen*
+cass_uuid_gen_new_per_thread_with_node(cass_uint64_t node,
+                                       unsigned batch_size);
+
 /**
  * Frees a UUID generator instance.
  *
@@ -11072,6 +17094,48 @@ CASS_EXPORT CassTimestampGen*
 cass_timestamp_gen_monotonic_new_with_settings(cass_int64_t warning_threshold_us,
                                                cass_int64_t warning_interval_ms);
 
+/**
+ * Creates a new monotonically increasing timestamp generator with per-thread
+ * lanes. The low bits of each timestamp's microseconds hold the id of the lane
+ * that generated it and each thread is assigned its own lane, so timestamps
+ * are unique without the threads updating a shared timestamp. Timestamps
+ * generated by the same thread are monotonic, but timestamps generated by
+ * different threads can be out of order by up to 2^lane_bits microseconds.
+ *
+ * <b>Note:</b> This generator is thread-safe and can be shared by multiple
+ * sessions.
+ *
+ * @cassandra{2.1+}
+ *
+ * @public @memberof CassTimestampGen
+ *
+ * @param[in] lane_bits The number of low microsecond bits used for the lane
+ * id (at most 10). The generator has 2^lane_bits lanes. A value of 4 is a good
+ * default.
+ * @return Returns a timestamp generator that must be freed.
+ *
+ * @see cass_timestamp_gen_per_thread_monotonic_new_with_settings()
+ * @see cass_timestamp_gen_free()
+ */
+CASS_EXPORT CassTimestampGen*
+cass_timestamp_gen_per_thread_monotonic_new(unsigned lane_bits);
+
+/**
+ * Same as cass_timestamp_gen_per_thread_monotonic_new(), but with settings for
+ * controlling warnings about clock skew.
+ *
+ * @param lane_bits
+ * @param warning_threshold_us
+ * @param warning_interval_ms
+ * @return Returns a timestamp generator that must be freed.
+ *
+ * @see cass_timestamp_gen_monotonic_new_with_settings()
+ */
+CASS_EXPORT CassTimestampGen*
+cass_timestamp_gen_per_thread_monotonic_new_with_settings(unsigned lane_bits,
+                                                          cass_int64_t warning_threshold_us,
+                                                          cass_int64_t warning_interval_ms);
+
 /**
  * Frees a timestamp generator instance.
  *
@@ -11085,6 +17149,44 @@ CASS_EXPORT void
 cass_timestamp_gen_free(CassTimestampGen* timestamp_gen);
 
 
+/***********************************************************************************
+ *
+ * Runtime
+ *
+ ***********************************************************************************/
+
+/**
+ * Creates a new runtime, the threads shared by the sessions of the cluster
+ * objects it's set on. This allows an application that connects to several
+ * clusters to use a number of IO threads that depends on its CPUs instead of
+ * the number of clusters. The threads are started by the first session that
+ * connects.
+ *
+ * @public @memberof CassRuntime
+ *
+ * @param[in] num_threads_io The number of IO threads. Use 0 to start the
+ * number of IO threads of the first connecting session's cluster object.
+ * @return Returns a runtime that must be freed. The threads are stopped once
+ * the runtime and all the sessions and cluster objects using it have been
+ * freed.
+ *
+ * @see cass_cluster_set_runtime()
+ * @see cass_runtime_free()
+ */
+CASS_EXPORT CassRuntime*
+cass_runtime_new(unsigned num_threads_io);
+
+/**
+ * Frees a runtime instance.
+ *
+ * @public @memberof CassRuntime
+ *
+ * @param[in] runtime
+ */
+CASS_EXPORT void
+cass_runtime_free(CassRuntime* runtime);
+
+
 /***********************************************************************************
  *
  * Retry policies
@@ -11297,6 +17399,24 @@ cass_custom_payload_remove_n(CassCustomPayload* payload,
                              const char* name,
                              size_t name_length);
 
+/**
+ * Makes the custom payload immutable and pre-encodes it. A frozen payload can
+ * be shared by many statements and batches, from multiple threads, and is
+ * added to their requests without being encoded again. Setting or removing
+ * items of a frozen payload has no effect.
+ *
+ * @cassandra{2.2+}
+ *
+ * @public @memberof CassCustomPayload
+ *
+ * @param[in] payload
+ *
+ * @see cass_statement_set_custom_payload()
+ * @see cass_batch_set_custom_payload()
+ */
+CASS_EXPORT void
+cass_custom_payload_freeze(CassCustomPayload* payload);
+
 
 /***********************************************************************************
  *
@@ -11406,6 +17526,45 @@ cass_log_set_callback(CassLogCallback callback,
 CASS_EXPORT CASS_DEPRECATED(void
 cass_log_set_queue_size(size_t queue_size));
 
+/**
+ * Enables/Disables asynchronous logging. If enabled, log messages are queued
+ * on a bounded, lock-free queue and the log callback is called on a
+ * background thread so that logging never blocks the driver's threads on the
+ * callback. Messages are dropped if the queue is full.
+ *
+ * Repeats of the same message, from the same place, within a second are
+ * collapsed into a single message followed by the number of repeats. The
+ * number of messages that are dropped, or suppressed by the rate limit, is
+ * logged in their place.
+ *
+ * <b>Note:</b> This needs to be done before any call that might log, such as
+ * any of the cass_cluster_*() or cass_ssl_*() functions. Disable it, or call
+ * cass_log_flush(), before the application exits so that queued messages
+ * aren't lost.
+ *
+ * <b>Default:</b> Disabled (the callback is called on the logging thread)
+ *
+ * @param[in] queue_size The maximum number of queued messages or zero to
+ * disable asynchronous logging. Disabling it logs the queued messages first.
+ * @param[in] max_messages_per_second The maximum number of messages passed to
+ * the callback per second or zero for no limit.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_log_set_callback()
+ */
+CASS_EXPORT CassError
+cass_log_set_async(size_t queue_size,
+                   unsigned max_messages_per_second);
+
+/**
+ * Waits for the queued log messages to be passed to the log callback. This
+ * does nothing if asynchronous logging is disabled.
+ *
+ * @see cass_log_set_async()
+ */
+CASS_EXPORT void
+cass_log_flush();
+
 /**
  * Gets the string for a log level.
  *
@@ -11533,6 +17692,29 @@ CASS_EXPORT cass_int64_t
 cass_date_time_to_epoch(cass_uint32_t date,
                         cass_int64_t time);
 
+/***********************************************************************************
+ *
+ * Token
+ *
+ ************************************************************************************/
+
+/**
+ * Computes the Murmur3Partitioner tokens of many routing keys. A routing key
+ * is the serialized partition key, the same value Cassandra hashes to place
+ * a partition. Several keys are hashed together which is faster than hashing
+ * each key on its own.
+ *
+ * @param[in] keys The routing keys.
+ * @param[in] key_lengths The length of each routing key.
+ * @param[in] count The number of routing keys.
+ * @param[out] output An array with room for count tokens.
+ */
+CASS_EXPORT void
+cass_murmur3_hash_batch(const char* const* keys,
+                        const size_t* key_lengths,
+                        size_t count,
+                        cass_int64_t* output);
+
 /***********************************************************************************
  *
  * Allocator
@@ -11559,6 +17741,18 @@ cass_alloc_set_functions(CassMallocFunction malloc_func,
                          CassReallocFunction realloc_func,
                          CassFreeFunction free_func);
 
+/**
+ * Gets a snapshot of the object cache's counters. The driver only caches
+ * objects when it's built with the CASS_USE_OBJECT_CACHE option, otherwise
+ * all the counters are zero.
+ *
+ * @param[out] stats
+ *
+ * @see CassObjectCacheStats
+ */
+CASS_EXPORT void
+cass_alloc_get_object_cache_stats(CassObjectCacheStats* stats);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -0,0 +1,385 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASSANDRA_BINDING_HPP_INCLUDED__
+#define __CASSANDRA_BINDING_HPP_INCLUDED__
+
+/**
+ * @file include/cassandra_binding.hpp
+ *
+ * An optional, header-only C++11 layer for binding the parameters of prepared
+ * statements with types that are known at compile time. The types are checked
+ * against the prepared statement's parameters once, when the binder is
+ * created. Binding values then encodes them directly into a single buffer
+ * that's bound using cass_statement_bind_encoded_values(), without checking
+ * the type of each value.
+ *
+ * @code{.cpp}
+ * // INSERT INTO users (id, name, age) VALUES (?, ?, ?)
+ * cass::Binder<CassUuid, std::string, cass_int32_t> binder(prepared);
+ * if (binder.error_code() != CASS_OK) {
+ *   // The parameters' types don't match
+ * }
+ *
+ * CassStatement* statement = binder.bind(id, name, 42);
+ * @endcode
+ *
+ * The C++ types map to the CQL types the same way as the bind functions e.g.
+ * "int" is a `cass_int32_t`, "bigint" and "timestamp" are a `cass_int64_t`,
+ * "date" is a `cass_uint32_t` and "text" is a `std::string` or a
+ * `const char*`. `cass::Null` binds null and `cass::Unset` leaves a parameter
+ * unset for any type.
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "cassandra.h"
+
+namespace cass {
+
+/**
+ * Binds a null value to a parameter of any type.
+ */
+struct Null {};
+
+/**
+ * Leaves a parameter of any type unset.
+ */
+struct Unset {};
+
+namespace binding {
+
+inline char* encode_int32(char* output, cass_int32_t value) {
+  cass_uint32_t bits = static_cast<cass_uint32_t>(value);
+  output[0] = static_cast<char>(bits >> 24);
+  output[1] = static_cast<char>(bits >> 16);
+  output[2] = static_cast<char>(bits >> 8);
+  output[3] = static_cast<char>(bits);
+  return output + 4;
+}
+
+inline char* encode_int64(char* output, cass_int64_t value) {
+  cass_uint64_t bits = static_cast<cass_uint64_t>(value);
+  for (int i = 7; i >= 0; --i) {
+    output[i] = static_cast<char>(bits);
+    bits >>= 8;
+  }
+  return output + 8;
+}
+
+inline char* encode_bytes(char* output, const void* data, size_t size) {
+  output = encode_int32(output, static_cast<cass_int32_t>(size));
+  memcpy(output, data, size);
+  return output + size;
+}
+
+inline bool is_string_type(CassValueType type) {
+  return type == CASS_VALUE_TYPE_ASCII || type == CASS_VALUE_TYPE_TEXT ||
+         type == CASS_VALUE_TYPE_VARCHAR;
+}
+
+inline bool is_bytes_type(CassValueType type) {
+  return type == CASS_VALUE_TYPE_BLOB || type == CASS_VALUE_TYPE_VARINT ||
+         type == CASS_VALUE_TYPE_CUSTOM;
+}
+
+} // namespace binding
+
+/**
+ * Describes how a C++ type is bound: the CQL types it can be bound to, the
+ * size of its encoded value (including the value's length) and how it's
+ * encoded. Specialize it to bind other types.
+ */
+template <class T>
+struct BindTraits;
+
+template <>
+struct BindTraits<Null> {
+  static bool is_valid(CassValueType) { return true; }
+  static size_t size(Null) { return 4; }
+  static char* encode(char* output, Null) { return binding::encode_int32(output, -1); }
+};
+
+template <>
+struct BindTraits<Unset> {
+  static bool is_valid(CassValueType) { return true; }
+  static size_t size(Unset) { return 4; }
+  static char* encode(char* output, Unset) { return binding::encode_int32(output, -2); }
+};
+
+template <>
+struct BindTraits<cass_int8_t> {
+  static bool is_valid(CassValueType type) { return type == CASS_VALUE_TYPE_TINY_INT; }
+  static size_t size(cass_int8_t) { return 4 + 1; }
+  static char* encode(char* output, cass_int8_t value) {
+    output = binding::encode_int32(output, 1);
+    *output = static_cast<char>(value);
+    return output + 1;
+  }
+};
+
+template <>
+struct BindTraits<cass_int16_t> {
+  static bool is_valid(CassValueType type) { return type == CASS_VALUE_TYPE_SMALL_INT; }
+  static size_t size(cass_int16_t) { return 4 + 2; }
+  static char* encode(char* output, cass_int16_t value) {
+    output = binding::encode_int32(output, 2);
+    cass_uint16_t bits = static_cast<cass_uint16_t>(value);
+    output[0] = static_cast<char>(bits >> 8);
+    output[1] = static_cast<char>(bits);
+    return output + 2;
+  }
+};
+
+template <>
+struct BindTraits<cass_int32_t> {
+  static bool is_valid(CassValueType type) { return type == CASS_VALUE_TYPE_INT; }
+  static size_t size(cass_int32_t) { return 4 + 4; }
+  static char* encode(char* output, cass_int32_t value) {
+    return binding::encode_int32(binding::encode_int32(output, 4), value);
+  }
+};
+
+template <>
+struct BindTraits<cass_uint32_t> {
+  static bool is_valid(CassValueType type) { return type == CASS_VALUE_TYPE_DATE; }
+  static size_t size(cass_uint32_t) { return 4 + 4; }
+  static char* encode(char* output, cass_uint32_t value) {
+    return binding::encode_int32(binding::encode_int32(output, 4),
+                                 static_cast<cass_int32_t>(value));
+  }
+};
+
+template <>
+struct BindTraits<cass_int64_t> {
+  static bool is_valid(CassValueType type) {
+    return type == CASS_VALUE_TYPE_BIGINT || type == CASS_VALUE_TYPE_COUNTER ||
+           type == CASS_VALUE_TYPE_TIMESTAMP || type == CASS_VALUE_TYPE_TIME;
+  }
+  static size_t size(cass_int64_t) { return 4 + 8; }
+  static char* encode(char* output, cass_int64_t value) {
+    return binding::encode_int64(binding::encode_int32(output, 8), value);
+  }
+};
+
+template <>
+struct BindTraits<cass_float_t> {
+  static bool is_valid(CassValueType type) { return type == CASS_VALUE_TYPE_FLOAT; }
+  static size_t size(cass_float_t) { return 4 + 4; }
+  static char* encode(char* output, cass_float_t value) {
+    cass_int32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return binding::encode_int32(binding::encode_int32(output, 4), bits);
+  }
+};
+
+template <>
+struct BindTraits<cass_double_t> {
+  static bool is_valid(CassValueType type) { return type == CASS_VALUE_TYPE_DOUBLE; }
+  static size_t size(cass_double_t) { return 4 + 8; }
+  static char* encode(char* output, cass_double_t value) {
+    cass_int64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return binding::encode_int64(binding::encode_int32(output, 8), bits);
+  }
+};
+
+template <>
+struct BindTraits<cass_bool_t> {
+  static bool is_valid(CassValueType type) { return type == CASS_VALUE_TYPE_BOOLEAN; }
+  static size_t size(cass_bool_t) { return 4 + 1; }
+  static char* encode(char* output, cass_bool_t value) {
+    output = binding::encode_int32(output, 1);
+    *output = static_cast<char>(value);
+    return output + 1;
+  }
+};
+
+template <>
+struct BindTraits<CassUuid> {
+  static bool is_valid(CassValueType type) {
+    return type == CASS_VALUE_TYPE_UUID || type == CASS_VALUE_TYPE_TIMEUUID;
+  }
+  static size_t size(const CassUuid&) { return 4 + 16; }
+  static char* encode(char* output, const CassUuid& value) {
+    output = binding::encode_int32(output, 16);
+    // The time fields are stored in the order time_low, time_mid and
+    // time_hi_and_version
+    cass_uint64_t time_and_version = value.time_and_version;
+    binding::encode_int32(output, static_cast<cass_int32_t>(time_and_version & 0xFFFFFFFF));
+    output[4] = static_cast<char>(time_and_version >> 40);
+    output[5] = static_cast<char>(time_and_version >> 32);
+    output[6] = static_cast<char>(time_and_version >> 56);
+    output[7] = static_cast<char>(time_and_version >> 48);
+    return binding::encode_int64(output + 8, static_cast<cass_int64_t>(value.clock_seq_and_node));
+  }
+};
+
+template <>
+struct BindTraits<CassInet> {
+  static bool is_valid(CassValueType type) { return type == CASS_VALUE_TYPE_INET; }
+  static size_t size(const CassInet& value) { return 4 + value.address_length; }
+  static char* encode(char* output, const CassInet& value) {
+    return binding::encode_bytes(output, value.address, value.address_length);
+  }
+};
+
+template <>
+struct BindTraits<std::string> {
+  // Strings can also be bound to "bytes" types, like cass_statement_bind_string()
+  static bool is_valid(CassValueType type) {
+    return binding::is_string_type(type) || binding::is_bytes_type(type);
+  }
+  static size_t size(const std::string& value) { return 4 + value.size(); }
+  static char* encode(char* output, const std::string& value) {
+    return binding::encode_bytes(output, value.data(), value.size());
+  }
+};
+
+template <>
+struct BindTraits<const char*> {
+  static bool is_valid(CassValueType type) { return BindTraits<std::string>::is_valid(type); }
+  static size_t size(const char* value) { return value ? 4 + strlen(value) : 4; }
+  static char* encode(char* output, const char* value) {
+    if (!value) return binding::encode_int32(output, -1);
+    return binding::encode_bytes(output, value, strlen(value));
+  }
+};
+
+template <>
+struct BindTraits<std::vector<cass_byte_t> > {
+  static bool is_valid(CassValueType type) { return binding::is_bytes_type(type); }
+  static size_t size(const std::vector<cass_byte_t>& value) { return 4 + value.size(); }
+  static char* encode(char* output, const std::vector<cass_byte_t>& value) {
+    return binding::encode_bytes(output, value.empty() ? NULL : &value[0], value.size());
+  }
+};
+
+/**
+ * Binds the parameters of a prepared statement with values of fixed C++
+ * types. The types are checked against the prepared statement's parameters
+ * once, when the binder is constructed, so a binder is usually created once
+ * per prepared statement and reused for each execution. A binder is
+ * immutable and can be used from multiple threads.
+ *
+ * @tparam Types The C++ types of the statement's parameters, in order. There
+ * must be a type for each parameter.
+ */
+template <class... Types>
+class Binder {
+public:
+  /**
+   * Constructor.
+   *
+   * @param[in] prepared The prepared statement. It must outlive the binder.
+   */
+  explicit Binder(const CassPrepared* prepared)
+      : prepared_(prepared)
+      , error_code_(check(prepared)) {}
+
+  /**
+   * Get the result of checking the types against the prepared statement's
+   * parameters. The binder can only be used if this is CASS_OK.
+   *
+   * @return CASS_OK if the types match, CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS if
+   * the number of types doesn't match the number of parameters, or
+   * CASS_ERROR_LIB_INVALID_VALUE_TYPE if a type can't be bound to its
+   * parameter.
+   */
+  CassError error_code() const { return error_code_; }
+
+  /**
+   * Create a bound statement from the prepared statement and bind values to
+   * it.
+   *
+   * @param[in] values
+   * @return A bound statement that must be freed, or NULL if the types didn't
+   * match the prepared statement's parameters.
+   */
+  CassStatement* bind(const Types&... values) const {
+    if (error_code_ != CASS_OK) return NULL;
+    CassStatement* statement = cass_prepared_bind(prepared_);
+    bind(statement, values...);
+    return statement;
+  }
+
+  /**
+   * Bind values to a statement that was bound from the binder's prepared
+   * statement.
+   *
+   * @param[in] statement
+   * @param[in] values
+   * @return CASS_OK if successful, otherwise an error occurred.
+   */
+  CassError bind(CassStatement* statement, const Types&... values) const {
+    if (error_code_ != CASS_OK) return error_code_;
+
+    size_t sizes[] = { 0, BindTraits<Types>::size(values)... };
+    size_t size = 0;
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+      size += sizes[i];
+    }
+
+    // Values are encoded on the stack unless they're large
+    char fixed[STACK_BUFFER_SIZE];
+    std::vector<char> dynamic;
+    char* buffer = fixed;
+    if (size > STACK_BUFFER_SIZE) {
+      dynamic.resize(size);
+      buffer = &dynamic[0];
+    }
+
+    char* pos = buffer;
+    char* ends[] = { pos, (pos = BindTraits<Types>::encode(pos, values))... };
+    (void)ends;
+
+    return cass_statement_bind_encoded_values(
+        statement, reinterpret_cast<const cass_byte_t*>(buffer), size);
+  }
+
+private:
+  static const size_t STACK_BUFFER_SIZE = 512;
+
+  static CassError check(const CassPrepared* prepared) {
+    typedef bool (*IsValidFunc)(CassValueType);
+    static const IsValidFunc is_valid[] = { NULL, &BindTraits<Types>::is_valid... };
+    const size_t count = sizeof(is_valid) / sizeof(is_valid[0]) - 1;
+
+    for (size_t i = 0; i < count; ++i) {
+      const CassDataType* data_type = cass_prepared_parameter_data_type(prepared, i);
+      if (data_type == NULL) return CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS;
+      if (!is_valid[i + 1](cass_data_type_type(data_type))) {
+        return CASS_ERROR_LIB_INVALID_VALUE_TYPE;
+      }
+    }
+    if (cass_prepared_parameter_data_type(prepared, count) != NULL) {
+      return CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS;
+    }
+    return CASS_OK;
+  }
+
+private:
+  const CassPrepared* prepared_;
+  CassError error_code_;
+};
+
+} // namespace cass
+
+#endif
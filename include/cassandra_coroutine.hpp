@@ -0,0 +1,188 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASSANDRA_COROUTINE_HPP_INCLUDED__
+#define __CASSANDRA_COROUTINE_HPP_INCLUDED__
+
+/**
+ * @file include/cassandra_coroutine.hpp
+ *
+ * An optional, header-only C++20 layer that makes driver futures awaitable
+ * from coroutines. It only uses the public C API and isn't part of the
+ * compiled library, so it can be used with a driver built with any standard.
+ *
+ * @code{.cpp}
+ * cass::Future future(cass_session_execute(session, statement));
+ * if (co_await future == CASS_OK) {
+ *   const CassResult* result = cass_future_get_result(future.get());
+ *   ...
+ * }
+ * @endcode
+ *
+ * A coroutine is resumed on the driver's I/O thread that completed the future
+ * unless an executor is provided. Blocking a resumed coroutine blocks that
+ * I/O thread, so use an executor to resume on an application thread pool:
+ *
+ * @code{.cpp}
+ * struct PoolExecutor {
+ *   void operator()(std::coroutine_handle<> handle) const {
+ *     pool->post([handle] { handle.resume(); });
+ *   }
+ * };
+ *
+ * CassError rc = co_await future.via(PoolExecutor());
+ * @endcode
+ */
+
+#if !defined(__cpp_impl_coroutine) || __cplusplus < 202002L
+#error "cassandra_coroutine.hpp requires C++20 coroutine support"
+#endif
+
+#include <coroutine>
+#include <utility>
+
+#include "cassandra.h"
+
+namespace cass {
+
+/**
+ * The default executor. It resumes the coroutine on the thread that completed
+ * the future, usually one of the driver's I/O threads.
+ */
+struct InlineExecutor {
+  void operator()(std::coroutine_handle<> handle) const { handle.resume(); }
+};
+
+/**
+ * Awaits a future without taking ownership of it. The result of `co_await` is
+ * the future's error code.
+ *
+ * The awaiter is stored in the awaiting coroutine's frame and is passed
+ * directly as the future's callback data so awaiting a future doesn't
+ * allocate. A future only has a single callback so it can't be awaited if a
+ * callback has already been set; in that case the coroutine isn't suspended
+ * and waits for the future instead.
+ *
+ * @tparam Executor A callable, `void(std::coroutine_handle<>)`, that resumes
+ * the coroutine. It's called on the thread that completed the future.
+ */
+template <class Executor = InlineExecutor>
+class FutureAwaiter {
+public:
+  FutureAwaiter(CassFuture* future, Executor executor = Executor())
+      : future_(future)
+      , executor_(std::move(executor)) {}
+
+  bool await_ready() const { return cass_future_ready(future_) == cass_true; }
+
+  bool await_suspend(std::coroutine_handle<> handle) {
+    handle_ = handle;
+    // If the future is already set the callback runs, and can resume the
+    // coroutine, before this returns so the awaiter mustn't be used after
+    // setting the callback.
+    return cass_future_set_callback(future_, on_ready, this) == CASS_OK;
+  }
+
+  CassError await_resume() const { return cass_future_error_code(future_); }
+
+private:
+  static void on_ready(CassFuture*, void* data) {
+    FutureAwaiter* awaiter = static_cast<FutureAwaiter*>(data);
+    awaiter->executor_(awaiter->handle_);
+  }
+
+private:
+  CassFuture* future_;
+  Executor executor_;
+  std::coroutine_handle<> handle_;
+};
+
+/**
+ * Await a future that's owned by the caller.
+ *
+ * @param[in] future
+ * @param[in] executor
+ * @return An awaiter of the future.
+ */
+template <class Executor = InlineExecutor>
+inline FutureAwaiter<Executor> wait(CassFuture* future, Executor executor = Executor()) {
+  return FutureAwaiter<Executor>(future, std::move(executor));
+}
+
+/**
+ * An owning, move-only wrapper of a future that's directly awaitable. The
+ * future is freed when the wrapper is destroyed.
+ */
+class Future {
+public:
+  Future()
+      : future_(nullptr) {}
+
+  explicit Future(CassFuture* future)
+      : future_(future) {}
+
+  Future(Future&& other) noexcept
+      : future_(other.release()) {}
+
+  Future& operator=(Future&& other) noexcept {
+    if (this != &other) {
+      reset(other.release());
+    }
+    return *this;
+  }
+
+  Future(const Future&) = delete;
+  Future& operator=(const Future&) = delete;
+
+  ~Future() { reset(); }
+
+  CassFuture* get() const { return future_; }
+
+  explicit operator bool() const { return future_ != nullptr; }
+
+  CassFuture* release() {
+    CassFuture* temp = future_;
+    future_ = nullptr;
+    return temp;
+  }
+
+  void reset(CassFuture* future = nullptr) {
+    if (future_) {
+      cass_future_free(future_);
+    }
+    future_ = future;
+  }
+
+  /**
+   * Await the future, resuming the coroutine using an executor.
+   *
+   * @param[in] executor
+   * @return An awaiter of the future.
+   */
+  template <class Executor>
+  FutureAwaiter<Executor> via(Executor executor) const {
+    return FutureAwaiter<Executor>(future_, std::move(executor));
+  }
+
+  FutureAwaiter<> operator co_await() const { return FutureAwaiter<>(future_); }
+
+private:
+  CassFuture* future_;
+};
+
+} // namespace cass
+
+#endif
@@ -0,0 +1,377 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASSANDRA_ROW_DECODER_HPP_INCLUDED__
+#define __CASSANDRA_ROW_DECODER_HPP_INCLUDED__
+
+/**
+ * @file include/cassandra_row_decoder.hpp
+ *
+ * An optional, header-only C++11 layer for decoding the rows of results with
+ * columns whose types are known at compile time. The types are checked
+ * against the result's metadata once, when the decoder is created. Each row
+ * is then decoded directly into a `std::tuple` in a single pass over the
+ * row's bytes, without checking the type of each value.
+ *
+ * @code{.cpp}
+ * // SELECT id, name, score FROM users
+ * cass::RowDecoder<cass_int64_t, std::string, cass_double_t> decoder(result);
+ * if (decoder.error_code() != CASS_OK) {
+ *   // The columns' types don't match
+ * }
+ *
+ * std::tuple<cass_int64_t, std::string, cass_double_t> row;
+ * while (decoder.next(&row)) {
+ *   ...
+ * }
+ * @endcode
+ *
+ * The C++ types map to the CQL types the same way as the `cass_value_get_*()`
+ * functions e.g. "int" is a `cass_int32_t`, "bigint" and "timestamp" are a
+ * `cass_int64_t`, "date" is a `cass_uint32_t` and "text" is a `std::string`.
+ * With C++17, "text" and "blob" columns can also be decoded into a
+ * `std::string_view` that references the result's memory and is only valid
+ * until the result is freed.
+ *
+ * A null value is decoded as a value-initialized value e.g. zero or an empty
+ * string.
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+#include "cassandra.h"
+
+namespace cass {
+
+namespace decoding {
+
+inline cass_int32_t decode_int32(const char* input) {
+  const unsigned char* bytes = reinterpret_cast<const unsigned char*>(input);
+  return static_cast<cass_int32_t>(
+      (static_cast<cass_uint32_t>(bytes[0]) << 24) | (static_cast<cass_uint32_t>(bytes[1]) << 16) |
+      (static_cast<cass_uint32_t>(bytes[2]) << 8) | static_cast<cass_uint32_t>(bytes[3]));
+}
+
+inline cass_int64_t decode_int64(const char* input) {
+  return static_cast<cass_int64_t>(
+      (static_cast<cass_uint64_t>(static_cast<cass_uint32_t>(decode_int32(input))) << 32) |
+      static_cast<cass_uint32_t>(decode_int32(input + 4)));
+}
+
+inline bool is_string_type(CassValueType type) {
+  return type == CASS_VALUE_TYPE_ASCII || type == CASS_VALUE_TYPE_TEXT ||
+         type == CASS_VALUE_TYPE_VARCHAR;
+}
+
+inline bool is_bytes_type(CassValueType type) {
+  return type == CASS_VALUE_TYPE_BLOB || type == CASS_VALUE_TYPE_VARINT ||
+         type == CASS_VALUE_TYPE_CUSTOM;
+}
+
+} // namespace decoding
+
+/**
+ * Describes how a C++ type is decoded: the CQL types it can be decoded from
+ * and how its value is decoded. `decode()` is called with a value's bytes
+ * and size, and returns false if the value is invalid. It isn't called for
+ * null values. Specialize it to decode other types.
+ */
+template <class T>
+struct DecodeTraits;
+
+/**
+ * Decodes values of a fixed size.
+ */
+template <class T, size_t Size>
+struct FixedSizeDecodeTraits {
+  static bool decode(const char* data, size_t size, T* output) {
+    if (size != Size) return false;
+    *output = DecodeTraits<T>::decode_fixed(data);
+    return true;
+  }
+};
+
+template <>
+struct DecodeTraits<cass_int8_t> : public FixedSizeDecodeTraits<cass_int8_t, 1> {
+  static bool is_valid(CassValueType type) { return type == CASS_VALUE_TYPE_TINY_INT; }
+  static cass_int8_t decode_fixed(const char* data) { return static_cast<cass_int8_t>(data[0]); }
+};
+
+template <>
+struct DecodeTraits<cass_int16_t> : public FixedSizeDecodeTraits<cass_int16_t, 2> {
+  static bool is_valid(CassValueType type) { return type == CASS_VALUE_TYPE_SMALL_INT; }
+  static cass_int16_t decode_fixed(const char* data) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+    return static_cast<cass_int16_t>((bytes[0] << 8) | bytes[1]);
+  }
+};
+
+template <>
+struct DecodeTraits<cass_int32_t> : public FixedSizeDecodeTraits<cass_int32_t, 4> {
+  static bool is_valid(CassValueType type) { return type == CASS_VALUE_TYPE_INT; }
+  static cass_int32_t decode_fixed(const char* data) { return decoding::decode_int32(data); }
+};
+
+template <>
+struct DecodeTraits<cass_uint32_t> : public FixedSizeDecodeTraits<cass_uint32_t, 4> {
+  static bool is_valid(CassValueType type) { return type == CASS_VALUE_TYPE_DATE; }
+  static cass_uint32_t decode_fixed(const char* data) {
+    return static_cast<cass_uint32_t>(decoding::decode_int32(data));
+  }
+};
+
+template <>
+struct DecodeTraits<cass_int64_t> : public FixedSizeDecodeTraits<cass_int64_t, 8> {
+  static bool is_valid(CassValueType type) {
+    return type == CASS_VALUE_TYPE_BIGINT || type == CASS_VALUE_TYPE_COUNTER ||
+           type == CASS_VALUE_TYPE_TIMESTAMP || type == CASS_VALUE_TYPE_TIME;
+  }
+  static cass_int64_t decode_fixed(const char* data) { return decoding::decode_int64(data); }
+};
+
+template <>
+struct DecodeTraits<cass_float_t> : public FixedSizeDecodeTraits<cass_float_t, 4> {
+  static bool is_valid(CassValueType type) { return type == CASS_VALUE_TYPE_FLOAT; }
+  static cass_float_t decode_fixed(const char* data) {
+    cass_int32_t bits = decoding::decode_int32(data);
+    cass_float_t value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+};
+
+template <>
+struct DecodeTraits<cass_double_t> : public FixedSizeDecodeTraits<cass_double_t, 8> {
+  static bool is_valid(CassValueType type) { return type == CASS_VALUE_TYPE_DOUBLE; }
+  static cass_double_t decode_fixed(const char* data) {
+    cass_int64_t bits = decoding::decode_int64(data);
+    cass_double_t value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+};
+
+template <>
+struct DecodeTraits<cass_bool_t> : public FixedSizeDecodeTraits<cass_bool_t, 1> {
+  static bool is_valid(CassValueType type) { return type == CASS_VALUE_TYPE_BOOLEAN; }
+  static cass_bool_t decode_fixed(const char* data) {
+    return data[0] != 0 ? cass_true : cass_false;
+  }
+};
+
+template <>
+struct DecodeTraits<CassUuid> : public FixedSizeDecodeTraits<CassUuid, 16> {
+  static bool is_valid(CassValueType type) {
+    return type == CASS_VALUE_TYPE_UUID || type == CASS_VALUE_TYPE_TIMEUUID;
+  }
+  static CassUuid decode_fixed(const char* data) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+    // The time fields are stored in the order time_low, time_mid and
+    // time_hi_and_version
+    CassUuid value;
+    value.time_and_version = static_cast<cass_uint32_t>(decoding::decode_int32(data));
+    value.time_and_version |= static_cast<cass_uint64_t>(bytes[4]) << 40;
+    value.time_and_version |= static_cast<cass_uint64_t>(bytes[5]) << 32;
+    value.time_and_version |= static_cast<cass_uint64_t>(bytes[6]) << 56;
+    value.time_and_version |= static_cast<cass_uint64_t>(bytes[7]) << 48;
+    value.clock_seq_and_node = static_cast<cass_uint64_t>(decoding::decode_int64(data + 8));
+    return value;
+  }
+};
+
+template <>
+struct DecodeTraits<CassInet> {
+  static bool is_valid(CassValueType type) { return type == CASS_VALUE_TYPE_INET; }
+  static bool decode(const char* data, size_t size, CassInet* output) {
+    if (size != CASS_INET_V4_LENGTH && size != CASS_INET_V6_LENGTH) return false;
+    memcpy(output->address, data, size);
+    output->address_length = static_cast<cass_uint8_t>(size);
+    return true;
+  }
+};
+
+template <>
+struct DecodeTraits<std::string> {
+  // "bytes" types can also be decoded as strings, like cass_value_get_string()
+  static bool is_valid(CassValueType type) {
+    return decoding::is_string_type(type) || decoding::is_bytes_type(type);
+  }
+  static bool decode(const char* data, size_t size, std::string* output) {
+    output->assign(data, size);
+    return true;
+  }
+};
+
+template <>
+struct DecodeTraits<std::vector<cass_byte_t> > {
+  static bool is_valid(CassValueType type) { return decoding::is_bytes_type(type); }
+  static bool decode(const char* data, size_t size, std::vector<cass_byte_t>* output) {
+    const cass_byte_t* bytes = reinterpret_cast<const cass_byte_t*>(data);
+    output->assign(bytes, bytes + size);
+    return true;
+  }
+};
+
+#if __cplusplus >= 201703L
+template <>
+struct DecodeTraits<std::string_view> {
+  static bool is_valid(CassValueType type) { return DecodeTraits<std::string>::is_valid(type); }
+  static bool decode(const char* data, size_t size, std::string_view* output) {
+    *output = std::string_view(data, size);
+    return true;
+  }
+};
+#endif
+
+namespace decoding {
+
+/**
+ * Decodes the values of a row, starting at the column `Index`, into a tuple.
+ */
+template <size_t Index, size_t Count, class Tuple>
+struct TupleDecoder {
+  static bool decode(const char** pos, const char* end, Tuple* row) {
+    typedef typename std::tuple_element<Index, Tuple>::type Type;
+    if (end - *pos < 4) return false;
+    cass_int32_t size = decode_int32(*pos);
+    *pos += 4;
+    Type& output = std::get<Index>(*row);
+    if (size < 0) {
+      output = Type();
+    } else {
+      if (end - *pos < size) return false;
+      if (!DecodeTraits<Type>::decode(*pos, static_cast<size_t>(size), &output)) return false;
+      *pos += size;
+    }
+    return TupleDecoder<Index + 1, Count, Tuple>::decode(pos, end, row);
+  }
+};
+
+template <size_t Count, class Tuple>
+struct TupleDecoder<Count, Count, Tuple> {
+  static bool decode(const char**, const char*, Tuple*) { return true; }
+};
+
+} // namespace decoding
+
+/**
+ * Decodes the rows of a result whose columns have fixed C++ types. The types
+ * are checked against the result's metadata once, when the decoder is
+ * constructed, then each call to next() decodes a row in one pass over its
+ * bytes.
+ *
+ * @tparam Types The C++ types of the result's columns, in order. There must
+ * be a type for each column.
+ */
+template <class... Types>
+class RowDecoder {
+public:
+  typedef std::tuple<Types...> Row;
+
+  /**
+   * Constructor.
+   *
+   * @param[in] result The result. It must outlive the decoder.
+   */
+  explicit RowDecoder(const CassResult* result)
+      : pos_(NULL)
+      , end_(NULL)
+      , remaining_(0)
+      , error_code_(check(result)) {
+    const cass_byte_t* rows = NULL;
+    size_t rows_size = 0;
+    if (error_code_ == CASS_OK) {
+      error_code_ = cass_result_encoded_rows(result, &rows, &rows_size);
+    }
+    if (error_code_ == CASS_OK) {
+      pos_ = reinterpret_cast<const char*>(rows);
+      end_ = pos_ + rows_size;
+      remaining_ = cass_result_row_count(result);
+    }
+  }
+
+  /**
+   * Get the result of checking the types against the result's columns or of
+   * decoding the rows.
+   *
+   * @return CASS_OK if successful, CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS if the
+   * number of types doesn't match the number of columns,
+   * CASS_ERROR_LIB_INVALID_VALUE_TYPE if a column can't be decoded into its
+   * type or CASS_ERROR_LIB_INVALID_DATA if a row couldn't be decoded.
+   */
+  CassError error_code() const { return error_code_; }
+
+  /**
+   * Get the number of rows that haven't been decoded yet.
+   *
+   * @return The number of rows.
+   */
+  size_t remaining() const { return remaining_; }
+
+  /**
+   * Decode the next row.
+   *
+   * @param[out] row
+   * @return true if a row was decoded, false if there are no more rows or an
+   * error occurred. The row is partially modified if an error occurred.
+   */
+  bool next(Row* row) {
+    if (remaining_ == 0) return false;
+    if (!decoding::TupleDecoder<0, sizeof...(Types), Row>::decode(&pos_, end_, row)) {
+      error_code_ = CASS_ERROR_LIB_INVALID_DATA;
+      remaining_ = 0;
+      return false;
+    }
+    --remaining_;
+    return true;
+  }
+
+private:
+  static CassError check(const CassResult* result) {
+    typedef bool (*IsValidFunc)(CassValueType);
+    static const IsValidFunc is_valid[] = { NULL, &DecodeTraits<Types>::is_valid... };
+    const size_t count = sizeof(is_valid) / sizeof(is_valid[0]) - 1;
+
+    if (cass_result_column_count(result) != count) {
+      return CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      if (!is_valid[i + 1](cass_result_column_type(result, i))) {
+        return CASS_ERROR_LIB_INVALID_VALUE_TYPE;
+      }
+    }
+    return CASS_OK;
+  }
+
+private:
+  const char* pos_;
+  const char* end_;
+  size_t remaining_;
+  CassError error_code_;
+};
+
+} // namespace cass
+
+#endif
@@ -954,6 +954,32 @@ DSE_EXPORT CassError
 cass_value_get_dse_date_range(const CassValue* value,
                               DseDateRange* range);
 
+/**
+ * Decodes all the values of a date-range column into a contiguous buffer.
+ * The column's type is only checked once so this is faster than getting
+ * each row's value using cass_value_get_dse_date_range() for large results.
+ *
+ * @public @memberof CassResult
+ *
+ * @param[in] result
+ * @param[in] index The column index.
+ * @param[out] output A buffer with room for cass_result_row_count() ranges.
+ * Null values are decoded as ranges with unbounded lower and upper bounds.
+ * @param[out] validity An optional bitmap of (cass_result_row_count() + 7) / 8
+ * bytes. The bit for each row, starting at the least significant bit of the
+ * first byte, is set if the row's value isn't null. This can be NULL.
+ * @param[in] output_size The number of ranges the output buffer can hold.
+ * @return CASS_OK if successful, otherwise error occurred
+ *
+ * @see cass_value_get_dse_date_range()
+ */
+DSE_EXPORT CassError
+cass_result_column_get_dse_date_range(const CassResult* result,
+                                      size_t index,
+                                      DseDateRange* output,
+                                      cass_uint8_t* validity,
+                                      size_t output_size);
+
 /**
  * Gets a point for the specified value.
  *
@@ -968,6 +994,67 @@ DSE_EXPORT CassError
 cass_value_get_dse_point(const CassValue* value,
                          cass_double_t* x, cass_double_t* y);
 
+/**
+ * Gets all the points of a line string for the specified value. The
+ * coordinates are decoded directly from the result into an array of
+ * interleaved coordinates: x0, y0, x1, y1, ...
+ *
+ * <b>Note:</b> The number of points is returned even if the array is too
+ * small so that it can be used to size the array.
+ *
+ * @public @memberof CassValue
+ *
+ * @param[in] value
+ * @param[out] points An array of 2 * points_size coordinates. It can be NULL
+ * if points_size is 0.
+ * @param[in] points_size The maximum number of points the array can hold.
+ * @param[out] num_points The number of points in the line string.
+ * @return CASS_OK if successful, CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS if the
+ * array is too small, otherwise error occurred
+ *
+ * @see dse_line_string_iterator_next_points()
+ */
+DSE_EXPORT CassError
+cass_value_get_dse_line_string(const CassValue* value,
+                               cass_double_t* points,
+                               size_t points_size,
+                               cass_uint32_t* num_points);
+
+/**
+ * Gets all the points of a polygon for the specified value. The
+ * coordinates of all the rings are decoded directly from the result into an
+ * array of interleaved coordinates: x0, y0, x1, y1, ... and the number of
+ * points in each ring into a second array.
+ *
+ * <b>Note:</b> The number of rings and the total number of points are
+ * returned even if the arrays are too small so that they can be used to
+ * size the arrays.
+ *
+ * @public @memberof CassValue
+ *
+ * @param[in] value
+ * @param[out] points An array of 2 * points_size coordinates. It can be NULL
+ * if points_size is 0.
+ * @param[in] points_size The maximum number of points the array can hold.
+ * @param[out] ring_num_points An array of the number of points in each
+ * ring. It can be NULL if rings_size is 0.
+ * @param[in] rings_size The maximum number of rings the array can hold.
+ * @param[out] num_rings The number of rings in the polygon.
+ * @param[out] num_points The total number of points in all the rings.
+ * @return CASS_OK if successful, CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS if an
+ * array is too small, otherwise error occurred
+ *
+ * @see dse_polygon_iterator_next_points()
+ */
+DSE_EXPORT CassError
+cass_value_get_dse_polygon(const CassValue* value,
+                           cass_double_t* points,
+                           size_t points_size,
+                           cass_uint32_t* ring_num_points,
+                           size_t rings_size,
+                           cass_uint32_t* num_rings,
+                           cass_uint32_t* num_points);
+
 /***********************************************************************************
  *
  * Point
@@ -1062,6 +1149,25 @@ DSE_EXPORT CassError
 dse_line_string_add_point(DseLineString* line_string,
                           cass_double_t x, cass_double_t y);
 
+/**
+ * Adds an array of points to the line string. The coordinates are
+ * interleaved: x0, y0, x1, y1, ... This is faster than adding the points
+ * one at a time.
+ *
+ * @public @memberof DseLineString
+ *
+ * @param[in] line_string
+ * @param[in] points An array of 2 * num_points coordinates.
+ * @param[in] num_points
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see dse_line_string_add_point()
+ */
+DSE_EXPORT CassError
+dse_line_string_add_points(DseLineString* line_string,
+                           const cass_double_t* points,
+                           size_t num_points);
+
 /**
  * Finishes the contruction of a line string.
  *
@@ -1175,6 +1281,26 @@ DSE_EXPORT CassError
 dse_line_string_iterator_next_point(DseLineStringIterator* iterator,
                                     cass_double_t* x, cass_double_t* y);
 
+/**
+ * Gets the next points in the line string. The coordinates are
+ * interleaved: x0, y0, x1, y1, ... This is faster than getting the points
+ * one at a time.
+ *
+ * @public @memberof DseLineStringIterator
+ *
+ * @param[in] iterator
+ * @param[out] points An array of at least 2 * num_points coordinates.
+ * @param[in] num_points
+ * @return CASS_OK if successful, otherwise an error occurred. An error is
+ * returned if fewer than num_points points remain.
+ *
+ * @see dse_line_string_iterator_next_point()
+ */
+DSE_EXPORT CassError
+dse_line_string_iterator_next_points(DseLineStringIterator* iterator,
+                                     cass_double_t* points,
+                                     size_t num_points);
+
 /***********************************************************************************
  *
  * Polygon
@@ -1255,6 +1381,25 @@ DSE_EXPORT CassError
 dse_polygon_add_point(DsePolygon* polygon,
                       cass_double_t x, cass_double_t y);
 
+/**
+ * Adds an array of points to the current ring. The coordinates are
+ * interleaved: x0, y0, x1, y1, ... This is faster than adding the points
+ * one at a time.
+ *
+ * @public @memberof DsePolygon
+ *
+ * @param[in] polygon
+ * @param[in] points An array of 2 * num_points coordinates.
+ * @param[in] num_points
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see dse_polygon_add_point()
+ */
+DSE_EXPORT CassError
+dse_polygon_add_points(DsePolygon* polygon,
+                       const cass_double_t* points,
+                       size_t num_points);
+
 /**
  * Finishes the contruction of a polygon.
  *
@@ -1354,6 +1499,17 @@ dse_polygon_iterator_reset_with_wkt_n(DsePolygonIterator* iterator,
 DSE_EXPORT cass_uint32_t
 dse_polygon_iterator_num_rings(const DsePolygonIterator* iterator);
 
+/**
+ * Gets the total number of points in all the rings of the polygon.
+ *
+ * @public @memberof DsePolygonIterator
+ *
+ * @param[in] iterator
+ * @return The number of points in the polygon.
+ */
+DSE_EXPORT cass_uint32_t
+dse_polygon_iterator_num_points(const DsePolygonIterator* iterator);
+
 /**
  * Gets the number of points for the current ring.
  *
@@ -1381,6 +1537,189 @@ DSE_EXPORT CassError
 dse_polygon_iterator_next_point(DsePolygonIterator* iterator,
                                 cass_double_t* x, cass_double_t* y);
 
+/**
+ * Gets the next points in the current ring. The coordinates are
+ * interleaved: x0, y0, x1, y1, ... This is faster than getting the points
+ * one at a time.
+ *
+ * @public @memberof DsePolygonIterator
+ *
+ * @param[in] iterator
+ * @param[out] points An array of at least 2 * num_points coordinates.
+ * @param[in] num_points
+ * @return CASS_OK if successful, otherwise an error occurred. An error is
+ * returned if fewer than num_points points remain in the current ring.
+ *
+ * @see dse_polygon_iterator_next_point()
+ */
+DSE_EXPORT CassError
+dse_polygon_iterator_next_points(DsePolygonIterator* iterator,
+                                 cass_double_t* points,
+                                 size_t num_points);
+
+/***********************************************************************************
+ *
+ * Continuous Paging
+ *
+ ***********************************************************************************/
+
+/**
+ * A DSE continuous paging request. The coordinator streams the pages of the
+ * request's result without a request for each page and the pages are queued
+ * until they're taken using dse_continuous_paging_next_page().
+ *
+ * With DSE protocol v2 (CASS_PROTOCOL_VERSION_DSEV2) the coordinator only
+ * sends as many pages as it has credits for. It starts with the maximum
+ * number of enqueued pages and more credits are granted as the pages are
+ * taken, so the coordinator is throttled by the application. DSE protocol v1
+ * only supports throttling the pages per second.
+ *
+ * @struct DseContinuousPaging
+ */
+typedef struct DseContinuousPaging_ DseContinuousPaging;
+
+/**
+ * Creates a new continuous paging request.
+ *
+ * @public @memberof DseContinuousPaging
+ *
+ * @return Returns a continuous paging request that must be freed.
+ *
+ * @see dse_continuous_paging_free()
+ */
+DSE_EXPORT DseContinuousPaging*
+dse_continuous_paging_new();
+
+/**
+ * Frees a continuous paging request. A running request is canceled.
+ *
+ * @public @memberof DseContinuousPaging
+ *
+ * @param[in] paging
+ */
+DSE_EXPORT void
+dse_continuous_paging_free(DseContinuousPaging* paging);
+
+/**
+ * Sets the maximum number of pages of the request.
+ *
+ * <b>Default:</b> 0 (no limit)
+ *
+ * @public @memberof DseContinuousPaging
+ *
+ * @param[in] paging
+ * @param[in] max_pages
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+DSE_EXPORT CassError
+dse_continuous_paging_set_max_pages(DseContinuousPaging* paging,
+                                    cass_int32_t max_pages);
+
+/**
+ * Sets the maximum number of pages the coordinator sends per second.
+ *
+ * <b>Default:</b> 0 (no limit)
+ *
+ * @public @memberof DseContinuousPaging
+ *
+ * @param[in] paging
+ * @param[in] pages_per_second
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+DSE_EXPORT CassError
+dse_continuous_paging_set_pages_per_second(DseContinuousPaging* paging,
+                                           cass_int32_t pages_per_second);
+
+/**
+ * Sets the maximum number of pages that are sent by the coordinator but not
+ * taken yet. This is the coordinator's initial page credits and it requires
+ * DSE protocol v2.
+ *
+ * <b>Default:</b> 0 (no limit)
+ *
+ * @public @memberof DseContinuousPaging
+ *
+ * @param[in] paging
+ * @param[in] max_enqueued_pages
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+DSE_EXPORT CassError
+dse_continuous_paging_set_max_enqueued_pages(DseContinuousPaging* paging,
+                                             cass_int32_t max_enqueued_pages);
+
+/**
+ * Executes a statement using continuous paging. The statement's page size is
+ * the number of rows of each page. A continuous paging request can only be
+ * executed once.
+ *
+ * The request's timeout only applies to the first page. A continuous paging
+ * request isn't retried or speculatively executed once a page has been
+ * received.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] statement
+ * @param[in] paging
+ * @return CASS_OK if the request was started, otherwise an error occurred.
+ *
+ * @see dse_continuous_paging_next_page()
+ */
+DSE_EXPORT CassError
+cass_session_execute_dse_continuous_paging(CassSession* session,
+                                           const CassStatement* statement,
+                                           DseContinuousPaging* paging);
+
+/**
+ * Takes the next page, waiting for it if it hasn't been received yet.
+ *
+ * @public @memberof DseContinuousPaging
+ *
+ * @param[in] paging
+ * @return The next page that must be freed using cass_result_free() or NULL
+ * if there are no more pages, the request failed or it was canceled.
+ *
+ * @see dse_continuous_paging_error_code()
+ */
+DSE_EXPORT const CassResult*
+dse_continuous_paging_next_page(DseContinuousPaging* paging);
+
+/**
+ * Cancels the request. The coordinator stops sending pages and the pages that
+ * haven't been taken are dropped.
+ *
+ * @public @memberof DseContinuousPaging
+ *
+ * @param[in] paging
+ */
+DSE_EXPORT void
+dse_continuous_paging_cancel(DseContinuousPaging* paging);
+
+/**
+ * Gets the error of a failed request.
+ *
+ * @public @memberof DseContinuousPaging
+ *
+ * @param[in] paging
+ * @return CASS_OK if the request hasn't failed, otherwise its error.
+ */
+DSE_EXPORT CassError
+dse_continuous_paging_error_code(const DseContinuousPaging* paging);
+
+/**
+ * Gets the error message of a failed request.
+ *
+ * @public @memberof DseContinuousPaging
+ *
+ * @param[in] paging
+ * @param[out] message Empty if the request hasn't failed.
+ * @param[out] message_length
+ */
+DSE_EXPORT void
+dse_continuous_paging_error_message(const DseContinuousPaging* paging,
+                                    const char** message,
+                                    size_t* message_length);
+
 /***********************************************************************************
  *
  * GSSAPI Authentication
@@ -17,13 +17,67 @@
 #include "abstract_data.hpp"
 
 #include "collection.hpp"
+#include "column_handle.hpp"
 #include "constants.hpp"
 #include "request.hpp"
+#include "struct_encoder.hpp"
 #include "tuple.hpp"
 #include "user_type_value.hpp"
 
 using namespace datastax::internal::core;
 
+const IndexVec* AbstractData::get_handle_indices(const ColumnHandle& handle, IndexVec* indices) {
+  return get_indices(StringRef(handle.name()), indices) > 0 ? indices : NULL;
+}
+
+CassError AbstractData::set(size_t index, CassBytesRef value) {
+  CASS_CHECK_INDEX_AND_TYPE(index, value);
+  elements_[index] = Element(value.buffer);
+  return CASS_OK;
+}
+
+CassError AbstractData::set(size_t index, CassStringRef value) {
+  CASS_CHECK_INDEX_AND_TYPE(index, value);
+  elements_[index] = Element(value.buffer);
+  return CASS_OK;
+}
+
+CassError AbstractData::set_encoded_values(const char* values, size_t size) {
+  const char* pos = values;
+  const char* end = values + size;
+  size_t index = 0;
+  while (pos < end) {
+    if (index >= elements_.size()) {
+      return CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS;
+    }
+    const char* start = pos;
+    int32_t length = 0;
+    if (end - pos < static_cast<ptrdiff_t>(sizeof(int32_t))) {
+      return CASS_ERROR_LIB_BAD_PARAMS;
+    }
+    pos = decode_int32(pos, length);
+    if (length >= 0) {
+      if (end - pos < length) {
+        return CASS_ERROR_LIB_BAD_PARAMS;
+      }
+      pos += length;
+      elements_[index] = Buffer(start, pos - start);
+    } else if (length == -1) {
+      elements_[index] = Element(CassNull());
+    } else {
+      elements_[index] = Element();
+    }
+    ++index;
+  }
+  return CASS_OK;
+}
+
+CassError AbstractData::set(size_t index, CassStruct value) {
+  CASS_CHECK_INDEX_AND_TYPE(index, value);
+  elements_[index] = value.encoder->encode_with_length(value.data);
+  return CASS_OK;
+}
+
 CassError AbstractData::set(size_t index, CassNull value) {
   CASS_CHECK_INDEX_AND_TYPE(index, value);
   elements_[index] = Element(value);
@@ -32,7 +86,7 @@ CassError AbstractData::set(size_t index, CassNull value) {
 
 CassError AbstractData::set(size_t index, const Collection* value) {
   CASS_CHECK_INDEX_AND_TYPE(index, value);
-  if (value->type() == CASS_COLLECTION_TYPE_MAP && value->items().size() % 2 != 0) {
+  if (value->type() == CASS_COLLECTION_TYPE_MAP && value->item_count() % 2 != 0) {
     return CASS_ERROR_LIB_INVALID_ITEM_COUNT;
   }
   elements_[index] = value;
@@ -89,9 +143,18 @@ void AbstractData::encode_buffers(size_t pos, Buffer* buf) const {
   }
 }
 
+AbstractData::Element::Element(ExternalBuffer* external)
+    : type_(EXTERNAL)
+    , buf_(sizeof(int32_t))
+    , external_(external) {
+  buf_.encode_int32(0, external->size());
+}
+
 size_t AbstractData::Element::get_size() const {
   if (type_ == COLLECTION) {
     return collection_->get_size_with_length();
+  } else if (type_ == EXTERNAL) {
+    return buf_.size() + external_->size();
   } else {
     assert(type_ == BUFFER || type_ == NUL);
     return buf_.size();
@@ -100,8 +163,10 @@ size_t AbstractData::Element::get_size() const {
 
 size_t AbstractData::Element::copy_buffer(size_t pos, Buffer* buf) const {
   if (type_ == COLLECTION) {
-    Buffer encoded(collection_->encode_with_length());
-    return buf->copy(pos, encoded.data(), encoded.size());
+    return collection_->copy_with_length(pos, buf);
+  } else if (type_ == EXTERNAL) {
+    pos = buf->copy(pos, buf_.data(), buf_.size());
+    return buf->copy(pos, external_->data(), external_->size());
   } else {
     assert(type_ == BUFFER || type_ == NUL);
     return buf->copy(pos, buf_.data(), buf_.size());
@@ -111,8 +176,22 @@ size_t AbstractData::Element::copy_buffer(size_t pos, Buffer* buf) const {
 Buffer AbstractData::Element::get_buffer() const {
   if (type_ == COLLECTION) {
     return collection_->encode_with_length();
+  } else if (type_ == EXTERNAL) {
+    Buffer buf(get_size());
+    copy_buffer(0, &buf);
+    return buf;
   } else {
     assert(type_ == BUFFER || type_ == NUL);
     return buf_;
   }
 }
+
+size_t AbstractData::Element::append_buffers(BufferVec* bufs) const {
+  if (type_ == EXTERNAL) {
+    bufs->push_back(buf_);
+    bufs->push_back(Buffer(external_.get()));
+    return get_size();
+  }
+  bufs->push_back(get_buffer());
+  return bufs->back().size();
+}
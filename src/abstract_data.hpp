@@ -36,6 +36,7 @@
 
 namespace datastax { namespace internal { namespace core {
 
+class ColumnHandle;
 class Tuple;
 class UserTypeValue;
 
@@ -43,7 +44,7 @@ class AbstractData : public Allocated {
 public:
   class Element {
   public:
-    enum Type { UNSET, NUL, BUFFER, COLLECTION };
+    enum Type { UNSET, NUL, BUFFER, COLLECTION, EXTERNAL };
 
     Element()
         : type_(UNSET) {}
@@ -60,6 +61,9 @@ public:
         : type_(COLLECTION)
         , collection_(collection) {}
 
+    // The value's length is encoded and its data is referenced
+    Element(ExternalBuffer* external);
+
     bool is_unset() const { return type_ == UNSET || (type_ == BUFFER && buf_.size() == 0); }
 
     bool is_null() const { return type_ == NUL; }
@@ -68,10 +72,20 @@ public:
     size_t copy_buffer(size_t pos, Buffer* buf) const;
     Buffer get_buffer() const;
 
+    /**
+     * Append the encoded value to a request's buffers. An external value is
+     * appended without copying it.
+     *
+     * @param bufs
+     * @return The number of bytes appended.
+     */
+    size_t append_buffers(BufferVec* bufs) const;
+
   private:
     Type type_;
     Buffer buf_;
     SharedRefPtr<const Collection> collection_;
+    ExternalBuffer::Ptr external_;
   };
 
   typedef Vector<Element> ElementVec;
@@ -89,6 +103,8 @@ public:
     elements_.resize(count);
   }
 
+  void set_elements(const ElementVec& elements) { elements_ = elements; }
+
 #define SET_TYPE(Type)                                  \
   CassError set(size_t index, const Type value) {       \
     CASS_CHECK_INDEX_AND_TYPE(index, value);            \
@@ -115,10 +131,25 @@ public:
 #undef SET_TYPE
 
   CassError set(size_t index, CassNull value);
+  CassError set(size_t index, CassBytesRef value);
+  CassError set(size_t index, CassStringRef value);
+  CassError set(size_t index, CassStruct value);
   CassError set(size_t index, const Collection* value);
   CassError set(size_t index, const Tuple* value);
   CassError set(size_t index, const UserTypeValue* value);
 
+  /**
+   * Set the values from a buffer of values that are already encoded in the
+   * native protocol's format, each prefixed by its length (-1 for null, -2 for
+   * unset). The values aren't checked against the types of the elements; the
+   * caller is expected to have checked them.
+   *
+   * @param values The encoded values, starting at the first element.
+   * @param size The size of the encoded values in bytes.
+   * @return CASS_OK if successful, otherwise an error occurred.
+   */
+  CassError set_encoded_values(const char* values, size_t size);
+
   template <class T>
   CassError set(StringRef name, const T value) {
     IndexVec indices;
@@ -136,11 +167,34 @@ public:
     return CASS_OK;
   }
 
+  template <class T>
+  CassError set(const ColumnHandle* handle, const T value) {
+    IndexVec temp;
+    const IndexVec* indices = get_handle_indices(*handle, &temp);
+
+    if (indices == NULL) {
+      return CASS_ERROR_LIB_NAME_DOES_NOT_EXIST;
+    }
+
+    for (IndexVec::const_iterator it = indices->begin(), end = indices->end(); it != end; ++it) {
+      size_t index = *it;
+      CassError rc = set(index, value);
+      if (rc != CASS_OK) return rc;
+    }
+
+    return CASS_OK;
+  }
+
   Buffer encode() const;
   Buffer encode_with_length() const;
 
 protected:
+  // The encoded size of the values, including their lengths
+  size_t get_buffers_size() const;
+
   virtual size_t get_indices(StringRef name, IndexVec* indices) = 0;
+  // Data without result metadata looks up the handle's name
+  virtual const IndexVec* get_handle_indices(const ColumnHandle& handle, IndexVec* indices);
   virtual const DataType::ConstPtr& get_type(size_t index) const = 0;
 
 private:
@@ -157,7 +211,6 @@ private:
     return CASS_OK;
   }
 
-  size_t get_buffers_size() const;
   void encode_buffers(size_t pos, Buffer* buf) const;
 
 private:
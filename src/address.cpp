@@ -21,6 +21,8 @@
 #include "row.hpp"
 #include "value.hpp"
 
+#include <string.h>
+
 using namespace datastax;
 using namespace datastax::internal::core;
 
@@ -39,13 +41,17 @@ inline void hash_combine(std::size_t& seed, const T& v) {
 
 Address::Address()
     : family_(UNRESOLVED)
-    , port_(0) {}
+    , port_(0) {
+  init(NULL, 0);
+}
 
 Address::Address(const Address& other, const String& server_name)
-    : hostname_or_address_(other.hostname_or_address_)
+    : hostname_(other.hostname_)
     , server_name_(server_name)
     , family_(other.family_)
-    , port_(other.port_) {}
+    , port_(other.port_) {
+  init(other.address_, other.address_length());
+}
 
 Address::Address(const String& hostname, int port, const String& server_name)
     : server_name_(server_name)
@@ -53,13 +59,14 @@ Address::Address(const String& hostname, int port, const String& server_name)
     , port_(port) {
   char addr[16];
   if (uv_inet_pton(AF_INET, hostname.c_str(), addr) == 0) {
-    hostname_or_address_.assign(addr, addr + 4);
     family_ = IPv4;
+    init(addr, 4);
   } else if (uv_inet_pton(AF_INET6, hostname.c_str(), addr) == 0) {
-    hostname_or_address_.assign(addr, addr + 16);
     family_ = IPv6;
+    init(addr, 16);
   } else {
-    hostname_or_address_ = hostname;
+    hostname_ = hostname;
+    init(NULL, 0);
   }
 }
 
@@ -67,11 +74,13 @@ Address::Address(const uint8_t* address, uint8_t address_length, int port)
     : family_(UNRESOLVED)
     , port_(port) {
   if (address_length == 4) {
-    hostname_or_address_.assign(reinterpret_cast<const char*>(address), address_length);
     family_ = IPv4;
+    init(reinterpret_cast<const char*>(address), address_length);
   } else if (address_length == 16) {
-    hostname_or_address_.assign(reinterpret_cast<const char*>(address), address_length);
     family_ = IPv6;
+    init(reinterpret_cast<const char*>(address), address_length);
+  } else {
+    init(NULL, 0);
   }
 }
 
@@ -80,81 +89,109 @@ Address::Address(const struct sockaddr* addr)
     , port_(0) {
   if (addr->sa_family == AF_INET) {
     const struct sockaddr_in* addr_in = reinterpret_cast<const struct sockaddr_in*>(addr);
-    hostname_or_address_.assign(reinterpret_cast<const char*>(&addr_in->sin_addr), 4);
     port_ = ntohs(addr_in->sin_port);
     family_ = IPv4;
+    init(reinterpret_cast<const char*>(&addr_in->sin_addr), 4);
   } else if (addr->sa_family == AF_INET6) {
     const struct sockaddr_in6* addr_in6 = reinterpret_cast<const struct sockaddr_in6*>(addr);
-    hostname_or_address_.assign(reinterpret_cast<const char*>(&addr_in6->sin6_addr), 16);
     port_ = ntohs(addr_in6->sin6_port);
     family_ = IPv6;
+    init(reinterpret_cast<const char*>(&addr_in6->sin6_addr), 16);
+  } else {
+    init(NULL, 0);
+  }
+}
+
+void Address::init(const char* address, size_t address_length) {
+  memset(address_, 0, sizeof(address_));
+  if (address_length > 0) {
+    memcpy(address_, address, address_length);
   }
+  hash_ = compute_hash();
 }
 
 bool Address::equals(const Address& other, bool with_port) const {
+  if (with_port && (hash_ != other.hash_ || port_ != other.port_)) return false;
   if (family_ != other.family_) return false;
-  if (with_port && port_ != other.port_) return false;
-  if (server_name_ != other.server_name_) return false;
-  if (hostname_or_address_ != other.hostname_or_address_) return false;
-  return true;
+  if (family_ == UNRESOLVED) {
+    if (hostname_ != other.hostname_) return false;
+  } else if (memcmp(address_, other.address_, address_length()) != 0) {
+    return false;
+  }
+  return server_name_ == other.server_name_;
 }
 
 bool Address::operator<(const Address& other) const {
   if (family_ != other.family_) return family_ < other.family_;
   if (port_ != other.port_) return port_ < other.port_;
   if (server_name_ != other.server_name_) return server_name_ < other.server_name_;
-  return hostname_or_address_ < other.hostname_or_address_;
+  if (family_ == UNRESOLVED) return hostname_ < other.hostname_;
+  return memcmp(address_, other.address_, address_length()) < 0;
 }
 
 String Address::hostname_or_address() const {
   if (family_ == IPv4) {
     char name[INET_ADDRSTRLEN + 1] = { '\0' };
-    uv_inet_ntop(AF_INET, hostname_or_address_.data(), name, INET_ADDRSTRLEN);
+    uv_inet_ntop(AF_INET, address_, name, INET_ADDRSTRLEN);
     return name;
   } else if (family_ == IPv6) {
     char name[INET6_ADDRSTRLEN + 1] = { '\0' };
-    uv_inet_ntop(AF_INET6, hostname_or_address_.data(), name, INET6_ADDRSTRLEN);
+    uv_inet_ntop(AF_INET6, address_, name, INET6_ADDRSTRLEN);
     return name;
   } else {
-    return hostname_or_address_;
+    return hostname_;
   }
 }
 
-size_t Address::hash_code() const {
+size_t Address::compute_hash() const {
   SPARSEHASH_HASH<Family> hasher;
   size_t code = hasher(family_);
   hash_combine(code, port_);
-  hash_combine(code, server_name_);
-  hash_combine(code, hostname_or_address_);
+  if (!server_name_.empty()) {
+    hash_combine(code, server_name_);
+  }
+  if (family_ == UNRESOLVED) {
+    hash_combine(code, hostname_);
+  } else {
+    for (size_t i = 0, length = address_length(); i < length; i += sizeof(uint32_t)) {
+      uint32_t word;
+      memcpy(&word, address_ + i, sizeof(word));
+      hash_combine(code, word);
+    }
+  }
   return code;
 }
 
 uint8_t Address::to_inet(void* address) const {
-  if (family_ == IPv4 || family_ == IPv6) {
-    size_t size = hostname_or_address_.size();
-    assert((size == 4 || size == 16) && "Invalid size for address");
-    hostname_or_address_.copy(reinterpret_cast<char*>(address), size);
-    return static_cast<uint8_t>(size);
+  size_t size = address_length();
+  if (size > 0) {
+    memcpy(address, address_, size);
   }
-  return 0;
+  return static_cast<uint8_t>(size);
 }
 
 const struct sockaddr* Address::to_sockaddr(SocketStorage* storage) const {
-  int rc = 0;
   if (family_ == IPv4) {
-    char name[INET_ADDRSTRLEN + 1] = { '\0' };
-    rc = uv_inet_ntop(AF_INET, hostname_or_address_.data(), name, INET_ADDRSTRLEN);
-    if (rc != 0) return NULL;
-    rc = uv_ip4_addr(name, port_, storage->addr_in());
+    struct sockaddr_in* addr_in = storage->addr_in();
+    memset(addr_in, 0, sizeof(*addr_in));
+    addr_in->sin_family = AF_INET;
+    addr_in->sin_port = htons(static_cast<uint16_t>(port_));
+    memcpy(&addr_in->sin_addr, address_, 4);
+#ifdef SIN6_LEN
+    addr_in->sin_len = sizeof(*addr_in);
+#endif
   } else if (family_ == IPv6) {
-    char name[INET6_ADDRSTRLEN + 1] = { '\0' };
-    rc = uv_inet_ntop(AF_INET6, hostname_or_address_.data(), name, INET6_ADDRSTRLEN);
-    if (rc != 0) return NULL;
-    rc = uv_ip6_addr(name, port_, storage->addr_in6());
+    struct sockaddr_in6* addr_in6 = storage->addr_in6();
+    memset(addr_in6, 0, sizeof(*addr_in6));
+    addr_in6->sin6_family = AF_INET6;
+    addr_in6->sin6_port = htons(static_cast<uint16_t>(port_));
+    memcpy(&addr_in6->sin6_addr, address_, 16);
+#ifdef SIN6_LEN
+    addr_in6->sin6_len = sizeof(*addr_in6);
+#endif
   } else {
     return NULL;
   }
-  if (rc != 0) return NULL;
   return storage->addr();
 }
 
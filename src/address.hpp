@@ -75,6 +75,8 @@ public:
   Address(const uint8_t* address, uint8_t address_length, int port);
   Address(const struct sockaddr* addr);
 
+  // Addresses with the port are compared using their hashes first, so most
+  // unequal addresses are rejected without comparing their contents
   bool equals(const Address& other, bool with_port = true) const;
 
   bool operator==(const Address& other) const { return equals(other); }
@@ -87,21 +89,28 @@ public:
   Family family() const { return family_; }
   int port() const { return port_; }
 
-  bool is_valid() const { return !hostname_or_address_.empty(); }
+  bool is_valid() const { return family_ != UNRESOLVED || !hostname_.empty(); }
   bool is_resolved() const { return family_ == IPv4 || family_ == IPv6; }
   bool is_valid_and_resolved() const { return is_valid() && is_resolved(); }
 
 public:
-  size_t hash_code() const;
+  size_t hash_code() const { return hash_; }
   uint8_t to_inet(void* address) const;
   const struct sockaddr* to_sockaddr(SocketStorage* storage) const;
   String to_string(bool with_port = false) const;
 
 private:
-  String hostname_or_address_;
+  void init(const char* address, size_t address_length);
+  size_t address_length() const { return family_ == IPv4 ? 4 : (family_ == IPv6 ? 16 : 0); }
+  size_t compute_hash() const;
+
+private:
+  String hostname_; // Only used by unresolved addresses
   String server_name_;
+  char address_[16]; // The IPv4 or IPv6 address in network byte order
   Family family_;
   int port_;
+  size_t hash_;
 };
 
 String determine_listen_address(const Address& address, const Row* row);
@@ -15,11 +15,22 @@
 */
 
 #include "allocated.hpp"
+#include "driver_config.hpp"
 #include "memory.hpp"
+#include "object_cache.hpp"
 #include <new>
 
 using namespace datastax::internal;
 
+#ifdef HAVE_OBJECT_CACHE
+void* Allocated::operator new(size_t size) { return ObjectCache::allocate(size); }
+
+void* Allocated::operator new[](size_t size) { return ObjectCache::allocate(size); }
+
+void Allocated::operator delete(void* ptr) { ObjectCache::deallocate(ptr); }
+
+void Allocated::operator delete[](void* ptr) { ObjectCache::deallocate(ptr); }
+#else
 void* Allocated::operator new(size_t size) { return Memory::malloc(size); }
 
 void* Allocated::operator new[](size_t size) { return Memory::malloc(size); }
@@ -27,3 +38,4 @@ void* Allocated::operator new[](size_t size) { return Memory::malloc(size); }
 void Allocated::operator delete(void* ptr) { Memory::free(ptr); }
 
 void Allocated::operator delete[](void* ptr) { Memory::free(ptr); }
+#endif
@@ -0,0 +1,82 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "arena.hpp"
+
+#include "driver_config.hpp"
+#include "memory.hpp"
+#include "object_cache.hpp"
+
+#include <assert.h>
+#include <new>
+
+using namespace datastax::internal;
+
+Arena* Arena::create(size_t capacity) {
+  capacity = aligned_size(capacity);
+  void* block = Memory::malloc(aligned_size(sizeof(Arena)) + capacity);
+  return new (block) Arena(capacity);
+}
+
+void Arena::dec_ref() const {
+  size_t new_ref_count = ref_count_.fetch_sub(1, MEMORY_ORDER_RELEASE);
+  assert(new_ref_count >= 1);
+  if (new_ref_count == 1) {
+    atomic_thread_fence(MEMORY_ORDER_ACQUIRE);
+    Arena* arena = const_cast<Arena*>(this);
+    arena->~Arena();
+    Memory::free(arena);
+  }
+}
+
+void* Arena::allocate(Arena* arena, size_t size) {
+  const size_t total = sizeof(Header) + aligned_size(size);
+  if (arena != NULL) {
+    // Objects for the same request can be allocated on different threads, so
+    // claim the space atomically. A failed claim leaves the offset past the
+    // end which just disables the arena for later allocations.
+    size_t offset = arena->offset_.fetch_add(total, MEMORY_ORDER_RELAXED);
+    if (offset + total <= arena->capacity_) {
+      Header* header = reinterpret_cast<Header*>(arena->data() + offset);
+      header->arena = arena;
+      arena->inc_ref();
+      return header + 1;
+    }
+  }
+
+#ifdef HAVE_OBJECT_CACHE
+  Header* header = static_cast<Header*>(ObjectCache::allocate(total));
+#else
+  Header* header = static_cast<Header*>(Memory::malloc(total));
+#endif
+  header->arena = NULL;
+  return header + 1;
+}
+
+void Arena::deallocate(void* ptr) {
+  if (ptr == NULL) return;
+  Header* header = static_cast<Header*>(ptr) - 1;
+  if (header->arena != NULL) {
+    // The space isn't reused, it's released with the block
+    header->arena->dec_ref();
+  } else {
+#ifdef HAVE_OBJECT_CACHE
+    ObjectCache::deallocate(header);
+#else
+    Memory::free(header);
+#endif
+  }
+}
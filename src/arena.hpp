@@ -0,0 +1,118 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_ARENA_HPP
+#define DATASTAX_INTERNAL_ARENA_HPP
+
+#include "atomic.hpp"
+#include "macros.hpp"
+
+#include <stddef.h>
+
+namespace datastax { namespace internal {
+
+/**
+ * A bump allocator that carves objects from a single block of memory. Every
+ * object allocated from an arena holds a reference to it and the block is
+ * freed when the owners' references and every object's reference have been
+ * released. This is used to allocate the objects for a single request (its
+ * future, handler and executions) with one call to the allocator.
+ *
+ * Allocations that don't fit in the remaining space fall back to the heap so
+ * a small arena never fails a request.
+ */
+class Arena {
+public:
+  /**
+   * Create an arena. Like other reference counted objects, the arena starts
+   * without any references.
+   *
+   * @param capacity The number of bytes available for objects.
+   * @return The new arena.
+   */
+  static Arena* create(size_t capacity);
+
+  void inc_ref() const { ref_count_.fetch_add(1, MEMORY_ORDER_RELAXED); }
+  void dec_ref() const;
+
+  size_t capacity() const { return capacity_; }
+  size_t used() const {
+    size_t offset = offset_.load(MEMORY_ORDER_RELAXED);
+    return offset < capacity_ ? offset : capacity_;
+  }
+
+  /**
+   * Allocate memory for an object. Every allocation, including the heap
+   * fallback, is prefixed by a header that records where it came from.
+   *
+   * @param arena The arena to allocate from. This can be NULL to allocate
+   * from the heap.
+   * @param size The size of the object.
+   * @return The object's memory.
+   */
+  static void* allocate(Arena* arena, size_t size);
+
+  /**
+   * Free memory returned by allocate().
+   *
+   * @param ptr The object's memory. This can be NULL.
+   */
+  static void deallocate(void* ptr);
+
+private:
+  union Header {
+    Arena* arena; // NULL for heap allocations
+    double align_double;
+    long long align_long_long;
+    void* align_pointer;
+  };
+
+  static size_t aligned_size(size_t size) {
+    return (size + sizeof(Header) - 1) & ~(sizeof(Header) - 1);
+  }
+
+  Arena(size_t capacity)
+      : ref_count_(0)
+      , offset_(0)
+      , capacity_(capacity) {}
+
+  char* data() { return reinterpret_cast<char*>(this) + aligned_size(sizeof(Arena)); }
+
+private:
+  mutable Atomic<size_t> ref_count_;
+  Atomic<size_t> offset_;
+  const size_t capacity_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(Arena);
+};
+
+}} // namespace datastax::internal
+
+// Add to a class (derived from Allocated) to allow its instances to be
+// allocated from an arena using "new (arena) Type(...)". Instances created
+// with a plain "new" are allocated from the heap.
+#define ARENA_ALLOCATED()                                                              \
+  void* operator new(size_t size) { return datastax::internal::Arena::allocate(NULL, size); } \
+  void* operator new(size_t size, datastax::internal::Arena* arena) {                \
+    return datastax::internal::Arena::allocate(arena, size);                         \
+  }                                                                                  \
+  void operator delete(void* ptr) { datastax::internal::Arena::deallocate(ptr); }    \
+  void operator delete(void* ptr, datastax::internal::Arena*) {                      \
+    datastax::internal::Arena::deallocate(ptr);                                      \
+  }
+
+#endif
@@ -0,0 +1,379 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "arrow_export.hpp"
+
+#include "byte_swap.hpp"
+#include "result_columns.hpp"
+#include "result_metadata.hpp"
+#include "result_response.hpp"
+#include "scoped_ptr.hpp"
+#include "serialization.hpp"
+#include "string.hpp"
+#include "vector.hpp"
+
+#include <limits>
+#include <string.h>
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+namespace {
+
+// Owns the strings and children of an exported schema
+class SchemaData : public Allocated {
+public:
+  SchemaData(const String& format, const String& name, size_t child_count)
+      : format(format)
+      , name(name)
+      , children(child_count)
+      , child_ptrs(child_count) {
+    for (size_t i = 0; i < child_count; ++i) {
+      child_ptrs[i] = &children[i];
+    }
+  }
+
+  String format;
+  String name;
+  Vector<ArrowSchema> children;
+  Vector<ArrowSchema*> child_ptrs;
+};
+
+// Owns the buffers and children of an exported array
+class ArrayData : public Allocated {
+public:
+  explicit ArrayData(size_t child_count)
+      : children(child_count)
+      , child_ptrs(child_count) {
+    buffers[0] = buffers[1] = buffers[2] = NULL;
+    for (size_t i = 0; i < child_count; ++i) {
+      child_ptrs[i] = &children[i];
+    }
+  }
+
+  Vector<char> validity;
+  Vector<char> offsets;
+  Vector<char> values;
+  const void* buffers[3];
+  Vector<ArrowArray> children;
+  Vector<ArrowArray*> child_ptrs;
+};
+
+void release_schema(ArrowSchema* schema) {
+  SchemaData* data = static_cast<SchemaData*>(schema->private_data);
+  for (size_t i = 0; i < data->children.size(); ++i) {
+    ArrowSchema& child = data->children[i];
+    if (child.release) child.release(&child);
+  }
+  delete data;
+  schema->release = NULL;
+}
+
+void release_array(ArrowArray* array) {
+  ArrayData* data = static_cast<ArrayData*>(array->private_data);
+  for (size_t i = 0; i < data->children.size(); ++i) {
+    ArrowArray& child = data->children[i];
+    if (child.release) child.release(&child);
+  }
+  delete data;
+  array->release = NULL;
+}
+
+void init_schema(ArrowSchema* schema, SchemaData* data, int64_t flags) {
+  schema->format = data->format.c_str();
+  schema->name = data->name.c_str();
+  schema->metadata = NULL;
+  schema->flags = flags;
+  schema->n_children = static_cast<int64_t>(data->children.size());
+  schema->children = data->child_ptrs.empty() ? NULL : &data->child_ptrs[0];
+  schema->dictionary = NULL;
+  schema->release = release_schema;
+  schema->private_data = data;
+}
+
+void init_array(ArrowArray* array, ArrayData* data, size_t length, size_t null_count,
+                int64_t n_buffers) {
+  array->length = static_cast<int64_t>(length);
+  array->null_count = static_cast<int64_t>(null_count);
+  array->offset = 0;
+  array->n_buffers = n_buffers;
+  array->n_children = static_cast<int64_t>(data->children.size());
+  array->buffers = data->buffers;
+  array->children = data->child_ptrs.empty() ? NULL : &data->child_ptrs[0];
+  array->dictionary = NULL;
+  array->release = release_array;
+  array->private_data = data;
+}
+
+// Never returns an empty buffer so that the result is always a valid pointer
+char* allocate(Vector<char>& buffer, size_t size) {
+  buffer.resize(size > 0 ? size : 1);
+  return &buffer[0];
+}
+
+const char* arrow_format(CassValueType value_type) {
+  switch (value_type) {
+    case CASS_VALUE_TYPE_TINY_INT:
+      return "c";
+    case CASS_VALUE_TYPE_SMALL_INT:
+      return "s";
+    case CASS_VALUE_TYPE_INT:
+      return "i";
+    case CASS_VALUE_TYPE_BIGINT:
+    case CASS_VALUE_TYPE_COUNTER:
+      return "l";
+    case CASS_VALUE_TYPE_FLOAT:
+      return "f";
+    case CASS_VALUE_TYPE_DOUBLE:
+      return "g";
+    case CASS_VALUE_TYPE_BOOLEAN:
+      return "b";
+    case CASS_VALUE_TYPE_ASCII:
+    case CASS_VALUE_TYPE_TEXT:
+    case CASS_VALUE_TYPE_VARCHAR:
+      return "u";
+    case CASS_VALUE_TYPE_TIMESTAMP:
+      return "tsm:UTC";
+    case CASS_VALUE_TYPE_DATE:
+      return "tdD";
+    case CASS_VALUE_TYPE_TIME:
+      return "ttn";
+    case CASS_VALUE_TYPE_UUID:
+    case CASS_VALUE_TYPE_TIMEUUID:
+      return "w:16";
+    default:
+      return "z";
+  }
+}
+
+inline bool is_valid(const uint8_t* validity, size_t row) {
+  return (validity[row / 8] & (1 << (row % 8))) != 0;
+}
+
+inline void set_valid(uint8_t* validity, size_t row) {
+  validity[row / 8] |= static_cast<uint8_t>(1 << (row % 8));
+}
+
+// Copy a fixed width column and convert it to host byte order
+bool export_fixed(const ResultColumns* columns, size_t index, int32_t width, ArrayData* data) {
+  const size_t row_count = columns->row_count();
+  uint8_t* validity = reinterpret_cast<uint8_t*>(allocate(data->validity, (row_count + 7) / 8));
+  char* values = allocate(data->values, row_count * width);
+
+  if (!columns->gather(index, width, values, validity)) {
+    return false;
+  }
+
+  if (width == sizeof(int32_t)) {
+    swap_bytes_32(values, row_count);
+  } else if (width == sizeof(int64_t)) {
+    swap_bytes_64(values, row_count);
+  }
+  return true;
+}
+
+// Copy a column that's too small to benefit from bulk conversion, one cell at a
+// time. Booleans are packed into a bitmap.
+template <class T>
+bool export_small(const ResultColumns* columns, size_t index,
+                  const char* (*decode)(const char*, T&), ArrayData* data) {
+  const size_t row_count = columns->row_count();
+  uint8_t* validity = reinterpret_cast<uint8_t*>(allocate(data->validity, (row_count + 7) / 8));
+  T* values = reinterpret_cast<T*>(allocate(data->values, row_count * sizeof(T)));
+  memset(validity, 0, (row_count + 7) / 8);
+
+  for (size_t row = 0; row < row_count; ++row) {
+    int32_t size = 0;
+    const char* cell = columns->cell(index, row, &size);
+    values[row] = T();
+    if (cell == NULL) continue;
+    if (size < static_cast<int32_t>(sizeof(T))) return false;
+    decode(cell, values[row]);
+    set_valid(validity, row);
+  }
+  return true;
+}
+
+bool export_bool(const ResultColumns* columns, size_t index, ArrayData* data) {
+  const size_t row_count = columns->row_count();
+  const size_t bitmap_size = (row_count + 7) / 8;
+  uint8_t* validity = reinterpret_cast<uint8_t*>(allocate(data->validity, bitmap_size));
+  uint8_t* values = reinterpret_cast<uint8_t*>(allocate(data->values, bitmap_size));
+  memset(validity, 0, bitmap_size);
+  memset(values, 0, bitmap_size);
+
+  for (size_t row = 0; row < row_count; ++row) {
+    int32_t size = 0;
+    const char* cell = columns->cell(index, row, &size);
+    if (cell == NULL) continue;
+    if (size < 1) return false;
+    if (*cell != 0) set_valid(values, row);
+    set_valid(validity, row);
+  }
+  return true;
+}
+
+// Copy a variable length column into an offsets buffer and a values buffer
+bool export_variable(const ResultColumns* columns, size_t index, ArrayData* data) {
+  const size_t row_count = columns->row_count();
+  uint8_t* validity = reinterpret_cast<uint8_t*>(allocate(data->validity, (row_count + 7) / 8));
+  int32_t* offsets =
+      reinterpret_cast<int32_t*>(allocate(data->offsets, (row_count + 1) * sizeof(int32_t)));
+  memset(validity, 0, (row_count + 7) / 8);
+
+  size_t total = 0;
+  for (size_t row = 0; row < row_count; ++row) {
+    int32_t size = 0;
+    columns->cell(index, row, &size);
+    if (size > 0) total += size;
+  }
+  if (total > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+    return false;
+  }
+
+  char* values = allocate(data->values, total);
+  int32_t offset = 0;
+  for (size_t row = 0; row < row_count; ++row) {
+    int32_t size = 0;
+    const char* cell = columns->cell(index, row, &size);
+    offsets[row] = offset;
+    if (cell == NULL) continue;
+    memcpy(values + offset, cell, size);
+    offset += size;
+    set_valid(validity, row);
+  }
+  offsets[row_count] = offset;
+  return true;
+}
+
+size_t count_nulls(const ResultColumns* columns, size_t index) {
+  size_t null_count = 0;
+  for (size_t row = 0, row_count = columns->row_count(); row < row_count; ++row) {
+    int32_t size = 0;
+    if (columns->cell(index, row, &size) == NULL) ++null_count;
+  }
+  return null_count;
+}
+
+bool export_column(const ResultColumns* columns, size_t index, CassValueType value_type,
+                   ArrowArray* array) {
+  ScopedPtr<ArrayData> data(new ArrayData(0));
+  int64_t n_buffers = 2;
+
+  bool exported = false;
+  switch (value_type) {
+    case CASS_VALUE_TYPE_TINY_INT:
+      exported = export_small<int8_t>(columns, index, decode_int8, data.get());
+      break;
+    case CASS_VALUE_TYPE_SMALL_INT:
+      exported = export_small<int16_t>(columns, index, decode_int16, data.get());
+      break;
+    case CASS_VALUE_TYPE_BOOLEAN:
+      exported = export_bool(columns, index, data.get());
+      break;
+    case CASS_VALUE_TYPE_INT:
+    case CASS_VALUE_TYPE_FLOAT:
+      exported = export_fixed(columns, index, sizeof(int32_t), data.get());
+      break;
+    case CASS_VALUE_TYPE_DATE:
+      exported = export_fixed(columns, index, sizeof(int32_t), data.get());
+      if (exported) {
+        // Dates are encoded as unsigned days with the epoch at 2^31
+        const uint8_t* validity = reinterpret_cast<const uint8_t*>(&data->validity[0]);
+        int32_t* days = reinterpret_cast<int32_t*>(&data->values[0]);
+        for (size_t row = 0, row_count = columns->row_count(); row < row_count; ++row) {
+          if (is_valid(validity, row)) {
+            days[row] = static_cast<int32_t>(static_cast<uint32_t>(days[row]) - 0x80000000U);
+          }
+        }
+      }
+      break;
+    case CASS_VALUE_TYPE_BIGINT:
+    case CASS_VALUE_TYPE_COUNTER:
+    case CASS_VALUE_TYPE_TIMESTAMP:
+    case CASS_VALUE_TYPE_TIME:
+    case CASS_VALUE_TYPE_DOUBLE:
+      exported = export_fixed(columns, index, sizeof(int64_t), data.get());
+      break;
+    case CASS_VALUE_TYPE_UUID:
+    case CASS_VALUE_TYPE_TIMEUUID:
+      exported = export_fixed(columns, index, sizeof(CassUuid), data.get());
+      break;
+    default:
+      exported = export_variable(columns, index, data.get());
+      n_buffers = 3;
+      break;
+  }
+
+  if (!exported) {
+    return false;
+  }
+
+  data->buffers[0] = &data->validity[0];
+  if (n_buffers == 3) {
+    data->buffers[1] = &data->offsets[0];
+    data->buffers[2] = &data->values[0];
+  } else {
+    data->buffers[1] = &data->values[0];
+  }
+  init_array(array, data.release(), columns->row_count(), count_nulls(columns, index), n_buffers);
+  return true;
+}
+
+} // namespace
+
+CassError datastax::internal::core::export_arrow(const ResultResponse* result, ArrowArray* array,
+                                                 ArrowSchema* schema) {
+  if (result->kind() != CASS_RESULT_KIND_ROWS || !result->metadata()) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+
+  const ResultColumns* columns = result->columns();
+  if (columns == NULL) {
+    return CASS_ERROR_LIB_NOT_ENOUGH_DATA;
+  }
+
+  const ResultMetadata::Ptr& metadata = result->metadata();
+  const size_t column_count = metadata->column_count();
+
+  ArrowSchema batch_schema;
+  init_schema(&batch_schema, new SchemaData("+s", "", column_count), 0);
+
+  ArrayData* data = new ArrayData(column_count);
+  ArrowArray batch;
+  init_array(&batch, data, columns->row_count(), 0, 1);
+
+  SchemaData* schema_data = static_cast<SchemaData*>(batch_schema.private_data);
+  for (size_t i = 0; i < column_count; ++i) {
+    const ColumnDefinition& def = metadata->get_column_definition(i);
+    const CassValueType value_type = def.data_type->value_type();
+
+    init_schema(&schema_data->children[i],
+                new SchemaData(arrow_format(value_type), def.name.to_string(), 0),
+                ARROW_FLAG_NULLABLE);
+
+    if (!export_column(columns, i, value_type, &data->children[i])) {
+      batch.release(&batch);
+      batch_schema.release(&batch_schema);
+      return CASS_ERROR_LIB_NOT_ENOUGH_DATA;
+    }
+  }
+
+  *array = batch;
+  *schema = batch_schema;
+  return CASS_OK;
+}
@@ -0,0 +1,39 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_ARROW_EXPORT_HPP
+#define DATASTAX_INTERNAL_ARROW_EXPORT_HPP
+
+#include "cassandra.h"
+
+namespace datastax { namespace internal { namespace core {
+
+class ResultResponse;
+
+/**
+ * Export the rows of a result as an Arrow record batch (a struct array with a
+ * child for each column) using the Arrow C data interface.
+ *
+ * @param result A ROWS result with valid metadata.
+ * @param array The record batch's data. Only written if successful.
+ * @param schema The record batch's schema. Only written if successful.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CassError export_arrow(const ResultResponse* result, ArrowArray* array, ArrowSchema* schema);
+
+}}} // namespace datastax::internal::core
+
+#endif
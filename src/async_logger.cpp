@@ -0,0 +1,206 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "async_logger.hpp"
+
+#include "get_time.hpp"
+#include "logger.hpp"
+#include "scoped_lock.hpp"
+
+#include <string.h>
+
+// The longest the background thread waits before checking the queue; a
+// producer's wake-up can be missed because producers don't take the mutex.
+#define MAX_WAIT_NS (100LL * NANOSECONDS_PER_MILLISECOND)
+
+// Repeats of a message within this window are collapsed into a single message
+#define REPEAT_WINDOW_MS 1000
+
+#define RATE_LIMIT_WINDOW_MS 1000
+
+using namespace datastax;
+using namespace datastax::internal;
+
+static bool is_repeat(const CassLogMessage& a, const CassLogMessage& b) {
+  return a.severity == b.severity && a.line == b.line && strcmp(a.file, b.file) == 0 &&
+         strcmp(a.message, b.message) == 0;
+}
+
+AsyncLogger::AsyncLogger(size_t queue_size, unsigned max_messages_per_second)
+    : queue_(queue_size)
+    , max_messages_per_second_(max_messages_per_second)
+    , is_thread_started_(false)
+    , is_closing_(false)
+    , queued_count_(0)
+    , handled_count_(0)
+    , dropped_count_(0)
+    , has_last_(false)
+    , last_time_ms_(0)
+    , repeated_count_(0)
+    , reported_dropped_count_(0)
+    , window_start_ms_(0)
+    , window_count_(0)
+    , suppressed_count_(0) {
+  uv_mutex_init(&mutex_);
+  uv_cond_init(&cond_);
+}
+
+AsyncLogger::~AsyncLogger() {
+  if (is_thread_started_) {
+    {
+      ScopedMutex l(&mutex_);
+      is_closing_.store(true, MEMORY_ORDER_RELEASE);
+      uv_cond_broadcast(&cond_);
+    }
+    uv_thread_join(&thread_);
+  }
+  uv_cond_destroy(&cond_);
+  uv_mutex_destroy(&mutex_);
+}
+
+int AsyncLogger::init() {
+  int rc = uv_thread_create(&thread_, on_run, this);
+  is_thread_started_ = rc == 0;
+  return rc;
+}
+
+bool AsyncLogger::log(const CassLogMessage& message, CassLogCallback callback, void* data) {
+  Entry entry;
+  entry.message = message;
+  entry.callback = callback;
+  entry.data = data;
+  if (!queue_.enqueue(entry)) {
+    dropped_count_.fetch_add(1, MEMORY_ORDER_RELAXED);
+    return false;
+  }
+  queued_count_.fetch_add(1, MEMORY_ORDER_RELEASE);
+  uv_cond_signal(&cond_);
+  return true;
+}
+
+void AsyncLogger::flush() {
+  uint64_t queued_count = queued_count_.load(MEMORY_ORDER_ACQUIRE);
+  ScopedMutex l(&mutex_);
+  while (handled_count_.load(MEMORY_ORDER_ACQUIRE) < queued_count) {
+    uv_cond_broadcast(&cond_);
+    uv_cond_timedwait(&cond_, l.get(), MAX_WAIT_NS);
+  }
+}
+
+void AsyncLogger::on_run(void* arg) { static_cast<AsyncLogger*>(arg)->run(); }
+
+void AsyncLogger::run() {
+  Entry entry;
+  while (true) {
+    // Read the flag before draining so that all the messages queued before
+    // closing are handled.
+    bool is_closing = is_closing_.load(MEMORY_ORDER_ACQUIRE);
+
+    bool is_drained = false;
+    while (queue_.dequeue(entry)) {
+      handle(entry, get_time_since_epoch_ms());
+      handled_count_.fetch_add(1, MEMORY_ORDER_RELEASE);
+      is_drained = true;
+    }
+    maybe_emit_summaries(get_time_since_epoch_ms());
+
+    if (is_closing) break;
+
+    ScopedMutex l(&mutex_);
+    if (is_drained) {
+      uv_cond_broadcast(&cond_); // Wake up flushing threads
+    }
+    if (queue_.is_empty() && !is_closing_.load(MEMORY_ORDER_ACQUIRE)) {
+      uv_cond_timedwait(&cond_, l.get(), MAX_WAIT_NS);
+    }
+  }
+
+  if (repeated_count_ > 0) {
+    emit_summary(last_, "Last message repeated %llu times", repeated_count_,
+                 get_time_since_epoch_ms());
+  }
+}
+
+void AsyncLogger::handle(const Entry& entry, uint64_t now_ms) {
+  if (has_last_ && now_ms - last_time_ms_ < REPEAT_WINDOW_MS &&
+      is_repeat(entry.message, last_.message)) {
+    repeated_count_++;
+    return;
+  }
+
+  if (repeated_count_ > 0) {
+    emit_summary(last_, "Last message repeated %llu times", repeated_count_, now_ms);
+    repeated_count_ = 0;
+  }
+
+  last_ = entry;
+  has_last_ = true;
+  last_time_ms_ = now_ms;
+  emit(entry, now_ms);
+}
+
+void AsyncLogger::emit(const Entry& entry, uint64_t now_ms) {
+  if (max_messages_per_second_ > 0) {
+    if (now_ms - window_start_ms_ >= RATE_LIMIT_WINDOW_MS) {
+      window_start_ms_ = now_ms;
+      window_count_ = 0;
+    }
+    if (window_count_ >= max_messages_per_second_) {
+      suppressed_count_++;
+      return;
+    }
+    window_count_++;
+  }
+  entry.callback(&entry.message, entry.data);
+}
+
+void AsyncLogger::maybe_emit_summaries(uint64_t now_ms) {
+  if (!has_last_) return;
+
+  if (repeated_count_ > 0 && now_ms - last_time_ms_ >= REPEAT_WINDOW_MS) {
+    emit_summary(last_, "Last message repeated %llu times", repeated_count_, now_ms);
+    repeated_count_ = 0;
+  }
+
+  // The summaries of messages that weren't logged are attributed to the logger
+  Entry driver(last_);
+  driver.message.severity = CASS_LOG_WARN;
+  driver.message.file = LOG_FILE_;
+  driver.message.line = __LINE__;
+  driver.message.function = LOG_FUNCTION_;
+
+  uint64_t dropped_count = dropped_count_.load(MEMORY_ORDER_RELAXED);
+  if (dropped_count > reported_dropped_count_) {
+    emit_summary(driver, "Dropped %llu log messages because the log queue was full",
+                 dropped_count - reported_dropped_count_, now_ms);
+    reported_dropped_count_ = dropped_count;
+  }
+
+  if (suppressed_count_ > 0 && now_ms - window_start_ms_ >= RATE_LIMIT_WINDOW_MS) {
+    emit_summary(driver, "Suppressed %llu log messages because of the log rate limit",
+                 suppressed_count_, now_ms);
+    suppressed_count_ = 0;
+  }
+}
+
+void AsyncLogger::emit_summary(const Entry& entry, const char* format, uint64_t count,
+                               uint64_t now_ms) {
+  CassLogMessage message(entry.message);
+  message.time_ms = now_ms;
+  snprintf(message.message, sizeof(message.message), format,
+           static_cast<unsigned long long>(count));
+  entry.callback(&message, entry.data);
+}
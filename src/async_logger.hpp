@@ -0,0 +1,129 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_ASYNC_LOGGER_HPP
+#define DATASTAX_INTERNAL_ASYNC_LOGGER_HPP
+
+#include "allocated.hpp"
+#include "atomic.hpp"
+#include "cassandra.h"
+#include "macros.hpp"
+#include "mpmc_queue.hpp"
+
+#include <uv.h>
+
+namespace datastax { namespace internal {
+
+/**
+ * Runs the log callback on a background thread so that logging doesn't block
+ * the thread that logged, such as an I/O thread, on the application's
+ * callback. Logged messages are queued on a bounded, lock-free queue and
+ * messages are dropped, and counted, if the queue is full.
+ *
+ * Repeated messages (the same message from the same place) are collapsed into
+ * a single message that reports the number of repeats and the rate of the
+ * messages passed to the callback can be limited. Summaries of the dropped and
+ * the suppressed messages are logged in their place.
+ */
+class AsyncLogger : public Allocated {
+public:
+  /**
+   * Constructor.
+   *
+   * @param queue_size The maximum number of queued messages.
+   * @param max_messages_per_second The maximum number of messages passed to
+   * the callback per second or zero for no limit.
+   */
+  AsyncLogger(size_t queue_size, unsigned max_messages_per_second);
+
+  /**
+   * Destructor. Logs the queued messages and stops the background thread.
+   */
+  ~AsyncLogger();
+
+  /**
+   * Start the background thread.
+   *
+   * @return 0 if successful, otherwise an error occurred.
+   */
+  int init();
+
+  /**
+   * Queue a message. This never blocks.
+   *
+   * @param message The formatted message.
+   * @param callback The callback that handles the message.
+   * @param data The callback's data.
+   * @return true if the message was queued, false if the queue was full.
+   */
+  bool log(const CassLogMessage& message, CassLogCallback callback, void* data);
+
+  /**
+   * Wait for the messages that are queued to be passed to the callback.
+   */
+  void flush();
+
+  /**
+   * The number of messages dropped because the queue was full.
+   */
+  uint64_t dropped_count() const { return dropped_count_.load(MEMORY_ORDER_RELAXED); }
+
+private:
+  struct Entry {
+    CassLogMessage message;
+    CassLogCallback callback;
+    void* data;
+  };
+
+  static void on_run(void* arg);
+  void run();
+
+  void handle(const Entry& entry, uint64_t now_ms);
+  void emit(const Entry& entry, uint64_t now_ms);
+  void maybe_emit_summaries(uint64_t now_ms);
+  void emit_summary(const Entry& entry, const char* format, uint64_t count, uint64_t now_ms);
+
+private:
+  core::MPMCQueue<Entry> queue_;
+  const unsigned max_messages_per_second_;
+
+  uv_thread_t thread_;
+  uv_mutex_t mutex_;
+  uv_cond_t cond_;
+  bool is_thread_started_;
+  Atomic<bool> is_closing_;
+
+  Atomic<uint64_t> queued_count_;
+  Atomic<uint64_t> handled_count_;
+  Atomic<uint64_t> dropped_count_;
+
+  // Only used by the background thread
+  Entry last_;
+  bool has_last_;
+  uint64_t last_time_ms_;
+  uint64_t repeated_count_;
+  uint64_t reported_dropped_count_;
+  uint64_t window_start_ms_;
+  unsigned window_count_;
+  uint64_t suppressed_count_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(AsyncLogger);
+};
+
+}} // namespace datastax::internal
+
+#endif
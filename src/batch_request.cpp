@@ -21,6 +21,7 @@
 #include "external.hpp"
 #include "protocol.hpp"
 #include "request_callback.hpp"
+#include "scoped_ptr.hpp"
 #include "serialization.hpp"
 #include "statement.hpp"
 
@@ -67,11 +68,21 @@ CassError cass_batch_set_request_timeout(CassBatch* batch, cass_uint64_t timeout
   return CASS_OK;
 }
 
+CassError cass_batch_set_deadline(CassBatch* batch, cass_uint64_t deadline_ms) {
+  batch->set_deadline_ms(deadline_ms);
+  return CASS_OK;
+}
+
 CassError cass_batch_set_is_idempotent(CassBatch* batch, cass_bool_t is_idempotent) {
   batch->set_is_idempotent(is_idempotent == cass_true);
   return CASS_OK;
 }
 
+CassError cass_batch_set_priority(CassBatch* batch, CassRequestPriority priority) {
+  batch->set_priority(priority);
+  return CASS_OK;
+}
+
 CassError cass_batch_set_retry_policy(CassBatch* batch, CassRetryPolicy* retry_policy) {
   batch->set_retry_policy(retry_policy);
   return CASS_OK;
@@ -106,6 +117,15 @@ CassError cass_batch_set_execution_profile_n(CassBatch* batch, const char* name,
   return CASS_OK;
 }
 
+CassError cass_batch_set_execution_profile_handle(CassBatch* batch, cass_int32_t handle) {
+  if (handle < 0) {
+    batch->set_execution_profile_name(String());
+  } else {
+    batch->set_execution_profile_handle(handle);
+  }
+  return CASS_OK;
+}
+
 } // extern "C"
 
 // Format: <type><n><query_1>...<query_n><consistency><flags>[<serial_consistency>][<timestamp>]
@@ -136,22 +156,45 @@ int BatchRequest::encode(ProtocolVersion version, RequestCallback* callback,
     length += buf_size;
   }
 
-  for (BatchRequest::StatementVec::const_iterator i = statements_.begin(), end = statements_.end();
-       i != end; ++i) {
-    const Statement::Ptr& statement(*i);
-    if (statement->has_names_for_values()) {
-      callback->on_error(CASS_ERROR_LIB_BAD_PARAMS,
-                         "Batches cannot contain queries with named values");
-      return REQUEST_ERROR_BATCH_WITH_NAMED_VALUES;
+  const EncodedStatements* encoded = encoded_statements_.load(MEMORY_ORDER_ACQUIRE);
+  if (encoded != NULL && encoded->version == version) {
+    bufs->insert(bufs->end(), encoded->bufs.begin(), encoded->bufs.end());
+    length += encoded->length;
+  } else {
+    size_t first = bufs->size();
+    int32_t statements_length = 0;
+    for (BatchRequest::StatementVec::const_iterator i = statements_.begin(),
+                                                    end = statements_.end();
+         i != end; ++i) {
+      const Statement::Ptr& statement(*i);
+      if (statement->has_names_for_values()) {
+        callback->on_error(CASS_ERROR_LIB_BAD_PARAMS,
+                           "Batches cannot contain queries with named values");
+        return REQUEST_ERROR_BATCH_WITH_NAMED_VALUES;
+      }
+      int32_t result = statement->encode_batch(version, callback, bufs);
+      if (result < 0) {
+        return result;
+      }
+      statements_length += result;
     }
-    int32_t result = statement->encode_batch(version, callback, bufs);
-    if (result < 0) {
-      return result;
+    length += statements_length;
+
+    if (is_encoding_cached_ && encoded == NULL) {
+      // Encoded buffers are reference counted so the cached copies share
+      // their data. Another thread might have cached its encoding first.
+      ScopedPtr<EncodedStatements> cached(new EncodedStatements(
+          version, BufferVec(bufs->begin() + first, bufs->end()), statements_length));
+      EncodedStatements* expected = NULL;
+      if (encoded_statements_.compare_exchange_strong(expected, cached.get())) {
+        cached.release();
+      }
     }
-    length += result;
   }
 
   {
+    const String& keyspace = callback->keyspace();
+
     // <consistency> [short]
     size_t buf_size = sizeof(uint16_t);
 
@@ -172,8 +215,8 @@ int BatchRequest::encode(ProtocolVersion version, RequestCallback* callback,
       flags |= CASS_QUERY_FLAG_DEFAULT_TIMESTAMP;
     }
 
-    if (version.supports_set_keyspace() && !keyspace().empty()) {
-      buf_size += sizeof(uint16_t) + keyspace().size();
+    if (version.supports_set_keyspace() && !keyspace.empty()) {
+      buf_size += sizeof(uint16_t) + keyspace.size();
       flags |= CASS_QUERY_FLAG_WITH_KEYSPACE;
     }
 
@@ -194,8 +237,8 @@ int BatchRequest::encode(ProtocolVersion version, RequestCallback* callback,
       pos = buf.encode_int64(pos, callback->timestamp());
     }
 
-    if (version.supports_set_keyspace() && !keyspace().empty()) {
-      pos = buf.encode_string(pos, keyspace().data(), static_cast<uint16_t>(keyspace().size()));
+    if (version.supports_set_keyspace() && !keyspace.empty()) {
+      pos = buf.encode_string(pos, keyspace.data(), static_cast<uint16_t>(keyspace.size()));
     }
 
     bufs->push_back(buf);
@@ -205,6 +248,8 @@ int BatchRequest::encode(ProtocolVersion version, RequestCallback* callback,
   return length;
 }
 
+BatchRequest::~BatchRequest() { delete encoded_statements_.load(); }
+
 void BatchRequest::add_statement(Statement* statement) {
   // If the keyspace is not set then inherit the keyspace of the first
   // statement with a non-empty keyspace.
@@ -212,6 +257,36 @@ void BatchRequest::add_statement(Statement* statement) {
     set_keyspace(statement->keyspace());
   }
   statements_.push_back(Statement::Ptr(statement));
+  encoded_size_ += statement->encoded_batch_size();
+}
+
+BatchRequest::Ptr BatchRequest::split(const StatementVec& statements) const {
+  BatchRequest::Ptr batch(new BatchRequest(type_));
+  batch->copy_options(*this);
+  for (StatementVec::const_iterator it = statements.begin(), end = statements.end(); it != end;
+       ++it) {
+    batch->add_statement(it->get());
+  }
+  return batch;
+}
+
+void BatchRequest::split_by_size(size_t max_size, Vector<BatchRequest::Ptr>* batches) const {
+  StatementVec statements;
+  size_t size = 0;
+  for (StatementVec::const_iterator it = statements_.begin(), end = statements_.end(); it != end;
+       ++it) {
+    size_t statement_size = (*it)->encoded_batch_size();
+    if (!statements.empty() && size + statement_size > max_size) {
+      batches->push_back(split(statements));
+      statements.clear();
+      size = 0;
+    }
+    statements.push_back(*it);
+    size += statement_size;
+  }
+  if (!statements.empty()) {
+    batches->push_back(split(statements));
+  }
 }
 
 bool BatchRequest::find_prepared_query(const String& id, String* query) const {
@@ -229,6 +304,16 @@ bool BatchRequest::find_prepared_query(const String& id, String* query) const {
   return false;
 }
 
+bool BatchRequest::is_lwt() const {
+  for (BatchRequest::StatementVec::const_iterator i = statements_.begin(); i != statements_.end();
+       ++i) {
+    if ((*i)->is_lwt()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 bool BatchRequest::get_routing_key(String* routing_key) const {
   for (BatchRequest::StatementVec::const_iterator i = statements_.begin(); i != statements_.end();
        ++i) {
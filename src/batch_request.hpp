@@ -17,6 +17,8 @@
 #ifndef DATASTAX_INTERNAL_BATCH_REQUEST_HPP
 #define DATASTAX_INTERNAL_BATCH_REQUEST_HPP
 
+#include "atomic.hpp"
+#include "buffer.hpp"
 #include "cassandra.h"
 #include "constants.hpp"
 #include "external.hpp"
@@ -38,24 +40,78 @@ public:
 
   BatchRequest(uint8_t type)
       : RoutableRequest(CQL_OPCODE_BATCH)
-      , type_(type) {}
+      , type_(type)
+      , encoded_size_(0)
+      , is_encoding_cached_(false)
+      , encoded_statements_(NULL) {}
+
+  ~BatchRequest();
 
   uint8_t type() const { return type_; }
 
   const StatementVec& statements() const { return statements_; }
 
+  // The encoded size of the statements when they were added
+  size_t encoded_size() const { return encoded_size_; }
+
   void add_statement(Statement* statement);
 
+  /**
+   * Cache the encoded statements the first time the batch is encoded so that
+   * retries and speculative executions don't encode them again. This is only
+   * used for the driver's own batches: the statements must not be modified
+   * once the batch is executed.
+   *
+   * @param enable
+   */
+  void set_is_encoding_cached(bool enable) { is_encoding_cached_ = enable; }
+
+  /**
+   * Create a batch of the same type, and with the same settings, that contains
+   * a subset of this batch's statements.
+   *
+   * @param statements The statements of the new batch.
+   * @return The new batch.
+   */
+  BatchRequest::Ptr split(const StatementVec& statements) const;
+
+  /**
+   * Split the batch, keeping the order of its statements, into batches whose
+   * statements' encoded size is at most a limit. A statement that's larger
+   * than the limit is put in a batch of its own.
+   *
+   * @param max_size The maximum encoded size of each batch's statements.
+   * @param batches The batches (output).
+   */
+  void split_by_size(size_t max_size, Vector<BatchRequest::Ptr>* batches) const;
+
   bool find_prepared_query(const String& id, String* query) const;
 
   virtual bool get_routing_key(String* routing_key) const;
 
+  // A batch with a lightweight transaction is itself a lightweight transaction
+  virtual bool is_lwt() const;
+
 private:
   int encode(ProtocolVersion version, RequestCallback* callback, BufferVec* bufs) const;
 
+private:
+  struct EncodedStatements : public Allocated {
+    EncodedStatements(ProtocolVersion version, const BufferVec& bufs, int32_t length)
+        : version(version)
+        , bufs(bufs)
+        , length(length) {}
+    ProtocolVersion version;
+    BufferVec bufs;
+    int32_t length;
+  };
+
 private:
   uint8_t type_;
   StatementVec statements_;
+  size_t encoded_size_;
+  bool is_encoding_cached_;
+  mutable Atomic<EncodedStatements*> encoded_statements_;
 };
 
 }}} // namespace datastax::internal::core
@@ -28,10 +28,12 @@ namespace datastax { namespace internal { namespace core {
 class Buffer {
 public:
   Buffer()
-      : size_(0) {}
+      : size_(0)
+      , is_external_(false) {}
 
   Buffer(const char* data, size_t size)
-      : size_(size) {
+      : size_(size)
+      , is_external_(false) {
     if (size > FIXED_BUFFER_SIZE) {
       RefBuffer* buffer = RefBuffer::create(size);
       buffer->inc_ref();
@@ -43,7 +45,8 @@ public:
   }
 
   explicit Buffer(size_t size)
-      : size_(size) {
+      : size_(size)
+      , is_external_(false) {
     if (size > FIXED_BUFFER_SIZE) {
       RefBuffer* buffer = RefBuffer::create(size);
       buffer->inc_ref();
@@ -51,8 +54,27 @@ public:
     }
   }
 
+  /**
+   * Reference the application's memory instead of copying it. Small buffers
+   * are still copied. The buffer must not be written to.
+   *
+   * @param external
+   */
+  explicit Buffer(ExternalBuffer* external)
+      : size_(external->size())
+      , is_external_(false) {
+    if (size_ > FIXED_BUFFER_SIZE) {
+      external->inc_ref();
+      data_.external = external;
+      is_external_ = true;
+    } else if (size_ > 0) {
+      memcpy(data_.fixed, external->data(), size_);
+    }
+  }
+
   Buffer(const Buffer& buf)
-      : size_(0) {
+      : size_(0)
+      , is_external_(false) {
     copy(buf);
   }
 
@@ -61,11 +83,7 @@ public:
     return *this;
   }
 
-  ~Buffer() {
-    if (size_ > FIXED_BUFFER_SIZE) {
-      data_.buffer->dec_ref();
-    }
-  }
+  ~Buffer() { release(data_, size_, is_external_); }
 
   size_t encode_byte(size_t offset, uint8_t value) {
     assert(offset + sizeof(uint8_t) <= static_cast<size_t>(size_));
@@ -173,11 +191,14 @@ public:
   }
 
   char* data() {
-    return size_ > FIXED_BUFFER_SIZE ? static_cast<RefBuffer*>(data_.buffer)->data() : data_.fixed;
+    if (size_ <= FIXED_BUFFER_SIZE) return data_.fixed;
+    // External buffers are never written to
+    return is_external_ ? const_cast<char*>(data_.external->data()) : data_.buffer->data();
   }
 
   const char* data() const {
-    return size_ > FIXED_BUFFER_SIZE ? static_cast<RefBuffer*>(data_.buffer)->data() : data_.fixed;
+    if (size_ <= FIXED_BUFFER_SIZE) return data_.fixed;
+    return is_external_ ? data_.external->data() : data_.buffer->data();
   }
 
   size_t size() const { return size_; }
@@ -186,36 +207,55 @@ private:
   // Enough space to avoid extra allocations for most of the basic types
   static const size_t FIXED_BUFFER_SIZE = 16;
 
+  union Data {
+    char fixed[FIXED_BUFFER_SIZE];
+    RefBuffer* buffer;
+    ExternalBuffer* external;
+
+    Data()
+        : buffer(NULL) {}
+  };
+
 private:
   void copy(const Buffer& buf) {
-    RefBuffer* temp = data_.buffer;
+    Data temp = data_;
+    size_t temp_size = size_;
+    bool temp_is_external = is_external_;
 
     if (buf.size_ > FIXED_BUFFER_SIZE) {
-      buf.data_.buffer->inc_ref();
-      data_.buffer = buf.data_.buffer;
+      if (buf.is_external_) {
+        buf.data_.external->inc_ref();
+      } else {
+        buf.data_.buffer->inc_ref();
+      }
+      data_ = buf.data_;
     } else if (buf.size_ > 0) {
       memcpy(data_.fixed, buf.data_.fixed, buf.size_);
     }
 
-    if (size_ > FIXED_BUFFER_SIZE) {
-      temp->dec_ref();
-    }
-
     size_ = buf.size_;
-  }
+    is_external_ = buf.is_external_;
 
-  union Data {
-    char fixed[FIXED_BUFFER_SIZE];
-    RefBuffer* buffer;
+    release(temp, temp_size, temp_is_external);
+  }
 
-    Data()
-        : buffer(NULL) {}
-  } data_;
+  static void release(const Data& data, size_t size, bool is_external) {
+    if (size > FIXED_BUFFER_SIZE) {
+      if (is_external) {
+        data.external->dec_ref();
+      } else {
+        data.buffer->dec_ref();
+      }
+    }
+  }
 
+  Data data_;
   size_t size_;
+  bool is_external_;
 };
 
 typedef Vector<Buffer> BufferVec;
+typedef Vector<size_t> SizeVec;
 
 }}} // namespace datastax::internal::core
 
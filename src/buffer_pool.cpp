@@ -0,0 +1,127 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "buffer_pool.hpp"
+
+#include "metrics.hpp"
+
+#include <string.h>
+
+// The number of in-use buffers that are skipped looking for a free buffer
+// before allocating a new one
+#define MAX_PROBES 4
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+namespace {
+
+// Size classes for common response bodies and socket reads (64 KB), and the
+// maximum number of buffers kept for each (at most 1 MB per class).
+const size_t size_class_sizes[BUFFER_POOL_SIZE_CLASS_COUNT] = { 1024, 4 * 1024, 16 * 1024,
+                                                                64 * 1024 };
+const size_t size_class_counts[BUFFER_POOL_SIZE_CLASS_COUNT] = { 256, 128, 64, 16 };
+
+// Pooled buffers are placed in the arena, if there's one, until it's full
+RefBuffer* create_buffer(size_t size, RefBuffer::Arena* arena) {
+  if (arena != NULL) {
+    RefBuffer* buffer = RefBuffer::create(size, MEMORY_CATEGORY_RESPONSE_BUFFERS, arena);
+    if (buffer != NULL) return buffer;
+  }
+  return RefBuffer::create(size, MEMORY_CATEGORY_RESPONSE_BUFFERS);
+}
+
+} // namespace
+
+void BufferPool::SizeClass::init(size_t size, size_t max_buffers) {
+  size_ = size;
+  max_buffers_ = max_buffers;
+  buffers_.reserve(max_buffers);
+}
+
+RefBuffer* BufferPool::SizeClass::acquire(bool* is_hit, RefBuffer::Arena* arena) {
+  for (size_t i = 0; i < MAX_PROBES && i < buffers_.size(); ++i) {
+    RefBuffer* buffer = buffers_[next_].get();
+    next_ = (next_ + 1) % buffers_.size();
+    // The pool holds the only reference so the buffer is no longer in use
+    if (buffer->ref_count() == 1) {
+      *is_hit = true;
+      return buffer;
+    }
+  }
+
+  *is_hit = false;
+  if (buffers_.size() < max_buffers_) {
+    RefBuffer* buffer = create_buffer(size_, arena);
+    buffers_.push_back(RefBuffer::Ptr(buffer));
+    return buffer;
+  }
+  return RefBuffer::create(size_, MEMORY_CATEGORY_RESPONSE_BUFFERS);
+}
+
+void BufferPool::SizeClass::preallocate(RefBuffer::Arena* arena) {
+  while (buffers_.size() < max_buffers_) {
+    RefBuffer* buffer = create_buffer(size_, arena);
+    memset(buffer->data(), 0, size_); // Fault in the pages on this thread
+    buffers_.push_back(RefBuffer::Ptr(buffer));
+  }
+}
+
+BufferPool::BufferPool(Metrics* metrics, bool huge_pages)
+    : metrics_(metrics) {
+  size_t pooled_size = 0;
+  for (size_t i = 0; i < BUFFER_POOL_SIZE_CLASS_COUNT; ++i) {
+    size_classes_[i].init(size_class_sizes[i], size_class_counts[i]);
+    // Leave room for each buffer's header and alignment
+    pooled_size += size_class_counts[i] * (sizeof(RefBuffer) + size_class_sizes[i] + 64);
+  }
+  if (huge_pages) {
+    arena_.reset(new HugePageArena(pooled_size));
+  }
+}
+
+void BufferPool::preallocate() {
+  for (size_t i = 0; i < BUFFER_POOL_SIZE_CLASS_COUNT; ++i) {
+    size_classes_[i].preallocate(arena_.get());
+  }
+}
+
+RefBuffer::Ptr BufferPool::acquire(size_t size) {
+  bool is_hit = false;
+  RefBuffer* buffer = NULL;
+
+  for (size_t i = 0; i < BUFFER_POOL_SIZE_CLASS_COUNT; ++i) {
+    if (size <= size_classes_[i].size()) {
+      buffer = size_classes_[i].acquire(&is_hit, arena_.get());
+      break;
+    }
+  }
+
+  if (buffer == NULL) {
+    buffer = RefBuffer::create(size, MEMORY_CATEGORY_RESPONSE_BUFFERS); // Too large to pool
+  }
+
+  if (metrics_) {
+    if (is_hit) {
+      metrics_->buffer_pool_hits.inc();
+    } else {
+      metrics_->buffer_pool_misses.inc();
+    }
+  }
+
+  return RefBuffer::Ptr(buffer);
+}
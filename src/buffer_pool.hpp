@@ -0,0 +1,108 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_BUFFER_POOL_HPP
+#define DATASTAX_INTERNAL_BUFFER_POOL_HPP
+
+#include "huge_page_arena.hpp"
+#include "macros.hpp"
+#include "ref_counted.hpp"
+#include "vector.hpp"
+
+#define BUFFER_POOL_SIZE_CLASS_COUNT 4
+
+namespace datastax { namespace internal { namespace core {
+
+class Metrics;
+
+/**
+ * A pool of size-classed, ref-counted buffers used for socket reads and
+ * response bodies. A pool is only used by a single event loop, but its
+ * buffers can be released on any thread: the pool keeps a reference to each
+ * of its buffers and a buffer is reused once the pool holds the only
+ * remaining reference.
+ */
+class BufferPool : public RefCounted<BufferPool> {
+public:
+  typedef SharedRefPtr<BufferPool> Ptr;
+
+  /**
+   * Constructor.
+   *
+   * @param metrics Metrics for recording pool hits and misses. This can be
+   * NULL.
+   * @param huge_pages If true, the pooled buffers are placed in memory backed
+   * by huge pages when the system supports it.
+   */
+  BufferPool(Metrics* metrics = NULL, bool huge_pages = false);
+
+  /**
+   * Acquire a buffer. Sizes that are larger than the largest size class are
+   * allocated directly.
+   *
+   * @param size The minimum size of the buffer.
+   * @return A buffer with a capacity of at least the requested size.
+   */
+  RefBuffer::Ptr acquire(size_t size);
+
+  /**
+   * Allocate and write to the maximum number of buffers of every size class
+   * so that their memory is placed on the NUMA node of the calling thread.
+   * This must be called on the pool's event loop thread.
+   */
+  void preallocate();
+
+  /**
+   * Determine if the pooled buffers are placed in memory backed by huge pages.
+   *
+   * @return true if huge pages are used.
+   */
+  bool is_using_huge_pages() const { return arena_ && arena_->is_mapped(); }
+
+private:
+  class SizeClass {
+  public:
+    SizeClass()
+        : size_(0)
+        , max_buffers_(0)
+        , next_(0) {}
+
+    void init(size_t size, size_t max_buffers);
+
+    size_t size() const { return size_; }
+
+    RefBuffer* acquire(bool* is_hit, RefBuffer::Arena* arena);
+
+    void preallocate(RefBuffer::Arena* arena);
+
+  private:
+    size_t size_;
+    size_t max_buffers_;
+    size_t next_;
+    Vector<RefBuffer::Ptr> buffers_;
+  };
+
+  SizeClass size_classes_[BUFFER_POOL_SIZE_CLASS_COUNT];
+  Metrics* metrics_;
+  HugePageArena::Ptr arena_; // NULL unless the buffers are backed by huge pages
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(BufferPool);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -0,0 +1,334 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "bulk_writer.hpp"
+
+#include "constants.hpp"
+#include "execute_request.hpp"
+#include "get_time.hpp"
+#include "logger.hpp"
+#include "request_handler.hpp"
+#include "session.hpp"
+
+using namespace datastax;
+using namespace datastax::internal::core;
+
+extern "C" {
+
+CassBulkWriter* cass_bulk_writer_new(const CassPrepared* prepared) {
+  BulkWriter* writer = new BulkWriter(Prepared::ConstPtr(prepared->from()));
+  writer->inc_ref();
+  return CassBulkWriter::to(writer);
+}
+
+void cass_bulk_writer_free(CassBulkWriter* writer) { writer->dec_ref(); }
+
+CassError cass_bulk_writer_set_batch_size(CassBulkWriter* writer, unsigned batch_size) {
+  return writer->set_batch_size(batch_size);
+}
+
+CassError cass_bulk_writer_set_max_requests_per_host(CassBulkWriter* writer,
+                                                     unsigned max_requests) {
+  return writer->set_max_requests_per_host(max_requests);
+}
+
+CassError cass_bulk_writer_set_max_pending_rows(CassBulkWriter* writer, unsigned max_rows) {
+  return writer->set_max_pending_rows(max_rows);
+}
+
+CassError cass_bulk_writer_set_max_retries(CassBulkWriter* writer, unsigned max_retries) {
+  return writer->set_max_retries(max_retries);
+}
+
+CassError cass_bulk_writer_set_consistency(CassBulkWriter* writer, CassConsistency consistency) {
+  return writer->set_consistency(consistency);
+}
+
+CassError cass_session_start_bulk_writer(CassSession* session, CassBulkWriter* writer) {
+  return writer->start(session->from());
+}
+
+CassError cass_bulk_writer_add_row(CassBulkWriter* writer, CassStatement* statement) {
+  return writer->add_row(statement->from());
+}
+
+CassError cass_bulk_writer_flush(CassBulkWriter* writer) { return writer->flush(); }
+
+void cass_bulk_writer_get_metrics(CassBulkWriter* writer, CassBulkWriterMetrics* metrics) {
+  writer->get_metrics(metrics);
+}
+
+CassError cass_bulk_writer_error_code(CassBulkWriter* writer) { return writer->error_code(); }
+
+void cass_bulk_writer_error_message(CassBulkWriter* writer, const char** message,
+                                    size_t* message_length) {
+  // Only the first error is kept so the message can't change once it's set
+  const String& m = writer->error_message();
+  *message = m.data();
+  *message_length = m.length();
+}
+
+} // extern "C"
+
+BulkWriter::BulkWriter(const Prepared::ConstPtr& prepared)
+    : prepared_(prepared)
+    , batch_size_(CASS_DEFAULT_BULK_WRITER_BATCH_SIZE)
+    , max_requests_per_host_(CASS_DEFAULT_BULK_WRITER_MAX_REQUESTS_PER_HOST)
+    , max_pending_rows_(CASS_DEFAULT_BULK_WRITER_MAX_PENDING_ROWS)
+    , max_retries_(CASS_DEFAULT_BULK_WRITER_MAX_RETRIES)
+    , consistency_(CASS_CONSISTENCY_UNKNOWN)
+    , is_started_(false)
+    , session_(NULL)
+    , start_time_ns_(0)
+    , pending_rows_(0)
+    , total_inflight_(0)
+    , rows_written_(0)
+    , rows_failed_(0)
+    , batches_written_(0)
+    , retries_(0)
+    , error_code_(CASS_OK) {
+  uv_mutex_init(&mutex_);
+  uv_cond_init(&cond_);
+}
+
+BulkWriter::~BulkWriter() {
+  uv_mutex_destroy(&mutex_);
+  uv_cond_destroy(&cond_);
+}
+
+CassError BulkWriter::set_batch_size(unsigned batch_size) {
+  if (is_started_) return CASS_ERROR_LIB_INVALID_STATE;
+  if (batch_size == 0) return CASS_ERROR_LIB_BAD_PARAMS;
+  batch_size_ = batch_size;
+  return CASS_OK;
+}
+
+CassError BulkWriter::set_max_requests_per_host(unsigned max_requests) {
+  if (is_started_) return CASS_ERROR_LIB_INVALID_STATE;
+  if (max_requests == 0) return CASS_ERROR_LIB_BAD_PARAMS;
+  max_requests_per_host_ = max_requests;
+  return CASS_OK;
+}
+
+CassError BulkWriter::set_max_pending_rows(unsigned max_rows) {
+  if (is_started_) return CASS_ERROR_LIB_INVALID_STATE;
+  if (max_rows == 0) return CASS_ERROR_LIB_BAD_PARAMS;
+  max_pending_rows_ = max_rows;
+  return CASS_OK;
+}
+
+CassError BulkWriter::set_max_retries(unsigned max_retries) {
+  if (is_started_) return CASS_ERROR_LIB_INVALID_STATE;
+  max_retries_ = max_retries;
+  return CASS_OK;
+}
+
+CassError BulkWriter::set_consistency(CassConsistency consistency) {
+  if (is_started_) return CASS_ERROR_LIB_INVALID_STATE;
+  consistency_ = consistency;
+  return CASS_OK;
+}
+
+CassError BulkWriter::start(Session* session) {
+  if (is_started_) return CASS_ERROR_LIB_INVALID_STATE;
+
+  if (session->state() != SessionBase::SESSION_STATE_CONNECTED) {
+    ScopedMutex l(&mutex_);
+    error_code_ = CASS_ERROR_LIB_NO_HOSTS_AVAILABLE;
+    error_message_ = "Session is not connected";
+    return error_code_;
+  }
+
+  is_started_ = true;
+  session_ = session;
+  start_time_ns_ = get_time_monotonic_ns();
+
+  LOG_DEBUG("Started a bulk writer for \"%s\" with batches of %u rows", prepared_->query().c_str(),
+            batch_size_);
+  return CASS_OK;
+}
+
+CassError BulkWriter::add_row(Statement* statement) {
+  if (!is_started_) return CASS_ERROR_LIB_INVALID_STATE;
+  if (statement->opcode() != CQL_OPCODE_EXECUTE ||
+      static_cast<const ExecuteRequest*>(statement)->prepared()->id() != prepared_->id()) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+
+  // Rows without a routing key can't be grouped and are sent on their own
+  String routing_key;
+  Address host;
+  if (statement->get_routing_key(&routing_key)) {
+    TokenMap::Ptr token_map(session_->token_map());
+    if (token_map) {
+      const String& keyspace = !statement->keyspace().empty() ? statement->keyspace()
+                                                               : session_->connect_keyspace();
+      const CopyOnWriteHostVec& replicas = token_map->get_replicas(keyspace, routing_key);
+      if (!replicas->empty()) {
+        host = replicas->front()->address();
+      }
+    }
+  }
+
+  ScopedMutex l(&mutex_);
+  if (routing_key.empty()) {
+    BatchRequest::StatementVec statements(1, Statement::Ptr(statement));
+    send(l, host, statements);
+    return CASS_OK;
+  }
+
+  Partition& partition = partitions_[routing_key];
+  partition.host = host;
+  partition.statements.push_back(Statement::Ptr(statement));
+  ++pending_rows_;
+
+  if (partition.statements.size() >= batch_size_) {
+    BatchRequest::StatementVec statements;
+    statements.swap(partition.statements);
+    partitions_.erase(routing_key);
+    pending_rows_ -= statements.size();
+    send(l, host, statements);
+  } else if (pending_rows_ >= max_pending_rows_) {
+    // Too many partitions are only partially filled
+    send_all(l);
+  }
+  return CASS_OK;
+}
+
+CassError BulkWriter::flush() {
+  if (!is_started_) return CASS_ERROR_LIB_INVALID_STATE;
+
+  ScopedMutex l(&mutex_);
+  send_all(l);
+  while (total_inflight_ > 0) {
+    uv_cond_wait(&cond_, l.get());
+  }
+  return error_code_;
+}
+
+void BulkWriter::get_metrics(CassBulkWriterMetrics* metrics) const {
+  ScopedMutex l(&mutex_);
+  metrics->rows_written = rows_written_;
+  metrics->rows_failed = rows_failed_;
+  metrics->batches_written = batches_written_;
+  metrics->retries = retries_;
+  metrics->pending_rows = pending_rows_;
+  metrics->inflight_batches = total_inflight_;
+  metrics->rows_per_second = 0.0;
+  if (is_started_) {
+    uint64_t elapsed_ns = get_time_monotonic_ns() - start_time_ns_;
+    if (elapsed_ns > 0) {
+      metrics->rows_per_second = static_cast<double>(rows_written_) * 1e9 / elapsed_ns;
+    }
+  }
+}
+
+CassError BulkWriter::error_code() const {
+  ScopedMutex l(&mutex_);
+  return error_code_;
+}
+
+const String& BulkWriter::error_message() const {
+  ScopedMutex l(&mutex_);
+  return error_message_;
+}
+
+bool BulkWriter::is_retryable(CassError code) {
+  return code == CASS_ERROR_LIB_REQUEST_TIMED_OUT || code == CASS_ERROR_SERVER_WRITE_TIMEOUT ||
+         code == CASS_ERROR_SERVER_OVERLOADED;
+}
+
+void BulkWriter::send(ScopedMutex& l, const Address& host,
+                      const BatchRequest::StatementVec& statements) {
+  while (inflight_[host] >= max_requests_per_host_) {
+    uv_cond_wait(&cond_, l.get());
+  }
+  ++inflight_[host];
+  ++total_inflight_;
+  l.unlock();
+
+  BatchRequest::Ptr batch(new BatchRequest(CASS_BATCH_TYPE_UNLOGGED));
+  for (BatchRequest::StatementVec::const_iterator it = statements.begin(), end = statements.end();
+       it != end; ++it) {
+    batch->add_statement(it->get());
+  }
+  // Retries use the same timestamp so the batch's writes are idempotent
+  batch->set_timestamp(session_->config().timestamp_gen()->next());
+  batch->set_is_idempotent(true);
+  batch->set_is_encoding_cached(true);
+  if (consistency_ != CASS_CONSISTENCY_UNKNOWN) {
+    batch->set_consistency(consistency_);
+  }
+  execute(new BatchWrite(this, batch, host));
+
+  l.lock();
+}
+
+void BulkWriter::send_all(ScopedMutex& l) {
+  // Other threads can add rows while the batches are sent
+  PartitionMap partitions;
+  partitions.swap(partitions_);
+  pending_rows_ = 0;
+  for (PartitionMap::const_iterator it = partitions.begin(), end = partitions.end(); it != end;
+       ++it) {
+    send(l, it->second.host, it->second.statements);
+  }
+}
+
+void BulkWriter::execute(BatchWrite* write) {
+  write->attempts++;
+  Future::Ptr future(session_->execute(Request::ConstPtr(write->batch)));
+  inc_ref(); // Released after the batch is handled
+  future->set_callback(on_write, write);
+}
+
+void BulkWriter::on_write(CassFuture* future, void* data) {
+  BatchWrite* write = static_cast<BatchWrite*>(data);
+  BulkWriter* writer = write->writer;
+  if (writer->handle_write(write, static_cast<ResponseFuture*>(future->from()))) {
+    delete write;
+  }
+  writer->dec_ref();
+}
+
+bool BulkWriter::handle_write(BatchWrite* write, ResponseFuture* future) {
+  const Future::Error* error = future->error();
+  if (error != NULL && is_retryable(error->code) && write->attempts <= max_retries_) {
+    {
+      ScopedMutex l(&mutex_);
+      ++retries_;
+    }
+    execute(write);
+    return false;
+  }
+
+  size_t row_count = write->batch->statements().size();
+  ScopedMutex l(&mutex_);
+  if (error != NULL) {
+    rows_failed_ += row_count;
+    if (error_code_ == CASS_OK) {
+      error_code_ = error->code;
+      error_message_ = error->message;
+    }
+  } else {
+    rows_written_ += row_count;
+    ++batches_written_;
+  }
+  --inflight_[write->host];
+  --total_inflight_;
+  uv_cond_broadcast(&cond_);
+  return true;
+}
@@ -0,0 +1,163 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_BULK_WRITER_HPP
+#define DATASTAX_INTERNAL_BULK_WRITER_HPP
+
+#include "address.hpp"
+#include "batch_request.hpp"
+#include "cassandra.h"
+#include "external.hpp"
+#include "future.hpp"
+#include "map.hpp"
+#include "prepared.hpp"
+#include "ref_counted.hpp"
+#include "scoped_lock.hpp"
+#include "string.hpp"
+
+#include <uv.h>
+
+namespace datastax { namespace internal { namespace core {
+
+class ResponseFuture;
+class Session;
+
+/**
+ * Writes a stream of rows bound from the same prepared statement. Rows are
+ * grouped by partition (routing key) into unlogged batches, so each batch only
+ * touches a single partition, and the batches are sent to the partition's
+ * replicas by the load balancing policy.
+ *
+ * The number of in-flight batches is bounded per replica: adding a row blocks
+ * the application's thread while its replica has the maximum number of
+ * in-flight batches. Batches that time out are retried, using the same
+ * client-side timestamp, up to a maximum number of times.
+ */
+class BulkWriter : public RefCounted<BulkWriter> {
+public:
+  typedef SharedRefPtr<BulkWriter> Ptr;
+
+  BulkWriter(const Prepared::ConstPtr& prepared);
+  ~BulkWriter();
+
+  CassError set_batch_size(unsigned batch_size);
+  CassError set_max_requests_per_host(unsigned max_requests);
+  CassError set_max_pending_rows(unsigned max_rows);
+  CassError set_max_retries(unsigned max_retries);
+  CassError set_consistency(CassConsistency consistency);
+
+  /**
+   * Start the writer. The session must stay connected until the writer is
+   * flushed.
+   *
+   * @param session A connected session.
+   * @return CASS_OK if the writer was started, otherwise an error.
+   */
+  CassError start(Session* session);
+
+  /**
+   * Add a row. Its partition's batch is sent once it has the maximum number
+   * of rows, waiting while the partition's replica has the maximum number of
+   * in-flight batches.
+   *
+   * @param statement A statement bound from the writer's prepared statement.
+   * It must not be modified after it's added.
+   * @return CASS_OK if the row was added, otherwise an error.
+   */
+  CassError add_row(Statement* statement);
+
+  /**
+   * Send the partially filled batches and wait for all of the in-flight
+   * batches.
+   *
+   * @return CASS_OK if all of the rows were written, otherwise the first
+   * error.
+   */
+  CassError flush();
+
+  void get_metrics(CassBulkWriterMetrics* metrics) const;
+
+  CassError error_code() const;
+  const String& error_message() const;
+
+public:
+  /**
+   * Determine if a failed batch is retried.
+   *
+   * @param code The batch's error.
+   * @return true if the error is a timeout or an overloaded replica.
+   */
+  static bool is_retryable(CassError code);
+
+private:
+  struct Partition {
+    Address host;
+    BatchRequest::StatementVec statements;
+  };
+
+  struct BatchWrite : public Allocated {
+    BatchWrite(BulkWriter* writer, const BatchRequest::Ptr& batch, const Address& host)
+        : writer(writer)
+        , batch(batch)
+        , host(host)
+        , attempts(0) {}
+    BulkWriter* writer;
+    BatchRequest::Ptr batch;
+    Address host;
+    unsigned attempts;
+  };
+
+  typedef Map<String, Partition> PartitionMap;
+  typedef Map<Address, unsigned> InflightMap;
+
+  void send(ScopedMutex& l, const Address& host, const BatchRequest::StatementVec& statements);
+  void send_all(ScopedMutex& l);
+  void execute(BatchWrite* write);
+  static void on_write(CassFuture* future, void* data);
+  bool handle_write(BatchWrite* write, ResponseFuture* future);
+
+private:
+  mutable uv_mutex_t mutex_;
+  uv_cond_t cond_;
+  Prepared::ConstPtr prepared_;
+  unsigned batch_size_;
+  unsigned max_requests_per_host_;
+  unsigned max_pending_rows_;
+  unsigned max_retries_;
+  CassConsistency consistency_;
+  bool is_started_;
+  Session* session_;
+  uint64_t start_time_ns_;
+  PartitionMap partitions_;
+  size_t pending_rows_;
+  InflightMap inflight_;
+  size_t total_inflight_;
+  uint64_t rows_written_;
+  uint64_t rows_failed_;
+  uint64_t batches_written_;
+  uint64_t retries_;
+  CassError error_code_;
+  String error_message_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(BulkWriter);
+};
+
+}}} // namespace datastax::internal::core
+
+EXTERNAL_TYPE(datastax::internal::core::BulkWriter, CassBulkWriter)
+
+#endif
@@ -0,0 +1,118 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_BYTE_ORDERED_TOKEN_HPP
+#define DATASTAX_INTERNAL_BYTE_ORDERED_TOKEN_HPP
+
+#include "memory.hpp"
+
+#include <stdint.h>
+#include <string.h>
+
+// The number of bytes stored inside of a token without an allocation
+#define BYTE_ORDERED_TOKEN_INLINE_SIZE 16
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * A ByteOrderedPartitioner token: an arbitrary sequence of bytes ordered
+ * lexicographically. Short tokens (the common case for routing keys) are
+ * stored inline without allocating. The first eight bytes are also kept as a
+ * big-endian integer prefix so that most comparisons in ring lookups are a
+ * single integer comparison without following a pointer.
+ */
+class ByteOrderedToken {
+public:
+  typedef const uint8_t* const_iterator;
+
+  ByteOrderedToken()
+      : prefix_(0)
+      , size_(0) {}
+
+  ByteOrderedToken(const uint8_t* first, const uint8_t* last) { init(first, last - first); }
+
+  ByteOrderedToken(const ByteOrderedToken& other) { init(other.data(), other.size_); }
+
+  ~ByteOrderedToken() {
+    if (!is_inline()) Memory::free(heap_);
+  }
+
+  ByteOrderedToken& operator=(const ByteOrderedToken& other) {
+    if (this != &other) {
+      if (!is_inline()) Memory::free(heap_);
+      init(other.data(), other.size_);
+    }
+    return *this;
+  }
+
+  const uint8_t* data() const { return is_inline() ? inline_ : heap_; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  const_iterator begin() const { return data(); }
+  const_iterator end() const { return data() + size_; }
+
+  bool operator<(const ByteOrderedToken& other) const {
+    if (prefix_ != other.prefix_) return prefix_ < other.prefix_;
+    // The prefixes are the same so only the bytes after the prefix and the
+    // sizes are left to compare
+    size_t common = size_ < other.size_ ? size_ : other.size_;
+    if (common > sizeof(prefix_)) {
+      int result = memcmp(data() + sizeof(prefix_), other.data() + sizeof(prefix_),
+                          common - sizeof(prefix_));
+      if (result != 0) return result < 0;
+    }
+    return size_ < other.size_;
+  }
+
+  bool operator==(const ByteOrderedToken& other) const {
+    return prefix_ == other.prefix_ && size_ == other.size_ &&
+           (size_ <= sizeof(prefix_) ||
+            memcmp(data() + sizeof(prefix_), other.data() + sizeof(prefix_),
+                   size_ - sizeof(prefix_)) == 0);
+  }
+
+  bool operator!=(const ByteOrderedToken& other) const { return !(*this == other); }
+
+private:
+  bool is_inline() const { return size_ <= BYTE_ORDERED_TOKEN_INLINE_SIZE; }
+
+  void init(const uint8_t* data, size_t size) {
+    size_ = static_cast<uint32_t>(size);
+    uint8_t* bytes = inline_;
+    if (!is_inline()) {
+      bytes = heap_ = static_cast<uint8_t*>(Memory::malloc(size));
+    }
+    if (size > 0) memcpy(bytes, data, size);
+
+    prefix_ = 0;
+    for (size_t i = 0; i < sizeof(prefix_); ++i) {
+      prefix_ = (prefix_ << 8) | (i < size ? data[i] : 0);
+    }
+  }
+
+private:
+  uint64_t prefix_;
+  uint32_t size_;
+  union {
+    uint8_t inline_[BYTE_ORDERED_TOKEN_INLINE_SIZE];
+    uint8_t* heap_;
+  };
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
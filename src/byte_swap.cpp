@@ -0,0 +1,126 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "byte_swap.hpp"
+
+#include "macros.hpp"
+#include "serialization.hpp"
+
+#include <string.h>
+
+#if defined(__AVX2__) || defined(__SSSE3__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CASS_BYTE_SWAP_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define CASS_BYTE_SWAP_NEON
+#endif
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define CASS_BYTE_SWAP_BIG_ENDIAN
+#endif
+
+using namespace datastax::internal;
+
+void datastax::internal::swap_bytes_32(char* data, size_t count) {
+#if !defined(CASS_BYTE_SWAP_BIG_ENDIAN)
+  size_t i = 0;
+#if defined(__AVX2__)
+  const __m256i mask256 = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3,
+                                           2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+  for (; i + 8 <= count; i += 8) {
+    __m256i* p = reinterpret_cast<__m256i*>(data + i * sizeof(int32_t));
+    _mm256_storeu_si256(p, _mm256_shuffle_epi8(_mm256_loadu_si256(p), mask256));
+  }
+#endif
+#if defined(__SSSE3__)
+  const __m128i mask = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+  for (; i + 4 <= count; i += 4) {
+    __m128i* p = reinterpret_cast<__m128i*>(data + i * sizeof(int32_t));
+    _mm_storeu_si128(p, _mm_shuffle_epi8(_mm_loadu_si128(p), mask));
+  }
+#elif defined(CASS_BYTE_SWAP_SSE2)
+  for (; i + 4 <= count; i += 4) {
+    __m128i* p = reinterpret_cast<__m128i*>(data + i * sizeof(int32_t));
+    __m128i v = _mm_loadu_si128(p);
+    v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)); // Swap bytes in each word
+    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));          // Swap words in each dword
+    v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+    _mm_storeu_si128(p, v);
+  }
+#elif defined(CASS_BYTE_SWAP_NEON)
+  for (; i + 4 <= count; i += 4) {
+    uint8_t* p = reinterpret_cast<uint8_t*>(data + i * sizeof(int32_t));
+    vst1q_u8(p, vrev32q_u8(vld1q_u8(p)));
+  }
+#endif
+  for (; i < count; ++i) {
+    char* p = data + i * sizeof(int32_t);
+    int32_t value;
+    decode_int32(p, value);
+    memcpy(p, &value, sizeof(int32_t));
+  }
+#else
+  UNUSED_(data);
+  UNUSED_(count);
+#endif
+}
+
+void datastax::internal::swap_bytes_64(char* data, size_t count) {
+#if !defined(CASS_BYTE_SWAP_BIG_ENDIAN)
+  size_t i = 0;
+#if defined(__AVX2__)
+  const __m256i mask256 = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7,
+                                           6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+  for (; i + 4 <= count; i += 4) {
+    __m256i* p = reinterpret_cast<__m256i*>(data + i * sizeof(int64_t));
+    _mm256_storeu_si256(p, _mm256_shuffle_epi8(_mm256_loadu_si256(p), mask256));
+  }
+#endif
+#if defined(__SSSE3__)
+  const __m128i mask = _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+  for (; i + 2 <= count; i += 2) {
+    __m128i* p = reinterpret_cast<__m128i*>(data + i * sizeof(int64_t));
+    _mm_storeu_si128(p, _mm_shuffle_epi8(_mm_loadu_si128(p), mask));
+  }
+#elif defined(CASS_BYTE_SWAP_SSE2)
+  for (; i + 2 <= count; i += 2) {
+    __m128i* p = reinterpret_cast<__m128i*>(data + i * sizeof(int64_t));
+    __m128i v = _mm_loadu_si128(p);
+    v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)); // Swap bytes in each word
+    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));          // Reverse words in each qword
+    v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+    _mm_storeu_si128(p, v);
+  }
+#elif defined(CASS_BYTE_SWAP_NEON)
+  for (; i + 2 <= count; i += 2) {
+    uint8_t* p = reinterpret_cast<uint8_t*>(data + i * sizeof(int64_t));
+    vst1q_u8(p, vrev64q_u8(vld1q_u8(p)));
+  }
+#endif
+  for (; i < count; ++i) {
+    char* p = data + i * sizeof(int64_t);
+    int64_t value;
+    decode_int64(p, value);
+    memcpy(p, &value, sizeof(int64_t));
+  }
+#else
+  UNUSED_(data);
+  UNUSED_(count);
+#endif
+}
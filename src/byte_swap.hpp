@@ -0,0 +1,34 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_BYTE_SWAP_HPP
+#define DATASTAX_INTERNAL_BYTE_SWAP_HPP
+
+#include <stddef.h>
+
+namespace datastax { namespace internal {
+
+// Convert runs of big-endian (network order) fixed width values to host order
+// in place. These use SIMD shuffles when they're available at compile time and
+// do nothing on big-endian hosts.
+
+void swap_bytes_32(char* data, size_t count);
+
+void swap_bytes_64(char* data, size_t count);
+
+}} // namespace datastax::internal
+
+#endif
@@ -0,0 +1,66 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "callback_executor.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+extern "C" {
+
+void cass_callback_task_run(CassCallbackTask* task) {
+  task->run();
+  delete task->from();
+}
+
+} // extern "C"
+
+namespace datastax { namespace internal { namespace core {
+
+class ThreadPoolCallbackExecutor::RunCallback : public Task {
+public:
+  RunCallback(Future* future)
+      : future_(future) {}
+
+  virtual void run(EventLoop* event_loop) { CallbackExecutor::run_callback(future_.get()); }
+
+private:
+  Future::Ptr future_;
+};
+
+}}} // namespace datastax::internal::core
+
+void CallbackTask::run() { CallbackExecutor::run_callback(future_.get()); }
+
+int ThreadPoolCallbackExecutor::init() {
+  int rc = event_loop_group_.init("Callback");
+  if (rc != 0) return rc;
+  return event_loop_group_.run();
+}
+
+void ThreadPoolCallbackExecutor::execute(Future* future) {
+  event_loop_group_.add(new RunCallback(future));
+}
+
+void ThreadPoolCallbackExecutor::close() {
+  event_loop_group_.close_handles();
+  event_loop_group_.join();
+}
+
+void ExternalCallbackExecutor::execute(Future* future) {
+  submit_(CassCallbackTask::to(new CallbackTask(future)), data_);
+}
@@ -0,0 +1,111 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_CALLBACK_EXECUTOR_HPP
+#define DATASTAX_INTERNAL_CALLBACK_EXECUTOR_HPP
+
+#include "allocated.hpp"
+#include "cassandra.h"
+#include "event_loop.hpp"
+#include "external.hpp"
+#include "future.hpp"
+#include "macros.hpp"
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * Runs the application's future callbacks off of the I/O threads so that a
+ * slow callback doesn't stall the connections of an event loop.
+ */
+class CallbackExecutor : public Allocated {
+public:
+  virtual ~CallbackExecutor() {}
+
+  /**
+   * Run a completed future's callback. The executor holds a reference to the
+   * future until the callback has run.
+   *
+   * @param future The completed future.
+   */
+  virtual void execute(Future* future) = 0;
+
+  /**
+   * Run the callbacks that have been queued and wait for them to finish.
+   */
+  virtual void close() {}
+
+  static void run_callback(Future* future) { future->run_callback(); }
+};
+
+/**
+ * A future callback that's been submitted to an application's executor.
+ */
+class CallbackTask : public Allocated {
+public:
+  CallbackTask(Future* future)
+      : future_(future) {}
+
+  void run();
+
+private:
+  Future::Ptr future_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(CallbackTask);
+};
+
+/**
+ * Runs the callbacks on a pool of driver-managed threads. The callbacks are
+ * queued on the threads in turn and each thread runs all of its queued
+ * callbacks, in a batch, each time it wakes up.
+ */
+class ThreadPoolCallbackExecutor : public CallbackExecutor {
+public:
+  ThreadPoolCallbackExecutor(unsigned num_threads)
+      : event_loop_group_(num_threads) {}
+
+  int init();
+
+  virtual void execute(Future* future);
+  virtual void close();
+
+private:
+  class RunCallback;
+
+  RoundRobinEventLoopGroup event_loop_group_;
+};
+
+/**
+ * Submits the callbacks to an application's executor.
+ */
+class ExternalCallbackExecutor : public CallbackExecutor {
+public:
+  ExternalCallbackExecutor(CassCallbackExecutorSubmit submit, void* data)
+      : submit_(submit)
+      , data_(data) {}
+
+  virtual void execute(Future* future);
+
+private:
+  CassCallbackExecutorSubmit submit_;
+  void* data_;
+};
+
+}}} // namespace datastax::internal::core
+
+EXTERNAL_TYPE(datastax::internal::core::CallbackTask, CassCallbackTask)
+
+#endif
@@ -0,0 +1,55 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "circuit_breaker.hpp"
+
+#include "logger.hpp"
+
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+bool CircuitBreaker::try_acquire(Host* host, uint64_t now_ns) const {
+  uint64_t open_until_ns = host->circuit_open_until_ns().load(MEMORY_ORDER_RELAXED);
+  if (open_until_ns == 0) return true;
+  if (now_ns < open_until_ns) return false;
+  // The circuit is half-open. Only the thread that moves the open time
+  // forward sends the probe.
+  return host->circuit_open_until_ns().compare_exchange_strong(open_until_ns,
+                                                               now_ns + open_duration_ns_);
+}
+
+void CircuitBreaker::record_success(Host* host) const {
+  // Avoid writing to the shared state in the common case
+  if (host->consecutive_failures().load(MEMORY_ORDER_RELAXED) != 0) {
+    host->consecutive_failures().store(0, MEMORY_ORDER_RELAXED);
+  }
+  if (host->circuit_open_until_ns().load(MEMORY_ORDER_RELAXED) != 0) {
+    host->circuit_open_until_ns().store(0, MEMORY_ORDER_RELAXED);
+    LOG_INFO("Closing the circuit for host %s", host->address_string().c_str());
+  }
+}
+
+void CircuitBreaker::record_failure(Host* host, uint64_t now_ns) const {
+  int32_t failures = host->consecutive_failures().fetch_add(1, MEMORY_ORDER_RELAXED) + 1;
+  if (failures >= failure_threshold_) {
+    if (failures == failure_threshold_) {
+      LOG_WARN("Opening the circuit for host %s after %d consecutive failures",
+               host->address_string().c_str(), failures);
+    }
+    // A failed probe keeps the circuit open for another period
+    host->circuit_open_until_ns().store(now_ns + open_duration_ns_, MEMORY_ORDER_RELAXED);
+  }
+}
@@ -0,0 +1,88 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_CIRCUIT_BREAKER_HPP
+#define DATASTAX_INTERNAL_CIRCUIT_BREAKER_HPP
+
+#include "host.hpp"
+#include "ref_counted.hpp"
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * A per-host circuit breaker that moves hosts that keep timing out or
+ * reporting that they're overloaded to the end of the query plans.
+ *
+ * A host's circuit opens after a number of consecutive failures. While it's
+ * open the host is only used once the other hosts of a query plan have been
+ * tried. Once the open duration has elapsed the circuit is half-open and a
+ * single request is sent to the host as a probe (at most one per open
+ * duration). A successful response closes the circuit and a failure keeps it
+ * open.
+ *
+ * The state is kept in the hosts so it's shared by all the I/O threads.
+ */
+class CircuitBreaker : public RefCounted<CircuitBreaker> {
+public:
+  typedef SharedRefPtr<CircuitBreaker> Ptr;
+
+  /**
+   * Constructor.
+   *
+   * @param failure_threshold The number of consecutive failures that opens a
+   * host's circuit.
+   * @param open_duration_ms The time a host's circuit stays open before a
+   * probe request is allowed.
+   */
+  CircuitBreaker(unsigned failure_threshold, uint64_t open_duration_ms)
+      : failure_threshold_(static_cast<int32_t>(failure_threshold))
+      , open_duration_ns_(open_duration_ms * 1000LL * 1000LL) {}
+
+  /**
+   * Determine if a request can be sent to a host. Hosts with a closed circuit
+   * always accept requests. A host with a half-open circuit accepts a single
+   * probe request.
+   *
+   * @param host The host.
+   * @param now_ns The current time from get_time_monotonic_coarse_ns().
+   * @return true if the request can be sent to the host, otherwise false if
+   * the host should be tried after the other hosts.
+   */
+  bool try_acquire(Host* host, uint64_t now_ns) const;
+
+  /**
+   * Record a successful response from a host. This closes the host's circuit.
+   *
+   * @param host The host.
+   */
+  void record_success(Host* host) const;
+
+  /**
+   * Record a timeout, overloaded or unavailable error from a host.
+   *
+   * @param host The host.
+   * @param now_ns The current time from get_time_monotonic_coarse_ns().
+   */
+  void record_failure(Host* host, uint64_t now_ns) const;
+
+private:
+  const int32_t failure_threshold_;
+  const uint64_t open_duration_ns_;
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -20,6 +20,7 @@
 #include "driver_info.hpp"
 #include "get_time.hpp"
 #include "logger.hpp"
+#include "metrics.hpp"
 #include "session.hpp"
 #include "ssl.hpp"
 #include "string.hpp"
@@ -42,6 +43,9 @@
 #define METADATA_INSIGHTS_MAPPING_ID "v1"
 #define METADATA_LANGUAGE "C/C++"
 
+#define INSIGHTS_RPC_PREFIX "CALL InsightsRpc.reportInsight('"
+#define INSIGHTS_RPC_SUFFIX "')"
+
 #define CONFIG_ANTIPATTERN_MSG_MULTI_DC_HOSTS \
   "Contact points contain hosts from "        \
   "multiple data centers but only one "       \
@@ -63,11 +67,11 @@
 namespace datastax { namespace internal { namespace core {
 
 MonitorReporting* create_monitor_reporting(const String& client_id, const String& session_id,
-                                           const Config& config) {
+                                           const Config& config, const Metrics* metrics) {
   // Ensure the client monitor events should be enabled
   unsigned interval_secs = config.monitor_reporting_interval_secs();
   if (interval_secs > 0) {
-    return new enterprise::ClientInsights(client_id, session_id, interval_secs);
+    return new enterprise::ClientInsights(client_id, session_id, interval_secs, metrics);
   }
   return new NopMonitorReporting();
 }
@@ -113,6 +117,19 @@ String get_hostname() {
   return String(buf, size);
 }
 
+const char* compression_type_to_string(CassCompressionType type) {
+  switch (type) {
+    case CASS_COMPRESSION_LZ4:
+      return "LZ4";
+    case CASS_COMPRESSION_SNAPPY:
+      return "SNAPPY";
+    case CASS_COMPRESSION_AUTO:
+      return "AUTO";
+    default:
+      return "NONE";
+  }
+}
+
 struct Os {
   String name;
   String version;
@@ -190,8 +207,8 @@ class ClientInsightsRequestCallback : public SimpleRequestCallback {
 public:
   typedef SharedRefPtr<ClientInsightsRequestCallback> Ptr;
 
-  ClientInsightsRequestCallback(const String& json, const String& event_type)
-      : SimpleRequestCallback("CALL InsightsRpc.reportInsight('" + json + "')")
+  ClientInsightsRequestCallback(const String& query, const String& event_type)
+      : SimpleRequestCallback(query)
       , event_type_(event_type) {}
 
   virtual void on_internal_set(ResponseMessage* response) {
@@ -235,37 +252,133 @@ void metadata(ClientInsights::Writer& writer, const String& name) {
   writer.EndObject();
 }
 
-class StartupMessageHandler : public RefCounted<StartupMessageHandler> {
+void append(ClientInsights::StringBuffer& buffer, const char* str) {
+  size_t length = strlen(str);
+  memcpy(buffer.Push(length), str, length);
+}
+
+/**
+ * An insights message whose JSON is built on libuv's thread pool so that
+ * serializing a large config or host list doesn't delay the control
+ * connection's event loop. Anything that can only be read on the event loop
+ * is captured before the message is built and the message is sent back on
+ * the event loop. The buffer is kept between messages so it only grows to
+ * the largest message once.
+ */
+class InsightsMessageHandler : public RefCounted<InsightsMessageHandler> {
+public:
+  typedef SharedRefPtr<InsightsMessageHandler> Ptr;
+
+  InsightsMessageHandler(const char* name, const Connection::Ptr& connection = Connection::Ptr())
+      : connection_(connection)
+      , name_(name)
+      , is_building_(false) {
+    req_.data = this;
+  }
+
+  virtual ~InsightsMessageHandler() {}
+
+  bool is_building() const { return is_building_; }
+
+protected:
+  /**
+   * Build the message on a worker thread then send it on the connection. This
+   * must be called on the connection's event loop.
+   */
+  void build_and_send() {
+    assert(!is_building_ && "Insights message is already being built");
+    is_building_ = true;
+    inc_ref(); // Released after the message is sent
+    if (uv_queue_work(connection_->loop(), &req_, on_build, on_after_build) != 0) {
+      on_build(&req_);
+      on_after_build(&req_, 0);
+    }
+  }
+
+  // Called on a worker thread
+  virtual void build_data(ClientInsights::Writer& writer) = 0;
+
+  Connection::Ptr connection_;
+
+private:
+  static void on_build(uv_work_t* req) {
+    InsightsMessageHandler* handler = static_cast<InsightsMessageHandler*>(req->data);
+    ClientInsights::StringBuffer& buffer = handler->buffer_;
+
+    buffer.Clear(); // Keeps the capacity of the previous message
+    append(buffer, INSIGHTS_RPC_PREFIX);
+    ClientInsights::Writer writer(buffer);
+    writer.StartObject();
+    metadata(writer, handler->name_);
+    handler->build_data(writer);
+    writer.EndObject();
+    assert(writer.IsComplete() && "Insights JSON is incomplete");
+    append(buffer, INSIGHTS_RPC_SUFFIX);
+  }
+
+  static void on_after_build(uv_work_t* req, int status) {
+    InsightsMessageHandler* handler = static_cast<InsightsMessageHandler*>(req->data);
+    const ClientInsights::StringBuffer& buffer = handler->buffer_;
+
+    if (status == 0 && !handler->connection_->is_closing()) {
+      handler->connection_->write_and_flush(RequestCallback::Ptr(new ClientInsightsRequestCallback(
+          String(buffer.GetString(), buffer.GetLength()), handler->name_)));
+    }
+    handler->connection_.reset();
+    handler->is_building_ = false;
+    handler->dec_ref();
+  }
+
+private:
+  uv_work_t req_;
+  const char* name_;
+  bool is_building_;
+  ClientInsights::StringBuffer buffer_;
+};
+
+class StartupMessageHandler : public InsightsMessageHandler {
 public:
   typedef SharedRefPtr<StartupMessageHandler> Ptr;
 
   StartupMessageHandler(const Connection::Ptr& connection, const String& client_id,
                         const String& session_id, const Config& config, const HostMap& hosts,
                         const LoadBalancingPolicy::Vec& initialized_policies)
-      : connection_(connection)
+      : InsightsMessageHandler(METADATA_STARTUP_NAME, connection)
       , client_id_(client_id)
       , session_id_(session_id)
       , config_(config)
       , hosts_(hosts)
-      , initialized_policies_(initialized_policies) {}
+      , initialized_policies_(initialized_policies)
+      , protocol_version_(0) {}
 
-  ~StartupMessageHandler() {
-    ClientInsights::StringBuffer buffer;
-    ClientInsights::Writer writer(buffer);
-
-    writer.StartObject();
-    metadata(writer, METADATA_STARTUP_NAME);
-    startup_message_data(writer);
-    writer.EndObject();
+  void send_message() {
+    if (!resolve_contact_points()) {
+      capture_and_send();
+    }
+  }
 
-    assert(writer.IsComplete() && "Startup JSON is incomplete");
-    connection_->write_and_flush(RequestCallback::Ptr(
-        new ClientInsightsRequestCallback(buffer.GetString(), METADATA_STARTUP_NAME)));
+private:
+  // Captures the values that can only be read on the event loop then builds
+  // the rest of the message on a worker thread.
+  void capture_and_send() {
+    initial_control_connection_ = connection_->resolved_address().to_string(true);
+    protocol_version_ = connection_->protocol_version().value();
+    local_address_ = get_local_address(connection_->handle());
+    Set<String> data_centers;
+    for (HostMap::const_iterator it = hosts_.begin(), end = hosts_.end(); it != end; ++it) {
+      const String& data_center = it->second->dc();
+      if (data_centers.insert(data_center).second) {
+        data_centers_.push_back(data_center);
+      }
+    }
+    config_anti_patterns_ = get_config_anti_patterns(config_.default_profile(), config_.profiles(),
+                                                     initialized_policies_, hosts_,
+                                                     config_.ssl_context(), config_.auth_provider());
+    build_and_send();
   }
 
-  void send_message() { resolve_contact_points(); }
+  virtual void build_data(ClientInsights::Writer& writer) { startup_message_data(writer); }
 
-private:
   // Startup message associated methods
   void startup_message_data(ClientInsights::Writer& writer) {
     writer.Key("data");
@@ -296,11 +409,11 @@ private:
     contact_points(writer);
     data_centers(writer);
     writer.Key("initialControlConnection");
-    writer.String(connection_->resolved_address().to_string(true).c_str());
+    writer.String(initial_control_connection_.c_str());
     writer.Key("protocolVersion");
-    writer.Int(connection_->protocol_version().value());
+    writer.Int(protocol_version_);
     writer.Key("localAddress");
-    writer.String(get_local_address(connection_->handle()).c_str());
+    writer.String(local_address_.c_str());
     writer.Key("hostName");
     writer.String(get_hostname().c_str());
     execution_profiles(writer);
@@ -308,7 +421,7 @@ private:
     writer.Key("heartbeatInterval");
     writer.Uint64(config_.connection_heartbeat_interval_secs() * 1000); // in milliseconds
     writer.Key("compression");
-    writer.String("NONE"); // TODO: Update once compression is added
+    writer.String(compression_type_to_string(config_.compression()));
     reconnection_policy(writer);
     ssl(writer);
     auth_provider(writer);
@@ -345,12 +458,9 @@ private:
     writer.Key("dataCenters");
     writer.StartArray();
 
-    Set<String> data_centers;
-    for (HostMap::const_iterator it = hosts_.begin(), end = hosts_.end(); it != end; ++it) {
-      const String& data_center = it->second->dc();
-      if (data_centers.insert(data_center).second) {
-        writer.String(data_center.c_str());
-      }
+    for (StringVec::const_iterator it = data_centers_.begin(), end = data_centers_.end(); it != end;
+         ++it) {
+      writer.String(it->c_str());
     }
 
     writer.EndArray();
@@ -396,6 +506,8 @@ private:
       writer.String("ConstantReconnectionPolicy");
     } else if (reconnection_policy->type() == ReconnectionPolicy::EXPONENTIAL) {
       writer.String("ExponentialReconnectionPolicy");
+    } else if (reconnection_policy->type() == ReconnectionPolicy::DECORRELATED_JITTER) {
+      writer.String("DecorrelatedJitterReconnectionPolicy");
     } else {
       assert(false && "Reconnection policy needs to be added");
       writer.String("UnknownReconnectionPolicy");
@@ -414,6 +526,13 @@ private:
       writer.Uint(erp->base_delay_ms());
       writer.Key("maxDelayMs");
       writer.Uint(erp->max_delay_ms());
+    } else if (reconnection_policy->type() == ReconnectionPolicy::DECORRELATED_JITTER) {
+      DecorrelatedJitterReconnectionPolicy::Ptr drp =
+          static_cast<DecorrelatedJitterReconnectionPolicy::Ptr>(reconnection_policy);
+      writer.Key("baseDelayMs");
+      writer.Uint(drp->base_delay_ms());
+      writer.Key("maxDelayMs");
+      writer.Uint(drp->max_delay_ms());
     }
     writer.EndObject(); // options
 
@@ -593,15 +712,12 @@ private:
   }
 
   void config_anti_patterns(ClientInsights::Writer& writer) {
-    StringPairVec config_anti_patterns = get_config_anti_patterns(
-        config_.default_profile(), config_.profiles(), initialized_policies_, hosts_,
-        config_.ssl_context(), config_.auth_provider());
-    if (!config_anti_patterns.empty()) {
+    if (!config_anti_patterns_.empty()) {
       writer.Key("configAntiPatterns");
       writer.StartObject();
 
-      for (StringPairVec::const_iterator it = config_anti_patterns.begin(),
-                                         end = config_anti_patterns.end();
+      for (StringPairVec::const_iterator it = config_anti_patterns_.begin(),
+                                         end = config_anti_patterns_.end();
            it != end; ++it) {
         writer.Key(it->first.c_str());
         writer.String(it->second.c_str());
@@ -613,7 +729,9 @@ private:
 
 private:
   // Startup message helper methods
-  void resolve_contact_points() {
+  // Returns true if any contact points are being resolved. The message is
+  // sent once they're resolved.
+  bool resolve_contact_points() {
     const AddressVec& contact_points = config_.contact_points();
     const int port = config_.port();
     MultiResolver::Ptr resolver;
@@ -639,8 +757,7 @@ private:
       }
     }
 
-    // NOTE: If no resolution is performed the startup message will be sent in
-    //       the destructor
+    return resolver.get() != NULL;
   }
 
   void on_resolve(MultiResolver* resolver) {
@@ -661,7 +778,8 @@ private:
       contact_points_resolved_[resolver->hostname()] = addresses; // Empty resolved addresses are OK
     }
 
-    dec_ref(); // Send startup message in destructor
+    capture_and_send();
+    dec_ref();
   }
 
   String get_local_address(const uv_tcp_t* tcp) const {
@@ -942,7 +1060,6 @@ private:
   }
 
 private:
-  const Connection::Ptr connection_;
   const String client_id_;
   const String session_id_;
   const Config config_;
@@ -952,13 +1069,165 @@ private:
 private:
   typedef Map<String, AddressSet> ResolvedHostMap;
   ResolvedHostMap contact_points_resolved_;
+
+private:
+  // Captured on the event loop
+  String initial_control_connection_;
+  int protocol_version_;
+  String local_address_;
+  StringVec data_centers_;
+  StringPairVec config_anti_patterns_;
+};
+
+/**
+ * The periodic status message. It's kept by the client insights object so
+ * that its buffer is reused for every message.
+ */
+class StatusMessageHandler : public InsightsMessageHandler {
+public:
+  typedef SharedRefPtr<StatusMessageHandler> Ptr;
+
+  StatusMessageHandler(const String& client_id, const String& session_id, const Metrics* metrics)
+      : InsightsMessageHandler(METADATA_STATUS_NAME)
+      , client_id_(client_id)
+      , session_id_(session_id)
+      , metrics_(metrics) {}
+
+  void send_message(const Connection::Ptr& connection, const HostMap& hosts) {
+    connection_ = connection;
+    control_connection_ = connection->resolved_address().to_string(true);
+
+    hosts_.clear();
+    for (HostMap::const_iterator it = hosts.begin(), end = hosts.end(); it != end; ++it) {
+      const Host::Ptr& host = it->second;
+      hosts_.push_back(HostStatus(it->first, host->connection_count(),
+                                  host->inflight_request_count()));
+    }
+
+    if (metrics_) {
+      metrics_->request_latencies.get_snapshot(&request_latencies_);
+      request_mean_rate_ = metrics_->request_rates.mean_rate();
+      request_one_minute_rate_ = metrics_->request_rates.one_minute_rate();
+      total_connections_ = metrics_->total_connections.sum();
+      connection_timeouts_ = metrics_->connection_timeouts.sum();
+      request_timeouts_ = metrics_->request_timeouts.sum();
+      retries_ = metrics_->retries.sum();
+      speculative_requests_ = metrics_->request_rates.speculative_request_count();
+    }
+
+    build_and_send();
+  }
+
+private:
+  struct HostStatus {
+    HostStatus(const Address& address, int connections, int inflight_requests)
+        : address(address)
+        , connections(connections)
+        , inflight_requests(inflight_requests) {}
+    Address address;
+    int connections;
+    int inflight_requests;
+  };
+
+  virtual void build_data(ClientInsights::Writer& writer) {
+    writer.Key("data");
+    writer.StartObject();
+
+    writer.Key("clientId");
+    writer.String(client_id_.c_str());
+    writer.Key("sessionId");
+    writer.String(session_id_.c_str());
+    writer.Key("controlConnection");
+    writer.String(control_connection_.c_str());
+
+    writer.Key("conntectedNodes");
+    writer.StartObject();
+    for (Vector<HostStatus>::const_iterator it = hosts_.begin(), end = hosts_.end(); it != end;
+         ++it) {
+      writer.Key(it->address.to_string(true).c_str());
+      writer.StartObject();
+      writer.Key("connections");
+      writer.Int(it->connections);
+      writer.Key("inFlightQueries");
+      writer.Int(it->inflight_requests);
+      writer.EndObject(); // address_with_port
+    }
+    writer.EndObject(); // connectedNodes
+
+    if (metrics_) {
+      driver_metrics(writer);
+    }
+
+    writer.EndObject(); // data
+  }
+
+  void driver_metrics(ClientInsights::Writer& writer) {
+    writer.Key("driverMetrics");
+    writer.StartObject();
+
+    writer.Key("requestLatencies"); // In microseconds
+    writer.StartObject();
+    writer.Key("min");
+    writer.Int64(request_latencies_.min);
+    writer.Key("max");
+    writer.Int64(request_latencies_.max);
+    writer.Key("mean");
+    writer.Int64(request_latencies_.mean);
+    writer.Key("median");
+    writer.Int64(request_latencies_.median);
+    writer.Key("percentile95th");
+    writer.Int64(request_latencies_.percentile_95th);
+    writer.Key("percentile99th");
+    writer.Int64(request_latencies_.percentile_99th);
+    writer.Key("percentile999th");
+    writer.Int64(request_latencies_.percentile_999th);
+    writer.EndObject(); // requestLatencies
+
+    writer.Key("requestMeanRate");
+    writer.Double(request_mean_rate_);
+    writer.Key("requestOneMinuteRate");
+    writer.Double(request_one_minute_rate_);
+    writer.Key("totalConnections");
+    writer.Int64(total_connections_);
+    writer.Key("connectionTimeouts");
+    writer.Int64(connection_timeouts_);
+    writer.Key("requestTimeouts");
+    writer.Int64(request_timeouts_);
+    writer.Key("retries");
+    writer.Int64(retries_);
+    writer.Key("speculativeRequests");
+    writer.Int64(speculative_requests_);
+
+    writer.EndObject(); // driverMetrics
+  }
+
+private:
+  const String client_id_;
+  const String session_id_;
+  const Metrics* const metrics_;
+
+private:
+  // Captured on the event loop
+  String control_connection_;
+  Vector<HostStatus> hosts_;
+  Metrics::Histogram::Snapshot request_latencies_;
+  double request_mean_rate_;
+  double request_one_minute_rate_;
+  int64_t total_connections_;
+  int64_t connection_timeouts_;
+  int64_t request_timeouts_;
+  int64_t retries_;
+  int64_t speculative_requests_;
 };
 
 ClientInsights::ClientInsights(const String& client_id, const String& session_id,
-                               unsigned interval_secs)
+                               unsigned interval_secs, const Metrics* metrics)
     : client_id_(client_id)
     , session_id_(session_id)
-    , interval_ms_(interval_secs * 1000) {}
+    , interval_ms_(interval_secs * 1000)
+    , status_message_handler_(new StatusMessageHandler(client_id, session_id, metrics)) {}
+
+ClientInsights::~ClientInsights() {}
 
 uint64_t ClientInsights::interval_ms(const VersionNumber& dse_server_version) const {
   // DSE v5.1.13+ (backported)
@@ -981,43 +1250,12 @@ void ClientInsights::send_startup_message(const Connection::Ptr& connection, con
 }
 
 void ClientInsights::send_status_message(const Connection::Ptr& connection, const HostMap& hosts) {
-  StringBuffer buffer;
-  Writer writer(buffer);
-
-  writer.StartObject();
-  metadata(writer, METADATA_STATUS_NAME);
-
-  writer.Key("data");
-  writer.StartObject();
-
-  writer.Key("clientId");
-  writer.String(client_id_.c_str());
-  writer.Key("sessionId");
-  writer.String(session_id_.c_str());
-  writer.Key("controlConnection");
-  writer.String(connection->resolved_address().to_string(true).c_str());
-
-  writer.Key("conntectedNodes");
-  writer.StartObject();
-  for (HostMap::const_iterator it = hosts.begin(), end = hosts.end(); it != end; ++it) {
-    String address_with_port = it->first.to_string(true);
-    const Host::Ptr& host = it->second;
-    writer.Key(address_with_port.c_str());
-    writer.StartObject();
-    writer.Key("connections");
-    writer.Int(host->connection_count());
-    writer.Key("inFlightQueries");
-    writer.Int(host->inflight_request_count());
-    writer.EndObject(); // address_with_port
+  if (status_message_handler_->is_building()) {
+    LOG_DEBUG("Skipping %s event message because the previous message is still being built",
+              METADATA_STATUS_NAME);
+    return;
   }
-  writer.EndObject(); // connectedNodes
-
-  writer.EndObject(); // data
-  writer.EndObject();
-
-  assert(writer.IsComplete() && "Status JSON is incomplete");
-  connection->write_and_flush(RequestCallback::Ptr(
-      new ClientInsightsRequestCallback(buffer.GetString(), METADATA_STATUS_NAME)));
+  status_message_handler_->send_message(connection, hosts);
 }
 
 }}} // namespace datastax::internal::enterprise
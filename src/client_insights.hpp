@@ -20,20 +20,23 @@
 #include "config.hpp"
 #include "json.hpp"
 #include "monitor_reporting.hpp"
+#include "ref_counted.hpp"
 #include "resolver.hpp"
 
 namespace datastax { namespace internal { namespace enterprise {
 
 class ClientInsightsRequestCallback;
 class StartupMessageHandler;
+class StatusMessageHandler;
 
 class ClientInsights : public core::MonitorReporting {
 public:
   typedef json::StringBuffer StringBuffer;
   typedef json::Writer<StringBuffer> Writer;
 
-  ClientInsights(const String& client_id, const String& session_id, unsigned interval_secs);
-  virtual ~ClientInsights() {}
+  ClientInsights(const String& client_id, const String& session_id, unsigned interval_secs,
+                 const core::Metrics* metrics = NULL);
+  virtual ~ClientInsights();
 
   virtual uint64_t interval_ms(const core::VersionNumber& dse_server_version) const;
   virtual void send_startup_message(const core::Connection::Ptr& connection,
@@ -46,6 +49,7 @@ private:
   const String client_id_;
   const String session_id_;
   const uint64_t interval_ms_;
+  SharedRefPtr<StatusMessageHandler> status_message_handler_;
 };
 
 }}} // namespace datastax::internal::enterprise
@@ -37,6 +37,7 @@ using namespace datastax::internal::core;
 #define METADATA_SERVER_PATH "/metadata?version=1"
 
 #define METADATA_SERVER_PORT 30443
+#define SNI_PROXY_MAX_CONCURRENT_HANDSHAKES 8
 #define RESPONSE_BODY_TRUNCATE_LENGTH 1024
 
 #ifdef HAVE_ZLIB
@@ -91,15 +92,28 @@ namespace {
 class CloudClusterMetadataResolver : public ClusterMetadataResolver {
 public:
   CloudClusterMetadataResolver(const String& host, int port, const SocketSettings& settings,
-                               uint64_t request_timeout_ms)
+                               uint64_t request_timeout_ms, const String& cache_file)
       : client_(new HttpClient(Address(host, port), METADATA_SERVER_PATH,
-                               bind_callback(&CloudClusterMetadataResolver::on_response, this))) {
+                               bind_callback(&CloudClusterMetadataResolver::on_response, this)))
+      , cache_file_(cache_file)
+      , is_resolved_(false) {
     client_->with_settings(settings)->with_request_timeout_ms(request_timeout_ms);
+    OStringStream ss;
+    ss << host << ":" << port;
+    cache_key_ = ss.str();
   }
 
 private:
   virtual void internal_resolve(uv_loop_t* loop, const AddressVec& contact_points) {
     inc_ref();
+    if (load_cached_metadata()) {
+      // Connect using the cached metadata right away and refresh the cache
+      // for the next time in the background
+      LOG_INFO("Using cloud metadata cached in \"%s\"; refreshing it in the background",
+               cache_file_.c_str());
+      is_resolved_ = true;
+      callback_(this);
+    }
     client_->request(loop);
   }
 
@@ -109,7 +123,15 @@ private:
   void on_response(HttpClient* http_client) {
     if (http_client->is_ok()) {
       if (http_client->content_type().find("json") != std::string::npos) {
-        parse_metadata(http_client->response_body());
+        AddressVec contact_points;
+        String local_dc;
+        if (parse_metadata(http_client->response_body(), &contact_points, &local_dc)) {
+          save_cached_metadata(http_client->response_body());
+        }
+        if (!is_resolved_) {
+          resolved_contact_points_ = contact_points;
+          local_dc_ = local_dc;
+        }
       } else {
         LOG_ERROR(METADATA_SERVER_ERROR "Invalid response content type: '%s'",
                   http_client->content_type().c_str());
@@ -133,37 +155,66 @@ private:
       }
     }
 
-    callback_(this);
+    if (!is_resolved_) {
+      callback_(this);
+    }
     dec_ref();
   }
 
-  void parse_metadata(const String& response_body) {
+  bool load_cached_metadata() {
+    if (cache_file_.empty()) return false;
+
+    // The cached response is prefixed by the metadata service's address so
+    // that a cache written for another bundle isn't used
+    String contents;
+    if (!read_file(cache_file_, &contents)) {
+      LOG_DEBUG("Unable to read cloud metadata cache file \"%s\"", cache_file_.c_str());
+      return false;
+    }
+    size_t pos = contents.find('\n');
+    if (pos == String::npos || contents.compare(0, pos, cache_key_) != 0) {
+      LOG_INFO("Ignoring cloud metadata cache file \"%s\" written for a different bundle",
+               cache_file_.c_str());
+      return false;
+    }
+    return parse_metadata(contents.substr(pos + 1), &resolved_contact_points_, &local_dc_);
+  }
+
+  void save_cached_metadata(const String& response_body) {
+    if (cache_file_.empty()) return;
+    if (!write_file(cache_file_, cache_key_ + "\n" + response_body)) {
+      LOG_WARN("Unable to write cloud metadata cache file \"%s\"", cache_file_.c_str());
+    }
+  }
+
+  static bool parse_metadata(const String& response_body, AddressVec* resolved_contact_points,
+                             String* local_dc) {
     json::Document document;
     document.Parse(response_body.c_str());
 
     if (!document.IsObject()) {
       LOG_ERROR(METADATA_SERVER_ERROR "Metadata JSON is invalid");
-      return;
+      return false;
     }
 
     if (!document.HasMember("contact_info") || !document["contact_info"].IsObject()) {
       LOG_ERROR(METADATA_SERVER_ERROR "Contact information is not available");
-      return;
+      return false;
     }
 
     const json::Value& contact_info = document["contact_info"];
 
     if (!contact_info.HasMember("local_dc") || !contact_info["local_dc"].IsString()) {
       LOG_ERROR(METADATA_SERVER_ERROR "Local DC is not available");
-      return;
+      return false;
     }
 
-    local_dc_ = contact_info["local_dc"].GetString();
+    *local_dc = contact_info["local_dc"].GetString();
 
     if (!contact_info.HasMember("sni_proxy_address") ||
         !contact_info["sni_proxy_address"].IsString()) {
       LOG_ERROR(METADATA_SERVER_ERROR "SNI proxy address is not available");
-      return;
+      return false;
     }
 
     int sni_port = METADATA_SERVER_PORT;
@@ -180,20 +231,24 @@ private:
 
     if (!contact_info.HasMember("contact_points") || !contact_info["contact_points"].IsArray()) {
       LOG_ERROR(METADATA_SERVER_ERROR "Contact points are not available");
-      return;
+      return false;
     }
 
     const json::Value& contact_points = contact_info["contact_points"];
     for (rapidjson::SizeType i = 0; i < contact_points.Size(); ++i) {
       if (contact_points[i].IsString()) {
         String host_id = contact_points[i].GetString();
-        resolved_contact_points_.push_back(Address(sni_address, sni_port, host_id));
+        resolved_contact_points->push_back(Address(sni_address, sni_port, host_id));
       }
     }
+    return !resolved_contact_points->empty();
   }
 
 private:
   HttpClient::Ptr client_;
+  String cache_key_;
+  const String cache_file_;
+  bool is_resolved_; // Resolved using the cached metadata
 };
 
 class CloudClusterMetadataResolverFactory : public ClusterMetadataResolverFactory {
@@ -205,7 +260,8 @@ public:
   virtual ClusterMetadataResolver::Ptr new_instance(const ClusterSettings& settings) const {
     return ClusterMetadataResolver::Ptr(new CloudClusterMetadataResolver(
         host_, port_, settings.control_connection_settings.connection_settings.socket_settings,
-        settings.control_connection_settings.connection_settings.connect_timeout_ms));
+        settings.control_connection_settings.connection_settings.connect_timeout_ms,
+        settings.cloud_metadata_cache_file));
   }
 
   virtual const char* name() const { return "Cloud"; }
@@ -290,6 +346,9 @@ bool CloudSecureConnectionConfig::load(const String& filename, Config* config /*
     SslContext::Ptr ssl_context(SslContextFactory::create());
 
     ssl_context->set_verify_flags(CASS_SSL_VERIFY_PEER_CERT | CASS_SSL_VERIFY_PEER_IDENTITY_DNS);
+    // All the connections go through the SNI proxy. Limiting the handshakes
+    // in progress lets most of them resume a session instead.
+    ssl_context->set_max_concurrent_handshakes(SNI_PROXY_MAX_CONCURRENT_HANDSHAKES);
 
     if (ssl_context->add_trusted_cert(ca_cert_.c_str(), ca_cert_.length()) != CASS_OK) {
       LOG_ERROR(CLOUD_ERROR "Invalid CA certificate %s", CERTIFICATE_AUTHORITY_FILE);
@@ -20,6 +20,7 @@
 #include "dc_aware_policy.hpp"
 #include "rack_aware_policy.hpp"
 #include "external.hpp"
+#include "get_time.hpp"
 #include "logger.hpp"
 #include "resolver.hpp"
 #include "round_robin_policy.hpp"
@@ -29,6 +30,10 @@
 using namespace datastax;
 using namespace datastax::internal::core;
 
+// The longest a host is avoided by prepared statements while they're
+// prepared again, in case the preparation never finishes
+#define MAX_REPREPARE_DURATION_MS 10000
+
 namespace datastax { namespace internal { namespace core {
 
 /**
@@ -91,14 +96,16 @@ private:
 class ClusterStartClientMonitor : public Task {
 public:
   ClusterStartClientMonitor(const Cluster::Ptr& cluster, const String& client_id,
-                            const String& session_id, const Config& config)
+                            const String& session_id, const Config& config,
+                            const Metrics* metrics)
       : cluster_(cluster)
       , client_id_(client_id)
       , session_id_(session_id)
-      , config_(config) {}
+      , config_(config)
+      , metrics_(metrics) {}
 
   void run(EventLoop* event_loop) {
-    cluster_->internal_start_monitor_reporting(client_id_, session_id_, config_);
+    cluster_->internal_start_monitor_reporting(client_id_, session_id_, config_, metrics_);
   }
 
 private:
@@ -106,6 +113,65 @@ private:
   String client_id_;
   String session_id_;
   Config config_;
+  const Metrics* metrics_;
+};
+
+class ClusterStartMetricsMerging : public Task {
+public:
+  ClusterStartMetricsMerging(const Cluster::Ptr& cluster, Metrics* metrics, unsigned interval_ms)
+      : cluster_(cluster)
+      , metrics_(metrics)
+      , interval_ms_(interval_ms) {}
+
+  void run(EventLoop* event_loop) {
+    cluster_->internal_start_metrics_merging(metrics_, interval_ms_);
+  }
+
+private:
+  Cluster::Ptr cluster_;
+  Metrics* metrics_;
+  unsigned interval_ms_;
+};
+
+class ClusterReprepareHost : public Task {
+public:
+  ClusterReprepareHost(const Cluster::Ptr& cluster, const Host::Ptr& host)
+      : cluster_(cluster)
+      , host_(host) {}
+
+  void run(EventLoop* event_loop) { cluster_->internal_reprepare_host(host_); }
+
+private:
+  Cluster::Ptr cluster_;
+  Host::Ptr host_;
+};
+
+/**
+ * A chained request callback that gets the schema metadata that was deferred
+ * during startup.
+ */
+class DeferredSchemaRequestCallback : public ChainedRequestCallback {
+public:
+  DeferredSchemaRequestCallback(const String& key, const String& query,
+                                const Cluster::Ptr& cluster)
+      : ChainedRequestCallback(key, query)
+      , cluster_(cluster) {}
+
+  virtual void on_chain_set() { cluster_->handle_deferred_schema(this); }
+
+  virtual void on_chain_error(CassError code, const String& message) {
+    LOG_ERROR("Error running deferred schema queries on control connection: %s",
+              message.c_str());
+    cluster_->handle_deferred_schema(NULL);
+  }
+
+  virtual void on_chain_timeout() {
+    LOG_ERROR("Timed out running deferred schema queries on control connection");
+    cluster_->handle_deferred_schema(NULL);
+  }
+
+private:
+  Cluster::Ptr cluster_;
 };
 
 /**
@@ -163,7 +229,8 @@ void ClusterEvent::process_events(const ClusterEvent::Vec& events, ClusterListen
 static NopClusterListener nop_cluster_listener__;
 
 LockedHostMap::LockedHostMap(const HostMap& hosts)
-    : hosts_(hosts) {
+    : hosts_(hosts)
+    , version_(0) {
   uv_mutex_init(&mutex_);
 }
 
@@ -193,6 +260,24 @@ Host::Ptr LockedHostMap::get(const Address& address) const {
 void LockedHostMap::erase(const Address& address) {
   ScopedMutex l(&mutex_);
   hosts_.erase(address);
+  ++version_;
+}
+
+void LockedHostMap::set(const Address& address, const Host::Ptr& host) {
+  ScopedMutex l(&mutex_);
+  hosts_[address] = host;
+  ++version_;
+}
+
+HostMap LockedHostMap::copy(uint64_t* version) const {
+  ScopedMutex l(&mutex_);
+  *version = version_;
+  return hosts_;
+}
+
+uint64_t LockedHostMap::version() const {
+  ScopedMutex l(&mutex_);
+  return version_;
 }
 
 Host::Ptr& LockedHostMap::operator[](const Address& address) {
@@ -203,6 +288,7 @@ Host::Ptr& LockedHostMap::operator[](const Address& address) {
 LockedHostMap& LockedHostMap::operator=(const HostMap& hosts) {
   ScopedMutex l(&mutex_);
   hosts_ = hosts;
+  ++version_;
   return *this;
 }
 
@@ -211,8 +297,12 @@ ClusterSettings::ClusterSettings()
     , port(CASS_DEFAULT_PORT)
     , reconnection_policy(new ExponentialReconnectionPolicy())
     , prepare_on_up_or_add_host(CASS_DEFAULT_PREPARE_ON_UP_OR_ADD_HOST)
+    , prepare_on_unprepared_host(CASS_DEFAULT_PREPARE_ON_UNPREPARED_HOST)
     , max_prepares_per_flush(CASS_DEFAULT_MAX_PREPARES_PER_FLUSH)
+    , max_prepared_statements(CASS_DEFAULT_MAX_PREPARED_STATEMENTS)
+    , host_probe_interval_ms(CASS_DEFAULT_HOST_PROBE_INTERVAL_MS)
     , disable_events_on_startup(false)
+    , use_parallel_startup(CASS_DEFAULT_USE_PARALLEL_STARTUP)
     , cluster_metadata_resolver_factory(new DefaultClusterMetadataResolverFactory()) {
   load_balancing_policies.push_back(load_balancing_policy);
 }
@@ -224,9 +314,14 @@ ClusterSettings::ClusterSettings(const Config& config)
     , port(config.port())
     , reconnection_policy(config.reconnection_policy())
     , prepare_on_up_or_add_host(config.prepare_on_up_or_add_host())
+    , prepare_on_unprepared_host(config.prepare_on_unprepared_host())
     , max_prepares_per_flush(CASS_DEFAULT_MAX_PREPARES_PER_FLUSH)
+    , max_prepared_statements(config.max_prepared_statements())
+    , host_probe_interval_ms(config.host_probe_interval_ms())
     , disable_events_on_startup(false)
-    , cluster_metadata_resolver_factory(config.cluster_metadata_resolver_factory()) {}
+    , use_parallel_startup(config.use_parallel_startup())
+    , cluster_metadata_resolver_factory(config.cluster_metadata_resolver_factory())
+    , cloud_metadata_cache_file(config.cloud_metadata_cache_file()) {}
 
 Cluster::Cluster(const ControlConnection::Ptr& connection, ClusterListener* listener,
                  EventLoop* event_loop, const Host::Ptr& connected_host, const HostMap& hosts,
@@ -244,10 +339,18 @@ Cluster::Cluster(const ControlConnection::Ptr& connection, ClusterListener* list
     , is_closing_(false)
     , connected_host_(connected_host)
     , hosts_(hosts)
+    , is_schema_pending_(false)
+    , deferred_schema_start_time_(0)
+    , deferred_schema_time_(0)
+    , prepared_metadata_(settings.max_prepared_statements)
     , local_dc_(local_dc)
     , local_rack_(local_rack)
     , supported_options_(supported_options)
-    , is_recording_events_(settings.disable_events_on_startup) {
+    , is_recording_events_(settings.disable_events_on_startup)
+    , merged_metrics_(NULL)
+    , metrics_merge_interval_ms_(0)
+    , is_token_map_update_pending_(false) {
+  uv_mutex_init(&host_table_mutex_);
   inc_ref();
   connection_->set_listener(this);
 
@@ -256,9 +359,16 @@ Cluster::Cluster(const ControlConnection::Ptr& connection, ClusterListener* list
   update_schema(schema);
   update_token_map(hosts, connected_host_->partitioner(), schema);
 
+  if (schema.is_deferred) {
+    deferred_schema_version_ = schema.version;
+    query_deferred_schema();
+  }
+
   listener_->on_reconnect(this);
 }
 
+Cluster::~Cluster() { uv_mutex_destroy(&host_table_mutex_); }
+
 void Cluster::close() { event_loop_->add(new ClusterRunClose(Ptr(this))); }
 
 void Cluster::notify_host_up(const Address& address) {
@@ -272,8 +382,23 @@ void Cluster::notify_host_down(const Address& address) {
 void Cluster::start_events() { event_loop_->add(new ClusterStartEvents(Ptr(this))); }
 
 void Cluster::start_monitor_reporting(const String& client_id, const String& session_id,
-                                      const Config& config) {
-  event_loop_->add(new ClusterStartClientMonitor(Ptr(this), client_id, session_id, config));
+                                      const Config& config, const Metrics* metrics) {
+  event_loop_->add(
+      new ClusterStartClientMonitor(Ptr(this), client_id, session_id, config, metrics));
+}
+
+void Cluster::start_metrics_merging(Metrics* metrics, unsigned interval_ms) {
+  event_loop_->add(new ClusterStartMetricsMerging(Ptr(this), metrics, interval_ms));
+}
+
+void Cluster::reprepare_host(const Host::Ptr& host) {
+  if (!settings_.prepare_on_unprepared_host) return;
+  // Only the first UNPREPARED response, from any of the IO threads, starts
+  // preparing the statements again
+  if (host->try_start_reprepare(get_time_monotonic_coarse_ns(),
+                                MAX_REPREPARE_DURATION_MS * NANOSECONDS_PER_MILLISECOND)) {
+    event_loop_->add(new ClusterReprepareHost(Ptr(this), host));
+  }
 }
 
 Metadata::SchemaSnapshot Cluster::schema_snapshot() { return metadata_.schema_snapshot(); }
@@ -288,6 +413,14 @@ void Cluster::prepared(const String& id, const PreparedMetadata::Entry::Ptr& ent
   prepared_metadata_.set(id, entry);
 }
 
+PreparedMetadata::Entry::Vec Cluster::prepared_entries() const {
+  return prepared_metadata_.copy();
+}
+
+void Cluster::prepared_metadata_metrics(PreparedMetadataMetrics* metrics) const {
+  prepared_metadata_.get_metrics(metrics);
+}
+
 HostMap Cluster::available_hosts() const {
   HostMap available;
   for (HostMap::const_iterator it = hosts_.begin(), end = hosts_.end(); it != end; ++it) {
@@ -298,6 +431,23 @@ HostMap Cluster::available_hosts() const {
   return available;
 }
 
+HostTable::ConstPtr Cluster::host_table() const {
+  ScopedMutex l(&host_table_mutex_);
+  if (!host_table_ || host_table_->version() != hosts_.version()) {
+    uint64_t version;
+    HostMap hosts(hosts_.copy(&version));
+    for (HostMap::iterator it = hosts.begin(); it != hosts.end();) {
+      if (is_host_ignored(it->second)) {
+        hosts.erase(it++);
+      } else {
+        ++it;
+      }
+    }
+    host_table_.reset(new HostTable(hosts, version));
+  }
+  return host_table_;
+}
+
 void Cluster::set_listener(ClusterListener* listener) {
   listener_ = listener ? listener : &nop_cluster_listener__;
 }
@@ -323,38 +473,61 @@ void Cluster::update_hosts(const HostMap& hosts) {
 }
 
 void Cluster::update_schema(const ControlConnectionSchema& schema) {
+  // The existing metadata is kept up to date by schema change events so it
+  // only needs to be rebuilt when the schema version has diverged.
+  if (schema.is_unchanged) return;
+
+  // A deferred schema only contains the keyspaces so its version can't be
+  // used to skip a full schema refresh.
+  schema_version_ = schema.is_deferred ? String() : schema.version;
+  schema_server_version_ = connection_->server_version();
+
   metadata_.clear_and_update_back(connection_->server_version());
 
   if (schema.keyspaces) {
     metadata_.update_keyspaces(schema.keyspaces.get(), false);
   }
 
-  if (schema.tables) {
-    metadata_.update_tables(schema.tables.get());
-  }
+  if (settings_.control_connection_settings.use_lazy_schema) {
+    // The keyspaces' elements are built from the retained rows when they're
+    // first accessed.
+    SchemaRows::Ptr rows(new SchemaRows(connection_->server_version()));
+    rows->tables = schema.tables;
+    rows->views = schema.views;
+    rows->columns = schema.columns;
+    rows->indexes = schema.indexes;
+    rows->user_types = schema.user_types;
+    rows->functions = schema.functions;
+    rows->aggregates = schema.aggregates;
+    metadata_.set_lazy_keyspaces(rows);
+  } else {
+    if (schema.tables) {
+      metadata_.update_tables(schema.tables.get());
+    }
 
-  if (schema.views) {
-    metadata_.update_views(schema.views.get());
-  }
+    if (schema.views) {
+      metadata_.update_views(schema.views.get());
+    }
 
-  if (schema.columns) {
-    metadata_.update_columns(schema.columns.get());
-  }
+    if (schema.columns) {
+      metadata_.update_columns(schema.columns.get());
+    }
 
-  if (schema.indexes) {
-    metadata_.update_indexes(schema.indexes.get());
-  }
+    if (schema.indexes) {
+      metadata_.update_indexes(schema.indexes.get());
+    }
 
-  if (schema.user_types) {
-    metadata_.update_user_types(schema.user_types.get());
-  }
+    if (schema.user_types) {
+      metadata_.update_user_types(schema.user_types.get());
+    }
 
-  if (schema.functions) {
-    metadata_.update_functions(schema.functions.get());
-  }
+    if (schema.functions) {
+      metadata_.update_functions(schema.functions.get());
+    }
 
-  if (schema.aggregates) {
-    metadata_.update_aggregates(schema.aggregates.get());
+    if (schema.aggregates) {
+      metadata_.update_aggregates(schema.aggregates.get());
+    }
   }
 
   if (schema.virtual_keyspaces) {
@@ -381,6 +554,11 @@ void Cluster::update_token_map(const HostMap& hosts, const String& partitioner,
       return; // Partition is not supported
     }
     token_map_->add_keyspaces(connection_->server_version(), schema.keyspaces.get());
+    size_t token_count = 0;
+    for (HostMap::const_iterator it = hosts.begin(), end = hosts.end(); it != end; ++it) {
+      token_count += it->second->tokens().size();
+    }
+    token_map_->reserve_tokens(token_count);
     for (HostMap::const_iterator it = hosts.begin(), end = hosts.end(); it != end; ++it) {
       token_map_->add_host(it->second);
     }
@@ -392,6 +570,32 @@ void Cluster::update_token_map(const HostMap& hosts, const String& partitioner,
 // balancing policies (LBP) so that LBPs return the correct host distance (esp.
 // important for DC-aware). This method prevents connection pools from being
 // created to ignored hosts.
+void Cluster::copy_token_map() {
+  // The pending token map hasn't been handed out yet so it can be updated in
+  // place.
+  if (!is_token_map_update_pending_) {
+    token_map_ = token_map_->copy();
+  }
+}
+
+void Cluster::notify_token_map_updated() {
+  unsigned window_ms = settings_.control_connection_settings.event_debounce_window_ms;
+  if (window_ms == 0) {
+    notify_or_record(ClusterEvent(token_map_));
+  } else if (!is_token_map_update_pending_) {
+    is_token_map_update_pending_ = true;
+    token_map_timer_.start(event_loop_->loop(), window_ms,
+                           bind_callback(&Cluster::on_token_map_timer, this));
+  }
+}
+
+void Cluster::on_token_map_timer(Timer* timer) {
+  is_token_map_update_pending_ = false;
+  if (!is_closing_ && token_map_) {
+    notify_or_record(ClusterEvent(token_map_));
+  }
+}
+
 bool Cluster::is_host_ignored(const Host::Ptr& host) const {
   return core::is_host_ignored(load_balancing_policies_, host);
 }
@@ -417,6 +621,7 @@ void Cluster::handle_schedule_reconnect() {
     reconnector_.reset(new ControlConnector(host, connection_->protocol_version(),
                                             bind_callback(&Cluster::on_reconnect, this)));
     reconnector_->with_settings(settings_.control_connection_settings)
+        ->with_schema_version(schema_version_, schema_server_version_)
         ->connect(connection_->loop());
   } else {
     // No more hosts, refresh the query plan and schedule a re-connection
@@ -449,6 +654,8 @@ void Cluster::on_reconnect(ControlConnector* connector) {
     update_token_map(connector->hosts(), connected_host_->partitioner(), connector->schema());
 
     // Notify the listener that we've built a new token map
+    token_map_timer_.stop();
+    is_token_map_update_pending_ = false;
     if (token_map_) {
       notify_or_record(ClusterEvent(token_map_));
     }
@@ -465,11 +672,46 @@ void Cluster::on_reconnect(ControlConnector* connector) {
   }
 }
 
+void Cluster::query_deferred_schema() {
+  is_schema_pending_ = true;
+  deferred_schema_start_time_ = uv_hrtime();
+
+  const VersionNumber& server_version = connection_->server_version();
+  ChainedRequestCallback::Ptr callback(new DeferredSchemaRequestCallback(
+      "keyspaces", ControlConnector::keyspaces_query(server_version), Ptr(this)));
+  callback = ControlConnector::chain_schema_queries(
+      callback, server_version, settings_.control_connection_settings);
+
+  if (connection_->write_and_flush(callback) < 0) {
+    LOG_ERROR("Unable to write deferred schema query to control connection");
+    handle_deferred_schema(NULL);
+  }
+}
+
+void Cluster::handle_deferred_schema(const ChainedRequestCallback* callback) {
+  if (!is_schema_pending_) return;
+
+  deferred_schema_time_ = uv_hrtime() - deferred_schema_start_time_;
+  is_schema_pending_ = false;
+
+  if (callback && !is_closing_) {
+    ControlConnectionSchema schema;
+    schema.set(callback);
+    schema.version = deferred_schema_version_;
+    update_schema(schema);
+  }
+
+  listener_->on_schema_ready(this);
+}
+
 void Cluster::internal_close() {
   is_closing_ = true;
   bool was_timer_running = timer_.is_running();
   timer_.stop();
   monitor_reporting_timer_.stop();
+  metrics_merge_timer_.stop();
+  stop_probes();
+  token_map_timer_.stop();
   if (was_timer_running) {
     handle_close();
   } else if (reconnector_) {
@@ -499,6 +741,7 @@ void Cluster::internal_notify_host_up(const Address& address) {
   }
 
   Host::Ptr host(it->second);
+  probe_addresses_.erase(host->address());
 
   if (load_balancing_policy_->is_host_up(address)) {
     // Already marked up so don't repeat duplicate notifications.
@@ -552,6 +795,11 @@ void Cluster::internal_notify_host_down(const Address& address) {
   }
 
   notify_or_record(ClusterEvent(ClusterEvent::HOST_DOWN, host));
+
+  if (settings_.host_probe_interval_ms > 0) {
+    probe_addresses_.insert(host->address());
+    schedule_probes();
+  }
 }
 
 void Cluster::internal_start_events() {
@@ -564,8 +812,8 @@ void Cluster::internal_start_events() {
 }
 
 void Cluster::internal_start_monitor_reporting(const String& client_id, const String& session_id,
-                                               const Config& config) {
-  monitor_reporting_.reset(create_monitor_reporting(client_id, session_id, config));
+                                               const Config& config, const Metrics* metrics) {
+  monitor_reporting_.reset(create_monitor_reporting(client_id, session_id, config, metrics));
 
   if (!is_closing_ && monitor_reporting_->interval_ms(connection_->dse_server_version()) > 0) {
     monitor_reporting_->send_startup_message(connection_->connection(), config, available_hosts(),
@@ -576,6 +824,23 @@ void Cluster::internal_start_monitor_reporting(const String& client_id, const St
   }
 }
 
+void Cluster::internal_start_metrics_merging(Metrics* metrics, unsigned interval_ms) {
+  merged_metrics_ = metrics;
+  metrics_merge_interval_ms_ = interval_ms;
+  if (!is_closing_ && interval_ms > 0) {
+    metrics_merge_timer_.start(event_loop_->loop(), interval_ms,
+                               bind_callback(&Cluster::on_metrics_merge, this));
+  }
+}
+
+void Cluster::on_metrics_merge(Timer* timer) {
+  if (!is_closing_) {
+    merged_metrics_->merge_histograms();
+    metrics_merge_timer_.start(event_loop_->loop(), metrics_merge_interval_ms_,
+                               bind_callback(&Cluster::on_metrics_merge, this));
+  }
+}
+
 void Cluster::on_monitor_reporting(Timer* timer) {
   if (!is_closing_) {
     monitor_reporting_->send_status_message(connection_->connection(), available_hosts());
@@ -585,6 +850,81 @@ void Cluster::on_monitor_reporting(Timer* timer) {
   }
 }
 
+void Cluster::schedule_probes() {
+  if (!is_closing_ && !probe_timer_.is_running()) {
+    probe_timer_.start(event_loop_->loop(), settings_.host_probe_interval_ms,
+                       bind_callback(&Cluster::on_probe_timer, this));
+  }
+}
+
+void Cluster::stop_probes() {
+  probe_timer_.stop();
+  probe_addresses_.clear();
+  for (Connector::Vec::const_iterator it = probes_.begin(), end = probes_.end(); it != end; ++it) {
+    (*it)->cancel();
+  }
+}
+
+void Cluster::on_probe_timer(Timer* timer) {
+  if (is_closing_) return;
+
+  for (AddressSet::const_iterator it = probe_addresses_.begin(), end = probe_addresses_.end();
+       it != end; ++it) {
+    bool is_probing = false;
+    for (Connector::Vec::const_iterator i = probes_.begin(), probes_end = probes_.end();
+         i != probes_end; ++i) {
+      if ((*i)->address() == *it) {
+        is_probing = true; // Wait for the previous probe to finish
+        break;
+      }
+    }
+    if (is_probing) continue;
+
+    Host::Ptr host(hosts_.get(*it));
+    if (!host) continue; // Removed, the address is cleaned up by the remove
+
+    LOG_DEBUG("Probing host %s", host->address_string().c_str());
+    Connector::Ptr connector(new Connector(host, connection_->protocol_version(),
+                                           bind_callback(&Cluster::on_probe, Cluster::Ptr(this))));
+    connector->with_settings(settings_.control_connection_settings.connection_settings)
+        ->connect(event_loop_->loop());
+    probes_.push_back(connector);
+  }
+
+  if (!probe_addresses_.empty()) {
+    schedule_probes();
+  }
+}
+
+void Cluster::on_probe(Connector* connector) {
+  for (Connector::Vec::iterator it = probes_.begin(), end = probes_.end(); it != end; ++it) {
+    if (it->get() == connector) {
+      probes_.erase(it);
+      break;
+    }
+  }
+
+  if (!connector->is_ok()) {
+    if (!connector->is_canceled()) {
+      LOG_DEBUG("Probe of host %s failed: %s", connector->address().to_string().c_str(),
+                connector->error_message().c_str());
+    }
+    return;
+  }
+
+  connector->release_connection()->close();
+
+  if (is_closing_ || probe_addresses_.count(connector->address()) == 0) return;
+
+  // Treat the host the same way as an UP event from the control connection so
+  // that the connection pools attempt to reconnect right away. The host stays
+  // DOWN until a connection pool is connected.
+  LOG_INFO("Probe of host %s succeeded, attempting to reconnect",
+           connector->address().to_string().c_str());
+  probe_addresses_.erase(connector->address());
+  notify_or_record(ClusterEvent(ClusterEvent::HOST_MAYBE_UP, connector->host()));
+}
+
 void Cluster::notify_host_add(const Host::Ptr& host) {
   LockedHostMap::const_iterator host_it = hosts_.find(host->address());
 
@@ -600,7 +940,7 @@ void Cluster::notify_host_add(const Host::Ptr& host) {
     notify_or_record(ClusterEvent(ClusterEvent::HOST_REMOVE, host));
   }
 
-  hosts_[host->address()] = host;
+  hosts_.set(host->address(), host);
   for (LoadBalancingPolicy::Vec::const_iterator it = load_balancing_policies_.begin(),
                                                 end = load_balancing_policies_.end();
        it != end; ++it) {
@@ -618,9 +958,9 @@ void Cluster::notify_host_add(const Host::Ptr& host) {
 
 void Cluster::notify_host_add_after_prepare(const Host::Ptr& host) {
   if (token_map_) {
-    token_map_ = token_map_->copy();
+    copy_token_map();
     token_map_->update_host_and_build(host);
-    notify_or_record(ClusterEvent(token_map_));
+    notify_token_map_updated();
   }
   notify_or_record(ClusterEvent(ClusterEvent::HOST_ADD, host));
 }
@@ -636,9 +976,9 @@ void Cluster::notify_host_remove(const Address& address) {
   Host::Ptr host(it->second);
 
   if (token_map_) {
-    token_map_ = token_map_->copy();
+    copy_token_map();
     token_map_->remove_host_and_build(host);
-    notify_or_record(ClusterEvent(token_map_));
+    notify_token_map_updated();
   }
 
   // If not marked down yet then explicitly trigger the event.
@@ -646,6 +986,7 @@ void Cluster::notify_host_remove(const Address& address) {
     notify_or_record(ClusterEvent(ClusterEvent::HOST_DOWN, host));
   }
 
+  probe_addresses_.erase(host->address());
   hosts_.erase(it->first);
   for (LoadBalancingPolicy::Vec::const_iterator it = load_balancing_policies_.begin(),
                                                 end = load_balancing_policies_.end();
@@ -677,6 +1018,25 @@ bool Cluster::prepare_host(const Host::Ptr& host, const PrepareHostHandler::Call
   return false;
 }
 
+void Cluster::internal_reprepare_host(const Host::Ptr& host) {
+  if (!connection_ || is_closing_) {
+    host->finish_reprepare();
+    return;
+  }
+  LOG_INFO("Host %s responded with UNPREPARED. Preparing the cached prepared statements again",
+           host->address_string().c_str());
+  PrepareHostHandler::Ptr prepare_host_handler(
+      new PrepareHostHandler(host, prepared_metadata_.copy(),
+                             bind_callback(&Cluster::on_reprepare_host, Cluster::Ptr(this)),
+                             connection_->protocol_version(), settings_.max_prepares_per_flush));
+  prepare_host_handler->prepare(connection_->loop(),
+                                settings_.control_connection_settings.connection_settings);
+}
+
+void Cluster::on_reprepare_host(const PrepareHostHandler* handler) {
+  handler->host()->finish_reprepare();
+}
+
 void Cluster::on_prepare_host_add(const PrepareHostHandler* handler) {
   notify_host_add_after_prepare(handler->host());
 }
@@ -692,9 +1052,9 @@ void Cluster::on_update_schema(SchemaType type, const ResultResponse::Ptr& resul
       // Virtual keyspaces are not updated (always false)
       metadata_.update_keyspaces(result.get(), false);
       if (token_map_) {
-        token_map_ = token_map_->copy();
+        copy_token_map();
         token_map_->update_keyspaces_and_build(connection_->server_version(), result.get());
-        notify_or_record(ClusterEvent(token_map_));
+        notify_token_map_updated();
       }
       break;
     case TABLE:
@@ -727,9 +1087,9 @@ void Cluster::on_drop_schema(SchemaType type, const String& keyspace_name,
     case KEYSPACE:
       metadata_.drop_keyspace(keyspace_name);
       if (token_map_) {
-        token_map_ = token_map_->copy();
+        copy_token_map();
         token_map_->drop_keyspace(keyspace_name);
-        notify_or_record(ClusterEvent(token_map_));
+        notify_token_map_updated();
       }
       break;
     case TABLE:
@@ -49,6 +49,20 @@ public:
   Host::Ptr get(const Address& address) const;
 
   void erase(const Address& address);
+  void set(const Address& address, const Host::Ptr& host);
+
+  /**
+   * Copy the hosts and the version they're at.
+   *
+   * @param version The version of the copied hosts (output).
+   * @return A copy of the hosts.
+   */
+  HostMap copy(uint64_t* version) const;
+
+  /**
+   * The version is incremented each time the hosts change.
+   */
+  uint64_t version() const;
 
   Host::Ptr& operator[](const Address& address);
   LockedHostMap& operator=(const HostMap& hosts);
@@ -56,6 +70,7 @@ public:
 private:
   mutable uv_mutex_t mutex_;
   HostMap hosts_;
+  uint64_t version_;
 };
 
 /**
@@ -115,6 +130,14 @@ public:
    */
   virtual void on_reconnect(Cluster* cluster) {}
 
+  /**
+   * A callback that's called when the schema metadata that was deferred
+   * during startup has been retrieved (or failed to be retrieved).
+   *
+   * @param cluster The cluster object.
+   */
+  virtual void on_schema_ready(Cluster* cluster) {}
+
   /**
    * A callback that's called when the cluster has closed.
    *
@@ -203,23 +226,55 @@ struct ClusterSettings {
    */
   bool prepare_on_up_or_add_host;
 
+  /**
+   * If true then cached prepared statements are prepared again, in the
+   * background, on a host that responded with UNPREPARED.
+   */
+  bool prepare_on_unprepared_host;
+
   /**
    * Max number of requests to be written out to the socket per write system call.
    */
   unsigned max_prepares_per_flush;
 
+  /**
+   * The maximum number of prepared statements kept for preparing statements
+   * on hosts that come up or zero for no limit.
+   */
+  unsigned max_prepared_statements;
+
+  /**
+   * The interval between probes of the hosts that are down or zero to disable
+   * probes. A successful probe triggers an immediate reconnection attempt
+   * from the connection pools.
+   */
+  unsigned host_probe_interval_ms;
+
   /**
    * If true then events are disabled on startup. Events can be explicitly
    * started by calling `Cluster::start_events()`.
    */
   bool disable_events_on_startup;
 
+  /**
+   * If true then the initial control connection only queries the keyspaces
+   * and the cluster queries the rest of the schema after it's created. This
+   * allows the caller to connect to the hosts while the schema is retrieved.
+   */
+  bool use_parallel_startup;
+
   /**
    * A factory for creating cluster metadata resolvers. A cluster metadata resolver is used to
    * determine contact points and retrieve other metadata required to connect the
    * cluster.
    */
   ClusterMetadataResolverFactory::Ptr cluster_metadata_resolver_factory;
+
+  /**
+   * A file used to cache the metadata of a cloud cluster or empty to always
+   * wait for the metadata service.
+   */
+  String cloud_metadata_cache_file;
 };
 
 /**
@@ -262,6 +317,7 @@ public:
           const LoadBalancingPolicy::Vec& load_balancing_policies, const String& local_dc,
 	  const String& local_rack,
           const StringMultimap& supported_options, const ClusterSettings& settings);
+  ~Cluster();
 
   /**
    * Set the listener that will handle events for the cluster
@@ -305,9 +361,29 @@ public:
    * @param client_id Client ID associated with the session.
    * @param session_id Session ID associated with the session.
    * @param config The config object.
+   * @param metrics The session's metrics, included in the status messages. It
+   * can be NULL and it must outlive the cluster.
    */
   void start_monitor_reporting(const String& client_id, const String& session_id,
-                               const Config& config);
+                               const Config& config, const Metrics* metrics = NULL);
+
+  /**
+   * Periodically merge the values recorded by the IO threads into the
+   * session's latency histograms (thread-safe).
+   *
+   * @param metrics The session's metrics. It must outlive the cluster.
+   * @param interval_ms The interval between merges.
+   */
+  void start_metrics_merging(Metrics* metrics, unsigned interval_ms);
+
+  /**
+   * Prepare the cached prepared statements again on a host that responded
+   * with UNPREPARED (thread-safe). Requests for prepared statements avoid the
+   * host until the statements are prepared.
+   *
+   * @param host The host.
+   */
+  void reprepare_host(const Host::Ptr& host);
 
   /**
    * Get the latest snapshot of the schema metadata (thread-safe).
@@ -316,6 +392,13 @@ public:
    */
   Metadata::SchemaSnapshot schema_snapshot();
 
+  /**
+   * Get the version of the latest schema metadata (thread-safe and lock-free).
+   *
+   * @return The version a schema metadata snapshot has while it's up-to-date.
+   */
+  uint32_t schema_snapshot_version() const { return metadata_.schema_snapshot_version(); }
+
   /**
    * Look up a host by address (thread-safe).
    *
@@ -342,6 +425,20 @@ public:
    */
   void prepared(const String& id, const PreparedMetadata::Entry::Ptr& entry);
 
+  /**
+   * Get all the prepared metadata entries (thread-safe).
+   *
+   * @return A copy of the prepared metadata entries.
+   */
+  PreparedMetadata::Entry::Vec prepared_entries() const;
+
+  /**
+   * Get the metrics of the prepared metadata (thread-safe).
+   *
+   * @param metrics The prepared metadata metrics.
+   */
+  void prepared_metadata_metrics(PreparedMetadataMetrics* metrics) const;
+
   /**
    * Get available hosts (determined by host distance). This filters out ignored
    * hosts (*NOT* thread-safe).
@@ -350,6 +447,15 @@ public:
    */
   HostMap available_hosts() const;
 
+  /**
+   * Get a shared snapshot of the available hosts. The snapshot is only rebuilt
+   * when the hosts have changed since the last one was taken so it's cheap to
+   * share the same snapshot with many request processors (thread-safe).
+   *
+   * @return An immutable snapshot of the available hosts.
+   */
+  HostTable::ConstPtr host_table() const;
+
 public:
   ProtocolVersion protocol_version() const { return connection_->protocol_version(); }
   const Host::Ptr& connected_host() const { return connected_host_; }
@@ -359,12 +465,31 @@ public:
   const VersionNumber& dse_server_version() const { return connection_->dse_server_version(); }
   const StringMultimap& supported_options() const { return supported_options_; }
 
+  /**
+   * Determines if the schema metadata deferred during startup is still being
+   * retrieved (*NOT* thread-safe).
+   *
+   * @return true if the deferred schema hasn't been retrieved yet.
+   */
+  bool is_schema_pending() const { return is_schema_pending_; }
+
+  /**
+   * The time spent retrieving the deferred schema metadata in nanoseconds
+   * (*NOT* thread-safe).
+   *
+   * @return The time spent or 0 if the schema wasn't deferred.
+   */
+  uint64_t deferred_schema_time() const { return deferred_schema_time_; }
+
 private:
   friend class ClusterRunClose;
   friend class ClusterNotifyUp;
   friend class ClusterNotifyDown;
   friend class ClusterStartEvents;
   friend class ClusterStartClientMonitor;
+  friend class ClusterStartMetricsMerging;
+  friend class ClusterReprepareHost;
+  friend class DeferredSchemaRequestCallback;
 
 private:
   void update_hosts(const HostMap& hosts);
@@ -372,6 +497,10 @@ private:
   void update_token_map(const HostMap& hosts, const String& partitioner,
                         const ControlConnectionSchema& schema);
 
+  void copy_token_map();
+  void notify_token_map_updated();
+  void on_token_map_timer(Timer* timer);
+
   bool is_host_ignored(const Host::Ptr& host) const;
 
   void schedule_reconnect();
@@ -381,6 +510,9 @@ private:
 
   void on_reconnect(ControlConnector* connector);
 
+  void query_deferred_schema();
+  void handle_deferred_schema(const ChainedRequestCallback* callback);
+
 private:
   void internal_close();
   void handle_close();
@@ -392,10 +524,18 @@ private:
 
   void internal_start_events();
   void internal_start_monitor_reporting(const String& client_id, const String& session_id,
-                                        const Config& config);
+                                        const Config& config, const Metrics* metrics);
 
   void on_monitor_reporting(Timer* timer);
 
+  void internal_start_metrics_merging(Metrics* metrics, unsigned interval_ms);
+  void on_metrics_merge(Timer* timer);
+
+  void schedule_probes();
+  void stop_probes();
+  void on_probe_timer(Timer* timer);
+  void on_probe(Connector* connector);
+
   void notify_host_add(const Host::Ptr& host);
   void notify_host_add_after_prepare(const Host::Ptr& host);
 
@@ -410,6 +550,9 @@ private:
   void on_prepare_host_add(const PrepareHostHandler* handler);
   void on_prepare_host_up(const PrepareHostHandler* handler);
 
+  void internal_reprepare_host(const Host::Ptr& host);
+  void on_reprepare_host(const PrepareHostHandler* handler);
+
 private:
   // Control connection listener methods
 
@@ -439,7 +582,15 @@ private:
   bool is_closing_;
   Host::Ptr connected_host_;
   LockedHostMap hosts_;
+  mutable uv_mutex_t host_table_mutex_;
+  mutable HostTable::ConstPtr host_table_;
   Metadata metadata_;
+  String schema_version_;
+  VersionNumber schema_server_version_;
+  bool is_schema_pending_;
+  String deferred_schema_version_;
+  uint64_t deferred_schema_start_time_;
+  uint64_t deferred_schema_time_;
   PreparedMetadata prepared_metadata_;
   TokenMap::Ptr token_map_;
   String local_dc_;
@@ -450,7 +601,15 @@ private:
   ClusterEvent::Vec recorded_events_;
   ScopedPtr<MonitorReporting> monitor_reporting_;
   Timer monitor_reporting_timer_;
+  Metrics* merged_metrics_;
+  unsigned metrics_merge_interval_ms_;
+  Timer metrics_merge_timer_;
   ScopedPtr<ReconnectionSchedule> reconnection_schedule_;
+  AddressSet probe_addresses_; // Hosts that are down and waiting to be probed
+  Connector::Vec probes_;
+  Timer probe_timer_;
+  bool is_token_map_update_pending_; // The token map is updated but not handed out yet
+  Timer token_map_timer_;
 };
 
 }}} // namespace datastax::internal::core
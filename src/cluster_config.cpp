@@ -16,6 +16,9 @@
 
 #include "cluster_config.hpp"
 
+#include "compression.hpp"
+#include "driver_config.hpp"
+
 using namespace datastax;
 using namespace datastax::internal;
 using namespace datastax::internal::core;
@@ -101,6 +104,100 @@ CassError cass_cluster_set_num_threads_io(CassCluster* cluster, unsigned num_thr
   return CASS_OK;
 }
 
+CassError cass_cluster_set_num_threads_callback(CassCluster* cluster, unsigned num_threads) {
+  cluster->config().set_thread_count_callback(num_threads);
+  return CASS_OK;
+}
+
+void cass_cluster_set_callback_executor(CassCluster* cluster, CassCallbackExecutorSubmit submit,
+                                        void* data) {
+  cluster->config().set_callback_executor(submit, data);
+}
+
+CassError cass_cluster_set_work_stealing(CassCluster* cluster, cass_bool_t enabled) {
+  cluster->config().set_work_stealing(enabled == cass_true);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_io_uring(CassCluster* cluster, cass_bool_t enabled) {
+#ifdef HAVE_IO_URING
+  cluster->config().set_io_uring_enabled(enabled == cass_true);
+  return CASS_OK;
+#else
+  return enabled == cass_true ? CASS_ERROR_LIB_NOT_IMPLEMENTED : CASS_OK;
+#endif
+}
+
+CassError cass_cluster_set_busy_poll(CassCluster* cluster, cass_bool_t enabled,
+                                     unsigned socket_busy_poll_us) {
+#ifndef HAVE_SO_BUSY_POLL
+  if (socket_busy_poll_us > 0) {
+    return CASS_ERROR_LIB_NOT_IMPLEMENTED;
+  }
+#endif
+  cluster->config().set_busy_poll(enabled == cass_true, socket_busy_poll_us);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_io_thread_cpus(CassCluster* cluster, const unsigned* cpus,
+                                          size_t cpus_count) {
+  if (cpus == NULL && cpus_count > 0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+#if UV_VERSION_HEX < 0x012D00 // uv_thread_setaffinity() was added in libuv 1.45
+  if (cpus_count > 0) {
+    return CASS_ERROR_LIB_NOT_IMPLEMENTED;
+  }
+#endif
+  Vector<Vector<unsigned> > cpu_sets;
+  for (size_t i = 0; i < cpus_count; ++i) {
+    cpu_sets.push_back(Vector<unsigned>(1, cpus[i]));
+  }
+  cluster->config().set_io_thread_cpu_sets(cpu_sets);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_io_thread_cpu_sets(CassCluster* cluster, const unsigned* cpus,
+                                              const size_t* cpu_set_sizes,
+                                              size_t cpu_sets_count) {
+  if (cpu_sets_count > 0 && (cpus == NULL || cpu_set_sizes == NULL)) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  for (size_t i = 0; i < cpu_sets_count; ++i) {
+    if (cpu_set_sizes[i] == 0) {
+      return CASS_ERROR_LIB_BAD_PARAMS;
+    }
+  }
+#if UV_VERSION_HEX < 0x012D00 // uv_thread_setaffinity() was added in libuv 1.45
+  if (cpu_sets_count > 0) {
+    return CASS_ERROR_LIB_NOT_IMPLEMENTED;
+  }
+#endif
+  Vector<Vector<unsigned> > cpu_sets;
+  for (size_t i = 0; i < cpu_sets_count; ++i) {
+    cpu_sets.push_back(Vector<unsigned>(cpus, cpus + cpu_set_sizes[i]));
+    cpus += cpu_set_sizes[i];
+  }
+  cluster->config().set_io_thread_cpu_sets(cpu_sets);
+  return CASS_OK;
+}
+
+void cass_cluster_set_io_thread_numa_local(CassCluster* cluster, cass_bool_t enabled) {
+  cluster->config().set_io_thread_numa_local(enabled == cass_true);
+}
+
+void cass_cluster_set_huge_page_buffers(CassCluster* cluster, cass_bool_t enabled) {
+  cluster->config().set_huge_page_buffers(enabled == cass_true);
+}
+
+void cass_cluster_set_shared_runtime(CassCluster* cluster, cass_bool_t enabled) {
+  cluster->config().set_shared_runtime(enabled == cass_true);
+}
+
+void cass_cluster_set_runtime(CassCluster* cluster, CassRuntime* runtime) {
+  cluster->config().set_runtime(runtime);
+}
+
 CassError cass_cluster_set_queue_size_io(CassCluster* cluster, unsigned queue_size) {
   if (queue_size == 0) {
     return CASS_ERROR_LIB_BAD_PARAMS;
@@ -109,6 +206,31 @@ CassError cass_cluster_set_queue_size_io(CassCluster* cluster, unsigned queue_si
   return CASS_OK;
 }
 
+CassError cass_cluster_set_max_inflight_requests(CassCluster* cluster, unsigned num_requests) {
+  cluster->config().set_max_inflight_requests(num_requests);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_backpressure_mode(CassCluster* cluster, CassBackpressureMode mode) {
+  cluster->config().set_backpressure_mode(mode);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_producer_lanes(CassCluster* cluster, unsigned num_lanes) {
+  cluster->config().set_producer_lanes(num_lanes);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_memory_limit(CassCluster* cluster, cass_uint64_t limit_bytes) {
+  cluster->config().set_memory_limit(limit_bytes);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_request_arena_size(CassCluster* cluster, unsigned size) {
+  cluster->config().set_request_arena_size(size);
+  return CASS_OK;
+}
+
 CassError cass_cluster_set_queue_size_event(CassCluster* cluster, unsigned queue_size) {
   return CASS_OK;
 }
@@ -146,8 +268,18 @@ CassError cass_cluster_set_core_connections_per_host(CassCluster* cluster,
   return CASS_OK;
 }
 
+CassError cass_cluster_set_core_connections_per_remote_host(CassCluster* cluster,
+                                                            unsigned num_connections) {
+  if (num_connections == 0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_core_connections_per_remote_host(num_connections);
+  return CASS_OK;
+}
+
 CassError cass_cluster_set_max_connections_per_host(CassCluster* cluster,
                                                     unsigned num_connections) {
+  cluster->config().set_max_connections_per_host(num_connections);
   return CASS_OK;
 }
 
@@ -179,6 +311,54 @@ CassError cass_cluster_set_exponential_reconnect(CassCluster* cluster, cass_uint
   return CASS_OK;
 }
 
+CassError cass_cluster_set_decorrelated_jitter_reconnect(CassCluster* cluster,
+                                                         cass_uint64_t base_delay_ms,
+                                                         cass_uint64_t max_delay_ms) {
+  if (base_delay_ms == 0) {
+    LOG_ERROR("Base delay must be greater than 0");
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+
+  if (max_delay_ms < base_delay_ms) {
+    LOG_ERROR("Max delay cannot be less than base delay");
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_decorrelated_jitter_reconnect(base_delay_ms, max_delay_ms);
+  return CASS_OK;
+}
+
+void cass_cluster_set_max_concurrent_connect_attempts_per_host(CassCluster* cluster,
+                                                                unsigned max_attempts) {
+  cluster->config().set_max_concurrent_connect_attempts_per_host(max_attempts);
+}
+
+void cass_cluster_set_host_warmup_duration(CassCluster* cluster, cass_uint64_t duration_ms) {
+  cluster->config().set_host_warmup_duration_ms(duration_ms);
+}
+
+void cass_cluster_set_connection_warmup(CassCluster* cluster, unsigned requests_per_connection,
+                                        const char* query) {
+  cass_cluster_set_connection_warmup_n(cluster, requests_per_connection, query, SAFE_STRLEN(query));
+}
+
+void cass_cluster_set_connection_warmup_n(CassCluster* cluster, unsigned requests_per_connection,
+                                          const char* query, size_t query_length) {
+  cluster->config().set_connection_warmup(
+      requests_per_connection, query != NULL ? String(query, query_length) : String());
+}
+
+void cass_cluster_set_shard_awareness(CassCluster* cluster, cass_bool_t enabled) {
+  cluster->config().set_shard_awareness(enabled == cass_true);
+}
+
+void cass_cluster_set_host_probe_interval(CassCluster* cluster, unsigned interval_ms) {
+  cluster->config().set_host_probe_interval_ms(interval_ms);
+}
+
+void cass_cluster_set_event_debounce_window(CassCluster* cluster, unsigned window_ms) {
+  cluster->config().set_event_debounce_window_ms(window_ms);
+}
+
 CassError cass_cluster_set_coalesce_delay(CassCluster* cluster, cass_int64_t delay_us) {
   if (delay_us < 0) {
     return CASS_ERROR_LIB_BAD_PARAMS;
@@ -195,6 +375,22 @@ CassError cass_cluster_set_new_request_ratio(CassCluster* cluster, cass_int32_t
   return CASS_OK;
 }
 
+CassError cass_cluster_set_coalesce_mode(CassCluster* cluster, CassCoalesceMode mode) {
+  if (mode != CASS_COALESCE_MODE_FIXED && mode != CASS_COALESCE_MODE_ADAPTIVE) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_coalesce_mode(mode);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_coalesce_latency_budget(CassCluster* cluster, cass_uint64_t budget_us) {
+  if (budget_us == 0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_coalesce_latency_budget_us(budget_us);
+  return CASS_OK;
+}
+
 CassError cass_cluster_set_max_concurrent_creation(CassCluster* cluster, unsigned num_connections) {
   // Deprecated
   return CASS_OK;
@@ -202,7 +398,10 @@ CassError cass_cluster_set_max_concurrent_creation(CassCluster* cluster, unsigne
 
 CassError cass_cluster_set_max_concurrent_requests_threshold(CassCluster* cluster,
                                                              unsigned num_requests) {
-  // Deprecated
+  if (num_requests == 0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_max_concurrent_requests_threshold(num_requests);
   return CASS_OK;
 }
 
@@ -233,6 +432,11 @@ CassError cass_cluster_set_pending_requests_low_water_mark(CassCluster* cluster,
   return CASS_OK;
 }
 
+void cass_cluster_set_max_outstanding_write_bytes_per_connection(CassCluster* cluster,
+                                                                 unsigned num_bytes) {
+  cluster->config().set_max_outstanding_write_bytes_per_connection(num_bytes);
+}
+
 void cass_cluster_set_connect_timeout(CassCluster* cluster, unsigned timeout_ms) {
   cluster->config().set_connect_timeout(timeout_ms);
 }
@@ -245,10 +449,37 @@ void cass_cluster_set_resolve_timeout(CassCluster* cluster, unsigned timeout_ms)
   cluster->config().set_resolve_timeout(timeout_ms);
 }
 
+void cass_cluster_set_close_timeout(CassCluster* cluster, unsigned timeout_ms) {
+  cluster->config().set_close_timeout(timeout_ms);
+}
+
+void cass_cluster_set_host_drain_timeout(CassCluster* cluster, unsigned timeout_ms) {
+  cluster->config().set_host_drain_timeout(timeout_ms);
+}
+
+void cass_cluster_set_lazy_remote_pools(CassCluster* cluster, cass_bool_t enabled,
+                                        unsigned idle_timeout_secs) {
+  cluster->config().set_lazy_remote_pools(enabled == cass_true, idle_timeout_secs);
+}
+
+void cass_cluster_set_resolve_cache_ttl(CassCluster* cluster, unsigned ttl_ms,
+                                        unsigned negative_ttl_ms) {
+  cluster->config().set_resolve_cache_ttl(ttl_ms, negative_ttl_ms);
+}
+
 void cass_cluster_set_max_schema_wait_time(CassCluster* cluster, unsigned wait_time_ms) {
   cluster->config().set_max_schema_wait_time_ms(wait_time_ms);
 }
 
+CassError cass_cluster_set_schema_agreement_interval(CassCluster* cluster, unsigned interval_ms,
+                                                     unsigned max_interval_ms) {
+  if (interval_ms == 0 || max_interval_ms < interval_ms) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_schema_agreement_interval(interval_ms, max_interval_ms);
+  return CASS_OK;
+}
+
 void cass_cluster_set_tracing_max_wait_time(CassCluster* cluster, unsigned wait_time_ms) {
   cluster->config().set_max_tracing_wait_time_ms(wait_time_ms);
 }
@@ -261,6 +492,18 @@ void cass_cluster_set_tracing_consistency(CassCluster* cluster, CassConsistency
   cluster->config().set_tracing_consistency(consistency);
 }
 
+void cass_cluster_set_tracing_wait_for_data(CassCluster* cluster, cass_bool_t enabled) {
+  cluster->config().set_tracing_wait_for_data(enabled == cass_true);
+}
+
+CassError cass_cluster_set_tracing_probability(CassCluster* cluster, cass_double_t probability) {
+  if (!(probability >= 0.0 && probability <= 1.0)) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_tracing_probability(probability);
+  return CASS_OK;
+}
+
 void cass_cluster_set_credentials(CassCluster* cluster, const char* username,
                                   const char* password) {
   return cass_cluster_set_credentials_n(cluster, username, SAFE_STRLEN(username), password,
@@ -331,6 +574,25 @@ void cass_cluster_set_token_aware_routing_shuffle_replicas(CassCluster* cluster,
   cluster->config().set_token_aware_routing_shuffle_replicas(enabled == cass_true);
 }
 
+void cass_cluster_set_token_aware_routing_least_loaded_replicas(CassCluster* cluster,
+                                                                cass_bool_t enabled) {
+  cluster->config().set_token_aware_routing_least_loaded_replicas(enabled == cass_true);
+}
+
+void cass_cluster_set_connection_selection(CassCluster* cluster,
+                                           CassConnectionSelection selection) {
+  cluster->config().set_connection_selection(selection);
+}
+
+CassError cass_cluster_set_rate_limit(CassCluster* cluster, cass_double_t requests_per_second,
+                                      unsigned burst) {
+  if (requests_per_second < 0.0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_rate_limit(requests_per_second, burst);
+  return CASS_OK;
+}
+
 void cass_cluster_set_latency_aware_routing(CassCluster* cluster, cass_bool_t enabled) {
   cluster->config().set_latency_aware_routing(enabled == cass_true);
 }
@@ -408,6 +670,21 @@ void cass_cluster_set_tcp_keepalive(CassCluster* cluster, cass_bool_t enabled,
   cluster->config().set_tcp_keepalive(enabled == cass_true, delay_secs);
 }
 
+void cass_cluster_set_socket_buffer_sizes(CassCluster* cluster, unsigned receive_buffer_size,
+                                          unsigned send_buffer_size) {
+  cluster->config().set_socket_buffer_sizes(receive_buffer_size, send_buffer_size);
+}
+
+CassError cass_cluster_set_tcp_notsent_lowat(CassCluster* cluster, unsigned bytes) {
+#ifndef HAVE_TCP_NOTSENT_LOWAT
+  if (bytes > 0) {
+    return CASS_ERROR_LIB_NOT_IMPLEMENTED;
+  }
+#endif
+  cluster->config().set_tcp_notsent_lowat(bytes);
+  return CASS_OK;
+}
+
 CassError cass_cluster_set_authenticator_callbacks(
     CassCluster* cluster, const CassAuthenticatorCallbacks* exchange_callbacks,
     CassAuthenticatorDataCleanupCallback cleanup_callback, void* data) {
@@ -428,6 +705,87 @@ void cass_cluster_set_retry_policy(CassCluster* cluster, CassRetryPolicy* retry_
   cluster->config().set_retry_policy(retry_policy);
 }
 
+CassError cass_cluster_set_retry_budget(CassCluster* cluster, cass_double_t ratio) {
+  if (ratio < 0.0 || ratio > 1.0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_retry_budget_ratio(ratio);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_circuit_breaker(CassCluster* cluster, unsigned failure_threshold,
+                                           cass_uint64_t open_duration_ms) {
+  if (failure_threshold > 0 && open_duration_ms == 0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_circuit_breaker(failure_threshold, open_duration_ms);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_concurrency_limiter(CassCluster* cluster, unsigned min_limit,
+                                               unsigned max_limit,
+                                               cass_uint64_t latency_threshold_ms) {
+  if (max_limit > 0 && (min_limit == 0 || min_limit > max_limit || latency_threshold_ms == 0)) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_concurrency_limiter(min_limit, max_limit, latency_threshold_ms);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_frame_capture(CassCluster* cluster, const char* path,
+                                         size_t max_size_bytes) {
+  return cass_cluster_set_frame_capture_n(cluster, path, SAFE_STRLEN(path), max_size_bytes);
+}
+
+CassError cass_cluster_set_frame_capture_n(CassCluster* cluster, const char* path,
+                                           size_t path_length, size_t max_size_bytes) {
+  if (path_length == 0) {
+    cluster->config().set_frame_capture(FrameCapture::Ptr());
+    return CASS_OK;
+  }
+  if (max_size_bytes == 0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  FrameCapture::Ptr frame_capture(new FrameCapture(String(path, path_length), max_size_bytes));
+  if (!frame_capture->open()) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_frame_capture(frame_capture);
+  return CASS_OK;
+}
+
+void cass_cluster_set_host_and_profile_metrics(CassCluster* cluster, cass_bool_t enabled) {
+  cluster->config().set_host_and_profile_metrics(enabled == cass_true);
+}
+
+void cass_cluster_set_request_stage_metrics(CassCluster* cluster, cass_bool_t enabled) {
+  cluster->config().set_request_stage_metrics(enabled == cass_true);
+}
+
+void cass_cluster_set_metrics_snapshot_caching(CassCluster* cluster, unsigned merge_interval_ms,
+                                               unsigned max_age_ms) {
+  cluster->config().set_metrics_snapshot_caching(merge_interval_ms, max_age_ms);
+}
+
+CassError cass_cluster_set_slow_request_log(CassCluster* cluster, cass_uint64_t threshold_ms,
+                                            unsigned capacity) {
+  if (threshold_ms > 0 && capacity == 0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_slow_request_log(threshold_ms, capacity);
+  return CASS_OK;
+}
+
+void cass_cluster_set_slow_request_callback(CassCluster* cluster,
+                                            CassSlowRequestCallback callback, void* data) {
+  cluster->config().set_slow_request_callback(callback, data);
+}
+
+void cass_cluster_set_request_tracer(CassCluster* cluster, CassRequestTracerCallback callback,
+                                     void* data) {
+  cluster->config().set_request_tracer(callback, data);
+}
+
 void cass_cluster_set_timestamp_gen(CassCluster* cluster, CassTimestampGen* timestamp_gen) {
   cluster->config().set_timestamp_gen(timestamp_gen);
 }
@@ -436,6 +794,46 @@ void cass_cluster_set_use_schema(CassCluster* cluster, cass_bool_t enabled) {
   cluster->config().set_use_schema(enabled == cass_true);
 }
 
+void cass_cluster_set_use_lazy_schema(CassCluster* cluster, cass_bool_t enabled) {
+  cluster->config().set_use_lazy_schema(enabled == cass_true);
+}
+
+void cass_cluster_set_schema_keyspace_filtering(CassCluster* cluster, const char* keyspaces) {
+  cass_cluster_set_schema_keyspace_filtering_n(cluster, keyspaces, SAFE_STRLEN(keyspaces));
+}
+
+void cass_cluster_set_schema_keyspace_filtering_n(CassCluster* cluster, const char* keyspaces,
+                                                  size_t keyspaces_length) {
+  cluster->config().schema_keyspaces().clear();
+  explode(String(keyspaces, keyspaces_length), cluster->config().schema_keyspaces());
+}
+
+void cass_cluster_set_use_parallel_startup(CassCluster* cluster, cass_bool_t enabled) {
+  cluster->config().set_use_parallel_startup(enabled == cass_true);
+}
+
+void cass_cluster_set_token_aware_batch_splitting(CassCluster* cluster, cass_bool_t enabled) {
+  cluster->config().set_token_aware_batch_splitting(enabled == cass_true);
+}
+
+void cass_cluster_set_read_coalescing(CassCluster* cluster, cass_bool_t enabled) {
+  cluster->config().set_read_coalescing(enabled == cass_true);
+}
+
+void cass_cluster_set_batch_split_size(CassCluster* cluster, unsigned size) {
+  cluster->config().set_batch_split_size(size);
+}
+
+CassError cass_cluster_set_low_priority_weight(CassCluster* cluster, unsigned weight) {
+  if (weight == 0) return CASS_ERROR_LIB_BAD_PARAMS;
+  cluster->config().set_low_priority_weight(weight);
+  return CASS_OK;
+}
+
+void cass_cluster_set_reserved_streams(CassCluster* cluster, unsigned count) {
+  cluster->config().set_reserved_streams(count);
+}
+
 CassError cass_cluster_set_use_hostname_resolution(CassCluster* cluster, cass_bool_t enabled) {
   cluster->config().set_use_hostname_resolution(enabled == cass_true);
   return CASS_OK;
@@ -458,6 +856,18 @@ CassError cass_cluster_set_constant_speculative_execution_policy(CassCluster* cl
   return CASS_OK;
 }
 
+CassError cass_cluster_set_percentile_speculative_execution_policy(
+    CassCluster* cluster, cass_double_t percentile, int max_speculative_executions,
+    cass_double_t max_speculative_ratio) {
+  if (percentile <= 0.0 || percentile > 100.0 || max_speculative_executions < 0 ||
+      max_speculative_ratio < 0.0 || max_speculative_ratio > 1.0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_speculative_execution_policy(new PercentileSpeculativeExecutionPolicy(
+      percentile, max_speculative_executions, max_speculative_ratio));
+  return CASS_OK;
+}
+
 CassError cass_cluster_set_no_speculative_execution_policy(CassCluster* cluster) {
   cluster->config().set_speculative_execution_policy(new NoSpeculativeExecutionPolicy());
   return CASS_OK;
@@ -492,6 +902,11 @@ CassError cass_cluster_set_prepare_on_up_or_add_host(CassCluster* cluster, cass_
   return CASS_OK;
 }
 
+CassError cass_cluster_set_prepare_on_unprepared_host(CassCluster* cluster, cass_bool_t enabled) {
+  cluster->config().set_prepare_on_unprepared_host(enabled == cass_true);
+  return CASS_OK;
+}
+
 CassError cass_cluster_set_local_address(CassCluster* cluster, const char* name) {
   return cass_cluster_set_local_address_n(cluster, name, SAFE_STRLEN(name));
 }
@@ -511,11 +926,73 @@ CassError cass_cluster_set_local_address_n(CassCluster* cluster, const char* nam
   return CASS_OK;
 }
 
+CassError cass_cluster_set_local_addresses(CassCluster* cluster, const char* addresses) {
+  return cass_cluster_set_local_addresses_n(cluster, addresses, SAFE_STRLEN(addresses));
+}
+
+CassError cass_cluster_set_local_addresses_n(CassCluster* cluster, const char* addresses,
+                                             size_t addresses_length) {
+  AddressVec local_addresses;
+  if (addresses_length > 0 && addresses != NULL) {
+    Vector<String> exploded;
+    explode(String(addresses, addresses_length), exploded);
+    for (Vector<String>::const_iterator it = exploded.begin(), end = exploded.end(); it != end;
+         ++it) {
+      Address address(*it, 0);
+      if (!address.is_valid_and_resolved()) {
+        return CASS_ERROR_LIB_HOST_RESOLUTION;
+      }
+      local_addresses.push_back(address);
+    }
+  }
+  cluster->config().set_local_addresses(local_addresses);
+  return CASS_OK;
+}
+
 CassError cass_cluster_set_no_compact(CassCluster* cluster, cass_bool_t enabled) {
   cluster->config().set_no_compact(enabled == cass_true);
   return CASS_OK;
 }
 
+CassError cass_cluster_set_pipelined_startup(CassCluster* cluster, cass_bool_t enabled) {
+  cluster->config().set_pipelined_startup(enabled == cass_true);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_compression(CassCluster* cluster, CassCompressionType type) {
+  if (!Compressor::is_available(type)) {
+    return CASS_ERROR_LIB_NOT_IMPLEMENTED;
+  }
+  cluster->config().set_compression(type);
+  return CASS_OK;
+}
+
+void cass_cluster_set_compression_threshold(CassCluster* cluster, unsigned threshold_bytes) {
+  cluster->config().set_compression_threshold(threshold_bytes);
+}
+
+void cass_cluster_set_result_decode_offload_threshold(CassCluster* cluster,
+                                                      unsigned threshold_bytes) {
+  cluster->config().set_result_decode_offload_threshold(threshold_bytes);
+}
+
+void cass_cluster_set_prepared_cache_file(CassCluster* cluster, const char* path) {
+  cass_cluster_set_prepared_cache_file_n(cluster, path, SAFE_STRLEN(path));
+}
+
+void cass_cluster_set_prepared_cache_file_n(CassCluster* cluster, const char* path,
+                                            size_t path_length) {
+  cluster->config().set_prepared_cache_file(String(path, path_length));
+}
+
+void cass_cluster_set_max_prepared_statements(CassCluster* cluster, unsigned count) {
+  cluster->config().set_max_prepared_statements(count);
+}
+
+void cass_cluster_set_result_cache_size(CassCluster* cluster, unsigned max_entries) {
+  cluster->config().set_result_cache_size(max_entries);
+}
+
 CassError cass_cluster_set_host_listener_callback(CassCluster* cluster,
                                                   CassHostListenerCallback callback, void* data) {
   cluster->config().set_host_listener(
@@ -570,6 +1047,15 @@ CassError cass_cluster_set_cloud_secure_connection_bundle_no_ssl_lib_init_n(Cass
   return CASS_OK;
 }
 
+void cass_cluster_set_cloud_metadata_cache_file(CassCluster* cluster, const char* path) {
+  cass_cluster_set_cloud_metadata_cache_file_n(cluster, path, SAFE_STRLEN(path));
+}
+
+void cass_cluster_set_cloud_metadata_cache_file_n(CassCluster* cluster, const char* path,
+                                                  size_t path_length) {
+  cluster->config().set_cloud_metadata_cache_file(String(path, path_length));
+}
+
 void cass_cluster_set_application_name(CassCluster* cluster, const char* application_name) {
   cass_cluster_set_application_name_n(cluster, application_name, SAFE_STRLEN(application_name));
 }
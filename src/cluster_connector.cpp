@@ -66,6 +66,7 @@ ClusterConnector::ClusterConnector(const AddressVec& contact_points,
     , event_loop_(NULL)
     , random_(NULL)
     , metrics_(NULL)
+    , resolve_start_time_(0)
     , callback_(callback)
     , error_code_(CLUSTER_OK)
     , ssl_error_code_(CASS_OK) {}
@@ -110,6 +111,7 @@ void ClusterConnector::internal_resolve_and_connect() {
   }
 
   resolver_ = settings_.cluster_metadata_resolver_factory->new_instance(settings_);
+  resolve_start_time_ = uv_hrtime();
 
   resolver_->resolve(event_loop_->loop(), contact_points_,
                      bind_callback(&ClusterConnector::on_resolve, this));
@@ -122,6 +124,7 @@ void ClusterConnector::internal_connect(const Address& address, ProtocolVersion
   connectors_[address] = connector; // Keep track of the connectors so they can be canceled.
   connector->with_metrics(metrics_)
       ->with_settings(settings_.control_connection_settings)
+      ->with_deferred_schema(settings_.use_parallel_startup)
       ->connect(event_loop_->loop());
 }
 
@@ -168,6 +171,8 @@ void ClusterConnector::on_resolve(ClusterMetadataResolver* resolver) {
     return;
   }
 
+  timings_.resolve = uv_hrtime() - resolve_start_time_;
+
   const AddressVec& resolved_contact_points(resolver->resolved_contact_points());
 
   if (resolved_contact_points.empty()) {
@@ -263,10 +268,16 @@ void ClusterConnector::on_connect(ControlConnector* connector) {
       return;
     }
 
+    uint64_t metadata_start_time = uv_hrtime();
     cluster_.reset(new Cluster(connector->release_connection(), listener_, event_loop_,
                                connected_host, hosts, connector->schema(), default_policy, policies,
                                local_dc_, local_rack_, connector->supported_options(), settings_));
 
+    uint64_t resolve = timings_.resolve;
+    timings_ = connector->timings();
+    timings_.resolve = resolve;
+    timings_.metadata = uv_hrtime() - metadata_start_time;
+
     // Clear any connection errors and set the final negotiated protocol version.
     error_code_ = CLUSTER_OK;
     error_message_.clear();
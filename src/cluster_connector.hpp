@@ -125,6 +125,14 @@ public:
 public:
   ProtocolVersion protocol_version() const { return protocol_version_; }
 
+  /**
+   * The time spent resolving the contact points, establishing the control
+   * connection and building the cluster's initial metadata.
+   *
+   * @return
+   */
+  const StartupTimings& timings() const { return timings_; }
+
   bool is_ok() const { return error_code_ == CLUSTER_OK; }
   bool is_canceled() const { return error_code_ == CLUSTER_CANCELED; }
 
@@ -171,6 +179,8 @@ private:
   String local_dc_;
   String local_rack_;
   ClusterSettings settings_;
+  StartupTimings timings_;
+  uint64_t resolve_start_time_;
 
   Callback callback_;
 
@@ -25,9 +25,11 @@ namespace {
 
 class DefaultClusterMetadataResolver : public ClusterMetadataResolver {
 public:
-  DefaultClusterMetadataResolver(uint64_t resolve_timeout_ms, int port)
+  DefaultClusterMetadataResolver(uint64_t resolve_timeout_ms, int port,
+                                 const ResolverCache::Ptr& cache)
       : resolve_timeout_ms_(resolve_timeout_ms)
-      , port_(port) {}
+      , port_(port)
+      , cache_(cache) {}
 
 private:
   virtual void internal_resolve(uv_loop_t* loop, const AddressVec& contact_points) {
@@ -42,8 +44,8 @@ private:
         resolved_contact_points_.push_back(Address(it->hostname_or_address(), port));
       } else {
         if (!resolver_) {
-          resolver_.reset(
-              new MultiResolver(bind_callback(&DefaultClusterMetadataResolver::on_resolve, this)));
+          resolver_.reset(new MultiResolver(
+              bind_callback(&DefaultClusterMetadataResolver::on_resolve, this), cache_));
         }
         resolver_->resolve(loop, it->hostname_or_address(), port, resolve_timeout_ms_);
       }
@@ -94,13 +96,15 @@ private:
   MultiResolver::Ptr resolver_;
   const uint64_t resolve_timeout_ms_;
   const int port_;
+  const ResolverCache::Ptr cache_;
 };
 
 } // namespace
 
 ClusterMetadataResolver::Ptr
 DefaultClusterMetadataResolverFactory::new_instance(const ClusterSettings& settings) const {
+  const SocketSettings& socket_settings =
+      settings.control_connection_settings.connection_settings.socket_settings;
   return ClusterMetadataResolver::Ptr(new DefaultClusterMetadataResolver(
-      settings.control_connection_settings.connection_settings.socket_settings.resolve_timeout_ms,
-      settings.port));
+      socket_settings.resolve_timeout_ms, settings.port, socket_settings.resolver_cache));
 }
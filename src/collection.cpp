@@ -19,6 +19,7 @@
 #include "constants.hpp"
 #include "external.hpp"
 #include "macros.hpp"
+#include "struct_encoder.hpp"
 #include "tuple.hpp"
 #include "user_type_value.hpp"
 
@@ -78,6 +79,8 @@ CASS_COLLECTION_APPEND(decimal,
 CASS_COLLECTION_APPEND(duration,
                        THREE_PARAMS_(cass_int32_t months, cass_int32_t days, cass_int64_t nanos),
                        CassDuration(months, days, nanos))
+CASS_COLLECTION_APPEND(struct, TWO_PARAMS_(const CassStructEncoder* encoder, const void* data),
+                       CassStruct(encoder->from(), data))
 
 #undef CASS_COLLECTION_APPEND
 
@@ -90,6 +93,25 @@ CassError cass_collection_append_string_n(CassCollection* collection, const char
   return collection->append(CassString(value, value_length));
 }
 
+#define CASS_COLLECTION_APPEND_ARRAY(Name, Type)                                             \
+  CassError cass_collection_append_##Name##_array(CassCollection* collection,                \
+                                                  const Type* values, size_t values_count) { \
+    return collection->append_array(values, values_count);                                   \
+  }
+
+CASS_COLLECTION_APPEND_ARRAY(int32, cass_int32_t)
+CASS_COLLECTION_APPEND_ARRAY(int64, cass_int64_t)
+CASS_COLLECTION_APPEND_ARRAY(float, cass_float_t)
+CASS_COLLECTION_APPEND_ARRAY(double, cass_double_t)
+
+#undef CASS_COLLECTION_APPEND_ARRAY
+
+CassError cass_collection_append_struct_array(CassCollection* collection,
+                                              const CassStructEncoder* encoder, const void* data,
+                                              size_t struct_size, size_t count) {
+  return collection->append_structs(encoder->from(), data, struct_size, count);
+}
+
 CassError cass_collection_append_custom(CassCollection* collection, const char* class_name,
                                         const cass_byte_t* value, size_t value_size) {
   return collection->append(CassCustom(StringRef(class_name), value, value_size));
@@ -104,46 +126,97 @@ CassError cass_collection_append_custom_n(CassCollection* collection, const char
 
 } // extern "C"
 
+CassError Collection::append(CassString value) {
+  CASS_COLLECTION_CHECK_TYPE(value);
+  append_item(value.data, value.length);
+  return CASS_OK;
+}
+
+CassError Collection::append(CassBytes value) {
+  CASS_COLLECTION_CHECK_TYPE(value);
+  append_item(reinterpret_cast<const char*>(value.data), value.size);
+  return CASS_OK;
+}
+
+CassError Collection::append(CassCustom value) {
+  CASS_COLLECTION_CHECK_TYPE(value);
+  append_item(reinterpret_cast<const char*>(value.data), value.size);
+  return CASS_OK;
+}
+
+CassError Collection::append(CassInet value) {
+  CASS_COLLECTION_CHECK_TYPE(value);
+  append_item(reinterpret_cast<const char*>(value.address), value.address_length);
+  return CASS_OK;
+}
+
+CassError Collection::append(CassStruct value) {
+  CASS_COLLECTION_CHECK_TYPE(value);
+  append_struct(value.encoder, static_cast<const char*>(value.data));
+  return CASS_OK;
+}
+
+CassError Collection::append_structs(const StructEncoder* encoder, const void* data,
+                                     size_t struct_size, size_t count) {
+  if (count == 0) return CASS_OK;
+  CASS_COLLECTION_CHECK_TYPE(CassStruct(encoder, data));
+  if (count > 1) {
+    CassError rc = check(CassStruct(encoder, data), 1);
+    if (rc != CASS_OK) return rc;
+  }
+  const char* pos = static_cast<const char*>(data);
+  for (size_t i = 0; i < count; ++i, pos += struct_size) {
+    append_struct(encoder, pos);
+  }
+  return CASS_OK;
+}
+
 CassError Collection::append(CassNull value) {
   CASS_COLLECTION_CHECK_TYPE(value);
-  items_.push_back(Buffer());
+  append_item(NULL, 0);
   return CASS_OK;
 }
 
 CassError Collection::append(const Collection* value) {
   CASS_COLLECTION_CHECK_TYPE(value);
-  items_.push_back(value->encode());
+  char* pos = grow(sizeof(int32_t) + value->get_size());
+  pos = encode_int32(pos, value->get_size());
+  pos = encode_int32(pos, value->get_count());
+  value->encode_items(pos);
+  item_count_++;
   return CASS_OK;
 }
 
 CassError Collection::append(const Tuple* value) {
   CASS_COLLECTION_CHECK_TYPE(value);
-  items_.push_back(value->encode());
+  append_item(value->encode());
   return CASS_OK;
 }
 
 CassError Collection::append(const UserTypeValue* value) {
   CASS_COLLECTION_CHECK_TYPE(value);
-  items_.push_back(value->encode());
+  append_item(value->encode());
   return CASS_OK;
 }
 
-size_t Collection::get_items_size() const {
-  size_t size = 0;
-  for (BufferVec::const_iterator i = items_.begin(), end = items_.end(); i != end; ++i) {
-    size += sizeof(int32_t);
-    size += i->size();
-  }
-  return size;
+void Collection::append_struct(const StructEncoder* encoder, const char* data) {
+  size_t size = encoder->get_size(data);
+  char* pos = grow(sizeof(int32_t) + size);
+  encoder->encode(data, encode_int32(pos, size));
+  item_count_++;
+}
+
+void Collection::append_item(const char* data, size_t size) {
+  char* pos = grow(sizeof(int32_t) + size);
+  pos = encode_int32(pos, size);
+  if (size > 0) memcpy(pos, data, size);
+  item_count_++;
 }
 
+size_t Collection::get_items_size() const { return data_.size(); }
+
 void Collection::encode_items(char* buf) const {
-  for (BufferVec::const_iterator i = items_.begin(), end = items_.end(); i != end; ++i) {
-    encode_int32(buf, i->size());
-    buf += sizeof(int32_t);
-    memcpy(buf, i->data(), i->size());
-    buf += i->size();
-  }
+  if (!data_.empty()) memcpy(buf, &data_[0], data_.size());
 }
 
 size_t Collection::get_size() const { return sizeof(int32_t) + get_items_size(); }
@@ -165,3 +238,10 @@ Buffer Collection::encode_with_length() const {
   encode_items(buf.data() + pos);
   return buf;
 }
+
+size_t Collection::copy_with_length(size_t pos, Buffer* buf) const {
+  pos = buf->encode_int32(pos, get_size());
+  pos = buf->encode_int32(pos, get_count());
+  encode_items(buf->data() + pos);
+  return pos + get_items_size();
+}
@@ -23,7 +23,9 @@
 #include "encode.hpp"
 #include "external.hpp"
 #include "ref_counted.hpp"
+#include "serialization.hpp"
 #include "types.hpp"
+#include "vector.hpp"
 
 #define CASS_COLLECTION_CHECK_TYPE(Value) \
   do {                                    \
@@ -37,14 +39,20 @@ class UserTypeValue;
 
 class Collection : public RefCounted<Collection> {
 public:
+  // The number of bytes reserved per item when the collection is created;
+  // large enough for a length and an 8 byte value.
+  static const size_t RESERVED_ITEM_SIZE = sizeof(int32_t) + sizeof(int64_t);
+
   Collection(CassCollectionType type, size_t item_count)
-      : data_type_(new CollectionType(static_cast<CassValueType>(type), false)) {
-    items_.reserve(item_count);
+      : data_type_(new CollectionType(static_cast<CassValueType>(type), false))
+      , item_count_(0) {
+    data_.reserve(item_count * RESERVED_ITEM_SIZE);
   }
 
   Collection(const CollectionType::ConstPtr& data_type, size_t item_count)
-      : data_type_(data_type) {
-    items_.reserve(item_count);
+      : data_type_(data_type)
+      , item_count_(0) {
+    data_.reserve(item_count * RESERVED_ITEM_SIZE);
   }
 
   CassCollectionType type() const {
@@ -52,13 +60,13 @@ public:
   }
 
   const CollectionType::ConstPtr& data_type() const { return data_type_; }
-  const BufferVec& items() const { return items_; }
+  size_t item_count() const { return item_count_; }
 
-#define APPEND_TYPE(Type)                  \
-  CassError append(const Type value) {     \
-    CASS_COLLECTION_CHECK_TYPE(value);     \
-    items_.push_back(core::encode(value)); \
-    return CASS_OK;                        \
+#define APPEND_TYPE(Type)                 \
+  CassError append(const Type value) {    \
+    CASS_COLLECTION_CHECK_TYPE(value);    \
+    append_item(core::encode(value));     \
+    return CASS_OK;                       \
   }
 
   APPEND_TYPE(cass_int8_t)
@@ -69,21 +77,46 @@ public:
   APPEND_TYPE(cass_float_t)
   APPEND_TYPE(cass_double_t)
   APPEND_TYPE(cass_bool_t)
-  APPEND_TYPE(CassString)
-  APPEND_TYPE(CassBytes)
-  APPEND_TYPE(CassCustom)
   APPEND_TYPE(CassUuid)
-  APPEND_TYPE(CassInet)
   APPEND_TYPE(CassDecimal)
   APPEND_TYPE(CassDuration)
 
 #undef APPEND_TYPE
 
+  CassError append(CassString value);
+  CassError append(CassBytes value);
+  CassError append(CassCustom value);
+  CassError append(CassInet value);
+  CassError append(CassStruct value);
   CassError append(CassNull value);
   CassError append(const Collection* value);
   CassError append(const Tuple* value);
   CassError append(const UserTypeValue* value);
 
+  /**
+   * Append many fixed-width values at once. The values' type is checked once
+   * and they're encoded directly into the collection's buffer.
+   *
+   * @param values
+   * @param count
+   * @return CASS_OK if successful, otherwise an error occurred.
+   */
+  template <class T>
+  CassError append_array(const T* values, size_t count);
+
+  /**
+   * Append many structs at once, encoding each one directly into the
+   * collection's buffer.
+   *
+   * @param encoder
+   * @param data The first struct.
+   * @param struct_size The distance between structs in bytes.
+   * @param count
+   * @return CASS_OK if successful, otherwise an error occurred.
+   */
+  CassError append_structs(const StructEncoder* encoder, const void* data, size_t struct_size,
+                           size_t count);
+
   size_t get_items_size() const;
   void encode_items(char* buf) const;
 
@@ -93,13 +126,19 @@ public:
   Buffer encode() const;
   Buffer encode_with_length() const;
 
-  void clear() { items_.clear(); }
+  // Encode the collection with its length directly into "buf" at "pos"
+  size_t copy_with_length(size_t pos, Buffer* buf) const;
+
+  void clear() {
+    data_.clear();
+    item_count_ = 0;
+  }
 
 private:
   template <class T>
-  CassError check(const T value) {
+  CassError check(const T value, size_t offset = 0) {
     IsValidDataType<T> is_valid_type;
-    size_t index = items_.size();
+    size_t index = item_count_ + offset;
 
     switch (type()) {
       case CASS_COLLECTION_TYPE_MAP:
@@ -120,17 +159,61 @@ private:
   }
 
   int32_t get_count() const {
-    return ((type() == CASS_COLLECTION_TYPE_MAP) ? items_.size() / 2 : items_.size());
+    return ((type() == CASS_COLLECTION_TYPE_MAP) ? item_count_ / 2 : item_count_);
+  }
+
+  // Grow the encoded items by "size" bytes and return where they start
+  char* grow(size_t size) {
+    size_t pos = data_.size();
+    data_.resize(pos + size);
+    return &data_[pos];
+  }
+
+  static char* encode_value(char* output, cass_int32_t value) {
+    return internal::encode_int32(output, value);
+  }
+  static char* encode_value(char* output, cass_int64_t value) {
+    return internal::encode_int64(output, value);
+  }
+  static char* encode_value(char* output, cass_float_t value) {
+    return internal::encode_float(output, value);
+  }
+  static char* encode_value(char* output, cass_double_t value) {
+    return internal::encode_double(output, value);
   }
 
+  void append_struct(const StructEncoder* encoder, const char* data);
+  void append_item(const char* data, size_t size);
+  void append_item(const Buffer& buf) { append_item(buf.data(), buf.size()); }
+
 private:
   CollectionType::ConstPtr data_type_;
-  BufferVec items_;
+  // The encoded items, each one is an [int] length followed by its data
+  Vector<char> data_;
+  size_t item_count_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(Collection);
 };
 
+template <class T>
+CassError Collection::append_array(const T* values, size_t count) {
+  if (count == 0) return CASS_OK;
+  // Map keys and values alternate so both of their types need to be checked
+  CASS_COLLECTION_CHECK_TYPE(values[0]);
+  if (count > 1) {
+    CassError rc = check(values[1], 1);
+    if (rc != CASS_OK) return rc;
+  }
+  char* pos = grow(count * (sizeof(int32_t) + sizeof(T)));
+  for (size_t i = 0; i < count; ++i) {
+    pos = internal::encode_int32(pos, sizeof(T));
+    pos = encode_value(pos, values[i]);
+  }
+  item_count_ += count;
+  return CASS_OK;
+}
+
 }}} // namespace datastax::internal::core
 
 EXTERNAL_TYPE(datastax::internal::core::Collection, CassCollection)
@@ -0,0 +1,75 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "column_handle.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+extern "C" {
+
+void cass_column_handle_free(const CassColumnHandle* column_handle) {
+  delete column_handle->from();
+}
+
+} // extern "C"
+
+ColumnHandle* ColumnHandle::resolve(const ResultMetadata::Ptr& metadata, StringRef name) {
+  if (!metadata) return NULL;
+  ColumnHandle* handle = new ColumnHandle(metadata, name);
+  if (metadata->get_indices(name, &handle->indices_) == 0) {
+    delete handle;
+    return NULL;
+  }
+  handle->column_name_ = metadata->get_column_definition(handle->indices_[0]).name;
+  return handle;
+}
+
+const IndexVec* ColumnHandle::get_indices(const ResultMetadata* metadata,
+                                          IndexVec* indices) const {
+  if (metadata == metadata_.get()) {
+    return &indices_;
+  }
+
+  // The name could match a different number of columns in another metadata
+  // so it's looked up again
+  if (metadata->get_indices(StringRef(name_), indices) == 0) {
+    return NULL;
+  }
+  return indices;
+}
+
+bool ColumnHandle::get_first_index(const ResultMetadata* metadata, size_t* index) const {
+  // Results with the same columns, e.g. the pages of a query, have their own
+  // copies of the same metadata
+  if (metadata == metadata_.get() || is_valid_index(metadata, indices_[0])) {
+    *index = indices_[0];
+    return true;
+  }
+
+  IndexVec indices;
+  if (metadata->get_indices(StringRef(name_), &indices) == 0) {
+    return false;
+  }
+  *index = indices[0];
+  return true;
+}
+
+bool ColumnHandle::is_valid_index(const ResultMetadata* metadata, size_t index) const {
+  return index < metadata->column_count() &&
+         metadata->get_column_definition(index).name == column_name_;
+}
@@ -0,0 +1,91 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_COLUMN_HANDLE_HPP
+#define DATASTAX_INTERNAL_COLUMN_HANDLE_HPP
+
+#include "allocated.hpp"
+#include "external.hpp"
+#include "hash_table.hpp"
+#include "macros.hpp"
+#include "result_metadata.hpp"
+#include "string.hpp"
+#include "string_ref.hpp"
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * A name resolved, once, to the indices of the matching columns (or bind
+ * parameters) of a result metadata. The indices are used directly with the
+ * same metadata. A row's column is also found directly in other metadata, e.g.
+ * the metadata of another page, if the column at the handle's index still has
+ * the same name. Otherwise, the name is looked up again.
+ */
+class ColumnHandle : public Allocated {
+public:
+  /**
+   * Resolve a name.
+   *
+   * @param metadata The metadata the name is resolved against.
+   * @param name A name that's case-insensitive unless it's quoted.
+   * @return The handle or NULL if no columns match the name.
+   */
+  static ColumnHandle* resolve(const ResultMetadata::Ptr& metadata, StringRef name);
+
+  const ResultMetadata::Ptr& metadata() const { return metadata_; }
+  const String& name() const { return name_; }
+  const IndexVec& indices() const { return indices_; }
+
+  /**
+   * Get the indices of the handle's columns in a metadata.
+   *
+   * @param metadata
+   * @param indices Filled if the handle's indices can't be used.
+   * @return The indices or NULL if no columns match the handle's name.
+   */
+  const IndexVec* get_indices(const ResultMetadata* metadata, IndexVec* indices) const;
+
+  /**
+   * Get the index of the handle's first column in a metadata.
+   *
+   * @param metadata
+   * @param index
+   * @return true if a column matches the handle's name.
+   */
+  bool get_first_index(const ResultMetadata* metadata, size_t* index) const;
+
+private:
+  ColumnHandle(const ResultMetadata::Ptr& metadata, StringRef name)
+      : metadata_(metadata)
+      , name_(name.to_string()) {}
+
+  bool is_valid_index(const ResultMetadata* metadata, size_t index) const;
+
+private:
+  ResultMetadata::Ptr metadata_;
+  String name_;           // The name as it was resolved (possibly quoted)
+  StringRef column_name_; // The column's name in the metadata
+  IndexVec indices_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ColumnHandle);
+};
+
+}}} // namespace datastax::internal::core
+
+EXTERNAL_TYPE(datastax::internal::core::ColumnHandle, CassColumnHandle)
+
+#endif
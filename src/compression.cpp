@@ -0,0 +1,220 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "compression.hpp"
+
+#include "driver_config.hpp"
+#include "logger.hpp"
+#include "serialization.hpp"
+#include "string_ref.hpp"
+
+#ifdef HAVE_LZ4
+#include <lz4.h>
+#endif
+
+#ifdef HAVE_SNAPPY
+#include <snappy-c.h>
+#endif
+
+#include <cstring>
+
+// Frames larger than this are rejected by the server (native_transport_max_frame_size)
+#define MAX_UNCOMPRESSED_LENGTH (256 * 1024 * 1024)
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+namespace {
+
+#ifdef HAVE_LZ4
+/**
+ * LZ4 block compression. Cassandra prefixes the compressed block with the
+ * uncompressed length as a 4 byte, big-endian integer.
+ */
+class Lz4Compressor : public Compressor {
+public:
+  virtual const char* name() const { return "lz4"; }
+
+protected:
+  virtual size_t max_compressed_length(size_t length) const {
+    return sizeof(int32_t) + LZ4_compressBound(static_cast<int>(length));
+  }
+
+  virtual bool compress_raw(const char* input, size_t length, char* output,
+                            size_t* output_length) const {
+    encode_int32(output, static_cast<int32_t>(length));
+    int result = LZ4_compress_default(input, output + sizeof(int32_t), static_cast<int>(length),
+                                      static_cast<int>(*output_length - sizeof(int32_t)));
+    if (result <= 0) return false;
+    *output_length = sizeof(int32_t) + result;
+    return true;
+  }
+
+  virtual bool uncompressed_length(const char* input, size_t length, size_t* result) const {
+    if (length < sizeof(int32_t)) return false;
+    int32_t value;
+    decode_int32(input, value);
+    if (value < 0) return false;
+    *result = static_cast<size_t>(value);
+    return true;
+  }
+
+  virtual bool decompress_raw(const char* input, size_t length, char* output,
+                              size_t output_length) const {
+    int result = LZ4_decompress_safe(input + sizeof(int32_t), output,
+                                     static_cast<int>(length - sizeof(int32_t)),
+                                     static_cast<int>(output_length));
+    return result >= 0 && static_cast<size_t>(result) == output_length;
+  }
+};
+#endif
+
+#ifdef HAVE_SNAPPY
+/**
+ * Snappy compression using the raw snappy format.
+ */
+class SnappyCompressor : public Compressor {
+public:
+  virtual const char* name() const { return "snappy"; }
+
+protected:
+  virtual size_t max_compressed_length(size_t length) const {
+    return snappy_max_compressed_length(length);
+  }
+
+  virtual bool compress_raw(const char* input, size_t length, char* output,
+                            size_t* output_length) const {
+    return snappy_compress(input, length, output, output_length) == SNAPPY_OK;
+  }
+
+  virtual bool uncompressed_length(const char* input, size_t length, size_t* result) const {
+    return snappy_uncompressed_length(input, length, result) == SNAPPY_OK;
+  }
+
+  virtual bool decompress_raw(const char* input, size_t length, char* output,
+                              size_t output_length) const {
+    size_t result = output_length;
+    return snappy_uncompress(input, length, output, &result) == SNAPPY_OK &&
+           result == output_length;
+  }
+};
+#endif
+
+#if defined(HAVE_LZ4) || defined(HAVE_SNAPPY)
+bool is_supported_by_host(const char* name, const StringMultimap& supported_options) {
+  StringMultimap::const_iterator it = supported_options.find("COMPRESSION");
+  if (it == supported_options.end()) return false;
+  for (Vector<String>::const_iterator i = it->second.begin(), end = it->second.end(); i != end;
+       ++i) {
+    if (iequals(*i, name)) return true;
+  }
+  return false;
+}
+#endif
+
+} // namespace
+
+bool Compressor::compress(BufferVec::const_iterator begin, BufferVec::const_iterator end,
+                          size_t length, Buffer* output) {
+  if (length == 0) return false;
+
+  const char* input;
+  if (end - begin == 1) {
+    input = begin->data();
+  } else {
+    input_.resize(length);
+    char* pos = &input_[0];
+    for (BufferVec::const_iterator it = begin; it != end; ++it) {
+      memcpy(pos, it->data(), it->size());
+      pos += it->size();
+    }
+    input = &input_[0];
+  }
+
+  size_t output_length = max_compressed_length(length);
+  output_.resize(output_length);
+  if (!compress_raw(input, length, &output_[0], &output_length)) {
+    LOG_WARN("Unable to compress frame body using %s", name());
+    return false;
+  }
+
+  // Not worth sending compressed if it didn't get any smaller
+  if (output_length >= length) return false;
+
+  *output = Buffer(&output_[0], output_length);
+  return true;
+}
+
+bool Compressor::decompress(const char* input, size_t length, RefBuffer::Ptr* output,
+                            size_t* output_length) {
+  size_t result;
+  if (!uncompressed_length(input, length, &result) || result > MAX_UNCOMPRESSED_LENGTH) {
+    LOG_ERROR("Invalid uncompressed length for %s compressed frame body", name());
+    return false;
+  }
+
+  RefBuffer::Ptr buffer(RefBuffer::create(result, MEMORY_CATEGORY_RESPONSE_BUFFERS));
+  if (!decompress_raw(input, length, buffer->data(), result)) {
+    LOG_ERROR("Unable to decompress frame body using %s", name());
+    return false;
+  }
+
+  *output = buffer;
+  *output_length = result;
+  return true;
+}
+
+bool Compressor::is_available(CassCompressionType type) {
+  switch (type) {
+    case CASS_COMPRESSION_NONE:
+      return true;
+    case CASS_COMPRESSION_LZ4:
+#ifdef HAVE_LZ4
+      return true;
+#else
+      return false;
+#endif
+    case CASS_COMPRESSION_SNAPPY:
+#ifdef HAVE_SNAPPY
+      return true;
+#else
+      return false;
+#endif
+    case CASS_COMPRESSION_AUTO:
+      return is_available(CASS_COMPRESSION_LZ4) || is_available(CASS_COMPRESSION_SNAPPY);
+  }
+  return false;
+}
+
+Compressor* Compressor::negotiate(CassCompressionType type,
+                                  const StringMultimap& supported_options) {
+#ifdef HAVE_LZ4
+  if ((type == CASS_COMPRESSION_LZ4 || type == CASS_COMPRESSION_AUTO) &&
+      is_supported_by_host("lz4", supported_options)) {
+    return new Lz4Compressor();
+  }
+#endif
+
+#ifdef HAVE_SNAPPY
+  if ((type == CASS_COMPRESSION_SNAPPY || type == CASS_COMPRESSION_AUTO) &&
+      is_supported_by_host("snappy", supported_options)) {
+    return new SnappyCompressor();
+  }
+#endif
+
+  return NULL;
+}
@@ -0,0 +1,108 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_COMPRESSION_HPP
+#define DATASTAX_INTERNAL_COMPRESSION_HPP
+
+#include "allocated.hpp"
+#include "buffer.hpp"
+#include "cassandra.h"
+#include "decoder.hpp"
+#include "macros.hpp"
+#include "ref_counted.hpp"
+#include "vector.hpp"
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * A compressor for native protocol frame bodies. A compressor is owned by a
+ * single connection (and is only used on that connection's event loop) so it
+ * reuses its scratch buffers across frames.
+ */
+class Compressor : public Allocated {
+public:
+  Compressor() {}
+  virtual ~Compressor() {}
+
+  /**
+   * The algorithm's name as used by the STARTUP "COMPRESSION" option.
+   */
+  virtual const char* name() const = 0;
+
+  /**
+   * Compress a frame body.
+   *
+   * @param begin The first buffer of the uncompressed body.
+   * @param end The end of the uncompressed body's buffers.
+   * @param length The total length of the uncompressed body.
+   * @param output The compressed body.
+   * @return true if successful and the compressed body is smaller than the
+   * uncompressed body, otherwise false.
+   */
+  bool compress(BufferVec::const_iterator begin, BufferVec::const_iterator end, size_t length,
+                Buffer* output);
+
+  /**
+   * Decompress a frame body.
+   *
+   * @param input The compressed body.
+   * @param length The length of the compressed body.
+   * @param output The uncompressed body.
+   * @param output_length The length of the uncompressed body.
+   * @return true if successful, otherwise false.
+   */
+  bool decompress(const char* input, size_t length, RefBuffer::Ptr* output,
+                  size_t* output_length);
+
+public:
+  /**
+   * Determine if a compression type is available in this build.
+   *
+   * @param type The compression type.
+   * @return true if the type can be used.
+   */
+  static bool is_available(CassCompressionType type);
+
+  /**
+   * Create a compressor using the best algorithm supported by both the driver
+   * (as configured) and the host.
+   *
+   * @param type The configured compression type.
+   * @param supported_options The options returned in the host's SUPPORTED
+   * response.
+   * @return A new compressor or NULL if there is no common algorithm.
+   */
+  static Compressor* negotiate(CassCompressionType type, const StringMultimap& supported_options);
+
+protected:
+  virtual size_t max_compressed_length(size_t length) const = 0;
+  virtual bool compress_raw(const char* input, size_t length, char* output,
+                            size_t* output_length) const = 0;
+  virtual bool uncompressed_length(const char* input, size_t length, size_t* result) const = 0;
+  virtual bool decompress_raw(const char* input, size_t length, char* output,
+                              size_t output_length) const = 0;
+
+private:
+  Vector<char> input_;
+  Vector<char> output_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(Compressor);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
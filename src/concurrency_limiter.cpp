@@ -0,0 +1,53 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "concurrency_limiter.hpp"
+
+#include "logger.hpp"
+
+#include <algorithm>
+
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+void ConcurrencyLimiter::record_success(Host* host, uint64_t latency_ns) const {
+  if (latency_ns > latency_threshold_ns_) {
+    decrease(host);
+    return;
+  }
+  // The stored limit is zero until it first changes so the exchange has to
+  // compare against the stored value and not the effective limit
+  int32_t stored = host->concurrency_limit().load(MEMORY_ORDER_RELAXED);
+  int32_t current = stored > 0 ? stored : min_limit_;
+  // Only grow the limit when it's being used, otherwise an idle host's limit
+  // would grow without ever being tested
+  if (current < max_limit_ && host->inflight_request_count() * 2 >= current) {
+    // Losing a race with another thread only skips an increment
+    host->concurrency_limit().compare_exchange_strong(stored, current + 1);
+  }
+}
+
+void ConcurrencyLimiter::record_failure(Host* host) const { decrease(host); }
+
+void ConcurrencyLimiter::decrease(Host* host) const {
+  int32_t stored = host->concurrency_limit().load(MEMORY_ORDER_RELAXED);
+  int32_t current = stored > 0 ? stored : min_limit_;
+  int32_t decreased = std::max(min_limit_, static_cast<int32_t>(current * 0.9));
+  if (decreased < current && host->concurrency_limit().compare_exchange_strong(stored, decreased)) {
+    LOG_DEBUG("Lowered the concurrency limit of host %s to %d", host->address_string().c_str(),
+              decreased);
+  }
+}
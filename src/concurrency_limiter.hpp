@@ -0,0 +1,102 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_CONCURRENCY_LIMITER_HPP
+#define DATASTAX_INTERNAL_CONCURRENCY_LIMITER_HPP
+
+#include "host.hpp"
+#include "ref_counted.hpp"
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * A per-host adaptive concurrency limiter that finds the number of in-flight
+ * requests each host can handle using additive increase, multiplicative
+ * decrease (AIMD).
+ *
+ * A host's limit grows by one for each response received within the latency
+ * threshold while the host is using at least half of its limit. A response
+ * slower than the threshold or a timeout, overloaded or unavailable error
+ * shrinks the limit by 10%. Hosts at their limit are moved to the end of the
+ * query plans so requests go to the hosts with spare capacity first.
+ *
+ * The limits are kept in the hosts so they're shared by all the I/O threads.
+ */
+class ConcurrencyLimiter : public RefCounted<ConcurrencyLimiter> {
+public:
+  typedef SharedRefPtr<ConcurrencyLimiter> Ptr;
+
+  /**
+   * Constructor.
+   *
+   * @param min_limit The lowest limit. This is also each host's initial limit.
+   * @param max_limit The highest limit.
+   * @param latency_threshold_ms The latency above which a response lowers the
+   * host's limit.
+   */
+  ConcurrencyLimiter(unsigned min_limit, unsigned max_limit, uint64_t latency_threshold_ms)
+      : min_limit_(static_cast<int32_t>(min_limit > 0 ? min_limit : 1))
+      , max_limit_(static_cast<int32_t>(max_limit > min_limit ? max_limit : min_limit))
+      , latency_threshold_ns_(latency_threshold_ms * 1000LL * 1000LL) {}
+
+  /**
+   * Determine if a request can be sent to a host without going over the
+   * host's limit.
+   *
+   * @param host The host.
+   * @return true if the host has spare capacity, otherwise false if the host
+   * should be tried after the other hosts.
+   */
+  bool try_acquire(Host* host) const { return host->inflight_request_count() < limit(host); }
+
+  /**
+   * Record a response from a host.
+   *
+   * @param host The host.
+   * @param latency_ns The latency of the response.
+   */
+  void record_success(Host* host, uint64_t latency_ns) const;
+
+  /**
+   * Record a timeout, overloaded or unavailable error from a host.
+   *
+   * @param host The host.
+   */
+  void record_failure(Host* host) const;
+
+  /**
+   * Get a host's current limit.
+   *
+   * @param host The host.
+   * @return The limit.
+   */
+  int32_t limit(Host* host) const {
+    int32_t limit = host->concurrency_limit().load(MEMORY_ORDER_RELAXED);
+    return limit > 0 ? limit : min_limit_;
+  }
+
+private:
+  void decrease(Host* host) const;
+
+private:
+  const int32_t min_limit_;
+  const int32_t max_limit_;
+  const uint64_t latency_threshold_ns_;
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -21,21 +21,38 @@ using namespace datastax::internal::core;
 void Config::init_profiles() {
   // Initialize the profile settings (if needed)
   for (ExecutionProfile::Map::iterator it = profiles_.begin(); it != profiles_.end(); ++it) {
-    if (it->second.serial_consistency() == CASS_CONSISTENCY_UNKNOWN) {
-      it->second.set_serial_consistency(default_profile_.serial_consistency());
-    }
-
-    if (it->second.request_timeout_ms() == CASS_UINT64_MAX) {
-      it->second.set_request_timeout(default_profile_.request_timeout_ms());
-    }
-
-    if (!it->second.retry_policy()) {
-      it->second.set_retry_policy(default_profile_.retry_policy().get());
-    }
-
-    if (!it->second.speculative_execution_policy()) {
-      it->second.set_speculative_execution_policy(
-          default_profile_.speculative_execution_policy()->new_instance());
-    }
+    init_profile(it->second);
   }
 }
+
+void Config::init_profile(ExecutionProfile& profile) const {
+  if (profile.consistency() == CASS_CONSISTENCY_UNKNOWN) {
+    profile.set_consistency(default_profile_.consistency());
+  }
+
+  if (profile.serial_consistency() == CASS_CONSISTENCY_UNKNOWN) {
+    profile.set_serial_consistency(default_profile_.serial_consistency());
+  }
+
+  if (profile.request_timeout_ms() == CASS_UINT64_MAX) {
+    profile.set_request_timeout(default_profile_.request_timeout_ms());
+  }
+
+  if (!profile.retry_policy()) {
+    profile.set_retry_policy(default_profile_.retry_policy().get());
+  }
+
+  if (profile.tracing_probability() < 0.0) {
+    profile.set_tracing_probability(default_profile_.tracing_probability());
+  }
+
+  // Speculative execution policies can keep state (e.g. latencies) so each
+  // session gets its own instances
+  const SpeculativeExecutionPolicy::Ptr& speculative_execution_policy =
+      profile.speculative_execution_policy() ? profile.speculative_execution_policy()
+                                             : default_profile_.speculative_execution_policy();
+  profile.set_speculative_execution_policy(speculative_execution_policy->new_instance());
+  profile.speculative_execution_policy()->init(thread_count_io_ + 1);
+
+  profile.build_rate_limiter();
+}
@@ -23,12 +23,16 @@
 #include "cluster_metadata_resolver.hpp"
 #include "constants.hpp"
 #include "execution_profile.hpp"
+#include "frame_capture.hpp"
 #include "protocol.hpp"
 #include "reconnection_policy.hpp"
+#include "resolver_cache.hpp"
+#include "shared_runtime.hpp"
 #include "speculative_execution.hpp"
 #include "ssl.hpp"
 #include "string.hpp"
 #include "timestamp_generator.hpp"
+#include "vector.hpp"
 
 #include <climits>
 
@@ -43,17 +47,60 @@ public:
       , protocol_version_(ProtocolVersion::highest_supported())
       , use_beta_protocol_version_(CASS_DEFAULT_USE_BETA_PROTOCOL_VERSION)
       , thread_count_io_(CASS_DEFAULT_THREAD_COUNT_IO)
+      , thread_count_callback_(CASS_DEFAULT_THREAD_COUNT_CALLBACK)
+      , callback_executor_submit_(NULL)
+      , callback_executor_data_(NULL)
+      , work_stealing_(CASS_DEFAULT_WORK_STEALING)
+      , io_uring_enabled_(CASS_DEFAULT_IO_URING_ENABLED)
+      , busy_poll_(CASS_DEFAULT_BUSY_POLL)
+      , socket_busy_poll_us_(CASS_DEFAULT_SOCKET_BUSY_POLL_US)
+      , io_thread_numa_local_(CASS_DEFAULT_IO_THREAD_NUMA_LOCAL)
+      , huge_page_buffers_(CASS_DEFAULT_HUGE_PAGE_BUFFERS)
       , queue_size_io_(CASS_DEFAULT_QUEUE_SIZE_IO)
+      , max_inflight_requests_(CASS_DEFAULT_MAX_INFLIGHT_REQUESTS)
+      , backpressure_mode_(CASS_DEFAULT_BACKPRESSURE_MODE)
+      , producer_lanes_(CASS_DEFAULT_PRODUCER_LANES)
+      , memory_limit_(CASS_DEFAULT_MEMORY_LIMIT)
+      , request_arena_size_(CASS_DEFAULT_REQUEST_ARENA_SIZE)
       , core_connections_per_host_(CASS_DEFAULT_NUM_CONNECTIONS_PER_HOST)
+      , core_connections_per_remote_host_(CASS_DEFAULT_NUM_CONNECTIONS_PER_REMOTE_HOST)
+      , max_connections_per_host_(CASS_DEFAULT_MAX_CONNECTIONS_PER_HOST)
+      , max_concurrent_requests_threshold_(CASS_DEFAULT_MAX_CONCURRENT_REQUESTS_THRESHOLD)
       , reconnection_policy_(new ExponentialReconnectionPolicy())
       , connect_timeout_ms_(CASS_DEFAULT_CONNECT_TIMEOUT_MS)
       , resolve_timeout_ms_(CASS_DEFAULT_RESOLVE_TIMEOUT_MS)
+      , close_timeout_ms_(CASS_DEFAULT_CLOSE_TIMEOUT_MS)
+      , host_drain_timeout_ms_(CASS_DEFAULT_HOST_DRAIN_TIMEOUT_MS)
+      , lazy_remote_pools_(CASS_DEFAULT_LAZY_REMOTE_POOLS)
+      , remote_pool_idle_timeout_secs_(CASS_DEFAULT_REMOTE_POOL_IDLE_TIMEOUT_SECS)
       , max_schema_wait_time_ms_(CASS_DEFAULT_MAX_SCHEMA_WAIT_TIME_MS)
+      , schema_agreement_interval_ms_(CASS_DEFAULT_SCHEMA_AGREEMENT_INTERVAL_MS)
+      , max_schema_agreement_interval_ms_(CASS_DEFAULT_MAX_SCHEMA_AGREEMENT_INTERVAL_MS)
       , max_tracing_wait_time_ms_(CASS_DEFAULT_MAX_TRACING_DATA_WAIT_TIME_MS)
       , retry_tracing_wait_time_ms_(CASS_DEFAULT_RETRY_TRACING_DATA_WAIT_TIME_MS)
       , tracing_consistency_(CASS_DEFAULT_TRACING_CONSISTENCY)
+      , tracing_wait_for_data_(CASS_DEFAULT_TRACING_WAIT_FOR_DATA)
       , coalesce_delay_us_(CASS_DEFAULT_COALESCE_DELAY)
       , new_request_ratio_(CASS_DEFAULT_NEW_REQUEST_RATIO)
+      , retry_budget_ratio_(CASS_DEFAULT_RETRY_BUDGET_RATIO)
+      , circuit_breaker_failure_threshold_(CASS_DEFAULT_CIRCUIT_BREAKER_FAILURE_THRESHOLD)
+      , circuit_breaker_open_duration_ms_(CASS_DEFAULT_CIRCUIT_BREAKER_OPEN_DURATION_MS)
+      , concurrency_limiter_min_limit_(CASS_DEFAULT_CONCURRENCY_LIMITER_MIN_LIMIT)
+      , concurrency_limiter_max_limit_(CASS_DEFAULT_CONCURRENCY_LIMITER_MAX_LIMIT)
+      , concurrency_limiter_latency_threshold_ms_(
+            CASS_DEFAULT_CONCURRENCY_LIMITER_LATENCY_THRESHOLD_MS)
+      , host_and_profile_metrics_(CASS_DEFAULT_HOST_AND_PROFILE_METRICS)
+      , request_stage_metrics_(CASS_DEFAULT_REQUEST_STAGE_METRICS)
+      , metrics_merge_interval_ms_(CASS_DEFAULT_METRICS_MERGE_INTERVAL_MS)
+      , metrics_snapshot_max_age_ms_(CASS_DEFAULT_METRICS_SNAPSHOT_MAX_AGE_MS)
+      , slow_request_threshold_ms_(CASS_DEFAULT_SLOW_REQUEST_THRESHOLD_MS)
+      , slow_request_log_capacity_(CASS_DEFAULT_SLOW_REQUEST_LOG_CAPACITY)
+      , slow_request_callback_(NULL)
+      , slow_request_data_(NULL)
+      , request_tracer_callback_(NULL)
+      , request_tracer_data_(NULL)
+      , coalesce_mode_(CASS_DEFAULT_COALESCE_MODE)
+      , coalesce_latency_budget_us_(CASS_DEFAULT_COALESCE_LATENCY_BUDGET_US)
       , log_level_(CASS_DEFAULT_LOG_LEVEL)
       , log_callback_(stderr_log_callback)
       , log_data_(NULL)
@@ -61,16 +108,42 @@ public:
       , tcp_nodelay_enable_(CASS_DEFAULT_TCP_NO_DELAY_ENABLED)
       , tcp_keepalive_enable_(CASS_DEFAULT_TCP_KEEPALIVE_ENABLED)
       , tcp_keepalive_delay_secs_(CASS_DEFAULT_TCP_KEEPALIVE_DELAY_SECS)
+      , socket_receive_buffer_size_(CASS_DEFAULT_SOCKET_RECEIVE_BUFFER_SIZE)
+      , socket_send_buffer_size_(CASS_DEFAULT_SOCKET_SEND_BUFFER_SIZE)
+      , tcp_notsent_lowat_(CASS_DEFAULT_TCP_NOTSENT_LOWAT)
       , connection_idle_timeout_secs_(CASS_DEFAULT_IDLE_TIMEOUT_SECS)
       , connection_heartbeat_interval_secs_(CASS_DEFAULT_HEARTBEAT_INTERVAL_SECS)
       , timestamp_gen_(new MonotonicTimestampGenerator())
       , use_schema_(CASS_DEFAULT_USE_SCHEMA)
+      , use_lazy_schema_(CASS_DEFAULT_USE_LAZY_SCHEMA)
+      , use_parallel_startup_(CASS_DEFAULT_USE_PARALLEL_STARTUP)
+      , token_aware_batch_splitting_(CASS_DEFAULT_TOKEN_AWARE_BATCH_SPLITTING)
+      , read_coalescing_(CASS_DEFAULT_READ_COALESCING)
+      , batch_split_size_(CASS_DEFAULT_BATCH_SPLIT_SIZE)
+      , low_priority_weight_(CASS_DEFAULT_LOW_PRIORITY_WEIGHT)
+      , reserved_streams_(CASS_DEFAULT_RESERVED_STREAMS)
       , use_hostname_resolution_(CASS_DEFAULT_HOSTNAME_RESOLUTION_ENABLED)
       , use_randomized_contact_points_(CASS_DEFAULT_USE_RANDOMIZED_CONTACT_POINTS)
       , max_reusable_write_objects_(CASS_DEFAULT_MAX_REUSABLE_WRITE_OBJECTS)
       , prepare_on_all_hosts_(CASS_DEFAULT_PREPARE_ON_ALL_HOSTS)
       , prepare_on_up_or_add_host_(CASS_DEFAULT_PREPARE_ON_UP_OR_ADD_HOST)
+      , prepare_on_unprepared_host_(CASS_DEFAULT_PREPARE_ON_UNPREPARED_HOST)
       , no_compact_(CASS_DEFAULT_NO_COMPACT)
+      , pipelined_startup_(CASS_DEFAULT_PIPELINED_STARTUP)
+      , compression_(CASS_DEFAULT_COMPRESSION)
+      , compression_threshold_(CASS_DEFAULT_COMPRESSION_THRESHOLD)
+      , result_decode_offload_threshold_(CASS_DEFAULT_RESULT_DECODE_OFFLOAD_THRESHOLD)
+      , max_outstanding_write_bytes_per_connection_(
+            CASS_DEFAULT_MAX_OUTSTANDING_WRITE_BYTES_PER_CONNECTION)
+      , max_prepared_statements_(CASS_DEFAULT_MAX_PREPARED_STATEMENTS)
+      , result_cache_size_(CASS_DEFAULT_RESULT_CACHE_SIZE)
+      , max_concurrent_connect_attempts_per_host_(
+            CASS_DEFAULT_MAX_CONCURRENT_CONNECT_ATTEMPTS_PER_HOST)
+      , host_warmup_duration_ms_(CASS_DEFAULT_HOST_WARMUP_DURATION_MS)
+      , connection_warmup_requests_(CASS_DEFAULT_CONNECTION_WARMUP_REQUESTS)
+      , shard_awareness_(CASS_DEFAULT_SHARD_AWARENESS)
+      , host_probe_interval_ms_(CASS_DEFAULT_HOST_PROBE_INTERVAL_MS)
+      , event_debounce_window_ms_(CASS_DEFAULT_EVENT_DEBOUNCE_WINDOW_MS)
       , is_client_id_set_(false)
       , host_listener_(new DefaultHostListener())
       , monitor_reporting_interval_secs_(CASS_DEFAULT_CLIENT_MONITOR_EVENTS_INTERVAL_SECS)
@@ -83,6 +156,7 @@ public:
     default_profile_.set_load_balancing_policy(new DCAwarePolicy());
     default_profile_.set_retry_policy(new DefaultRetryPolicy());
     default_profile_.set_speculative_execution_policy(new NoSpeculativeExecutionPolicy());
+    default_profile_.set_tracing_probability(CASS_DEFAULT_TRACING_PROBABILITY);
   }
 
   Config new_instance() const {
@@ -91,6 +165,8 @@ public:
     config.init_profiles(); // Initializes the profiles from default (if needed)
     config.set_speculative_execution_policy(
         default_profile_.speculative_execution_policy()->new_instance());
+    config.default_profile_.speculative_execution_policy()->init(thread_count_io_ + 1);
+    config.default_profile_.build_rate_limiter();
 
     return config;
   }
@@ -109,16 +185,108 @@ public:
 
   void set_thread_count_io(unsigned num_threads) { thread_count_io_ = num_threads; }
 
+  unsigned thread_count_callback() const { return thread_count_callback_; }
+
+  void set_thread_count_callback(unsigned num_threads) { thread_count_callback_ = num_threads; }
+
+  CassCallbackExecutorSubmit callback_executor_submit() const { return callback_executor_submit_; }
+  void* callback_executor_data() const { return callback_executor_data_; }
+
+  void set_callback_executor(CassCallbackExecutorSubmit submit, void* data) {
+    callback_executor_submit_ = submit;
+    callback_executor_data_ = data;
+  }
+
+  bool work_stealing() const { return work_stealing_; }
+
+  void set_work_stealing(bool enabled) { work_stealing_ = enabled; }
+
+  bool io_uring_enabled() const { return io_uring_enabled_; }
+
+  void set_io_uring_enabled(bool enabled) { io_uring_enabled_ = enabled; }
+
+  bool busy_poll() const { return busy_poll_; }
+  unsigned socket_busy_poll_us() const { return socket_busy_poll_us_; }
+
+  void set_busy_poll(bool enabled, unsigned socket_busy_poll_us) {
+    busy_poll_ = enabled;
+    socket_busy_poll_us_ = socket_busy_poll_us;
+  }
+
+  const Vector<Vector<unsigned> >& io_thread_cpu_sets() const { return io_thread_cpu_sets_; }
+
+  void set_io_thread_cpu_sets(const Vector<Vector<unsigned> >& cpu_sets) {
+    io_thread_cpu_sets_ = cpu_sets;
+  }
+
+  const SharedRuntime::Ptr& shared_runtime() const { return shared_runtime_; }
+
+  void set_shared_runtime(bool enabled) {
+    if (enabled) {
+      if (!shared_runtime_) shared_runtime_.reset(new SharedRuntime());
+    } else {
+      shared_runtime_.reset();
+    }
+  }
+
+  void set_runtime(SharedRuntime* runtime) { shared_runtime_.reset(runtime); }
+
+  bool io_thread_numa_local() const { return io_thread_numa_local_; }
+
+  void set_io_thread_numa_local(bool enabled) { io_thread_numa_local_ = enabled; }
+
+  bool huge_page_buffers() const { return huge_page_buffers_; }
+
+  void set_huge_page_buffers(bool enabled) { huge_page_buffers_ = enabled; }
+
   unsigned queue_size_io() const { return queue_size_io_; }
 
   void set_queue_size_io(unsigned queue_size) { queue_size_io_ = queue_size; }
 
+  unsigned max_inflight_requests() const { return max_inflight_requests_; }
+
+  void set_max_inflight_requests(unsigned num_requests) { max_inflight_requests_ = num_requests; }
+
+  CassBackpressureMode backpressure_mode() const { return backpressure_mode_; }
+
+  void set_backpressure_mode(CassBackpressureMode mode) { backpressure_mode_ = mode; }
+
+  unsigned producer_lanes() const { return producer_lanes_; }
+
+  void set_producer_lanes(unsigned num_lanes) { producer_lanes_ = num_lanes; }
+
+  uint64_t memory_limit() const { return memory_limit_; }
+
+  void set_memory_limit(uint64_t limit_bytes) { memory_limit_ = limit_bytes; }
+
+  unsigned request_arena_size() const { return request_arena_size_; }
+
+  void set_request_arena_size(unsigned size) { request_arena_size_ = size; }
+
   unsigned core_connections_per_host() const { return core_connections_per_host_; }
 
   void set_core_connections_per_host(unsigned num_connections) {
     core_connections_per_host_ = num_connections;
   }
 
+  unsigned core_connections_per_remote_host() const { return core_connections_per_remote_host_; }
+
+  void set_core_connections_per_remote_host(unsigned num_connections) {
+    core_connections_per_remote_host_ = num_connections;
+  }
+
+  unsigned max_connections_per_host() const { return max_connections_per_host_; }
+
+  void set_max_connections_per_host(unsigned num_connections) {
+    max_connections_per_host_ = num_connections;
+  }
+
+  unsigned max_concurrent_requests_threshold() const { return max_concurrent_requests_threshold_; }
+
+  void set_max_concurrent_requests_threshold(unsigned num_requests) {
+    max_concurrent_requests_threshold_ = num_requests;
+  }
+
   ReconnectionPolicy::Ptr reconnection_policy() const { return reconnection_policy_; }
 
   void set_constant_reconnect(uint64_t wait_time_ms) {
@@ -129,6 +297,44 @@ public:
     reconnection_policy_.reset(new ExponentialReconnectionPolicy(base_delay_ms, max_delay_ms));
   }
 
+  void set_decorrelated_jitter_reconnect(uint64_t base_delay_ms, uint64_t max_delay_ms) {
+    reconnection_policy_.reset(
+        new DecorrelatedJitterReconnectionPolicy(base_delay_ms, max_delay_ms));
+  }
+
+  unsigned max_concurrent_connect_attempts_per_host() const {
+    return max_concurrent_connect_attempts_per_host_;
+  }
+
+  void set_max_concurrent_connect_attempts_per_host(unsigned max_attempts) {
+    max_concurrent_connect_attempts_per_host_ = max_attempts;
+  }
+
+  uint64_t host_warmup_duration_ms() const { return host_warmup_duration_ms_; }
+
+  void set_host_warmup_duration_ms(uint64_t duration_ms) { host_warmup_duration_ms_ = duration_ms; }
+
+  unsigned connection_warmup_requests() const { return connection_warmup_requests_; }
+
+  const String& connection_warmup_query() const { return connection_warmup_query_; }
+
+  void set_connection_warmup(unsigned requests_per_connection, const String& query) {
+    connection_warmup_requests_ = requests_per_connection;
+    connection_warmup_query_ = query;
+  }
+
+  bool shard_awareness() const { return shard_awareness_; }
+
+  void set_shard_awareness(bool enable) { shard_awareness_ = enable; }
+
+  unsigned host_probe_interval_ms() const { return host_probe_interval_ms_; }
+
+  void set_host_probe_interval_ms(unsigned interval_ms) { host_probe_interval_ms_ = interval_ms; }
+
+  unsigned event_debounce_window_ms() const { return event_debounce_window_ms_; }
+
+  void set_event_debounce_window_ms(unsigned window_ms) { event_debounce_window_ms_ = window_ms; }
+
   unsigned connect_timeout_ms() const { return connect_timeout_ms_; }
 
   void set_connect_timeout(unsigned timeout_ms) { connect_timeout_ms_ = timeout_ms; }
@@ -137,6 +343,15 @@ public:
 
   void set_max_schema_wait_time_ms(unsigned time_ms) { max_schema_wait_time_ms_ = time_ms; }
 
+  unsigned schema_agreement_interval_ms() const { return schema_agreement_interval_ms_; }
+
+  unsigned max_schema_agreement_interval_ms() const { return max_schema_agreement_interval_ms_; }
+
+  void set_schema_agreement_interval(unsigned interval_ms, unsigned max_interval_ms) {
+    schema_agreement_interval_ms_ = interval_ms;
+    max_schema_agreement_interval_ms_ = max_interval_ms;
+  }
+
   unsigned max_tracing_wait_time_ms() const { return max_tracing_wait_time_ms_; }
 
   void set_max_tracing_wait_time_ms(unsigned time_ms) { max_tracing_wait_time_ms_ = time_ms; }
@@ -149,6 +364,14 @@ public:
 
   void set_tracing_consistency(CassConsistency consistency) { tracing_consistency_ = consistency; }
 
+  bool tracing_wait_for_data() const { return tracing_wait_for_data_; }
+
+  void set_tracing_wait_for_data(bool wait_for_data) { tracing_wait_for_data_ = wait_for_data; }
+
+  void set_tracing_probability(double probability) {
+    default_profile_.set_tracing_probability(probability);
+  }
+
   uint64_t coalesce_delay_us() const { return coalesce_delay_us_; }
 
   void set_coalesce_delay_us(uint64_t delay_us) { coalesce_delay_us_ = delay_us; }
@@ -157,6 +380,94 @@ public:
 
   void set_new_request_ratio(int ratio) { new_request_ratio_ = ratio; }
 
+  double retry_budget_ratio() const { return retry_budget_ratio_; }
+
+  void set_retry_budget_ratio(double ratio) { retry_budget_ratio_ = ratio; }
+
+  unsigned circuit_breaker_failure_threshold() const { return circuit_breaker_failure_threshold_; }
+
+  uint64_t circuit_breaker_open_duration_ms() const { return circuit_breaker_open_duration_ms_; }
+
+  void set_circuit_breaker(unsigned failure_threshold, uint64_t open_duration_ms) {
+    circuit_breaker_failure_threshold_ = failure_threshold;
+    circuit_breaker_open_duration_ms_ = open_duration_ms;
+  }
+
+  unsigned concurrency_limiter_min_limit() const { return concurrency_limiter_min_limit_; }
+
+  unsigned concurrency_limiter_max_limit() const { return concurrency_limiter_max_limit_; }
+
+  uint64_t concurrency_limiter_latency_threshold_ms() const {
+    return concurrency_limiter_latency_threshold_ms_;
+  }
+
+  void set_concurrency_limiter(unsigned min_limit, unsigned max_limit,
+                               uint64_t latency_threshold_ms) {
+    concurrency_limiter_min_limit_ = min_limit;
+    concurrency_limiter_max_limit_ = max_limit;
+    concurrency_limiter_latency_threshold_ms_ = latency_threshold_ms;
+  }
+
+  const FrameCapture::Ptr& frame_capture() const { return frame_capture_; }
+
+  void set_frame_capture(const FrameCapture::Ptr& frame_capture) {
+    frame_capture_ = frame_capture;
+  }
+
+  bool host_and_profile_metrics() const { return host_and_profile_metrics_; }
+
+  void set_host_and_profile_metrics(bool enabled) { host_and_profile_metrics_ = enabled; }
+
+  bool request_stage_metrics() const { return request_stage_metrics_; }
+
+  void set_request_stage_metrics(bool enabled) { request_stage_metrics_ = enabled; }
+
+  unsigned metrics_merge_interval_ms() const { return metrics_merge_interval_ms_; }
+
+  unsigned metrics_snapshot_max_age_ms() const { return metrics_snapshot_max_age_ms_; }
+
+  void set_metrics_snapshot_caching(unsigned merge_interval_ms, unsigned max_age_ms) {
+    metrics_merge_interval_ms_ = merge_interval_ms;
+    metrics_snapshot_max_age_ms_ = max_age_ms;
+  }
+
+  uint64_t slow_request_threshold_ms() const { return slow_request_threshold_ms_; }
+
+  unsigned slow_request_log_capacity() const { return slow_request_log_capacity_; }
+
+  void set_slow_request_log(uint64_t threshold_ms, unsigned capacity) {
+    slow_request_threshold_ms_ = threshold_ms;
+    slow_request_log_capacity_ = capacity;
+  }
+
+  CassSlowRequestCallback slow_request_callback() const { return slow_request_callback_; }
+
+  void* slow_request_data() const { return slow_request_data_; }
+
+  void set_slow_request_callback(CassSlowRequestCallback callback, void* data) {
+    slow_request_callback_ = callback;
+    slow_request_data_ = data;
+  }
+
+  CassRequestTracerCallback request_tracer_callback() const { return request_tracer_callback_; }
+
+  void* request_tracer_data() const { return request_tracer_data_; }
+
+  void set_request_tracer(CassRequestTracerCallback callback, void* data) {
+    request_tracer_callback_ = callback;
+    request_tracer_data_ = data;
+  }
+
+  CassCoalesceMode coalesce_mode() const { return coalesce_mode_; }
+
+  void set_coalesce_mode(CassCoalesceMode mode) { coalesce_mode_ = mode; }
+
+  uint64_t coalesce_latency_budget_us() const { return coalesce_latency_budget_us_; }
+
+  void set_coalesce_latency_budget_us(uint64_t budget_us) {
+    coalesce_latency_budget_us_ = budget_us;
+  }
+
   unsigned request_timeout() { return default_profile_.request_timeout_ms(); }
   void set_request_timeout(unsigned timeout_ms) {
     default_profile_.set_request_timeout(timeout_ms);
@@ -166,6 +477,33 @@ public:
 
   void set_resolve_timeout(unsigned timeout_ms) { resolve_timeout_ms_ = timeout_ms; }
 
+  unsigned close_timeout_ms() const { return close_timeout_ms_; }
+
+  void set_close_timeout(unsigned timeout_ms) { close_timeout_ms_ = timeout_ms; }
+
+  unsigned host_drain_timeout_ms() const { return host_drain_timeout_ms_; }
+
+  void set_host_drain_timeout(unsigned timeout_ms) { host_drain_timeout_ms_ = timeout_ms; }
+
+  bool lazy_remote_pools() const { return lazy_remote_pools_; }
+
+  unsigned remote_pool_idle_timeout_secs() const { return remote_pool_idle_timeout_secs_; }
+
+  void set_lazy_remote_pools(bool enable, unsigned idle_timeout_secs) {
+    lazy_remote_pools_ = enable;
+    remote_pool_idle_timeout_secs_ = idle_timeout_secs;
+  }
+
+  const ResolverCache::Ptr& resolver_cache() const { return resolver_cache_; }
+
+  void set_resolve_cache_ttl(unsigned ttl_ms, unsigned negative_ttl_ms) {
+    if (ttl_ms > 0 || negative_ttl_ms > 0) {
+      resolver_cache_.reset(new ResolverCache(ttl_ms, negative_ttl_ms));
+    } else {
+      resolver_cache_.reset();
+    }
+  }
+
   const AddressVec& contact_points() const { return contact_points_; }
 
   AddressVec& contact_points() { return contact_points_; }
@@ -243,6 +581,18 @@ public:
     default_profile_.set_token_aware_routing_shuffle_replicas(shuffle_replicas);
   }
 
+  void set_token_aware_routing_least_loaded_replicas(bool least_loaded_replicas) {
+    default_profile_.set_token_aware_routing_least_loaded_replicas(least_loaded_replicas);
+  }
+
+  void set_connection_selection(CassConnectionSelection selection) {
+    default_profile_.set_connection_selection(selection);
+  }
+
+  void set_rate_limit(double requests_per_second, unsigned burst) {
+    default_profile_.set_rate_limit(requests_per_second, burst);
+  }
+
   void set_latency_aware_routing(bool is_latency_aware) {
     default_profile_.set_latency_aware_routing(is_latency_aware);
   }
@@ -263,6 +613,18 @@ public:
     tcp_keepalive_delay_secs_ = delay_secs;
   }
 
+  unsigned socket_receive_buffer_size() const { return socket_receive_buffer_size_; }
+  unsigned socket_send_buffer_size() const { return socket_send_buffer_size_; }
+
+  void set_socket_buffer_sizes(unsigned receive_buffer_size, unsigned send_buffer_size) {
+    socket_receive_buffer_size_ = receive_buffer_size;
+    socket_send_buffer_size_ = send_buffer_size;
+  }
+
+  unsigned tcp_notsent_lowat() const { return tcp_notsent_lowat_; }
+
+  void set_tcp_notsent_lowat(unsigned bytes) { tcp_notsent_lowat_ = bytes; }
+
   unsigned connection_idle_timeout_secs() const { return connection_idle_timeout_secs_; }
 
   void set_connection_idle_timeout_secs(unsigned timeout_secs) {
@@ -291,6 +653,30 @@ public:
   bool use_schema() const { return use_schema_; }
   void set_use_schema(bool enable) { use_schema_ = enable; }
 
+  bool use_lazy_schema() const { return use_lazy_schema_; }
+  void set_use_lazy_schema(bool enable) { use_lazy_schema_ = enable; }
+
+  const StringVec& schema_keyspaces() const { return schema_keyspaces_; }
+  StringVec& schema_keyspaces() { return schema_keyspaces_; }
+
+  bool use_parallel_startup() const { return use_parallel_startup_; }
+  void set_use_parallel_startup(bool enable) { use_parallel_startup_ = enable; }
+
+  bool token_aware_batch_splitting() const { return token_aware_batch_splitting_; }
+  void set_token_aware_batch_splitting(bool enable) { token_aware_batch_splitting_ = enable; }
+
+  bool read_coalescing() const { return read_coalescing_; }
+  void set_read_coalescing(bool enable) { read_coalescing_ = enable; }
+
+  size_t batch_split_size() const { return batch_split_size_; }
+  void set_batch_split_size(size_t size) { batch_split_size_ = size; }
+
+  unsigned low_priority_weight() const { return low_priority_weight_; }
+  void set_low_priority_weight(unsigned weight) { low_priority_weight_ = weight; }
+
+  unsigned reserved_streams() const { return reserved_streams_; }
+  void set_reserved_streams(unsigned count) { reserved_streams_ = count; }
+
   bool use_hostname_resolution() const { return use_hostname_resolution_; }
   void set_use_hostname_resolution(bool enable) { use_hostname_resolution_ = enable; }
 
@@ -311,9 +697,15 @@ public:
   void set_execution_profile(const String& name, const ExecutionProfile* profile) {
     ExecutionProfile copy = *profile;
     copy.build_load_balancing_policy();
+    ExecutionProfile::Map::const_iterator it = profiles_.find(name);
+    copy.set_handle(it != profiles_.end() ? it->second.handle()
+                                          : static_cast<int32_t>(profiles_.size()));
     profiles_[name] = copy;
   }
 
+  // Initialize a profile's unset settings from the default profile
+  void init_profile(ExecutionProfile& profile) const;
+
   bool prepare_on_all_hosts() const { return prepare_on_all_hosts_; }
 
   void set_prepare_on_all_hosts(bool enabled) { prepare_on_all_hosts_ = enabled; }
@@ -322,14 +714,65 @@ public:
 
   void set_prepare_on_up_or_add_host(bool enabled) { prepare_on_up_or_add_host_ = enabled; }
 
-  const Address& local_address() const { return local_address_; }
+  bool prepare_on_unprepared_host() const { return prepare_on_unprepared_host_; }
 
-  void set_local_address(const Address& address) { local_address_ = address; }
+  void set_prepare_on_unprepared_host(bool enabled) { prepare_on_unprepared_host_ = enabled; }
+
+  const AddressVec& local_addresses() const { return local_addresses_; }
+
+  void set_local_addresses(const AddressVec& addresses) { local_addresses_ = addresses; }
+
+  void set_local_address(const Address& address) {
+    local_addresses_.clear();
+    if (address.is_valid()) {
+      local_addresses_.push_back(address);
+    }
+  }
 
   bool no_compact() const { return no_compact_; }
 
   void set_no_compact(bool enabled) { no_compact_ = enabled; }
 
+  bool pipelined_startup() const { return pipelined_startup_; }
+
+  void set_pipelined_startup(bool enabled) { pipelined_startup_ = enabled; }
+
+  CassCompressionType compression() const { return compression_; }
+
+  void set_compression(CassCompressionType type) { compression_ = type; }
+
+  unsigned compression_threshold() const { return compression_threshold_; }
+
+  void set_compression_threshold(unsigned threshold_bytes) {
+    compression_threshold_ = threshold_bytes;
+  }
+
+  unsigned result_decode_offload_threshold() const { return result_decode_offload_threshold_; }
+
+  void set_result_decode_offload_threshold(unsigned threshold_bytes) {
+    result_decode_offload_threshold_ = threshold_bytes;
+  }
+
+  unsigned max_outstanding_write_bytes_per_connection() const {
+    return max_outstanding_write_bytes_per_connection_;
+  }
+
+  void set_max_outstanding_write_bytes_per_connection(unsigned num_bytes) {
+    max_outstanding_write_bytes_per_connection_ = num_bytes;
+  }
+
+  const String& prepared_cache_file() const { return prepared_cache_file_; }
+
+  void set_prepared_cache_file(const String& path) { prepared_cache_file_ = path; }
+
+  unsigned max_prepared_statements() const { return max_prepared_statements_; }
+
+  void set_max_prepared_statements(unsigned count) { max_prepared_statements_ = count; }
+
+  unsigned result_cache_size() const { return result_cache_size_; }
+
+  void set_result_cache_size(unsigned max_entries) { result_cache_size_ = max_entries; }
+
   const String& application_name() const { return application_name_; }
 
   void set_application_name(const String& application_name) {
@@ -372,6 +815,9 @@ public:
     return cloud_secure_connection_config_.load(path, this);
   }
 
+  const String& cloud_metadata_cache_file() const { return cloud_metadata_cache_file_; }
+  void set_cloud_metadata_cache_file(const String& path) { cloud_metadata_cache_file_ = path; }
+
   const ClusterMetadataResolverFactory::Ptr& cluster_metadata_resolver_factory() const {
     return cluster_metadata_resolver_factory_;
   }
@@ -401,17 +847,63 @@ private:
   bool use_beta_protocol_version_;
   AddressVec contact_points_;
   unsigned thread_count_io_;
+  unsigned thread_count_callback_;
+  CassCallbackExecutorSubmit callback_executor_submit_;
+  void* callback_executor_data_;
+  bool work_stealing_;
+  bool io_uring_enabled_;
+  bool busy_poll_;
+  unsigned socket_busy_poll_us_;
+  Vector<Vector<unsigned> > io_thread_cpu_sets_;
+  SharedRuntime::Ptr shared_runtime_;
+  bool io_thread_numa_local_;
+  bool huge_page_buffers_;
   unsigned queue_size_io_;
+  unsigned max_inflight_requests_;
+  CassBackpressureMode backpressure_mode_;
+  unsigned producer_lanes_;
+  uint64_t memory_limit_;
+  unsigned request_arena_size_;
   unsigned core_connections_per_host_;
+  unsigned core_connections_per_remote_host_;
+  unsigned max_connections_per_host_;
+  unsigned max_concurrent_requests_threshold_;
   SharedRefPtr<ReconnectionPolicy> reconnection_policy_;
   unsigned connect_timeout_ms_;
   unsigned resolve_timeout_ms_;
+  unsigned close_timeout_ms_;
+  unsigned host_drain_timeout_ms_;
+  bool lazy_remote_pools_;
+  unsigned remote_pool_idle_timeout_secs_;
+  ResolverCache::Ptr resolver_cache_;
   unsigned max_schema_wait_time_ms_;
+  unsigned schema_agreement_interval_ms_;
+  unsigned max_schema_agreement_interval_ms_;
   unsigned max_tracing_wait_time_ms_;
   unsigned retry_tracing_wait_time_ms_;
   CassConsistency tracing_consistency_;
+  bool tracing_wait_for_data_;
   uint64_t coalesce_delay_us_;
   int new_request_ratio_;
+  double retry_budget_ratio_;
+  unsigned circuit_breaker_failure_threshold_;
+  uint64_t circuit_breaker_open_duration_ms_;
+  unsigned concurrency_limiter_min_limit_;
+  unsigned concurrency_limiter_max_limit_;
+  uint64_t concurrency_limiter_latency_threshold_ms_;
+  FrameCapture::Ptr frame_capture_;
+  bool host_and_profile_metrics_;
+  bool request_stage_metrics_;
+  unsigned metrics_merge_interval_ms_;
+  unsigned metrics_snapshot_max_age_ms_;
+  uint64_t slow_request_threshold_ms_;
+  unsigned slow_request_log_capacity_;
+  CassSlowRequestCallback slow_request_callback_;
+  void* slow_request_data_;
+  CassRequestTracerCallback request_tracer_callback_;
+  void* request_tracer_data_;
+  CassCoalesceMode coalesce_mode_;
+  uint64_t coalesce_latency_budget_us_;
   CassLogLevel log_level_;
   CassLogCallback log_callback_;
   void* log_data_;
@@ -420,10 +912,21 @@ private:
   bool tcp_nodelay_enable_;
   bool tcp_keepalive_enable_;
   unsigned tcp_keepalive_delay_secs_;
+  unsigned socket_receive_buffer_size_;
+  unsigned socket_send_buffer_size_;
+  unsigned tcp_notsent_lowat_;
   unsigned connection_idle_timeout_secs_;
   unsigned connection_heartbeat_interval_secs_;
   SharedRefPtr<TimestampGenerator> timestamp_gen_;
   bool use_schema_;
+  bool use_lazy_schema_;
+  StringVec schema_keyspaces_;
+  bool use_parallel_startup_;
+  bool token_aware_batch_splitting_;
+  bool read_coalescing_;
+  size_t batch_split_size_;
+  unsigned low_priority_weight_;
+  unsigned reserved_streams_;
   bool use_hostname_resolution_;
   bool use_randomized_contact_points_;
   unsigned max_reusable_write_objects_;
@@ -431,8 +934,24 @@ private:
   ExecutionProfile::Map profiles_;
   bool prepare_on_all_hosts_;
   bool prepare_on_up_or_add_host_;
-  Address local_address_;
+  bool prepare_on_unprepared_host_;
+  AddressVec local_addresses_;
   bool no_compact_;
+  bool pipelined_startup_;
+  CassCompressionType compression_;
+  unsigned compression_threshold_;
+  unsigned result_decode_offload_threshold_;
+  unsigned max_outstanding_write_bytes_per_connection_;
+  String prepared_cache_file_;
+  unsigned max_prepared_statements_;
+  unsigned result_cache_size_;
+  unsigned max_concurrent_connect_attempts_per_host_;
+  uint64_t host_warmup_duration_ms_;
+  unsigned connection_warmup_requests_;
+  String connection_warmup_query_;
+  bool shard_awareness_;
+  unsigned host_probe_interval_ms_;
+  unsigned event_debounce_window_ms_;
   String application_name_;
   String application_version_;
   bool is_client_id_set_;
@@ -440,6 +959,7 @@ private:
   DefaultHostListener::Ptr host_listener_;
   unsigned monitor_reporting_interval_secs_;
   CloudSecureConnectionConfig cloud_secure_connection_config_;
+  String cloud_metadata_cache_file_;
   ClusterMetadataResolverFactory::Ptr cluster_metadata_resolver_factory_;
 };
 
@@ -16,12 +16,18 @@
 
 #include "connection.hpp"
 
+#include "compression.hpp"
+#include "event_loop.hpp"
 #include "event_response.hpp"
 #include "options_request.hpp"
 #include "request.hpp"
 #include "result_response.hpp"
+#include "segment.hpp"
+
+#include <algorithm>
 
 using namespace datastax;
+using namespace datastax::internal;
 using namespace datastax::internal::core;
 
 namespace datastax { namespace internal { namespace core {
@@ -71,8 +77,12 @@ class NopConnectionListener : public ConnectionListener {
 
 static NopConnectionListener nop_listener__;
 
+ConnectionHandler::ConnectionHandler(Connection* connection)
+    : SocketHandler(connection->buffer_pool())
+    , connection_(connection) {}
+
 void ConnectionHandler::on_read(Socket* socket, ssize_t nread, const uv_buf_t* buf) {
-  connection_->on_read(buf->base, nread);
+  connection_->on_read(buf->base, nread, read_buffer());
   free_buffer(buf);
 }
 
@@ -80,16 +90,28 @@ void ConnectionHandler::on_write(Socket* socket, int status, SocketRequest* requ
   connection_->on_write(status, static_cast<RequestCallback*>(request));
 }
 
+void ConnectionHandler::on_flush(Socket* socket, const SizeVec& sizes, BufferVec* bufs) {
+  connection_->on_flush(sizes, bufs);
+}
+
 void ConnectionHandler::on_close() { connection_->on_close(); }
 
+SslConnectionHandler::SslConnectionHandler(SslSession* ssl_session, Connection* connection)
+    : SslSocketHandler(ssl_session, connection->buffer_pool())
+    , connection_(connection) {}
+
 void SslConnectionHandler::on_ssl_read(Socket* socket, char* buf, size_t size) {
-  connection_->on_read(buf, size);
+  connection_->on_read(buf, size, read_buffer());
 }
 
 void SslConnectionHandler::on_write(Socket* socket, int status, SocketRequest* request) {
   connection_->on_write(status, static_cast<RequestCallback*>(request));
 }
 
+void SslConnectionHandler::on_flush(Socket* socket, const SizeVec& sizes, BufferVec* bufs) {
+  connection_->on_flush(sizes, bufs);
+}
+
 void SslConnectionHandler::on_close() { connection_->on_close(); }
 
 }}} // namespace datastax::internal::core
@@ -109,11 +131,18 @@ Connection::Connection(const Socket::Ptr& socket, const Host::Ptr& host,
     , host_(host)
     , inflight_request_count_(0)
     , response_(new ResponseMessage())
+    , decode_offload_threshold_(0)
+    , event_loop_(NULL)
+    , max_outstanding_write_bytes_(0)
+    , frame_capture_id_(0)
+    , compression_threshold_(0)
     , listener_(&nop_listener__)
     , protocol_version_(protocol_version)
     , idle_timeout_secs_(idle_timeout_secs)
     , heartbeat_interval_secs_(heartbeat_interval_secs)
-    , heartbeat_outstanding_(false) {
+    , heartbeat_outstanding_(false)
+    , last_write_ms_(0)
+    , last_read_ms_(0) {
   inc_ref(); // For the event loop
   host_->increment_connection_count();
 }
@@ -140,7 +169,7 @@ int32_t Connection::write(const RequestCallback::Ptr& callback) {
   }
 
   // Add to the inflight count after we've cleared all posssible errors.
-  inflight_request_count_.fetch_add(1);
+  host_->record_connection_inflight_requests(inflight_request_count_.fetch_add(1) + 1);
 
   LOG_TRACE("Sending message type %s with stream %d on host %s",
             opcode_to_string(callback->request()->opcode()).c_str(), stream,
@@ -170,8 +199,38 @@ void Connection::set_listener(ConnectionListener* listener) {
 }
 
 void Connection::start_heartbeats() {
-  restart_heartbeat_timer();
-  restart_terminate_timer();
+  last_write_ms_ = last_read_ms_ = uv_now(socket_->loop());
+  start_heartbeat_timer(1000 * static_cast<uint64_t>(heartbeat_interval_secs_));
+  start_terminate_timer(1000 * static_cast<uint64_t>(idle_timeout_secs_));
+}
+
+void Connection::set_compressor(Compressor* compressor, size_t threshold) {
+  compressor_.reset(compressor);
+  compression_threshold_ = threshold;
+  response_->set_compressor(compressor);
+}
+
+void Connection::set_buffer_pool(const BufferPool::Ptr& buffer_pool) {
+  buffer_pool_ = buffer_pool;
+  response_->set_buffer_pool(buffer_pool.get());
+}
+
+void Connection::set_decode_offload_threshold(size_t threshold) {
+  decode_offload_threshold_ = threshold;
+  response_->set_deferred_body_threshold(threshold);
+}
+
+void Connection::set_frame_capture(const FrameCapture::Ptr& frame_capture) {
+  frame_capture_ = frame_capture;
+  frame_capture_id_ = frame_capture->next_connection_id();
+}
+
+void Connection::start_segment_framing() {
+  if (!segment_decoder_) {
+    LOG_DEBUG("Using segment framing for connection to host %s", host_->address_string().c_str());
+    segment_encoder_.reset(new SegmentEncoder());
+    segment_decoder_.reset(new SegmentDecoder());
+  }
 }
 
 void Connection::maybe_set_keyspace(ResponseMessage* response) {
@@ -186,10 +245,10 @@ void Connection::maybe_set_keyspace(ResponseMessage* response) {
 void Connection::on_write(int status, RequestCallback* request) {
   listener_->on_write();
 
-  // A successful write means that a heartbeat doesn't need to be sent so the
-  // timer can be reset.
+  // A successful write means that a heartbeat doesn't need to be sent until
+  // the connection has been idle for the heartbeat interval
   if (status == 0) {
-    restart_heartbeat_timer();
+    last_write_ms_ = uv_now(socket_->loop());
   }
 
   // Keep alive after releasing from the stream manager.
@@ -204,7 +263,7 @@ void Connection::on_write(int status, RequestCallback* request) {
         stream_manager_.release(callback->stream());
         inflight_request_count_.fetch_sub(1);
         callback->set_state(RequestCallback::REQUEST_STATE_FINISHED);
-        callback->on_error(CASS_ERROR_LIB_WRITE_ERROR, "Unable to write to socket");
+        callback->on_write_error();
       }
       break;
 
@@ -227,79 +286,318 @@ void Connection::on_write(int status, RequestCallback* request) {
   }
 }
 
-void Connection::on_read(const char* buf, size_t size) {
+void Connection::on_flush(const SizeVec& sizes, BufferVec* bufs) {
+  // The requests are captured as envelopes, before they're packed into
+  // segments
+  if (frame_capture_) {
+    capture_requests(sizes, *bufs);
+  }
+
+  if (segment_encoder_) {
+    segment_encoder_->encode(sizes, bufs);
+  }
+
+  size_t bytes = 0;
+  for (BufferVec::const_iterator it = bufs->begin(), end = bufs->end(); it != end; ++it) {
+    bytes += it->size();
+  }
+  host_->record_flush(sizes.size(), bytes, socket_->write_queue_size());
+}
+
+void Connection::capture_requests(const SizeVec& sizes, const BufferVec& bufs) {
+  // The requests' envelopes are laid out back to back across the buffers
+  BufferVec::const_iterator it = bufs.begin();
+  size_t offset = 0;
+  String frame;
+  for (SizeVec::const_iterator size = sizes.begin(); size != sizes.end(); ++size) {
+    frame.clear();
+    while (frame.size() < *size && it != bufs.end()) {
+      size_t count = std::min(*size - frame.size(), it->size() - offset);
+      frame.append(it->data() + offset, count);
+      offset += count;
+      if (offset == it->size()) {
+        ++it;
+        offset = 0;
+      }
+    }
+    frame_capture_->record(frame_capture_id_, FrameCapture::DIRECTION_REQUEST, frame.data(),
+                           frame.size());
+  }
+}
+
+void Connection::on_read(const char* buf, size_t size, RefBuffer* buffer) {
   listener_->on_read();
+  host_->record_read(size);
+
+  // A successful read means the connection is still responsive
+  last_read_ms_ = uv_now(socket_->loop());
+
+  if (segment_decoder_) {
+    decode_segments(buf, size, buffer);
+  } else {
+    decode_envelopes(buf, size, buffer, false);
+  }
+}
 
+void Connection::decode_segments(const char* buf, size_t size, RefBuffer* buffer) {
   const char* pos = buf;
   size_t remaining = size;
 
-  // A successful read means the connection is still responsive
-  restart_terminate_timer();
+  while (remaining != 0 && !socket_->is_closing()) {
+    ssize_t consumed = segment_decoder_->decode(pos, remaining);
+    if (consumed <= 0) {
+      LOG_ERROR("Error decoding/consuming segment (invalid checksum)");
+      defunct();
+      continue;
+    }
+
+    if (segment_decoder_->is_ready()) {
+      decode_envelopes(segment_decoder_->payload(), segment_decoder_->payload_length(),
+                       segment_decoder_->is_payload_copied() ? NULL : buffer, true);
+    }
+    remaining -= consumed;
+    pos += consumed;
+  }
+}
+
+void Connection::decode_envelopes(const char* buf, size_t size, RefBuffer* buffer,
+                                  bool is_segment_payload) {
+  const char* pos = buf;
+  size_t remaining = size;
 
   while (remaining != 0 && !socket_->is_closing()) {
-    ssize_t consumed = response_->decode(pos, remaining);
+    ssize_t consumed = response_->decode(pos, remaining, buffer);
     if (consumed <= 0) {
       LOG_ERROR("Error decoding/consuming message");
       defunct();
       continue;
     }
 
+    if (frame_capture_) {
+      captured_response_.append(pos, consumed);
+    }
+
     if (response_->is_body_ready()) {
+      if (frame_capture_) {
+        frame_capture_->record(frame_capture_id_, FrameCapture::DIRECTION_RESPONSE,
+                               captured_response_.data(), captured_response_.size());
+        captured_response_.clear();
+      }
+
       ScopedPtr<ResponseMessage> response(response_.release());
-      response_.reset(new ResponseMessage());
+      response_.reset(new ResponseMessage(compressor_.get(), buffer_pool_.get()));
+      response_->set_deferred_body_threshold(decode_offload_threshold_);
 
       LOG_TRACE("Consumed message type %s with stream %d, input %u, remaining %u on host %s",
                 opcode_to_string(response->opcode()).c_str(), static_cast<int>(response->stream()),
                 static_cast<unsigned int>(size), static_cast<unsigned int>(remaining),
                 host_->address_string().c_str());
 
-      if (response->stream() < 0) {
-        if (response->opcode() == CQL_OPCODE_EVENT) {
-          listener_->on_event(response->response_body());
-        } else {
-          LOG_ERROR("Invalid response opcode for event stream: %s",
-                    opcode_to_string(response->opcode()).c_str());
-          defunct();
-          continue;
-        }
-      } else {
-        RequestCallback::Ptr callback;
-
-        if (stream_manager_.get(response->stream(), callback)) {
-          switch (callback->state()) {
-            case RequestCallback::REQUEST_STATE_READING:
-              pending_reads_.remove(callback.get());
-              stream_manager_.release(callback->stream());
-              inflight_request_count_.fetch_sub(1);
-              callback->set_state(RequestCallback::REQUEST_STATE_FINISHED);
-              maybe_set_keyspace(response.get());
-              callback->on_set(response.get());
-              break;
-
-            case RequestCallback::REQUEST_STATE_WRITING:
-              // There are cases when the read callback will happen
-              // before the write callback. If this happens we have
-              // to allow the write callback to finish the request.
-              callback->set_state(RequestCallback::REQUEST_STATE_READ_BEFORE_WRITE);
-              // Save the response for the write callback
-              callback->set_read_before_write_response(response.release()); // Transfer ownership
-              break;
-
-            default:
-              LOG_ERROR("Invalid request state %s for stream ID %d", callback->state_string(),
-                        response->stream());
-              defunct();
-              break;
-          }
-        } else {
-          LOG_ERROR("Invalid stream ID %d", response->stream());
+      if (response->is_body_deferred()) {
+        // Decoded on the event loop if the work can't be queued
+        if (!offload_decode(response) && !response->decode_deferred_body()) {
+          LOG_ERROR("Error decoding/consuming message");
           defunct();
           continue;
         }
       }
+
+      if (response && !handle_response(response)) {
+        defunct();
+        continue;
+      }
+    } else if (response_->opcode() == CQL_OPCODE_RESULT && response_->stream() >= 0) {
+      handle_partial_body();
     }
     remaining -= consumed;
     pos += consumed;
+
+    // The rest of the data is segments if the response switched the framing
+    if (segment_decoder_ && !is_segment_payload) {
+      decode_segments(pos, remaining, buffer);
+      return;
+    }
+  }
+}
+
+void Connection::handle_partial_body() {
+  size_t received = 0;
+  if (response_->received_body(&received) == NULL) return;
+
+  RequestCallback::Ptr callback;
+  if (stream_manager_.get(response_->stream(), callback) &&
+      (callback->state() == RequestCallback::REQUEST_STATE_READING ||
+       callback->state() == RequestCallback::REQUEST_STATE_WRITING)) {
+    callback->on_partial_body(response_.get());
+  }
+}
+
+bool Connection::handle_response(ScopedPtr<ResponseMessage>& response) {
+  if (response->stream() < 0) {
+    if (response->opcode() == CQL_OPCODE_EVENT) {
+      listener_->on_event(response->response_body());
+    } else {
+      LOG_ERROR("Invalid response opcode for event stream: %s",
+                opcode_to_string(response->opcode()).c_str());
+      return false;
+    }
+  } else {
+    RequestCallback::Ptr callback;
+
+    if (stream_manager_.get(response->stream(), callback)) {
+      // The responses before a request's last response (DSE continuous
+      // paging) don't finish the request. They can be read before the write
+      // callback because the request's write has already been started.
+      if ((callback->state() == RequestCallback::REQUEST_STATE_READING ||
+           callback->state() == RequestCallback::REQUEST_STATE_WRITING) &&
+          callback->on_partial_response(response.get())) {
+        return true;
+      }
+
+      switch (callback->state()) {
+        case RequestCallback::REQUEST_STATE_READING:
+          pending_reads_.remove(callback.get());
+          stream_manager_.release(callback->stream());
+          inflight_request_count_.fetch_sub(1);
+          callback->set_state(RequestCallback::REQUEST_STATE_FINISHED);
+          maybe_set_keyspace(response.get());
+          callback->on_set(response.get());
+          break;
+
+        case RequestCallback::REQUEST_STATE_WRITING:
+          // There are cases when the read callback will happen
+          // before the write callback. If this happens we have
+          // to allow the write callback to finish the request.
+          callback->set_state(RequestCallback::REQUEST_STATE_READ_BEFORE_WRITE);
+          // Save the response for the write callback
+          callback->set_read_before_write_response(response.release()); // Transfer ownership
+          break;
+
+        default:
+          LOG_ERROR("Invalid request state %s for stream ID %d", callback->state_string(),
+                    response->stream());
+          defunct();
+          break;
+      }
+    } else {
+      LOG_ERROR("Invalid stream ID %d", response->stream());
+      return false;
+    }
+  }
+  return true;
+}
+
+namespace {
+
+/**
+ * A response body that's decoded using libuv's thread pool. The connection is
+ * kept alive until the response is handled back on its event loop.
+ */
+struct OffloadDecode : public Allocated {
+  OffloadDecode(Connection* connection, ResponseMessage* response)
+      : connection(connection)
+      , response(response)
+      , is_decoded(false) {
+    req.data = this;
+  }
+
+  uv_work_t req;
+  Connection::Ptr connection;
+  ScopedPtr<ResponseMessage> response;
+  bool is_decoded;
+};
+
+} // namespace
+
+/**
+ * A response body that's decoded by any event loop of the connection's group
+ * when work stealing is enabled, so an idle event loop can decode it while the
+ * connection's event loop is busy. The decoded response is handed back to the
+ * connection's event loop.
+ */
+class Connection::StealableDecode : public Task {
+public:
+  StealableDecode(Connection* connection, ResponseMessage* response)
+      : connection_(connection)
+      , response_(response) {}
+
+  virtual void run(EventLoop* event_loop);
+
+private:
+  Connection::Ptr connection_;
+  ScopedPtr<ResponseMessage> response_;
+};
+
+/**
+ * Handles a response that was decoded by another event loop on the
+ * connection's event loop.
+ */
+class Connection::DecodedResponse : public Task {
+public:
+  DecodedResponse(const Connection::Ptr& connection, ResponseMessage* response, bool is_decoded)
+      : connection_(connection)
+      , response_(response)
+      , is_decoded_(is_decoded) {}
+
+  virtual void run(EventLoop* event_loop) { connection_->on_decoded(response_, is_decoded_); }
+
+private:
+  Connection::Ptr connection_;
+  ScopedPtr<ResponseMessage> response_;
+  bool is_decoded_;
+};
+
+void Connection::StealableDecode::run(EventLoop* event_loop) {
+  bool is_decoded = response_->decode_deferred_body();
+  connection_->event_loop_->add(new DecodedResponse(connection_, response_.release(), is_decoded));
+}
+
+bool Connection::offload_decode(ScopedPtr<ResponseMessage>& response) {
+  RoundRobinEventLoopGroup* group = event_loop_ ? event_loop_->stealing_group() : NULL;
+  if (group) {
+    LOG_TRACE("Decoding %s response with stream %d on any event loop for host %s",
+              opcode_to_string(response->opcode()).c_str(), static_cast<int>(response->stream()),
+              host_->address_string().c_str());
+    group->add_stealable(new StealableDecode(this, response.release()));
+    return true;
+  }
+
+  ScopedPtr<OffloadDecode> work(new OffloadDecode(this, response.get()));
+  if (uv_queue_work(loop(), &work->req, on_offload_decode, on_after_offload_decode) != 0) {
+    work->response.release(); // Still owned by the caller
+    return false;
+  }
+  LOG_TRACE("Decoding %s response with stream %d on a worker thread for host %s",
+            opcode_to_string(response->opcode()).c_str(), static_cast<int>(response->stream()),
+            host_->address_string().c_str());
+  response.release();
+  work.release();
+  return true;
+}
+
+void Connection::on_offload_decode(uv_work_t* req) {
+  OffloadDecode* work = static_cast<OffloadDecode*>(req->data);
+  work->is_decoded = work->response->decode_deferred_body();
+}
+
+void Connection::on_after_offload_decode(uv_work_t* req, int status) {
+  ScopedPtr<OffloadDecode> work(static_cast<OffloadDecode*>(req->data));
+  work->connection->on_decoded(work->response, status == 0 && work->is_decoded);
+}
+
+void Connection::on_decoded(ScopedPtr<ResponseMessage>& response, bool is_decoded) {
+  // Requests that were pending when the connection closed have already been
+  // failed by on_close().
+  if (is_closing()) return;
+
+  if (!is_decoded) {
+    LOG_ERROR("Error decoding/consuming message");
+    defunct();
+    return;
+  }
+
+  if (!handle_response(response)) {
+    defunct();
   }
 }
 
@@ -313,14 +611,22 @@ void Connection::on_close() {
   dec_ref();
 }
 
-void Connection::restart_heartbeat_timer() {
+void Connection::start_heartbeat_timer(uint64_t timeout_ms) {
   if (!is_closing() && heartbeat_interval_secs_ > 0) {
-    heartbeat_timer_.start(socket_->loop(), 1000 * heartbeat_interval_secs_,
+    heartbeat_timer_.start(socket_->loop(), timeout_ms,
                            bind_callback(&Connection::on_heartbeat, this));
   }
 }
 
 void Connection::on_heartbeat(Timer* timer) {
+  const uint64_t interval_ms = 1000 * static_cast<uint64_t>(heartbeat_interval_secs_);
+  const uint64_t idle_ms = uv_now(socket_->loop()) - last_write_ms_;
+  if (idle_ms < interval_ms) {
+    // Written to since the timer was started so it isn't idle yet
+    start_heartbeat_timer(interval_ms - idle_ms);
+    return;
+  }
+
   if (!heartbeat_outstanding_ && !socket_->is_closing()) {
     RequestCallback::Ptr callback(new HeartbeatCallback(this));
     if (write_and_flush(callback) < 0) {
@@ -335,19 +641,27 @@ void Connection::on_heartbeat(Timer* timer) {
     heartbeat_outstanding_ = true;
   }
 
-  restart_heartbeat_timer();
+  start_heartbeat_timer(interval_ms);
 }
 
-void Connection::restart_terminate_timer() {
+void Connection::start_terminate_timer(uint64_t timeout_ms) {
   // The terminate timer shouldn't be started without having heartbeats enabled,
   // otherwise connections would be terminated in periods of request inactivity.
   if (!is_closing() && heartbeat_interval_secs_ > 0 && idle_timeout_secs_ > 0) {
-    terminate_timer_.start(socket_->loop(), 1000 * idle_timeout_secs_,
+    terminate_timer_.start(socket_->loop(), timeout_ms,
                            bind_callback(&Connection::on_terminate, this));
   }
 }
 
 void Connection::on_terminate(Timer* timer) {
+  const uint64_t timeout_ms = 1000 * static_cast<uint64_t>(idle_timeout_secs_);
+  const uint64_t idle_ms = uv_now(socket_->loop()) - last_read_ms_;
+  if (idle_ms < timeout_ms) {
+    // Read from since the timer was started so it's still responsive
+    start_terminate_timer(timeout_ms - idle_ms);
+    return;
+  }
+
   LOG_ERROR("Failed to send a heartbeat within connection idle interval. "
             "Terminating connection...");
   defunct();
@@ -15,7 +15,9 @@
 */
 
 #include "event_response.hpp"
+#include "frame_capture.hpp"
 #include "request_callback.hpp"
+#include "sharding_info.hpp"
 #include "socket.hpp"
 #include "stream_manager.hpp"
 
@@ -24,7 +26,11 @@
 
 namespace datastax { namespace internal { namespace core {
 
+class Compressor;
+class EventLoop;
 class ResponseMessage;
+class SegmentDecoder;
+class SegmentEncoder;
 class EventResponse;
 class Connection;
 
@@ -33,11 +39,11 @@ class Connection;
  */
 class ConnectionHandler : public SocketHandler {
 public:
-  ConnectionHandler(Connection* connection)
-      : connection_(connection) {}
+  ConnectionHandler(Connection* connection);
 
   virtual void on_read(Socket* socket, ssize_t nread, const uv_buf_t* buf);
   virtual void on_write(Socket* socket, int status, SocketRequest* request);
+  virtual void on_flush(Socket* socket, const SizeVec& sizes, BufferVec* bufs);
   virtual void on_close();
 
 private:
@@ -49,12 +55,11 @@ private:
  */
 class SslConnectionHandler : public SslSocketHandler {
 public:
-  SslConnectionHandler(SslSession* ssl_session, Connection* connection)
-      : SslSocketHandler(ssl_session)
-      , connection_(connection) {}
+  SslConnectionHandler(SslSession* ssl_session, Connection* connection);
 
   virtual void on_ssl_read(Socket* socket, char* buf, size_t size);
   virtual void on_write(Socket* socket, int status, SocketRequest* request);
+  virtual void on_flush(Socket* socket, const SizeVec& sizes, BufferVec* bufs);
   virtual void on_close();
 
 private:
@@ -201,6 +206,93 @@ public:
    */
   void start_heartbeats();
 
+  /**
+   * Set the compressor used to compress request bodies and decompress
+   * response bodies. This should only be set after the STARTUP request that
+   * negotiated the compression algorithm has been written.
+   *
+   * @param compressor The compressor (the connection takes ownership).
+   * @param threshold The minimum size of a request body before it's
+   * compressed.
+   */
+  void set_compressor(Compressor* compressor, size_t threshold);
+
+  /**
+   * Switch the connection to the protocol v5 segment framing. All data
+   * written after this call is packed into segments and all data read after
+   * the response that triggered the switch (READY or AUTHENTICATE) is
+   * expected to be segments. Calling this more than once has no effect.
+   */
+  void start_segment_framing();
+
+  /**
+   * Set the pool used to allocate read buffers and response bodies. This
+   * must be set before the connection's socket handler is created.
+   *
+   * @param buffer_pool The buffer pool.
+   */
+  void set_buffer_pool(const BufferPool::Ptr& buffer_pool);
+
+  /**
+   * Set the minimum size of a RESULT response body that's decoded using
+   * libuv's thread pool (or another event loop, see set_event_loop()) instead
+   * of on the connection's event loop. The response is handled back on the
+   * event loop once it's decoded.
+   *
+   * @param threshold The minimum body size in bytes or zero to disable.
+   */
+  void set_decode_offload_threshold(size_t threshold);
+
+  /**
+   * Set the event loop the connection runs on. If the event loop's group has
+   * work stealing enabled then offloaded response bodies are decoded by the
+   * group's idle event loops instead of libuv's thread pool.
+   *
+   * @param event_loop The connection's event loop.
+   */
+  void set_event_loop(EventLoop* event_loop) { event_loop_ = event_loop; }
+
+  /**
+   * Set the number of bytes that can be outstanding on the connection's
+   * socket before the connection is considered saturated.
+   *
+   * @param num_bytes The number of bytes or zero for no limit.
+   *
+   * @see is_write_queue_full()
+   */
+  void set_max_outstanding_write_bytes(size_t num_bytes) {
+    max_outstanding_write_bytes_ = num_bytes;
+  }
+
+  /**
+   * Record the frames sent and received by the connection. This must be set
+   * before the connection's socket handler is created.
+   *
+   * @param frame_capture The capture that records the frames.
+   */
+  void set_frame_capture(const FrameCapture::Ptr& frame_capture);
+
+  /**
+   * Determine if the connection is saturated because the requests written
+   * to it, but not yet written to the network, exceed the maximum number of
+   * outstanding bytes. Requests are still accepted by write(), but new
+   * requests should be sent elsewhere.
+   *
+   * @return Returns true if the write queue is full.
+   */
+  bool is_write_queue_full() const {
+    return max_outstanding_write_bytes_ > 0 &&
+           socket_->outstanding_write_bytes() >= max_outstanding_write_bytes_;
+  }
+
+  /**
+   * Set the sharding of the host and the shard that owns the connection.
+   *
+   * @param sharding_info The sharding advertised by the connection's SUPPORTED
+   * response.
+   */
+  void set_sharding_info(const ShardingInfo& sharding_info) { sharding_info_ = sharding_info; }
+
 public:
   const Address& address() const { return host_->address(); }
   const String& address_string() const { return host_->address_string(); }
@@ -213,18 +305,45 @@ public:
 
   int inflight_request_count() const { return inflight_request_count_.load(MEMORY_ORDER_RELAXED); }
 
+  // Only valid on the connection's event loop thread
+  size_t available_streams() const { return stream_manager_.available_streams(); }
+
+  const ShardingInfo& sharding_info() const { return sharding_info_; }
+
+  const BufferPool::Ptr& buffer_pool() const { return buffer_pool_; }
+  Compressor* compressor() const { return compressor_.get(); }
+  size_t compression_threshold() const { return compression_threshold_; }
+
 private:
   void maybe_set_keyspace(ResponseMessage* response);
 
   void on_write(int status, RequestCallback* request);
-  void on_read(const char* buf, size_t size);
+  void on_flush(const SizeVec& sizes, BufferVec* bufs);
+  void capture_requests(const SizeVec& sizes, const BufferVec& bufs);
+  void on_read(const char* buf, size_t size, RefBuffer* buffer);
   void on_close();
 
+  void decode_segments(const char* buf, size_t size, RefBuffer* buffer);
+  void decode_envelopes(const char* buf, size_t size, RefBuffer* buffer, bool is_segment_payload);
+  bool handle_response(ScopedPtr<ResponseMessage>& response);
+  void handle_partial_body();
+
+  bool offload_decode(ScopedPtr<ResponseMessage>& response);
+  static void on_offload_decode(uv_work_t* req);
+  static void on_after_offload_decode(uv_work_t* req, int status);
+  void on_decoded(ScopedPtr<ResponseMessage>& response, bool is_decoded);
+
+  class StealableDecode;
+  class DecodedResponse;
+
 private:
-  void restart_heartbeat_timer();
+  // Reads and writes only record their time; the timers aren't restarted for
+  // every event. When a timer expires it's started again for the rest of the
+  // interval if the connection was active in the meantime.
+  void start_heartbeat_timer(uint64_t timeout_ms);
   void on_heartbeat(Timer* timer);
 
-  void restart_terminate_timer();
+  void start_terminate_timer(uint64_t timeout_ms);
   void on_terminate(Timer* timer);
 
 private:
@@ -234,16 +353,33 @@ private:
   Atomic<int> inflight_request_count_;
 
   List<SocketRequest> pending_reads_;
+  BufferPool::Ptr buffer_pool_;
   ScopedPtr<ResponseMessage> response_;
+  size_t decode_offload_threshold_;
+  EventLoop* event_loop_;
+  size_t max_outstanding_write_bytes_;
+
+  FrameCapture::Ptr frame_capture_;
+  int32_t frame_capture_id_;
+  String captured_response_; // The part of the current response read so far
+
+  ScopedPtr<Compressor> compressor_;
+  size_t compression_threshold_;
+
+  ScopedPtr<SegmentEncoder> segment_encoder_;
+  ScopedPtr<SegmentDecoder> segment_decoder_;
 
   ConnectionListener* listener_;
 
   ProtocolVersion protocol_version_;
   String keyspace_;
+  ShardingInfo sharding_info_;
 
   unsigned int idle_timeout_secs_;
   unsigned int heartbeat_interval_secs_;
   bool heartbeat_outstanding_;
+  uint64_t last_write_ms_; // The loop's time of the last successful write
+  uint64_t last_read_ms_;  // The loop's time of the last read
   Timer heartbeat_timer_;
   Timer terminate_timer_;
 };
@@ -18,11 +18,29 @@
 
 #include "config.hpp"
 #include "connection_pool_manager.hpp"
+#include "get_time.hpp"
 #include "metrics.hpp"
+#include "murmur3.hpp"
+#include "request.hpp"
 #include "utils.hpp"
 
 #include <algorithm>
 
+// How often a dynamically sized pool checks the load on its connections
+#define SIZING_INTERVAL_MS 100
+
+// The number of consecutive checks the connections must be above the threshold
+// before a connection is added
+#define GROW_AFTER_INTERVALS 3
+
+// The number of consecutive checks a connection must be idle before an extra
+// connection is closed
+#define SHRINK_AFTER_INTERVALS 600
+
+// How often a draining pool checks if its connections still have requests
+// in-flight
+#define DRAIN_INTERVAL_MS 100
+
 using namespace datastax;
 using namespace datastax::internal::core;
 
@@ -37,14 +55,51 @@ static inline bool least_busy_comp(const PooledConnection::Ptr& a, const PooledC
   return a->inflight_request_count() < b->inflight_request_count();
 }
 
+// A xorshift generator; selection only needs to be cheap, not high quality.
+static inline uint64_t next_random(uint64_t* state) {
+  uint64_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  return *state = x;
+}
+
+static inline bool is_routable(const Request* request) {
+  uint8_t opcode = request->opcode();
+  return opcode == CQL_OPCODE_QUERY || opcode == CQL_OPCODE_EXECUTE || opcode == CQL_OPCODE_BATCH;
+}
+
 ConnectionPoolSettings::ConnectionPoolSettings()
     : num_connections_per_host(CASS_DEFAULT_NUM_CONNECTIONS_PER_HOST)
-    , reconnection_policy(new ExponentialReconnectionPolicy()) {}
+    , num_connections_per_remote_host(CASS_DEFAULT_NUM_CONNECTIONS_PER_REMOTE_HOST)
+    , max_connections_per_host(CASS_DEFAULT_MAX_CONNECTIONS_PER_HOST)
+    , max_concurrent_requests_threshold(CASS_DEFAULT_MAX_CONCURRENT_REQUESTS_THRESHOLD)
+    , reconnection_policy(new ExponentialReconnectionPolicy())
+    , shard_awareness_enabled(CASS_DEFAULT_SHARD_AWARENESS)
+    , warmup_requests_per_connection(CASS_DEFAULT_CONNECTION_WARMUP_REQUESTS)
+    , drain_timeout_ms(CASS_DEFAULT_HOST_DRAIN_TIMEOUT_MS)
+    , lazy_remote_pools(CASS_DEFAULT_LAZY_REMOTE_POOLS)
+    , remote_pool_idle_timeout_ms(CASS_DEFAULT_REMOTE_POOL_IDLE_TIMEOUT_SECS * 1000) {}
 
 ConnectionPoolSettings::ConnectionPoolSettings(const Config& config)
     : connection_settings(config)
     , num_connections_per_host(config.core_connections_per_host())
-    , reconnection_policy(config.reconnection_policy()) {}
+    , num_connections_per_remote_host(config.core_connections_per_remote_host())
+    , max_connections_per_host(config.max_connections_per_host())
+    , max_concurrent_requests_threshold(config.max_concurrent_requests_threshold())
+    , reconnection_policy(config.reconnection_policy())
+    , reconnect_throttle(config.max_concurrent_connect_attempts_per_host() > 0 ||
+                                 config.host_warmup_duration_ms() > 0
+                             ? new ReconnectThrottle(config.max_concurrent_connect_attempts_per_host(),
+                                                     config.host_warmup_duration_ms())
+                             : NULL)
+    , shard_awareness_enabled(config.shard_awareness())
+    , warmup_requests_per_connection(config.connection_warmup_requests())
+    , warmup_query(config.connection_warmup_query())
+    , drain_timeout_ms(config.host_drain_timeout_ms())
+    , lazy_remote_pools(config.lazy_remote_pools())
+    , remote_pool_idle_timeout_ms(1000 * static_cast<uint64_t>(
+                                             config.remote_pool_idle_timeout_secs())) {}
 
 class NopConnectionPoolListener : public ConnectionPoolListener {
 public:
@@ -72,10 +127,19 @@ ConnectionPool::ConnectionPool(const Connection::Vec& connections, ConnectionPoo
     , settings_(settings)
     , metrics_(metrics)
     , close_state_(CLOSE_STATE_OPEN)
-    , notify_state_(NOTIFY_STATE_NEW) {
+    , notify_state_(NOTIFY_STATE_NEW)
+    , pressure_intervals_(0)
+    , idle_intervals_(0)
+    , random_state_((uv_hrtime() ^ reinterpret_cast<uintptr_t>(this)) | 1)
+    , last_used_ms_(uv_now(loop))
+    , use_shard_aware_port_(true)
+    , drain_deadline_ms_(0) {
   inc_ref(); // Reference for the lifetime of the pooled connections
   set_pointer_keys(reconnection_schedules_);
+  set_pointer_keys(shard_connectors_);
   set_pointer_keys(to_flush_);
+  set_pointer_keys(growing_connectors_);
+  set_pointer_keys(shrinking_connections_);
 
   for (Connection::Vec::const_iterator it = connections.begin(), end = connections.end(); it != end;
        ++it) {
@@ -87,15 +151,50 @@ ConnectionPool::ConnectionPool(const Connection::Vec& connections, ConnectionPoo
 
   notify_up_or_down();
 
-  // We had non-critical errors or some connections closed
-  assert(connections.size() <= settings_.num_connections_per_host);
-  size_t needed = settings_.num_connections_per_host - connections_.size();
-  for (size_t i = 0; i < needed; ++i) {
-    schedule_reconnect();
+  if (is_shard_aware()) {
+    maybe_connect_shards(true);
+  } else {
+    // We had non-critical errors or some connections closed
+    assert(connections.size() <= settings_.num_connections_per_host);
+    size_t needed = settings_.num_connections_per_host - connections_.size();
+    for (size_t i = 0; i < needed; ++i) {
+      schedule_reconnect();
+    }
+  }
+
+  if (is_dynamically_sized()) {
+    start_sizing_timer();
   }
 }
 
-PooledConnection::Ptr ConnectionPool::find_least_busy() const {
+PooledConnection::Ptr ConnectionPool::find_least_busy(CassConnectionSelection selection,
+                                                      const Request* request) const {
+  last_used_ms_ = uv_now(loop_);
+
+  String routing_key;
+  if (request && is_shard_aware() && is_routable(request) &&
+      static_cast<const RoutableRequest*>(request)->get_routing_key(&routing_key)) {
+    int64_t token = MurmurHash3_x64_128(routing_key.data(), routing_key.size(), 0);
+    const PooledConnection::Ptr& connection = shard_connections_[sharding_info_.shard_id(token)];
+    if (connection && !connection->is_closing()) {
+      return connection;
+    }
+    // The shard's connection isn't available so use any other connection
+  }
+
+  size_t count = connections_.size();
+  if (selection == CASS_CONNECTION_SELECTION_POWER_OF_TWO_CHOICES && count > 2) {
+    size_t i = next_random(&random_state_) % count;
+    size_t j = next_random(&random_state_) % (count - 1);
+    if (j >= i) j++; // Two distinct connections
+    const PooledConnection::Ptr& a = connections_[i];
+    const PooledConnection::Ptr& b = connections_[j];
+    if (!a->is_closing() || !b->is_closing()) {
+      return least_busy_comp(b, a) ? b : a;
+    }
+    // Both are closing so fall back to scanning for an open connection
+  }
+
   PooledConnection::Vec::const_iterator it =
       std::min_element(connections_.begin(), connections_.end(), least_busy_comp);
   if (it == connections_.end() || (*it)->is_closing()) {
@@ -104,7 +203,22 @@ PooledConnection::Ptr ConnectionPool::find_least_busy() const {
   return *it;
 }
 
-bool ConnectionPool::has_connections() const { return !connections_.empty(); }
+bool ConnectionPool::has_connections() const {
+  for (PooledConnection::Vec::const_iterator it = connections_.begin(), end = connections_.end();
+       it != end; ++it) {
+    if (!(*it)->is_closing()) return true;
+  }
+  return false;
+}
+
+int ConnectionPool::inflight_request_count() const {
+  int inflight_request_count = 0;
+  for (PooledConnection::Vec::const_iterator it = connections_.begin(), end = connections_.end();
+       it != end; ++it) {
+    inflight_request_count += (*it)->inflight_request_count();
+  }
+  return inflight_request_count;
+}
 
 void ConnectionPool::flush() {
   for (DenseHashSet<PooledConnection*>::const_iterator it = to_flush_.begin(),
@@ -117,6 +231,35 @@ void ConnectionPool::flush() {
 
 void ConnectionPool::close() { internal_close(); }
 
+void ConnectionPool::drain() {
+  if (close_state_ != CLOSE_STATE_OPEN) return;
+
+  if (settings_.drain_timeout_ms == 0) {
+    internal_close();
+    return;
+  }
+
+  LOG_DEBUG("Draining connection pool (%p) to host %s for up to %u ms", static_cast<void*>(this),
+            host_->address().to_string().c_str(),
+            static_cast<unsigned>(settings_.drain_timeout_ms));
+
+  close_state_ = CLOSE_STATE_DRAINING;
+  sizing_timer_.stop();
+
+  // Connections aren't replaced while the pool drains
+  DelayedConnector::Vec pending_connections(pending_connections_);
+  for (DelayedConnector::Vec::iterator it = pending_connections.begin(),
+                                       end = pending_connections.end();
+       it != end; ++it) {
+    (*it)->cancel();
+  }
+
+  drain_deadline_ms_ = uv_now(loop_) + settings_.drain_timeout_ms;
+  drain_timer_.start(loop_, DRAIN_INTERVAL_MS,
+                     bind_callback(&ConnectionPool::on_drain_timer, this));
+  maybe_drained();
+}
+
 void ConnectionPool::attempt_immediate_connect() {
   for (DelayedConnector::Vec::iterator it = pending_connections_.begin(),
                                        end = pending_connections_.end();
@@ -146,15 +289,43 @@ void ConnectionPool::close_connection(PooledConnection* connection, Protected) {
                      connections_.end());
   to_flush_.erase(connection);
 
+  if (is_shard_aware()) {
+    int shard_id = connection->sharding_info().shard_id();
+    if (shard_id < sharding_info_.shards_count() &&
+        shard_connections_[shard_id].get() == connection) {
+      // Replace it with another connection to the same shard, if there's one
+      shard_connections_[shard_id].reset();
+      for (PooledConnection::Vec::const_iterator it = connections_.begin(),
+                                                 end = connections_.end();
+           it != end; ++it) {
+        index_shard_connection(*it);
+      }
+    }
+  }
+
   if (close_state_ != CLOSE_STATE_OPEN) {
-    maybe_closed();
+    shrinking_connections_.erase(connection);
+    if (close_state_ == CLOSE_STATE_DRAINING) {
+      maybe_drained();
+    } else {
+      maybe_closed();
+    }
+    return;
+  }
+
+  // Connections closed to shrink the pool aren't replaced
+  if (shrinking_connections_.erase(connection) > 0) {
     return;
   }
 
   // When there are no more connections available then notify that the host
   // is down.
   notify_up_or_down();
-  schedule_reconnect();
+  if (is_shard_aware()) {
+    maybe_connect_shards(false);
+  } else {
+    schedule_reconnect();
+  }
 }
 
 void ConnectionPool::add_connection(const PooledConnection::Ptr& connection) {
@@ -162,6 +333,70 @@ void ConnectionPool::add_connection(const PooledConnection::Ptr& connection) {
     metrics_->total_connections.inc();
   }
   connections_.push_back(connection);
+
+  const ShardingInfo& sharding_info = connection->sharding_info();
+  if (settings_.shard_awareness_enabled && sharding_info.is_valid()) {
+    if (sharding_info_.shards_count() != sharding_info.shards_count()) {
+      // The host's sharding was discovered or it changed because the host
+      // restarted with a different number of shards.
+      LOG_DEBUG("Host %s has %d shards; connection pool (%p) is shard-aware",
+                host_->address().to_string().c_str(), sharding_info.shards_count(),
+                static_cast<void*>(this));
+      sharding_info_ = sharding_info;
+      shard_connections_.assign(sharding_info.shards_count(), PooledConnection::Ptr());
+      for (PooledConnection::Vec::const_iterator it = connections_.begin(),
+                                                 end = connections_.end();
+           it != end; ++it) {
+        index_shard_connection(*it);
+      }
+    } else {
+      index_shard_connection(connection);
+    }
+  }
+}
+
+void ConnectionPool::index_shard_connection(const PooledConnection::Ptr& connection) {
+  const ShardingInfo& sharding_info = connection->sharding_info();
+  if (sharding_info.shards_count() == sharding_info_.shards_count() &&
+      !shard_connections_[sharding_info.shard_id()]) {
+    shard_connections_[sharding_info.shard_id()] = connection;
+  }
+}
+
+void ConnectionPool::maybe_connect_shards(bool is_immediate) {
+  if (close_state_ != CLOSE_STATE_OPEN) return;
+
+  size_t shards_count = static_cast<size_t>(sharding_info_.shards_count());
+  if (use_shard_aware_port_ && sharding_info_.shard_aware_port() > 0) {
+    // Connect each missing shard using a local port that selects it
+    Vector<bool> is_pending(shards_count, false);
+    for (ShardConnectors::const_iterator it = shard_connectors_.begin(),
+                                         end = shard_connectors_.end();
+         it != end; ++it) {
+      if (static_cast<size_t>(it->second) < shards_count) is_pending[it->second] = true;
+    }
+    for (size_t i = 0; i < shards_count; ++i) {
+      if (!shard_connections_[i] && !is_pending[i]) {
+        int shard_id = static_cast<int>(i);
+        if (is_immediate) {
+          connect(settings_.reconnection_policy->new_reconnection_schedule(), 0, shard_id);
+        } else {
+          schedule_reconnect(NULL, shard_id);
+        }
+      }
+    }
+  } else {
+    // The host assigns the connections to its shards so keep as many
+    // connections as shards; some shards might not have a connection.
+    for (size_t count = connections_.size() + pending_connections_.size(); count < shards_count;
+         ++count) {
+      if (is_immediate) {
+        connect(settings_.reconnection_policy->new_reconnection_schedule(), 0, -1);
+      } else {
+        schedule_reconnect();
+      }
+    }
+  }
 }
 
 void ConnectionPool::notify_up_or_down() {
@@ -171,6 +406,10 @@ void ConnectionPool::notify_up_or_down() {
     listener_->on_pool_down(host_->address());
   } else if ((notify_state_ == NOTIFY_STATE_NEW || notify_state_ == NOTIFY_STATE_DOWN) &&
              !connections_.empty()) {
+    if (notify_state_ == NOTIFY_STATE_DOWN && settings_.reconnect_throttle) {
+      // Ramp up the traffic to a host that was reconnected
+      settings_.reconnect_throttle->start_warmup(host_.get(), get_time_monotonic_coarse_ns());
+    }
     notify_state_ = NOTIFY_STATE_UP;
     listener_->on_pool_up(host_->address());
   }
@@ -183,30 +422,46 @@ void ConnectionPool::notify_critical_error(Connector::ConnectionError code, cons
   }
 }
 
-void ConnectionPool::schedule_reconnect(ReconnectionSchedule* schedule) {
-  DelayedConnector::Ptr connector(new DelayedConnector(
-      host_, protocol_version_, bind_callback(&ConnectionPool::on_reconnect, this)));
-
+void ConnectionPool::schedule_reconnect(ReconnectionSchedule* schedule, int shard_id) {
   if (!schedule) {
     schedule = settings_.reconnection_policy->new_reconnection_schedule();
   }
-  reconnection_schedules_[connector.get()] = schedule;
 
   uint64_t delay_ms = schedule->next_delay_ms();
   LOG_INFO("Scheduling %s reconnect for host %s in %llums on connection pool (%p) ",
            settings_.reconnection_policy->name(), host_->address().to_string().c_str(),
            static_cast<unsigned long long>(delay_ms), static_cast<void*>(this));
 
+  connect(schedule, delay_ms, shard_id);
+}
+
+DelayedConnector* ConnectionPool::connect(ReconnectionSchedule* schedule, uint64_t delay_ms,
+                                          int shard_id) {
+  DelayedConnector::Ptr connector(new DelayedConnector(
+      host_, protocol_version_, bind_callback(&ConnectionPool::on_reconnect, this)));
+  reconnection_schedules_[connector.get()] = schedule;
+
+  if (shard_id >= 0) {
+    int local_port =
+        sharding_info_.local_port(shard_id, static_cast<int>(next_random(&random_state_) >> 33));
+    shard_connectors_[connector.get()] = shard_id;
+    connector->with_shard_aware_port(sharding_info_.shard_aware_port(), local_port);
+  }
+
   pending_connections_.push_back(connector);
   connector->with_keyspace(keyspace())
       ->with_metrics(metrics_)
       ->with_settings(settings_.connection_settings)
+      ->with_reconnect_throttle(settings_.reconnect_throttle)
       ->delayed_connect(loop_, delay_ms);
+  return connector.get();
 }
 
 void ConnectionPool::internal_close() {
-  if (close_state_ == CLOSE_STATE_OPEN) {
+  if (close_state_ == CLOSE_STATE_OPEN || close_state_ == CLOSE_STATE_DRAINING) {
     close_state_ = CLOSE_STATE_CLOSING;
+    sizing_timer_.stop();
+    drain_timer_.stop();
 
     // Make copies of connection/connector data structures to prevent iterator
     // invalidation.
@@ -245,6 +500,43 @@ void ConnectionPool::maybe_closed() {
   }
 }
 
+// This must be the last call in a function because it can potentially
+// deallocate the pool.
+void ConnectionPool::maybe_drained() {
+  for (PooledConnection::Vec::const_iterator it = connections_.begin(), end = connections_.end();
+       it != end; ++it) {
+    if (!(*it)->is_closing() && (*it)->inflight_request_count() > 0) {
+      return;
+    }
+  }
+  LOG_DEBUG("Connection pool (%p) to host %s is drained", static_cast<void*>(this),
+            host_->address().to_string().c_str());
+  internal_close();
+}
+
+void ConnectionPool::on_drain_timer(Timer* timer) {
+  if (close_state_ != CLOSE_STATE_DRAINING) return;
+
+  if (uv_now(loop_) >= drain_deadline_ms_) {
+    int inflight_request_count = 0;
+    for (PooledConnection::Vec::const_iterator it = connections_.begin(),
+                                               end = connections_.end();
+         it != end; ++it) {
+      inflight_request_count += (*it)->inflight_request_count();
+    }
+    LOG_WARN("Closing connection pool (%p) to host %s with %d request(s) still in-flight because "
+             "the drain timeout expired",
+             static_cast<void*>(this), host_->address().to_string().c_str(),
+             inflight_request_count);
+    internal_close();
+    return;
+  }
+
+  drain_timer_.start(loop_, DRAIN_INTERVAL_MS,
+                     bind_callback(&ConnectionPool::on_drain_timer, this));
+  maybe_drained();
+}
+
 void ConnectionPool::on_reconnect(DelayedConnector* connector) {
   pending_connections_.erase(
       std::remove(pending_connections_.begin(), pending_connections_.end(), connector),
@@ -257,26 +549,123 @@ void ConnectionPool::on_reconnect(DelayedConnector* connector) {
   ScopedPtr<ReconnectionSchedule> schedule(it->second);
   reconnection_schedules_.erase(it);
 
+  int shard_id = -1;
+  ShardConnectors::iterator shard_it = shard_connectors_.find(connector);
+  if (shard_it != shard_connectors_.end()) {
+    shard_id = shard_it->second;
+    shard_connectors_.erase(shard_it);
+  }
+
+  bool is_growing = growing_connectors_.erase(connector) > 0;
+
   if (close_state_ != CLOSE_STATE_OPEN) {
     maybe_closed();
     return;
   }
 
   if (connector->is_ok()) {
-    add_connection(
-        PooledConnection::Ptr(new PooledConnection(this, connector->release_connection())));
+    PooledConnection::Ptr connection(new PooledConnection(this, connector->release_connection()));
+    if (shard_id >= 0 && connection->sharding_info().shard_id() != shard_id) {
+      // The local port was likely changed by address translation (NAT)
+      LOG_WARN("Connection to the shard-aware port of host %s was assigned to the wrong shard; "
+               "connection pool (%p) will use the regular port",
+               address().to_string().c_str(), static_cast<void*>(this));
+      use_shard_aware_port_ = false;
+    }
+    add_connection(connection);
     notify_up_or_down();
+    if (is_shard_aware()) {
+      maybe_connect_shards(true);
+    }
   } else if (!connector->is_canceled()) {
     if (connector->is_critical_error()) {
       LOG_ERROR("Closing established connection pool to host %s because of the following error: %s",
                 address().to_string().c_str(), connector->error_message().c_str());
       notify_critical_error(connector->error_code(), connector->error_message());
       internal_close();
+    } else if (is_growing) {
+      // Don't retry; the pool grows again if it's still under pressure
+      LOG_WARN("Connection pool was unable to add a connection to host %s because of the "
+               "following error: %s",
+               address().to_string().c_str(), connector->error_message().c_str());
     } else {
       LOG_WARN(
           "Connection pool was unable to reconnect to host %s because of the following error: %s",
           address().to_string().c_str(), connector->error_message().c_str());
-      schedule_reconnect(schedule.release());
+      schedule_reconnect(schedule.release(), shard_id);
     }
   }
 }
+
+bool ConnectionPool::is_dynamically_sized() const {
+  return settings_.max_connections_per_host > settings_.num_connections_per_host;
+}
+
+void ConnectionPool::start_sizing_timer() {
+  sizing_timer_.start(loop_, SIZING_INTERVAL_MS,
+                      bind_callback(&ConnectionPool::on_sizing_timer, this));
+}
+
+void ConnectionPool::on_sizing_timer(Timer* timer) {
+  // Shard-aware pools keep a connection per shard instead
+  if (close_state_ != CLOSE_STATE_OPEN || is_shard_aware()) return;
+
+  size_t open_connections = 0;
+  size_t inflight_request_count = 0;
+  for (PooledConnection::Vec::const_iterator it = connections_.begin(), end = connections_.end();
+       it != end; ++it) {
+    if (!(*it)->is_closing()) {
+      open_connections++;
+      inflight_request_count += (*it)->inflight_request_count();
+    }
+  }
+
+  if (open_connections > 0 &&
+      inflight_request_count > settings_.max_concurrent_requests_threshold * open_connections) {
+    idle_intervals_ = 0;
+    if (++pressure_intervals_ >= GROW_AFTER_INTERVALS) {
+      pressure_intervals_ = 0;
+      grow();
+    }
+  } else {
+    pressure_intervals_ = 0;
+    maybe_shrink();
+  }
+
+  start_sizing_timer();
+}
+
+void ConnectionPool::grow() {
+  // Only add a single connection at a time
+  if (!growing_connectors_.empty() ||
+      connections_.size() + pending_connections_.size() >= settings_.max_connections_per_host) {
+    return;
+  }
+
+  LOG_DEBUG("Adding a connection to host %s on connection pool (%p) because of load",
+            host_->address().to_string().c_str(), static_cast<void*>(this));
+
+  growing_connectors_.insert(
+      connect(settings_.reconnection_policy->new_reconnection_schedule(), 0, -1));
+}
+
+void ConnectionPool::maybe_shrink() {
+  if (connections_.size() - shrinking_connections_.size() <= settings_.num_connections_per_host) {
+    idle_intervals_ = 0;
+    return;
+  }
+
+  PooledConnection::Ptr connection(find_least_busy());
+  if (!connection || connection->inflight_request_count() > 0) {
+    idle_intervals_ = 0;
+    return;
+  }
+
+  if (++idle_intervals_ >= SHRINK_AFTER_INTERVALS) {
+    idle_intervals_ = 0;
+    LOG_DEBUG("Closing an idle connection to host %s on connection pool (%p)",
+              host_->address().to_string().c_str(), static_cast<void*>(this));
+    shrinking_connections_.insert(connection.get());
+    connection->close();
+  }
+}
@@ -20,8 +20,11 @@
 #include "address.hpp"
 #include "delayed_connector.hpp"
 #include "dense_hash_map.hpp"
+#include "flat_hash_map.hpp"
 #include "pooled_connection.hpp"
+#include "reconnect_throttle.hpp"
 #include "reconnection_policy.hpp"
+#include "timer.hpp"
 
 #include <uv.h>
 
@@ -31,6 +34,7 @@ class ConnectionPool;
 class ConnectionPoolConnector;
 class ConnectionPoolManager;
 class EventLoop;
+class Request;
 
 class ConnectionPoolStateListener {
 public:
@@ -93,24 +97,38 @@ struct ConnectionPoolSettings {
 
   ConnectionSettings connection_settings;
   size_t num_connections_per_host;
+  size_t num_connections_per_remote_host; // The same as the local hosts if 0
+  size_t max_connections_per_host;
+  size_t max_concurrent_requests_threshold;
   ReconnectionPolicy::Ptr reconnection_policy;
+  ReconnectThrottle::Ptr reconnect_throttle; // NULL if disabled, shared by all the pools
+  bool shard_awareness_enabled;
+  unsigned warmup_requests_per_connection; // Sent before a new pool is used
+  String warmup_query;                     // OPTIONS requests are sent if empty
+  uint64_t drain_timeout_ms;               // Closed immediately when removed if 0
+  bool lazy_remote_pools;                  // Remote hosts are connected on first use
+  uint64_t remote_pool_idle_timeout_ms;    // Remote pools are kept open if 0
 };
 
 /**
- * A pool of connections to the same host.
+ * A pool of connections to the same host. The pool keeps the core number of
+ * connections and, if the maximum number of connections is larger, grows while
+ * its connections are under sustained pressure and shrinks back once the extra
+ * connections are idle.
+ *
+ * If shard awareness is enabled and the host partitions its data per CPU core
+ * (shard) then the pool keeps a connection per shard instead and a request is
+ * written to the connection of the shard that owns its partition. The
+ * connections are opened to the host's shard-aware port, if it has one, from
+ * a local port that selects their shard.
  */
 class ConnectionPool : public RefCounted<ConnectionPool> {
 public:
   typedef SharedRefPtr<ConnectionPool> Ptr;
   typedef DenseHashMap<DelayedConnector*, ReconnectionSchedule*> ReconnectionSchedules;
+  typedef DenseHashMap<DelayedConnector*, int> ShardConnectors;
 
-  class Map : public DenseHashMap<Address, Ptr> {
-  public:
-    Map() {
-      set_empty_key(Address::EMPTY_KEY);
-      set_deleted_key(Address::DELETED_KEY);
-    }
-  };
+  typedef FlatHashMap<Address, Ptr> Map;
 
   /**
    * Constructor. Don't use directly.
@@ -133,17 +151,33 @@ public:
    * Find the least busy connection for the pool. The least busy connection has
    * the lowest number of outstanding requests and is not closed.
    *
+   * @param selection How the connection is selected. The power of two choices
+   * selection returns the less busy of two random connections instead of
+   * scanning every connection.
+   * @param request The request that's written to the connection. If the pool
+   * is shard-aware then the connection of the shard that owns the request's
+   * partition is returned, if it's available.
    * @return The least busy connection or null if no connection is available.
    */
-  PooledConnection::Ptr find_least_busy() const;
+  PooledConnection::Ptr
+  find_least_busy(CassConnectionSelection selection = CASS_CONNECTION_SELECTION_LEAST_BUSY,
+                  const Request* request = NULL) const;
 
   /**
-   * Determine if the pool has any valid connections.
+   * Determine if the pool has any valid connections. Connections that are
+   * closing aren't valid.
    *
    * @return Returns true if the pool has valid connections.
    */
   bool has_connections() const;
 
+  /**
+   * Get the number of requests in-flight on the pool's connections.
+   *
+   * @return The number of in-flight requests.
+   */
+  int inflight_request_count() const;
+
   /**
    * Trigger immediate connection of any delayed (reconnecting) connections.
    */
@@ -159,6 +193,15 @@ public:
    */
   void close();
 
+  /**
+   * Drain the pool. The pool stops reconnecting and closes once none of its
+   * connections have requests in-flight or once the drain timeout expires,
+   * whichever comes first. The pool is closed immediately if the drain
+   * timeout is 0. The pool shouldn't be used for new requests while it's
+   * draining.
+   */
+  void drain();
+
   /**
    * Set the listener that will handle events for the pool.
    *
@@ -169,8 +212,11 @@ public:
 public:
   const uv_loop_t* loop() const { return loop_; }
   const Address& address() const { return host_->address(); }
+  const Host::Ptr& host() const { return host_; }
+  uint64_t last_used_ms() const { return last_used_ms_; } // The loop's time of the last use
   ProtocolVersion protocol_version() const { return protocol_version_; }
   const String& keyspace() const { return keyspace_; }
+  bool is_shard_aware() const { return sharding_info_.is_valid(); }
 
   void set_keyspace(const String& keyspace);
 
@@ -200,6 +246,7 @@ public:
 private:
   enum CloseState {
     CLOSE_STATE_OPEN,
+    CLOSE_STATE_DRAINING,
     CLOSE_STATE_CLOSING,
     CLOSE_STATE_WAITING_FOR_CONNECTIONS,
     CLOSE_STATE_CLOSED
@@ -214,12 +261,25 @@ private:
   void notify_up_or_down();
   void notify_critical_error(Connector::ConnectionError code, const String& message);
   void add_connection(const PooledConnection::Ptr& connection);
-  void schedule_reconnect(ReconnectionSchedule* schedule = NULL);
+  void schedule_reconnect(ReconnectionSchedule* schedule = NULL, int shard_id = -1);
+  DelayedConnector* connect(ReconnectionSchedule* schedule, uint64_t delay_ms, int shard_id);
   void internal_close();
   void maybe_closed();
+  void maybe_drained();
+
+  void on_drain_timer(Timer* timer);
 
   void on_reconnect(DelayedConnector* connector);
 
+  bool is_dynamically_sized() const;
+  void start_sizing_timer();
+  void on_sizing_timer(Timer* timer);
+  void grow();
+  void maybe_shrink();
+
+  void index_shard_connection(const PooledConnection::Ptr& connection);
+  void maybe_connect_shards(bool is_immediate);
+
 private:
   ConnectionPoolListener* listener_;
   String keyspace_;
@@ -235,6 +295,22 @@ private:
   PooledConnection::Vec connections_;
   DelayedConnector::Vec pending_connections_;
   DenseHashSet<PooledConnection*> to_flush_;
+
+  Timer sizing_timer_;
+  unsigned pressure_intervals_;
+  unsigned idle_intervals_;
+  DenseHashSet<DelayedConnector*> growing_connectors_;
+  DenseHashSet<PooledConnection*> shrinking_connections_;
+  mutable uint64_t random_state_;
+  mutable uint64_t last_used_ms_;
+
+  ShardingInfo sharding_info_; // Invalid unless the pool is shard-aware
+  bool use_shard_aware_port_;
+  PooledConnection::Vec shard_connections_; // Indexed by shard, null if missing
+  ShardConnectors shard_connectors_;        // The shards of pending connections
+
+  Timer drain_timer_;
+  uint64_t drain_deadline_ms_;
 };
 
 }}} // namespace datastax::internal::core
@@ -18,10 +18,58 @@
 
 #include "event_loop.hpp"
 #include "metrics.hpp"
+#include "options_request.hpp"
+#include "query_request.hpp"
+#include "request_callback.hpp"
 
 using namespace datastax;
 using namespace datastax::internal::core;
 
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * A request callback that handles a warm-up request of a new connection.
+ * Failed warm-up requests are only logged; they don't fail the pool.
+ */
+class WarmupCallback : public SimpleRequestCallback {
+public:
+  typedef SharedRefPtr<WarmupCallback> Ptr;
+
+  WarmupCallback(const Request::ConstPtr& request, uint64_t request_timeout_ms,
+                 ConnectionPoolConnector* connector)
+      : SimpleRequestCallback(request, request_timeout_ms)
+      , connector_(connector)
+      , is_done_(false) {}
+
+  bool is_done() const { return is_done_; }
+
+private:
+  virtual void on_internal_set(ResponseMessage* response) { done(); }
+
+  virtual void on_internal_error(CassError code, const String& message) {
+    LOG_DEBUG("Warm-up request failed on host %s: %s",
+              connector_->host_->address_string().c_str(), message.c_str());
+    done();
+  }
+
+  virtual void on_internal_timeout() {
+    LOG_DEBUG("Warm-up request timed out on host %s",
+              connector_->host_->address_string().c_str());
+    done();
+  }
+
+  void done() {
+    is_done_ = true;
+    connector_->on_warmup();
+  }
+
+private:
+  ConnectionPoolConnector::Ptr connector_;
+  bool is_done_;
+};
+
+}}} // namespace datastax::internal::core
+
 ConnectionPoolConnector::ConnectionPoolConnector(const Host::Ptr& host,
                                                  ProtocolVersion protocol_version,
                                                  const Callback& callback)
@@ -137,26 +185,72 @@ void ConnectionPoolConnector::on_connect(Connector* connector) {
   }
 
   if (--remaining_ == 0) {
-    if (!is_canceled_) {
-      if (!critical_error_connector_) {
-        pool_.reset(new ConnectionPool(connections_, listener_, keyspace_, loop_, host_,
-                                       protocol_version_, settings_, metrics_));
-      } else {
-        if (listener_) {
-          listener_->on_pool_critical_error(host_->address(),
-                                            critical_error_connector_->error_code(),
-                                            critical_error_connector_->error_message());
-        }
+    if (!is_canceled_ && !critical_error_connector_ && settings_.warmup_requests_per_connection > 0) {
+      warmup();
+    } else {
+      finish();
+    }
+  }
+}
+
+void ConnectionPoolConnector::warmup() {
+  LOG_DEBUG("Warming up %u connection(s) to host %s with %u request(s) each",
+            static_cast<unsigned>(connections_.size()), host_->address_string().c_str(),
+            settings_.warmup_requests_per_connection);
+
+  Request::ConstPtr request;
+  if (settings_.warmup_query.empty()) {
+    request.reset(new OptionsRequest());
+  } else {
+    request.reset(new QueryRequest(settings_.warmup_query));
+  }
+
+  remaining_ = 1; // Keep the connector from finishing until all the requests are written
+  for (Connection::Vec::iterator it = connections_.begin(), end = connections_.end(); it != end;
+       ++it) {
+    const Connection::Ptr& connection(*it);
+    for (unsigned i = 0; i < settings_.warmup_requests_per_connection; ++i) {
+      // A host that can't answer within the connect timeout isn't worth
+      // delaying the pool for
+      WarmupCallback::Ptr callback(new WarmupCallback(
+          request, settings_.connection_settings.connect_timeout_ms, this));
+      ++remaining_;
+      if (connection->write(callback) <= 0 && !callback->is_done()) {
+        --remaining_; // No stream or the connection is closing
+        break;
       }
     }
-    callback_(this);
-    // If the pool hasn't been released then close it.
-    if (pool_) {
-      // If the callback doesn't take possession of the pool then we should
-      // also clear the listener.
-      pool_->set_listener();
-      pool_->close();
+    connection->flush();
+  }
+  on_warmup();
+}
+
+void ConnectionPoolConnector::on_warmup() {
+  if (--remaining_ == 0) {
+    finish();
+  }
+}
+
+void ConnectionPoolConnector::finish() {
+  if (!is_canceled_) {
+    if (!critical_error_connector_) {
+      pool_.reset(new ConnectionPool(connections_, listener_, keyspace_, loop_, host_,
+                                     protocol_version_, settings_, metrics_));
+    } else {
+      if (listener_) {
+        listener_->on_pool_critical_error(host_->address(),
+                                          critical_error_connector_->error_code(),
+                                          critical_error_connector_->error_message());
+      }
     }
-    dec_ref();
   }
+  callback_(this);
+  // If the pool hasn't been released then close it.
+  if (pool_) {
+    // If the callback doesn't take possession of the pool then we should
+    // also clear the listener.
+    pool_->set_listener();
+    pool_->close();
+  }
+  dec_ref();
 }
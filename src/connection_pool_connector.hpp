@@ -116,8 +116,15 @@ public:
   bool is_critical_error() const;
   bool is_keyspace_error() const;
 
+private:
+  friend class WarmupCallback;
+
+  void warmup();
+  void finish();
+
 private:
   void on_connect(Connector* connector);
+  void on_warmup();
 
 private:
   uv_loop_t* loop_;
@@ -19,6 +19,9 @@
 #include "scoped_lock.hpp"
 #include "utils.hpp"
 
+// How often the pools of lazily connected hosts are checked for idleness
+#define IDLE_CHECK_INTERVAL_MS 1000
+
 using namespace datastax;
 using namespace datastax::internal::core;
 
@@ -45,6 +48,7 @@ ConnectionPoolManager::ConnectionPoolManager(const ConnectionPool::Map& pools, u
     : loop_(loop)
     , protocol_version_(protocol_version)
     , settings_(settings)
+    , remote_settings_(settings)
     , listener_(listener ? listener : &nop_connection_pool_manager_listener__)
     , close_state_(CLOSE_STATE_OPEN)
     , keyspace_(keyspace)
@@ -55,6 +59,11 @@ ConnectionPoolManager::ConnectionPoolManager(const ConnectionPool::Map& pools, u
 {
   inc_ref(); // Reference for the lifetime of the connection pools
   set_pointer_keys(to_flush_);
+  set_pointer_keys(draining_pools_);
+
+  if (settings_.num_connections_per_remote_host > 0) {
+    remote_settings_.num_connections_per_host = settings_.num_connections_per_remote_host;
+  }
 
   for (ConnectionPool::Map::const_iterator it = pools.begin(), end = pools.end(); it != end; ++it) {
     it->second->set_listener(this);
@@ -62,12 +71,15 @@ ConnectionPoolManager::ConnectionPoolManager(const ConnectionPool::Map& pools, u
   }
 }
 
-PooledConnection::Ptr ConnectionPoolManager::find_least_busy(const Address& address) const {
+PooledConnection::Ptr
+ConnectionPoolManager::find_least_busy(const Address& address,
+                                       CassConnectionSelection selection,
+                                       const Request* request) const {
   ConnectionPool::Map::const_iterator it = pools_.find(address);
   if (it == pools_.end()) {
     return PooledConnection::Ptr();
   }
-  return it->second->find_least_busy();
+  return it->second->find_least_busy(selection, request);
 }
 
 bool ConnectionPoolManager::has_connections(const Address& address) const {
@@ -93,10 +105,21 @@ AddressVec ConnectionPoolManager::available() const {
   return result;
 }
 
-void ConnectionPoolManager::add(const Host::Ptr& host) {
+void ConnectionPoolManager::add(const Host::Ptr& host, bool is_remote) {
   ConnectionPool::Map::iterator it = pools_.find(host->address());
+  if (is_remote && settings_.lazy_remote_pools) {
+    lazy_hosts_[host->address()] = host;
+    if (it != pools_.end()) { // Already connected so it's only closed when idle
+      lazy_pools_.insert(host->address());
+      maybe_start_idle_timer();
+    }
+    return;
+  }
   if (it != pools_.end()) return;
+  connect(host, is_remote);
+}
 
+void ConnectionPoolManager::connect(const Host::Ptr& host, bool is_remote) {
   for (ConnectionPoolConnector::Vec::iterator it = pending_pools_.begin(),
                                               end = pending_pools_.end();
        it != end; ++it) {
@@ -107,23 +130,51 @@ void ConnectionPoolManager::add(const Host::Ptr& host) {
       host, protocol_version_, bind_callback(&ConnectionPoolManager::on_connect, this)));
   pending_pools_.push_back(connector);
   connector->with_listener(this)
-      ->with_keyspace(keyspace_)
+      ->with_keyspace(keyspace_.str())
       ->with_metrics(metrics_)
-      ->with_settings(settings_)
+      ->with_settings(is_remote ? remote_settings_ : settings_)
       ->connect(loop_);
 }
 
+void ConnectionPoolManager::connect_lazy(const Address& address) {
+  if (close_state_ != CLOSE_STATE_OPEN) return;
+
+  HostMap::const_iterator it = lazy_hosts_.find(address);
+  if (it == lazy_hosts_.end() || lazy_pools_.count(address) > 0) return;
+
+  // Wait for a pool that was closed because it was idle to finish closing
+  for (DenseHashSet<ConnectionPool*>::const_iterator pool_it = draining_pools_.begin(),
+                                                     end = draining_pools_.end();
+       pool_it != end; ++pool_it) {
+    if ((*pool_it)->address() == address) return;
+  }
+
+  LOG_DEBUG("Connecting pool for remote host %s on first use", address.to_string().c_str());
+  lazy_pools_.insert(address);
+  connect(it->second, true);
+}
+
 void ConnectionPoolManager::remove(const Address& address) {
+  lazy_hosts_.erase(address);
+  lazy_pools_.erase(address);
+  remove_pool(address);
+}
+
+void ConnectionPoolManager::remove_pool(const Address& address) {
   ConnectionPool::Map::iterator it = pools_.find(address);
   if (it == pools_.end()) return;
-  // The connection pool will remove itself from the manager when all of its
-  // connections are closed.
-  it->second->close();
+  // The connection pool is no longer used for new requests. It will remove
+  // itself from the manager when all of its connections are closed.
+  ConnectionPool::Ptr pool(it->second);
+  pools_.erase(it);
+  draining_pools_.insert(pool.get());
+  pool->drain();
 }
 
 void ConnectionPoolManager::close() {
   if (close_state_ == CLOSE_STATE_OPEN) {
     close_state_ = CLOSE_STATE_CLOSING;
+    idle_timer_.stop();
 
     // Make copies of pool/connector data structures to prevent iterator
     // invalidation.
@@ -133,6 +184,13 @@ void ConnectionPoolManager::close() {
       it->second->close();
     }
 
+    DenseHashSet<ConnectionPool*> draining_pools(draining_pools_);
+    for (DenseHashSet<ConnectionPool*>::iterator it = draining_pools.begin(),
+                                                 end = draining_pools.end();
+         it != end; ++it) {
+      (*it)->close();
+    }
+
     ConnectionPoolConnector::Vec pending_pools(pending_pools_);
     for (ConnectionPoolConnector::Vec::iterator it = pending_pools.begin(),
                                                 end = pending_pools.end();
@@ -156,7 +214,7 @@ void ConnectionPoolManager::set_listener(ConnectionPoolManagerListener* listener
 }
 
 void ConnectionPoolManager::set_keyspace(const String& keyspace) {
-  keyspace_ = keyspace;
+  keyspace_ = InternedString(keyspace);
   for (ConnectionPool::Map::iterator it = pools_.begin(), end = pools_.end(); it != end; ++it) {
     it->second->set_keyspace(keyspace);
   }
@@ -165,6 +223,8 @@ void ConnectionPoolManager::set_keyspace(const String& keyspace) {
 void ConnectionPoolManager::on_pool_up(const Address& address) { listener_->on_pool_up(address); }
 
 void ConnectionPoolManager::on_pool_down(const Address& address) {
+  // A lazy host's pool that was closed because it was idle isn't down
+  if (lazy_pools_.count(address) == 0 && lazy_hosts_.count(address) > 0) return;
   listener_->on_pool_down(address);
 }
 
@@ -182,7 +242,9 @@ void ConnectionPoolManager::on_requires_flush(ConnectionPool* pool) {
 }
 
 void ConnectionPoolManager::on_close(ConnectionPool* pool) {
-  pools_.erase(pool->address());
+  if (draining_pools_.erase(pool) == 0) {
+    pools_.erase(pool->address());
+  }
   to_flush_.erase(pool);
   maybe_closed();
 }
@@ -196,7 +258,8 @@ void ConnectionPoolManager::add_pool(const ConnectionPool::Ptr& pool) {
 // deallocate the manager.
 void ConnectionPoolManager::maybe_closed() {
   // Close the manager once all current and pending pools are terminated.
-  if (close_state_ == CLOSE_STATE_WAITING_FOR_POOLS && pools_.empty() && pending_pools_.empty()) {
+  if (close_state_ == CLOSE_STATE_WAITING_FOR_POOLS && pools_.empty() &&
+      draining_pools_.empty() && pending_pools_.empty()) {
     close_state_ = CLOSE_STATE_CLOSED;
     listener_->on_close(this);
     dec_ref();
@@ -212,10 +275,51 @@ void ConnectionPoolManager::on_connect(ConnectionPoolConnector* pool_connector)
     return;
   }
 
+  const Address& address = pool_connector->address();
+  bool is_lazy = lazy_pools_.count(address) > 0;
   if (pool_connector->is_ok()) {
     add_pool(pool_connector->release_pool());
+    if (is_lazy) maybe_start_idle_timer();
+  } else if (is_lazy) {
+    // The host stays available and its pool is connected again on next use
+    LOG_WARN("Unable to connect pool for remote host %s: %s", address.to_string().c_str(),
+             pool_connector->error_message().c_str());
+    lazy_pools_.erase(address);
   } else {
-    listener_->on_pool_critical_error(pool_connector->address(), pool_connector->error_code(),
+    listener_->on_pool_critical_error(address, pool_connector->error_code(),
                                       pool_connector->error_message());
   }
 }
+
+void ConnectionPoolManager::maybe_start_idle_timer() {
+  if (settings_.remote_pool_idle_timeout_ms > 0 && !lazy_pools_.empty() &&
+      !idle_timer_.is_running()) {
+    idle_timer_.start(loop_, IDLE_CHECK_INTERVAL_MS,
+                      bind_callback(&ConnectionPoolManager::on_idle_timer, this));
+  }
+}
+
+void ConnectionPoolManager::on_idle_timer(Timer* timer) {
+  if (close_state_ != CLOSE_STATE_OPEN) return;
+
+  uint64_t now = uv_now(loop_);
+  AddressVec idle;
+  for (AddressSet::const_iterator it = lazy_pools_.begin(), end = lazy_pools_.end(); it != end;
+       ++it) {
+    ConnectionPool::Map::const_iterator pool_it = pools_.find(*it);
+    if (pool_it == pools_.end()) continue; // Still connecting
+    const ConnectionPool::Ptr& pool = pool_it->second;
+    if (now - pool->last_used_ms() >= settings_.remote_pool_idle_timeout_ms &&
+        pool->inflight_request_count() == 0) {
+      idle.push_back(*it);
+    }
+  }
+
+  for (AddressVec::const_iterator it = idle.begin(), end = idle.end(); it != end; ++it) {
+    LOG_DEBUG("Closing idle pool for remote host %s", it->to_string().c_str());
+    lazy_pools_.erase(*it);
+    remove_pool(*it);
+  }
+
+  maybe_start_idle_timer();
+}
@@ -22,8 +22,10 @@
 #include "connection_pool.hpp"
 #include "connection_pool_connector.hpp"
 #include "histogram_wrapper.hpp"
+#include "interned_string.hpp"
 #include "ref_counted.hpp"
 #include "string.hpp"
+#include "timer.hpp"
 
 #include <uv.h>
 
@@ -81,10 +83,16 @@ public:
    * Find the least busy connection for a given host.
    *
    * @param address The address of the host to find a least busy connection.
+   * @param selection How the connection is selected from the host's pool.
+   * @param request The request that's written to the connection. It's used to
+   * select the connection of the request's shard if the pool is shard-aware.
    * @return The least busy connection for a host or null if no connections are
    * available.
    */
-  PooledConnection::Ptr find_least_busy(const Address& address) const;
+  PooledConnection::Ptr
+  find_least_busy(const Address& address,
+                  CassConnectionSelection selection = CASS_CONNECTION_SELECTION_LEAST_BUSY,
+                  const Request* request = NULL) const;
 
   /**
    * Determine if a pool has any valid connections.
@@ -110,11 +118,25 @@ public:
    * Add a connection pool for the given host.
    *
    * @param host The host to add.
+   * @param is_remote If true, the host is at a remote distance. Its pool is
+   * sized with the number of connections per remote host and, if remote pools
+   * are lazy, it isn't connected until it's used (see `connect_lazy()`) and
+   * it's closed again once it's idle for the remote pool idle timeout.
    */
-  void add(const Host::Ptr& host);
+  void add(const Host::Ptr& host, bool is_remote = false);
 
   /**
-   * Remove a connection pool for the given host.
+   * Connect the pool of a host that was added lazily, if it's not already
+   * connected or connecting.
+   *
+   * @param address The address of the host.
+   */
+  void connect_lazy(const Address& address);
+
+  /**
+   * Remove a connection pool for the given host. The pool is no longer used
+   * for new requests, but it's drained before it's closed if a drain timeout
+   * is set.
    *
    * @param address The address of the host to remove.
    */
@@ -144,7 +166,8 @@ public:
   ProtocolVersion protocol_version() const { return protocol_version_; }
   const ConnectionPoolSettings& settings() const { return settings_; }
   ConnectionPoolManagerListener* listener() const { return listener_; }
-  const String& keyspace() const { return keyspace_; }
+  const String& keyspace() const { return keyspace_.str(); }
+  const InternedString& interned_keyspace() const { return keyspace_; }
 
   void set_keyspace(const String& keyspace);
 
@@ -177,25 +200,36 @@ private:
   };
 
 private:
+  void connect(const Host::Ptr& host, bool is_remote);
   void add_pool(const ConnectionPool::Ptr& pool);
+  void remove_pool(const Address& address);
   void maybe_closed();
 
+  void maybe_start_idle_timer();
+
 private:
   void on_connect(ConnectionPoolConnector* pool_connector);
+  void on_idle_timer(Timer* timer);
 
 private:
   uv_loop_t* loop_;
 
   const ProtocolVersion protocol_version_;
   const ConnectionPoolSettings settings_;
+  ConnectionPoolSettings remote_settings_;
   ConnectionPoolManagerListener* listener_;
 
   CloseState close_state_;
   ConnectionPool::Map pools_;
+  DenseHashSet<ConnectionPool*> draining_pools_; // Removed, but not yet closed
   ConnectionPoolConnector::Vec pending_pools_;
   DenseHashSet<ConnectionPool*> to_flush_;
 
-  String keyspace_;
+  HostMap lazy_hosts_;     // Hosts connected on first use
+  AddressSet lazy_pools_;  // The lazy hosts that are connected or connecting
+  Timer idle_timer_;
+
+  InternedString keyspace_;
 
   Metrics* const metrics_;
 
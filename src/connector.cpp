@@ -19,6 +19,7 @@
 #include "config.hpp"
 
 #include "auth_responses.hpp"
+#include "compression.hpp"
 #include "connection.hpp"
 #include "metrics.hpp"
 #include "serialization.hpp"
@@ -42,7 +43,9 @@ using namespace datastax::internal::core;
 namespace datastax { namespace internal { namespace core {
 
 /**
- * A proxy request callback that handles the connection process.
+ * A proxy request callback that handles the connection process. It keeps the
+ * connector alive because a pipelined request can still be pending when the
+ * connector finishes with an error.
  */
 class StartupCallback : public SimpleRequestCallback {
 public:
@@ -56,7 +59,7 @@ private:
   void on_result_response(ResponseMessage* response);
 
 private:
-  Connector* connector_;
+  Connector::Ptr connector_;
 };
 
 }}} // namespace datastax::internal::core
@@ -89,6 +92,7 @@ void StartupCallback::on_internal_set(ResponseMessage* response) {
     }
 
     case CQL_OPCODE_AUTHENTICATE: {
+      connector_->maybe_start_segment_framing();
       AuthenticateResponse* auth =
           static_cast<AuthenticateResponse*>(response->response_body().get());
       connector_->on_authenticate(auth->class_name());
@@ -108,6 +112,7 @@ void StartupCallback::on_internal_set(ResponseMessage* response) {
       break;
 
     case CQL_OPCODE_READY:
+      connector_->maybe_start_segment_framing();
       connector_->on_ready_or_register_for_events();
       break;
 
@@ -154,7 +159,12 @@ ConnectionSettings::ConnectionSettings()
     , auth_provider(new AuthProvider())
     , idle_timeout_secs(CASS_DEFAULT_IDLE_TIMEOUT_SECS)
     , heartbeat_interval_secs(CASS_DEFAULT_HEARTBEAT_INTERVAL_SECS)
-    , no_compact(CASS_DEFAULT_NO_COMPACT) {}
+    , no_compact(CASS_DEFAULT_NO_COMPACT)
+    , pipelined_startup(CASS_DEFAULT_PIPELINED_STARTUP)
+    , compression(CASS_DEFAULT_COMPRESSION)
+    , compression_threshold(CASS_DEFAULT_COMPRESSION_THRESHOLD)
+    , result_decode_offload_threshold(CASS_DEFAULT_RESULT_DECODE_OFFLOAD_THRESHOLD)
+    , max_outstanding_write_bytes(CASS_DEFAULT_MAX_OUTSTANDING_WRITE_BYTES_PER_CONNECTION) {}
 
 ConnectionSettings::ConnectionSettings(const Config& config)
     : socket_settings(config)
@@ -163,6 +173,12 @@ ConnectionSettings::ConnectionSettings(const Config& config)
     , idle_timeout_secs(config.connection_idle_timeout_secs())
     , heartbeat_interval_secs(config.connection_heartbeat_interval_secs())
     , no_compact(config.no_compact())
+    , pipelined_startup(config.pipelined_startup())
+    , compression(config.compression())
+    , compression_threshold(config.compression_threshold())
+    , result_decode_offload_threshold(config.result_decode_offload_threshold())
+    , max_outstanding_write_bytes(config.max_outstanding_write_bytes_per_connection())
+    , frame_capture(config.frame_capture())
     , application_name(config.application_name())
     , application_version(config.application_version()) {}
 
@@ -177,7 +193,19 @@ Connector::Connector(const Host::Ptr& host, ProtocolVersion protocol_version,
     , protocol_version_(protocol_version)
     , event_types_(0)
     , listener_(NULL)
-    , metrics_(NULL) {}
+    , metrics_(NULL)
+    , is_supported_options_cached_(false)
+    , is_keyspace_pipelined_(false)
+    , is_protocol_version_cached_(false)
+    , is_protocol_downgraded_(false) {
+  // Start with the version the host is known to support instead of repeating
+  // a handshake that the host is going to reject
+  ProtocolVersion cached_version(host->protocol_version());
+  if (cached_version.is_valid() && cached_version < protocol_version) {
+    protocol_version_ = cached_version;
+    is_protocol_version_cached_ = true;
+  }
+}
 
 Connector* Connector::with_keyspace(const String& keyspace) {
   keyspace_ = keyspace;
@@ -209,9 +237,21 @@ Connector* Connector::with_settings(const ConnectionSettings& settings) {
   return this;
 }
 
+Connector* Connector::with_shard_aware_port(int port, int local_port) {
+  const Address& address = host_->address();
+  socket_connector_.reset(
+      new SocketConnector(Address(address.hostname_or_address(), port, address.server_name()),
+                          bind_callback(&Connector::on_connect, this)));
+  socket_connector_->with_local_port(local_port);
+  return this;
+}
+
 void Connector::connect(uv_loop_t* loop) {
   inc_ref(); // For the event loop
   loop_ = loop;
+  if (is_protocol_version_cached_ && metrics_) {
+    metrics_->downgraded_connections.inc();
+  }
   socket_connector_->with_settings(settings_.socket_settings)->connect(loop);
   if (settings_.connect_timeout_ms > 0) {
     timer_.start(loop, settings_.connect_timeout_ms, bind_callback(&Connector::on_timeout, this));
@@ -232,6 +272,9 @@ Connection::Ptr Connector::release_connection() {
 
 void Connector::finish() {
   timer_.stop();
+  if (is_ok()) {
+    host_->set_protocol_version(protocol_version_);
+  }
   if (connection_) {
     connection_->set_listener(is_ok() ? listener_ : NULL);
   }
@@ -252,6 +295,14 @@ void Connector::on_error(ConnectionError code, const String& message) {
   if (error_code_ == CONNECTION_OK) { // Only perform this once
     error_message_ = message;
     error_code_ = code;
+    // The host's options might have changed (e.g. it was upgraded) so the
+    // next connection requests them again
+    if (is_supported_options_cached_ && code == CONNECTION_ERROR_RESPONSE) {
+      host_->clear_supported_options();
+    }
+    if (code == CONNECTION_ERROR_INVALID_PROTOCOL) {
+      downgrade_protocol_version();
+    }
     if (connection_) connection_->defunct();
     finish();
   }
@@ -260,6 +311,9 @@ void Connector::on_error(ConnectionError code, const String& message) {
 void Connector::on_ready_or_set_keyspace() {
   if (keyspace_.empty()) {
     finish();
+  } else if (is_keyspace_pipelined_) {
+    // The response to the USE request that was written after the STARTUP
+    // request finishes the connection
   } else {
     connection_->write_and_flush(RequestCallback::Ptr(
         new StartupCallback(this, Request::ConstPtr(new QueryRequest("USE " + keyspace_)))));
@@ -282,10 +336,79 @@ void Connector::on_supported(ResponseMessage* response) {
   SupportedResponse* supported = static_cast<SupportedResponse*>(response->response_body().get());
   supported_options_ = supported->supported_options();
 
+  ShardingInfo sharding_info;
+  if (ShardingInfo::parse(supported_options_, &sharding_info)) {
+    connection_->set_sharding_info(sharding_info);
+  } else {
+    // Only options that aren't specific to this connection are reused
+    host_->set_supported_options(supported_options_);
+  }
+
+  startup();
+}
+
+void Connector::startup() {
+  ScopedPtr<Compressor> compressor;
+  if (protocol_version_.supports_segments()) {
+    // Envelopes can't be compressed individually when using segment framing
+    if (settings_.compression != CASS_COMPRESSION_NONE) {
+      LOG_DEBUG("Compression is not supported for protocol version %s. "
+                "Connection to host %s will not use compression.",
+                protocol_version_.to_string().c_str(), address().to_string().c_str());
+    }
+  } else if (settings_.compression != CASS_COMPRESSION_NONE) {
+    compressor.reset(Compressor::negotiate(settings_.compression, supported_options_));
+    if (!compressor) {
+      LOG_WARN("Host %s doesn't support the requested compression algorithm. "
+               "Connection will not use compression.",
+               address().to_string().c_str());
+    }
+  }
+
   connection_->write_and_flush(RequestCallback::Ptr(new StartupCallback(
-      this, Request::ConstPtr(new StartupRequest(settings_.application_name,
-                                                 settings_.application_version, settings_.client_id,
-                                                 settings_.no_compact)))));
+      this, Request::ConstPtr(new StartupRequest(
+                settings_.application_name, settings_.application_version, settings_.client_id,
+                settings_.no_compact, compressor ? compressor->name() : "")))));
+
+  // All frames after the STARTUP request can be compressed
+  if (compressor) {
+    LOG_DEBUG("Using %s compression for connection to host %s", compressor->name(),
+              address().to_string().c_str());
+    connection_->set_compressor(compressor.release(), settings_.compression_threshold);
+  }
+
+  // The keyspace can be set without waiting for the READY response if the
+  // server can't require anything else first: authentication, registering
+  // for events or switching to segment framing.
+  if (settings_.pipelined_startup && !keyspace_.empty() && event_types_ == 0 &&
+      !protocol_version_.supports_segments() &&
+      (!settings_.auth_provider || settings_.auth_provider->name().empty())) {
+    is_keyspace_pipelined_ = true;
+    connection_->write_and_flush(RequestCallback::Ptr(
+        new StartupCallback(this, Request::ConstPtr(new QueryRequest("USE " + keyspace_)))));
+  }
+}
+
+void Connector::maybe_start_segment_framing() {
+  // The server switches to segment framing after the READY or AUTHENTICATE
+  // response so this must happen before any other request is written.
+  if (protocol_version_.supports_segments()) {
+    connection_->start_segment_framing();
+  }
+}
+
+void Connector::downgrade_protocol_version() {
+  ProtocolVersion lower_version(protocol_version_.previous());
+  if (!lower_version.is_valid()) return;
+  LOG_DEBUG("Host %s does not support protocol version %s. "
+            "Its next connection will use protocol version %s",
+            address().to_string().c_str(), protocol_version_.to_string().c_str(),
+            lower_version.to_string().c_str());
+  host_->set_protocol_version(lower_version);
+  is_protocol_downgraded_ = true;
+  if (metrics_) {
+    metrics_->protocol_downgrades.inc();
+  }
 }
 
 void Connector::on_authenticate(const String& class_name) {
@@ -338,6 +461,12 @@ void Connector::on_connect(SocketConnector* socket_connector) {
     connection_.reset(new Connection(socket, host_, protocol_version_, settings_.idle_timeout_secs,
                                      settings_.heartbeat_interval_secs));
     connection_->set_listener(this);
+    connection_->set_buffer_pool(settings_.buffer_pool);
+    connection_->set_decode_offload_threshold(settings_.result_decode_offload_threshold);
+    connection_->set_max_outstanding_write_bytes(settings_.max_outstanding_write_bytes);
+    if (settings_.frame_capture) {
+      connection_->set_frame_capture(settings_.frame_capture);
+    }
 
     if (socket_connector->ssl_session()) {
       socket->set_handler(
@@ -346,8 +475,15 @@ void Connector::on_connect(SocketConnector* socket_connector) {
       socket->set_handler(new ConnectionHandler(connection_.get()));
     }
 
-    connection_->write_and_flush(
-        RequestCallback::Ptr(new StartupCallback(this, Request::ConstPtr(new OptionsRequest()))));
+    // The OPTIONS request is skipped if another connection to the host has
+    // already received its SUPPORTED response
+    if (host_->supported_options(&supported_options_)) {
+      is_supported_options_cached_ = true;
+      startup();
+    } else {
+      connection_->write_and_flush(
+          RequestCallback::Ptr(new StartupCallback(this, Request::ConstPtr(new OptionsRequest()))));
+    }
 
   } else if (socket_connector->is_canceled() || is_timeout_error()) {
     finish();
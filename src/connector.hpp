@@ -51,6 +51,13 @@ struct ConnectionSettings {
   unsigned int idle_timeout_secs;
   unsigned int heartbeat_interval_secs;
   bool no_compact;
+  bool pipelined_startup;
+  CassCompressionType compression;
+  size_t compression_threshold;
+  size_t result_decode_offload_threshold;
+  size_t max_outstanding_write_bytes; // Unlimited if 0
+  FrameCapture::Ptr frame_capture;     // Not captured if NULL
+  BufferPool::Ptr buffer_pool;
   String application_name;
   String application_version;
   String client_id;
@@ -140,6 +147,17 @@ public:
    */
   Connector* with_settings(const ConnectionSettings& settings);
 
+  /**
+   * Connect to the host's shard-aware port instead of its regular port. The
+   * shard-aware port assigns the connection to the shard selected by its local
+   * port.
+   *
+   * @param port The shard-aware port.
+   * @param local_port The local (source) port.
+   * @return The connector to chain calls.
+   */
+  Connector* with_shard_aware_port(int port, int local_port);
+
   /**
    * Connect the connection.
    *
@@ -164,6 +182,7 @@ public:
 public:
   uv_loop_t* loop() { return loop_; }
 
+  const Host::Ptr& host() const { return host_; }
   const Address& address() const { return host_->address(); }
   const ProtocolVersion protocol_version() const { return protocol_version_; }
 
@@ -177,8 +196,11 @@ public:
   }
   bool is_timeout_error() const { return error_code_ == CONNECTION_ERROR_TIMEOUT; }
   bool is_keyspace_error() const { return error_code_ == CONNECTION_ERROR_KEYSPACE; }
+  // A rejected protocol version isn't critical if there's a lower version for
+  // the next connection to the host to try
   bool is_critical_error() const {
-    return is_auth_error() || is_ssl_error() || is_invalid_protocol() || is_keyspace_error();
+    return is_auth_error() || is_ssl_error() ||
+           (is_invalid_protocol() && !is_protocol_downgraded_) || is_keyspace_error();
   }
 
   const StringMultimap& supported_options() const { return supported_options_; }
@@ -197,6 +219,9 @@ private:
   void on_ready_or_set_keyspace();
   void on_ready_or_register_for_events();
   void on_supported(ResponseMessage* response);
+  void startup();
+  void maybe_start_segment_framing();
+  void downgrade_protocol_version();
 
   void on_authenticate(const String& class_name);
   void on_auth_challenge(const AuthResponseRequest* request, const String& token);
@@ -227,6 +252,10 @@ private:
   ConnectionListener* listener_;
   Metrics* metrics_;
   ConnectionSettings settings_;
+  bool is_supported_options_cached_;
+  bool is_keyspace_pipelined_;
+  bool is_protocol_version_cached_;
+  bool is_protocol_downgraded_;
 };
 
 }}} // namespace datastax::internal::core
@@ -100,6 +100,10 @@
 #define CASS_RESULT_FLAG_CONTINUOUS_PAGING 0x40000000
 #define CASS_RESULT_FLAG_LAST_CONTINUOUS_PAGE 0x80000000
 
+// The revisions of a continuous paging request (DSE)
+#define CASS_REVISION_TYPE_CANCEL_CONTINUOUS_PAGING 1
+#define CASS_REVISION_TYPE_MORE_CONTINUOUS_PAGES 2
+
 #define CASS_EVENT_TOPOLOGY_CHANGE 1
 #define CASS_EVENT_STATUS_CHANGE 2
 #define CASS_EVENT_SCHEMA_CHANGE 4
@@ -116,32 +120,100 @@
 #define CASS_DEFAULT_MAX_PREPARES_PER_FLUSH 128
 #define CASS_DEFAULT_MAX_REUSABLE_WRITE_OBJECTS UINT_MAX
 #define CASS_DEFAULT_MAX_SCHEMA_WAIT_TIME_MS 10000
+#define CASS_DEFAULT_SCHEMA_AGREEMENT_INTERVAL_MS 10
+#define CASS_DEFAULT_MAX_SCHEMA_AGREEMENT_INTERVAL_MS 200
 #define CASS_DEFAULT_NUM_CONNECTIONS_PER_HOST 1
+#define CASS_DEFAULT_NUM_CONNECTIONS_PER_REMOTE_HOST 0
+#define CASS_DEFAULT_MAX_CONNECTIONS_PER_HOST 0
+#define CASS_DEFAULT_MAX_CONCURRENT_REQUESTS_THRESHOLD 100
 #define CASS_DEFAULT_PREPARE_ON_ALL_HOSTS true
 #define CASS_DEFAULT_PREPARE_ON_UP_OR_ADD_HOST true
+#define CASS_DEFAULT_PREPARE_ON_UNPREPARED_HOST true
 #define CASS_DEFAULT_PORT 9042
 #define CASS_DEFAULT_QUEUE_SIZE_IO 8192
+#define CASS_DEFAULT_MAX_INFLIGHT_REQUESTS 0
+#define CASS_DEFAULT_REQUEST_ARENA_SIZE 0
+#define CASS_DEFAULT_BACKPRESSURE_MODE CASS_BACKPRESSURE_MODE_FAIL
+#define CASS_DEFAULT_PRODUCER_LANES 0
+#define CASS_DEFAULT_MEMORY_LIMIT 0
 #define CASS_DEFAULT_CONSTANT_RECONNECT_WAIT_TIME_MS 2000u
 #define CASS_DEFAULT_EXPONENTIAL_RECONNECT_BASE_DELAY_MS \
   CASS_DEFAULT_CONSTANT_RECONNECT_WAIT_TIME_MS
 #define CASS_DEFAULT_EXPONENTIAL_RECONNECT_MAX_DELAY_MS 600000u // 10 minutes
 #define CASS_DEFAULT_RESOLVE_TIMEOUT_MS 5000
+#define CASS_DEFAULT_CLOSE_TIMEOUT_MS 0
+#define CASS_DEFAULT_HOST_DRAIN_TIMEOUT_MS 0
+#define CASS_DEFAULT_LAZY_REMOTE_POOLS false
+#define CASS_DEFAULT_REMOTE_POOL_IDLE_TIMEOUT_SECS 0
 #define CASS_DEFAULT_TCP_KEEPALIVE_DELAY_SECS 0
 #define CASS_DEFAULT_TCP_KEEPALIVE_ENABLED true
 #define CASS_DEFAULT_TCP_NO_DELAY_ENABLED true
+#define CASS_DEFAULT_SOCKET_RECEIVE_BUFFER_SIZE 0 // The system's default
+#define CASS_DEFAULT_SOCKET_SEND_BUFFER_SIZE 0    // The system's default
+#define CASS_DEFAULT_TCP_NOTSENT_LOWAT 0          // Disabled
 #define CASS_DEFAULT_THREAD_COUNT_IO 1
+#define CASS_DEFAULT_THREAD_COUNT_CALLBACK 0
+#define CASS_DEFAULT_WORK_STEALING false
+#define CASS_DEFAULT_IO_URING_ENABLED false
+#define CASS_DEFAULT_BUSY_POLL false
+#define CASS_DEFAULT_SOCKET_BUSY_POLL_US 0
+#define CASS_DEFAULT_IO_THREAD_NUMA_LOCAL false
+#define CASS_DEFAULT_HUGE_PAGE_BUFFERS false
 #define CASS_DEFAULT_USE_TOKEN_AWARE_ROUTING true
 #define CASS_DEFAULT_USE_SNI_ROUTING false
 #define CASS_DEFAULT_USE_BETA_PROTOCOL_VERSION false
 #define CASS_DEFAULT_USE_RANDOMIZED_CONTACT_POINTS true
 #define CASS_DEFAULT_USE_SCHEMA true
+#define CASS_DEFAULT_USE_LAZY_SCHEMA false
+#define CASS_DEFAULT_USE_PARALLEL_STARTUP false
+#define CASS_DEFAULT_TOKEN_AWARE_BATCH_SPLITTING false
+#define CASS_DEFAULT_READ_COALESCING false
+#define CASS_DEFAULT_BATCH_SPLIT_SIZE 0
+#define CASS_DEFAULT_LOW_PRIORITY_WEIGHT 8
+#define CASS_DEFAULT_RESERVED_STREAMS 1024
+#define CASS_DEFAULT_TABLE_SCAN_CONCURRENCY 4
+#define CASS_DEFAULT_TABLE_SCAN_PAGING_SIZE 5000
+#define CASS_DEFAULT_BULK_WRITER_BATCH_SIZE 32
+#define CASS_DEFAULT_BULK_WRITER_MAX_REQUESTS_PER_HOST 8
+#define CASS_DEFAULT_BULK_WRITER_MAX_PENDING_ROWS 16384
+#define CASS_DEFAULT_BULK_WRITER_MAX_RETRIES 3
 #define CASS_DEFAULT_COALESCE_DELAY 200
 #define CASS_DEFAULT_NEW_REQUEST_RATIO 50
+#define CASS_DEFAULT_RETRY_BUDGET_RATIO 0.0
+#define CASS_DEFAULT_CIRCUIT_BREAKER_FAILURE_THRESHOLD 0
+#define CASS_DEFAULT_CIRCUIT_BREAKER_OPEN_DURATION_MS 1000
+#define CASS_DEFAULT_CONCURRENCY_LIMITER_MIN_LIMIT 20
+#define CASS_DEFAULT_CONCURRENCY_LIMITER_MAX_LIMIT 0
+#define CASS_DEFAULT_CONCURRENCY_LIMITER_LATENCY_THRESHOLD_MS 100
+#define CASS_DEFAULT_HOST_AND_PROFILE_METRICS false
+#define CASS_DEFAULT_REQUEST_STAGE_METRICS false
+#define CASS_DEFAULT_METRICS_MERGE_INTERVAL_MS 0
+#define CASS_DEFAULT_METRICS_SNAPSHOT_MAX_AGE_MS 0
+#define CASS_DEFAULT_SLOW_REQUEST_THRESHOLD_MS 0
+#define CASS_DEFAULT_SLOW_REQUEST_LOG_CAPACITY 1024
+#define CASS_DEFAULT_COALESCE_MODE CASS_COALESCE_MODE_FIXED
+#define CASS_DEFAULT_COALESCE_LATENCY_BUDGET_US 2000
+#define CASS_DEFAULT_CONNECTION_SELECTION CASS_CONNECTION_SELECTION_LEAST_BUSY
 #define CASS_DEFAULT_NO_COMPACT false
+#define CASS_DEFAULT_PIPELINED_STARTUP false
+#define CASS_DEFAULT_COMPRESSION CASS_COMPRESSION_NONE
+#define CASS_DEFAULT_COMPRESSION_THRESHOLD 512
+#define CASS_DEFAULT_RESULT_DECODE_OFFLOAD_THRESHOLD 0
+#define CASS_DEFAULT_MAX_OUTSTANDING_WRITE_BYTES_PER_CONNECTION 0
+#define CASS_DEFAULT_MAX_PREPARED_STATEMENTS 0
+#define CASS_DEFAULT_RESULT_CACHE_SIZE 0
+#define CASS_DEFAULT_MAX_CONCURRENT_CONNECT_ATTEMPTS_PER_HOST 0
+#define CASS_DEFAULT_HOST_WARMUP_DURATION_MS 0
+#define CASS_DEFAULT_CONNECTION_WARMUP_REQUESTS 0
+#define CASS_DEFAULT_SHARD_AWARENESS true
+#define CASS_DEFAULT_HOST_PROBE_INTERVAL_MS 0
+#define CASS_DEFAULT_EVENT_DEBOUNCE_WINDOW_MS 0
 #define CASS_DEFAULT_CQL_VERSION "3.0.0"
 #define CASS_DEFAULT_MAX_TRACING_DATA_WAIT_TIME_MS 15
 #define CASS_DEFAULT_RETRY_TRACING_DATA_WAIT_TIME_MS 3
 #define CASS_DEFAULT_TRACING_CONSISTENCY CASS_CONSISTENCY_ONE
+#define CASS_DEFAULT_TRACING_WAIT_FOR_DATA true
+#define CASS_DEFAULT_TRACING_PROBABILITY 0.0
 
 // Request-level defaults
 #define CASS_DEFAULT_CONSISTENCY CASS_CONSISTENCY_LOCAL_ONE
@@ -0,0 +1,309 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "continuous_paging.hpp"
+
+#include "connection.hpp"
+#include "constants.hpp"
+#include "event_loop.hpp"
+#include "logger.hpp"
+#include "request_handler.hpp"
+#include "revise_request.hpp"
+#include "session.hpp"
+#include "statement.hpp"
+
+using namespace datastax;
+using namespace datastax::internal::core;
+
+extern "C" {
+
+DseContinuousPaging* dse_continuous_paging_new() {
+  ContinuousPaging* paging = new ContinuousPaging();
+  paging->inc_ref();
+  return DseContinuousPaging::to(paging);
+}
+
+void dse_continuous_paging_free(DseContinuousPaging* paging) {
+  paging->cancel();
+  paging->dec_ref();
+}
+
+CassError dse_continuous_paging_set_max_pages(DseContinuousPaging* paging,
+                                              cass_int32_t max_pages) {
+  return paging->set_max_pages(max_pages);
+}
+
+CassError dse_continuous_paging_set_pages_per_second(DseContinuousPaging* paging,
+                                                     cass_int32_t pages_per_second) {
+  return paging->set_pages_per_second(pages_per_second);
+}
+
+CassError dse_continuous_paging_set_max_enqueued_pages(DseContinuousPaging* paging,
+                                                       cass_int32_t max_enqueued_pages) {
+  return paging->set_max_enqueued_pages(max_enqueued_pages);
+}
+
+CassError cass_session_execute_dse_continuous_paging(CassSession* session,
+                                                     const CassStatement* statement,
+                                                     DseContinuousPaging* paging) {
+  return paging->start(session->from(), statement->from());
+}
+
+const CassResult* dse_continuous_paging_next_page(DseContinuousPaging* paging) {
+  ResultResponse::Ptr page(paging->next_page());
+  if (!page) return NULL;
+  page->inc_ref();
+  return CassResult::to(page.get());
+}
+
+void dse_continuous_paging_cancel(DseContinuousPaging* paging) { paging->cancel(); }
+
+CassError dse_continuous_paging_error_code(const DseContinuousPaging* paging) {
+  return paging->error_code();
+}
+
+void dse_continuous_paging_error_message(const DseContinuousPaging* paging, const char** message,
+                                         size_t* message_length) {
+  const String& error_message = paging->error_message();
+  *message = error_message.data();
+  *message_length = error_message.size();
+}
+
+} // extern "C"
+
+namespace {
+
+/**
+ * The callback of a revise request. Its response is only logged: a canceled
+ * request is still finished by its last response.
+ */
+class ReviseCallback : public SimpleRequestCallback {
+public:
+  ReviseCallback(int32_t revision_type, int stream, int32_t next_pages)
+      : SimpleRequestCallback(
+            Request::ConstPtr(new ReviseRequest(revision_type, stream, next_pages)))
+      , stream_(stream) {}
+
+private:
+  virtual void on_internal_set(ResponseMessage* response) {
+    if (response->opcode() == CQL_OPCODE_ERROR) {
+      ErrorResponse* error = static_cast<ErrorResponse*>(response->response_body().get());
+      LOG_WARN("Unable to revise the continuous paging request with stream %d: %s", stream_,
+               error->message().to_string().c_str());
+    }
+  }
+
+  virtual void on_internal_error(CassError code, const String& message) {
+    LOG_WARN("Unable to revise the continuous paging request with stream %d: %s", stream_,
+             message.c_str());
+  }
+
+  virtual void on_internal_timeout() {
+    LOG_WARN("Revising the continuous paging request with stream %d timed out", stream_);
+  }
+
+private:
+  int stream_;
+};
+
+/**
+ * Writes a revise request on the event loop of the connection of the
+ * continuous paging request.
+ */
+class ReviseTask : public Task {
+public:
+  ReviseTask(Connection* connection, int32_t revision_type, int stream, int32_t next_pages)
+      : connection_(connection)
+      , revision_type_(revision_type)
+      , stream_(stream)
+      , next_pages_(next_pages) {}
+
+  virtual void run(EventLoop* event_loop) {
+    if (connection_->is_closing()) return; // The request is failed by the connection
+    RequestCallback::Ptr callback(new ReviseCallback(revision_type_, stream_, next_pages_));
+    if (connection_->write_and_flush(callback) < 0) {
+      LOG_WARN("Unable to write a revise request for the continuous paging request with stream %d",
+               stream_);
+    }
+  }
+
+private:
+  Connection::Ptr connection_;
+  int32_t revision_type_;
+  int stream_;
+  int32_t next_pages_;
+};
+
+} // namespace
+
+ContinuousPaging::ContinuousPaging()
+    : is_started_(false)
+    , is_done_(false)
+    , is_canceled_(false)
+    , is_cancel_sent_(false)
+    , event_loop_(NULL)
+    , stream_(-1)
+    , has_credits_(false)
+    , taken_pages_(0)
+    , error_code_(CASS_OK) {
+  uv_mutex_init(&mutex_);
+  uv_cond_init(&cond_);
+}
+
+ContinuousPaging::~ContinuousPaging() {
+  uv_mutex_destroy(&mutex_);
+  uv_cond_destroy(&cond_);
+}
+
+CassError ContinuousPaging::set_max_pages(int32_t max_pages) {
+  if (is_started_) return CASS_ERROR_LIB_INVALID_STATE;
+  if (max_pages < 0) return CASS_ERROR_LIB_BAD_PARAMS;
+  options_.max_pages = max_pages;
+  return CASS_OK;
+}
+
+CassError ContinuousPaging::set_pages_per_second(int32_t pages_per_second) {
+  if (is_started_) return CASS_ERROR_LIB_INVALID_STATE;
+  if (pages_per_second < 0) return CASS_ERROR_LIB_BAD_PARAMS;
+  options_.pages_per_second = pages_per_second;
+  return CASS_OK;
+}
+
+CassError ContinuousPaging::set_max_enqueued_pages(int32_t max_enqueued_pages) {
+  if (is_started_) return CASS_ERROR_LIB_INVALID_STATE;
+  if (max_enqueued_pages < 0) return CASS_ERROR_LIB_BAD_PARAMS;
+  options_.max_enqueued_pages = max_enqueued_pages;
+  return CASS_OK;
+}
+
+CassError ContinuousPaging::start(Session* session, const Statement* statement) {
+  if (is_started_) return CASS_ERROR_LIB_INVALID_STATE;
+
+  if (session->state() != SessionBase::SESSION_STATE_CONNECTED) {
+    ScopedMutex l(&mutex_);
+    error_code_ = CASS_ERROR_LIB_NO_HOSTS_AVAILABLE;
+    error_message_ = "Session is not connected";
+    return error_code_;
+  }
+
+  is_started_ = true;
+
+  Future::Ptr future(session->execute_continuous_paging(Request::ConstPtr(statement), Ptr(this)));
+  inc_ref(); // Released by the future's callback
+  future->set_callback(on_result, this);
+  return CASS_OK;
+}
+
+ResultResponse::Ptr ContinuousPaging::next_page() {
+  ScopedMutex l(&mutex_);
+  if (!is_started_) return ResultResponse::Ptr();
+
+  while (pages_.empty() && !is_done_ && !is_canceled_) {
+    uv_cond_wait(&cond_, l.get());
+  }
+  if (pages_.empty()) return ResultResponse::Ptr();
+
+  ResultResponse::Ptr page(pages_.front());
+  pages_.pop_front();
+
+  // Grant the pages taken as credits once half of the enqueued pages have
+  // been taken so the coordinator doesn't stall waiting for credits and
+  // a revise request isn't sent for every page.
+  if (has_credits_ && !is_done_) {
+    int32_t threshold = options_.max_enqueued_pages / 2;
+    if (++taken_pages_ >= (threshold > 0 ? threshold : 1)) {
+      revise(CASS_REVISION_TYPE_MORE_CONTINUOUS_PAGES, taken_pages_);
+      taken_pages_ = 0;
+    }
+  }
+  return page;
+}
+
+void ContinuousPaging::cancel() {
+  ScopedMutex l(&mutex_);
+  if (is_canceled_) return;
+  is_canceled_ = true;
+  pages_.clear();
+  // Before the first page the connection isn't known yet so the revise
+  // request is sent once the first page is received.
+  if (!is_done_ && connection_) {
+    revise(CASS_REVISION_TYPE_CANCEL_CONTINUOUS_PAGING);
+    is_cancel_sent_ = true;
+  }
+  uv_cond_broadcast(&cond_);
+}
+
+CassError ContinuousPaging::error_code() const {
+  ScopedMutex l(&mutex_);
+  return error_code_;
+}
+
+const String& ContinuousPaging::error_message() const {
+  ScopedMutex l(&mutex_);
+  return error_message_;
+}
+
+void ContinuousPaging::add_page(Connection* connection, int stream,
+                                const ResultResponse::Ptr& page) {
+  ScopedMutex l(&mutex_);
+  if (!connection_) {
+    event_loop_ = static_cast<EventLoop*>(connection->loop()->data);
+    connection_.reset(connection);
+    stream_ = stream;
+    has_credits_ = options_.max_enqueued_pages > 0 &&
+                   connection->protocol_version() >= CASS_PROTOCOL_VERSION_DSEV2;
+  }
+
+  if (is_canceled_) {
+    if (!is_cancel_sent_) {
+      revise(CASS_REVISION_TYPE_CANCEL_CONTINUOUS_PAGING);
+      is_cancel_sent_ = true;
+    }
+    return; // Dropped until the last response finishes the request
+  }
+
+  pages_.push_back(page);
+  uv_cond_signal(&cond_);
+}
+
+void ContinuousPaging::on_result(CassFuture* future, void* data) {
+  ContinuousPaging* paging = static_cast<ContinuousPaging*>(data);
+  paging->handle_result(future->from());
+  paging->dec_ref();
+}
+
+void ContinuousPaging::handle_result(Future* future) {
+  ResponseFuture* response_future = static_cast<ResponseFuture*>(future);
+  const Future::Error* error = response_future->error();
+
+  ScopedMutex l(&mutex_);
+  is_done_ = true;
+  connection_.reset(); // Released on the connection's event loop
+  if (error != NULL) {
+    error_code_ = error->code;
+    error_message_ = error->message;
+  } else if (!is_canceled_) {
+    const Response::Ptr& response = response_future->response();
+    if (response->opcode() == CQL_OPCODE_RESULT) {
+      pages_.push_back(ResultResponse::Ptr(static_cast<ResultResponse*>(response.get())));
+    }
+  }
+  uv_cond_broadcast(&cond_);
+}
+
+void ContinuousPaging::revise(int32_t revision_type, int32_t next_pages) {
+  event_loop_->add(new ReviseTask(connection_.get(), revision_type, stream_, next_pages));
+}
@@ -0,0 +1,138 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_CONTINUOUS_PAGING_HPP
+#define DATASTAX_INTERNAL_CONTINUOUS_PAGING_HPP
+
+#include "cassandra.h"
+#include "deque.hpp"
+#include "dse.h"
+#include "external.hpp"
+#include "future.hpp"
+#include "ref_counted.hpp"
+#include "request_callback.hpp"
+#include "result_response.hpp"
+#include "scoped_lock.hpp"
+#include "string.hpp"
+
+#include <uv.h>
+
+namespace datastax { namespace internal { namespace core {
+
+class Connection;
+class EventLoop;
+class Session;
+class Statement;
+
+/**
+ * The pages of a DSE continuous paging request. The coordinator streams all
+ * of the pages on the request's stream, without a request for each page, and
+ * they're queued until the application takes them.
+ *
+ * With DSEv2 the coordinator only sends as many pages as it has credits for.
+ * It starts with the maximum number of enqueued pages and more credits are
+ * granted (using a revise request on the request's connection) as the
+ * application takes pages, so a slow application throttles the coordinator
+ * instead of queuing an unbounded number of pages. DSEv1 doesn't support
+ * credits so the pages are only throttled by the pages per second.
+ */
+class ContinuousPaging : public RefCounted<ContinuousPaging> {
+public:
+  typedef SharedRefPtr<ContinuousPaging> Ptr;
+
+  ContinuousPaging();
+  ~ContinuousPaging();
+
+  CassError set_max_pages(int32_t max_pages);
+  CassError set_pages_per_second(int32_t pages_per_second);
+  CassError set_max_enqueued_pages(int32_t max_enqueued_pages);
+
+  const ContinuousPagingOptions& options() const { return options_; }
+
+  /**
+   * Start the request. A continuous paging request can only be started once.
+   *
+   * @param session A connected session.
+   * @param statement The statement. Its page size is the number of rows of
+   * each page.
+   * @return CASS_OK if the request was started, otherwise an error.
+   */
+  CassError start(Session* session, const Statement* statement);
+
+  /**
+   * Take the next page, waiting for it if it hasn't been received yet.
+   *
+   * @return The next page or null if there are no more pages, the request
+   * failed or it was canceled.
+   */
+  ResultResponse::Ptr next_page();
+
+  /**
+   * Cancel the request. The coordinator stops sending pages and the pages that
+   * haven't been taken are dropped.
+   */
+  void cancel();
+
+  CassError error_code() const;
+  const String& error_message() const;
+
+public:
+  /**
+   * Add a page that isn't the last page. This is called on the event loop of
+   * the request's connection.
+   *
+   * @param connection The request's connection.
+   * @param stream The request's stream.
+   * @param page The page.
+   */
+  void add_page(Connection* connection, int stream, const ResultResponse::Ptr& page);
+
+private:
+  static void on_result(CassFuture* future, void* data);
+  void handle_result(Future* future);
+
+  /**
+   * Revise the request by queuing a revise request on the event loop of the
+   * request's connection. The mutex must be held.
+   */
+  void revise(int32_t revision_type, int32_t next_pages = 0);
+
+private:
+  mutable uv_mutex_t mutex_;
+  uv_cond_t cond_;
+  ContinuousPagingOptions options_;
+  bool is_started_;
+  bool is_done_; // The last page or an error was received
+  bool is_canceled_;
+  bool is_cancel_sent_;
+  Deque<ResultResponse::Ptr> pages_;
+  EventLoop* event_loop_;
+  SharedRefPtr<Connection> connection_;
+  int stream_;
+  bool has_credits_;
+  int32_t taken_pages_; // The pages taken since credits were last granted
+  CassError error_code_;
+  String error_message_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ContinuousPaging);
+};
+
+}}} // namespace datastax::internal::core
+
+EXTERNAL_TYPE(datastax::internal::core::ContinuousPaging, DseContinuousPaging)
+
+#endif
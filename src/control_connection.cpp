@@ -172,6 +172,28 @@ public:
   const bool is_all_peers;
 };
 
+/**
+ * A specialized request callback for refreshing several nodes with a single
+ * query of the whole "system.peers" table. This is used when node events are
+ * debounced.
+ */
+class RefreshNodesCallback : public ControlRequestCallback {
+public:
+  /**
+   * Constructor.
+   *
+   * @param events The new node and node moved events.
+   * @param query The query for all the peers.
+   * @param control_connection The control connection the query is run on.
+   */
+  RefreshNodesCallback(const EventResponse::Vec& events, const String& query,
+                       ControlConnection* control_connection)
+      : ControlRequestCallback(query, control_connection, ControlConnection::on_refresh_nodes)
+      , events(events) {}
+
+  const EventResponse::Vec events;
+};
+
 /**
  * A specialized request callback for keyspace queries. This is needed for
  * keyspace change events.
@@ -306,19 +328,52 @@ static NopControlConnectionListener nop_listener__;
 
 ControlConnectionSettings::ControlConnectionSettings()
     : use_schema(CASS_DEFAULT_USE_SCHEMA)
+    , use_lazy_schema(CASS_DEFAULT_USE_LAZY_SCHEMA)
     , use_token_aware_routing(CASS_DEFAULT_USE_TOKEN_AWARE_ROUTING)
-    , address_factory(new AddressFactory()) {}
+    , address_factory(new AddressFactory())
+    , event_debounce_window_ms(CASS_DEFAULT_EVENT_DEBOUNCE_WINDOW_MS) {}
 
 ControlConnectionSettings::ControlConnectionSettings(const Config& config)
     : connection_settings(config)
     , use_schema(config.use_schema())
+    , use_lazy_schema(config.use_lazy_schema())
+    , schema_keyspaces(config.schema_keyspaces())
     , use_token_aware_routing(config.token_aware_routing())
-    , address_factory(create_address_factory_from_config(config)) {}
+    , address_factory(create_address_factory_from_config(config))
+    , event_debounce_window_ms(config.event_debounce_window_ms()) {}
+
+bool ControlConnectionSettings::is_schema_keyspace_included(const StringRef& keyspace_name) const {
+  if (schema_keyspaces.empty()) return true;
+  for (StringVec::const_iterator it = schema_keyspaces.begin(), end = schema_keyspaces.end();
+       it != end; ++it) {
+    if (keyspace_name == *it) return true;
+  }
+  return false;
+}
+
+String ControlConnectionSettings::schema_keyspace_restriction() const {
+  if (schema_keyspaces.empty()) return String();
+  String restriction(" WHERE keyspace_name IN (");
+  for (StringVec::const_iterator it = schema_keyspaces.begin(), end = schema_keyspaces.end();
+       it != end; ++it) {
+    if (it != schema_keyspaces.begin()) restriction.append(",");
+    restriction.push_back('\'');
+    for (String::const_iterator c = it->begin(); c != it->end(); ++c) {
+      if (*c == '\'') restriction.push_back('\''); // Escape quotes by doubling them
+      restriction.push_back(*c);
+    }
+    restriction.push_back('\'');
+  }
+  restriction.append(")");
+  return restriction;
+}
 
 ControlConnector::ControlConnector(const Host::Ptr& host, ProtocolVersion protocol_version,
                                    const Callback& callback)
     : connector_(
           new Connector(host, protocol_version, bind_callback(&ControlConnector::on_connect, this)))
+    , is_schema_deferred_(false)
+    , step_start_time_(0)
     , callback_(callback)
     , error_code_(CONTROL_CONNECTION_OK)
     , listener_(NULL)
@@ -415,13 +470,60 @@ void ControlConnection::handle_refresh_node(RefreshNodeCallback* callback) {
     return;
   }
 
+  update_node(callback->type, row);
+}
+
+void ControlConnection::refresh_nodes(const EventResponse::Vec& events) {
+  LOG_DEBUG("Refresh %u nodes: %s", static_cast<unsigned>(events.size()), SELECT_PEERS);
+
+  RequestCallback::Ptr callback(new RefreshNodesCallback(events, SELECT_PEERS, this));
+  if (write_and_flush(callback) < 0) {
+    LOG_ERROR("No more stream available while attempting to refresh nodes info");
+    defunct();
+  }
+}
+
+void ControlConnection::on_refresh_nodes(ControlRequestCallback* callback) {
+  RefreshNodesCallback* refresh_callback = static_cast<RefreshNodesCallback*>(callback);
+  refresh_callback->control_connection()->handle_refresh_nodes(refresh_callback);
+}
+
+void ControlConnection::handle_refresh_nodes(RefreshNodesCallback* callback) {
+  for (EventResponse::Vec::const_iterator it = callback->events.begin(),
+                                          end = callback->events.end();
+       it != end; ++it) {
+    const Address& address = (*it)->affected_node();
+    bool found_host = false;
+    const Row* row = NULL;
+    ResultIterator rows(callback->result().get());
+    while (!found_host && rows.next()) {
+      row = rows.row();
+      if (settings_.address_factory->is_peer(row, connection_->host(), address)) {
+        found_host = true;
+      }
+    }
+
+    if (!found_host) {
+      String address_str = address.to_string();
+      LOG_ERROR("No row found for host %s in %s's peers system table. "
+                "%s will be ignored.",
+                address_str.c_str(), address_string().c_str(), address_str.c_str());
+      continue;
+    }
+
+    update_node((*it)->topology_change() == EventResponse::MOVED_NODE ? MOVED_NODE : NEW_NODE,
+                row);
+  }
+}
+
+void ControlConnection::update_node(RefreshNodeType type, const Row* row) {
   Address address;
   if (settings_.address_factory->create(row, connection_->host(), &address)) {
     Host::Ptr host(new Host(address));
     host->set(row, settings_.use_token_aware_routing);
     listen_addresses_[host->rpc_address()] = determine_listen_address(address, row);
 
-    switch (callback->type) {
+    switch (type) {
       case NEW_NODE:
         listener_->on_add(host);
         break;
@@ -686,11 +788,85 @@ void ControlConnection::handle_refresh_function(RefreshFunctionCallback* callbac
 }
 
 void ControlConnection::on_close(Connection* connection) {
+  debounce_timer_.stop();
+  pending_events_.clear();
   listener_->on_close(this);
   dec_ref();
 }
 
 void ControlConnection::on_event(const EventResponse::Ptr& response) {
+  if (settings_.event_debounce_window_ms > 0) {
+    debounce_event(response);
+  } else {
+    handle_event(response);
+  }
+}
+
+static bool is_same_event_target(const EventResponse* a, const EventResponse* b) {
+  if (a->event_type() != b->event_type()) return false;
+  if (a->event_type() == CASS_EVENT_TOPOLOGY_CHANGE) {
+    return a->affected_node() == b->affected_node();
+  }
+  return a->schema_change_target() == b->schema_change_target() &&
+         a->keyspace() == b->keyspace() && a->target() == b->target() &&
+         a->arg_types() == b->arg_types();
+}
+
+void ControlConnection::debounce_event(const EventResponse::Ptr& response) {
+  bool is_refresh = false;
+  if (response->event_type() == CASS_EVENT_TOPOLOGY_CHANGE) {
+    is_refresh = response->topology_change() != EventResponse::REMOVED_NODE;
+  } else if (response->event_type() == CASS_EVENT_SCHEMA_CHANGE) {
+    is_refresh = response->schema_change() != EventResponse::DROPPED;
+  }
+
+  // Any pending refresh of the same node or schema object is superseded. A
+  // removed node or dropped object is handled right away and isn't refreshed.
+  for (EventResponse::Vec::iterator it = pending_events_.begin(); it != pending_events_.end();) {
+    if (is_same_event_target(it->get(), response.get())) {
+      it = pending_events_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  if (!is_refresh) {
+    handle_event(response);
+    return;
+  }
+
+  pending_events_.push_back(response);
+  if (!debounce_timer_.is_running()) {
+    debounce_timer_.start(connection_->loop(), settings_.event_debounce_window_ms,
+                          bind_callback(&ControlConnection::on_debounce, this));
+  }
+}
+
+void ControlConnection::on_debounce(Timer* timer) {
+  EventResponse::Vec events;
+  events.swap(pending_events_);
+
+  EventResponse::Vec peer_events;
+  for (EventResponse::Vec::const_iterator it = events.begin(), end = events.end(); it != end;
+       ++it) {
+    if ((*it)->event_type() == CASS_EVENT_TOPOLOGY_CHANGE &&
+        !connection_->host()->rpc_address().equals((*it)->affected_node(), false)) {
+      peer_events.push_back(*it);
+    } else {
+      handle_event(*it);
+    }
+  }
+
+  // Refresh all the changed peers with a single query
+  if (peer_events.size() == 1) {
+    handle_event(peer_events.front());
+  } else if (peer_events.size() > 1) {
+    LOG_INFO("Coalesced %u node events", static_cast<unsigned>(peer_events.size()));
+    refresh_nodes(peer_events);
+  }
+}
+
+void ControlConnection::handle_event(const EventResponse::Ptr& response) {
   switch (response->event_type()) {
     case CASS_EVENT_TOPOLOGY_CHANGE: {
       String address_str = response->affected_node().to_string();
@@ -744,6 +920,13 @@ void ControlConnection::on_event(const EventResponse::Ptr& response) {
                 (int)response->keyspace().size(), response->keyspace().data(),
                 (int)response->target().size(), response->target().data());
 
+      // Keyspaces are always tracked (for the token map), but the rest of the
+      // schema is only tracked for the filtered keyspaces
+      if (response->schema_change_target() != EventResponse::KEYSPACE &&
+          !settings_.is_schema_keyspace_included(response->keyspace())) {
+        return;
+      }
+
       switch (response->schema_change()) {
         case EventResponse::CREATED:
         case EventResponse::UPDATED:
@@ -23,12 +23,14 @@
 #include "connection.hpp"
 #include "connector.hpp"
 #include "dense_hash_map.hpp"
+#include "event_response.hpp"
 #include "host.hpp"
 #include "load_balancing.hpp"
 #include "macros.hpp"
 #include "request_callback.hpp"
 #include "response.hpp"
 #include "scoped_ptr.hpp"
+#include "timer.hpp"
 #include "token_map.hpp"
 
 #include <stdint.h>
@@ -63,10 +65,12 @@ class ControlRequestCallback;
 class ControlConnection;
 class EventResponse;
 class RefreshNodeCallback;
+class RefreshNodesCallback;
 class RefreshKeyspaceCallback;
 class RefreshTableCallback;
 class RefreshTypeCallback;
 class RefreshFunctionCallback;
+class Row;
 
 /**
  * A listener for processing control connection events such as topology, node
@@ -166,6 +170,24 @@ struct ControlConnectionSettings {
    */
   ControlConnectionSettings(const Config& config);
 
+  /**
+   * Determines if schema metadata is retrieved for a keyspace.
+   *
+   * @param keyspace_name The name of the keyspace.
+   * @return true if there's no keyspace filter or the keyspace is in the
+   * filter.
+   */
+  bool is_schema_keyspace_included(const StringRef& keyspace_name) const;
+
+  /**
+   * Gets the "WHERE" clause that restricts schema queries to the keyspace
+   * filter.
+   *
+   * @return The "WHERE" clause (with a leading space) or an empty string if
+   * there's no keyspace filter.
+   */
+  String schema_keyspace_restriction() const;
+
   /**
    * The settings for the underlying connection.
    */
@@ -176,6 +198,19 @@ struct ControlConnectionSettings {
    */
   bool use_schema;
 
+  /**
+   * If true then the tables, views, user types, functions and aggregates of a
+   * keyspace are only built from the retained schema rows when the keyspace
+   * is first accessed.
+   */
+  bool use_lazy_schema;
+
+  /**
+   * The keyspaces to retrieve schema metadata for. All keyspaces are included
+   * if this is empty.
+   */
+  StringVec schema_keyspaces;
+
   /**
    * If true then the control connection will listen for keyspace schema
    * events. This is needed for the keyspaces replication strategy.
@@ -186,6 +221,13 @@ struct ControlConnectionSettings {
    * A factory for creating addresses (for the connection process).
    */
   AddressFactory::Ptr address_factory;
+
+  /**
+   * The window, in milliseconds, used to coalesce node and schema change
+   * events into fewer refreshes and token map updates. Events are handled
+   * as soon as they're received if this is zero.
+   */
+  unsigned event_debounce_window_ms;
 };
 
 /**
@@ -261,6 +303,7 @@ public:
 private:
   friend class ControlConnector;
   friend class RefreshNodeCallback;
+  friend class RefreshNodesCallback;
   friend class RefreshKeyspaceCallback;
   friend class RefreshTableCallback;
   friend class RefreshTypeCallback;
@@ -271,6 +314,12 @@ private:
   static void on_refresh_node(ControlRequestCallback* callback);
   void handle_refresh_node(RefreshNodeCallback* callback);
 
+  void refresh_nodes(const EventResponse::Vec& events);
+  static void on_refresh_nodes(ControlRequestCallback* callback);
+  void handle_refresh_nodes(RefreshNodesCallback* callback);
+
+  void update_node(RefreshNodeType type, const Row* row);
+
   void refresh_keyspace(const StringRef& keyspace_name);
   static void on_refresh_keyspace(ControlRequestCallback* callback);
   void handle_refresh_keyspace(RefreshKeyspaceCallback* callback);
@@ -288,6 +337,10 @@ private:
   static void on_refresh_function(ControlRequestCallback* callback);
   void handle_refresh_function(RefreshFunctionCallback* callback);
 
+  void handle_event(const EventResponse::Ptr& response);
+  void debounce_event(const EventResponse::Ptr& response);
+  void on_debounce(Timer* timer);
+
   // Connection listener methods
   virtual void on_close(Connection* connection);
   virtual void on_event(const EventResponse::Ptr& response);
@@ -299,6 +352,8 @@ private:
   VersionNumber dse_server_version_;
   ListenAddressMap listen_addresses_;
   ControlConnectionListener* listener_;
+  EventResponse::Vec pending_events_;
+  Timer debounce_timer_;
 };
 
 }}} // namespace datastax::internal::core
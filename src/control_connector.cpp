@@ -80,6 +80,61 @@ private:
 
 }}} // namespace datastax::internal::core
 
+void ControlConnectionSchema::set(const ChainedRequestCallback* callback) {
+  keyspaces = callback->result("keyspaces");
+  tables = callback->result("tables");
+  views = callback->result("views");
+  columns = callback->result("columns");
+  indexes = callback->result("indexes");
+  user_types = callback->result("user_types");
+  functions = callback->result("functions");
+  aggregates = callback->result("aggregates");
+  virtual_keyspaces = callback->result("virtual_keyspaces");
+  virtual_tables = callback->result("virtual_tables");
+  virtual_columns = callback->result("virtual_columns");
+}
+
+ChainedRequestCallback::Ptr
+ControlConnector::chain_schema_queries(const ChainedRequestCallback::Ptr& callback,
+                                       const VersionNumber& server_version,
+                                       const ControlConnectionSettings& settings) {
+  ChainedRequestCallback::Ptr chain(callback);
+  String where(settings.schema_keyspace_restriction());
+
+  if (server_version >= VersionNumber(3, 0, 0)) {
+    chain = chain->chain("tables", SELECT_TABLES_30 + where)
+                ->chain("views", SELECT_VIEWS_30 + where)
+                ->chain("columns", SELECT_COLUMNS_30 + where)
+                ->chain("indexes", SELECT_INDEXES_30 + where)
+                ->chain("user_types", SELECT_USERTYPES_30 + where)
+                ->chain("functions", SELECT_FUNCTIONS_30 + where)
+                ->chain("aggregates", SELECT_AGGREGATES_30 + where);
+
+    if (server_version >= VersionNumber(4, 0, 0)) {
+      chain = chain->chain("virtual_keyspaces", SELECT_VIRTUAL_KEYSPACES_40)
+                  ->chain("virtual_tables", SELECT_VIRTUAL_TABLES_40)
+                  ->chain("virtual_columns", SELECT_VIRTUAL_COLUMNS_40);
+    }
+  } else {
+    chain = chain->chain("tables", SELECT_COLUMN_FAMILIES_20 + where)
+                ->chain("columns", SELECT_COLUMNS_20 + where);
+
+    if (server_version >= VersionNumber(2, 1, 0)) {
+      chain = chain->chain("user_types", SELECT_USERTYPES_21 + where);
+    }
+    if (server_version >= VersionNumber(2, 2, 0)) {
+      chain = chain->chain("functions", SELECT_FUNCTIONS_22 + where)
+                  ->chain("aggregates", SELECT_AGGREGATES_22 + where);
+    }
+  }
+
+  return chain;
+}
+
+const char* ControlConnector::keyspaces_query(const VersionNumber& server_version) {
+  return server_version >= VersionNumber(3, 0, 0) ? SELECT_KEYSPACES_30 : SELECT_KEYSPACES_20;
+}
+
 ControlConnector* ControlConnector::with_listener(ControlConnectionListener* listener) {
   listener_ = listener;
   return this;
@@ -95,8 +150,21 @@ ControlConnector* ControlConnector::with_settings(const ControlConnectionSetting
   return this;
 }
 
+ControlConnector* ControlConnector::with_schema_version(const String& schema_version,
+                                                        const VersionNumber& server_version) {
+  known_schema_version_ = schema_version;
+  known_server_version_ = server_version;
+  return this;
+}
+
+ControlConnector* ControlConnector::with_deferred_schema(bool is_deferred) {
+  is_schema_deferred_ = is_deferred;
+  return this;
+}
+
 void ControlConnector::connect(uv_loop_t* loop) {
   inc_ref();
+  step_start_time_ = uv_hrtime();
   int event_types = 0;
   if (settings_.use_schema || settings_.use_token_aware_routing) {
     event_types = CASS_EVENT_TOPOLOGY_CHANGE | CASS_EVENT_STATUS_CHANGE | CASS_EVENT_SCHEMA_CHANGE;
@@ -172,6 +240,7 @@ void ControlConnector::on_error(ControlConnector::ControlConnectionError code,
 void ControlConnector::on_connect(Connector* connector) {
   if (!is_canceled() && connector->is_ok()) {
     connection_ = connector->release_connection();
+    timings_.control_connection = uv_hrtime() - step_start_time_;
 
     // It's important to record any events that happen while querying the hosts
     // and schema. The recorded events are replayed after the initial hosts
@@ -193,6 +262,7 @@ void ControlConnector::query_hosts() {
   // This needs to happen before other schema metadata queries so that we have
   // a valid server version because this version determines which follow up
   // schema metadata queries are executed.
+  step_start_time_ = uv_hrtime();
   ChainedRequestCallback::Ptr callback(
       new HostsConnectorRequestCallback("local", SELECT_LOCAL, this));
   callback = callback->chain("peers", SELECT_PEERS);
@@ -203,13 +273,20 @@ void ControlConnector::query_hosts() {
 }
 
 void ControlConnector::handle_query_hosts(HostsConnectorRequestCallback* callback) {
+  timings_.hosts_query = uv_hrtime() - step_start_time_;
   ResultResponse::Ptr local_result(callback->result("local"));
   const Host::Ptr& connected_host = connection_->host();
   if (local_result && local_result->row_count() > 0) {
-    connected_host->set(&local_result->first_row(), settings_.use_token_aware_routing);
+    const Row* row = &local_result->first_row();
+    connected_host->set(row, settings_.use_token_aware_routing);
     hosts_[connected_host->address()] = connected_host;
     server_version_ = connected_host->server_version();
     dse_server_version_ = connected_host->dse_server_version();
+
+    const Value* v = row->get_by_name("schema_version");
+    if (v && !v->is_null()) {
+      schema_.version = v->to_string();
+    }
   } else {
     on_error(CONTROL_CONNECTION_ERROR_HOSTS,
              "No row found in " + connection_->address_string() + "'s local system table");
@@ -231,7 +308,17 @@ void ControlConnector::handle_query_hosts(HostsConnectorRequestCallback* callbac
     }
   }
 
-  if (settings_.use_token_aware_routing || settings_.use_schema) {
+  // The schema only needs to be rebuilt when it has diverged from the caller's
+  // existing metadata. Changes that happen after this point are recorded as
+  // events and replayed incrementally.
+  if (settings_.use_schema && !schema_.version.empty() &&
+      schema_.version == known_schema_version_ && server_version_.compare(known_server_version_) == 0) {
+    LOG_DEBUG("Schema version is unchanged on host %s. Skipping the full schema refresh",
+              connection_->address_string().c_str());
+    schema_.is_unchanged = true;
+  }
+
+  if (settings_.use_token_aware_routing || (settings_.use_schema && !schema_.is_unchanged)) {
     query_schema();
   } else {
     // If we're not using token aware routing or schema we can just finish.
@@ -240,40 +327,16 @@ void ControlConnector::handle_query_hosts(HostsConnectorRequestCallback* callbac
 }
 
 void ControlConnector::query_schema() {
-  ChainedRequestCallback::Ptr callback;
-
-  if (server_version_ >= VersionNumber(3, 0, 0)) {
-    callback = ChainedRequestCallback::Ptr(
-        new SchemaConnectorRequestCallback("keyspaces", SELECT_KEYSPACES_30, this));
-    if (settings_.use_schema) {
-      callback = callback->chain("tables", SELECT_TABLES_30)
-                     ->chain("views", SELECT_VIEWS_30)
-                     ->chain("columns", SELECT_COLUMNS_30)
-                     ->chain("indexes", SELECT_INDEXES_30)
-                     ->chain("user_types", SELECT_USERTYPES_30)
-                     ->chain("functions", SELECT_FUNCTIONS_30)
-                     ->chain("aggregates", SELECT_AGGREGATES_30);
-
-      if (server_version_ >= VersionNumber(4, 0, 0)) {
-        callback = callback->chain("virtual_keyspaces", SELECT_VIRTUAL_KEYSPACES_40)
-                       ->chain("virtual_tables", SELECT_VIRTUAL_TABLES_40)
-                       ->chain("virtual_columns", SELECT_VIRTUAL_COLUMNS_40);
-      }
-    }
-  } else {
-    callback = ChainedRequestCallback::Ptr(
-        new SchemaConnectorRequestCallback("keyspaces", SELECT_KEYSPACES_20, this));
-    if (settings_.use_schema) {
-      callback =
-          callback->chain("tables", SELECT_COLUMN_FAMILIES_20)->chain("columns", SELECT_COLUMNS_20);
-
-      if (server_version_ >= VersionNumber(2, 1, 0)) {
-        callback = callback->chain("user_types", SELECT_USERTYPES_21);
-      }
-      if (server_version_ >= VersionNumber(2, 2, 0)) {
-        callback = callback->chain("functions", SELECT_FUNCTIONS_22)
-                       ->chain("aggregates", SELECT_AGGREGATES_22);
-      }
+  // The keyspaces are always queried because they're needed for the token map
+  step_start_time_ = uv_hrtime();
+  ChainedRequestCallback::Ptr callback(
+      new SchemaConnectorRequestCallback("keyspaces", keyspaces_query(server_version_), this));
+
+  if (settings_.use_schema && !schema_.is_unchanged) {
+    if (is_schema_deferred_) {
+      schema_.is_deferred = true;
+    } else {
+      callback = chain_schema_queries(callback, server_version_, settings_);
     }
   }
 
@@ -283,18 +346,8 @@ void ControlConnector::query_schema() {
 }
 
 void ControlConnector::handle_query_schema(SchemaConnectorRequestCallback* callback) {
-  schema_.keyspaces = callback->result("keyspaces");
-  schema_.tables = callback->result("tables");
-  schema_.views = callback->result("views");
-  schema_.columns = callback->result("columns");
-  schema_.indexes = callback->result("indexes");
-  schema_.user_types = callback->result("user_types");
-  schema_.functions = callback->result("functions");
-  schema_.aggregates = callback->result("aggregates");
-  schema_.virtual_keyspaces = callback->result("virtual_keyspaces");
-  schema_.virtual_tables = callback->result("virtual_tables");
-  schema_.virtual_columns = callback->result("virtual_columns");
-
+  timings_.schema_query = uv_hrtime() - step_start_time_;
+  schema_.set(callback);
   on_success();
 }
 
@@ -28,11 +28,65 @@ class HostsConnectorRequestCallback;
 class Metrics;
 class SchemaConnectorRequestCallback;
 
+/**
+ * The time spent in each step of the startup process in nanoseconds. The
+ * control connector records the control connection steps, the rest are
+ * recorded by the cluster connector and the session.
+ */
+struct StartupTimings {
+  StartupTimings()
+      : resolve(0)
+      , control_connection(0)
+      , hosts_query(0)
+      , schema_query(0)
+      , metadata(0)
+      , connection_pools(0)
+      , total(0) {}
+
+  uint64_t resolve;
+  uint64_t control_connection;
+  uint64_t hosts_query;
+  uint64_t schema_query;
+  uint64_t metadata;
+  uint64_t connection_pools;
+  uint64_t total;
+};
+
 /**
  * The initial schema metadata retrieved from the cluster when the control
  * connection is established.
  */
 struct ControlConnectionSchema {
+  ControlConnectionSchema()
+      : is_unchanged(false)
+      , is_deferred(false) {}
+
+  /**
+   * Set the schema results from a chained schema request.
+   *
+   * @param callback A chained request started with the "keyspaces" query and
+   * followed by the queries from `ControlConnector::chain_schema_queries()`.
+   */
+  void set(const ChainedRequestCallback* callback);
+
+  /**
+   * The connected host's schema version (raw UUID bytes). This is empty if
+   * the host didn't report a schema version.
+   */
+  String version;
+
+  /**
+   * True if the schema version matched the version of the caller's existing
+   * metadata. Only the keyspaces are queried (for the token map) in that case.
+   */
+  bool is_unchanged;
+
+  /**
+   * True if only the keyspaces were queried because the rest of the schema is
+   * queried by the caller after the control connection is established.
+   */
+  bool is_deferred;
+
   ResultResponse::Ptr keyspaces;
   ResultResponse::Ptr tables;
   ResultResponse::Ptr views;
@@ -105,6 +159,29 @@ public:
    */
   ControlConnector* with_settings(const ControlConnectionSettings& settings);
 
+  /**
+   * Sets the schema version of the caller's existing schema metadata. If the
+   * connected host reports the same schema version (and server version) then
+   * the full schema isn't queried and the schema is marked as unchanged.
+   *
+   * @param schema_version The schema version of the existing metadata.
+   * @param server_version The server version the existing metadata was built
+   * with.
+   * @return The connector to chain calls.
+   */
+  ControlConnector* with_schema_version(const String& schema_version,
+                                        const VersionNumber& server_version);
+
+  /**
+   * Only query the keyspaces (needed for the token map) during the connection
+   * process and mark the schema as deferred. The caller is responsible for
+   * querying the rest of the schema.
+   *
+   * @param is_deferred If true the schema is deferred.
+   * @return The connector to chain calls.
+   */
+  ControlConnector* with_deferred_schema(bool is_deferred);
+
   /**
    * Start the connection process.
    *
@@ -148,6 +225,37 @@ public:
    */
   const ControlConnectionSchema& schema() const { return schema_; }
 
+  /**
+   * The time spent connecting the control connection and running the host
+   * and schema queries.
+   *
+   * @return
+   */
+  const StartupTimings& timings() const { return timings_; }
+
+public:
+  /**
+   * Chain the schema queries, other than the keyspaces query, for a server
+   * version.
+   *
+   * @param callback The chained request to add the queries to.
+   * @param server_version The server version of the connected host.
+   * @param settings The control connection settings (for the keyspace filter).
+   * @return The last request in the chain.
+   */
+  static ChainedRequestCallback::Ptr
+  chain_schema_queries(const ChainedRequestCallback::Ptr& callback,
+                       const VersionNumber& server_version,
+                       const ControlConnectionSettings& settings);
+
+  /**
+   * Gets the keyspaces query for a server version.
+   *
+   * @param server_version The server version of the connected host.
+   * @return The query.
+   */
+  static const char* keyspaces_query(const VersionNumber& server_version);
+
 public:
   const Address& address() const { return connector_->address(); }
 
@@ -212,6 +320,11 @@ private:
    */
   ListenAddressMap listen_addresses_;
   ControlConnectionSchema schema_;
+  String known_schema_version_;
+  VersionNumber known_server_version_;
+  bool is_schema_deferred_;
+  StartupTimings timings_;
+  uint64_t step_start_time_;
 
   Callback callback_;
 
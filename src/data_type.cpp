@@ -18,6 +18,7 @@
 
 #include "collection.hpp"
 #include "external.hpp"
+#include "struct_encoder.hpp"
 #include "tuple.hpp"
 #include "types.hpp"
 #include "user_type_value.hpp"
@@ -26,6 +27,7 @@
 #include <string.h>
 
 using namespace datastax;
+using namespace datastax::internal;
 using namespace datastax::internal::core;
 
 extern "C" {
@@ -353,6 +355,9 @@ DataType::ConstPtr DataType::create_by_cql(StringRef name) {
 ValueTypes::HashMap ValueTypes::value_types_by_class_;
 ValueTypes::HashMap ValueTypes::value_types_by_cql_;
 
+// The shared simple data types, indexed by value type
+static DataType::ConstPtr simple_data_types__[CASS_VALUE_TYPE_LAST_ENTRY];
+
 static ValueTypes __value_types__; // Initializer
 
 ValueTypes::ValueTypes() {
@@ -361,7 +366,8 @@ ValueTypes::ValueTypes() {
 
 #define XX_VALUE_TYPE(name, type, cql, klass)                     \
   if (sizeof(klass) - 1 > 0) value_types_by_class_[klass] = name; \
-  if (sizeof(cql) - 1 > 0) value_types_by_cql_[cql] = name;
+  if (sizeof(cql) - 1 > 0) value_types_by_cql_[cql] = name;       \
+  simple_data_types__[name] = DataType::ConstPtr(new DataType(name));
 
   CASS_VALUE_TYPE_MAPPING(XX_VALUE_TYPE)
 #undef XX_VALUE_TYPE
@@ -390,11 +396,51 @@ const DataType::ConstPtr& SimpleDataTypeCache::by_value_type(uint16_t value_type
       value_type == CASS_VALUE_TYPE_TUPLE || value_type >= CASS_VALUE_TYPE_LAST_ENTRY) {
     return DataType::NIL;
   }
-  DataType::ConstPtr& data_type = cache_[value_type];
-  if (!data_type) {
-    data_type = DataType::ConstPtr(new DataType(static_cast<CassValueType>(value_type)));
+  return simple_data_types__[value_type];
+}
+
+// Bounds the memory used by applications that create many distinct types
+#define DATA_TYPE_CACHE_MAX_ENTRIES 4096
+
+Spinlock DataTypeCache::lock_;
+DataTypeCache::HashMap DataTypeCache::data_types_;
+Vector<String*> DataTypeCache::keys_;
+
+static DataTypeCache __data_type_cache__; // Initializer
+
+DataTypeCache::DataTypeCache() { data_types_.set_empty_key(StringRef()); }
+
+DataTypeCache::~DataTypeCache() {
+  data_types_.clear();
+  for (Vector<String*>::iterator it = keys_.begin(), end = keys_.end(); it != end; ++it) {
+    delete *it;
+  }
+  keys_.clear();
+}
+
+DataType::ConstPtr DataTypeCache::get(StringRef encoded) {
+  ScopedSpinlock l(&lock_);
+  HashMap::const_iterator it = data_types_.find(encoded);
+  if (it == data_types_.end()) {
+    return DataType::NIL;
+  }
+  return it->second;
+}
+
+void DataTypeCache::put(StringRef encoded, const DataType::ConstPtr& data_type) {
+  ScopedSpinlock l(&lock_);
+  if (data_types_.size() >= DATA_TYPE_CACHE_MAX_ENTRIES ||
+      data_types_.find(encoded) != data_types_.end()) {
+    return;
   }
-  return data_type;
+  String* key = new String(encoded.data(), encoded.size());
+  keys_.push_back(key);
+  data_types_[StringRef(*key)] = data_type;
+}
+
+size_t DataTypeCache::size() {
+  ScopedSpinlock l(&lock_);
+  return data_types_.size();
 }
 
 bool IsValidDataType<const Collection*>::operator()(const Collection* value,
@@ -411,3 +457,8 @@ bool IsValidDataType<const UserTypeValue*>::operator()(const UserTypeValue* valu
                                                        const DataType::ConstPtr& data_type) const {
   return value->data_type()->equals(data_type);
 }
+
+bool IsValidDataType<CassStruct>::operator()(CassStruct value,
+                                             const DataType::ConstPtr& data_type) const {
+  return value.encoder->data_type()->equals(data_type);
+}
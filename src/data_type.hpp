@@ -18,13 +18,16 @@
 #define DATASTAX_INTERNAL_DATA_TYPE_HPP
 
 #include "cassandra.h"
+#include "dense_hash_map.hpp"
 #include "external.hpp"
 #include "hash_table.hpp"
 #include "macros.hpp"
 #include "map.hpp"
 #include "ref_counted.hpp"
 #include "small_dense_hash_map.hpp"
+#include "spin_lock.hpp"
 #include "string.hpp"
+#include "string_ref.hpp"
 #include "types.hpp"
 #include "vector.hpp"
 
@@ -140,6 +143,7 @@ public:
 
   virtual bool equals(const DataType::ConstPtr& data_type) const {
     assert(value_type() == CASS_VALUE_TYPE_CUSTOM);
+    if (data_type.get() == this) return true; // Interned types
     if (data_type->value_type() != CASS_VALUE_TYPE_CUSTOM) {
       return false;
     }
@@ -206,6 +210,7 @@ public:
   virtual bool equals(const DataType::ConstPtr& data_type) const {
     assert(value_type() == CASS_VALUE_TYPE_LIST || value_type() == CASS_VALUE_TYPE_SET ||
            value_type() == CASS_VALUE_TYPE_MAP || value_type() == CASS_VALUE_TYPE_TUPLE);
+    if (data_type.get() == this) return true; // Interned types
 
     if (value_type() != data_type->value_type()) {
       return false;
@@ -266,6 +271,7 @@ public:
 
   virtual bool equals(const DataType::ConstPtr& data_type) const {
     assert(value_type() == CASS_VALUE_TYPE_TUPLE);
+    if (data_type.get() == this) return true; // Interned types
 
     if (value_type() != data_type->value_type()) {
       return false;
@@ -351,6 +357,7 @@ public:
 
   virtual bool equals(const DataType::ConstPtr& data_type) const {
     assert(value_type() == CASS_VALUE_TYPE_UDT);
+    if (data_type.get() == this) return true; // Interned types
     if (data_type->value_type() != CASS_VALUE_TYPE_UDT) {
       return false;
     }
@@ -414,6 +421,8 @@ private:
   static HashMap value_types_by_cql_;
 };
 
+// The simple (non-composite) data types are immutable so a single instance
+// of each is shared by all the caches.
 class SimpleDataTypeCache {
 public:
   const DataType::ConstPtr& by_class(StringRef name) {
@@ -425,9 +434,45 @@ public:
   }
 
   const DataType::ConstPtr& by_value_type(uint16_t value_type);
+};
+
+/**
+ * A global cache of the composite and custom data types decoded from result
+ * metadata. The types are interned by their encoding in the native protocol
+ * (an [option]), which includes the nested types, so that the results of the
+ * same queries share immutable instances and decoding the metadata of a
+ * known type doesn't allocate. Comparing interned types is a pointer
+ * comparison. The cache is shared by all the sessions so it's thread-safe.
+ */
+class DataTypeCache {
+public:
+  DataTypeCache();
+  ~DataTypeCache();
+
+  /**
+   * Get an interned data type.
+   *
+   * @param encoded The encoded data type.
+   * @return The data type or DataType::NIL if it's not cached.
+   */
+  static DataType::ConstPtr get(StringRef encoded);
+
+  /**
+   * Intern a data type. Nothing is cached once the cache is full.
+   *
+   * @param encoded The encoded data type.
+   * @param data_type The data type. It must not be modified afterwards.
+   */
+  static void put(StringRef encoded, const DataType::ConstPtr& data_type);
+
+  static size_t size();
 
 private:
-  DataType::ConstPtr cache_[CASS_VALUE_TYPE_LAST_ENTRY];
+  typedef DenseHashMap<StringRef, DataType::ConstPtr, StringRefHash> HashMap;
+
+  static Spinlock lock_;
+  static HashMap data_types_;
+  static Vector<String*> keys_; // The memory of the map's keys
 };
 
 template <class T>
@@ -509,6 +554,20 @@ struct IsValidDataType<CassBytes> {
   }
 };
 
+template <>
+struct IsValidDataType<CassStringRef> {
+  bool operator()(CassStringRef, const DataType::ConstPtr& data_type) const {
+    return is_string_type(data_type->value_type()) || is_bytes_type(data_type->value_type());
+  }
+};
+
+template <>
+struct IsValidDataType<CassBytesRef> {
+  bool operator()(CassBytesRef, const DataType::ConstPtr& data_type) const {
+    return is_bytes_type(data_type->value_type());
+  }
+};
+
 template <>
 struct IsValidDataType<CassCustom> {
   bool operator()(const CassCustom& custom, const DataType::ConstPtr& data_type) const {
@@ -561,6 +620,11 @@ struct IsValidDataType<const UserTypeValue*> {
   bool operator()(const UserTypeValue* value, const DataType::ConstPtr& data_type) const;
 };
 
+template <>
+struct IsValidDataType<CassStruct> {
+  bool operator()(CassStruct value, const DataType::ConstPtr& data_type) const;
+};
+
 }}} // namespace datastax::internal::core
 
 EXTERNAL_TYPE(datastax::internal::core::DataType, CassDataType)
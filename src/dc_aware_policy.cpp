@@ -87,7 +87,7 @@ QueryPlan* DCAwarePolicy::new_query_plan(const String& keyspace, RequestHandler*
                                          const TokenMap* token_map) {
   CassConsistency cl =
       request_handler != NULL ? request_handler->consistency() : CASS_DEFAULT_CONSISTENCY;
-  return new DCAwareQueryPlan(this, cl, index_++);
+  return new (request_handler) DCAwareQueryPlan(this, cl, index_++);
 }
 
 bool DCAwarePolicy::is_host_up(const Address& address) const {
@@ -223,7 +223,7 @@ DCAwarePolicy::DCAwareQueryPlan::DCAwareQueryPlan(const DCAwarePolicy* policy, C
     , remote_remaining_(0)
     , index_(start_index) {}
 
-Host::Ptr DCAwarePolicy::DCAwareQueryPlan::compute_next() {
+const Host::Ptr& DCAwarePolicy::DCAwareQueryPlan::compute_next() {
   while (local_remaining_ > 0) {
     --local_remaining_;
     const Host::Ptr& host(get_next_host(hosts_, index_++));
@@ -233,7 +233,12 @@ Host::Ptr DCAwarePolicy::DCAwareQueryPlan::compute_next() {
   }
 
   if (policy_->skip_remote_dcs_for_local_cl_ && is_dc_local(cl_)) {
-    return Host::Ptr();
+    return NO_HOST;
+  }
+
+  // Avoid copying the remote datacenters when none of their hosts can be used
+  if (policy_->used_hosts_per_remote_dc_ == 0) {
+    return NO_HOST;
   }
 
   if (!remote_dcs_) {
@@ -261,5 +266,5 @@ Host::Ptr DCAwarePolicy::DCAwareQueryPlan::compute_next() {
     remote_dcs_->erase(i);
   }
 
-  return Host::Ptr();
+  return NO_HOST;
 }
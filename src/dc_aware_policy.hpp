@@ -94,7 +94,7 @@ public:
   public:
     DCAwareQueryPlan(const DCAwarePolicy* policy, CassConsistency cl, size_t start_index);
 
-    virtual Host::Ptr compute_next();
+    virtual const Host::Ptr& compute_next();
 
   private:
     const DCAwarePolicy* policy_;
@@ -29,7 +29,7 @@
 using namespace datastax::internal::core;
 
 void Decoder::maybe_log_remaining() const {
-  if (remaining_ > 0) {
+  if (remaining_ > 0 && !is_quiet_) {
     LOG_TRACE("Data remaining in %s response: %u", type_, static_cast<unsigned int>(remaining_));
   }
 }
@@ -174,6 +174,7 @@ bool Decoder::update_value(Value& value) {
 }
 
 void Decoder::notify_error(const char* detail, size_t bytes) const {
+  if (is_quiet_) return;
   if (strlen(type_) == 0) {
     LOG_ERROR("Expected at least %u byte%s to decode %s value", static_cast<unsigned int>(bytes),
               (bytes > 1 ? "s" : ""), detail);
@@ -65,7 +65,8 @@ public:
       : input_(NULL)
       , length_(0)
       , remaining_(0)
-      , type_("") {}
+      , type_("")
+      , is_quiet_(false) {}
 
   Decoder(const char* input, size_t length,
           ProtocolVersion protocol_version = ProtocolVersion::highest_supported())
@@ -73,7 +74,8 @@ public:
       , input_(input)
       , length_(length)
       , remaining_(length)
-      , type_("") {}
+      , type_("")
+      , is_quiet_(false) {}
 
   void maybe_log_remaining() const;
 
@@ -91,6 +93,10 @@ public:
 
   inline void set_type(const char* type) { type_ = type; }
 
+  // Don't log decoding errors. This is used to decode data that might not
+  // have been completely received yet.
+  inline void set_quiet(bool is_quiet) { is_quiet_ = is_quiet; }
+
   inline bool decode_byte(uint8_t& output) {
     CHECK_REMAINING(sizeof(uint8_t), "byte");
 
@@ -443,38 +449,13 @@ public:
   inline bool decode_vint(uint64_t& output) {
     CHECK_REMAINING(sizeof(uint8_t), "vint extra bytes");
 
-    uint8_t first_byte = *input_++;
-    remaining_ -= sizeof(uint8_t);
-
-    if (first_byte <= 127) {
-      // If this is a multibyte vint, at least the MSB of the first byte
-      // will be set. Since that's not the case, this is a one-byte value.
-      output = first_byte;
-    } else {
-      // The number of consecutive most significant bits of the first-byte tell us how
-      // many additional bytes are in this vint. Count them like this:
-      // 1. Invert the firstByte so that all leading 1s become 0s.
-      // 2. Count the number of leading zeros; num_leading_zeros assumes a 64-bit long.
-      // 3. We care about leading 0s in the byte, not int, so subtract out the
-      //    appropriate number of extra bits (56 for a 64-bit int).
-
-      // We mask out high-order bits to prevent sign-extension as the value is placed in a 64-bit
-      // arg to the num_leading_zeros function.
-      int extra_bytes = internal::num_leading_zeros(~first_byte & 0xff) - 56;
-      CHECK_REMAINING(extra_bytes, "vint value");
-
-      // Build up the vint value one byte at a time from the data bytes.
-      // The firstByte contains size as well as the most significant bits of
-      // the value. Extract just the value.
-      output = first_byte & (0xff >> extra_bytes);
-      for (int i = 0; i < extra_bytes; ++i) {
-        uint8_t vint_byte = *input_++;
-        output <<= 8;
-        output |= vint_byte & 0xff;
-      }
-      remaining_ -= extra_bytes;
+    const char* pos = internal::decode_vint(input_, remaining_, output);
+    if (pos == NULL) {
+      notify_error("vint value", internal::vint_extra_bytes(static_cast<uint8_t>(*input_)) + 1);
+      return false;
     }
-
+    remaining_ -= pos - input_;
+    input_ = pos;
     return true;
   }
 
@@ -575,6 +556,7 @@ private:
   size_t length_;
   size_t remaining_;
   const char* type_;
+  bool is_quiet_;
 
   void notify_error(const char* detail, size_t bytes) const;
 };
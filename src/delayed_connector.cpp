@@ -18,6 +18,10 @@
 
 #include "event_loop.hpp"
 
+// The delay before retrying a connection attempt that's over the host's limit
+// of attempts in progress
+#define CONNECT_ATTEMPT_RETRY_DELAY_MS 50
+
 using namespace datastax;
 using namespace datastax::internal::core;
 
@@ -26,7 +30,8 @@ DelayedConnector::DelayedConnector(const Host::Ptr& host, ProtocolVersion protoc
     : connector_(
           new Connector(host, protocol_version, bind_callback(&DelayedConnector::on_connect, this)))
     , callback_(callback)
-    , is_canceled_(false) {}
+    , is_canceled_(false)
+    , is_attempt_started_(false) {}
 
 DelayedConnector* DelayedConnector::with_keyspace(const String& keyspace) {
   connector_->with_keyspace(keyspace);
@@ -43,6 +48,17 @@ DelayedConnector* DelayedConnector::with_settings(const ConnectionSettings& sett
   return this;
 }
 
+DelayedConnector* DelayedConnector::with_shard_aware_port(int port, int local_port) {
+  connector_->with_shard_aware_port(port, local_port);
+  return this;
+}
+
+DelayedConnector*
+DelayedConnector::with_reconnect_throttle(const ReconnectThrottle::Ptr& reconnect_throttle) {
+  reconnect_throttle_ = reconnect_throttle;
+  return this;
+}
+
 void DelayedConnector::delayed_connect(uv_loop_t* loop, uint64_t wait_time_ms) {
   inc_ref();
   if (wait_time_ms > 0) {
@@ -55,8 +71,9 @@ void DelayedConnector::delayed_connect(uv_loop_t* loop, uint64_t wait_time_ms) {
 
 void DelayedConnector::attempt_immediate_connect() {
   if (delayed_connect_timer_.is_running() && !is_canceled_) {
-    internal_connect(delayed_connect_timer_.loop());
-    delayed_connect_timer_.stop();
+    uv_loop_t* loop = delayed_connect_timer_.loop();
+    delayed_connect_timer_.stop(); // Stopped first because the attempt can be delayed again
+    internal_connect(loop);
   }
 }
 
@@ -92,9 +109,23 @@ Connector::ConnectionError DelayedConnector::error_code() const {
   return connector_->error_code();
 }
 
-void DelayedConnector::internal_connect(uv_loop_t* loop) { connector_->connect(loop); }
+void DelayedConnector::internal_connect(uv_loop_t* loop) {
+  if (reconnect_throttle_) {
+    if (!reconnect_throttle_->try_start_connect_attempt(connector_->host().get())) {
+      delayed_connect_timer_.start(loop, CONNECT_ATTEMPT_RETRY_DELAY_MS,
+                                   bind_callback(&DelayedConnector::on_delayed_connect, this));
+      return;
+    }
+    is_attempt_started_ = true;
+  }
+  connector_->connect(loop);
+}
 
 void DelayedConnector::on_connect(Connector* connector) {
+  if (is_attempt_started_) {
+    reconnect_throttle_->finish_connect_attempt(connector_->host().get());
+    is_attempt_started_ = false;
+  }
   callback_(this);
   dec_ref();
 }
@@ -20,6 +20,7 @@
 #include "callback.hpp"
 #include "connector.hpp"
 #include "host.hpp"
+#include "reconnect_throttle.hpp"
 #include "ref_counted.hpp"
 #include "string.hpp"
 #include "vector.hpp"
@@ -74,6 +75,24 @@ public:
    */
   DelayedConnector* with_settings(const ConnectionSettings& settings);
 
+  /**
+   * Same as Connector::with_shard_aware_port()
+   *
+   * @param port
+   * @param local_port
+   * @return
+   */
+  DelayedConnector* with_shard_aware_port(int port, int local_port);
+
+  /**
+   * Set the throttle that limits the connection attempts in progress to the
+   * host. An attempt that's over the limit is retried after a short delay.
+   *
+   * @param reconnect_throttle The throttle or NULL for no limit.
+   * @return The delayed connector to chain calls.
+   */
+  DelayedConnector* with_reconnect_throttle(const ReconnectThrottle::Ptr& reconnect_throttle);
+
   /**
    * Connect to a host after a delay.
    *
@@ -125,6 +144,8 @@ private:
 
   Timer delayed_connect_timer_;
   bool is_canceled_;
+  ReconnectThrottle::Ptr reconnect_throttle_;
+  bool is_attempt_started_;
 };
 
 }}} // namespace datastax::internal::core
@@ -115,4 +115,78 @@ Bytes encode_date_range(const DseDateRange* range) {
   return bytes;
 }
 
+CassError decode_date_range(const char* pos, size_t size, DseDateRange* range) {
+  size_t expected_size = 0;
+  const char* end = NULL;
+  DateRangeBoundType range_type;
+  DseDateRangeBound* first_bound = NULL;
+  int8_t decoded_byte = 0;
+
+  if (size == 0) {
+    return CASS_ERROR_LIB_NOT_ENOUGH_DATA;
+  }
+
+  end = pos + size;
+
+  // The format of the data is <type int8>[<from_time int64><from_precision int8>[<to_time
+  // int64><to_precision int8>]] Depending on the type of range, we may have a subset of the
+  // remaining fields. This translates to having 0, 1, or 2 bounds. If we have one bound, it may be
+  // an upper or lower bound.
+
+  range_type = static_cast<DateRangeBoundType>(*pos++);
+
+  range->is_single_date =
+      static_cast<cass_bool_t>(range_type == DATE_RANGE_BOUND_TYPE_SINGLE_DATE ||
+                               range_type == DATE_RANGE_BOUND_TYPE_SINGLE_DATE_OPEN);
+  range->lower_bound = dse_date_range_bound_unbounded();
+  range->upper_bound = dse_date_range_bound_unbounded();
+
+  switch (range_type) {
+    case DATE_RANGE_BOUND_TYPE_BOTH_OPEN_RANGE:
+    case DATE_RANGE_BOUND_TYPE_SINGLE_DATE_OPEN:
+      expected_size = sizeof(int8_t);
+      break;
+    case DATE_RANGE_BOUND_TYPE_SINGLE_DATE:
+    case DATE_RANGE_BOUND_TYPE_OPEN_RANGE_HIGH:
+    case DATE_RANGE_BOUND_TYPE_OPEN_RANGE_LOW:
+      // type, from_time, from_precision
+      expected_size = sizeof(int8_t) + sizeof(int64_t) + sizeof(int8_t);
+      first_bound = (range_type == DATE_RANGE_BOUND_TYPE_OPEN_RANGE_LOW) ? &(range->upper_bound)
+                                                                         : &(range->lower_bound);
+      break;
+    case DATE_RANGE_BOUND_TYPE_CLOSED_RANGE:
+      // type, from_time, from_precision, to_time, to_precision
+      expected_size =
+          sizeof(int8_t) + sizeof(int64_t) + sizeof(int8_t) + sizeof(int64_t) + sizeof(int8_t);
+      first_bound = &(range->lower_bound);
+      break;
+    default:
+      return CASS_ERROR_LIB_INVALID_DATA;
+  }
+
+  if (size < expected_size) {
+    return CASS_ERROR_LIB_NOT_ENOUGH_DATA;
+  }
+
+  if (pos == end) {
+    return CASS_OK;
+  }
+
+  // We have at least one bound; write to the attribute that was chosen earlier.
+  pos = decode_int64(const_cast<char*>(pos), first_bound->time_ms);
+  pos = decode_int8(const_cast<char*>(pos), decoded_byte);
+  first_bound->precision = static_cast<DseDateRangePrecision>(decoded_byte);
+
+  if (pos == end) {
+    return CASS_OK;
+  }
+
+  // This is the second bound; must be upper.
+  pos = decode_int64(const_cast<char*>(pos), range->upper_bound.time_ms);
+  decode_int8(const_cast<char*>(pos), decoded_byte);
+  range->upper_bound.precision = static_cast<DseDateRangePrecision>(decoded_byte);
+
+  return CASS_OK;
+}
+
 }}} // namespace datastax::internal::enterprise
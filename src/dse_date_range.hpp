@@ -23,6 +23,8 @@ namespace datastax { namespace internal { namespace enterprise {
 
 Bytes encode_date_range(const DseDateRange* range);
 
+CassError decode_date_range(const char* pos, size_t size, DseDateRange* range);
+
 }}} // namespace datastax::internal::enterprise
 
 #endif
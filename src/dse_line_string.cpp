@@ -44,6 +44,12 @@ CassError dse_line_string_add_point(DseLineString* line_string, cass_double_t x,
   return CASS_OK;
 }
 
+CassError dse_line_string_add_points(DseLineString* line_string, const cass_double_t* points,
+                                     size_t num_points) {
+  line_string->add_points(points, num_points);
+  return CASS_OK;
+}
+
 CassError dse_line_string_finish(DseLineString* line_string) { return line_string->finish(); }
 
 DseLineStringIterator* dse_line_string_iterator_new() {
@@ -75,6 +81,11 @@ CassError dse_line_string_iterator_next_point(DseLineStringIterator* iterator, c
   return iterator->next_point(x, y);
 }
 
+CassError dse_line_string_iterator_next_points(DseLineStringIterator* iterator,
+                                               cass_double_t* points, size_t num_points) {
+  return iterator->next_points(points, num_points);
+}
+
 } // extern "C"
 
 String LineString::to_wkt() const {
@@ -125,7 +136,7 @@ CassError LineStringIterator::reset_binary(const CassValue* value) {
   num_points = decode_uint32(pos, byte_order);
   pos += sizeof(cass_uint32_t);
 
-  if (size < 2 * num_points * sizeof(cass_double_t)) {
+  if (num_points > size / (2 * sizeof(cass_double_t))) {
     return CASS_ERROR_LIB_NOT_ENOUGH_DATA;
   }
 
@@ -210,6 +221,19 @@ CassError LineStringIterator::BinaryIterator::next_point(cass_double_t* x, cass_
   return CASS_OK;
 }
 
+CassError LineStringIterator::BinaryIterator::next_points(cass_double_t* points,
+                                                         size_t num_points) {
+  size_t size = 2 * num_points * sizeof(cass_double_t);
+  if (size > static_cast<size_t>(points_end_ - position_)) {
+    return CASS_ERROR_LIB_INVALID_STATE;
+  }
+
+  decode_doubles(position_, 2 * num_points, byte_order_, points);
+  position_ += size;
+
+  return CASS_OK;
+}
+
 LineStringIterator::TextIterator::TextIterator(const char* text, size_t size)
     : lexer_(text, size) {
   WktLexer::Token token;
@@ -55,6 +55,11 @@ public:
     num_points_++;
   }
 
+  void add_points(const cass_double_t* points, size_t num_points) {
+    encode_doubles_append(points, 2 * num_points, bytes_);
+    num_points_ += static_cast<cass_uint32_t>(num_points);
+  }
+
   CassError finish() {
     if (num_points_ == 1) {
       return CASS_ERROR_LIB_INVALID_STATE;
@@ -88,11 +93,26 @@ public:
     return iterator_->next_point(x, y);
   }
 
+  CassError next_points(cass_double_t* points, size_t num_points) {
+    if (iterator_ == NULL) {
+      return CASS_ERROR_LIB_INVALID_STATE;
+    }
+    return iterator_->next_points(points, num_points);
+  }
+
 private:
   class Iterator : public Allocated {
   public:
     virtual ~Iterator() {}
     virtual CassError next_point(cass_double_t* x, cass_double_t* y) = 0;
+
+    virtual CassError next_points(cass_double_t* points, size_t num_points) {
+      for (size_t i = 0; i < num_points; ++i) {
+        CassError rc = next_point(&points[2 * i], &points[2 * i + 1]);
+        if (rc != CASS_OK) return rc;
+      }
+      return CASS_OK;
+    }
   };
 
   class BinaryIterator : public Iterator {
@@ -105,6 +125,7 @@ private:
         , byte_order_(byte_order) {}
 
     virtual CassError next_point(cass_double_t* x, cass_double_t* y);
+    virtual CassError next_points(cass_double_t* points, size_t num_points);
 
   private:
     const cass_byte_t* position_;
@@ -46,6 +46,12 @@ CassError dse_polygon_add_point(DsePolygon* polygon, cass_double_t x, cass_doubl
   return CASS_OK;
 }
 
+CassError dse_polygon_add_points(DsePolygon* polygon, const cass_double_t* points,
+                                 size_t num_points) {
+  polygon->add_points(points, num_points);
+  return CASS_OK;
+}
+
 CassError dse_polygon_finish(DsePolygon* polygon) { return polygon->finish(); }
 
 DsePolygonIterator* dse_polygon_iterator_new() {
@@ -67,6 +73,10 @@ CassError dse_polygon_iterator_reset_with_wkt(DsePolygonIterator* iterator, cons
 
 void dse_polygon_iterator_free(DsePolygonIterator* iterator) { delete iterator->from(); }
 
+cass_uint32_t dse_polygon_iterator_num_points(const DsePolygonIterator* iterator) {
+  return iterator->num_points();
+}
+
 cass_uint32_t dse_polygon_iterator_num_rings(const DsePolygonIterator* iterator) {
   return iterator->num_rings();
 }
@@ -81,6 +91,11 @@ CassError dse_polygon_iterator_next_point(DsePolygonIterator* iterator, cass_dou
   return iterator->next_point(x, y);
 }
 
+CassError dse_polygon_iterator_next_points(DsePolygonIterator* iterator, cass_double_t* points,
+                                           size_t num_points) {
+  return iterator->next_points(points, num_points);
+}
+
 } // extern "C"
 
 String Polygon::to_wkt() const {
@@ -117,6 +132,7 @@ CassError PolygonIterator::reset_binary(const CassValue* value) {
   const cass_byte_t* pos;
   WkbByteOrder byte_order;
   cass_uint32_t num_rings;
+  cass_uint32_t total_num_points = 0;
 
   CassError rc = validate_data_type(value, DSE_POLYGON_TYPE);
   if (rc != CASS_OK) return rc;
@@ -151,13 +167,16 @@ CassError PolygonIterator::reset_binary(const CassValue* value) {
     num_points = decode_uint32(pos, byte_order);
     pos += sizeof(cass_uint32_t);
 
-    if (size < 2 * num_points * sizeof(cass_double_t)) {
+    if (num_points > size / (2 * sizeof(cass_double_t))) {
       return CASS_ERROR_LIB_NOT_ENOUGH_DATA;
     }
     size -= 2 * num_points * sizeof(cass_double_t);
+    pos += 2 * num_points * sizeof(cass_double_t);
+    total_num_points += num_points;
   }
 
   num_rings_ = num_rings;
+  num_points_ = total_num_points;
   binary_iterator_ = BinaryIterator(rings, rings_end, byte_order);
   iterator_ = &binary_iterator_;
 
@@ -166,6 +185,7 @@ CassError PolygonIterator::reset_binary(const CassValue* value) {
 
 CassError PolygonIterator::reset_text(const char* text, size_t size) {
   cass_uint32_t num_rings = 0;
+  cass_uint32_t total_num_points = 0;
   const bool skip_numbers = true;
   WktLexer lexer(text, size, skip_numbers);
 
@@ -206,6 +226,8 @@ CassError PolygonIterator::reset_text(const char* text, size_t size) {
         return CASS_ERROR_LIB_BAD_PARAMS;
       }
 
+      ++total_num_points;
+
       // Check and skip "," token
       token = lexer.next_token();
       if (token == WktLexer::TK_COMMA) {
@@ -241,6 +263,7 @@ CassError PolygonIterator::reset_text(const char* text, size_t size) {
   }
 
   num_rings_ = num_rings;
+  num_points_ = total_num_points;
   text_iterator_ = TextIterator(text, size);
   iterator_ = &text_iterator_;
 
@@ -278,6 +301,27 @@ CassError PolygonIterator::BinaryIterator::next_point(cass_double_t* x, cass_dou
   return CASS_OK;
 }
 
+CassError PolygonIterator::BinaryIterator::next_points(cass_double_t* points, size_t num_points) {
+  if (state_ != STATE_POINTS) {
+    return CASS_ERROR_LIB_INVALID_STATE;
+  }
+
+  size_t size = 2 * num_points * sizeof(cass_double_t);
+  if (size > static_cast<size_t>(points_end_ - position_)) {
+    return CASS_ERROR_LIB_INVALID_STATE;
+  }
+
+  decode_doubles(position_, 2 * num_points, byte_order_, points);
+  position_ += size;
+  if (position_ >= rings_end_) {
+    state_ = STATE_DONE;
+  } else if (position_ >= points_end_) {
+    state_ = STATE_NUM_POINTS;
+  }
+
+  return CASS_OK;
+}
+
 PolygonIterator::TextIterator::TextIterator(const char* text, size_t size)
     : state_(STATE_NUM_POINTS)
     , lexer_(text, size) {
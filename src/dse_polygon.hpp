@@ -69,6 +69,11 @@ public:
     num_points_++;
   }
 
+  void add_points(const cass_double_t* points, size_t num_points) {
+    encode_doubles_append(points, 2 * num_points, bytes_);
+    num_points_ += static_cast<cass_uint32_t>(num_points);
+  }
+
   CassError finish() {
     encode(num_rings_, WKB_HEADER_SIZE, bytes_);
     return finish_ring(); // Finish the last ring
@@ -103,9 +108,11 @@ private:
 public:
   PolygonIterator()
       : num_rings_(0)
+      , num_points_(0)
       , iterator_(NULL) {}
 
   cass_uint32_t num_rings() const { return num_rings_; }
+  cass_uint32_t num_points() const { return num_points_; }
 
   CassError reset_binary(const CassValue* value);
   CassError reset_text(const char* text, size_t size);
@@ -124,12 +131,27 @@ public:
     return iterator_->next_point(x, y);
   }
 
+  CassError next_points(cass_double_t* points, size_t num_points) {
+    if (iterator_ == NULL) {
+      return CASS_ERROR_LIB_INVALID_STATE;
+    }
+    return iterator_->next_points(points, num_points);
+  }
+
 private:
   class Iterator : public Allocated {
   public:
     virtual ~Iterator() {}
     virtual CassError next_num_points(cass_uint32_t* num_points) = 0;
     virtual CassError next_point(cass_double_t* x, cass_double_t* y) = 0;
+
+    virtual CassError next_points(cass_double_t* points, size_t num_points) {
+      for (size_t i = 0; i < num_points; ++i) {
+        CassError rc = next_point(&points[2 * i], &points[2 * i + 1]);
+        if (rc != CASS_OK) return rc;
+      }
+      return CASS_OK;
+    }
   };
 
   class BinaryIterator : public Iterator {
@@ -145,6 +167,7 @@ private:
 
     virtual CassError next_num_points(cass_uint32_t* num_points);
     virtual CassError next_point(cass_double_t* x, cass_double_t* y);
+    virtual CassError next_points(cass_double_t* points, size_t num_points);
 
   private:
     State state_;
@@ -168,6 +191,7 @@ private:
   };
 
   cass_uint32_t num_rings_;
+  cass_uint32_t num_points_; // The total number of points in all the rings
   Iterator* iterator_;
   BinaryIterator binary_iterator_;
   TextIterator text_iterator_;
@@ -116,6 +116,13 @@ inline void encode_append(T value, Bytes& bytes) {
   }
 }
 
+inline void encode_doubles_append(const cass_double_t* values, size_t count, Bytes& bytes) {
+  if (count == 0) return;
+  size_t index = bytes.size();
+  bytes.resize(index + count * sizeof(cass_double_t));
+  memcpy(&bytes[index], values, count * sizeof(cass_double_t));
+}
+
 inline void encode_header_append(WkbGeometryType type, Bytes& bytes) {
   bytes.push_back(native_byte_order());
   encode_append(static_cast<cass_uint32_t>(type), bytes);
@@ -127,7 +134,7 @@ inline cass_double_t decode_double(const cass_byte_t* bytes, WkbByteOrder byte_o
   if (byte_order != native_byte_order()) {
     cass_uint64_t temp;
     memcpy(&temp, bytes, sizeof(cass_uint64_t));
-    swap_uint64(temp);
+    temp = swap_uint64(temp);
     memcpy(&value, &temp, sizeof(cass_uint64_t));
   } else {
     memcpy(&value, bytes, sizeof(cass_uint64_t));
@@ -135,11 +142,31 @@ inline cass_double_t decode_double(const cass_byte_t* bytes, WkbByteOrder byte_o
   return value;
 }
 
+/**
+ * Decodes an array of doubles. Values in the native byte order are copied
+ * directly and the byte swapping loop for the other order has no dependencies
+ * between iterations so compilers vectorize it into SIMD byte shuffles.
+ */
+inline void decode_doubles(const cass_byte_t* bytes, size_t count, WkbByteOrder byte_order,
+                           cass_double_t* values) {
+  STATIC_ASSERT(sizeof(cass_double_t) == sizeof(cass_uint64_t));
+  if (count == 0) return;
+  memcpy(values, bytes, count * sizeof(cass_double_t));
+  if (byte_order != native_byte_order()) {
+    for (size_t i = 0; i < count; ++i) {
+      cass_uint64_t temp;
+      memcpy(&temp, values + i, sizeof(cass_uint64_t));
+      temp = swap_uint64(temp);
+      memcpy(values + i, &temp, sizeof(cass_uint64_t));
+    }
+  }
+}
+
 inline cass_uint32_t decode_uint32(const cass_byte_t* bytes, WkbByteOrder byte_order) {
   cass_uint32_t value;
   memcpy(&value, bytes, sizeof(cass_uint32_t));
   if (byte_order != native_byte_order()) {
-    swap_uint32(value);
+    value = swap_uint32(value);
   }
   return value;
 }
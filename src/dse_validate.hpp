@@ -23,9 +23,7 @@
 
 namespace datastax { namespace internal { namespace enterprise {
 
-inline CassError validate_data_type(const CassValue* value, const char* class_name) {
-  const CassDataType* data_type = cass_value_data_type(value);
-
+inline CassError validate_data_type(const CassDataType* data_type, const char* class_name) {
   if (data_type == NULL) {
     return CASS_ERROR_LIB_INTERNAL_ERROR;
   }
@@ -45,6 +43,10 @@ inline CassError validate_data_type(const CassValue* value, const char* class_na
   return CASS_OK;
 }
 
+inline CassError validate_data_type(const CassValue* value, const char* class_name) {
+  return validate_data_type(cass_value_data_type(value), class_name);
+}
+
 }}} // namespace datastax::internal::enterprise
 
 #endif
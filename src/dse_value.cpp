@@ -17,12 +17,20 @@
 #include "dse.h"
 
 #include "macros.hpp"
+#include "result_columns.hpp"
+#include "result_response.hpp"
 #include "string_ref.hpp"
 
+#include "dse_date_range.hpp"
+#include "dse_line_string.hpp"
+#include "dse_polygon.hpp"
 #include "dse_serialization.hpp"
 #include "dse_validate.hpp"
 
+#include <string.h>
+
 using namespace datastax::internal;
+using namespace datastax::internal::core;
 using namespace datastax::internal::enterprise;
 
 extern "C" {
@@ -55,14 +63,51 @@ CassError cass_value_get_dse_point(const CassValue* value, cass_double_t* x, cas
   return CASS_OK;
 }
 
+CassError cass_value_get_dse_line_string(const CassValue* value, cass_double_t* points,
+                                         size_t points_size, cass_uint32_t* num_points) {
+  LineStringIterator iterator;
+
+  CassError rc = iterator.reset_binary(value);
+  if (rc != CASS_OK) return rc;
+
+  *num_points = iterator.num_points();
+  if (*num_points > points_size) {
+    return CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS;
+  }
+
+  return iterator.next_points(points, *num_points);
+}
+
+CassError cass_value_get_dse_polygon(const CassValue* value, cass_double_t* points,
+                                     size_t points_size, cass_uint32_t* ring_num_points,
+                                     size_t rings_size, cass_uint32_t* num_rings,
+                                     cass_uint32_t* num_points) {
+  PolygonIterator iterator;
+
+  CassError rc = iterator.reset_binary(value);
+  if (rc != CASS_OK) return rc;
+
+  *num_rings = iterator.num_rings();
+  *num_points = iterator.num_points();
+  if (*num_rings > rings_size || *num_points > points_size) {
+    return CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS;
+  }
+
+  for (cass_uint32_t i = 0; i < *num_rings; ++i) {
+    rc = iterator.next_num_points(&ring_num_points[i]);
+    if (rc != CASS_OK) return rc;
+
+    rc = iterator.next_points(points, ring_num_points[i]);
+    if (rc != CASS_OK) return rc;
+    points += 2 * ring_num_points[i];
+  }
+
+  return CASS_OK;
+}
+
 CassError cass_value_get_dse_date_range(const CassValue* value, DseDateRange* range) {
-  size_t size = 0;
-  size_t expected_size = 0;
   const char* pos = NULL;
-  const char* end = NULL;
-  DateRangeBoundType range_type;
-  DseDateRangeBound* first_bound = NULL;
-  int8_t decoded_byte = 0;
+  size_t size = 0;
 
   CassError rc = validate_data_type(value, DSE_DATE_RANGE_TYPE);
   if (rc != CASS_OK) return rc;
@@ -70,70 +115,46 @@ CassError cass_value_get_dse_date_range(const CassValue* value, DseDateRange* ra
   rc = cass_value_get_string(value, &pos, &size);
   if (rc != CASS_OK) return rc;
 
-  if (size == 0) {
-    return CASS_ERROR_LIB_NOT_ENOUGH_DATA;
-  }
+  return decode_date_range(pos, size, range);
+}
 
-  end = pos + size;
-
-  // The format of the data is <type int8>[<from_time int64><from_precision int8>[<to_time
-  // int64><to_precision int8>]] Depending on the type of range, we may have a subset of the
-  // remaining fields. This translates to having 0, 1, or 2 bounds. If we have one bound, it may be
-  // an upper or lower bound.
-
-  range_type = static_cast<DateRangeBoundType>(*pos++);
-
-  range->is_single_date =
-      static_cast<cass_bool_t>(range_type == DATE_RANGE_BOUND_TYPE_SINGLE_DATE ||
-                               range_type == DATE_RANGE_BOUND_TYPE_SINGLE_DATE_OPEN);
-  range->lower_bound = dse_date_range_bound_unbounded();
-  range->upper_bound = dse_date_range_bound_unbounded();
-
-  switch (range_type) {
-    case DATE_RANGE_BOUND_TYPE_BOTH_OPEN_RANGE:
-    case DATE_RANGE_BOUND_TYPE_SINGLE_DATE_OPEN:
-      expected_size = sizeof(int8_t);
-      break;
-    case DATE_RANGE_BOUND_TYPE_SINGLE_DATE:
-    case DATE_RANGE_BOUND_TYPE_OPEN_RANGE_HIGH:
-    case DATE_RANGE_BOUND_TYPE_OPEN_RANGE_LOW:
-      // type, from_time, from_precision
-      expected_size = sizeof(int8_t) + sizeof(int64_t) + sizeof(int8_t);
-      first_bound = (range_type == DATE_RANGE_BOUND_TYPE_OPEN_RANGE_LOW) ? &(range->upper_bound)
-                                                                         : &(range->lower_bound);
-      break;
-    case DATE_RANGE_BOUND_TYPE_CLOSED_RANGE:
-      // type, from_time, from_precision, to_time, to_precision
-      expected_size =
-          sizeof(int8_t) + sizeof(int64_t) + sizeof(int8_t) + sizeof(int64_t) + sizeof(int8_t);
-      first_bound = &(range->lower_bound);
-      break;
-    default:
-      return CASS_ERROR_LIB_INVALID_DATA;
+CassError cass_result_column_get_dse_date_range(const CassResult* result, size_t index,
+                                                DseDateRange* output, cass_uint8_t* validity,
+                                                size_t output_size) {
+  if (result->kind() != CASS_RESULT_KIND_ROWS) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
   }
-
-  if (size < expected_size) {
-    return CASS_ERROR_LIB_NOT_ENOUGH_DATA;
+  if (index >= static_cast<size_t>(result->column_count())) {
+    return CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS;
   }
-
-  if (pos == end) {
-    return CASS_OK;
+  if (output_size < static_cast<size_t>(result->row_count())) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
   }
 
-  // We have at least one bound; write to the attribute that was chosen earlier.
-  pos = decode_int64(const_cast<char*>(pos), first_bound->time_ms);
-  pos = decode_int8(const_cast<char*>(pos), decoded_byte);
-  first_bound->precision = static_cast<DseDateRangePrecision>(decoded_byte);
+  CassError rc =
+      validate_data_type(cass_result_column_data_type(result, index), DSE_DATE_RANGE_TYPE);
+  if (rc != CASS_OK) return rc;
 
-  if (pos == end) {
-    return CASS_OK;
+  const ResultColumns* columns = result->columns();
+  if (columns == NULL) {
+    return CASS_ERROR_LIB_NOT_ENOUGH_DATA;
   }
 
-  // This is the second bound; must be upper.
-  pos = decode_int64(const_cast<char*>(pos), range->upper_bound.time_ms);
-  decode_int8(const_cast<char*>(pos), decoded_byte);
-  range->upper_bound.precision = static_cast<DseDateRangePrecision>(decoded_byte);
-
+  size_t row_count = columns->row_count();
+  if (validity) memset(validity, 0, (row_count + 7) / 8);
+
+  for (size_t row = 0; row < row_count; ++row) {
+    int32_t size = 0;
+    const char* data = columns->cell(index, row, &size);
+    if (data == NULL) {
+      dse_date_range_init(&output[row], dse_date_range_bound_unbounded(),
+                          dse_date_range_bound_unbounded());
+      continue;
+    }
+    rc = decode_date_range(data, size, &output[row]);
+    if (rc != CASS_OK) return rc;
+    if (validity) validity[row / 8] |= static_cast<cass_uint8_t>(1 << (row % 8));
+  }
   return CASS_OK;
 }
 
@@ -21,6 +21,12 @@
 #include <signal.h>
 #endif
 
+// The maximum number of tasks an idle event loop steals each time it's woken
+#define MAX_STOLEN_TASKS 64
+
+// The length of the window used to compute an event loop's utilization
+#define UTILIZATION_WINDOW_NS (100 * 1000 * 1000)
+
 using namespace datastax;
 using namespace datastax::internal::core;
 
@@ -47,9 +53,23 @@ static void consume_blocked_sigpipe() {
 EventLoop::EventLoop()
     : is_loop_initialized_(false)
     , is_joinable_(false)
+    , stealing_group_(NULL)
     , is_closing_(false)
+    , is_busy_poll_(false)
+#ifdef HAVE_IO_URING
+    , is_io_uring_failed_(false)
+#endif
     , io_time_start_(0)
-    , io_time_elapsed_(0) {
+    , io_time_elapsed_(0)
+    , last_transition_time_(0)
+    , is_idle_(false)
+    , busy_time_(0)
+    , idle_time_(0)
+    , tasks_run_(0)
+    , tasks_stolen_(0)
+    , utilization_window_start_(0)
+    , utilization_window_busy_time_(0)
+    , utilization_(0) {
   // Set user data for PooledConnection to start the I/O elapsed time.
   loop_.data = this;
 }
@@ -76,6 +96,8 @@ int EventLoop::init(const String& thread_name /*= ""*/) {
   rc = async_.start(loop(), bind_callback(&EventLoop::on_task, this));
   if (rc != 0) return rc;
   rc = check_.start(loop(), bind_callback(&EventLoop::on_check, this));
+  if (rc != 0) return rc;
+  rc = idle_prepare_.start(loop(), bind_callback(&EventLoop::on_idle_prepare, this));
   is_loop_initialized_ = true;
 
 #if defined(HAVE_SIGTIMEDWAIT) && !defined(HAVE_NOSIGPIPE)
@@ -114,7 +136,16 @@ void EventLoop::add(Task* task) {
   async_.send();
 }
 
+void EventLoop::add_stealable(Task* task) { stealable_tasks_.enqueue(task); }
+
+void EventLoop::run_task(Task* task) {
+  task->run(this);
+  delete task;
+  tasks_run_.store(tasks_run_.load(MEMORY_ORDER_RELAXED) + 1, MEMORY_ORDER_RELAXED);
+}
+
 void EventLoop::maybe_start_io_time() {
+  mark_busy();
   if (io_time_start_ == 0) {
     io_time_start_ = uv_hrtime();
   }
@@ -158,18 +189,58 @@ bool EventLoop::TaskQueue::is_empty() {
   return queue_.empty();
 }
 
+size_t EventLoop::TaskQueue::size() const {
+  ScopedMutex l(&lock_);
+  return queue_.size();
+}
+
 void EventLoop::internal_on_run(void* arg) {
   EventLoop* thread = static_cast<EventLoop*>(arg);
   thread->handle_run();
 }
 
 void EventLoop::handle_run() {
+  apply_cpu_affinity();
   on_run();
-  uv_run(loop(), UV_RUN_DEFAULT);
+  last_transition_time_ = utilization_window_start_ = uv_hrtime();
+  if (is_busy_poll_) {
+    // Poll for events without blocking until there are no more active handles
+    while (uv_run(loop(), UV_RUN_NOWAIT) != 0) {
+    }
+  } else {
+    uv_run(loop(), UV_RUN_DEFAULT);
+  }
   on_after_run();
   SslContextFactory::thread_cleanup();
 }
 
+void EventLoop::apply_cpu_affinity() {
+  if (cpu_affinity_.empty()) return;
+#if UV_VERSION_HEX >= 0x012D00 // uv_thread_setaffinity() was added in libuv 1.45
+  int mask_size = uv_cpumask_size();
+  if (mask_size <= 0) {
+    LOG_WARN("Unable to pin event loop thread: %s", uv_strerror(mask_size));
+    return;
+  }
+  Vector<char> mask(static_cast<size_t>(mask_size), 0);
+  for (Vector<unsigned>::const_iterator it = cpu_affinity_.begin(), end = cpu_affinity_.end();
+       it != end; ++it) {
+    if (*it >= static_cast<unsigned>(mask_size)) {
+      LOG_WARN("Unable to pin event loop thread to CPU %u: Invalid CPU", *it);
+      return;
+    }
+    mask[*it] = 1;
+  }
+  uv_thread_t self = uv_thread_self();
+  int rc = uv_thread_setaffinity(&self, &mask[0], NULL, mask.size());
+  if (rc != 0) {
+    LOG_WARN("Unable to pin event loop thread: %s", uv_strerror(rc));
+  }
+#else
+  LOG_WARN("Unable to pin event loop thread: Not supported by libuv");
+#endif
+}
+
 void EventLoop::on_check(Check* check) {
   uint64_t now = uv_hrtime();
   if (io_time_start_ > 0) {
@@ -178,20 +249,83 @@ void EventLoop::on_check(Check* check) {
   } else {
     io_time_elapsed_ = 0;
   }
+
+  // The end of the loop iteration's I/O processing
+  if (is_idle_.load(MEMORY_ORDER_RELAXED)) {
+    record_idle_time(now);
+  } else {
+    record_busy_time(now);
+  }
+  is_idle_.store(false, MEMORY_ORDER_RELAXED);
+}
+
+void EventLoop::on_idle_prepare(Prepare* prepare) {
+  // The loop is about to wait for events
+  record_busy_time(uv_hrtime());
+  is_idle_.store(true, MEMORY_ORDER_RELAXED);
+}
+
+void EventLoop::mark_busy() {
+  // The first callback after waiting for events
+  if (is_idle_.load(MEMORY_ORDER_RELAXED)) {
+    record_idle_time(uv_hrtime());
+    is_idle_.store(false, MEMORY_ORDER_RELAXED);
+  }
+}
+
+void EventLoop::record_busy_time(uint64_t now) {
+  busy_time_.store(busy_time_.load(MEMORY_ORDER_RELAXED) + (now - last_transition_time_),
+                   MEMORY_ORDER_RELAXED);
+  last_transition_time_ = now;
+  maybe_update_utilization(now);
+}
+
+void EventLoop::record_idle_time(uint64_t now) {
+  idle_time_.store(idle_time_.load(MEMORY_ORDER_RELAXED) + (now - last_transition_time_),
+                   MEMORY_ORDER_RELAXED);
+  last_transition_time_ = now;
+  maybe_update_utilization(now);
+}
+
+void EventLoop::maybe_update_utilization(uint64_t now) {
+  uint64_t elapsed = now - utilization_window_start_;
+  if (elapsed >= UTILIZATION_WINDOW_NS) {
+    uint64_t busy_time = busy_time_.load(MEMORY_ORDER_RELAXED);
+    utilization_.store(
+        static_cast<int>(((busy_time - utilization_window_busy_time_) * 1000) / elapsed),
+        MEMORY_ORDER_RELAXED);
+    utilization_window_start_ = now;
+    utilization_window_busy_time_ = busy_time;
+  }
 }
 
 void EventLoop::on_task(Async* async) {
+  mark_busy();
+
   Task* task = NULL;
   while (tasks_.dequeue(task)) {
     if (task) {
-      task->run(this);
-      delete task;
+      run_task(task);
+    }
+  }
+
+  while (stealable_tasks_.dequeue(task)) {
+    if (task) {
+      run_task(task);
     }
   }
 
-  if (is_closing_.load() && tasks_.is_empty()) {
+  if (stealing_group_) {
+    stealing_group_->steal(this);
+  }
+
+  if (is_closing_.load() && tasks_.is_empty() && stealable_tasks_.is_empty()) {
     async_.close_handle();
     check_.close_handle();
+    idle_prepare_.close_handle();
+#ifdef HAVE_IO_URING
+    if (io_uring_) io_uring_->close();
+#endif
 #if defined(HAVE_SIGTIMEDWAIT) && !defined(HAVE_NOSIGPIPE)
     uv_prepare_stop(&prepare_);
     uv_close(reinterpret_cast<uv_handle_t*>(&prepare_), NULL);
@@ -200,10 +334,47 @@ void EventLoop::on_task(Async* async) {
   }
 }
 
+#ifdef HAVE_IO_URING
+IoUring* EventLoop::io_uring() {
+  if (!io_uring_ && !is_io_uring_failed_) {
+    io_uring_.reset(new IoUring());
+    int rc = io_uring_->init(loop());
+    if (rc != 0) {
+      LOG_WARN("Unable to initialize io_uring, using libuv for sockets instead: %s",
+               uv_strerror(rc));
+      io_uring_->close();
+      io_uring_.reset();
+      is_io_uring_failed_ = true;
+    }
+  }
+  return io_uring_.get();
+}
+#endif
+
 #if defined(HAVE_SIGTIMEDWAIT) && !defined(HAVE_NOSIGPIPE)
 void EventLoop::on_prepare(uv_prepare_t* prepare) { consume_blocked_sigpipe(); }
 #endif
 
+void RoundRobinEventLoopGroup::set_work_stealing(bool enabled) {
+  is_work_stealing_ = enabled;
+  for (size_t i = 0; i < num_threads_; ++i) {
+    threads_[i].stealing_group_ = enabled ? this : NULL;
+  }
+}
+
+void RoundRobinEventLoopGroup::set_busy_poll(bool enabled) {
+  for (size_t i = 0; i < num_threads_; ++i) {
+    threads_[i].set_busy_poll(enabled);
+  }
+}
+
+void RoundRobinEventLoopGroup::set_cpu_affinity(const Vector<Vector<unsigned> >& cpu_sets) {
+  if (cpu_sets.empty()) return;
+  for (size_t i = 0; i < num_threads_; ++i) {
+    threads_[i].set_cpu_affinity(cpu_sets[i % cpu_sets.size()]);
+  }
+}
+
 int RoundRobinEventLoopGroup::init(const String& thread_name /*= ""*/) {
   for (size_t i = 0; i < num_threads_; ++i) {
     int rc = threads_[i].init(thread_name);
@@ -237,3 +408,42 @@ EventLoop* RoundRobinEventLoopGroup::add(Task* task) {
   event_loop->add(task);
   return event_loop;
 }
+
+void RoundRobinEventLoopGroup::add_stealable(Task* task) {
+  EventLoop* event_loop = &threads_[current_.fetch_add(1) % num_threads_];
+  event_loop->add_stealable(task);
+
+  // Prefer waking an idle event loop to steal the task over queuing more work
+  // behind a busy event loop.
+  if (is_work_stealing_ && !event_loop->is_idle()) {
+    for (size_t i = 0; i < num_threads_; ++i) {
+      if (threads_[i].is_idle()) {
+        threads_[i].wake();
+        return;
+      }
+    }
+  }
+  event_loop->wake();
+}
+
+void RoundRobinEventLoopGroup::steal(EventLoop* thief) {
+  size_t stolen = 0;
+  for (size_t i = 0; i < num_threads_ && stolen < MAX_STOLEN_TASKS; ++i) {
+    EventLoop* victim = &threads_[i];
+    if (victim == thief) continue;
+    Task* task = NULL;
+    while (stolen < MAX_STOLEN_TASKS && victim->stealable_tasks_.dequeue(task)) {
+      if (task) {
+        thief->run_task(task);
+        ++stolen;
+      }
+    }
+  }
+  if (stolen > 0) {
+    thief->tasks_stolen_.store(thief->tasks_stolen_.load(MEMORY_ORDER_RELAXED) + stolen,
+                               MEMORY_ORDER_RELAXED);
+  }
+  if (stolen == MAX_STOLEN_TASKS) {
+    thief->wake(); // There might be more tasks to steal
+  }
+}
@@ -22,12 +22,14 @@
 #include "atomic.hpp"
 #include "deque.hpp"
 #include "driver_config.hpp"
+#include "io_uring.hpp"
 #include "logger.hpp"
 #include "loop_watcher.hpp"
 #include "macros.hpp"
 #include "scoped_lock.hpp"
 #include "scoped_ptr.hpp"
 #include "utils.hpp"
+#include "vector.hpp"
 
 #include <assert.h>
 #include <uv.h>
@@ -35,6 +37,7 @@
 namespace datastax { namespace internal { namespace core {
 
 class EventLoop;
+class RoundRobinEventLoopGroup;
 
 /**
  * A task executed on an event loop thread.
@@ -72,6 +75,29 @@ public:
    */
   int run();
 
+  /**
+   * Spin checking for events instead of blocking until an event occurs. This
+   * must be called before the event loop is run.
+   *
+   * @param enabled
+   */
+  void set_busy_poll(bool enabled) { is_busy_poll_ = enabled; }
+
+  /**
+   * Determines if the event loop spins checking for events.
+   *
+   * @return true if busy polling.
+   */
+  bool is_busy_poll() const { return is_busy_poll_; }
+
+  /**
+   * Pin the event loop thread to a set of CPUs. This must be called before the
+   * event loop is run.
+   *
+   * @param cpus The CPU numbers. If empty, the thread isn't pinned.
+   */
+  void set_cpu_affinity(const Vector<unsigned>& cpus) { cpu_affinity_ = cpus; }
+
   /**
    * Closes the libuv handles (thread-safe).
    */
@@ -115,6 +141,72 @@ public:
    */
   const String& name() const { return name_; }
 
+  /**
+   * Get the time spent running callbacks and tasks, i.e. not waiting for
+   * events (thread-safe). The loop is considered busy from its first task or
+   * I/O (see maybe_start_io_time()) after waiting for events until it waits
+   * again.
+   *
+   * @return Busy time (in nanoseconds)
+   */
+  uint64_t busy_time() const { return busy_time_.load(MEMORY_ORDER_RELAXED); }
+
+  /**
+   * Get the time spent waiting for events (thread-safe).
+   *
+   * @return Idle time (in nanoseconds)
+   */
+  uint64_t idle_time() const { return idle_time_.load(MEMORY_ORDER_RELAXED); }
+
+  /**
+   * Get the fraction of the recent past the event loop was busy (thread-safe).
+   * This is updated over windows of about 100 milliseconds.
+   *
+   * @return Utilization in thousandths (0 to 1000)
+   */
+  int utilization() const { return utilization_.load(MEMORY_ORDER_RELAXED); }
+
+  /**
+   * Get the number of tasks run on this event loop, including stolen tasks
+   * (thread-safe).
+   *
+   * @return The number of tasks run.
+   */
+  uint64_t tasks_run() const { return tasks_run_.load(MEMORY_ORDER_RELAXED); }
+
+  /**
+   * Get the number of tasks this event loop has stolen from other event loops
+   * in its group (thread-safe).
+   *
+   * @return The number of tasks stolen.
+   */
+  uint64_t tasks_stolen() const { return tasks_stolen_.load(MEMORY_ORDER_RELAXED); }
+
+  /**
+   * Get the number of tasks waiting to run on this event loop, including the
+   * tasks other event loops can steal (thread-safe).
+   *
+   * @return The number of pending tasks.
+   */
+  size_t pending_task_count() const { return tasks_.size() + stealable_tasks_.size(); }
+
+  /**
+   * Get the group whose event loops can steal work from this event loop.
+   *
+   * @return The group or NULL if work stealing isn't enabled.
+   */
+  RoundRobinEventLoopGroup* stealing_group() const { return stealing_group_; }
+
+#ifdef HAVE_IO_URING
+  /**
+   * Get the io_uring shared by the sockets of this event loop. It's created
+   * the first time it's used. This must be called on the event loop thread.
+   *
+   * @return The io_uring or NULL if the kernel doesn't support it.
+   */
+  IoUring* io_uring();
+#endif
+
 protected:
   /**
    * A callback that's run before the event loop is run.
@@ -135,17 +227,33 @@ private:
     bool enqueue(Task* task);
     bool dequeue(Task*& task);
     bool is_empty();
+    size_t size() const;
 
   private:
-    uv_mutex_t lock_;
+    mutable uv_mutex_t lock_;
     Deque<Task*> queue_;
   };
 
+private:
+  friend class RoundRobinEventLoopGroup;
+
+  bool is_idle() const { return is_idle_.load(MEMORY_ORDER_RELAXED); }
+  void add_stealable(Task* task);
+  void wake() { async_.send(); }
+  void run_task(Task* task);
+
 private:
   static void internal_on_run(void* arg);
   void handle_run();
 
+  void apply_cpu_affinity();
+
   void on_check(Check* check);
+  void on_idle_prepare(Prepare* prepare);
+  void mark_busy();
+  void record_busy_time(uint64_t now);
+  void record_idle_time(uint64_t now);
+  void maybe_update_utilization(uint64_t now);
   void on_task(Async* async);
 
   uv_loop_t loop_;
@@ -161,13 +269,34 @@ private:
   bool is_joinable_;
   Async async_;
   TaskQueue tasks_;
+  TaskQueue stealable_tasks_;
+  RoundRobinEventLoopGroup* stealing_group_;
 
   Atomic<bool> is_closing_;
 
+  bool is_busy_poll_;
+  Vector<unsigned> cpu_affinity_;
+
+#ifdef HAVE_IO_URING
+  ScopedPtr<IoUring> io_uring_;
+  bool is_io_uring_failed_;
+#endif
+
   Check check_;
   uint64_t io_time_start_;
   uint64_t io_time_elapsed_;
 
+  Prepare idle_prepare_;
+  uint64_t last_transition_time_;
+  Atomic<bool> is_idle_;
+  Atomic<uint64_t> busy_time_;
+  Atomic<uint64_t> idle_time_;
+  Atomic<uint64_t> tasks_run_;
+  Atomic<uint64_t> tasks_stolen_;
+  uint64_t utilization_window_start_;
+  uint64_t utilization_window_busy_time_;
+  Atomic<int> utilization_;
+
   String name_;
 };
 
@@ -205,13 +334,44 @@ public:
 /**
  * A groups of event loops where tasks are assigned to a specific event loop
  * using round-robin.
+ *
+ * Tasks that aren't tied to a specific event loop can be added using
+ * add_stealable(). When work stealing is enabled, an idle event loop can run
+ * these tasks in place of a busy event loop.
  */
 class RoundRobinEventLoopGroup : public EventLoopGroup {
 public:
   RoundRobinEventLoopGroup(size_t num_threads)
       : current_(0)
       , threads_(new EventLoop[num_threads])
-      , num_threads_(num_threads) {}
+      , num_threads_(num_threads)
+      , is_work_stealing_(false) {}
+
+  /**
+   * Enable work stealing between the event loops. This must be called before
+   * the event loops are run.
+   *
+   * @param enabled
+   */
+  void set_work_stealing(bool enabled);
+
+  /**
+   * Spin the event loops instead of blocking until events occur. This must be
+   * called before the event loops are run.
+   *
+   * @param enabled
+   */
+  void set_busy_poll(bool enabled);
+
+  /**
+   * Pin the event loop threads to sets of CPUs, in order. The sets are reused
+   * if there are more event loops than sets. This must be called before the
+   * event loops are run.
+   *
+   * @param cpu_sets The sets of CPU numbers. If empty, the threads aren't
+   * pinned.
+   */
+  void set_cpu_affinity(const Vector<Vector<unsigned> >& cpu_sets);
 
   int init(const String& thread_name = "");
   int run();
@@ -220,12 +380,28 @@ public:
 
   virtual EventLoop* add(Task* task);
   virtual EventLoop* get(size_t index) { return &threads_[index]; }
+  const EventLoop* get(size_t index) const { return &threads_[index]; }
   virtual size_t size() const { return num_threads_; }
 
+  /**
+   * Queue a task that can be run on any event loop in the group. Unlike add(),
+   * the task may be run by an idle event loop other than the one it's assigned
+   * to when work stealing is enabled.
+   *
+   * @param task The task to be run on an event loop.
+   */
+  void add_stealable(Task* task);
+
+private:
+  friend class EventLoop;
+
+  void steal(EventLoop* thief);
+
 private:
   Atomic<size_t> current_;
   ScopedArray<EventLoop> threads_;
   size_t num_threads_;
+  bool is_work_stealing_;
 };
 
 }}} // namespace datastax::internal::core
@@ -26,6 +26,11 @@ ExecuteRequest::ExecuteRequest(const Prepared* prepared)
     : Statement(prepared)
     , prepared_(prepared) {}
 
+ExecuteRequest::ExecuteRequest(const StatementTemplate* statement_template)
+    : Statement(statement_template->prepared().get())
+    , prepared_(statement_template->prepared())
+    , statement_template_(statement_template) {}
+
 int ExecuteRequest::encode(ProtocolVersion version, RequestCallback* callback,
                            BufferVec* bufs) const {
   int32_t length = encode_query_or_id(bufs);
@@ -40,10 +45,24 @@ int ExecuteRequest::encode(ProtocolVersion version, RequestCallback* callback,
       length += bufs->back().size();
     }
   }
-  length += encode_begin(version, static_cast<uint16_t>(elements().size()), callback, bufs);
+
+  // Statements created from a template copy its pre-encoded parameters
+  const bool use_template = statement_template_ &&
+                            statement_template_->page_size() == page_size() &&
+                            paging_state(callback).empty();
+
+  if (use_template) {
+    length += statement_template_->encode_begin(version, callback, bufs);
+  } else {
+    length += encode_begin(version, static_cast<uint16_t>(elements().size()), callback, bufs);
+  }
   int32_t result = encode_values(version, callback, bufs);
   if (result < 0) return result;
   length += result;
-  length += encode_end(version, callback, bufs);
+  if (use_template) {
+    length += statement_template_->encode_end(version, callback, bufs);
+  } else {
+    length += encode_end(version, callback, bufs);
+  }
   return length;
 }
@@ -17,10 +17,12 @@
 #ifndef DATASTAX_INTERNAL_EXECUTE_REQUEST_HPP
 #define DATASTAX_INTERNAL_EXECUTE_REQUEST_HPP
 
+#include "column_handle.hpp"
 #include "constants.hpp"
 #include "prepared.hpp"
 #include "ref_counted.hpp"
 #include "statement.hpp"
+#include "statement_template.hpp"
 #include "string.hpp"
 #include "vector.hpp"
 
@@ -30,6 +32,8 @@ class ExecuteRequest : public Statement {
 public:
   ExecuteRequest(const Prepared* prepared);
 
+  ExecuteRequest(const StatementTemplate* statement_template);
+
   const Prepared::ConstPtr& prepared() const { return prepared_; }
 
   virtual int encode(ProtocolVersion version, RequestCallback* callback, BufferVec* bufs) const;
@@ -38,17 +42,36 @@ public:
     return calculate_routing_key(prepared_->key_indices(), routing_key);
   }
 
+  virtual bool is_lwt() const { return prepared_->is_lwt(); }
+
+  // Determines if the prepared statement returns rows e.g. it's a SELECT
+  bool has_result_columns() const {
+    const ResultMetadata::Ptr& metadata(prepared_->result()->result_metadata());
+    return metadata && metadata->column_count() > 0;
+  }
+
+protected:
+  virtual Statement* new_copy() const {
+    return statement_template_ ? new ExecuteRequest(statement_template_.get())
+                               : new ExecuteRequest(prepared_.get());
+  }
+
 private:
   virtual size_t get_indices(StringRef name, IndexVec* indices) {
     return prepared_->result()->metadata()->get_indices(name, indices);
   }
 
+  virtual const IndexVec* get_handle_indices(const ColumnHandle& handle, IndexVec* indices) {
+    return handle.get_indices(prepared_->result()->metadata().get(), indices);
+  }
+
   virtual const DataType::ConstPtr& get_type(size_t index) const {
     return prepared_->result()->metadata()->get_column_definition(index).data_type;
   }
 
 private:
   Prepared::ConstPtr prepared_;
+  StatementTemplate::ConstPtr statement_template_;
 };
 
 }}} // namespace datastax::internal::core
@@ -86,6 +86,43 @@ CassError cass_execution_profile_set_token_aware_routing_shuffle_replicas(CassEx
   return CASS_OK;
 }
 
+CassError
+cass_execution_profile_set_token_aware_routing_least_loaded_replicas(CassExecProfile* profile,
+                                                                     cass_bool_t enabled) {
+  profile->set_token_aware_routing_least_loaded_replicas(enabled == cass_true);
+  return CASS_OK;
+}
+
+CassError cass_execution_profile_set_connection_selection(CassExecProfile* profile,
+                                                          CassConnectionSelection selection) {
+  profile->set_connection_selection(selection);
+  return CASS_OK;
+}
+
+CassError cass_execution_profile_set_priority(CassExecProfile* profile,
+                                              CassRequestPriority priority) {
+  profile->set_priority(priority);
+  return CASS_OK;
+}
+
+CassError cass_execution_profile_set_rate_limit(CassExecProfile* profile,
+                                                cass_double_t requests_per_second, unsigned burst) {
+  if (requests_per_second < 0.0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  profile->set_rate_limit(requests_per_second, burst);
+  return CASS_OK;
+}
+
+CassError cass_execution_profile_set_tracing_probability(CassExecProfile* profile,
+                                                         cass_double_t probability) {
+  if (!(probability >= 0.0 && probability <= 1.0)) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  profile->set_tracing_probability(probability);
+  return CASS_OK;
+}
+
 CassError cass_execution_profile_set_latency_aware_routing(CassExecProfile* profile,
                                                            cass_bool_t enabled) {
   profile->set_latency_aware_routing(enabled == cass_true);
@@ -182,6 +219,18 @@ CassError cass_execution_profile_set_constant_speculative_execution_policy(
   return CASS_OK;
 }
 
+CassError cass_execution_profile_set_percentile_speculative_execution_policy(
+    CassExecProfile* profile, cass_double_t percentile, int max_speculative_executions,
+    cass_double_t max_speculative_ratio) {
+  if (percentile <= 0.0 || percentile > 100.0 || max_speculative_executions < 0 ||
+      max_speculative_ratio < 0.0 || max_speculative_ratio > 1.0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  profile->set_speculative_execution_policy(new PercentileSpeculativeExecutionPolicy(
+      percentile, max_speculative_executions, max_speculative_ratio));
+  return CASS_OK;
+}
+
 CassError cass_execution_profile_set_no_speculative_execution_policy(CassExecProfile* profile) {
   profile->set_speculative_execution_policy(new NoSpeculativeExecutionPolicy());
   return CASS_OK;
@@ -24,8 +24,10 @@
 #include "constants.hpp"
 #include "dc_aware_policy.hpp"
 #include "rack_aware_policy.hpp"
+#include "rate_limiter.hpp"
 #include "dense_hash_map.hpp"
 #include "latency_aware_policy.hpp"
+#include "metrics.hpp"
 #include "speculative_execution.hpp"
 #include "string.hpp"
 #include "token_aware_policy.hpp"
@@ -38,14 +40,49 @@ namespace datastax { namespace internal { namespace core {
 class ExecutionProfile : public Allocated {
 public:
   typedef DenseHashMap<String, ExecutionProfile> Map;
+  typedef Vector<const ExecutionProfile*> ConstVec;
+
+  /**
+   * Index the profiles of a map by their handles.
+   *
+   * @param profiles The profiles.
+   * @param indexed The profiles indexed by their handles (output). The
+   * pointers are only valid while the map isn't modified.
+   */
+  static void index(const Map& profiles, ConstVec* indexed) {
+    indexed->assign(profiles.size(), NULL);
+    for (Map::const_iterator it = profiles.begin(), end = profiles.end(); it != end; ++it) {
+      int32_t handle = it->second.handle();
+      if (handle >= 0 && static_cast<size_t>(handle) < indexed->size()) {
+        (*indexed)[handle] = &it->second;
+      }
+    }
+  }
 
   ExecutionProfile()
-      : request_timeout_ms_(CASS_UINT64_MAX)
+      : handle_(-1)
+      , request_timeout_ms_(CASS_UINT64_MAX)
       , consistency_(CASS_CONSISTENCY_UNKNOWN)
       , serial_consistency_(CASS_CONSISTENCY_UNKNOWN)
       , latency_aware_routing_(false)
       , token_aware_routing_(true)
-      , token_aware_routing_shuffle_replicas_(true) {}
+      , token_aware_routing_shuffle_replicas_(true)
+      , token_aware_routing_least_loaded_replicas_(false)
+      , connection_selection_(CASS_DEFAULT_CONNECTION_SELECTION)
+      , priority_(CASS_REQUEST_PRIORITY_UNSET)
+      , rate_limit_(0.0)
+      , rate_limit_burst_(0)
+      , tracing_probability_(-1.0)
+      , latency_histogram_(NULL) {}
+
+  /**
+   * The profile's handle. Handles are assigned, in order, as profiles are
+   * added to the cluster's configuration so that requests can reference a
+   * profile without looking up its name. This is -1 if the profile hasn't
+   * been added.
+   */
+  int32_t handle() const { return handle_; }
+  void set_handle(int32_t handle) { handle_ = handle; }
 
   uint64_t request_timeout_ms() const { return request_timeout_ms_; }
 
@@ -93,6 +130,14 @@ public:
     return token_aware_routing_shuffle_replicas_;
   }
 
+  void set_token_aware_routing_least_loaded_replicas(bool least_loaded_replicas) {
+    token_aware_routing_least_loaded_replicas_ = least_loaded_replicas;
+  }
+
+  bool token_aware_routing_least_loaded_replicas() const {
+    return token_aware_routing_least_loaded_replicas_;
+  }
+
   ContactPointList& whitelist() { return whitelist_; }
   const ContactPointList& whitelist() const { return whitelist_; }
 
@@ -136,7 +181,8 @@ public:
         chain = new WhitelistDCPolicy(chain, whitelist_dc_);
       }
       if (token_aware_routing()) {
-        chain = new TokenAwarePolicy(chain, token_aware_routing_shuffle_replicas_);
+        chain = new TokenAwarePolicy(chain, token_aware_routing_shuffle_replicas_,
+                                     token_aware_routing_least_loaded_replicas_);
       }
       if (latency_aware()) {
         chain = new LatencyAwarePolicy(chain, latency_aware_routing_settings_);
@@ -146,6 +192,12 @@ public:
     }
   }
 
+  CassConnectionSelection connection_selection() const { return connection_selection_; }
+
+  void set_connection_selection(CassConnectionSelection selection) {
+    connection_selection_ = selection;
+  }
+
   const RetryPolicy::Ptr& retry_policy() const { return retry_policy_; }
 
   void set_retry_policy(RetryPolicy* retry_policy) { retry_policy_.reset(retry_policy); }
@@ -159,7 +211,47 @@ public:
     speculative_execution_policy_.reset(sep);
   }
 
+  CassRequestPriority priority() const { return priority_; }
+
+  void set_priority(CassRequestPriority priority) { priority_ = priority; }
+
+  double rate_limit() const { return rate_limit_; }
+  unsigned rate_limit_burst() const { return rate_limit_burst_; }
+
+  void set_rate_limit(double requests_per_second, unsigned burst) {
+    rate_limit_ = requests_per_second;
+    rate_limit_burst_ = burst;
+  }
+
+  const RateLimiter::Ptr& rate_limiter() const { return rate_limiter_; }
+
+  /**
+   * The probability that a request is traced even though tracing isn't
+   * enabled on its statement. This is negative if it's not set on the
+   * profile and the cluster's probability is used instead.
+   */
+  double tracing_probability() const { return tracing_probability_; }
+
+  void set_tracing_probability(double probability) { tracing_probability_ = probability; }
+
+  /**
+   * The session's histogram for the latencies of the profile's requests. This
+   * is NULL if per profile metrics are disabled.
+   */
+  Metrics::Histogram* latency_histogram() const { return latency_histogram_; }
+  void set_latency_histogram(Metrics::Histogram* histogram) { latency_histogram_ = histogram; }
+
+  /**
+   * Create the rate limiter for the profile's rate limit (if any). This is
+   * done for each session so that sessions don't share their limits.
+   */
+  void build_rate_limiter() {
+    rate_limiter_.reset(rate_limit_ > 0.0 ? new RateLimiter(rate_limit_, rate_limit_burst_)
+                                          : NULL);
+  }
+
 private:
+  int32_t handle_;
   cass_uint64_t request_timeout_ms_;
   CassConsistency consistency_;
   CassConsistency serial_consistency_;
@@ -169,12 +261,20 @@ private:
   LatencyAwarePolicy::Settings latency_aware_routing_settings_;
   bool token_aware_routing_;
   bool token_aware_routing_shuffle_replicas_;
+  bool token_aware_routing_least_loaded_replicas_;
+  CassConnectionSelection connection_selection_;
   ContactPointList whitelist_;
   DcList whitelist_dc_;
   LoadBalancingPolicy::Ptr load_balancing_policy_;
   LoadBalancingPolicy::Ptr base_load_balancing_policy_;
   RetryPolicy::Ptr retry_policy_;
   SpeculativeExecutionPolicy::Ptr speculative_execution_policy_;
+  CassRequestPriority priority_;
+  double rate_limit_;
+  unsigned rate_limit_burst_;
+  RateLimiter::Ptr rate_limiter_;
+  double tracing_probability_;
+  Metrics::Histogram* latency_histogram_;
 };
 
 }}} // namespace datastax::internal::core
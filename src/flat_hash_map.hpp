@@ -0,0 +1,489 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_FLAT_HASH_MAP_HPP
+#define DATASTAX_INTERNAL_FLAT_HASH_MAP_HPP
+
+#include "memory.hpp"
+
+#include <sparsehash/internal/sparseconfig.h>
+
+#include <functional>
+#include <iterator>
+#include <new>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FLAT_HASH_MAP_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace datastax { namespace internal {
+
+/**
+ * A group of consecutive control bytes that are probed together. Each slot of
+ * a flat hash map has a control byte that's either empty, deleted or, when the
+ * slot is full, the low 7 bits of the hash of its key. The group compares all
+ * of its bytes at once using SSE2 if it's available, otherwise it compares
+ * them one by one.
+ */
+class FlatHashGroup {
+public:
+  typedef int8_t Ctrl;
+
+  enum {
+    EMPTY = -128,
+    DELETED = -2,
+#if defined(FLAT_HASH_MAP_USE_SSE2)
+    WIDTH = 16
+#else
+    WIDTH = 8
+#endif
+  };
+
+  /**
+   * A set of the group's slots, a bit per slot.
+   */
+  class BitMask {
+  public:
+    explicit BitMask(uint32_t mask)
+        : mask_(mask) {}
+
+    bool any() const { return mask_ != 0; }
+
+    // The first slot in the set. The set must not be empty.
+    int lowest() const { return trailing_zeros(); }
+
+    void clear_lowest() { mask_ &= mask_ - 1; }
+
+    int trailing_zeros() const {
+#if defined(_MSC_VER)
+      unsigned long index;
+      _BitScanForward(&index, mask_);
+      return static_cast<int>(index);
+#else
+      return __builtin_ctz(mask_);
+#endif
+    }
+
+    int leading_zeros() const {
+#if defined(_MSC_VER)
+      unsigned long index;
+      _BitScanReverse(&index, mask_);
+      return static_cast<int>(WIDTH - 1 - index);
+#else
+      return __builtin_clz(mask_) - (32 - WIDTH);
+#endif
+    }
+
+  private:
+    uint32_t mask_;
+  };
+
+  explicit FlatHashGroup(const Ctrl* ctrl) {
+#if defined(FLAT_HASH_MAP_USE_SSE2)
+    ctrl_ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+#else
+    memcpy(ctrl_, ctrl, WIDTH);
+#endif
+  }
+
+  // The full slots whose hash matches
+  BitMask match(Ctrl h2) const {
+#if defined(FLAT_HASH_MAP_USE_SSE2)
+    return BitMask(
+        static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_))));
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < WIDTH; ++i) {
+      if (ctrl_[i] == h2) mask |= 1u << i;
+    }
+    return BitMask(mask);
+#endif
+  }
+
+  BitMask match_empty() const { return match(static_cast<Ctrl>(EMPTY)); }
+
+  BitMask match_empty_or_deleted() const {
+#if defined(FLAT_HASH_MAP_USE_SSE2)
+    // Empty and deleted are the only negative values less than -1
+    return BitMask(
+        static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl_))));
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < WIDTH; ++i) {
+      if (ctrl_[i] < -1) mask |= 1u << i;
+    }
+    return BitMask(mask);
+#endif
+  }
+
+private:
+#if defined(FLAT_HASH_MAP_USE_SSE2)
+  __m128i ctrl_;
+#else
+  Ctrl ctrl_[WIDTH];
+#endif
+};
+
+/**
+ * An open-addressing hash map in the style of SwissTable. The entries are
+ * stored inline in a single array and a separate array of control bytes is
+ * probed a group at a time, so most lookups only compare the keys of entries
+ * whose 7-bit hash matches. Unlike DenseHashMap it doesn't need empty or
+ * deleted keys, and an erased entry only leaves a tombstone when a probe
+ * could have passed over it, so erasing rarely causes a rehash.
+ *
+ * Iterators and references are invalidated by inserts.
+ */
+template <class K, class V, class HashFcn = SPARSEHASH_HASH<K>, class EqualKey = std::equal_to<K> >
+class FlatHashMap {
+public:
+  typedef K key_type;
+  typedef V mapped_type;
+  typedef std::pair<const K, V> value_type;
+  typedef size_t size_type;
+  typedef HashFcn hasher;
+  typedef EqualKey key_equal;
+
+  template <class Value, class Map>
+  class IteratorBase {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef Value value_type;
+    typedef ptrdiff_t difference_type;
+    typedef Value* pointer;
+    typedef Value& reference;
+
+    IteratorBase()
+        : map_(NULL)
+        , index_(0) {}
+
+    IteratorBase(Map* map, size_t index)
+        : map_(map)
+        , index_(index) {}
+
+    // Allows conversion from an iterator to a const iterator
+    template <class OtherValue, class OtherMap>
+    IteratorBase(const IteratorBase<OtherValue, OtherMap>& other)
+        : map_(other.map_)
+        , index_(other.index_) {}
+
+    reference operator*() const { return map_->slots_[index_]; }
+    pointer operator->() const { return &map_->slots_[index_]; }
+
+    IteratorBase& operator++() {
+      index_ = map_->next_full(index_ + 1);
+      return *this;
+    }
+
+    IteratorBase operator++(int) {
+      IteratorBase temp(*this);
+      ++(*this);
+      return temp;
+    }
+
+    template <class OtherValue, class OtherMap>
+    bool operator==(const IteratorBase<OtherValue, OtherMap>& other) const {
+      return index_ == other.index_;
+    }
+
+    template <class OtherValue, class OtherMap>
+    bool operator!=(const IteratorBase<OtherValue, OtherMap>& other) const {
+      return index_ != other.index_;
+    }
+
+  private:
+    template <class, class>
+    friend class IteratorBase;
+    friend class FlatHashMap;
+
+    Map* map_;
+    size_t index_;
+  };
+
+  typedef IteratorBase<value_type, FlatHashMap> iterator;
+  typedef IteratorBase<const value_type, const FlatHashMap> const_iterator;
+
+  explicit FlatHashMap(size_t expected_max_items = 0, const HashFcn& hf = HashFcn(),
+                       const EqualKey& eql = EqualKey())
+      : ctrl_(NULL)
+      , slots_(NULL)
+      , capacity_(0)
+      , size_(0)
+      , growth_left_(0)
+      , hash_(hf)
+      , equal_(eql) {
+    reserve(expected_max_items);
+  }
+
+  FlatHashMap(const FlatHashMap& other)
+      : ctrl_(NULL)
+      , slots_(NULL)
+      , capacity_(0)
+      , size_(0)
+      , growth_left_(0)
+      , hash_(other.hash_)
+      , equal_(other.equal_) {
+    reserve(other.size_);
+    for (const_iterator it = other.begin(), end = other.end(); it != end; ++it) {
+      insert(*it);
+    }
+  }
+
+  ~FlatHashMap() { destroy(); }
+
+  FlatHashMap& operator=(const FlatHashMap& other) {
+    if (this != &other) {
+      FlatHashMap temp(other);
+      swap(temp);
+    }
+    return *this;
+  }
+
+  void swap(FlatHashMap& other) {
+    std::swap(ctrl_, other.ctrl_);
+    std::swap(slots_, other.slots_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(size_, other.size_);
+    std::swap(growth_left_, other.growth_left_);
+    std::swap(hash_, other.hash_);
+    std::swap(equal_, other.equal_);
+  }
+
+  iterator begin() { return iterator(this, next_full(0)); }
+  iterator end() { return iterator(this, capacity_); }
+  const_iterator begin() const { return const_iterator(this, next_full(0)); }
+  const_iterator end() const { return const_iterator(this, capacity_); }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  // The number of slots, full or not
+  size_t bucket_count() const { return capacity_; }
+
+  iterator find(const K& key) { return iterator(this, find_index(key)); }
+  const_iterator find(const K& key) const { return const_iterator(this, find_index(key)); }
+
+  size_t count(const K& key) const { return find_index(key) != capacity_ ? 1 : 0; }
+
+  std::pair<iterator, bool> insert(const value_type& value) {
+    std::pair<size_t, bool> result(find_or_prepare_insert(value.first));
+    if (result.second) {
+      new (&slots_[result.first]) value_type(value);
+    }
+    return std::pair<iterator, bool>(iterator(this, result.first), result.second);
+  }
+
+  V& operator[](const K& key) {
+    std::pair<size_t, bool> result(find_or_prepare_insert(key));
+    if (result.second) {
+      new (&slots_[result.first]) value_type(key, V());
+    }
+    return slots_[result.first].second;
+  }
+
+  size_t erase(const K& key) {
+    size_t index = find_index(key);
+    if (index == capacity_) return 0;
+    erase_index(index);
+    return 1;
+  }
+
+  void erase(iterator it) { erase_index(it.index_); }
+
+  void clear() {
+    for (size_t i = 0; i < capacity_; ++i) {
+      if (is_full(ctrl_[i])) slots_[i].~value_type();
+    }
+    if (capacity_ > 0) {
+      memset(ctrl_, FlatHashGroup::EMPTY, capacity_ + FlatHashGroup::WIDTH);
+    }
+    size_ = 0;
+    growth_left_ = max_size_for(capacity_);
+  }
+
+  /**
+   * Make room for a number of entries without rehashing.
+   */
+  void reserve(size_t count) {
+    if (count > max_size_for(capacity_)) {
+      size_t capacity = capacity_ > 0 ? capacity_ : static_cast<size_t>(FlatHashGroup::WIDTH);
+      while (count > max_size_for(capacity)) {
+        capacity *= 2;
+      }
+      rehash(capacity);
+    }
+  }
+
+private:
+  typedef FlatHashGroup::Ctrl Ctrl;
+  typedef FlatHashGroup::BitMask BitMask;
+
+  static bool is_full(Ctrl ctrl) { return ctrl >= 0; }
+
+  // At most 7/8 of the slots are used so that probes always find an empty slot
+  static size_t max_size_for(size_t capacity) { return capacity - capacity / 8; }
+
+  // Mixes the hash so that hash functions with poor low bits, like the
+  // identity hash of integers and pointers, still spread the entries.
+  size_t hash_of(const K& key) const {
+    uint64_t h = static_cast<uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_t>(h ^ (h >> 32));
+  }
+
+  static size_t h1(size_t hash) { return hash >> 7; }
+  static Ctrl h2(size_t hash) { return static_cast<Ctrl>(hash & 0x7F); }
+
+  void set_ctrl(size_t index, Ctrl ctrl) {
+    ctrl_[index] = ctrl;
+    // The first group is cloned after the last slot so that a group can be
+    // loaded from any slot without wrapping.
+    if (index < static_cast<size_t>(FlatHashGroup::WIDTH)) {
+      ctrl_[capacity_ + index] = ctrl;
+    }
+  }
+
+  size_t next_full(size_t index) const {
+    while (index < capacity_ && !is_full(ctrl_[index])) {
+      ++index;
+    }
+    return index;
+  }
+
+  // Returns the capacity if the key isn't found
+  size_t find_index(const K& key) const {
+    if (size_ == 0) return capacity_;
+    size_t hash = hash_of(key);
+    size_t mask = capacity_ - 1;
+    size_t pos = h1(hash) & mask;
+    for (size_t step = FlatHashGroup::WIDTH;; step += FlatHashGroup::WIDTH) {
+      FlatHashGroup group(ctrl_ + pos);
+      for (BitMask match = group.match(h2(hash)); match.any(); match.clear_lowest()) {
+        size_t index = (pos + match.lowest()) & mask;
+        if (equal_(slots_[index].first, key)) return index;
+      }
+      if (group.match_empty().any()) return capacity_;
+      pos = (pos + step) & mask; // Triangular probing visits every group
+    }
+  }
+
+  size_t find_first_non_full(size_t hash) const {
+    size_t mask = capacity_ - 1;
+    size_t pos = h1(hash) & mask;
+    for (size_t step = FlatHashGroup::WIDTH;; step += FlatHashGroup::WIDTH) {
+      BitMask match = FlatHashGroup(ctrl_ + pos).match_empty_or_deleted();
+      if (match.any()) return (pos + match.lowest()) & mask;
+      pos = (pos + step) & mask;
+    }
+  }
+
+  // Returns the slot for the key and whether it needs to be constructed
+  std::pair<size_t, bool> find_or_prepare_insert(const K& key) {
+    size_t index = find_index(key);
+    if (index != capacity_) return std::pair<size_t, bool>(index, false);
+
+    if (capacity_ == 0) rehash(FlatHashGroup::WIDTH);
+    size_t hash = hash_of(key);
+    index = find_first_non_full(hash);
+    if (growth_left_ == 0 && ctrl_[index] != FlatHashGroup::DELETED) {
+      // Rehash in place to drop the tombstones if there are enough of them,
+      // otherwise grow.
+      rehash(size_ * 32 <= capacity_ * 25 ? capacity_ : capacity_ * 2);
+      index = find_first_non_full(hash);
+    }
+    if (ctrl_[index] == FlatHashGroup::EMPTY) growth_left_--;
+    set_ctrl(index, h2(hash));
+    size_++;
+    return std::pair<size_t, bool>(index, true);
+  }
+
+  void erase_index(size_t index) {
+    slots_[index].~value_type();
+    size_--;
+
+    // The slot can be emptied, instead of becoming a tombstone, if every
+    // group that contains it also has an empty slot because a probe would
+    // have stopped in that group.
+    size_t mask = capacity_ - 1;
+    size_t index_before = (index - FlatHashGroup::WIDTH) & mask;
+    BitMask empty_after = FlatHashGroup(ctrl_ + index).match_empty();
+    BitMask empty_before = FlatHashGroup(ctrl_ + index_before).match_empty();
+    bool was_never_full =
+        empty_before.any() && empty_after.any() &&
+        empty_after.trailing_zeros() + empty_before.leading_zeros() < FlatHashGroup::WIDTH;
+    if (was_never_full) {
+      set_ctrl(index, FlatHashGroup::EMPTY);
+      growth_left_++;
+    } else {
+      set_ctrl(index, FlatHashGroup::DELETED);
+    }
+  }
+
+  // Rehash into a new power of two capacity
+  void rehash(size_t capacity) {
+    Ctrl* old_ctrl = ctrl_;
+    value_type* old_slots = slots_;
+    size_t old_capacity = capacity_;
+
+    ctrl_ = static_cast<Ctrl*>(Memory::malloc(capacity + FlatHashGroup::WIDTH));
+    slots_ = static_cast<value_type*>(Memory::malloc(capacity * sizeof(value_type)));
+    capacity_ = capacity;
+    memset(ctrl_, FlatHashGroup::EMPTY, capacity + FlatHashGroup::WIDTH);
+    growth_left_ = max_size_for(capacity) - size_;
+
+    for (size_t i = 0; i < old_capacity; ++i) {
+      if (is_full(old_ctrl[i])) {
+        size_t hash = hash_of(old_slots[i].first);
+        size_t index = find_first_non_full(hash);
+        set_ctrl(index, h2(hash));
+        new (&slots_[index]) value_type(old_slots[i]);
+        old_slots[i].~value_type();
+      }
+    }
+
+    Memory::free(old_ctrl);
+    Memory::free(old_slots);
+  }
+
+  void destroy() {
+    for (size_t i = 0; i < capacity_; ++i) {
+      if (is_full(ctrl_[i])) slots_[i].~value_type();
+    }
+    Memory::free(ctrl_);
+    Memory::free(slots_);
+  }
+
+private:
+  Ctrl* ctrl_;
+  value_type* slots_;
+  size_t capacity_;
+  size_t size_;
+  size_t growth_left_; // The number of empty slots that can be filled before growing
+  HashFcn hash_;
+  EqualKey equal_;
+};
+
+}} // namespace datastax::internal
+
+#endif
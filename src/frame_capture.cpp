@@ -0,0 +1,96 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "frame_capture.hpp"
+
+#include "logger.hpp"
+#include "scoped_lock.hpp"
+#include "serialization.hpp"
+
+#define FILE_BUFFER_SIZE (64 * 1024)
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+FrameCapture::FrameCapture(const String& path, size_t max_size)
+    : path_(path)
+    , max_size_(max_size)
+    , connection_id_(0)
+    , file_(NULL)
+    , file_size_(0) {
+  uv_mutex_init(&mutex_);
+}
+
+FrameCapture::~FrameCapture() {
+  if (file_ != NULL) {
+    fclose(file_);
+  }
+  uv_mutex_destroy(&mutex_);
+}
+
+bool FrameCapture::open() {
+  ScopedMutex l(&mutex_);
+  if (file_ != NULL) {
+    fclose(file_);
+  }
+  file_ = fopen(path_.c_str(), "wb");
+  if (file_ == NULL) {
+    LOG_ERROR("Unable to create the frame capture file '%s'", path_.c_str());
+    return false;
+  }
+  setvbuf(file_, NULL, _IOFBF, FILE_BUFFER_SIZE);
+  file_size_ = fwrite(FRAME_CAPTURE_MAGIC, 1, FRAME_CAPTURE_MAGIC_SIZE, file_);
+  return file_size_ == FRAME_CAPTURE_MAGIC_SIZE;
+}
+
+void FrameCapture::record(int32_t connection_id, Direction direction, const char* data,
+                          size_t size) {
+  char header[FRAME_CAPTURE_RECORD_HEADER_SIZE];
+  char* pos = encode_int64(header, static_cast<int64_t>(uv_hrtime()));
+  pos = encode_int32(pos, connection_id);
+  pos = encode_int8(pos, static_cast<int8_t>(direction));
+  encode_int32(pos, static_cast<int32_t>(size));
+
+  ScopedMutex l(&mutex_);
+  if (file_ == NULL) return;
+  if (file_size_ + sizeof(header) + size > max_size_ / 2 && !rotate()) return;
+  if (fwrite(header, 1, sizeof(header), file_) != sizeof(header) ||
+      fwrite(data, 1, size, file_) != size) {
+    LOG_ERROR("Unable to write to the frame capture file '%s'. Capturing is stopped",
+              path_.c_str());
+    fclose(file_);
+    file_ = NULL;
+    return;
+  }
+  file_size_ += sizeof(header) + size;
+}
+
+bool FrameCapture::rotate() {
+  String previous_path(path_ + ".1");
+  fclose(file_);
+  remove(previous_path.c_str()); // A rename doesn't replace a file on Windows
+  file_ = NULL;
+  if (rename(path_.c_str(), previous_path.c_str()) != 0 ||
+      (file_ = fopen(path_.c_str(), "wb")) == NULL) {
+    LOG_ERROR("Unable to rotate the frame capture file '%s'. Capturing is stopped",
+              path_.c_str());
+    return false;
+  }
+  setvbuf(file_, NULL, _IOFBF, FILE_BUFFER_SIZE);
+  file_size_ = fwrite(FRAME_CAPTURE_MAGIC, 1, FRAME_CAPTURE_MAGIC_SIZE, file_);
+  return true;
+}
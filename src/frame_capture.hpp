@@ -0,0 +1,108 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_FRAME_CAPTURE_HPP
+#define DATASTAX_INTERNAL_FRAME_CAPTURE_HPP
+
+#include "atomic.hpp"
+#include "macros.hpp"
+#include "ref_counted.hpp"
+#include "string.hpp"
+
+#include <stdio.h>
+#include <uv.h>
+
+// The file starts with the magic and every record has a fixed size header:
+// a monotonic timestamp in nanoseconds (int64), the connection ID (int32), the
+// direction (int8) and the frame's length (int32), all big-endian, followed by
+// the frame
+#define FRAME_CAPTURE_MAGIC "CASSCAP1"
+#define FRAME_CAPTURE_MAGIC_SIZE 8
+#define FRAME_CAPTURE_RECORD_HEADER_SIZE 17
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * Records the frames (envelopes) sent and received by connections with their
+ * timestamps so the traffic can be replayed offline, e.g. by the replay mock
+ * server (cassandra-replay-server). The captured frames are kept in a ring of
+ * two files on disk: once the current file reaches half of the maximum size
+ * it replaces the previous file (the path with a ".1" suffix) and a new
+ * current file is started, so the most recent traffic is always kept.
+ *
+ * Frames are written, buffered, on the connections' event loop threads under
+ * a lock. This is meant for diagnostics and not for production throughput.
+ */
+class FrameCapture : public RefCounted<FrameCapture> {
+public:
+  typedef SharedRefPtr<FrameCapture> Ptr;
+
+  enum Direction { DIRECTION_REQUEST = 0, DIRECTION_RESPONSE = 1 };
+
+  /**
+   * Constructor.
+   *
+   * @param path The path of the current capture file.
+   * @param max_size The maximum size of both capture files in bytes.
+   */
+  FrameCapture(const String& path, size_t max_size);
+
+  ~FrameCapture();
+
+  /**
+   * Create the current capture file, replacing an existing file.
+   *
+   * @return true if the file was created.
+   */
+  bool open();
+
+  /**
+   * A new ID that identifies a connection's frames in the capture.
+   */
+  int32_t next_connection_id() { return connection_id_.fetch_add(1, MEMORY_ORDER_RELAXED); }
+
+  /**
+   * Record a frame.
+   *
+   * @param connection_id The ID of the connection that sent or received the
+   * frame.
+   * @param direction Whether the frame is a request or a response.
+   * @param data The frame (its header and body).
+   * @param size The size of the frame.
+   */
+  void record(int32_t connection_id, Direction direction, const char* data, size_t size);
+
+  const String& path() const { return path_; }
+  size_t max_size() const { return max_size_; }
+
+private:
+  bool rotate();
+
+private:
+  const String path_;
+  const size_t max_size_;
+  Atomic<int32_t> connection_id_;
+  uv_mutex_t mutex_;
+  FILE* file_;
+  size_t file_size_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(FrameCapture);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -16,10 +16,12 @@
 
 #include "future.hpp"
 
+#include "callback_executor.hpp"
 #include "external.hpp"
 #include "prepared.hpp"
 #include "request_handler.hpp"
 #include "result_response.hpp"
+#include "scoped_lock.hpp"
 #include "scoped_ptr.hpp"
 
 using namespace datastax;
@@ -132,6 +134,22 @@ CassError cass_future_tracing_id(CassFuture* future, CassUuid* tracing_id) {
   return CASS_OK;
 }
 
+CassError cass_future_tracing_data(CassFuture* future, CassFuture** tracing_data_future) {
+  if (future->type() != Future::FUTURE_TYPE_RESPONSE) {
+    return CASS_ERROR_LIB_INVALID_FUTURE_TYPE;
+  }
+
+  Future::Ptr tracing_future(static_cast<ResponseFuture*>(future->from())->tracing_data_future());
+  if (!tracing_future) {
+    return CASS_ERROR_LIB_NO_TRACING_ID;
+  }
+
+  tracing_future->inc_ref();
+  *tracing_data_future = CassFuture::to(tracing_future.get());
+
+  return CASS_OK;
+}
+
 size_t cass_future_custom_payload_item_count(CassFuture* future) {
   if (future->type() != Future::FUTURE_TYPE_RESPONSE) {
     return 0;
@@ -173,31 +191,87 @@ const CassNode* cass_future_coordinator(CassFuture* future) {
 
 } // extern "C"
 
+Future::~Future() { delete waiter_.load(); }
+
 bool Future::set_callback(Future::Callback callback, void* data) {
-  ScopedMutex lock(&mutex_);
-  if (callback_) {
+  if (set_flags(FUTURE_CALLBACK_CLAIMED) & FUTURE_CALLBACK_CLAIMED) {
     return false; // Callback is already set
   }
   callback_ = callback;
   data_ = data;
-  if (is_set_) {
+  if (set_flags(FUTURE_CALLBACK_READY) & FUTURE_COMPLETED) {
     // Run the callback if the future is already set
-    lock.unlock();
-    callback(CassFuture::to(this), data);
+    run_callback();
   }
   return true;
 }
 
-void Future::internal_set(ScopedMutex& lock) {
-  is_set_ = true;
-  if (callback_) {
-    Callback callback = callback_;
-    void* data = data_;
-    lock.unlock();
-    callback(CassFuture::to(this), data);
-    lock.lock();
+void Future::internal_set() {
+  if (set_flags(FUTURE_COMPLETED) & FUTURE_CALLBACK_READY) {
+    if (callback_executor_) {
+      // The callback is run later, on another thread, so waiting threads
+      // don't see its side effects.
+      callback_executor_->execute(this);
+    } else {
+      run_callback();
+    }
+  }
+  // Mark the future as done after we've run the callback so that threads
+  // waiting on this future see the side effects of the callback.
+  if (set_flags(FUTURE_DONE) & FUTURE_WAITERS) {
+    Waiter* waiter = waiter_.load(MEMORY_ORDER_ACQUIRE);
+    ScopedMutex lock(&waiter->mutex);
+    uv_cond_broadcast(&waiter->cond);
+  }
+}
+
+void Future::internal_wait() {
+  if (ready() || is_callback_thread()) return;
+  Waiter* waiter = this->waiter();
+  ScopedMutex lock(&waiter->mutex);
+  set_flags(FUTURE_WAITERS);
+  while (!ready()) {
+    uv_cond_wait(&waiter->cond, lock.get());
   }
-  // Broadcast after we've run the callback so that threads waiting
-  // on this future see the side effects of the callback.
-  uv_cond_broadcast(&cond_);
+}
+
+bool Future::internal_wait_for(uint64_t timeout_us) {
+  if (ready() || is_callback_thread()) return true;
+  Waiter* waiter = this->waiter();
+  ScopedMutex lock(&waiter->mutex);
+  set_flags(FUTURE_WAITERS);
+  if (!ready()) {
+    if (uv_cond_timedwait(&waiter->cond, lock.get(), timeout_us * 1000) != 0) { // Expects nanos
+      return false;
+    }
+  }
+  return ready();
+}
+
+Future::Waiter* Future::waiter() {
+  Waiter* waiter = waiter_.load(MEMORY_ORDER_ACQUIRE);
+  if (waiter == NULL) {
+    Waiter* temp = new Waiter();
+    if (waiter_.compare_exchange_strong(waiter, temp)) {
+      waiter = temp;
+    } else {
+      delete temp; // Another thread created the waiter first
+    }
+  }
+  return waiter;
+}
+
+void Future::run_callback() {
+  // The future's results are set before it's marked completed, but it's only
+  // marked done after the callback returns. Record the thread running the
+  // callback so that it can access the results without waiting on itself.
+  callback_thread_ = uv_thread_self();
+  set_flags(FUTURE_IN_CALLBACK);
+  callback_(CassFuture::to(this), data_);
+}
+
+bool Future::is_callback_thread() {
+  if ((state_.load(MEMORY_ORDER_ACQUIRE) & FUTURE_IN_CALLBACK) == 0) return false;
+  uv_thread_t self = uv_thread_self();
+  return uv_thread_equal(&callback_thread_, &self) != 0;
 }
@@ -23,7 +23,6 @@
 #include "host.hpp"
 #include "macros.hpp"
 #include "ref_counted.hpp"
-#include "scoped_lock.hpp"
 #include "scoped_ptr.hpp"
 #include "string.hpp"
 
@@ -32,8 +31,16 @@
 
 namespace datastax { namespace internal { namespace core {
 
+class CallbackExecutor;
 struct Error;
 
+/**
+ * A future that's completed once, either with a result or an error, and then
+ * either notifies a callback or wakes threads waiting on it. The state is
+ * tracked using atomic flags so that setting a future that only has a callback
+ * doesn't lock a mutex or signal a condition variable; these are only created
+ * when a thread actually waits on the future.
+ */
 class Future : public RefCounted<Future> {
 public:
   typedef SharedRefPtr<Future> Ptr;
@@ -51,50 +58,37 @@ public:
   };
 
   Future(Type type)
-      : is_set_(false)
+      : state_(0)
+      , waiter_(NULL)
       , type_(type)
-      , callback_(NULL) {
-    uv_mutex_init(&mutex_);
-    uv_cond_init(&cond_);
-  }
+      , callback_(NULL)
+      , data_(NULL)
+      , callback_executor_(NULL) {}
 
-  virtual ~Future() {
-    uv_mutex_destroy(&mutex_);
-    uv_cond_destroy(&cond_);
-  }
+  virtual ~Future();
 
   Type type() const { return type_; }
 
-  bool ready() {
-    ScopedMutex lock(&mutex_);
-    return is_set_;
-  }
+  bool ready() { return (state_.load(MEMORY_ORDER_ACQUIRE) & FUTURE_DONE) != 0; }
 
-  virtual void wait() {
-    ScopedMutex lock(&mutex_);
-    internal_wait(lock);
-  }
+  virtual void wait() { internal_wait(); }
 
-  virtual bool wait_for(uint64_t timeout_us) {
-    ScopedMutex lock(&mutex_);
-    return internal_wait_for(lock, timeout_us);
-  }
+  virtual bool wait_for(uint64_t timeout_us) { return internal_wait_for(timeout_us); }
 
   Error* error() {
-    ScopedMutex lock(&mutex_);
-    internal_wait(lock);
+    internal_wait();
     return error_.get();
   }
 
   void set() {
-    ScopedMutex lock(&mutex_);
-    internal_set(lock);
+    if (internal_claim()) {
+      internal_set();
+    }
   }
 
   bool set_error(CassError code, const String& message) {
-    ScopedMutex lock(&mutex_);
-    if (!is_set_) {
-      internal_set_error(code, message, lock);
+    if (internal_claim()) {
+      internal_set_error(code, message);
       return true;
     }
     return false;
@@ -102,40 +96,95 @@ public:
 
   bool set_callback(Callback callback, void* data);
 
+  /**
+   * Run the callback using an executor, instead of on the thread that sets
+   * the future. This must be called before the future is returned to the
+   * application and the executor must outlive the future being set.
+   *
+   * @param executor The executor or NULL to run the callback in place.
+   */
+  void set_callback_executor(CallbackExecutor* executor) { callback_executor_ = executor; }
+
+  CallbackExecutor* callback_executor() const { return callback_executor_; }
+
 protected:
-  bool is_set() const { return is_set_; }
+  /**
+   * Claim the exclusive right to set the future. The claiming thread must then
+   * set its results and call internal_set() or internal_set_error().
+   *
+   * @return true if the future was claimed, false if the future was already
+   * claimed by another thread.
+   */
+  bool internal_claim() { return (set_flags(FUTURE_CLAIMED) & FUTURE_CLAIMED) == 0; }
+
+  void internal_set();
+
+  void internal_set_error(CassError code, const String& message) {
+    error_.reset(new Error(code, message));
+    internal_set();
+  }
+
+  void internal_wait();
+
+  bool internal_wait_for(uint64_t timeout_us);
+
+  /**
+   * A mutex that's only created on first use. This can be used by derived
+   * futures to protect state that's updated concurrently with being waited on.
+   */
+  uv_mutex_t* mutex() { return &waiter()->mutex; }
 
-  void internal_wait(ScopedMutex& lock) {
-    while (!is_set_) {
-      uv_cond_wait(&cond_, lock.get());
+private:
+  enum Flags {
+    FUTURE_CLAIMED = 0x01,
+    FUTURE_COMPLETED = 0x02,
+    FUTURE_DONE = 0x04,
+    FUTURE_CALLBACK_CLAIMED = 0x08,
+    FUTURE_CALLBACK_READY = 0x10,
+    FUTURE_WAITERS = 0x20,
+    FUTURE_IN_CALLBACK = 0x40
+  };
+
+  struct Waiter : public Allocated {
+    Waiter() {
+      uv_mutex_init(&mutex);
+      uv_cond_init(&cond);
     }
-  }
 
-  bool internal_wait_for(ScopedMutex& lock, uint64_t timeout_us) {
-    if (!is_set_) {
-      if (uv_cond_timedwait(&cond_, lock.get(), timeout_us * 1000) != 0) { // Expects nanos
-        return false;
-      }
+    ~Waiter() {
+      uv_mutex_destroy(&mutex);
+      uv_cond_destroy(&cond);
     }
-    return is_set_;
-  }
 
-  void internal_set(ScopedMutex& lock);
+    uv_mutex_t mutex;
+    uv_cond_t cond;
+  };
 
-  void internal_set_error(CassError code, const String& message, ScopedMutex& lock) {
-    error_.reset(new Error(code, message));
-    internal_set(lock);
+  int set_flags(int flags) {
+    int expected = state_.load(MEMORY_ORDER_RELAXED);
+    while (!state_.compare_exchange_weak(expected, expected | flags)) {
+    }
+    return expected;
   }
 
-  uv_mutex_t mutex_;
+  Waiter* waiter();
+
+  void run_callback();
+
+  bool is_callback_thread();
+
+private:
+  friend class CallbackExecutor;
 
 private:
-  bool is_set_;
-  uv_cond_t cond_;
+  Atomic<int> state_;
+  Atomic<Waiter*> waiter_;
   Type type_;
   ScopedPtr<Error> error_;
   Callback callback_;
   void* data_;
+  CallbackExecutor* callback_executor_;
+  uv_thread_t callback_thread_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(Future);
@@ -0,0 +1,143 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "future_group.hpp"
+
+#include "scoped_lock.hpp"
+
+#include <algorithm>
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+extern "C" {
+
+CassFutureGroup* cass_future_group_new(size_t queue_size) {
+  FutureGroup* group = new FutureGroup(queue_size);
+  group->inc_ref();
+  return CassFutureGroup::to(group);
+}
+
+void cass_future_group_free(CassFutureGroup* group) { group->dec_ref(); }
+
+CassError cass_future_group_add(CassFutureGroup* group, CassFuture* future) {
+  if (!group->add(future->from())) {
+    return CASS_ERROR_LIB_CALLBACK_ALREADY_SET;
+  }
+  return CASS_OK;
+}
+
+size_t cass_future_group_wait(CassFutureGroup* group, CassFuture** futures, size_t count,
+                              cass_duration_t timeout_us) {
+  return group->wait(futures, count, timeout_us);
+}
+
+} // extern "C"
+
+FutureGroup::FutureGroup(size_t queue_size)
+    : queue_(queue_size)
+    , waiters_(0)
+    , overflow_count_(0) {
+  uv_mutex_init(&mutex_);
+  uv_cond_init(&cond_);
+  uv_mutex_init(&overflow_mutex_);
+}
+
+FutureGroup::~FutureGroup() {
+  // Release the futures that were never drained
+  Future* future;
+  while (queue_.dequeue(future)) {
+    future->dec_ref();
+  }
+  for (Vector<Future*>::iterator it = overflow_.begin(), end = overflow_.end(); it != end; ++it) {
+    (*it)->dec_ref();
+  }
+  uv_mutex_destroy(&mutex_);
+  uv_cond_destroy(&cond_);
+  uv_mutex_destroy(&overflow_mutex_);
+}
+
+bool FutureGroup::add(Future* future) {
+  // The references are released when the future is drained and when the
+  // callback is run, respectively.
+  future->inc_ref();
+  inc_ref();
+  if (!future->set_callback(on_future_set, this)) {
+    future->dec_ref();
+    dec_ref();
+    return false;
+  }
+  return true;
+}
+
+size_t FutureGroup::wait(CassFuture** futures, size_t count, uint64_t timeout_us) {
+  size_t drained = drain(futures, count);
+  if (drained > 0 || timeout_us == 0) {
+    return drained;
+  }
+
+  uint64_t deadline = uv_hrtime() + timeout_us * 1000;
+  ScopedMutex lock(&mutex_);
+  waiters_.fetch_add(1);
+  // Make sure completions posted after this point see the waiter
+  MPMCQueue<Future*>::memory_fence();
+  while ((drained = drain(futures, count)) == 0) {
+    uint64_t now = uv_hrtime();
+    if (now >= deadline) break;
+    uv_cond_timedwait(&cond_, lock.get(), deadline - now); // Expects nanos
+  }
+  waiters_.fetch_sub(1);
+  return drained;
+}
+
+void FutureGroup::on_future_set(CassFuture* future, void* data) {
+  FutureGroup* group = static_cast<FutureGroup*>(data);
+  group->post(future->from());
+  group->dec_ref();
+}
+
+void FutureGroup::post(Future* future) {
+  if (!queue_.enqueue(future)) {
+    ScopedMutex lock(&overflow_mutex_);
+    overflow_.push_back(future);
+    overflow_count_.store(overflow_.size());
+  }
+  // Make sure the completion is visible before checking for waiters
+  MPMCQueue<Future*>::memory_fence();
+  if (waiters_.load() > 0) {
+    ScopedMutex lock(&mutex_);
+    uv_cond_signal(&cond_);
+  }
+}
+
+size_t FutureGroup::drain(CassFuture** futures, size_t count) {
+  size_t drained = 0;
+  Future* future;
+  while (drained < count && queue_.dequeue(future)) {
+    futures[drained++] = CassFuture::to(future);
+  }
+  if (drained < count && overflow_count_.load() > 0) {
+    ScopedMutex lock(&overflow_mutex_);
+    size_t n = std::min(count - drained, overflow_.size());
+    for (size_t i = 0; i < n; ++i) {
+      futures[drained++] = CassFuture::to(overflow_[i]);
+    }
+    overflow_.erase(overflow_.begin(), overflow_.begin() + n);
+    overflow_count_.store(overflow_.size());
+  }
+  return drained;
+}
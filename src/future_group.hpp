@@ -0,0 +1,97 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_FUTURE_GROUP_HPP
+#define DATASTAX_INTERNAL_FUTURE_GROUP_HPP
+
+#include "atomic.hpp"
+#include "cassandra.h"
+#include "external.hpp"
+#include "future.hpp"
+#include "macros.hpp"
+#include "mpmc_queue.hpp"
+#include "ref_counted.hpp"
+#include "vector.hpp"
+
+#include <uv.h>
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * A completion queue for many futures. Completed futures are posted to a
+ * lock-free queue and an application thread drains them in batches, instead
+ * of waiting on (and being woken up for) each future individually. A waiting
+ * thread is only signaled if it's blocked on an empty queue.
+ */
+class FutureGroup : public RefCounted<FutureGroup> {
+public:
+  typedef SharedRefPtr<FutureGroup> Ptr;
+
+  /**
+   * Constructor.
+   *
+   * @param queue_size The expected maximum number of completed futures that
+   * haven't been drained. Completions that don't fit in the queue are kept in a
+   * slower, locked overflow list.
+   */
+  FutureGroup(size_t queue_size);
+  ~FutureGroup();
+
+  /**
+   * Add a future to the group. The group holds a reference to the future until
+   * it's drained.
+   *
+   * @param future The future to add.
+   * @return false if the future already has a callback.
+   */
+  bool add(Future* future);
+
+  /**
+   * Drain completed futures, waiting if none are available.
+   *
+   * @param futures The output array for completed futures. The caller owns a
+   * reference to each future.
+   * @param count The maximum number of futures to drain.
+   * @param timeout_us The time to wait for a future to complete if none are
+   * available. Use 0 to return immediately.
+   * @return The number of futures drained.
+   */
+  size_t wait(CassFuture** futures, size_t count, uint64_t timeout_us);
+
+private:
+  static void on_future_set(CassFuture* future, void* data);
+
+  void post(Future* future);
+  size_t drain(CassFuture** futures, size_t count);
+
+private:
+  MPMCQueue<Future*> queue_;
+  uv_mutex_t mutex_;
+  uv_cond_t cond_;
+  Atomic<int> waiters_;
+  uv_mutex_t overflow_mutex_;
+  Atomic<size_t> overflow_count_;
+  Vector<Future*> overflow_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(FutureGroup);
+};
+
+}}} // namespace datastax::internal::core
+
+EXTERNAL_TYPE(datastax::internal::core::FutureGroup, CassFutureGroup)
+
+#endif
@@ -56,6 +56,8 @@ uint64_t get_time_monotonic_ns() {
   return time * ClockInfo::frequency();
 }
 
+uint64_t get_time_monotonic_coarse_ns() { return get_time_monotonic_ns(); }
+
 }} // namespace datastax::internal
 
 #endif // defined(__APPLE__) && defined(__MACH__)
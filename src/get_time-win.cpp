@@ -68,6 +68,11 @@ uint64_t get_time_monotonic_ns() {
   }
 }
 
+uint64_t get_time_monotonic_coarse_ns() {
+  // The tick count is updated every 10-16 milliseconds
+  return static_cast<uint64_t>(GetTickCount64()) * NANOSECONDS_PER_MILLISECOND;
+}
+
 }} // namespace datastax::internal
 
 #endif // defined(_WIN32)
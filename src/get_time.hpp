@@ -38,6 +38,13 @@ inline uint64_t get_time_since_epoch_ms() {
 // `get_time_since_epoch_us()` will be used.
 uint64_t get_time_monotonic_ns();
 
+// A cheaper monotonic clock with a resolution of a few milliseconds, for
+// timing that doesn't need the precision of `get_time_monotonic_ns()` on hot
+// paths (e.g. meters and circuit breaker periods). Its start time can differ
+// from `get_time_monotonic_ns()` so the two clocks can't be compared. If the
+// platform has no coarse clock then `get_time_monotonic_ns()` is used.
+uint64_t get_time_monotonic_coarse_ns();
+
 }} // namespace datastax::internal
 
 #endif
@@ -18,9 +18,11 @@
 
 #include "collection_iterator.hpp"
 #include "row.hpp"
+#include "scoped_lock.hpp"
 #include "value.hpp"
 
 using namespace datastax;
+using namespace datastax::internal;
 using namespace datastax::internal::core;
 
 namespace datastax { namespace internal { namespace core {
@@ -55,31 +57,89 @@ bool remove_host(CopyOnWriteHostVec& hosts, const Address& address) {
 
 }}} // namespace datastax::internal::core
 
+namespace {
+
+uv_once_t shard_key_guard = UV_ONCE_INIT;
+uv_key_t shard_key;
+Atomic<size_t> next_shard_index(0);
+
+void init_shard_key() { uv_key_create(&shard_key); }
+
+} // namespace
+
+size_t Host::LatencyTracker::shard_index() {
+  uv_once(&shard_key_guard, init_shard_key);
+  // The index is stored plus one so that a missing index is NULL
+  size_t index = reinterpret_cast<size_t>(uv_key_get(&shard_key));
+  if (index == 0) {
+    index = next_shard_index.fetch_add(1, MEMORY_ORDER_RELAXED) % NUM_SHARDS + 1;
+    uv_key_set(&shard_key, reinterpret_cast<void*>(index));
+  }
+  return index - 1;
+}
+
 void Host::LatencyTracker::update(uint64_t latency_ns) {
-  uint64_t now = uv_hrtime();
+  if (latency_ns > MAX_LATENCY_NS) latency_ns = MAX_LATENCY_NS;
+  Shard& shard = shards_[shard_index()];
+  uint64_t previous =
+      shard.packed.fetch_add((1ULL << COUNT_SHIFT) + latency_ns, MEMORY_ORDER_RELAXED);
+
+  // Merge early, well before either of the shard's fields can overflow
+  bool is_half_full = (previous >> COUNT_SHIFT) >= (1ULL << (63 - COUNT_SHIFT)) ||
+                      (previous & TOTAL_MASK) >= (TOTAL_MASK >> 1);
+  if (is_half_full ||
+      uv_hrtime() - last_merge_ns_.load(MEMORY_ORDER_RELAXED) >= MERGE_INTERVAL_NS) {
+    merge();
+  }
+}
 
-  ScopedSpinlock l(SpinlockPool<LatencyTracker>::get_spinlock(this));
+void Host::LatencyTracker::merge() {
+  if (is_merging_.exchange(true, MEMORY_ORDER_ACQUIRE)) {
+    return; // Another thread is already merging
+  }
 
-  TimestampedAverage previous = current_;
+  uint64_t now = uv_hrtime();
+  last_merge_ns_.store(now, MEMORY_ORDER_RELAXED);
+
+  uint64_t total_ns = 0;
+  uint64_t count = 0;
+  for (size_t i = 0; i < NUM_SHARDS; ++i) {
+    uint64_t packed = shards_[i].packed.exchange(0, MEMORY_ORDER_RELAXED);
+    count += packed >> COUNT_SHIFT;
+    total_ns += packed & TOTAL_MASK;
+  }
 
-  if (previous.num_measured < threshold_to_account_) {
-    current_.average = -1;
-  } else if (previous.average < 0) {
-    current_.average = latency_ns;
-  } else {
-    int64_t delay = now - previous.timestamp;
-    if (delay <= 0) {
-      return;
+  if (count > 0) {
+    // The latencies since the last merge are folded in as a single
+    // measurement of their mean.
+    uint64_t latency_ns = total_ns / count;
+    TimestampedAverage previous = get();
+    bool is_updated = true;
+
+    if (previous.num_measured < threshold_to_account_) {
+      average_.store(-1, MEMORY_ORDER_RELAXED);
+    } else if (previous.average < 0) {
+      average_.store(latency_ns, MEMORY_ORDER_RELAXED);
+    } else {
+      int64_t delay = now - previous.timestamp;
+      if (delay > 0) {
+        double scaled_delay = static_cast<double>(delay) / scale_ns_;
+        double weight = log(scaled_delay + 1) / scaled_delay;
+        average_.store(
+            static_cast<int64_t>((1.0 - weight) * latency_ns + weight * previous.average + 0.5),
+            MEMORY_ORDER_RELAXED);
+      } else {
+        is_updated = false;
+      }
     }
 
-    double scaled_delay = static_cast<double>(delay) / scale_ns_;
-    double weight = log(scaled_delay + 1) / scaled_delay;
-    current_.average =
-        static_cast<int64_t>((1.0 - weight) * latency_ns + weight * previous.average);
+    if (is_updated) {
+      num_measured_.store(previous.num_measured + count, MEMORY_ORDER_RELAXED);
+      timestamp_.store(now, MEMORY_ORDER_RELAXED);
+    }
   }
 
-  current_.num_measured = previous.num_measured + 1;
-  current_.timestamp = now;
+  is_merging_.store(false, MEMORY_ORDER_RELEASE);
 }
 
 bool VersionNumber::parse(const String& version) {
@@ -87,6 +147,25 @@ bool VersionNumber::parse(const String& version) {
          2;
 }
 
+bool Host::supported_options(StringMultimap* options) const {
+  ScopedMutex l(&supported_options_mutex_);
+  if (!is_supported_options_cached_) return false;
+  *options = supported_options_;
+  return true;
+}
+
+void Host::set_supported_options(const StringMultimap& options) {
+  ScopedMutex l(&supported_options_mutex_);
+  supported_options_ = options;
+  is_supported_options_cached_ = true;
+}
+
+void Host::clear_supported_options() {
+  ScopedMutex l(&supported_options_mutex_);
+  supported_options_.clear();
+  is_supported_options_cached_ = false;
+}
+
 void Host::set(const Row* row, bool use_tokens) {
   const Value* v;
 
@@ -99,8 +178,8 @@ void Host::set(const Row* row, bool use_tokens) {
   String release_version;
   row->get_string_by_name("release_version", &release_version);
 
-  rack_ = rack;
-  dc_ = dc;
+  rack_ = InternedString(rack);
+  dc_ = InternedString(dc);
 
   VersionNumber server_version;
   if (server_version.parse(release_version)) {
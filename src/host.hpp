@@ -21,17 +21,21 @@
 #include "allocated.hpp"
 #include "atomic.hpp"
 #include "copy_on_write_ptr.hpp"
+#include "decoder.hpp"
 #include "get_time.hpp"
+#include "interned_string.hpp"
 #include "logger.hpp"
 #include "macros.hpp"
 #include "map.hpp"
+#include "metrics.hpp"
+#include "protocol.hpp"
 #include "ref_counted.hpp"
 #include "scoped_ptr.hpp"
-#include "spin_lock.hpp"
 #include "vector.hpp"
 
 #include <math.h>
 #include <stdint.h>
+#include <uv.h>
 
 namespace datastax { namespace internal { namespace core {
 
@@ -101,7 +105,27 @@ public:
       , dc_id_(0)
       , address_string_(address.to_string())
       , connection_count_(0)
-      , inflight_request_count_(0) {}
+      , inflight_request_count_(0)
+      , consecutive_failures_(0)
+      , circuit_open_until_ns_(0)
+      , concurrency_limit_(0)
+      , connect_attempts_(0)
+      , warmup_start_ns_(0)
+      , warmup_requests_(0)
+      , reprepare_until_ns_(0)
+      , bytes_written_(0)
+      , bytes_read_(0)
+      , flushes_(0)
+      , flushed_requests_(0)
+      , max_connection_inflight_requests_(0)
+      , max_write_queue_bytes_(0)
+      , protocol_version_(0)
+      , latency_histogram_(NULL)
+      , is_supported_options_cached_(false) {
+    uv_mutex_init(&supported_options_mutex_);
+  }
+
+  ~Host() { uv_mutex_destroy(&supported_options_mutex_); }
 
   const Address& address() const { return address_; }
   const String& address_string() const { return address_string_; }
@@ -110,11 +134,13 @@ public:
 
   void set(const Row* row, bool use_tokens);
 
-  const String& rack() const { return rack_; }
-  const String& dc() const { return dc_; }
+  const String& rack() const { return rack_.str(); }
+  const String& dc() const { return dc_.str(); }
+  const InternedString& interned_rack() const { return rack_; }
+  const InternedString& interned_dc() const { return dc_; }
   void set_rack_and_dc(const String& rack, const String& dc) {
-    rack_ = rack;
-    dc_ = dc;
+    rack_ = InternedString(rack);
+    dc_ = InternedString(dc);
   }
 
   uint32_t rack_id() const { return rack_id_; }
@@ -136,7 +162,7 @@ public:
     OStringStream ss;
     ss << address_string_;
     if (!rack_.empty() || !dc_.empty()) {
-      ss << " [" << rack_ << ':' << dc_ << "]";
+      ss << " [" << rack_.str() << ':' << dc_.str() << "]";
     }
     return ss.str();
   }
@@ -161,6 +187,17 @@ public:
     return TimestampedAverage();
   }
 
+  /**
+   * Fold the latencies recorded since the last merge into the current
+   * average. This is called periodically by the latency-aware policy, but it
+   * also happens during updates if no merge has happened for a while.
+   */
+  void merge_latencies() {
+    if (latency_tracker_) {
+      latency_tracker_->merge();
+    }
+  }
+
   void increment_connection_count() { connection_count_.fetch_add(1, MEMORY_ORDER_RELAXED); }
 
   void decrement_connection_count() { connection_count_.fetch_sub(1, MEMORY_ORDER_RELAXED); }
@@ -175,24 +212,228 @@ public:
     return inflight_request_count_.load(MEMORY_ORDER_RELAXED);
   }
 
+  /**
+   * The host's circuit breaker state. This is only used by the CircuitBreaker.
+   */
+  Atomic<int32_t>& consecutive_failures() { return consecutive_failures_; }
+  Atomic<uint64_t>& circuit_open_until_ns() { return circuit_open_until_ns_; }
+
+  /**
+   * The host's adaptive concurrency limit. This is only used by the
+   * ConcurrencyLimiter.
+   */
+  Atomic<int32_t>& concurrency_limit() { return concurrency_limit_; }
+
+  /**
+   * The host's reconnection throttling state. This is only used by the
+   * ReconnectThrottle.
+   */
+  Atomic<int32_t>& connect_attempts() { return connect_attempts_; }
+  Atomic<uint64_t>& warmup_start_ns() { return warmup_start_ns_; }
+  Atomic<uint32_t>& warmup_requests() { return warmup_requests_; }
+
+  /**
+   * Start preparing the cached prepared statements again on the host after
+   * it responded with UNPREPARED.
+   *
+   * @param now_ns The current time from get_time_monotonic_coarse_ns().
+   * @param max_duration_ns The maximum time the host is considered to be
+   * preparing the statements, in case finish_reprepare() is never called.
+   * @return true if the caller should prepare the statements, otherwise false
+   * if the host is already preparing them.
+   */
+  bool try_start_reprepare(uint64_t now_ns, uint64_t max_duration_ns) {
+    uint64_t until_ns = reprepare_until_ns_.load(MEMORY_ORDER_RELAXED);
+    if (until_ns > now_ns) return false;
+    return reprepare_until_ns_.compare_exchange_strong(until_ns, now_ns + max_duration_ns);
+  }
+
+  void finish_reprepare() { reprepare_until_ns_.store(0, MEMORY_ORDER_RELAXED); }
+
+  /**
+   * Determine if the cached prepared statements are being prepared again on
+   * the host. Requests for prepared statements avoid the host until they're
+   * done.
+   *
+   * @param now_ns The current time from get_time_monotonic_coarse_ns().
+   * @return true if the statements are being prepared again.
+   */
+  bool is_repreparing(uint64_t now_ns) const {
+    return reprepare_until_ns_.load(MEMORY_ORDER_RELAXED) > now_ns;
+  }
+
+  /**
+   * Get the options from the host's SUPPORTED response that are cached by its
+   * connections so that later connections can skip the OPTIONS request.
+   *
+   * @param options The cached options (output).
+   * @return true if the options are cached, otherwise false.
+   */
+  bool supported_options(StringMultimap* options) const;
+
+  /**
+   * Cache the options from the host's SUPPORTED response. Options that are
+   * specific to a connection (e.g. its shard) must not be cached.
+   *
+   * @param options The options.
+   */
+  void set_supported_options(const StringMultimap& options);
+
+  /**
+   * Clear the cached options e.g. if the host rejected a connection that
+   * used them because the host's options changed after it was restarted.
+   */
+  void clear_supported_options();
+
+  /**
+   * Get the protocol version that connections to the host start with instead
+   * of the session's protocol version. This is the version negotiated by the
+   * host's last connection, or the version below the last one it rejected,
+   * so that later connections avoid a rejected handshake.
+   *
+   * @return The cached protocol version. It's invalid if no version has been
+   * negotiated with the host yet.
+   */
+  ProtocolVersion protocol_version() const {
+    return ProtocolVersion(protocol_version_.load(MEMORY_ORDER_RELAXED));
+  }
+
+  void set_protocol_version(ProtocolVersion version) {
+    protocol_version_.store(version.value(), MEMORY_ORDER_RELAXED);
+  }
+
+  /**
+   * Record a flush (a socket write of coalesced requests) on one of the
+   * host's connections.
+   *
+   * @param requests The number of requests in the flush.
+   * @param bytes The number of bytes written.
+   * @param write_queue_bytes The bytes still queued in the socket by earlier
+   * flushes.
+   */
+  void record_flush(size_t requests, size_t bytes, size_t write_queue_bytes) {
+    flushes_.fetch_add(1, MEMORY_ORDER_RELAXED);
+    flushed_requests_.fetch_add(requests, MEMORY_ORDER_RELAXED);
+    bytes_written_.fetch_add(bytes, MEMORY_ORDER_RELAXED);
+    update_max(max_write_queue_bytes_, static_cast<uint64_t>(write_queue_bytes));
+  }
+
+  /**
+   * Record a socket read on one of the host's connections.
+   *
+   * @param bytes The number of bytes read.
+   */
+  void record_read(size_t bytes) { bytes_read_.fetch_add(bytes, MEMORY_ORDER_RELAXED); }
+
+  /**
+   * Record the number of in-flight requests (stream IDs in use) on one of the
+   * host's connections.
+   *
+   * @param count The number of in-flight requests.
+   */
+  void record_connection_inflight_requests(int32_t count) {
+    update_max(max_connection_inflight_requests_, count);
+  }
+
+  uint64_t bytes_written() const { return bytes_written_.load(MEMORY_ORDER_RELAXED); }
+  uint64_t bytes_read() const { return bytes_read_.load(MEMORY_ORDER_RELAXED); }
+  uint64_t flushes() const { return flushes_.load(MEMORY_ORDER_RELAXED); }
+  uint64_t flushed_requests() const { return flushed_requests_.load(MEMORY_ORDER_RELAXED); }
+
+  /**
+   * The highest number of in-flight requests on any of the host's
+   * connections.
+   */
+  int32_t max_connection_inflight_requests() const {
+    return max_connection_inflight_requests_.load(MEMORY_ORDER_RELAXED);
+  }
+
+  /**
+   * The largest number of bytes queued in any of the host's sockets when
+   * requests were flushed.
+   */
+  uint64_t max_write_queue_bytes() const {
+    return max_write_queue_bytes_.load(MEMORY_ORDER_RELAXED);
+  }
+
+  /**
+   * The session's histogram for the latencies of the host's responses. This is
+   * NULL if per host metrics are disabled. It's set before the host is passed
+   * to the request processors.
+   */
+  Metrics::Histogram* latency_histogram() const { return latency_histogram_; }
+  void set_latency_histogram(Metrics::Histogram* histogram) { latency_histogram_ = histogram; }
+
+private:
+  template <class T>
+  static void update_max(Atomic<T>& max, T value) {
+    T current = max.load(MEMORY_ORDER_RELAXED);
+    while (value > current && !max.compare_exchange_weak(current, value)) {
+    }
+  }
+
 private:
+  /**
+   * Tracks a host's average latency. Latencies are recorded into per-thread
+   * shards without locking and are periodically merged into an exponentially
+   * weighted moving average. The average can be read without locking.
+   */
   class LatencyTracker : public Allocated {
   public:
+    // The number of shards. Threads share a shard if there are more threads.
+    static const size_t NUM_SHARDS = 16;
+    // Updates merge the shards if no merge has happened in this interval.
+    static const uint64_t MERGE_INTERVAL_NS = 100LL * 1000LL * 1000LL; // 100 ms
+
     LatencyTracker(uint64_t scale_ns, uint64_t threshold_to_account)
         : scale_ns_(scale_ns)
-        , threshold_to_account_(threshold_to_account) {}
+        , threshold_to_account_(threshold_to_account)
+        , average_(-1)
+        , timestamp_(0)
+        , num_measured_(0)
+        , last_merge_ns_(uv_hrtime())
+        , is_merging_(false) {}
 
     void update(uint64_t latency_ns);
 
+    void merge();
+
     TimestampedAverage get() const {
-      ScopedSpinlock l(SpinlockPool<LatencyTracker>::get_spinlock(this));
-      return current_;
+      TimestampedAverage current;
+      current.average = average_.load(MEMORY_ORDER_RELAXED);
+      current.timestamp = timestamp_.load(MEMORY_ORDER_RELAXED);
+      current.num_measured = num_measured_.load(MEMORY_ORDER_RELAXED);
+      return current;
     }
 
   private:
-    uint64_t scale_ns_;
-    uint64_t threshold_to_account_;
-    TimestampedAverage current_;
+    // A shard's count (the high bits) and total (the low bits) are packed into
+    // a single word so that a merge always takes a latency's count and total
+    // together.
+    static const int COUNT_SHIFT = 44;
+    static const uint64_t TOTAL_MASK = (1ULL << COUNT_SHIFT) - 1;
+    // Latencies are capped so that a single update can't overflow the total
+    static const uint64_t MAX_LATENCY_NS = 1ULL << 40;
+
+    struct Shard {
+      Shard()
+          : packed(0) {}
+
+      Atomic<uint64_t> packed;
+      char pad[64 - sizeof(uint64_t)]; // Avoid false sharing between threads
+    };
+
+    static size_t shard_index();
+
+  private:
+    const uint64_t scale_ns_;
+    const uint64_t threshold_to_account_;
+    Shard shards_[NUM_SHARDS];
+    Atomic<int64_t> average_;
+    Atomic<uint64_t> timestamp_;
+    Atomic<uint64_t> num_measured_;
+    Atomic<uint64_t> last_merge_ns_;
+    Atomic<bool> is_merging_;
 
   private:
     DISALLOW_COPY_AND_ASSIGN(LatencyTracker);
@@ -206,12 +447,31 @@ private:
   String address_string_;
   VersionNumber server_version_;
   VersionNumber dse_server_version_;
-  String rack_;
-  String dc_;
+  InternedString rack_;
+  InternedString dc_;
   String partitioner_;
   Vector<String> tokens_;
   Atomic<int32_t> connection_count_;
   Atomic<int32_t> inflight_request_count_;
+  Atomic<int32_t> consecutive_failures_;
+  Atomic<uint64_t> circuit_open_until_ns_; // Zero if the circuit is closed
+  Atomic<int32_t> concurrency_limit_;      // Zero until the limit first changes
+  Atomic<int32_t> connect_attempts_;       // Connection attempts in progress
+  Atomic<uint64_t> warmup_start_ns_;       // Zero if the host isn't warming up
+  Atomic<uint32_t> warmup_requests_;
+  Atomic<uint64_t> reprepare_until_ns_; // Zero if statements aren't being prepared again
+  Atomic<uint64_t> bytes_written_;
+  Atomic<uint64_t> bytes_read_;
+  Atomic<uint64_t> flushes_;
+  Atomic<uint64_t> flushed_requests_;
+  Atomic<int32_t> max_connection_inflight_requests_;
+  Atomic<uint64_t> max_write_queue_bytes_;
+  Atomic<int32_t> protocol_version_; // Zero if unknown
+  Metrics::Histogram* latency_histogram_;
+
+  mutable uv_mutex_t supported_options_mutex_;
+  StringMultimap supported_options_;
+  bool is_supported_options_cached_;
 
   ScopedPtr<LatencyTracker> latency_tracker_;
 
@@ -284,6 +544,31 @@ private:
 
 typedef Map<Address, Host::Ptr> HostMap;
 
+/**
+ * An immutable, versioned snapshot of the cluster's hosts. A single snapshot
+ * is shared by all the request processors, instead of each processor copying
+ * the host map, and changes after it was taken are sent to the processors as
+ * individual host add/remove notifications.
+ */
+class HostTable : public RefCounted<HostTable> {
+public:
+  typedef SharedRefPtr<const HostTable> ConstPtr;
+
+  HostTable(const HostMap& hosts, uint64_t version)
+      : hosts_(hosts)
+      , version_(version) {}
+
+  const HostMap& hosts() const { return hosts_; }
+  uint64_t version() const { return version_; }
+
+private:
+  const HostMap hosts_;
+  const uint64_t version_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(HostTable);
+};
+
 struct GetAddress {
   typedef std::pair<Address, Host::Ptr> Pair;
   const Address& operator()(const Pair& pair) const { return pair.first; }
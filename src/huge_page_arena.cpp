@@ -0,0 +1,107 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#include "huge_page_arena.hpp"
+
+#include "logger.hpp"
+
+#include <assert.h>
+#include <stdint.h>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+// Allocations are aligned to cache lines so that buffers used by different
+// connections don't share them
+#define ALLOCATION_ALIGNMENT 64
+
+using namespace datastax::internal;
+
+HugePageArena::HugePageArena(size_t size)
+    : data_(NULL)
+    , size_((size + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE)
+    , used_(0)
+    , is_huge_tlb_(false) {
+#if defined(__linux__)
+#if defined(MAP_HUGETLB)
+  void* data = mmap(NULL, size_, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  if (data != MAP_FAILED) {
+    data_ = data;
+    is_huge_tlb_ = true;
+    return;
+  }
+#endif
+  // No huge pages are reserved so map an extra huge page to align the region
+  // to the huge page size, which transparent huge pages require
+  size_t mapped_size = size_ + HUGE_PAGE_SIZE;
+  char* mapped = static_cast<char*>(
+      mmap(NULL, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+  if (mapped == MAP_FAILED) {
+    LOG_WARN("Unable to map %u bytes for huge page buffers",
+             static_cast<unsigned int>(mapped_size));
+    return;
+  }
+  char* aligned = reinterpret_cast<char*>(
+      (reinterpret_cast<uintptr_t>(mapped) + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1));
+  if (aligned > mapped) {
+    munmap(mapped, aligned - mapped);
+  }
+  size_t trailing = (mapped + mapped_size) - (aligned + size_);
+  if (trailing > 0) {
+    munmap(aligned + size_, trailing);
+  }
+  data_ = aligned;
+#if defined(MADV_HUGEPAGE)
+  if (madvise(data_, size_, MADV_HUGEPAGE) != 0) {
+    LOG_DEBUG("Transparent huge pages are unavailable for the buffer pools");
+  }
+#endif
+#else
+  LOG_DEBUG("Huge page buffers are only supported on Linux");
+#endif
+}
+
+HugePageArena::~HugePageArena() {
+#if defined(__linux__)
+  if (data_ != NULL) {
+    munmap(data_, size_);
+  }
+#endif
+}
+
+void* HugePageArena::allocate_unreferenced(size_t size) {
+  size_t aligned_size = (size + ALLOCATION_ALIGNMENT - 1) & ~(ALLOCATION_ALIGNMENT - 1);
+  if (data_ == NULL || size_ - used_ < aligned_size) return NULL;
+  void* ptr = static_cast<char*>(data_) + used_;
+  used_ += aligned_size;
+  return ptr;
+}
+
+void* HugePageArena::allocate(size_t size) {
+  void* ptr = allocate_unreferenced(size);
+  if (ptr != NULL) {
+    inc_ref(); // Released with the memory
+  }
+  return ptr;
+}
+
+void HugePageArena::release(void* ptr) {
+  assert(contains(ptr));
+  dec_ref();
+}
@@ -0,0 +1,111 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#ifndef DATASTAX_INTERNAL_HUGE_PAGE_ARENA_HPP
+#define DATASTAX_INTERNAL_HUGE_PAGE_ARENA_HPP
+
+#include "macros.hpp"
+#include "ref_counted.hpp"
+
+namespace datastax { namespace internal {
+
+/**
+ * A region of memory backed by huge pages (2 MB on x86-64) for an event loop's
+ * buffer pools, so that the pools' buffers are covered by a few TLB entries.
+ * Explicit huge pages (MAP_HUGETLB) are used if the system has reserved some,
+ * otherwise the region is aligned to the huge page size and the kernel is
+ * asked to back it with transparent huge pages. Huge pages are only supported
+ * on Linux; elsewhere the arena is empty and the pools allocate their buffers
+ * as usual.
+ *
+ * The memory is handed out sequentially and isn't reused. Its region is
+ * unmapped once the arena and all of the buffers placed in it are released.
+ * Memory can only be allocated on one thread, but buffers can be released on
+ * any thread.
+ */
+class HugePageArena
+    : public RefCounted<HugePageArena>
+    , public RefBuffer::Arena {
+public:
+  typedef SharedRefPtr<HugePageArena> Ptr;
+
+  static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+  /**
+   * Constructor.
+   *
+   * @param size The minimum size of the region. It's rounded up to a
+   * multiple of the huge page size.
+   */
+  HugePageArena(size_t size);
+
+  ~HugePageArena();
+
+  /**
+   * Determine if the region was mapped. If it wasn't, every allocation fails.
+   *
+   * @return true if the region was mapped.
+   */
+  bool is_mapped() const { return data_ != NULL; }
+
+  /**
+   * Determine if the region uses explicit huge pages instead of transparent
+   * huge pages.
+   *
+   * @return true if the region was mapped using MAP_HUGETLB.
+   */
+  bool is_huge_tlb() const { return is_huge_tlb_; }
+
+  /**
+   * Determine if memory was allocated from the arena.
+   *
+   * @param ptr The memory.
+   * @return true if the memory is in the arena's region.
+   */
+  bool contains(const void* ptr) const {
+    return ptr >= data_ && ptr < static_cast<const char*>(data_) + size_;
+  }
+
+  /**
+   * Allocate memory without a reference to the arena. The memory is only
+   * valid while the arena is referenced.
+   *
+   * @param size The size of the memory.
+   * @return The memory or NULL if the arena is out of space.
+   */
+  void* allocate_unreferenced(size_t size);
+
+  /**
+   * Allocate memory for a buffer. Each allocation holds a reference to the
+   * arena until it's released.
+   */
+  virtual void* allocate(size_t size);
+  virtual void release(void* ptr);
+
+private:
+  void* data_;
+  size_t size_;
+  size_t used_;
+  bool is_huge_tlb_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(HugePageArena);
+};
+
+}} // namespace datastax::internal
+
+#endif
@@ -0,0 +1,135 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#include "inflight_limiter.hpp"
+
+#include "memory_accounting.hpp"
+#include "request_handler.hpp"
+#include "scoped_lock.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+InflightLimiter::InflightLimiter(unsigned max_requests, uint64_t max_buffer_bytes, bool wait,
+                                 InflightLimiterListener* listener)
+    : max_requests_(max_requests)
+    , max_buffer_bytes_(max_buffer_bytes)
+    , wait_(wait)
+    , listener_(listener)
+    , inflight_request_count_(0)
+    , waiting_request_count_(0)
+    , is_closed_(false) {
+  uv_mutex_init(&mutex_);
+}
+
+InflightLimiter::~InflightLimiter() {
+  close();
+  uv_mutex_destroy(&mutex_);
+}
+
+bool InflightLimiter::acquire(const RequestHandler::Ptr& request_handler) {
+  if (try_acquire()) {
+    request_handler->set_inflight_limiter(Ptr(this));
+    return true;
+  }
+
+  if (!wait_) {
+    request_handler->set_error(CASS_ERROR_LIB_REQUEST_QUEUE_FULL,
+                               is_over_memory_limit()
+                                   ? "The session's memory limit has been reached"
+                                   : "The session's in-flight request limit has been reached");
+    return false;
+  }
+
+  {
+    ScopedMutex l(&mutex_);
+    if (is_closed_) {
+      l.unlock();
+      request_handler->set_error(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, "Session is closed");
+      return false;
+    }
+    request_handler->inc_ref(); // Waiting reference
+    waiting_.push_back(request_handler.get());
+    waiting_request_count_.fetch_add(1);
+  }
+
+  // A slot may have been released before the request was added
+  drain();
+  return false;
+}
+
+void InflightLimiter::release() {
+  inflight_request_count_.fetch_sub(1);
+  if (waiting_request_count_.load() > 0) {
+    drain();
+  }
+}
+
+void InflightLimiter::close() {
+  Deque<RequestHandler*> waiting;
+  {
+    ScopedMutex l(&mutex_);
+    is_closed_ = true;
+    waiting.swap(waiting_);
+    waiting_request_count_.store(0);
+  }
+
+  for (Deque<RequestHandler*>::iterator it = waiting.begin(), end = waiting.end(); it != end;
+       ++it) {
+    (*it)->set_error(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, "Session is closed");
+    (*it)->dec_ref();
+  }
+}
+
+bool InflightLimiter::try_acquire() {
+  unsigned count = inflight_request_count_.load(MEMORY_ORDER_RELAXED);
+  while (max_requests_ == 0 || count < max_requests_) {
+    // A request is always started if none are in flight. Otherwise, the
+    // deferred requests could wait forever on memory that isn't released by
+    // requests completing.
+    if (count > 0 && is_over_memory_limit()) {
+      return false;
+    }
+    if (inflight_request_count_.compare_exchange_weak(count, count + 1)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool InflightLimiter::is_over_memory_limit() const {
+  return max_buffer_bytes_ > 0 && MemoryAccounting::buffer_bytes() > max_buffer_bytes_;
+}
+
+void InflightLimiter::drain() {
+  for (;;) {
+    RequestHandler* request_handler = NULL;
+    {
+      ScopedMutex l(&mutex_);
+      if (is_closed_ || waiting_.empty() || !try_acquire()) return;
+      request_handler = waiting_.front();
+      waiting_.pop_front();
+      waiting_request_count_.fetch_sub(1);
+    }
+
+    RequestHandler::Ptr temp(request_handler);
+    request_handler->dec_ref(); // Waiting reference
+    temp->set_inflight_limiter(Ptr(this));
+    listener_->on_dispatch(temp);
+  }
+}
@@ -0,0 +1,122 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#ifndef DATASTAX_INTERNAL_INFLIGHT_LIMITER_HPP
+#define DATASTAX_INTERNAL_INFLIGHT_LIMITER_HPP
+
+#include "atomic.hpp"
+#include "deque.hpp"
+#include "macros.hpp"
+#include "ref_counted.hpp"
+
+#include <uv.h>
+
+namespace datastax { namespace internal { namespace core {
+
+class RequestHandler;
+
+/**
+ * A listener for requests that were deferred by the limiter and can now be
+ * started.
+ */
+class InflightLimiterListener {
+public:
+  virtual ~InflightLimiterListener() {}
+
+  /**
+   * A callback that's called when a deferred request acquires a slot. This can
+   * be called on any thread.
+   *
+   * @param request_handler The request to start.
+   */
+  virtual void on_dispatch(const SharedRefPtr<RequestHandler>& request_handler) = 0;
+};
+
+/**
+ * A session-wide limit on the number of in-flight requests and on the memory
+ * used by request and response buffers. Requests over the limits either fail
+ * immediately or are deferred until a running request completes.
+ */
+class InflightLimiter : public RefCounted<InflightLimiter> {
+public:
+  typedef SharedRefPtr<InflightLimiter> Ptr;
+
+  /**
+   * Constructor.
+   *
+   * @param max_requests The maximum number of in-flight requests or zero for
+   * no limit.
+   * @param max_buffer_bytes The buffer memory (see
+   * `MemoryAccounting::buffer_bytes()`) over which requests aren't started or
+   * zero for no limit. A request is always started if there are none in
+   * flight.
+   * @param wait If true, requests over the limit are deferred instead of
+   * failed.
+   * @param listener A listener that's notified when deferred requests can be
+   * started.
+   */
+  InflightLimiter(unsigned max_requests, uint64_t max_buffer_bytes, bool wait,
+                  InflightLimiterListener* listener);
+  ~InflightLimiter();
+
+  /**
+   * Acquire a slot for a request. If the limit has been reached then the
+   * request is either deferred or failed with
+   * CASS_ERROR_LIB_REQUEST_QUEUE_FULL.
+   *
+   * @param request_handler The request.
+   * @return true if the request should be started now.
+   */
+  bool acquire(const SharedRefPtr<RequestHandler>& request_handler);
+
+  /**
+   * Release a request's slot, starting a deferred request if there is one.
+   */
+  void release();
+
+  /**
+   * Fail any deferred requests and stop deferring new requests.
+   */
+  void close();
+
+  unsigned inflight_request_count() const { return inflight_request_count_.load(); }
+  unsigned waiting_request_count() const { return waiting_request_count_.load(); }
+  uint64_t max_buffer_bytes() const { return max_buffer_bytes_; }
+
+private:
+  bool try_acquire();
+  bool is_over_memory_limit() const;
+  void drain();
+
+private:
+  const unsigned max_requests_;
+  const uint64_t max_buffer_bytes_;
+  const bool wait_;
+  InflightLimiterListener* const listener_;
+  Atomic<unsigned> inflight_request_count_;
+  Atomic<unsigned> waiting_request_count_;
+  uv_mutex_t mutex_;
+  bool is_closed_;
+  Deque<RequestHandler*> waiting_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(InflightLimiter);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
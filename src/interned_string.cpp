@@ -0,0 +1,72 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "interned_string.hpp"
+
+#include "flat_hash_map.hpp"
+#include "scoped_lock.hpp"
+
+#include <uv.h>
+
+using namespace datastax;
+using namespace datastax::internal;
+
+namespace {
+
+typedef FlatHashMap<String, const void*> EntryMap;
+
+uv_once_t init_guard = UV_ONCE_INIT;
+uv_rwlock_t rwlock;
+EntryMap* entries = NULL;
+
+void init() {
+  uv_rwlock_init(&rwlock);
+  entries = new (Memory::malloc(sizeof(EntryMap))) EntryMap();
+}
+
+const void* find_entry(const String& str) {
+  ScopedReadLock rl(&rwlock);
+  EntryMap::const_iterator it = entries->find(str);
+  return it != entries->end() ? it->second : NULL;
+}
+
+} // namespace
+
+InternedString InternedString::find(const String& str) {
+  if (str.empty()) return InternedString();
+  uv_once(&init_guard, init);
+  return InternedString(static_cast<const Entry*>(find_entry(str)));
+}
+
+const InternedString::Entry* InternedString::intern(const String& str) {
+  if (str.empty()) return NULL;
+  uv_once(&init_guard, init);
+
+  const Entry* entry = static_cast<const Entry*>(find_entry(str));
+  if (entry != NULL) return entry;
+
+  ScopedWriteLock wl(&rwlock);
+  const void*& value = (*entries)[str];
+  if (value == NULL) { // It may have been interned while the lock was released
+    value = new Entry(str, SPARSEHASH_HASH<String>()(str));
+  }
+  return static_cast<const Entry*>(value);
+}
+
+const String& InternedString::empty_string() {
+  static const String empty;
+  return empty;
+}
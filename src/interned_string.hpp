@@ -0,0 +1,110 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_INTERNED_STRING_HPP
+#define DATASTAX_INTERNAL_INTERNED_STRING_HPP
+
+#include "allocated.hpp"
+#include "string.hpp"
+
+#include <stddef.h>
+
+namespace datastax { namespace internal {
+
+/**
+ * A string, such as a keyspace, table or datacenter name, that's stored once
+ * in a global table and shared by all of its copies. Interned strings are
+ * compared by pointer and their hash is computed once, so they're cheap to
+ * use as keys on the request path.
+ *
+ * Interning takes a lock, so strings should be interned when they're set
+ * (e.g. when a statement's keyspace is set or metadata is updated) instead of
+ * for every request. Interned strings are never freed; this is intended for
+ * the small set of names of a cluster's schema and topology.
+ */
+class InternedString {
+public:
+  /**
+   * Constructor. An empty string.
+   */
+  InternedString()
+      : entry_(NULL) {}
+
+  /**
+   * Constructor. Interns a string.
+   *
+   * @param str The string to intern.
+   */
+  explicit InternedString(const String& str)
+      : entry_(intern(str)) {}
+
+  /**
+   * Find a string that's already interned without interning it.
+   *
+   * @param str The string to find.
+   * @return The interned string, otherwise an empty string if it has never
+   * been interned.
+   */
+  static InternedString find(const String& str);
+
+  const String& str() const { return entry_ != NULL ? entry_->str : empty_string(); }
+  const char* c_str() const { return str().c_str(); }
+  bool empty() const { return entry_ == NULL; }
+  size_t hash() const { return entry_ != NULL ? entry_->hash : 0; }
+
+  bool operator==(const InternedString& other) const { return entry_ == other.entry_; }
+  bool operator!=(const InternedString& other) const { return entry_ != other.entry_; }
+
+private:
+  struct Entry : public Allocated {
+    Entry(const String& str, size_t hash)
+        : str(str)
+        , hash(hash) {}
+
+    const String str;
+    const size_t hash;
+  };
+
+  explicit InternedString(const Entry* entry)
+      : entry_(entry) {}
+
+  static const Entry* intern(const String& str);
+  static const String& empty_string();
+
+private:
+  const Entry* entry_;
+};
+
+}} // namespace datastax::internal
+
+namespace std {
+
+#if defined(HASH_IN_TR1) && !defined(_WIN32)
+namespace tr1 {
+#endif
+
+template <>
+struct hash<datastax::internal::InternedString> {
+  size_t operator()(const datastax::internal::InternedString& str) const { return str.hash(); }
+};
+
+#if defined(HASH_IN_TR1) && !defined(_WIN32)
+} // namespace tr1
+#endif
+
+} // namespace std
+
+#endif
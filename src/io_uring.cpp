@@ -0,0 +1,333 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "io_uring.hpp"
+
+#ifdef HAVE_IO_URING
+
+#include "logger.hpp"
+
+#include <errno.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// The number of operations that can be queued before they're submitted
+#define IO_URING_ENTRIES 256
+
+// Each multishot receive can complete many times before the completions are
+// processed so the completion queue is much larger than the submission queue
+#define IO_URING_CQ_ENTRIES 4096
+
+// The registered receive buffers (a power of 2) and their size. They come
+// from a buffer pool so they're reused once they're no longer referenced. A
+// multishot receive that runs out of buffers is restarted.
+#define IO_URING_BUFFER_COUNT 16
+#define IO_URING_BUFFER_SIZE (64 * 1024)
+#define IO_URING_BUFFER_GROUP 0
+
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+static int io_uring_setup(unsigned entries, struct io_uring_params* params) {
+  int fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+  return fd < 0 ? -errno : fd;
+}
+
+static int io_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+  int rc = static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags,
+                                    NULL, 0));
+  return rc < 0 ? -errno : rc;
+}
+
+static int io_uring_register(int fd, unsigned opcode, void* arg, unsigned nr_args) {
+  int rc = static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+  return rc < 0 ? -errno : rc;
+}
+
+IoUring::IoUring()
+    : fd_(-1)
+    , sq_ptr_(MAP_FAILED)
+    , sq_size_(0)
+    , cq_ptr_(MAP_FAILED)
+    , cq_size_(0)
+    , sqes_(static_cast<struct io_uring_sqe*>(MAP_FAILED))
+    , sqes_size_(0)
+    , sq_head_(NULL)
+    , sq_tail_(NULL)
+    , sq_flags_(NULL)
+    , sq_mask_(0)
+    , sq_array_(NULL)
+    , sq_entries_(0)
+    , pending_(0)
+    , active_(0)
+    , is_closing_(false)
+    , cq_head_(NULL)
+    , cq_tail_(NULL)
+    , cq_mask_(0)
+    , cqes_(NULL)
+    , buf_ring_(static_cast<struct io_uring_buf_ring*>(MAP_FAILED))
+    , buf_ring_size_(0)
+    , buf_tail_(0)
+    , buffer_pool_(new BufferPool())
+    , poll_(NULL) {}
+
+IoUring::~IoUring() {
+  close_handles();
+  if (buf_ring_ != MAP_FAILED) munmap(buf_ring_, buf_ring_size_);
+  if (sqes_ != MAP_FAILED) munmap(sqes_, sqes_size_);
+  if (cq_ptr_ != MAP_FAILED && cq_ptr_ != sq_ptr_) munmap(cq_ptr_, cq_size_);
+  if (sq_ptr_ != MAP_FAILED) munmap(sq_ptr_, sq_size_);
+  if (fd_ >= 0) ::close(fd_);
+}
+
+int IoUring::init(uv_loop_t* loop) {
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  // Only the event loop's thread submits. This also requires Linux 6.0, the
+  // first version with multishot receives.
+  params.flags = IORING_SETUP_CQSIZE | IORING_SETUP_SINGLE_ISSUER;
+  params.cq_entries = IO_URING_CQ_ENTRIES;
+
+  fd_ = io_uring_setup(IO_URING_ENTRIES, &params);
+  if (fd_ < 0) {
+    int rc = fd_;
+    fd_ = -1;
+    return rc;
+  }
+
+  sq_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cq_size_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  if (params.features & IORING_FEAT_SINGLE_MMAP) {
+    if (cq_size_ > sq_size_) sq_size_ = cq_size_;
+    cq_size_ = sq_size_;
+  }
+
+  sq_ptr_ = mmap(NULL, sq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_,
+                 IORING_OFF_SQ_RING);
+  if (sq_ptr_ == MAP_FAILED) return -errno;
+
+  if (params.features & IORING_FEAT_SINGLE_MMAP) {
+    cq_ptr_ = sq_ptr_;
+  } else {
+    cq_ptr_ = mmap(NULL, cq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_,
+                   IORING_OFF_CQ_RING);
+    if (cq_ptr_ == MAP_FAILED) return -errno;
+  }
+
+  sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+  sqes_ = static_cast<struct io_uring_sqe*>(mmap(NULL, sqes_size_, PROT_READ | PROT_WRITE,
+                                                 MAP_SHARED | MAP_POPULATE, fd_,
+                                                 IORING_OFF_SQES));
+  if (sqes_ == MAP_FAILED) return -errno;
+
+  char* sq = static_cast<char*>(sq_ptr_);
+  sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+  sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+  sq_flags_ = reinterpret_cast<unsigned*>(sq + params.sq_off.flags);
+  sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+  sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+  sq_entries_ = params.sq_entries;
+
+  char* cq = static_cast<char*>(cq_ptr_);
+  cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+  cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+  cqes_ = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+
+  // Register the ring of receive buffers. The ring is page aligned.
+  buf_ring_size_ = IO_URING_BUFFER_COUNT * sizeof(struct io_uring_buf);
+  buf_ring_ = static_cast<struct io_uring_buf_ring*>(
+      mmap(NULL, buf_ring_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+  if (buf_ring_ == MAP_FAILED) return -errno;
+
+  struct io_uring_buf_reg reg;
+  memset(&reg, 0, sizeof(reg));
+  reg.ring_addr = reinterpret_cast<uint64_t>(buf_ring_);
+  reg.ring_entries = IO_URING_BUFFER_COUNT;
+  reg.bgid = IO_URING_BUFFER_GROUP;
+  int rc = io_uring_register(fd_, IORING_REGISTER_PBUF_RING, &reg, 1);
+  if (rc < 0) return rc;
+
+  buffers_.resize(IO_URING_BUFFER_COUNT);
+  for (unsigned short bid = 0; bid < IO_URING_BUFFER_COUNT; ++bid) {
+    provide_buffer(bid);
+  }
+
+  poll_ = new AllocatedT<uv_poll_t>();
+  poll_->data = this;
+  rc = uv_poll_init(loop, poll_, fd_);
+  if (rc != 0) {
+    delete poll_;
+    poll_ = NULL;
+    return rc;
+  }
+  rc = uv_poll_start(poll_, UV_READABLE, on_poll);
+  if (rc != 0) return rc;
+
+  return prepare_.start(loop, bind_callback(&IoUring::on_prepare, this));
+}
+
+void IoUring::close() {
+  is_closing_ = true;
+  if (active_ == 0) {
+    close_handles();
+  }
+}
+
+void IoUring::close_handles() {
+  prepare_.close_handle();
+  if (poll_ != NULL) {
+    uv_close(reinterpret_cast<uv_handle_t*>(poll_), on_close);
+    poll_ = NULL;
+  }
+}
+
+bool IoUring::recv_multishot(int fd, Operation* op) {
+  struct io_uring_sqe* sqe = get_sqe();
+  if (sqe == NULL) return false;
+  sqe->opcode = IORING_OP_RECV;
+  sqe->fd = fd;
+  sqe->ioprio = IORING_RECV_MULTISHOT;
+  sqe->flags = IOSQE_BUFFER_SELECT;
+  sqe->buf_group = IO_URING_BUFFER_GROUP;
+  sqe->user_data = reinterpret_cast<uint64_t>(op);
+  ++active_;
+  return true;
+}
+
+bool IoUring::sendmsg(int fd, const struct msghdr* msg, Operation* op) {
+  struct io_uring_sqe* sqe = get_sqe();
+  if (sqe == NULL) return false;
+  sqe->opcode = IORING_OP_SENDMSG;
+  sqe->fd = fd;
+  sqe->addr = reinterpret_cast<uint64_t>(msg);
+  sqe->len = 1;
+  // Retry short sends until all the data is sent
+  sqe->msg_flags = MSG_NOSIGNAL | MSG_WAITALL;
+  sqe->user_data = reinterpret_cast<uint64_t>(op);
+  ++active_;
+  return true;
+}
+
+bool IoUring::cancel(Operation* op) {
+  struct io_uring_sqe* sqe = get_sqe();
+  if (sqe == NULL) return false;
+  sqe->opcode = IORING_OP_ASYNC_CANCEL;
+  sqe->fd = -1;
+  sqe->addr = reinterpret_cast<uint64_t>(op);
+  sqe->user_data = 0; // The cancellation's own completion is ignored
+  return true;
+}
+
+RefBuffer::Ptr IoUring::take_buffer(unsigned flags) {
+  unsigned short bid = static_cast<unsigned short>(flags >> IORING_CQE_BUFFER_SHIFT);
+  RefBuffer::Ptr buffer(buffers_[bid]);
+  provide_buffer(bid);
+  return buffer;
+}
+
+struct io_uring_sqe* IoUring::get_sqe() {
+  if (fd_ < 0) return NULL;
+  unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+  unsigned tail = *sq_tail_;
+  if (tail - head >= sq_entries_) {
+    // The submission queue is full so submit now instead of waiting for the
+    // end of the event loop's iteration
+    if (submit() < 0) return NULL;
+    head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    if (tail - head >= sq_entries_) return NULL;
+  }
+
+  unsigned index = tail & sq_mask_;
+  struct io_uring_sqe* sqe = &sqes_[index];
+  memset(sqe, 0, sizeof(*sqe));
+  sq_array_[index] = index;
+  __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+  ++pending_;
+  return sqe;
+}
+
+int IoUring::submit() {
+  if (pending_ == 0) return 0;
+  int rc;
+  do {
+    rc = io_uring_enter(fd_, pending_, 0, 0);
+  } while (rc == -EINTR);
+  if (rc < 0) {
+    LOG_ERROR("Unable to submit io_uring operations: %s", strerror(-rc));
+    return rc;
+  }
+  pending_ -= rc;
+  return rc;
+}
+
+void IoUring::provide_buffer(unsigned short bid) {
+  RefBuffer::Ptr buffer(buffer_pool_->acquire(IO_URING_BUFFER_SIZE));
+  // The ring's entries are indexed directly, the header's flexible array
+  // member isn't at the start of the ring when compiled as C++
+  struct io_uring_buf* buf = reinterpret_cast<struct io_uring_buf*>(buf_ring_) +
+                             (buf_tail_ & (IO_URING_BUFFER_COUNT - 1));
+  buf->addr = reinterpret_cast<uint64_t>(buffer->data());
+  buf->len = IO_URING_BUFFER_SIZE;
+  buf->bid = bid;
+  buffers_[bid] = buffer;
+  ++buf_tail_;
+  __atomic_store_n(&buf_ring_->tail, buf_tail_, __ATOMIC_RELEASE);
+}
+
+void IoUring::on_prepare(Prepare* prepare) { submit(); }
+
+void IoUring::on_poll(uv_poll_t* poll, int status, int events) {
+  IoUring* io_uring = static_cast<IoUring*>(poll->data);
+  io_uring->handle_completions();
+}
+
+void IoUring::handle_completions() {
+  unsigned head = *cq_head_;
+  unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+  while (head != tail) {
+    struct io_uring_cqe* cqe = &cqes_[head & cq_mask_];
+    int result = cqe->res;
+    unsigned flags = cqe->flags;
+    Operation* op = reinterpret_cast<Operation*>(cqe->user_data);
+    // Release the entry before the callback because it can queue operations
+    // that complete inline
+    __atomic_store_n(cq_head_, ++head, __ATOMIC_RELEASE);
+    if (op != NULL) {
+      if (!(flags & IORING_CQE_F_MORE)) --active_;
+      op->on_complete(result, flags);
+    }
+    tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    if (head == tail && (__atomic_load_n(sq_flags_, __ATOMIC_ACQUIRE) & IORING_SQ_CQ_OVERFLOW)) {
+      // The completions that didn't fit in the completion queue are kept by
+      // the kernel until they're flushed
+      io_uring_enter(fd_, 0, 0, IORING_ENTER_GETEVENTS);
+      tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    }
+  }
+
+  if (is_closing_ && active_ == 0) {
+    close_handles();
+  }
+}
+
+void IoUring::on_close(uv_handle_t* handle) {
+  delete reinterpret_cast<AllocatedT<uv_poll_t>*>(handle);
+}
+
+#endif
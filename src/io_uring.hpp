@@ -0,0 +1,179 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_IO_URING_HPP
+#define DATASTAX_INTERNAL_IO_URING_HPP
+
+#include "driver_config.hpp"
+
+#ifdef HAVE_IO_URING
+
+#include "allocated.hpp"
+#include "buffer_pool.hpp"
+#include "loop_watcher.hpp"
+#include "macros.hpp"
+#include "vector.hpp"
+
+#include <linux/io_uring.h>
+#include <sys/socket.h>
+#include <uv.h>
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * A Linux io_uring shared by the sockets of a single event loop. Sockets
+ * receive using multishot receives into a ring of buffers registered with the
+ * kernel and send using queued sendmsg operations. The operations queued
+ * during an iteration of the event loop are submitted together, using a
+ * single system call, right before the event loop polls. The completions are
+ * processed when the event loop polls the io_uring's file descriptor.
+ *
+ * This is only used on the event loop's thread.
+ */
+class IoUring : public Allocated {
+public:
+  /**
+   * An operation submitted to the io_uring.
+   */
+  class Operation {
+  public:
+    virtual ~Operation() {}
+
+    /**
+     * Called for each of the operation's completions. A multishot receive
+     * completes several times, its last completion doesn't have the
+     * IORING_CQE_F_MORE flag.
+     *
+     * @param result The result of the operation. This is the number of bytes
+     * received or sent, or a negated errno.
+     * @param flags The completion's flags.
+     */
+    virtual void on_complete(int result, unsigned flags) = 0;
+  };
+
+  IoUring();
+  ~IoUring();
+
+  /**
+   * Create the io_uring and start processing its completions. This fails if
+   * the kernel doesn't support the features that are used (Linux 6.0+).
+   *
+   * @param loop The event loop.
+   * @return 0 if successful, otherwise a negated errno.
+   */
+  int init(uv_loop_t* loop);
+
+  /**
+   * Stop processing completions. This is delayed until the outstanding
+   * operations complete, they should be canceled first.
+   */
+  void close();
+
+  /**
+   * Receive data from a socket, into the registered buffers, until the
+   * operation is canceled or fails.
+   *
+   * @param fd The socket's file descriptor.
+   * @param op The operation notified of the received data. Use take_buffer()
+   * to get the buffer the data was received into.
+   * @return true if the operation was queued.
+   */
+  bool recv_multishot(int fd, Operation* op);
+
+  /**
+   * Send data to a socket.
+   *
+   * @param fd The socket's file descriptor.
+   * @param msg The data to send. This must remain valid until the operation
+   * completes.
+   * @param op The operation notified when the data is sent.
+   * @return true if the operation was queued.
+   */
+  bool sendmsg(int fd, const struct msghdr* msg, Operation* op);
+
+  /**
+   * Cancel an operation. The operation completes with -ECANCELED unless it
+   * completes before it's canceled.
+   *
+   * @param op The operation to cancel.
+   * @return true if the cancellation was queued.
+   */
+  bool cancel(Operation* op);
+
+  /**
+   * Take the registered buffer that a receive completed into and register a
+   * new buffer in its place.
+   *
+   * @param flags The flags of the receive's completion.
+   * @return The buffer that holds the received data.
+   */
+  RefBuffer::Ptr take_buffer(unsigned flags);
+
+private:
+  struct io_uring_sqe* get_sqe();
+  int submit();
+  void provide_buffer(unsigned short bid);
+
+  void on_prepare(Prepare* prepare);
+  static void on_poll(uv_poll_t* poll, int status, int events);
+  void handle_completions();
+  void close_handles();
+  static void on_close(uv_handle_t* handle);
+
+private:
+  int fd_;
+
+  void* sq_ptr_;
+  size_t sq_size_;
+  void* cq_ptr_;
+  size_t cq_size_;
+  struct io_uring_sqe* sqes_;
+  size_t sqes_size_;
+
+  unsigned* sq_head_;
+  unsigned* sq_tail_;
+  unsigned* sq_flags_;
+  unsigned sq_mask_;
+  unsigned* sq_array_;
+  unsigned sq_entries_;
+  unsigned pending_;
+  // The operations that haven't had their last completion
+  unsigned active_;
+  bool is_closing_;
+
+  unsigned* cq_head_;
+  unsigned* cq_tail_;
+  unsigned cq_mask_;
+  struct io_uring_cqe* cqes_;
+
+  struct io_uring_buf_ring* buf_ring_;
+  size_t buf_ring_size_;
+  unsigned short buf_tail_;
+  BufferPool::Ptr buffer_pool_;
+  Vector<RefBuffer::Ptr> buffers_;
+
+  AllocatedT<uv_poll_t>* poll_;
+  Prepare prepare_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(IoUring);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
+
+#endif
@@ -19,8 +19,10 @@
 #include "collection_iterator.hpp"
 #include "external.hpp"
 #include "map_iterator.hpp"
+#include "paged_result_iterator.hpp"
 #include "result_iterator.hpp"
 #include "row_iterator.hpp"
+#include "session.hpp"
 #include "user_type_field_iterator.hpp"
 
 using namespace datastax;
@@ -40,6 +42,21 @@ CassIterator* cass_iterator_from_result(const CassResult* result) {
   return CassIterator::to(new ResultIterator(result));
 }
 
+CassIterator* cass_iterator_from_paged_future(CassSession* session, CassFuture* future) {
+  if (future->type() != Future::FUTURE_TYPE_RESPONSE) {
+    return NULL;
+  }
+  return CassIterator::to(new PagedResultIterator(
+      session->from(), ResponseFuture::Ptr(static_cast<ResponseFuture*>(future->from()))));
+}
+
+CassError cass_iterator_get_paging_error(const CassIterator* iterator) {
+  if (iterator->type() != CASS_ITERATOR_TYPE_PAGED_RESULT) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  return static_cast<const PagedResultIterator*>(iterator->from())->error_code();
+}
+
 CassIterator* cass_iterator_from_row(const CassRow* row) {
   return CassIterator::to(new RowIterator(row));
 }
@@ -91,6 +108,9 @@ const CassValue* cass_iterator_get_user_type_field_value(const CassIterator* ite
 }
 
 const CassRow* cass_iterator_get_row(const CassIterator* iterator) {
+  if (iterator->type() == CASS_ITERATOR_TYPE_PAGED_RESULT) {
+    return CassRow::to(static_cast<const PagedResultIterator*>(iterator->from())->row());
+  }
   if (iterator->type() != CASS_ITERATOR_TYPE_RESULT) {
     return NULL;
   }
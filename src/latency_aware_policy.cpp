@@ -43,7 +43,7 @@ void LatencyAwarePolicy::close_handles() { timer_.stop(); }
 QueryPlan* LatencyAwarePolicy::new_query_plan(const String& keyspace,
                                               RequestHandler* request_handler,
                                               const TokenMap* token_map) {
-  return new LatencyAwareQueryPlan(
+  return new (request_handler) LatencyAwareQueryPlan(
       this, child_policy_->new_query_plan(keyspace, request_handler, token_map));
 }
 
@@ -63,8 +63,18 @@ void LatencyAwarePolicy::start_timer(uv_loop_t* loop) {
 }
 
 void LatencyAwarePolicy::on_timer(Timer* timer) {
+  update_min_average();
+  start_timer(timer_.loop());
+}
+
+void LatencyAwarePolicy::update_min_average() {
   const CopyOnWriteHostVec& hosts(hosts_);
 
+  // Fold the latencies recorded by all the threads into the hosts' averages
+  for (HostVec::const_iterator i = hosts->begin(), end = hosts->end(); i != end; ++i) {
+    (*i)->merge_latencies();
+  }
+
   int64_t new_min_average = CASS_INT64_MAX;
   int64_t now = uv_hrtime();
 
@@ -72,7 +82,7 @@ void LatencyAwarePolicy::on_timer(Timer* timer) {
     TimestampedAverage latency = (*i)->get_current_average();
     if (latency.average >= 0 && latency.num_measured >= settings_.min_measured &&
         (now - latency.timestamp) <= settings_.retry_period_ns) {
-      new_min_average = std::min(new_min_average, latency.average);
+      new_min_average = std::min(new_min_average, penalized_average(*i, latency));
     }
   }
 
@@ -80,17 +90,28 @@ void LatencyAwarePolicy::on_timer(Timer* timer) {
     LOG_TRACE("Calculated new minimum: %f", static_cast<double>(new_min_average) / 1e6);
     min_average_.store(new_min_average);
   }
+}
 
-  start_timer(timer_.loop());
+int64_t LatencyAwarePolicy::penalized_average(const Host::Ptr& host,
+                                              const TimestampedAverage& latency) const {
+  int32_t inflight = host->inflight_request_count();
+  if (inflight <= 0 || settings_.inflight_penalty <= 0.0) {
+    return latency.average;
+  }
+  double inflight_per_connection =
+      static_cast<double>(inflight) / std::max(host->connection_count(), static_cast<int32_t>(1));
+  return static_cast<int64_t>(latency.average *
+                              (1.0 + settings_.inflight_penalty * inflight_per_connection));
 }
 
-Host::Ptr LatencyAwarePolicy::LatencyAwareQueryPlan::compute_next() {
+const Host::Ptr& LatencyAwarePolicy::LatencyAwareQueryPlan::compute_next() {
   int64_t min = policy_->min_average_.load();
   const Settings& settings = policy_->settings_;
   uint64_t now = uv_hrtime();
 
-  Host::Ptr host;
-  while ((host = child_plan_->compute_next())) {
+  while (true) {
+    const Host::Ptr& host(child_plan_->compute_next());
+    if (!host) break;
     TimestampedAverage latency = host->get_current_average();
 
     if (min < 0 || latency.average < 0 || latency.num_measured < settings.min_measured ||
@@ -98,12 +119,13 @@ Host::Ptr LatencyAwarePolicy::LatencyAwareQueryPlan::compute_next() {
       return host;
     }
 
-    if (latency.average <= static_cast<int64_t>(settings.exclusion_threshold * min)) {
+    int64_t average = policy_->penalized_average(host, latency);
+    if (average <= static_cast<int64_t>(settings.exclusion_threshold * min)) {
       return host;
     }
 
     LOG_TRACE("Skipping %s because latency is too high %f", host->address_string().c_str(),
-              static_cast<double>(latency.average) / 1e6);
+              static_cast<double>(average) / 1e6);
     skipped_.push_back(host);
   }
 
@@ -111,5 +133,5 @@ Host::Ptr LatencyAwarePolicy::LatencyAwareQueryPlan::compute_next() {
     return skipped_[skipped_index_++];
   }
 
-  return Host::Ptr();
+  return NO_HOST;
 }
@@ -33,13 +33,17 @@ public:
         , scale_ns(100LL * 1000LL * 1000LL)
         , retry_period_ns(10LL * 1000LL * 1000LL * 1000LL)
         , update_rate_ms(100LL)
-        , min_measured(50LL) {}
+        , min_measured(50LL)
+        , inflight_penalty(0.01) {}
 
     double exclusion_threshold;
     uint64_t scale_ns;
     uint64_t retry_period_ns;
     uint64_t update_rate_ms;
     uint64_t min_measured;
+    // The fraction of a host's average latency that's added for each of its
+    // in-flight requests per connection
+    double inflight_penalty;
   };
 
   LatencyAwarePolicy(LoadBalancingPolicy* child_policy, const Settings& settings)
@@ -70,6 +74,24 @@ public:
   // Testing only
   int64_t min_average() const { return min_average_.load(); }
 
+  /**
+   * A host's average latency penalized by its in-flight requests. Requests
+   * that are sent to a host with many requests outstanding on each of its
+   * connections are expected to wait longer than its recent average.
+   *
+   * @param host The host.
+   * @param latency The host's current average latency.
+   * @return The penalized average in nanoseconds.
+   */
+  int64_t penalized_average(const Host::Ptr& host, const TimestampedAverage& latency) const;
+
+  /**
+   * Fold the hosts' recorded latencies into their averages and recalculate
+   * the minimum average. This runs on the policy's update timer and can also
+   * be driven directly, e.g. by a simulation with its own clock.
+   */
+  void update_min_average();
+
 private:
   void start_timer(uv_loop_t* loop);
 
@@ -81,7 +103,7 @@ private:
         , child_plan_(child_plan)
         , skipped_index_(0) {}
 
-    Host::Ptr compute_next();
+    const Host::Ptr& compute_next();
 
   private:
     LatencyAwarePolicy* policy_;
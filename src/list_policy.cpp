@@ -25,9 +25,10 @@ using namespace datastax::internal::core;
 void ListPolicy::init(const Host::Ptr& connected_host, const HostMap& hosts, Random* random,
                       const String& local_dc, const String& local_rack) {
   HostMap valid_hosts;
+  valid_hosts_.clear();
   for (HostMap::const_iterator i = hosts.begin(), end = hosts.end(); i != end; ++i) {
     const Host::Ptr& host = i->second;
-    if (is_valid_host(host)) {
+    if (add_valid_host(host)) {
       valid_hosts.insert(HostPair(i->first, host));
     }
   }
@@ -40,7 +41,7 @@ void ListPolicy::init(const Host::Ptr& connected_host, const HostMap& hosts, Ran
 }
 
 CassHostDistance ListPolicy::distance(const Host::Ptr& host) const {
-  if (is_valid_host(host)) {
+  if (valid_hosts_.count(host->address()) > 0) {
     return child_policy_->distance(host);
   }
   return CASS_HOST_DISTANCE_IGNORE;
@@ -52,13 +53,25 @@ QueryPlan* ListPolicy::new_query_plan(const String& keyspace, RequestHandler* re
 }
 
 void ListPolicy::on_host_added(const Host::Ptr& host) {
-  if (is_valid_host(host)) {
+  if (add_valid_host(host)) {
     child_policy_->on_host_added(host);
   }
 }
 
+void ListPolicy::on_host_removed(const Host::Ptr& host) {
+  if (valid_hosts_.erase(host->address()) > 0) {
+    child_policy_->on_host_removed(host);
+  }
+}
+
 void ListPolicy::on_host_up(const Host::Ptr& host) {
-  if (is_valid_host(host)) {
+  if (valid_hosts_.count(host->address()) > 0 || add_valid_host(host)) {
     child_policy_->on_host_up(host);
   }
 }
+
+bool ListPolicy::add_valid_host(const Host::Ptr& host) {
+  if (!is_valid_host(host)) return false;
+  valid_hosts_.insert(host->address());
+  return true;
+}
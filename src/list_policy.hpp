@@ -17,6 +17,7 @@
 #ifndef DATASTAX_INTERNAL_LIST_POLICY_HPP
 #define DATASTAX_INTERNAL_LIST_POLICY_HPP
 
+#include "address.hpp"
 #include "host.hpp"
 #include "load_balancing.hpp"
 #include "scoped_ptr.hpp"
@@ -39,12 +40,21 @@ public:
                                     const TokenMap* token_map);
 
   virtual void on_host_added(const Host::Ptr& host);
+  virtual void on_host_removed(const Host::Ptr& host);
   virtual void on_host_up(const Host::Ptr& host);
 
   virtual ListPolicy* new_instance() = 0;
 
+private:
+  bool add_valid_host(const Host::Ptr& host);
+
 private:
   virtual bool is_valid_host(const Host::Ptr& host) const = 0;
+
+private:
+  // The hosts that passed the list's check, so that it's only evaluated when
+  // hosts are added instead of for every request
+  AddressSet valid_hosts_;
 };
 
 }}} // namespace datastax::internal::core
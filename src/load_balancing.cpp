@@ -0,0 +1,63 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "load_balancing.hpp"
+
+#include "driver_config.hpp"
+#include "memory.hpp"
+#include "object_cache.hpp"
+#include "request_handler.hpp"
+
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+void* QueryPlanStorage::allocate(QueryPlanStorage* storage, size_t size) {
+  const size_t total = sizeof(Header) + aligned_size(size);
+  if (storage != NULL && storage->offset_ + total <= CAPACITY) {
+    Header* header =
+        reinterpret_cast<Header*>(static_cast<char*>(storage->data_.address()) + storage->offset_);
+    storage->offset_ += total;
+    header->storage = storage;
+    return header + 1;
+  }
+
+#ifdef HAVE_OBJECT_CACHE
+  Header* header = static_cast<Header*>(ObjectCache::allocate(total));
+#else
+  Header* header = static_cast<Header*>(Memory::malloc(total));
+#endif
+  header->storage = NULL;
+  return header + 1;
+}
+
+void QueryPlanStorage::deallocate(void* ptr) {
+  if (ptr == NULL) return;
+  Header* header = static_cast<Header*>(ptr) - 1;
+  if (header->storage == NULL) {
+#ifdef HAVE_OBJECT_CACHE
+    ObjectCache::deallocate(header);
+#else
+    Memory::free(header);
+#endif
+  }
+}
+
+const Host::Ptr QueryPlan::NO_HOST;
+
+void* QueryPlan::operator new(size_t size, RequestHandler* request_handler) {
+  return QueryPlanStorage::allocate(
+      request_handler != NULL ? request_handler->query_plan_storage() : NULL, size);
+}
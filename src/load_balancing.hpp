@@ -17,10 +17,12 @@
 #ifndef DATASTAX_INTERNAL_LOAD_BALANCING_HPP
 #define DATASTAX_INTERNAL_LOAD_BALANCING_HPP
 
+#include "aligned_storage.hpp"
 #include "allocated.hpp"
 #include "cassandra.h"
 #include "constants.hpp"
 #include "host.hpp"
+#include "macros.hpp"
 #include "request.hpp"
 #include "string.hpp"
 #include "vector.hpp"
@@ -73,19 +75,92 @@ inline bool is_dc_local(CassConsistency cl) {
   return cl == CASS_CONSISTENCY_LOCAL_ONE || cl == CASS_CONSISTENCY_LOCAL_QUORUM;
 }
 
+/**
+ * Inline storage for a request's query plans. It's part of the request
+ * handler so that the plans of the common policy chains (e.g. token-aware
+ * wrapping DC-aware) don't need a heap allocation per request. Plans that
+ * don't fit, or that are created without a request handler, are allocated
+ * from the heap. The space of destroyed plans isn't reused.
+ */
+class QueryPlanStorage {
+public:
+  static const size_t CAPACITY = 512;
+
+  QueryPlanStorage()
+      : offset_(0) {}
+
+  size_t used() const { return offset_; }
+
+  /**
+   * Allocate memory for a query plan. Every allocation, including the heap
+   * fallback, is prefixed by a header that records where it came from.
+   *
+   * @param storage The storage to allocate from. This can be NULL to
+   * allocate from the heap.
+   * @param size The size of the query plan.
+   * @return The query plan's memory.
+   */
+  static void* allocate(QueryPlanStorage* storage, size_t size);
+
+  /**
+   * Free memory returned by allocate().
+   *
+   * @param ptr The query plan's memory. This can be NULL.
+   */
+  static void deallocate(void* ptr);
+
+private:
+  union Header {
+    QueryPlanStorage* storage; // NULL for heap allocations
+    double align_double;
+    long long align_long_long;
+    void* align_pointer;
+  };
+
+  static size_t aligned_size(size_t size) {
+    return (size + sizeof(Header) - 1) & ~(sizeof(Header) - 1);
+  }
+
+private:
+  AlignedStorage<CAPACITY, 16> data_;
+  size_t offset_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(QueryPlanStorage);
+};
+
 class QueryPlan : public Allocated {
 public:
+  // Query plans are allocated using "new (request_handler) Plan(...)" to use
+  // the request handler's query plan storage. The request handler can be NULL.
+  void* operator new(size_t size) { return QueryPlanStorage::allocate(NULL, size); }
+  void* operator new(size_t size, RequestHandler* request_handler);
+  void operator delete(void* ptr) { QueryPlanStorage::deallocate(ptr); }
+  void operator delete(void* ptr, RequestHandler*) { QueryPlanStorage::deallocate(ptr); }
+
   virtual ~QueryPlan() {}
-  virtual Host::Ptr compute_next() = 0;
+
+  /**
+   * Get the next host of the query plan. The host is only referenced by the
+   * plan (or its policy), so it has to be copied to be used after the next
+   * call or after the plan is destroyed. This avoids updating the shared
+   * host's reference count for every host a chain of plans visits.
+   *
+   * @return The next host or an empty host if there are no more hosts.
+   */
+  virtual const Host::Ptr& compute_next() = 0;
 
   bool compute_next(Address* address) {
-    Host::Ptr host = compute_next();
+    const Host::Ptr& host = compute_next();
     if (host) {
       *address = host->address();
       return true;
     }
     return false;
   }
+
+protected:
+  static const Host::Ptr NO_HOST;
 };
 
 class LoadBalancingPolicy : public RefCounted<LoadBalancingPolicy> {
@@ -128,6 +203,17 @@ inline bool is_host_ignored(const LoadBalancingPolicy::Vec& policies, const Host
   return true;
 }
 
+inline bool is_host_remote(const LoadBalancingPolicy::Vec& policies, const Host::Ptr& host) {
+  bool is_remote = false;
+  for (LoadBalancingPolicy::Vec::const_iterator it = policies.begin(), end = policies.end();
+       it != end; ++it) {
+    CassHostDistance distance = (*it)->distance(host);
+    if (distance == CASS_HOST_DISTANCE_LOCAL) return false;
+    if (distance != CASS_HOST_DISTANCE_IGNORE) is_remote = true; // REMOTE or REMOTE2
+  }
+  return is_remote;
+}
+
 class ChainedLoadBalancingPolicy : public LoadBalancingPolicy {
 public:
   ChainedLoadBalancingPolicy(LoadBalancingPolicy* child_policy)
@@ -16,6 +16,9 @@
 
 #include "logger.hpp"
 
+#include "async_logger.hpp"
+#include "scoped_ptr.hpp"
+
 using namespace datastax::internal;
 
 extern "C" {
@@ -34,6 +37,12 @@ void cass_log_set_queue_size(size_t queue_size) {
   // Deprecated
 }
 
+CassError cass_log_set_async(size_t queue_size, unsigned max_messages_per_second) {
+  return Logger::set_async(queue_size, max_messages_per_second);
+}
+
+void cass_log_flush() { Logger::flush(); }
+
 } // extern "C"
 
 namespace datastax { namespace internal { namespace core {
@@ -52,12 +61,19 @@ void noop_log_callback(const CassLogMessage* message, void* data) {}
 CassLogLevel Logger::log_level_ = CASS_LOG_WARN;
 CassLogCallback Logger::cb_ = core::stderr_log_callback;
 void* Logger::data_ = NULL;
+AsyncLogger* Logger::async_ = NULL;
 
 void Logger::internal_log(CassLogLevel severity, const char* file, int line, const char* function,
                           const char* format, va_list args) {
   CassLogMessage message = { get_time_since_epoch_ms(), severity, file, line, function, "" };
   vsnprintf(message.message, sizeof(message.message), format, args);
-  Logger::cb_(&message, Logger::data_);
+  if (Logger::async_) {
+    // The message is formatted here because the arguments might not outlive
+    // this call, but the callback runs on the logger's thread.
+    Logger::async_->log(message, Logger::cb_, Logger::data_);
+  } else {
+    Logger::cb_(&message, Logger::data_);
+  }
 }
 
 void Logger::set_log_level(CassLogLevel log_level) { log_level_ = log_level; }
@@ -66,3 +82,23 @@ void Logger::set_callback(CassLogCallback cb, void* data) {
   cb_ = cb == NULL ? noop_log_callback : cb;
   data_ = data;
 }
+
+CassError Logger::set_async(size_t queue_size, unsigned max_messages_per_second) {
+  ScopedPtr<AsyncLogger> async;
+  if (queue_size > 0) {
+    async.reset(new AsyncLogger(queue_size, max_messages_per_second));
+    if (async->init() != 0) {
+      return CASS_ERROR_LIB_UNABLE_TO_INIT;
+    }
+  }
+  // The previous logger logs its queued messages before it's destroyed
+  ScopedPtr<AsyncLogger> previous(async_);
+  async_ = async.release();
+  return CASS_OK;
+}
+
+void Logger::flush() {
+  if (async_) {
+    async_->flush();
+  }
+}
@@ -18,6 +18,7 @@
 #define DATASTAX_INTERNAL_LOGGER_HPP
 
 #include "cassandra.h"
+#include "driver_config.hpp"
 #include "get_time.hpp"
 #include "string.hpp"
 
@@ -27,10 +28,14 @@
 
 namespace datastax { namespace internal {
 
+class AsyncLogger;
+
 class Logger {
 public:
   static void set_log_level(CassLogLevel level);
   static void set_callback(CassLogCallback cb, void* data);
+  static CassError set_async(size_t queue_size, unsigned max_messages_per_second);
+  static void flush();
 
 #if defined(__GNUC__) || defined(__clang__)
 #define ATTR_FORMAT(string, first) __attribute__((__format__(__printf__, string, first)))
@@ -58,6 +63,7 @@ private:
   static CassLogLevel log_level_;
   static CassLogCallback cb_;
   static void* data_;
+  static AsyncLogger* async_;
 
   Logger(); // Keep this object from being created
 };
@@ -107,12 +113,27 @@ private:
 #define LOG_FUNCTION_ ""
 #endif
 
-#define LOG_CHECK_LEVEL(severity, ...)                                                   \
-  do {                                                                                   \
-    if (severity <= ::datastax::internal::Logger::log_level()) {                         \
-      ::datastax::internal::Logger::log(severity, LOG_FILE_, __LINE__, LOG_FUNCTION_,    \
-                                        LOG_FIRST_(__VA_ARGS__) LOG_REST_(__VA_ARGS__)); \
-    }                                                                                    \
+// Log statements more verbose than this are compiled out
+#ifndef MAX_LOG_LEVEL
+#define MAX_LOG_LEVEL CASS_LOG_TRACE
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define LOG_UNLIKELY_(expr) __builtin_expect(!!(expr), 0)
+#else
+#define LOG_UNLIKELY_(expr) (expr)
+#endif
+
+// The arguments are only evaluated if the statement is logged. The first check is a constant
+// expression so statements above the compiled level are removed entirely, but their arguments are
+// still checked against the format string.
+#define LOG_CHECK_LEVEL(severity, ...)                                                     \
+  do {                                                                                     \
+    if (severity <= MAX_LOG_LEVEL &&                                                       \
+        LOG_UNLIKELY_(severity <= ::datastax::internal::Logger::log_level())) {            \
+      ::datastax::internal::Logger::log(severity, LOG_FILE_, __LINE__, LOG_FUNCTION_,      \
+                                        LOG_FIRST_(__VA_ARGS__) LOG_REST_(__VA_ARGS__));   \
+    }                                                                                      \
   } while (0)
 
 #define LOG_CRITICAL(...) LOG_CHECK_LEVEL(CASS_LOG_CRITICAL, __VA_ARGS__)
@@ -155,6 +155,24 @@ private:
   static void stop_handle(HandleType* handle) { uv_check_stop(handle); }
 };
 
+/**
+ * A wrapper for uv_idle. This is useful for keeping the event loop from
+ * blocking while it polls.
+ */
+class Idle : public LoopWatcher<Idle, uv_idle_t> {
+private:
+  typedef uv_idle_cb HandleCallback;
+  friend class LoopWatcher<Idle, HandleType>;
+
+  static int init_handle(uv_loop_t* loop, HandleType* handle) { return uv_idle_init(loop, handle); }
+
+  static int start_handle(HandleType* handle, HandleCallback callback) {
+    return uv_idle_start(handle, callback);
+  }
+
+  static void stop_handle(HandleType* handle) { uv_idle_stop(handle); }
+};
+
 }}} // namespace datastax::internal::core
 
 #endif
@@ -55,6 +55,17 @@
 #define GET(n) (block_[(n)])
 #endif
 
+// The number of messages hashed together by md5_batch()
+#define MD5_BATCH_LANES 4
+
+// The MD5 transformation for all of the lanes at once
+#define LANE_STEP(f, a, b, c, d, n, t, s)                               \
+  for (int lane = 0; lane < MD5_BATCH_LANES; ++lane) {                  \
+    (a)[lane] += f((b)[lane], (c)[lane], (d)[lane]) + x[(n)][lane] + (t); \
+    (a)[lane] = ((a)[lane] << (s)) | ((a)[lane] >> (32 - (s)));         \
+    (a)[lane] += (b)[lane];                                             \
+  }
+
 using namespace datastax::internal;
 
 Md5::Md5()
@@ -252,3 +263,174 @@ const uint8_t* Md5::body(const uint8_t* data, size_t size) {
 
   return ptr;
 }
+
+namespace {
+
+// The blocks of one message including its padding and length. All the blocks
+// but the last one or two come straight from the message.
+struct LaneBlocks {
+  void init(const uint8_t* data, size_t size) {
+    message = data;
+    full_blocks = size / 64;
+    size_t remaining = size % 64;
+    count = full_blocks + (remaining + 8) / 64 + 1;
+    memset(tail, 0, sizeof(tail));
+    if (remaining > 0) memcpy(tail, data + full_blocks * 64, remaining);
+    tail[remaining] = 0x80;
+    uint64_t bits = static_cast<uint64_t>(size) << 3;
+    uint8_t* length = tail + (count - full_blocks) * 64 - 8;
+    for (int i = 0; i < 8; ++i) {
+      length[i] = static_cast<uint8_t>(bits >> (8 * i));
+    }
+  }
+
+  const uint8_t* block(size_t i) const {
+    return i < full_blocks ? message + i * 64 : tail + (i - full_blocks) * 64;
+  }
+
+  const uint8_t* message;
+  size_t full_blocks;
+  size_t count;
+  uint8_t tail[128];
+};
+
+// Hash MD5_BATCH_LANES messages together. Each lane's state is only updated
+// while the lane has blocks left so lanes of different sizes can share the
+// rounds.
+void md5_lanes(const uint8_t* const* data, const size_t* sizes, size_t lanes,
+               uint8_t* digests) {
+  LaneBlocks blocks[MD5_BATCH_LANES];
+  uint32_t a[MD5_BATCH_LANES], b[MD5_BATCH_LANES], c[MD5_BATCH_LANES], d[MD5_BATCH_LANES];
+  uint32_t x[16][MD5_BATCH_LANES];
+  size_t max_blocks = 0;
+
+  for (size_t lane = 0; lane < MD5_BATCH_LANES; ++lane) {
+    // Unused lanes hash an empty message
+    if (lane < lanes) {
+      blocks[lane].init(data[lane], sizes[lane]);
+    } else {
+      blocks[lane].init(NULL, 0);
+    }
+    if (blocks[lane].count > max_blocks) max_blocks = blocks[lane].count;
+    a[lane] = 0x67452301;
+    b[lane] = 0xefcdab89;
+    c[lane] = 0x98badcfe;
+    d[lane] = 0x10325476;
+  }
+
+  for (size_t i = 0; i < max_blocks; ++i) {
+    uint32_t saved_a[MD5_BATCH_LANES], saved_b[MD5_BATCH_LANES];
+    uint32_t saved_c[MD5_BATCH_LANES], saved_d[MD5_BATCH_LANES];
+    for (int lane = 0; lane < MD5_BATCH_LANES; ++lane) {
+      const LaneBlocks& lane_blocks = blocks[lane];
+      const uint8_t* ptr = lane_blocks.block(i < lane_blocks.count ? i : 0);
+      for (int n = 0; n < 16; ++n) {
+        x[n][lane] = (uint32_t)ptr[n * 4] | ((uint32_t)ptr[n * 4 + 1] << 8) |
+                     ((uint32_t)ptr[n * 4 + 2] << 16) | ((uint32_t)ptr[n * 4 + 3] << 24);
+      }
+      saved_a[lane] = a[lane];
+      saved_b[lane] = b[lane];
+      saved_c[lane] = c[lane];
+      saved_d[lane] = d[lane];
+    }
+
+    // Round 1
+    LANE_STEP(F, a, b, c, d, 0, 0xd76aa478, 7)
+    LANE_STEP(F, d, a, b, c, 1, 0xe8c7b756, 12)
+    LANE_STEP(F, c, d, a, b, 2, 0x242070db, 17)
+    LANE_STEP(F, b, c, d, a, 3, 0xc1bdceee, 22)
+    LANE_STEP(F, a, b, c, d, 4, 0xf57c0faf, 7)
+    LANE_STEP(F, d, a, b, c, 5, 0x4787c62a, 12)
+    LANE_STEP(F, c, d, a, b, 6, 0xa8304613, 17)
+    LANE_STEP(F, b, c, d, a, 7, 0xfd469501, 22)
+    LANE_STEP(F, a, b, c, d, 8, 0x698098d8, 7)
+    LANE_STEP(F, d, a, b, c, 9, 0x8b44f7af, 12)
+    LANE_STEP(F, c, d, a, b, 10, 0xffff5bb1, 17)
+    LANE_STEP(F, b, c, d, a, 11, 0x895cd7be, 22)
+    LANE_STEP(F, a, b, c, d, 12, 0x6b901122, 7)
+    LANE_STEP(F, d, a, b, c, 13, 0xfd987193, 12)
+    LANE_STEP(F, c, d, a, b, 14, 0xa679438e, 17)
+    LANE_STEP(F, b, c, d, a, 15, 0x49b40821, 22)
+
+    // Round 2
+    LANE_STEP(G, a, b, c, d, 1, 0xf61e2562, 5)
+    LANE_STEP(G, d, a, b, c, 6, 0xc040b340, 9)
+    LANE_STEP(G, c, d, a, b, 11, 0x265e5a51, 14)
+    LANE_STEP(G, b, c, d, a, 0, 0xe9b6c7aa, 20)
+    LANE_STEP(G, a, b, c, d, 5, 0xd62f105d, 5)
+    LANE_STEP(G, d, a, b, c, 10, 0x02441453, 9)
+    LANE_STEP(G, c, d, a, b, 15, 0xd8a1e681, 14)
+    LANE_STEP(G, b, c, d, a, 4, 0xe7d3fbc8, 20)
+    LANE_STEP(G, a, b, c, d, 9, 0x21e1cde6, 5)
+    LANE_STEP(G, d, a, b, c, 14, 0xc33707d6, 9)
+    LANE_STEP(G, c, d, a, b, 3, 0xf4d50d87, 14)
+    LANE_STEP(G, b, c, d, a, 8, 0x455a14ed, 20)
+    LANE_STEP(G, a, b, c, d, 13, 0xa9e3e905, 5)
+    LANE_STEP(G, d, a, b, c, 2, 0xfcefa3f8, 9)
+    LANE_STEP(G, c, d, a, b, 7, 0x676f02d9, 14)
+    LANE_STEP(G, b, c, d, a, 12, 0x8d2a4c8a, 20)
+
+    // Round 3
+    LANE_STEP(H, a, b, c, d, 5, 0xfffa3942, 4)
+    LANE_STEP(H, d, a, b, c, 8, 0x8771f681, 11)
+    LANE_STEP(H, c, d, a, b, 11, 0x6d9d6122, 16)
+    LANE_STEP(H, b, c, d, a, 14, 0xfde5380c, 23)
+    LANE_STEP(H, a, b, c, d, 1, 0xa4beea44, 4)
+    LANE_STEP(H, d, a, b, c, 4, 0x4bdecfa9, 11)
+    LANE_STEP(H, c, d, a, b, 7, 0xf6bb4b60, 16)
+    LANE_STEP(H, b, c, d, a, 10, 0xbebfbc70, 23)
+    LANE_STEP(H, a, b, c, d, 13, 0x289b7ec6, 4)
+    LANE_STEP(H, d, a, b, c, 0, 0xeaa127fa, 11)
+    LANE_STEP(H, c, d, a, b, 3, 0xd4ef3085, 16)
+    LANE_STEP(H, b, c, d, a, 6, 0x04881d05, 23)
+    LANE_STEP(H, a, b, c, d, 9, 0xd9d4d039, 4)
+    LANE_STEP(H, d, a, b, c, 12, 0xe6db99e5, 11)
+    LANE_STEP(H, c, d, a, b, 15, 0x1fa27cf8, 16)
+    LANE_STEP(H, b, c, d, a, 2, 0xc4ac5665, 23)
+
+    // Round 4
+    LANE_STEP(I, a, b, c, d, 0, 0xf4292244, 6)
+    LANE_STEP(I, d, a, b, c, 7, 0x432aff97, 10)
+    LANE_STEP(I, c, d, a, b, 14, 0xab9423a7, 15)
+    LANE_STEP(I, b, c, d, a, 5, 0xfc93a039, 21)
+    LANE_STEP(I, a, b, c, d, 12, 0x655b59c3, 6)
+    LANE_STEP(I, d, a, b, c, 3, 0x8f0ccc92, 10)
+    LANE_STEP(I, c, d, a, b, 10, 0xffeff47d, 15)
+    LANE_STEP(I, b, c, d, a, 1, 0x85845dd1, 21)
+    LANE_STEP(I, a, b, c, d, 8, 0x6fa87e4f, 6)
+    LANE_STEP(I, d, a, b, c, 15, 0xfe2ce6e0, 10)
+    LANE_STEP(I, c, d, a, b, 6, 0xa3014314, 15)
+    LANE_STEP(I, b, c, d, a, 13, 0x4e0811a1, 21)
+    LANE_STEP(I, a, b, c, d, 4, 0xf7537e82, 6)
+    LANE_STEP(I, d, a, b, c, 11, 0xbd3af235, 10)
+    LANE_STEP(I, c, d, a, b, 2, 0x2ad7d2bb, 15)
+    LANE_STEP(I, b, c, d, a, 9, 0xeb86d391, 21)
+
+    // Lanes without any blocks left keep their state
+    for (int lane = 0; lane < MD5_BATCH_LANES; ++lane) {
+      uint32_t mask = i < blocks[lane].count ? 0xffffffff : 0;
+      a[lane] = ((a[lane] + saved_a[lane]) & mask) | (saved_a[lane] & ~mask);
+      b[lane] = ((b[lane] + saved_b[lane]) & mask) | (saved_b[lane] & ~mask);
+      c[lane] = ((c[lane] + saved_c[lane]) & mask) | (saved_c[lane] & ~mask);
+      d[lane] = ((d[lane] + saved_d[lane]) & mask) | (saved_d[lane] & ~mask);
+    }
+  }
+
+  for (size_t lane = 0; lane < lanes; ++lane) {
+    uint32_t state[4] = { a[lane], b[lane], c[lane], d[lane] };
+    uint8_t* digest = digests + lane * 16;
+    for (int i = 0; i < 16; ++i) {
+      digest[i] = static_cast<uint8_t>(state[i / 4] >> (8 * (i % 4)));
+    }
+  }
+}
+
+} // namespace
+
+void datastax::internal::md5_batch(const uint8_t* const* data, const size_t* sizes, size_t count,
+                                   uint8_t* digests) {
+  for (size_t i = 0; i < count; i += MD5_BATCH_LANES) {
+    size_t lanes = count - i < MD5_BATCH_LANES ? count - i : MD5_BATCH_LANES;
+    md5_lanes(data + i, sizes + i, lanes, digests + i * 16);
+  }
+}
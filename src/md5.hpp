@@ -49,6 +49,19 @@ private:
   DISALLOW_COPY_AND_ASSIGN(Md5);
 };
 
+/**
+ * Compute the MD5 digests of many messages. The messages are hashed several at
+ * a time with their blocks interleaved so that the independent rounds of
+ * each message can be vectorized.
+ *
+ * @param data The messages.
+ * @param sizes The sizes of the messages.
+ * @param count The number of messages.
+ * @param digests The 16 byte digests of the messages (output). It must have
+ * room for count * 16 bytes.
+ */
+void md5_batch(const uint8_t* const* data, const size_t* sizes, size_t count, uint8_t* digests);
+
 }} // namespace datastax::internal
 
 #endif
@@ -0,0 +1,69 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_MEMORY_ACCOUNTING_HPP
+#define DATASTAX_INTERNAL_MEMORY_ACCOUNTING_HPP
+
+#include "atomic.hpp"
+
+#include <stddef.h>
+
+namespace datastax { namespace internal {
+
+enum MemoryCategory {
+  MEMORY_CATEGORY_REQUEST_BUFFERS,  // Encoded requests and bound values
+  MEMORY_CATEGORY_RESPONSE_BUFFERS, // Socket reads and response bodies (including pooled buffers)
+  MEMORY_CATEGORY_METADATA,         // Encoded schema metadata values
+  MEMORY_CATEGORY_SSL_BUFFERS,      // The ring buffers of SSL connections
+  MEMORY_CATEGORY_COUNT
+};
+
+/**
+ * Process-wide counts of the bytes allocated by the driver's larger
+ * subsystems. The allocations are counted where they're made instead of in
+ * `Memory::malloc()` because a free doesn't know the size of the memory it
+ * frees.
+ */
+class MemoryAccounting {
+public:
+  static void add(MemoryCategory category, size_t size) {
+    bytes_[category].fetch_add(size, MEMORY_ORDER_RELAXED);
+  }
+
+  static void remove(MemoryCategory category, size_t size) {
+    bytes_[category].fetch_sub(size, MEMORY_ORDER_RELAXED);
+  }
+
+  static size_t bytes(MemoryCategory category) {
+    return bytes_[category].load(MEMORY_ORDER_RELAXED);
+  }
+
+  /**
+   * The bytes used by request and response buffers. This is the memory that
+   * grows with the number of requests and it's the memory bounded by the
+   * session's memory limit.
+   */
+  static size_t buffer_bytes() {
+    return bytes(MEMORY_CATEGORY_REQUEST_BUFFERS) + bytes(MEMORY_CATEGORY_RESPONSE_BUFFERS);
+  }
+
+private:
+  static Atomic<size_t> bytes_[MEMORY_CATEGORY_COUNT];
+};
+
+}} // namespace datastax::internal
+
+#endif
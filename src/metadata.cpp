@@ -747,53 +747,100 @@ String Metadata::full_function_name(const String& name, const StringVec& signatu
   return full_function_name;
 }
 
+KeyspaceMetadata* Metadata::build_keyspace(const SchemaRows& rows,
+                                           const KeyspaceMetadata& keyspace) {
+  const VersionNumber& server_version = rows.server_version;
+  SimpleDataTypeCache cache;
+
+  InternalData data(keyspace.name());
+  data.keyspaces_->insert(std::make_pair(keyspace.name(), keyspace));
+
+  if (rows.tables) {
+    data.update_tables(server_version, rows.tables.get());
+  }
+
+  if (rows.views) {
+    data.update_views(server_version, rows.views.get());
+  }
+
+  if (rows.columns) {
+    data.update_columns(server_version, cache, rows.columns.get());
+    if (server_version < VersionNumber(3, 0, 0)) {
+      data.update_legacy_indexes(server_version, rows.columns.get());
+    }
+  }
+
+  if (rows.indexes) {
+    data.update_indexes(server_version, rows.indexes.get());
+  }
+
+  if (rows.user_types) {
+    data.update_user_types(server_version, cache, rows.user_types.get());
+  }
+
+  if (rows.functions) {
+    data.update_functions(server_version, cache, rows.functions.get());
+  }
+
+  if (rows.aggregates) {
+    data.update_aggregates(server_version, cache, rows.aggregates.get());
+  }
+
+  return new KeyspaceMetadata(data.keyspaces_->find(keyspace.name())->second);
+}
+
 Metadata::SchemaSnapshot Metadata::schema_snapshot() const {
   ScopedMutex l(&mutex_);
-  return SchemaSnapshot(schema_snapshot_version_, server_version_, front_.keyspaces());
+  return SchemaSnapshot(schema_snapshot_version_.load(MEMORY_ORDER_RELAXED), server_version_,
+                        front_.keyspaces());
 }
 
-void Metadata::update_keyspaces(const ResultResponse* result, bool is_virtual) {
-  schema_snapshot_version_++;
+void Metadata::increment_schema_snapshot_version() {
+  // Only the cluster's thread updates the version (while holding the lock) so
+  // a load and a store are enough. The release makes the updated schema
+  // visible to the threads that see the new version.
+  schema_snapshot_version_.store(schema_snapshot_version_.load(MEMORY_ORDER_RELAXED) + 1,
+                                 MEMORY_ORDER_RELEASE);
+}
 
+void Metadata::update_keyspaces(const ResultResponse* result, bool is_virtual) {
   if (is_front_buffer()) {
     ScopedMutex l(&mutex_);
     updating_->update_keyspaces(server_version_, result, is_virtual);
+    increment_schema_snapshot_version();
   } else {
     updating_->update_keyspaces(server_version_, result, is_virtual);
   }
 }
 
 void Metadata::update_tables(const ResultResponse* result) {
-  schema_snapshot_version_++;
-
   if (is_front_buffer()) {
     ScopedMutex l(&mutex_);
     updating_->update_tables(server_version_, result);
+    increment_schema_snapshot_version();
   } else {
     updating_->update_tables(server_version_, result);
   }
 }
 
 void Metadata::update_views(const ResultResponse* result) {
-  schema_snapshot_version_++;
-
   if (is_front_buffer()) {
     ScopedMutex l(&mutex_);
     updating_->update_views(server_version_, result);
+    increment_schema_snapshot_version();
   } else {
     updating_->update_views(server_version_, result);
   }
 }
 
 void Metadata::update_columns(const ResultResponse* result) {
-  schema_snapshot_version_++;
-
   if (is_front_buffer()) {
     ScopedMutex l(&mutex_);
     updating_->update_columns(server_version_, cache_, result);
     if (server_version_ < VersionNumber(3, 0, 0)) {
       updating_->update_legacy_indexes(server_version_, result);
     }
+    increment_schema_snapshot_version();
   } else {
     updating_->update_columns(server_version_, cache_, result);
     if (server_version_ < VersionNumber(3, 0, 0)) {
@@ -803,99 +850,100 @@ void Metadata::update_columns(const ResultResponse* result) {
 }
 
 void Metadata::update_indexes(const ResultResponse* result) {
-  schema_snapshot_version_++;
-
   if (is_front_buffer()) {
     ScopedMutex l(&mutex_);
     updating_->update_indexes(server_version_, result);
+    increment_schema_snapshot_version();
   } else {
     updating_->update_indexes(server_version_, result);
   }
 }
 
 void Metadata::update_user_types(const ResultResponse* result) {
-  schema_snapshot_version_++;
-
   if (is_front_buffer()) {
     ScopedMutex l(&mutex_);
     updating_->update_user_types(server_version_, cache_, result);
+    increment_schema_snapshot_version();
   } else {
     updating_->update_user_types(server_version_, cache_, result);
   }
 }
 
 void Metadata::update_functions(const ResultResponse* result) {
-  schema_snapshot_version_++;
-
   if (is_front_buffer()) {
     ScopedMutex l(&mutex_);
     updating_->update_functions(server_version_, cache_, result);
+    increment_schema_snapshot_version();
   } else {
     updating_->update_functions(server_version_, cache_, result);
   }
 }
 
 void Metadata::update_aggregates(const ResultResponse* result) {
-  schema_snapshot_version_++;
-
   if (is_front_buffer()) {
     ScopedMutex l(&mutex_);
     updating_->update_aggregates(server_version_, cache_, result);
+    increment_schema_snapshot_version();
   } else {
     updating_->update_aggregates(server_version_, cache_, result);
   }
 }
 
-void Metadata::drop_keyspace(const String& keyspace_name) {
-  schema_snapshot_version_++;
+void Metadata::set_lazy_keyspaces(const SchemaRows::ConstPtr& rows) {
+  if (is_front_buffer()) {
+    ScopedMutex l(&mutex_);
+    updating_->set_lazy_keyspaces(rows);
+    increment_schema_snapshot_version();
+  } else {
+    updating_->set_lazy_keyspaces(rows);
+  }
+}
 
+void Metadata::drop_keyspace(const String& keyspace_name) {
   if (is_front_buffer()) {
     ScopedMutex l(&mutex_);
     updating_->drop_keyspace(keyspace_name);
+    increment_schema_snapshot_version();
   } else {
     updating_->drop_keyspace(keyspace_name);
   }
 }
 
 void Metadata::drop_table_or_view(const String& keyspace_name, const String& table_or_view_name) {
-  schema_snapshot_version_++;
-
   if (is_front_buffer()) {
     ScopedMutex l(&mutex_);
     updating_->drop_table_or_view(keyspace_name, table_or_view_name);
+    increment_schema_snapshot_version();
   } else {
     updating_->drop_table_or_view(keyspace_name, table_or_view_name);
   }
 }
 
 void Metadata::drop_user_type(const String& keyspace_name, const String& type_name) {
-  schema_snapshot_version_++;
-
   if (is_front_buffer()) {
     ScopedMutex l(&mutex_);
     updating_->drop_user_type(keyspace_name, type_name);
+    increment_schema_snapshot_version();
   } else {
     updating_->drop_user_type(keyspace_name, type_name);
   }
 }
 
 void Metadata::drop_function(const String& keyspace_name, const String& full_function_name) {
-  schema_snapshot_version_++;
-
   if (is_front_buffer()) {
     ScopedMutex l(&mutex_);
     updating_->drop_function(keyspace_name, full_function_name);
+    increment_schema_snapshot_version();
   } else {
     updating_->drop_function(keyspace_name, full_function_name);
   }
 }
 
 void Metadata::drop_aggregate(const String& keyspace_name, const String& full_aggregate_name) {
-  schema_snapshot_version_++;
-
   if (is_front_buffer()) {
     ScopedMutex l(&mutex_);
     updating_->drop_aggregate(keyspace_name, full_aggregate_name);
+    increment_schema_snapshot_version();
   } else {
     updating_->drop_aggregate(keyspace_name, full_aggregate_name);
   }
@@ -913,8 +961,8 @@ void Metadata::clear_and_update_back(const VersionNumber& server_version) {
 void Metadata::swap_to_back_and_update_front() {
   {
     ScopedMutex l(&mutex_);
-    schema_snapshot_version_++;
     front_.swap(back_);
+    increment_schema_snapshot_version();
   }
   back_.clear();
   updating_ = &front_;
@@ -923,8 +971,8 @@ void Metadata::swap_to_back_and_update_front() {
 void Metadata::clear() {
   {
     ScopedMutex l(&mutex_);
-    schema_snapshot_version_ = 0;
     front_.clear();
+    increment_schema_snapshot_version(); // Never reset so that old snapshots don't look current
   }
   back_.clear();
 }
@@ -988,7 +1036,7 @@ void MetadataBase::add_json_list_field(const Row* row, const String& name) {
   }
 
   size_t encoded_size = collection.get_items_size();
-  RefBuffer::Ptr encoded(RefBuffer::create(encoded_size));
+  RefBuffer::Ptr encoded(RefBuffer::create(encoded_size, MEMORY_CATEGORY_METADATA));
 
   collection.encode_items(encoded->data());
 
@@ -1029,7 +1077,7 @@ const Value* MetadataBase::add_json_map_field(const Row* row, const String& name
   }
 
   size_t encoded_size = collection.get_items_size();
-  RefBuffer::Ptr encoded(RefBuffer::create(encoded_size));
+  RefBuffer::Ptr encoded(RefBuffer::create(encoded_size, MEMORY_CATEGORY_METADATA));
 
   collection.encode_items(encoded->data());
 
@@ -1040,18 +1088,21 @@ const Value* MetadataBase::add_json_map_field(const Row* row, const String& name
 }
 
 const TableMetadata* KeyspaceMetadata::get_table(const String& name) const {
-  TableMetadata::Map::const_iterator i = tables_->find(name);
-  if (i == tables_->end()) return NULL;
+  const TableMetadata::Map& tables = *loaded().tables_;
+  TableMetadata::Map::const_iterator i = tables.find(name);
+  if (i == tables.end()) return NULL;
   return i->second.get();
 }
 
 const TableMetadata::Ptr& KeyspaceMetadata::get_table(const String& name) {
+  load();
   TableMetadata::Map::iterator i = tables_->find(name);
   if (i == tables_->end()) return TableMetadata::NIL;
   return i->second;
 }
 
 void KeyspaceMetadata::add_table(const TableMetadata::Ptr& table) {
+  load();
   TableMetadata::Map::iterator table_it = tables_->find(table->name());
 
   // If there's a previous version of this table then copy its views
@@ -1077,20 +1128,26 @@ void KeyspaceMetadata::internal_add_table(const TableMetadata::Ptr& table,
 }
 
 const ViewMetadata* KeyspaceMetadata::get_view(const String& name) const {
-  ViewMetadata::Map::const_iterator i = views_->find(name);
-  if (i == views_->end()) return NULL;
+  const ViewMetadata::Map& views = *loaded().views_;
+  ViewMetadata::Map::const_iterator i = views.find(name);
+  if (i == views.end()) return NULL;
   return i->second.get();
 }
 
 const ViewMetadata::Ptr& KeyspaceMetadata::get_view(const String& name) {
+  load();
   ViewMetadata::Map::iterator i = views_->find(name);
   if (i == views_->end()) return ViewMetadata::NIL;
   return i->second;
 }
 
-void KeyspaceMetadata::add_view(const ViewMetadata::Ptr& view) { (*views_)[view->name()] = view; }
+void KeyspaceMetadata::add_view(const ViewMetadata::Ptr& view) {
+  load();
+  (*views_)[view->name()] = view;
+}
 
 void KeyspaceMetadata::drop_table_or_view(const String& table_or_view_name) {
+  load();
   TableMetadata::Map::iterator table_it = tables_->find(table_or_view_name);
   if (table_it != tables_->end()) { // The name is for a table, remove the
     // table and views from keyspace
@@ -1127,6 +1184,7 @@ void KeyspaceMetadata::drop_table_or_view(const String& table_or_view_name) {
 }
 
 const UserType::Ptr& KeyspaceMetadata::get_or_create_user_type(const String& name, bool is_frozen) {
+  load();
   UserType::Map::iterator i = user_types_->find(name);
   if (i == user_types_->end()) {
     i = user_types_
@@ -1138,8 +1196,9 @@ const UserType::Ptr& KeyspaceMetadata::get_or_create_user_type(const String& nam
 }
 
 const UserType* KeyspaceMetadata::get_user_type(const String& name) const {
-  UserType::Map::const_iterator i = user_types_->find(name);
-  if (i == user_types_->end()) return NULL;
+  const UserType::Map& user_types = *loaded().user_types_;
+  UserType::Map::const_iterator i = user_types.find(name);
+  if (i == user_types.end()) return NULL;
   return i->second.get();
 }
 
@@ -1173,36 +1232,87 @@ void KeyspaceMetadata::update(const VersionNumber& server_version, const RefBuff
   }
 }
 
-void KeyspaceMetadata::drop_user_type(const String& type_name) { user_types_->erase(type_name); }
+void KeyspaceMetadata::drop_user_type(const String& type_name) {
+  load();
+  user_types_->erase(type_name);
+}
 
 void KeyspaceMetadata::add_function(const FunctionMetadata::Ptr& function) {
+  load();
   (*functions_)[function->name()] = function;
 }
 
 const FunctionMetadata* KeyspaceMetadata::get_function(const String& full_function_name) const {
-  FunctionMetadata::Map::const_iterator i = functions_->find(full_function_name);
-  if (i == functions_->end()) return NULL;
+  const FunctionMetadata::Map& functions = *loaded().functions_;
+  FunctionMetadata::Map::const_iterator i = functions.find(full_function_name);
+  if (i == functions.end()) return NULL;
   return i->second.get();
 }
 
 void KeyspaceMetadata::drop_function(const String& full_function_name) {
+  load();
   functions_->erase(full_function_name);
 }
 
 const AggregateMetadata* KeyspaceMetadata::get_aggregate(const String& full_aggregate_name) const {
-  AggregateMetadata::Map::const_iterator i = aggregates_->find(full_aggregate_name);
-  if (i == aggregates_->end()) return NULL;
+  const AggregateMetadata::Map& aggregates = *loaded().aggregates_;
+  AggregateMetadata::Map::const_iterator i = aggregates.find(full_aggregate_name);
+  if (i == aggregates.end()) return NULL;
   return i->second.get();
 }
 
 void KeyspaceMetadata::add_aggregate(const AggregateMetadata::Ptr& aggregate) {
+  load();
   (*aggregates_)[aggregate->name()] = aggregate;
 }
 
 void KeyspaceMetadata::drop_aggregate(const String& full_aggregate_name) {
+  load();
   aggregates_->erase(full_aggregate_name);
 }
 
+void KeyspaceMetadata::set_lazy(const SchemaRows::ConstPtr& rows) {
+  tables_ = CopyOnWritePtr<TableMetadata::Map>(new TableMetadata::Map());
+  views_ = CopyOnWritePtr<ViewMetadata::Map>(new ViewMetadata::Map());
+  user_types_ = CopyOnWritePtr<UserType::Map>(new UserType::Map());
+  functions_ = CopyOnWritePtr<FunctionMetadata::Map>(new FunctionMetadata::Map());
+  aggregates_ = CopyOnWritePtr<AggregateMetadata::Map>(new AggregateMetadata::Map());
+  lazy_.reset(new LazyElements(rows));
+}
+
+bool KeyspaceMetadata::is_loaded() const { return !lazy_ || lazy_->is_loaded(); }
+
+const KeyspaceMetadata& KeyspaceMetadata::loaded() const {
+  if (!lazy_) return *this;
+  return lazy_->get(*this);
+}
+
+void KeyspaceMetadata::load() {
+  if (!lazy_) return;
+  const KeyspaceMetadata& keyspace = lazy_->get(*this);
+  tables_ = keyspace.tables_;
+  views_ = keyspace.views_;
+  user_types_ = keyspace.user_types_;
+  functions_ = keyspace.functions_;
+  aggregates_ = keyspace.aggregates_;
+  lazy_.reset();
+}
+
+const KeyspaceMetadata& KeyspaceMetadata::LazyElements::get(const KeyspaceMetadata& keyspace) {
+  if (!is_loaded_.load(MEMORY_ORDER_ACQUIRE)) {
+    ScopedMutex l(&mutex_);
+    if (!is_loaded_.load(MEMORY_ORDER_RELAXED)) {
+      // Build from a copy without the lazy elements
+      KeyspaceMetadata copy(keyspace);
+      copy.lazy_.reset();
+      keyspace_.reset(Metadata::build_keyspace(*rows_, copy));
+      rows_.reset();
+      is_loaded_.store(true, MEMORY_ORDER_RELEASE);
+    }
+  }
+  return *keyspace_;
+}
+
 TableMetadataBase::TableMetadataBase(const VersionNumber& server_version, const String& name,
                                      const RefBuffer::Ptr& buffer, const Row* row, bool is_virtual)
     : MetadataBase(name)
@@ -1856,6 +1966,7 @@ void Metadata::InternalData::update_keyspaces(const VersionNumber& server_versio
     }
 
     KeyspaceMetadata* keyspace = get_or_create_keyspace(keyspace_name, is_virtual);
+    if (keyspace == NULL) continue; // Filtered
     keyspace->update(server_version, buffer, row);
   }
 }
@@ -1886,6 +1997,8 @@ void Metadata::InternalData::update_tables(const VersionNumber& server_version,
       keyspace = get_or_create_keyspace(keyspace_name);
     }
 
+    if (keyspace == NULL) continue; // Filtered
+
     keyspace->add_table(TableMetadata::Ptr(
         new TableMetadata(server_version, table_name, buffer, row, keyspace->is_virtual())));
   }
@@ -1919,6 +2032,8 @@ void Metadata::InternalData::update_views(const VersionNumber& server_version,
       keyspace = get_or_create_keyspace(keyspace_name);
     }
 
+    if (keyspace == NULL) continue; // Filtered
+
     if (!row->get_string_by_name("base_table_name", &base_table_name)) {
       LOG_ERROR("Unable to get column value for 'base_table_name'");
       continue;
@@ -1972,6 +2087,8 @@ void Metadata::InternalData::update_user_types(const VersionNumber& server_versi
       keyspace = get_or_create_keyspace(keyspace_name);
     }
 
+    if (keyspace == NULL) continue; // Filtered
+
     const Value* names_value = row->get_by_name("field_names");
     if (names_value == NULL || names_value->is_null()) {
       LOG_ERROR("'field_name's column for keyspace \"%s\" and type \"%s\" is null",
@@ -2058,6 +2175,8 @@ void Metadata::InternalData::update_functions(const VersionNumber& server_versio
       keyspace = get_or_create_keyspace(keyspace_name);
     }
 
+    if (keyspace == NULL) continue; // Filtered
+
     keyspace->add_function(FunctionMetadata::Ptr(new FunctionMetadata(
         server_version, cache, function_name, signature, keyspace, buffer, row)));
   }
@@ -2090,11 +2209,22 @@ void Metadata::InternalData::update_aggregates(const VersionNumber& server_versi
       keyspace = get_or_create_keyspace(keyspace_name);
     }
 
+    if (keyspace == NULL) continue; // Filtered
+
     keyspace->add_aggregate(AggregateMetadata::Ptr(new AggregateMetadata(
         server_version, cache, aggregate_name, signature, keyspace, buffer, row)));
   }
 }
 
+void Metadata::InternalData::set_lazy_keyspaces(const SchemaRows::ConstPtr& rows) {
+  for (KeyspaceMetadata::Map::iterator i = keyspaces_->begin(), end = keyspaces_->end(); i != end;
+       ++i) {
+    if (!i->second.is_virtual()) {
+      i->second.set_lazy(rows);
+    }
+  }
+}
+
 void Metadata::InternalData::drop_keyspace(const String& keyspace_name) {
   keyspaces_->erase(keyspace_name);
 }
@@ -2159,6 +2289,8 @@ void Metadata::InternalData::update_columns(const VersionNumber& server_version,
       table_or_view_name.clear();
     }
 
+    if (keyspace == NULL) continue; // Filtered
+
     if (table_or_view_name != temp_table_or_view_name) {
       // Build keys for the previous table
       if (table_or_view) {
@@ -2218,6 +2350,8 @@ void Metadata::InternalData::update_legacy_indexes(const VersionNumber& server_v
       table_name.clear();
     }
 
+    if (keyspace == NULL) continue; // Filtered
+
     if (table_name != temp_table_name) {
       table_name = temp_table_name;
       table = keyspace->get_table(table_name);
@@ -2269,6 +2403,8 @@ void Metadata::InternalData::update_indexes(const VersionNumber& server_version,
       table_name.clear();
     }
 
+    if (keyspace == NULL) continue; // Filtered
+
     if (table_name != temp_table_name) {
       table_name = temp_table_name;
       table = keyspace->get_table(table_name);
@@ -2282,6 +2418,7 @@ void Metadata::InternalData::update_indexes(const VersionNumber& server_version,
 
 KeyspaceMetadata* Metadata::InternalData::get_or_create_keyspace(const String& name,
                                                                  bool is_virtual) {
+  if (!keyspace_filter_.empty() && name != keyspace_filter_) return NULL;
   KeyspaceMetadata::Map::iterator i = keyspaces_->find(name);
   if (i == keyspaces_->end()) {
     i = keyspaces_->insert(std::make_pair(name, KeyspaceMetadata(name, is_virtual))).first;
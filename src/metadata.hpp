@@ -18,6 +18,7 @@
 #define DATASTAX_INTERNAL_SCHEMA_METADATA_HPP
 
 #include "allocated.hpp"
+#include "atomic.hpp"
 #include "copy_on_write_ptr.hpp"
 #include "data_type.hpp"
 #include "external.hpp"
@@ -26,6 +27,7 @@
 #include "macros.hpp"
 #include "map.hpp"
 #include "ref_counted.hpp"
+#include "result_response.hpp"
 #include "scoped_lock.hpp"
 #include "scoped_ptr.hpp"
 #include "string.hpp"
@@ -494,11 +496,35 @@ private:
   IndexMetadata::Map indexes_by_name_;
 };
 
+/**
+ * The schema rows retained to lazily build the tables, views, user types,
+ * functions and aggregates of keyspaces. The rows of all keyspaces are shared
+ * by the keyspaces built from them.
+ */
+struct SchemaRows : public RefCounted<SchemaRows> {
+  typedef SharedRefPtr<SchemaRows> Ptr;
+  typedef SharedRefPtr<const SchemaRows> ConstPtr;
+
+  SchemaRows(const VersionNumber& server_version)
+      : server_version(server_version) {}
+
+  VersionNumber server_version;
+  ResultResponse::Ptr tables;
+  ResultResponse::Ptr views;
+  ResultResponse::Ptr columns;
+  ResultResponse::Ptr indexes;
+  ResultResponse::Ptr user_types;
+  ResultResponse::Ptr functions;
+  ResultResponse::Ptr aggregates;
+};
+
 class KeyspaceMetadata : public MetadataBase {
 public:
   typedef internal::Map<String, KeyspaceMetadata> Map;
   typedef CopyOnWritePtr<KeyspaceMetadata::Map> MapPtr;
 
+  class LazyElements;
+
   class TableIterator : public MetadataIteratorImpl<MapIteratorImpl<TableMetadata::Ptr> > {
   public:
     TableIterator(const TableIterator::Collection& collection)
@@ -542,34 +568,50 @@ public:
 
   void update(const VersionNumber& server_version, const RefBuffer::Ptr& buffer, const Row* row);
 
+  /**
+   * Build the keyspace's elements (tables, views, user types, functions and
+   * aggregates) from the retained schema rows the first time they're
+   * accessed.
+   *
+   * @param rows The schema rows of all keyspaces.
+   */
+  void set_lazy(const SchemaRows::ConstPtr& rows);
+
+  /**
+   * Determines if the keyspace's elements have been built.
+   *
+   * @return true if the elements aren't lazy or have already been accessed.
+   */
+  bool is_loaded() const;
+
   bool is_virtual() const { return is_virtual_; }
 
-  const FunctionMetadata::Map& functions() const { return *functions_; }
-  const UserType::Map& user_types() const { return *user_types_; }
+  const FunctionMetadata::Map& functions() const { return *loaded().functions_; }
+  const UserType::Map& user_types() const { return *loaded().user_types_; }
 
-  Iterator* iterator_tables() const { return new TableIterator(*tables_); }
+  Iterator* iterator_tables() const { return new TableIterator(*loaded().tables_); }
   const TableMetadata* get_table(const String& name) const;
   const TableMetadata::Ptr& get_table(const String& name);
   void add_table(const TableMetadata::Ptr& table);
 
-  Iterator* iterator_views() const { return new ViewIteratorMap(*views_); }
+  Iterator* iterator_views() const { return new ViewIteratorMap(*loaded().views_); }
   const ViewMetadata* get_view(const String& name) const;
   const ViewMetadata::Ptr& get_view(const String& name);
   void add_view(const ViewMetadata::Ptr& view);
 
   void drop_table_or_view(const String& table_name);
 
-  Iterator* iterator_user_types() const { return new TypeIterator(*user_types_); }
+  Iterator* iterator_user_types() const { return new TypeIterator(*loaded().user_types_); }
   const UserType* get_user_type(const String& type_name) const;
   const UserType::Ptr& get_or_create_user_type(const String& name, bool is_frozen);
   void drop_user_type(const String& type_name);
 
-  Iterator* iterator_functions() const { return new FunctionIterator(*functions_); }
+  Iterator* iterator_functions() const { return new FunctionIterator(*loaded().functions_); }
   const FunctionMetadata* get_function(const String& full_function_name) const;
   void add_function(const FunctionMetadata::Ptr& function);
   void drop_function(const String& full_function_name);
 
-  Iterator* iterator_aggregates() const { return new AggregateIterator(*aggregates_); }
+  Iterator* iterator_aggregates() const { return new AggregateIterator(*loaded().aggregates_); }
   const AggregateMetadata* get_aggregate(const String& full_aggregate_name) const;
   void add_aggregate(const AggregateMetadata::Ptr& aggregate);
   void drop_aggregate(const String& full_aggregate_name);
@@ -580,6 +622,13 @@ public:
 private:
   void internal_add_table(const TableMetadata::Ptr& table, const ViewMetadata::Vec& views);
 
+  // The keyspace with built elements. This is the keyspace itself unless its
+  // elements are lazy.
+  const KeyspaceMetadata& loaded() const;
+
+  // Take ownership of the lazily built elements before they're modified
+  void load();
+
 private:
   const bool is_virtual_;
   StringRef strategy_class_;
@@ -590,6 +639,42 @@ private:
   CopyOnWritePtr<UserType::Map> user_types_;
   CopyOnWritePtr<FunctionMetadata::Map> functions_;
   CopyOnWritePtr<AggregateMetadata::Map> aggregates_;
+  SharedRefPtr<LazyElements> lazy_;
+};
+
+/**
+ * A keyspace's elements that are built from the retained schema rows on first
+ * access. This is shared by the copies of a keyspace and can be accessed from
+ * multiple threads.
+ */
+class KeyspaceMetadata::LazyElements : public RefCounted<KeyspaceMetadata::LazyElements> {
+public:
+  LazyElements(const SchemaRows::ConstPtr& rows)
+      : rows_(rows)
+      , is_loaded_(false) {
+    uv_mutex_init(&mutex_);
+  }
+
+  ~LazyElements() { uv_mutex_destroy(&mutex_); }
+
+  bool is_loaded() const { return is_loaded_.load(MEMORY_ORDER_ACQUIRE); }
+
+  /**
+   * Get the keyspace with built elements, building them if needed.
+   *
+   * @param keyspace The keyspace the elements belong to.
+   * @return The keyspace with built elements.
+   */
+  const KeyspaceMetadata& get(const KeyspaceMetadata& keyspace);
+
+private:
+  SchemaRows::ConstPtr rows_;
+  Atomic<bool> is_loaded_;
+  uv_mutex_t mutex_;
+  ScopedPtr<KeyspaceMetadata> keyspace_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(LazyElements);
 };
 
 class Metadata {
@@ -626,6 +711,17 @@ public:
 
   static String full_function_name(const String& name, const StringVec& signature);
 
+  /**
+   * Build a keyspace's elements from schema rows.
+   *
+   * @param rows The schema rows of all keyspaces.
+   * @param keyspace The keyspace to build.
+   * @return A copy of the keyspace with its tables, views, user types,
+   * functions and aggregates.
+   */
+  static KeyspaceMetadata* build_keyspace(const SchemaRows& rows,
+                                          const KeyspaceMetadata& keyspace);
+
 public:
   Metadata()
       : updating_(&front_)
@@ -637,6 +733,17 @@ public:
 
   SchemaSnapshot schema_snapshot() const;
 
+  /**
+   * Get the version of the current schema without taking a snapshot
+   * (lock-free). A snapshot is up-to-date while its version is the current
+   * version.
+   *
+   * @return The current schema snapshot version.
+   */
+  uint32_t schema_snapshot_version() const {
+    return schema_snapshot_version_.load(MEMORY_ORDER_ACQUIRE);
+  }
+
   void update_keyspaces(const ResultResponse* result, bool is_virtual);
   void update_tables(const ResultResponse* result);
   void update_views(const ResultResponse* result);
@@ -646,6 +753,10 @@ public:
   void update_functions(const ResultResponse* result);
   void update_aggregates(const ResultResponse* result);
 
+  // Make the elements of the existing (non-virtual) keyspaces lazy instead of
+  // building them using the update methods above.
+  void set_lazy_keyspaces(const SchemaRows::ConstPtr& rows);
+
   void drop_keyspace(const String& keyspace_name);
   void drop_table_or_view(const String& keyspace_name, const String& table_or_view_name);
   void drop_user_type(const String& keyspace_name, const String& type_name);
@@ -664,6 +775,7 @@ public:
 
 private:
   bool is_front_buffer() const { return updating_ == &front_; }
+  void increment_schema_snapshot_version();
 
 private:
   class InternalData {
@@ -671,6 +783,11 @@ private:
     InternalData()
         : keyspaces_(new KeyspaceMetadata::Map()) {}
 
+    // Only build the given keyspace, rows for other keyspaces are skipped
+    InternalData(const String& keyspace_filter)
+        : keyspaces_(new KeyspaceMetadata::Map())
+        , keyspace_filter_(keyspace_filter) {}
+
     const KeyspaceMetadata::MapPtr& keyspaces() const { return keyspaces_; }
 
     void update_keyspaces(const VersionNumber& server_version, const ResultResponse* result,
@@ -688,6 +805,8 @@ private:
     void update_aggregates(const VersionNumber& server_version, SimpleDataTypeCache& cache,
                            const ResultResponse* result);
 
+    void set_lazy_keyspaces(const SchemaRows::ConstPtr& rows);
+
     void drop_keyspace(const String& keyspace_name);
     void drop_table_or_view(const String& keyspace_name, const String& table_or_view_name);
     void drop_user_type(const String& keyspace_name, const String& type_name);
@@ -706,7 +825,9 @@ private:
     KeyspaceMetadata* get_or_create_keyspace(const String& name, bool is_virtual = false);
 
   private:
+    friend class Metadata;
     CopyOnWritePtr<KeyspaceMetadata::Map> keyspaces_;
+    String keyspace_filter_;
 
   private:
     DISALLOW_COPY_AND_ASSIGN(InternalData);
@@ -717,7 +838,7 @@ private:
   InternalData back_;
 
   VersionNumber server_version_;
-  uint32_t schema_snapshot_version_;
+  Atomic<uint32_t> schema_snapshot_version_;
 
   // This lock prevents partial snapshots when updating metadata
   mutable uv_mutex_t mutex_;
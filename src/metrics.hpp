@@ -20,12 +20,17 @@
 #ifndef DATASTAX_INTERNAL_METRICS_HPP
 #define DATASTAX_INTERNAL_METRICS_HPP
 
+#include "address.hpp"
 #include "allocated.hpp"
 #include "atomic.hpp"
 #include "constants.hpp"
+#include "get_time.hpp"
+#include "map.hpp"
 #include "scoped_lock.hpp"
 #include "scoped_ptr.hpp"
+#include "string.hpp"
 #include "utils.hpp"
+#include "vector.hpp"
 
 #include "third_party/hdr_histogram/hdr_histogram.hpp"
 
@@ -174,7 +179,7 @@ public:
               thread_state)
         , count_(thread_state)
         , speculative_request_count_(thread_state)
-        , start_time_(uv_hrtime())
+        , start_time_(get_time_monotonic_coarse_ns())
         , last_tick_(start_time_) {}
 
     void mark() {
@@ -192,10 +197,11 @@ public:
     double fifteen_minute_rate() const { return fifteen_minute_rate_.rate(); }
 
     double mean_rate() const {
-      if (count() == 0) {
+      uint64_t elapsed_ns = get_time_monotonic_coarse_ns() - start_time_;
+      if (count() == 0 || elapsed_ns == 0) {
         return 0.0;
       } else {
-        double elapsed = static_cast<double>(uv_hrtime() - start_time_) / 1e9;
+        double elapsed = static_cast<double>(elapsed_ns) / 1e9;
         return count() / elapsed;
       }
     }
@@ -223,7 +229,9 @@ public:
 
     void tick_if_necessary() {
       uint64_t old_tick = last_tick_.load();
-      uint64_t new_tick = uv_hrtime();
+      // Ticks are seconds apart so the coarse clock is precise enough and it
+      // avoids a high resolution clock read for every request
+      uint64_t new_tick = get_time_monotonic_coarse_ns();
       uint64_t elapsed = new_tick - old_tick;
 
       if (elapsed > TICK_INTERVAL) {
@@ -251,7 +259,7 @@ public:
     DISALLOW_COPY_AND_ASSIGN(Meter);
   };
 
-  class Histogram {
+  class Histogram : public Allocated {
   public:
     static const int64_t HIGHEST_TRACKABLE_VALUE = 3600LL * 1000LL * 1000LL;
 
@@ -268,15 +276,31 @@ public:
       int64_t percentile_999th;
     };
 
-    Histogram(ThreadState* thread_state)
+    struct Bucket {
+      Bucket(int64_t value, int64_t count)
+          : value(value)
+          , count(count) {}
+      int64_t value;
+      int64_t count;
+    };
+
+    Histogram(ThreadState* thread_state, int significant_figures = 3)
         : thread_state_(thread_state)
-        , histograms_(new PerThreadHistogram[thread_state->max_threads()]) {
-      hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, 3, &histogram_);
+        , histograms_(new PerThreadHistogram[thread_state->max_threads()])
+        , snapshot_max_age_ms_(0)
+        , snapshot_time_ms_(0)
+        , has_snapshot_(false) {
+      for (size_t i = 0; i < thread_state->max_threads(); ++i) {
+        histograms_[i].init(significant_figures);
+      }
+      hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, significant_figures, &histogram_);
+      hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, significant_figures, &interval_histogram_);
       uv_mutex_init(&mutex_);
     }
 
     ~Histogram() {
       free(histogram_);
+      free(interval_histogram_);
       uv_mutex_destroy(&mutex_);
     }
 
@@ -286,11 +310,95 @@ public:
 
     void get_snapshot(Snapshot* snapshot) const {
       ScopedMutex l(&mutex_);
+      uint64_t now_ms = get_time_monotonic_coarse_ns() / NANOSECONDS_PER_MILLISECOND;
+      if (!has_snapshot_ || now_ms - snapshot_time_ms_ >= snapshot_max_age_ms_) {
+        drain();
+        fill_snapshot(histogram_, &snapshot_);
+        snapshot_time_ms_ = now_ms;
+        has_snapshot_ = true;
+      }
+      *snapshot = snapshot_;
+    }
+
+    /**
+     * Reuse snapshots taken less than `max_age_ms` ago in get_snapshot()
+     * instead of merging the threads' values and computing the percentiles
+     * again.
+     *
+     * @param max_age_ms The maximum age of a reused snapshot (0 to disable).
+     */
+    void set_snapshot_max_age_ms(uint64_t max_age_ms) {
+      ScopedMutex l(&mutex_);
+      snapshot_max_age_ms_ = max_age_ms;
+    }
+
+    /**
+     * Move the values recorded by each thread into the histogram so that
+     * taking snapshots has less to merge.
+     */
+    void merge() {
+      ScopedMutex l(&mutex_);
+      drain();
+    }
+
+    /**
+     * Get a snapshot of the values recorded since the last interval snapshot
+     * (or since the histogram was created), then start a new interval. Unlike
+     * get_snapshot() this shows recent changes in the latencies.
+     *
+     * @param snapshot The interval's snapshot.
+     * @param buckets If not NULL, the interval's recorded values and their
+     * counts, e.g. to write the interval to an HdrHistogram log.
+     */
+    void get_interval_snapshot(Snapshot* snapshot, Vector<Bucket>* buckets = NULL) const {
+      ScopedMutex l(&mutex_);
+      drain();
+      hdr_histogram* h = interval_histogram_;
+      fill_snapshot(h, snapshot);
+      if (buckets != NULL) {
+        buckets->clear();
+        hdr_iter iter;
+        hdr_iter_recorded_init(&iter, h);
+        while (hdr_iter_next(&iter)) {
+          buckets->push_back(Bucket(iter.highest_equivalent_value, iter.count_at_index));
+        }
+      }
+      hdr_reset(h);
+    }
+
+    /**
+     * Get the value at a percentile of the values recorded since the last
+     * reset, then reset the histogram. Nothing is reset if fewer than
+     * `min_count` values have been recorded.
+     *
+     * @param percentile The percentile (0.0 - 100.0).
+     * @param min_count The minimum number of recorded values.
+     * @return The value or -1 if there are not enough recorded values.
+     */
+    int64_t value_at_percentile_and_reset(double percentile, int64_t min_count) {
+      ScopedMutex l(&mutex_);
+      drain();
       hdr_histogram* h = histogram_;
+
+      if (h->total_count < min_count || h->total_count == 0) {
+        return -1;
+      }
+      int64_t value = hdr_value_at_percentile(h, percentile);
+      hdr_reset(h);
+      has_snapshot_ = false;
+      return value;
+    }
+
+  private:
+    // Move the values recorded by each thread into the lifetime and the
+    // interval histograms. This must be called with the mutex held.
+    void drain() const {
       for (size_t i = 0; i < thread_state_->max_threads(); ++i) {
-        histograms_[i].add(h);
+        histograms_[i].add(histogram_, interval_histogram_);
       }
+    }
 
+    static void fill_snapshot(hdr_histogram* h, Snapshot* snapshot) {
       if (h->total_count == 0) {
         // There is no data; default to 0 for the stats.
         snapshot->max = 0;
@@ -374,8 +482,12 @@ public:
     public:
       PerThreadHistogram()
           : active_index_(0) {
-        hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, 3, &histograms_[0]);
-        hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, 3, &histograms_[1]);
+        histograms_[0] = histograms_[1] = NULL;
+      }
+
+      void init(int significant_figures) {
+        hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, significant_figures, &histograms_[0]);
+        hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, significant_figures, &histograms_[1]);
       }
 
       ~PerThreadHistogram() {
@@ -390,11 +502,12 @@ public:
         phaser_.writer_critical_section_end(critical_value_enter);
       }
 
-      void add(hdr_histogram* to) const {
+      void add(hdr_histogram* to, hdr_histogram* interval) const {
         int inactive_index = active_index_.exchange(!active_index_.load());
         hdr_histogram* from = histograms_[inactive_index];
         phaser_.flip_phase();
         hdr_add(to, from);
+        hdr_add(interval, from);
         hdr_reset(from);
       }
 
@@ -407,7 +520,12 @@ public:
     ThreadState* thread_state_;
     ScopedArray<PerThreadHistogram> histograms_;
     hdr_histogram* histogram_;
+    hdr_histogram* interval_histogram_;
     mutable uv_mutex_t mutex_;
+    uint64_t snapshot_max_age_ms_;
+    mutable Snapshot snapshot_;
+    mutable uint64_t snapshot_time_ms_;
+    mutable bool has_snapshot_;
 
   private:
     DISALLOW_COPY_AND_ASSIGN(Histogram);
@@ -415,12 +533,37 @@ public:
 
   Metrics(size_t max_threads)
       : thread_state_(max_threads)
+      , snapshot_max_age_ms_(0)
       , request_latencies(&thread_state_)
       , speculative_request_latencies(&thread_state_)
       , request_rates(&thread_state_)
       , total_connections(&thread_state_)
       , connection_timeouts(&thread_state_)
-      , request_timeouts(&thread_state_) {}
+      , request_timeouts(&thread_state_)
+      , buffer_pool_hits(&thread_state_)
+      , buffer_pool_misses(&thread_state_)
+      , local_rack_requests(&thread_state_)
+      , local_dc_requests(&thread_state_)
+      , remote_dc_requests(&thread_state_)
+      , retries(&thread_state_)
+      , denied_retries(&thread_state_)
+      , protocol_downgrades(&thread_state_)
+      , downgraded_connections(&thread_state_) {
+    uv_mutex_init(&latencies_mutex_);
+  }
+
+  ~Metrics() {
+    for (HostLatencyMap::iterator it = host_latencies_.begin(), end = host_latencies_.end();
+         it != end; ++it) {
+      delete it->second;
+    }
+    for (ProfileLatencyMap::iterator it = profile_latencies_.begin(),
+                                     end = profile_latencies_.end();
+         it != end; ++it) {
+      delete it->second;
+    }
+    uv_mutex_destroy(&latencies_mutex_);
+  }
 
   void record_request(uint64_t latency_ns) {
     // Final measurement is in microseconds
@@ -434,8 +577,200 @@ public:
     request_rates.mark_speculative();
   }
 
+  /**
+   * Get a host's latency histogram, creating it if needed. Per host and per
+   * execution profile histograms have fewer significant figures than the
+   * session's histograms to keep their size down because there can be many
+   * of them.
+   *
+   * @param address The host's address.
+   * @return The host's histogram.
+   */
+  Histogram* host_latencies(const Address& address) {
+    ScopedMutex l(&latencies_mutex_);
+    Histogram*& histogram = host_latencies_[address];
+    if (histogram == NULL) {
+      histogram = new Histogram(&thread_state_, KEYED_HISTOGRAM_SIGNIFICANT_FIGURES);
+      histogram->set_snapshot_max_age_ms(snapshot_max_age_ms_);
+    }
+    return histogram;
+  }
+
+  /**
+   * Get an execution profile's latency histogram, creating it if needed.
+   *
+   * @param name The profile's name.
+   * @return The profile's histogram.
+   */
+  Histogram* profile_latencies(const String& name) {
+    ScopedMutex l(&latencies_mutex_);
+    Histogram*& histogram = profile_latencies_[name];
+    if (histogram == NULL) {
+      histogram = new Histogram(&thread_state_, KEYED_HISTOGRAM_SIGNIFICANT_FIGURES);
+      histogram->set_snapshot_max_age_ms(snapshot_max_age_ms_);
+    }
+    return histogram;
+  }
+
+  /**
+   * Get a snapshot of a host's latency histogram.
+   *
+   * @param address The host's address.
+   * @param snapshot The snapshot.
+   * @return false if there's no histogram for the host.
+   */
+  bool get_host_latencies_snapshot(const Address& address, Histogram::Snapshot* snapshot) const {
+    ScopedMutex l(&latencies_mutex_);
+    HostLatencyMap::const_iterator it = host_latencies_.find(address);
+    if (it == host_latencies_.end()) return false;
+    it->second->get_snapshot(snapshot);
+    return true;
+  }
+
+  /**
+   * Get a snapshot of an execution profile's latency histogram.
+   *
+   * @param name The profile's name.
+   * @param snapshot The snapshot.
+   * @return false if there's no histogram for the profile.
+   */
+  bool get_profile_latencies_snapshot(const String& name, Histogram::Snapshot* snapshot) const {
+    ScopedMutex l(&latencies_mutex_);
+    ProfileLatencyMap::const_iterator it = profile_latencies_.find(name);
+    if (it == profile_latencies_.end()) return false;
+    it->second->get_snapshot(snapshot);
+    return true;
+  }
+
+  /**
+   * The latencies of the stages of the requests' executions.
+   */
+  struct StageLatencies : public Allocated {
+    StageLatencies(ThreadState* thread_state)
+        : queue(thread_state)
+        , write(thread_state)
+        , server(thread_state)
+        , callback(thread_state) {}
+
+    Histogram queue;    // From Session::execute() until a request processor starts the request
+    Histogram write;    // From queueing a write on a connection until the socket write completes
+    Histogram server;   // From the completed write until the response is decoded
+    Histogram callback; // Setting the response on the future, including its callback
+
+    void set_snapshot_max_age_ms(uint64_t max_age_ms) {
+      queue.set_snapshot_max_age_ms(max_age_ms);
+      write.set_snapshot_max_age_ms(max_age_ms);
+      server.set_snapshot_max_age_ms(max_age_ms);
+      callback.set_snapshot_max_age_ms(max_age_ms);
+    }
+
+    void merge() {
+      queue.merge();
+      write.merge();
+      server.merge();
+      callback.merge();
+    }
+  };
+
+  /**
+   * Start recording the stage latencies. This must be called before any
+   * request is executed.
+   */
+  void enable_stage_latencies() {
+    stage_latencies.reset(new StageLatencies(&thread_state_));
+    stage_latencies->set_snapshot_max_age_ms(snapshot_max_age_ms_);
+  }
+
+  /**
+   * Reuse the histograms' snapshots that were taken less than `max_age_ms`
+   * ago. This must be called before any request is executed.
+   *
+   * @param max_age_ms The maximum age of a reused snapshot (0 to disable).
+   */
+  void set_snapshot_max_age_ms(uint64_t max_age_ms) {
+    ScopedMutex l(&latencies_mutex_);
+    snapshot_max_age_ms_ = max_age_ms;
+    request_latencies.set_snapshot_max_age_ms(max_age_ms);
+    speculative_request_latencies.set_snapshot_max_age_ms(max_age_ms);
+    if (stage_latencies) {
+      stage_latencies->set_snapshot_max_age_ms(max_age_ms);
+    }
+    for (HostLatencyMap::iterator it = host_latencies_.begin(), end = host_latencies_.end();
+         it != end; ++it) {
+      it->second->set_snapshot_max_age_ms(max_age_ms);
+    }
+    for (ProfileLatencyMap::iterator it = profile_latencies_.begin(),
+                                     end = profile_latencies_.end();
+         it != end; ++it) {
+      it->second->set_snapshot_max_age_ms(max_age_ms);
+    }
+  }
+
+  /**
+   * Move the values recorded by each thread into all of the histograms. This
+   * is run periodically so that each snapshot has less to merge.
+   */
+  void merge_histograms() {
+    request_latencies.merge();
+    speculative_request_latencies.merge();
+    if (stage_latencies) {
+      stage_latencies->merge();
+    }
+    ScopedMutex l(&latencies_mutex_);
+    for (HostLatencyMap::iterator it = host_latencies_.begin(), end = host_latencies_.end();
+         it != end; ++it) {
+      it->second->merge();
+    }
+    for (ProfileLatencyMap::iterator it = profile_latencies_.begin(),
+                                     end = profile_latencies_.end();
+         it != end; ++it) {
+      it->second->merge();
+    }
+  }
+
+  typedef Vector<std::pair<Address, Histogram::Snapshot> > HostLatencySnapshotVec;
+  typedef Vector<std::pair<String, Histogram::Snapshot> > ProfileLatencySnapshotVec;
+
+  /**
+   * Get snapshots of all the hosts' latency histograms.
+   *
+   * @param snapshots The snapshots ordered by the hosts' addresses.
+   */
+  void get_host_latencies_snapshots(HostLatencySnapshotVec* snapshots) const {
+    ScopedMutex l(&latencies_mutex_);
+    for (HostLatencyMap::const_iterator it = host_latencies_.begin(), end = host_latencies_.end();
+         it != end; ++it) {
+      snapshots->push_back(std::make_pair(it->first, Histogram::Snapshot()));
+      it->second->get_snapshot(&snapshots->back().second);
+    }
+  }
+
+  /**
+   * Get snapshots of all the execution profiles' latency histograms.
+   *
+   * @param snapshots The snapshots ordered by the profiles' names.
+   */
+  void get_profile_latencies_snapshots(ProfileLatencySnapshotVec* snapshots) const {
+    ScopedMutex l(&latencies_mutex_);
+    for (ProfileLatencyMap::const_iterator it = profile_latencies_.begin(),
+                                           end = profile_latencies_.end();
+         it != end; ++it) {
+      snapshots->push_back(std::make_pair(it->first, Histogram::Snapshot()));
+      it->second->get_snapshot(&snapshots->back().second);
+    }
+  }
+
 private:
+  static const int KEYED_HISTOGRAM_SIGNIFICANT_FIGURES = 2;
+
+  typedef Map<Address, Histogram*> HostLatencyMap;
+  typedef Map<String, Histogram*> ProfileLatencyMap;
+
   ThreadState thread_state_;
+  mutable uv_mutex_t latencies_mutex_;
+  HostLatencyMap host_latencies_;
+  ProfileLatencyMap profile_latencies_;
+  uint64_t snapshot_max_age_ms_;
 
 public:
   Histogram request_latencies;
@@ -447,6 +782,21 @@ public:
   Counter connection_timeouts;
   Counter request_timeouts;
 
+  Counter buffer_pool_hits;
+  Counter buffer_pool_misses;
+
+  Counter local_rack_requests;
+  Counter local_dc_requests;
+  Counter remote_dc_requests;
+
+  Counter retries;
+  Counter denied_retries;
+
+  Counter protocol_downgrades;
+  Counter downgraded_connections;
+
+  ScopedPtr<StageLatencies> stage_latencies; // Null unless request stage metrics are enabled
+
 private:
   DISALLOW_COPY_AND_ASSIGN(Metrics);
 };
@@ -25,6 +25,7 @@
 namespace datastax { namespace internal { namespace core {
 
 class Config;
+class Metrics;
 
 class MonitorReporting {
 public:
@@ -46,7 +47,7 @@ public:
 };
 
 MonitorReporting* create_monitor_reporting(const String& client_id, const String& session_id,
-                                           const Config& config);
+                                           const Config& config, const Metrics* metrics = NULL);
 
 }}} // namespace datastax::internal::core
 
@@ -125,6 +125,89 @@ public:
     return false;
   }
 
+  /**
+   * Enqueue up to count items, in order, claiming their slots with a single
+   * compare-and-swap.
+   *
+   * @param data The items to enqueue.
+   * @param count The number of items.
+   * @return The number of items enqueued; fewer than count if the queue was
+   * full.
+   */
+  size_t enqueue(const T* data, size_t count) {
+    size_t pos = tail_.load(MEMORY_ORDER_RELAXED);
+
+    for (;;) {
+      // Count the empty slots starting at the tail. They can only be filled
+      // by the producer that moves the tail past them.
+      size_t n = 0;
+      while (n < count) {
+        size_t node_seq = buffer_[(pos + n) & mask_].seq.load(MEMORY_ORDER_ACQUIRE);
+        if (node_seq != pos + n) break;
+        n++;
+      }
+
+      if (n == 0) {
+        size_t node_seq = buffer_[pos & mask_].seq.load(MEMORY_ORDER_ACQUIRE);
+        if ((intptr_t)node_seq - (intptr_t)pos < 0) {
+          return 0; // Full
+        }
+        pos = tail_.load(MEMORY_ORDER_RELAXED);
+      } else if (tail_.compare_exchange_weak(pos, pos + n, MEMORY_ORDER_RELAXED)) {
+        for (size_t i = 0; i < n; ++i) {
+          Node* node = &buffer_[(pos + i) & mask_];
+          node->data = data[i];
+          node->seq.store(pos + i + 1, MEMORY_ORDER_RELEASE);
+        }
+        return n;
+      }
+    }
+
+    // never taken
+    return 0;
+  }
+
+  /**
+   * Dequeue up to count items, in order, claiming their slots with a single
+   * compare-and-swap.
+   *
+   * @param data The dequeued items.
+   * @param count The maximum number of items to dequeue.
+   * @return The number of items dequeued; zero if the queue was empty.
+   */
+  size_t dequeue(T* data, size_t count) {
+    size_t pos = head_.load(MEMORY_ORDER_RELAXED);
+
+    for (;;) {
+      // Count the published slots starting at the head. They can only be
+      // emptied by the consumer that moves the head past them.
+      size_t n = 0;
+      while (n < count) {
+        size_t node_seq = buffer_[(pos + n) & mask_].seq.load(MEMORY_ORDER_ACQUIRE);
+        if (node_seq != pos + n + 1) break;
+        n++;
+      }
+
+      if (n == 0) {
+        size_t node_seq = buffer_[pos & mask_].seq.load(MEMORY_ORDER_ACQUIRE);
+        if ((intptr_t)node_seq - (intptr_t)(pos + 1) < 0) {
+          return 0; // Empty
+        }
+        pos = head_.load(MEMORY_ORDER_RELAXED);
+      } else if (head_.compare_exchange_weak(pos, pos + n, MEMORY_ORDER_RELAXED)) {
+        for (size_t i = 0; i < n; ++i) {
+          Node* node = &buffer_[(pos + i) & mask_];
+          data[i] = node->data;
+          node->seq.store(pos + i + mask_ + 1, MEMORY_ORDER_RELEASE);
+        }
+        return n;
+      }
+    }
+
+    // never taken
+    return 0;
+  }
+
   bool is_empty() const {
     size_t pos = head_.load(MEMORY_ORDER_RELAXED);
     const Node* node = &buffer_[pos & mask_];
@@ -132,6 +215,14 @@ public:
     return (intptr_t)node_seq - (intptr_t)(pos + 1) < 0;
   }
 
+  // An approximation of the number of queued items. This can be stale when
+  // other threads are modifying the queue.
+  size_t size() const {
+    size_t head = head_.load(MEMORY_ORDER_RELAXED);
+    size_t tail = tail_.load(MEMORY_ORDER_RELAXED);
+    return tail > head ? tail - head : 0;
+  }
+
   static void memory_fence() {
 #if defined(HAVE_BOOST_ATOMIC) || defined(HAVE_STD_ATOMIC)
     atomic_thread_fence(MEMORY_ORDER_SEQ_CST);
@@ -21,10 +21,15 @@
 
 #include "murmur3.hpp"
 
+#include "cassandra.h"
+
 #include <algorithm>
 #include <stdlib.h>
 #include <string.h>
 
+// The number of keys hashed together by MurmurHash3_x64_128_batch()
+#define MURMUR3_BATCH_LANES 4
+
 #if defined(_MSC_VER)
 
 #define FORCE_INLINE __forceinline
@@ -73,47 +78,36 @@ FORCE_INLINE int64_t fmix(int64_t k) {
   return k;
 }
 
-int64_t MurmurHash3_x64_128(const void* key, const int len, const uint32_t seed) {
-  const int8_t* data = (const int8_t*)key;
-  const int nblocks = len / 16;
-
-  int64_t h1 = seed;
-  int64_t h2 = seed;
-
-  int64_t c1 = BIG_CONSTANT(0x87c37b91114253d5);
-  int64_t c2 = BIG_CONSTANT(0x4cf5ad432745937f);
-  int64_t k1 = 0;
-  int64_t k2 = 0;
+// Mix a 16 byte block into the hash state
+FORCE_INLINE void mix_block(int64_t& h1, int64_t& h2, int64_t k1, int64_t k2) {
+  const int64_t c1 = BIG_CONSTANT(0x87c37b91114253d5);
+  const int64_t c2 = BIG_CONSTANT(0x4cf5ad432745937f);
 
-  const int64_t* blocks = (const int64_t*)(data);
-  const int8_t* tail = (const int8_t*)(data + nblocks * 16);
+  k1 *= c1;
+  k1 = ROTL64(k1, 31);
+  k1 *= c2;
+  h1 ^= k1;
 
-  //----------
-  // body
-
-  int i;
-  for (i = 0; i < nblocks; i++) {
-    int64_t k1 = getblock(blocks, i * 2 + 0);
-    int64_t k2 = getblock(blocks, i * 2 + 1);
-
-    k1 *= c1;
-    k1 = ROTL64(k1, 31);
-    k1 *= c2;
-    h1 ^= k1;
+  h1 = ROTL64(h1, 27);
+  h1 += h2;
+  h1 = h1 * 5 + 0x52dce729;
 
-    h1 = ROTL64(h1, 27);
-    h1 += h2;
-    h1 = h1 * 5 + 0x52dce729;
+  k2 *= c2;
+  k2 = ROTL64(k2, 33);
+  k2 *= c1;
+  h2 ^= k2;
 
-    k2 *= c2;
-    k2 = ROTL64(k2, 33);
-    k2 *= c1;
-    h2 ^= k2;
+  h2 = ROTL64(h2, 31);
+  h2 += h1;
+  h2 = h2 * 5 + 0x38495ab5;
+}
 
-    h2 = ROTL64(h2, 31);
-    h2 += h1;
-    h2 = h2 * 5 + 0x38495ab5;
-  }
+// Mix the remaining bytes and finalize the hash
+FORCE_INLINE int64_t finish(int64_t h1, int64_t h2, const int8_t* tail, const int len) {
+  const int64_t c1 = BIG_CONSTANT(0x87c37b91114253d5);
+  const int64_t c2 = BIG_CONSTANT(0x4cf5ad432745937f);
+  int64_t k1 = 0;
+  int64_t k2 = 0;
 
   //----------
   // tail
@@ -177,4 +171,80 @@ int64_t MurmurHash3_x64_128(const void* key, const int len, const uint32_t seed)
   return h1;
 }
 
+int64_t MurmurHash3_x64_128(const void* key, const int len, const uint32_t seed) {
+  const int8_t* data = (const int8_t*)key;
+  const int nblocks = len / 16;
+
+  int64_t h1 = seed;
+  int64_t h2 = seed;
+
+  const int64_t* blocks = (const int64_t*)(data);
+
+  //----------
+  // body
+
+  for (int i = 0; i < nblocks; i++) {
+    mix_block(h1, h2, getblock(blocks, i * 2 + 0), getblock(blocks, i * 2 + 1));
+  }
+
+  return finish(h1, h2, data + nblocks * 16, len);
+}
+
+// Hash MURMUR3_BATCH_LANES keys together. The blocks the keys have in common
+// are mixed in lockstep so the lanes' independent multiplies overlap (and can
+// be vectorized by compilers targeting 64-bit vector multiplies), then each
+// key's remaining blocks and tail are mixed on their own.
+static void hash_lanes(const char* const* keys, const size_t* lengths, const uint32_t seed,
+                       int64_t* output) {
+  int64_t h1[MURMUR3_BATCH_LANES];
+  int64_t h2[MURMUR3_BATCH_LANES];
+  const int64_t* blocks[MURMUR3_BATCH_LANES];
+  int nblocks[MURMUR3_BATCH_LANES];
+
+  int common_blocks = static_cast<int>(lengths[0] / 16);
+  for (int lane = 0; lane < MURMUR3_BATCH_LANES; ++lane) {
+    h1[lane] = h2[lane] = seed;
+    blocks[lane] = (const int64_t*)keys[lane];
+    nblocks[lane] = static_cast<int>(lengths[lane] / 16);
+    common_blocks = std::min(common_blocks, nblocks[lane]);
+  }
+
+  for (int i = 0; i < common_blocks; ++i) {
+    for (int lane = 0; lane < MURMUR3_BATCH_LANES; ++lane) {
+      mix_block(h1[lane], h2[lane], getblock(blocks[lane], i * 2 + 0),
+                getblock(blocks[lane], i * 2 + 1));
+    }
+  }
+
+  for (int lane = 0; lane < MURMUR3_BATCH_LANES; ++lane) {
+    for (int i = common_blocks; i < nblocks[lane]; ++i) {
+      mix_block(h1[lane], h2[lane], getblock(blocks[lane], i * 2 + 0),
+                getblock(blocks[lane], i * 2 + 1));
+    }
+    output[lane] = finish(h1[lane], h2[lane], (const int8_t*)keys[lane] + nblocks[lane] * 16,
+                          static_cast<int>(lengths[lane]));
+  }
+}
+
+void MurmurHash3_x64_128_batch(const char* const* keys, const size_t* lengths, size_t count,
+                               const uint32_t seed, int64_t* output) {
+  size_t i = 0;
+  for (; i + MURMUR3_BATCH_LANES <= count; i += MURMUR3_BATCH_LANES) {
+    hash_lanes(keys + i, lengths + i, seed, output + i);
+  }
+  for (; i < count; ++i) {
+    output[i] = MurmurHash3_x64_128(keys[i], static_cast<int>(lengths[i]), seed);
+  }
+}
+
 }} // namespace datastax::internal
+
+extern "C" {
+
+void cass_murmur3_hash_batch(const char* const* keys, const size_t* key_lengths, size_t count,
+                             cass_int64_t* output) {
+  datastax::internal::MurmurHash3_x64_128_batch(keys, key_lengths, count, 0,
+                                                reinterpret_cast<int64_t*>(output));
+}
+
+} // extern "C"
@@ -30,6 +30,11 @@ namespace datastax { namespace internal {
 
 int64_t MurmurHash3_x64_128(const void* key, const int len, const uint32_t seed);
 
+// Hash many keys, several at a time. This is the same as calling
+// MurmurHash3_x64_128() for each key.
+void MurmurHash3_x64_128_batch(const char* const* keys, const size_t* lengths, size_t count,
+                               const uint32_t seed, int64_t* output);
+
 }} // namespace datastax::internal
 
 #endif
@@ -20,6 +20,7 @@
 #include "address.hpp"
 #include "callback.hpp"
 #include "ref_counted.hpp"
+#include "resolver_cache.hpp"
 #include "string.hpp"
 #include "timer.hpp"
 
@@ -43,11 +44,14 @@ public:
     SUCCESS
   };
 
-  NameResolver(const Address& address, const Callback& callback)
+  NameResolver(const Address& address, const Callback& callback,
+               const ResolverCache::Ptr& cache = ResolverCache::Ptr())
       : address_(address)
       , status_(NEW)
       , uv_status_(-1)
-      , callback_(callback) {
+      , is_cached_(false)
+      , callback_(callback)
+      , cache_(cache) {
     req_.data = this;
   }
 
@@ -59,6 +63,9 @@ public:
   Status status() { return status_; }
   int uv_status() { return uv_status_; }
 
+  // True if the result came from the cache
+  bool is_cached() const { return is_cached_; }
+
   const Address& address() const { return address_; }
   const String& hostname() const { return hostname_; }
   const String& service() const { return service_; }
@@ -68,6 +75,14 @@ public:
 
     inc_ref(); // For the event loop
 
+    if (cache_ && cache_->get_hostname(address_, &hostname_, &service_, &uv_status_)) {
+      // Finish on the next iteration of the loop, like a lookup, because the
+      // callback can destroy the caller.
+      is_cached_ = true;
+      timer_.start(loop, 0, bind_callback(&NameResolver::on_cached, this));
+      return;
+    }
+
     if (timeout > 0) {
       timer_.start(loop, timeout, bind_callback(&NameResolver::on_timeout, this));
     }
@@ -86,8 +101,10 @@ public:
 
   void cancel() {
     if (status_ == RESOLVING) {
-      uv_cancel(reinterpret_cast<uv_req_t*>(&req_));
-      timer_.stop();
+      if (!is_cached_) { // A cached result still finishes using the timer
+        uv_cancel(reinterpret_cast<uv_req_t*>(&req_));
+        timer_.stop();
+      }
       status_ = CANCELED;
     }
   }
@@ -111,6 +128,11 @@ private:
         }
         resolver->status_ = SUCCESS;
       }
+
+      if (resolver->cache_ && status != UV_ECANCELED) {
+        resolver->cache_->put_hostname(resolver->address_, resolver->hostname_,
+                                       resolver->service_, status);
+      }
     }
 
     resolver->uv_status_ = status;
@@ -123,15 +145,25 @@ private:
     uv_cancel(reinterpret_cast<uv_req_t*>(&req_));
   }
 
+  void on_cached(Timer* timer) {
+    if (status_ == RESOLVING) {
+      status_ = hostname_.empty() ? FAILED_UNABLE_TO_RESOLVE : SUCCESS;
+    }
+    callback_(this);
+    dec_ref();
+  }
+
 private:
   uv_getnameinfo_t req_;
   Timer timer_;
   Address address_;
   Status status_;
   int uv_status_;
+  bool is_cached_;
   String hostname_;
   String service_;
   Callback callback_;
+  ResolverCache::Ptr cache_;
 };
 
 }}} // namespace datastax::internal::core
@@ -0,0 +1,303 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "object_cache.hpp"
+
+#include "atomic.hpp"
+#include "memory.hpp"
+#include "scoped_lock.hpp"
+
+#include <new>
+#include <uv.h>
+
+#define OBJECT_CACHE_SIZE_CLASS_COUNT 5
+#define OBJECT_CACHE_MIN_SIZE_CLASS 64
+#define OBJECT_CACHE_MAGAZINE_SIZE 32
+#define OBJECT_CACHE_MAX_DEPOT_MAGAZINES 64
+#define OBJECT_CACHE_NO_SIZE_CLASS 0xFF
+
+using namespace datastax::internal;
+
+namespace {
+
+// Prefixes each object so that it can be returned to the right size class.
+// The padding keeps objects aligned for any type.
+union Header {
+  size_t size_class;
+  long double padding1;
+  void* padding2;
+};
+
+struct Magazine {
+  Magazine* next;
+  size_t count;
+  void* rounds[OBJECT_CACHE_MAGAZINE_SIZE];
+
+  bool is_empty() const { return count == 0; }
+  bool is_full() const { return count == OBJECT_CACHE_MAGAZINE_SIZE; }
+};
+
+// The magazines for a size class on a single thread. Objects are only taken
+// from and returned to "loaded"; "previous" is exchanged with it first so that
+// alternating allocations and frees around a magazine boundary don't touch
+// the depot.
+struct ThreadClass {
+  Magazine* loaded;
+  Magazine* previous;
+};
+
+struct ThreadCache {
+  ThreadCache()
+      : next(NULL)
+      , hits(0)
+      , misses(0) {}
+
+  ThreadCache* next;
+  ThreadClass classes[OBJECT_CACHE_SIZE_CLASS_COUNT];
+  // Only written by the owning thread, but read by get_stats()
+  Atomic<uint64_t> hits;
+  Atomic<uint64_t> misses;
+
+  void inc(Atomic<uint64_t>& counter) {
+    counter.store(counter.load(MEMORY_ORDER_RELAXED) + 1, MEMORY_ORDER_RELAXED);
+  }
+};
+
+struct DepotClass {
+  Magazine* full;
+  Magazine* empty;
+  size_t full_count;
+};
+
+uv_once_t init_guard = UV_ONCE_INIT;
+uv_key_t thread_cache_key;
+uv_mutex_t depot_mutex;
+DepotClass depot[OBJECT_CACHE_SIZE_CLASS_COUNT];
+ThreadCache* thread_caches = NULL;
+size_t thread_cache_count = 0;
+// Counters of threads that have released their cache
+uint64_t released_hits = 0;
+uint64_t released_misses = 0;
+
+void init() {
+  uv_key_create(&thread_cache_key);
+  uv_mutex_init(&depot_mutex);
+}
+
+size_t class_size(size_t size_class) { return OBJECT_CACHE_MIN_SIZE_CLASS << size_class; }
+
+size_t size_class_for(size_t total) {
+  size_t size_class = 0;
+  while (class_size(size_class) < total) {
+    if (++size_class == OBJECT_CACHE_SIZE_CLASS_COUNT) return OBJECT_CACHE_NO_SIZE_CLASS;
+  }
+  return size_class;
+}
+
+Magazine* new_magazine() {
+  Magazine* magazine = static_cast<Magazine*>(Memory::malloc(sizeof(Magazine)));
+  magazine->next = NULL;
+  magazine->count = 0;
+  return magazine;
+}
+
+Magazine* pop(Magazine** list) {
+  Magazine* magazine = *list;
+  if (magazine != NULL) {
+    *list = magazine->next;
+    magazine->next = NULL;
+  }
+  return magazine;
+}
+
+void push(Magazine** list, Magazine* magazine) {
+  magazine->next = *list;
+  *list = magazine;
+}
+
+ThreadCache* thread_cache() {
+  uv_once(&init_guard, init);
+  ThreadCache* cache = static_cast<ThreadCache*>(uv_key_get(&thread_cache_key));
+  if (cache == NULL) {
+    cache = new (Memory::malloc(sizeof(ThreadCache))) ThreadCache();
+    for (size_t i = 0; i < OBJECT_CACHE_SIZE_CLASS_COUNT; ++i) {
+      cache->classes[i].loaded = new_magazine();
+      cache->classes[i].previous = new_magazine();
+    }
+    uv_key_set(&thread_cache_key, cache);
+
+    ScopedMutex l(&depot_mutex);
+    cache->next = thread_caches;
+    thread_caches = cache;
+    thread_cache_count++;
+  }
+  return cache;
+}
+
+// Replace the thread's empty magazines with a full one from the depot. The
+// previous magazine is returned to the depot's empty list.
+bool reload_full(ThreadClass& thread_class, size_t size_class) {
+  ScopedMutex l(&depot_mutex);
+  DepotClass& depot_class = depot[size_class];
+  Magazine* full = pop(&depot_class.full);
+  if (full == NULL) return false;
+  depot_class.full_count--;
+  push(&depot_class.empty, thread_class.previous);
+  thread_class.previous = thread_class.loaded;
+  thread_class.loaded = full;
+  return true;
+}
+
+// Replace the thread's full magazines with an empty one, returning the
+// previous magazine to the depot. The depot is bounded so when it's full the
+// magazine's objects are freed instead.
+void reload_empty(ThreadClass& thread_class, size_t size_class) {
+  Magazine* empty;
+  Magazine* previous = thread_class.previous;
+  {
+    ScopedMutex l(&depot_mutex);
+    DepotClass& depot_class = depot[size_class];
+    if (depot_class.full_count < OBJECT_CACHE_MAX_DEPOT_MAGAZINES) {
+      push(&depot_class.full, previous);
+      depot_class.full_count++;
+      previous = NULL;
+    }
+    empty = pop(&depot_class.empty);
+  }
+
+  if (previous != NULL) {
+    for (size_t i = 0; i < previous->count; ++i) {
+      Memory::free(previous->rounds[i]);
+    }
+    previous->count = 0;
+    empty = previous;
+  } else if (empty == NULL) {
+    empty = new_magazine();
+  }
+
+  thread_class.previous = thread_class.loaded;
+  thread_class.loaded = empty;
+}
+
+} // namespace
+
+void* ObjectCache::allocate(size_t size) {
+  size_t size_class = size_class_for(sizeof(Header) + size);
+  if (size_class == OBJECT_CACHE_NO_SIZE_CLASS) {
+    Header* header = static_cast<Header*>(Memory::malloc(sizeof(Header) + size));
+    header->size_class = OBJECT_CACHE_NO_SIZE_CLASS;
+    return header + 1;
+  }
+
+  ThreadCache* cache = thread_cache();
+  ThreadClass& thread_class = cache->classes[size_class];
+  if (thread_class.loaded->is_empty()) {
+    if (!thread_class.previous->is_empty()) {
+      Magazine* temp = thread_class.loaded;
+      thread_class.loaded = thread_class.previous;
+      thread_class.previous = temp;
+    } else if (!reload_full(thread_class, size_class)) {
+      cache->inc(cache->misses);
+      Header* header = static_cast<Header*>(Memory::malloc(class_size(size_class)));
+      header->size_class = size_class;
+      return header + 1;
+    }
+  }
+
+  cache->inc(cache->hits);
+  Magazine* loaded = thread_class.loaded;
+  Header* header = static_cast<Header*>(loaded->rounds[--loaded->count]);
+  return header + 1;
+}
+
+void ObjectCache::deallocate(void* ptr) {
+  if (ptr == NULL) return;
+  Header* header = static_cast<Header*>(ptr) - 1;
+  size_t size_class = header->size_class;
+  if (size_class == OBJECT_CACHE_NO_SIZE_CLASS) {
+    Memory::free(header);
+    return;
+  }
+
+  ThreadClass& thread_class = thread_cache()->classes[size_class];
+  if (thread_class.loaded->is_full()) {
+    if (!thread_class.previous->is_full()) {
+      Magazine* temp = thread_class.loaded;
+      thread_class.loaded = thread_class.previous;
+      thread_class.previous = temp;
+    } else {
+      reload_empty(thread_class, size_class);
+    }
+  }
+
+  Magazine* loaded = thread_class.loaded;
+  loaded->rounds[loaded->count++] = header;
+}
+
+void ObjectCache::release_thread() {
+  uv_once(&init_guard, init);
+  ThreadCache* cache = static_cast<ThreadCache*>(uv_key_get(&thread_cache_key));
+  if (cache == NULL) return;
+  uv_key_set(&thread_cache_key, NULL);
+
+  {
+    ScopedMutex l(&depot_mutex);
+    ThreadCache** link = &thread_caches;
+    while (*link != cache) {
+      link = &(*link)->next;
+    }
+    *link = cache->next;
+    released_hits += cache->hits.load(MEMORY_ORDER_RELAXED);
+    released_misses += cache->misses.load(MEMORY_ORDER_RELAXED);
+  }
+
+  for (size_t i = 0; i < OBJECT_CACHE_SIZE_CLASS_COUNT; ++i) {
+    Magazine* magazines[] = { cache->classes[i].loaded, cache->classes[i].previous };
+    for (size_t j = 0; j < 2; ++j) {
+      for (size_t k = 0; k < magazines[j]->count; ++k) {
+        Memory::free(magazines[j]->rounds[k]);
+      }
+      Memory::free(magazines[j]);
+    }
+  }
+  cache->~ThreadCache();
+  Memory::free(cache);
+}
+
+void ObjectCache::get_stats(CassObjectCacheStats* stats) {
+  uv_once(&init_guard, init);
+  stats->depot_magazines = 0;
+
+  ScopedMutex l(&depot_mutex);
+  stats->hits = released_hits;
+  stats->misses = released_misses;
+  for (ThreadCache* cache = thread_caches; cache != NULL; cache = cache->next) {
+    stats->hits += cache->hits.load(MEMORY_ORDER_RELAXED);
+    stats->misses += cache->misses.load(MEMORY_ORDER_RELAXED);
+  }
+  for (size_t i = 0; i < OBJECT_CACHE_SIZE_CLASS_COUNT; ++i) {
+    stats->depot_magazines += depot[i].full_count;
+  }
+  stats->thread_caches = thread_cache_count;
+}
+
+extern "C" {
+
+void cass_alloc_get_object_cache_stats(CassObjectCacheStats* stats) {
+  ObjectCache::get_stats(stats);
+}
+
+} // extern "C"
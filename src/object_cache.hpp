@@ -0,0 +1,74 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_OBJECT_CACHE_HPP
+#define DATASTAX_INTERNAL_OBJECT_CACHE_HPP
+
+#include "cassandra.h"
+
+#include <stddef.h>
+
+namespace datastax { namespace internal {
+
+/**
+ * A cache of small objects in front of Memory. Freed objects are kept in
+ * per-thread magazines (fixed size stacks) for each size class and are reused
+ * by the next allocation of the same size class on that thread. Full and
+ * empty magazines are exchanged with a shared depot, so objects allocated by
+ * application threads and freed by I/O threads (futures, request handlers,
+ * response messages and buffers) flow back without either side calling the
+ * allocator, and the depot's lock is only taken once per magazine.
+ *
+ * Each object is prefixed with a small header recording its size class, so
+ * objects from the cache must only be freed with deallocate(). This is used
+ * for Allocated objects and RefBuffers when the driver is built with
+ * CASS_USE_OBJECT_CACHE.
+ */
+class ObjectCache {
+public:
+  /**
+   * Allocate memory for an object. Objects too large for the largest size
+   * class are allocated directly from Memory.
+   *
+   * @param size The size of the object.
+   * @return The object's memory.
+   */
+  static void* allocate(size_t size);
+
+  /**
+   * Free memory returned by allocate().
+   *
+   * @param ptr The object's memory. This can be NULL.
+   */
+  static void deallocate(void* ptr);
+
+  /**
+   * Free the calling thread's magazines and the objects they hold. Short-lived
+   * threads call this before exiting, otherwise their cache is leaked.
+   */
+  static void release_thread();
+
+  /**
+   * Get a snapshot of the cache's counters across all threads.
+   *
+   * @param stats The counters.
+   */
+  static void get_stats(CassObjectCacheStats* stats);
+};
+
+}} // namespace datastax::internal
+
+#endif
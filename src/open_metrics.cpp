@@ -0,0 +1,103 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "open_metrics.hpp"
+
+#define METRIC_PREFIX "cassandra_driver_"
+
+using namespace datastax;
+using namespace datastax::internal::core;
+
+OpenMetricsWriter::OpenMetricsWriter() {
+  // Enough for rates and for microsecond latencies in seconds
+  ss_.precision(12);
+}
+
+void OpenMetricsWriter::add_family(const char* name, const char* type, const char* help) {
+  ss_ << "# TYPE " METRIC_PREFIX << name << " " << type << "\n";
+  ss_ << "# HELP " METRIC_PREFIX << name << " " << help << "\n";
+}
+
+void OpenMetricsWriter::add_sample(const char* name, const String& labels, double value) {
+  add_name(name, labels);
+  ss_ << " " << value << "\n";
+}
+
+void OpenMetricsWriter::add_sample(const char* name, const String& labels, uint64_t value) {
+  add_name(name, labels);
+  ss_ << " " << value << "\n";
+}
+
+void OpenMetricsWriter::add_latency_quantiles(const char* name, const String& labels,
+                                              const Metrics::Histogram::Snapshot& snapshot) {
+  static const struct {
+    const char* quantile;
+    int64_t Metrics::Histogram::Snapshot::*value;
+  } quantiles[] = { { "0.5", &Metrics::Histogram::Snapshot::median },
+                    { "0.75", &Metrics::Histogram::Snapshot::percentile_75th },
+                    { "0.95", &Metrics::Histogram::Snapshot::percentile_95th },
+                    { "0.98", &Metrics::Histogram::Snapshot::percentile_98th },
+                    { "0.99", &Metrics::Histogram::Snapshot::percentile_99th },
+                    { "0.999", &Metrics::Histogram::Snapshot::percentile_999th } };
+
+  for (size_t i = 0; i < sizeof(quantiles) / sizeof(quantiles[0]); ++i) {
+    String quantile_labels(labels);
+    if (!quantile_labels.empty()) quantile_labels.append(",");
+    quantile_labels.append(label("quantile", quantiles[i].quantile));
+    add_sample(name, quantile_labels, static_cast<double>(snapshot.*quantiles[i].value) / 1e6);
+  }
+}
+
+String OpenMetricsWriter::finish() {
+  ss_ << "# EOF\n";
+  return ss_.str();
+}
+
+String OpenMetricsWriter::label(const char* name, const String& value) {
+  String result(name);
+  result.append("=\"");
+  for (String::const_iterator it = value.begin(), end = value.end(); it != end; ++it) {
+    switch (*it) {
+      case '\\':
+        result.append("\\\\");
+        break;
+      case '"':
+        result.append("\\\"");
+        break;
+      case '\n':
+        result.append("\\n");
+        break;
+      default:
+        result.push_back(*it);
+        break;
+    }
+  }
+  result.append("\"");
+  return result;
+}
+
+String OpenMetricsWriter::label(const char* name, size_t value) {
+  OStringStream ss;
+  ss << value;
+  return label(name, ss.str());
+}
+
+void OpenMetricsWriter::add_name(const char* name, const String& labels) {
+  ss_ << METRIC_PREFIX << name;
+  if (!labels.empty()) {
+    ss_ << "{" << labels << "}";
+  }
+}
@@ -0,0 +1,92 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_OPEN_METRICS_HPP
+#define DATASTAX_INTERNAL_OPEN_METRICS_HPP
+
+#include "metrics.hpp"
+#include "string.hpp"
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * A writer for metrics in the OpenMetrics (and Prometheus) text exposition
+ * format. The samples of a metric family must be added right after the
+ * family itself.
+ */
+class OpenMetricsWriter {
+public:
+  OpenMetricsWriter();
+
+  /**
+   * Start a metric family.
+   *
+   * @param name The family's name without the driver's prefix.
+   * @param type The family's type e.g. "counter", "gauge" or "summary".
+   * @param help The family's description.
+   */
+  void add_family(const char* name, const char* type, const char* help);
+
+  /**
+   * Add a sample to the current family.
+   *
+   * @param name The sample's name without the driver's prefix. Counters'
+   * samples have the "_total" suffix.
+   * @param labels The sample's labels built with label() (can be empty).
+   * @param value The sample's value.
+   */
+  void add_sample(const char* name, const String& labels, double value);
+  void add_sample(const char* name, const String& labels, uint64_t value);
+
+  /**
+   * Add the quantiles of a latency histogram to the current summary family.
+   * The histogram's microseconds are converted to seconds.
+   *
+   * @param name The family's name without the driver's prefix.
+   * @param labels The labels of the summary (can be empty).
+   * @param snapshot The histogram's snapshot.
+   */
+  void add_latency_quantiles(const char* name, const String& labels,
+                             const Metrics::Histogram::Snapshot& snapshot);
+
+  /**
+   * Finish the exposition.
+   *
+   * @return The exposition text.
+   */
+  String finish();
+
+public:
+  /**
+   * Build a label, escaping its value.
+   *
+   * @param name The label's name.
+   * @param value The label's value.
+   * @return The label.
+   */
+  static String label(const char* name, const String& value);
+  static String label(const char* name, size_t value);
+
+private:
+  void add_name(const char* name, const String& labels);
+
+private:
+  OStringStream ss_;
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -0,0 +1,60 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "paged_result_iterator.hpp"
+
+#include "session.hpp"
+
+using namespace datastax::internal::core;
+
+bool PagedResultIterator::next() {
+  while (!iterator_ || !iterator_->next()) {
+    if (!next_page()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool PagedResultIterator::next_page() {
+  if (iterator_) { // Move past the current page
+    if (!result_->has_more_pages()) {
+      return false;
+    }
+    future_ = session_->take_next_page(future_.get());
+    if (!future_) { // The next page wasn't prefetched or was already taken
+      error_code_ = CASS_ERROR_LIB_INVALID_STATE;
+      return false;
+    }
+  }
+
+  if (future_->error()) {
+    error_code_ = future_->error()->code;
+    return false;
+  }
+
+  Response::Ptr response(future_->response());
+  if (!response || response->opcode() != CQL_OPCODE_RESULT) {
+    error_code_ = CASS_ERROR_LIB_UNEXPECTED_RESPONSE;
+    return false;
+  }
+
+  // Release the previous page before referencing the new one
+  iterator_.reset();
+  result_ = SharedRefPtr<ResultResponse>(response);
+  iterator_.reset(new ResultIterator(result_.get()));
+  return true;
+}
@@ -0,0 +1,62 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_PAGED_RESULT_ITERATOR_HPP
+#define DATASTAX_INTERNAL_PAGED_RESULT_ITERATOR_HPP
+
+#include "iterator.hpp"
+#include "request_handler.hpp"
+#include "result_iterator.hpp"
+#include "scoped_ptr.hpp"
+
+namespace datastax { namespace internal { namespace core {
+
+class Session;
+
+/**
+ * An iterator over the rows of all the pages of a paged query. Pages are
+ * waited on as the iterator crosses page boundaries. If the statement was
+ * executed with paging prefetch enabled then the next page is usually already
+ * available by the time the current page has been consumed.
+ */
+class PagedResultIterator : public Iterator {
+public:
+  PagedResultIterator(Session* session, const ResponseFuture::Ptr& future)
+      : Iterator(CASS_ITERATOR_TYPE_PAGED_RESULT)
+      , session_(session)
+      , future_(future)
+      , error_code_(CASS_OK) {}
+
+  virtual bool next();
+
+  const Row* row() const { return iterator_->row(); }
+
+  CassError error_code() const { return error_code_; }
+
+private:
+  bool next_page();
+
+private:
+  Session* session_;
+  ResponseFuture::Ptr future_;
+  SharedRefPtr<ResultResponse> result_;
+  ScopedPtr<ResultIterator> iterator_;
+  CassError error_code_;
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
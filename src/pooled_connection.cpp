@@ -105,12 +105,13 @@ PooledConnection::PooledConnection(ConnectionPool* pool, const Connection::Ptr&
     , event_loop_(static_cast<EventLoop*>(pool->loop()->data)) {
   inc_ref(); // Reference for the connection's lifetime
   connection_->set_listener(this);
+  connection_->set_event_loop(event_loop_);
 }
 
 int32_t PooledConnection::write(RequestCallback* callback) {
   int32_t result;
   const String& keyspace(pool_->keyspace());
-  if (keyspace != connection_->keyspace()) {
+  if (keyspace != connection_->keyspace() && !has_keyspace(callback)) {
     LOG_DEBUG("Setting keyspace %s on connection(%p) pool(%p)", keyspace.c_str(),
               static_cast<void*>(connection_.get()), static_cast<void*>(pool_));
     result = connection_->write(RequestCallback::Ptr(new ChainedSetKeyspaceCallback(
@@ -126,6 +127,15 @@ int32_t PooledConnection::write(RequestCallback* callback) {
   return result;
 }
 
+bool PooledConnection::has_keyspace(const RequestCallback* callback) const {
+  // Requests carry their own keyspace when the protocol supports it so the
+  // keyspace doesn't need to be set on the connection. Execute requests use
+  // the keyspace from the time of prepare.
+  if (!connection_->protocol_version().supports_set_keyspace()) return false;
+  const Request* request = callback->request();
+  return request->opcode() == CQL_OPCODE_EXECUTE || !callback->keyspace().empty();
+}
+
 void PooledConnection::flush() {
   size_t bytes_flushed = connection_->flush();
 #ifdef CASS_INTERNAL_DIAGNOSTICS
@@ -143,8 +153,16 @@ int PooledConnection::inflight_request_count() const {
   return connection_->inflight_request_count();
 }
 
+size_t PooledConnection::available_streams() const { return connection_->available_streams(); }
+
+bool PooledConnection::is_write_queue_full() const { return connection_->is_write_queue_full(); }
+
 bool PooledConnection::is_closing() const { return connection_->is_closing(); }
 
+const ShardingInfo& PooledConnection::sharding_info() const {
+  return connection_->sharding_info();
+}
+
 void PooledConnection::on_read() {
   if (event_loop_) {
     event_loop_->maybe_start_io_time();
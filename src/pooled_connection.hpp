@@ -29,10 +29,11 @@ class EventLoop;
 class RequestCallback;
 
 /**
- * A connection wrapper that handles connection pool functionality.
+ * A connection wrapper that handles connection pool functionality. It's only
+ * referenced from the thread of its pool's event loop.
  */
 class PooledConnection
-    : public RefCounted<PooledConnection>
+    : public LoopRefCounted<PooledConnection>
     , public ConnectionListener {
 public:
   typedef SharedRefPtr<PooledConnection> Ptr;
@@ -72,6 +73,20 @@ public:
    */
   int inflight_request_count() const;
 
+  /**
+   * Get the number of stream IDs that aren't used by outstanding requests.
+   *
+   * @return The number of available stream IDs.
+   */
+  size_t available_streams() const;
+
+  /**
+   * Determine if the connection is saturated by its outstanding writes.
+   *
+   * @return Returns true if the write queue is full.
+   */
+  bool is_write_queue_full() const;
+
   /**
    * Determine if the connection is closing.
    *
@@ -79,9 +94,19 @@ public:
    */
   bool is_closing() const;
 
+  /**
+   * Get the sharding of the host and the shard that owns the connection.
+   *
+   * @return The sharding; it's invalid if the host isn't sharded.
+   */
+  const ShardingInfo& sharding_info() const;
+
 public:
   const String& keyspace() const { return connection_->keyspace(); } // Test only
 
+private:
+  bool has_keyspace(const RequestCallback* callback) const;
+
 private:
   virtual void on_read();
   virtual void on_write();
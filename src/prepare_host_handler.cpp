@@ -41,7 +41,8 @@ PrepareHostHandler::PrepareHostHandler(
     , callback_(callback)
     , connection_(NULL)
     , prepares_outstanding_(0)
-    , max_prepares_outstanding_(CASS_MAX_STREAMS)
+    , max_prepares_outstanding_(max_requests_per_flush > 0 ? max_requests_per_flush : 1)
+    , is_setting_keyspace_(false)
     , prepared_metadata_entries_(prepared_metadata_entries) {
 
   // Sort by keyspace to minimize the number of times the keyspace
@@ -84,32 +85,37 @@ void PrepareHostHandler::on_connect(Connector* connector) {
 
 // This is the main loop for preparing statements. It's called after each
 // request successfully completes, either setting the keyspace or preparing
-// a statement. It attempts to group prepare requests into a single batch as
-// long as the keyspace is the same and the number of outstanding requests is
-// under the maximum.
+// a statement. It keeps the window of outstanding prepare requests full until
+// there are no more statements or the keyspace needs to change. Changing the
+// keyspace waits for the outstanding prepares because the keyspace is part of
+// the connection's state.
 void PrepareHostHandler::prepare_next() {
-  // Finish current prepares before continuing
-  if (--prepares_outstanding_ > 0) {
+  if (is_setting_keyspace_ || connection_->is_closing()) {
     return;
   }
 
-  // Check to see if we're done
   if (is_done()) {
-    close();
+    if (prepares_outstanding_ == 0) {
+      close();
+    }
     return;
   }
 
-  prepares_outstanding_ = 0;
+  bool is_written = false;
+  while (!is_done() && prepares_outstanding_ < max_prepares_outstanding_) {
+    if (needs_keyspace_change()) {
+      if (prepares_outstanding_ == 0) {
+        set_keyspace();
+      }
+      break;
+    }
 
-  // Write prepare requests until there's no more left, the keyspace changes,
-  // or the maximum number of outstanding prepares is reached.
-  while (!is_done() && check_and_set_keyspace() &&
-         prepares_outstanding_ < max_prepares_outstanding_) {
     const String& query((*current_entry_it_)->query());
     PrepareRequest::Ptr prepare_request(new PrepareRequest(query));
 
-    // Set the keyspace in case per request keyspaces are supported
-    prepare_request->set_keyspace(current_keyspace_);
+    // Set the keyspace in case per request keyspaces are supported. It's the
+    // same as the current keyspace otherwise.
+    prepare_request->set_keyspace((*current_entry_it_)->keyspace());
 
     PrepareCallback::Ptr callback(new PrepareCallback(prepare_request, Ptr(this)));
     if (connection_->write(callback) < 0) {
@@ -121,31 +127,41 @@ void PrepareHostHandler::prepare_next() {
 
     prepares_outstanding_++;
     current_entry_it_++;
+    is_written = true;
   }
 
-  connection_->flush();
+  if (is_written) {
+    connection_->flush();
+  }
 }
 
-bool PrepareHostHandler::check_and_set_keyspace() {
-  if (protocol_version_.supports_set_keyspace()) {
-    return true;
-  }
+void PrepareHostHandler::on_prepared() {
+  prepares_outstanding_--;
+  prepare_next();
+}
+
+void PrepareHostHandler::on_keyspace_set() {
+  is_setting_keyspace_ = false;
+  prepare_next();
+}
 
+bool PrepareHostHandler::needs_keyspace_change() const {
+  return !protocol_version_.supports_set_keyspace() &&
+         (*current_entry_it_)->keyspace() != current_keyspace_;
+}
+
+void PrepareHostHandler::set_keyspace() {
   const String& keyspace((*current_entry_it_)->keyspace());
 
-  if (keyspace != current_keyspace_) {
-    PrepareCallback::Ptr callback(new SetKeyspaceCallback(keyspace, Ptr(this)));
-    if (connection_->write_and_flush(callback) < 0) {
-      LOG_WARN("Failed to write \"USE\" keyspace request while preparing all queries on host %s",
-               host_->address_string().c_str());
-      close();
-      return false;
-    }
-    current_keyspace_ = keyspace;
-    return false;
+  PrepareCallback::Ptr callback(new SetKeyspaceCallback(keyspace, Ptr(this)));
+  if (connection_->write_and_flush(callback) < 0) {
+    LOG_WARN("Failed to write \"USE\" keyspace request while preparing all queries on host %s",
+             host_->address_string().c_str());
+    close();
+    return;
   }
-
-  return true;
+  current_keyspace_ = keyspace;
+  is_setting_keyspace_ = true;
 }
 
 bool PrepareHostHandler::is_done() const {
@@ -163,7 +179,7 @@ void PrepareHostHandler::PrepareCallback::on_internal_set(ResponseMessage* respo
   LOG_DEBUG("Successfully prepared query \"%s\" on host %s while preparing all queries",
             static_cast<const PrepareRequest*>(request())->query().c_str(),
             handler_->host()->address_string().c_str());
-  handler_->prepare_next();
+  handler_->on_prepared();
 }
 
 void PrepareHostHandler::PrepareCallback::on_internal_error(CassError code, const String& message) {
@@ -186,7 +202,7 @@ PrepareHostHandler::SetKeyspaceCallback::SetKeyspaceCallback(const String& keysp
 void PrepareHostHandler::SetKeyspaceCallback::on_internal_set(ResponseMessage* response) {
   LOG_TRACE("Successfully set keyspace to \"%s\" on host %s while preparing all queries",
             handler_->current_keyspace_.c_str(), handler_->host()->address_string().c_str());
-  handler_->prepare_next();
+  handler_->on_keyspace_set();
 }
 
 void PrepareHostHandler::SetKeyspaceCallback::on_internal_error(CassError code,
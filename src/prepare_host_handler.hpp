@@ -29,7 +29,11 @@ namespace datastax { namespace internal { namespace core {
 class Connector;
 
 /**
- * A handler for pre-preparing statements on a newly available host.
+ * A handler for pre-preparing statements on a newly available host. Prepare
+ * requests are pipelined on a single connection using a bounded window of
+ * outstanding requests that's refilled as each response arrives. Statements
+ * are grouped by keyspace so the connection's keyspace (pre-V5/DSEv2) is only
+ * changed once per keyspace.
  */
 class PrepareHostHandler
     : public RefCounted<PrepareHostHandler>
@@ -39,6 +43,16 @@ public:
 
   typedef SharedRefPtr<PrepareHostHandler> Ptr;
 
+  /**
+   * Constructor.
+   *
+   * @param host The host to prepare the statements on.
+   * @param prepared_metadata_entries The statements to prepare.
+   * @param callback A callback that's called when the host is done.
+   * @param protocol_version The protocol version to use for the connection.
+   * @param max_requests_per_flush The maximum number of outstanding prepare
+   * requests.
+   */
   PrepareHostHandler(const Host::Ptr& host,
                      const PreparedMetadata::Entry::Vec& prepared_metadata_entries,
                      const Callback& callback, ProtocolVersion protocol_version,
@@ -98,8 +112,13 @@ private:
   // This is the main method for iterating over the list of prepared statements
   void prepare_next();
 
-  // Returns true if the keyspace is current or using protocol v5/DSEv2
-  bool check_and_set_keyspace();
+  void on_prepared();
+  void on_keyspace_set();
+
+  // Returns true if the keyspace needs to be changed before preparing the
+  // current statement (pre-V5/DSEv2 only)
+  bool needs_keyspace_change() const;
+  void set_keyspace();
 
   bool is_done() const;
 
@@ -113,6 +132,7 @@ private:
   String current_keyspace_;
   int prepares_outstanding_;
   const int max_prepares_outstanding_;
+  bool is_setting_keyspace_;
   PreparedMetadata::Entry::Vec prepared_metadata_entries_;
   PreparedMetadata::Entry::Vec::const_iterator current_entry_it_;
 };
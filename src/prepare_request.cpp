@@ -17,6 +17,7 @@
 #include "prepare_request.hpp"
 
 #include "protocol.hpp"
+#include "request_callback.hpp"
 #include "serialization.hpp"
 
 using namespace datastax::internal::core;
@@ -29,13 +30,15 @@ int PrepareRequest::encode(ProtocolVersion version, RequestCallback* callback,
   bufs->back().encode_long_string(0, query_.data(), query().size());
 
   if (version.supports_set_keyspace()) {
+    const String& keyspace = callback->keyspace();
+
     // <flags> [int] [<keyspace> [string]]
     int32_t flags = 0;
     size_t flags_keyspace_buf_size = sizeof(int32_t); // <flags> [int]
 
-    if (!keyspace().empty()) {
+    if (!keyspace.empty()) {
       flags |= CASS_PREPARE_FLAG_WITH_KEYSPACE;
-      flags_keyspace_buf_size += sizeof(uint16_t) + keyspace().size(); // <keyspace> [string]
+      flags_keyspace_buf_size += sizeof(uint16_t) + keyspace.size(); // <keyspace> [string]
     }
 
     bufs->push_back(Buffer(flags_keyspace_buf_size));
@@ -44,8 +47,8 @@ int PrepareRequest::encode(ProtocolVersion version, RequestCallback* callback,
     Buffer& buf = bufs->back();
     size_t pos = buf.encode_int32(0, flags);
 
-    if (!keyspace().empty()) {
-      buf.encode_string(pos, keyspace().data(), static_cast<uint16_t>(keyspace().size()));
+    if (!keyspace.empty()) {
+      buf.encode_string(pos, keyspace.data(), static_cast<uint16_t>(keyspace.size()));
     }
   }
   return length;
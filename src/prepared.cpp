@@ -16,10 +16,13 @@
 
 #include "prepared.hpp"
 
+#include "column_handle.hpp"
 #include "execute_request.hpp"
 #include "external.hpp"
 #include "logger.hpp"
 
+#include <ctype.h>
+
 using namespace datastax;
 using namespace datastax::internal;
 using namespace datastax::internal::core;
@@ -72,17 +75,90 @@ const CassDataType* cass_prepared_parameter_data_type_by_name_n(const CassPrepar
   return CassDataType::to(metadata->get_column_definition(indices[0]).data_type.get());
 }
 
+CassColumnHandle* cass_prepared_parameter_handle(const CassPrepared* prepared, const char* name) {
+  return cass_prepared_parameter_handle_n(prepared, name, SAFE_STRLEN(name));
+}
+
+CassColumnHandle* cass_prepared_parameter_handle_n(const CassPrepared* prepared, const char* name,
+                                                   size_t name_length) {
+  return CassColumnHandle::to(
+      ColumnHandle::resolve(prepared->result()->metadata(), StringRef(name, name_length)));
+}
+
 } // extern "C"
 
+static inline bool is_identifier_char(char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+static inline bool keyword_equals(const char* word, size_t length, const char* keyword) {
+  size_t i = 0;
+  for (; i < length && keyword[i] != '\0'; ++i) {
+    if (toupper(static_cast<unsigned char>(word[i])) != keyword[i]) return false;
+  }
+  return i == length && keyword[i] == '\0';
+}
+
+bool Prepared::is_lwt_query(const String& query) {
+  const char* pos = query.data();
+  const char* end = pos + query.size();
+  bool is_first_word = true;
+  while (pos < end) {
+    char c = *pos;
+    if (c == '\'' || c == '"') { // String literal or quoted identifier
+      for (++pos; pos < end; ++pos) {
+        if (*pos == c) {
+          if (pos + 1 < end && pos[1] == c) { // Escaped quote
+            ++pos;
+          } else {
+            break;
+          }
+        }
+      }
+      ++pos;
+    } else if (c == '$' && pos + 1 < end && pos[1] == '$') { // $$ string literal
+      pos += 2;
+      while (pos + 1 < end && !(pos[0] == '$' && pos[1] == '$')) ++pos;
+      pos += 2;
+    } else if ((c == '-' || c == '/') && pos + 1 < end && pos[1] == c) { // Line comment
+      while (pos < end && *pos != '\n') ++pos;
+    } else if (c == '/' && pos + 1 < end && pos[1] == '*') { // Block comment
+      pos += 2;
+      while (pos + 1 < end && !(pos[0] == '*' && pos[1] == '/')) ++pos;
+      pos += 2;
+    } else if (is_identifier_char(c)) {
+      const char* word = pos;
+      while (pos < end && is_identifier_char(*pos)) ++pos;
+      size_t length = pos - word;
+      if (is_first_word) {
+        // Only data modification statements can be conditional
+        if (!keyword_equals(word, length, "INSERT") && !keyword_equals(word, length, "UPDATE") &&
+            !keyword_equals(word, length, "DELETE") && !keyword_equals(word, length, "BEGIN")) {
+          return false;
+        }
+        is_first_word = false;
+      } else if (keyword_equals(word, length, "IF")) {
+        return true;
+      }
+    } else {
+      ++pos;
+    }
+  }
+  return false;
+}
+
 Prepared::Prepared(const ResultResponse::Ptr& result,
                    const PrepareRequest::ConstPtr& prepare_request,
                    const Metadata::SchemaSnapshot& schema_metadata)
     : result_(result)
     , id_(result->prepared_id().to_string())
+    , encoded_id_(sizeof(uint16_t) + id_.size())
     , query_(prepare_request->query())
     , keyspace_(prepare_request->keyspace())
-    , request_settings_(prepare_request->settings()) {
+    , request_settings_(prepare_request->settings())
+    , is_lwt_(is_lwt_query(query_)) {
   assert(result->protocol_version() > 0 && "The protocol version should be set");
+  encoded_id_.encode_string(0, id_.data(), static_cast<uint16_t>(id_.size()));
   if (result->protocol_version() >= CASS_PROTOCOL_VERSION_V4) {
     key_indices_ = result->pk_indices();
   } else {
@@ -109,3 +185,120 @@ Prepared::Prepared(const ResultResponse::Ptr& result,
     }
   }
 }
+
+#define PREPARED_METADATA_SHARD_COUNT 16
+
+PreparedMetadata::Shard::Shard()
+    : capacity(0)
+    , hand(0)
+    , evictions(0) {
+  uv_rwlock_init(&rwlock);
+}
+
+PreparedMetadata::Shard::~Shard() { uv_rwlock_destroy(&rwlock); }
+
+void PreparedMetadata::Shard::init(size_t capacity) {
+  this->capacity = capacity;
+  if (capacity > 0) {
+    slots.reserve(capacity);
+    referenced.reset(new Atomic<bool>[capacity]);
+    for (size_t i = 0; i < capacity; ++i) {
+      referenced[i].store(false, MEMORY_ORDER_RELAXED);
+    }
+  }
+}
+
+size_t PreparedMetadata::Shard::evict() {
+  // Requires the write lock. Every slot is cleared at most once so this
+  // terminates within two sweeps.
+  while (referenced[hand].load(MEMORY_ORDER_RELAXED)) {
+    referenced[hand].store(false, MEMORY_ORDER_RELAXED);
+    hand = (hand + 1) % capacity;
+  }
+  size_t victim = hand;
+  hand = (hand + 1) % capacity;
+  index.erase(slots[victim].prepared_id);
+  evictions++;
+  return victim;
+}
+
+PreparedMetadata::PreparedMetadata(size_t max_entries)
+    : max_entries_(max_entries)
+    , shard_count_(max_entries > 0 && max_entries < PREPARED_METADATA_SHARD_COUNT
+                       ? 1
+                       : PREPARED_METADATA_SHARD_COUNT)
+    , shards_(new Shard[shard_count_]) {
+  if (max_entries_ > 0) {
+    // Split the limit exactly so that the total never exceeds it
+    for (size_t i = 0; i < shard_count_; ++i) {
+      shards_[i].init(max_entries_ / shard_count_ + (i < max_entries_ % shard_count_ ? 1 : 0));
+    }
+  }
+}
+
+PreparedMetadata::~PreparedMetadata() {}
+
+PreparedMetadata::Shard& PreparedMetadata::shard(const String& prepared_id) const {
+  // Use the hash's higher bits because the lower bits select the bucket in
+  // the shard's index
+  size_t h = static_cast<size_t>(hash::fnv1a(prepared_id.data(), prepared_id.size()));
+  return shards_[(h >> 16) % shard_count_];
+}
+
+PreparedMetadata::Entry::Ptr PreparedMetadata::get(const String& prepared_id) const {
+  Shard& shard = this->shard(prepared_id);
+  ScopedReadLock rl(&shard.rwlock);
+  IndexMap::const_iterator i = shard.index.find(prepared_id);
+  if (i == shard.index.end()) {
+    return Entry::Ptr();
+  }
+  if (shard.capacity > 0) {
+    shard.referenced[i->second].store(true, MEMORY_ORDER_RELAXED);
+  }
+  return shard.slots[i->second].entry;
+}
+
+void PreparedMetadata::set(const String& prepared_id, const Entry::Ptr& entry) {
+  Shard& shard = this->shard(prepared_id);
+  ScopedWriteLock wl(&shard.rwlock);
+  IndexMap::const_iterator i = shard.index.find(prepared_id);
+  if (i != shard.index.end()) {
+    shard.slots[i->second].entry = entry;
+    if (shard.capacity > 0) {
+      shard.referenced[i->second].store(true, MEMORY_ORDER_RELAXED);
+    }
+  } else if (shard.capacity == 0 || shard.slots.size() < shard.capacity) {
+    shard.index[prepared_id] = shard.slots.size();
+    shard.slots.push_back(Slot(prepared_id, entry));
+  } else {
+    size_t slot = shard.evict();
+    shard.slots[slot] = Slot(prepared_id, entry);
+    shard.index[prepared_id] = slot;
+  }
+}
+
+PreparedMetadata::Entry::Vec PreparedMetadata::copy() const {
+  Entry::Vec temp;
+  for (size_t i = 0; i < shard_count_; ++i) {
+    const Shard& shard = shards_[i];
+    ScopedReadLock rl(&shard.rwlock);
+    temp.reserve(temp.size() + shard.slots.size());
+    for (SlotVec::const_iterator it = shard.slots.begin(), end = shard.slots.end(); it != end;
+         ++it) {
+      temp.push_back(it->entry);
+    }
+  }
+  return temp;
+}
+
+void PreparedMetadata::get_metrics(PreparedMetadataMetrics* metrics) const {
+  metrics->entries = 0;
+  metrics->max_entries = max_entries_;
+  metrics->evictions = 0;
+  for (size_t i = 0; i < shard_count_; ++i) {
+    const Shard& shard = shards_[i];
+    ScopedReadLock rl(&shard.rwlock);
+    metrics->entries += shard.slots.size();
+    metrics->evictions += shard.evictions;
+  }
+}
@@ -17,9 +17,12 @@
 #ifndef DATASTAX_INTERNAL_PREPARED_HPP
 #define DATASTAX_INTERNAL_PREPARED_HPP
 
+#include "allocated.hpp"
+#include "atomic.hpp"
 #include "buffer.hpp"
-#include "dense_hash_map.hpp"
 #include "external.hpp"
+#include "flat_hash_map.hpp"
+#include "macros.hpp"
 #include "metadata.hpp"
 #include "prepare_request.hpp"
 #include "ref_counted.hpp"
@@ -28,6 +31,7 @@
 #include "scoped_lock.hpp"
 #include "scoped_ptr.hpp"
 #include "string.hpp"
+#include "vector.hpp"
 
 #include <uv.h>
 
@@ -42,20 +46,53 @@ public:
 
   const ResultResponse::ConstPtr& result() const { return result_; }
   const String& id() const { return id_; }
+  // The ID encoded as a [short bytes] so it can be shared by bound statements
+  const Buffer& encoded_id() const { return encoded_id_; }
   const String& query() const { return query_; }
   const String& keyspace() const { return keyspace_; }
   const RequestSettings& request_settings() const { return request_settings_; }
   const ResultResponse::PKIndexVec& key_indices() const { return key_indices_; }
+  // A conditional INSERT, UPDATE, DELETE or batch (a lightweight transaction)
+  bool is_lwt() const { return is_lwt_; }
+
+  /**
+   * Determine if a query is a lightweight transaction i.e. an INSERT, UPDATE,
+   * DELETE or batch with an IF clause. String literals, quoted identifiers and
+   * comments are skipped.
+   *
+   * @param query
+   * @return true if the query is a lightweight transaction.
+   */
+  static bool is_lwt_query(const String& query);
 
 private:
   ResultResponse::ConstPtr result_;
   String id_;
+  Buffer encoded_id_;
   String query_;
   String keyspace_;
   RequestSettings request_settings_;
   ResultResponse::PKIndexVec key_indices_;
+  bool is_lwt_;
 };
 
+struct PreparedMetadataMetrics {
+  PreparedMetadataMetrics()
+      : entries(0)
+      , max_entries(0)
+      , evictions(0) {}
+  size_t entries;
+  size_t max_entries;
+  uint64_t evictions;
+};
+
+/**
+ * The prepared statements known to the session (by prepared ID). These are
+ * used to prepare statements on hosts that come up and to re-prepare
+ * statements on hosts that respond with UNPREPARED. The number of entries can
+ * be bounded for applications that prepare dynamic queries; an evicted
+ * statement is still prepared again on demand using its bound statements.
+ */
 class PreparedMetadata {
 public:
   class Entry : public RefCounted<Entry> {
@@ -85,42 +122,78 @@ public:
     ResultResponse::ConstPtr result_;
   };
 
-  PreparedMetadata() {
-    metadata_.set_empty_key(String());
-    uv_rwlock_init(&rwlock_);
-  }
+  /**
+   * Constructor.
+   *
+   * @param max_entries The maximum number of entries or zero for no limit.
+   * Entries are evicted, least recently used first, once a limit is reached.
+   */
+  explicit PreparedMetadata(size_t max_entries = 0);
 
-  ~PreparedMetadata() { uv_rwlock_destroy(&rwlock_); }
+  ~PreparedMetadata();
 
-  Entry::Ptr get(const String& prepared_id) const {
-    ScopedReadLock rl(&rwlock_);
-    Map::const_iterator i = metadata_.find(prepared_id);
-    if (i != metadata_.end()) {
-      return i->second;
-    }
-    return Entry::Ptr();
-  }
-
-  void set(const String& prepared_id, const PreparedMetadata::Entry::Ptr& entry) {
-    ScopedWriteLock wl(&rwlock_);
-    metadata_[prepared_id] = entry;
-  }
-
-  Entry::Vec copy() const {
-    ScopedReadLock rl(&rwlock_);
-    Entry::Vec temp;
-    temp.reserve(metadata_.size());
-    for (Map::const_iterator it = metadata_.begin(), end = metadata_.end(); it != end; ++it) {
-      temp.push_back(it->second);
-    }
-    return temp;
-  }
+  Entry::Ptr get(const String& prepared_id) const;
+
+  void set(const String& prepared_id, const PreparedMetadata::Entry::Ptr& entry);
+
+  Entry::Vec copy() const;
+
+  size_t max_entries() const { return max_entries_; }
+
+  /**
+   * Get the number of entries and the number of evictions.
+   *
+   * @param metrics The metrics.
+   */
+  void get_metrics(PreparedMetadataMetrics* metrics) const;
 
 private:
-  typedef DenseHashMap<String, Entry::Ptr> Map;
+  typedef FlatHashMap<String, size_t> IndexMap; // Prepared ID to slot
+
+  struct Slot {
+    Slot(const String& prepared_id, const Entry::Ptr& entry)
+        : prepared_id(prepared_id)
+        , entry(entry) {}
+    String prepared_id;
+    Entry::Ptr entry;
+  };
 
-  mutable uv_rwlock_t rwlock_;
-  Map metadata_;
+  typedef Vector<Slot> SlotVec;
+
+  // The entries are split into shards, each with its own lock, so that
+  // concurrent lookups of different statements don't share a lock. Bounded
+  // shards approximate LRU using the CLOCK algorithm: a lookup only sets the
+  // slot's referenced flag (under the read lock) and an insert into a full
+  // shard sweeps the slots, giving referenced slots a second chance, until it
+  // finds a slot that wasn't used since the last sweep.
+  struct Shard : public Allocated {
+    Shard();
+    ~Shard();
+
+    void init(size_t capacity);
+    size_t evict();
+
+    mutable uv_rwlock_t rwlock;
+    IndexMap index;
+    SlotVec slots;
+    ScopedArray<Atomic<bool> > referenced; // Only used by bounded shards
+    size_t capacity;                       // Zero if unbounded
+    size_t hand;
+    uint64_t evictions;
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(Shard);
+  };
+
+  Shard& shard(const String& prepared_id) const;
+
+private:
+  size_t max_entries_;
+  size_t shard_count_;
+  ScopedArray<Shard> shards_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(PreparedMetadata);
 };
 
 }}} // namespace datastax::internal::core
@@ -0,0 +1,177 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "prepared_cache.hpp"
+
+#include "logger.hpp"
+#include "scoped_ptr.hpp"
+#include "serialization.hpp"
+#include "utils.hpp"
+
+#include <string.h>
+
+// The file starts with a magic number and a format version followed by the
+// protocol version and the statements. Each statement is its query, keyspace
+// and PREPARED result body as [int] length prefixed strings.
+#define PREPARED_CACHE_MAGIC "CPSC"
+#define PREPARED_CACHE_FORMAT_VERSION 1
+#define PREPARED_CACHE_HEADER_SIZE (4 + 2 * sizeof(uint8_t) + sizeof(int32_t))
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+namespace {
+
+void append_int32(int32_t value, String* output) {
+  char buf[sizeof(int32_t)];
+  encode_int32(buf, value);
+  output->append(buf, sizeof(buf));
+}
+
+void append_string(const char* data, size_t size, String* output) {
+  append_int32(static_cast<int32_t>(size), output);
+  output->append(data, size);
+}
+
+bool read_string(const char** pos, const char* end, String* output) {
+  if (end - *pos < static_cast<ptrdiff_t>(sizeof(int32_t))) return false;
+  int32_t size;
+  *pos = decode_int32(*pos, size);
+  if (size < 0 || end - *pos < size) return false;
+  output->assign(*pos, size);
+  *pos += size;
+  return true;
+}
+
+} // namespace
+
+PreparedCache* PreparedCache::load(const String& path, ProtocolVersion protocol_version) {
+  String data;
+  if (!read_file(path, &data)) {
+    LOG_DEBUG("Unable to read prepared statement cache file \"%s\"", path.c_str());
+    return NULL;
+  }
+
+  const char* pos = data.data();
+  const char* end = data.data() + data.size();
+  if (data.size() < PREPARED_CACHE_HEADER_SIZE || memcmp(pos, PREPARED_CACHE_MAGIC, 4) != 0 ||
+      static_cast<uint8_t>(pos[4]) != PREPARED_CACHE_FORMAT_VERSION) {
+    LOG_WARN("Ignoring invalid prepared statement cache file \"%s\"", path.c_str());
+    return NULL;
+  }
+  pos += 4 + sizeof(uint8_t);
+
+  if (static_cast<uint8_t>(*pos++) != protocol_version.value()) {
+    LOG_INFO("Ignoring prepared statement cache file \"%s\" saved using a different protocol "
+             "version",
+             path.c_str());
+    return NULL;
+  }
+
+  int32_t count;
+  pos = decode_int32(pos, count);
+
+  ScopedPtr<PreparedCache> cache(new PreparedCache(protocol_version));
+  for (int32_t i = 0; i < count; ++i) {
+    Statement statement;
+    if (!read_string(&pos, end, &statement.query) ||
+        !read_string(&pos, end, &statement.keyspace) ||
+        !read_string(&pos, end, &statement.body)) {
+      LOG_WARN("Ignoring truncated prepared statement cache file \"%s\"", path.c_str());
+      return NULL;
+    }
+    if (!cache->decode(statement)) continue; // Skip statements that can't be decoded
+    cache->index_[statement.query].push_back(cache->statements_.size());
+    cache->statements_.push_back(statement);
+  }
+
+  LOG_INFO("Loaded %u prepared statements from cache file \"%s\"",
+           static_cast<unsigned int>(cache->statements_.size()), path.c_str());
+  return cache.release();
+}
+
+int PreparedCache::save(const String& path, ProtocolVersion protocol_version,
+                        const PreparedMetadata::Entry::Vec& entries) {
+  String data(PREPARED_CACHE_MAGIC);
+  data.push_back(static_cast<char>(PREPARED_CACHE_FORMAT_VERSION));
+  data.push_back(static_cast<char>(protocol_version.value()));
+  size_t count_pos = data.size();
+  append_int32(0, &data); // Updated after the statements are written
+
+  int32_t count = 0;
+  for (PreparedMetadata::Entry::Vec::const_iterator it = entries.begin(), end = entries.end();
+       it != end; ++it) {
+    const ResultResponse::ConstPtr& result((*it)->result());
+    // Entries updated by a metadata change (protocol v5) reference a ROWS
+    // result instead of the PREPARED result
+    if (result->kind() != CASS_RESULT_KIND_PREPARED ||
+        result->protocol_version() != protocol_version) {
+      continue;
+    }
+    append_string((*it)->query().data(), (*it)->query().size(), &data);
+    append_string((*it)->keyspace().data(), (*it)->keyspace().size(), &data);
+    append_string(result->body().data(), result->body().size(), &data);
+    count++;
+  }
+  encode_int32(&data[count_pos], count);
+
+  if (!write_file(path, data)) {
+    LOG_WARN("Unable to write prepared statement cache file \"%s\"", path.c_str());
+    return -1;
+  }
+  return count;
+}
+
+ResultResponse::Ptr PreparedCache::find(const String& keyspace, const String& query) const {
+  IndexMap::const_iterator it = index_.find(query);
+  if (it == index_.end()) {
+    return ResultResponse::Ptr();
+  }
+  const Vector<size_t>& indices = it->second;
+  for (Vector<size_t>::const_iterator i = indices.begin(), end = indices.end(); i != end; ++i) {
+    if (statements_[*i].keyspace == keyspace) {
+      return decode(statements_[*i]);
+    }
+  }
+  if (keyspace.empty() && indices.size() == 1) {
+    return decode(statements_[indices.front()]);
+  }
+  return ResultResponse::Ptr();
+}
+
+void PreparedCache::entries(Vector<std::pair<String, PreparedMetadata::Entry::Ptr> >* output) const {
+  for (StatementVec::const_iterator it = statements_.begin(), end = statements_.end(); it != end;
+       ++it) {
+    ResultResponse::Ptr result(decode(*it));
+    if (!result) continue;
+    output->push_back(std::make_pair(
+        result->prepared_id().to_string(),
+        PreparedMetadata::Entry::Ptr(new PreparedMetadata::Entry(
+            it->query, it->keyspace, result->result_metadata_id().to_string(), result))));
+  }
+}
+
+ResultResponse::Ptr PreparedCache::decode(const Statement& statement) const {
+  ResultResponse::Ptr result(new ResultResponse());
+  result->set_buffer(statement.body.size());
+  memcpy(result->buffer()->data(), statement.body.data(), statement.body.size());
+  Decoder decoder(result->data(), statement.body.size(), protocol_version_);
+  if (!result->decode(decoder) || result->kind() != CASS_RESULT_KIND_PREPARED) {
+    return ResultResponse::Ptr();
+  }
+  return result;
+}
@@ -0,0 +1,114 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_PREPARED_CACHE_HPP
+#define DATASTAX_INTERNAL_PREPARED_CACHE_HPP
+
+#include "map.hpp"
+#include "prepared.hpp"
+#include "protocol.hpp"
+#include "ref_counted.hpp"
+#include "result_response.hpp"
+#include "string.hpp"
+#include "vector.hpp"
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * Prepared statements persisted to a file so that a restarted application
+ * doesn't need to prepare its statements again. The file contains the query,
+ * keyspace and the server's PREPARED result for each statement. Cached
+ * statements are used without contacting the cluster and are validated lazily:
+ * a host that doesn't know a statement responds with UNPREPARED and the
+ * statement is prepared on that host as usual.
+ *
+ * A cache is immutable once it's loaded so it's safe to use from multiple
+ * threads.
+ */
+class PreparedCache : public RefCounted<PreparedCache> {
+public:
+  typedef SharedRefPtr<const PreparedCache> ConstPtr;
+
+  /**
+   * Load the prepared statements from a file.
+   *
+   * @param path The file's path.
+   * @param protocol_version The session's protocol version. Statements saved
+   * using a different protocol version are ignored.
+   * @return The cache or NULL if the file doesn't exist or is invalid.
+   */
+  static PreparedCache* load(const String& path, ProtocolVersion protocol_version);
+
+  /**
+   * Save prepared statements to a file. The file is replaced atomically
+   * (where supported).
+   *
+   * @param path The file's path.
+   * @param protocol_version The session's protocol version.
+   * @param entries The prepared metadata entries. Only entries for PREPARED
+   * results are saved.
+   * @return The number of statements saved or negative if the file couldn't
+   * be written.
+   */
+  static int save(const String& path, ProtocolVersion protocol_version,
+                  const PreparedMetadata::Entry::Vec& entries);
+
+  size_t size() const { return statements_.size(); }
+
+  /**
+   * Find a cached statement. Statements are recorded with the keyspace of the
+   * result metadata, which is the session's keyspace for unqualified queries.
+   * Without a keyspace the query must be fully qualified, so the statement is
+   * also found if it's the only one cached for the query.
+   *
+   * @param keyspace The keyspace the statement is prepared in (or empty).
+   * @param query The statement's query.
+   * @return A new PREPARED result for the statement or NULL if it's not
+   * cached.
+   */
+  ResultResponse::Ptr find(const String& keyspace, const String& query) const;
+
+  /**
+   * Get the prepared metadata entries for all the cached statements.
+   *
+   * @return The entries and their prepared IDs.
+   */
+  void entries(Vector<std::pair<String, PreparedMetadata::Entry::Ptr> >* output) const;
+
+private:
+  struct Statement {
+    String query;
+    String keyspace;
+    String body;
+  };
+
+  typedef Vector<Statement> StatementVec;
+  typedef Map<String, Vector<size_t> > IndexMap; // Query to statements
+
+  explicit PreparedCache(ProtocolVersion protocol_version)
+      : protocol_version_(protocol_version) {}
+
+  ResultResponse::Ptr decode(const Statement& statement) const;
+
+private:
+  ProtocolVersion protocol_version_;
+  StatementVec statements_;
+  IndexMap index_;
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
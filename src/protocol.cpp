@@ -92,3 +92,9 @@ bool ProtocolVersion::supports_result_metadata_id() const {
   assert(value_ > 0 && "Invalid protocol version");
   return is_protocol_at_least_v5_or_dse_v2(value_);
 }
+
+bool ProtocolVersion::supports_segments() const {
+  assert(value_ > 0 && "Invalid protocol version");
+  // DSE protocol versions don't use segment framing
+  return !is_dse() && value_ >= CASS_PROTOCOL_VERSION_V5;
+}
@@ -131,6 +131,14 @@ public:
    */
   bool supports_result_metadata_id() const;
 
+  /**
+   * Check to see if the outer segment framing (with checksummed segments that
+   * can contain many envelopes) is used by the current protocol version.
+   *
+   * @return true if supported, otherwise false.
+   */
+  bool supports_segments() const;
+
 public:
   bool operator<(ProtocolVersion version) const { return value_ < version.value_; }
   bool operator>(ProtocolVersion version) const { return value_ > version.value_; }
@@ -103,7 +103,7 @@ QueryPlan* RackAwarePolicy::new_query_plan(const String& keyspace, RequestHandle
                                          const TokenMap* token_map) {
   CassConsistency cl =
       request_handler != NULL ? request_handler->consistency() : CASS_DEFAULT_CONSISTENCY;
-  return new RackAwareQueryPlan(this, cl, index_++);
+  return new (request_handler) RackAwareQueryPlan(this, cl, index_++);
 }
 
 bool RackAwarePolicy::is_host_up(const Address& address) const {
@@ -242,7 +242,7 @@ RackAwarePolicy::RackAwareQueryPlan::RackAwareQueryPlan(const RackAwarePolicy* p
     , remote_remaining_(0)
     , index_(start_index) {}
 
-Host::Ptr RackAwarePolicy::RackAwareQueryPlan::compute_next() {
+const Host::Ptr& RackAwarePolicy::RackAwareQueryPlan::compute_next() {
   while (local_remaining_ > 0) {
     --local_remaining_;
     const Host::Ptr& host(get_next_host(hosts_, index_++));
@@ -278,7 +278,7 @@ Host::Ptr RackAwarePolicy::RackAwareQueryPlan::compute_next() {
 
   // Skip remote DCs for LOCAL_ consistency levels.
   if (is_dc_local(cl_)) {
-    return Host::Ptr();
+    return NO_HOST;
   }
 
   if (!remote_dcs_) {
@@ -306,5 +306,5 @@ Host::Ptr RackAwarePolicy::RackAwareQueryPlan::compute_next() {
     remote_dcs_->erase(i);
   }
 
-  return Host::Ptr();
+  return NO_HOST;
 }
@@ -93,7 +93,7 @@ public:
   public:
     RackAwareQueryPlan(const RackAwarePolicy* policy, CassConsistency cl, size_t start_index);
 
-    virtual Host::Ptr compute_next();
+    virtual const Host::Ptr& compute_next();
 
   private:
     const RackAwarePolicy* policy_;
@@ -44,16 +44,31 @@
 namespace datastax { namespace internal {
 
 Random::Random()
+    : is_synchronized_(true)
     // Use high resolution time if we can't get a real random seed
-    : rng_(get_random_seed(uv_hrtime())) {
+    , rng_(get_random_seed(uv_hrtime())) {
   uv_mutex_init(&mutex_);
 }
 
-Random::~Random() { uv_mutex_destroy(&mutex_); }
+Random::Random(uint64_t seed)
+    : is_synchronized_(false)
+    , rng_(seed) {}
+
+Random::~Random() {
+  if (is_synchronized_) {
+    uv_mutex_destroy(&mutex_);
+  }
+}
 
 uint64_t Random::next(uint64_t max) {
+  if (!is_synchronized_) {
+    return internal_next(max);
+  }
   ScopedMutex l(&mutex_);
+  return internal_next(max);
+}
 
+uint64_t Random::internal_next(uint64_t max) {
   if (max == 0) {
     return 0;
   }
@@ -27,12 +27,28 @@ namespace datastax { namespace internal {
 
 class Random : public Allocated {
 public:
+  /**
+   * Construct a generator that can be shared by threads.
+   */
   Random();
+
+  /**
+   * Construct a generator that's only used by a single thread, e.g. by the
+   * load balancing policies of an event loop, so it doesn't need a lock.
+   *
+   * @param seed The generator's seed.
+   */
+  explicit Random(uint64_t seed);
+
   ~Random();
 
   uint64_t next(uint64_t max);
 
 private:
+  uint64_t internal_next(uint64_t max);
+
+private:
+  const bool is_synchronized_;
   uv_mutex_t mutex_;
   MT19937_64 rng_;
 };
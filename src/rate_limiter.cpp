@@ -0,0 +1,38 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "rate_limiter.hpp"
+
+#include <algorithm>
+
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+RateLimiter::RateLimiter(double requests_per_second, unsigned burst)
+    : interval_ns_(std::max(static_cast<uint64_t>(1e9 / requests_per_second),
+                            static_cast<uint64_t>(1)))
+    , burst_ns_(interval_ns_ * std::max(burst, 1u))
+    , next_ns_(0) {}
+
+uint64_t RateLimiter::acquire(uint64_t now_ns) {
+  uint64_t next_ns = next_ns_.load(MEMORY_ORDER_RELAXED);
+  uint64_t new_next_ns;
+  do {
+    // Time that went by while idle only adds up to a burst of requests
+    new_next_ns = std::max(next_ns, now_ns) + interval_ns_;
+  } while (!next_ns_.compare_exchange_weak(next_ns, new_next_ns));
+  return new_next_ns > burst_ns_ ? new_next_ns - burst_ns_ : 0;
+}
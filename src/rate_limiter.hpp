@@ -0,0 +1,64 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_RATE_LIMITER_HPP
+#define DATASTAX_INTERNAL_RATE_LIMITER_HPP
+
+#include "atomic.hpp"
+#include "ref_counted.hpp"
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * A token bucket that limits the rate requests are started. Requests over the
+ * rate aren't failed. Instead each request reserves the next free slot and is
+ * told when it can start, so a burst is spread out at the configured rate.
+ *
+ * The bucket is kept as the time the next slot is free (a "virtual
+ * scheduling" token bucket), which can be updated without locking by all the
+ * I/O threads.
+ */
+class RateLimiter : public RefCounted<RateLimiter> {
+public:
+  typedef SharedRefPtr<RateLimiter> Ptr;
+
+  /**
+   * Constructor.
+   *
+   * @param requests_per_second The rate requests are allowed to start.
+   * @param burst The number of requests that can start at the same time after
+   * the limiter has been idle.
+   */
+  RateLimiter(double requests_per_second, unsigned burst);
+
+  /**
+   * Reserve a slot for a request.
+   *
+   * @param now_ns The current time.
+   * @return The time the request can start. This is at most the current time
+   * if the request can start immediately.
+   */
+  uint64_t acquire(uint64_t now_ns);
+
+private:
+  const uint64_t interval_ns_;
+  const uint64_t burst_ns_;
+  Atomic<uint64_t> next_ns_;
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -0,0 +1,65 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "reconnect_throttle.hpp"
+
+#include "logger.hpp"
+
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+bool ReconnectThrottle::try_start_connect_attempt(Host* host) const {
+  if (max_connect_attempts_ <= 0) return true;
+  int32_t attempts = host->connect_attempts().load(MEMORY_ORDER_RELAXED);
+  do {
+    if (attempts >= max_connect_attempts_) return false;
+  } while (!host->connect_attempts().compare_exchange_weak(attempts, attempts + 1));
+  return true;
+}
+
+void ReconnectThrottle::finish_connect_attempt(Host* host) const {
+  if (max_connect_attempts_ <= 0) return;
+  host->connect_attempts().fetch_sub(1, MEMORY_ORDER_RELAXED);
+}
+
+void ReconnectThrottle::start_warmup(Host* host, uint64_t now_ns) const {
+  if (warmup_duration_ns_ == 0) return;
+  uint64_t start_ns = host->warmup_start_ns().load(MEMORY_ORDER_RELAXED);
+  if (start_ns != 0 && now_ns - start_ns < warmup_duration_ns_) {
+    return; // Another connection pool to the host already started the warm-up
+  }
+  if (host->warmup_start_ns().compare_exchange_strong(start_ns, now_ns)) {
+    host->warmup_requests().store(0, MEMORY_ORDER_RELAXED);
+    LOG_INFO("Warming up host %s for %llums", host->address_string().c_str(),
+             static_cast<unsigned long long>(warmup_duration_ns_ / (1000LL * 1000LL)));
+  }
+}
+
+bool ReconnectThrottle::try_admit(Host* host, uint64_t now_ns) const {
+  uint64_t start_ns = host->warmup_start_ns().load(MEMORY_ORDER_RELAXED);
+  if (start_ns == 0) return true;
+  uint64_t elapsed_ns = now_ns > start_ns ? now_ns - start_ns : 0;
+  if (elapsed_ns >= warmup_duration_ns_) {
+    // Avoid writing to the shared state once the warm-up is over
+    host->warmup_start_ns().compare_exchange_strong(start_ns, 0);
+    return true;
+  }
+  // Admit a share of the requests, in percent, that grows with the elapsed
+  // time. Counting the requests spreads the admitted requests evenly.
+  uint32_t percent = static_cast<uint32_t>((elapsed_ns * 100) / warmup_duration_ns_);
+  uint32_t count = host->warmup_requests().fetch_add(1, MEMORY_ORDER_RELAXED);
+  return count % 100 < percent;
+}
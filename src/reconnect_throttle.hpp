@@ -0,0 +1,101 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_RECONNECT_THROTTLE_HPP
+#define DATASTAX_INTERNAL_RECONNECT_THROTTLE_HPP
+
+#include "host.hpp"
+#include "ref_counted.hpp"
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * Limits the load the connection pools put on a host that's restarting.
+ *
+ * The number of connection attempts in progress to a host is capped. Every
+ * I/O thread has its own connection pool to each host so without a cap all
+ * the pools connect at the same time once the host is reachable again. A pool
+ * that can't start an attempt retries it after a short delay.
+ *
+ * A host that's reconnected after being down is warmed up: the share of the
+ * requests that use it (as their first choice) ramps up linearly over the
+ * warm-up duration. The other requests use it only after the other hosts of
+ * their query plan.
+ *
+ * The state is kept in the hosts so it's shared by all the I/O threads.
+ */
+class ReconnectThrottle : public RefCounted<ReconnectThrottle> {
+public:
+  typedef SharedRefPtr<ReconnectThrottle> Ptr;
+
+  /**
+   * Constructor.
+   *
+   * @param max_connect_attempts The maximum number of connection attempts in
+   * progress to a host or zero for no limit.
+   * @param warmup_duration_ms The duration of a reconnected host's warm-up or
+   * zero to disable warm-ups.
+   */
+  ReconnectThrottle(unsigned max_connect_attempts, uint64_t warmup_duration_ms)
+      : max_connect_attempts_(static_cast<int32_t>(max_connect_attempts))
+      , warmup_duration_ns_(warmup_duration_ms * 1000LL * 1000LL) {}
+
+  /**
+   * Start a connection attempt to a host.
+   *
+   * @param host The host.
+   * @return true if the attempt can start, otherwise false if too many
+   * attempts are in progress. An attempt that started must be finished using
+   * finish_connect_attempt().
+   */
+  bool try_start_connect_attempt(Host* host) const;
+
+  /**
+   * Finish a connection attempt to a host (successful or not).
+   *
+   * @param host The host.
+   */
+  void finish_connect_attempt(Host* host) const;
+
+  /**
+   * Start warming up a host that was reconnected. A host that's already
+   * warming up isn't restarted.
+   *
+   * @param host The host.
+   * @param now_ns The current time from get_time_monotonic_coarse_ns().
+   */
+  void start_warmup(Host* host, uint64_t now_ns) const;
+
+  /**
+   * Determine if a request can use a host now.
+   *
+   * @param host The host.
+   * @param now_ns The current time from get_time_monotonic_coarse_ns().
+   * @return true if the request can use the host, otherwise false if the host
+   * is warming up and should be tried after the other hosts.
+   */
+  bool try_admit(Host* host, uint64_t now_ns) const;
+
+  bool has_warmup() const { return warmup_duration_ns_ > 0; }
+
+private:
+  const int32_t max_connect_attempts_;
+  const uint64_t warmup_duration_ns_;
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -98,4 +98,41 @@ uint64_t ExponentialReconnectionSchedule::next_delay_ms() {
   return delay_ms;
 }
 
+DecorrelatedJitterReconnectionPolicy::DecorrelatedJitterReconnectionPolicy(uint64_t base_delay_ms,
+                                                                           uint64_t max_delay_ms)
+    : ReconnectionPolicy(DECORRELATED_JITTER)
+    , base_delay_ms_(base_delay_ms)
+    , max_delay_ms_(max_delay_ms) {}
+
+uint64_t DecorrelatedJitterReconnectionPolicy::base_delay_ms() const { return base_delay_ms_; }
+
+uint64_t DecorrelatedJitterReconnectionPolicy::max_delay_ms() const { return max_delay_ms_; }
+
+const char* DecorrelatedJitterReconnectionPolicy::name() const { return "decorrelated jitter"; }
+
+ReconnectionSchedule* DecorrelatedJitterReconnectionPolicy::new_reconnection_schedule() {
+  return new DecorrelatedJitterReconnectionSchedule(base_delay_ms_, max_delay_ms_, &random_);
+}
+
+DecorrelatedJitterReconnectionSchedule::DecorrelatedJitterReconnectionSchedule(
+    uint64_t base_delay_ms, uint64_t max_delay_ms, Random* random)
+    : base_delay_ms_(base_delay_ms)
+    , max_delay_ms_(max_delay_ms)
+    , delay_ms_(base_delay_ms)
+    , random_(random) {}
+
+uint64_t DecorrelatedJitterReconnectionSchedule::next_delay_ms() {
+  // Choose a delay in [base, previous * 3], avoiding overflow once the
+  // previous delay reaches the max delay
+  uint64_t upper_ms = delay_ms_ < max_delay_ms_ / 3 ? delay_ms_ * 3 : max_delay_ms_;
+  if (upper_ms > base_delay_ms_) {
+    delay_ms_ = base_delay_ms_ + random_->next(upper_ms - base_delay_ms_ + 1);
+  } else {
+    delay_ms_ = base_delay_ms_;
+  }
+  delay_ms_ = std::min(delay_ms_, max_delay_ms_);
+  assert(delay_ms_ > 0);
+  return delay_ms_;
+}
+
 }}} // namespace datastax::internal::core
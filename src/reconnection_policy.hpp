@@ -33,7 +33,7 @@ public:
 class ReconnectionPolicy : public RefCounted<ReconnectionPolicy> {
 public:
   typedef SharedRefPtr<ReconnectionPolicy> Ptr;
-  enum Type { CONSTANT, EXPONENTIAL };
+  enum Type { CONSTANT, EXPONENTIAL, DECORRELATED_JITTER };
 
   ReconnectionPolicy(Type type);
   virtual ~ReconnectionPolicy();
@@ -108,6 +108,47 @@ private:
   Random random_;
 };
 
+/**
+ * A schedule using "decorrelated jitter": each delay is chosen at random
+ * between the base delay and three times the previous delay (capped at the
+ * max delay). Unlike a fixed exponential sequence with a small amount of
+ * jitter, the schedules of the many connection pools reconnecting to the same
+ * host quickly spread apart instead of retrying in lockstep.
+ */
+class DecorrelatedJitterReconnectionSchedule : public ReconnectionSchedule {
+public:
+  DecorrelatedJitterReconnectionSchedule(uint64_t base_delay_ms, uint64_t max_delay_ms,
+                                         Random* random);
+
+  virtual uint64_t next_delay_ms();
+
+private:
+  uint64_t base_delay_ms_;
+  uint64_t max_delay_ms_;
+  uint64_t delay_ms_;
+  Random* random_;
+};
+
+class DecorrelatedJitterReconnectionPolicy : public ReconnectionPolicy {
+public:
+  typedef SharedRefPtr<DecorrelatedJitterReconnectionPolicy> Ptr;
+
+  DecorrelatedJitterReconnectionPolicy(
+      uint64_t base_delay_ms = CASS_DEFAULT_EXPONENTIAL_RECONNECT_BASE_DELAY_MS,
+      uint64_t max_delay_ms = CASS_DEFAULT_EXPONENTIAL_RECONNECT_MAX_DELAY_MS);
+
+  uint64_t base_delay_ms() const;
+  uint64_t max_delay_ms() const;
+
+  virtual const char* name() const;
+  virtual ReconnectionSchedule* new_reconnection_schedule();
+
+private:
+  uint64_t base_delay_ms_;
+  uint64_t max_delay_ms_;
+  Random random_;
+};
+
 }}} // namespace datastax::internal::core
 
 #endif
@@ -19,8 +19,11 @@
 
 #include "allocated.hpp"
 #include "atomic.hpp"
+#include "driver_config.hpp"
 #include "macros.hpp"
 #include "memory.hpp"
+#include "memory_accounting.hpp"
+#include "object_cache.hpp"
 
 #include <assert.h>
 #include <new>
@@ -28,6 +31,16 @@
 
 namespace datastax { namespace internal {
 
+/**
+ * Destroys a ref-counted object once its last reference is released. This is
+ * specialized for objects that can be placed in memory that isn't freed using
+ * delete.
+ */
+template <class T>
+struct RefCountedDestroyer {
+  static void destroy(const T* object) { delete object; }
+};
+
 template <class T>
 class RefCounted : public Allocated {
 public:
@@ -46,7 +59,7 @@ public:
 #ifdef THREAD_SANITIZER
       __tsan_acquire(const_cast<void*>(static_cast<const void*>(this)));
 #endif
-      delete static_cast<const T*>(this);
+      RefCountedDestroyer<T>::destroy(static_cast<const T*>(this));
     }
   }
 
@@ -55,6 +68,62 @@ private:
   DISALLOW_COPY_AND_ASSIGN(RefCounted);
 };
 
+/**
+ * A reference count for objects that are only referenced from the thread of
+ * one event loop (e.g. a connection pool's connections). The count isn't
+ * atomic so it's cheaper to copy their SharedRefPtr on hot paths. Debug builds
+ * assert that every reference is taken and released on the thread that took
+ * the first reference.
+ */
+template <class T>
+class LoopRefCounted : public Allocated {
+public:
+  LoopRefCounted()
+      : ref_count_(0)
+#ifndef NDEBUG
+      , has_thread_(false)
+#endif
+  {
+  }
+
+  int ref_count() const { return ref_count_; }
+
+  void inc_ref() const {
+    check_thread();
+    ++ref_count_;
+  }
+
+  void dec_ref() const {
+    check_thread();
+    assert(ref_count_ >= 1);
+    if (--ref_count_ == 0) {
+      delete static_cast<const T*>(this);
+    }
+  }
+
+private:
+#ifndef NDEBUG
+  void check_thread() const {
+    uv_thread_t current = uv_thread_self();
+    if (!has_thread_) {
+      thread_ = current;
+      has_thread_ = true;
+    }
+    assert(uv_thread_equal(&thread_, &current) && "Referenced outside of its event loop's thread");
+  }
+#else
+  void check_thread() const {}
+#endif
+
+private:
+  mutable int ref_count_;
+#ifndef NDEBUG
+  mutable uv_thread_t thread_;
+  mutable bool has_thread_;
+#endif
+  DISALLOW_COPY_AND_ASSIGN(LoopRefCounted);
+};
+
 template <class T>
 class SharedRefPtr {
 public:
@@ -141,29 +210,137 @@ class RefBuffer : public RefCounted<RefBuffer> {
 public:
   typedef SharedRefPtr<RefBuffer> Ptr;
 
-  static RefBuffer* create(size_t size) {
+  /**
+   * Memory that buffers can be placed in instead of being allocated, e.g. a
+   * region backed by huge pages. An arena's memory is given back when each
+   * buffer placed in it is destroyed, which can be on any thread.
+   */
+  class Arena {
+  public:
+    virtual ~Arena() {}
+
+    /**
+     * Get memory for a buffer.
+     *
+     * @param size The size of the memory.
+     * @return The memory or NULL if the arena is out of space.
+     */
+    virtual void* allocate(size_t size) = 0;
+
+    /**
+     * Give back the memory of a destroyed buffer.
+     *
+     * @param ptr The memory returned by allocate().
+     */
+    virtual void release(void* ptr) = 0;
+  };
+
+  static RefBuffer* create(size_t size,
+                           MemoryCategory category = MEMORY_CATEGORY_REQUEST_BUFFERS) {
 #if defined(_WIN32)
 #pragma warning(push)
 #pragma warning(disable : 4291) // Invalid warning thrown RefBuffer has a delete function
 #endif
-    return new (size) RefBuffer();
+    return new (size) RefBuffer(size, category, NULL);
 #if defined(_WIN32)
 #pragma warning(pop)
 #endif
   }
 
+  /**
+   * Create a buffer in an arena's memory.
+   *
+   * @param size The size of the buffer.
+   * @param category The category of the buffer's memory.
+   * @param arena The arena.
+   * @return The buffer or NULL if the arena is out of space.
+   */
+  static RefBuffer* create(size_t size, MemoryCategory category, Arena* arena) {
+    void* memory = arena->allocate(sizeof(RefBuffer) + size);
+    if (memory == NULL) return NULL;
+    return ::new (memory) RefBuffer(size, category, arena);
+  }
+
+  static void destroy(const RefBuffer* buffer) {
+    Arena* arena = buffer->arena_;
+    if (arena == NULL) {
+      delete buffer;
+    } else {
+      void* memory = const_cast<RefBuffer*>(buffer);
+      buffer->~RefBuffer();
+      arena->release(memory);
+    }
+  }
+
+  ~RefBuffer() { MemoryAccounting::remove(category_, sizeof(RefBuffer) + size_); }
+
   char* data() { return reinterpret_cast<char*>(this) + sizeof(RefBuffer); }
 
+#ifdef HAVE_OBJECT_CACHE
+  void operator delete(void* ptr) { ObjectCache::deallocate(ptr); }
+#else
   void operator delete(void* ptr) { Memory::free(ptr); }
+#endif
 
 private:
-  RefBuffer() {}
+  RefBuffer(size_t size, MemoryCategory category, Arena* arena)
+      : size_(size)
+      , category_(category)
+      , arena_(arena) {
+    MemoryAccounting::add(category_, sizeof(RefBuffer) + size_);
+  }
 
+#ifdef HAVE_OBJECT_CACHE
+  void* operator new(size_t size, size_t extra) { return ObjectCache::allocate(size + extra); }
+#else
   void* operator new(size_t size, size_t extra) { return Memory::malloc(size + extra); }
+#endif
+
+  const size_t size_;
+  const MemoryCategory category_;
+  Arena* const arena_; // NULL unless the buffer is placed in an arena
 
   DISALLOW_COPY_AND_ASSIGN(RefBuffer);
 };
 
+template <>
+struct RefCountedDestroyer<RefBuffer> {
+  static void destroy(const RefBuffer* buffer) { RefBuffer::destroy(buffer); }
+};
+
+/**
+ * Memory owned by the application that's referenced instead of copied. The
+ * application's release callback is called once the last reference is
+ * released, which can be on any thread.
+ */
+class ExternalBuffer : public RefCounted<ExternalBuffer> {
+public:
+  typedef SharedRefPtr<ExternalBuffer> Ptr;
+  typedef void (*ReleaseCallback)(void* data);
+
+  ExternalBuffer(const char* data, size_t size, ReleaseCallback release, void* release_data)
+      : data_(data)
+      , size_(size)
+      , release_(release)
+      , release_data_(release_data) {}
+
+  ~ExternalBuffer() {
+    if (release_) release_(release_data_);
+  }
+
+  const char* data() const { return data_; }
+  size_t size() const { return size_; }
+
+private:
+  const char* data_;
+  size_t size_;
+  ReleaseCallback release_;
+  void* release_data_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ExternalBuffer);
+};
+
 }} // namespace datastax::internal
 
 #endif
@@ -47,12 +47,15 @@ void cass_custom_payload_remove_n(CassCustomPayload* payload, const char* name,
   payload->remove(name, name_length);
 }
 
+void cass_custom_payload_freeze(CassCustomPayload* payload) { payload->freeze(); }
+
 void cass_custom_payload_free(CassCustomPayload* payload) { payload->dec_ref(); }
 
 } // extern "C"
 
 void CustomPayload::set(const char* name, size_t name_length, const uint8_t* value,
                         size_t value_size) {
+  if (is_frozen_) return;
   Buffer buf(sizeof(uint16_t) + name_length + sizeof(int32_t) + value_size);
   size_t pos = buf.encode_string(0, name, static_cast<uint16_t>(name_length));
   buf.encode_bytes(pos, reinterpret_cast<const char*>(value), value_size);
@@ -68,3 +71,34 @@ int32_t CustomPayload::encode(BufferVec* bufs) const {
   }
   return length;
 }
+
+void Request::copy_options(const Request& request) {
+  flags_ = request.flags_;
+  settings_ = request.settings_;
+  timestamp_ = request.timestamp_;
+  deadline_ms_ = request.deadline_ms_;
+  record_attempted_addresses_ = request.record_attempted_addresses_;
+  custom_payload_ = request.custom_payload_;
+  custom_payload_extra_.assign(request.custom_payload_extra_);
+  profile_name_ = request.profile_name_;
+  profile_handle_ = request.profile_handle_;
+  if (request.host_) {
+    host_.reset(new Address(*request.host_));
+  } else {
+    host_.reset();
+  }
+}
+
+void CustomPayload::freeze() {
+  if (is_frozen_) return;
+  size_t size = sizeof(uint16_t);
+  for (ItemMap::const_iterator i = items_.begin(), end = items_.end(); i != end; ++i) {
+    size += i->second.size();
+  }
+  encoded_ = Buffer(size);
+  size_t pos = encoded_.encode_uint16(0, static_cast<uint16_t>(items_.size()));
+  for (ItemMap::const_iterator i = items_.begin(), end = items_.end(); i != end; ++i) {
+    pos = encoded_.copy(pos, i->second.data(), i->second.size());
+  }
+  is_frozen_ = true;
+}
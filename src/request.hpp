@@ -21,6 +21,7 @@
 #include "cassandra.h"
 #include "constants.hpp"
 #include "external.hpp"
+#include "interned_string.hpp"
 #include "macros.hpp"
 #include "map.hpp"
 #include "ref_counted.hpp"
@@ -39,11 +40,17 @@ class CustomPayload : public RefCounted<CustomPayload> {
 public:
   typedef SharedRefPtr<const CustomPayload> ConstPtr;
 
+  CustomPayload()
+      : is_frozen_(false) {}
+
   virtual ~CustomPayload() {}
 
   void set(const char* name, size_t name_length, const uint8_t* value, size_t value_size);
 
-  void remove(const char* name, size_t name_length) { items_.erase(String(name, name_length)); }
+  void remove(const char* name, size_t name_length) {
+    if (is_frozen_) return;
+    items_.erase(String(name, name_length));
+  }
 
   int32_t encode(BufferVec* bufs) const;
 
@@ -51,9 +58,25 @@ public:
 
   inline size_t size() const { return items_.size(); }
 
+  void assign(const CustomPayload& payload) { items_ = payload.items_; }
+
+  /**
+   * Make the payload immutable and pre-encode it, with its item count, into
+   * a single buffer that's shared by the requests that use the payload.
+   * Setting or removing items of a frozen payload has no effect.
+   */
+  void freeze();
+
+  bool is_frozen() const { return is_frozen_; }
+
+  // The encoded payload ([bytes map]), only valid if the payload is frozen
+  const Buffer& encoded() const { return encoded_; }
+
 private:
   typedef Map<String, Buffer> ItemMap;
   ItemMap items_;
+  bool is_frozen_;
+  Buffer encoded_;
 };
 
 // A grouping of common request settings that can be easily inherited (copied).
@@ -64,13 +87,15 @@ struct RequestSettings {
       : consistency(CASS_CONSISTENCY_UNKNOWN)
       , serial_consistency(CASS_CONSISTENCY_UNKNOWN)
       , request_timeout_ms(CASS_UINT64_MAX)
-      , is_idempotent(false) {}
+      , is_idempotent(false)
+      , priority(CASS_REQUEST_PRIORITY_UNSET) {}
   CassConsistency consistency;
   CassConsistency serial_consistency;
   uint64_t request_timeout_ms;
   RetryPolicy::Ptr retry_policy;
   bool is_idempotent;
-  String keyspace;
+  CassRequestPriority priority;
+  InternedString keyspace;
 };
 
 class Request : public RefCounted<Request> {
@@ -82,14 +107,17 @@ public:
     REQUEST_ERROR_BATCH_WITH_NAMED_VALUES,
     REQUEST_ERROR_PARAMETER_UNSET,
     REQUEST_ERROR_NO_AVAILABLE_STREAM_IDS,
-    REQUEST_ERROR_NO_DATA_WRITTEN
+    REQUEST_ERROR_NO_DATA_WRITTEN,
+    REQUEST_ERROR_WRITE_QUEUE_FULL
   };
 
   Request(uint8_t opcode)
       : opcode_(opcode)
       , flags_(0)
       , timestamp_(CASS_INT64_MIN)
-      , record_attempted_addresses_(false) {}
+      , deadline_ms_(0)
+      , record_attempted_addresses_(false)
+      , profile_handle_(-1) {}
 
   virtual ~Request() {}
 
@@ -137,14 +165,25 @@ public:
 
   void set_is_idempotent(bool is_idempotent) { settings_.is_idempotent = is_idempotent; }
 
-  const String& keyspace() const { return settings_.keyspace; }
+  CassRequestPriority priority() const { return settings_.priority; }
+
+  void set_priority(CassRequestPriority priority) { settings_.priority = priority; }
+
+  const String& keyspace() const { return settings_.keyspace.str(); }
 
-  void set_keyspace(const String& keyspace) { settings_.keyspace = keyspace; }
+  const InternedString& interned_keyspace() const { return settings_.keyspace; }
+
+  void set_keyspace(const String& keyspace) { settings_.keyspace = InternedString(keyspace); }
 
   int64_t timestamp() const { return timestamp_; }
 
   void set_timestamp(int64_t timestamp) { timestamp_ = timestamp; }
 
+  // An absolute deadline in milliseconds since the Unix epoch, 0 if none.
+  uint64_t deadline_ms() const { return deadline_ms_; }
+
+  void set_deadline_ms(uint64_t deadline_ms) { deadline_ms_ = deadline_ms; }
+
   bool record_attempted_addresses() const { return record_attempted_addresses_; }
 
   void set_record_attempted_addresses(bool record_attempted_addresses) {
@@ -161,13 +200,30 @@ public:
     custom_payload_extra_.set(key, strlen(key), value, value_len);
   }
 
-  bool has_execution_profile() const { return !profile_name_.empty(); }
+  bool has_execution_profile() const { return !profile_name_.empty() || profile_handle_ >= 0; }
 
   const String& execution_profile_name() const { return profile_name_; }
 
-  void set_execution_profile_name(const String& name) { profile_name_ = name; }
+  void set_execution_profile_name(const String& name) {
+    profile_name_ = name;
+    profile_handle_ = -1;
+  }
+
+  // The handle of the request's execution profile, -1 if it's set by name
+  int32_t execution_profile_handle() const { return profile_handle_; }
+
+  void set_execution_profile_handle(int32_t handle) {
+    profile_name_.clear();
+    profile_handle_ = handle;
+  }
 
   int32_t encode_custom_payload(BufferVec* bufs) const {
+    // A frozen payload is referenced as-is, without re-encoding it
+    if (custom_payload_ && custom_payload_->is_frozen() && custom_payload_extra_.empty()) {
+      bufs->push_back(custom_payload_->encoded());
+      return static_cast<int32_t>(custom_payload_->encoded().size());
+    }
+
     int32_t length = sizeof(uint16_t);
     uint16_t count = 0;
 
@@ -187,6 +243,10 @@ public:
   void set_host(const Address& host) { host_.reset(new Address(host)); }
   const Address* host() const { return host_.get(); }
 
+  // Copy the flags, settings and options of another request. This is used by
+  // requests derived from an existing request.
+  void copy_options(const Request& request);
+
   virtual int encode(ProtocolVersion version, RequestCallback* callback, BufferVec* bufs) const = 0;
 
 private:
@@ -194,10 +254,12 @@ private:
   uint8_t flags_;
   RequestSettings settings_;
   int64_t timestamp_;
+  uint64_t deadline_ms_;
   bool record_attempted_addresses_;
   CustomPayload::ConstPtr custom_payload_;
   CustomPayload custom_payload_extra_;
   String profile_name_;
+  int32_t profile_handle_;
   ScopedPtr<Address> host_;
 
 private:
@@ -210,6 +272,14 @@ public:
       : Request(opcode) {}
 
   virtual bool get_routing_key(String* routing_key) const = 0;
+
+  /**
+   * Determine if the request is a lightweight transaction. These are routed
+   * to their replicas in a consistent order to reduce Paxos contention.
+   *
+   * @return true if the request is a lightweight transaction.
+   */
+  virtual bool is_lwt() const { return false; }
 };
 
 }}} // namespace datastax::internal::core
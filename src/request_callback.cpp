@@ -16,6 +16,7 @@
 
 #include "request_callback.hpp"
 
+#include "compression.hpp"
 #include "connection.hpp"
 #include "constants.hpp"
 #include "execute_request.hpp"
@@ -45,14 +46,29 @@ void RequestWrapper::init(const ExecutionProfile& profile,
 
 void RequestCallback::notify_write(Connection* connection, int stream) {
   protocol_version_ = connection->protocol_version();
+  compressor_ = connection->compressor();
+  compression_threshold_ = connection->compression_threshold();
   stream_ = stream;
   on_write(connection);
 }
 
 bool RequestCallback::skip_metadata() const {
-  // Skip the metadata if this an execute request and we have an entry cached
-  return request()->opcode() == CQL_OPCODE_EXECUTE && prepared_metadata_entry() &&
-         prepared_metadata_entry()->result()->result_metadata();
+  // Skip the metadata if this is an execute request and its result metadata is
+  // already known
+  const ResultResponse* result = prepared_result();
+  return result != NULL && result->result_metadata();
+}
+
+const ResultResponse* RequestCallback::prepared_result() const {
+  if (request()->opcode() != CQL_OPCODE_EXECUTE) {
+    return NULL;
+  }
+  if (prepared_metadata_entry()) {
+    return prepared_metadata_entry()->result().get();
+  }
+  // Statements prepared using another session don't have an entry. Protocol
+  // v5 servers send the metadata anyway because the metadata ID is empty.
+  return static_cast<const ExecuteRequest*>(request())->prepared()->result().get();
 }
 
 int32_t RequestCallback::encode(BufferVec* bufs) {
@@ -62,6 +78,12 @@ int32_t RequestCallback::encode(BufferVec* bufs) {
     return Request::REQUEST_ERROR_UNSUPPORTED_PROTOCOL;
   }
 
+  if (wrapper_.is_continuous_paging() && !version.is_dse()) {
+    on_error(CASS_ERROR_LIB_MESSAGE_ENCODE,
+             "Continuous paging is only supported by DSE protocol versions");
+    return Request::REQUEST_ERROR_UNSUPPORTED_PROTOCOL;
+  }
+
   size_t index = bufs->size();
   bufs->push_back(Buffer()); // Placeholder
 
@@ -73,6 +95,10 @@ int32_t RequestCallback::encode(BufferVec* bufs) {
     flags |= CASS_FLAG_BETA;
   }
 
+  if (wrapper_.is_tracing_sampled()) {
+    flags |= CASS_FLAG_TRACING;
+  }
+
   if (version >= CASS_PROTOCOL_VERSION_V4 && req->has_custom_payload()) {
     flags |= CASS_FLAG_CUSTOM_PAYLOAD;
     length += req->encode_custom_payload(bufs);
@@ -82,6 +108,18 @@ int32_t RequestCallback::encode(BufferVec* bufs) {
   if (result < 0) return result;
   length += result;
 
+  // The STARTUP and OPTIONS requests are sent before compression is negotiated
+  if (compressor_ && static_cast<size_t>(length) >= compression_threshold_ &&
+      req->opcode() != CQL_OPCODE_STARTUP && req->opcode() != CQL_OPCODE_OPTIONS) {
+    Buffer compressed;
+    if (compressor_->compress(bufs->begin() + index + 1, bufs->end(), length, &compressed)) {
+      bufs->resize(index + 1);
+      bufs->push_back(compressed);
+      flags |= CASS_FLAG_COMPRESSION;
+      length = static_cast<int32_t>(compressed.size());
+    }
+  }
+
   const size_t header_size = CASS_HEADER_SIZE_V3;
 
   Buffer buf(header_size);
@@ -123,7 +161,21 @@ void RequestCallback::on_close() {
   }
 }
 
+void RequestCallback::on_write_error() {
+  if (request()->is_idempotent()) {
+    LOG_DEBUG("Unable to write idempotent request (%p) to socket. Retrying on the next host...",
+              static_cast<void*>(this));
+    on_retry_next_host();
+  } else {
+    on_error(CASS_ERROR_LIB_WRITE_ERROR, "Unable to write to socket");
+  }
+}
+
 void RequestCallback::set_state(RequestCallback::State next_state) {
+  if (record_stage_times_) {
+    record_stage_time(next_state);
+  }
+
   switch (state_) {
     case REQUEST_STATE_NEW:
       if (next_state == REQUEST_STATE_NEW || next_state == REQUEST_STATE_WRITING) {
@@ -172,6 +224,30 @@ void RequestCallback::set_state(RequestCallback::State next_state) {
   }
 }
 
+void RequestCallback::record_stage_time(RequestCallback::State next_state) {
+  uint64_t now = uv_hrtime();
+  switch (next_state) {
+    case REQUEST_STATE_WRITING:
+      write_start_ns_ = now;
+      break;
+    case REQUEST_STATE_READING:
+      write_end_ns_ = now;
+      break;
+    case REQUEST_STATE_READ_BEFORE_WRITE:
+      read_ns_ = now;
+      break;
+    case REQUEST_STATE_FINISHED:
+      if (state_ == REQUEST_STATE_READING) {
+        read_ns_ = now;
+      } else if (state_ == REQUEST_STATE_READ_BEFORE_WRITE) {
+        write_end_ns_ = now;
+      }
+      break;
+    default:
+      break;
+  }
+}
+
 const char* RequestCallback::state_string() const {
   switch (state_) {
     case REQUEST_STATE_NEW:
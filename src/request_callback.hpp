@@ -36,6 +36,7 @@
 
 namespace datastax { namespace internal { namespace core {
 
+class Compressor;
 class Config;
 class Connection;
 class ExecutionProfile;
@@ -48,6 +49,20 @@ class ResultResponse;
 
 typedef Vector<uv_buf_t> UvBufVec;
 
+/**
+ * The options of a DSE continuous paging request.
+ */
+struct ContinuousPagingOptions {
+  ContinuousPagingOptions()
+      : max_pages(0)
+      , pages_per_second(0)
+      , max_enqueued_pages(0) {}
+
+  int32_t max_pages;          // The maximum number of pages, 0 for no limit
+  int32_t pages_per_second;   // The maximum pages sent per second, 0 for no limit
+  int32_t max_enqueued_pages; // The initial page credits (DSEv2), 0 for no limit
+};
+
 /**
  * A wrapper class for keeping a request's state grouped together with the
  * request object. This is necessary because a request object is immutable
@@ -61,7 +76,9 @@ public:
       , consistency_(CASS_DEFAULT_CONSISTENCY)
       , serial_consistency_(CASS_DEFAULT_SERIAL_CONSISTENCY)
       , request_timeout_ms_(request_timeout_ms)
-      , timestamp_(CASS_INT64_MIN) {}
+      , timestamp_(CASS_INT64_MIN)
+      , is_tracing_sampled_(false)
+      , is_continuous_paging_(false) {}
 
   void set_prepared_metadata(const PreparedMetadata::Entry::Ptr& entry);
 
@@ -108,6 +125,42 @@ public:
     return prepared_metadata_entry_;
   }
 
+  // The paging state of a prefetched page. This overrides the statement's
+  // paging state when it's not empty.
+  const String& paging_state() const { return paging_state_; }
+
+  void set_paging_state(const String& paging_state) { paging_state_ = paging_state; }
+
+  // Whether the request was sampled for tracing by its execution profile. The
+  // request is traced even if tracing isn't enabled on its statement.
+  bool is_tracing_sampled() const { return is_tracing_sampled_; }
+
+  void set_tracing_sampled(bool is_tracing_sampled) { is_tracing_sampled_ = is_tracing_sampled; }
+
+  // The keyspace encoded in the request's frame when the protocol supports a
+  // per-request keyspace: the statement's keyspace or the session's keyspace.
+  const String& keyspace() const {
+    if (!request()->keyspace().empty()) {
+      return request()->keyspace();
+    }
+    return keyspace_;
+  }
+
+  void set_keyspace(const String& keyspace) { keyspace_ = keyspace; }
+
+  // Whether the request's pages are streamed by the coordinator using DSE
+  // continuous paging.
+  bool is_continuous_paging() const { return is_continuous_paging_; }
+
+  const ContinuousPagingOptions& continuous_paging_options() const {
+    return continuous_paging_options_;
+  }
+
+  void set_continuous_paging_options(const ContinuousPagingOptions& options) {
+    is_continuous_paging_ = true;
+    continuous_paging_options_ = options;
+  }
+
 private:
   Request::ConstPtr request_;
   CassConsistency consistency_;
@@ -116,6 +169,11 @@ private:
   int64_t timestamp_;
   RetryPolicy::Ptr retry_policy_;
   PreparedMetadata::Entry::Ptr prepared_metadata_entry_;
+  String paging_state_;
+  bool is_tracing_sampled_;
+  String keyspace_;
+  bool is_continuous_paging_;
+  ContinuousPagingOptions continuous_paging_options_;
 };
 
 class RequestCallback
@@ -135,14 +193,25 @@ public:
 
   RequestCallback(const RequestWrapper& wrapper)
       : wrapper_(wrapper)
+      , compressor_(NULL)
+      , compression_threshold_(0)
       , stream_(-1)
       , state_(REQUEST_STATE_NEW)
-      , retry_consistency_(CASS_CONSISTENCY_UNKNOWN) {}
+      , retry_consistency_(CASS_CONSISTENCY_UNKNOWN)
+      , record_stage_times_(false)
+      , write_start_ns_(0)
+      , write_end_ns_(0)
+      , read_ns_(0) {}
 
   virtual ~RequestCallback() {}
 
   void notify_write(Connection* connection, int stream);
 
+  // Called when the request couldn't be written to its connection. An
+  // idempotent request is retried on the next host, like the requests of a
+  // connection that's closed, otherwise it fails with a write error.
+  void on_write_error();
+
 public:
   // Called to retry a request on a different connection
   virtual void on_retry_current_host() = 0;
@@ -157,11 +226,27 @@ public:
   virtual void on_set(ResponseMessage* response) = 0;
   virtual void on_error(CassError code, const String& message) = 0;
 
+  // Called for each response of a request that has more than one response
+  // (DSE continuous paging) until its last response. The request keeps its
+  // stream until then. Returns false if the response is the last response,
+  // which finishes the request using on_set().
+  virtual bool on_partial_response(ResponseMessage* response) { return false; }
+
+  // Called each time more of a RESULT response's body is received until the
+  // whole body has been received (used to stream the rows of large pages).
+  virtual void on_partial_body(const ResponseMessage* response) {}
+
 public:
   const Request* request() const { return wrapper_.request().get(); }
 
   bool skip_metadata() const;
 
+  // The prepared result whose metadata is used for the rows of an execute
+  // request that skips its metadata. This is the cached entry's result, which
+  // is kept up to date when the metadata changes, otherwise it's the result
+  // returned when the statement was prepared. NULL for other requests.
+  const ResultResponse* prepared_result() const;
+
   CassConsistency consistency() {
     // The retry consistency takes the highest priority
     if (retry_consistency_ != CASS_CONSISTENCY_UNKNOWN) {
@@ -182,6 +267,16 @@ public:
     return wrapper_.prepared_metadata_entry();
   }
 
+  const String& paging_state() const { return wrapper_.paging_state(); }
+
+  const String& keyspace() const { return wrapper_.keyspace(); }
+
+  bool is_continuous_paging() const { return wrapper_.is_continuous_paging(); }
+
+  const ContinuousPagingOptions& continuous_paging_options() const {
+    return wrapper_.continuous_paging_options();
+  }
+
   void set_retry_consistency(CassConsistency cl) { retry_consistency_ = cl; }
 
   int stream() const { return stream_; }
@@ -197,17 +292,38 @@ public:
     read_before_write_response_.reset(response);
   }
 
+  /**
+   * Record the times of the state changes: when the request is written to a
+   * connection, when the socket write completes and when the response is
+   * read. This is disabled by default so the hot path doesn't read the clock.
+   *
+   * @param enabled
+   */
+  void set_record_stage_times(bool enabled) { record_stage_times_ = enabled; }
+
+  uint64_t write_start_ns() const { return write_start_ns_; }
+  uint64_t write_end_ns() const { return write_end_ns_; }
+  uint64_t read_ns() const { return read_ns_; }
+
 private:
   virtual int32_t encode(BufferVec* bufs);
   virtual void on_close();
 
+  void record_stage_time(State next_state);
+
 private:
   const RequestWrapper wrapper_;
   ProtocolVersion protocol_version_;
+  Compressor* compressor_;
+  size_t compression_threshold_;
   int stream_;
   State state_;
   CassConsistency retry_consistency_;
   ScopedPtr<ResponseMessage> read_before_write_response_;
+  bool record_stage_times_;
+  uint64_t write_start_ns_;
+  uint64_t write_end_ns_;
+  uint64_t read_ns_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(RequestCallback);
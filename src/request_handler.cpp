@@ -20,8 +20,10 @@
 #include "connection.hpp"
 #include "connection_pool_manager.hpp"
 #include "constants.hpp"
+#include "continuous_paging.hpp"
 #include "error_response.hpp"
 #include "execute_request.hpp"
+#include "get_time.hpp"
 #include "metrics.hpp"
 #include "prepare_request.hpp"
 #include "protocol.hpp"
@@ -53,16 +55,18 @@ static String to_hex(const String& byte_id) {
 class SingleHostQueryPlan : public QueryPlan {
 public:
   SingleHostQueryPlan(const Address& address)
-      : host_(new Host(address)) {}
+      : host_(new Host(address))
+      , is_done_(false) {}
 
-  virtual Host::Ptr compute_next() {
-    Host::Ptr temp = host_;
-    host_.reset(); // Only return the host once
-    return temp;
+  virtual const Host::Ptr& compute_next() {
+    if (is_done_) return NO_HOST;
+    is_done_ = true; // Only return the host once
+    return host_;
   }
 
 private:
   Host::Ptr host_;
+  bool is_done_;
 };
 
 class PrepareCallback : public SimpleRequestCallback {
@@ -151,21 +155,102 @@ public:
     return false;
   }
 
+  virtual void on_next_page(const RequestHandler::Ptr& request_handler) {}
+
+  virtual void on_request_sent(const Host::Ptr& host) {}
+
+  virtual void on_host_unprepared(const Host::Ptr& host) {}
+
   virtual void on_done() {}
 };
 
 static NopRequestListener nop_request_listener__;
 
+ResponseFuture::~ResponseFuture() {}
+
+bool ResponseFuture::set_next_page(const Ptr& next_page,
+                                   const RequestHandler::Ptr& request_handler) {
+  ScopedMutex lock(mutex());
+  next_page->is_page_taken_ = false;
+  next_page_ = next_page;
+  if (is_page_taken_) {
+    return true;
+  }
+  next_page_request_handler_ = request_handler;
+  return false;
+}
+
+ResponseFuture::Ptr ResponseFuture::take_next_page(RequestHandler::Ptr* request_handler) {
+  internal_wait();
+  Ptr next_page;
+  {
+    ScopedMutex lock(mutex());
+    next_page = next_page_;
+    next_page_.reset();
+  }
+  if (next_page) {
+    ScopedMutex lock(next_page->mutex());
+    next_page->is_page_taken_ = true;
+    *request_handler = next_page->next_page_request_handler_;
+    next_page->next_page_request_handler_.reset();
+  }
+  return next_page;
+}
+
+Future::Ptr ResponseFuture::tracing_data_future() {
+  internal_wait();
+  if (tracing_data_future_) {
+    return tracing_data_future_;
+  }
+  if (!response_ || !response_->has_tracing_id()) {
+    return Future::Ptr();
+  }
+  Future::Ptr future(new Future(FUTURE_TYPE_GENERIC));
+  future->set();
+  return future;
+}
+
+// Convert a request's deadline, in milliseconds since the Unix epoch, to the
+// monotonic clock used for the request's timings.
+static uint64_t deadline_to_hrtime(uint64_t deadline_ms, uint64_t now_ns) {
+  if (deadline_ms == 0) return 0;
+  uint64_t now_ms = get_time_since_epoch_ms();
+  if (deadline_ms <= now_ms) return now_ns; // Already expired
+  return now_ns + (deadline_ms - now_ms) * NANOSECONDS_PER_MILLISECOND;
+}
+
 RequestHandler::RequestHandler(const Request::ConstPtr& request, const ResponseFuture::Ptr& future,
                                Metrics* metrics)
     : wrapper_(request)
     , future_(future)
     , is_done_(false)
     , running_executions_(0)
+    , next_skipped_host_(0)
+    , timer_wheel_(NULL)
     , start_time_ns_(uv_hrtime())
+    , deadline_ns_(deadline_to_hrtime(request->deadline_ms(), start_time_ns_))
     , listener_(&nop_request_listener__)
     , manager_(NULL)
-    , metrics_(metrics) {}
+    , connection_selection_(CASS_DEFAULT_CONNECTION_SELECTION)
+    , is_low_priority_(false)
+    , is_prepared_request_(request->opcode() == CQL_OPCODE_EXECUTE ||
+                           request->opcode() == CQL_OPCODE_BATCH)
+    , reserved_streams_(0)
+    , profile_latencies_(NULL)
+    , metrics_(metrics)
+    , stage_latencies_(metrics ? metrics->stage_latencies.get() : NULL)
+    , result_cache_ttl_ms_(0)
+    , retry_count_(0)
+    , speculative_execution_count_(0)
+    , queue_time_ns_(0)
+    , write_time_ns_(0)
+    , server_time_ns_(0)
+    , trace_request_id_(0)
+    , trace_span_(NULL)
+    , has_continuous_pages_(false)
+    , row_callback_(NULL)
+    , row_callback_data_(NULL)
+    , streamed_row_count_(0) {}
 
 RequestHandler::~RequestHandler() {
   if (Logger::log_level() >= CASS_LOG_TRACE) {
@@ -183,64 +268,259 @@ RequestHandler::~RequestHandler() {
     }
     LOG_TRACE("Speculative execution attempts: [%s]", ss.str().c_str());
   }
+
+  // Don't leak the request's slot if it was never completed
+  if (!is_done_ && inflight_limiter_) {
+    inflight_limiter_->release();
+  }
+}
+
+void RequestHandler::set_continuous_paging(const ContinuousPaging::Ptr& continuous_paging) {
+  continuous_paging_ = continuous_paging;
+  wrapper_.set_continuous_paging_options(continuous_paging->options());
 }
 
 void RequestHandler::set_prepared_metadata(const PreparedMetadata::Entry::Ptr& entry) {
   wrapper_.set_prepared_metadata(entry);
 }
 
+void RequestHandler::set_request_tracer(const RequestTracer::Ptr& tracer) {
+  request_tracer_ = tracer;
+  if (request_tracer_) {
+    trace_request_id_ = request_tracer_->next_request_id();
+    trace(CASS_REQUEST_TRACE_EVENT_START);
+  }
+}
+
 void RequestHandler::init(const ExecutionProfile& profile, ConnectionPoolManager* manager,
                           const TokenMap* token_map, TimestampGenerator* timestamp_generator,
                           RequestListener* listener) {
   manager_ = manager;
+  connection_selection_ = profile.connection_selection();
+  profile_latencies_ = profile.latency_histogram();
   listener_ = listener ? listener : &nop_request_listener__;
   wrapper_.init(profile, timestamp_generator);
 
+  if (retry_budget_) {
+    retry_budget_->deposit();
+  }
+
   // Attempt to use the statement's keyspace first then if not set then use the session's keyspace
-  const String& keyspace(!request()->keyspace().empty() ? request()->keyspace()
-                                                        : manager_->keyspace());
+  keyspace_ = !request()->interned_keyspace().empty() ? request()->interned_keyspace()
+                                                      : manager_->interned_keyspace();
+  const String& keyspace(keyspace_.str());
+  // Protocols that support a per-request keyspace send it with the request
+  // instead of setting it on the connection using "USE <keyspace>"
+  wrapper_.set_keyspace(keyspace);
 
   // If a specific host is set then bypass the load balancing policy and use a
   // specialized single host query plan.
   if (request()->host()) {
-    query_plan_.reset(new SingleHostQueryPlan(*request()->host()));
+    query_plan_.reset(new (this) SingleHostQueryPlan(*request()->host()));
   } else {
     query_plan_.reset(profile.load_balancing_policy()->new_query_plan(keyspace, this, token_map));
   }
 
   execution_plan_.reset(
       profile.speculative_execution_policy()->new_plan(keyspace, wrapper_.request().get()));
+
+  if (request()->opcode() == CQL_OPCODE_QUERY || request()->opcode() == CQL_OPCODE_EXECUTE) {
+    const Statement* statement = static_cast<const Statement*>(request());
+    row_callback_ = statement->row_callback();
+    row_callback_data_ = statement->row_callback_data();
+  }
 }
 
 void RequestHandler::execute() {
-  RequestExecution::Ptr request_execution(new RequestExecution(this));
+  RequestExecution::Ptr request_execution(new (arena_.get()) RequestExecution(this));
+  executions_.push_back(request_execution.get());
   running_executions_++;
   internal_retry(request_execution.get());
 }
 
 void RequestHandler::retry(RequestExecution* request_execution, Protected) {
+  retry_count_++;
+  if (request_tracer_) {
+    trace(CASS_REQUEST_TRACE_EVENT_RETRY, request_execution->current_host());
+  }
   internal_retry(request_execution);
 }
 
+bool RequestHandler::acquire_retry(Protected) {
+  if (retry_budget_ && !retry_budget_->try_withdraw()) {
+    if (metrics_) {
+      metrics_->denied_retries.inc();
+    }
+    return false;
+  }
+  if (metrics_) {
+    metrics_->retries.inc();
+  }
+  return true;
+}
+
 void RequestHandler::start_request(uv_loop_t* loop, Protected) {
-  if (!timer_.is_running()) {
+  if (!timer_.is_running() && !wheel_timer_.is_running()) {
     uint64_t request_timeout_ms = wrapper_.request_timeout_ms();
-    if (request_timeout_ms > 0) { // 0 means no timeout
+    if (deadline_ns_ > 0) {
+      // Don't wait for a response past the request's deadline
+      uint64_t now = uv_hrtime();
+      uint64_t remaining_ms =
+          deadline_ns_ > now ? (deadline_ns_ - now) / NANOSECONDS_PER_MILLISECOND + 1 : 1;
+      if (request_timeout_ms == 0 || remaining_ms < request_timeout_ms) {
+        request_timeout_ms = remaining_ms;
+      }
+    }
+    if (request_timeout_ms == 0) { // 0 means no timeout
+      return;
+    }
+    if (timer_wheel_) {
+      wheel_timer_.start(timer_wheel_, request_timeout_ms,
+                         bind_callback(&RequestHandler::on_wheel_timeout, this));
+    } else {
       timer_.start(loop, request_timeout_ms, bind_callback(&RequestHandler::on_timeout, this));
     }
   }
 }
 
-Host::Ptr RequestHandler::next_host(Protected) { return query_plan_->compute_next(); }
+void RequestHandler::add_continuous_page(Connection* connection, int stream, ResultResponse* page,
+                                         Protected) {
+  // The timeout only bounds the wait for the first page. Later pages are
+  // throttled by the application taking them (page credits) so the time
+  // between them isn't bounded. A coordinator that stops responding is
+  // detected by the connection's heartbeats.
+  stop_timer();
+  has_continuous_pages_ = true;
+  continuous_paging_->add_page(connection, stream, ResultResponse::Ptr(page));
+}
+
+void RequestHandler::stream_row(const Row& row, int32_t index, Protected) {
+  // Another execution might have already delivered the row
+  if (row_callback_ == NULL || index != streamed_row_count_) return;
+  row_callback_(CassRow::to(&row), row_callback_data_);
+  streamed_row_count_++;
+}
+
+void RequestHandler::stream_rows(const ResultResponse* result, Protected) {
+  if (row_callback_ == NULL || !result->metadata() ||
+      streamed_row_count_ >= result->row_count()) {
+    return;
+  }
+
+  Decoder decoder(result->rows().data(), result->rows().size(), result->protocol_version());
+  Row row(result);
+  for (int32_t i = 0; i < result->row_count(); ++i) {
+    if (!decode_row(decoder, result, row.values)) return;
+    if (i >= streamed_row_count_) {
+      row_callback_(CassRow::to(&row), row_callback_data_);
+    }
+  }
+  streamed_row_count_ = result->row_count();
+}
+
+const Host::Ptr& RequestHandler::next_host(Protected) {
+  uint64_t now = 0;
+  while (true) {
+    const Host::Ptr& host = query_plan_->compute_next();
+    if (!host) {
+      // Only the skipped hosts (e.g. with open circuits) are left. Use them,
+      // in the query plan's order, instead of failing the request.
+      if (next_skipped_host_ < skipped_hosts_.size()) {
+        return skipped_hosts_[next_skipped_host_++];
+      }
+      return host;
+    }
+    // Skip the hosts that have no open connections right now. Their pools
+    // might not have been reported down yet, but a request can't be written
+    // to them anyway. A remote host that's connected on first use starts
+    // connecting for the next requests.
+    if (manager_ && !manager_->has_connections(host->address())) {
+      manager_->connect_lazy(host->address());
+      continue;
+    }
+    if (!circuit_breaker_ && !reconnect_throttle_ && !concurrency_limiter_ &&
+        !is_prepared_request_) {
+      return host;
+    }
+    if (now == 0) now = get_time_monotonic_coarse_ns();
+    // Check the warm-up and concurrency limit first so that a half-open
+    // circuit's probe isn't used up by a host that's then skipped. Prepared
+    // statements avoid hosts that are preparing their statements again after
+    // losing them.
+    if ((!is_prepared_request_ || !host->is_repreparing(now)) &&
+        (!concurrency_limiter_ || concurrency_limiter_->try_acquire(host.get())) &&
+        (!reconnect_throttle_ || reconnect_throttle_->try_admit(host.get(), now)) &&
+        (!circuit_breaker_ || circuit_breaker_->try_acquire(host.get(), now))) {
+      return host;
+    }
+    skipped_hosts_.push_back(host);
+  }
+}
+
+void RequestHandler::record_host_success(const Host::Ptr& host, uint64_t latency_ns, Protected) {
+  if (circuit_breaker_) {
+    circuit_breaker_->record_success(host.get());
+  }
+  if (concurrency_limiter_) {
+    concurrency_limiter_->record_success(host.get(), latency_ns);
+  }
+}
+
+void RequestHandler::record_host_failure(const Host::Ptr& host, Protected) {
+  if (circuit_breaker_) {
+    circuit_breaker_->record_failure(host.get(), get_time_monotonic_coarse_ns());
+  }
+  if (concurrency_limiter_) {
+    concurrency_limiter_->record_failure(host.get());
+  }
+}
 
 int64_t RequestHandler::next_execution(const Host::Ptr& current_host, Protected) {
   return execution_plan_->next_execution(current_host);
 }
 
+bool RequestHandler::start_execution(Protected) {
+  if (!execution_plan_->start_execution()) return false;
+  speculative_execution_count_++;
+  if (request_tracer_) {
+    trace(CASS_REQUEST_TRACE_EVENT_SPECULATIVE_EXECUTION);
+  }
+  return true;
+}
+
+void RequestHandler::record_latency(uint64_t latency_ns, Protected) {
+  execution_plan_->record_latency(latency_ns);
+}
+
+void RequestHandler::remove_execution(RequestExecution* request_execution, Protected) {
+  for (SmallVector<RequestExecution*, 2>::iterator it = executions_.begin(),
+                                                   end = executions_.end();
+       it != end; ++it) {
+    if (*it == request_execution) {
+      executions_.erase(it);
+      break;
+    }
+  }
+}
+
 void RequestHandler::add_attempted_address(const Address& address, Protected) {
   future_->add_attempted_address(address);
 }
 
+void RequestHandler::notify_request_sent(const Host::Ptr& host, Protected) {
+  if (slow_request_log_) {
+    attempted_hosts_.push_back(host->address());
+  }
+  if (request_tracer_) {
+    trace(CASS_REQUEST_TRACE_EVENT_ATTEMPT, host);
+  }
+  listener_->on_request_sent(host);
+}
+
+void RequestHandler::notify_host_unprepared(const Host::Ptr& host, Protected) {
+  listener_->on_host_unprepared(host);
+}
+
 void RequestHandler::notify_result_metadata_changed(const String& prepared_id, const String& query,
                                                     const String& keyspace,
                                                     const String& result_metadata_id,
@@ -272,12 +552,32 @@ bool RequestHandler::prepare_all(const Host::Ptr& current_host, const Response::
 }
 
 void RequestHandler::set_response(const Host::Ptr& host, const Response::Ptr& response) {
+  if (!is_done_) {
+    maybe_prefetch_next_page(response);
+  }
   stop_request();
   running_executions_--;
 
+  uint64_t set_start_ns = stage_latencies_ ? uv_hrtime() : 0;
   if (future_->set_response(host->address(), response)) {
+    if (stage_latencies_) {
+      // Setting the response runs the future's callback on this thread
+      stage_latencies_->callback.record_value((uv_hrtime() - set_start_ns) / 1000);
+    }
+    cancel_executions();
+    on_finish(host, CASS_OK);
+    if (result_cache_ && response->opcode() == CQL_OPCODE_RESULT) {
+      ResultResponse::Ptr result(static_cast<ResultResponse*>(response.get()));
+      if (result->kind() == CASS_RESULT_KIND_ROWS && !result->has_more_pages()) {
+        result_cache_->put(result_cache_key_, result, result_cache_ttl_ms_);
+      }
+    }
     if (metrics_) {
-      metrics_->record_request(uv_hrtime() - start_time_ns_);
+      uint64_t latency_ns = uv_hrtime() - start_time_ns_;
+      metrics_->record_request(latency_ns);
+      if (profile_latencies_) {
+        profile_latencies_->record_value(latency_ns / 1000);
+      }
     }
   } else {
     // This request is a speculative execution for whom we already processed
@@ -297,7 +597,10 @@ void RequestHandler::set_error(CassError code, const String& message) {
   stop_request();
   bool skip = (code == CASS_ERROR_LIB_NO_HOSTS_AVAILABLE && --running_executions_ > 0);
   if (!skip) {
-    future_->set_error(code, message);
+    if (future_->set_error(code, message)) {
+      on_finish(Host::Ptr(), code);
+    }
+    cancel_executions();
   }
 }
 
@@ -306,7 +609,10 @@ void RequestHandler::set_error(const Host::Ptr& host, CassError code, const Stri
   bool skip = (code == CASS_ERROR_LIB_NO_HOSTS_AVAILABLE && --running_executions_ > 0);
   if (!skip) {
     if (host) {
-      future_->set_error_with_address(host->address(), code, message);
+      if (future_->set_error_with_address(host->address(), code, message)) {
+        on_finish(host, code);
+      }
+      cancel_executions();
     } else {
       set_error(code, message);
     }
@@ -321,28 +627,114 @@ void RequestHandler::set_error_with_error_response(const Host::Ptr& host,
                                                    const String& message) {
   stop_request();
   running_executions_--;
-  future_->set_error_with_response(host->address(), error, code, message);
+  if (future_->set_error_with_response(host->address(), error, code, message)) {
+    on_finish(host, code);
+  }
+  cancel_executions();
   if (Logger::log_level() >= CASS_LOG_TRACE) {
     request_tries_.push_back(RequestTry(host->address(), code));
   }
 }
 
-void RequestHandler::stop_timer() { timer_.stop(); }
+void RequestHandler::stop_timer() {
+  timer_.stop();
+  wheel_timer_.stop();
+}
+
+void RequestHandler::on_wheel_timeout(WheelTimer* timer) { on_timeout(NULL); }
 
 void RequestHandler::on_timeout(Timer* timer) {
   if (metrics_) {
     metrics_->request_timeouts.inc();
   }
+  for (SmallVector<RequestExecution*, 2>::iterator it = executions_.begin(),
+                                                   end = executions_.end();
+       it != end; ++it) {
+    (*it)->on_request_timeout();
+  }
   set_error(CASS_ERROR_LIB_REQUEST_TIMED_OUT, "Request timed out");
   LOG_DEBUG("Request timed out");
 }
 
+void RequestHandler::maybe_prefetch_next_page(const Response::Ptr& response) {
+  int8_t opcode = request()->opcode();
+  if ((opcode != CQL_OPCODE_QUERY && opcode != CQL_OPCODE_EXECUTE) ||
+      !static_cast<const Statement*>(request())->paging_prefetch() ||
+      response->opcode() != CQL_OPCODE_RESULT) {
+    return;
+  }
+
+  const ResultResponse* result = static_cast<const ResultResponse*>(response.get());
+  if (result->kind() != CASS_RESULT_KIND_ROWS || !result->has_more_pages()) {
+    return;
+  }
+
+  ResponseFuture::Ptr next_page(new ResponseFuture());
+  RequestHandler::Ptr request_handler(new RequestHandler(wrapper_.request(), next_page, metrics_));
+  request_handler->set_prepared_metadata(wrapper_.prepared_metadata_entry());
+  request_handler->wrapper_.set_paging_state(result->paging_state().to_string());
+
+  if (future_->set_next_page(next_page, request_handler)) {
+    listener_->on_next_page(request_handler);
+  }
+}
+
 void RequestHandler::stop_request() {
   if (!is_done_) {
     listener_->on_done();
     is_done_ = true;
+    if (inflight_limiter_) {
+      inflight_limiter_->release();
+    }
   }
-  timer_.stop();
+  stop_timer();
+}
+
+void RequestHandler::cancel_executions() {
+  for (SmallVector<RequestExecution*, 2>::iterator it = executions_.begin(),
+                                                   end = executions_.end();
+       it != end; ++it) {
+    (*it)->cancel();
+  }
+}
+
+void RequestHandler::on_finish(const Host::Ptr& host, CassError code) {
+  maybe_log_slow_request(host, code);
+  if (request_tracer_) {
+    trace(CASS_REQUEST_TRACE_EVENT_FINISH, host, code);
+  }
+}
+
+void RequestHandler::trace(CassRequestTraceEventType type, const Host::Ptr& host,
+                           CassError code) {
+  RequestTraceEvent event(type, trace_request_id_, request(), &trace_span_);
+  if (host) {
+    event.host = &host->address();
+  }
+  event.error_code = code;
+  request_tracer_->trace(&event);
+}
+
+void RequestHandler::maybe_log_slow_request(const Host::Ptr& host, CassError code) {
+  if (!slow_request_log_) return;
+
+  uint64_t latency_ns = uv_hrtime() - start_time_ns_;
+  if (latency_ns < slow_request_log_->threshold_ns()) return;
+
+  SlowRequest* slow_request = new SlowRequest();
+  slow_request->query = SlowRequest::describe(request());
+  if (host) {
+    slow_request->coordinator = host->address();
+    slow_request->write_time_us = write_time_ns_ / 1000;
+    slow_request->server_time_us = server_time_ns_ / 1000;
+  }
+  slow_request->attempted_hosts = attempted_hosts_;
+  slow_request->error_code = code;
+  slow_request->latency_us = latency_ns / 1000;
+  slow_request->queue_time_us = queue_time_ns_ / 1000;
+  slow_request->retries = retry_count_;
+  slow_request->speculative_executions = speculative_execution_count_;
+  slow_request_log_->add(slow_request);
 }
 
 void RequestHandler::internal_retry(RequestExecution* request_execution) {
@@ -355,12 +747,32 @@ void RequestHandler::internal_retry(RequestExecution* request_execution) {
     return;
   }
 
+  // Discard initial executions, retries and speculative executions that can no
+  // longer complete before the request's deadline instead of writing them.
+  if (deadline_ns_ > 0 && uv_hrtime() >= deadline_ns_) {
+    LOG_DEBUG("Request (%p) exceeded its deadline before it was written",
+              static_cast<void*>(this));
+    on_timeout(NULL);
+    return;
+  }
+
   bool is_done = false;
   while (!is_done && request_execution->current_host()) {
     PooledConnection::Ptr connection =
-        manager_->find_least_busy(request_execution->current_host()->address());
+        manager_->find_least_busy(request_execution->current_host()->address(),
+                                  connection_selection_, request());
     if (connection) {
-      int32_t result = connection->write(request_execution);
+      int32_t result;
+      if (is_low_priority_ && connection->available_streams() <= reserved_streams_) {
+        // Low priority requests leave the reserved stream IDs to normal
+        // priority requests.
+        result = Request::REQUEST_ERROR_NO_AVAILABLE_STREAM_IDS;
+      } else if (connection->is_write_queue_full()) {
+        // Don't queue more writes behind a host that isn't keeping up.
+        result = Request::REQUEST_ERROR_WRITE_QUEUE_FULL;
+      } else {
+        result = connection->write(request_execution);
+      }
 
       if (result > 0) {
         is_done = true;
@@ -378,6 +790,7 @@ void RequestHandler::internal_retry(RequestExecution* request_execution) {
             break;
 
           case Request::REQUEST_ERROR_NO_AVAILABLE_STREAM_IDS:
+          case Request::REQUEST_ERROR_WRITE_QUEUE_FULL:
             // Retry with next host
             request_execution->next_host();
             break;
@@ -413,14 +826,51 @@ RequestExecution::RequestExecution(RequestHandler* request_handler)
     , request_handler_(request_handler)
     , current_host_(request_handler->next_host(RequestHandler::Protected()))
     , num_retries_(0)
-    , start_time_ns_(uv_hrtime()) {}
+    , start_time_ns_(uv_hrtime())
+    , is_canceled_(false)
+    , is_timed_out_(false) {
+  set_record_stage_times(request_handler->records_stage_times());
+}
+
+RequestExecution::~RequestExecution() {
+  request_handler_->remove_execution(this, RequestHandler::Protected());
+}
+
+void RequestExecution::cancel() {
+  is_canceled_ = true;
+  schedule_timer_.stop();
+  schedule_wheel_timer_.stop();
+}
 
-void RequestExecution::on_execute_next(Timer* timer) { request_handler_->execute(); }
+void RequestExecution::on_request_timeout() {
+  if (state() == REQUEST_STATE_WRITING || state() == REQUEST_STATE_READING) {
+    is_timed_out_ = true;
+    current_host_->update_latency(uv_hrtime() - start_time_ns_);
+    request_handler_->record_host_failure(current_host_, RequestHandler::Protected());
+  }
+}
+
+void RequestExecution::on_execute_next(Timer* timer) {
+  if (request_handler_->start_execution(RequestHandler::Protected())) {
+    request_handler_->execute();
+  }
+}
+
+void RequestExecution::on_wheel_execute_next(WheelTimer* timer) { on_execute_next(NULL); }
 
-void RequestExecution::on_retry_current_host() { retry_current_host(); }
+void RequestExecution::on_retry_current_host() {
+  if (is_canceled_) return;
+  retry_current_host();
+}
 
 void RequestExecution::on_retry_next_host() {
   if (current_host_) current_host_->decrement_inflight_requests();
+  if (is_canceled_) return;
+  if (request_handler_->has_continuous_pages()) {
+    // The pages that were already added would be added again
+    set_error(CASS_ERROR_LIB_REQUEST_TIMED_OUT, "Request timed out");
+    return;
+  }
   retry_next_host();
 }
 
@@ -440,17 +890,26 @@ void RequestExecution::on_write(Connection* connection) {
   assert(current_host_ && "Tried to start on a non-existent host");
   current_host_->increment_inflight_requests();
   connection_ = connection;
+  row_stream_decoder_.reset(); // The rows of a new response are streamed from the start
   if (request()->record_attempted_addresses()) {
     request_handler_->add_attempted_address(current_host_->address(), RequestHandler::Protected());
   }
   request_handler_->start_request(connection->loop(), RequestHandler::Protected());
-  if (request()->is_idempotent()) {
+  request_handler_->notify_request_sent(current_host_, RequestHandler::Protected());
+  // A speculative execution of a continuous paging request would stream the
+  // same pages again
+  if (request()->is_idempotent() && !is_continuous_paging()) {
     int64_t timeout = request_handler_->next_execution(current_host_, RequestHandler::Protected());
     if (timeout == 0) {
-      request_handler_->execute();
+      on_execute_next(NULL);
     } else if (timeout > 0) {
-      schedule_timer_.start(connection->loop(), timeout,
-                            bind_callback(&RequestExecution::on_execute_next, this));
+      if (request_handler_->timer_wheel()) {
+        schedule_wheel_timer_.start(request_handler_->timer_wheel(), timeout,
+                                    bind_callback(&RequestExecution::on_wheel_execute_next, this));
+      } else {
+        schedule_timer_.start(connection->loop(), timeout,
+                              bind_callback(&RequestExecution::on_execute_next, this));
+      }
     }
   }
 }
@@ -462,6 +921,40 @@ void RequestExecution::on_set(ResponseMessage* response) {
   current_host_->decrement_inflight_requests();
   Connection* connection = connection_;
 
+  if (request_handler_->records_stage_times()) {
+    uint64_t write_time_ns = write_end_ns() - write_start_ns();
+    // The response can be read before the write callback runs
+    uint64_t server_time_ns = read_ns() > write_end_ns() ? read_ns() - write_end_ns() : 0;
+    Metrics::StageLatencies* stage_latencies = request_handler_->stage_latencies();
+    if (stage_latencies) {
+      stage_latencies->write.record_value(write_time_ns / 1000);
+      stage_latencies->server.record_value(server_time_ns / 1000);
+    }
+    if (!is_canceled_) {
+      request_handler_->record_execution_times(write_time_ns, server_time_ns,
+                                               RequestHandler::Protected());
+    }
+  }
+
+  if (is_canceled_) {
+    // Another execution already finished the request so the response is
+    // dropped without processing it. Results are still counted as aborted
+    // speculative executions and their latencies are still recorded.
+    LOG_TRACE("Dropping response for canceled execution (%p) on host %s",
+              static_cast<void*>(this), current_host_->address_string().c_str());
+    if (response->opcode() == CQL_OPCODE_RESULT) {
+      uint64_t latency_ns = uv_hrtime() - start_time_ns_;
+      if (!is_timed_out_) { // Already recorded when the request timed out
+        current_host_->update_latency(latency_ns);
+      }
+      request_handler_->record_latency(latency_ns, RequestHandler::Protected());
+      request_handler_->record_host_success(current_host_, latency_ns,
+                                            RequestHandler::Protected());
+      set_response(response->response_body());
+    }
+    return;
+  }
+
   switch (response->opcode()) {
     case CQL_OPCODE_RESULT:
       on_result_response(connection, response);
@@ -478,9 +971,61 @@ void RequestExecution::on_set(ResponseMessage* response) {
 
 void RequestExecution::on_error(CassError code, const String& message) {
   if (current_host_) current_host_->decrement_inflight_requests();
+  if (is_canceled_) return;
   set_error(code, message);
 }
 
+bool RequestExecution::on_partial_response(ResponseMessage* response) {
+  if (!is_continuous_paging() || response->opcode() != CQL_OPCODE_RESULT) return false;
+
+  ResultResponse* result = static_cast<ResultResponse*>(response->response_body().get());
+  if (result->kind() != CASS_RESULT_KIND_ROWS || !result->is_continuous_page() ||
+      result->is_last_continuous_page()) {
+    return false;
+  }
+
+  // The pages of a request that already failed (e.g. timed out) are dropped
+  // until its last response releases the stream
+  if (!is_canceled_) {
+    set_continuous_page_metadata(result);
+    request_handler_->add_continuous_page(connection_, stream(), result,
+                                          RequestHandler::Protected());
+  }
+  return true;
+}
+
+void RequestExecution::on_partial_body(const ResponseMessage* response) {
+  if (is_canceled_ || is_continuous_paging() || !request_handler_->has_row_callback()) return;
+
+  if (!row_stream_decoder_) {
+    row_stream_decoder_.reset(new RowStreamDecoder());
+  }
+
+  // Bound statements that skip their metadata use the prepared metadata
+  ResultMetadata::Ptr metadata;
+  if (request()->opcode() == CQL_OPCODE_EXECUTE && skip_metadata() && prepared_result()) {
+    metadata = prepared_result()->result_metadata();
+  }
+  if (!row_stream_decoder_->update(response, metadata)) return;
+
+  Row row;
+  while (row_stream_decoder_->next_row(&row)) {
+    request_handler_->stream_row(row, row_stream_decoder_->row_index() - 1,
+                                 RequestHandler::Protected());
+  }
+}
+
+void RequestExecution::set_continuous_page_metadata(ResultResponse* result) {
+  if (!result->no_metadata()) {
+    request_handler_->set_continuous_page_metadata(result->metadata(),
+                                                   RequestHandler::Protected());
+  } else if (request_handler_->continuous_page_metadata()) {
+    result->set_metadata(request_handler_->continuous_page_metadata());
+  } else if (prepared_result()) {
+    result->set_metadata(prepared_result()->result_metadata());
+  }
+}
+
 void RequestExecution::notify_result_metadata_changed(const Request* request,
                                                       ResultResponse* result_response) {
   // Attempt to use the per-query keyspace first (v5+/DSEv2+ only) then
@@ -523,14 +1068,23 @@ void RequestExecution::notify_prepared_id_mismatch(const String& expected_id,
 
 void RequestExecution::on_result_response(Connection* connection, ResponseMessage* response) {
   ResultResponse* result = static_cast<ResultResponse*>(response->response_body().get());
+  uint64_t latency_ns = uv_hrtime() - start_time_ns_;
+  request_handler_->record_latency(latency_ns, RequestHandler::Protected());
+  request_handler_->record_host_success(current_host_, latency_ns, RequestHandler::Protected());
+  if (current_host_->latency_histogram()) {
+    // Measurements are in microseconds (like the session's metrics)
+    current_host_->latency_histogram()->record_value(latency_ns / 1000);
+  }
 
   switch (result->kind()) {
     case CASS_RESULT_KIND_ROWS:
-      current_host_->update_latency(uv_hrtime() - start_time_ns_);
+      current_host_->update_latency(latency_ns);
 
       // Execute statements with no metadata get their metadata from
       // result_metadata() returned when the statement was prepared.
-      if (request()->opcode() == CQL_OPCODE_EXECUTE) {
+      if (is_continuous_paging()) {
+        set_continuous_page_metadata(result);
+      } else if (request()->opcode() == CQL_OPCODE_EXECUTE) {
         if (result->no_metadata()) {
           if (!skip_metadata()) {
             // Caused by a race condition in C* 2.1.0
@@ -538,12 +1092,17 @@ void RequestExecution::on_result_response(Connection* connection, ResponseMessag
                      "Expected metadata but no metadata in response (see CASSANDRA-8054)");
             return;
           }
-          result->set_metadata(prepared_metadata_entry()->result()->result_metadata());
+          result->set_metadata(prepared_result()->result_metadata());
         } else if (result->metadata_changed()) {
           notify_result_metadata_changed(request(), result);
         }
       }
 
+      // Deliver the rows that weren't streamed while the page was received
+      if (!is_continuous_paging()) {
+        request_handler_->stream_rows(result, RequestHandler::Protected());
+      }
+
       if (!response->response_body()->has_tracing_id() ||
           !request_handler_->wait_for_tracing_data(current_host(), response->response_body())) {
         set_response(response->response_body());
@@ -581,6 +1140,18 @@ void RequestExecution::on_error_response(Connection* connection, ResponseMessage
 
   RetryPolicy::RetryDecision decision = RetryPolicy::RetryDecision::return_error();
 
+  switch (error->code()) {
+    case CQL_ERROR_READ_TIMEOUT:
+    case CQL_ERROR_WRITE_TIMEOUT:
+    case CQL_ERROR_UNAVAILABLE:
+    case CQL_ERROR_OVERLOADED:
+      request_handler_->record_host_failure(current_host_, RequestHandler::Protected());
+      break;
+
+    default:
+      break;
+  }
+
   switch (error->code()) {
     case CQL_ERROR_READ_TIMEOUT:
       if (retry_policy()) {
@@ -636,6 +1207,21 @@ void RequestExecution::on_error_response(Connection* connection, ResponseMessage
       break;
   }
 
+  // A continuous paging request that failed after pages were added can't be
+  // retried because the pages would be added again
+  if (decision.type() == RetryPolicy::RetryDecision::RETRY &&
+      request_handler_->has_continuous_pages()) {
+    decision = RetryPolicy::RetryDecision::return_error();
+  }
+
+  // Retries decided by the retry policy are limited by the retry budget
+  if (decision.type() == RetryPolicy::RetryDecision::RETRY &&
+      !request_handler_->acquire_retry(RequestHandler::Protected())) {
+    LOG_DEBUG("Retry budget exhausted. Returning the error from host %s instead of retrying",
+              connection->address_string().c_str());
+    decision = RetryPolicy::RetryDecision::return_error();
+  }
+
   // Process retry decision
   switch (decision.type()) {
     case RetryPolicy::RetryDecision::RETURN_ERROR:
@@ -684,6 +1270,11 @@ void RequestExecution::on_error_unprepared(Connection* connection, ErrorResponse
     return;
   }
 
+  // The host has likely lost all of its prepared statements so they're
+  // prepared again in the background while this request's statement is
+  // prepared inline
+  request_handler_->notify_host_unprepared(current_host_, RequestHandler::Protected());
+
   RequestCallback::Ptr callback(new PrepareCallback(query, id, this));
   if (connection->write_and_flush(callback) < 0) {
     // Try to prepare on the same host but on a different connection
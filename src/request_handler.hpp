@@ -17,22 +17,33 @@
 #ifndef DATASTAX_INTERNAL_REQUEST_HANDLER_HPP
 #define DATASTAX_INTERNAL_REQUEST_HANDLER_HPP
 
+#include "arena.hpp"
+#include "circuit_breaker.hpp"
+#include "concurrency_limiter.hpp"
 #include "constants.hpp"
 #include "error_response.hpp"
 #include "future.hpp"
 #include "host.hpp"
+#include "inflight_limiter.hpp"
 #include "load_balancing.hpp"
 #include "metadata.hpp"
 #include "prepare_request.hpp"
+#include "reconnect_throttle.hpp"
 #include "request.hpp"
 #include "request_callback.hpp"
+#include "request_tracer.hpp"
 #include "response.hpp"
+#include "result_cache.hpp"
 #include "result_response.hpp"
 #include "retry_policy.hpp"
+#include "row_stream_decoder.hpp"
+#include "scoped_lock.hpp"
 #include "scoped_ptr.hpp"
+#include "slow_request_log.hpp"
 #include "small_vector.hpp"
 #include "speculative_execution.hpp"
 #include "string.hpp"
+#include "timer_wheel.hpp"
 #include "timestamp_generator.hpp"
 
 #include <uv.h>
@@ -42,8 +53,10 @@ namespace datastax { namespace internal { namespace core {
 class Config;
 class Connection;
 class ConnectionPoolManager;
+class ContinuousPaging;
 class Pool;
 class ExecutionProfile;
+class RequestHandler;
 class Timer;
 class TokenMap;
 
@@ -73,35 +86,38 @@ class ResponseFuture : public Future {
 public:
   typedef SharedRefPtr<ResponseFuture> Ptr;
 
+  ARENA_ALLOCATED()
+
   ResponseFuture()
-      : Future(FUTURE_TYPE_RESPONSE) {}
+      : Future(FUTURE_TYPE_RESPONSE)
+      , is_page_taken_(true) {}
 
   ResponseFuture(const Metadata::SchemaSnapshot& schema_metadata)
       : Future(FUTURE_TYPE_RESPONSE)
-      , schema_metadata(new Metadata::SchemaSnapshot(schema_metadata)) {}
+      , schema_metadata(new Metadata::SchemaSnapshot(schema_metadata))
+      , is_page_taken_(true) {}
+
+  ~ResponseFuture();
 
   bool set_response(Address address, const Response::Ptr& response) {
-    ScopedMutex lock(&mutex_);
-    if (!is_set()) {
+    if (internal_claim()) {
       address_ = address;
       response_ = response;
-      internal_set(lock);
+      internal_set();
       return true;
     }
     return false;
   }
 
   const Response::Ptr& response() {
-    ScopedMutex lock(&mutex_);
-    internal_wait(lock);
+    internal_wait();
     return response_;
   }
 
   bool set_error_with_address(Address address, CassError code, const String& message) {
-    ScopedMutex lock(&mutex_);
-    if (!is_set()) {
+    if (internal_claim()) {
       address_ = address;
-      internal_set_error(code, message, lock);
+      internal_set_error(code, message);
       return true;
     }
     return false;
@@ -109,29 +125,73 @@ public:
 
   bool set_error_with_response(Address address, const Response::Ptr& response, CassError code,
                                const String& message) {
-    ScopedMutex lock(&mutex_);
-    if (!is_set()) {
+    if (internal_claim()) {
       address_ = address;
       response_ = response;
-      internal_set_error(code, message, lock);
+      internal_set_error(code, message);
       return true;
     }
     return false;
   }
 
   const Address& address() {
-    ScopedMutex lock(&mutex_);
-    internal_wait(lock);
+    internal_wait();
     return address_;
   }
 
   // Currently, used for testing only, but it could be exposed in the future.
   AddressVec attempted_addresses() {
-    ScopedMutex lock(&mutex_);
-    internal_wait(lock);
+    internal_wait();
+    ScopedMutex lock(mutex());
     return attempted_addresses_;
   }
 
+  /**
+   * Set the future for the next page. This is called before this page's
+   * response is set.
+   *
+   * @param next_page The future for the next page.
+   * @param request_handler The request for the next page.
+   * @return true if the next page's request should be started now. Otherwise,
+   * this page hasn't been taken by the application yet and the request is
+   * started once it's taken. This bounds prefetching to a single page ahead of
+   * the application.
+   */
+  bool set_next_page(const Ptr& next_page, const SharedRefPtr<RequestHandler>& request_handler);
+
+  /**
+   * Take the future for the next page. This waits for this page and the next
+   * page can only be taken once.
+   *
+   * @param request_handler The request for the page after the next page if it
+   * was deferred until the next page was taken. The caller must start it.
+   * @return The future for the next page or null if there are no more pages
+   * or prefetching wasn't enabled.
+   */
+  Ptr take_next_page(SharedRefPtr<RequestHandler>* request_handler);
+
+  /**
+   * Set the future for the request's tracing data when it's waited for after
+   * the response is set. This is called before the response is set.
+   *
+   * @param future The future for the tracing data. It uses the same callback
+   * executor as this future.
+   */
+  void set_tracing_data_future(const Future::Ptr& future) {
+    future->set_callback_executor(callback_executor());
+    tracing_data_future_ = future;
+  }
+
+  /**
+   * Get the future for the request's tracing data. This waits for the
+   * response.
+   *
+   * @return The future for the tracing data, an already set future if the
+   * tracing data was waited for before the response was set, or null if the
+   * response doesn't have a tracing ID.
+   */
+  Future::Ptr tracing_data_future();
+
   PrepareRequest::ConstPtr prepare_request;
   ScopedPtr<Metadata::SchemaSnapshot> schema_metadata;
 
@@ -139,7 +199,7 @@ private:
   friend class RequestHandler;
 
   void add_attempted_address(const Address& address) {
-    ScopedMutex lock(&mutex_);
+    ScopedMutex lock(mutex());
     attempted_addresses_.push_back(address);
   }
 
@@ -147,6 +207,10 @@ private:
   Address address_;
   Response::Ptr response_;
   AddressVec attempted_addresses_;
+  bool is_page_taken_;
+  Ptr next_page_;
+  SharedRefPtr<RequestHandler> next_page_request_handler_;
+  Future::Ptr tracing_data_future_;
 };
 
 class RequestExecution;
@@ -158,12 +222,180 @@ class RequestHandler : public RefCounted<RequestHandler> {
 public:
   typedef SharedRefPtr<RequestHandler> Ptr;
 
+  ARENA_ALLOCATED()
+
   RequestHandler(const Request::ConstPtr& request, const ResponseFuture::Ptr& future,
                  Metrics* metrics = NULL);
   ~RequestHandler();
 
   void set_prepared_metadata(const PreparedMetadata::Entry::Ptr& entry);
 
+  /**
+   * Set the limiter that holds a slot for this request. The slot is released
+   * when the request is done.
+   *
+   * @param limiter The limiter.
+   */
+  void set_inflight_limiter(const InflightLimiter::Ptr& limiter) { inflight_limiter_ = limiter; }
+
+  /**
+   * Set the arena used to allocate this request's executions.
+   *
+   * @param arena The arena. This can be NULL to allocate from the heap.
+   */
+  void set_arena(Arena* arena) { arena_.reset(arena); }
+
+  /**
+   * Set the budget that limits the retries decided by the retry policy.
+   *
+   * @param budget The budget. This can be NULL to allow all retries.
+   */
+  void set_retry_budget(const RetryBudget::Ptr& budget) { retry_budget_ = budget; }
+
+  /**
+   * Set the circuit breaker that moves failing hosts to the end of this
+   * request's query plan.
+   *
+   * @param circuit_breaker The circuit breaker. This can be NULL to use the
+   * query plan as is.
+   */
+  void set_circuit_breaker(const CircuitBreaker::Ptr& circuit_breaker) {
+    circuit_breaker_ = circuit_breaker;
+  }
+
+  /**
+   * Set the concurrency limiter that moves hosts at their in-flight request
+   * limit to the end of this request's query plan.
+   *
+   * @param concurrency_limiter The concurrency limiter. This can be NULL to
+   * use the query plan as is.
+   */
+  void set_concurrency_limiter(const ConcurrencyLimiter::Ptr& concurrency_limiter) {
+    concurrency_limiter_ = concurrency_limiter;
+  }
+
+  /**
+   * Trace the request even if tracing isn't enabled on its statement. This is
+   * used to sample the requests of execution profiles with a tracing
+   * probability.
+   */
+  void set_tracing_sampled() { wrapper_.set_tracing_sampled(true); }
+
+  /**
+   * Set the future for the request's tracing data when it's waited for after
+   * the response is set.
+   *
+   * @param future The future for the tracing data.
+   */
+  void set_tracing_data_future(const Future::Ptr& future) {
+    future_->set_tracing_data_future(future);
+  }
+
+  /**
+   * Set the reconnect throttle that moves warming up hosts to the end of this
+   * request's query plan.
+   *
+   * @param reconnect_throttle The reconnect throttle. This can be NULL to use
+   * the query plan as is.
+   */
+  void set_reconnect_throttle(const ReconnectThrottle::Ptr& reconnect_throttle) {
+    reconnect_throttle_ = reconnect_throttle;
+  }
+
+  /**
+   * Set the log that records this request if it's slower than the log's
+   * threshold.
+   *
+   * @param slow_request_log The log. This can be NULL to not record the
+   * request.
+   */
+  void set_slow_request_log(const SlowRequestLog::Ptr& slow_request_log) {
+    slow_request_log_ = slow_request_log;
+  }
+
+  /**
+   * Cache the request's result once it's received.
+   *
+   * @param result_cache The cache.
+   * @param key The result's key.
+   * @param ttl_ms The time the result is valid for.
+   */
+  void set_result_cache(const ResultCache::Ptr& result_cache, const String& key, uint64_t ttl_ms) {
+    result_cache_ = result_cache;
+    result_cache_key_ = key;
+    result_cache_ttl_ms_ = ttl_ms;
+  }
+
+  /**
+   * Set the request's priority lane. This is determined before the request is
+   * queued because the request processor has a queue for each lane.
+   *
+   * @param is_low_priority
+   */
+  void set_is_low_priority(bool is_low_priority) { is_low_priority_ = is_low_priority; }
+  bool is_low_priority() const { return is_low_priority_; }
+
+  /**
+   * Set the timer wheel of the event loop that the request's timeout and its
+   * speculative executions are scheduled on.
+   *
+   * @param timer_wheel The timer wheel. This can be NULL to use a libuv timer
+   * for each timeout.
+   */
+  void set_timer_wheel(TimerWheel* timer_wheel) { timer_wheel_ = timer_wheel; }
+  TimerWheel* timer_wheel() const { return timer_wheel_; }
+
+  /**
+   * Set the number of stream IDs of each connection that low priority
+   * requests can't use.
+   *
+   * @param reserved_streams
+   */
+  void set_reserved_streams(size_t reserved_streams) { reserved_streams_ = reserved_streams; }
+
+  /**
+   * Set the tracer that's notified of this request's execution. This traces
+   * the request's start so it must be called on the thread that executes the
+   * request.
+   *
+   * @param tracer The tracer. This can be NULL to not trace the request.
+   */
+  void set_request_tracer(const RequestTracer::Ptr& tracer);
+
+  /**
+   * Stream the request's pages using DSE continuous paging. The pages before
+   * the last page are added to the continuous paging object and the last page
+   * (or the request's error) is set on the request's future. Once a page has
+   * been added the request isn't retried and its timeout no longer applies.
+   *
+   * @param continuous_paging The request's pages.
+   */
+  void set_continuous_paging(const SharedRefPtr<ContinuousPaging>& continuous_paging);
+
+  /**
+   * Determine if pages of a continuous paging request have been added. The
+   * request can't be retried once pages have been added because they would be
+   * added again.
+   */
+  bool has_continuous_pages() const { return has_continuous_pages_; }
+
+  /**
+   * The metadata of the continuous paging request's rows. The coordinator
+   * only sends the metadata with the first page.
+   */
+  const ResultMetadata::Ptr& continuous_page_metadata() const { return continuous_page_metadata_; }
+
+  /**
+   * Determine if the statement's rows are delivered to a row callback as
+   * they're received.
+   */
+  bool has_row_callback() const { return row_callback_ != NULL; }
+
+  /**
+   * The storage used to allocate this request's query plans.
+   */
+  QueryPlanStorage* query_plan_storage() { return &query_plan_storage_; }
+
   void init(const ExecutionProfile& profile, ConnectionPoolManager* manager,
             const TokenMap* token_map, TimestampGenerator* timestamp_generator,
             RequestListener* listener);
@@ -174,6 +406,38 @@ public:
   const Request* request() const { return wrapper_.request().get(); }
   CassConsistency consistency() const { return wrapper_.consistency(); }
 
+  /**
+   * The keyspace used to route the request: the statement's keyspace or the
+   * session's keyspace. It's empty until the request handler is initialized.
+   */
+  const InternedString& keyspace() const { return keyspace_; }
+
+  /**
+   * The histograms of the request stages' latencies.
+   *
+   * @return The histograms or NULL if request stage metrics are disabled.
+   */
+  Metrics::StageLatencies* stage_latencies() const { return stage_latencies_; }
+
+  /**
+   * Determine if the executions of this request should record the times of
+   * their stages.
+   */
+  bool records_stage_times() const { return stage_latencies_ || slow_request_log_; }
+
+  /**
+   * Record the time since the request was created as its queue latency. This
+   * is called when a request processor dequeues the request.
+   */
+  void record_queue_latency() {
+    if (records_stage_times()) {
+      queue_time_ns_ = uv_hrtime() - start_time_ns_;
+      if (stage_latencies_) {
+        stage_latencies_->queue.record_value(queue_time_ns_ / 1000);
+      }
+    }
+  }
+
 public:
   class Protected {
     friend class RequestExecution;
@@ -183,13 +447,71 @@ public:
 
   void retry(RequestExecution* request_execution, Protected);
 
-  Host::Ptr next_host(Protected);
+  /**
+   * Take a retry from the retry budget (if any) for a retry decided by the
+   * retry policy.
+   *
+   * @return true if the request can be retried, otherwise false.
+   */
+  bool acquire_retry(Protected);
+
+  const Host::Ptr& next_host(Protected);
+  void record_host_success(const Host::Ptr& host, uint64_t latency_ns, Protected);
+  void record_host_failure(const Host::Ptr& host, Protected);
   int64_t next_execution(const Host::Ptr& current_host, Protected);
+  bool start_execution(Protected);
+  void record_latency(uint64_t latency_ns, Protected);
+
+  /**
+   * Record the write and server times of the execution that received the
+   * latest response.
+   */
+  void record_execution_times(uint64_t write_time_ns, uint64_t server_time_ns, Protected) {
+    write_time_ns_ = write_time_ns;
+    server_time_ns_ = server_time_ns;
+  }
+
+  void remove_execution(RequestExecution* request_execution, Protected);
 
   void start_request(uv_loop_t* loop, Protected);
 
+  /**
+   * Add a page, that isn't the last page, of a continuous paging request.
+   *
+   * @param connection The request's connection.
+   * @param stream The request's stream.
+   * @param page The page.
+   */
+  void add_continuous_page(Connection* connection, int stream, ResultResponse* page, Protected);
+
+  void set_continuous_page_metadata(const ResultMetadata::Ptr& metadata, Protected) {
+    continuous_page_metadata_ = metadata;
+  }
+
+  /**
+   * Deliver a row of the page to the statement's row callback. A row that has
+   * already been delivered, e.g. by another execution of the request, is
+   * skipped.
+   *
+   * @param row The row.
+   * @param index The row's index in the page.
+   */
+  void stream_row(const Row& row, int32_t index, Protected);
+
+  /**
+   * Deliver the rows of the page that haven't already been delivered to the
+   * statement's row callback.
+   *
+   * @param result The page.
+   */
+  void stream_rows(const ResultResponse* result, Protected);
+
   void add_attempted_address(const Address& address, Protected);
 
+  void notify_request_sent(const Host::Ptr& host, Protected);
+
+  void notify_host_unprepared(const Host::Ptr& host, Protected);
+
   void notify_result_metadata_changed(const String& prepared_id, const String& query,
                                       const String& keyspace, const String& result_metadata_id,
                                       const ResultResponse::ConstPtr& result_response, Protected);
@@ -212,11 +534,34 @@ public:
 
 private:
   void on_timeout(Timer* timer);
+  void on_wheel_timeout(WheelTimer* timer);
 
 private:
+  void maybe_prefetch_next_page(const Response::Ptr& response);
   void stop_request();
   void internal_retry(RequestExecution* request_execution);
 
+  /**
+   * Cancel the request's executions once its future has been set. This stops
+   * the executions from being retried or from scheduling more speculative
+   * executions and their late responses are dropped.
+   */
+  void cancel_executions();
+
+  /**
+   * Add the request to the slow request log if it took longer than the log's
+   * threshold. This is called once the request's future is set.
+   */
+  void maybe_log_slow_request(const Host::Ptr& host, CassError code);
+
+  /**
+   * Called once the request's future is set.
+   */
+  void on_finish(const Host::Ptr& host, CassError code);
+
+  void trace(CassRequestTraceEventType type, const Host::Ptr& host = Host::Ptr(),
+             CassError code = CASS_OK);
+
 private:
   RequestWrapper wrapper_;
   SharedRefPtr<ResponseFuture> future_;
@@ -224,15 +569,58 @@ private:
   bool is_done_;
   int running_executions_;
 
+  QueryPlanStorage query_plan_storage_;
   ScopedPtr<QueryPlan> query_plan_;
+  SmallVector<Host::Ptr, 2> skipped_hosts_; // Hosts with open circuits, warming up or re-preparing
+  size_t next_skipped_host_;
   ScopedPtr<SpeculativeExecutionPlan> execution_plan_;
+  SmallVector<RequestExecution*, 2> executions_; // Not owned
   Timer timer_;
+  TimerWheel* timer_wheel_;
+  WheelTimer wheel_timer_;
 
   const uint64_t start_time_ns_;
+  const uint64_t deadline_ns_; // In terms of uv_hrtime(), 0 if there's no deadline
   RequestListener* listener_;
   ConnectionPoolManager* manager_;
-
+  InternedString keyspace_;
+  CassConnectionSelection connection_selection_;
+  bool is_low_priority_;
+  const bool is_prepared_request_; // An EXECUTE or BATCH request
+  size_t reserved_streams_;
+  InflightLimiter::Ptr inflight_limiter_;
+  RetryBudget::Ptr retry_budget_;
+  CircuitBreaker::Ptr circuit_breaker_;
+  ConcurrencyLimiter::Ptr concurrency_limiter_;
+  ReconnectThrottle::Ptr reconnect_throttle_;
+  SharedRefPtr<Arena> arena_;
+
+  Metrics::Histogram* profile_latencies_;
   Metrics* const metrics_;
+  Metrics::StageLatencies* const stage_latencies_;
+
+  SlowRequestLog::Ptr slow_request_log_;
+  ResultCache::Ptr result_cache_;
+  String result_cache_key_;
+  uint64_t result_cache_ttl_ms_;
+  AddressVec attempted_hosts_; // Only recorded for the slow request log
+  unsigned retry_count_;
+  unsigned speculative_execution_count_;
+  uint64_t queue_time_ns_;
+  uint64_t write_time_ns_;
+  uint64_t server_time_ns_;
+
+  RequestTracer::Ptr request_tracer_;
+  uint64_t trace_request_id_;
+  void* trace_span_;
+
+  SharedRefPtr<ContinuousPaging> continuous_paging_;
+  ResultMetadata::Ptr continuous_page_metadata_;
+  bool has_continuous_pages_;
+
+  CassRowCallback row_callback_;
+  void* row_callback_data_;
+  int32_t streamed_row_count_;
 
   RequestTryVec request_tries_;
 };
@@ -285,6 +673,29 @@ public:
   virtual bool on_prepare_all(const RequestHandler::Ptr& request_handler,
                               const Host::Ptr& current_host, const Response::Ptr& response) = 0;
 
+  /**
+   * A callback called to start the request for a prefetched page.
+   *
+   * @param request_handler The request for the next page.
+   */
+  virtual void on_next_page(const RequestHandler::Ptr& request_handler) = 0;
+
+  /**
+   * A callback called when a request (or one of its retries or speculative
+   * executions) is written to a host.
+   *
+   * @param host The host.
+   */
+  virtual void on_request_sent(const Host::Ptr& host) = 0;
+
+  /**
+   * A callback called when a host responds with UNPREPARED, e.g. because it
+   * was restarted and lost its prepared statement cache.
+   *
+   * @param host The host.
+   */
+  virtual void on_host_unprepared(const Host::Ptr& host) = 0;
+
   virtual void on_done() = 0;
 };
 
@@ -292,7 +703,10 @@ class RequestExecution : public RequestCallback {
 public:
   typedef SharedRefPtr<RequestExecution> Ptr;
 
+  ARENA_ALLOCATED()
+
   RequestExecution(RequestHandler* request_handler);
+  ~RequestExecution();
 
   const Host::Ptr& current_host() const { return current_host_; }
   void next_host() { current_host_ = request_handler_->next_host(RequestHandler::Protected()); }
@@ -303,8 +717,24 @@ public:
   virtual void on_retry_current_host();
   virtual void on_retry_next_host();
 
+  /**
+   * Cancel the execution because another execution finished the request. An
+   * in-flight execution keeps its stream ID until the coordinator responds
+   * (the ID can't be reused before then) but the response is dropped and no
+   * retries or speculative executions are started.
+   */
+  void cancel();
+
+  /**
+   * Called when the request times out while this execution is waiting for a
+   * response. The time waited so far is recorded as the host's latency so
+   * that hosts which stop responding are penalized by latency tracking.
+   */
+  void on_request_timeout();
+
 private:
   void on_execute_next(Timer* timer);
+  void on_wheel_execute_next(WheelTimer* timer);
 
   void retry_current_host();
   void retry_next_host();
@@ -313,6 +743,15 @@ private:
 
   virtual void on_set(ResponseMessage* response);
   virtual void on_error(CassError code, const String& message);
+  virtual bool on_partial_response(ResponseMessage* response);
+
+  /**
+   * Set the metadata of a continuous page that doesn't have metadata to the
+   * metadata of the first page, otherwise, record the page's metadata.
+   */
+  void set_continuous_page_metadata(ResultResponse* result);
+
+  virtual void on_partial_body(const ResponseMessage* response);
 
   void on_result_response(Connection* connection, ResponseMessage* response);
   void on_error_response(Connection* connection, ResponseMessage* response);
@@ -329,8 +768,12 @@ private:
   Host::Ptr current_host_;
   Connection* connection_;
   Timer schedule_timer_;
+  WheelTimer schedule_wheel_timer_;
   int num_retries_;
   const uint64_t start_time_ns_;
+  bool is_canceled_;
+  bool is_timed_out_;
+  ScopedPtr<RowStreamDecoder> row_stream_decoder_;
 };
 
 }}} // namespace datastax::internal::core
@@ -23,6 +23,8 @@
 #include "tracing_data_handler.hpp"
 #include "utils.hpp"
 
+#include <algorithm>
+
 using namespace datastax;
 using namespace datastax::internal;
 using namespace datastax::internal::core;
@@ -102,6 +104,27 @@ private:
   const TokenMap::Ptr token_map_;
 };
 
+class ProcessorNotifyExecutionProfileUpdate : public Task {
+public:
+  ProcessorNotifyExecutionProfileUpdate(const String& name, const ExecutionProfile& profile,
+                                        const HostMap& hosts,
+                                        const RequestProcessor::Ptr& request_processor)
+      : request_processor_(request_processor)
+      , name_(name)
+      , profile_(profile)
+      , hosts_(hosts) {}
+
+  virtual void run(EventLoop* event_loop) {
+    request_processor_->internal_execution_profile_update(name_, profile_, hosts_);
+  }
+
+private:
+  const RequestProcessor::Ptr request_processor_;
+  const String name_;
+  const ExecutionProfile profile_;
+  const HostMap hosts_;
+};
+
 class SetKeyspaceProcessor : public Task {
 public:
   SetKeyspaceProcessor(const ConnectionPoolManager::Ptr& manager, const String& keyspace,
@@ -137,33 +160,107 @@ static NopRequestProcessorListener nop_request_processor_listener__;
 
 RequestProcessorSettings::RequestProcessorSettings()
     : max_schema_wait_time_ms(10000)
+    , schema_agreement_interval_ms(CASS_DEFAULT_SCHEMA_AGREEMENT_INTERVAL_MS)
+    , max_schema_agreement_interval_ms(CASS_DEFAULT_MAX_SCHEMA_AGREEMENT_INTERVAL_MS)
     , prepare_on_all_hosts(true)
     , timestamp_generator(new ServerSideTimestampGenerator())
+    , host_and_profile_metrics(CASS_DEFAULT_HOST_AND_PROFILE_METRICS)
     , default_profile(Config().default_profile())
     , request_queue_size(8192)
+    , request_queue_overflow(false)
+    , producer_lanes(CASS_DEFAULT_PRODUCER_LANES)
+    , low_priority_weight(CASS_DEFAULT_LOW_PRIORITY_WEIGHT)
+    , reserved_streams(CASS_DEFAULT_RESERVED_STREAMS)
     , coalesce_delay_us(CASS_DEFAULT_COALESCE_DELAY)
     , new_request_ratio(CASS_DEFAULT_NEW_REQUEST_RATIO)
+    , coalesce_mode(CASS_DEFAULT_COALESCE_MODE)
+    , coalesce_latency_budget_us(CASS_DEFAULT_COALESCE_LATENCY_BUDGET_US)
     , max_tracing_wait_time_ms(CASS_DEFAULT_MAX_TRACING_DATA_WAIT_TIME_MS)
     , retry_tracing_wait_time_ms(CASS_DEFAULT_RETRY_TRACING_DATA_WAIT_TIME_MS)
     , tracing_consistency(CASS_DEFAULT_TRACING_CONSISTENCY)
-    , address_factory(new AddressFactory()) {
+    , tracing_wait_for_data(CASS_DEFAULT_TRACING_WAIT_FOR_DATA)
+    , address_factory(new AddressFactory())
+    , numa_local_pools(CASS_DEFAULT_IO_THREAD_NUMA_LOCAL)
+    , huge_page_buffers(CASS_DEFAULT_HUGE_PAGE_BUFFERS)
+    , close_timeout_ms(CASS_DEFAULT_CLOSE_TIMEOUT_MS) {
   profiles.set_empty_key("");
 }
 
 RequestProcessorSettings::RequestProcessorSettings(const Config& config)
     : connection_pool_settings(config)
     , max_schema_wait_time_ms(config.max_schema_wait_time_ms())
+    , schema_agreement_interval_ms(config.schema_agreement_interval_ms())
+    , max_schema_agreement_interval_ms(config.max_schema_agreement_interval_ms())
     , prepare_on_all_hosts(config.prepare_on_all_hosts())
     , timestamp_generator(config.timestamp_gen())
+    , retry_budget(config.retry_budget_ratio() > 0.0
+                       ? new RetryBudget(config.retry_budget_ratio())
+                       : NULL)
+    , circuit_breaker(config.circuit_breaker_failure_threshold() > 0
+                          ? new CircuitBreaker(config.circuit_breaker_failure_threshold(),
+                                               config.circuit_breaker_open_duration_ms())
+                          : NULL)
+    , concurrency_limiter(config.concurrency_limiter_max_limit() > 0
+                              ? new ConcurrencyLimiter(
+                                    config.concurrency_limiter_min_limit(),
+                                    config.concurrency_limiter_max_limit(),
+                                    config.concurrency_limiter_latency_threshold_ms())
+                              : NULL)
+    , host_and_profile_metrics(config.host_and_profile_metrics())
     , default_profile(config.default_profile())
     , profiles(config.profiles())
     , request_queue_size(config.queue_size_io())
+    , request_queue_overflow(config.backpressure_mode() == CASS_BACKPRESSURE_MODE_WAIT)
+    , producer_lanes(config.producer_lanes())
+    , low_priority_weight(config.low_priority_weight())
+    , reserved_streams(std::min(static_cast<size_t>(config.reserved_streams()),
+                                static_cast<size_t>(CASS_MAX_STREAMS / 2)))
     , coalesce_delay_us(config.coalesce_delay_us())
     , new_request_ratio(config.new_request_ratio())
+    , coalesce_mode(config.coalesce_mode())
+    , coalesce_latency_budget_us(config.coalesce_latency_budget_us())
     , max_tracing_wait_time_ms(config.max_tracing_wait_time_ms())
     , retry_tracing_wait_time_ms(config.retry_tracing_wait_time_ms())
     , tracing_consistency(config.tracing_consistency())
-    , address_factory(create_address_factory_from_config(config)) {}
+    , tracing_wait_for_data(config.tracing_wait_for_data())
+    , address_factory(create_address_factory_from_config(config))
+    , numa_local_pools(config.io_thread_numa_local())
+    , huge_page_buffers(config.huge_page_buffers())
+    , close_timeout_ms(config.close_timeout_ms()) {}
+
+// The smallest delay used by the adaptive coalesce mode. A timer shorter than
+// this costs more than the latency it saves.
+#define MIN_ADAPTIVE_COALESCE_DELAY_US 10
+
+CoalesceDelay::CoalesceDelay(const RequestProcessorSettings& settings)
+    : is_adaptive_(settings.coalesce_mode == CASS_COALESCE_MODE_ADAPTIVE)
+    , min_delay_us_(MIN_ADAPTIVE_COALESCE_DELAY_US)
+    , max_delay_us_(std::max(settings.coalesce_latency_budget_us / 2,
+                             static_cast<uint64_t>(MIN_ADAPTIVE_COALESCE_DELAY_US)))
+    , delay_us_(settings.coalesce_delay_us) {
+  if (is_adaptive_) {
+    delay_us_ = std::min(std::max(delay_us_, min_delay_us_), max_delay_us_);
+  }
+}
+
+void CoalesceDelay::update(uint64_t io_time_ns, int processed, bool has_backlog) {
+  if (!is_adaptive_) return;
+
+  if (has_backlog) {
+    // Requests are arriving faster than they're written so wait longer to
+    // write more of them at once.
+    delay_us_ = std::min(delay_us_ * 2, max_delay_us_);
+  } else if (processed <= 1) {
+    // There's nothing to coalesce so don't hold requests back.
+    delay_us_ = std::max(delay_us_ / 2, min_delay_us_);
+  } else if (io_time_ns > (delay_us_ * 1000) / 2) {
+    // The loop is busy with I/O for most of the window; larger writes reduce
+    // the number of system calls.
+    delay_us_ = std::min(delay_us_ + delay_us_ / 4, max_delay_us_);
+  } else {
+    delay_us_ = std::max(delay_us_ - delay_us_ / 4, min_delay_us_);
+  }
+}
 
 RequestProcessor::RequestProcessor(RequestProcessorListener* listener, EventLoop* event_loop,
                                    const ConnectionPoolManager::Ptr& connection_pool_manager,
@@ -178,11 +275,24 @@ RequestProcessor::RequestProcessor(RequestProcessorListener* listener, EventLoop
     , default_profile_(settings.default_profile)
     , profiles_(settings.profiles)
     , request_count_(0)
-    , request_queue_(new MPMCQueue<RequestHandler*>(settings.request_queue_size))
+    , request_queue_(new RequestQueue(settings.request_queue_size, settings.request_queue_overflow,
+                                      settings.producer_lanes))
+    , low_priority_queue_(
+          new RequestQueue(settings.request_queue_size, settings.request_queue_overflow))
+    , normal_since_low_priority_(0)
     , is_closing_(false)
     , is_processing_(false)
+    , is_sleeping_(true)
+    , is_wakeup_pending_(false)
     , attempts_without_requests_(0)
     , io_time_during_coalesce_(0)
+    , tracing_random_state_((uv_hrtime() ^ reinterpret_cast<uintptr_t>(this)) | 1)
+    , random_(random ? random->next(CASS_UINT64_MAX) : get_random_seed(uv_hrtime()))
+    , is_randomized_(random != NULL)
+    , coalesce_delay_(settings)
+    , batch_count_(0)
+    , batched_request_count_(0)
+    , timer_wheel_(event_loop->loop())
 #ifdef CASS_INTERNAL_DIAGNOSTICS
     , reads_during_coalesce_(0)
     , writes_during_coalesce_(0)
@@ -207,16 +317,49 @@ RequestProcessor::RequestProcessor(RequestProcessorListener* listener, EventLoop
       it->second.use_load_balancing_policy(default_profile_.load_balancing_policy());
     }
   }
+  ExecutionProfile::index(profiles_, &indexed_profiles_);
+
+  // Record the latencies of each named profile's requests
+  Metrics* metrics = connection_pool_manager_->metrics();
+  if (settings.host_and_profile_metrics && metrics) {
+    for (ExecutionProfile::Map::iterator it = profiles_.begin(), end = profiles_.end(); it != end;
+         ++it) {
+      it->second.set_latency_histogram(metrics->profile_latencies(it->first));
+    }
+  }
 
   token_map_ = token_map;
 
+  // Use the connected host's datacenter and rack, like the load balancing
+  // policies, if they weren't provided
+  local_dc_ = local_dc;
+  local_rack_ = local_rack;
+  if (local_dc_.empty() && connected_host) {
+    local_dc_ = connected_host->dc();
+  }
+  if (local_rack_.empty() && connected_host) {
+    local_rack_ = connected_host->rack();
+  }
+
   LoadBalancingPolicy::Vec policies = load_balancing_policies();
   for (LoadBalancingPolicy::Vec::const_iterator it = policies.begin(); it != policies.end(); ++it) {
     // Initialize the load balancing policies
-    (*it)->init(connected_host, hosts, random, local_dc, local_rack);
+    (*it)->init(connected_host, hosts, random ? &random_ : NULL, local_dc, local_rack);
     (*it)->register_handles(event_loop_->loop());
   }
 
+  // The initializer only connected the local hosts if the remote hosts' pools
+  // are sized differently or connected on first use. The remote hosts are
+  // added now that their distance is known.
+  const ConnectionPoolSettings& pool_settings = connection_pool_manager_->settings();
+  if (pool_settings.lazy_remote_pools || pool_settings.num_connections_per_remote_host > 0) {
+    for (HostMap::const_iterator it = hosts.begin(), end = hosts.end(); it != end; ++it) {
+      if (!is_host_ignored(policies, it->second)) {
+        connection_pool_manager_->add(it->second, is_host_remote(policies, it->second));
+      }
+    }
+  }
+
   listener_->on_connect(this);
 }
 
@@ -258,27 +401,93 @@ void RequestProcessor::notify_token_map_updated(const TokenMap::Ptr& token_map)
   event_loop_->add(new ProcessorNotifyTokenMapUpdate(token_map, Ptr(this)));
 }
 
+void RequestProcessor::notify_execution_profile_updated(const String& name,
+                                                        const ExecutionProfile& profile,
+                                                        const HostMap& hosts) {
+  event_loop_->add(new ProcessorNotifyExecutionProfileUpdate(name, profile, hosts, Ptr(this)));
+}
+
 void RequestProcessor::process_request(const RequestHandler::Ptr& request_handler) {
-  request_handler->inc_ref(); // Queue reference
+  if (enqueue(request_handler)) {
+    maybe_wakeup();
+  }
+}
 
-  if (request_queue_->enqueue(request_handler.get())) {
-    request_count_.fetch_add(1);
-    // Only signal the request queue if it's not already processing requests.
-    bool expected = false;
-    if (!is_processing_.load(MEMORY_ORDER_RELAXED) &&
-        is_processing_.compare_exchange_strong(expected, true)) {
-      async_.send();
+void RequestProcessor::process_request_group(const Vector<RequestHandler::Ptr>& request_handlers) {
+  // The normal and the low priority requests are each enqueued with a single
+  // queue operation
+  Vector<RequestHandler*> normal_priority;
+  Vector<RequestHandler*> low_priority;
+  normal_priority.reserve(request_handlers.size());
+  for (Vector<RequestHandler::Ptr>::const_iterator it = request_handlers.begin(),
+                                                   end = request_handlers.end();
+       it != end; ++it) {
+    (*it)->inc_ref(); // Queue reference
+    if ((*it)->is_low_priority()) {
+      low_priority.push_back(it->get());
+    } else {
+      normal_priority.push_back(it->get());
     }
-  } else {
+  }
+
+  size_t enqueued = enqueue(request_queue_.get(), normal_priority) +
+                    enqueue(low_priority_queue_.get(), low_priority);
+  if (enqueued > 0) {
+    request_count_.fetch_add(enqueued);
+    maybe_wakeup();
+  }
+}
+
+size_t RequestProcessor::enqueue(RequestQueue* queue,
+                                 const Vector<RequestHandler*>& request_handlers) {
+  if (request_handlers.empty()) return 0;
+
+  size_t enqueued = queue->enqueue(&request_handlers[0], request_handlers.size());
+  for (size_t i = enqueued; i < request_handlers.size(); ++i) {
+    RequestHandler::Ptr request_handler(request_handlers[i]);
+    request_handler->dec_ref(); // Queue reference
+    request_handler->set_error(CASS_ERROR_LIB_REQUEST_QUEUE_FULL,
+                               "The request queue has reached capacity");
+  }
+  return enqueued;
+}
+
+bool RequestProcessor::enqueue(const RequestHandler::Ptr& request_handler) {
+  request_handler->inc_ref(); // Queue reference
+
+  RequestQueue* queue =
+      request_handler->is_low_priority() ? low_priority_queue_.get() : request_queue_.get();
+  if (!queue->enqueue(request_handler.get())) {
     request_handler->dec_ref();
     request_handler->set_error(CASS_ERROR_LIB_REQUEST_QUEUE_FULL,
                                "The request queue has reached capacity");
+    return false;
+  }
+  request_count_.fetch_add(1);
+  return true;
+}
+
+void RequestProcessor::maybe_wakeup() {
+  // Only wake up the processor if it's not already processing requests.
+  // A busy polling event loop checks the queue on every iteration instead.
+  bool expected = false;
+  if (!event_loop_->is_busy_poll() && !is_processing_.load(MEMORY_ORDER_RELAXED) &&
+      is_processing_.compare_exchange_strong(expected, true)) {
+    // An event loop that's awake handles the pending wake-up before it
+    // blocks so the async handle (a system call) is only signaled when
+    // it might be blocked.
+    is_wakeup_pending_.store(true);
+    if (is_sleeping_.load()) {
+      async_.send();
+    }
   }
 }
 
 int RequestProcessor::init(Protected) {
   int rc = async_.start(event_loop_->loop(), bind_callback(&RequestProcessor::on_async, this));
   if (rc != 0) return rc;
+  rc = check_.start(event_loop_->loop(), bind_callback(&RequestProcessor::on_check, this));
+  if (rc != 0) return rc;
   return prepare_.start(event_loop_->loop(), bind_callback(&RequestProcessor::on_prepare, this));
 }
 
@@ -302,7 +511,7 @@ void RequestProcessor::on_pool_critical_error(const Address& address,
 }
 
 void RequestProcessor::on_requires_flush() {
-  if (!timer_.is_running()) {
+  if (!event_loop_->is_busy_poll() && !timer_.is_running()) {
     is_processing_.store(true);
     start_coalescing();
   }
@@ -315,7 +524,11 @@ void RequestProcessor::on_close(ConnectionPoolManager* manager) {
   }
   async_.close_handle();
   prepare_.close_handle();
+  check_.close_handle();
+  idle_.close_handle();
   timer_.stop();
+  close_timer_.stop();
+  timer_wheel_.close();
   connection_pool_manager_.reset();
   listener_->on_close(this);
   dec_ref();
@@ -335,11 +548,32 @@ void RequestProcessor::on_keyspace_changed(const String& keyspace,
 bool RequestProcessor::on_wait_for_tracing_data(const RequestHandler::Ptr& request_handler,
                                                 const Host::Ptr& current_host,
                                                 const Response::Ptr& response) {
+  if (settings_.tracing_wait_for_data) {
+    TracingDataHandler::Ptr handler(new TracingDataHandler(
+        request_handler, current_host, response, settings_.tracing_consistency,
+        settings_.max_tracing_wait_time_ms, settings_.retry_tracing_wait_time_ms));
+
+    return write_wait_callback(request_handler, current_host, handler->callback());
+  }
+
+  // Wait for the tracing data in the background and set the response now. The
+  // tracing data's future is attached before the response is set so that
+  // it's available as soon as the response is.
+  Future::Ptr tracing_data_future(new Future(Future::FUTURE_TYPE_GENERIC));
+  request_handler->set_tracing_data_future(tracing_data_future);
+
   TracingDataHandler::Ptr handler(new TracingDataHandler(
       request_handler, current_host, response, settings_.tracing_consistency,
-      settings_.max_tracing_wait_time_ms, settings_.retry_tracing_wait_time_ms));
+      settings_.max_tracing_wait_time_ms, settings_.retry_tracing_wait_time_ms,
+      tracing_data_future));
 
-  return write_wait_callback(request_handler, current_host, handler->callback());
+  PooledConnection::Ptr connection(
+      connection_pool_manager_->find_least_busy(current_host->address()));
+  if (!connection || connection->write(handler->callback().get()) <= 0) {
+    tracing_data_future->set_error(CASS_ERROR_LIB_NO_STREAMS,
+                                   "Unable to send the request for the tracing data");
+  }
+  return false;
 }
 
 bool RequestProcessor::on_wait_for_schema_agreement(const RequestHandler::Ptr& request_handler,
@@ -347,7 +581,10 @@ bool RequestProcessor::on_wait_for_schema_agreement(const RequestHandler::Ptr& r
                                                     const Response::Ptr& response) {
   SchemaAgreementHandler::Ptr handler(
       new SchemaAgreementHandler(request_handler, current_host, response, this,
-                                 settings_.max_schema_wait_time_ms, settings_.address_factory));
+                                 settings_.max_schema_wait_time_ms,
+                                 settings_.schema_agreement_interval_ms,
+                                 settings_.max_schema_agreement_interval_ms,
+                                 settings_.address_factory));
 
   return write_wait_callback(request_handler, current_host, handler->callback());
 }
@@ -392,6 +629,27 @@ bool RequestProcessor::on_prepare_all(const RequestHandler::Ptr& request_handler
   return true;
 }
 
+void RequestProcessor::on_next_page(const RequestHandler::Ptr& request_handler) {
+  process_request(request_handler);
+}
+
+void RequestProcessor::on_request_sent(const Host::Ptr& host) {
+  Metrics* metrics = connection_pool_manager_->metrics();
+  if (metrics == NULL) return;
+
+  if (!local_dc_.empty() && host->dc() != local_dc_) {
+    metrics->remote_dc_requests.inc();
+  } else if (!local_rack_.empty() && host->rack() == local_rack_) {
+    metrics->local_rack_requests.inc();
+  } else {
+    metrics->local_dc_requests.inc();
+  }
+}
+
+void RequestProcessor::on_host_unprepared(const Host::Ptr& host) {
+  listener_->on_host_unprepared(host);
+}
+
 void RequestProcessor::on_done() {
 #ifdef CASS_INTERNAL_DIAGNOSTICS
   reads_during_coalesce_++;
@@ -405,9 +663,21 @@ bool RequestProcessor::on_is_host_up(const Address& address) {
 
 void RequestProcessor::internal_close() {
   is_closing_ = true;
+  if (settings_.close_timeout_ms > 0) {
+    close_timer_.start(&timer_wheel_, settings_.close_timeout_ms,
+                       bind_callback(&RequestProcessor::on_close_timeout, this));
+  }
   maybe_close(request_count_.load());
 }
 
+void RequestProcessor::on_close_timeout(WheelTimer* timer) {
+  LOG_WARN("Closing connections with %d request(s) still in-flight after waiting %u ms",
+           request_count_.load(), static_cast<unsigned>(settings_.close_timeout_ms));
+  fail_pending_requests();
+  // The requests waiting for responses fail when their connections are closed
+  if (connection_pool_manager_) connection_pool_manager_->close();
+}
+
 void RequestProcessor::internal_pool_down(const Address& address) {
   LoadBalancingPolicy::Vec policies = load_balancing_policies();
   for (LoadBalancingPolicy::Vec::const_iterator it = policies.begin(); it != policies.end(); ++it) {
@@ -415,6 +685,15 @@ void RequestProcessor::internal_pool_down(const Address& address) {
   }
 }
 
+const ExecutionProfile* RequestProcessor::execution_profile(const Request* request) const {
+  int32_t handle = request->execution_profile_handle();
+  if (handle >= 0) {
+    return static_cast<size_t>(handle) < indexed_profiles_.size() ? indexed_profiles_[handle]
+                                                                   : NULL;
+  }
+  return execution_profile(request->execution_profile_name());
+}
+
 const ExecutionProfile* RequestProcessor::execution_profile(const String& name) const {
   // Determine if cluster profile should be used
   if (name.empty()) {
@@ -433,11 +712,57 @@ const LoadBalancingPolicy::Vec& RequestProcessor::load_balancing_policies() cons
   return load_balancing_policies_;
 }
 
+void RequestProcessor::internal_execution_profile_update(const String& name,
+                                                         const ExecutionProfile& profile,
+                                                         const HostMap& hosts) {
+  ExecutionProfile::Map::iterator it = profiles_.find(name);
+  if (it == profiles_.end() || !connection_pool_manager_) return;
+
+  ExecutionProfile updated(profile);
+  updated.set_handle(it->second.handle());
+  updated.set_latency_histogram(it->second.latency_histogram());
+  updated.build_load_balancing_policy();
+  const LoadBalancingPolicy::Ptr& load_balancing_policy = updated.load_balancing_policy();
+  if (load_balancing_policy) {
+    load_balancing_policy->init(Host::Ptr(), hosts, is_randomized_ ? &random_ : NULL, local_dc_,
+                                local_rack_);
+    // The hosts that went down before the update are only known by the
+    // connection pools
+    for (HostMap::const_iterator host_it = hosts.begin(), end = hosts.end(); host_it != end;
+         ++host_it) {
+      if (!connection_pool_manager_->has_connections(host_it->first)) {
+        load_balancing_policy->on_host_down(host_it->first);
+      }
+    }
+    load_balancing_policy->register_handles(event_loop_->loop());
+    load_balancing_policies_.push_back(load_balancing_policy);
+  } else {
+    updated.use_load_balancing_policy(default_profile_.load_balancing_policy());
+  }
+
+  // Retire the previous profile's own load balancing policy. It's kept until
+  // the processor is closed because the query plans of the requests that are
+  // still running point to it.
+  const LoadBalancingPolicy::Ptr& previous = it->second.load_balancing_policy();
+  if (previous && previous != default_profile_.load_balancing_policy()) {
+    LoadBalancingPolicy::Vec::iterator policy_it =
+        std::find(load_balancing_policies_.begin(), load_balancing_policies_.end(), previous);
+    if (policy_it != load_balancing_policies_.end()) {
+      load_balancing_policies_.erase(policy_it);
+    }
+    previous->close_handles();
+    retired_load_balancing_policies_.push_back(previous);
+  }
+
+  it->second = updated;
+  LOG_DEBUG("Updated the '%s' execution profile", name.c_str());
+}
+
 void RequestProcessor::internal_host_add(const Host::Ptr& host) {
   if (connection_pool_manager_) {
     LoadBalancingPolicy::Vec policies = load_balancing_policies();
     if (!is_host_ignored(policies, host)) {
-      connection_pool_manager_->add(host);
+      connection_pool_manager_->add(host, is_host_remote(policies, host));
       for (LoadBalancingPolicy::Vec::const_iterator it = policies.begin(); it != policies.end();
            ++it) {
         if ((*it)->distance(host) != CASS_HOST_DISTANCE_IGNORE) {
@@ -480,7 +805,7 @@ void RequestProcessor::internal_host_maybe_up(const Address& address) {
 
 void RequestProcessor::start_coalescing() {
   io_time_during_coalesce_ = 0;
-  timer_.start(event_loop_->loop(), settings_.coalesce_delay_us,
+  timer_.start(event_loop_->loop(), coalesce_delay_.delay_us(),
                bind_callback(&RequestProcessor::on_timeout, this));
 }
 
@@ -488,13 +813,17 @@ void RequestProcessor::on_timeout(MicroTimer* timer) {
   // Don't process for more time than the coalesce delay.
   uint64_t processing_time =
       std::min((io_time_during_coalesce_ * settings_.new_request_ratio) / 100,
-               settings_.coalesce_delay_us * 1000);
-  int processed = process_requests(processing_time);
+               coalesce_delay_.delay_us() * 1000);
+  int processed = process_delayed_requests();
+  processed += process_requests(processing_time);
 
   connection_pool_manager_->flush();
 
+  coalesce_delay_.update(io_time_during_coalesce_, processed, !is_request_queue_empty());
+
   if (processed > 0) {
     attempts_without_requests_ = 0;
+    record_batch(processed);
 
 #ifdef CASS_INTERNAL_DIAGNOSTICS
     reads_per_.record_value(reads_during_coalesce_);
@@ -510,7 +839,15 @@ void RequestProcessor::on_timeout(MicroTimer* timer) {
       attempts_without_requests_ = 0;
       is_processing_.store(false);
       bool expected = false;
-      if (request_queue_->is_empty() || !is_processing_.compare_exchange_strong(expected, true)) {
+      if (is_request_queue_empty() || !is_processing_.compare_exchange_strong(expected, true)) {
+        // Sleep until the next rate limited request can start. New requests
+        // are still processed as soon as they arrive.
+        if (!delayed_requests_.empty()) {
+          uint64_t now = uv_hrtime();
+          uint64_t start_ns = delayed_requests_.front().start_ns;
+          timer_.start(event_loop_->loop(), start_ns > now ? (start_ns - now) / 1000 + 1 : 0,
+                       bind_callback(&RequestProcessor::on_timeout, this));
+        }
         return;
       }
     }
@@ -522,7 +859,13 @@ void RequestProcessor::on_timeout(MicroTimer* timer) {
 }
 
 void RequestProcessor::on_async(Async* async) {
-  process_requests(0);
+  is_sleeping_.store(false);
+  is_wakeup_pending_.store(false);
+
+  int processed = process_requests(0);
+  if (processed > 0) {
+    record_batch(processed);
+  }
 
   connection_pool_manager_->flush();
 
@@ -533,43 +876,109 @@ void RequestProcessor::on_async(Async* async) {
   }
 }
 
+void RequestProcessor::record_batch(int processed) {
+  // Only this processor's event loop writes the counters
+  batch_count_.store(batch_count_.load(MEMORY_ORDER_RELAXED) + 1, MEMORY_ORDER_RELAXED);
+  batched_request_count_.store(batched_request_count_.load(MEMORY_ORDER_RELAXED) + processed,
+                               MEMORY_ORDER_RELAXED);
+}
+
 void RequestProcessor::on_prepare(Prepare* prepare) {
   io_time_during_coalesce_ += event_loop_->io_time_elapsed();
+
+  // A busy polling event loop doesn't wait to be woken up so the queued
+  // requests are written on every iteration
+  if (event_loop_->is_busy_poll()) {
+    int processed = process_delayed_requests();
+    processed += process_requests(0);
+    if (processed > 0) {
+      record_batch(processed);
+    }
+    connection_pool_manager_->flush();
+    return;
+  }
+
+  // The loop is about to block. Producers that see this signal the async
+  // handle. Both flags are sequentially consistent so that a wake-up is
+  // never missed.
+  is_sleeping_.store(true);
+  if (is_wakeup_pending_.load()) {
+    // A wake-up was left by a producer that saw the loop awake. The loop
+    // polls without blocking and the requests are written after the I/O
+    // that's already pending (e.g. a closed connection) is handled.
+    is_sleeping_.store(false);
+    idle_.start(event_loop_->loop(), bind_callback(&RequestProcessor::on_idle, this));
+  }
+}
+
+void RequestProcessor::on_idle(Idle* idle) {}
+
+void RequestProcessor::on_check(Check* check) {
+  // The loop is awake until it's about to block again
+  is_sleeping_.store(false);
+  if (idle_.is_running()) {
+    idle_.stop();
+    if (is_wakeup_pending_.load()) {
+      on_async(&async_);
+    }
+  }
 }
 
 void RequestProcessor::maybe_close(int request_count) {
-  if (is_closing_ && request_count <= 0 && request_queue_->is_empty()) {
+  if (is_closing_ && request_count <= 0 && is_request_queue_empty()) {
+    close_timer_.stop();
     if (connection_pool_manager_) connection_pool_manager_->close();
   }
 }
 
+// The number of requests dequeued at a time
+#define PROCESS_REQUESTS_BATCH_SIZE 64
+
 int RequestProcessor::process_requests(uint64_t processing_time) {
   uint64_t finish_time = uv_hrtime() + processing_time;
 
   int processed = 0;
-  RequestHandler* request_handler = NULL;
-  while (request_queue_->dequeue(request_handler)) {
-    if (request_handler) {
-      const String& profile_name = request_handler->request()->execution_profile_name();
-      const ExecutionProfile* profile(execution_profile(profile_name));
+  RequestHandler* request_handlers[PROCESS_REQUESTS_BATCH_SIZE];
+  size_t count;
+  while ((count = dequeue_requests(request_handlers, PROCESS_REQUESTS_BATCH_SIZE)) > 0) {
+    for (size_t i = 0; i < count; ++i) {
+      RequestHandler* request_handler = request_handlers[i];
+      request_handler->record_queue_latency();
+      const Request* request = request_handler->request();
+      const ExecutionProfile* profile(execution_profile(request));
       if (profile) {
-        if (!profile_name.empty()) {
-          LOG_TRACE("Using execution profile '%s'", profile_name.c_str());
+        if (!request->execution_profile_name().empty()) {
+          LOG_TRACE("Using execution profile '%s'",
+                    request->execution_profile_name().c_str());
         }
-        request_handler->init(*profile, connection_pool_manager_.get(), token_map_.get(),
-                              settings_.timestamp_generator.get(), this);
-        request_handler->execute();
+        if (profile->rate_limiter()) {
+          uint64_t now = uv_hrtime();
+          uint64_t start_ns = profile->rate_limiter()->acquire(now);
+          if (start_ns > now) {
+            // Keep the request's reference until it's started
+            delayed_requests_.push_back(DelayedRequest(start_ns, request_handler, profile));
+            std::push_heap(delayed_requests_.begin(), delayed_requests_.end());
+            continue;
+          }
+        }
+        execute_request(request_handler, *profile);
         processed++;
       } else {
         maybe_close(request_count_.fetch_sub(1) - 1);
-        request_handler->set_error(CASS_ERROR_LIB_EXECUTION_PROFILE_INVALID,
-                                   profile_name + " does not exist");
+        if (request->execution_profile_handle() >= 0) {
+          OStringStream ss;
+          ss << "Execution profile handle " << request->execution_profile_handle()
+             << " does not exist";
+          request_handler->set_error(CASS_ERROR_LIB_EXECUTION_PROFILE_INVALID, ss.str());
+        } else {
+          request_handler->set_error(CASS_ERROR_LIB_EXECUTION_PROFILE_INVALID,
+                                     request->execution_profile_name() + " does not exist");
+        }
       }
       request_handler->dec_ref();
     }
 
-    if ((processed & 0x3F) == 0 && // Check the finish time every 64 requests
-        uv_hrtime() >= finish_time) {
+    if (uv_hrtime() >= finish_time) { // Check the finish time after every batch
       break;
     }
   }
@@ -581,6 +990,117 @@ int RequestProcessor::process_requests(uint64_t processing_time) {
   return processed;
 }
 
+size_t RequestProcessor::dequeue_requests(RequestHandler** request_handlers, size_t count) {
+  // Weighted round-robin between the lanes: a low priority request is only
+  // taken first after enough normal priority requests, otherwise only when
+  // there are no normal priority requests.
+  size_t dequeued = 0;
+  while (dequeued < count) {
+    if (normal_since_low_priority_ >= settings_.low_priority_weight) {
+      if (low_priority_queue_->dequeue(request_handlers + dequeued, 1) > 0) {
+        normal_since_low_priority_ = 0;
+        dequeued++;
+        continue;
+      }
+    }
+
+    // Take normal priority requests up to the next low priority request's turn
+    size_t max_normal = count - dequeued;
+    if (normal_since_low_priority_ < settings_.low_priority_weight) {
+      max_normal = std::min(max_normal, static_cast<size_t>(settings_.low_priority_weight -
+                                                            normal_since_low_priority_));
+    }
+    size_t normal = request_queue_->dequeue(request_handlers + dequeued, max_normal);
+    if (normal > 0) {
+      normal_since_low_priority_ += normal;
+      dequeued += normal;
+      continue;
+    }
+
+    if (low_priority_queue_->dequeue(request_handlers + dequeued, 1) > 0) {
+      normal_since_low_priority_ = 0;
+      dequeued++;
+      continue;
+    }
+    break;
+  }
+  return dequeued;
+}
+
+int RequestProcessor::process_delayed_requests() {
+  if (delayed_requests_.empty()) return 0;
+
+  int processed = 0;
+  uint64_t now = uv_hrtime();
+  while (!delayed_requests_.empty() && delayed_requests_.front().start_ns <= now) {
+    DelayedRequest delayed_request(delayed_requests_.front());
+    std::pop_heap(delayed_requests_.begin(), delayed_requests_.end());
+    delayed_requests_.pop_back();
+    execute_request(delayed_request.request_handler, *delayed_request.profile);
+    delayed_request.request_handler->dec_ref();
+    processed++;
+  }
+
+#ifdef CASS_INTERNAL_DIAGNOSTICS
+  writes_during_coalesce_ += processed;
+#endif
+
+  return processed;
+}
+
+void RequestProcessor::fail_pending_requests() {
+  RequestHandler* request_handlers[PROCESS_REQUESTS_BATCH_SIZE];
+  size_t count;
+  while ((count = dequeue_requests(request_handlers, PROCESS_REQUESTS_BATCH_SIZE)) > 0) {
+    for (size_t i = 0; i < count; ++i) {
+      request_count_.fetch_sub(1);
+      request_handlers[i]->set_error(CASS_ERROR_LIB_REQUEST_TIMED_OUT,
+                                     "Session closed before the request was started");
+      request_handlers[i]->dec_ref();
+    }
+  }
+  for (Vector<DelayedRequest>::iterator it = delayed_requests_.begin(),
+                                        end = delayed_requests_.end();
+       it != end; ++it) {
+    request_count_.fetch_sub(1);
+    it->request_handler->set_error(CASS_ERROR_LIB_REQUEST_TIMED_OUT,
+                                   "Session closed before the request was started");
+    it->request_handler->dec_ref();
+  }
+  delayed_requests_.clear();
+}
+
+void RequestProcessor::execute_request(RequestHandler* request_handler,
+                                       const ExecutionProfile& profile) {
+  request_handler->set_retry_budget(settings_.retry_budget);
+  request_handler->set_circuit_breaker(settings_.circuit_breaker);
+  request_handler->set_concurrency_limiter(settings_.concurrency_limiter);
+  request_handler->set_reserved_streams(settings_.reserved_streams);
+  request_handler->set_timer_wheel(&timer_wheel_);
+  const ReconnectThrottle::Ptr& reconnect_throttle =
+      settings_.connection_pool_settings.reconnect_throttle;
+  if (reconnect_throttle && reconnect_throttle->has_warmup()) {
+    request_handler->set_reconnect_throttle(reconnect_throttle);
+  }
+  if (profile.tracing_probability() > 0.0 && is_tracing_sampled(profile.tracing_probability())) {
+    request_handler->set_tracing_sampled();
+  }
+  request_handler->init(profile, connection_pool_manager_.get(), token_map_.get(),
+                        settings_.timestamp_generator.get(), this);
+  request_handler->execute();
+}
+
+bool RequestProcessor::is_tracing_sampled(double probability) {
+  // A xorshift generator; sampling only needs to be cheap, not high quality.
+  uint64_t x = tracing_random_state_;
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  tracing_random_state_ = x;
+  // The top 53 bits as a uniform double in [0, 1)
+  return static_cast<double>(x >> 11) * (1.0 / 9007199254740992.0) < probability;
+}
+
 bool RequestProcessor::write_wait_callback(const RequestHandler::Ptr& request_handler,
                                            const Host::Ptr& current_host,
                                            const RequestCallback::Ptr& callback) {
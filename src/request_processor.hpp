@@ -18,6 +18,8 @@
 #define DATASTAX_INTERNAL_REQUEST_PROCESSOR_HPP
 
 #include "atomic.hpp"
+#include "circuit_breaker.hpp"
+#include "concurrency_limiter.hpp"
 #include "config.hpp"
 #include "connection_pool_manager.hpp"
 #include "event_loop.hpp"
@@ -25,12 +27,13 @@
 #include "host.hpp"
 #include "loop_watcher.hpp"
 #include "micro_timer.hpp"
-#include "mpmc_queue.hpp"
 #include "prepare_host_handler.hpp"
 #include "random.hpp"
+#include "request_queue.hpp"
 #include "schema_agreement_handler.hpp"
 #include "scoped_ptr.hpp"
 #include "timer.hpp"
+#include "timer_wheel.hpp"
 #include "token_map.hpp"
 
 namespace datastax { namespace internal { namespace core {
@@ -104,6 +107,16 @@ public:
    * @param processor The processor object.
    */
   virtual void on_close(RequestProcessor* processor) = 0;
+
+  /**
+   * A callback that's called when a host responds with UNPREPARED. The
+   * cached prepared statements can be prepared again on the host.
+   *
+   * Note: This is called from the processor's event loop thread.
+   *
+   * @param host The host.
+   */
+  virtual void on_host_unprepared(const Host::Ptr& host) {}
 };
 
 struct RequestProcessorSettings {
@@ -115,27 +128,108 @@ struct RequestProcessorSettings {
 
   unsigned max_schema_wait_time_ms;
 
+  unsigned schema_agreement_interval_ms;
+
+  unsigned max_schema_agreement_interval_ms;
+
   bool prepare_on_all_hosts;
 
   TimestampGenerator::Ptr timestamp_generator;
 
+  RetryBudget::Ptr retry_budget;
+
+  CircuitBreaker::Ptr circuit_breaker;
+
+  ConcurrencyLimiter::Ptr concurrency_limiter;
+
+  bool host_and_profile_metrics;
+
   ExecutionProfile default_profile;
 
   ExecutionProfile::Map profiles;
 
   unsigned request_queue_size;
 
+  // Spill requests over the request queue size into an overflow list instead
+  // of failing them
+  bool request_queue_overflow;
+
+  // The number of application threads given their own request queue lane
+  unsigned producer_lanes;
+
+  // The number of normal priority requests started for each low priority
+  // request while both are queued
+  unsigned low_priority_weight;
+
+  // The stream IDs of each connection that low priority requests can't use
+  size_t reserved_streams;
+
   uint64_t coalesce_delay_us;
 
   int new_request_ratio;
 
+  CassCoalesceMode coalesce_mode;
+
+  uint64_t coalesce_latency_budget_us;
+
   uint64_t max_tracing_wait_time_ms;
 
   uint64_t retry_tracing_wait_time_ms;
 
   CassConsistency tracing_consistency;
 
+  // Whether to set the response of a traced request only once its tracing
+  // data is available. Otherwise, the tracing data is waited for after the
+  // response is set.
+  bool tracing_wait_for_data;
+
   AddressFactory::Ptr address_factory;
+
+  // Preallocate the event loop's buffer pools on its own (pinned) thread
+  bool numa_local_pools;
+
+  // Place the event loop's pooled buffers in memory backed by huge pages
+  bool huge_page_buffers;
+
+  // The time in-flight requests are drained when closing before the
+  // connections are closed anyway. Zero waits for all of them.
+  uint64_t close_timeout_ms;
+};
+
+/**
+ * Determines how long new requests are coalesced before they're written. In
+ * the fixed mode the delay is always the configured coalesce delay. In the
+ * adaptive mode the delay is shrunk when there's little load, so that requests
+ * aren't held back needlessly, and grown when requests are backing up, so that
+ * more of them are written together, but never beyond half of the latency
+ * budget.
+ */
+class CoalesceDelay {
+public:
+  CoalesceDelay(const RequestProcessorSettings& settings);
+
+  /**
+   * The current delay.
+   *
+   * @return The delay in microseconds.
+   */
+  uint64_t delay_us() const { return delay_us_; }
+
+  /**
+   * Update the delay using the load observed during the last coalescing
+   * window.
+   *
+   * @param io_time_ns The time spent doing I/O during the window.
+   * @param processed The number of requests processed after the window.
+   * @param has_backlog True if requests are still queued after processing.
+   */
+  void update(uint64_t io_time_ns, int processed, bool has_backlog);
+
+private:
+  const bool is_adaptive_;
+  const uint64_t min_delay_us_;
+  const uint64_t max_delay_us_;
+  uint64_t delay_us_;
 };
 
 /**
@@ -164,7 +258,8 @@ public:
    * @param hosts A mapping of the currently available hosts.
    * @param token_map The current token map.
    * @param settings The current settings for the request processor.
-   * @param random A RNG for randomizing hosts in the load balancing policies.
+   * @param random A RNG used to seed the processor's own RNG for randomizing
+   * hosts in the load balancing policies. If NULL, hosts aren't randomized.
    * @param local_dc The local datacenter for initializing the load balancing policies.
    * @param local_rack The local rack for initializing the load balancing policies.
    */
@@ -241,13 +336,38 @@ public:
   void notify_token_map_updated(const TokenMap::Ptr& token_map);
 
   /**
-   * Enqueue a request to be processed.
+   * Replace a named execution profile. The requests that are already being
+   * executed keep using the previous profile's settings
+   * (thread-safe, asynchronous).
+   *
+   * @param name The name of an existing execution profile.
+   * @param profile The new profile with its settings initialized from the
+   * default profile.
+   * @param hosts The current hosts used to initialize the new profile's load
+   * balancing policy.
+   */
+  void notify_execution_profile_updated(const String& name, const ExecutionProfile& profile,
+                                        const HostMap& hosts);
+
+  /**
+   * Enqueue a request to be processed. Low priority requests are queued
+   * separately.
    * (thread-safe, asynchronous)).
    *
    * @param request_handler
    */
   void process_request(const RequestHandler::Ptr& request_handler);
 
+  /**
+   * Enqueue a group of requests to be processed. The requests are added to
+   * the queue with a single operation (per priority) and the processor is
+   * woken up once for the whole group instead of once per request.
+   * (thread-safe, asynchronous)).
+   *
+   * @param request_handlers
+   */
+  void process_request_group(const Vector<RequestHandler::Ptr>& request_handlers);
+
   /**
    * Get the number of requests the processor is handling
    *
@@ -255,6 +375,46 @@ public:
    */
   int request_count() const { return request_count_.load(MEMORY_ORDER_RELAXED); }
 
+  /**
+   * Get the approximate number of requests waiting in the request queue
+   *
+   * @return Queued request count
+   */
+  size_t queued_request_count() const {
+    return request_queue_->size() + low_priority_queue_->size();
+  }
+
+  /**
+   * Get the number of coalesced batches of requests that were written and
+   * flushed together. Dividing the batched request count by this gives the
+   * average batch size.
+   *
+   * @return Batch count
+   */
+  uint64_t batch_count() const { return batch_count_.load(MEMORY_ORDER_RELAXED); }
+
+  /**
+   * Get the number of requests written in coalesced batches.
+   *
+   * @return Batched request count
+   */
+  uint64_t batched_request_count() const {
+    return batched_request_count_.load(MEMORY_ORDER_RELAXED);
+  }
+
+  /**
+   * Get a measure of how loaded the processor is, used to balance new
+   * requests across processors. This combines the number of requests the
+   * processor is handling with how busy its event loop has recently been, so
+   * that a processor whose event loop is saturated (e.g. by the responses of a
+   * hot partition) receives fewer new requests.
+   *
+   * @return The load (lower is less loaded)
+   */
+  int64_t load() const {
+    return static_cast<int64_t>(request_count() + 1) * (1000 + event_loop_->utilization());
+  }
+
 public:
   class Protected {
     friend class RequestProcessorInitializer;
@@ -293,6 +453,9 @@ private:
                                             const Response::Ptr& response);
   virtual bool on_prepare_all(const RequestHandler::Ptr& request_handler,
                               const Host::Ptr& current_host, const Response::Ptr& response);
+  virtual void on_next_page(const RequestHandler::Ptr& request_handler);
+  virtual void on_request_sent(const Host::Ptr& host);
+  virtual void on_host_unprepared(const Host::Ptr& host);
   virtual void on_done();
 
 private:
@@ -302,11 +465,14 @@ private:
 
 private:
   void on_timeout(MicroTimer* timer);
+  void on_close_timeout(WheelTimer* timer);
 
 private:
   void internal_close();
+  void fail_pending_requests();
   void internal_pool_down(const Address& address);
 
+  const ExecutionProfile* execution_profile(const Request* request) const;
   const ExecutionProfile* execution_profile(const String& name) const;
   const LoadBalancingPolicy::Vec& load_balancing_policies() const;
 
@@ -317,43 +483,102 @@ private:
   friend class ProcessorNotifyHostReady;
   friend class ProcessorNotifyMaybeHostUp;
   friend class ProcessorNotifyTokenMapUpdate;
+  friend class ProcessorNotifyExecutionProfileUpdate;
 
 private:
   void internal_host_add(const Host::Ptr& host);
+  void internal_execution_profile_update(const String& name, const ExecutionProfile& profile,
+                                         const HostMap& hosts);
   void internal_host_remove(const Host::Ptr& host);
   void internal_host_ready(const Host::Ptr& host);
   void internal_host_maybe_up(const Address& address);
 
   void start_coalescing();
+  bool enqueue(const RequestHandler::Ptr& request_handler);
+  size_t enqueue(RequestQueue* queue, const Vector<RequestHandler*>& request_handlers);
+  void maybe_wakeup();
   void on_async(Async* async);
   void on_prepare(Prepare* prepare);
+  void on_check(Check* check);
+  void on_idle(Idle* idle);
+  void record_batch(int processed);
 
   void maybe_close(int request_count);
   int process_requests(uint64_t processing_time);
+  size_t dequeue_requests(RequestHandler** request_handlers, size_t count);
+  bool is_request_queue_empty() const {
+    return request_queue_->is_empty() && low_priority_queue_->is_empty();
+  }
+  int process_delayed_requests();
+  void execute_request(RequestHandler* request_handler, const ExecutionProfile& profile);
+  bool is_tracing_sampled(double probability);
 
   bool write_wait_callback(const RequestHandler::Ptr& request_handler,
                            const Host::Ptr& current_host, const RequestCallback::Ptr& callback);
 
+private:
+  /**
+   * A request that's waiting for its profile's rate limit.
+   */
+  struct DelayedRequest {
+    DelayedRequest(uint64_t start_ns, RequestHandler* request_handler,
+                   const ExecutionProfile* profile)
+        : start_ns(start_ns)
+        , request_handler(request_handler)
+        , profile(profile) {}
+
+    // Orders the heap so that the request that starts first is on top
+    bool operator<(const DelayedRequest& other) const { return start_ns > other.start_ns; }
+
+    uint64_t start_ns;
+    RequestHandler* request_handler; // Holds a reference
+    const ExecutionProfile* profile;
+  };
+
 private:
   ConnectionPoolManager::Ptr connection_pool_manager_;
   String connect_keyspace_;
   RequestProcessorListener* listener_;
   EventLoop* const event_loop_;
   LoadBalancingPolicy::Vec load_balancing_policies_;
+  LoadBalancingPolicy::Vec retired_load_balancing_policies_; // Replaced by profile updates
   const RequestProcessorSettings settings_;
   ExecutionProfile default_profile_;
   ExecutionProfile::Map profiles_;
+  ExecutionProfile::ConstVec indexed_profiles_; // The profiles by handle
   Atomic<int> request_count_;
-  ScopedPtr<MPMCQueue<RequestHandler*> > const request_queue_;
+  ScopedPtr<RequestQueue> const request_queue_;
+  ScopedPtr<RequestQueue> const low_priority_queue_;
+  unsigned normal_since_low_priority_;
   TokenMap::Ptr token_map_;
+  String local_dc_;
+  String local_rack_;
 
   bool is_closing_;
   Atomic<bool> is_processing_;
+  // Set while the event loop may be blocked waiting for events. Producers only
+  // signal the async handle while it's set, otherwise they leave a pending
+  // wake-up that's handled before the loop blocks again.
+  Atomic<bool> is_sleeping_;
+  Atomic<bool> is_wakeup_pending_;
   int attempts_without_requests_;
   uint64_t io_time_during_coalesce_;
+  uint64_t tracing_random_state_;
+  // Only used on the processor's event loop so query plans are randomized
+  // without locking the session's RNG
+  Random random_;
+  bool is_randomized_; // The load balancing policies randomize hosts
+  CoalesceDelay coalesce_delay_;
+  Atomic<uint64_t> batch_count_;
+  Atomic<uint64_t> batched_request_count_;
   Async async_;
   Prepare prepare_;
+  Check check_;
+  Idle idle_; // Keeps the loop from blocking while a wake-up is pending
   MicroTimer timer_;
+  Vector<DelayedRequest> delayed_requests_; // A heap ordered by start time
+  TimerWheel timer_wheel_; // For the request timeouts and speculative executions
+  WheelTimer close_timer_;
 
 #ifdef CASS_INTERNAL_DIAGNOSTICS
   int reads_during_coalesce_;
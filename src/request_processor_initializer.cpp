@@ -39,8 +39,8 @@ private:
 }}} // namespace datastax::internal::core
 
 RequestProcessorInitializer::RequestProcessorInitializer(
-    const Host::Ptr& connected_host, ProtocolVersion protocol_version, const HostMap& hosts,
-    const TokenMap::Ptr& token_map, const String& local_dc, const String& local_rack, const Callback& callback)
+    const Host::Ptr& connected_host, ProtocolVersion protocol_version,
+    const HostTable::ConstPtr& hosts, const TokenMap::Ptr& token_map, const String& local_dc, const String& local_rack, const Callback& callback)
     : event_loop_(NULL)
     , listener_(NULL)
     , metrics_(NULL)
@@ -123,6 +123,53 @@ void RequestProcessorInitializer::on_close(ConnectionPoolManager* manager) {
 
 void RequestProcessorInitializer::internal_initialize() {
   inc_ref();
+  // Connections on the same event loop share read buffers, response bodies and
+  // SSL buffers
+  settings_.connection_pool_settings.connection_settings.buffer_pool.reset(
+      new BufferPool(metrics_, settings_.huge_page_buffers));
+  SocketSettings& socket_settings =
+      settings_.connection_pool_settings.connection_settings.socket_settings;
+  if (socket_settings.ssl_context) {
+    socket_settings.ssl_chunk_pool.reset(
+        new rb::ChunkPool(socket_settings.ssl_context->buffer_size(),
+                          rb::ChunkPool::DEFAULT_MAX_FREE_CHUNKS, settings_.huge_page_buffers));
+  }
+  // This runs on the event loop's thread, after it's been pinned, so the
+  // buffers are placed on the NUMA node of its CPUs
+  if (settings_.numa_local_pools) {
+    settings_.connection_pool_settings.connection_settings.buffer_pool->preallocate();
+    if (socket_settings.ssl_chunk_pool) {
+      socket_settings.ssl_chunk_pool->preallocate();
+    }
+  }
+#ifdef HAVE_IO_URING
+  if (socket_settings.io_uring_enabled) {
+    socket_settings.io_uring = event_loop_->io_uring();
+  }
+#endif
+
+  // Only the hosts that the default profile's load balancing policy considers
+  // local are connected up front if the remote hosts' pools are sized
+  // differently or connected on first use. The processor adds the other hosts
+  // once its load balancing policies are built.
+  const HostMap* hosts = &hosts_->hosts();
+  HostMap local_hosts;
+  const ConnectionPoolSettings& pool_settings = settings_.connection_pool_settings;
+  if (pool_settings.lazy_remote_pools || pool_settings.num_connections_per_remote_host > 0) {
+    ExecutionProfile profile(settings_.default_profile);
+    profile.build_load_balancing_policy();
+    const LoadBalancingPolicy::Ptr& policy = profile.load_balancing_policy();
+    policy->init(connected_host_, *hosts, NULL, local_dc_, local_rack_);
+    for (HostMap::const_iterator it = hosts->begin(), end = hosts->end(); it != end; ++it) {
+      if (policy->distance(it->second) == CASS_HOST_DISTANCE_LOCAL) {
+        local_hosts.insert(*it);
+      }
+    }
+    if (!local_hosts.empty()) {
+      hosts = &local_hosts;
+    }
+  }
+
   connection_pool_manager_initializer_.reset(new ConnectionPoolManagerInitializer(
       protocol_version_, bind_callback(&RequestProcessorInitializer::on_initialize, this)));
 
@@ -130,13 +177,15 @@ void RequestProcessorInitializer::internal_initialize() {
       ->with_listener(this)
       ->with_keyspace(keyspace_)
       ->with_metrics(metrics_)
-      ->initialize(event_loop_->loop(), hosts_);
+      ->initialize(event_loop_->loop(), *hosts);
 }
 
 void RequestProcessorInitializer::on_initialize(ConnectionPoolManagerInitializer* initializer) {
   bool is_keyspace_error = false;
 
-  // Prune hosts
+  // Prune hosts, the shared snapshot is only copied if a host failed
+  const HostMap* hosts = &hosts_->hosts();
+  HostMap pruned;
   const ConnectionPoolConnector::Vec& failures = initializer->failures();
   for (ConnectionPoolConnector::Vec::const_iterator it = failures.begin(), end = failures.end();
        it != end; ++it) {
@@ -145,7 +194,11 @@ void RequestProcessorInitializer::on_initialize(ConnectionPoolManagerInitializer
       is_keyspace_error = true;
       break;
     } else {
-      hosts_.erase(connector->address());
+      if (hosts != &pruned) {
+        pruned = *hosts;
+        hosts = &pruned;
+      }
+      pruned.erase(connector->address());
     }
   }
 
@@ -153,12 +206,12 @@ void RequestProcessorInitializer::on_initialize(ConnectionPoolManagerInitializer
   if (is_keyspace_error) {
     error_code_ = REQUEST_PROCESSOR_ERROR_KEYSPACE;
     error_message_ = "Keyspace '" + keyspace_ + "' does not exist";
-  } else if (hosts_.empty()) {
+  } else if (hosts->empty()) {
     error_code_ = REQUEST_PROCESSOR_ERROR_NO_HOSTS_AVAILABLE;
     error_message_ = "Unable to connect to any hosts";
   } else {
     processor_.reset(new RequestProcessor(listener_, event_loop_, initializer->release_manager(),
-                                          connected_host_, hosts_, token_map_, settings_, random_,
+                                          connected_host_, *hosts, token_map_, settings_, random_,
                                           local_dc_, local_rack_));
 
     int rc = processor_->init(RequestProcessor::Protected());
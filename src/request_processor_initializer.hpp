@@ -57,7 +57,8 @@ public:
    *
    * @param connected_host The currently connected control connection host.
    * @param protocol_version The highest negotiated protocol for the cluster.
-   * @param hosts A mapping of available hosts in the cluster.
+   * @param hosts A snapshot of the available hosts in the cluster. The
+   * snapshot is shared, not copied, by the request processors.
    * @param token_map A token map.
    * @param local_dc The local datacenter for initializing the load balancing policies.
    * @param local_rack The local datacenter for initializing the load balancing policies.
@@ -65,7 +66,7 @@ public:
    * or if an error occurred.
    */
   RequestProcessorInitializer(const Host::Ptr& connected_host, ProtocolVersion protocol_version,
-                              const HostMap& hosts, const TokenMap::Ptr& token_map,
+                              const HostTable::ConstPtr& hosts, const TokenMap::Ptr& token_map,
                               const String& local_dc, const String& local_rack, const Callback& callback);
   ~RequestProcessorInitializer();
 
@@ -165,7 +166,7 @@ private:
 
   const Host::Ptr connected_host_;
   const ProtocolVersion protocol_version_;
-  HostMap hosts_;
+  const HostTable::ConstPtr hosts_;
   const TokenMap::Ptr token_map_;
   String local_dc_;
   String local_rack_;
@@ -0,0 +1,177 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "request_queue.hpp"
+
+#include "scoped_lock.hpp"
+
+#include <algorithm>
+
+// The number of overflow requests moved into the bounded queue at a time
+#define MOVE_OVERFLOW_BATCH_SIZE 64
+
+// The size of each producer thread's lane
+#define LANE_SIZE 1024
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+RequestQueue::RequestQueue(size_t size, bool allow_overflow, size_t max_lanes)
+    : queue_(size)
+    , allow_overflow_(allow_overflow)
+    , overflow_count_(0)
+    , max_lanes_(max_lanes)
+    , lanes_(max_lanes, NULL)
+    , lane_count_(0)
+    , next_source_(0) {
+  uv_mutex_init(&mutex_);
+  if (max_lanes_ > 0) {
+    uv_key_create(&lane_key_);
+  }
+}
+
+RequestQueue::~RequestQueue() {
+  for (size_t i = 0; i < lane_count_.load(); ++i) {
+    delete lanes_[i];
+  }
+  if (max_lanes_ > 0) {
+    uv_key_delete(&lane_key_);
+  }
+  uv_mutex_destroy(&mutex_);
+}
+
+bool RequestQueue::enqueue(RequestHandler* request_handler) {
+  if (max_lanes_ > 0) {
+    Lane* lane = current_lane();
+    if (lane && lane->enqueue(request_handler)) {
+      return true;
+    }
+  }
+
+  // Requests are added to the overflow while it's not empty so that they're
+  // not processed before the requests that overflowed earlier.
+  if (overflow_count_.load(MEMORY_ORDER_ACQUIRE) == 0 && queue_.enqueue(request_handler)) {
+    return true;
+  }
+  if (!allow_overflow_) return false;
+
+  ScopedMutex l(&mutex_);
+  overflow_.push_back(request_handler);
+  overflow_count_.fetch_add(1, MEMORY_ORDER_RELEASE);
+  return true;
+}
+
+size_t RequestQueue::enqueue(RequestHandler* const* request_handlers, size_t count) {
+  size_t enqueued = 0;
+  if (overflow_count_.load(MEMORY_ORDER_ACQUIRE) == 0) {
+    enqueued = queue_.enqueue(request_handlers, count);
+  }
+  if (enqueued == count || !allow_overflow_) return enqueued;
+
+  ScopedMutex l(&mutex_);
+  overflow_.insert(overflow_.end(), request_handlers + enqueued, request_handlers + count);
+  overflow_count_.fetch_add(count - enqueued, MEMORY_ORDER_RELEASE);
+  return count;
+}
+
+size_t RequestQueue::dequeue(RequestHandler** request_handlers, size_t count) {
+  size_t lane_count = lane_count_.load(MEMORY_ORDER_ACQUIRE);
+  if (lane_count == 0) {
+    return dequeue_shared(request_handlers, count);
+  }
+
+  // The shared queue is source zero and the lanes are the rest
+  size_t source_count = lane_count + 1;
+  size_t first = next_source_++ % source_count;
+  size_t dequeued = 0;
+  for (size_t i = 0; i < source_count && dequeued < count; ++i) {
+    size_t source = (first + i) % source_count;
+    if (source == 0) {
+      dequeued += dequeue_shared(request_handlers + dequeued, count - dequeued);
+    } else {
+      Lane* lane = lanes_[source - 1];
+      while (dequeued < count && lane->dequeue(request_handlers[dequeued])) {
+        dequeued++;
+      }
+    }
+  }
+  return dequeued;
+}
+
+bool RequestQueue::is_empty() const {
+  if (!queue_.is_empty() || overflow_count_.load(MEMORY_ORDER_ACQUIRE) > 0) {
+    return false;
+  }
+  for (size_t i = 0, lane_count = lane_count_.load(MEMORY_ORDER_ACQUIRE); i < lane_count; ++i) {
+    if (!lanes_[i]->is_empty()) return false;
+  }
+  return true;
+}
+
+size_t RequestQueue::size() const {
+  size_t size = queue_.size() + overflow_count_.load(MEMORY_ORDER_RELAXED);
+  for (size_t i = 0, lane_count = lane_count_.load(MEMORY_ORDER_ACQUIRE); i < lane_count; ++i) {
+    size += lanes_[i]->size();
+  }
+  return size;
+}
+
+size_t RequestQueue::dequeue_shared(RequestHandler** request_handlers, size_t count) {
+  size_t dequeued = queue_.dequeue(request_handlers, count);
+  if (overflow_count_.load(MEMORY_ORDER_ACQUIRE) > 0) {
+    move_overflow();
+    if (dequeued < count) {
+      dequeued += queue_.dequeue(request_handlers + dequeued, count - dequeued);
+    }
+  }
+  return dequeued;
+}
+
+void RequestQueue::move_overflow() {
+  RequestHandler* batch[MOVE_OVERFLOW_BATCH_SIZE];
+
+  ScopedMutex l(&mutex_);
+  while (!overflow_.empty()) {
+    size_t count = std::min(overflow_.size(), static_cast<size_t>(MOVE_OVERFLOW_BATCH_SIZE));
+    std::copy(overflow_.begin(), overflow_.begin() + count, batch);
+    size_t enqueued = queue_.enqueue(batch, count);
+    overflow_.erase(overflow_.begin(), overflow_.begin() + enqueued);
+    overflow_count_.fetch_sub(enqueued, MEMORY_ORDER_RELEASE);
+    if (enqueued < count) break; // The bounded queue is full
+  }
+}
+
+RequestQueue::Lane* RequestQueue::current_lane() {
+  // The key's value is the index of the thread's lane plus one. Threads that
+  // weren't given a lane have an index past the last lane.
+  void* value = uv_key_get(&lane_key_);
+  if (value == NULL) {
+    ScopedMutex l(&mutex_);
+    size_t index = lane_count_.load(MEMORY_ORDER_RELAXED);
+    if (index < max_lanes_) {
+      lanes_[index] = new Lane(LANE_SIZE);
+      lane_count_.store(index + 1, MEMORY_ORDER_RELEASE);
+    } else {
+      index = max_lanes_;
+    }
+    value = reinterpret_cast<void*>(index + 1);
+    uv_key_set(&lane_key_, value);
+  }
+
+  size_t index = reinterpret_cast<size_t>(value) - 1;
+  return index < max_lanes_ ? lanes_[index] : NULL;
+}
@@ -0,0 +1,121 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_REQUEST_QUEUE_HPP
+#define DATASTAX_INTERNAL_REQUEST_QUEUE_HPP
+
+#include "allocated.hpp"
+#include "atomic.hpp"
+#include "deque.hpp"
+#include "macros.hpp"
+#include "mpmc_queue.hpp"
+#include "spsc_queue.hpp"
+#include "vector.hpp"
+
+#include <uv.h>
+
+namespace datastax { namespace internal { namespace core {
+
+class RequestHandler;
+
+/**
+ * The queue of requests waiting to be processed by an I/O thread. It's a
+ * bounded, lock-free queue that, if allowed, spills requests that don't fit
+ * into an unbounded overflow list instead of rejecting them. The overflow is
+ * moved back into the bounded queue as the requests are dequeued.
+ *
+ * The first producer threads can also be given their own single-producer
+ * queue (lane) so that they don't contend on the shared queue. A thread is
+ * given a lane the first time it enqueues a request and keeps it for the life
+ * of the queue.
+ */
+class RequestQueue : public Allocated {
+public:
+  /**
+   * Constructor.
+   *
+   * @param size The size of the bounded queue.
+   * @param allow_overflow If true, requests that don't fit into the bounded
+   * queue are added to the overflow list, otherwise they're rejected.
+   * @param max_lanes The maximum number of producer threads given a lane.
+   */
+  RequestQueue(size_t size, bool allow_overflow, size_t max_lanes = 0);
+  ~RequestQueue();
+
+  /**
+   * Enqueue a request. This can be called on any thread.
+   *
+   * @param request_handler The request.
+   * @return true if the request was queued, false if the queue was full.
+   */
+  bool enqueue(RequestHandler* request_handler);
+
+  /**
+   * Enqueue requests, in order, with a single operation on the shared queue.
+   * This can be called on any thread.
+   *
+   * @param request_handlers The requests.
+   * @param count The number of requests.
+   * @return The number of requests queued. The requests after them were
+   * rejected because the queue was full.
+   */
+  size_t enqueue(RequestHandler* const* request_handlers, size_t count);
+
+  /**
+   * Dequeue requests. The shared queue and the lanes take turns to be
+   * dequeued first. This must only be called on a single (consumer) thread.
+   *
+   * @param request_handlers The dequeued requests.
+   * @param count The maximum number of requests to dequeue.
+   * @return The number of requests dequeued.
+   */
+  size_t dequeue(RequestHandler** request_handlers, size_t count);
+
+  bool is_empty() const;
+
+  /**
+   * An approximation of the number of queued requests, including the
+   * overflow and the lanes.
+   */
+  size_t size() const;
+
+private:
+  typedef SPSCQueue<RequestHandler*> Lane;
+
+  size_t dequeue_shared(RequestHandler** request_handlers, size_t count);
+  void move_overflow();
+  Lane* current_lane();
+
+private:
+  MPMCQueue<RequestHandler*> queue_;
+  const bool allow_overflow_;
+  uv_mutex_t mutex_;
+  Deque<RequestHandler*> overflow_;
+  Atomic<size_t> overflow_count_;
+
+  const size_t max_lanes_;
+  uv_key_t lane_key_;
+  Vector<Lane*> lanes_; // Sized up front so it's never reallocated
+  Atomic<size_t> lane_count_;
+  size_t next_source_; // Only used by the consumer
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(RequestQueue);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
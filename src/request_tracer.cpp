@@ -0,0 +1,75 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "request_tracer.hpp"
+
+#include "slow_request_log.hpp"
+
+using namespace datastax;
+using namespace datastax::internal::core;
+
+extern "C" {
+
+CassRequestTraceEventType cass_request_trace_event_type(const CassRequestTraceEvent* event) {
+  return event->type;
+}
+
+cass_uint64_t cass_request_trace_event_request_id(const CassRequestTraceEvent* event) {
+  return event->request_id;
+}
+
+cass_uint64_t cass_request_trace_event_timestamp(const CassRequestTraceEvent* event) {
+  return event->timestamp_ns;
+}
+
+CassError cass_request_trace_event_host(const CassRequestTraceEvent* event, CassInet* address) {
+  if (event->host == NULL) {
+    return CASS_ERROR_LIB_NO_HOSTS_AVAILABLE;
+  }
+  address->address_length = event->host->to_inet(address->address);
+  return CASS_OK;
+}
+
+CassError cass_request_trace_event_error_code(const CassRequestTraceEvent* event) {
+  return event->error_code;
+}
+
+void cass_request_trace_event_query(CassRequestTraceEvent* event, const char** query,
+                                    size_t* query_length) {
+  const String& description = event->query();
+  *query = description.data();
+  *query_length = description.size();
+}
+
+void cass_request_trace_event_set_span(CassRequestTraceEvent* event, void* span) {
+  *event->span = span;
+}
+
+void* cass_request_trace_event_span(const CassRequestTraceEvent* event) { return *event->span; }
+
+} // extern "C"
+
+const String& RequestTraceEvent::query() {
+  if (!is_query_built_) {
+    query_ = SlowRequest::describe(request_);
+    is_query_built_ = true;
+  }
+  return query_;
+}
+
+void RequestTracer::trace(RequestTraceEvent* event) const {
+  callback_(CassRequestTraceEvent::to(event), data_);
+}
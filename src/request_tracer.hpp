@@ -0,0 +1,104 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_REQUEST_TRACER_HPP
+#define DATASTAX_INTERNAL_REQUEST_TRACER_HPP
+
+#include "address.hpp"
+#include "atomic.hpp"
+#include "cassandra.h"
+#include "external.hpp"
+#include "ref_counted.hpp"
+#include "string.hpp"
+
+#include <uv.h>
+
+namespace datastax { namespace internal { namespace core {
+
+class Request;
+
+/**
+ * An event in the execution of a request that's passed to the application's
+ * tracer. It only lives for the duration of the tracer's callback.
+ */
+class RequestTraceEvent {
+public:
+  RequestTraceEvent(CassRequestTraceEventType type, uint64_t request_id, const Request* request,
+                    void** span)
+      : type(type)
+      , request_id(request_id)
+      , timestamp_ns(uv_hrtime())
+      , host(NULL)
+      , error_code(CASS_OK)
+      , span(span)
+      , request_(request)
+      , is_query_built_(false) {}
+
+  /**
+   * The request's query (see SlowRequest::describe()). It's only built the
+   * first time it's used.
+   */
+  const String& query();
+
+  const CassRequestTraceEventType type;
+  const uint64_t request_id;
+  const uint64_t timestamp_ns;
+  const Address* host; // NULL if the event isn't for a specific host
+  CassError error_code;
+  void** const span; // The tracer's data for the request
+
+private:
+  const Request* request_;
+  String query_;
+  bool is_query_built_;
+};
+
+/**
+ * Passes the events of each request's execution to the application's tracer:
+ * the request's start, each execution attempt on a host, retries,
+ * speculative executions and the request's completion. Requests aren't
+ * traced when no tracer is registered.
+ */
+class RequestTracer : public RefCounted<RequestTracer> {
+public:
+  typedef SharedRefPtr<RequestTracer> Ptr;
+
+  RequestTracer(CassRequestTracerCallback callback, void* data)
+      : callback_(callback)
+      , data_(data)
+      , last_request_id_(0) {}
+
+  /**
+   * Get a new request ID. The IDs start at 1 and are unique within a session.
+   */
+  uint64_t next_request_id() { return last_request_id_.fetch_add(1, MEMORY_ORDER_RELAXED) + 1; }
+
+  void trace(RequestTraceEvent* event) const;
+
+private:
+  const CassRequestTracerCallback callback_;
+  void* const data_;
+  Atomic<uint64_t> last_request_id_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(RequestTracer);
+};
+
+}}} // namespace datastax::internal::core
+
+EXTERNAL_TYPE(datastax::internal::core::RequestTraceEvent, CassRequestTraceEvent)
+
+#endif
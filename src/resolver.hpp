@@ -20,6 +20,7 @@
 #include "address.hpp"
 #include "callback.hpp"
 #include "ref_counted.hpp"
+#include "resolver_cache.hpp"
 #include "string.hpp"
 #include "timer.hpp"
 #include "vector.hpp"
@@ -47,11 +48,15 @@ public:
     SUCCESS
   };
 
-  Resolver(const String& hostname, int port, const Callback& callback)
+  Resolver(const String& hostname, int port, const Callback& callback,
+           const ResolverCache::Ptr& cache = ResolverCache::Ptr())
       : hostname_(hostname)
       , port_(port)
       , status_(NEW)
-      , callback_(callback) {
+      , uv_status_(-1)
+      , is_cached_(false)
+      , callback_(callback)
+      , cache_(cache) {
     req_.data = this;
   }
 
@@ -66,6 +71,9 @@ public:
   Status status() { return status_; }
   int uv_status() { return uv_status_; }
 
+  // True if the result came from the cache
+  bool is_cached() const { return is_cached_; }
+
   const AddressVec& addresses() const { return addresses_; }
 
   void resolve(uv_loop_t* loop, uint64_t timeout, struct addrinfo* hints = NULL) {
@@ -73,6 +81,14 @@ public:
 
     inc_ref(); // For the event loop
 
+    if (cache_ && cache_->get_addresses(hostname_, port_, &addresses_, &uv_status_)) {
+      // Finish on the next iteration of the loop, like a lookup, because the
+      // callback can destroy the caller.
+      is_cached_ = true;
+      timer_.start(loop, 0, bind_callback(&Resolver::on_cached, this));
+      return;
+    }
+
     // If no hints are provided then use a default filter.
     struct addrinfo default_hints;
     if (hints == NULL) {
@@ -101,8 +117,12 @@ public:
 
   void cancel() {
     if (status_ == RESOLVING) {
-      uv_cancel(reinterpret_cast<uv_req_t*>(&req_));
-      timer_.stop();
+      if (is_cached_) { // A cached result still finishes using the timer
+        addresses_.clear();
+      } else {
+        uv_cancel(reinterpret_cast<uv_req_t*>(&req_));
+        timer_.stop();
+      }
       status_ = CANCELED;
     }
   }
@@ -121,6 +141,12 @@ private:
       } else {
         resolver->status_ = SUCCESS;
       }
+
+      if (resolver->cache_ && (resolver->status_ == SUCCESS ||
+                               resolver->status_ == FAILED_UNABLE_TO_RESOLVE)) {
+        resolver->cache_->put_addresses(resolver->hostname_, resolver->port_,
+                                        resolver->addresses_, status);
+      }
     }
 
     resolver->uv_status_ = status;
@@ -135,6 +161,14 @@ private:
     uv_cancel(reinterpret_cast<uv_req_t*>(&req_));
   }
 
+  void on_cached(Timer* timer) {
+    if (status_ == RESOLVING) {
+      status_ = addresses_.empty() ? FAILED_UNABLE_TO_RESOLVE : SUCCESS;
+    }
+    callback_(this);
+    dec_ref();
+  }
+
 private:
   bool init_addresses(struct addrinfo* res) {
     bool status = false;
@@ -156,8 +190,10 @@ private:
   int port_;
   Status status_;
   int uv_status_;
+  bool is_cached_;
   AddressVec addresses_;
   Callback callback_;
+  ResolverCache::Ptr cache_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(Resolver);
@@ -168,9 +204,10 @@ public:
   typedef SharedRefPtr<MultiResolver> Ptr;
   typedef internal::Callback<void, MultiResolver*> Callback;
 
-  MultiResolver(const Callback& callback)
+  MultiResolver(const Callback& callback, const ResolverCache::Ptr& cache = ResolverCache::Ptr())
       : remaining_(0)
-      , callback_(callback) {}
+      , callback_(callback)
+      , cache_(cache) {}
 
   const Resolver::Vec& resolvers() { return resolvers_; }
 
@@ -178,7 +215,7 @@ public:
                struct addrinfo* hints = NULL) {
     inc_ref();
     Resolver::Ptr resolver(
-        new Resolver(host, port, bind_callback(&MultiResolver::on_resolve, this)));
+        new Resolver(host, port, bind_callback(&MultiResolver::on_resolve, this), cache_));
     resolver->resolve(loop, timeout, hints);
     resolvers_.push_back(resolver);
     remaining_++;
@@ -203,6 +240,7 @@ private:
   Resolver::Vec resolvers_;
   int remaining_;
   Callback callback_;
+  ResolverCache::Ptr cache_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(MultiResolver);
@@ -0,0 +1,111 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "resolver_cache.hpp"
+
+#include "get_time.hpp"
+#include "scoped_lock.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+ResolverCache::ResolverCache(uint64_t ttl_ms, uint64_t negative_ttl_ms)
+    : ttl_ns_(ttl_ms * NANOSECONDS_PER_MILLISECOND)
+    , negative_ttl_ns_(negative_ttl_ms * NANOSECONDS_PER_MILLISECOND) {
+  uv_mutex_init(&mutex_);
+}
+
+ResolverCache::~ResolverCache() { uv_mutex_destroy(&mutex_); }
+
+bool ResolverCache::get_addresses(const String& hostname, int port, AddressVec* addresses,
+                                  int* uv_status) {
+  ScopedMutex l(&mutex_);
+  AddressesMap::const_iterator it = addresses_.find(std::make_pair(hostname, port));
+  if (it == addresses_.end() || it->second.expires_ns <= get_time_monotonic_ns()) {
+    return false;
+  }
+  *addresses = it->second.addresses;
+  *uv_status = it->second.uv_status;
+  return true;
+}
+
+void ResolverCache::put_addresses(const String& hostname, int port, const AddressVec& addresses,
+                                  int uv_status) {
+  uint64_t expires = expires_ns(!addresses.empty());
+  if (expires == 0) return;
+
+  ScopedMutex l(&mutex_);
+  remove_expired(get_time_monotonic_ns());
+  AddressesEntry& entry = addresses_[std::make_pair(hostname, port)];
+  entry.addresses = addresses;
+  entry.uv_status = uv_status;
+  entry.expires_ns = expires;
+}
+
+bool ResolverCache::get_hostname(const Address& address, String* hostname, String* service,
+                                 int* uv_status) {
+  ScopedMutex l(&mutex_);
+  HostnameMap::const_iterator it = hostnames_.find(address);
+  if (it == hostnames_.end() || it->second.expires_ns <= get_time_monotonic_ns()) {
+    return false;
+  }
+  *hostname = it->second.hostname;
+  *service = it->second.service;
+  *uv_status = it->second.uv_status;
+  return true;
+}
+
+void ResolverCache::put_hostname(const Address& address, const String& hostname,
+                                 const String& service, int uv_status) {
+  uint64_t expires = expires_ns(!hostname.empty());
+  if (expires == 0) return;
+
+  ScopedMutex l(&mutex_);
+  remove_expired(get_time_monotonic_ns());
+  HostnameEntry& entry = hostnames_[address];
+  entry.hostname = hostname;
+  entry.service = service;
+  entry.uv_status = uv_status;
+  entry.expires_ns = expires;
+}
+
+size_t ResolverCache::size() const {
+  ScopedMutex l(&mutex_);
+  return addresses_.size() + hostnames_.size();
+}
+
+uint64_t ResolverCache::expires_ns(bool is_success) const {
+  uint64_t ttl_ns = is_success ? ttl_ns_ : negative_ttl_ns_;
+  return ttl_ns > 0 ? get_time_monotonic_ns() + ttl_ns : 0;
+}
+
+void ResolverCache::remove_expired(uint64_t now_ns) {
+  for (AddressesMap::iterator it = addresses_.begin(); it != addresses_.end();) {
+    if (it->second.expires_ns <= now_ns) {
+      addresses_.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+  for (HostnameMap::iterator it = hostnames_.begin(); it != hostnames_.end();) {
+    if (it->second.expires_ns <= now_ns) {
+      hostnames_.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+}
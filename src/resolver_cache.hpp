@@ -0,0 +1,132 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_RESOLVER_CACHE_HPP
+#define DATASTAX_INTERNAL_RESOLVER_CACHE_HPP
+
+#include "address.hpp"
+#include "macros.hpp"
+#include "map.hpp"
+#include "ref_counted.hpp"
+#include "string.hpp"
+
+#include <uv.h>
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * A cache of the results of name resolution: the addresses of hostnames
+ * (`uv_getaddrinfo()`) and the hostnames of addresses (`uv_getnameinfo()`).
+ * Failed lookups are also cached (negative caching), for a separate time, so
+ * that an unresolvable name doesn't cause a slow lookup for every reconnect.
+ * Timed out and canceled lookups aren't cached.
+ *
+ * The cache is shared by the connectors of all the event loops so it's
+ * thread-safe.
+ */
+class ResolverCache : public RefCounted<ResolverCache> {
+public:
+  typedef SharedRefPtr<ResolverCache> Ptr;
+
+  /**
+   * Constructor.
+   *
+   * @param ttl_ms The time successful lookups are cached.
+   * @param negative_ttl_ms The time failed lookups are cached.
+   */
+  ResolverCache(uint64_t ttl_ms, uint64_t negative_ttl_ms);
+  ~ResolverCache();
+
+  /**
+   * Get the cached addresses of a hostname.
+   *
+   * @param hostname The hostname.
+   * @param port The port of the addresses.
+   * @param addresses The cached addresses. It's empty if the lookup failed.
+   * @param uv_status The status of the cached lookup.
+   * @return true if the lookup is cached and hasn't expired.
+   */
+  bool get_addresses(const String& hostname, int port, AddressVec* addresses, int* uv_status);
+
+  /**
+   * Cache the result of looking up the addresses of a hostname.
+   *
+   * @param hostname The hostname.
+   * @param port The port of the addresses.
+   * @param addresses The addresses or empty if the lookup failed.
+   * @param uv_status The status of the lookup.
+   */
+  void put_addresses(const String& hostname, int port, const AddressVec& addresses,
+                     int uv_status);
+
+  /**
+   * Get the cached hostname of an address.
+   *
+   * @param address The address.
+   * @param hostname The cached hostname. It's empty if the lookup failed.
+   * @param service The cached service.
+   * @param uv_status The status of the cached lookup.
+   * @return true if the lookup is cached and hasn't expired.
+   */
+  bool get_hostname(const Address& address, String* hostname, String* service, int* uv_status);
+
+  /**
+   * Cache the result of looking up the hostname of an address.
+   *
+   * @param address The address.
+   * @param hostname The hostname or empty if the lookup failed.
+   * @param service The service.
+   * @param uv_status The status of the lookup.
+   */
+  void put_hostname(const Address& address, const String& hostname, const String& service,
+                    int uv_status);
+
+  size_t size() const;
+
+private:
+  struct AddressesEntry {
+    AddressVec addresses;
+    int uv_status;
+    uint64_t expires_ns;
+  };
+
+  struct HostnameEntry {
+    String hostname;
+    String service;
+    int uv_status;
+    uint64_t expires_ns;
+  };
+
+  typedef Map<std::pair<String, int>, AddressesEntry> AddressesMap;
+  typedef Map<Address, HostnameEntry> HostnameMap;
+
+  uint64_t expires_ns(bool is_success) const;
+  void remove_expired(uint64_t now_ns);
+
+private:
+  const uint64_t ttl_ns_;
+  const uint64_t negative_ttl_ns_;
+  mutable uv_mutex_t mutex_;
+  AddressesMap addresses_;
+  HostnameMap hostnames_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ResolverCache);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -17,6 +17,8 @@
 #include "response.hpp"
 
 #include "auth_responses.hpp"
+#include "buffer_pool.hpp"
+#include "compression.hpp"
 #include "error_response.hpp"
 #include "event_response.hpp"
 #include "logger.hpp"
@@ -26,6 +28,12 @@
 
 #include <cstring>
 
+// Bodies smaller than this are copied out of the socket's read buffer so that
+// small, long-lived responses (e.g. prepared metadata) don't keep the whole
+// read buffer alive.
+#define MIN_ZERO_COPY_BODY_SIZE (16 * 1024)
+
+using namespace datastax::internal;
 using namespace datastax::internal::core;
 
 /**
@@ -43,7 +51,8 @@ public:
 };
 
 Response::Response(uint8_t opcode)
-    : opcode_(opcode) {
+    : opcode_(opcode)
+    , data_(NULL) {
   memset(&tracing_id_, 0, sizeof(CassUuid));
 }
 
@@ -98,7 +107,14 @@ bool ResponseMessage::allocate_body(int8_t opcode) {
   }
 }
 
-ssize_t ResponseMessage::decode(const char* input, size_t size) {
+RefBuffer::Ptr ResponseMessage::allocate_buffer(size_t size) {
+  if (buffer_pool_) {
+    return buffer_pool_->acquire(size);
+  }
+  return RefBuffer::Ptr(RefBuffer::create(size, MEMORY_CATEGORY_RESPONSE_BUFFERS));
+}
+
+ssize_t ResponseMessage::decode(const char* input, size_t size, RefBuffer* buffer) {
   const char* input_pos = input;
 
   received_ += size;
@@ -148,9 +164,6 @@ ssize_t ResponseMessage::decode(const char* input, size_t size) {
       } else if (!allocate_body(opcode_) || !response_body_) {
         return -1;
       }
-
-      response_body_->set_buffer(length_);
-      body_buffer_pos_ = response_body_->data();
     } else {
       // We haven't received all the data for the header. We consume the
       // entire buffer.
@@ -168,33 +181,34 @@ ssize_t ResponseMessage::decode(const char* input, size_t size) {
     size_t overage = received_ - frame_size;
     size_t needed = remaining - overage;
 
-    memcpy(body_buffer_pos_, input_pos, needed);
-    body_buffer_pos_ += needed;
-    input_pos += needed;
-    assert(body_buffer_pos_ == response_body_->data() + length_);
-    Decoder decoder(response_body_->data(), length_, ProtocolVersion(version_));
-
-    if (flags_ & CASS_FLAG_TRACING) {
-      if (!response_body_->decode_trace_id(decoder)) return -1;
-    }
-
-    if (flags_ & CASS_FLAG_WARNING) {
-      if (!response_body_->decode_warnings(decoder)) return -1;
-    }
-
-    if (flags_ & CASS_FLAG_CUSTOM_PAYLOAD) {
-      if (!response_body_->decode_custom_payload(decoder)) return -1;
+    const char* body;
+    if (body_buffer_pos_ == NULL) {
+      // The whole body is contained in the input
+      body = input_pos;
+    } else {
+      memcpy(body_buffer_pos_, input_pos, needed);
+      body_buffer_pos_ += needed;
+      body = body_buffer_->data();
+      assert(body_buffer_pos_ == body + length_);
     }
+    input_pos += needed;
 
-    if (!response_body_->decode(decoder)) {
-      is_body_error_ = true;
+    if (opcode_ == CQL_OPCODE_RESULT && deferred_body_threshold_ > 0 &&
+        static_cast<size_t>(length_) >= deferred_body_threshold_) {
+      defer_body(body, buffer);
+    } else if (!decode_body(body, buffer)) {
       return -1;
     }
 
     is_body_ready_ = true;
   } else {
-    // We haven't received all the data for the frame. We consume the entire
-    // buffer.
+    // We haven't received all the data for the frame. The body straddles
+    // reads so it's copied into its own buffer. We consume the entire buffer.
+    if (remaining == 0) return size;
+    if (body_buffer_pos_ == NULL) {
+      body_buffer_ = allocate_buffer(length_);
+      body_buffer_pos_ = body_buffer_->data();
+    }
     memcpy(body_buffer_pos_, input_pos, remaining);
     body_buffer_pos_ += remaining;
     return size;
@@ -202,3 +216,71 @@ ssize_t ResponseMessage::decode(const char* input, size_t size) {
 
   return input_pos - input;
 }
+
+void ResponseMessage::defer_body(const char* body, RefBuffer* buffer) {
+  // The body must outlive the socket's read buffer and it can't be copied
+  // using the buffer pool later because the pool isn't thread-safe.
+  if (!body_buffer_) {
+    if (buffer != NULL && static_cast<size_t>(length_) >= MIN_ZERO_COPY_BODY_SIZE) {
+      deferred_buffer_ = RefBuffer::Ptr(buffer);
+    } else {
+      body_buffer_ = allocate_buffer(length_);
+      memcpy(body_buffer_->data(), body, length_);
+      body = body_buffer_->data();
+    }
+  }
+  deferred_body_ = body;
+  is_body_deferred_ = true;
+}
+
+bool ResponseMessage::decode_deferred_body() {
+  assert(is_body_deferred_);
+  is_body_deferred_ = false;
+  bool is_decoded = decode_body(deferred_body_, deferred_buffer_.get());
+  deferred_buffer_.reset(); // The response body references the buffer if it's needed
+  return is_decoded;
+}
+
+bool ResponseMessage::decode_body(const char* body, RefBuffer* buffer) {
+  size_t body_length = length_;
+  if (flags_ & CASS_FLAG_COMPRESSION) {
+    if (!compressor_) {
+      LOG_ERROR("Received a compressed frame body without negotiating compression");
+      return false;
+    }
+    RefBuffer::Ptr decompressed;
+    if (!compressor_->decompress(body, length_, &decompressed, &body_length)) {
+      return false;
+    }
+    response_body_->set_buffer(decompressed);
+  } else if (body_buffer_) {
+    // The body straddled reads and has already been copied
+    response_body_->set_buffer(body_buffer_);
+  } else if (buffer != NULL && body_length >= MIN_ZERO_COPY_BODY_SIZE) {
+    response_body_->set_buffer(RefBuffer::Ptr(buffer), body);
+  } else {
+    response_body_->set_buffer(allocate_buffer(body_length));
+    memcpy(response_body_->buffer()->data(), body, body_length);
+  }
+
+  Decoder decoder(response_body_->data(), body_length, ProtocolVersion(version_));
+
+  if (flags_ & CASS_FLAG_TRACING) {
+    if (!response_body_->decode_trace_id(decoder)) return false;
+  }
+
+  if (flags_ & CASS_FLAG_WARNING) {
+    if (!response_body_->decode_warnings(decoder)) return false;
+  }
+
+  if (flags_ & CASS_FLAG_CUSTOM_PAYLOAD) {
+    if (!response_body_->decode_custom_payload(decoder)) return false;
+  }
+
+  if (!response_body_->decode(decoder)) {
+    is_body_error_ = true;
+    return false;
+  }
+
+  return true;
+}
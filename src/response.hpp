@@ -42,11 +42,31 @@ public:
 
   uint8_t opcode() const { return opcode_; }
 
-  char* data() const { return buffer_->data(); }
+  const char* data() const { return data_; }
 
   const RefBuffer::Ptr& buffer() const { return buffer_; }
 
-  void set_buffer(size_t size) { buffer_ = RefBuffer::Ptr(RefBuffer::create(size)); }
+  void set_buffer(size_t size) {
+    buffer_ = RefBuffer::Ptr(RefBuffer::create(size, MEMORY_CATEGORY_RESPONSE_BUFFERS));
+    data_ = buffer_->data();
+  }
+
+  void set_buffer(const RefBuffer::Ptr& buffer) {
+    buffer_ = buffer;
+    data_ = buffer_->data();
+  }
+
+  /**
+   * Reference a body that's contained in a larger buffer (e.g. a socket read
+   * buffer) instead of copying it.
+   *
+   * @param buffer The buffer that contains the body.
+   * @param data The start of the body within the buffer.
+   */
+  void set_buffer(const RefBuffer::Ptr& buffer, const char* data) {
+    buffer_ = buffer;
+    data_ = data;
+  }
 
   bool has_tracing_id() const;
 
@@ -67,6 +87,7 @@ public:
 private:
   uint8_t opcode_;
   RefBuffer::Ptr buffer_;
+  const char* data_;
   CassUuid tracing_id_;
   CustomPayloadVec custom_payload_;
   WarningVec warnings_;
@@ -75,10 +96,15 @@ private:
   DISALLOW_COPY_AND_ASSIGN(Response);
 };
 
+class BufferPool;
+class Compressor;
+
 class ResponseMessage : public Allocated {
 public:
-  ResponseMessage()
-      : version_(0)
+  ResponseMessage(Compressor* compressor = NULL, BufferPool* buffer_pool = NULL)
+      : compressor_(compressor)
+      , buffer_pool_(buffer_pool)
+      , version_(0)
       , flags_(0)
       , stream_(0)
       , opcode_(0)
@@ -89,7 +115,10 @@ public:
       , header_buffer_pos_(header_buffer_)
       , is_body_ready_(false)
       , is_body_error_(false)
-      , body_buffer_pos_(NULL) {}
+      , body_buffer_pos_(NULL)
+      , deferred_body_threshold_(0)
+      , is_body_deferred_(false)
+      , deferred_body_(NULL) {}
 
   uint8_t flags() const { return flags_; }
 
@@ -101,12 +130,73 @@ public:
 
   bool is_body_ready() const { return is_body_ready_; }
 
-  ssize_t decode(const char* input, size_t size);
+  uint8_t version() const { return version_; }
+
+  /**
+   * Get the part of a body that has been received so far. This is only
+   * available for uncompressed bodies that straddle reads (the part that's
+   * received is copied into the body's buffer) and only until the body is
+   * ready.
+   *
+   * @param size The number of bytes of the body received so far (output).
+   * @return The start of the body or NULL if the body isn't available.
+   */
+  const char* received_body(size_t* size) const {
+    if (is_body_ready_ || body_buffer_pos_ == NULL || (flags_ & CASS_FLAG_COMPRESSION)) {
+      return NULL;
+    }
+    *size = body_buffer_pos_ - body_buffer_->data();
+    return body_buffer_->data();
+  }
+
+  // The buffer of a body that straddles reads
+  const RefBuffer::Ptr& body_buffer() const { return body_buffer_; }
+
+  void set_compressor(Compressor* compressor) { compressor_ = compressor; }
+
+  void set_buffer_pool(BufferPool* buffer_pool) { buffer_pool_ = buffer_pool; }
+
+  /**
+   * Defer decoding the bodies of RESULT frames of at least a size. A deferred
+   * body is ready once it's received, but it must be decoded using
+   * decode_deferred_body() before the response is used.
+   *
+   * @param threshold The minimum size of a body in bytes that's deferred or
+   * zero to decode all bodies when they're received.
+   */
+  void set_deferred_body_threshold(size_t threshold) { deferred_body_threshold_ = threshold; }
+
+  bool is_body_deferred() const { return is_body_deferred_; }
+
+  /**
+   * Decode a deferred body. This only uses memory owned by the message so it
+   * can run on a thread other than the connection's event loop.
+   *
+   * @return true if successful, otherwise false.
+   */
+  bool decode_deferred_body();
+
+  /**
+   * Decode a response from socket data.
+   *
+   * @param input The socket data.
+   * @param size The size of the socket data.
+   * @param buffer The ref-counted buffer that contains the socket data. If
+   * provided, a body that's fully contained in the input references this
+   * buffer instead of being copied. This can be NULL.
+   * @return The number of bytes consumed or negative if an error occurred.
+   */
+  ssize_t decode(const char* input, size_t size, RefBuffer* buffer = NULL);
 
 private:
   bool allocate_body(int8_t opcode);
+  RefBuffer::Ptr allocate_buffer(size_t size);
+  bool decode_body(const char* body, RefBuffer* buffer);
+  void defer_body(const char* body, RefBuffer* buffer);
 
 private:
+  Compressor* compressor_;
+  BufferPool* buffer_pool_;
   uint8_t version_;
   uint8_t flags_;
   int16_t stream_;
@@ -122,8 +212,14 @@ private:
   bool is_body_ready_;
   bool is_body_error_;
   Response::Ptr response_body_;
+  RefBuffer::Ptr body_buffer_;
   char* body_buffer_pos_;
 
+  size_t deferred_body_threshold_;
+  bool is_body_deferred_;
+  RefBuffer::Ptr deferred_buffer_;
+  const char* deferred_body_;
+
 private:
   DISALLOW_COPY_AND_ASSIGN(ResponseMessage);
 };
@@ -0,0 +1,94 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "result_cache.hpp"
+
+#include "get_time.hpp"
+#include "scoped_lock.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+ResultCache::ResultCache(size_t max_entries)
+    : max_entries_(max_entries)
+    , referenced_(new Atomic<bool>[max_entries])
+    , hand_(0)
+    , hits_(0)
+    , misses_(0)
+    , evictions_(0) {
+  index_.set_empty_key(String());
+  index_.set_deleted_key(String(1, '\0'));
+  slots_.reserve(max_entries);
+  for (size_t i = 0; i < max_entries; ++i) {
+    referenced_[i].store(false, MEMORY_ORDER_RELAXED);
+  }
+  uv_rwlock_init(&rwlock_);
+}
+
+ResultCache::~ResultCache() { uv_rwlock_destroy(&rwlock_); }
+
+ResultResponse::Ptr ResultCache::get(const String& key) {
+  ScopedReadLock rl(&rwlock_);
+  IndexMap::const_iterator i = index_.find(key);
+  if (i == index_.end() || slots_[i->second].expires_ns <= get_time_monotonic_ns()) {
+    misses_.fetch_add(1, MEMORY_ORDER_RELAXED);
+    return ResultResponse::Ptr();
+  }
+  referenced_[i->second].store(true, MEMORY_ORDER_RELAXED);
+  hits_.fetch_add(1, MEMORY_ORDER_RELAXED);
+  return slots_[i->second].result;
+}
+
+void ResultCache::put(const String& key, const ResultResponse::Ptr& result, uint64_t ttl_ms) {
+  if (max_entries_ == 0) return;
+  uint64_t expires_ns = get_time_monotonic_ns() + ttl_ms * 1000 * 1000;
+  ScopedWriteLock wl(&rwlock_);
+  IndexMap::const_iterator i = index_.find(key);
+  if (i != index_.end()) {
+    slots_[i->second] = Slot(key, result, expires_ns);
+  } else if (slots_.size() < max_entries_) {
+    index_[key] = slots_.size();
+    slots_.push_back(Slot(key, result, expires_ns));
+  } else {
+    size_t slot = evict();
+    slots_[slot] = Slot(key, result, expires_ns);
+    index_[key] = slot;
+  }
+}
+
+size_t ResultCache::evict() {
+  // Requires the write lock. Every slot is cleared at most once so this
+  // terminates within two sweeps.
+  while (referenced_[hand_].load(MEMORY_ORDER_RELAXED)) {
+    referenced_[hand_].store(false, MEMORY_ORDER_RELAXED);
+    hand_ = (hand_ + 1) % max_entries_;
+  }
+  size_t victim = hand_;
+  hand_ = (hand_ + 1) % max_entries_;
+  index_.erase(slots_[victim].key);
+  evictions_++;
+  return victim;
+}
+
+void ResultCache::get_metrics(CassResultCacheMetrics* metrics) const {
+  ScopedReadLock rl(&rwlock_);
+  metrics->entries = slots_.size();
+  metrics->max_entries = max_entries_;
+  metrics->hits = hits_.load(MEMORY_ORDER_RELAXED);
+  metrics->misses = misses_.load(MEMORY_ORDER_RELAXED);
+  metrics->evictions = evictions_;
+}
@@ -0,0 +1,109 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_RESULT_CACHE_HPP
+#define DATASTAX_INTERNAL_RESULT_CACHE_HPP
+
+#include "atomic.hpp"
+#include "cassandra.h"
+#include "dense_hash_map.hpp"
+#include "macros.hpp"
+#include "ref_counted.hpp"
+#include "result_response.hpp"
+#include "scoped_ptr.hpp"
+#include "string.hpp"
+#include "vector.hpp"
+
+#include <uv.h>
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * A size-bounded cache of the results of bound statements that are marked
+ * cacheable. Results are keyed by the prepared ID and the bound values and
+ * expire after the statement's TTL. A hit shares the cached result, it isn't
+ * copied, so results are immutable once they're cached.
+ *
+ * Like the prepared metadata, the cache approximates LRU using the CLOCK
+ * algorithm so that a hit only sets a flag under the read lock.
+ */
+class ResultCache : public RefCounted<ResultCache> {
+public:
+  typedef SharedRefPtr<ResultCache> Ptr;
+
+  /**
+   * Constructor.
+   *
+   * @param max_entries The maximum number of cached results.
+   */
+  explicit ResultCache(size_t max_entries);
+  ~ResultCache();
+
+  /**
+   * Get a result that hasn't expired.
+   *
+   * @param key The result's key.
+   * @return The cached result or NULL if it's not cached or has expired.
+   */
+  ResultResponse::Ptr get(const String& key);
+
+  /**
+   * Cache a result, evicting a result that hasn't been used recently if the
+   * cache is full.
+   *
+   * @param key The result's key.
+   * @param result The result. Only a single page of rows should be cached.
+   * @param ttl_ms The time the result is valid for.
+   */
+  void put(const String& key, const ResultResponse::Ptr& result, uint64_t ttl_ms);
+
+  void get_metrics(CassResultCacheMetrics* metrics) const;
+
+private:
+  typedef DenseHashMap<String, size_t> IndexMap; // Key to slot
+
+  struct Slot {
+    Slot(const String& key, const ResultResponse::Ptr& result, uint64_t expires_ns)
+        : key(key)
+        , result(result)
+        , expires_ns(expires_ns) {}
+    String key;
+    ResultResponse::Ptr result;
+    uint64_t expires_ns;
+  };
+
+  typedef Vector<Slot> SlotVec;
+
+  size_t evict();
+
+private:
+  const size_t max_entries_;
+  mutable uv_rwlock_t rwlock_;
+  IndexMap index_;
+  SlotVec slots_;
+  ScopedArray<Atomic<bool> > referenced_;
+  size_t hand_;
+  Atomic<uint64_t> hits_;
+  Atomic<uint64_t> misses_;
+  uint64_t evictions_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ResultCache);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -0,0 +1,96 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "result_columns.hpp"
+
+#include "result_response.hpp"
+#include "scoped_ptr.hpp"
+#include "serialization.hpp"
+#include "utf8.hpp"
+
+#include <string.h>
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+ResultColumns* ResultColumns::create(const ResultResponse* result) {
+  const size_t row_count = result->row_count();
+  const size_t column_count = result->column_count();
+  StringRef rows(result->rows());
+
+  ScopedPtr<ResultColumns> columns(new ResultColumns(rows.data(), row_count, column_count));
+
+  const char* pos = rows.data();
+  const char* end = rows.data() + rows.size();
+  for (size_t row = 0; row < row_count; ++row) {
+    for (size_t column = 0; column < column_count; ++column) {
+      if (end - pos < static_cast<ptrdiff_t>(sizeof(int32_t))) {
+        return NULL;
+      }
+      Cell& cell = columns->cells_[column * row_count + row];
+      pos = decode_int32(pos, cell.size);
+      cell.offset = static_cast<int32_t>(pos - rows.data());
+      if (cell.size > 0) {
+        if (end - pos < cell.size) {
+          return NULL;
+        }
+        pos += cell.size;
+      }
+    }
+  }
+
+  return columns.release();
+}
+
+bool ResultColumns::gather(size_t column, int32_t width, char* output, uint8_t* validity) const {
+  if (validity) {
+    memset(validity, 0, (row_count_ + 7) / 8);
+  }
+  for (size_t row = 0; row < row_count_; ++row) {
+    const Cell& cell = cells_[column * row_count_ + row];
+    char* pos = output + row * width;
+    if (cell.size < 0) {
+      memset(pos, 0, width);
+    } else if (cell.size < width) {
+      return false;
+    } else {
+      memcpy(pos, rows_ + cell.offset, width);
+      if (validity) {
+        validity[row / 8] |= static_cast<uint8_t>(1 << (row % 8));
+      }
+    }
+  }
+  return true;
+}
+
+bool ResultColumns::is_valid_text(size_t column, bool is_ascii_only) const {
+  int state = text_states_[column].load(MEMORY_ORDER_ACQUIRE);
+  if (state != TEXT_UNKNOWN) {
+    return state == TEXT_VALID;
+  }
+
+  bool is_valid = true;
+  for (size_t row = 0; row < row_count_ && is_valid; ++row) {
+    const Cell& cell = cells_[column * row_count_ + row];
+    if (cell.size <= 0) continue;
+    const char* data = rows_ + cell.offset;
+    is_valid = is_ascii_only ? is_ascii(data, cell.size) : is_valid_utf8(data, cell.size);
+  }
+
+  text_states_[column].store(is_valid ? TEXT_VALID : TEXT_INVALID, MEMORY_ORDER_RELEASE);
+  return is_valid;
+}
@@ -0,0 +1,127 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_RESULT_COLUMNS_HPP
+#define DATASTAX_INTERNAL_RESULT_COLUMNS_HPP
+
+#include "allocated.hpp"
+#include "atomic.hpp"
+#include "macros.hpp"
+#include "scoped_ptr.hpp"
+#include "vector.hpp"
+
+namespace datastax { namespace internal { namespace core {
+
+class ResultResponse;
+
+/**
+ * A columnar index over the rows of a ROWS result. The row data is scanned
+ * once to record the position of every cell, after which all the values of a
+ * single column can be read without decoding the other columns into values.
+ */
+class ResultColumns : public Allocated {
+public:
+  struct Cell {
+    int32_t offset; // Relative to the start of the row data
+    int32_t size;   // Negative for null values
+  };
+
+  /**
+   * Scan the rows of a result.
+   *
+   * @param result A ROWS result with valid metadata.
+   * @return The index or NULL if the row data is invalid.
+   */
+  static ResultColumns* create(const ResultResponse* result);
+
+  size_t row_count() const { return row_count_; }
+
+  /**
+   * Get the contents of a cell.
+   *
+   * @param column The column index.
+   * @param row The row index.
+   * @param size The size of the cell's value. This is negative for null values.
+   * @return A pointer to the cell's value or NULL for null values.
+   */
+  const char* cell(size_t column, size_t row, int32_t* size) const {
+    const Cell& cell = cells_[column * row_count_ + row];
+    *size = cell.size;
+    return cell.size < 0 ? NULL : rows_ + cell.offset;
+  }
+
+  /**
+   * Get the position of a row. The result must have at least one column.
+   *
+   * @param row The row index.
+   * @return The offset of the row's first cell (including its length) relative
+   * to the start of the row data.
+   */
+  size_t row_offset(size_t row) const {
+    return static_cast<size_t>(cells_[row].offset) - sizeof(int32_t);
+  }
+
+  /**
+   * Copy the encoded values of a fixed width column into a contiguous buffer.
+   * The values are left in network byte order.
+   *
+   * @param column The column index.
+   * @param width The encoded width of the column's values.
+   * @param output A buffer with room for row_count() values. Null values are
+   * zeroed.
+   * @param validity An optional bitmap of (row_count() + 7) / 8 bytes. The bit
+   * for each row (least significant bit first) is set if its value isn't null.
+   * @return false if a value is smaller than the width.
+   */
+  bool gather(size_t column, int32_t width, char* output, uint8_t* validity) const;
+
+  /**
+   * Determine if all the values of a text column are valid. The column is
+   * only validated the first time, after which the result is cached.
+   *
+   * @param column The column index.
+   * @param is_ascii_only true for "ascii" columns.
+   * @return true if all the values are valid UTF-8 (or ASCII).
+   */
+  bool is_valid_text(size_t column, bool is_ascii_only) const;
+
+private:
+  enum TextState { TEXT_UNKNOWN, TEXT_VALID, TEXT_INVALID };
+
+  ResultColumns(const char* rows, size_t row_count, size_t column_count)
+      : rows_(rows)
+      , row_count_(row_count)
+      , cells_(row_count * column_count)
+      , text_states_(new Atomic<int>[column_count]) {
+    for (size_t i = 0; i < column_count; ++i) {
+      text_states_[i].store(TEXT_UNKNOWN);
+    }
+  }
+
+private:
+  const char* rows_;
+  size_t row_count_;
+  Vector<Cell> cells_; // Column-major so each column is contiguous
+  // Threads racing to validate a column store the same state
+  ScopedArray<Atomic<int> > text_states_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ResultColumns);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
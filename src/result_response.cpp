@@ -16,9 +16,13 @@
 
 #include "result_response.hpp"
 
+#include "arrow_export.hpp"
+#include "byte_swap.hpp"
+#include "column_handle.hpp"
 #include "external.hpp"
 #include "logger.hpp"
 #include "protocol.hpp"
+#include "result_columns.hpp"
 #include "result_metadata.hpp"
 #include "result_response.hpp"
 #include "serialization.hpp"
@@ -27,6 +31,101 @@ using namespace datastax;
 using namespace datastax::internal;
 using namespace datastax::internal::core;
 
+namespace {
+
+inline bool is_int32_type(CassValueType value_type) { return value_type == CASS_VALUE_TYPE_INT; }
+
+inline bool is_float_type(CassValueType value_type) { return value_type == CASS_VALUE_TYPE_FLOAT; }
+
+inline bool is_double_type(CassValueType value_type) {
+  return value_type == CASS_VALUE_TYPE_DOUBLE;
+}
+
+inline bool is_bool_type(CassValueType value_type) {
+  return value_type == CASS_VALUE_TYPE_BOOLEAN;
+}
+
+inline const char* decode_bool(const char* input, cass_bool_t& output) {
+  uint8_t value = 0;
+  const char* pos = decode_byte(input, value);
+  output = value != 0 ? cass_true : cass_false;
+  return pos;
+}
+
+CassError check_column(const CassResult* result, size_t index, size_t output_size,
+                       const ResultColumns** columns) {
+  if (result->kind() != CASS_RESULT_KIND_ROWS) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  if (index >= static_cast<size_t>(result->column_count())) {
+    return CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS;
+  }
+  if (output_size < static_cast<size_t>(result->row_count())) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  *columns = result->columns();
+  if (*columns == NULL) {
+    return CASS_ERROR_LIB_NOT_ENOUGH_DATA;
+  }
+  return CASS_OK;
+}
+
+// Copy a fixed size column into a contiguous buffer. Null values are copied as
+// zero.
+template <class T>
+CassError copy_column(const CassResult* result, size_t index, bool (*is_type)(CassValueType),
+                      int32_t encoded_size, const char* (*decode)(const char*, T&), T* output,
+                      cass_bool_t* is_null, size_t output_size) {
+  const ResultColumns* columns = NULL;
+  CassError rc = check_column(result, index, output_size, &columns);
+  if (rc != CASS_OK) return rc;
+
+  if (!is_type(result->metadata()->get_column_definition(index).data_type->value_type())) {
+    return CASS_ERROR_LIB_INVALID_VALUE_TYPE;
+  }
+
+  for (size_t row = 0, row_count = columns->row_count(); row < row_count; ++row) {
+    int32_t size = 0;
+    const char* data = columns->cell(index, row, &size);
+    if (is_null) is_null[row] = data == NULL ? cass_true : cass_false;
+    if (data == NULL) {
+      output[row] = T();
+    } else if (size < encoded_size) {
+      return CASS_ERROR_LIB_NOT_ENOUGH_DATA;
+    } else {
+      decode(data, output[row]);
+    }
+  }
+  return CASS_OK;
+}
+
+// Copy a fixed width column into a contiguous buffer and convert the whole run
+// of values to host byte order at once.
+CassError copy_column_array(const CassResult* result, size_t index,
+                            bool (*is_type)(CassValueType), int32_t width, char* output,
+                            cass_uint8_t* validity, size_t output_size) {
+  const ResultColumns* columns = NULL;
+  CassError rc = check_column(result, index, output_size, &columns);
+  if (rc != CASS_OK) return rc;
+
+  if (!is_type(result->metadata()->get_column_definition(index).data_type->value_type())) {
+    return CASS_ERROR_LIB_INVALID_VALUE_TYPE;
+  }
+
+  if (!columns->gather(index, width, output, validity)) {
+    return CASS_ERROR_LIB_NOT_ENOUGH_DATA;
+  }
+
+  if (width == sizeof(int32_t)) {
+    swap_bytes_32(output, columns->row_count());
+  } else {
+    swap_bytes_64(output, columns->row_count());
+  }
+  return CASS_OK;
+}
+
+} // namespace
+
 extern "C" {
 
 void cass_result_free(const CassResult* result) { result->dec_ref(); }
@@ -60,6 +159,19 @@ CassError cass_result_column_name(const CassResult* result, size_t index, const
   return CASS_OK;
 }
 
+CassColumnHandle* cass_result_column_handle(const CassResult* result, const char* name) {
+  return cass_result_column_handle_n(result, name, SAFE_STRLEN(name));
+}
+
+CassColumnHandle* cass_result_column_handle_n(const CassResult* result, const char* name,
+                                              size_t name_length) {
+  if (result->kind() != CASS_RESULT_KIND_ROWS) {
+    return NULL;
+  }
+  return CassColumnHandle::to(
+      ColumnHandle::resolve(result->metadata(), StringRef(name, name_length)));
+}
+
 CassValueType cass_result_column_type(const CassResult* result, size_t index) {
   const SharedRefPtr<ResultMetadata>& metadata(result->metadata());
   if (result->kind() == CASS_RESULT_KIND_ROWS && index < metadata->column_count()) {
@@ -83,6 +195,149 @@ const CassRow* cass_result_first_row(const CassResult* result) {
   return NULL;
 }
 
+CassError cass_result_encoded_rows(const CassResult* result, const cass_byte_t** rows,
+                                   size_t* rows_size) {
+  if (result->kind() != CASS_RESULT_KIND_ROWS || !result->metadata()) {
+    return CASS_ERROR_LIB_INVALID_STATE;
+  }
+  *rows = reinterpret_cast<const cass_byte_t*>(result->rows().data());
+  *rows_size = result->rows().size();
+  return CASS_OK;
+}
+
+CassError cass_result_column_get_int32(const CassResult* result, size_t index,
+                                       cass_int32_t* output, cass_bool_t* is_null,
+                                       size_t output_size) {
+  return copy_column<cass_int32_t>(result, index, is_int32_type, sizeof(int32_t), decode_int32,
+                                   output, is_null, output_size);
+}
+
+CassError cass_result_column_get_int64(const CassResult* result, size_t index,
+                                       cass_int64_t* output, cass_bool_t* is_null,
+                                       size_t output_size) {
+  return copy_column<cass_int64_t>(result, index, is_int64_type, sizeof(int64_t), decode_int64,
+                                   output, is_null, output_size);
+}
+
+CassError cass_result_column_get_float(const CassResult* result, size_t index,
+                                       cass_float_t* output, cass_bool_t* is_null,
+                                       size_t output_size) {
+  return copy_column<cass_float_t>(result, index, is_float_type, sizeof(int32_t), decode_float,
+                                   output, is_null, output_size);
+}
+
+CassError cass_result_column_get_double(const CassResult* result, size_t index,
+                                        cass_double_t* output, cass_bool_t* is_null,
+                                        size_t output_size) {
+  return copy_column<cass_double_t>(result, index, is_double_type, sizeof(int64_t),
+                                    decode_double, output, is_null, output_size);
+}
+
+CassError cass_result_column_get_bool(const CassResult* result, size_t index,
+                                      cass_bool_t* output, cass_bool_t* is_null,
+                                      size_t output_size) {
+  return copy_column<cass_bool_t>(result, index, is_bool_type, sizeof(uint8_t), decode_bool,
+                                  output, is_null, output_size);
+}
+
+CassError cass_result_column_get_int32_array(const CassResult* result, size_t index,
+                                             cass_int32_t* output, cass_uint8_t* validity,
+                                             size_t output_size) {
+  return copy_column_array(result, index, is_int32_type, sizeof(int32_t),
+                           reinterpret_cast<char*>(output), validity, output_size);
+}
+
+CassError cass_result_column_get_int64_array(const CassResult* result, size_t index,
+                                             cass_int64_t* output, cass_uint8_t* validity,
+                                             size_t output_size) {
+  return copy_column_array(result, index, is_int64_type, sizeof(int64_t),
+                           reinterpret_cast<char*>(output), validity, output_size);
+}
+
+CassError cass_result_column_get_float_array(const CassResult* result, size_t index,
+                                             cass_float_t* output, cass_uint8_t* validity,
+                                             size_t output_size) {
+  return copy_column_array(result, index, is_float_type, sizeof(int32_t),
+                           reinterpret_cast<char*>(output), validity, output_size);
+}
+
+CassError cass_result_column_get_double_array(const CassResult* result, size_t index,
+                                              cass_double_t* output, cass_uint8_t* validity,
+                                              size_t output_size) {
+  return copy_column_array(result, index, is_double_type, sizeof(int64_t),
+                           reinterpret_cast<char*>(output), validity, output_size);
+}
+
+CassError cass_result_column_get_duration(const CassResult* result, size_t index,
+                                          cass_int32_t* months, cass_int32_t* days,
+                                          cass_int64_t* nanos, cass_uint8_t* validity,
+                                          size_t output_size) {
+  const ResultColumns* columns = NULL;
+  CassError rc = check_column(result, index, output_size, &columns);
+  if (rc != CASS_OK) return rc;
+
+  if (result->metadata()->get_column_definition(index).data_type->value_type() !=
+      CASS_VALUE_TYPE_DURATION) {
+    return CASS_ERROR_LIB_INVALID_VALUE_TYPE;
+  }
+
+  size_t row_count = columns->row_count();
+  if (validity) memset(validity, 0, (row_count + 7) / 8);
+
+  for (size_t row = 0; row < row_count; ++row) {
+    int32_t size = 0;
+    const char* data = columns->cell(index, row, &size);
+    if (data == NULL) {
+      months[row] = 0;
+      days[row] = 0;
+      nanos[row] = 0;
+      continue;
+    }
+    if (!decode_duration(data, size, &months[row], &days[row], &nanos[row])) {
+      return CASS_ERROR_LIB_NOT_ENOUGH_DATA;
+    }
+    if (validity) validity[row / 8] |= static_cast<cass_uint8_t>(1 << (row % 8));
+  }
+  return CASS_OK;
+}
+
+CassError cass_result_column_get_string(const CassResult* result, size_t index,
+                                        const char** output, size_t* output_length,
+                                        size_t output_size) {
+  const ResultColumns* columns = NULL;
+  CassError rc = check_column(result, index, output_size, &columns);
+  if (rc != CASS_OK) return rc;
+
+  for (size_t row = 0, row_count = columns->row_count(); row < row_count; ++row) {
+    int32_t size = 0;
+    output[row] = columns->cell(index, row, &size);
+    output_length[row] = size < 0 ? 0 : static_cast<size_t>(size);
+  }
+  return CASS_OK;
+}
+
+CassError cass_result_column_is_valid_utf8(const CassResult* result, size_t index,
+                                           cass_bool_t* is_valid) {
+  const ResultColumns* columns = NULL;
+  CassError rc = check_column(result, index, result->row_count(), &columns);
+  if (rc != CASS_OK) return rc;
+
+  CassValueType value_type =
+      result->metadata()->get_column_definition(index).data_type->value_type();
+  if (!is_string_type(value_type)) {
+    return CASS_ERROR_LIB_INVALID_VALUE_TYPE;
+  }
+
+  *is_valid = columns->is_valid_text(index, value_type == CASS_VALUE_TYPE_ASCII) ? cass_true
+                                                                                 : cass_false;
+  return CASS_OK;
+}
+
+CassError cass_result_export_arrow(const CassResult* result, ArrowArray* array,
+                                   ArrowSchema* schema) {
+  return export_arrow(result, array, schema);
+}
+
 cass_bool_t cass_result_has_more_pages(const CassResult* result) {
   return static_cast<cass_bool_t>(result->has_more_pages());
 }
@@ -107,23 +362,18 @@ public:
 
   DataType::ConstPtr decode() {
     decoder_.set_type("data type");
+    StringRef start(decoder_.as_string_ref());
     uint16_t value_type;
     if (!decoder_.decode_uint16(value_type)) return DataType::NIL;
 
     switch (value_type) {
       case CASS_VALUE_TYPE_CUSTOM:
-        return decode_custom();
-
       case CASS_VALUE_TYPE_LIST:
       case CASS_VALUE_TYPE_SET:
       case CASS_VALUE_TYPE_MAP:
-        return decode_collection(static_cast<CassValueType>(value_type));
-
       case CASS_VALUE_TYPE_UDT:
-        return decode_user_type();
-
       case CASS_VALUE_TYPE_TUPLE:
-        return decode_tuple();
+        return decode_interned(value_type, start);
 
       default:
         return cache_.by_value_type(value_type);
@@ -131,6 +381,76 @@ public:
   }
 
 private:
+  // Composite and custom types are looked up by their encoding first so that
+  // known types are neither rebuilt nor allocated
+  DataType::ConstPtr decode_interned(uint16_t value_type, StringRef start) {
+    Decoder end(decoder_);
+    if (!skip(value_type, end)) return DataType::NIL;
+
+    StringRef encoded(start.data(), start.size() - end.as_string_ref().size());
+    DataType::ConstPtr data_type(DataTypeCache::get(encoded));
+    if (data_type) {
+      decoder_ = end;
+      return data_type;
+    }
+
+    switch (value_type) {
+      case CASS_VALUE_TYPE_CUSTOM:
+        data_type = decode_custom();
+        break;
+      case CASS_VALUE_TYPE_UDT:
+        data_type = decode_user_type();
+        break;
+      case CASS_VALUE_TYPE_TUPLE:
+        data_type = decode_tuple();
+        break;
+      default:
+        data_type = decode_collection(static_cast<CassValueType>(value_type));
+        break;
+    }
+    if (data_type) {
+      DataTypeCache::put(encoded, data_type);
+    }
+    return data_type;
+  }
+
+  // Skip the rest of a type's encoding without building the type
+  static bool skip(uint16_t value_type, Decoder& decoder) {
+    StringRef name;
+    uint16_t n = 0;
+    switch (value_type) {
+      case CASS_VALUE_TYPE_CUSTOM:
+        return decoder.decode_string(&name);
+      case CASS_VALUE_TYPE_LIST:
+      case CASS_VALUE_TYPE_SET:
+        return skip(decoder);
+      case CASS_VALUE_TYPE_MAP:
+        return skip(decoder) && skip(decoder);
+      case CASS_VALUE_TYPE_UDT:
+        if (!decoder.decode_string(&name) || !decoder.decode_string(&name) ||
+            !decoder.decode_uint16(n)) {
+          return false;
+        }
+        for (uint16_t i = 0; i < n; ++i) {
+          if (!decoder.decode_string(&name) || !skip(decoder)) return false;
+        }
+        return true;
+      case CASS_VALUE_TYPE_TUPLE:
+        if (!decoder.decode_uint16(n)) return false;
+        for (uint16_t i = 0; i < n; ++i) {
+          if (!skip(decoder)) return false;
+        }
+        return true;
+      default:
+        return true;
+    }
+  }
+
+  static bool skip(Decoder& decoder) {
+    uint16_t value_type;
+    return decoder.decode_uint16(value_type) && skip(value_type, decoder);
+  }
+
   DataType::ConstPtr decode_custom() {
     StringRef class_name;
     if (!decoder_.decode_string(&class_name)) return DataType::NIL;
@@ -187,6 +507,28 @@ private:
   SimpleDataTypeCache& cache_;
 };
 
+ResultResponse::~ResultResponse() { delete columns_.load(); }
+
+const ResultColumns* ResultResponse::columns() const {
+  ResultColumns* columns = columns_.load(MEMORY_ORDER_ACQUIRE);
+  if (columns || kind_ != CASS_RESULT_KIND_ROWS || !metadata_) {
+    return columns;
+  }
+
+  columns = ResultColumns::create(this);
+  if (!columns) {
+    return NULL;
+  }
+
+  // Another thread might have finished building the index first
+  ResultColumns* expected = NULL;
+  if (!columns_.compare_exchange_strong(expected, columns)) {
+    delete columns;
+    return expected;
+  }
+  return columns;
+}
+
 void ResultResponse::set_metadata(const ResultMetadata::Ptr& metadata) {
   metadata_ = metadata;
   decode_first_row();
@@ -194,6 +536,7 @@ void ResultResponse::set_metadata(const ResultMetadata::Ptr& metadata) {
 
 bool ResultResponse::decode(Decoder& decoder) {
   protocol_version_ = decoder.protocol_version();
+  body_ = decoder.as_string_ref();
   decoder.set_type("result");
   bool is_valid = false;
 
@@ -229,6 +572,46 @@ bool ResultResponse::decode(Decoder& decoder) {
   return is_valid;
 }
 
+ResultResponse::Ptr ResultResponse::concat_rows(const Vector<ConstPtr>& results) {
+  if (results.empty()) return Ptr();
+
+  const ResultResponse* first = results.front().get();
+  int32_t row_count = 0;
+  size_t rows_size = 0;
+  for (Vector<ConstPtr>::const_iterator it = results.begin(), end = results.end(); it != end;
+       ++it) {
+    const ResultResponse* result = it->get();
+    if (result->kind() != CASS_RESULT_KIND_ROWS || result->no_metadata() ||
+        result->column_count() != first->column_count()) {
+      return Ptr();
+    }
+    row_count += result->row_count();
+    rows_size += result->rows().size();
+  }
+
+  // Encode a ROWS result without metadata (kind, flags, column count and row
+  // count) followed by the rows and use the first result's metadata
+  size_t size = 4 * sizeof(int32_t) + rows_size;
+  Ptr concatenated(new ResultResponse());
+  concatenated->set_buffer(size);
+  char* pos = concatenated->buffer()->data();
+  pos = encode_int32(pos, CASS_RESULT_KIND_ROWS);
+  pos = encode_int32(pos, CASS_RESULT_FLAG_NO_METADATA);
+  pos = encode_int32(pos, first->column_count());
+  pos = encode_int32(pos, row_count);
+  for (Vector<ConstPtr>::const_iterator it = results.begin(), end = results.end(); it != end;
+       ++it) {
+    StringRef rows((*it)->rows());
+    memcpy(pos, rows.data(), rows.size());
+    pos += rows.size();
+  }
+
+  Decoder decoder(concatenated->data(), size, first->protocol_version());
+  if (!concatenated->decode(decoder)) return Ptr();
+  concatenated->set_metadata(first->metadata());
+  return concatenated;
+}
+
 bool ResultResponse::decode_metadata(Decoder& decoder, ResultMetadata::Ptr* metadata,
                                      bool has_pk_indices) {
   int32_t flags = 0;
@@ -264,6 +647,11 @@ bool ResultResponse::decode_metadata(Decoder& decoder, ResultMetadata::Ptr* meta
     has_more_pages_ = false;
   }
 
+  if (flags & CASS_RESULT_FLAG_CONTINUOUS_PAGING) {
+    CHECK_RESULT(decoder.decode_int32(continuous_page_number_));
+    is_last_continuous_page_ = (flags & CASS_RESULT_FLAG_LAST_CONTINUOUS_PAGE) != 0;
+  }
+
   if (!(flags & CASS_RESULT_FLAG_NO_METADATA)) {
     bool global_table_spec = flags & CASS_RESULT_FLAG_GLOBAL_TABLESPEC;
 
@@ -310,6 +698,7 @@ bool ResultResponse::decode_first_row() {
 bool ResultResponse::decode_rows(Decoder& decoder) {
   CHECK_RESULT(decode_metadata(decoder, &metadata_));
   CHECK_RESULT(decoder.decode_int32(row_count_));
+  rows_ = decoder.as_string_ref();
   row_decoder_ = decoder;
   CHECK_RESULT(decode_first_row());
   return true;
@@ -17,6 +17,7 @@
 #ifndef DATASTAX_INTERNAL_RESULT_RESPONSE_HPP
 #define DATASTAX_INTERNAL_RESULT_RESPONSE_HPP
 
+#include "atomic.hpp"
 #include "constants.hpp"
 #include "data_type.hpp"
 #include "macros.hpp"
@@ -28,6 +29,7 @@
 
 namespace datastax { namespace internal { namespace core {
 
+class ResultColumns;
 class ResultIterator;
 
 class ResultResponse : public Response {
@@ -40,16 +42,27 @@ public:
       : Response(CQL_OPCODE_RESULT)
       , kind_(CASS_RESULT_KIND_VOID)
       , has_more_pages_(false)
-      , row_count_(0) {
+      , continuous_page_number_(-1)
+      , is_last_continuous_page_(false)
+      , row_count_(0)
+      , columns_(NULL) {
     first_row_.set_result(this);
   }
 
+  ~ResultResponse();
+
   int32_t kind() const { return kind_; }
 
   ProtocolVersion protocol_version() const { return protocol_version_; }
 
   bool has_more_pages() const { return has_more_pages_; }
 
+  // The page's number, starting at 1, if the rows are a page of a DSE
+  // continuous paging request.
+  bool is_continuous_page() const { return continuous_page_number_ >= 0; }
+  int32_t continuous_page_number() const { return continuous_page_number_; }
+  bool is_last_continuous_page() const { return is_last_continuous_page_; }
+
   int32_t column_count() const { return (metadata_ ? metadata_->column_count() : 0); }
 
   bool no_metadata() const { return !metadata_; }
@@ -80,10 +93,37 @@ public:
 
   const Row& first_row() const { return first_row_; }
 
+  // The encoded data of all the rows starting at the first row
+  StringRef rows() const { return rows_; }
+
+  // The encoded result (without the frame's tracing ID, warnings or custom
+  // payload)
+  StringRef body() const { return body_; }
+
+  /**
+   * Get the columnar index of the rows. This is built the first time it's
+   * used and is safe to call from multiple threads.
+   *
+   * @return The columnar index or NULL if this isn't a ROWS result with valid
+   * metadata and row data.
+   */
+  const ResultColumns* columns() const;
+
   const PKIndexVec& pk_indices() const { return pk_indices_; }
 
   virtual bool decode(Decoder& decoder);
 
+  /**
+   * Concatenate the rows of ROWS results that have the same columns, e.g. the
+   * results of statements bound from the same prepared statement. Only the
+   * rows are kept; the results' paging states are dropped.
+   *
+   * @param results The results.
+   * @return A result with all of the rows, in the order of the results, or
+   * null if the results aren't ROWS results with the same number of columns.
+   */
+  static Ptr concat_rows(const Vector<ConstPtr>& results);
+
 private:
   bool decode_metadata(Decoder& decoder, ResultMetadata::Ptr* metadata,
                        bool has_pk_indices = false);
@@ -101,7 +141,9 @@ private:
 private:
   int32_t kind_;
   ProtocolVersion protocol_version_;
-  bool has_more_pages_; // row data
+  bool has_more_pages_;            // row data
+  int32_t continuous_page_number_; // rows result, DSE continuous paging
+  bool is_last_continuous_page_;   // rows result, DSE continuous paging
   ResultMetadata::Ptr metadata_;
   ResultMetadata::Ptr result_metadata_;
   StringRef paging_state_;       // row paging
@@ -112,9 +154,12 @@ private:
   StringRef table_;              // rows, and schema change
   StringRef new_metadata_id_;    // rows result, protocol v5/DSEv2
   int32_t row_count_;
+  StringRef rows_;
+  StringRef body_;
   Decoder row_decoder_;
   Row first_row_;
   PKIndexVec pk_indices_;
+  mutable Atomic<ResultColumns*> columns_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ResultResponse);
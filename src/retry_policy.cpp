@@ -327,3 +327,19 @@ RetryPolicy::RetryDecision LoggingRetryPolicy::on_request_error(const Request* r
 
   return decision;
 }
+
+void RetryBudget::deposit() {
+  if (balance_.load(MEMORY_ORDER_RELAXED) < RESERVE * 1000) {
+    balance_.fetch_add(deposit_, MEMORY_ORDER_RELAXED);
+  }
+}
+
+bool RetryBudget::try_withdraw() {
+  int64_t balance = balance_.load(MEMORY_ORDER_RELAXED);
+  while (balance >= 1000) {
+    if (balance_.compare_exchange_weak(balance, balance - 1000)) {
+      return true;
+    }
+  }
+  return false;
+}
@@ -17,6 +17,7 @@
 #ifndef DATASTAX_INTERNAL_RETRY_POLICY_HPP
 #define DATASTAX_INTERNAL_RETRY_POLICY_HPP
 
+#include "atomic.hpp"
 #include "cassandra.h"
 #include "error_response.hpp"
 #include "external.hpp"
@@ -160,6 +161,44 @@ private:
   RetryPolicy::Ptr retry_policy_;
 };
 
+/**
+ * A budget that limits the retries decided by the retry policies to a
+ * fraction of the session's requests. Each request deposits its share of a
+ * retry and each retry withdraws a whole one. This keeps a struggling cluster
+ * from being flooded with retries when most requests are failing.
+ *
+ * The budget is shared by all the session's I/O threads.
+ */
+class RetryBudget : public RefCounted<RetryBudget> {
+public:
+  typedef SharedRefPtr<RetryBudget> Ptr;
+
+  // The number of retries that can be saved up. The budget starts full so
+  // that the first requests can be retried.
+  static const int64_t RESERVE = 10;
+
+  RetryBudget(double ratio)
+      : deposit_(static_cast<int64_t>(ratio * 1000.0))
+      , balance_(RESERVE * 1000) {}
+
+  /**
+   * Add a request's share of a retry to the budget.
+   */
+  void deposit();
+
+  /**
+   * Take a retry from the budget.
+   *
+   * @return true if the retry is allowed, otherwise false.
+   */
+  bool try_withdraw();
+
+private:
+  // Both are in thousandths of a retry
+  const int64_t deposit_;
+  Atomic<int64_t> balance_;
+};
+
 }}} // namespace datastax::internal::core
 
 EXTERNAL_TYPE(datastax::internal::core::RetryPolicy, CassRetryPolicy)
@@ -0,0 +1,52 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_REVISE_REQUEST_HPP
+#define DATASTAX_INTERNAL_REVISE_REQUEST_HPP
+
+#include "constants.hpp"
+#include "request.hpp"
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * A request (DSE) that revises a continuous paging request that's running on
+ * the same connection: it either cancels the request or grants the
+ * coordinator credits to send more pages (DSEv2).
+ */
+class ReviseRequest : public Request {
+public:
+  ReviseRequest(int32_t revision_type, int32_t stream, int32_t next_pages = 0)
+      : Request(CQL_OPCODE_CANCEL)
+      , revision_type_(revision_type)
+      , stream_(stream)
+      , next_pages_(next_pages) {}
+
+  int32_t revision_type() const { return revision_type_; }
+  int32_t target_stream() const { return stream_; }
+  int32_t next_pages() const { return next_pages_; }
+
+private:
+  int encode(ProtocolVersion version, RequestCallback* callback, BufferVec* bufs) const;
+
+  int32_t revision_type_;
+  int32_t stream_;
+  int32_t next_pages_;
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -41,19 +41,113 @@
 
 #include "ring_buffer.hpp"
 
+#include "memory.hpp"
+#include "memory_accounting.hpp"
+
 #include <assert.h>
+#include <new>
 #include <string.h>
 
+using namespace datastax::internal;
 using namespace datastax::internal::rb;
 
+ChunkPool::~ChunkPool() {
+  while (free_chunks_ != NULL) {
+    Chunk* next = free_chunks_->next_;
+    free_chunk(free_chunks_);
+    free_chunks_ = next;
+  }
+  while (free_arena_chunks_ != NULL) {
+    Chunk* next = free_arena_chunks_->next_;
+    free_chunk(free_arena_chunks_);
+    free_arena_chunks_ = next;
+  }
+}
+
+Chunk* ChunkPool::acquire() {
+  // Prefer the chunks backed by huge pages
+  Chunk** free_chunks = free_arena_chunks_ != NULL ? &free_arena_chunks_ : &free_chunks_;
+  if (*free_chunks != NULL) {
+    Chunk* chunk = *free_chunks;
+    *free_chunks = chunk->next_;
+    --free_count_;
+    return new (chunk) Chunk();
+  }
+  return allocate_chunk();
+}
+
+void ChunkPool::release(Chunk* chunk) {
+  if (is_arena_chunk(chunk)) {
+    // The arena's memory is never freed so its chunks are always kept. A free
+    // heap chunk makes room for it if the pool is full.
+    if (free_count_ >= max_free_chunks_ && free_chunks_ != NULL) {
+      Chunk* heap_chunk = free_chunks_;
+      free_chunks_ = heap_chunk->next_;
+      --free_count_;
+      free_chunk(heap_chunk);
+    }
+    chunk->next_ = free_arena_chunks_;
+    free_arena_chunks_ = chunk;
+    ++free_count_;
+  } else if (free_count_ < max_free_chunks_) {
+    chunk->next_ = free_chunks_;
+    free_chunks_ = chunk;
+    ++free_count_;
+  } else {
+    free_chunk(chunk);
+  }
+}
+
+void ChunkPool::preallocate() {
+  while (free_count_ < max_free_chunks_) {
+    Chunk* chunk = allocate_chunk();
+    memset(chunk->data(), 0, chunk_size_); // Fault in the pages on this thread
+    release(chunk);
+  }
+}
+
+Chunk* ChunkPool::allocate_chunk() {
+  MemoryAccounting::add(MEMORY_CATEGORY_SSL_BUFFERS, sizeof(Chunk) + chunk_size_);
+  if (arena_ && arena_chunk_count_ < max_free_chunks_) {
+    // The chunks are returned to the pool before it's destroyed so they don't
+    // need to reference the arena
+    void* memory = arena_->allocate_unreferenced(sizeof(Chunk) + chunk_size_);
+    if (memory != NULL) {
+      ++arena_chunk_count_;
+      return new (memory) Chunk();
+    }
+  }
+  return new (Memory::malloc(sizeof(Chunk) + chunk_size_)) Chunk();
+}
+
+void ChunkPool::free_chunk(Chunk* chunk) {
+  MemoryAccounting::remove(MEMORY_CATEGORY_SSL_BUFFERS, sizeof(Chunk) + chunk_size_);
+  if (!is_arena_chunk(chunk)) {
+    Memory::free(chunk);
+  }
+}
+
+RingBuffer::RingBuffer(const ChunkPool::Ptr& pool)
+    : pool_(pool ? pool : ChunkPool::Ptr(new ChunkPool()))
+    , chunk_size_(pool_->chunk_size())
+    , length_(0)
+    , head_(pool_->acquire())
+    , read_head_(head_)
+    , write_head_(head_) {
+  // Loop head
+  head_->next_ = head_;
+}
+
 RingBuffer::~RingBuffer() {
-  Buffer* current = head_.next_;
-  while (current != &head_) {
-    Buffer* next = current->next_;
-    delete current;
+  Chunk* current = head_->next_;
+  while (current != head_) {
+    Chunk* next = current->next_;
+    pool_->release(current);
     current = next;
   }
+  pool_->release(head_);
 
+  head_ = NULL;
   read_head_ = NULL;
   write_head_ = NULL;
 }
@@ -86,7 +180,7 @@ size_t RingBuffer::read(char* out, size_t size) {
     if (avail > left) avail = left;
 
     // Copy data
-    if (out != NULL) memcpy(out + offset, read_head_->data_ + read_head_->read_pos_, avail);
+    if (out != NULL) memcpy(out + offset, read_head_->data() + read_head_->read_pos_, avail);
     read_head_->read_pos_ += avail;
 
     // Move pointers
@@ -106,28 +200,28 @@ size_t RingBuffer::read(char* out, size_t size) {
 }
 
 void RingBuffer::free_empty() {
-  Buffer* child = write_head_->next_;
+  Chunk* child = write_head_->next_;
   if (child == write_head_ || child == read_head_) return;
-  Buffer* cur = child->next_;
+  Chunk* cur = child->next_;
   if (cur == write_head_ || cur == read_head_) return;
 
-  Buffer* prev = child;
+  Chunk* prev = child;
   while (cur != read_head_) {
     // Skip embedded buffer, and continue deallocating again starting from it
-    if (cur == &head_) {
+    if (cur == head_) {
       prev->next_ = cur;
       prev = cur;
-      cur = head_.next_;
+      cur = head_->next_;
       continue;
     }
     assert(cur != write_head_);
     assert(cur->write_pos_ == cur->read_pos_);
 
-    Buffer* next = cur->next_;
-    delete cur;
+    Chunk* next = cur->next_;
+    pool_->release(cur);
     cur = next;
   }
-  assert(prev == child || prev == &head_);
+  assert(prev == child || prev == head_);
   prev->next_ = cur;
 }
 
@@ -135,7 +229,7 @@ size_t RingBuffer::index_of(char delim, size_t limit) {
   size_t bytes_read = 0;
   size_t max = length_ > limit ? limit : length_;
   size_t left = limit;
-  Buffer* current = read_head_;
+  Chunk* current = read_head_;
 
   while (bytes_read < max) {
     assert(current->read_pos_ <= current->write_pos_);
@@ -143,7 +237,7 @@ size_t RingBuffer::index_of(char delim, size_t limit) {
     if (avail > left) avail = left;
 
     // Walk through data
-    char* tmp = current->data_ + current->read_pos_;
+    char* tmp = current->data() + current->read_pos_;
     size_t off = 0;
     while (off < avail && *tmp != delim) {
       off++;
@@ -160,7 +254,7 @@ size_t RingBuffer::index_of(char delim, size_t limit) {
     }
 
     // Move to next buffer
-    if (current->read_pos_ + avail == BUFFER_LENGTH) {
+    if (current->read_pos_ + avail == chunk_size_) {
       current = current->next_;
     }
   }
@@ -174,24 +268,24 @@ void RingBuffer::write(const char* data, size_t size) {
   size_t left = size;
   while (left > 0) {
     size_t to_write = left;
-    assert(write_head_->write_pos_ <= BUFFER_LENGTH);
-    size_t avail = BUFFER_LENGTH - write_head_->write_pos_;
+    assert(write_head_->write_pos_ <= chunk_size_);
+    size_t avail = chunk_size_ - write_head_->write_pos_;
 
     if (to_write > avail) to_write = avail;
 
     // Copy data
-    memcpy(write_head_->data_ + write_head_->write_pos_, data + offset, to_write);
+    memcpy(write_head_->data() + write_head_->write_pos_, data + offset, to_write);
 
     // Move pointers
     left -= to_write;
     offset += to_write;
     length_ += to_write;
     write_head_->write_pos_ += to_write;
-    assert(write_head_->write_pos_ <= BUFFER_LENGTH);
+    assert(write_head_->write_pos_ <= chunk_size_);
 
     // Go to next buffer if there still are some bytes to write
     if (left != 0) {
-      assert(write_head_->write_pos_ == BUFFER_LENGTH);
+      assert(write_head_->write_pos_ == chunk_size_);
       try_allocate_for_write();
       write_head_ = write_head_->next_;
 
@@ -204,24 +298,24 @@ void RingBuffer::write(const char* data, size_t size) {
 }
 
 char* RingBuffer::peek_writable(size_t* size) {
-  size_t available = BUFFER_LENGTH - write_head_->write_pos_;
+  size_t available = chunk_size_ - write_head_->write_pos_;
   if (*size != 0 && available > *size)
     available = *size;
   else
     *size = available;
 
-  return write_head_->data_ + write_head_->write_pos_;
+  return write_head_->data() + write_head_->write_pos_;
 }
 
 void RingBuffer::commit(size_t size) {
   write_head_->write_pos_ += size;
   length_ += size;
-  assert(write_head_->write_pos_ <= BUFFER_LENGTH);
+  assert(write_head_->write_pos_ <= chunk_size_);
 
   // Allocate new buffer if write head is full,
   // and there're no other place to go
   try_allocate_for_write();
-  if (write_head_->write_pos_ == BUFFER_LENGTH) {
+  if (write_head_->write_pos_ == chunk_size_) {
     write_head_ = write_head_->next_;
 
     // Additionally, since we're moved to the next buffer, read head
@@ -232,9 +326,9 @@ void RingBuffer::commit(size_t size) {
 
 void RingBuffer::try_allocate_for_write() {
   // If write head is full, next buffer is either read head or not empty.
-  if (write_head_->write_pos_ == BUFFER_LENGTH &&
+  if (write_head_->write_pos_ == chunk_size_ &&
       (write_head_->next_ == read_head_ || write_head_->next_->write_pos_ != 0)) {
-    Buffer* next = new Buffer();
+    Chunk* next = pool_->acquire();
     next->next_ = write_head_->next_;
     write_head_->next_ = next;
   }
@@ -42,48 +42,133 @@
 #ifndef DATASTAX_INTERNAL_RING_BUFFER_HPP
 #define DATASTAX_INTERNAL_RING_BUFFER_HPP
 
-#include "allocated.hpp"
+#include "huge_page_arena.hpp"
+#include "macros.hpp"
+#include "ref_counted.hpp"
 #include "small_vector.hpp"
 
 #include <uv.h>
 
 namespace datastax { namespace internal { namespace rb {
 
-class RingBuffer {
-private:
+/**
+ * A chunk of a ring buffer. The chunk's data follows the chunk in the same
+ * allocation.
+ */
+class Chunk {
+public:
+  Chunk()
+      : read_pos_(0)
+      , write_pos_(0)
+      , next_(NULL) {}
+
+  char* data() { return reinterpret_cast<char*>(this + 1); }
+
+  size_t read_pos_;
+  size_t write_pos_;
+  Chunk* next_;
+};
+
+/**
+ * A pool of same-sized ring buffer chunks. A pool is shared by the SSL
+ * sessions of a single event loop so that the chunks freed by one connection
+ * are reused by the others instead of being returned to the allocator. It's
+ * not thread-safe.
+ */
+class ChunkPool : public RefCounted<ChunkPool> {
+public:
+  typedef SharedRefPtr<ChunkPool> Ptr;
+
   // NOTE: Size is maximum TLS frame length, this is required if we want
-  // to fit whole ClientHello into one Buffer of RingBuffer.
-  static const size_t BUFFER_LENGTH = 16 * 1024 + 5;
-
-  class Buffer : public Allocated {
-  public:
-    Buffer()
-        : read_pos_(0)
-        , write_pos_(0)
-        , next_(NULL) {}
-
-    size_t read_pos_;
-    size_t write_pos_;
-    Buffer* next_;
-    char data_[BUFFER_LENGTH];
-  };
+  // to fit whole ClientHello into one chunk of RingBuffer.
+  static const size_t MIN_CHUNK_SIZE = 16 * 1024 + 5;
+  static const size_t DEFAULT_MAX_FREE_CHUNKS = 64;
+
+  /**
+   * Constructor.
+   *
+   * @param chunk_size The size of the chunks' data. Sizes smaller than
+   * MIN_CHUNK_SIZE are increased to MIN_CHUNK_SIZE.
+   * @param max_free_chunks The maximum number of free chunks kept by the
+   * pool.
+   * @param huge_pages If true, up to `max_free_chunks` chunks are placed in
+   * memory backed by huge pages when the system supports it.
+   */
+  ChunkPool(size_t chunk_size = MIN_CHUNK_SIZE,
+            size_t max_free_chunks = DEFAULT_MAX_FREE_CHUNKS, bool huge_pages = false)
+      : chunk_size_(chunk_size)
+      , max_free_chunks_(max_free_chunks)
+      , free_chunks_(NULL)
+      , free_arena_chunks_(NULL)
+      , free_count_(0)
+      , arena_chunk_count_(0) {
+    if (chunk_size_ < MIN_CHUNK_SIZE) chunk_size_ = MIN_CHUNK_SIZE;
+    if (huge_pages) {
+      // Leave room for each chunk's header and alignment
+      arena_.reset(new HugePageArena(max_free_chunks_ * (sizeof(Chunk) + chunk_size_ + 64)));
+    }
+  }
+
+  ~ChunkPool();
+
+  size_t chunk_size() const { return chunk_size_; }
+  size_t free_count() const { return free_count_; }
+
+  Chunk* acquire();
+  void release(Chunk* chunk);
+
+  /**
+   * Allocate and write to the maximum number of free chunks so that their
+   * memory is placed on the NUMA node of the calling thread.
+   */
+  void preallocate();
 
+  /**
+   * Determine if chunks are placed in memory backed by huge pages.
+   *
+   * @return true if huge pages are used.
+   */
+  bool is_using_huge_pages() const { return arena_ && arena_->is_mapped(); }
+
+private:
+  Chunk* allocate_chunk();
+  void free_chunk(Chunk* chunk);
+
+  bool is_arena_chunk(const Chunk* chunk) const { return arena_ && arena_->contains(chunk); }
+
+private:
+  size_t chunk_size_;
+  const size_t max_free_chunks_;
+  Chunk* free_chunks_;
+  // The arena's memory is never freed so its chunks are kept in their own
+  // free list. At most `max_free_chunks` chunks are placed in the arena so the
+  // pool never keeps more than the maximum number of free chunks.
+  Chunk* free_arena_chunks_;
+  size_t free_count_;
+  size_t arena_chunk_count_;
+  HugePageArena::Ptr arena_; // NULL unless chunks are backed by huge pages
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ChunkPool);
+};
+
+class RingBuffer {
 public:
   struct Position {
-    Position(Buffer* buf, size_t pos)
+    Position(Chunk* buf, size_t pos)
         : buf(buf)
         , pos(pos) {}
-    Buffer* buf;
+    Chunk* buf;
     size_t pos;
   };
 
-  RingBuffer()
-      : length_(0)
-      , read_head_(&head_)
-      , write_head_(&head_) {
-    // Loop head
-    head_.next_ = &head_;
-  }
+  /**
+   * Constructor.
+   *
+   * @param pool The pool the chunks are allocated from. If not provided, the
+   * ring buffer uses its own pool with the minimum chunk size.
+   */
+  RingBuffer(const ChunkPool::Ptr& pool = ChunkPool::Ptr());
 
   ~RingBuffer();
 
@@ -127,21 +212,28 @@ public:
   // Return size of buffer in bytes
   size_t inline length() { return length_; }
 
+  size_t chunk_size() const { return chunk_size_; }
+
 private:
+  ChunkPool::Ptr pool_;
+  const size_t chunk_size_;
   size_t length_;
-  Buffer head_;
-  Buffer* read_head_;
-  Buffer* write_head_;
+  Chunk* head_;
+  Chunk* read_head_;
+  Chunk* write_head_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(RingBuffer);
 };
 
 template <size_t N>
 size_t RingBuffer::peek_multiple(Position pos, SmallVector<uv_buf_t, N>* bufs) {
-  Buffer* buf = pos.buf;
+  Chunk* buf = pos.buf;
   size_t offset = pos.pos;
   size_t total = 0;
 
   while (true) {
-    char* base = (buf->data_ + offset);
+    char* base = (buf->data() + offset);
     size_t len = (buf->write_pos_ - offset);
     bufs->push_back(uv_buf_init(base, len));
     total += len;
@@ -51,7 +51,7 @@ CassHostDistance RoundRobinPolicy::distance(const Host::Ptr& host) const {
 
 QueryPlan* RoundRobinPolicy::new_query_plan(const String& keyspace, RequestHandler* request_handler,
                                             const TokenMap* token_map) {
-  return new RoundRobinQueryPlan(this, hosts_, index_++);
+  return new (request_handler) RoundRobinQueryPlan(this, hosts_, index_++);
 }
 
 bool RoundRobinPolicy::is_host_up(const Address& address) const {
@@ -80,7 +80,7 @@ void RoundRobinPolicy::on_host_down(const Address& address) {
   available_.erase(address);
 }
 
-Host::Ptr RoundRobinPolicy::RoundRobinQueryPlan::compute_next() {
+const Host::Ptr& RoundRobinPolicy::RoundRobinQueryPlan::compute_next() {
   while (remaining_ > 0) {
     --remaining_;
     const Host::Ptr& host((*hosts_)[index_++ % hosts_->size()]);
@@ -88,5 +88,5 @@ Host::Ptr RoundRobinPolicy::RoundRobinQueryPlan::compute_next() {
       return host;
     }
   }
-  return Host::Ptr();
+  return NO_HOST;
 }
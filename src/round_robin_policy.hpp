@@ -57,7 +57,7 @@ private:
         , index_(start_index)
         , remaining_(hosts->size()) {}
 
-    virtual Host::Ptr compute_next();
+    virtual const Host::Ptr& compute_next();
 
   private:
     const RoundRobinPolicy* policy_;
@@ -16,6 +16,7 @@
 
 #include "row.hpp"
 
+#include "column_handle.hpp"
 #include "external.hpp"
 #include "result_metadata.hpp"
 #include "result_response.hpp"
@@ -45,6 +46,11 @@ const CassValue* cass_row_get_column_by_name_n(const CassRow* row, const char* n
   return CassValue::to(row->get_by_name(StringRef(name, name_length)));
 }
 
+const CassValue* cass_row_get_column_by_handle(const CassRow* row,
+                                               const CassColumnHandle* column_handle) {
+  return CassValue::to(row->get_by_handle(*column_handle->from()));
+}
+
 } // extern "C"
 
 namespace datastax { namespace internal { namespace core {
@@ -80,6 +86,14 @@ const Value* Row::get_by_name(const StringRef& name) const {
   return &values[indices[0]];
 }
 
+const Value* Row::get_by_handle(const ColumnHandle& handle) const {
+  size_t index;
+  if (!handle.get_first_index(result_->metadata().get(), &index)) {
+    return NULL;
+  }
+  return &values[index];
+}
+
 bool Row::get_string_by_name(const StringRef& name, String* out) const {
   const Value* value = get_by_name(name);
   if (value == NULL || value->is_null()) {
@@ -24,6 +24,8 @@
 
 namespace datastax { namespace internal { namespace core {
 
+class ColumnHandle;
+
 class ResultResponse;
 
 class Row {
@@ -38,13 +40,15 @@ public:
 
   const Value* get_by_name(const StringRef& name) const;
 
+  const Value* get_by_handle(const ColumnHandle& handle) const;
+
   bool get_string_by_name(const StringRef& name, String* out) const;
 
   bool get_uuid_by_name(const StringRef& name, CassUuid* out) const;
 
   const ResultResponse* result() const { return result_; }
 
-  void set_result(ResultResponse* result) { result_ = result; }
+  void set_result(const ResultResponse* result) { result_ = result; }
 
 private:
   const ResultResponse* result_;
@@ -0,0 +1,100 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "row_batch.hpp"
+
+#include "result_columns.hpp"
+
+#include <algorithm>
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+extern "C" {
+
+CassRowBatch* cass_row_batch_new(size_t capacity) {
+  if (capacity == 0) {
+    return NULL;
+  }
+  return CassRowBatch::to(new RowBatch(capacity));
+}
+
+void cass_row_batch_free(CassRowBatch* batch) { delete batch->from(); }
+
+CassError cass_row_batch_decode(CassRowBatch* batch, const CassResult* result, size_t start_row) {
+  return batch->decode(result->from(), start_row);
+}
+
+size_t cass_row_batch_row_count(const CassRowBatch* batch) { return batch->row_count(); }
+
+const CassRow* cass_row_batch_get_row(const CassRowBatch* batch, size_t index) {
+  return CassRow::to(batch->row(index));
+}
+
+} // extern "C"
+
+CassError RowBatch::decode(const ResultResponse* result, size_t start_row) {
+  row_count_ = 0;
+
+  if (result->kind() != CASS_RESULT_KIND_ROWS) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+
+  const size_t total_row_count = static_cast<size_t>(result->row_count());
+  if (start_row > total_row_count) {
+    return CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS;
+  }
+
+  const size_t row_count = std::min(capacity_, total_row_count - start_row);
+  if (row_count == 0) {
+    return CASS_OK;
+  }
+
+  // The columnar index locates the start row without decoding the rows before
+  // it.
+  StringRef rows(result->rows());
+  size_t offset = 0;
+  if (result->column_count() > 0) {
+    const ResultColumns* columns = result->columns();
+    if (columns == NULL) {
+      return CASS_ERROR_LIB_NOT_ENOUGH_DATA;
+    }
+    offset = columns->row_offset(start_row);
+  }
+
+  Decoder decoder(rows.data() + offset, rows.size() - offset, result->protocol_version());
+
+  // Only the first row resolves each column's data type, the rest of the rows
+  // update the copied values in place.
+  Row& first = rows_[0];
+  first.set_result(result);
+  if (!decode_row(decoder, result, first.values)) {
+    return CASS_ERROR_LIB_NOT_ENOUGH_DATA;
+  }
+
+  for (size_t i = 1; i < row_count; ++i) {
+    Row& row = rows_[i];
+    row.set_result(result);
+    row.values = first.values;
+    if (!decode_next_row(decoder, row.values)) {
+      return CASS_ERROR_LIB_NOT_ENOUGH_DATA;
+    }
+  }
+
+  row_count_ = row_count;
+  return CASS_OK;
+}
@@ -0,0 +1,78 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_ROW_BATCH_HPP
+#define DATASTAX_INTERNAL_ROW_BATCH_HPP
+
+#include "allocated.hpp"
+#include "cassandra.h"
+#include "external.hpp"
+#include "macros.hpp"
+#include "result_response.hpp"
+#include "row.hpp"
+#include "vector.hpp"
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * Decodes a range of a result's rows in a single pass into rows that stay
+ * valid until the next decode. Unlike the rows of a result iterator, which are
+ * overwritten as the iterator advances, every row in a batch can be read at
+ * the same time e.g. by several application threads. The rows and their
+ * values are reused by subsequent decodes to avoid allocating for each batch.
+ */
+class RowBatch : public Allocated {
+public:
+  /**
+   * Constructor.
+   *
+   * @param capacity The maximum number of rows decoded at once.
+   */
+  explicit RowBatch(size_t capacity)
+      : capacity_(capacity)
+      , row_count_(0)
+      , rows_(capacity) {}
+
+  size_t capacity() const { return capacity_; }
+  size_t row_count() const { return row_count_; }
+
+  const Row* row(size_t index) const { return index < row_count_ ? &rows_[index] : NULL; }
+
+  /**
+   * Decode up to capacity() rows of a result starting at a row. The rows
+   * point into the result's data so the result must outlive their use.
+   *
+   * @param result A ROWS result.
+   * @param start_row The index of the first row to decode.
+   * @return CASS_OK if successful, otherwise an error occurred and the batch
+   * is empty.
+   */
+  CassError decode(const ResultResponse* result, size_t start_row);
+
+private:
+  size_t capacity_;
+  size_t row_count_;
+  Vector<Row> rows_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(RowBatch);
+};
+
+}}} // namespace datastax::internal::core
+
+EXTERNAL_TYPE(datastax::internal::core::RowBatch, CassRowBatch)
+
+#endif
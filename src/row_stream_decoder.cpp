@@ -0,0 +1,118 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "row_stream_decoder.hpp"
+
+#include "response.hpp"
+#include "serialization.hpp"
+
+using namespace datastax::internal::core;
+
+bool RowStreamDecoder::update(const ResponseMessage* response,
+                              const ResultMetadata::Ptr& metadata) {
+  if (is_invalid_) return false;
+
+  size_t received = 0;
+  const char* body = response->received_body(&received);
+  if (body == NULL) return false;
+  assert(body_ == NULL || body_ == body);
+  body_ = body;
+  received_ = received;
+
+  if (!result_) {
+    // The result's metadata and first row (if any) are decoded again after
+    // each read until enough of the body has been received
+    if (!decode_result(metadata, ProtocolVersion(response->version()), response->flags())) {
+      return !is_invalid_;
+    }
+    result_->set_buffer(response->body_buffer());
+  }
+  return true;
+}
+
+bool RowStreamDecoder::next_row(Row* row) {
+  if (!result_ || row_index_ >= result_->row_count()) return false;
+
+  // Make sure all of the row's values have been received before decoding it
+  const char* start = body_ + offset_;
+  const char* pos = start;
+  const char* end = body_ + received_;
+  for (int i = 0; i < result_->column_count(); ++i) {
+    if (end - pos < static_cast<ptrdiff_t>(sizeof(int32_t))) return false;
+    int32_t size = 0;
+    pos = decode_int32(pos, size);
+    if (size > 0) {
+      if (end - pos < size) return false;
+      pos += size;
+    }
+  }
+
+  Decoder decoder(start, pos - start, result_->protocol_version());
+  row->set_result(result_.get());
+  if (!decode_row(decoder, result_.get(), row->values)) {
+    is_invalid_ = true;
+    return false;
+  }
+  offset_ = pos - body_;
+  row_index_++;
+  return true;
+}
+
+bool RowStreamDecoder::decode_result(const ResultMetadata::Ptr& metadata, ProtocolVersion version,
+                                     uint8_t flags) {
+  Decoder decoder(body_, received_, version);
+  decoder.set_quiet(true);
+
+  if (flags & CASS_FLAG_TRACING) {
+    CassUuid tracing_id;
+    if (!decoder.decode_uuid(&tracing_id)) return false;
+  }
+
+  if (flags & CASS_FLAG_WARNING) {
+    // The warnings are logged when the whole response is decoded
+    uint16_t count = 0;
+    if (!decoder.decode_uint16(count)) return false;
+    for (uint16_t i = 0; i < count; ++i) {
+      StringRef warning;
+      if (!decoder.decode_string(&warning)) return false;
+    }
+  }
+
+  if (flags & CASS_FLAG_CUSTOM_PAYLOAD) {
+    CustomPayloadVec custom_payload;
+    if (!decoder.decode_custom_payload(custom_payload)) return false;
+  }
+
+  ResultResponse::Ptr result(new ResultResponse());
+  if (!result->decode(decoder)) return false;
+
+  // Only the rows of regular pages with metadata can be streamed
+  if (result->kind() != CASS_RESULT_KIND_ROWS || result->is_continuous_page()) {
+    is_invalid_ = true;
+    return false;
+  }
+  if (result->no_metadata()) {
+    if (!metadata) {
+      is_invalid_ = true;
+      return false;
+    }
+    result->set_metadata(metadata);
+  }
+
+  offset_ = result->rows().data() - body_;
+  result_ = result;
+  return true;
+}
@@ -0,0 +1,86 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_ROW_STREAM_DECODER_HPP
+#define DATASTAX_INTERNAL_ROW_STREAM_DECODER_HPP
+
+#include "allocated.hpp"
+#include "macros.hpp"
+#include "result_response.hpp"
+#include "row.hpp"
+
+namespace datastax { namespace internal { namespace core {
+
+class ResponseMessage;
+
+/**
+ * Decodes the rows of a ROWS result while its frame is still being received
+ * so that the rows can be used before the whole page has arrived. The result's
+ * metadata is decoded once enough of the body has been received, then each
+ * row is decoded once all of its values have been received.
+ */
+class RowStreamDecoder : public Allocated {
+public:
+  RowStreamDecoder()
+      : is_invalid_(false)
+      , body_(NULL)
+      , received_(0)
+      , offset_(0)
+      , row_index_(0) {}
+
+  /**
+   * Update the decoder with the part of a response's body that has been
+   * received so far.
+   *
+   * @param response A response whose body is being received.
+   * @param metadata The metadata of the rows if the result doesn't include
+   * its metadata (a bound statement's prepared result metadata). This can be
+   * NULL.
+   * @return false if the rows of the response can't be streamed, otherwise
+   * true.
+   */
+  bool update(const ResponseMessage* response, const ResultMetadata::Ptr& metadata);
+
+  /**
+   * Decode the next row if all of its values have been received.
+   *
+   * @param row The row (output). It's only valid until the response is
+   * released.
+   * @return true if a row was decoded, otherwise false.
+   */
+  bool next_row(Row* row);
+
+  // The index of the next row in the page
+  int32_t row_index() const { return row_index_; }
+
+private:
+  bool decode_result(const ResultMetadata::Ptr& metadata, ProtocolVersion version, uint8_t flags);
+
+private:
+  bool is_invalid_;
+  ResultResponse::Ptr result_;
+  const char* body_;
+  size_t received_;
+  size_t offset_;
+  int32_t row_index_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(RowStreamDecoder);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -18,23 +18,26 @@
 
 #include "result_iterator.hpp"
 
-#define RETRY_SCHEMA_AGREEMENT_WAIT_MS 200
+#include <algorithm>
+
+#define MAX_TARGETED_PEERS 8
 #define SELECT_LOCAL_SCHEMA "SELECT schema_version FROM system.local WHERE key='local'"
 #define SELECT_PEERS_SCHEMA "SELECT peer, rpc_address, host_id, schema_version FROM system.peers"
 
 using namespace datastax;
 using namespace datastax::internal::core;
 
-SchemaAgreementHandler::SchemaAgreementHandler(const RequestHandler::Ptr& request_handler,
-                                               const Host::Ptr& current_host,
-                                               const Response::Ptr& response,
-                                               SchemaAgreementListener* listener,
-                                               uint64_t max_wait_time_ms,
-                                               const AddressFactory::Ptr& address_factory)
+SchemaAgreementHandler::SchemaAgreementHandler(
+    const RequestHandler::Ptr& request_handler, const Host::Ptr& current_host,
+    const Response::Ptr& response, SchemaAgreementListener* listener, uint64_t max_wait_time_ms,
+    uint64_t retry_wait_time_ms, uint64_t max_retry_wait_time_ms,
+    const AddressFactory::Ptr& address_factory)
     : WaitForHandler(request_handler, current_host, response, max_wait_time_ms,
-                     RETRY_SCHEMA_AGREEMENT_WAIT_MS)
+                     retry_wait_time_ms)
     , listener_(listener)
-    , address_factory_(address_factory) {}
+    , address_factory_(address_factory)
+    , max_retry_wait_time_ms_(max_retry_wait_time_ms)
+    , is_retrying_(false) {}
 
 ChainedRequestCallback::Ptr SchemaAgreementHandler::callback() {
   WaitforRequestVec requests;
@@ -58,34 +61,79 @@ bool SchemaAgreementHandler::on_set(const ChainedRequestCallback::Ptr& callback)
     LOG_DEBUG("No row found in %s's local system table", host()->address_string().c_str());
   }
 
-  ResultResponse::Ptr peers_result(callback->result("peers"));
-  if (peers_result) {
-    ResultIterator rows(peers_result.get());
-    while (rows.next()) {
-      const Row* row = rows.row();
-
-      Address address;
-      bool is_valid_address = address_factory_->create(row, this->host(), &address);
-
-      if (is_valid_address && listener_->on_is_host_up(address)) {
-        const Value* v = row->get_by_name("schema_version");
-        if (!row->get_by_name("rpc_address")->is_null() && !v->is_null()) {
-          StringRef version(v->to_string_ref());
-          if (version != current_version) {
-            LOG_DEBUG("Schema still not up-to-date on some live nodes. "
-                      "Trying again in %llu ms",
-                      static_cast<unsigned long long>(retry_wait_time_ms()));
-            return false;
+  StringVec outliers;
+  bool is_outlier_unknown = false;
+  if (peer_keys_.empty()) {
+    check_peers(callback->result("peers"), current_version, &outliers, &is_outlier_unknown);
+  } else {
+    for (StringVec::const_iterator it = peer_keys_.begin(), end = peer_keys_.end(); it != end;
+         ++it) {
+      check_peers(callback->result(*it), current_version, &outliers, &is_outlier_unknown);
+    }
+  }
+
+  if (outliers.empty() && !is_outlier_unknown) {
+    LOG_DEBUG("Found schema agreement in %llu ms",
+              static_cast<unsigned long long>(get_time_since_epoch_ms() - start_time_ms()));
+    return true;
+  }
+
+  // Only query the peers that don't agree yet, unless there are too many of
+  // them or they can't be queried by their listen address.
+  WaitforRequestVec requests;
+  requests.push_back(make_request("local", SELECT_LOCAL_SCHEMA));
+  peer_keys_.clear();
+  if (is_outlier_unknown || outliers.size() > MAX_TARGETED_PEERS) {
+    requests.push_back(make_request("peers", SELECT_PEERS_SCHEMA));
+  } else {
+    for (StringVec::const_iterator it = outliers.begin(), end = outliers.end(); it != end; ++it) {
+      String key("peer:" + *it);
+      requests.push_back(make_request(key, SELECT_PEERS_SCHEMA " WHERE peer = '" + *it + "'"));
+      peer_keys_.push_back(key);
+    }
+  }
+
+  uint64_t wait_time_ms = retry_wait_time_ms();
+  if (is_retrying_) {
+    wait_time_ms = std::min(wait_time_ms * 2, max_retry_wait_time_ms_);
+  }
+  is_retrying_ = true;
+  set_retry(requests, wait_time_ms);
+
+  LOG_DEBUG("Schema still not up-to-date on %u live nodes. "
+            "Trying again in %llu ms",
+            static_cast<unsigned>(outliers.size()),
+            static_cast<unsigned long long>(wait_time_ms));
+  return false;
+}
+
+void SchemaAgreementHandler::check_peers(const ResultResponse::Ptr& result,
+                                         const StringRef& current_version, StringVec* outliers,
+                                         bool* is_outlier_unknown) {
+  if (!result) return;
+
+  ResultIterator rows(result.get());
+  while (rows.next()) {
+    const Row* row = rows.row();
+
+    Address address;
+    bool is_valid_address = address_factory_->create(row, this->host(), &address);
+
+    if (is_valid_address && listener_->on_is_host_up(address)) {
+      const Value* v = row->get_by_name("schema_version");
+      if (!row->get_by_name("rpc_address")->is_null() && !v->is_null()) {
+        StringRef version(v->to_string_ref());
+        if (version != current_version) {
+          String listen_address(determine_listen_address(address, row));
+          if (listen_address.empty()) {
+            *is_outlier_unknown = true;
+          } else {
+            outliers->push_back(listen_address);
           }
         }
       }
     }
   }
-
-  LOG_DEBUG("Found schema agreement in %llu ms",
-            static_cast<unsigned long long>(get_time_since_epoch_ms() - start_time_ms()));
-
-  return true;
 }
 
 void SchemaAgreementHandler::on_error(WaitForHandler::WaitForError code, const String& message) {
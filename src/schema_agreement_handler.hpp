@@ -44,6 +44,12 @@ public:
  * A handler that waits for schema agreement after schema changes. It waits for
  * schema to propagate to all nodes then it sets the future of the request that
  * originally made the schema change.
+ *
+ * The first check queries all the peers. The following checks only query the
+ * peers that didn't agree yet (when there are only a few of them) and the
+ * time between the checks doubles, from the initial up to the maximum
+ * interval, so that quick agreements are found quickly without polling slow
+ * ones too often.
  */
 class SchemaAgreementHandler : public WaitForHandler {
 public:
@@ -58,11 +64,16 @@ public:
    * @param listener A listener for determining host liveness.
    * @param max_wait_time_ms The maximum amount of time to wait for the data to
    * become available.
+   * @param retry_wait_time_ms The initial amount of time to wait between checks.
+   * @param max_retry_wait_time_ms The maximum amount of time to wait between
+   * checks.
    * @param address_factory Address factory for determining peer addresses.
    */
   SchemaAgreementHandler(const RequestHandler::Ptr& request_handler, const Host::Ptr& current_host,
                          const Response::Ptr& response, SchemaAgreementListener* listener,
-                         uint64_t max_wait_time_ms, const AddressFactory::Ptr& address_factory);
+                         uint64_t max_wait_time_ms, uint64_t retry_wait_time_ms,
+                         uint64_t max_retry_wait_time_ms,
+                         const AddressFactory::Ptr& address_factory);
 
   /**
    * Gets a request callback for executing queries on behalf of the handler.
@@ -75,9 +86,15 @@ private:
   virtual bool on_set(const ChainedRequestCallback::Ptr& callback);
   virtual void on_error(WaitForError code, const String& message);
 
+  void check_peers(const ResultResponse::Ptr& result, const StringRef& current_version,
+                   StringVec* outliers, bool* is_outlier_unknown);
+
 private:
   SchemaAgreementListener* const listener_;
   AddressFactory::Ptr address_factory_;
+  const uint64_t max_retry_wait_time_ms_;
+  StringVec peer_keys_; // The keys of the targeted peer queries (empty if all peers are queried)
+  bool is_retrying_;
 };
 
 }}} // namespace datastax::internal::core
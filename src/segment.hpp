@@ -0,0 +1,139 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_SEGMENT_HPP
+#define DATASTAX_INTERNAL_SEGMENT_HPP
+
+#include "allocated.hpp"
+#include "buffer.hpp"
+#include "macros.hpp"
+#include "vector.hpp"
+
+#include <uv.h>
+
+#define SEGMENT_HEADER_LENGTH 6  // 3 byte header + 3 byte CRC24
+#define SEGMENT_TRAILER_LENGTH 4 // CRC32 of the payload
+#define SEGMENT_MAX_PAYLOAD_LENGTH (128 * 1024 - 1)
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * Compute the CRC24 used to protect a segment's header.
+ *
+ * @param value The header bytes (little-endian).
+ * @param length The number of bytes in the header.
+ * @return The CRC24 value.
+ */
+uint32_t segment_crc24(uint64_t value, size_t length);
+
+/**
+ * Compute the CRC32 used to protect a segment's payload.
+ *
+ * @param data The payload.
+ * @param length The length of the payload.
+ * @return The CRC32 value.
+ */
+uint32_t segment_crc32(const char* data, size_t length);
+
+/**
+ * An encoder for the protocol v5 (and later) outer framing. Encoded envelopes
+ * (v4 style frames) are packed into self-contained segments and envelopes
+ * that are too large for a single segment are split across several segments.
+ */
+class SegmentEncoder : public Allocated {
+public:
+  SegmentEncoder() {}
+
+  /**
+   * Replace a write's encoded envelopes with segments.
+   *
+   * @param sizes The size of each envelope in the buffers.
+   * @param bufs The encoded envelopes. On return these are the encoded
+   * segments.
+   */
+  void encode(const SizeVec& sizes, BufferVec* bufs);
+
+private:
+  BufferVec segments_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(SegmentEncoder);
+};
+
+/**
+ * A decoder for the protocol v5 (and later) outer framing. This is an
+ * incremental decoder that's fed socket data until a complete segment is
+ * available.
+ */
+class SegmentDecoder : public Allocated {
+public:
+  SegmentDecoder()
+      : state_(STATE_HEADER)
+      , payload_(NULL)
+      , payload_length_(0)
+      , is_self_contained_(false)
+      , is_payload_copied_(false) {}
+
+  /**
+   * Decode socket data.
+   *
+   * @param input The socket data.
+   * @param size The size of the socket data.
+   * @return The number of bytes consumed or negative if an error occurred.
+   */
+  ssize_t decode(const char* input, size_t size);
+
+  /**
+   * Determine if a complete segment has been decoded. The payload is only
+   * valid until the next call to decode().
+   *
+   * @return true if the segment's payload is available.
+   */
+  bool is_ready() const { return state_ == STATE_READY; }
+
+  const char* payload() const { return payload_; }
+  size_t payload_length() const { return payload_length_; }
+  bool is_self_contained() const { return is_self_contained_; }
+
+  /**
+   * Determine if the payload was copied into the decoder's own buffer because
+   * the segment straddled several calls to decode(). Otherwise, the payload
+   * references the input.
+   *
+   * @return true if the payload was copied.
+   */
+  bool is_payload_copied() const { return is_payload_copied_; }
+
+private:
+  enum State { STATE_HEADER, STATE_PAYLOAD, STATE_READY };
+
+  const char* buffer(const char*& pos, size_t& remaining, size_t needed);
+
+private:
+  State state_;
+  Vector<char> buffer_;
+  const char* payload_;
+  size_t payload_length_;
+  bool is_self_contained_;
+  bool is_payload_copied_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(SegmentDecoder);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -224,6 +224,64 @@ inline int64_t decode_zig_zag(uint64_t n) {
 
 inline uint64_t encode_zig_zag(int64_t n) { return (n << 1) ^ (n >> 63); }
 
+// The number of bytes that follow the first byte of a vint: the number of
+// leading ones in the first byte.
+inline int vint_extra_bytes(uint8_t first_byte) {
+  // Invert the first byte so that the leading ones become zeros, mask out the
+  // sign extension and only count the zeros of the byte, not the 64-bit int.
+  return static_cast<int>(num_leading_zeros(~first_byte & 0xff)) - 56;
+}
+
+// Decode an unsigned vint. When there are at least 8 bytes after the first
+// byte the value's bytes are read using a single big-endian load and shifted
+// into place instead of one at a time. Returns NULL if the input is too short.
+inline const char* decode_vint(const char* input, size_t remaining, uint64_t& output) {
+  uint8_t first_byte = static_cast<uint8_t>(*input);
+  if (first_byte < 0x80) { // Single byte values are the most common
+    output = first_byte;
+    return input + 1;
+  }
+
+  int extra_bytes = vint_extra_bytes(first_byte);
+  if (remaining < static_cast<size_t>(extra_bytes) + 1) return NULL;
+
+  // The first byte holds the size as well as the value's most significant bits
+  uint64_t value = first_byte & (0xff >> extra_bytes);
+  if (remaining >= sizeof(int64_t) + 1) {
+    int64_t bytes;
+    decode_int64(input + 1, bytes);
+    // Shifting by 64 is undefined so the high bits are shifted in two steps.
+    // There are no high bits for 8 extra bytes.
+    output = ((value << (8 * extra_bytes - 1)) << 1) |
+             (static_cast<uint64_t>(bytes) >> (64 - 8 * extra_bytes));
+  } else {
+    for (int i = 1; i <= extra_bytes; ++i) {
+      value = (value << 8) | static_cast<uint8_t>(input[i]);
+    }
+    output = value;
+  }
+  return input + extra_bytes + 1;
+}
+
+// Decode a duration: three zig-zag encoded vints for the months, days and
+// nanoseconds. Returns false if the input is too short.
+inline bool decode_duration(const char* input, size_t size, int32_t* months, int32_t* days,
+                            int64_t* nanos) {
+  const char* end = input + size;
+  uint64_t decoded = 0;
+
+  if (input == end || (input = decode_vint(input, end - input, decoded)) == NULL) return false;
+  *months = static_cast<int32_t>(decode_zig_zag(decoded));
+
+  if (input == end || (input = decode_vint(input, end - input, decoded)) == NULL) return false;
+  *days = static_cast<int32_t>(decode_zig_zag(decoded));
+
+  if (input == end || (input = decode_vint(input, end - input, decoded)) == NULL) return false;
+  *nanos = decode_zig_zag(decoded);
+
+  return true;
+}
+
 }} // namespace datastax::internal
 
 #endif
@@ -19,20 +19,41 @@
 #include "batch_request.hpp"
 #include "cluster_config.hpp"
 #include "constants.hpp"
+#include "continuous_paging.hpp"
 #include "execute_request.hpp"
 #include "external.hpp"
 #include "logger.hpp"
+#include "map.hpp"
+#include "memory_accounting.hpp"
 #include "metrics.hpp"
 #include "monitor_reporting.hpp"
+#include "open_metrics.hpp"
 #include "prepare_all_handler.hpp"
 #include "prepare_request.hpp"
 #include "request_processor_initializer.hpp"
 #include "scoped_lock.hpp"
 #include "statement.hpp"
 
+#include <algorithm>
+
 using namespace datastax;
+using namespace datastax::internal;
 using namespace datastax::internal::core;
 
+static void copy_latency_snapshot(const Metrics::Histogram::Snapshot& snapshot,
+                                  CassLatencyMetrics* metrics) {
+  metrics->min = snapshot.min;
+  metrics->max = snapshot.max;
+  metrics->mean = snapshot.mean;
+  metrics->stddev = snapshot.stddev;
+  metrics->median = snapshot.median;
+  metrics->percentile_75th = snapshot.percentile_75th;
+  metrics->percentile_95th = snapshot.percentile_95th;
+  metrics->percentile_98th = snapshot.percentile_98th;
+  metrics->percentile_99th = snapshot.percentile_99th;
+  metrics->percentile_999th = snapshot.percentile_999th;
+}
+
 extern "C" {
 
 CassSession* cass_session_new() {
@@ -88,21 +109,74 @@ CassFuture* cass_session_prepare_from_existing(CassSession* session, CassStateme
 }
 
 CassFuture* cass_session_execute(CassSession* session, const CassStatement* statement) {
-  Future::Ptr future(session->execute(Request::ConstPtr(statement->from())));
+  Future::Ptr future(session->execute(statement->from()->execution_request()));
   future->inc_ref();
   return CassFuture::to(future.get());
 }
 
+CassFuture* cass_session_get_next_page(CassSession* session, CassFuture* future) {
+  if (future->type() != Future::FUTURE_TYPE_RESPONSE) {
+    return NULL;
+  }
+  ResponseFuture::Ptr next_page(
+      session->take_next_page(static_cast<ResponseFuture*>(future->from())));
+  if (!next_page) {
+    return NULL;
+  }
+  next_page->inc_ref();
+  return CassFuture::to(next_page.get());
+}
+
 CassFuture* cass_session_execute_batch(CassSession* session, const CassBatch* batch) {
   Future::Ptr future(session->execute(Request::ConstPtr(batch->from())));
   future->inc_ref();
   return CassFuture::to(future.get());
 }
 
+CassFuture* cass_session_execute_many(CassSession* session, const CassStatement* const* statements,
+                                      size_t statements_count) {
+  Vector<Request::ConstPtr> requests;
+  if (statements != NULL) {
+    requests.reserve(statements_count);
+    for (size_t i = 0; i < statements_count; ++i) {
+      requests.push_back(statements[i]->from()->execution_request());
+    }
+  }
+  Future::Ptr future(session->execute_many(requests));
+  future->inc_ref();
+  return CassFuture::to(future.get());
+}
+
+void cass_session_execute_all(CassSession* session, const CassStatement* const* statements,
+                              size_t statements_count, CassFuture** futures) {
+  Vector<Request::ConstPtr> requests;
+  requests.reserve(statements_count);
+  for (size_t i = 0; i < statements_count; ++i) {
+    requests.push_back(statements[i]->from()->execution_request());
+  }
+  Vector<Future::Ptr> internal_futures;
+  session->execute_all(requests, &internal_futures);
+  for (size_t i = 0; i < internal_futures.size(); ++i) {
+    internal_futures[i]->inc_ref();
+    futures[i] = CassFuture::to(internal_futures[i].get());
+  }
+}
+
 const CassSchemaMeta* cass_session_get_schema_meta(const CassSession* session) {
   return CassSchemaMeta::to(new Metadata::SchemaSnapshot(session->cluster()->schema_snapshot()));
 }
 
+const CassSchemaMeta* cass_session_refresh_schema_meta(const CassSession* session,
+                                                       const CassSchemaMeta* schema_meta) {
+  if (schema_meta != NULL) {
+    if (schema_meta->version() == session->cluster()->schema_snapshot_version()) {
+      return schema_meta; // Still up-to-date
+    }
+    delete schema_meta->from();
+  }
+  return CassSchemaMeta::to(new Metadata::SchemaSnapshot(session->cluster()->schema_snapshot()));
+}
+
 void cass_session_get_metrics(const CassSession* session, CassMetrics* metrics) {
   const Metrics* internal_metrics = session->metrics();
 
@@ -167,11 +241,361 @@ void cass_session_get_speculative_execution_metrics(const CassSession* session,
   metrics->percentage = internal_metrics->request_rates.speculative_request_percent();
 }
 
+void cass_session_get_buffer_pool_metrics(const CassSession* session,
+                                          CassBufferPoolMetrics* metrics) {
+  const Metrics* internal_metrics = session->metrics();
+
+  if (internal_metrics == NULL) {
+    LOG_WARN("Attempted to get buffer pool metrics before connecting session object");
+    memset(metrics, 0, sizeof(CassBufferPoolMetrics));
+    return;
+  }
+
+  metrics->hits = internal_metrics->buffer_pool_hits.sum();
+  metrics->misses = internal_metrics->buffer_pool_misses.sum();
+}
+
+void cass_session_get_result_cache_metrics(const CassSession* session,
+                                           CassResultCacheMetrics* metrics) {
+  const ResultCache::Ptr& result_cache = session->result_cache();
+  if (!result_cache) {
+    memset(metrics, 0, sizeof(CassResultCacheMetrics));
+    return;
+  }
+  result_cache->get_metrics(metrics);
+}
+
+void cass_session_get_rack_metrics(const CassSession* session, CassRackMetrics* metrics) {
+  const Metrics* internal_metrics = session->metrics();
+
+  if (internal_metrics == NULL) {
+    LOG_WARN("Attempted to get rack metrics before connecting session object");
+    memset(metrics, 0, sizeof(CassRackMetrics));
+    return;
+  }
+
+  metrics->local_rack_requests = internal_metrics->local_rack_requests.sum();
+  metrics->local_dc_requests = internal_metrics->local_dc_requests.sum();
+  metrics->remote_dc_requests = internal_metrics->remote_dc_requests.sum();
+}
+
+void cass_session_get_retry_metrics(const CassSession* session, CassRetryMetrics* metrics) {
+  const Metrics* internal_metrics = session->metrics();
+
+  if (internal_metrics == NULL) {
+    LOG_WARN("Attempted to get retry metrics before connecting session object");
+    memset(metrics, 0, sizeof(CassRetryMetrics));
+    return;
+  }
+
+  metrics->retries = internal_metrics->retries.sum();
+  metrics->denied_retries = internal_metrics->denied_retries.sum();
+}
+
+void cass_session_get_protocol_metrics(const CassSession* session, CassProtocolMetrics* metrics) {
+  const Metrics* internal_metrics = session->metrics();
+
+  if (internal_metrics == NULL) {
+    LOG_WARN("Attempted to get protocol metrics before connecting session object");
+    memset(metrics, 0, sizeof(CassProtocolMetrics));
+    return;
+  }
+
+  metrics->protocol_downgrades = internal_metrics->protocol_downgrades.sum();
+  metrics->downgraded_connections = internal_metrics->downgraded_connections.sum();
+}
+
+void cass_session_get_request_stage_metrics(const CassSession* session,
+                                            CassRequestStageMetrics* metrics) {
+  const Metrics* internal_metrics = session->metrics();
+
+  if (internal_metrics == NULL) {
+    LOG_WARN("Attempted to get request stage metrics before connecting session object");
+    memset(metrics, 0, sizeof(CassRequestStageMetrics));
+    return;
+  }
+
+  const Metrics::StageLatencies* stage_latencies = internal_metrics->stage_latencies.get();
+  if (stage_latencies == NULL) {
+    memset(metrics, 0, sizeof(CassRequestStageMetrics));
+    return;
+  }
+
+  Metrics::Histogram::Snapshot snapshot;
+  stage_latencies->queue.get_snapshot(&snapshot);
+  copy_latency_snapshot(snapshot, &metrics->queue);
+  stage_latencies->write.get_snapshot(&snapshot);
+  copy_latency_snapshot(snapshot, &metrics->write);
+  stage_latencies->server.get_snapshot(&snapshot);
+  copy_latency_snapshot(snapshot, &metrics->server);
+  stage_latencies->callback.get_snapshot(&snapshot);
+  copy_latency_snapshot(snapshot, &metrics->callback);
+}
+
+CassSlowRequest* cass_session_get_slow_request(CassSession* session) {
+  const SlowRequestLog::Ptr& slow_request_log = session->slow_request_log();
+  if (!slow_request_log) return NULL;
+  return CassSlowRequest::to(slow_request_log->next());
+}
+
+cass_uint64_t cass_session_get_dropped_slow_request_count(const CassSession* session) {
+  const SlowRequestLog::Ptr& slow_request_log = session->slow_request_log();
+  return slow_request_log ? slow_request_log->dropped() : 0;
+}
+
+size_t cass_session_get_interval_metrics(const CassSession* session, CassLatencyMetrics* metrics,
+                                         CassHistogramBucket* buckets, size_t bucket_count) {
+  const Metrics* internal_metrics = session->metrics();
+
+  if (internal_metrics == NULL) {
+    LOG_WARN("Attempted to get interval metrics before connecting session object");
+    memset(metrics, 0, sizeof(CassLatencyMetrics));
+    return 0;
+  }
+
+  Metrics::Histogram::Snapshot snapshot;
+  internal::Vector<Metrics::Histogram::Bucket> recorded;
+  internal_metrics->request_latencies.get_interval_snapshot(&snapshot,
+                                                            buckets != NULL ? &recorded : NULL);
+  copy_latency_snapshot(snapshot, metrics);
+
+  if (buckets == NULL) return 0;
+  for (size_t i = 0; i < recorded.size() && i < bucket_count; ++i) {
+    buckets[i].value = recorded[i].value;
+    buckets[i].count = recorded[i].count;
+  }
+  return recorded.size();
+}
+
+size_t cass_session_get_open_metrics(const CassSession* session, char* output,
+                                     size_t output_size) {
+  if (session->metrics() == NULL) {
+    LOG_WARN("Attempted to get OpenMetrics before connecting session object");
+  }
+
+  String metrics(session->open_metrics());
+  if (output_size > 0) {
+    size_t length = std::min(metrics.size(), output_size - 1);
+    memcpy(output, metrics.data(), length);
+    output[length] = '\0';
+  }
+  return metrics.size();
+}
+
+CassError cass_session_get_connection_metrics(const CassSession* session, const char* host,
+                                              int port, CassConnectionMetrics* metrics) {
+  return cass_session_get_connection_metrics_n(session, host, SAFE_STRLEN(host), port, metrics);
+}
+
+CassError cass_session_get_connection_metrics_n(const CassSession* session, const char* host,
+                                                size_t host_length, int port,
+                                                CassConnectionMetrics* metrics) {
+  memset(metrics, 0, sizeof(CassConnectionMetrics));
+
+  Address address(String(host, host_length), port);
+  if (!address.is_valid_and_resolved()) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+
+  if (!session->cluster()) {
+    LOG_WARN("Attempted to get connection metrics before connecting session object");
+    return CASS_ERROR_LIB_NO_HOSTS_AVAILABLE;
+  }
+
+  Host::Ptr internal_host(session->cluster()->find_host(address));
+  if (!internal_host) {
+    return CASS_ERROR_LIB_NO_HOSTS_AVAILABLE;
+  }
+
+  metrics->connections = std::max(0, internal_host->connection_count());
+  metrics->bytes_written = internal_host->bytes_written();
+  metrics->bytes_read = internal_host->bytes_read();
+  metrics->flushes = internal_host->flushes();
+  metrics->flushed_requests = internal_host->flushed_requests();
+  metrics->max_inflight_requests = std::max(0, internal_host->max_connection_inflight_requests());
+  metrics->max_write_queue_bytes = internal_host->max_write_queue_bytes();
+  return CASS_OK;
+}
+
+CassError cass_session_get_host_metrics(const CassSession* session, const char* host, int port,
+                                        CassLatencyMetrics* metrics) {
+  return cass_session_get_host_metrics_n(session, host, SAFE_STRLEN(host), port, metrics);
+}
+
+CassError cass_session_get_host_metrics_n(const CassSession* session, const char* host,
+                                          size_t host_length, int port,
+                                          CassLatencyMetrics* metrics) {
+  memset(metrics, 0, sizeof(CassLatencyMetrics));
+
+  Address address(String(host, host_length), port);
+  if (!address.is_valid_and_resolved()) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+
+  const Metrics* internal_metrics = session->metrics();
+  if (internal_metrics == NULL) {
+    LOG_WARN("Attempted to get host metrics before connecting session object");
+    return CASS_ERROR_LIB_NO_HOSTS_AVAILABLE;
+  }
+
+  Metrics::Histogram::Snapshot snapshot;
+  if (!internal_metrics->get_host_latencies_snapshot(address, &snapshot)) {
+    return CASS_ERROR_LIB_NO_HOSTS_AVAILABLE;
+  }
+  copy_latency_snapshot(snapshot, metrics);
+  return CASS_OK;
+}
+
+CassError cass_session_get_execution_profile_metrics(const CassSession* session, const char* name,
+                                                     CassLatencyMetrics* metrics) {
+  return cass_session_get_execution_profile_metrics_n(session, name, SAFE_STRLEN(name), metrics);
+}
+
+CassError cass_session_get_execution_profile_metrics_n(const CassSession* session,
+                                                       const char* name, size_t name_length,
+                                                       CassLatencyMetrics* metrics) {
+  memset(metrics, 0, sizeof(CassLatencyMetrics));
+
+  const Metrics* internal_metrics = session->metrics();
+  if (internal_metrics == NULL) {
+    LOG_WARN("Attempted to get execution profile metrics before connecting session object");
+    return CASS_ERROR_LIB_EXECUTION_PROFILE_INVALID;
+  }
+
+  Metrics::Histogram::Snapshot snapshot;
+  if (!internal_metrics->get_profile_latencies_snapshot(String(name, name_length), &snapshot)) {
+    return CASS_ERROR_LIB_EXECUTION_PROFILE_INVALID;
+  }
+  copy_latency_snapshot(snapshot, metrics);
+  return CASS_OK;
+}
+
+size_t cass_session_get_event_loop_metrics(const CassSession* session,
+                                           CassEventLoopMetrics* metrics, size_t count) {
+  const RoundRobinEventLoopGroup* event_loop_group = session->event_loop_group();
+
+  if (event_loop_group == NULL) {
+    LOG_WARN("Attempted to get event loop metrics before connecting session object");
+    return 0;
+  }
+
+  size_t size = event_loop_group->size();
+  for (size_t i = 0; i < size && i < count; ++i) {
+    const EventLoop* event_loop = event_loop_group->get(i);
+    metrics[i].busy_time_us = event_loop->busy_time() / 1000;
+    metrics[i].idle_time_us = event_loop->idle_time() / 1000;
+    metrics[i].tasks_run = event_loop->tasks_run();
+    metrics[i].tasks_stolen = event_loop->tasks_stolen();
+    metrics[i].utilization = event_loop->utilization() / 1000.0;
+    metrics[i].pending_tasks = event_loop->pending_task_count();
+  }
+  return size;
+}
+
+size_t cass_session_get_request_processor_metrics(const CassSession* session,
+                                                  CassRequestProcessorMetrics* metrics,
+                                                  size_t count) {
+  const RequestProcessor::Vec& request_processors = session->request_processors();
+
+  size_t size = request_processors.size();
+  for (size_t i = 0; i < size && i < count; ++i) {
+    const RequestProcessor::Ptr& request_processor = request_processors[i];
+    // The request count includes queued requests
+    size_t queued = request_processor->queued_request_count();
+    int request_count = request_processor->request_count();
+    metrics[i].queued_requests = queued;
+    metrics[i].inflight_requests =
+        request_count > static_cast<int>(queued) ? request_count - queued : 0;
+    metrics[i].batches = request_processor->batch_count();
+    metrics[i].batched_requests = request_processor->batched_request_count();
+  }
+  return size;
+}
+
+void cass_session_get_startup_timings(const CassSession* session, CassStartupTimings* timings) {
+  StartupTimings internal_timings(session->startup_timings());
+  timings->resolve_us = internal_timings.resolve / 1000;
+  timings->control_connection_us = internal_timings.control_connection / 1000;
+  timings->hosts_query_us = internal_timings.hosts_query / 1000;
+  timings->schema_query_us = internal_timings.schema_query / 1000;
+  timings->metadata_us = internal_timings.metadata / 1000;
+  timings->connection_pools_us = internal_timings.connection_pools / 1000;
+  timings->total_us = internal_timings.total / 1000;
+}
+
+void cass_session_get_token_map_metrics(const CassSession* session,
+                                        CassTokenMapMetrics* metrics) {
+  TokenMapMetrics internal_metrics;
+  session->token_map_metrics(&internal_metrics);
+  metrics->keyspaces = internal_metrics.keyspaces;
+  metrics->replica_vectors = internal_metrics.replica_vectors;
+  metrics->tokens = internal_metrics.tokens;
+  metrics->memory_bytes = internal_metrics.memory_bytes;
+}
+
+void cass_session_get_prepared_metadata_metrics(const CassSession* session,
+                                                CassPreparedMetadataMetrics* metrics) {
+  PreparedMetadataMetrics internal_metrics;
+  session->prepared_metadata_metrics(&internal_metrics);
+  metrics->entries = internal_metrics.entries;
+  metrics->max_entries = internal_metrics.max_entries;
+  metrics->evictions = internal_metrics.evictions;
+}
+
+void cass_session_get_memory_metrics(const CassSession* session, CassMemoryMetrics* metrics) {
+  TokenMapMetrics token_map_metrics;
+  session->token_map_metrics(&token_map_metrics);
+  const InflightLimiter* inflight_limiter = session->inflight_limiter();
+  metrics->request_buffer_bytes = MemoryAccounting::bytes(MEMORY_CATEGORY_REQUEST_BUFFERS);
+  metrics->response_buffer_bytes = MemoryAccounting::bytes(MEMORY_CATEGORY_RESPONSE_BUFFERS);
+  metrics->metadata_bytes = MemoryAccounting::bytes(MEMORY_CATEGORY_METADATA);
+  metrics->token_map_bytes = token_map_metrics.memory_bytes;
+  metrics->ssl_buffer_bytes = MemoryAccounting::bytes(MEMORY_CATEGORY_SSL_BUFFERS);
+  metrics->memory_limit = inflight_limiter ? inflight_limiter->max_buffer_bytes() : 0;
+}
+
+cass_uint64_t cass_session_get_waiting_request_count(const CassSession* session) {
+  const InflightLimiter* inflight_limiter = session->inflight_limiter();
+  return inflight_limiter ? inflight_limiter->waiting_request_count() : 0;
+}
+
 CassUuid cass_session_get_client_id(CassSession* session) { return session->client_id(); }
 
+CassError cass_session_get_execution_profile_handle(const CassSession* session, const char* name,
+                                                    cass_int32_t* handle) {
+  return cass_session_get_execution_profile_handle_n(session, name, SAFE_STRLEN(name), handle);
+}
+
+CassError cass_session_get_execution_profile_handle_n(const CassSession* session,
+                                                      const char* name, size_t name_length,
+                                                      cass_int32_t* handle) {
+  const ExecutionProfile::Map& profiles = session->config().profiles();
+  ExecutionProfile::Map::const_iterator it = profiles.find(String(name, name_length));
+  if (it == profiles.end()) {
+    return CASS_ERROR_LIB_EXECUTION_PROFILE_INVALID;
+  }
+  *handle = it->second.handle();
+  return CASS_OK;
+}
+
+CassError cass_session_update_execution_profile(CassSession* session, const char* name,
+                                                const CassExecProfile* profile) {
+  return cass_session_update_execution_profile_n(session, name, SAFE_STRLEN(name), profile);
+}
+
+CassError cass_session_update_execution_profile_n(CassSession* session, const char* name,
+                                                  size_t name_length,
+                                                  const CassExecProfile* profile) {
+  if (name_length == 0 || profile == NULL) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  return session->update_execution_profile(String(name, name_length), *profile->from());
+}
+
 cass_uint64_t cass_session_get_inflight_request_count(const CassSession* session) {
   cass_uint64_t inflight_request_count = 0;
-  const HostMap hosts = session->cluster()->available_hosts();
+  const HostTable::ConstPtr host_table(session->cluster()->host_table());
+  const HostMap& hosts = host_table->hosts();
   for (HostMap::const_iterator it = hosts.begin(), end = hosts.end(); it != end; ++it) {
     const Host::Ptr& host = it->second;
     inflight_request_count += host->inflight_request_count();
@@ -182,7 +606,7 @@ cass_uint64_t cass_session_get_inflight_request_count(const CassSession* session
 } // extern "C"
 
 static inline bool least_busy_comp(const RequestProcessor::Ptr& a, const RequestProcessor::Ptr& b) {
-  return a->request_count() < b->request_count();
+  return a->load() < b->load();
 }
 
 namespace datastax { namespace internal { namespace core {
@@ -205,20 +629,22 @@ public:
   SessionInitializer() { uv_mutex_destroy(&mutex_); }
 
   void initialize(const Host::Ptr& connected_host, ProtocolVersion protocol_version,
-                  const HostMap& hosts, const TokenMap::Ptr& token_map, const String& local_dc,
+                  const HostTable::ConstPtr& hosts, const TokenMap::Ptr& token_map, const String& local_dc,
 		  const String& local_rack) {
     inc_ref();
 
+    // The settings are shared so that session-wide state, like the retry
+    // budget, is shared by all the request processors
+    RequestProcessorSettings settings(session_->config());
+    settings.connection_pool_settings.connection_settings.client_id =
+        to_string(session_->client_id());
+
     const size_t thread_count_io = remaining_ = session_->config().thread_count_io();
     for (size_t i = 0; i < thread_count_io; ++i) {
       RequestProcessorInitializer::Ptr initializer(new RequestProcessorInitializer(
           connected_host, protocol_version, hosts, token_map, local_dc, local_rack,
           bind_callback(&SessionInitializer::on_initialize, this)));
 
-      RequestProcessorSettings settings(session_->config());
-      settings.connection_pool_settings.connection_settings.client_id =
-          to_string(session_->client_id());
-
       initializer->with_settings(RequestProcessorSettings(settings))
           ->with_listener(session_)
           ->with_keyspace(session_->connect_keyspace())
@@ -265,9 +691,13 @@ private:
         session_->notify_connect_failed(error_code_, error_message_);
       } else {
         session_->notify_connected();
-        session_->cluster()->start_monitor_reporting(to_string(session_->client_id()),
-                                                     to_string(session_->session_id()),
-                                                     session_->config());
+        session_->cluster()->start_monitor_reporting(
+            to_string(session_->client_id()), to_string(session_->session_id()),
+            session_->config(), session_->metrics());
+        if (session_->config().metrics_merge_interval_ms() > 0) {
+          session_->cluster()->start_metrics_merging(
+              session_->metrics(), session_->config().metrics_merge_interval_ms());
+        }
       }
       l.unlock(); // Unlock before destroying the object
       dec_ref();
@@ -283,15 +713,248 @@ private:
   RequestProcessor::Vec request_processors_;
 };
 
+/**
+ * Sets the future of a batch that was split by replica set once all of the
+ * batches it was split into are complete. The batch's future is set to the
+ * first error, if any, otherwise to the result of one of the batches.
+ */
+class SplitBatchCallback : public RefCounted<SplitBatchCallback> {
+public:
+  typedef SharedRefPtr<SplitBatchCallback> Ptr;
+
+  SplitBatchCallback(const ResponseFuture::Ptr& future, size_t count)
+      : future_(future)
+      , remaining_(count) {
+    uv_mutex_init(&mutex_);
+  }
+
+  ~SplitBatchCallback() { uv_mutex_destroy(&mutex_); }
+
+  void add(const Future::Ptr& future) {
+    inc_ref(); // Released after the batch's future is set
+    future->set_callback(on_set, this);
+  }
+
+private:
+  static void on_set(CassFuture* future, void* data) {
+    SplitBatchCallback* callback = static_cast<SplitBatchCallback*>(data);
+    callback->handle_set(static_cast<ResponseFuture*>(future->from()));
+    callback->dec_ref();
+  }
+
+  void handle_set(ResponseFuture* future) {
+    ScopedMutex l(&mutex_);
+    if (!result_ || (future->error() && !result_->error())) {
+      result_.reset(future);
+    }
+    if (--remaining_ > 0) return;
+    l.unlock();
+
+    const Future::Error* error = result_->error();
+    if (error) {
+      future_->set_error_with_response(result_->address(), result_->response(), error->code,
+                                       error->message);
+    } else {
+      future_->set_response(result_->address(), result_->response());
+    }
+  }
+
+private:
+  uv_mutex_t mutex_;
+  ResponseFuture::Ptr future_;
+  ResponseFuture::Ptr result_;
+  size_t remaining_;
+};
+
+/**
+ * Sets the future of statements that are executed together once all of them
+ * are complete. The future is set to the first error, in the order of the
+ * statements, if any, otherwise to the statements' rows concatenated in their
+ * order.
+ */
+class MultiReadCallback : public RefCounted<MultiReadCallback> {
+public:
+  typedef SharedRefPtr<MultiReadCallback> Ptr;
+
+  MultiReadCallback(const ResponseFuture::Ptr& future, size_t count)
+      : future_(future)
+      , futures_(count)
+      , remaining_(count) {
+    uv_mutex_init(&mutex_);
+  }
+
+  ~MultiReadCallback() { uv_mutex_destroy(&mutex_); }
+
+  void add(size_t index, const ResponseFuture::Ptr& future) {
+    futures_[index] = future;
+    inc_ref(); // Released after the statement's future is set
+    future->set_callback(on_set, this);
+  }
+
+private:
+  static void on_set(CassFuture* future, void* data) {
+    MultiReadCallback* callback = static_cast<MultiReadCallback*>(data);
+    callback->handle_set();
+    callback->dec_ref();
+  }
+
+  void handle_set() {
+    {
+      ScopedMutex l(&mutex_);
+      if (--remaining_ > 0) return;
+    }
+
+    Vector<ResultResponse::ConstPtr> results;
+    results.reserve(futures_.size());
+    for (Vector<ResponseFuture::Ptr>::const_iterator it = futures_.begin(), end = futures_.end();
+         it != end; ++it) {
+      ResponseFuture* future = it->get();
+      const Future::Error* error = future->error();
+      if (error) {
+        future_->set_error_with_response(future->address(), future->response(), error->code,
+                                         error->message);
+        return;
+      }
+      const Response::Ptr& response = future->response();
+      if (response->opcode() != CQL_OPCODE_RESULT) {
+        results.clear();
+        break;
+      }
+      results.push_back(
+          ResultResponse::ConstPtr(static_cast<const ResultResponse*>(response.get())));
+    }
+
+    ResultResponse::Ptr result(ResultResponse::concat_rows(results));
+    if (!result) {
+      future_->set_error(CASS_ERROR_LIB_UNEXPECTED_RESPONSE,
+                         "The statements' results aren't rows with the same columns");
+      return;
+    }
+    future_->set_response(futures_.front()->address(), result);
+  }
+
+private:
+  uv_mutex_t mutex_;
+  ResponseFuture::Ptr future_;
+  Vector<ResponseFuture::Ptr> futures_;
+  size_t remaining_;
+};
+
+/**
+ * Coalesces identical concurrent requests: prepares of the same query in the
+ * same keyspace and (if enabled) idempotent reads of the same bound statement
+ * and values. The first request is sent using an internal future and the
+ * futures of all the requests, including the first, are set with its
+ * response when it completes. Each request keeps its own future so that the
+ * application can set a callback on each of them.
+ */
+class RequestCoalescer : public RefCounted<RequestCoalescer> {
+public:
+  typedef SharedRefPtr<RequestCoalescer> Ptr;
+
+  RequestCoalescer() {
+    uv_mutex_init(&mutex_);
+  }
+
+  ~RequestCoalescer() { uv_mutex_destroy(&mutex_); }
+
+  /**
+   * Add a prepare's future.
+   *
+   * @param keyspace The keyspace the query is prepared in.
+   * @param query The query.
+   * @param future The prepare's future.
+   * @return The future to send the prepare request with if there's no prepare
+   * of the query in flight, otherwise null.
+   */
+  ResponseFuture::Ptr add(const String& keyspace, const String& query,
+                          const ResponseFuture::Ptr& future) {
+    return add(keyspace + '\0' + query, future); // Keyspaces can't contain a null character
+  }
+
+  /**
+   * Add a request's future.
+   *
+   * @param key The key of identical requests.
+   * @param future The request's future.
+   * @return The future to send the request with if there's no identical
+   * request in flight, otherwise null.
+   */
+  ResponseFuture::Ptr add(const String& key, const ResponseFuture::Ptr& future) {
+    {
+      ScopedMutex l(&mutex_);
+      WaiterMap::iterator it = waiters_.find(key);
+      if (it != waiters_.end()) {
+        it->second.push_back(future);
+        return ResponseFuture::Ptr();
+      }
+      waiters_[key].push_back(future);
+    }
+
+    ResponseFuture::Ptr coalesced_future(new ResponseFuture());
+    coalesced_future->set_callback(on_set, new Callback(Ptr(this), key));
+    return coalesced_future;
+  }
+
+private:
+  struct Callback : public Allocated {
+    Callback(const RequestCoalescer::Ptr& coalescer, const String& key)
+        : coalescer(coalescer)
+        , key(key) {}
+
+    RequestCoalescer::Ptr coalescer;
+    String key;
+  };
+
+  static void on_set(CassFuture* future, void* data) {
+    ScopedPtr<Callback> callback(static_cast<Callback*>(data));
+    callback->coalescer->handle_set(callback->key, static_cast<ResponseFuture*>(future->from()));
+  }
+
+  void handle_set(const String& key, ResponseFuture* coalesced_future) {
+    FutureVec futures;
+    {
+      ScopedMutex l(&mutex_);
+      WaiterMap::iterator it = waiters_.find(key);
+      if (it == waiters_.end()) return;
+      futures.swap(it->second);
+      waiters_.erase(it);
+    }
+
+    const Future::Error* error = coalesced_future->error();
+    for (FutureVec::const_iterator it = futures.begin(), end = futures.end(); it != end; ++it) {
+      if (error) {
+        (*it)->set_error_with_response(coalesced_future->address(), coalesced_future->response(),
+                                       error->code, error->message);
+      } else {
+        (*it)->set_response(coalesced_future->address(), coalesced_future->response());
+      }
+    }
+  }
+
+private:
+  typedef Vector<ResponseFuture::Ptr> FutureVec;
+  typedef Map<String, FutureVec> WaiterMap;
+
+  uv_mutex_t mutex_;
+  WaiterMap waiters_;
+};
+
 }}} // namespace datastax::internal::core
 
 Session::Session()
-    : request_processor_count_(0)
-    , is_closing_(false) {
+    : event_loop_group_(NULL)
+    , request_processor_count_(0)
+    , is_closing_(false)
+    , prepare_coalescer_(new RequestCoalescer())
+    , read_coalescer_(new RequestCoalescer()) {
   uv_mutex_init(&mutex_);
 }
 
 Session::~Session() {
+  if (inflight_limiter_) {
+    inflight_limiter_->close();
+  }
   join();
   uv_mutex_destroy(&mutex_);
 }
@@ -299,12 +962,7 @@ Session::~Session() {
 Future::Ptr Session::prepare(const char* statement, size_t length) {
   PrepareRequest::Ptr prepare(new PrepareRequest(String(statement, length)));
 
-  ResponseFuture::Ptr future(new ResponseFuture(cluster()->schema_snapshot()));
-  future->prepare_request = PrepareRequest::ConstPtr(prepare);
-
-  execute(RequestHandler::Ptr(new RequestHandler(prepare, future, metrics())));
-
-  return future;
+  return execute_prepare(prepare);
 }
 
 Future::Ptr Session::prepare(const Statement* statement) {
@@ -322,18 +980,177 @@ Future::Ptr Session::prepare(const Statement* statement) {
   // inherited by bound statements.
   prepare->set_settings(statement->settings());
 
+  return execute_prepare(prepare);
+}
+
+Future::Ptr Session::execute_prepare(const PrepareRequest::Ptr& prepare) {
   ResponseFuture::Ptr future(new ResponseFuture(cluster()->schema_snapshot()));
   future->prepare_request = PrepareRequest::ConstPtr(prepare);
+  future->set_callback_executor(callback_executor_.get());
+
+  String keyspace;
+  {
+    ScopedMutex l(&mutex_);
+    keyspace = !prepare->keyspace().empty() ? prepare->keyspace() : keyspace_;
+  }
 
-  execute(RequestHandler::Ptr(new RequestHandler(prepare, future, metrics())));
+  if (prepare_cached(keyspace, prepare.get(), future)) {
+    return future;
+  }
+
+  // Only the first of the concurrent prepares of a query sends a request
+  ResponseFuture::Ptr coalesced_future(prepare_coalescer_->add(keyspace, prepare->query(), future));
+  if (coalesced_future) {
+    execute(RequestHandler::Ptr(new RequestHandler(prepare, coalesced_future, metrics())));
+  }
 
   return future;
 }
 
+bool Session::prepare_cached(const String& keyspace, const PrepareRequest* prepare,
+                             const ResponseFuture::Ptr& future) {
+  ResultResponse::Ptr result;
+  {
+    ScopedMutex l(&mutex_);
+    if (!prepared_cache_) return false;
+    result = prepared_cache_->find(keyspace, prepare->query());
+  }
+  if (!result) return false;
+
+  // The statement isn't validated here. A host that doesn't have the statement
+  // responds with UNPREPARED when it's executed and it's prepared again.
+  LOG_TRACE("Using cached prepared statement for query \"%s\"", prepare->query().c_str());
+  future->set_response(Address(), result);
+  return true;
+}
+
 Future::Ptr Session::execute(const Request::ConstPtr& request) {
-  ResponseFuture::Ptr future(new ResponseFuture());
+  Future::Ptr future;
+  if (request->opcode() == CQL_OPCODE_BATCH) {
+    const BatchRequest* batch = static_cast<const BatchRequest*>(request.get());
+    if (config().token_aware_batch_splitting()) {
+      future = execute_split_batch(batch);
+    }
+    if (!future && config().batch_split_size() > 0) {
+      future = execute_sized_batch(batch);
+    }
+  }
+  if (!future) {
+    future = execute_request(request);
+  }
+  future->set_callback_executor(callback_executor_.get());
+  return future;
+}
+
+Future::Ptr Session::execute_request(const Request::ConstPtr& request,
+                                     Vector<RequestHandler::Ptr>* request_handlers) {
+  // Statements that stream their rows to a callback need their own request
+  bool has_row_callback = (request->opcode() == CQL_OPCODE_QUERY ||
+                           request->opcode() == CQL_OPCODE_EXECUTE) &&
+                          static_cast<const Statement*>(request.get())->row_callback() != NULL;
+
+  // Serve cacheable bound statements from the result cache
+  String result_cache_key;
+  uint64_t result_cache_ttl_ms = 0;
+  if (result_cache() && request->opcode() == CQL_OPCODE_EXECUTE && !has_row_callback) {
+    const Statement* statement = static_cast<const Statement*>(request.get());
+    if (statement->result_cache_ttl_ms() > 0 && statement->result_cache_key(&result_cache_key)) {
+      ResultResponse::Ptr result(result_cache()->get(result_cache_key));
+      if (result) {
+        ResponseFuture::Ptr future(new ResponseFuture());
+        future->set_response(Address(), result);
+        return future;
+      }
+      result_cache_ttl_ms = statement->result_cache_ttl_ms();
+    }
+  }
+
+  // Identical idempotent reads that are in flight share a single request.
+  // Only prepared statements that return rows are reads.
+  String read_key;
+  if (config().read_coalescing() && request->opcode() == CQL_OPCODE_EXECUTE &&
+      request->is_idempotent() && !has_row_callback) {
+    const ExecuteRequest* statement = static_cast<const ExecuteRequest*>(request.get());
+    if (!statement->paging_prefetch() && statement->has_result_columns()) {
+      if (result_cache_ttl_ms > 0) {
+        read_key = result_cache_key;
+      } else {
+        statement->result_cache_key(&read_key);
+      }
+    }
+  }
+
+  // The request's future, handler and executions are carved from a single
+  // block when an arena size is configured.
+  SharedRefPtr<Arena> arena;
+  if (config().request_arena_size() > 0) {
+    arena.reset(Arena::create(config().request_arena_size()));
+  }
+
+  ResponseFuture::Ptr future(new (arena.get()) ResponseFuture());
+
+  ResponseFuture::Ptr request_future(future);
+  if (!read_key.empty()) {
+    request_future = read_coalescer_->add(read_key, future);
+    if (!request_future) {
+      LOG_TRACE("Coalesced an identical in-flight read");
+      return future;
+    }
+  }
+
+  RequestHandler::Ptr request_handler(
+      new (arena.get()) RequestHandler(request, request_future, metrics()));
+  request_handler->set_arena(arena.get());
+  request_handler->set_slow_request_log(slow_request_log());
+  request_handler->set_request_tracer(request_tracer());
+  if (result_cache_ttl_ms > 0) {
+    request_handler->set_result_cache(result_cache(), result_cache_key, result_cache_ttl_ms);
+  }
+
+  if (request_handler->request()->opcode() == CQL_OPCODE_EXECUTE) {
+    const ExecuteRequest* execute = static_cast<const ExecuteRequest*>(request_handler->request());
+    request_handler->set_prepared_metadata(cluster()->prepared(execute->prepared()->id()));
+  }
+
+  if (request_handlers) {
+    request_handlers->push_back(request_handler);
+  } else {
+    execute(request_handler);
+  }
+
+  return future;
+}
+
+void Session::execute_all(const Vector<Request::ConstPtr>& requests, Vector<Future::Ptr>* futures) {
+  futures->reserve(futures->size() + requests.size());
+
+  // Batches can be split into several requests so they're executed on their own
+  Vector<RequestHandler::Ptr> request_handlers;
+  request_handlers.reserve(requests.size());
+  for (Vector<Request::ConstPtr>::const_iterator it = requests.begin(), end = requests.end();
+       it != end; ++it) {
+    if ((*it)->opcode() == CQL_OPCODE_BATCH) {
+      futures->push_back(execute(*it));
+    } else {
+      Future::Ptr future(execute_request(*it, &request_handlers));
+      future->set_callback_executor(callback_executor_.get());
+      futures->push_back(future);
+    }
+  }
 
+  execute_group(request_handlers);
+}
+
+Future::Ptr
+Session::execute_continuous_paging(const Request::ConstPtr& request,
+                                   const SharedRefPtr<ContinuousPaging>& continuous_paging) {
+  // The pages aren't cached or coalesced and a callback executor would
+  // reorder the last page with the pages that are added by the event loop
+  ResponseFuture::Ptr future(new ResponseFuture());
   RequestHandler::Ptr request_handler(new RequestHandler(request, future, metrics()));
+  request_handler->set_continuous_paging(continuous_paging);
+  request_handler->set_slow_request_log(slow_request_log());
+  request_handler->set_request_tracer(request_tracer());
 
   if (request_handler->request()->opcode() == CQL_OPCODE_EXECUTE) {
     const ExecuteRequest* execute = static_cast<const ExecuteRequest*>(request_handler->request());
@@ -345,26 +1162,645 @@ Future::Ptr Session::execute(const Request::ConstPtr& request) {
   return future;
 }
 
+Future::Ptr Session::execute_split_batch(const BatchRequest* batch) {
+  // Only unlogged batches can be split without changing their guarantees.
+  // Batches sent to a specific host are never split.
+  if (batch->type() != CASS_BATCH_TYPE_UNLOGGED || batch->statements().size() < 2 ||
+      batch->host() != NULL) {
+    return Future::Ptr();
+  }
+
+  TokenMap::Ptr token_map;
+  String keyspace;
+  {
+    ScopedMutex l(&mutex_);
+    token_map = token_map_;
+    keyspace = keyspace_;
+  }
+  if (!token_map) return Future::Ptr();
+  if (!batch->keyspace().empty()) {
+    keyspace = batch->keyspace();
+  }
+
+  const BatchRequest::StatementVec& statements = batch->statements();
+  BatchRequest::StatementVec routed_statements;
+  BatchRequest::StatementVec unrouted_statements;
+  Vector<String> routing_keys;
+  for (BatchRequest::StatementVec::const_iterator it = statements.begin(), end = statements.end();
+       it != end; ++it) {
+    String routing_key;
+    if ((*it)->get_routing_key(&routing_key)) {
+      routing_keys.push_back(routing_key);
+      routed_statements.push_back(*it);
+    } else {
+      unrouted_statements.push_back(*it);
+    }
+  }
+  if (routing_keys.empty()) return Future::Ptr();
+
+  Vector<CopyOnWriteHostVec> replicas;
+  token_map->get_replicas(keyspace, routing_keys, replicas);
+
+  // Group the statements by the addresses of their replicas
+  typedef Map<AddressVec, size_t> GroupIndexMap;
+  GroupIndexMap group_indexes;
+  Vector<BatchRequest::StatementVec> groups;
+  for (size_t i = 0; i < replicas.size(); ++i) {
+    const CopyOnWriteHostVec& hosts = replicas[i];
+    if (hosts->empty()) return Future::Ptr();
+
+    AddressVec addresses;
+    addresses.reserve(hosts->size());
+    for (HostVec::const_iterator it = hosts->begin(), end = hosts->end(); it != end; ++it) {
+      addresses.push_back((*it)->address());
+    }
+    std::sort(addresses.begin(), addresses.end());
+
+    std::pair<GroupIndexMap::iterator, bool> result =
+        group_indexes.insert(std::make_pair(addresses, groups.size()));
+    if (result.second) {
+      groups.push_back(BatchRequest::StatementVec());
+    }
+    groups[result.first->second].push_back(routed_statements[i]);
+  }
+  if (groups.size() < 2) return Future::Ptr();
+
+  // Statements without a routing key can go to any replica
+  BatchRequest::StatementVec& first = groups.front();
+  first.insert(first.end(), unrouted_statements.begin(), unrouted_statements.end());
+
+  Vector<BatchRequest::Ptr> batches;
+  for (Vector<BatchRequest::StatementVec>::const_iterator it = groups.begin(), end = groups.end();
+       it != end; ++it) {
+    batches.push_back(batch->split(*it));
+  }
+
+  LOG_TRACE("Split an unlogged batch of %u statements into %u batches",
+            static_cast<unsigned>(statements.size()), static_cast<unsigned>(groups.size()));
+
+  return execute_batches(batch, batches);
+}
+
+Future::Ptr Session::execute_sized_batch(const BatchRequest* batch) {
+  Vector<BatchRequest::Ptr> batches;
+  size_t max_size = config().batch_split_size();
+  if (batch->type() != CASS_BATCH_TYPE_LOGGED && batch->encoded_size() > max_size) {
+    batch->split_by_size(max_size, &batches);
+    LOG_TRACE("Split a batch of %u bytes into %u batches",
+              static_cast<unsigned>(batch->encoded_size()), static_cast<unsigned>(batches.size()));
+  } else {
+    // The application can modify its batch's statements once the batch's
+    // future is set so only the driver's copy caches its encoding.
+    batches.push_back(batch->split(batch->statements()));
+  }
+
+  for (Vector<BatchRequest::Ptr>::iterator it = batches.begin(), end = batches.end(); it != end;
+       ++it) {
+    (*it)->set_is_encoding_cached(true);
+  }
+
+  if (batches.size() == 1) {
+    return execute_request(Request::ConstPtr(batches.front()));
+  }
+  return execute_batches(batch, batches);
+}
+
+Future::Ptr Session::execute_batches(const BatchRequest* batch,
+                                     const Vector<BatchRequest::Ptr>& batches) {
+  // Use the same client-side timestamp for all of the batches
+  int64_t timestamp = batch->timestamp();
+  if (timestamp == CASS_INT64_MIN) {
+    timestamp = config().timestamp_gen()->next();
+  }
+
+  ResponseFuture::Ptr future(new ResponseFuture());
+  SplitBatchCallback::Ptr callback(new SplitBatchCallback(future, batches.size()));
+  for (Vector<BatchRequest::Ptr>::const_iterator it = batches.begin(), end = batches.end();
+       it != end; ++it) {
+    (*it)->set_timestamp(timestamp);
+    callback->add(execute_request(Request::ConstPtr(*it)));
+  }
+  return future;
+}
+
+Future::Ptr Session::execute_many(const Vector<Request::ConstPtr>& requests) {
+  ResponseFuture::Ptr future(new ResponseFuture());
+  future->set_callback_executor(callback_executor_.get());
+
+  // All of the statements must be bound from the same prepared statement
+  const ExecuteRequest* first = NULL;
+  for (Vector<Request::ConstPtr>::const_iterator it = requests.begin(), end = requests.end();
+       it != end; ++it) {
+    const Request* request = it->get();
+    if (request->opcode() != CQL_OPCODE_EXECUTE ||
+        (first != NULL && static_cast<const ExecuteRequest*>(request)->prepared()->id() !=
+                              first->prepared()->id())) {
+      future->set_error(CASS_ERROR_LIB_BAD_PARAMS,
+                        "The statements must be bound from the same prepared statement");
+      return future;
+    }
+    if (first == NULL) first = static_cast<const ExecuteRequest*>(request);
+  }
+  if (first == NULL) {
+    future->set_error(CASS_ERROR_LIB_BAD_PARAMS, "No statements to execute");
+    return future;
+  }
+  if (state() != SESSION_STATE_CONNECTED) {
+    future->set_error(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, "Session is not connected");
+    return future;
+  }
+
+  TokenMap::Ptr token_map;
+  String keyspace;
+  {
+    ScopedMutex l(&mutex_);
+    token_map = token_map_;
+    keyspace = keyspace_;
+  }
+  if (!first->keyspace().empty()) {
+    keyspace = first->keyspace();
+  }
+
+  // Find the replica that owns each statement's partition
+  Vector<String> routing_keys;
+  Vector<size_t> routed_indexes;
+  if (token_map) {
+    for (size_t i = 0; i < requests.size(); ++i) {
+      String routing_key;
+      if (static_cast<const Statement*>(requests[i].get())->get_routing_key(&routing_key)) {
+        routing_keys.push_back(routing_key);
+        routed_indexes.push_back(i);
+      }
+    }
+  }
+  Vector<CopyOnWriteHostVec> replicas;
+  if (!routing_keys.empty()) {
+    token_map->get_replicas(keyspace, routing_keys, replicas);
+  }
+  Vector<Address> owners(requests.size());
+  for (size_t i = 0; i < replicas.size(); ++i) {
+    if (!replicas[i]->empty()) {
+      owners[routed_indexes[i]] = replicas[i]->front()->address();
+    }
+  }
+
+  // Group the statements by their replica (statements without a replica form
+  // their own group) and enqueue each group to a single request processor so
+  // that their requests are coalesced on the same connections.
+  typedef Map<Address, Vector<RequestHandler::Ptr> > GroupMap;
+  GroupMap groups;
+  MultiReadCallback::Ptr callback(new MultiReadCallback(future, requests.size()));
+  const PreparedMetadata::Entry::Ptr prepared_metadata(
+      cluster()->prepared(first->prepared()->id()));
+  for (size_t i = 0; i < requests.size(); ++i) {
+    ResponseFuture::Ptr request_future(new ResponseFuture());
+    RequestHandler::Ptr request_handler(new RequestHandler(requests[i], request_future, metrics()));
+    request_handler->set_slow_request_log(slow_request_log());
+    request_handler->set_request_tracer(request_tracer());
+    request_handler->set_prepared_metadata(prepared_metadata);
+    callback->add(i, request_future);
+    groups[owners[i]].push_back(request_handler);
+  }
+
+  for (GroupMap::const_iterator it = groups.begin(), end = groups.end(); it != end; ++it) {
+    execute_group(it->second);
+  }
+
+  LOG_TRACE("Executed %u statements in %u groups by replica",
+            static_cast<unsigned>(requests.size()), static_cast<unsigned>(groups.size()));
+
+  return future;
+}
+
+ResponseFuture::Ptr Session::take_next_page(ResponseFuture* future) {
+  RequestHandler::Ptr request_handler;
+  ResponseFuture::Ptr next_page(future->take_next_page(&request_handler));
+  if (next_page) {
+    next_page->set_callback_executor(callback_executor_.get());
+  }
+  if (request_handler) {
+    execute(request_handler);
+  }
+  return next_page;
+}
+
+TokenMap::Ptr Session::token_map() const {
+  ScopedMutex l(&mutex_);
+  return token_map_;
+}
+
+void Session::token_map_metrics(TokenMapMetrics* metrics) const {
+  TokenMap::Ptr token_map(this->token_map());
+  if (token_map) {
+    token_map->get_metrics(metrics);
+  }
+}
+
+void Session::prepared_metadata_metrics(PreparedMetadataMetrics* metrics) const {
+  Cluster::Ptr cluster(this->cluster());
+  if (cluster) {
+    cluster->prepared_metadata_metrics(metrics);
+  }
+}
+
+String Session::open_metrics() const {
+  const Metrics* metrics = this->metrics();
+  if (metrics == NULL) return String();
+
+  OpenMetricsWriter writer;
+
+  Metrics::Histogram::Snapshot snapshot;
+  metrics->request_latencies.get_snapshot(&snapshot);
+  writer.add_family("request_latency_seconds", "summary", "Latency of the requests");
+  writer.add_latency_quantiles("request_latency_seconds", "", snapshot);
+  writer.add_sample("request_latency_seconds_count", "", metrics->request_rates.count());
+
+  writer.add_family("request_rate", "gauge", "Moving averages of the number of requests per second");
+  writer.add_sample("request_rate", OpenMetricsWriter::label("window", "1m"),
+                    metrics->request_rates.one_minute_rate());
+  writer.add_sample("request_rate", OpenMetricsWriter::label("window", "5m"),
+                    metrics->request_rates.five_minute_rate());
+  writer.add_sample("request_rate", OpenMetricsWriter::label("window", "15m"),
+                    metrics->request_rates.fifteen_minute_rate());
+  writer.add_sample("request_rate", OpenMetricsWriter::label("window", "mean"),
+                    metrics->request_rates.mean_rate());
+
+  metrics->speculative_request_latencies.get_snapshot(&snapshot);
+  writer.add_family("speculative_request_latency_seconds", "summary",
+                    "Latency of the requests that used speculative executions");
+  writer.add_latency_quantiles("speculative_request_latency_seconds", "", snapshot);
+
+  if (metrics->stage_latencies) {
+    const Metrics::StageLatencies* stage_latencies = metrics->stage_latencies.get();
+    writer.add_family("request_stage_latency_seconds", "summary",
+                      "Latency of the stages of the requests");
+    stage_latencies->queue.get_snapshot(&snapshot);
+    writer.add_latency_quantiles("request_stage_latency_seconds",
+                                 OpenMetricsWriter::label("stage", "queue"), snapshot);
+    stage_latencies->write.get_snapshot(&snapshot);
+    writer.add_latency_quantiles("request_stage_latency_seconds",
+                                 OpenMetricsWriter::label("stage", "write"), snapshot);
+    stage_latencies->server.get_snapshot(&snapshot);
+    writer.add_latency_quantiles("request_stage_latency_seconds",
+                                 OpenMetricsWriter::label("stage", "server"), snapshot);
+    stage_latencies->callback.get_snapshot(&snapshot);
+    writer.add_latency_quantiles("request_stage_latency_seconds",
+                                 OpenMetricsWriter::label("stage", "callback"), snapshot);
+  }
+
+  writer.add_family("speculative_requests", "counter",
+                    "Speculative executions that were aborted by another execution's response");
+  writer.add_sample("speculative_requests_total", "",
+                    metrics->request_rates.speculative_request_count());
+
+  writer.add_family("connections", "gauge", "Connections to the hosts");
+  writer.add_sample("connections", "", static_cast<uint64_t>(metrics->total_connections.sum()));
+
+  writer.add_family("connection_timeouts", "counter", "Connection attempts that timed out");
+  writer.add_sample("connection_timeouts_total", "",
+                    static_cast<uint64_t>(metrics->connection_timeouts.sum()));
+
+  writer.add_family("request_timeouts", "counter", "Requests that timed out");
+  writer.add_sample("request_timeouts_total", "",
+                    static_cast<uint64_t>(metrics->request_timeouts.sum()));
+
+  writer.add_family("retries", "counter", "Retries decided by the retry policies");
+  writer.add_sample("retries_total", "", static_cast<uint64_t>(metrics->retries.sum()));
+
+  writer.add_family("denied_retries", "counter", "Retries denied by the retry budget");
+  writer.add_sample("denied_retries_total", "",
+                    static_cast<uint64_t>(metrics->denied_retries.sum()));
+
+  writer.add_family("protocol_downgrades", "counter",
+                    "Connections rejected because a host doesn't support their protocol version");
+  writer.add_sample("protocol_downgrades_total", "",
+                    static_cast<uint64_t>(metrics->protocol_downgrades.sum()));
+
+  writer.add_family("downgraded_connections", "counter",
+                    "Connections that used the lower protocol version cached for their host");
+  writer.add_sample("downgraded_connections_total", "",
+                    static_cast<uint64_t>(metrics->downgraded_connections.sum()));
+
+  writer.add_family("buffer_pool", "counter", "Buffer pool lookups");
+  writer.add_sample("buffer_pool_total", OpenMetricsWriter::label("result", "hit"),
+                    static_cast<uint64_t>(metrics->buffer_pool_hits.sum()));
+  writer.add_sample("buffer_pool_total", OpenMetricsWriter::label("result", "miss"),
+                    static_cast<uint64_t>(metrics->buffer_pool_misses.sum()));
+
+  writer.add_family("routed_requests", "counter", "Requests sent by the hosts' locality");
+  writer.add_sample("routed_requests_total", OpenMetricsWriter::label("locality", "local_rack"),
+                    static_cast<uint64_t>(metrics->local_rack_requests.sum()));
+  writer.add_sample("routed_requests_total", OpenMetricsWriter::label("locality", "local_dc"),
+                    static_cast<uint64_t>(metrics->local_dc_requests.sum()));
+  writer.add_sample("routed_requests_total", OpenMetricsWriter::label("locality", "remote_dc"),
+                    static_cast<uint64_t>(metrics->remote_dc_requests.sum()));
+
+  writer.add_family("processor_requests", "gauge", "Requests of the request processors");
+  for (size_t i = 0; i < request_processors_.size(); ++i) {
+    const RequestProcessor::Ptr& request_processor = request_processors_[i];
+    // The request count includes queued requests
+    size_t queued = request_processor->queued_request_count();
+    int request_count = request_processor->request_count();
+    String processor(OpenMetricsWriter::label("processor", i));
+    writer.add_sample("processor_requests",
+                      processor + "," + OpenMetricsWriter::label("state", "queued"),
+                      static_cast<uint64_t>(queued));
+    writer.add_sample(
+        "processor_requests", processor + "," + OpenMetricsWriter::label("state", "inflight"),
+        static_cast<uint64_t>(request_count > static_cast<int>(queued) ? request_count - queued
+                                                                       : 0));
+  }
+
+  writer.add_family("processor_batches", "counter",
+                    "Coalesced batches of requests written and flushed together");
+  for (size_t i = 0; i < request_processors_.size(); ++i) {
+    writer.add_sample("processor_batches_total", OpenMetricsWriter::label("processor", i),
+                      request_processors_[i]->batch_count());
+  }
+
+  writer.add_family("processor_batched_requests", "counter", "Requests written in batches");
+  for (size_t i = 0; i < request_processors_.size(); ++i) {
+    writer.add_sample("processor_batched_requests_total", OpenMetricsWriter::label("processor", i),
+                      request_processors_[i]->batched_request_count());
+  }
+
+  PreparedMetadataMetrics prepared_metrics;
+  prepared_metadata_metrics(&prepared_metrics);
+  writer.add_family("prepared_statements", "gauge", "Prepared statements kept by the session");
+  writer.add_sample("prepared_statements", "", static_cast<uint64_t>(prepared_metrics.entries));
+  writer.add_family("prepared_statement_evictions", "counter",
+                    "Prepared statements evicted by the limit");
+  writer.add_sample("prepared_statement_evictions_total", "", prepared_metrics.evictions);
+
+  TokenMapMetrics token_map_metrics;
+  this->token_map_metrics(&token_map_metrics);
+  writer.add_family("memory_bytes", "gauge", "Memory used by the driver's subsystems");
+  writer.add_sample(
+      "memory_bytes", OpenMetricsWriter::label("subsystem", "request_buffers"),
+      static_cast<uint64_t>(MemoryAccounting::bytes(MEMORY_CATEGORY_REQUEST_BUFFERS)));
+  writer.add_sample(
+      "memory_bytes", OpenMetricsWriter::label("subsystem", "response_buffers"),
+      static_cast<uint64_t>(MemoryAccounting::bytes(MEMORY_CATEGORY_RESPONSE_BUFFERS)));
+  writer.add_sample("memory_bytes", OpenMetricsWriter::label("subsystem", "metadata"),
+                    static_cast<uint64_t>(MemoryAccounting::bytes(MEMORY_CATEGORY_METADATA)));
+  writer.add_sample("memory_bytes", OpenMetricsWriter::label("subsystem", "token_map"),
+                    static_cast<uint64_t>(token_map_metrics.memory_bytes));
+  writer.add_sample("memory_bytes", OpenMetricsWriter::label("subsystem", "ssl_buffers"),
+                    static_cast<uint64_t>(MemoryAccounting::bytes(MEMORY_CATEGORY_SSL_BUFFERS)));
+
+  if (inflight_limiter_) {
+    writer.add_family("waiting_requests", "gauge",
+                      "Requests waiting for the in-flight or memory limit");
+    writer.add_sample("waiting_requests", "",
+                      static_cast<uint64_t>(inflight_limiter_->waiting_request_count()));
+  }
+
+  if (event_loop_group_) {
+    writer.add_family("event_loop_seconds", "counter", "Time the event loops were busy or idle");
+    for (size_t i = 0; i < event_loop_group_->size(); ++i) {
+      const EventLoop* event_loop = event_loop_group_->get(i);
+      String loop(OpenMetricsWriter::label("loop", i));
+      writer.add_sample("event_loop_seconds_total",
+                        loop + "," + OpenMetricsWriter::label("state", "busy"),
+                        static_cast<double>(event_loop->busy_time()) / 1e9);
+      writer.add_sample("event_loop_seconds_total",
+                        loop + "," + OpenMetricsWriter::label("state", "idle"),
+                        static_cast<double>(event_loop->idle_time()) / 1e9);
+    }
+
+    writer.add_family("event_loop_utilization", "gauge",
+                      "Fraction of the last ~100 milliseconds the event loops were busy");
+    for (size_t i = 0; i < event_loop_group_->size(); ++i) {
+      writer.add_sample("event_loop_utilization", OpenMetricsWriter::label("loop", i),
+                        event_loop_group_->get(i)->utilization() / 1000.0);
+    }
+
+    writer.add_family("event_loop_pending_tasks", "gauge", "Tasks waiting to run");
+    for (size_t i = 0; i < event_loop_group_->size(); ++i) {
+      writer.add_sample("event_loop_pending_tasks", OpenMetricsWriter::label("loop", i),
+                        static_cast<uint64_t>(event_loop_group_->get(i)->pending_task_count()));
+    }
+
+    writer.add_family("event_loop_tasks", "counter",
+                      "Tasks run by the event loops, including stolen tasks");
+    for (size_t i = 0; i < event_loop_group_->size(); ++i) {
+      writer.add_sample("event_loop_tasks_total", OpenMetricsWriter::label("loop", i),
+                        event_loop_group_->get(i)->tasks_run());
+    }
+
+    writer.add_family("event_loop_stolen_tasks", "counter",
+                      "Tasks the event loops stole from the other event loops");
+    for (size_t i = 0; i < event_loop_group_->size(); ++i) {
+      writer.add_sample("event_loop_stolen_tasks_total", OpenMetricsWriter::label("loop", i),
+                        event_loop_group_->get(i)->tasks_stolen());
+    }
+  }
+
+  const HostTable::ConstPtr host_table(cluster()->host_table());
+  const HostMap& hosts = host_table->hosts();
+  writer.add_family("host_inflight_requests", "gauge", "In-flight requests of the hosts");
+  for (HostMap::const_iterator it = hosts.begin(), end = hosts.end(); it != end; ++it) {
+    writer.add_sample("host_inflight_requests",
+                      OpenMetricsWriter::label("host", it->first.to_string(true)),
+                      static_cast<uint64_t>(std::max(0, it->second->inflight_request_count())));
+  }
+
+  writer.add_family("host_connections", "gauge", "Open connections to the hosts");
+  for (HostMap::const_iterator it = hosts.begin(), end = hosts.end(); it != end; ++it) {
+    writer.add_sample("host_connections",
+                      OpenMetricsWriter::label("host", it->first.to_string(true)),
+                      static_cast<uint64_t>(std::max(0, it->second->connection_count())));
+  }
+
+  writer.add_family("host_bytes", "counter", "Bytes written to and read from the hosts");
+  for (HostMap::const_iterator it = hosts.begin(), end = hosts.end(); it != end; ++it) {
+    String host(OpenMetricsWriter::label("host", it->first.to_string(true)));
+    writer.add_sample("host_bytes_total",
+                      host + "," + OpenMetricsWriter::label("direction", "written"),
+                      it->second->bytes_written());
+    writer.add_sample("host_bytes_total", host + "," + OpenMetricsWriter::label("direction", "read"),
+                      it->second->bytes_read());
+  }
+
+  writer.add_family("host_flushes", "counter", "Socket writes of coalesced requests to the hosts");
+  for (HostMap::const_iterator it = hosts.begin(), end = hosts.end(); it != end; ++it) {
+    writer.add_sample("host_flushes_total",
+                      OpenMetricsWriter::label("host", it->first.to_string(true)),
+                      it->second->flushes());
+  }
+
+  writer.add_family("host_flushed_requests", "counter", "Requests written by the flushes");
+  for (HostMap::const_iterator it = hosts.begin(), end = hosts.end(); it != end; ++it) {
+    writer.add_sample("host_flushed_requests_total",
+                      OpenMetricsWriter::label("host", it->first.to_string(true)),
+                      it->second->flushed_requests());
+  }
+
+  writer.add_family("host_max_connection_inflight_requests", "gauge",
+                    "The highest number of in-flight requests on one of the hosts' connections");
+  for (HostMap::const_iterator it = hosts.begin(), end = hosts.end(); it != end; ++it) {
+    writer.add_sample(
+        "host_max_connection_inflight_requests",
+        OpenMetricsWriter::label("host", it->first.to_string(true)),
+        static_cast<uint64_t>(std::max(0, it->second->max_connection_inflight_requests())));
+  }
+
+  writer.add_family("host_max_write_queue_bytes", "gauge",
+                    "The largest socket write queue of the hosts' connections");
+  for (HostMap::const_iterator it = hosts.begin(), end = hosts.end(); it != end; ++it) {
+    writer.add_sample("host_max_write_queue_bytes",
+                      OpenMetricsWriter::label("host", it->first.to_string(true)),
+                      it->second->max_write_queue_bytes());
+  }
+
+  Metrics::HostLatencySnapshotVec host_snapshots;
+  metrics->get_host_latencies_snapshots(&host_snapshots);
+  if (!host_snapshots.empty()) {
+    writer.add_family("host_request_latency_seconds", "summary", "Latency of the hosts' responses");
+    for (Metrics::HostLatencySnapshotVec::const_iterator it = host_snapshots.begin(),
+                                                         end = host_snapshots.end();
+         it != end; ++it) {
+      writer.add_latency_quantiles("host_request_latency_seconds",
+                                   OpenMetricsWriter::label("host", it->first.to_string(true)),
+                                   it->second);
+    }
+  }
+
+  Metrics::ProfileLatencySnapshotVec profile_snapshots;
+  metrics->get_profile_latencies_snapshots(&profile_snapshots);
+  if (!profile_snapshots.empty()) {
+    writer.add_family("profile_request_latency_seconds", "summary",
+                      "Latency of the execution profiles' requests");
+    for (Metrics::ProfileLatencySnapshotVec::const_iterator it = profile_snapshots.begin(),
+                                                            end = profile_snapshots.end();
+         it != end; ++it) {
+      writer.add_latency_quantiles("profile_request_latency_seconds",
+                                   OpenMetricsWriter::label("profile", it->first), it->second);
+    }
+  }
+
+  return writer.finish();
+}
+
+CassError Session::update_execution_profile(const String& name,
+                                           const ExecutionProfile& profile) {
+  if (state() != SESSION_STATE_CONNECTED) {
+    return CASS_ERROR_LIB_NO_HOSTS_AVAILABLE;
+  }
+  // Only existing profiles can be replaced so that the profiles' handles
+  // stay the same
+  if (config().profiles().find(name) == config().profiles().end()) {
+    return CASS_ERROR_LIB_EXECUTION_PROFILE_INVALID;
+  }
+
+  ExecutionProfile updated(profile);
+  config().init_profile(updated);
+  HostTable::ConstPtr host_table(cluster()->host_table());
+
+  ScopedMutex l(&mutex_);
+  for (RequestProcessor::Vec::const_iterator it = request_processors_.begin(),
+                                             end = request_processors_.end();
+       it != end; ++it) {
+    (*it)->notify_execution_profile_updated(name, updated, host_table->hosts());
+  }
+  LOG_INFO("Updating the '%s' execution profile", name.c_str());
+  return CASS_OK;
+}
+
 void Session::execute(const RequestHandler::Ptr& request_handler) {
   if (state() != SESSION_STATE_CONNECTED) {
     request_handler->set_error(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, "Session is not connected");
     return;
   }
 
+  // Requests over the in-flight limit are either failed or started later by
+  // the limiter.
+  if (inflight_limiter_ && !inflight_limiter_->acquire(request_handler)) {
+    return;
+  }
+
+  dispatch(request_handler);
+}
+
+void Session::execute_group(const Vector<RequestHandler::Ptr>& request_handlers) {
+  if (request_handlers.empty()) return;
+
+  if (state() != SESSION_STATE_CONNECTED) {
+    for (Vector<RequestHandler::Ptr>::const_iterator it = request_handlers.begin(),
+                                                     end = request_handlers.end();
+         it != end; ++it) {
+      (*it)->set_error(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, "Session is not connected");
+    }
+    return;
+  }
+
+  Vector<RequestHandler::Ptr> dispatched;
+  dispatched.reserve(request_handlers.size());
+  for (Vector<RequestHandler::Ptr>::const_iterator it = request_handlers.begin(),
+                                                   end = request_handlers.end();
+       it != end; ++it) {
+    // Requests over the in-flight limit are either failed or started later by
+    // the limiter.
+    if (inflight_limiter_ && !inflight_limiter_->acquire(*it)) continue;
+    (*it)->set_is_low_priority(priority((*it)->request()) == CASS_REQUEST_PRIORITY_LOW);
+    dispatched.push_back(*it);
+  }
+  if (dispatched.empty()) return;
+
+  // The whole group is enqueued to the least busy processor with a single
+  // queue operation and wake-up
+  const RequestProcessor::Ptr& request_processor =
+      *std::min_element(request_processors_.begin(), request_processors_.end(), least_busy_comp);
+  request_processor->process_request_group(dispatched);
+}
+
+void Session::dispatch(const RequestHandler::Ptr& request_handler) {
   // This intentionally doesn't lock the request processors. The processors will
   // be populated before the connect future returns and calling execute during
   // the connection process is undefined behavior. Locking would cause unnecessary
   // overhead for something that's constant once the session is connected.
   const RequestProcessor::Ptr& request_processor =
       *std::min_element(request_processors_.begin(), request_processors_.end(), least_busy_comp);
+  request_handler->set_is_low_priority(priority(request_handler->request()) ==
+                                       CASS_REQUEST_PRIORITY_LOW);
   request_processor->process_request(request_handler);
 }
 
+CassRequestPriority Session::priority(const Request* request) const {
+  if (request->priority() != CASS_REQUEST_PRIORITY_UNSET) {
+    return request->priority();
+  }
+  int32_t handle = request->execution_profile_handle();
+  if (handle >= 0) {
+    const ExecutionProfile* profile =
+        static_cast<size_t>(handle) < indexed_profiles_.size() ? indexed_profiles_[handle] : NULL;
+    return profile ? profile->priority() : CASS_REQUEST_PRIORITY_UNSET;
+  }
+  if (request->execution_profile_name().empty()) {
+    return config().default_profile().priority();
+  }
+  const ExecutionProfile::Map& profiles = config().profiles();
+  ExecutionProfile::Map::const_iterator it = profiles.find(request->execution_profile_name());
+  if (it != profiles.end()) {
+    return it->second.priority();
+  }
+  return CASS_REQUEST_PRIORITY_UNSET; // The request fails when it's processed
+}
+
 void Session::join() {
-  if (event_loop_group_) {
-    event_loop_group_->close_handles();
-    event_loop_group_->join();
-    event_loop_group_.reset();
+  if (owned_event_loop_group_) {
+    owned_event_loop_group_->close_handles();
+    owned_event_loop_group_->join();
+    owned_event_loop_group_.reset();
+  } else if (event_loop_group_ && config().shared_runtime()) {
+    // The shared threads keep running for the other sessions
+    config().shared_runtime()->flush();
+  }
+  event_loop_group_ = NULL;
+  // The I/O threads are joined first because they can still queue callbacks
+  if (callback_executor_) {
+    callback_executor_->close();
+    callback_executor_.reset();
   }
 }
 
@@ -373,28 +1809,59 @@ void Session::on_connect(const Host::Ptr& connected_host, ProtocolVersion protoc
                          const String& local_dc, const String& local_rack) {
   int rc = 0;
 
+  ExecutionProfile::index(config().profiles(), &indexed_profiles_);
+
   if (hosts.empty()) {
     notify_connect_failed(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE,
                           "No hosts provided or no hosts resolved");
     return;
   }
 
-  join();
-  event_loop_group_.reset(new RoundRobinEventLoopGroup(config().thread_count_io()));
-  rc = event_loop_group_->init("Request Processor");
-  if (rc != 0) {
-    notify_connect_failed(CASS_ERROR_LIB_UNABLE_TO_INIT, "Unable to initialize event loop group");
-    return;
+  if (config().shared_runtime()) {
+    // The shared threads are already running, they're started when connecting.
+    // This runs on one of them so they can't be flushed here.
+    if (owned_event_loop_group_) join();
+    event_loop_group_ = config().shared_runtime()->event_loop_group();
+  } else {
+    join();
+    owned_event_loop_group_.reset(new RoundRobinEventLoopGroup(config().thread_count_io()));
+    owned_event_loop_group_->set_work_stealing(config().work_stealing());
+    owned_event_loop_group_->set_busy_poll(config().busy_poll());
+    owned_event_loop_group_->set_cpu_affinity(config().io_thread_cpu_sets());
+    rc = owned_event_loop_group_->init("Request Processor");
+    if (rc != 0) {
+      notify_connect_failed(CASS_ERROR_LIB_UNABLE_TO_INIT,
+                            "Unable to initialize event loop group");
+      return;
+    }
+
+    rc = owned_event_loop_group_->run();
+    if (rc != 0) {
+      notify_connect_failed(CASS_ERROR_LIB_UNABLE_TO_INIT, "Unable to run event loop group");
+      return;
+    }
+    event_loop_group_ = owned_event_loop_group_.get();
   }
 
-  rc = event_loop_group_->run();
-  if (rc != 0) {
-    notify_connect_failed(CASS_ERROR_LIB_UNABLE_TO_INIT, "Unable to run event loop group");
-    return;
+  if (config().callback_executor_submit()) {
+    callback_executor_.reset(new ExternalCallbackExecutor(config().callback_executor_submit(),
+                                                          config().callback_executor_data()));
+  } else if (config().thread_count_callback() > 0) {
+    ThreadPoolCallbackExecutor* executor =
+        new ThreadPoolCallbackExecutor(config().thread_count_callback());
+    callback_executor_.reset(executor);
+    rc = executor->init();
+    if (rc != 0) {
+      notify_connect_failed(CASS_ERROR_LIB_UNABLE_TO_INIT, "Unable to run callback threads");
+      return;
+    }
   }
 
   for (HostMap::const_iterator it = hosts.begin(), end = hosts.end(); it != end; ++it) {
     const Host::Ptr& host = it->second;
+    if (config().host_and_profile_metrics()) {
+      host->set_latency_histogram(metrics()->host_latencies(host->address()));
+    }
     config().host_listener()->on_host_added(host);
     config().host_listener()->on_host_up(
         host); // If host is down it will be marked down later in the connection process
@@ -403,13 +1870,65 @@ void Session::on_connect(const Host::Ptr& connected_host, ProtocolVersion protoc
   request_processors_.clear();
   request_processor_count_ = 0;
   is_closing_ = false;
+  if (config().max_inflight_requests() > 0 || config().memory_limit() > 0) {
+    inflight_limiter_.reset(
+        new InflightLimiter(config().max_inflight_requests(), config().memory_limit(),
+                            config().backpressure_mode() == CASS_BACKPRESSURE_MODE_WAIT, this));
+  } else {
+    inflight_limiter_.reset();
+  }
+  PreparedCache::ConstPtr prepared_cache;
+  if (!config().prepared_cache_file().empty()) {
+    prepared_cache.reset(PreparedCache::load(config().prepared_cache_file(), protocol_version));
+    if (prepared_cache) {
+      // Seed the prepared metadata so that cached statements are prepared
+      // again on hosts that respond with UNPREPARED
+      Vector<std::pair<String, PreparedMetadata::Entry::Ptr> > entries;
+      prepared_cache->entries(&entries);
+      for (size_t i = 0; i < entries.size(); ++i) {
+        cluster()->prepared(entries[i].first, entries[i].second);
+      }
+    }
+  }
+
+  {
+    ScopedMutex l(&mutex_);
+    token_map_ = token_map;
+    keyspace_ = connect_keyspace();
+    prepared_cache_ = prepared_cache;
+    protocol_version_ = protocol_version;
+  }
   SessionInitializer::Ptr initializer(new SessionInitializer(this));
-  initializer->initialize(connected_host, protocol_version, hosts, token_map, local_dc, local_rack);
+  // All the request processors share the same snapshot of the hosts
+  initializer->initialize(connected_host, protocol_version, cluster()->host_table(), token_map,
+                          local_dc, local_rack);
 }
 
 void Session::on_close() {
   // If there are request processors still connected those need to be closed
   // first before sending the close notification.
+  if (inflight_limiter_) {
+    inflight_limiter_->close();
+  }
+
+  if (cluster() && !config().prepared_cache_file().empty()) {
+    ProtocolVersion protocol_version;
+    {
+      ScopedMutex l(&mutex_);
+      protocol_version = protocol_version_;
+    }
+    // Sessions that failed to connect have no statements and don't replace
+    // the existing file
+    PreparedMetadata::Entry::Vec entries(cluster()->prepared_entries());
+    if (protocol_version.is_valid() && !entries.empty()) {
+      int count = PreparedCache::save(config().prepared_cache_file(), protocol_version, entries);
+      if (count >= 0) {
+        LOG_INFO("Saved %d prepared statements to cache file \"%s\"", count,
+                 config().prepared_cache_file().c_str());
+      }
+    }
+  }
+
   ScopedMutex l(&mutex_);
   is_closing_ = true;
   if (request_processor_count_ > 0) {
@@ -444,6 +1963,10 @@ void Session::on_host_down(const Host::Ptr& host) {
 }
 
 void Session::on_host_added(const Host::Ptr& host) {
+  // Set before the request processors can use the host
+  if (config().host_and_profile_metrics()) {
+    host->set_latency_histogram(metrics()->host_latencies(host->address()));
+  }
   { // Lock for request processor
     ScopedMutex l(&mutex_);
     for (RequestProcessor::Vec::const_iterator it = request_processors_.begin(),
@@ -469,6 +1992,7 @@ void Session::on_host_removed(const Host::Ptr& host) {
 
 void Session::on_token_map_updated(const TokenMap::Ptr& token_map) {
   ScopedMutex l(&mutex_);
+  token_map_ = token_map;
   for (RequestProcessor::Vec::const_iterator it = request_processors_.begin(),
                                              end = request_processors_.end();
        it != end; ++it) {
@@ -494,6 +2018,8 @@ void Session::on_host_ready(const Host::Ptr& host) {
   }
 }
 
+void Session::on_dispatch(const RequestHandler::Ptr& request_handler) { dispatch(request_handler); }
+
 void Session::on_pool_up(const Address& address) { cluster()->notify_host_up(address); }
 
 void Session::on_pool_down(const Address& address) { cluster()->notify_host_down(address); }
@@ -506,6 +2032,7 @@ void Session::on_pool_critical_error(const Address& address, Connector::Connecti
 void Session::on_keyspace_changed(const String& keyspace,
                                   const KeyspaceChangedHandler::Ptr& handler) {
   ScopedMutex l(&mutex_);
+  keyspace_ = keyspace;
   for (RequestProcessor::Vec::const_iterator it = request_processors_.begin(),
                                              end = request_processors_.end();
        it != end; ++it) {
@@ -518,6 +2045,8 @@ void Session::on_prepared_metadata_changed(const String& id,
   cluster()->prepared(id, entry);
 }
 
+void Session::on_host_unprepared(const Host::Ptr& host) { cluster()->reprepare_host(host); }
+
 void Session::on_close(RequestProcessor* processor) {
   // Requires a lock because the close callback is called from several
   // different request processor threads.
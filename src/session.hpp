@@ -18,8 +18,11 @@
 #define DATASTAX_INTERNAL_SESSION_HPP
 
 #include "allocated.hpp"
+#include "callback_executor.hpp"
+#include "inflight_limiter.hpp"
 #include "metrics.hpp"
 #include "mpmc_queue.hpp"
+#include "prepared_cache.hpp"
 #include "request_processor.hpp"
 #include "session_base.hpp"
 
@@ -27,13 +30,18 @@
 
 namespace datastax { namespace internal { namespace core {
 
+class BatchRequest;
+class ContinuousPaging;
+
+class RequestCoalescer;
 class RequestProcessorInitializer;
 class Statement;
 
 class Session
     : public Allocated
     , public SessionBase
-    , public RequestProcessorListener {
+    , public RequestProcessorListener
+    , public InflightLimiterListener {
 public:
   Session();
   ~Session();
@@ -44,11 +52,174 @@ public:
 
   Future::Ptr execute(const Request::ConstPtr& request);
 
+  /**
+   * Execute statements bound from the same prepared statement, e.g. reads of
+   * many partition keys. The statements are grouped by the replica that owns
+   * their partition and each group is enqueued to a single request processor
+   * at once.
+   *
+   * @param requests The bound statements.
+   * @return A future for the rows of all of the statements, concatenated in
+   * the order of the statements, or for the first statement's error.
+   */
+  Future::Ptr execute_many(const Vector<Request::ConstPtr>& requests);
+
+  /**
+   * Execute independent statements. The statements' requests are enqueued
+   * to a single request processor with one queue operation and one wake-up.
+   *
+   * @param requests The statements.
+   * @param futures The statements' futures, in the order of the statements
+   * (output).
+   */
+  void execute_all(const Vector<Request::ConstPtr>& requests, Vector<Future::Ptr>* futures);
+
+  /**
+   * Execute a DSE continuous paging request. The pages before the last page
+   * are added to the continuous paging object as they're received.
+   *
+   * @param request A statement.
+   * @param continuous_paging The request's pages.
+   * @return The future for the last page. Its callback runs on the thread
+   * that sets it.
+   */
+  Future::Ptr execute_continuous_paging(const Request::ConstPtr& request,
+                                        const SharedRefPtr<ContinuousPaging>& continuous_paging);
+
+  /**
+   * Take the prefetched next page of a paged request. This waits for the
+   * current page and starts the request for the page after the next page if
+   * that request was deferred until now.
+   *
+   * @param future The future for the current page.
+   * @return The future for the next page or null if there are no more pages,
+   * paging prefetch wasn't enabled or the next page was already taken.
+   */
+  ResponseFuture::Ptr take_next_page(ResponseFuture* future);
+
+  const RoundRobinEventLoopGroup* event_loop_group() const { return event_loop_group_; }
+  const RequestProcessor::Vec& request_processors() const { return request_processors_; }
+  const InflightLimiter* inflight_limiter() const { return inflight_limiter_.get(); }
+
+  /**
+   * Get the metrics of the session's current token map.
+   *
+   * @param metrics The token map metrics. These are all zero if the session
+   * isn't connected or token aware routing is disabled.
+   */
+  void token_map_metrics(TokenMapMetrics* metrics) const;
+
+  /**
+   * Get the session's current token map. Published token maps are never
+   * modified so it's safe to read the token map on any thread.
+   *
+   * @return The token map or null if the session isn't connected or token
+   * aware routing is disabled.
+   */
+  TokenMap::Ptr token_map() const;
+
+  /**
+   * Get the metrics of the session's prepared statements.
+   *
+   * @param metrics The prepared metadata metrics. These are all zero if the
+   * session isn't connected.
+   */
+  void prepared_metadata_metrics(PreparedMetadataMetrics* metrics) const;
+
+  /**
+   * Render the session's metrics in the OpenMetrics text format. This
+   * includes the request latencies and rates, connection, retry and buffer
+   * pool counters, the request processors' queues, the event loops and the
+   * per host and per execution profile metrics.
+   *
+   * @return The metrics or an empty string if the session isn't connected.
+   */
+  String open_metrics() const;
+
+  /**
+   * Replace one of the session's named execution profiles without
+   * reconnecting. Each request processor switches to the new profile on its
+   * event loop so the requests that are already running keep the previous
+   * settings.
+   *
+   * @param name The name of an existing execution profile.
+   * @param profile The new profile.
+   * @return CASS_OK if successful, otherwise an error occurred.
+   */
+  CassError update_execution_profile(const String& name, const ExecutionProfile& profile);
+
 private:
+  // The request's handler is added to the request handlers, if provided,
+  // instead of being executed
+  Future::Ptr execute_request(const Request::ConstPtr& request,
+                              Vector<RequestHandler::Ptr>* request_handlers = NULL);
+
+  /**
+   * Split an unlogged batch into one batch per replica set and execute the
+   * batches in parallel.
+   *
+   * @param batch The batch to split.
+   * @return The future for the whole batch or null if the batch can't be
+   * split and should be executed unchanged.
+   */
+  Future::Ptr execute_split_batch(const BatchRequest* batch);
+
+  /**
+   * Execute a copy of a batch that caches its encoded statements, split into
+   * batches under the configured size if the batch is too large.
+   *
+   * @param batch The batch to execute.
+   * @return The future for the whole batch.
+   */
+  Future::Ptr execute_sized_batch(const BatchRequest* batch);
+
+  /**
+   * Execute batches in parallel, using the same client-side timestamp.
+   *
+   * @param batch The original batch.
+   * @param batches The batches the original batch was split into.
+   * @return The future for the whole batch.
+   */
+  Future::Ptr execute_batches(const BatchRequest* batch,
+                              const Vector<SharedRefPtr<BatchRequest> >& batches);
+
   void execute(const RequestHandler::Ptr& request_handler);
 
+  void execute_group(const Vector<RequestHandler::Ptr>& request_handlers);
+
+  void dispatch(const RequestHandler::Ptr& request_handler);
+
+  /**
+   * Get a request's priority: the request's own priority, otherwise its
+   * execution profile's priority.
+   *
+   * @param request The request.
+   * @return The priority.
+   */
+  CassRequestPriority priority(const Request* request) const;
+
   void join();
 
+  /**
+   * Complete a prepare request using the prepared statement cache file.
+   *
+   * @param keyspace The keyspace the query is prepared in.
+   * @param prepare The prepare request.
+   * @param future The prepare request's future.
+   * @return true if the statement was cached and the future was set.
+   */
+  bool prepare_cached(const String& keyspace, const PrepareRequest* prepare,
+                      const ResponseFuture::Ptr& future);
+
+  /**
+   * Prepare a query, completing it from the prepared statement cache file or
+   * joining a prepare of the same query that's already in flight if possible.
+   *
+   * @param prepare The prepare request.
+   * @return The prepare request's future.
+   */
+  Future::Ptr execute_prepare(const PrepareRequest::Ptr& prepare);
+
 private:
   // Session base methods
 
@@ -90,6 +261,8 @@ private:
   virtual void on_keyspace_changed(const String& keyspace,
                                    const KeyspaceChangedHandler::Ptr& handler);
 
+  virtual void on_host_unprepared(const Host::Ptr& host);
+
   virtual void on_prepared_metadata_changed(const String& id,
                                             const PreparedMetadata::Entry::Ptr& entry);
 
@@ -97,15 +270,30 @@ private:
 
   using RequestProcessorListener::on_connect; // Intentional overload
 
+private:
+  // Inflight limiter listener methods
+
+  virtual void on_dispatch(const RequestHandler::Ptr& request_handler);
+
 private:
   friend class SessionInitializer;
 
 private:
-  ScopedPtr<RoundRobinEventLoopGroup> event_loop_group_;
-  uv_mutex_t mutex_;
+  RoundRobinEventLoopGroup* event_loop_group_; // Either owned or the shared runtime's
+  ScopedPtr<RoundRobinEventLoopGroup> owned_event_loop_group_;
+  ScopedPtr<CallbackExecutor> callback_executor_;
+  mutable uv_mutex_t mutex_;
   RequestProcessor::Vec request_processors_;
   size_t request_processor_count_;
   bool is_closing_;
+  InflightLimiter::Ptr inflight_limiter_;
+  TokenMap::Ptr token_map_;
+  String keyspace_;
+  PreparedCache::ConstPtr prepared_cache_;
+  ProtocolVersion protocol_version_;
+  SharedRefPtr<RequestCoalescer> prepare_coalescer_;
+  SharedRefPtr<RequestCoalescer> read_coalescer_;
+  ExecutionProfile::ConstVec indexed_profiles_; // The profiles by handle
 };
 
 }}} // namespace datastax::internal::core
@@ -37,7 +37,11 @@ public:
 };
 
 SessionBase::SessionBase()
-    : state_(SESSION_STATE_CLOSED) {
+    : state_(SESSION_STATE_CLOSED)
+    , is_connected_(false)
+    , is_schema_pending_(false)
+    , connect_start_time_(0)
+    , pools_start_time_(0) {
   uv_mutex_init(&mutex_);
 
   UuidGen generator;
@@ -49,6 +53,8 @@ SessionBase::~SessionBase() {
   if (event_loop_) {
     event_loop_->close_handles();
     event_loop_->join();
+  } else if (config_.shared_runtime()) {
+    config_.shared_runtime()->flush();
   }
   uv_mutex_destroy(&mutex_);
 }
@@ -63,7 +69,15 @@ Future::Ptr SessionBase::connect(const Config& config, const String& keyspace) {
     return future;
   }
 
-  if (!event_loop_) {
+  const SharedRuntime::Ptr& shared_runtime = config.shared_runtime();
+  if (shared_runtime) {
+    int rc = shared_runtime->init(config.thread_count_io(), config.work_stealing(),
+                                  config.busy_poll(), config.io_thread_cpu_sets());
+    if (rc != 0) {
+      future->set_error(CASS_ERROR_LIB_UNABLE_TO_INIT, "Unable to run shared event loops");
+      return future;
+    }
+  } else if (!event_loop_) {
     int rc = 0;
     event_loop_.reset(new EventLoop());
 
@@ -86,10 +100,21 @@ Future::Ptr SessionBase::connect(const Config& config, const String& keyspace) {
   LOG_INFO("Client id is %s", to_string(client_id_).c_str());
   LOG_INFO("Session id is %s", to_string(session_id_).c_str());
 
-  config_ = config.new_instance();
+  if (shared_runtime && shared_runtime->thread_count_io() != config.thread_count_io()) {
+    // The shared threads were started using an earlier number of IO threads
+    Config shared_config(config);
+    shared_config.set_thread_count_io(static_cast<unsigned>(shared_runtime->thread_count_io()));
+    config_ = shared_config.new_instance();
+  } else {
+    config_ = config.new_instance();
+  }
   connect_keyspace_ = keyspace;
   connect_future_ = future;
   state_ = SESSION_STATE_CONNECTING;
+  is_connected_ = false;
+  is_schema_pending_ = false;
+  connect_start_time_ = uv_hrtime();
+  startup_timings_ = StartupTimings();
 
   if (config.use_randomized_contact_points()) {
     random_.reset(new Random());
@@ -97,7 +122,32 @@ Future::Ptr SessionBase::connect(const Config& config, const String& keyspace) {
     random_.reset();
   }
 
-  metrics_.reset(new Metrics(config.thread_count_io() + 1));
+  metrics_.reset(new Metrics(config_.thread_count_io() + 1));
+  if (config.request_stage_metrics()) {
+    metrics_->enable_stage_latencies();
+  }
+  metrics_->set_snapshot_max_age_ms(config.metrics_snapshot_max_age_ms());
+
+  if (config.slow_request_threshold_ms() > 0) {
+    slow_request_log_.reset(new SlowRequestLog(
+        config.slow_request_threshold_ms(), config.slow_request_log_capacity(),
+        config.slow_request_callback(), config.slow_request_data()));
+  } else {
+    slow_request_log_.reset();
+  }
+
+  if (config.result_cache_size() > 0) {
+    result_cache_.reset(new ResultCache(config.result_cache_size()));
+  } else {
+    result_cache_.reset();
+  }
+
+  if (config.request_tracer_callback()) {
+    request_tracer_.reset(
+        new RequestTracer(config.request_tracer_callback(), config.request_tracer_data()));
+  } else {
+    request_tracer_.reset();
+  }
 
   cluster_.reset();
   ClusterConnector::Ptr connector(
@@ -112,7 +162,7 @@ Future::Ptr SessionBase::connect(const Config& config, const String& keyspace) {
       ->with_settings(settings)
       ->with_random(random_.get())
       ->with_metrics(metrics_.get())
-      ->connect(event_loop_.get());
+      ->connect(shared_runtime ? shared_runtime->event_loop() : event_loop_.get());
 
   return future;
 }
@@ -131,9 +181,23 @@ Future::Ptr SessionBase::close() {
   return future;
 }
 
+StartupTimings SessionBase::startup_timings() const {
+  ScopedMutex l(&mutex_);
+  return startup_timings_;
+}
+
 void SessionBase::notify_connected() {
   ScopedMutex l(&mutex_);
   if (state_ == SESSION_STATE_CONNECTING) {
+    startup_timings_.connection_pools = uv_hrtime() - pools_start_time_;
+    is_connected_ = true;
+    maybe_finish_connect();
+  }
+}
+
+void SessionBase::maybe_finish_connect() {
+  if (is_connected_ && !is_schema_pending_) {
+    startup_timings_.total = uv_hrtime() - connect_start_time_;
     state_ = SESSION_STATE_CONNECTED;
     connect_future_->set();
     connect_future_.reset();
@@ -183,10 +247,32 @@ void SessionBase::on_close(Cluster* cluster) {
   }
 }
 
+void SessionBase::on_schema_ready(Cluster* cluster) {
+  ScopedMutex l(&mutex_);
+  if (is_schema_pending_) {
+    startup_timings_.schema_query += cluster->deferred_schema_time();
+    is_schema_pending_ = false;
+    if (state_ == SESSION_STATE_CONNECTING) {
+      maybe_finish_connect();
+    }
+  }
+}
+
 void SessionBase::on_initialize(ClusterConnector* connector) {
   if (connector->is_ok()) {
     cluster_ = connector->release_cluster();
 
+    { // The deferred schema is handled on this thread so it can't be
+      // retrieved before this is recorded.
+      ScopedMutex l(&mutex_);
+      startup_timings_ = connector->timings();
+      is_schema_pending_ = cluster_->is_schema_pending();
+      if (!is_schema_pending_) {
+        startup_timings_.schema_query += cluster_->deferred_schema_time();
+      }
+      pools_start_time_ = uv_hrtime();
+    }
+
     // Handle default consistency level for DBaaS
     StringMultimap::const_iterator it = cluster_->supported_options().find("PRODUCT_TYPE");
     if (it != cluster_->supported_options().end() && it->second[0] == CASS_DBAAS_PRODUCT_TYPE) {
@@ -200,7 +286,7 @@ void SessionBase::on_initialize(ClusterConnector* connector) {
     }
 
     on_connect(cluster_->connected_host(), cluster_->protocol_version(),
-               cluster_->available_hosts(), cluster_->token_map(), cluster_->local_dc(), cluster_->local_rack());
+               cluster_->host_table()->hosts(), cluster_->token_map(), cluster_->local_dc(), cluster_->local_rack());
   } else {
     assert(!connector->is_canceled() && "Cluster connection process canceled");
     switch (connector->error_code()) {
@@ -19,7 +19,10 @@
 
 #include "cluster_connector.hpp"
 #include "prepared.hpp"
+#include "request_tracer.hpp"
+#include "result_cache.hpp"
 #include "schema_agreement_handler.hpp"
+#include "slow_request_log.hpp"
 #include "token_map.hpp"
 
 namespace datastax { namespace internal {
@@ -78,8 +81,18 @@ public:
   Cluster::Ptr cluster() const { return cluster_; }
   Random* random() const { return random_.get(); }
   Metrics* metrics() const { return metrics_.get(); }
+  const SlowRequestLog::Ptr& slow_request_log() const { return slow_request_log_; }
+  const RequestTracer::Ptr& request_tracer() const { return request_tracer_; }
+  const ResultCache::Ptr& result_cache() const { return result_cache_; }
   State state() const { return state_; }
 
+  /**
+   * Get the time spent in each step of connecting the session (thread-safe).
+   *
+   * @return The startup timings.
+   */
+  StartupTimings startup_timings() const;
+
 protected:
   /**
    * Notify the future that session has been successfully connected.
@@ -147,6 +160,13 @@ protected:
 private:
   void on_initialize(ClusterConnector* connector);
 
+  // Cluster listener methods
+  virtual void on_schema_ready(Cluster* cluster);
+
+  // Set the connect future once the hosts are connected and the deferred
+  // schema (if any) has been retrieved. This requires the mutex to be held.
+  void maybe_finish_connect();
+
 private:
   mutable uv_mutex_t mutex_;
   State state_;
@@ -155,11 +175,19 @@ private:
   Config config_;
   ScopedPtr<Random> random_;
   ScopedPtr<Metrics> metrics_;
+  SlowRequestLog::Ptr slow_request_log_;
+  RequestTracer::Ptr request_tracer_;
+  ResultCache::Ptr result_cache_;
   String connect_keyspace_;
   CassError connect_error_code_;
   String connect_error_message_;
   Future::Ptr connect_future_;
   Future::Ptr close_future_;
+  bool is_connected_;
+  bool is_schema_pending_;
+  uint64_t connect_start_time_;
+  uint64_t pools_start_time_;
+  StartupTimings startup_timings_;
   CassUuid client_id_;
   CassUuid session_id_;
 };
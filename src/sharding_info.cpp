@@ -0,0 +1,100 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "sharding_info.hpp"
+
+#include <errno.h>
+#include <stdlib.h>
+
+// The ephemeral port range used for the local ports of shard-aware connections
+#define LOCAL_PORT_MIN 49152
+#define LOCAL_PORT_MAX 65535
+
+#define SHARDING_PARTITIONER "org.apache.cassandra.dht.Murmur3Partitioner"
+#define SHARDING_ALGORITHM "biased-token-round-robin"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+static const String* find_option(const StringMultimap& supported_options, const char* key) {
+  StringMultimap::const_iterator it = supported_options.find(key);
+  if (it == supported_options.end() || it->second.empty()) return NULL;
+  return &it->second.front();
+}
+
+static bool parse_int(const StringMultimap& supported_options, const char* key, int min, int max,
+                      int* output) {
+  const String* value = find_option(supported_options, key);
+  if (!value || value->empty()) return false;
+  char* end = NULL;
+  errno = 0;
+  long result = strtol(value->c_str(), &end, 10);
+  if (errno != 0 || *end != '\0' || result < min || result > max) return false;
+  *output = static_cast<int>(result);
+  return true;
+}
+
+bool ShardingInfo::parse(const StringMultimap& supported_options, ShardingInfo* info) {
+  const String* partitioner = find_option(supported_options, "SCYLLA_PARTITIONER");
+  const String* algorithm = find_option(supported_options, "SCYLLA_SHARDING_ALGORITHM");
+  if (!partitioner || *partitioner != SHARDING_PARTITIONER || !algorithm ||
+      *algorithm != SHARDING_ALGORITHM) {
+    return false;
+  }
+
+  ShardingInfo result;
+  int ignore_msb = 0;
+  if (!parse_int(supported_options, "SCYLLA_NR_SHARDS", 1, LOCAL_PORT_MAX - LOCAL_PORT_MIN,
+                 &result.shards_count_) ||
+      !parse_int(supported_options, "SCYLLA_SHARD", 0, result.shards_count_ - 1,
+                 &result.shard_id_) ||
+      !parse_int(supported_options, "SCYLLA_SHARDING_IGNORE_MSB", 0, 63, &ignore_msb)) {
+    return false;
+  }
+  result.ignore_msb_ = static_cast<unsigned>(ignore_msb);
+
+  // The shard-aware port is optional
+  parse_int(supported_options, "SCYLLA_SHARD_AWARE_PORT", 1, LOCAL_PORT_MAX,
+            &result.shard_aware_port_);
+
+  *info = result;
+  return true;
+}
+
+int ShardingInfo::shard_id(int64_t token) const {
+  // Bias the token so that the smallest token is zero, drop the ignored most
+  // significant bits and scale the result to the number of shards. The high
+  // 64 bits of the 96-bit product are computed using 32-bit halves.
+  uint64_t biased = static_cast<uint64_t>(token) + (static_cast<uint64_t>(1) << 63);
+  biased <<= ignore_msb_;
+  uint64_t count = static_cast<uint64_t>(shards_count_);
+  uint64_t high = (biased >> 32) * count;
+  uint64_t low = (biased & 0xFFFFFFFF) * count;
+  return static_cast<int>((high + (low >> 32)) >> 32);
+}
+
+int ShardingInfo::local_port(int shard_id, int start) const {
+  int port = LOCAL_PORT_MIN + (start % (LOCAL_PORT_MAX - LOCAL_PORT_MIN + 1));
+  port = port - port % shards_count_ + shard_id;
+  if (port > LOCAL_PORT_MAX) { // Wrap around to the start of the range
+    port = LOCAL_PORT_MIN - LOCAL_PORT_MIN % shards_count_ + shard_id;
+  }
+  if (port < LOCAL_PORT_MIN) {
+    port += shards_count_;
+  }
+  return port;
+}
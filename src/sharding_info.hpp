@@ -0,0 +1,98 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_SHARDING_INFO_HPP
+#define DATASTAX_INTERNAL_SHARDING_INFO_HPP
+
+#include "decoder.hpp"
+
+#include <stdint.h>
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * The sharding of a host that partitions its data per CPU core (shard). It's
+ * advertised in the SUPPORTED response of each connection along with the
+ * shard that owns the connection.
+ *
+ * Only the "biased-token-round-robin" algorithm of the Murmur3 partitioner is
+ * supported; other hosts aren't considered to be sharded.
+ */
+class ShardingInfo {
+public:
+  ShardingInfo()
+      : shard_id_(-1)
+      , shards_count_(0)
+      , ignore_msb_(0)
+      , shard_aware_port_(0) {}
+
+  /**
+   * Parse the sharding of a host from the supported options of a connection.
+   *
+   * @param supported_options The normalized (uppercase) supported options.
+   * @param info The parsed sharding. It's unchanged if the host isn't sharded.
+   * @return true if the host is sharded, otherwise false.
+   */
+  static bool parse(const StringMultimap& supported_options, ShardingInfo* info);
+
+  /**
+   * Determine if the host is sharded.
+   *
+   * @return true if the sharding is known.
+   */
+  bool is_valid() const { return shards_count_ > 0; }
+
+  /**
+   * The shard that owns the connection the sharding was received on.
+   */
+  int shard_id() const { return shard_id_; }
+
+  int shards_count() const { return shards_count_; }
+
+  /**
+   * The port that assigns connections to the shard selected by their source
+   * port or zero if the host doesn't have one.
+   */
+  int shard_aware_port() const { return shard_aware_port_; }
+
+  /**
+   * Compute the shard that owns a token.
+   *
+   * @param token A Murmur3 token.
+   * @return The shard of the token.
+   */
+  int shard_id(int64_t token) const;
+
+  /**
+   * Compute a local (source) port, at or after a starting port, that the
+   * shard-aware port assigns to a shard.
+   *
+   * @param shard_id The shard.
+   * @param start A non-negative value that selects the starting port.
+   * @return A port in the ephemeral port range.
+   */
+  int local_port(int shard_id, int start) const;
+
+private:
+  int shard_id_;
+  int shards_count_;
+  unsigned ignore_msb_;
+  int shard_aware_port_;
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
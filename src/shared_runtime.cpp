@@ -0,0 +1,149 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "shared_runtime.hpp"
+
+#include "scoped_lock.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+extern "C" {
+
+CassRuntime* cass_runtime_new(unsigned num_threads_io) {
+  SharedRuntime* runtime = new SharedRuntime(num_threads_io);
+  runtime->inc_ref();
+  return CassRuntime::to(runtime);
+}
+
+void cass_runtime_free(CassRuntime* runtime) { runtime->dec_ref(); }
+
+} // extern "C"
+
+namespace {
+
+/**
+ * Counts down the event loops that have run all the tasks queued before it.
+ */
+class FlushBarrier {
+public:
+  FlushBarrier(size_t count)
+      : count_(count) {
+    uv_mutex_init(&mutex_);
+    uv_cond_init(&cond_);
+  }
+
+  ~FlushBarrier() {
+    uv_cond_destroy(&cond_);
+    uv_mutex_destroy(&mutex_);
+  }
+
+  void arrive() {
+    ScopedMutex l(&mutex_);
+    if (--count_ == 0) {
+      uv_cond_signal(&cond_);
+    }
+  }
+
+  void wait() {
+    ScopedMutex l(&mutex_);
+    while (count_ > 0) {
+      uv_cond_wait(&cond_, l.get());
+    }
+  }
+
+private:
+  uv_mutex_t mutex_;
+  uv_cond_t cond_;
+  size_t count_;
+};
+
+class FlushTask : public Task {
+public:
+  FlushTask(FlushBarrier* barrier)
+      : barrier_(barrier) {}
+
+  virtual void run(EventLoop* event_loop) { barrier_->arrive(); }
+
+private:
+  FlushBarrier* barrier_;
+};
+
+} // namespace
+
+SharedRuntime::SharedRuntime(size_t thread_count_io)
+    : thread_count_io_(thread_count_io)
+    , init_rc_(0)
+    , is_initialized_(false) {
+  uv_mutex_init(&mutex_);
+}
+
+SharedRuntime::~SharedRuntime() {
+  join();
+  uv_mutex_destroy(&mutex_);
+}
+
+int SharedRuntime::init(size_t thread_count_io, bool work_stealing, bool busy_poll,
+                        const Vector<Vector<unsigned> >& cpu_sets) {
+  ScopedMutex l(&mutex_);
+  if (is_initialized_) return init_rc_;
+  is_initialized_ = true;
+
+  event_loop_.reset(new EventLoop());
+  init_rc_ = event_loop_->init("Session/Control Connection");
+  if (init_rc_ != 0) return init_rc_;
+  init_rc_ = event_loop_->run();
+  if (init_rc_ != 0) return init_rc_;
+
+  event_loop_group_.reset(
+      new RoundRobinEventLoopGroup(thread_count_io_ > 0 ? thread_count_io_ : thread_count_io));
+  event_loop_group_->set_work_stealing(work_stealing);
+  event_loop_group_->set_busy_poll(busy_poll);
+  event_loop_group_->set_cpu_affinity(cpu_sets);
+  init_rc_ = event_loop_group_->init("Request Processor");
+  if (init_rc_ != 0) return init_rc_;
+  init_rc_ = event_loop_group_->run();
+  return init_rc_;
+}
+
+void SharedRuntime::flush() {
+  ScopedMutex l(&mutex_);
+  if (!is_initialized_ || init_rc_ != 0) return;
+
+  // The tasks of an event loop are run in order so once the barrier task has
+  // run, every task queued before it has also run
+  size_t count = 1 + event_loop_group_->size();
+  FlushBarrier barrier(count);
+  event_loop_->add(new FlushTask(&barrier));
+  for (size_t i = 0; i < event_loop_group_->size(); ++i) {
+    event_loop_group_->get(i)->add(new FlushTask(&barrier));
+  }
+  barrier.wait();
+}
+
+void SharedRuntime::join() {
+  if (event_loop_group_) {
+    event_loop_group_->close_handles();
+    event_loop_group_->join();
+    event_loop_group_.reset();
+  }
+  if (event_loop_) {
+    event_loop_->close_handles();
+    event_loop_->join();
+    event_loop_.reset();
+  }
+}
@@ -0,0 +1,106 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_SHARED_RUNTIME_HPP
+#define DATASTAX_INTERNAL_SHARED_RUNTIME_HPP
+
+#include "cassandra.h"
+#include "event_loop.hpp"
+#include "external.hpp"
+#include "macros.hpp"
+#include "ref_counted.hpp"
+#include "scoped_ptr.hpp"
+#include "vector.hpp"
+
+#include <uv.h>
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * The threads shared by the sessions connected using the same cluster object:
+ * the session/control connection event loop and the group of IO event loops.
+ * The threads are started by the first session that connects and they're
+ * joined once the runtime is no longer referenced by any session or cluster
+ * object. A runtime created by the application can also be shared by the
+ * cluster objects of different clusters.
+ *
+ * Each session still runs its own control connection and request processors
+ * (connection pools) on these event loops.
+ */
+class SharedRuntime : public RefCounted<SharedRuntime> {
+public:
+  typedef SharedRefPtr<SharedRuntime> Ptr;
+
+  /**
+   * Constructor.
+   *
+   * @param thread_count_io The number of IO event loops. If 0, the number
+   * given to init() is used.
+   */
+  SharedRuntime(size_t thread_count_io = 0);
+  ~SharedRuntime();
+
+  /**
+   * Start the threads if they haven't already been started. The settings are
+   * ignored once the threads are running.
+   *
+   * @param thread_count_io The number of IO event loops, unless the runtime
+   * was constructed with a number of IO event loops.
+   * @param work_stealing Enable work stealing between the IO event loops.
+   * @param busy_poll Spin the IO event loops.
+   * @param cpu_sets The CPUs the IO event loops are pinned to.
+   * @return Returns 0 if successful, otherwise an error occurred.
+   */
+  int init(size_t thread_count_io, bool work_stealing, bool busy_poll,
+           const Vector<Vector<unsigned> >& cpu_sets);
+
+  /**
+   * Wait until the tasks queued on the event loops before this call have run.
+   * A session uses this, instead of joining the threads, to make sure that
+   * its callbacks are no longer running before it's destroyed. This must not
+   * be called on one of the runtime's threads.
+   */
+  void flush();
+
+  EventLoop* event_loop() { return event_loop_.get(); }
+  RoundRobinEventLoopGroup* event_loop_group() { return event_loop_group_.get(); }
+
+  /**
+   * The number of IO event loops. This is only valid after a successful call
+   * to init().
+   */
+  size_t thread_count_io() const { return event_loop_group_ ? event_loop_group_->size() : 0; }
+
+private:
+  void join();
+
+private:
+  uv_mutex_t mutex_;
+  const size_t thread_count_io_;
+  int init_rc_;
+  bool is_initialized_;
+  ScopedPtr<EventLoop> event_loop_;
+  ScopedPtr<RoundRobinEventLoopGroup> event_loop_group_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(SharedRuntime);
+};
+
+}}} // namespace datastax::internal::core
+
+EXTERNAL_TYPE(datastax::internal::core::SharedRuntime, CassRuntime)
+
+#endif
@@ -0,0 +1,150 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "slow_request_log.hpp"
+
+#include "batch_request.hpp"
+#include "execute_request.hpp"
+#include "prepare_request.hpp"
+#include "statement.hpp"
+
+// Keeps a log of large batches from holding on to a lot of memory
+#define MAX_QUERY_LENGTH 1024
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+extern "C" {
+
+void cass_slow_request_free(CassSlowRequest* request) { delete request->from(); }
+
+void cass_slow_request_query(const CassSlowRequest* request, const char** query,
+                             size_t* query_length) {
+  *query = request->query.data();
+  *query_length = request->query.size();
+}
+
+CassError cass_slow_request_error_code(const CassSlowRequest* request) {
+  return request->error_code;
+}
+
+CassError cass_slow_request_coordinator(const CassSlowRequest* request, CassInet* address) {
+  if (!request->coordinator.is_valid()) {
+    return CASS_ERROR_LIB_NO_HOSTS_AVAILABLE;
+  }
+  address->address_length = request->coordinator.to_inet(address->address);
+  return CASS_OK;
+}
+
+size_t cass_slow_request_attempted_host_count(const CassSlowRequest* request) {
+  return request->attempted_hosts.size();
+}
+
+CassError cass_slow_request_attempted_host(const CassSlowRequest* request, size_t index,
+                                           CassInet* address) {
+  if (index >= request->attempted_hosts.size()) {
+    return CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS;
+  }
+  address->address_length = request->attempted_hosts[index].to_inet(address->address);
+  return CASS_OK;
+}
+
+unsigned cass_slow_request_retries(const CassSlowRequest* request) { return request->retries; }
+
+unsigned cass_slow_request_speculative_executions(const CassSlowRequest* request) {
+  return request->speculative_executions;
+}
+
+cass_uint64_t cass_slow_request_latency(const CassSlowRequest* request) {
+  return request->latency_us;
+}
+
+cass_uint64_t cass_slow_request_queue_time(const CassSlowRequest* request) {
+  return request->queue_time_us;
+}
+
+cass_uint64_t cass_slow_request_write_time(const CassSlowRequest* request) {
+  return request->write_time_us;
+}
+
+cass_uint64_t cass_slow_request_server_time(const CassSlowRequest* request) {
+  return request->server_time_us;
+}
+
+} // extern "C"
+
+static String statement_query(const Statement* statement) {
+  if (statement->opcode() == CQL_OPCODE_EXECUTE) {
+    return static_cast<const ExecuteRequest*>(statement)->prepared()->query();
+  }
+  return statement->query();
+}
+
+String SlowRequest::describe(const Request* request) {
+  String query;
+  switch (request->opcode()) {
+    case CQL_OPCODE_QUERY:
+    case CQL_OPCODE_EXECUTE:
+      query = statement_query(static_cast<const Statement*>(request));
+      break;
+    case CQL_OPCODE_PREPARE:
+      query = static_cast<const PrepareRequest*>(request)->query();
+      break;
+    case CQL_OPCODE_BATCH: {
+      const BatchRequest::StatementVec& statements =
+          static_cast<const BatchRequest*>(request)->statements();
+      query = "BATCH ";
+      for (BatchRequest::StatementVec::const_iterator it = statements.begin(),
+                                                      end = statements.end();
+           it != end && query.size() < MAX_QUERY_LENGTH; ++it) {
+        query.append(statement_query(it->get()));
+        query.append("; ");
+      }
+    } break;
+    default:
+      break;
+  }
+  if (query.size() > MAX_QUERY_LENGTH) {
+    query.resize(MAX_QUERY_LENGTH);
+  }
+  return query;
+}
+
+SlowRequestLog::~SlowRequestLog() {
+  SlowRequest* request;
+  while (requests_.dequeue(request)) {
+    delete request;
+  }
+}
+
+void SlowRequestLog::add(SlowRequest* request) {
+  if (callback_) {
+    callback_(CassSlowRequest::to(request), data_);
+    delete request;
+  } else if (!requests_.enqueue(request)) {
+    dropped_.fetch_add(1, MEMORY_ORDER_RELAXED);
+    delete request;
+  }
+}
+
+SlowRequest* SlowRequestLog::next() {
+  SlowRequest* request;
+  if (requests_.dequeue(request)) {
+    return request;
+  }
+  return NULL;
+}
@@ -0,0 +1,137 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_SLOW_REQUEST_LOG_HPP
+#define DATASTAX_INTERNAL_SLOW_REQUEST_LOG_HPP
+
+#include "address.hpp"
+#include "allocated.hpp"
+#include "atomic.hpp"
+#include "cassandra.h"
+#include "external.hpp"
+#include "mpmc_queue.hpp"
+#include "ref_counted.hpp"
+#include "string.hpp"
+
+namespace datastax { namespace internal { namespace core {
+
+class Request;
+
+/**
+ * A request that took longer than the slow request threshold. The times are
+ * in microseconds. The write and server times are those of the execution
+ * that finished the request.
+ */
+class SlowRequest : public Allocated {
+public:
+  SlowRequest()
+      : error_code(CASS_OK)
+      , latency_us(0)
+      , queue_time_us(0)
+      , write_time_us(0)
+      , server_time_us(0)
+      , retries(0)
+      , speculative_executions(0) {}
+
+  /**
+   * Get a description of a request for the log: the query of a simple
+   * statement or a prepare, the prepared query of a bound statement or the
+   * statements of a batch. Long queries are truncated.
+   *
+   * @param request The request.
+   * @return The description.
+   */
+  static String describe(const Request* request);
+
+  String query;
+  Address coordinator; // Not set if no host responded
+  AddressVec attempted_hosts;
+  CassError error_code;
+  uint64_t latency_us;
+  uint64_t queue_time_us;
+  uint64_t write_time_us;
+  uint64_t server_time_us;
+  unsigned retries;
+  unsigned speculative_executions;
+};
+
+/**
+ * A bounded log of a session's slow requests. The requests are either
+ * passed to a callback, on the I/O thread that finished them, or kept in a
+ * lock-free ring buffer for the application to take. The newest requests are
+ * dropped when the ring buffer is full.
+ */
+class SlowRequestLog : public RefCounted<SlowRequestLog> {
+public:
+  typedef SharedRefPtr<SlowRequestLog> Ptr;
+  typedef void (*Callback)(const CassSlowRequest*, void*);
+
+  /**
+   * Constructor.
+   *
+   * @param threshold_ms The latency above which requests are logged.
+   * @param capacity The number of requests kept (rounded up to a power of 2 of at
+   * least 2).
+   * @param callback A callback for each slow request. This can be NULL to keep
+   * the requests for the application to take.
+   * @param data User data passed to the callback.
+   */
+  SlowRequestLog(uint64_t threshold_ms, size_t capacity, Callback callback, void* data)
+      : threshold_ns_(threshold_ms * 1000LL * 1000LL)
+      , callback_(callback)
+      , data_(data)
+      , requests_(capacity)
+      , dropped_(0) {}
+
+  ~SlowRequestLog();
+
+  uint64_t threshold_ns() const { return threshold_ns_; }
+
+  /**
+   * Add a slow request. This takes ownership of the request.
+   *
+   * @param request The request.
+   */
+  void add(SlowRequest* request);
+
+  /**
+   * Take the oldest slow request. The caller owns the request.
+   *
+   * @return The request or NULL if there are none.
+   */
+  SlowRequest* next();
+
+  /**
+   * The number of slow requests dropped because the log was full.
+   */
+  uint64_t dropped() const { return dropped_.load(MEMORY_ORDER_RELAXED); }
+
+private:
+  const uint64_t threshold_ns_;
+  const Callback callback_;
+  void* const data_;
+  MPMCQueue<SlowRequest*> requests_;
+  Atomic<uint64_t> dropped_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(SlowRequestLog);
+};
+
+}}} // namespace datastax::internal::core
+
+EXTERNAL_TYPE(datastax::internal::core::SlowRequest, CassSlowRequest)
+
+#endif
@@ -17,18 +17,31 @@
 #include "socket.hpp"
 
 #include "logger.hpp"
+#include "small_vector.hpp"
+
+#include <string.h>
+
+#ifdef HAVE_IO_URING
+#include <errno.h>
+#include <limits.h>
+#endif
 
 #define SSL_READ_SIZE 8192
+#define SSL_MAX_READ_SIZE (64 * 1024)
 #define SSL_WRITE_SIZE 8192
 #define SSL_ENCRYPTED_BUFS_COUNT 16
 
-#define MAX_BUFFER_REUSE_NO 8
-#define BUFFER_REUSE_SIZE 64 * 1024
+#define READ_BUFFER_SIZE 64 * 1024
+
+// Buffers smaller than this are copied into the write's staging buffer so
+// that runs of small buffers are written as a single iovec
+#define STAGING_COPY_THRESHOLD 512
+#define STAGING_BUFFER_SIZE (64 * 1024)
 
 using namespace datastax::internal;
 using namespace datastax::internal::core;
 
-typedef Vector<uv_buf_t> UvBufVec;
+typedef SmallVector<uv_buf_t, MIN_BUFFERS_SIZE> UvBufVec;
 
 /**
  * A basic socket write handler.
@@ -36,62 +49,103 @@ typedef Vector<uv_buf_t> UvBufVec;
 class SocketWrite : public SocketWriteBase {
 public:
   SocketWrite(Socket* socket)
-      : SocketWriteBase(socket) {}
+      : SocketWriteBase(socket)
+      , staging_size_(0) {}
 
   size_t flush();
+
+private:
+  void gather(const Buffer& buffer);
+
+private:
+  // Kept with the write so that they're recycled along with the write object
+  // instead of being allocated for every flush
+  UvBufVec bufs_;
+  Vector<char> staging_;
+  size_t staging_size_;
 };
 
 size_t SocketWrite::flush() {
   size_t total = 0;
   if (!is_flushed_ && !buffers_.empty()) {
-    UvBufVec bufs;
+    prepare_flush();
 
-    bufs.reserve(buffers_.size());
+    bufs_.clear();
+    bufs_.reserve(buffers_.size());
+    // The iovecs point into the staging buffer so it's sized up front and
+    // must not be resized while they're gathered
+    size_t staging_needed = 0;
+    for (BufferVec::const_iterator it = buffers_.begin(), end = buffers_.end(); it != end; ++it) {
+      if (it->size() < STAGING_COPY_THRESHOLD) staging_needed += it->size();
+    }
+    if (staging_needed > STAGING_BUFFER_SIZE) staging_needed = STAGING_BUFFER_SIZE;
+    if (staging_.size() < staging_needed) staging_.resize(staging_needed);
+    staging_size_ = 0;
 
     for (BufferVec::const_iterator it = buffers_.begin(), end = buffers_.end(); it != end; ++it) {
       total += it->size();
-      bufs.push_back(uv_buf_init(const_cast<char*>(it->data()), it->size()));
+      gather(*it);
     }
 
     is_flushed_ = true;
-    uv_stream_t* sock_stream = reinterpret_cast<uv_stream_t*>(tcp());
-    uv_write(&req_, sock_stream, bufs.data(), bufs.size(), SocketWrite::on_write);
+    start_write(bufs_.data(), bufs_.size(), SocketWrite::on_write);
   }
   return total;
 }
 
-SocketHandler::~SocketHandler() {
-  while (!buffer_reuse_list_.empty()) {
-    uv_buf_t buf = buffer_reuse_list_.top();
-    Memory::free(buf.base);
-    buffer_reuse_list_.pop();
+void SocketWrite::gather(const Buffer& buffer) {
+  size_t size = buffer.size();
+  if (size == 0) return;
+  if (size < STAGING_COPY_THRESHOLD && staging_size_ + size <= staging_.size()) {
+    char* data = &staging_[0] + staging_size_;
+    memcpy(data, buffer.data(), size);
+    staging_size_ += size;
+    // Extend the previous iovec if it ends where this buffer was copied
+    if (!bufs_.empty() && bufs_.back().base + bufs_.back().len == data) {
+      bufs_.back().len += size;
+      return;
+    }
+    bufs_.push_back(uv_buf_init(data, size));
+  } else {
+    bufs_.push_back(uv_buf_init(const_cast<char*>(buffer.data()), size));
   }
 }
 
+size_t SocketHandlerBase::on_read_buffer(Socket* socket, const RefBuffer::Ptr& buffer,
+                                         const char* data, size_t size) {
+  uv_buf_t buf;
+  alloc_buffer(size, &buf);
+  if (buf.len < size) size = buf.len;
+  memcpy(buf.base, data, size);
+  on_read(socket, static_cast<ssize_t>(size), &buf);
+  return size;
+}
+
+SocketHandler::SocketHandler(const BufferPool::Ptr& buffer_pool)
+    : buffer_pool_(buffer_pool ? buffer_pool : BufferPool::Ptr(new BufferPool())) {}
+
 SocketWriteBase* SocketHandler::new_pending_write(Socket* socket) {
   return new SocketWrite(socket);
 }
 
 void SocketHandler::alloc_buffer(size_t suggested_size, uv_buf_t* buf) {
-  if (suggested_size <= BUFFER_REUSE_SIZE) {
-    if (!buffer_reuse_list_.empty()) {
-      *buf = buffer_reuse_list_.top();
-      buffer_reuse_list_.pop();
-    } else {
-      *buf = uv_buf_init(reinterpret_cast<char*>(Memory::malloc(BUFFER_REUSE_SIZE)),
-                         BUFFER_REUSE_SIZE);
-    }
-  } else {
-    *buf = uv_buf_init(reinterpret_cast<char*>(Memory::malloc(suggested_size)), suggested_size);
-  }
+  size_t size = suggested_size <= READ_BUFFER_SIZE ? READ_BUFFER_SIZE : suggested_size;
+  read_buffer_ = buffer_pool_->acquire(size);
+  *buf = uv_buf_init(read_buffer_->data(), size);
+}
+
+size_t SocketHandler::on_read_buffer(Socket* socket, const RefBuffer::Ptr& buffer,
+                                     const char* data, size_t size) {
+  read_buffer_ = buffer;
+  uv_buf_t buf = uv_buf_init(const_cast<char*>(data), size);
+  on_read(socket, static_cast<ssize_t>(size), &buf);
+  return size;
 }
 
 void SocketHandler::free_buffer(const uv_buf_t* buf) {
-  if (buf->len == BUFFER_REUSE_SIZE && buffer_reuse_list_.size() < MAX_BUFFER_REUSE_NO) {
-    buffer_reuse_list_.push(*buf);
-    return;
-  }
-  Memory::free(buf->base);
+  // Data decoded from the buffer (e.g. a response body) can still reference
+  // it. The pool reuses it once it's no longer referenced.
+  read_buffer_.reset();
 }
 
 /**
@@ -119,6 +173,8 @@ private:
 size_t SslSocketWrite::flush() {
   size_t total = 0;
   if (!is_flushed_ && !buffers_.empty()) {
+    prepare_flush();
+
     rb::RingBuffer::Position prev_pos = ssl_session_->outgoing().write_position();
 
     encrypt();
@@ -128,8 +184,7 @@ size_t SslSocketWrite::flush() {
 
     LOG_TRACE("Sending %u encrypted bytes", static_cast<unsigned int>(encrypted_size_));
 
-    uv_stream_t* sock_stream = reinterpret_cast<uv_stream_t*>(tcp());
-    uv_write(&req_, sock_stream, bufs.data(), bufs.size(), SslSocketWrite::on_write);
+    start_write(bufs.data(), bufs.size(), SslSocketWrite::on_write);
 
     is_flushed_ = true;
   }
@@ -194,7 +249,15 @@ void SslSocketWrite::on_write(uv_write_t* req, int status) {
   SocketWriteBase::on_write(req, status);
 }
 
+SslSocketHandler::SslSocketHandler(SslSession* ssl_session, const BufferPool::Ptr& buffer_pool)
+    : ssl_session_(ssl_session)
+    , buffer_pool_(buffer_pool ? buffer_pool : BufferPool::Ptr(new BufferPool())) {}
+
 SocketWriteBase* SslSocketHandler::new_pending_write(Socket* socket) {
+  // The kernel encrypts the writes so they're written as is
+  if (ssl_session_->is_kernel_tls_tx()) {
+    return new SocketWrite(socket);
+  }
   return new SslSocketWrite(socket, ssl_session_.get());
 }
 
@@ -206,11 +269,32 @@ void SslSocketHandler::alloc_buffer(size_t suggested_size, uv_buf_t* buf) {
 void SslSocketHandler::on_read(Socket* socket, ssize_t nread, const uv_buf_t* buf) {
   if (nread < 0) return;
 
-  ssl_session_->incoming().commit(nread);
-  char decrypted[SSL_READ_SIZE];
-  int rc = 0;
-  while ((rc = ssl_session_->decrypt(decrypted, sizeof(decrypted))) > 0) {
-    on_ssl_read(socket, decrypted, rc);
+  rb::RingBuffer& incoming = ssl_session_->incoming();
+  incoming.commit(nread);
+
+  int rc = 1;
+  while (rc > 0) {
+    // The decrypted data is never larger than the encrypted data so all the
+    // pending records are decrypted into a single ref-counted buffer. A
+    // response whose body is entirely in the buffer references it instead of
+    // copying the body.
+    size_t capacity = incoming.length();
+    if (capacity < SSL_READ_SIZE) {
+      capacity = SSL_READ_SIZE;
+    } else if (capacity > SSL_MAX_READ_SIZE) {
+      capacity = SSL_MAX_READ_SIZE;
+    }
+    read_buffer_ = buffer_pool_->acquire(capacity);
+
+    size_t size = 0;
+    while (size < capacity &&
+           (rc = ssl_session_->decrypt(read_buffer_->data() + size, capacity - size)) > 0) {
+      size += rc;
+    }
+    if (size > 0) {
+      on_ssl_read(socket, read_buffer_->data(), size);
+    }
+    read_buffer_.reset();
   }
   if (rc <= 0 && ssl_session_->has_error()) {
     if (ssl_session_->error_code() == CASS_ERROR_SSL_CLOSED) {
@@ -220,6 +304,11 @@ void SslSocketHandler::on_read(Socket* socket, ssize_t nread, const uv_buf_t* bu
       LOG_ERROR("Unable to decrypt data: %s", ssl_session_->error_message().c_str());
       socket->defunct();
     }
+  } else if (ssl_session_->is_kernel_tls_tx() && ssl_session_->outgoing().length() > 0) {
+    // The SSL library's records (e.g. alerts or a renegotiation) can't be
+    // sent because its sequence numbers no longer match the kernel's
+    LOG_ERROR("Unable to send SSL protocol data when the kernel encrypts writes");
+    socket->defunct();
   }
 }
 
@@ -240,10 +329,55 @@ int32_t SocketWriteBase::write(SocketRequest* request) {
   }
 
   requests_.push_back(request);
+  sizes_.push_back(request_size);
+  size_ += request_size;
+  socket_->outstanding_write_bytes_ += request_size;
 
   return request_size;
 }
 
+void SocketWriteBase::prepare_flush() {
+  if (socket_->handler_) {
+    socket_->handler_->on_flush(socket_, sizes_, &buffers_);
+  }
+}
+
+void SocketWriteBase::start_write(const uv_buf_t* bufs, size_t count, uv_write_cb cb) {
+#ifdef HAVE_IO_URING
+  if (socket_->io_uring_ != NULL) {
+    uring_bufs_.assign(bufs, bufs + count);
+    uring_offset_ = 0;
+    uring_cb_ = cb;
+    socket_->queue_uring_write(this);
+    return;
+  }
+#endif
+  uv_write(&req_, reinterpret_cast<uv_stream_t*>(tcp()), bufs, count, cb);
+}
+
+#ifdef HAVE_IO_URING
+size_t SocketWriteBase::uring_size() const {
+  size_t size = 0;
+  for (size_t i = uring_offset_; i < uring_bufs_.size(); ++i) {
+    size += uring_bufs_[i].len;
+  }
+  return size;
+}
+
+void SocketWriteBase::uring_advance(size_t size) {
+  while (size > 0 && uring_offset_ < uring_bufs_.size()) {
+    uv_buf_t& buf = uring_bufs_[uring_offset_];
+    if (size < buf.len) {
+      buf.base += size;
+      buf.len -= size;
+      return;
+    }
+    size -= buf.len;
+    ++uring_offset_;
+  }
+}
+#endif
+
 void SocketWriteBase::on_write(uv_write_t* req, int status) {
   SocketWriteBase* pending_write = static_cast<SocketWriteBase*>(req->data);
   pending_write->handle_write(req, status);
@@ -259,6 +393,12 @@ void SocketWriteBase::handle_write(uv_write_t* req, int status) {
     }
   }
 
+  socket->outstanding_write_bytes_ -= size_;
+
+  // The handler can be changed by the write callbacks (e.g. when the write
+  // finishes the SSL handshake)
+  unsigned handler_version = socket->handler_version_;
+
   if (socket->handler_) {
     for (RequestVec::iterator i = requests_.begin(), end = requests_.end(); i != end; ++i) {
       socket->handler_->on_write(socket, status, *i);
@@ -267,7 +407,8 @@ void SocketWriteBase::handle_write(uv_write_t* req, int status) {
 
   socket->pending_writes_.remove(this);
 
-  if (socket->free_writes_.size() < socket->max_reusable_write_objects_) {
+  if (socket->handler_version_ == handler_version &&
+      socket->free_writes_.size() < socket->max_reusable_write_objects_) {
     clear();
     socket->free_writes_.push_back(this);
   } else {
@@ -278,9 +419,21 @@ void SocketWriteBase::handle_write(uv_write_t* req, int status) {
 }
 
 Socket::Socket(const Address& address, size_t max_reusable_write_objects)
-    : is_defunct_(false)
+    : handler_version_(0)
+    , outstanding_write_bytes_(0)
+    , is_defunct_(false)
     , max_reusable_write_objects_(max_reusable_write_objects)
-    , address_(address) {
+    , address_(address)
+#ifdef HAVE_IO_URING
+    , io_uring_(NULL)
+    , uring_recv_(this)
+    , uring_send_(this)
+    , is_uring_recv_active_(false)
+    , is_uring_send_active_(false)
+    , is_uring_closing_(false)
+    , uring_queued_bytes_(0)
+#endif
+{
   tcp_.data = this;
 }
 
@@ -288,8 +441,24 @@ Socket::~Socket() { cleanup_free_writes(); }
 
 void Socket::set_handler(SocketHandlerBase* handler) {
   handler_.reset(handler);
+  ++handler_version_;
   cleanup_free_writes();
   free_writes_.clear();
+#ifdef HAVE_IO_URING
+  if (io_uring_ != NULL) {
+    // The receive isn't stopped when there's no handler, the reads are kept
+    // for the next handler
+    if (handler_) {
+      UringReadVec reads;
+      reads.swap(uring_reads_);
+      for (UringReadVec::const_iterator it = reads.begin(), end = reads.end(); it != end; ++it) {
+        handle_uring_read(it->result, it->buffer, it->data);
+      }
+      start_uring_recv();
+    }
+    return;
+  }
+#endif
   if (handler_) {
     uv_read_start(reinterpret_cast<uv_stream_t*>(&tcp_), Socket::alloc_buffer, Socket::on_read);
   } else {
@@ -333,12 +502,21 @@ size_t Socket::flush() {
 }
 
 bool Socket::is_closing() const {
+#ifdef HAVE_IO_URING
+  if (is_uring_closing_) return true;
+#endif
   return uv_is_closing(reinterpret_cast<const uv_handle_t*>(&tcp_)) != 0;
 }
 
 void Socket::close() {
   uv_handle_t* handle = reinterpret_cast<uv_handle_t*>(&tcp_);
   if (!uv_is_closing(handle)) {
+#ifdef HAVE_IO_URING
+    if (io_uring_ != NULL) {
+      close_uring();
+      return;
+    }
+#endif
     uv_close(handle, on_close);
   }
 }
@@ -381,6 +559,7 @@ void Socket::handle_close() {
     pending_write->on_close();
     delete pending_write;
   }
+  outstanding_write_bytes_ = 0;
 
   if (handler_) {
     handler_->on_close();
@@ -393,3 +572,168 @@ void Socket::cleanup_free_writes() {
     delete *i;
   }
 }
+
+#ifdef HAVE_IO_URING
+void Socket::start_uring_recv() {
+  if (is_uring_recv_active_ || is_closing()) return;
+  uv_os_fd_t fd = 0;
+  if (uv_fileno(reinterpret_cast<uv_handle_t*>(&tcp_), &fd) != 0 ||
+      !io_uring_->recv_multishot(fd, &uring_recv_)) {
+    LOG_ERROR("Unable to start an io_uring receive for host %s", address_.to_string().c_str());
+    defunct();
+    return;
+  }
+  is_uring_recv_active_ = true;
+}
+
+void Socket::handle_uring_recv(int result, unsigned flags) {
+  if (!(flags & IORING_CQE_F_MORE)) {
+    is_uring_recv_active_ = false;
+  }
+
+  RefBuffer::Ptr buffer;
+  if (flags & IORING_CQE_F_BUFFER) {
+    buffer = io_uring_->take_buffer(flags);
+  }
+
+  if (is_uring_closing_) {
+    maybe_finish_uring_close();
+    return;
+  }
+
+  if (result == -ENOBUFS) {
+    // All the registered buffers were in use. They've been replaced by the time
+    // the receive is resubmitted.
+    start_uring_recv();
+    return;
+  }
+
+  if (result == 0) result = UV_EOF;
+  if (handler_) {
+    handle_uring_read(result, buffer, buffer ? buffer->data() : NULL);
+  } else {
+    UringRead read;
+    read.result = result;
+    read.buffer = buffer;
+    read.data = buffer ? buffer->data() : NULL;
+    uring_reads_.push_back(read);
+  }
+
+  if (result > 0) {
+    // The kernel can end a multishot receive at any time
+    start_uring_recv();
+  }
+}
+
+void Socket::handle_uring_read(int result, const RefBuffer::Ptr& buffer, const char* data) {
+  if (result < 0) {
+    // The error codes are the same as libuv's (negated errno values)
+    uv_buf_t buf = uv_buf_init(NULL, 0);
+    handle_read(result, &buf);
+    return;
+  }
+
+  // The handler can change, or close the socket, while handling the data
+  size_t size = result;
+  while (size > 0 && !is_closing()) {
+    if (!handler_) {
+      UringRead read;
+      read.result = static_cast<int>(size);
+      read.buffer = buffer;
+      read.data = data;
+      uring_reads_.push_back(read);
+      return;
+    }
+    size_t handled = handler_->on_read_buffer(this, buffer, data, size);
+    data += handled;
+    size -= handled;
+  }
+}
+
+void Socket::queue_uring_write(SocketWriteBase* socket_write) {
+  // The write is closed along with the other pending writes
+  if (is_closing()) return;
+  uring_writes_.push_back(socket_write);
+  if (uring_writes_.size() == 1) {
+    start_uring_send();
+  } else {
+    uring_queued_bytes_ += socket_write->uring_size();
+  }
+}
+
+void Socket::start_uring_send() {
+  SocketWriteBase* socket_write = uring_writes_.front();
+  size_t count = socket_write->uring_bufs_.size() - socket_write->uring_offset_;
+  memset(&uring_msg_, 0, sizeof(uring_msg_));
+  // The buffers have the same layout as iovecs. Writes with more buffers than
+  // a single send allows are sent using several sends.
+  uring_msg_.msg_iov = reinterpret_cast<struct iovec*>(
+      socket_write->uring_bufs_.data() + socket_write->uring_offset_);
+  uring_msg_.msg_iovlen = count < IOV_MAX ? count : IOV_MAX;
+
+  uv_os_fd_t fd = 0;
+  if (uv_fileno(reinterpret_cast<uv_handle_t*>(&tcp_), &fd) != 0 ||
+      !io_uring_->sendmsg(fd, &uring_msg_, &uring_send_)) {
+    LOG_ERROR("Unable to start an io_uring send for host %s", address_.to_string().c_str());
+    defunct();
+    return;
+  }
+  is_uring_send_active_ = true;
+}
+
+void Socket::handle_uring_send(int result) {
+  is_uring_send_active_ = false;
+
+  if (is_uring_closing_) {
+    maybe_finish_uring_close();
+    return;
+  }
+
+  SocketWriteBase* socket_write = uring_writes_.front();
+  int status = result < 0 ? result : 0;
+  if (result > 0) {
+    socket_write->uring_advance(result);
+    if (socket_write->uring_offset_ < socket_write->uring_bufs_.size()) {
+      start_uring_send(); // Send the rest
+      return;
+    }
+  }
+
+  uring_writes_.pop_front();
+  if (!uring_writes_.empty()) {
+    uring_queued_bytes_ -= uring_writes_.front()->uring_size();
+    start_uring_send();
+  }
+
+  socket_write->uring_cb_(&socket_write->req_, status);
+}
+
+void Socket::close_uring() {
+  if (is_uring_closing_) return;
+  is_uring_closing_ = true;
+
+  // The socket can't be closed while the io_uring is using it. If an operation
+  // can't be canceled then shutting down the socket completes it.
+  bool is_canceled = (!is_uring_recv_active_ || io_uring_->cancel(&uring_recv_)) &&
+                     (!is_uring_send_active_ || io_uring_->cancel(&uring_send_));
+  if (!is_canceled) {
+    uv_os_fd_t fd = 0;
+    if (uv_fileno(reinterpret_cast<uv_handle_t*>(&tcp_), &fd) == 0) {
+      shutdown(fd, SHUT_RDWR);
+    }
+  }
+
+  maybe_finish_uring_close();
+}
+
+void Socket::maybe_finish_uring_close() {
+  if (is_uring_recv_active_ || is_uring_send_active_) return;
+  uring_writes_.clear();
+  uring_queued_bytes_ = 0;
+  uring_reads_.clear();
+  uv_handle_t* handle = reinterpret_cast<uv_handle_t*>(&tcp_);
+  if (!uv_is_closing(handle)) {
+    uv_close(handle, on_close);
+  }
+}
+#endif
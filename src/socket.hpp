@@ -19,11 +19,14 @@
 
 #include "allocated.hpp"
 #include "buffer.hpp"
+#include "buffer_pool.hpp"
 #include "constants.hpp"
+#include "deque.hpp"
+#include "driver_config.hpp"
+#include "io_uring.hpp"
 #include "list.hpp"
 #include "scoped_ptr.hpp"
 #include "ssl.hpp"
-#include "stack.hpp"
 #include "tcp_connector.hpp"
 #include "timer.hpp"
 
@@ -124,6 +127,21 @@ public:
    */
   virtual void on_read(Socket* socket, ssize_t nread, const uv_buf_t* buf) = 0;
 
+  /**
+   * A callback for handling data that was read into a buffer that wasn't
+   * allocated by the handler e.g. an io_uring's registered buffer. By default,
+   * the data is copied into a buffer from alloc_buffer() and passed to
+   * on_read(). The socket calls this again for the data that isn't handled.
+   *
+   * @param socket The socket receiving the read.
+   * @param buffer The buffer holding the data.
+   * @param data The data in the buffer.
+   * @param size The size of the data.
+   * @return The number of bytes handled.
+   */
+  virtual size_t on_read_buffer(Socket* socket, const RefBuffer::Ptr& buffer, const char* data,
+                                size_t size);
+
   /**
    * A callback for handling a socket write.
    *
@@ -133,6 +151,17 @@ public:
    */
   virtual void on_write(Socket* socket, int status, SocketRequest* request) = 0;
 
+  /**
+   * A callback for transforming the encoded requests of a write before
+   * they're flushed to the socket e.g. to apply protocol framing. The default
+   * leaves the buffers unchanged.
+   *
+   * @param socket The socket flushing the write.
+   * @param sizes The encoded size of each request in the write.
+   * @param bufs The encoded requests. These can be replaced.
+   */
+  virtual void on_flush(Socket* socket, const SizeVec& sizes, BufferVec* bufs) {}
+
   /**
    * A callback for handling the socket close.
    */
@@ -140,15 +169,31 @@ public:
 };
 
 /**
- * A basic socket handler that caches buffers used for reading socket data.
+ * A basic socket handler that draws the buffers used for reading socket data
+ * from a buffer pool. The read buffers are ref-counted so that decoded data
+ * can reference them directly instead of copying. A buffer is only reused if
+ * nothing else references it.
  */
 class SocketHandler : public SocketHandlerBase {
 public:
-  ~SocketHandler();
+  /**
+   * Constructor
+   *
+   * @param buffer_pool The pool used to allocate read buffers. If not
+   * provided, the handler uses its own pool.
+   */
+  SocketHandler(const BufferPool::Ptr& buffer_pool = BufferPool::Ptr());
 
   virtual SocketWriteBase* new_pending_write(Socket* socket);
   virtual void alloc_buffer(size_t suggested_size, uv_buf_t* buf);
 
+  /**
+   * The data is passed to on_read() as is, without copying. The buffer becomes
+   * the current read buffer.
+   */
+  virtual size_t on_read_buffer(Socket* socket, const RefBuffer::Ptr& buffer, const char* data,
+                                size_t size);
+
   /**
    * Free or cache a read buffer.
    * @param buf The buffer to free or cache. The buffer was created in
@@ -156,8 +201,17 @@ public:
    */
   void free_buffer(const uv_buf_t* buf);
 
+  /**
+   * The ref-counted buffer backing the current read. This is only valid
+   * between alloc_buffer() and free_buffer().
+   *
+   * @return The current read buffer.
+   */
+  RefBuffer* read_buffer() const { return read_buffer_.get(); }
+
 private:
-  Stack<uv_buf_t> buffer_reuse_list_;
+  BufferPool::Ptr buffer_pool_;
+  RefBuffer::Ptr read_buffer_;
 };
 
 /**
@@ -169,9 +223,11 @@ public:
    * Constructor
    *
    * @param ssl_session A SSL session used to encrypt/decrypt data.
+   * @param buffer_pool The pool used to allocate the buffers that data is
+   * decrypted into. If not provided, the handler uses its own pool.
    */
-  SslSocketHandler(SslSession* ssl_session)
-      : ssl_session_(ssl_session) {}
+  SslSocketHandler(SslSession* ssl_session,
+                   const BufferPool::Ptr& buffer_pool = BufferPool::Ptr());
 
   virtual SocketWriteBase* new_pending_write(Socket* socket);
   virtual void alloc_buffer(size_t suggested_size, uv_buf_t* buf);
@@ -187,8 +243,18 @@ public:
    */
   virtual void on_ssl_read(Socket* socket, char* buf, size_t size) = 0;
 
+  /**
+   * The ref-counted buffer backing the decrypted data. This is only valid
+   * during on_ssl_read().
+   *
+   * @return The current decrypted buffer.
+   */
+  RefBuffer* read_buffer() const { return read_buffer_.get(); }
+
 private:
   ScopedPtr<SslSession> ssl_session_;
+  BufferPool::Ptr buffer_pool_;
+  RefBuffer::Ptr read_buffer_;
 };
 
 /**
@@ -208,9 +274,14 @@ public:
    */
   SocketWriteBase(Socket* socket)
       : socket_(socket)
-      , is_flushed_(false) {
+      , is_flushed_(false)
+      , size_(0) {
     req_.data = this;
     buffers_.reserve(MIN_BUFFERS_SIZE);
+#ifdef HAVE_IO_URING
+    uring_offset_ = 0;
+    uring_cb_ = NULL;
+#endif
   }
 
   virtual ~SocketWriteBase() {}
@@ -229,7 +300,9 @@ public:
    */
   void clear() {
     buffers_.clear();
+    sizes_.clear();
     requests_.clear();
+    size_ = 0;
     is_flushed_ = false;
   }
 
@@ -255,13 +328,42 @@ protected:
   static void on_write(uv_write_t* req, int status);
   void handle_write(uv_write_t* req, int status);
 
+  /**
+   * Write buffers to the socket, using the socket's io_uring if it has one.
+   *
+   * @param bufs The buffers to write. They're copied.
+   * @param count The number of buffers.
+   * @param cb The callback called when the buffers are written.
+   */
+  void start_write(const uv_buf_t* bufs, size_t count, uv_write_cb cb);
+
+  /**
+   * Allow the socket's handler to transform the buffers before they're
+   * flushed.
+   */
+  void prepare_flush();
+
   typedef Vector<SocketRequest*> RequestVec;
 
   Socket* socket_;
   uv_write_t req_;
   bool is_flushed_;
   BufferVec buffers_;
+  SizeVec sizes_;
   RequestVec requests_;
+  size_t size_; // The number of bytes written by the requests
+
+#ifdef HAVE_IO_URING
+private:
+  friend class Socket;
+
+  size_t uring_size() const;
+  void uring_advance(size_t size);
+
+  Vector<uv_buf_t> uring_bufs_;
+  size_t uring_offset_;
+  uv_write_cb uring_cb_;
+#endif
 };
 
 /**
@@ -340,6 +442,28 @@ public:
    */
   bool is_defunct() const { return is_defunct_; }
 
+  /**
+   * Get the number of bytes queued in the socket by writes that couldn't be
+   * completed immediately.
+   *
+   * @return The number of queued bytes.
+   */
+  size_t write_queue_size() const {
+#ifdef HAVE_IO_URING
+    if (io_uring_ != NULL) return uring_queued_bytes_;
+#endif
+    return tcp_.write_queue_size;
+  }
+
+  /**
+   * Get the number of bytes written by requests that haven't finished being
+   * written to the network. This includes the requests that haven't been
+   * flushed yet.
+   *
+   * @return The number of outstanding bytes.
+   */
+  size_t outstanding_write_bytes() const { return outstanding_write_bytes_; }
+
   /**
    * Mark as defunct and close the socket.
    */
@@ -362,19 +486,80 @@ private:
 
   void cleanup_free_writes();
 
+#ifdef HAVE_IO_URING
+  class UringRecv : public IoUring::Operation {
+  public:
+    UringRecv(Socket* socket)
+        : socket_(socket) {}
+    virtual void on_complete(int result, unsigned flags) {
+      socket_->handle_uring_recv(result, flags);
+    }
+
+  private:
+    Socket* socket_;
+  };
+
+  class UringSend : public IoUring::Operation {
+  public:
+    UringSend(Socket* socket)
+        : socket_(socket) {}
+    virtual void on_complete(int result, unsigned flags) { socket_->handle_uring_send(result); }
+
+  private:
+    Socket* socket_;
+  };
+
+  void start_uring_recv();
+  void handle_uring_recv(int result, unsigned flags);
+  void handle_uring_read(int result, const RefBuffer::Ptr& buffer, const char* data);
+
+  void queue_uring_write(SocketWriteBase* socket_write);
+  void start_uring_send();
+  void handle_uring_send(int result);
+
+  void close_uring();
+  void maybe_finish_uring_close();
+#endif
+
 private:
   typedef Vector<SocketWriteBase*> SocketWriteVec;
 
   uv_tcp_t tcp_;
   ScopedPtr<SocketHandlerBase> handler_;
+  // Incremented when the handler changes so that in-flight writes, created
+  // by the previous handler, aren't reused
+  unsigned handler_version_;
 
   SocketWriteBase::List pending_writes_;
   SocketWriteVec free_writes_;
+  size_t outstanding_write_bytes_;
 
   bool is_defunct_;
   size_t max_reusable_write_objects_;
 
   Address address_;
+
+#ifdef HAVE_IO_URING
+  struct UringRead {
+    int result;
+    RefBuffer::Ptr buffer;
+    const char* data;
+  };
+  typedef Vector<UringRead> UringReadVec;
+
+  IoUring* io_uring_;
+  UringRecv uring_recv_;
+  UringSend uring_send_;
+  bool is_uring_recv_active_;
+  bool is_uring_send_active_;
+  bool is_uring_closing_;
+  // The writes waiting to be sent, the front write is being sent
+  Deque<SocketWriteBase*> uring_writes_;
+  size_t uring_queued_bytes_;
+  struct msghdr uring_msg_;
+  // Reads received while the socket doesn't have a handler
+  UringReadVec uring_reads_;
+#endif
 };
 
 }}} // namespace datastax::internal::core
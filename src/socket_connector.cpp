@@ -19,8 +19,16 @@
 #include "config.hpp"
 #include "logger.hpp"
 
+#ifdef HAVE_TCP_NOTSENT_LOWAT
+#include <netinet/tcp.h>
+#endif
+
 #define SSL_HANDSHAKE_MAX_BUFFER_SIZE (16 * 1024 + 5)
 
+// The delay before a connection that's waiting for the other handshakes with
+// its endpoint tries to start its handshake again
+#define SSL_HANDSHAKE_WAIT_MS 5
+
 using namespace datastax;
 using namespace datastax::internal;
 using namespace datastax::internal::core;
@@ -54,6 +62,12 @@ public:
     buf->len = suggested_size;
   }
 
+  virtual size_t on_read_buffer(Socket* socket, const RefBuffer::Ptr& buffer, const char* data,
+                                size_t size) {
+    // Copy the data into the SSL session's buffers
+    return SocketHandlerBase::on_read_buffer(socket, buffer, data, size);
+  }
+
   virtual void on_read(Socket* socket, ssize_t nread, const uv_buf_t* buf) {
     if (nread > 0) {
       connector_->ssl_session_->incoming().commit(nread);
@@ -65,6 +79,10 @@ public:
     delete request;
     if (status != 0) {
       connector_->on_error(SocketConnector::SOCKET_ERROR_WRITE, "Write error");
+    } else if (connector_->ssl_session_->is_handshake_done()) {
+      // The client sends the last message of a resumed session's handshake so
+      // finish once it's written
+      connector_->ssl_handshake();
     }
   }
 
@@ -88,31 +106,60 @@ SocketSettings::SocketSettings()
     , tcp_nodelay_enabled(CASS_DEFAULT_TCP_NO_DELAY_ENABLED)
     , tcp_keepalive_enabled(CASS_DEFAULT_TCP_KEEPALIVE_ENABLED)
     , tcp_keepalive_delay_secs(CASS_DEFAULT_TCP_KEEPALIVE_DELAY_SECS)
-    , max_reusable_write_objects(CASS_DEFAULT_MAX_REUSABLE_WRITE_OBJECTS) {}
+    , receive_buffer_size(CASS_DEFAULT_SOCKET_RECEIVE_BUFFER_SIZE)
+    , send_buffer_size(CASS_DEFAULT_SOCKET_SEND_BUFFER_SIZE)
+    , tcp_notsent_lowat(CASS_DEFAULT_TCP_NOTSENT_LOWAT)
+    , max_reusable_write_objects(CASS_DEFAULT_MAX_REUSABLE_WRITE_OBJECTS)
+    , busy_poll_us(CASS_DEFAULT_SOCKET_BUSY_POLL_US)
+    , io_uring_enabled(CASS_DEFAULT_IO_URING_ENABLED)
+#ifdef HAVE_IO_URING
+    , io_uring(NULL)
+#endif
+{
+}
 
 SocketSettings::SocketSettings(const Config& config)
     : hostname_resolution_enabled(config.use_hostname_resolution())
     , resolve_timeout_ms(config.resolve_timeout_ms())
+    , resolver_cache(config.resolver_cache())
     , ssl_context(config.ssl_context())
     , tcp_nodelay_enabled(config.tcp_nodelay_enable())
     , tcp_keepalive_enabled(config.tcp_keepalive_enable())
     , tcp_keepalive_delay_secs(config.tcp_keepalive_delay_secs())
+    , receive_buffer_size(config.socket_receive_buffer_size())
+    , send_buffer_size(config.socket_send_buffer_size())
+    , tcp_notsent_lowat(config.tcp_notsent_lowat())
     , max_reusable_write_objects(config.max_reusable_write_objects())
-    , local_address(config.local_address()) {}
+    , local_addresses(config.local_addresses())
+    , busy_poll_us(config.busy_poll() ? config.socket_busy_poll_us() : 0)
+    , io_uring_enabled(config.io_uring_enabled())
+#ifdef HAVE_IO_URING
+    , io_uring(NULL)
+#endif
+{
+}
 
 Atomic<size_t> SocketConnector::resolved_address_offset_(0);
+Atomic<size_t> SocketConnector::local_address_offset_(0);
 
 SocketConnector::SocketConnector(const Address& address, const Callback& callback)
     : address_(address)
     , callback_(callback)
+    , is_handshake_started_(false)
     , error_code_(SOCKET_OK)
-    , ssl_error_code_(CASS_OK) {}
+    , ssl_error_code_(CASS_OK)
+    , local_port_(0) {}
 
 SocketConnector* SocketConnector::with_settings(const SocketSettings& settings) {
   settings_ = settings;
   return this;
 }
 
+SocketConnector* SocketConnector::with_local_port(int local_port) {
+  local_port_ = local_port;
+  return this;
+}
+
 void SocketConnector::connect(uv_loop_t* loop) {
   inc_ref(); // For the event loop
 
@@ -120,14 +167,16 @@ void SocketConnector::connect(uv_loop_t* loop) {
     hostname_ = address_.hostname_or_address();
 
     resolver_.reset(new Resolver(hostname_, address_.port(),
-                                 bind_callback(&SocketConnector::on_resolve, this)));
+                                 bind_callback(&SocketConnector::on_resolve, this),
+                                 settings_.resolver_cache));
     resolver_->resolve(loop, settings_.resolve_timeout_ms);
   } else {
     resolved_address_ = address_;
 
     if (settings_.hostname_resolution_enabled) { // Run hostname resolution then connect.
-      name_resolver_.reset(
-          new NameResolver(address_, bind_callback(&SocketConnector::on_name_resolve, this)));
+      name_resolver_.reset(new NameResolver(address_,
+                                            bind_callback(&SocketConnector::on_name_resolve, this),
+                                            settings_.resolver_cache));
       name_resolver_->resolve(loop, settings_.resolve_timeout_ms);
     } else {
       // Postpone the connection process until after this method ends because it
@@ -155,18 +204,45 @@ Socket::Ptr SocketConnector::release_socket() {
 }
 
 void SocketConnector::internal_connect(uv_loop_t* loop) {
+  if (settings_.ssl_context && !is_handshake_started_) {
+    if (!settings_.ssl_context->try_start_handshake(resolved_address_)) {
+      // Wait for the other handshakes with the endpoint so that this
+      // connection can resume one of their sessions
+      handshake_wait_timer_.start(loop, SSL_HANDSHAKE_WAIT_MS,
+                                  bind_callback(&SocketConnector::on_handshake_wait, this));
+      return;
+    }
+    is_handshake_started_ = true;
+  }
+
   Socket::Ptr socket(new Socket(resolved_address_, settings_.max_reusable_write_objects));
 
-  if (uv_tcp_init(loop, socket->handle()) != 0) {
+  // The socket buffers are sized before connecting so that the TCP window
+  // scale accounts for them, which requires creating the socket right away
+  unsigned int flags = AF_UNSPEC;
+  if (settings_.receive_buffer_size > 0 || settings_.send_buffer_size > 0) {
+    flags = resolved_address_.family() == Address::IPv6 ? AF_INET6 : AF_INET;
+  }
+
+  if (uv_tcp_init_ex(loop, socket->handle(), flags) != 0) {
     on_error(SOCKET_ERROR_INIT, "Unable to initialize TCP object");
     return;
   }
 
   socket_ = socket;
   socket_->inc_ref(); // For the event loop
+#ifdef HAVE_IO_URING
+  socket_->io_uring_ = settings_.io_uring;
+#endif
 
   // This needs to be done after setting the socket to properly cleanup.
-  const Address& local_address = settings_.local_address;
+  Address local_address = select_local_address();
+  if (local_port_ > 0) {
+    String host = local_address.is_valid()
+                      ? local_address.hostname_or_address()
+                      : (resolved_address_.family() == Address::IPv6 ? "::" : "0.0.0.0");
+    local_address = Address(host, local_port_);
+  }
   if (local_address.is_valid()) {
     Address::SocketStorage storage;
     int rc = uv_tcp_bind(socket->handle(), local_address.to_sockaddr(&storage), 0);
@@ -186,15 +262,48 @@ void SocketConnector::internal_connect(uv_loop_t* loop) {
     LOG_WARN("Unable to set tcp keepalive");
   }
 
+  if (settings_.receive_buffer_size > 0) {
+    int size = static_cast<int>(settings_.receive_buffer_size);
+    if (uv_recv_buffer_size(reinterpret_cast<uv_handle_t*>(socket_->handle()), &size) != 0) {
+      LOG_WARN("Unable to set socket option SO_RCVBUF for host %s", address_.to_string().c_str());
+    }
+  }
+
+  if (settings_.send_buffer_size > 0) {
+    int size = static_cast<int>(settings_.send_buffer_size);
+    if (uv_send_buffer_size(reinterpret_cast<uv_handle_t*>(socket_->handle()), &size) != 0) {
+      LOG_WARN("Unable to set socket option SO_SNDBUF for host %s", address_.to_string().c_str());
+    }
+  }
+
   if (settings_.ssl_context) {
-    ssl_session_.reset(settings_.ssl_context->create_session(resolved_address_, hostname_,
-                                                             address_.server_name()));
+    ssl_session_.reset(settings_.ssl_context->create_session(
+        resolved_address_, hostname_, address_.server_name(), settings_.ssl_chunk_pool));
   }
 
   connector_.reset(new TcpConnector(resolved_address_));
   connector_->connect(socket_->handle(), bind_callback(&SocketConnector::on_connect, this));
 }
 
+Address SocketConnector::select_local_address() const {
+  const AddressVec& addresses = settings_.local_addresses;
+  if (addresses.empty()) return Address();
+  if (addresses.size() == 1) return addresses.front();
+
+  // Spread the connections across the addresses that can reach the host
+  size_t count = 0;
+  for (AddressVec::const_iterator it = addresses.begin(), end = addresses.end(); it != end; ++it) {
+    if (it->family() == resolved_address_.family()) ++count;
+  }
+  if (count == 0) return addresses.front(); // Fails to connect, as if it were the only one
+
+  size_t index = local_address_offset_.fetch_add(1, MEMORY_ORDER_RELAXED) % count;
+  for (AddressVec::const_iterator it = addresses.begin(), end = addresses.end(); it != end; ++it) {
+    if (it->family() == resolved_address_.family() && index-- == 0) return *it;
+  }
+  return Address();
+}
+
 void SocketConnector::ssl_handshake() {
   // Run the handshake process if not done which might create outgoing data
   // which is handled below.
@@ -220,16 +329,35 @@ void SocketConnector::ssl_handshake() {
                "Error verifying peer certificate: " + ssl_session_->error_message());
       return;
     }
+    if (settings_.ssl_context->is_kernel_tls_enabled()) {
+      enable_kernel_tls();
+    }
     finish();
   }
 }
 
+void SocketConnector::enable_kernel_tls() {
+  uv_os_fd_t fd = 0;
+  if (uv_fileno(reinterpret_cast<uv_handle_t*>(socket_->handle()), &fd) == 0 &&
+      ssl_session_->enable_kernel_tls(fd)) {
+    LOG_DEBUG("Enabled kernel TLS for host %s", address_.to_string().c_str());
+  } else {
+    LOG_DEBUG("Unable to enable kernel TLS for host %s. Encrypting in the driver instead",
+              address_.to_string().c_str());
+  }
+}
+
 void SocketConnector::finish() {
+  if (is_handshake_started_) {
+    settings_.ssl_context->finish_handshake(resolved_address_);
+    is_handshake_started_ = false;
+  }
   if (socket_) socket_->set_handler(NULL);
   callback_(this);
   // If the socket hasn't been released then close it.
   if (socket_) socket_->close();
   no_resolve_timer_.stop();
+  handshake_wait_timer_.stop();
   dec_ref();
 }
 
@@ -267,6 +395,30 @@ void SocketConnector::on_connect(TcpConnector* tcp_connector) {
     }
 #endif
 
+#ifdef HAVE_SO_BUSY_POLL
+    if (settings_.busy_poll_us > 0) {
+      uv_os_fd_t fd = 0;
+      int busy_poll_us = static_cast<int>(settings_.busy_poll_us);
+      if (uv_fileno(reinterpret_cast<uv_handle_t*>(socket_->handle()), &fd) != 0 ||
+          setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &busy_poll_us, sizeof(int)) != 0) {
+        LOG_WARN("Unable to set socket option SO_BUSY_POLL for host %s",
+                 address_.to_string().c_str());
+      }
+    }
+#endif
+
+#ifdef HAVE_TCP_NOTSENT_LOWAT
+    if (settings_.tcp_notsent_lowat > 0) {
+      uv_os_fd_t fd = 0;
+      int lowat = static_cast<int>(settings_.tcp_notsent_lowat);
+      if (uv_fileno(reinterpret_cast<uv_handle_t*>(socket_->handle()), &fd) != 0 ||
+          setsockopt(fd, IPPROTO_TCP, TCP_NOTSENT_LOWAT, &lowat, sizeof(int)) != 0) {
+        LOG_WARN("Unable to set socket option TCP_NOTSENT_LOWAT for host %s",
+                 address_.to_string().c_str());
+      }
+    }
+#endif
+
     if (ssl_session_) {
       socket_->set_handler(new SslHandshakeHandler(this));
       ssl_handshake();
@@ -284,8 +436,8 @@ void SocketConnector::on_connect(TcpConnector* tcp_connector) {
 void SocketConnector::on_resolve(Resolver* resolver) {
   if (resolver->is_success()) {
     const AddressVec& addresses(resolver->addresses());
-    LOG_DEBUG("Resolved the addresses %s for hostname %s", to_string(addresses).c_str(),
-              hostname_.c_str());
+    LOG_DEBUG("Resolved the addresses %s for hostname %s%s", to_string(addresses).c_str(),
+              hostname_.c_str(), resolver->is_cached() ? " (cached)" : "");
 
     size_t offset = resolved_address_offset_.fetch_add(1, MEMORY_ORDER_RELAXED);
     resolved_address_ = Address(addresses[offset % addresses.size()],
@@ -303,8 +455,8 @@ void SocketConnector::on_resolve(Resolver* resolver) {
 
 void SocketConnector::on_name_resolve(NameResolver* resolver) {
   if (resolver->is_success()) {
-    LOG_DEBUG("Resolved the hostname %s for address %s", resolver->hostname().c_str(),
-              resolver->address().to_string().c_str());
+    LOG_DEBUG("Resolved the hostname %s for address %s%s", resolver->hostname().c_str(),
+              resolver->address().to_string().c_str(), resolver->is_cached() ? " (cached)" : "");
     const String& hostname = resolver->hostname();
     if (!hostname.empty() && hostname[hostname.size() - 1] == '.') {
       // Strip off trailing dot for hostcheck comparison
@@ -330,3 +482,11 @@ void SocketConnector::on_no_resolve(Timer* timer) {
     internal_connect(timer->loop());
   }
 }
+
+void SocketConnector::on_handshake_wait(Timer* timer) {
+  if (is_canceled()) {
+    finish();
+  } else {
+    internal_connect(timer->loop());
+  }
+}
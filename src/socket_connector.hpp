@@ -46,12 +46,31 @@ struct SocketSettings {
 
   bool hostname_resolution_enabled;
   uint64_t resolve_timeout_ms;
+  // The cache of name resolution results, if enabled
+  ResolverCache::Ptr resolver_cache;
   SslContext::Ptr ssl_context;
+  // The pool of the SSL sessions' buffers. This is shared by the sessions on
+  // the same event loop. If not set, each session uses its own pool.
+  rb::ChunkPool::Ptr ssl_chunk_pool;
   bool tcp_nodelay_enabled;
   bool tcp_keepalive_enabled;
   unsigned tcp_keepalive_delay_secs;
+  // The sizes of the socket buffers (SO_RCVBUF/SO_SNDBUF). Zero for the
+  // system's default.
+  unsigned receive_buffer_size;
+  unsigned send_buffer_size;
+  // The low watermark of unsent bytes (TCP_NOTSENT_LOWAT). Zero if disabled.
+  unsigned tcp_notsent_lowat;
   unsigned max_reusable_write_objects;
-  Address local_address;
+  // The local addresses that connections are spread across, if any
+  AddressVec local_addresses;
+  // The time a read busy polls the network device for data (SO_BUSY_POLL)
+  unsigned busy_poll_us;
+  bool io_uring_enabled;
+#ifdef HAVE_IO_URING
+  // The io_uring of the event loop. If not set, the sockets use libuv.
+  IoUring* io_uring;
+#endif
 };
 
 /**
@@ -98,6 +117,16 @@ public:
    */
   SocketConnector* with_settings(const SocketSettings& settings);
 
+  /**
+   * Bind the socket to a local port. The local address is used if it's set,
+   * otherwise any address.
+   *
+   * @param local_port The local (source) port or zero to let the system
+   * choose it.
+   * @return The socket connector so calls can be chained.
+   */
+  SocketConnector* with_local_port(int local_port);
+
   /**
    * Connect the socket.
    * @param loop An event loop to use for connecting the socket.
@@ -137,7 +166,9 @@ public:
 
 private:
   void internal_connect(uv_loop_t* loop);
+  Address select_local_address() const;
   void ssl_handshake();
+  void enable_kernel_tls();
   void finish();
 
   void on_error(SocketError code, const String& message);
@@ -145,9 +176,11 @@ private:
   void on_resolve(Resolver* resolver);
   void on_name_resolve(NameResolver* resolver);
   void on_no_resolve(Timer* timer);
+  void on_handshake_wait(Timer* timer);
 
 private:
   static Atomic<size_t> resolved_address_offset_;
+  static Atomic<size_t> local_address_offset_;
 
 private:
   Address address_;
@@ -160,6 +193,8 @@ private:
   Resolver::Ptr resolver_;
   NameResolver::Ptr name_resolver_;
   Timer no_resolve_timer_;
+  Timer handshake_wait_timer_;
+  bool is_handshake_started_;
 
   SocketError error_code_;
   String error_message_;
@@ -168,6 +203,7 @@ private:
   ScopedPtr<SslSession> ssl_session_;
 
   SocketSettings settings_;
+  int local_port_;
 };
 
 }}} // namespace datastax::internal::core
@@ -0,0 +1,81 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "speculative_execution.hpp"
+
+#include <algorithm>
+#include <uv.h>
+
+using namespace datastax::internal::core;
+
+bool PercentileSpeculativeExecutionPlan::start_execution() { return policy_->try_acquire(); }
+
+void PercentileSpeculativeExecutionPlan::record_latency(uint64_t latency_ns) {
+  policy_->record_latency(latency_ns);
+}
+
+SpeculativeExecutionPlan* PercentileSpeculativeExecutionPolicy::new_plan(const String& keyspace,
+                                                                         const Request* request) {
+  if (latencies_) {
+    uint64_t now = uv_hrtime();
+    uint64_t next_refresh_ns = next_refresh_ns_.load(MEMORY_ORDER_RELAXED);
+    // Only the thread that moves the refresh time forward recomputes the delay
+    if (now >= next_refresh_ns &&
+        next_refresh_ns_.compare_exchange_strong(next_refresh_ns, now + REFRESH_INTERVAL_NS)) {
+      refresh_delay();
+    }
+  }
+
+  // Each request adds its share of a speculative execution to the budget
+  if (budget_.load(MEMORY_ORDER_RELAXED) < MAX_BUDGET * 1000) {
+    budget_.fetch_add(static_cast<int64_t>(max_speculative_ratio_ * 1000.0),
+                      MEMORY_ORDER_RELAXED);
+  }
+
+  return new PercentileSpeculativeExecutionPlan(this, delay_ms(), max_speculative_executions_);
+}
+
+void PercentileSpeculativeExecutionPolicy::init(size_t thread_count) {
+  thread_state_.reset(new Metrics::ThreadState(thread_count));
+  latencies_.reset(new Metrics::Histogram(thread_state_.get()));
+}
+
+bool PercentileSpeculativeExecutionPolicy::try_acquire() {
+  int64_t budget = budget_.load(MEMORY_ORDER_RELAXED);
+  while (budget >= 1000) {
+    if (budget_.compare_exchange_weak(budget, budget - 1000)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void PercentileSpeculativeExecutionPolicy::record_latency(uint64_t latency_ns) {
+  if (latencies_) {
+    // Measurements are in microseconds (like the session's metrics)
+    latencies_->record_value(latency_ns / 1000);
+  }
+}
+
+void PercentileSpeculativeExecutionPolicy::refresh_delay() {
+  if (!latencies_) return;
+  int64_t latency_us = latencies_->value_at_percentile_and_reset(percentile_, MIN_MEASURED);
+  if (latency_us >= 0) {
+    // Round up to the timer's resolution and always wait at least a millisecond
+    delay_ms_.store(std::max(static_cast<int64_t>(1), (latency_us + 999) / 1000),
+                    MEMORY_ORDER_RELAXED);
+  }
+}
@@ -18,8 +18,11 @@
 #define DATASTAX_INTERNAL_SPECULATIVE_EXECUTION_HPP
 
 #include "allocated.hpp"
+#include "atomic.hpp"
 #include "host.hpp"
+#include "metrics.hpp"
 #include "ref_counted.hpp"
+#include "scoped_ptr.hpp"
 #include "string.hpp"
 
 #include <stdint.h>
@@ -33,6 +36,22 @@ public:
   virtual ~SpeculativeExecutionPlan() {}
 
   virtual int64_t next_execution(const Host::Ptr& current_host) = 0;
+
+  /**
+   * Called when a speculative execution's delay has elapsed, right before the
+   * speculative execution is started.
+   *
+   * @return true if the speculative execution should be started, otherwise
+   * false to skip it (and any further speculative executions).
+   */
+  virtual bool start_execution() { return true; }
+
+  /**
+   * Called with the latency of each execution that received a result.
+   *
+   * @param latency_ns The execution's latency in nanoseconds.
+   */
+  virtual void record_latency(uint64_t latency_ns) {}
 };
 
 class SpeculativeExecutionPolicy : public RefCounted<SpeculativeExecutionPolicy> {
@@ -44,6 +63,15 @@ public:
   virtual SpeculativeExecutionPlan* new_plan(const String& keyspace, const Request* request) = 0;
 
   virtual SpeculativeExecutionPolicy* new_instance() = 0;
+
+  /**
+   * Called once a session has its own instance of the policy, before any plans
+   * are created.
+   *
+   * @param thread_count The number of threads that can create plans and
+   * record latencies.
+   */
+  virtual void init(size_t thread_count) {}
 };
 
 class NoSpeculativeExecutionPlan : public SpeculativeExecutionPlan {
@@ -93,6 +121,105 @@ public:
   const int max_speculative_executions_;
 };
 
+class PercentileSpeculativeExecutionPolicy;
+
+class PercentileSpeculativeExecutionPlan : public SpeculativeExecutionPlan {
+public:
+  PercentileSpeculativeExecutionPlan(PercentileSpeculativeExecutionPolicy* policy,
+                                     int64_t delay_ms, int count)
+      : policy_(policy)
+      , delay_ms_(delay_ms)
+      , count_(count) {}
+
+  virtual int64_t next_execution(const Host::Ptr& current_host) {
+    return delay_ms_ >= 0 && --count_ >= 0 ? delay_ms_ : -1;
+  }
+
+  virtual bool start_execution();
+  virtual void record_latency(uint64_t latency_ns);
+
+private:
+  SharedRefPtr<PercentileSpeculativeExecutionPolicy> policy_;
+  const int64_t delay_ms_;
+  int count_;
+};
+
+/**
+ * A speculative execution policy that waits for a percentile of the recent
+ * execution latencies (e.g. the 95th) before starting a speculative execution.
+ * The latencies are recorded in a histogram per policy instance, i.e. per
+ * execution profile, and the delay is recomputed from the histogram at a
+ * fixed interval. No speculative executions are started until enough
+ * latencies have been recorded.
+ *
+ * The number of speculative executions is also limited to a fraction of the
+ * number of requests so that a latency spike doesn't double the load on the
+ * cluster.
+ */
+class PercentileSpeculativeExecutionPolicy : public SpeculativeExecutionPolicy {
+public:
+  typedef SharedRefPtr<PercentileSpeculativeExecutionPolicy> Ptr;
+
+  // The interval for recomputing the delay from the recorded latencies
+  static const uint64_t REFRESH_INTERVAL_NS = 1000LL * 1000LL * 1000LL; // 1 second
+  // The minimum number of latencies needed to compute the delay
+  static const int64_t MIN_MEASURED = 100;
+  // The maximum number of speculative executions that can be saved up
+  static const int64_t MAX_BUDGET = 10;
+
+  PercentileSpeculativeExecutionPolicy(double percentile, int max_speculative_executions,
+                                       double max_speculative_ratio)
+      : percentile_(percentile)
+      , max_speculative_executions_(max_speculative_executions)
+      , max_speculative_ratio_(max_speculative_ratio)
+      , delay_ms_(-1)
+      , next_refresh_ns_(0)
+      , budget_(0) {}
+
+  virtual SpeculativeExecutionPlan* new_plan(const String& keyspace, const Request* request);
+
+  virtual SpeculativeExecutionPolicy* new_instance() {
+    return new PercentileSpeculativeExecutionPolicy(percentile_, max_speculative_executions_,
+                                                    max_speculative_ratio_);
+  }
+
+  virtual void init(size_t thread_count);
+
+  /**
+   * The current delay before starting a speculative execution.
+   *
+   * @return The delay in milliseconds or -1 if not enough latencies have been
+   * recorded.
+   */
+  int64_t delay_ms() const { return delay_ms_.load(MEMORY_ORDER_RELAXED); }
+
+  /**
+   * Take a speculative execution from the budget.
+   *
+   * @return true if the speculative execution is within the budget.
+   */
+  bool try_acquire();
+
+  void record_latency(uint64_t latency_ns);
+
+  /**
+   * Recompute the delay from the latencies recorded since the last refresh.
+   */
+  void refresh_delay();
+
+  const double percentile_;
+  const int max_speculative_executions_;
+  const double max_speculative_ratio_;
+
+private:
+  ScopedPtr<Metrics::ThreadState> thread_state_;
+  ScopedPtr<Metrics::Histogram> latencies_;
+  Atomic<int64_t> delay_ms_;
+  Atomic<uint64_t> next_refresh_ns_;
+  // The budget is in thousandths of a speculative execution
+  Atomic<int64_t> budget_;
+};
+
 }}} // namespace datastax::internal::core
 
 #endif
@@ -28,6 +28,7 @@
 
 #include <assert.h>
 
+#include "allocated.hpp"
 #include "atomic.hpp"
 #include "driver_config.hpp"
 #include "macros.hpp"
@@ -37,14 +38,14 @@
 namespace datastax { namespace internal { namespace core {
 
 template <typename T>
-class SPSCQueue {
+class SPSCQueue : public Allocated {
 public:
   typedef T EntryType;
 
   SPSCQueue(size_t size)
       : size_(next_pow_2(size))
       , mask_(size_ - 1)
-      , buffer_(new T[size])
+      , buffer_(new T[size_])
       , tail_(0)
       , head_(0) {}
 
@@ -71,6 +72,12 @@ public:
 
   bool is_empty() { return head_.load(MEMORY_ORDER_ACQUIRE) == tail_.load(MEMORY_ORDER_ACQUIRE); }
 
+  // An approximation of the number of queued items. This can be stale when
+  // the other thread is modifying the queue.
+  size_t size() const {
+    return (tail_.load(MEMORY_ORDER_RELAXED) - head_.load(MEMORY_ORDER_RELAXED)) & mask_;
+  }
+
   static void memory_fence() {
     // Internally, libuv has a "pending" flag check whose load can be reordered
     // before storing the data into the queue causing the data in the queue
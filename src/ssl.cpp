@@ -18,9 +18,27 @@
 
 #include "cassandra.h"
 #include "external.hpp"
+#include "scoped_lock.hpp"
+#include "serialization.hpp"
 
+#include <string.h>
 #include <uv.h>
 
+#ifdef HAVE_KTLS
+#include <linux/tls.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#endif
+
+using namespace datastax::internal;
 using namespace datastax::internal::core;
 
 extern "C" {
@@ -69,7 +87,103 @@ CassError cass_ssl_set_min_protocol_version(CassSsl* ssl, CassSslTlsVersion min_
   return ssl->set_min_protocol_version(min_version);
 }
 
+CassError cass_ssl_set_kernel_tls(CassSsl* ssl, cass_bool_t enabled) {
+  if (enabled && !SslContext::is_kernel_tls_available()) {
+    return CASS_ERROR_LIB_NOT_IMPLEMENTED;
+  }
+  ssl->set_kernel_tls_enabled(enabled == cass_true);
+  return CASS_OK;
+}
+
+void cass_ssl_set_session_resumption(CassSsl* ssl, cass_bool_t enabled) {
+  ssl->set_session_resumption_enabled(enabled == cass_true);
+}
+
+void cass_ssl_set_max_concurrent_handshakes(CassSsl* ssl, unsigned max_handshakes) {
+  ssl->set_max_concurrent_handshakes(max_handshakes);
+}
+
+void cass_ssl_get_session_metrics(const CassSsl* ssl, CassSslSessionMetrics* output) {
+  ssl->session_metrics(output);
+}
+
+CassError cass_ssl_set_buffer_size(CassSsl* ssl, size_t size) {
+  if (size < rb::ChunkPool::MIN_CHUNK_SIZE) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  ssl->set_buffer_size(size);
+  return CASS_OK;
+}
+
 } // extern "C"
 
+#ifdef HAVE_KTLS
+template <class CryptoInfo>
+static int set_kernel_tls_tx(uv_os_fd_t fd, unsigned short cipher_type, const TlsTxKeys& keys) {
+  CryptoInfo info;
+  memset(&info, 0, sizeof(info));
+  info.info.version = TLS_1_2_VERSION;
+  info.info.cipher_type = cipher_type;
+  memcpy(info.key, keys.key, sizeof(info.key));
+  memcpy(info.salt, keys.salt, sizeof(info.salt));
+  encode_int64(reinterpret_cast<char*>(info.rec_seq), keys.seq);
+  // The explicit nonce of a TLS 1.2 record only has to be unique so the
+  // record's sequence number is used (the kernel increments both)
+  memcpy(info.iv, info.rec_seq, sizeof(info.iv));
+  int rc = setsockopt(fd, SOL_TLS, TLS_TX, &info, sizeof(info));
+  memset(&info, 0, sizeof(info));
+  return rc;
+}
+#endif
+
+bool SslContext::try_start_handshake(const Address& address) {
+  if (max_concurrent_handshakes_ == 0) return true;
+  ScopedMutex l(&handshakes_mutex_);
+  unsigned& count = handshakes_[Address(address, String())];
+  if (count >= max_concurrent_handshakes_) return false;
+  ++count;
+  return true;
+}
+
+void SslContext::finish_handshake(const Address& address) {
+  if (max_concurrent_handshakes_ == 0) return;
+  ScopedMutex l(&handshakes_mutex_);
+  Map<Address, unsigned>::iterator it = handshakes_.find(Address(address, String()));
+  if (it != handshakes_.end() && --it->second == 0) {
+    handshakes_.erase(it);
+  }
+}
+
+bool SslContext::is_kernel_tls_available() {
+#ifdef HAVE_KTLS
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool SslSession::enable_kernel_tls(uv_os_fd_t fd) {
+#ifdef HAVE_KTLS
+  TlsTxKeys keys;
+  if (!tx_keys(&keys)) return false;
+
+  // This fails if the "tls" kernel module isn't available
+  int rc = setsockopt(fd, SOL_TCP, TCP_ULP, "tls", sizeof("tls"));
+  if (rc == 0) {
+    if (keys.key_size == TLS_CIPHER_AES_GCM_128_KEY_SIZE) {
+      rc = set_kernel_tls_tx<tls12_crypto_info_aes_gcm_128>(fd, TLS_CIPHER_AES_GCM_128, keys);
+    } else {
+      rc = set_kernel_tls_tx<tls12_crypto_info_aes_gcm_256>(fd, TLS_CIPHER_AES_GCM_256, keys);
+    }
+  }
+  memset(keys.key, 0, sizeof(keys.key));
+
+  is_kernel_tls_tx_ = (rc == 0);
+  return is_kernel_tls_tx_;
+#else
+  return false;
+#endif
+}
+
 template <class T>
 uv_once_t SslContextFactoryBase<T>::ssl_init_guard = UV_ONCE_INIT;
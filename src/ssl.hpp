@@ -19,9 +19,11 @@
 
 #include "address.hpp"
 #include "allocated.hpp"
+#include "atomic.hpp"
 #include "cassandra.h"
 #include "driver_config.hpp"
 #include "external.hpp"
+#include "map.hpp"
 #include "ref_counted.hpp"
 #include "ring_buffer.hpp"
 #include "string.hpp"
@@ -30,15 +32,33 @@
 
 namespace datastax { namespace internal { namespace core {
 
+/**
+ * The parameters needed to encrypt a connection's outgoing TLS 1.2 AES-GCM
+ * records outside of the SSL library (e.g. by the kernel).
+ */
+struct TlsTxKeys {
+  TlsTxKeys()
+      : key_size(0)
+      , seq(0) {}
+
+  size_t key_size; // 16 for AES-128-GCM and 32 for AES-256-GCM
+  unsigned char key[32];
+  unsigned char salt[4];
+  uint64_t seq; // The sequence number of the next record
+};
+
 class SslSession : public Allocated {
 public:
   SslSession(const Address& address, const String& hostname, const String& sni_server_name,
-             int flags)
+             int flags, const rb::ChunkPool::Ptr& chunk_pool = rb::ChunkPool::Ptr())
       : address_(address)
       , hostname_(hostname)
       , sni_server_name_(sni_server_name)
       , verify_flags_(flags)
-      , error_code_(CASS_OK) {}
+      , incoming_(chunk_pool)
+      , outgoing_(chunk_pool)
+      , error_code_(CASS_OK)
+      , is_kernel_tls_tx_(false) {}
 
   virtual ~SslSession() {}
 
@@ -55,6 +75,29 @@ public:
   virtual int encrypt(const char* data, size_t data_size) = 0;
   virtual int decrypt(char* data, size_t data_size) = 0;
 
+  /**
+   * Get the keys of the outgoing records. This is only valid after the
+   * handshake and before any data is encrypted.
+   *
+   * @param keys The keys.
+   * @return false if the negotiated protocol version or cipher isn't
+   * supported.
+   */
+  virtual bool tx_keys(TlsTxKeys* keys) const { return false; }
+
+  /**
+   * Install the keys of the outgoing records on the socket so that the kernel
+   * encrypts the writes (Linux kTLS). Incoming records are still decrypted by
+   * the SSL library. This must be called after the handshake and before any
+   * data is encrypted.
+   *
+   * @param fd The socket's file descriptor.
+   * @return true if the kernel now encrypts the socket's writes.
+   */
+  bool enable_kernel_tls(uv_os_fd_t fd);
+
+  bool is_kernel_tls_tx() const { return is_kernel_tls_tx_; }
+
   rb::RingBuffer& incoming() { return incoming_; }
   rb::RingBuffer& outgoing() { return outgoing_; }
 
@@ -67,6 +110,7 @@ protected:
   rb::RingBuffer outgoing_;
   CassError error_code_;
   String error_message_;
+  bool is_kernel_tls_tx_;
 };
 
 class SslContext : public RefCounted<SslContext> {
@@ -74,15 +118,93 @@ public:
   typedef SharedRefPtr<SslContext> Ptr;
 
   SslContext()
-      : verify_flags_(CASS_SSL_VERIFY_PEER_CERT) {}
-
-  virtual ~SslContext() {}
+      : verify_flags_(CASS_SSL_VERIFY_PEER_CERT)
+      , is_kernel_tls_enabled_(false)
+      , is_session_resumption_enabled_(true)
+      , buffer_size_(rb::ChunkPool::MIN_CHUNK_SIZE)
+      , max_concurrent_handshakes_(0)
+      , full_handshakes_(0)
+      , resumed_handshakes_(0) {
+    uv_mutex_init(&handshakes_mutex_);
+  }
+
+  virtual ~SslContext() { uv_mutex_destroy(&handshakes_mutex_); }
 
   void set_verify_flags(int flags) { verify_flags_ = flags; }
   bool is_cert_validation_enabled() { return verify_flags_ != CASS_SSL_VERIFY_NONE; }
 
+  /**
+   * Determine if the driver was built with kernel TLS support.
+   */
+  static bool is_kernel_tls_available();
+
+  void set_kernel_tls_enabled(bool enabled) { is_kernel_tls_enabled_ = enabled; }
+  bool is_kernel_tls_enabled() const { return is_kernel_tls_enabled_; }
+
+  void set_session_resumption_enabled(bool enabled) { is_session_resumption_enabled_ = enabled; }
+  bool is_session_resumption_enabled() const { return is_session_resumption_enabled_; }
+
+  void set_buffer_size(size_t size) { buffer_size_ = size; }
+  size_t buffer_size() const { return buffer_size_; }
+
+  void set_max_concurrent_handshakes(unsigned max_handshakes) {
+    max_concurrent_handshakes_ = max_handshakes;
+  }
+  unsigned max_concurrent_handshakes() const { return max_concurrent_handshakes_; }
+
+  /**
+   * Start a handshake with an endpoint. The handshakes in progress are
+   * counted by endpoint (the address without its SNI server name) so the
+   * connections to all the hosts behind an SNI proxy share the limit. A
+   * connection that waits for the other handshakes to finish can resume one
+   * of their sessions instead of doing a full handshake.
+   *
+   * @param address The host's address.
+   * @return true if the handshake can start, otherwise false if too many
+   * handshakes with the endpoint are in progress. A handshake that started
+   * must be finished using finish_handshake().
+   */
+  bool try_start_handshake(const Address& address);
+
+  /**
+   * Finish a handshake (successful or not).
+   *
+   * @param address The host's address.
+   */
+  void finish_handshake(const Address& address);
+
+  /**
+   * Count a successful handshake.
+   *
+   * @param is_resumed true if a cached session was resumed.
+   */
+  void record_handshake(bool is_resumed) {
+    if (is_resumed) {
+      resumed_handshakes_.fetch_add(1, MEMORY_ORDER_RELAXED);
+    } else {
+      full_handshakes_.fetch_add(1, MEMORY_ORDER_RELAXED);
+    }
+  }
+
+  void session_metrics(CassSslSessionMetrics* metrics) const {
+    metrics->full_handshakes = full_handshakes_.load(MEMORY_ORDER_RELAXED);
+    metrics->resumed_handshakes = resumed_handshakes_.load(MEMORY_ORDER_RELAXED);
+  }
+
+  /**
+   * Create a SSL session.
+   *
+   * @param address The address of the host.
+   * @param hostname The hostname of the host (used to verify its identity).
+   * @param sni_server_name The server name sent using SNI.
+   * @param chunk_pool The pool of the session's incoming and outgoing buffers.
+   * Sessions on the same event loop share a pool. If not provided, the session
+   * uses its own pool of buffers of the context's buffer size.
+   * @return The session.
+   */
   virtual SslSession* create_session(const Address& address, const String& hostname,
-                                     const String& sni_server_name) = 0;
+                                     const String& sni_server_name,
+                                     const rb::ChunkPool::Ptr& chunk_pool) = 0;
   virtual CassError add_trusted_cert(const char* cert, size_t cert_length) = 0;
   virtual CassError set_cert(const char* cert, size_t cert_length) = 0;
   virtual CassError set_private_key(const char* key, size_t key_length, const char* password,
@@ -91,6 +213,16 @@ public:
 
 protected:
   int verify_flags_;
+  bool is_kernel_tls_enabled_;
+  bool is_session_resumption_enabled_;
+  size_t buffer_size_;
+  unsigned max_concurrent_handshakes_;
+
+private:
+  Atomic<uint64_t> full_handshakes_;
+  Atomic<uint64_t> resumed_handshakes_;
+  uv_mutex_t handshakes_mutex_;
+  Map<Address, unsigned> handshakes_; // The handshakes in progress by endpoint
 };
 
 template <class T>
@@ -27,7 +27,8 @@ NoSslSession::NoSslSession(const Address& address, const String& hostname,
 }
 
 SslSession* NoSslContext::create_session(const Address& address, const String& hostname,
-                                         const String& sni_server_name) {
+                                         const String& sni_server_name,
+                                         const rb::ChunkPool::Ptr& chunk_pool) {
   return new NoSslSession(address, hostname, sni_server_name);
 }
 
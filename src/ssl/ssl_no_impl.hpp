@@ -34,7 +34,8 @@ public:
 class NoSslContext : public SslContext {
 public:
   virtual SslSession* create_session(const Address& address, const String& hostname,
-                                     const String& sni_server_name);
+                                     const String& sni_server_name,
+                                     const rb::ChunkPool::Ptr& chunk_pool);
 
   virtual CassError add_trusted_cert(const char* cert, size_t cert_length);
   virtual CassError set_cert(const char* cert, size_t cert_length);
@@ -17,6 +17,7 @@
 #include "ssl.hpp"
 
 #include "logger.hpp"
+#include "scoped_lock.hpp"
 #include "utils.hpp"
 
 #include "third_party/curl/hostcheck.hpp"
@@ -24,6 +25,7 @@
 #include <openssl/crypto.h>
 #include <openssl/engine.h>
 #include <openssl/err.h>
+#include <openssl/evp.h>
 #include <openssl/rand.h>
 #include <openssl/tls1.h>
 #include <openssl/x509v3.h>
@@ -46,6 +48,10 @@
 #else
 #define SSL_CLIENT_METHOD SSLv23_client_method
 #endif
+#if (OPENSSL_VERSION_NUMBER >= 0x10101000L)
+#define SSL_CAN_DERIVE_TX_KEYS
+#include <openssl/kdf.h>
+#endif
 #else
 #if (LIBRESSL_VERSION_NUMBER >= 0x20302000L)
 #define SSL_CAN_SET_MIN_VERSION
@@ -427,9 +433,11 @@ private:
 };
 
 OpenSslSession::OpenSslSession(const Address& address, const String& hostname,
-                               const String& sni_server_name, int flags, SSL_CTX* ssl_ctx)
-    : SslSession(address, hostname, sni_server_name, flags)
-    , ssl_(SSL_new(ssl_ctx))
+                               const String& sni_server_name, int flags,
+                               OpenSslContext* context, const rb::ChunkPool::Ptr& chunk_pool)
+    : SslSession(address, hostname, sni_server_name, flags, chunk_pool)
+    , context_(context)
+    , ssl_(SSL_new(context->ssl_ctx()))
     , incoming_state_(&incoming_)
     , outgoing_state_(&outgoing_)
     , incoming_bio_(rb::RingBufferBio::create(&incoming_state_))
@@ -440,16 +448,46 @@ OpenSslSession::OpenSslSession(const Address& address, const String& hostname,
   if (!sni_server_name_.empty()) {
     SSL_set_tlsext_host_name(ssl_, const_cast<char*>(sni_server_name_.c_str()));
   }
+
+  if (context_->is_session_resumption_enabled()) {
+    context_->resume_session(address_, ssl_);
+  }
 }
 
-OpenSslSession::~OpenSslSession() { SSL_free(ssl_); }
+OpenSslSession::~OpenSslSession() {
+  // The driver closes connections without a TLS shutdown. Freeing a connection
+  // that wasn't shut down marks its session as not resumable so mark it as
+  // shut down if there wasn't an error.
+  if (is_handshake_done() && (!has_error() || error_code_ == CASS_ERROR_SSL_CLOSED)) {
+    SSL_set_shutdown(ssl_, SSL_SENT_SHUTDOWN | SSL_RECEIVED_SHUTDOWN);
+  }
+  SSL_free(ssl_);
+}
 
 void OpenSslSession::do_handshake() {
   int rc = SSL_connect(ssl_);
-  if (rc <= 0) check_error(rc);
+  if (rc <= 0) {
+    check_error(rc);
+    // Don't try to resume the session again if resuming it failed
+    if (has_error() && context_->is_session_resumption_enabled()) {
+      context_->remove_session(address_);
+    }
+  }
 }
 
 void OpenSslSession::verify() {
+  verify_peer();
+  if (has_error()) return;
+
+  bool is_resumed = SSL_session_reused(ssl_) != 0;
+  context_->record_handshake(is_resumed);
+  // Only the sessions of verified peers are cached
+  if (!is_resumed && context_->is_session_resumption_enabled()) {
+    context_->cache_session(address_, ssl_);
+  }
+}
+
+void OpenSslSession::verify_peer() {
   if (!verify_flags_) return;
 
   X509* peer_cert = SSL_get_peer_certificate(ssl_);
@@ -523,6 +561,68 @@ int OpenSslSession::decrypt(char* buf, size_t size) {
   return rc;
 }
 
+bool OpenSslSession::tx_keys(TlsTxKeys* keys) const {
+#ifdef SSL_CAN_DERIVE_TX_KEYS
+  // Only TLS 1.2 using AES-GCM is supported. The client's Finished message is
+  // the first record encrypted with the keys (for full and resumed
+  // handshakes) so the application data starts at sequence number 1.
+  if (SSL_version(ssl_) != TLS1_2_VERSION) return false;
+
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl_);
+  if (cipher == NULL) return false;
+
+  size_t key_size;
+  switch (SSL_CIPHER_get_cipher_nid(cipher)) {
+    case NID_aes_128_gcm:
+      key_size = 16;
+      break;
+    case NID_aes_256_gcm:
+      key_size = 32;
+      break;
+    default:
+      return false;
+  }
+
+  unsigned char master_key[SSL_MAX_MASTER_KEY_LENGTH];
+  size_t master_key_size =
+      SSL_SESSION_get_master_key(SSL_get_session(ssl_), master_key, sizeof(master_key));
+  unsigned char client_random[SSL3_RANDOM_SIZE];
+  unsigned char server_random[SSL3_RANDOM_SIZE];
+  SSL_get_client_random(ssl_, client_random, sizeof(client_random));
+  SSL_get_server_random(ssl_, server_random, sizeof(server_random));
+
+  // The key block (RFC 5246, section 6.3) of an AEAD cipher has no MAC keys:
+  // client write key, server write key, client write IV and server write IV
+  unsigned char key_block[2 * 32 + 2 * 4];
+  size_t key_block_size = 2 * key_size + 2 * sizeof(keys->salt);
+  const char* label = "key expansion";
+
+  EVP_PKEY_CTX* pctx = EVP_PKEY_CTX_new_id(EVP_PKEY_TLS1_PRF, NULL);
+  bool is_derived =
+      pctx != NULL && EVP_PKEY_derive_init(pctx) > 0 &&
+      EVP_PKEY_CTX_set_tls1_prf_md(pctx, SSL_CIPHER_get_handshake_digest(cipher)) > 0 &&
+      EVP_PKEY_CTX_set1_tls1_prf_secret(pctx, master_key, master_key_size) > 0 &&
+      EVP_PKEY_CTX_add1_tls1_prf_seed(
+          pctx, reinterpret_cast<const unsigned char*>(label), strlen(label)) > 0 &&
+      EVP_PKEY_CTX_add1_tls1_prf_seed(pctx, server_random, sizeof(server_random)) > 0 &&
+      EVP_PKEY_CTX_add1_tls1_prf_seed(pctx, client_random, sizeof(client_random)) > 0 &&
+      EVP_PKEY_derive(pctx, key_block, &key_block_size) > 0;
+  EVP_PKEY_CTX_free(pctx);
+  OPENSSL_cleanse(master_key, sizeof(master_key));
+
+  if (is_derived) {
+    keys->key_size = key_size;
+    memcpy(keys->key, key_block, key_size);
+    memcpy(keys->salt, key_block + 2 * key_size, sizeof(keys->salt));
+    keys->seq = 1;
+  }
+  OPENSSL_cleanse(key_block, sizeof(key_block));
+  return is_derived;
+#else
+  return false;
+#endif
+}
+
 void OpenSslSession::check_error(int rc) {
   int err = SSL_get_error(ssl_, rc);
   if (err == SSL_ERROR_ZERO_RETURN) {
@@ -545,13 +645,67 @@ OpenSslContext::OpenSslContext()
 #if DEBUG_SSL
   SSL_CTX_set_info_callback(ssl_ctx_, ssl_info_callback);
 #endif
+  uv_mutex_init(&sessions_mutex_);
 }
 
-OpenSslContext::~OpenSslContext() { SSL_CTX_free(ssl_ctx_); }
+OpenSslContext::~OpenSslContext() {
+  for (SessionMap::iterator it = sessions_.begin(), end = sessions_.end(); it != end; ++it) {
+    SSL_SESSION_free(it->second);
+  }
+  uv_mutex_destroy(&sessions_mutex_);
+  SSL_CTX_free(ssl_ctx_);
+}
 
 SslSession* OpenSslContext::create_session(const Address& address, const String& hostname,
-                                           const String& sni_server_name) {
-  return new OpenSslSession(address, hostname, sni_server_name, verify_flags_, ssl_ctx_);
+                                           const String& sni_server_name,
+                                           const rb::ChunkPool::Ptr& chunk_pool) {
+  return new OpenSslSession(
+      address, hostname, sni_server_name, verify_flags_, this,
+      chunk_pool ? chunk_pool : rb::ChunkPool::Ptr(new rb::ChunkPool(buffer_size_)));
+}
+
+void OpenSslContext::resume_session(const Address& address, SSL* ssl) {
+  ScopedMutex l(&sessions_mutex_);
+  SessionMap::const_iterator it = sessions_.find(address);
+  if (it == sessions_.end() && !address.server_name().empty()) {
+    // Try the last session of the other hosts behind the same SNI proxy
+    it = sessions_.find(Address(address, String()));
+  }
+  if (it != sessions_.end()) {
+    SSL_set_session(ssl, it->second);
+  }
+}
+
+void OpenSslContext::cache_session(const Address& address, SSL* ssl) {
+  ScopedMutex l(&sessions_mutex_);
+  internal_cache_session(address, ssl);
+  if (!address.server_name().empty()) {
+    internal_cache_session(Address(address, String()), ssl);
+  }
+}
+
+void OpenSslContext::remove_session(const Address& address) {
+  ScopedMutex l(&sessions_mutex_);
+  internal_remove_session(address);
+  if (!address.server_name().empty()) {
+    internal_remove_session(Address(address, String()));
+  }
+}
+
+void OpenSslContext::internal_cache_session(const Address& address, SSL* ssl) {
+  SSL_SESSION* session = SSL_get1_session(ssl); // A reference for each entry
+  if (session == NULL) return;
+  SSL_SESSION*& cached = sessions_[address];
+  if (cached != NULL) SSL_SESSION_free(cached);
+  cached = session;
+}
+
+void OpenSslContext::internal_remove_session(const Address& address) {
+  SessionMap::iterator it = sessions_.find(address);
+  if (it != sessions_.end()) {
+    SSL_SESSION_free(it->second);
+    sessions_.erase(it);
+  }
 }
 
 CassError OpenSslContext::add_trusted_cert(const char* cert, size_t cert_length) {
@@ -17,6 +17,7 @@
 #ifndef DATASTAX_INTERNAL_SSL_OPENSSL_IMPL_HPP
 #define DATASTAX_INTERNAL_SSL_OPENSSL_IMPL_HPP
 
+#include "map.hpp"
 #include "ssl/ring_buffer_bio.hpp"
 
 #include <assert.h>
@@ -25,10 +26,12 @@
 
 namespace datastax { namespace internal { namespace core {
 
+class OpenSslContext;
+
 class OpenSslSession : public SslSession {
 public:
   OpenSslSession(const Address& address, const String& hostname, const String& sni_server_name,
-                 int flags, SSL_CTX* ssl_ctx);
+                 int flags, OpenSslContext* context, const rb::ChunkPool::Ptr& chunk_pool);
   ~OpenSslSession();
 
   virtual bool is_handshake_done() const { return SSL_is_init_finished(ssl_) != 0; }
@@ -39,9 +42,13 @@ public:
   virtual int encrypt(const char* buf, size_t size);
   virtual int decrypt(char* buf, size_t size);
 
+  virtual bool tx_keys(TlsTxKeys* keys) const;
+
 private:
   void check_error(int rc);
+  void verify_peer();
 
+  SharedRefPtr<OpenSslContext> context_;
   SSL* ssl_;
   rb::RingBufferState incoming_state_;
   rb::RingBufferState outgoing_state_;
@@ -56,16 +63,52 @@ public:
   ~OpenSslContext();
 
   virtual SslSession* create_session(const Address& address, const String& hostname,
-                                     const String& sni_server_name);
+                                     const String& sni_server_name,
+                                     const rb::ChunkPool::Ptr& chunk_pool);
   virtual CassError add_trusted_cert(const char* cert, size_t cert_length);
   virtual CassError set_cert(const char* cert, size_t cert_length);
   virtual CassError set_private_key(const char* key, size_t key_length, const char* password,
                                     size_t password_length);
   virtual CassError set_min_protocol_version(CassSslTlsVersion min_version);
 
+  SSL_CTX* ssl_ctx() const { return ssl_ctx_; }
+
+  /**
+   * Set the cached session of a host, if any, on a new connection so that
+   * the handshake tries to resume it. A host behind an SNI proxy without a
+   * cached session uses the proxy's last session.
+   *
+   * @param address The host's address.
+   * @param ssl The connection's SSL object.
+   */
+  void resume_session(const Address& address, SSL* ssl);
+
+  /**
+   * Cache the session of a connection that completed its handshake.
+   *
+   * @param address The host's address.
+   * @param ssl The connection's SSL object.
+   */
+  void cache_session(const Address& address, SSL* ssl);
+
+  /**
+   * Remove the cached session of a host (e.g. if resuming it failed).
+   *
+   * @param address The host's address.
+   */
+  void remove_session(const Address& address);
+
 private:
+  void internal_cache_session(const Address& address, SSL* ssl);
+  void internal_remove_session(const Address& address);
+
+private:
+  typedef Map<Address, SSL_SESSION*> SessionMap;
+
   SSL_CTX* ssl_ctx_;
   X509_STORE* trusted_store_;
+  uv_mutex_t sessions_mutex_;
+  SessionMap sessions_;
 };
 
 class OpenSslContextFactory : public SslContextFactoryBase<OpenSslContextFactory> {
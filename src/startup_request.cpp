@@ -35,6 +35,9 @@ int StartupRequest::encode(ProtocolVersion version, RequestCallback* callback,
   if (!client_id_.empty()) {
     options["CLIENT_ID"] = client_id_;
   }
+  if (!compression_.empty()) {
+    options["COMPRESSION"] = compression_;
+  }
   options["CQL_VERSION"] = CASS_DEFAULT_CQL_VERSION;
   options["DRIVER_NAME"] = driver_name();
   options["DRIVER_VERSION"] = driver_version();
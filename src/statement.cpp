@@ -17,6 +17,7 @@
 #include "statement.hpp"
 
 #include "collection.hpp"
+#include "column_handle.hpp"
 #include "execute_request.hpp"
 #include "external.hpp"
 #include "macros.hpp"
@@ -26,11 +27,16 @@
 #include "request_callback.hpp"
 #include "scoped_ptr.hpp"
 #include "string_ref.hpp"
+#include "struct_encoder.hpp"
 #include "tuple.hpp"
 #include "user_type_value.hpp"
 
 #include <uv.h>
 
+// The maximum number of copies kept by a reusable statement for its concurrent
+// executions
+#define MAX_REUSABLE_STATEMENT_COPIES 64
+
 using namespace datastax;
 using namespace datastax::internal;
 using namespace datastax::internal::core;
@@ -103,6 +109,17 @@ CassError cass_statement_set_paging_state_token(CassStatement* statement, const
   return CASS_OK;
 }
 
+CassError cass_statement_set_paging_prefetch(CassStatement* statement, cass_bool_t enabled) {
+  statement->set_paging_prefetch(enabled == cass_true);
+  return CASS_OK;
+}
+
+CassError cass_statement_set_row_callback(CassStatement* statement, CassRowCallback callback,
+                                          void* data) {
+  statement->set_row_callback(callback, data);
+  return CASS_OK;
+}
+
 CassError cass_statement_set_retry_policy(CassStatement* statement, CassRetryPolicy* retry_policy) {
   statement->set_retry_policy(retry_policy);
   return CASS_OK;
@@ -118,11 +135,37 @@ CassError cass_statement_set_request_timeout(CassStatement* statement, cass_uint
   return CASS_OK;
 }
 
+CassError cass_statement_set_deadline(CassStatement* statement, cass_uint64_t deadline_ms) {
+  statement->set_deadline_ms(deadline_ms);
+  return CASS_OK;
+}
+
 CassError cass_statement_set_is_idempotent(CassStatement* statement, cass_bool_t is_idempotent) {
   statement->set_is_idempotent(is_idempotent == cass_true);
   return CASS_OK;
 }
 
+CassError cass_statement_set_priority(CassStatement* statement, CassRequestPriority priority) {
+  statement->set_priority(priority);
+  return CASS_OK;
+}
+
+CassError cass_statement_set_result_cache_ttl(CassStatement* statement, cass_uint64_t ttl_ms) {
+  if (statement->opcode() != CQL_OPCODE_EXECUTE) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  statement->set_result_cache_ttl_ms(ttl_ms);
+  return CASS_OK;
+}
+
+CassError cass_statement_set_reusable(CassStatement* statement, cass_bool_t reusable) {
+  if (statement->opcode() != CQL_OPCODE_EXECUTE) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  statement->set_reusable(reusable == cass_true);
+  return CASS_OK;
+}
+
 CassError cass_statement_set_custom_payload(CassStatement* statement,
                                             const CassCustomPayload* payload) {
   statement->set_custom_payload(payload);
@@ -143,6 +186,16 @@ CassError cass_statement_set_execution_profile_n(CassStatement* statement, const
   return CASS_OK;
 }
 
+CassError cass_statement_set_execution_profile_handle(CassStatement* statement,
+                                                      cass_int32_t handle) {
+  if (handle < 0) {
+    statement->set_execution_profile_name(String());
+  } else {
+    statement->set_execution_profile_handle(handle);
+  }
+  return CASS_OK;
+}
+
 CassError cass_statement_set_tracing(CassStatement* statement, cass_bool_t enabled) {
   statement->set_tracing(enabled == cass_true);
   return CASS_OK;
@@ -190,6 +243,10 @@ CassError cass_statement_set_node(CassStatement* statement, const CassNode* node
   CassError cass_statement_bind_##Name##_by_name_n(CassStatement* statement, const char* name, \
                                                    size_t name_length Params) {                \
     return statement->set(StringRef(name, name_length), Value);                                \
+  }                                                                                            \
+  CassError cass_statement_bind_##Name##_by_handle(                                            \
+      CassStatement* statement, const CassColumnHandle* column_handle Params) {                \
+    return statement->set(column_handle->from(), Value);                                       \
   }
 
 CASS_STATEMENT_BIND(null, ZERO_PARAMS_(), CassNull())
@@ -214,6 +271,8 @@ CASS_STATEMENT_BIND(decimal,
 CASS_STATEMENT_BIND(duration,
                     THREE_PARAMS_(cass_int32_t months, cass_int32_t days, cass_int64_t nanos),
                     CassDuration(months, days, nanos))
+CASS_STATEMENT_BIND(struct, TWO_PARAMS_(const CassStructEncoder* encoder, const void* data),
+                    CassStruct(encoder->from(), data))
 
 #undef CASS_STATEMENT_BIND
 
@@ -237,6 +296,23 @@ CassError cass_statement_bind_string_by_name_n(CassStatement* statement, const c
   return statement->set(StringRef(name, name_length), CassString(value, value_length));
 }
 
+CassError cass_statement_bind_string_by_handle(CassStatement* statement,
+                                               const CassColumnHandle* column_handle,
+                                               const char* value) {
+  return statement->set(column_handle->from(), CassString(value, SAFE_STRLEN(value)));
+}
+
+CassError cass_statement_bind_string_by_handle_n(CassStatement* statement,
+                                                 const CassColumnHandle* column_handle,
+                                                 const char* value, size_t value_length) {
+  return statement->set(column_handle->from(), CassString(value, value_length));
+}
+
+CassError cass_statement_bind_encoded_values(CassStatement* statement, const cass_byte_t* values,
+                                             size_t values_size) {
+  return statement->set_encoded_values(reinterpret_cast<const char*>(values), values_size);
+}
+
 CassError cass_statement_bind_custom(CassStatement* statement, size_t index, const char* class_name,
                                      const cass_byte_t* value, size_t value_size) {
   return statement->set(index, CassCustom(StringRef(class_name), value, value_size));
@@ -263,6 +339,58 @@ CassError cass_statement_bind_custom_by_name_n(CassStatement* statement, const c
                         CassCustom(StringRef(class_name, class_name_length), value, value_size));
 }
 
+CassError cass_statement_bind_custom_by_handle(CassStatement* statement,
+                                               const CassColumnHandle* column_handle,
+                                               const char* class_name, const cass_byte_t* value,
+                                               size_t value_size) {
+  return statement->set(column_handle->from(),
+                        CassCustom(StringRef(class_name), value, value_size));
+}
+
+CassError cass_statement_bind_custom_by_handle_n(CassStatement* statement,
+                                                 const CassColumnHandle* column_handle,
+                                                 const char* class_name, size_t class_name_length,
+                                                 const cass_byte_t* value, size_t value_size) {
+  return statement->set(column_handle->from(),
+                        CassCustom(StringRef(class_name, class_name_length), value, value_size));
+}
+
+#define CASS_STATEMENT_BIND_REF(Name, ValueType, Ref)                                           \
+  CassError cass_statement_bind_##Name##_ref(CassStatement* statement, size_t index,            \
+                                             const ValueType* value, size_t value_size,         \
+                                             CassValueReleaseCallback release_callback,         \
+                                             void* data) {                                      \
+    ExternalBuffer::Ptr buffer(new ExternalBuffer(reinterpret_cast<const char*>(value),         \
+                                                  value_size, release_callback, data));         \
+    return statement->set(index, Ref(buffer.get()));                                           \
+  }                                                                                             \
+  CassError cass_statement_bind_##Name##_ref_by_name(                                           \
+      CassStatement* statement, const char* name, const ValueType* value, size_t value_size,    \
+      CassValueReleaseCallback release_callback, void* data) {                                  \
+    ExternalBuffer::Ptr buffer(new ExternalBuffer(reinterpret_cast<const char*>(value),         \
+                                                  value_size, release_callback, data));         \
+    return statement->set(StringRef(name), Ref(buffer.get()));                                  \
+  }                                                                                             \
+  CassError cass_statement_bind_##Name##_ref_by_name_n(                                         \
+      CassStatement* statement, const char* name, size_t name_length, const ValueType* value,   \
+      size_t value_size, CassValueReleaseCallback release_callback, void* data) {               \
+    ExternalBuffer::Ptr buffer(new ExternalBuffer(reinterpret_cast<const char*>(value),         \
+                                                  value_size, release_callback, data));         \
+    return statement->set(StringRef(name, name_length), Ref(buffer.get()));                     \
+  }                                                                                             \
+  CassError cass_statement_bind_##Name##_ref_by_handle(                                         \
+      CassStatement* statement, const CassColumnHandle* column_handle, const ValueType* value,  \
+      size_t value_size, CassValueReleaseCallback release_callback, void* data) {               \
+    ExternalBuffer::Ptr buffer(new ExternalBuffer(reinterpret_cast<const char*>(value),         \
+                                                  value_size, release_callback, data));         \
+    return statement->set(column_handle->from(), Ref(buffer.get()));                            \
+  }
+
+CASS_STATEMENT_BIND_REF(bytes, cass_byte_t, CassBytesRef)
+CASS_STATEMENT_BIND_REF(string, char, CassStringRef)
+
+#undef CASS_STATEMENT_BIND_REF
+
 } // extern "C"
 
 Statement::Statement(const char* query, size_t query_length, size_t values_count)
@@ -270,7 +398,13 @@ Statement::Statement(const char* query, size_t query_length, size_t values_count
     , AbstractData(values_count)
     , query_or_id_(sizeof(int32_t) + query_length)
     , flags_(0)
-    , page_size_(-1) {
+    , page_size_(-1)
+    , paging_prefetch_(false)
+    , row_callback_(NULL)
+    , row_callback_data_(NULL)
+    , result_cache_ttl_ms_(0)
+    , is_reusable_(false)
+    , next_copy_(0) {
   // <query> [long string]
   query_or_id_.encode_long_string(0, query, query_length);
 }
@@ -278,12 +412,15 @@ Statement::Statement(const char* query, size_t query_length, size_t values_count
 Statement::Statement(const Prepared* prepared)
     : RoutableRequest(CQL_OPCODE_EXECUTE)
     , AbstractData(prepared->result()->column_count())
-    , query_or_id_(sizeof(uint16_t) + prepared->id().size())
+    , query_or_id_(prepared->encoded_id()) // <id> [short bytes] (or [string])
     , flags_(0)
-    , page_size_(-1) {
-  // <id> [short bytes] (or [string])
-  const String& id = prepared->id();
-  query_or_id_.encode_string(0, id.data(), static_cast<uint16_t>(id.size()));
+    , page_size_(-1)
+    , paging_prefetch_(false)
+    , row_callback_(NULL)
+    , row_callback_data_(NULL)
+    , result_cache_ttl_ms_(0)
+    , is_reusable_(false)
+    , next_copy_(0) {
   // Inherit settings and keyspace from the prepared statement
   set_settings(prepared->request_settings());
   // If the keyspace wasn't explictly set then attempt to set it using the
@@ -293,6 +430,90 @@ Statement::Statement(const Prepared* prepared)
   }
 }
 
+Request::ConstPtr Statement::execution_request() const {
+  if (!is_reusable_) {
+    return Request::ConstPtr(this);
+  }
+
+  // Reuse a copy that's no longer in flight (only referenced by the statement)
+  Statement::Ptr copy;
+  for (size_t i = 0; i < copies_.size(); ++i) {
+    size_t index = (next_copy_ + i) % copies_.size();
+    if (copies_[index]->ref_count() == 1) {
+      copy = copies_[index];
+      next_copy_ = index + 1;
+      break;
+    }
+  }
+
+  if (!copy) {
+    copy.reset(new_copy());
+    if (!copy) {
+      return Request::ConstPtr(this);
+    }
+    // Copies beyond the maximum are freed when their executions complete
+    if (copies_.size() < MAX_REUSABLE_STATEMENT_COPIES) {
+      copies_.push_back(copy);
+    }
+  }
+
+  copy_to(copy.get());
+  return copy;
+}
+
+void Statement::copy_to(Statement* statement) const {
+  statement->copy_options(*this);
+  statement->set_elements(elements());
+  statement->flags_ = flags_;
+  statement->page_size_ = page_size_;
+  statement->paging_state_ = paging_state_;
+  statement->paging_prefetch_ = paging_prefetch_;
+  statement->row_callback_ = row_callback_;
+  statement->row_callback_data_ = row_callback_data_;
+  statement->result_cache_ttl_ms_ = result_cache_ttl_ms_;
+  statement->key_indices_ = key_indices_;
+}
+
+// Prefix the data with its size so that adjacent fields can't be confused
+static void append_sized(const char* data, size_t size, String* key) {
+  key->append(reinterpret_cast<const char*>(&size), sizeof(size));
+  key->append(data, size);
+}
+
+bool Statement::result_cache_key(String* key) const {
+  if (opcode() != CQL_OPCODE_EXECUTE || !paging_state_.empty()) {
+    return false;
+  }
+  Buffer values(AbstractData::encode());
+  int16_t consistency = static_cast<int16_t>(this->consistency());
+  int16_t serial_consistency = static_cast<int16_t>(this->serial_consistency());
+  uint8_t is_tracing = (flags() & CASS_FLAG_TRACING) != 0;
+  int32_t profile_handle = execution_profile_handle();
+  String host_address(host() ? host()->to_string(true) : String());
+
+  // The custom payload is passed to the server, which might use it to build
+  // the result
+  BufferVec custom_payload;
+  if (has_custom_payload()) {
+    encode_custom_payload(&custom_payload);
+  }
+
+  key->reserve(query_or_id_.size() + values.size() + 64);
+  key->assign(query_or_id_.data(), query_or_id_.size());
+  key->append(reinterpret_cast<const char*>(&consistency), sizeof(consistency));
+  key->append(reinterpret_cast<const char*>(&serial_consistency), sizeof(serial_consistency));
+  key->append(reinterpret_cast<const char*>(&page_size_), sizeof(page_size_));
+  key->append(reinterpret_cast<const char*>(&is_tracing), sizeof(is_tracing));
+  key->append(reinterpret_cast<const char*>(&profile_handle), sizeof(profile_handle));
+  append_sized(execution_profile_name().data(), execution_profile_name().size(), key);
+  append_sized(host_address.data(), host_address.size(), key);
+  for (BufferVec::const_iterator it = custom_payload.begin(); it != custom_payload.end(); ++it) {
+    append_sized(it->data(), it->size(), key);
+  }
+  key->append(values.data(), values.size());
+  return true;
+}
+
 String Statement::query() const {
   if (opcode() == CQL_OPCODE_QUERY) {
     return String(query_or_id_.data() + sizeof(int32_t), query_or_id_.size() - sizeof(int32_t));
@@ -336,11 +557,11 @@ int32_t Statement::encode_batch(ProtocolVersion version, RequestCallback* callba
   return length;
 }
 
-bool Statement::with_keyspace(ProtocolVersion version) const {
+bool Statement::with_keyspace(ProtocolVersion version, RequestCallback* callback) const {
   return version.supports_set_keyspace() &&
          // Execute requests (bound statements) use the keyspace
          // from the time of prepare.
-         opcode() != CQL_OPCODE_EXECUTE && !keyspace().empty();
+         opcode() != CQL_OPCODE_EXECUTE && !callback->keyspace().empty();
 }
 
 // For query statements the format is:
@@ -391,7 +612,7 @@ int32_t Statement::encode_begin(ProtocolVersion version, uint16_t element_count,
     flags |= CASS_QUERY_FLAG_PAGE_SIZE;
   }
 
-  if (!paging_state().empty()) {
+  if (!paging_state(callback).empty()) {
     flags |= CASS_QUERY_FLAG_PAGING_STATE;
   }
 
@@ -403,10 +624,14 @@ int32_t Statement::encode_begin(ProtocolVersion version, uint16_t element_count,
     flags |= CASS_QUERY_FLAG_DEFAULT_TIMESTAMP;
   }
 
-  if (with_keyspace(version)) {
+  if (with_keyspace(version, callback)) {
     flags |= CASS_QUERY_FLAG_WITH_KEYSPACE;
   }
 
+  if (callback->is_continuous_paging()) {
+    flags |= CASS_QUERY_FLAG_CONTINUOUS_PAGING;
+  }
+
   bufs->push_back(Buffer(query_params_buf_size));
   length += query_params_buf_size;
 
@@ -435,7 +660,7 @@ int32_t Statement::encode_values(ProtocolVersion version, RequestCallback* callb
   for (size_t i = 0; i < elements().size(); ++i) {
     const Element& element = elements()[i];
     if (!element.is_unset()) {
-      bufs->push_back(element.get_buffer());
+      length += element.append_buffers(bufs);
     } else {
       if (version >= CASS_PROTOCOL_VERSION_V4) {
         bufs->push_back(core::encode_with_length(CassUnset()));
@@ -445,32 +670,38 @@ int32_t Statement::encode_values(ProtocolVersion version, RequestCallback* callb
         callback->on_error(CASS_ERROR_LIB_PARAMETER_UNSET, ss.str());
         return Request::REQUEST_ERROR_PARAMETER_UNSET;
       }
+      length += bufs->back().size();
     }
-    length += bufs->back().size();
   }
   return length;
 }
 
 // Format: [<result_page_size>][<paging_state>][<serial_consistency>][<timestamp>]
+//         [<keyspace>][<continuous_paging_options>]
 // where:
 // <result_page_size> is a [int]
 // <paging_state> is a [bytes]
 // <serial_consistency> is a [short]
 // <timestamp> is a [long]
 // <keyspace> is a [string]
+// <continuous_paging_options> is <max_pages><pages_per_second>[<next_pages>] (DSE)
+// where each option is an [int] and <next_pages> is only sent for DSEv2
 int32_t Statement::encode_end(ProtocolVersion version, RequestCallback* callback,
                               BufferVec* bufs) const {
   int32_t length = 0;
   size_t paging_buf_size = 0;
 
-  bool with_keyspace = this->with_keyspace(version);
+  const String& paging_state = this->paging_state(callback);
+
+  const String& keyspace = callback->keyspace();
+  bool with_keyspace = this->with_keyspace(version, callback);
 
   if (page_size() > 0) {
     paging_buf_size += sizeof(int32_t); // [int]
   }
 
-  if (!paging_state().empty()) {
-    paging_buf_size += sizeof(int32_t) + paging_state().size(); // [bytes]
+  if (!paging_state.empty()) {
+    paging_buf_size += sizeof(int32_t) + paging_state.size(); // [bytes]
   }
 
   if (callback->serial_consistency() != 0) {
@@ -482,7 +713,15 @@ int32_t Statement::encode_end(ProtocolVersion version, RequestCallback* callback
   }
 
   if (with_keyspace) {
-    paging_buf_size += sizeof(uint16_t) + keyspace().size();
+    paging_buf_size += sizeof(uint16_t) + keyspace.size();
+  }
+
+  bool with_next_pages = version >= CASS_PROTOCOL_VERSION_DSEV2;
+  if (callback->is_continuous_paging()) {
+    paging_buf_size += 2 * sizeof(int32_t); // [int][int]
+    if (with_next_pages) {
+      paging_buf_size += sizeof(int32_t); // [int]
+    }
   }
 
   if (paging_buf_size > 0) {
@@ -496,8 +735,8 @@ int32_t Statement::encode_end(ProtocolVersion version, RequestCallback* callback
       pos = buf.encode_int32(pos, page_size());
     }
 
-    if (!paging_state().empty()) {
-      pos = buf.encode_bytes(pos, paging_state().data(), paging_state().size());
+    if (!paging_state.empty()) {
+      pos = buf.encode_bytes(pos, paging_state.data(), paging_state.size());
     }
 
     if (callback->serial_consistency() != 0) {
@@ -509,13 +748,28 @@ int32_t Statement::encode_end(ProtocolVersion version, RequestCallback* callback
     }
 
     if (with_keyspace) {
-      pos = buf.encode_string(pos, keyspace().data(), static_cast<uint16_t>(keyspace().size()));
+      pos = buf.encode_string(pos, keyspace.data(), static_cast<uint16_t>(keyspace.size()));
+    }
+
+    if (callback->is_continuous_paging()) {
+      const ContinuousPagingOptions& options = callback->continuous_paging_options();
+      pos = buf.encode_int32(pos, options.max_pages);
+      pos = buf.encode_int32(pos, options.pages_per_second);
+      if (with_next_pages) {
+        pos = buf.encode_int32(pos, options.max_enqueued_pages);
+      }
     }
   }
 
   return length;
 }
 
+const String& Statement::paging_state(RequestCallback* callback) const {
+  // A prefetched page's paging state overrides the statement's
+  const String& paging_state = callback->paging_state();
+  return paging_state.empty() ? paging_state_ : paging_state;
+}
+
 bool Statement::calculate_routing_key(const Vector<size_t>& key_indices,
                                       String* routing_key) const {
   if (key_indices.empty()) return false;
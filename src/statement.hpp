@@ -69,6 +69,49 @@ public:
 
   void set_paging_state(const String& paging_state) { paging_state_ = paging_state; }
 
+  bool paging_prefetch() const { return paging_prefetch_; }
+
+  void set_paging_prefetch(bool paging_prefetch) { paging_prefetch_ = paging_prefetch; }
+
+  CassRowCallback row_callback() const { return row_callback_; }
+  void* row_callback_data() const { return row_callback_data_; }
+
+  void set_row_callback(CassRowCallback callback, void* data) {
+    row_callback_ = callback;
+    row_callback_data_ = data;
+  }
+
+  uint64_t result_cache_ttl_ms() const { return result_cache_ttl_ms_; }
+
+  void set_result_cache_ttl_ms(uint64_t ttl_ms) { result_cache_ttl_ms_ = ttl_ms; }
+
+  bool is_reusable() const { return is_reusable_; }
+
+  void set_reusable(bool is_reusable) {
+    is_reusable_ = is_reusable;
+    if (!is_reusable) copies_.clear();
+  }
+
+  /**
+   * Get the request that's executed for the statement. A reusable statement
+   * is executed as a copy of its current state so that it can be rebound and
+   * executed again while previous executions are in flight. The copies are
+   * kept by the statement and reused once their executions complete.
+   *
+   * @return The statement itself or a copy of it.
+   */
+  Request::ConstPtr execution_request() const;
+
+  /**
+   * Get the key of the statement's result in the result cache: the prepared
+   * ID, consistencies, page size, tracing, execution profile, target host,
+   * custom payload and the bound values.
+   *
+   * @param key The result's key (output).
+   * @return false if the statement's result can't be cached.
+   */
+  bool result_cache_key(String* key) const;
+
   uint8_t kind() const {
     return opcode() == CQL_OPCODE_QUERY ? CASS_BATCH_KIND_QUERY : CASS_BATCH_KIND_PREPARED;
   }
@@ -81,8 +124,13 @@ public:
 
   int32_t encode_batch(ProtocolVersion version, RequestCallback* callback, BufferVec* bufs) const;
 
+  // The size of the statement when it's encoded in a batch
+  size_t encoded_batch_size() const {
+    return sizeof(uint8_t) + query_or_id_.size() + sizeof(uint16_t) + get_buffers_size();
+  }
+
 protected:
-  bool with_keyspace(ProtocolVersion version) const;
+  bool with_keyspace(ProtocolVersion version, RequestCallback* callback) const;
 
   int32_t encode_query_or_id(BufferVec* bufs) const;
   int32_t encode_begin(ProtocolVersion version, uint16_t element_count, RequestCallback* callback,
@@ -92,12 +140,28 @@ protected:
 
   bool calculate_routing_key(const Vector<size_t>& key_indices, String* routing_key) const;
 
+  const String& paging_state(RequestCallback* callback) const;
+
+  // A new statement, of the same kind, that a reusable statement is copied to
+  // or NULL if the statement can't be copied.
+  virtual Statement* new_copy() const { return NULL; }
+
+private:
+  void copy_to(Statement* statement) const;
+
 private:
   Buffer query_or_id_;
   int32_t flags_;
   int32_t page_size_;
   String paging_state_;
+  bool paging_prefetch_;
+  CassRowCallback row_callback_;
+  void* row_callback_data_;
+  uint64_t result_cache_ttl_ms_;
   Vector<size_t> key_indices_;
+  bool is_reusable_;
+  mutable Vector<Statement::Ptr> copies_;
+  mutable size_t next_copy_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(Statement);
@@ -0,0 +1,185 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "statement_template.hpp"
+
+#include "constants.hpp"
+#include "execute_request.hpp"
+#include "request_callback.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+extern "C" {
+
+CassStatementTemplate* cass_statement_template_new(const CassStatement* statement) {
+  if (statement->opcode() != CQL_OPCODE_EXECUTE) {
+    return NULL;
+  }
+  StatementTemplate* statement_template =
+      new StatementTemplate(static_cast<const ExecuteRequest*>(statement->from()));
+  statement_template->inc_ref();
+  return CassStatementTemplate::to(statement_template);
+}
+
+void cass_statement_template_free(const CassStatementTemplate* statement_template) {
+  statement_template->dec_ref();
+}
+
+CassStatement* cass_statement_template_bind(const CassStatementTemplate* statement_template) {
+  ExecuteRequest* execute = statement_template->bind();
+  execute->inc_ref();
+  return CassStatement::to(execute);
+}
+
+} // extern "C"
+
+StatementTemplate::StatementTemplate(const ExecuteRequest* statement)
+    : prepared_(statement->prepared())
+    , settings_(statement->settings())
+    , is_tracing_((statement->flags() & CASS_FLAG_TRACING) != 0)
+    , page_size_(statement->page_size())
+    , timestamp_(statement->timestamp())
+    , execution_profile_name_(statement->execution_profile_name())
+    , execution_profile_handle_(statement->execution_profile_handle())
+    , custom_payload_(statement->custom_payload())
+    , elements_(statement->elements()) {
+  for (int i = 0; i < LAYOUT_COUNT; ++i) {
+    encode_layout(i, &layouts_[i]);
+  }
+}
+
+ExecuteRequest* StatementTemplate::bind() const {
+  ExecuteRequest* statement = new ExecuteRequest(this);
+  statement->set_settings(settings_);
+  statement->set_tracing(is_tracing_);
+  statement->set_page_size(page_size_);
+  statement->set_timestamp(timestamp_);
+  if (execution_profile_handle_ >= 0) {
+    statement->set_execution_profile_handle(execution_profile_handle_);
+  } else {
+    statement->set_execution_profile_name(execution_profile_name_);
+  }
+  if (custom_payload_) {
+    statement->set_custom_payload(custom_payload_.get());
+  }
+  statement->set_elements(elements_);
+  return statement;
+}
+
+// The layouts are small enough to be stored inline by Buffer so copies can be
+// patched without affecting the template.
+int32_t StatementTemplate::encode_begin(ProtocolVersion version, RequestCallback* callback,
+                                        BufferVec* bufs) const {
+  const Layout& layout = layouts_[layout_index(version, callback)];
+  bufs->push_back(layout.begin);
+  bufs->back().encode_uint16(0, callback->consistency());
+  return static_cast<int32_t>(layout.begin.size());
+}
+
+int32_t StatementTemplate::encode_end(ProtocolVersion version, RequestCallback* callback,
+                                      BufferVec* bufs) const {
+  const int index = layout_index(version, callback);
+  const Layout& layout = layouts_[index];
+  if (layout.end.size() == 0) {
+    return 0;
+  }
+
+  bufs->push_back(layout.end);
+  Buffer& buf = bufs->back();
+  if (index & LAYOUT_SERIAL_CONSISTENCY) {
+    buf.encode_uint16(layout.serial_consistency_offset, callback->serial_consistency());
+  }
+  if (index & LAYOUT_TIMESTAMP) {
+    buf.encode_int64(layout.timestamp_offset, callback->timestamp());
+  }
+  return static_cast<int32_t>(layout.end.size());
+}
+
+int StatementTemplate::layout_index(ProtocolVersion version, RequestCallback* callback) {
+  int index = 0;
+  if (version >= CASS_PROTOCOL_VERSION_V5) {
+    index |= LAYOUT_PROTOCOL_V5;
+  }
+  if (callback->skip_metadata()) {
+    index |= LAYOUT_SKIP_METADATA;
+  }
+  if (callback->serial_consistency() != 0) {
+    index |= LAYOUT_SERIAL_CONSISTENCY;
+  }
+  if (callback->timestamp() != CASS_INT64_MIN) {
+    index |= LAYOUT_TIMESTAMP;
+  }
+  return index;
+}
+
+// This mirrors Statement::encode_begin() and Statement::encode_end() with
+// placeholders for the values that are patched for each execution.
+void StatementTemplate::encode_layout(int index, Layout* layout) const {
+  const bool is_v5 = (index & LAYOUT_PROTOCOL_V5) != 0;
+  const uint16_t element_count = static_cast<uint16_t>(elements_.size());
+  int32_t flags = 0;
+
+  size_t begin_size = sizeof(uint16_t); // <consistency> [short]
+  begin_size += is_v5 ? sizeof(int32_t) : sizeof(uint8_t); // <flags> [int] or [byte]
+
+  if (element_count > 0) {
+    begin_size += sizeof(uint16_t); // <n> [short]
+    flags |= CASS_QUERY_FLAG_VALUES;
+  }
+
+  if (index & LAYOUT_SKIP_METADATA) {
+    flags |= CASS_QUERY_FLAG_SKIP_METADATA;
+  }
+
+  size_t end_size = 0;
+  layout->serial_consistency_offset = 0;
+  layout->timestamp_offset = 0;
+
+  if (page_size_ > 0) {
+    end_size += sizeof(int32_t); // <result_page_size> [int]
+    flags |= CASS_QUERY_FLAG_PAGE_SIZE;
+  }
+
+  if (index & LAYOUT_SERIAL_CONSISTENCY) {
+    layout->serial_consistency_offset = end_size;
+    end_size += sizeof(uint16_t); // <serial_consistency> [short]
+    flags |= CASS_QUERY_FLAG_SERIAL_CONSISTENCY;
+  }
+
+  if (index & LAYOUT_TIMESTAMP) {
+    layout->timestamp_offset = end_size;
+    end_size += sizeof(int64_t); // <timestamp> [long]
+    flags |= CASS_QUERY_FLAG_DEFAULT_TIMESTAMP;
+  }
+
+  layout->begin = Buffer(begin_size);
+  size_t pos = layout->begin.encode_uint16(0, 0); // Consistency placeholder
+  if (is_v5) {
+    pos = layout->begin.encode_int32(pos, flags);
+  } else {
+    pos = layout->begin.encode_byte(pos, static_cast<uint8_t>(flags));
+  }
+  if (element_count > 0) {
+    layout->begin.encode_uint16(pos, element_count);
+  }
+
+  layout->end = Buffer(end_size);
+  if (page_size_ > 0) {
+    layout->end.encode_int32(0, page_size_);
+  }
+}
@@ -0,0 +1,103 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_STATEMENT_TEMPLATE_HPP
+#define DATASTAX_INTERNAL_STATEMENT_TEMPLATE_HPP
+
+#include "abstract_data.hpp"
+#include "buffer.hpp"
+#include "external.hpp"
+#include "prepared.hpp"
+#include "protocol.hpp"
+#include "ref_counted.hpp"
+#include "request.hpp"
+#include "string.hpp"
+
+namespace datastax { namespace internal { namespace core {
+
+class ExecuteRequest;
+class RequestCallback;
+
+/**
+ * An immutable snapshot of a bound statement used to create new bound
+ * statements cheaply. The parts of the frame that don't change between
+ * executions (the query parameters' consistency, flags and value count, and
+ * the page size, serial consistency and timestamp that follow the values) are
+ * encoded once for every combination of flags. Encoding a statement created
+ * from a template copies one of these layouts and patches the consistency,
+ * serial consistency and timestamp in place, which is repeated cheaply for
+ * every retry and speculative execution.
+ */
+class StatementTemplate : public RefCounted<StatementTemplate> {
+public:
+  typedef SharedRefPtr<const StatementTemplate> ConstPtr;
+
+  StatementTemplate(const ExecuteRequest* statement);
+
+  const Prepared::ConstPtr& prepared() const { return prepared_; }
+
+  /**
+   * Create a new bound statement with the template's settings and values.
+   *
+   * @return A new bound statement. Its reference count is zero.
+   */
+  ExecuteRequest* bind() const;
+
+  // The pre-encoded layouts can only be used by statements that have the
+  // same page size as the template and no paging state.
+  int32_t page_size() const { return page_size_; }
+
+  int32_t encode_begin(ProtocolVersion version, RequestCallback* callback, BufferVec* bufs) const;
+  int32_t encode_end(ProtocolVersion version, RequestCallback* callback, BufferVec* bufs) const;
+
+private:
+  enum {
+    LAYOUT_PROTOCOL_V5 = 0x01,
+    LAYOUT_SKIP_METADATA = 0x02,
+    LAYOUT_SERIAL_CONSISTENCY = 0x04,
+    LAYOUT_TIMESTAMP = 0x08,
+    LAYOUT_COUNT = 0x10
+  };
+
+  struct Layout {
+    Buffer begin; // <consistency><flags>[<n>]
+    Buffer end;   // [<result_page_size>][<serial_consistency>][<timestamp>]
+    size_t serial_consistency_offset;
+    size_t timestamp_offset;
+  };
+
+  static int layout_index(ProtocolVersion version, RequestCallback* callback);
+
+  void encode_layout(int index, Layout* layout) const;
+
+private:
+  Prepared::ConstPtr prepared_;
+  RequestSettings settings_;
+  bool is_tracing_;
+  int32_t page_size_;
+  int64_t timestamp_;
+  String execution_profile_name_;
+  int32_t execution_profile_handle_;
+  CustomPayload::ConstPtr custom_payload_;
+  AbstractData::ElementVec elements_;
+  Layout layouts_[LAYOUT_COUNT];
+};
+
+}}} // namespace datastax::internal::core
+
+EXTERNAL_TYPE(datastax::internal::core::StatementTemplate, CassStatementTemplate)
+
+#endif
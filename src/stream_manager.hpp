@@ -18,9 +18,9 @@
 #define DATASTAX_INTERNAL_STREAM_MANAGER_HPP
 
 #include "constants.hpp"
-#include "dense_hash_map.hpp"
 #include "macros.hpp"
 #include "scoped_ptr.hpp"
+#include "vector.hpp"
 
 #include <assert.h>
 #include <stdint.h>
@@ -32,57 +32,72 @@
 
 namespace datastax { namespace internal { namespace core {
 
-struct StreamHash {
-  std::size_t operator()(int stream) const { return ((stream & 0x3F) << 10) | (stream >> 6); }
-};
-
+/**
+ * Tracks the in-flight stream IDs of a connection and the item (usually a
+ * callback) that's waiting on each of them. Stream IDs are small, dense
+ * integers so items are stored in arrays indexed by stream ID, one for each
+ * word of the bitmap. Free stream IDs are tracked using a two-level bitmap: a
+ * bit is set in the summary for each word that contains at least one free
+ * stream so that a free stream is found by scanning a handful of summary
+ * words, even when the connection is close to saturation.
+ *
+ * Streams are only taken from a new word once all the words in use are full,
+ * so the items' arrays are allocated as the connection's concurrency grows
+ * and most connections only use a few words of the ID space.
+ */
 template <class T>
 class StreamManager {
 public:
   StreamManager()
       : max_streams_(CASS_MAX_STREAMS)
       , num_words_(max_streams_ / NUM_BITS_PER_WORD)
+      , num_summary_words_((num_words_ + NUM_BITS_PER_WORD - 1) / NUM_BITS_PER_WORD)
       , offset_(0)
-      , words_(num_words_, ~static_cast<word_t>(0)) {
-    // Client request stream IDs are always positive values so it's
-    // safe to use negative values for the empty and deleted keys.
-    pending_.set_empty_key(-1);
-    pending_.set_deleted_key(-2);
-    pending_.max_load_factor(0.4f);
+      , pending_count_(0)
+      , words_(num_words_, ~static_cast<word_t>(0))
+      , summary_(num_summary_words_, 0) {
+    pending_.reserve(num_words_);
+    add_word();
+  }
+
+  ~StreamManager() {
+    for (typename Vector<T*>::iterator it = pending_.begin(), end = pending_.end(); it != end;
+         ++it) {
+      delete[] *it;
+    }
   }
 
   int acquire(const T& item) {
     int stream = acquire_stream();
     if (stream < 0) return -1;
-    pending_.insert(std::pair<int, T>(stream, item));
+    item_at(stream) = item;
+    ++pending_count_;
     return stream;
   }
 
   void release(int stream) {
     assert(stream >= 0 && static_cast<size_t>(stream) < max_streams_);
-    assert(pending_.count(stream) > 0);
-    pending_.erase(stream);
+    assert(is_pending(stream));
+    item_at(stream) = T();
+    --pending_count_;
     release_stream(stream);
   }
 
   bool get(int stream, T& output) {
-    typename PendingMap::iterator i = pending_.find(stream);
-    if (i != pending_.end()) {
-      output = i->second;
-      return true;
+    if (stream < 0 || static_cast<size_t>(stream) >= max_streams_ || !is_pending(stream)) {
+      return false;
     }
-    return false;
+    output = item_at(stream);
+    return true;
   }
 
-  size_t available_streams() const { return max_streams_ - pending_.size(); }
-  size_t pending_streams() const { return pending_.size(); }
+  size_t available_streams() const { return max_streams_ - pending_count_; }
+  size_t pending_streams() const { return pending_count_; }
   size_t max_streams() const { return max_streams_; }
 
 private:
-  typedef DenseHashMap<int, T, StreamHash> PendingMap;
-
 #if defined(_MSC_VER) && defined(_M_AMD64)
-  typedef __int64 word_t;
+  typedef unsigned __int64 word_t;
 #else
   typedef unsigned long word_t;
 #endif
@@ -107,43 +122,84 @@ private:
 
 private:
   int acquire_stream() {
-    const size_t offset = offset_;
-    const size_t num_words = num_words_;
+    // Rotate the starting word so that streams are spread across the ID space
+    size_t start = offset_++ % pending_.size();
 
-    ++offset_;
-
-    for (size_t i = 0; i < num_words; ++i) {
-      size_t index = (i + offset) % num_words;
-      int bit = get_and_set_first_available_stream(index);
-      if (bit >= 0) {
-        return bit + (NUM_BITS_PER_WORD * index);
-      }
+    int index = find_available_word(start);
+    if (index < 0 && start > 0) {
+      index = find_available_word(0);
+    }
+    if (index < 0) {
+      // All the words in use are full
+      if (pending_.size() == num_words_) return -1;
+      index = static_cast<int>(add_word());
     }
 
-    return -1;
+    word_t& word = words_[index];
+    int bit = count_trailing_zeros(word);
+    word ^= (static_cast<word_t>(1) << bit);
+    if (word == 0) {
+      clear_summary_bit(index);
+    }
+    return bit + static_cast<int>(NUM_BITS_PER_WORD * index);
   }
 
   inline void release_stream(int stream) {
     size_t index = stream / NUM_BITS_PER_WORD;
     int bit = stream % NUM_BITS_PER_WORD;
     assert((words_[index] & (static_cast<word_t>(1) << (bit))) == 0);
+    if (words_[index] == 0) {
+      set_summary_bit(index);
+    }
     words_[index] |= (static_cast<word_t>(1) << (bit));
   }
 
-  inline int get_and_set_first_available_stream(size_t index) {
-    word_t word = words_[index];
-    if (word == 0) return -1;
-    int stream = count_trailing_zeros(word);
-    words_[index] ^= (static_cast<word_t>(1) << stream);
-    return stream;
+  // Start using the next word of the ID space
+  size_t add_word() {
+    size_t index = pending_.size();
+    pending_.push_back(new T[NUM_BITS_PER_WORD]);
+    set_summary_bit(index);
+    return index;
+  }
+
+  inline T& item_at(int stream) {
+    return pending_[stream / NUM_BITS_PER_WORD][stream % NUM_BITS_PER_WORD];
+  }
+
+  inline bool is_pending(int stream) const {
+    return (words_[stream / NUM_BITS_PER_WORD] &
+            (static_cast<word_t>(1) << (stream % NUM_BITS_PER_WORD))) == 0;
+  }
+
+  // Find the first word, starting at the given word, with a free stream
+  inline int find_available_word(size_t start) const {
+    size_t summary_index = start / NUM_BITS_PER_WORD;
+    word_t summary =
+        summary_[summary_index] & (~static_cast<word_t>(0) << (start % NUM_BITS_PER_WORD));
+    while (summary == 0) {
+      if (++summary_index >= num_summary_words_) return -1;
+      summary = summary_[summary_index];
+    }
+    return static_cast<int>(summary_index * NUM_BITS_PER_WORD + count_trailing_zeros(summary));
+  }
+
+  inline void set_summary_bit(size_t index) {
+    summary_[index / NUM_BITS_PER_WORD] |= (static_cast<word_t>(1) << (index % NUM_BITS_PER_WORD));
+  }
+
+  inline void clear_summary_bit(size_t index) {
+    summary_[index / NUM_BITS_PER_WORD] &= ~(static_cast<word_t>(1) << (index % NUM_BITS_PER_WORD));
   }
 
 private:
   const size_t max_streams_;
   const size_t num_words_;
+  const size_t num_summary_words_;
   size_t offset_;
+  size_t pending_count_;
   Vector<word_t> words_;
-  PendingMap pending_;
+  Vector<word_t> summary_;
+  Vector<T*> pending_; // The items of the words in use
 
 private:
   DISALLOW_COPY_AND_ASSIGN(StreamManager);
@@ -158,6 +158,10 @@ inline bool ends_with(const StringRef& input, const StringRef& target) {
 
 inline bool iequals(const StringRef& lhs, const StringRef& rhs) { return lhs.iequals(rhs); }
 
+struct StringRefHash {
+  std::size_t operator()(const StringRef& s) const { return hash::fnv1a(s.data(), s.size()); }
+};
+
 struct StringRefIHash {
   std::size_t operator()(const StringRef& s) const {
     return hash::fnv1a(s.data(), s.size(), ::tolower);
@@ -0,0 +1,240 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "struct_encoder.hpp"
+
+#include "serialization.hpp"
+
+#include <string.h>
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+extern "C" {
+
+CassStructEncoder* cass_struct_encoder_new(const CassDataType* data_type) {
+  if (!data_type->is_user_type() && !data_type->is_tuple()) {
+    return NULL;
+  }
+  return CassStructEncoder::to(new StructEncoder(DataType::ConstPtr(data_type)));
+}
+
+void cass_struct_encoder_free(CassStructEncoder* encoder) { delete encoder->from(); }
+
+CassError cass_struct_encoder_set_field(CassStructEncoder* encoder, size_t index, size_t offset) {
+  return encoder->set_field(index, offset);
+}
+
+CassError cass_struct_encoder_set_field_by_name(CassStructEncoder* encoder, const char* name,
+                                                size_t offset) {
+  return encoder->set_field(StringRef(name), offset);
+}
+
+CassError cass_struct_encoder_set_field_by_name_n(CassStructEncoder* encoder, const char* name,
+                                                  size_t name_length, size_t offset) {
+  return encoder->set_field(StringRef(name, name_length), offset);
+}
+
+} // extern "C"
+
+namespace {
+
+template <class T>
+inline T load(const char* value) {
+  T temp;
+  memcpy(&temp, value, sizeof(T)); // The struct's members might not be aligned
+  return temp;
+}
+
+template <class T, char* (*Encode)(char*, T)>
+char* encode_fixed(const char* value, char* output) {
+  output = encode_int32(output, sizeof(T));
+  return Encode(output, load<T>(value));
+}
+
+char* encode_bool(const char* value, char* output) {
+  output = encode_int32(output, 1);
+  return encode_int8(output, load<cass_bool_t>(value) ? 1 : 0);
+}
+
+char* encode_inet(const char* value, char* output) {
+  CassInet inet(load<CassInet>(value));
+  output = encode_int32(output, inet.address_length);
+  memcpy(output, inet.address, inet.address_length);
+  return output + inet.address_length;
+}
+
+char* encode_string(const char* value, char* output) {
+  const char* str = load<const char*>(value);
+  if (str == NULL) {
+    return encode_int32(output, -1); // null
+  }
+  size_t length = strlen(str);
+  output = encode_int32(output, length);
+  memcpy(output, str, length);
+  return output + length;
+}
+
+} // namespace
+
+StructEncoder::StructEncoder(const DataType::ConstPtr& data_type)
+    : data_type_(data_type)
+    , fixed_size_(0) {
+  size_t count;
+  if (data_type_->is_user_type()) {
+    count = static_cast<const UserType*>(data_type_.get())->fields().size();
+  } else {
+    count = static_cast<const TupleType*>(data_type_.get())->types().size();
+  }
+  fields_.resize(count);
+  fixed_size_ = count * sizeof(int32_t); // All fields are null until they're mapped
+}
+
+CassError StructEncoder::set_field(size_t index, size_t offset) {
+  if (index >= fields_.size()) {
+    return CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS;
+  }
+
+  const DataType::ConstPtr& type =
+      data_type_->is_user_type()
+          ? static_cast<const UserType*>(data_type_.get())->fields()[index].type
+          : static_cast<const TupleType*>(data_type_.get())->types()[index];
+
+  Field field;
+  field.offset = offset;
+
+  switch (type->value_type()) {
+    case CASS_VALUE_TYPE_TINY_INT:
+      field.encode = encode_fixed<int8_t, encode_int8>;
+      field.size += sizeof(int8_t);
+      break;
+    case CASS_VALUE_TYPE_SMALL_INT:
+      field.encode = encode_fixed<int16_t, encode_int16>;
+      field.size += sizeof(int16_t);
+      break;
+    case CASS_VALUE_TYPE_INT:
+      field.encode = encode_fixed<int32_t, encode_int32>;
+      field.size += sizeof(int32_t);
+      break;
+    case CASS_VALUE_TYPE_DATE:
+      field.encode = encode_fixed<uint32_t, encode_uint32>;
+      field.size += sizeof(uint32_t);
+      break;
+    case CASS_VALUE_TYPE_BIGINT:
+    case CASS_VALUE_TYPE_COUNTER:
+    case CASS_VALUE_TYPE_TIMESTAMP:
+    case CASS_VALUE_TYPE_TIME:
+      field.encode = encode_fixed<int64_t, encode_int64>;
+      field.size += sizeof(int64_t);
+      break;
+    case CASS_VALUE_TYPE_FLOAT:
+      field.encode = encode_fixed<float, encode_float>;
+      field.size += sizeof(float);
+      break;
+    case CASS_VALUE_TYPE_DOUBLE:
+      field.encode = encode_fixed<double, encode_double>;
+      field.size += sizeof(double);
+      break;
+    case CASS_VALUE_TYPE_BOOLEAN:
+      field.encode = encode_bool;
+      field.size += 1;
+      break;
+    case CASS_VALUE_TYPE_UUID:
+    case CASS_VALUE_TYPE_TIMEUUID:
+      field.encode = encode_fixed<CassUuid, encode_uuid>;
+      field.size += sizeof(CassUuid);
+      break;
+    case CASS_VALUE_TYPE_INET:
+      // The address's size is only known when the value is encoded
+      field.encode = encode_inet;
+      field.is_variable_size = true;
+      break;
+    case CASS_VALUE_TYPE_ASCII:
+    case CASS_VALUE_TYPE_TEXT:
+    case CASS_VALUE_TYPE_VARCHAR:
+      field.encode = encode_string;
+      field.is_variable_size = true;
+      break;
+    default:
+      return CASS_ERROR_LIB_INVALID_VALUE_TYPE;
+  }
+
+  fixed_size_ -= fields_[index].size;
+  fixed_size_ += field.size;
+  fields_[index] = field;
+
+  return CASS_OK;
+}
+
+CassError StructEncoder::set_field(StringRef name, size_t offset) {
+  if (!data_type_->is_user_type()) {
+    return CASS_ERROR_LIB_NAME_DOES_NOT_EXIST;
+  }
+
+  IndexVec indices;
+  if (static_cast<const UserType*>(data_type_.get())->get_indices(name, &indices) == 0) {
+    return CASS_ERROR_LIB_NAME_DOES_NOT_EXIST;
+  }
+
+  for (IndexVec::const_iterator it = indices.begin(), end = indices.end(); it != end; ++it) {
+    CassError rc = set_field(*it, offset);
+    if (rc != CASS_OK) return rc;
+  }
+
+  return CASS_OK;
+}
+
+size_t StructEncoder::get_size(const char* data) const {
+  size_t size = fixed_size_;
+  for (FieldVec::const_iterator it = fields_.begin(), end = fields_.end(); it != end; ++it) {
+    if (!it->is_variable_size) continue;
+    const char* value = data + it->offset;
+    if (it->encode == encode_inet) {
+      size += load<CassInet>(value).address_length;
+    } else {
+      const char* str = load<const char*>(value);
+      if (str != NULL) size += strlen(str);
+    }
+  }
+  return size;
+}
+
+char* StructEncoder::encode(const char* data, char* output) const {
+  for (FieldVec::const_iterator it = fields_.begin(), end = fields_.end(); it != end; ++it) {
+    if (it->encode) {
+      output = it->encode(data + it->offset, output);
+    } else {
+      output = encode_int32(output, -1); // null
+    }
+  }
+  return output;
+}
+
+Buffer StructEncoder::encode(const void* data) const {
+  const char* pos = static_cast<const char*>(data);
+  Buffer buf(get_size(pos));
+  encode(pos, buf.data());
+  return buf;
+}
+
+Buffer StructEncoder::encode_with_length(const void* data) const {
+  const char* pos = static_cast<const char*>(data);
+  size_t size = get_size(pos);
+  Buffer buf(sizeof(int32_t) + size);
+  encode(pos, buf.data() + buf.encode_int32(0, size));
+  return buf;
+}
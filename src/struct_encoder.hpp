@@ -0,0 +1,123 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_STRUCT_ENCODER_HPP
+#define DATASTAX_INTERNAL_STRUCT_ENCODER_HPP
+
+#include "allocated.hpp"
+#include "buffer.hpp"
+#include "cassandra.h"
+#include "data_type.hpp"
+#include "external.hpp"
+#include "macros.hpp"
+#include "string_ref.hpp"
+#include "vector.hpp"
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * Encodes user defined type or tuple values directly from the memory of an
+ * application's structs. Each of the type's fields is mapped to an offset in
+ * the struct and the field's encoding function is selected once, when it's
+ * mapped, using the field's CQL type. Encoding a value is then a single loop
+ * over the fields writing into one buffer. Fields that aren't mapped are
+ * encoded as null.
+ *
+ * The struct's members use the same C types as the driver's bind functions
+ * e.g. "bigint" is a `cass_int64_t` and "uuid" is a `CassUuid`. Text fields
+ * are a `const char*` to a null-terminated string, or NULL for a null value.
+ */
+class StructEncoder : public Allocated {
+public:
+  /**
+   * Constructor.
+   *
+   * @param data_type A user defined type or a tuple.
+   */
+  explicit StructEncoder(const DataType::ConstPtr& data_type);
+
+  const DataType::ConstPtr& data_type() const { return data_type_; }
+
+  /**
+   * Map a field to an offset in the struct.
+   *
+   * @param index The field's index in the type.
+   * @param offset The offset of the field's value in the struct.
+   * @return CASS_OK if successful, otherwise an error occurred.
+   */
+  CassError set_field(size_t index, size_t offset);
+
+  /**
+   * Map the fields with a name to an offset in the struct.
+   *
+   * @param name
+   * @param offset
+   * @return CASS_OK if successful, otherwise an error occurred.
+   */
+  CassError set_field(StringRef name, size_t offset);
+
+  /**
+   * Get the size of a struct's encoded value (without its length).
+   *
+   * @param data The struct.
+   * @return The size in bytes.
+   */
+  size_t get_size(const char* data) const;
+
+  /**
+   * Encode a struct's value (without its length).
+   *
+   * @param data The struct.
+   * @param output A buffer of at least get_size() bytes.
+   * @return The end of the encoded value.
+   */
+  char* encode(const char* data, char* output) const;
+
+  Buffer encode(const void* data) const;
+  Buffer encode_with_length(const void* data) const;
+
+private:
+  typedef char* (*EncodeFunc)(const char* value, char* output);
+
+  struct Field {
+    Field()
+        : offset(0)
+        , encode(NULL)
+        , size(sizeof(int32_t))
+        , is_variable_size(false) {}
+
+    size_t offset;
+    EncodeFunc encode; // NULL if the field isn't mapped
+    size_t size;       // The encoded size without variable-size data
+    bool is_variable_size;
+  };
+
+  typedef Vector<Field> FieldVec;
+
+private:
+  DataType::ConstPtr data_type_;
+  FieldVec fields_;
+  size_t fixed_size_; // The encoded size of all the fields except strings
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(StructEncoder);
+};
+
+}}} // namespace datastax::internal::core
+
+EXTERNAL_TYPE(datastax::internal::core::StructEncoder, CassStructEncoder)
+
+#endif
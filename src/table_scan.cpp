@@ -0,0 +1,378 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "table_scan.hpp"
+
+#include "constants.hpp"
+#include "logger.hpp"
+#include "metadata.hpp"
+#include "query_request.hpp"
+#include "request_handler.hpp"
+#include "session.hpp"
+#include "utils.hpp"
+
+#include <algorithm>
+
+using namespace datastax;
+using namespace datastax::internal::core;
+
+extern "C" {
+
+CassTableScan* cass_table_scan_new(const char* keyspace, const char* table) {
+  return cass_table_scan_new_n(keyspace, SAFE_STRLEN(keyspace), table, SAFE_STRLEN(table));
+}
+
+CassTableScan* cass_table_scan_new_n(const char* keyspace, size_t keyspace_length,
+                                     const char* table, size_t table_length) {
+  TableScan* scan = new TableScan(String(keyspace, keyspace_length), String(table, table_length));
+  scan->inc_ref();
+  return CassTableScan::to(scan);
+}
+
+void cass_table_scan_free(CassTableScan* scan) { scan->dec_ref(); }
+
+CassError cass_table_scan_set_columns(CassTableScan* scan, const char* columns) {
+  return cass_table_scan_set_columns_n(scan, columns, SAFE_STRLEN(columns));
+}
+
+CassError cass_table_scan_set_columns_n(CassTableScan* scan, const char* columns,
+                                        size_t columns_length) {
+  return scan->set_columns(String(columns, columns_length));
+}
+
+CassError cass_table_scan_set_concurrency(CassTableScan* scan, unsigned concurrency) {
+  return scan->set_concurrency(concurrency);
+}
+
+CassError cass_table_scan_set_paging_size(CassTableScan* scan, int paging_size) {
+  return scan->set_paging_size(paging_size);
+}
+
+CassError cass_table_scan_set_consistency(CassTableScan* scan, CassConsistency consistency) {
+  return scan->set_consistency(consistency);
+}
+
+CassError cass_table_scan_set_callback(CassTableScan* scan, CassTableScanCallback callback,
+                                       void* data) {
+  return scan->set_callback(callback, data);
+}
+
+CassError cass_session_scan_table(CassSession* session, CassTableScan* scan) {
+  return scan->start(session->from());
+}
+
+const CassResult* cass_table_scan_next_page(CassTableScan* scan) {
+  ResultResponse::Ptr result(scan->next_page());
+  if (!result) return NULL;
+  result->inc_ref();
+  return CassResult::to(result.get());
+}
+
+CassError cass_table_scan_error_code(CassTableScan* scan) { return scan->error_code(); }
+
+void cass_table_scan_error_message(CassTableScan* scan, const char** message,
+                                   size_t* message_length) {
+  // The message can't change once the scan has failed
+  const String& m = scan->error_message();
+  *message = m.data();
+  *message_length = m.length();
+}
+
+} // extern "C"
+
+TableScan::TableScan(const String& keyspace, const String& table)
+    : keyspace_(keyspace)
+    , table_(table)
+    , columns_("*")
+    , concurrency_(CASS_DEFAULT_TABLE_SCAN_CONCURRENCY)
+    , paging_size_(CASS_DEFAULT_TABLE_SCAN_PAGING_SIZE)
+    , consistency_(CASS_CONSISTENCY_UNKNOWN)
+    , callback_(NULL)
+    , data_(NULL)
+    , is_started_(false)
+    , session_(NULL)
+    , next_range_(0)
+    , active_ranges_(0)
+    , error_code_(CASS_OK) {
+  uv_mutex_init(&mutex_);
+  uv_cond_init(&cond_);
+}
+
+TableScan::~TableScan() {
+  uv_mutex_destroy(&mutex_);
+  uv_cond_destroy(&cond_);
+}
+
+CassError TableScan::set_columns(const String& columns) {
+  if (is_started_) return CASS_ERROR_LIB_INVALID_STATE;
+  if (columns.empty()) return CASS_ERROR_LIB_BAD_PARAMS;
+  columns_ = columns;
+  return CASS_OK;
+}
+
+CassError TableScan::set_concurrency(unsigned concurrency) {
+  if (is_started_) return CASS_ERROR_LIB_INVALID_STATE;
+  if (concurrency == 0) return CASS_ERROR_LIB_BAD_PARAMS;
+  concurrency_ = concurrency;
+  return CASS_OK;
+}
+
+CassError TableScan::set_paging_size(int32_t paging_size) {
+  if (is_started_) return CASS_ERROR_LIB_INVALID_STATE;
+  if (paging_size <= 0) return CASS_ERROR_LIB_BAD_PARAMS;
+  paging_size_ = paging_size;
+  return CASS_OK;
+}
+
+CassError TableScan::set_consistency(CassConsistency consistency) {
+  if (is_started_) return CASS_ERROR_LIB_INVALID_STATE;
+  consistency_ = consistency;
+  return CASS_OK;
+}
+
+CassError TableScan::set_callback(Callback callback, void* data) {
+  if (is_started_) return CASS_ERROR_LIB_INVALID_STATE;
+  callback_ = callback;
+  data_ = data;
+  return CASS_OK;
+}
+
+CassError TableScan::start(Session* session) {
+  if (is_started_) {
+    return CASS_ERROR_LIB_INVALID_STATE;
+  }
+
+  if (session->state() != SessionBase::SESSION_STATE_CONNECTED) {
+    set_error(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, "Session is not connected");
+    return error_code_;
+  }
+
+  Metadata::SchemaSnapshot schema(session->cluster()->schema_snapshot());
+  const KeyspaceMetadata* keyspace = schema.get_keyspace(keyspace_);
+  const TableMetadata* table = keyspace ? keyspace->get_table(table_) : NULL;
+  if (table == NULL) {
+    set_error(CASS_ERROR_LIB_BAD_PARAMS,
+              "Unable to find table \"" + keyspace_ + "." + table_ + "\" in the schema metadata");
+    return error_code_;
+  }
+  const ColumnMetadata::Vec& partition_key = table->partition_key();
+  partition_key_.clear();
+  for (ColumnMetadata::Vec::const_iterator it = partition_key.begin(), end = partition_key.end();
+       it != end; ++it) {
+    if (!*it) break; // The partition key is incomplete
+    partition_key_.push_back((*it)->name());
+  }
+  if (partition_key_.empty() || partition_key_.size() != partition_key.size()) {
+    set_error(CASS_ERROR_LIB_BAD_PARAMS,
+              "Unable to determine the partition key of table \"" + keyspace_ + "." + table_ + "\"");
+    return error_code_;
+  }
+
+  TokenMap::Ptr token_map(session->token_map());
+  if (token_map) {
+    token_map->get_token_ranges(keyspace_, ranges_);
+  }
+  if (ranges_.empty()) {
+    set_error(CASS_ERROR_LIB_INVALID_STATE, "No token ranges are available for keyspace \"" +
+                                                keyspace_ +
+                                                "\" (token aware routing must be enabled)");
+    return error_code_;
+  }
+
+  is_started_ = true;
+  session_ = session;
+  local_dc_ = session->cluster()->local_dc();
+
+  LOG_DEBUG("Scanning table \"%s.%s\" using %u token ranges", keyspace_.c_str(), table_.c_str(),
+            static_cast<unsigned>(ranges_.size()));
+
+  size_t count = std::min(static_cast<size_t>(concurrency_), ranges_.size());
+  {
+    ScopedMutex l(&mutex_);
+    next_range_ = active_ranges_ = count;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    execute(i, String(), true);
+  }
+  return CASS_OK;
+}
+
+ResultResponse::Ptr TableScan::next_page() {
+  if (callback_) return ResultResponse::Ptr();
+
+  ScopedMutex l(&mutex_);
+  while (pages_.empty() && active_ranges_ > 0 && error_code_ == CASS_OK) {
+    uv_cond_wait(&cond_, l.get());
+  }
+  if (pages_.empty() || error_code_ != CASS_OK) {
+    return ResultResponse::Ptr();
+  }
+  Page page(pages_.front());
+  pages_.pop_front();
+  l.unlock();
+
+  continue_range(page.range_index, page.paging_state);
+  return page.result;
+}
+
+CassError TableScan::error_code() const {
+  ScopedMutex l(&mutex_);
+  return error_code_;
+}
+
+const String& TableScan::error_message() const {
+  ScopedMutex l(&mutex_);
+  return error_message_;
+}
+
+String TableScan::build_query(const String& keyspace, const String& table, const String& columns,
+                              const StringVec& partition_key, const TokenRange& range) {
+  String token("token(");
+  for (StringVec::const_iterator it = partition_key.begin(), end = partition_key.end(); it != end;
+       ++it) {
+    String name(*it);
+    if (it != partition_key.begin()) token.append(", ");
+    token.append(escape_id(name));
+  }
+  token.append(")");
+
+  String keyspace_id(keyspace);
+  String table_id(table);
+  String query("SELECT " + columns + " FROM " + escape_id(keyspace_id) + "." + escape_id(table_id));
+  if (!range.start.empty()) {
+    query.append(" WHERE " + token + " > " + range.start);
+  }
+  if (!range.end.empty()) {
+    query.append(range.start.empty() ? " WHERE " : " AND ");
+    query.append(token + " <= " + range.end);
+  }
+  return query;
+}
+
+void TableScan::execute(size_t range_index, const String& paging_state, bool pin_to_replica) {
+  const TokenRange& range = ranges_[range_index];
+
+  QueryRequest::Ptr request(
+      new QueryRequest(build_query(keyspace_, table_, columns_, partition_key_, range)));
+  request->set_page_size(paging_size_);
+  request->set_paging_state(paging_state);
+  if (consistency_ != CASS_CONSISTENCY_UNKNOWN) {
+    request->set_consistency(consistency_);
+  }
+
+  // Send the query directly to one of the range's replicas in the local
+  // datacenter, alternating between the replicas for adjacent ranges.
+  bool is_pinned = false;
+  if (pin_to_replica) {
+    HostVec local_replicas;
+    for (HostVec::const_iterator it = range.replicas->begin(), end = range.replicas->end();
+         it != end; ++it) {
+      if (local_dc_.empty() || (*it)->dc() == local_dc_) {
+        local_replicas.push_back(*it);
+      }
+    }
+    if (!local_replicas.empty()) {
+      request->set_host(local_replicas[range_index % local_replicas.size()]->address());
+      is_pinned = true;
+    }
+  }
+
+  Future::Ptr future(session_->execute(Request::ConstPtr(request)));
+  inc_ref(); // Released after the page is handled
+  future->set_callback(on_page, new PageRequest(this, range_index, paging_state, is_pinned));
+}
+
+void TableScan::on_page(CassFuture* future, void* data) {
+  PageRequest* request = static_cast<PageRequest*>(data);
+  TableScan* scan = request->scan;
+  scan->handle_page(request, static_cast<ResponseFuture*>(future->from()));
+  delete request;
+  scan->dec_ref();
+}
+
+void TableScan::handle_page(const PageRequest* request, ResponseFuture* future) {
+  const Future::Error* error = future->error();
+  if (error != NULL) {
+    // The replica might be down so let the load balancing policy choose
+    // another host.
+    if (request->is_pinned && error->code == CASS_ERROR_LIB_NO_HOSTS_AVAILABLE) {
+      execute(request->range_index, request->paging_state, false);
+      return;
+    }
+    set_error(error->code, error->message);
+    ScopedMutex l(&mutex_);
+    finish_range(l);
+    return;
+  }
+
+  Response::Ptr response(future->response());
+  if (!response || response->opcode() != CQL_OPCODE_RESULT ||
+      static_cast<ResultResponse*>(response.get())->kind() != CASS_RESULT_KIND_ROWS) {
+    set_error(CASS_ERROR_LIB_UNEXPECTED_RESPONSE, "Expected a rows result for a table scan query");
+    ScopedMutex l(&mutex_);
+    finish_range(l);
+    return;
+  }
+
+  ResultResponse::Ptr result(response);
+  String paging_state(result->has_more_pages() ? result->paging_state().to_string() : String());
+  if (callback_) {
+    callback_(CassTableScan::to(this), CassResult::to(result.get()), data_);
+    continue_range(request->range_index, paging_state);
+  } else {
+    ScopedMutex l(&mutex_);
+    pages_.push_back(Page(result, request->range_index, paging_state));
+    uv_cond_signal(&cond_);
+  }
+}
+
+void TableScan::continue_range(size_t range_index, const String& paging_state) {
+  ScopedMutex l(&mutex_);
+  if (error_code_ == CASS_OK) {
+    if (!paging_state.empty()) {
+      l.unlock();
+      execute(range_index, paging_state, true);
+      return;
+    }
+    if (next_range_ < ranges_.size()) {
+      size_t next = next_range_++;
+      l.unlock();
+      execute(next, String(), true);
+      return;
+    }
+  }
+  finish_range(l);
+}
+
+void TableScan::set_error(CassError code, const String& message) {
+  ScopedMutex l(&mutex_);
+  if (error_code_ == CASS_OK) {
+    error_code_ = code;
+    error_message_ = message;
+    uv_cond_broadcast(&cond_);
+  }
+}
+
+void TableScan::finish_range(ScopedMutex& l) {
+  if (active_ranges_ > 0 && --active_ranges_ == 0) {
+    uv_cond_broadcast(&cond_);
+    if (callback_) {
+      l.unlock();
+      // Notify the callback that the scan is finished
+      callback_(CassTableScan::to(this), NULL, data_);
+    }
+  }
+}
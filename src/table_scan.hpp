@@ -0,0 +1,157 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_TABLE_SCAN_HPP
+#define DATASTAX_INTERNAL_TABLE_SCAN_HPP
+
+#include "cassandra.h"
+#include "deque.hpp"
+#include "external.hpp"
+#include "future.hpp"
+#include "ref_counted.hpp"
+#include "result_response.hpp"
+#include "scoped_lock.hpp"
+#include "string.hpp"
+#include "token_map.hpp"
+#include "vector.hpp"
+
+#include <uv.h>
+
+namespace datastax { namespace internal { namespace core {
+
+class ResponseFuture;
+class Session;
+
+/**
+ * A full scan of a table that's split into one query per token range. Each
+ * range's query is sent to one of the range's replicas in the local
+ * datacenter and up to a fixed number of ranges are scanned at the same time.
+ * The pages of all the ranges are either queued for an application thread to
+ * take, one at a time, or passed to a callback on the I/O threads.
+ *
+ * A range's next page is only requested once its current page has been taken
+ * (or the callback returns) so the number of buffered pages is bounded by the
+ * concurrency.
+ */
+class TableScan : public RefCounted<TableScan> {
+public:
+  typedef SharedRefPtr<TableScan> Ptr;
+  typedef void (*Callback)(CassTableScan*, const CassResult*, void*);
+
+  TableScan(const String& keyspace, const String& table);
+  ~TableScan();
+
+  CassError set_columns(const String& columns);
+  CassError set_concurrency(unsigned concurrency);
+  CassError set_paging_size(int32_t paging_size);
+  CassError set_consistency(CassConsistency consistency);
+  CassError set_callback(Callback callback, void* data);
+
+  /**
+   * Start scanning the table. The session must stay connected until the scan
+   * is finished.
+   *
+   * @param session A connected session.
+   * @return CASS_OK if the scan was started, otherwise an error. The error
+   * message is available using error_message().
+   */
+  CassError start(Session* session);
+
+  /**
+   * Wait for the next page of the scan. This can't be used with a callback.
+   *
+   * @return The next page or null if the scan is finished or failed.
+   */
+  ResultResponse::Ptr next_page();
+
+  CassError error_code() const;
+  const String& error_message() const;
+
+public:
+  /**
+   * Build the query for a token range of a table.
+   *
+   * @param keyspace The table's keyspace.
+   * @param table The table's name.
+   * @param columns The selected columns.
+   * @param partition_key The names of the table's partition key columns.
+   * @param range The token range.
+   * @return The query.
+   */
+  static String build_query(const String& keyspace, const String& table, const String& columns,
+                            const StringVec& partition_key, const TokenRange& range);
+
+private:
+  struct Page {
+    Page(const ResultResponse::Ptr& result, size_t range_index, const String& paging_state)
+        : result(result)
+        , range_index(range_index)
+        , paging_state(paging_state) {}
+    ResultResponse::Ptr result;
+    size_t range_index;
+    String paging_state; // Empty if this is the range's last page
+  };
+
+  struct PageRequest : public Allocated {
+    PageRequest(TableScan* scan, size_t range_index, const String& paging_state, bool is_pinned)
+        : scan(scan)
+        , range_index(range_index)
+        , paging_state(paging_state)
+        , is_pinned(is_pinned) {}
+    TableScan* scan;
+    size_t range_index;
+    String paging_state;
+    bool is_pinned;
+  };
+
+  void execute(size_t range_index, const String& paging_state, bool pin_to_replica);
+  static void on_page(CassFuture* future, void* data);
+  void handle_page(const PageRequest* request, ResponseFuture* future);
+  void continue_range(size_t range_index, const String& paging_state);
+  void set_error(CassError code, const String& message);
+  void finish_range(ScopedMutex& l);
+
+private:
+  mutable uv_mutex_t mutex_;
+  uv_cond_t cond_;
+  String keyspace_;
+  String table_;
+  String columns_;
+  unsigned concurrency_;
+  int32_t paging_size_;
+  CassConsistency consistency_;
+  Callback callback_;
+  void* data_;
+  bool is_started_;
+  Session* session_;
+  String local_dc_;
+  StringVec partition_key_;
+  TokenRangeVec ranges_;
+  size_t next_range_;
+  size_t active_ranges_;
+  Deque<Page> pages_;
+  CassError error_code_;
+  String error_message_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(TableScan);
+};
+
+}}} // namespace datastax::internal::core
+
+EXTERNAL_TYPE(datastax::internal::core::TableScan, CassTableScan)
+
+#endif
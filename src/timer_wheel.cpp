@@ -0,0 +1,258 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "timer_wheel.hpp"
+
+#include <string.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#define LEVEL0_MASK (CASS_TIMER_WHEEL_LEVEL0_SIZE - 1)
+#define LEVEL_MASK (CASS_TIMER_WHEEL_LEVEL_SIZE - 1)
+
+// Timers further out are cascaded through the top level until they're close
+#define MAX_TIMEOUT_MS 0xFFFFFFFFULL
+
+using namespace datastax::internal::core;
+
+static inline int count_trailing_zeros(uint32_t word) {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward(&index, word);
+  return static_cast<int>(index);
+#else
+  return __builtin_ctz(word);
+#endif
+}
+
+void WheelTimer::start(TimerWheel* wheel, uint64_t timeout_ms, const Callback& callback) {
+  stop();
+  wheel_ = wheel;
+  // Saturate instead of wrapping around for very long timeouts (e.g. the
+  // CASS_UINT64_MAX default request timeout)
+  uint64_t now = uv_now(wheel->loop());
+  expires_ms_ = timeout_ms > CASS_UINT64_MAX - now ? CASS_UINT64_MAX : now + timeout_ms;
+  callback_ = callback;
+  wheel->add(this);
+}
+
+void WheelTimer::stop() {
+  if (wheel_ != NULL) {
+    wheel_->remove(this);
+    wheel_ = NULL;
+  }
+}
+
+TimerWheel::TimerWheel(uv_loop_t* loop)
+    : loop_(loop)
+    , is_closed_(false)
+    , is_advancing_(false)
+    , current_ms_(0)
+    , scheduled_ms_(0)
+    , size_(0) {
+  memset(level0_bits_, 0, sizeof(level0_bits_));
+}
+
+TimerWheel::~TimerWheel() {
+  // Detach the timers that are still running so that they don't reference
+  // the wheel once it's gone
+  for (size_t i = 0; i < CASS_TIMER_WHEEL_LEVEL0_SIZE; ++i) {
+    while (WheelTimer* timer = level0_[i].pop_front()) {
+      timer->wheel_ = NULL;
+      timer->slot_ = NULL;
+    }
+  }
+  for (size_t i = 0; i < CASS_TIMER_WHEEL_NUM_LEVELS - 1; ++i) {
+    for (size_t j = 0; j < CASS_TIMER_WHEEL_LEVEL_SIZE; ++j) {
+      while (WheelTimer* timer = levels_[i][j].pop_front()) {
+        timer->wheel_ = NULL;
+        timer->slot_ = NULL;
+      }
+    }
+  }
+}
+
+void TimerWheel::close() {
+  is_closed_ = true;
+  scheduled_ms_ = 0;
+  timer_.stop();
+}
+
+void TimerWheel::add(WheelTimer* timer) {
+  if (size_ == 0 && !is_advancing_) {
+    // Nothing needs to be cascaded so an empty wheel can jump to the present
+    uint64_t now = uv_now(loop_);
+    if (now > current_ms_) move_to(now);
+  }
+
+  insert(timer);
+  if (is_advancing_) return; // Scheduled once the wheel has advanced
+
+  // Fire for the timer's slot if it's in the first level, otherwise, for the
+  // cascade that moves it down
+  uint64_t fire_ms;
+  if (timer->slot_ >= level0_ && timer->slot_ < level0_ + CASS_TIMER_WHEEL_LEVEL0_SIZE) {
+    fire_ms = timer->expires_ms_ > current_ms_ ? timer->expires_ms_ : current_ms_;
+  } else {
+    fire_ms = (current_ms_ | LEVEL0_MASK) + 1;
+  }
+  if (scheduled_ms_ == 0 || fire_ms < scheduled_ms_) {
+    schedule(fire_ms);
+  }
+}
+
+void TimerWheel::insert(WheelTimer* timer) {
+  uint64_t expires = timer->expires_ms_ > current_ms_ ? timer->expires_ms_ : current_ms_;
+  uint64_t delta = expires - current_ms_;
+
+  List<WheelTimer>* slot;
+  if (delta < CASS_TIMER_WHEEL_LEVEL0_SIZE) {
+    unsigned index = static_cast<unsigned>(expires & LEVEL0_MASK);
+    level0_bits_[index / 32] |= 1u << (index % 32);
+    slot = &level0_[index];
+  } else {
+    if (delta > MAX_TIMEOUT_MS) {
+      expires = current_ms_ + MAX_TIMEOUT_MS;
+      delta = MAX_TIMEOUT_MS;
+    }
+    int level = 0;
+    int shift = CASS_TIMER_WHEEL_LEVEL0_BITS + CASS_TIMER_WHEEL_LEVEL_BITS;
+    while (level < CASS_TIMER_WHEEL_NUM_LEVELS - 2 && (delta >> shift) != 0) {
+      ++level;
+      shift += CASS_TIMER_WHEEL_LEVEL_BITS;
+    }
+    slot = &levels_[level][(expires >> (shift - CASS_TIMER_WHEEL_LEVEL_BITS)) & LEVEL_MASK];
+  }
+
+  slot->add_to_back(timer);
+  timer->slot_ = slot;
+  ++size_;
+}
+
+void TimerWheel::remove(WheelTimer* timer) {
+  List<WheelTimer>* slot = timer->slot_;
+  slot->remove(timer);
+  timer->slot_ = NULL;
+  --size_;
+  if (slot >= level0_ && slot < level0_ + CASS_TIMER_WHEEL_LEVEL0_SIZE && slot->is_empty()) {
+    size_t index = slot - level0_;
+    level0_bits_[index / 32] &= ~(1u << (index % 32));
+  }
+}
+
+void TimerWheel::advance(uint64_t now_ms) {
+  while (current_ms_ <= now_ms) {
+    // Skip the empty slots; the wheel never skips past a cascade
+    unsigned index = static_cast<unsigned>(current_ms_ & LEVEL0_MASK);
+    int next = next_level0_index(index);
+    uint64_t next_ms = next < 0 ? (current_ms_ | LEVEL0_MASK) + 1 : current_ms_ - index + next;
+    if (next_ms > now_ms) {
+      move_to(now_ms + 1);
+      break;
+    }
+
+    move_to(next_ms);
+    if (next >= 0) {
+      expire(static_cast<unsigned>(next));
+      move_to(current_ms_ + 1);
+    }
+  }
+}
+
+void TimerWheel::move_to(uint64_t ms) {
+  if (ms == current_ms_) return;
+  current_ms_ = ms;
+  // Cascade as soon as the first level wraps around so that the timers of
+  // the new round are in the first level before the next fire is scheduled
+  if ((current_ms_ & LEVEL0_MASK) == 0) {
+    cascade();
+  }
+}
+
+void TimerWheel::cascade() {
+  int shift = CASS_TIMER_WHEEL_LEVEL0_BITS;
+  for (int level = 0; level < CASS_TIMER_WHEEL_NUM_LEVELS - 1; ++level) {
+    unsigned index = static_cast<unsigned>((current_ms_ >> shift) & LEVEL_MASK);
+
+    // Move the timers out first because a timer could be hashed back into
+    // the same slot
+    List<WheelTimer> timers;
+    List<WheelTimer>& slot = levels_[level][index];
+    while (WheelTimer* timer = slot.pop_front()) {
+      --size_;
+      timers.add_to_back(timer);
+    }
+    while (WheelTimer* timer = timers.pop_front()) {
+      insert(timer);
+    }
+
+    if (index != 0) break; // The next level only wraps with this level
+    shift += CASS_TIMER_WHEEL_LEVEL_BITS;
+  }
+}
+
+void TimerWheel::expire(unsigned index) {
+  List<WheelTimer>& slot = level0_[index];
+  // The callbacks can start and stop other timers, including timers in this
+  // slot, so the timers are removed one at a time
+  while (WheelTimer* timer = slot.pop_front()) {
+    --size_;
+    timer->wheel_ = NULL;
+    timer->slot_ = NULL;
+    timer->callback_(timer);
+  }
+  level0_bits_[index / 32] &= ~(1u << (index % 32));
+}
+
+void TimerWheel::schedule(uint64_t fire_ms) {
+  if (is_closed_) return;
+  uint64_t now = uv_now(loop_);
+  scheduled_ms_ = fire_ms;
+  timer_.start(loop_, fire_ms > now ? fire_ms - now : 0,
+               bind_callback(&TimerWheel::on_timeout, this));
+}
+
+int TimerWheel::next_level0_index(unsigned index) const {
+  for (unsigned word = index / 32; word < CASS_TIMER_WHEEL_LEVEL0_SIZE / 32; ++word) {
+    uint32_t bits = level0_bits_[word];
+    if (word == index / 32) {
+      bits &= ~0u << (index % 32); // Ignore the slots before the index
+    }
+    if (bits != 0) {
+      return static_cast<int>(word * 32 + count_trailing_zeros(bits));
+    }
+  }
+  return -1;
+}
+
+uint64_t TimerWheel::next_fire_ms() const {
+  unsigned index = static_cast<unsigned>(current_ms_ & LEVEL0_MASK);
+  int next = next_level0_index(index);
+  return next < 0 ? (current_ms_ | LEVEL0_MASK) + 1 : current_ms_ - index + next;
+}
+
+void TimerWheel::on_timeout(Timer* timer) {
+  scheduled_ms_ = 0;
+  is_advancing_ = true;
+  advance(uv_now(loop_));
+  is_advancing_ = false;
+
+  if (size_ > 0) {
+    schedule(next_fire_ms());
+  }
+}
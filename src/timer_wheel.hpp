@@ -0,0 +1,145 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_TIMER_WHEEL_HPP
+#define DATASTAX_INTERNAL_TIMER_WHEEL_HPP
+
+#include "callback.hpp"
+#include "list.hpp"
+#include "macros.hpp"
+#include "timer.hpp"
+
+#include <uv.h>
+
+#define CASS_TIMER_WHEEL_LEVEL0_BITS 8
+#define CASS_TIMER_WHEEL_LEVEL_BITS 6
+#define CASS_TIMER_WHEEL_LEVEL0_SIZE (1 << CASS_TIMER_WHEEL_LEVEL0_BITS)
+#define CASS_TIMER_WHEEL_LEVEL_SIZE (1 << CASS_TIMER_WHEEL_LEVEL_BITS)
+#define CASS_TIMER_WHEEL_NUM_LEVELS 5
+
+namespace datastax { namespace internal { namespace core {
+
+class TimerWheel;
+
+/**
+ * A timer that runs on a timer wheel. Unlike `Timer` it doesn't have its own
+ * libuv handle so starting and stopping it is cheap. It must only be used on
+ * the thread of the wheel's event loop.
+ */
+class WheelTimer : public List<WheelTimer>::Node {
+public:
+  typedef internal::Callback<void, WheelTimer*> Callback;
+
+  WheelTimer()
+      : wheel_(NULL)
+      , expires_ms_(0)
+      , slot_(NULL) {}
+
+  ~WheelTimer() { stop(); }
+
+  /**
+   * Start the timer. A running timer is restarted.
+   *
+   * @param wheel The timer wheel of the event loop.
+   * @param timeout_ms The timeout in milliseconds.
+   * @param callback The callback that handles the timeout.
+   */
+  void start(TimerWheel* wheel, uint64_t timeout_ms, const Callback& callback);
+
+  void stop();
+
+  bool is_running() const { return wheel_ != NULL; }
+
+private:
+  friend class TimerWheel;
+
+  TimerWheel* wheel_;
+  uint64_t expires_ms_;
+  List<WheelTimer>* slot_;
+  Callback callback_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(WheelTimer);
+};
+
+/**
+ * A hierarchical timer wheel with a millisecond resolution, like the one
+ * described in "Hashed and Hierarchical Timing Wheels" (Varghese and Lauck).
+ * Starting and stopping a timer is O(1) whereas libuv keeps its timers in a
+ * binary heap. Timers are hashed by their expiration time into the slots of
+ * the first level, which has a slot per millisecond, or the coarser slots of
+ * the higher levels. The timers of a higher level's slot are moved down a
+ * level (cascaded) once the lower level wraps around.
+ *
+ * A single libuv timer drives the wheel. It only runs while the wheel has
+ * timers and it's only started for the first level's next non-empty slot or
+ * the next cascade, not every millisecond.
+ */
+class TimerWheel {
+public:
+  TimerWheel(uv_loop_t* loop);
+  ~TimerWheel();
+
+  /**
+   * Stop driving the wheel. Running timers no longer expire. This must be
+   * called on the event loop's thread before the loop is closed.
+   */
+  void close();
+
+  /**
+   * The number of running timers.
+   */
+  size_t size() const { return size_; }
+
+  uv_loop_t* loop() const { return loop_; }
+
+private:
+  friend class WheelTimer;
+
+  void add(WheelTimer* timer);
+  void insert(WheelTimer* timer);
+  void remove(WheelTimer* timer);
+
+  void advance(uint64_t now_ms);
+  void move_to(uint64_t ms);
+  void cascade();
+  void expire(unsigned index);
+  void schedule(uint64_t fire_ms);
+  int next_level0_index(unsigned index) const;
+  uint64_t next_fire_ms() const;
+
+private:
+  void on_timeout(Timer* timer);
+
+private:
+  uv_loop_t* const loop_;
+  Timer timer_;
+  bool is_closed_;
+  bool is_advancing_;
+  uint64_t current_ms_;  // The next millisecond to be processed
+  uint64_t scheduled_ms_; // When the libuv timer fires or zero if it's not running
+  size_t size_;
+  uint32_t level0_bits_[CASS_TIMER_WHEEL_LEVEL0_SIZE / 32]; // The non-empty first level slots
+  List<WheelTimer> level0_[CASS_TIMER_WHEEL_LEVEL0_SIZE];
+  List<WheelTimer> levels_[CASS_TIMER_WHEEL_NUM_LEVELS - 1][CASS_TIMER_WHEEL_LEVEL_SIZE];
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(TimerWheel);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
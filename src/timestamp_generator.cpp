@@ -20,8 +20,30 @@
 #include "get_time.hpp"
 #include "logger.hpp"
 
+using namespace datastax::internal;
 using namespace datastax::internal::core;
 
+// If we exceed our warning threshold then warn periodically that clock skew
+// has been detected.
+static void warn_clock_skew(int64_t current, int64_t last, int64_t warning_threshold_us,
+                            int64_t warning_interval_ms, Atomic<int64_t>* last_warning) {
+  if (warning_threshold_us >= 0 && last > current + warning_threshold_us) {
+    // Using a monotonic clock to prevent the effects of clock skew from properly
+    // triggering warnings.
+    int64_t now = get_time_monotonic_ns() / NANOSECONDS_PER_MILLISECOND;
+    int64_t last_warning_ms = last_warning->load();
+    if (now > last_warning_ms + warning_interval_ms &&
+        last_warning->compare_exchange_strong(last_warning_ms, now)) {
+      LOG_WARN("Clock skew detected. The current time (%lld) was %lld "
+               "microseconds behind the last generated timestamp (%lld). "
+               "The next generated timestamp will be artificially incremented "
+               "to guarantee monotonicity.",
+               static_cast<long long>(current), static_cast<long long>(last - current),
+               static_cast<long long>(last));
+    }
+  }
+}
+
 extern "C" {
 
 CassTimestampGen* cass_timestamp_gen_server_side_new() {
@@ -44,6 +66,20 @@ CassTimestampGen* cass_timestamp_gen_monotonic_new_with_settings(int64_t warning
   return CassTimestampGen::to(timestamp_gen);
 }
 
+CassTimestampGen* cass_timestamp_gen_per_thread_monotonic_new(unsigned lane_bits) {
+  TimestampGenerator* timestamp_gen = new PerThreadMonotonicTimestampGenerator(lane_bits);
+  timestamp_gen->inc_ref();
+  return CassTimestampGen::to(timestamp_gen);
+}
+
+CassTimestampGen* cass_timestamp_gen_per_thread_monotonic_new_with_settings(
+    unsigned lane_bits, int64_t warning_threshold_us, int64_t warning_interval_ms) {
+  TimestampGenerator* timestamp_gen =
+      new PerThreadMonotonicTimestampGenerator(lane_bits, warning_threshold_us, warning_interval_ms);
+  timestamp_gen->inc_ref();
+  return CassTimestampGen::to(timestamp_gen);
+}
+
 void cass_timestamp_gen_free(CassTimestampGen* timestamp_gen) { timestamp_gen->dec_ref(); }
 
 } // extern "C"
@@ -64,26 +100,56 @@ int64_t MonotonicTimestampGenerator::compute_next(int64_t last) {
   int64_t current = get_time_since_epoch_us();
 
   if (last >= current) { // There's clock skew
-    // If we exceed our warning threshold then warn periodically that clock
-    // skew has been detected.
-    if (warning_threshold_us_ >= 0 && last > current + warning_threshold_us_) {
-      // Using a monotonic clock to prevent the effects of clock skew from properly
-      // triggering warnings.
-      int64_t now = get_time_monotonic_ns() / NANOSECONDS_PER_MILLISECOND;
-      int64_t last_warning = last_warning_.load();
-      if (now > last_warning + warning_interval_ms_ &&
-          last_warning_.compare_exchange_strong(last_warning, now)) {
-        LOG_WARN("Clock skew detected. The current time (%lld) was %lld "
-                 "microseconds behind the last generated timestamp (%lld). "
-                 "The next generated timestamp will be artificially incremented "
-                 "to guarantee monotonicity.",
-                 static_cast<long long>(current), static_cast<long long>(last - current),
-                 static_cast<long long>(last));
-      }
-    }
-
+    warn_clock_skew(current, last, warning_threshold_us_, warning_interval_ms_, &last_warning_);
     return last + 1;
   }
 
   return current;
 }
+
+PerThreadMonotonicTimestampGenerator::PerThreadMonotonicTimestampGenerator(
+    unsigned lane_bits, int64_t warning_threshold_us, int64_t warning_interval_ms)
+    : TimestampGenerator(PER_THREAD_MONOTONIC)
+    , lane_count_(static_cast<size_t>(1)
+                  << (lane_bits < MAX_LANE_BITS ? lane_bits : MAX_LANE_BITS))
+    , lanes_(new Lane[lane_count_])
+    , thread_count_(0)
+    , last_warning_(0)
+    , warning_threshold_us_(warning_threshold_us)
+    , warning_interval_ms_(warning_interval_ms < 0 ? 0 : warning_interval_ms) {
+  uv_key_create(&lane_key_);
+}
+
+PerThreadMonotonicTimestampGenerator::~PerThreadMonotonicTimestampGenerator() {
+  uv_key_delete(&lane_key_);
+}
+
+int64_t PerThreadMonotonicTimestampGenerator::next() {
+  const int64_t lane = static_cast<int64_t>(current_lane());
+  const int64_t lane_mask = static_cast<int64_t>(lane_count_) - 1;
+
+  // The lane's last timestamp is only contended when threads share the lane
+  Atomic<int64_t>& last = lanes_[lane].last;
+  int64_t prev = last.load();
+  while (true) {
+    int64_t current = (get_time_since_epoch_us() & ~lane_mask) | lane;
+    int64_t next = current;
+    if (prev >= current) { // There's clock skew
+      warn_clock_skew(current, prev, warning_threshold_us_, warning_interval_ms_, &last_warning_);
+      next = prev + static_cast<int64_t>(lane_count_); // Stay in the lane
+    }
+    if (last.compare_exchange_strong(prev, next)) {
+      return next;
+    }
+  }
+}
+
+size_t PerThreadMonotonicTimestampGenerator::current_lane() {
+  void* lane = uv_key_get(&lane_key_);
+  if (lane == NULL) {
+    size_t index = thread_count_.fetch_add(1) % lane_count_;
+    lane = reinterpret_cast<void*>(index + 1);
+    uv_key_set(&lane_key_, lane);
+  }
+  return reinterpret_cast<size_t>(lane) - 1;
+}
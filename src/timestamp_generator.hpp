@@ -23,8 +23,10 @@
 #include "macros.hpp"
 #include "ref_counted.hpp"
 #include "request.hpp"
+#include "scoped_ptr.hpp"
 
 #include <stdint.h>
+#include <uv.h>
 
 namespace datastax { namespace internal { namespace core {
 
@@ -32,7 +34,7 @@ class TimestampGenerator : public RefCounted<TimestampGenerator> {
 public:
   typedef SharedRefPtr<TimestampGenerator> Ptr;
 
-  enum Type { SERVER_SIDE, MONOTONIC };
+  enum Type { SERVER_SIDE, MONOTONIC, PER_THREAD_MONOTONIC };
 
   TimestampGenerator(Type type)
       : type_(type) {}
@@ -80,6 +82,65 @@ private:
   const int64_t warning_interval_ms_;
 };
 
+/**
+ * A monotonic timestamp generator with per-thread lanes. The low bits of each
+ * timestamp hold the id of the lane that generated it and each lane's
+ * timestamps are monotonic, so timestamps are unique across lanes without a
+ * shared compare-and-swap. A thread is assigned a lane the first time it
+ * generates a timestamp; threads only share a lane when there are more
+ * threads than lanes.
+ */
+class PerThreadMonotonicTimestampGenerator : public TimestampGenerator {
+public:
+  static const unsigned DEFAULT_LANE_BITS = 4;
+  static const unsigned MAX_LANE_BITS = 10;
+
+  /**
+   * Constructor.
+   *
+   * @param lane_bits The number of low microsecond bits used for the lane id.
+   * The generator has 2^lane_bits lanes and its timestamps have a precision
+   * of 2^lane_bits microseconds. Values larger than MAX_LANE_BITS are reduced
+   * to MAX_LANE_BITS.
+   * @param warning_threshold_us
+   * @param warning_interval_ms
+   */
+  PerThreadMonotonicTimestampGenerator(unsigned lane_bits = DEFAULT_LANE_BITS,
+                                       int64_t warning_threshold_us = 1000000,
+                                       int64_t warning_interval_ms = 1000);
+
+  ~PerThreadMonotonicTimestampGenerator();
+
+  size_t lane_count() const { return lane_count_; }
+
+  virtual int64_t next();
+
+private:
+  class Lane : public Allocated {
+  public:
+    Lane()
+        : last(0) {}
+
+    Atomic<int64_t> last;
+
+  private:
+    static const size_t cacheline_size = 64;
+    char pad__[cacheline_size];
+    void no_unused_private_warning__() { pad__[0] = 0; }
+  };
+
+  size_t current_lane();
+
+  const size_t lane_count_;
+  ScopedArray<Lane> lanes_;
+  Atomic<size_t> thread_count_;
+  uv_key_t lane_key_;
+  Atomic<int64_t> last_warning_;
+
+  const int64_t warning_threshold_us_;
+  const int64_t warning_interval_ms_;
+};
+
 }}} // namespace datastax::internal::core
 
 EXTERNAL_TYPE(datastax::internal::core::TimestampGenerator, CassTimestampGen)
@@ -16,8 +16,10 @@
 
 #include "token_aware_policy.hpp"
 
+#include "latency_aware_policy.hpp"
 #include "random.hpp"
 #include "request_handler.hpp"
+#include "small_vector.hpp"
 
 #include <algorithm>
 
@@ -36,8 +38,17 @@ static inline bool contains(const CopyOnWriteHostVec& replicas, const Address& a
   return false;
 }
 
+// Latency is tracked for ordering replicas by load using the same settings as
+// the latency-aware policy.
+static const LatencyAwarePolicy::Settings latency_settings;
+
 void TokenAwarePolicy::init(const Host::Ptr& connected_host, const HostMap& hosts, Random* random,
                             const String& local_dc, const String& local_rack) {
+  if (least_loaded_replicas_) {
+    for (HostMap::const_iterator i = hosts.begin(), end = hosts.end(); i != end; ++i) {
+      i->second->enable_latency_tracking(latency_settings.scale_ns, latency_settings.min_measured);
+    }
+  }
   if (random != NULL) {
     if (shuffle_replicas_) {
       // Store random so that it can be used to shuffle replicas.
@@ -64,15 +75,31 @@ QueryPlan* TokenAwarePolicy::new_query_plan(const String& keyspace, RequestHandl
           String routing_key;
           if (request->get_routing_key(&routing_key) && !keyspace.empty()) {
             if (token_map != NULL) {
-              CopyOnWriteHostVec replicas = token_map->get_replicas(keyspace, routing_key);
+              // The handler's keyspace is interned so its replicas are found
+              // without hashing its name.
+              const InternedString& interned_keyspace = request_handler->keyspace();
+              const CopyOnWriteHostVec replicas =
+                  &interned_keyspace.str() == &keyspace
+                      ? token_map->get_replicas(interned_keyspace, routing_key)
+                      : token_map->get_replicas(keyspace, routing_key);
               if (replicas && !replicas->empty()) {
-                if (random_ != NULL) {
-                  random_shuffle(replicas->begin(), replicas->end(), random_);
-                }
-                return new TokenAwareQueryPlan(
+                // Lightweight transactions always use their replicas in ring
+                // order, starting with the primary replica, so that every
+                // client uses the same coordinator and Paxos rounds don't
+                // contend with each other
+                bool is_lwt = request->is_lwt();
+                TokenAwareQueryPlan* query_plan = new (request_handler) TokenAwareQueryPlan(
                     child_policy_.get(),
                     child_policy_->new_query_plan(keyspace, request_handler, token_map), replicas,
-                    index_);
+                    least_loaded_replicas_ || is_lwt ? 0 : index_);
+                if (!is_lwt) {
+                  if (least_loaded_replicas_) {
+                    query_plan->order_by_load(random_);
+                  } else if (random_ != NULL) {
+                    query_plan->shuffle(random_);
+                  }
+                }
+                return query_plan;
               }
             }
           }
@@ -86,10 +113,108 @@ QueryPlan* TokenAwarePolicy::new_query_plan(const String& keyspace, RequestHandl
   return child_policy_->new_query_plan(keyspace, request_handler, token_map);
 }
 
-Host::Ptr TokenAwarePolicy::TokenAwareQueryPlan::compute_next() {
+void TokenAwarePolicy::on_host_added(const Host::Ptr& host) {
+  if (least_loaded_replicas_) {
+    host->enable_latency_tracking(latency_settings.scale_ns, latency_settings.min_measured);
+  }
+  ChainedLoadBalancingPolicy::on_host_added(host);
+}
+
+namespace {
+
+struct ReplicaLoad {
+  ReplicaLoad()
+      : inflight(0)
+      , latency(0)
+      , index(0) {}
+
+  ReplicaLoad(const Host::Ptr& host, size_t index, uint64_t now)
+      : inflight(host->inflight_request_count())
+      , latency(0)
+      , index(index) {
+    TimestampedAverage average = host->get_current_average();
+    if (average.average >= 0 && average.num_measured >= latency_settings.min_measured &&
+        now - average.timestamp <= latency_settings.retry_period_ns) {
+      latency = average.average;
+    }
+  }
+
+  bool operator<(const ReplicaLoad& other) const {
+    return inflight == other.inflight ? latency < other.latency : inflight < other.inflight;
+  }
+
+  int32_t inflight;
+  int64_t latency;
+  size_t index;
+};
+
+} // namespace
+
+CopyOnWriteHostVec TokenAwarePolicy::order_by_load(const CopyOnWriteHostVec& replicas,
+                                                   Random* random) {
+  ReplicaOrder order;
+  order_by_load(*replicas, random, &order);
+
+  CopyOnWriteHostVec ordered(new HostVec());
+  ordered->reserve(order.size());
+  for (ReplicaOrder::const_iterator i = order.begin(), end = order.end(); i != end; ++i) {
+    ordered->push_back((*replicas)[*i]);
+  }
+  return ordered;
+}
+
+void TokenAwarePolicy::order_by_load(const HostVec& replicas, Random* random,
+                                     ReplicaOrder* order) {
+  // Snapshot each replica's load once, then insertion sort them. This keeps
+  // the order of equally loaded replicas and there are only a few replicas.
+  uint64_t now = uv_hrtime();
+  SmallVector<ReplicaLoad, 8> loads;
+  loads.reserve(replicas.size());
+  for (size_t i = 0; i < replicas.size(); ++i) {
+    loads.push_back(ReplicaLoad(replicas[i], i, now));
+  }
+  if (random != NULL && loads.size() > 1) {
+    random_shuffle(loads.begin(), loads.end(), random);
+  }
+  for (size_t i = 1; i < loads.size(); ++i) {
+    ReplicaLoad load(loads[i]);
+    size_t j = i;
+    for (; j > 0 && load < loads[j - 1]; --j) {
+      loads[j] = loads[j - 1];
+    }
+    loads[j] = load;
+  }
+
+  order->clear();
+  for (SmallVector<ReplicaLoad, 8>::const_iterator i = loads.begin(), end = loads.end(); i != end;
+       ++i) {
+    order->push_back(i->index);
+  }
+}
+
+void TokenAwarePolicy::TokenAwareQueryPlan::shuffle(Random* random) {
+  order_.resize(replicas_->size());
+  for (size_t i = 0; i < order_.size(); ++i) {
+    order_[i] = i;
+  }
+  if (order_.size() > 1) {
+    random_shuffle(order_.begin(), order_.end(), random);
+  }
+}
+
+void TokenAwarePolicy::TokenAwareQueryPlan::order_by_load(Random* random) {
+  TokenAwarePolicy::order_by_load(*replicas_, random, &order_);
+}
+
+const Host::Ptr& TokenAwarePolicy::TokenAwareQueryPlan::next_replica() {
+  size_t index = index_++ % replicas_->size();
+  return (*replicas_)[order_.empty() ? index : order_[index]];
+}
+
+const Host::Ptr& TokenAwarePolicy::TokenAwareQueryPlan::compute_next() {
   while (remaining_local_ > 0) {
     --remaining_local_;
-    const Host::Ptr& host((*replicas_)[index_++ % replicas_->size()]);
+    const Host::Ptr& host(next_replica());
     if (child_policy_->is_host_up(host->address()) &&
         child_policy_->distance(host) == CASS_HOST_DISTANCE_LOCAL) {
       return host;
@@ -98,7 +223,7 @@ Host::Ptr TokenAwarePolicy::TokenAwareQueryPlan::compute_next() {
 
   while (remaining_remote_ > 0) {
     --remaining_remote_;
-    const Host::Ptr& host((*replicas_)[index_++ % replicas_->size()]);
+    const Host::Ptr& host(next_replica());
     if (child_policy_->is_host_up(host->address()) &&
         child_policy_->distance(host) == CASS_HOST_DISTANCE_REMOTE) {
       return host;
@@ -107,19 +232,20 @@ Host::Ptr TokenAwarePolicy::TokenAwareQueryPlan::compute_next() {
 
   while (remaining_remote2_ > 0) {
     --remaining_remote2_;
-    const Host::Ptr& host((*replicas_)[index_++ % replicas_->size()]);
+    const Host::Ptr& host(next_replica());
     if (child_policy_->is_host_up(host->address()) &&
         child_policy_->distance(host) == CASS_HOST_DISTANCE_REMOTE2) {
       return host;
     }
   }
 
-  Host::Ptr host;
-  while ((host = child_plan_->compute_next())) {
+  while (true) {
+    const Host::Ptr& host(child_plan_->compute_next());
+    if (!host) break;
     if (!contains(replicas_, host->address()) ||
         child_policy_->distance(host) > CASS_HOST_DISTANCE_REMOTE2) {
       return host;
     }
   }
-  return Host::Ptr();
+  return NO_HOST;
 }
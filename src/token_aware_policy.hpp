@@ -20,17 +20,20 @@
 #include "host.hpp"
 #include "load_balancing.hpp"
 #include "scoped_ptr.hpp"
+#include "small_vector.hpp"
 #include "token_map.hpp"
 
 namespace datastax { namespace internal { namespace core {
 
 class TokenAwarePolicy : public ChainedLoadBalancingPolicy {
 public:
-  TokenAwarePolicy(LoadBalancingPolicy* child_policy, bool shuffle_replicas)
+  TokenAwarePolicy(LoadBalancingPolicy* child_policy, bool shuffle_replicas,
+                   bool least_loaded_replicas = false)
       : ChainedLoadBalancingPolicy(child_policy)
       , random_(NULL)
       , index_(0)
-      , shuffle_replicas_(shuffle_replicas) {}
+      , shuffle_replicas_(shuffle_replicas)
+      , least_loaded_replicas_(least_loaded_replicas) {}
 
   virtual ~TokenAwarePolicy() {}
 
@@ -40,11 +43,35 @@ public:
   virtual QueryPlan* new_query_plan(const String& keyspace, RequestHandler* request_handler,
                                     const TokenMap* token_map);
 
+  virtual void on_host_added(const Host::Ptr& host);
+
   LoadBalancingPolicy* new_instance() {
-    return new TokenAwarePolicy(child_policy_->new_instance(), shuffle_replicas_);
+    return new TokenAwarePolicy(child_policy_->new_instance(), shuffle_replicas_,
+                                least_loaded_replicas_);
   }
 
+  /**
+   * Order replicas from the least to the most loaded. Replicas are ordered by
+   * their in-flight requests (across all the session's connection pools) and
+   * replicas with the same number of in-flight requests by their recent
+   * average latency. Replicas without a recent latency are ordered before
+   * replicas with one so that they get measured. The order of replicas with
+   * the same load is kept, after an optional shuffle.
+   *
+   * @param replicas The replicas to order.
+   * @param random If not null, the replicas are shuffled before being
+   * ordered so that equally loaded replicas are used evenly.
+   * @return The ordered replicas.
+   */
+  static CopyOnWriteHostVec order_by_load(const CopyOnWriteHostVec& replicas, Random* random);
+
 private:
+  // The order replicas are visited in, as indexes into the token map's
+  // replicas. This avoids copying the shared replicas for every request.
+  typedef SmallVector<size_t, 8> ReplicaOrder;
+
+  static void order_by_load(const HostVec& replicas, Random* random, ReplicaOrder* order);
+
   class TokenAwareQueryPlan : public QueryPlan {
   public:
     TokenAwareQueryPlan(LoadBalancingPolicy* child_policy, QueryPlan* child_plan,
@@ -57,12 +84,19 @@ private:
         , remaining_remote_(replicas->size())
         , remaining_remote2_(replicas->size()) {}
 
-    Host::Ptr compute_next();
+    void shuffle(Random* random);
+    void order_by_load(Random* random);
+
+    const Host::Ptr& compute_next();
+
+  private:
+    const Host::Ptr& next_replica();
 
   private:
     LoadBalancingPolicy* child_policy_;
     ScopedPtr<QueryPlan> child_plan_;
-    CopyOnWriteHostVec replicas_;
+    const CopyOnWriteHostVec replicas_;
+    ReplicaOrder order_; // Empty to visit the replicas in the token map's order
     size_t index_;
     size_t remaining_local_;
     size_t remaining_remote_;
@@ -72,6 +106,7 @@ private:
   Random* random_;
   size_t index_;
   bool shuffle_replicas_;
+  bool least_loaded_replicas_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(TokenAwarePolicy);
@@ -18,6 +18,7 @@
 #define DATASTAX_INTERNAL_TOKEN_MAP_HPP
 
 #include "host.hpp"
+#include "interned_string.hpp"
 #include "ref_counted.hpp"
 #include "string.hpp"
 #include "string_ref.hpp"
@@ -28,6 +29,32 @@ class VersionNumber;
 class Value;
 class ResultResponse;
 
+struct TokenMapMetrics {
+  TokenMapMetrics()
+      : keyspaces(0)
+      , replica_vectors(0)
+      , tokens(0)
+      , memory_bytes(0) {}
+  size_t keyspaces;
+  size_t replica_vectors;
+  size_t tokens;
+  size_t memory_bytes; // Estimated
+};
+
+// A range of tokens and its replicas. The tokens are CQL literals so that the
+// range can be used in a query's token() restriction.
+struct TokenRange {
+  TokenRange(const String& start, const String& end, const CopyOnWriteHostVec& replicas)
+      : start(start)
+      , end(end)
+      , replicas(replicas) {}
+  String start; // Exclusive, or empty if the range has no lower bound
+  String end;   // Inclusive, or empty if the range has no upper bound
+  CopyOnWriteHostVec replicas;
+};
+
+typedef Vector<TokenRange> TokenRangeVec;
+
 class TokenMap : public RefCounted<TokenMap> {
 public:
   typedef SharedRefPtr<TokenMap> Ptr;
@@ -36,6 +63,8 @@ public:
 
   virtual ~TokenMap() {}
 
+  // Reserve space for a number of tokens before adding hosts
+  virtual void reserve_tokens(size_t count) = 0;
   virtual void add_host(const Host::Ptr& host) = 0;
   virtual void update_host_and_build(const Host::Ptr& host) = 0;
   virtual void remove_host_and_build(const Host::Ptr& host) = 0;
@@ -53,7 +82,24 @@ public:
   virtual const CopyOnWriteHostVec& get_replicas(const String& keyspace_name,
                                                  const String& routing_key) const = 0;
 
+  // Get the replicas using an interned keyspace name; the keyspace is found
+  // without hashing or comparing its name.
+  virtual const CopyOnWriteHostVec& get_replicas(const InternedString& keyspace_name,
+                                                 const String& routing_key) const = 0;
+
+  // Get the replicas of many routing keys in the same keyspace. The routing
+  // keys are hashed together, which is faster for Murmur3 tokens.
+  virtual void get_replicas(const String& keyspace_name, const Vector<String>& routing_keys,
+                            Vector<CopyOnWriteHostVec>& replicas) const = 0;
+
+  // Get the token ranges that cover the whole ring and their replicas for a
+  // keyspace. The range wrapping around the ring is split at the minimum
+  // token so none of the ranges wrap.
+  virtual void get_token_ranges(const String& keyspace_name, TokenRangeVec& ranges) const = 0;
+
   virtual String dump(const String& keyspace_name) const = 0;
+
+  virtual void get_metrics(TokenMapMetrics* metrics) const = 0;
 };
 
 }}} // namespace datastax::internal::core
@@ -16,77 +16,211 @@
 
 #include "token_map_impl.hpp"
 
+#include "driver_config.hpp"
 #include "md5.hpp"
 #include "murmur3.hpp"
+#include "object_cache.hpp"
+
+#include <string.h>
+
+// The minimum number of tokens times strategies built by each thread
+#define REPLICAS_BUILD_MIN_WORK_PER_THREAD 4096
+
+// Fewer tokens than this are sorted using a comparison sort
+#define RADIX_SORT_MIN_TOKENS 256
 
 using namespace datastax;
 using namespace datastax::internal::core;
 
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define TOKEN_PARSE_BIG_ENDIAN
+#endif
+
+static inline bool is_digit(int c) { return static_cast<unsigned>(c - '0') < 10; }
+
+// Parse eight decimal digits at once using SWAR (SIMD within a register). This
+// returns false if any of the eight characters is not a digit.
+static inline bool parse_eight_digits(const char* s, uint64_t* digits) {
+#if defined(TOKEN_PARSE_BIG_ENDIAN)
+  uint64_t value = 0;
+  for (int i = 0; i < 8; ++i) {
+    if (!is_digit(s[i])) return false;
+    value = value * 10 + (s[i] - '0');
+  }
+  *digits = value;
+  return true;
+#else
+  uint64_t value;
+  memcpy(&value, s, sizeof(value));
+  if (((value & 0xF0F0F0F0F0F0F0F0ULL) |
+       (((value + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) !=
+      0x3333333333333333ULL) {
+    return false;
+  }
+  value -= 0x3030303030303030ULL;
+  value = (value * 10) + (value >> 8); // Pairs of digits
+  *digits = (((value & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+             (((value >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >>
+            32;
+  return true;
+#endif
+}
+
 static int64_t parse_int64(const char* p, size_t n) {
-  int c;
   const char* s = p;
-  for (; n != 0 && isspace(c = *s); ++s, --n) {
+  for (; n != 0 && isspace(*s); ++s, --n) {
   }
 
   if (n == 0) {
     return 0;
   }
 
-  int64_t sign = 1;
-  if (c == '-') {
-    sign = -1;
-    ++s;
-    --n;
-  }
+  bool negative = *s == '-';
+  s += negative;
+  n -= negative;
 
-  int64_t value = 0;
-  for (; n != 0 && isdigit(c = *s); ++s, --n) {
-    value *= 10;
-    value += c - '0';
+  // Accumulate as unsigned so that the minimum token doesn't overflow
+  uint64_t value = 0;
+  uint64_t digits;
+  while (n >= 8 && parse_eight_digits(s, &digits)) {
+    value = value * 100000000ULL + digits;
+    s += 8;
+    n -= 8;
   }
+  for (; n != 0 && is_digit(*s); ++s, --n) {
+    value = value * 10 + (*s - '0');
+  }
+
+  return static_cast<int64_t>(negative ? 0 - value : value);
+}
 
-  return sign * value;
+// Compute (hi, lo) = (hi, lo) * multiplier + addend for a 128-bit value where
+// the multiplier is less than 2^32.
+static inline void multiply_add_int128(uint64_t* hi, uint64_t* lo, uint64_t multiplier,
+                                       uint64_t addend) {
+  uint64_t low = (*lo & 0xFFFFFFFFULL) * multiplier;
+  uint64_t high = (*lo >> 32) * multiplier;
+  uint64_t result = low + (high << 32);
+  uint64_t carry = result < low ? 1 : 0;
+  *hi = *hi * multiplier + (high >> 32) + carry;
+  *lo = result + addend;
+  *hi += *lo < result ? 1 : 0;
 }
 
 static void parse_int128(const char* p, size_t n, uint64_t* h, uint64_t* l) {
   // no sign handling because C* uses [0, 2^127]
-  int c;
   const char* s = p;
 
-  for (; n != 0 && isspace(c = *s); ++s, --n) {
-  }
-
-  if (n == 0) {
-    *h = *l = 0;
-    return;
+  for (; n != 0 && isspace(*s); ++s, --n) {
   }
 
   uint64_t hi = 0;
   uint64_t lo = 0;
-  uint64_t hi_tmp;
-  uint64_t lo_tmp;
-  uint64_t lo_tmp2;
-  for (; n != 0 && isdigit(c = *s); ++s, --n) {
-    hi_tmp = hi;
-    lo_tmp = lo;
-
-    // value *= 10;
-    lo = lo_tmp << 1;
-    hi = (lo_tmp >> 63) + (hi_tmp << 1);
-    lo_tmp2 = lo;
-    lo += lo_tmp << 3;
-    hi += (lo_tmp >> 61) + (hi_tmp << 3) + (lo < lo_tmp2 ? 1 : 0);
-
-    // value += c - '0';
-    lo_tmp = lo;
-    lo += c - '0';
-    hi += (lo < lo_tmp) ? 1 : 0;
+  uint64_t digits;
+  while (n >= 8 && parse_eight_digits(s, &digits)) {
+    multiply_add_int128(&hi, &lo, 100000000ULL, digits);
+    s += 8;
+    n -= 8;
+  }
+  for (; n != 0 && is_digit(*s); ++s, --n) {
+    multiply_add_int128(&hi, &lo, 10, *s - '0');
   }
 
   *h = hi;
   *l = lo;
 }
 
+static uv_once_t cpu_count_guard = UV_ONCE_INIT;
+static size_t cpu_count = 1;
+
+static void init_cpu_count() {
+  uv_cpu_info_t* cpu_infos;
+  int count;
+  if (uv_cpu_info(&cpu_infos, &count) == 0) {
+    if (count > 0) cpu_count = count;
+    uv_free_cpu_info(cpu_infos, count);
+  }
+}
+
+static void on_run_thread(void* arg) {
+  std::pair<void (*)(void*), void*>* run = static_cast<std::pair<void (*)(void*), void*>*>(arg);
+  run->first(run->second);
+#ifdef HAVE_OBJECT_CACHE
+  ObjectCache::release_thread();
+#endif
+}
+
+size_t datastax::internal::core::replicas_build_thread_count(size_t strategy_count,
+                                                             size_t token_count) {
+  if (strategy_count < 2) return 1;
+  uv_once(&cpu_count_guard, init_cpu_count);
+  size_t count = (strategy_count * token_count) / REPLICAS_BUILD_MIN_WORK_PER_THREAD;
+  count = std::min(count, std::min(strategy_count, cpu_count));
+  return count > 0 ? count : 1;
+}
+
+void datastax::internal::core::run_on_threads(size_t thread_count, void (*func)(void*),
+                                              void* arg) {
+  std::pair<void (*)(void*), void*> run(func, arg);
+  Vector<uv_thread_t> threads;
+  threads.reserve(thread_count);
+  for (size_t i = 1; i < thread_count; ++i) {
+    uv_thread_t thread;
+    if (uv_thread_create(&thread, on_run_thread, &run) != 0) break;
+    threads.push_back(thread);
+  }
+  func(arg); // The calling thread also does work
+  for (Vector<uv_thread_t>::iterator i = threads.begin(), end = threads.end(); i != end; ++i) {
+    uv_thread_join(&*i);
+  }
+}
+
+void datastax::internal::core::radix_sort_tokens(Vector<std::pair<int64_t, Host*> >& tokens) {
+  typedef std::pair<int64_t, Host*> TokenHost;
+  const size_t count = tokens.size();
+  if (count < RADIX_SORT_MIN_TOKENS) {
+    std::sort(tokens.begin(), tokens.end());
+    return;
+  }
+
+  // Count the occurrences of every byte value of the keys in a single pass.
+  // The sign bit is flipped so that the unsigned keys keep the signed order.
+  const uint64_t sign = 0x8000000000000000ULL;
+  Vector<size_t> counts(8 * 256, 0);
+  for (size_t i = 0; i < count; ++i) {
+    uint64_t key = static_cast<uint64_t>(tokens[i].first) ^ sign;
+    for (int b = 0; b < 8; ++b) {
+      counts[b * 256 + ((key >> (b * 8)) & 0xFF)]++;
+    }
+  }
+
+  Vector<TokenHost> buffer(count);
+  TokenHost* from = &tokens[0];
+  TokenHost* to = &buffer[0];
+  for (int b = 0; b < 8; ++b) {
+    size_t* bucket = &counts[b * 256];
+    int shift = b * 8;
+    // Skip the pass if every key has the same byte
+    if (bucket[(static_cast<uint64_t>(from[0].first) ^ sign) >> shift & 0xFF] == count) continue;
+
+    size_t offset = 0;
+    for (int i = 0; i < 256; ++i) {
+      size_t n = bucket[i];
+      bucket[i] = offset;
+      offset += n;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      uint64_t key = static_cast<uint64_t>(from[i].first) ^ sign;
+      to[bucket[(key >> shift) & 0xFF]++] = from[i];
+    }
+    std::swap(from, to);
+  }
+
+  if (from != &tokens[0]) {
+    tokens.swap(buffer);
+  }
+}
+
 const uint32_t IdGenerator::EMPTY_KEY(0);
 const uint32_t IdGenerator::DELETED_KEY(CASS_UINT32_MAX);
 
@@ -98,12 +232,56 @@ Murmur3Partitioner::Token Murmur3Partitioner::hash(const StringRef& str) {
   return MurmurHash3_x64_128(str.data(), str.size(), 0);
 }
 
+void Murmur3Partitioner::hash_batch(const Vector<String>& strs, Token* output) {
+  Vector<const char*> keys;
+  Vector<size_t> lengths;
+  keys.reserve(strs.size());
+  lengths.reserve(strs.size());
+  for (Vector<String>::const_iterator i = strs.begin(), end = strs.end(); i != end; ++i) {
+    keys.push_back(i->data());
+    lengths.push_back(i->size());
+  }
+  if (!keys.empty()) {
+    MurmurHash3_x64_128_batch(&keys[0], &lengths[0], keys.size(), 0, output);
+  }
+}
+
+String Murmur3Partitioner::to_cql(const Token& token) {
+  OStringStream ss;
+  ss << token;
+  return ss.str();
+}
+
 RandomPartitioner::Token RandomPartitioner::from_string(const StringRef& str) {
   Token token;
   parse_int128(str.data(), str.size(), &token.hi, &token.lo);
   return token;
 }
 
+String RandomPartitioner::to_cql(const Token& token) {
+  // Convert the unsigned 128-bit value to decimal by repeatedly dividing it by
+  // 10, 32 bits at a time for the low half so that nothing overflows.
+  char digits[40];
+  size_t count = 0;
+  uint64_t hi = token.hi;
+  uint64_t lo = token.lo;
+  do {
+    uint64_t remainder = hi % 10;
+    hi /= 10;
+    uint64_t dividend = (remainder << 32) | (lo >> 32);
+    uint64_t quotient_hi = dividend / 10;
+    dividend = ((dividend % 10) << 32) | (lo & 0xFFFFFFFFULL);
+    lo = (quotient_hi << 32) | (dividend / 10);
+    digits[count++] = static_cast<char>('0' + dividend % 10);
+  } while (hi != 0 || lo != 0);
+  String result;
+  result.reserve(count);
+  while (count > 0) {
+    result.push_back(digits[--count]);
+  }
+  return result;
+}
+
 uint64_t RandomPartitioner::encode(uint8_t* bytes) {
   uint64_t result = 0;
   const size_t num_bytes = sizeof(uint64_t);
@@ -128,11 +306,7 @@ RandomPartitioner::Token RandomPartitioner::abs(RandomPartitioner::Token token)
   return token;
 }
 
-RandomPartitioner::Token RandomPartitioner::hash(const StringRef& str) {
-  Md5 hash;
-  hash.update(reinterpret_cast<const uint8_t*>(str.data()), str.size());
-  uint8_t digest[16];
-  hash.final(digest);
+RandomPartitioner::Token RandomPartitioner::from_digest(uint8_t* digest) {
   Token token;
 
   // For compatability with Cassandra we interpret the MD5 as a big-endian value:
@@ -142,9 +316,32 @@ RandomPartitioner::Token RandomPartitioner::hash(const StringRef& str) {
   token.lo = encode(digest + 8);
 
   // Then we find the absolute value of the two's complement representation.
-  token = abs(token);
+  return abs(token);
+}
 
-  return token;
+RandomPartitioner::Token RandomPartitioner::hash(const StringRef& str) {
+  Md5 hash;
+  hash.update(reinterpret_cast<const uint8_t*>(str.data()), str.size());
+  uint8_t digest[16];
+  hash.final(digest);
+  return from_digest(digest);
+}
+
+void RandomPartitioner::hash_batch(const Vector<String>& strs, Token* output) {
+  if (strs.empty()) return;
+  Vector<const uint8_t*> keys;
+  Vector<size_t> lengths;
+  keys.reserve(strs.size());
+  lengths.reserve(strs.size());
+  for (Vector<String>::const_iterator i = strs.begin(), end = strs.end(); i != end; ++i) {
+    keys.push_back(reinterpret_cast<const uint8_t*>(i->data()));
+    lengths.push_back(i->size());
+  }
+  Vector<uint8_t> digests(16 * strs.size());
+  md5_batch(&keys[0], &lengths[0], keys.size(), &digests[0]);
+  for (size_t i = 0; i < strs.size(); ++i) {
+    output[i] = from_digest(&digests[16 * i]);
+  }
 }
 
 ByteOrderedPartitioner::Token ByteOrderedPartitioner::from_string(const StringRef& str) {
@@ -152,7 +349,24 @@ ByteOrderedPartitioner::Token ByteOrderedPartitioner::from_string(const StringRe
   return Token(data, data + str.size());
 }
 
+String ByteOrderedPartitioner::to_cql(const Token& token) {
+  static const char hex[] = "0123456789abcdef";
+  String result("0x");
+  result.reserve(2 + 2 * token.size());
+  for (Token::const_iterator it = token.begin(), end = token.end(); it != end; ++it) {
+    result.push_back(hex[*it >> 4]);
+    result.push_back(hex[*it & 0x0F]);
+  }
+  return result;
+}
+
 ByteOrderedPartitioner::Token ByteOrderedPartitioner::hash(const StringRef& str) {
   const uint8_t* data = reinterpret_cast<const uint8_t*>(str.data());
   return Token(data, data + str.size());
 }
+
+void ByteOrderedPartitioner::hash_batch(const Vector<String>& strs, Token* output) {
+  for (Vector<String>::const_iterator i = strs.begin(), end = strs.end(); i != end; ++i) {
+    *output++ = hash(*i);
+  }
+}
@@ -17,9 +17,12 @@
 #ifndef DATASTAX_INTERNAL_TOKEN_MAP_IMPL_HPP
 #define DATASTAX_INTERNAL_TOKEN_MAP_IMPL_HPP
 
+#include "atomic.hpp"
+#include "byte_ordered_token.hpp"
 #include "collection_iterator.hpp"
 #include "constants.hpp"
 #include "dense_hash_map.hpp"
+#include "flat_hash_map.hpp"
 #include "dense_hash_set.hpp"
 #include "deque.hpp"
 #include "json.hpp"
@@ -80,14 +83,14 @@ namespace datastax { namespace internal { namespace core {
 
 class IdGenerator {
 public:
-  typedef DenseHashMap<String, uint32_t> IdMap;
+  typedef FlatHashMap<InternedString, uint32_t> IdMap;
 
   static const uint32_t EMPTY_KEY;
   static const uint32_t DELETED_KEY;
 
-  IdGenerator() { ids_.set_empty_key(String()); }
+  uint32_t get(const String& key) { return get(InternedString(key)); }
 
-  uint32_t get(const String& key) {
+  uint32_t get(const InternedString& key) {
     if (key.empty()) {
       return 0;
     }
@@ -113,6 +116,8 @@ struct Murmur3Partitioner {
 
   static Token from_string(const StringRef& str);
   static Token hash(const StringRef& str);
+  static void hash_batch(const Vector<String>& strs, Token* output);
+  static String to_cql(const Token& token);
   static StringRef name() { return "Murmur3Partitioner"; }
 };
 
@@ -121,27 +126,34 @@ struct RandomPartitioner {
     uint64_t hi;
     uint64_t lo;
 
+    // The halves are combined with bitwise operators so that comparing tokens
+    // in the token lookups doesn't branch
     bool operator<(const Token& other) const {
-      return hi == other.hi ? lo < other.lo : hi < other.hi;
+      return (hi < other.hi) | ((hi == other.hi) & (lo < other.lo));
     }
 
-    bool operator==(const Token& other) const { return hi == other.hi && lo == other.lo; }
+    bool operator==(const Token& other) const { return (hi == other.hi) & (lo == other.lo); }
   };
 
   static Token abs(Token token);
   static uint64_t encode(uint8_t* bytes);
+  static Token from_digest(uint8_t* digest);
 
   static Token from_string(const StringRef& str);
   static Token hash(const StringRef& str);
+  static void hash_batch(const Vector<String>& strs, Token* output);
+  static String to_cql(const Token& token);
   static StringRef name() { return "RandomPartitioner"; }
 };
 
 class ByteOrderedPartitioner {
 public:
-  typedef Vector<uint8_t> Token;
+  typedef ByteOrderedToken Token;
 
   static Token from_string(const StringRef& str);
   static Token hash(const StringRef& str);
+  static void hash_batch(const Vector<String>& strs, Token* output);
+  static String to_cql(const Token& token);
   static StringRef name() { return "ByteOrderedPartitioner"; }
 };
 
@@ -219,11 +231,107 @@ inline void build_datacenters(const HostSet& hosts, DatacenterMap& result) {
   }
 }
 
+/**
+ * The number of threads used to build the replicas for a number of distinct
+ * replication strategies. Small token maps are built on the calling thread
+ * because starting threads would cost more than the build itself.
+ */
+size_t replicas_build_thread_count(size_t strategy_count, size_t token_count);
+
+/**
+ * Run a function on a number of threads, including the calling thread, and
+ * wait for all of them to return.
+ */
+void run_on_threads(size_t thread_count, void (*func)(void*), void* arg);
+
+/**
+ * Sort Murmur3 tokens and their hosts using a stable LSD radix sort on the
+ * 64-bit token. This is much faster than a comparison sort for the hundreds
+ * of thousands of vnode tokens of large clusters.
+ */
+void radix_sort_tokens(Vector<std::pair<int64_t, Host*> >& tokens);
+
+/**
+ * Sort tokens and their hosts by token. Murmur3 tokens use a radix sort and
+ * the other partitioners' tokens use a comparison sort.
+ */
+template <class TokenHostVec>
+inline void sort_tokens(TokenHostVec& tokens) {
+  std::sort(tokens.begin(), tokens.end());
+}
+
+inline void sort_tokens(Vector<std::pair<int64_t, Host*> >& tokens) { radix_sort_tokens(tokens); }
+
 class ReplicationFactorMap : public DenseHashMap<uint32_t, ReplicationFactor> {
 public:
   ReplicationFactorMap() { set_empty_key(IdGenerator::EMPTY_KEY); }
 };
 
+/**
+ * A search index of a token map's sorted tokens. The tokens are stored
+ * contiguously in Eytzinger (breadth-first) order with a parallel array of
+ * their sorted positions, so the first steps of every search share the same
+ * few cache lines and the search loop has no data-dependent branches.
+ */
+template <class Token>
+class TokenSearchIndex {
+public:
+  TokenSearchIndex()
+      : size_(0) {}
+
+  template <class TokenPairVec>
+  void build(const TokenPairVec& sorted) {
+    size_ = sorted.size();
+    tokens_.resize(size_ + 1); // The index is 1-based
+    positions_.resize(size_ + 1);
+    fill(sorted, 0, 1);
+  }
+
+  size_t size() const { return size_; }
+
+  size_t memory_bytes() const {
+    return tokens_.capacity() * sizeof(Token) + positions_.capacity() * sizeof(uint32_t);
+  }
+
+  /**
+   * Find the sorted position of the first token greater than a token.
+   *
+   * @param token The token to search for.
+   * @return The position or size() if all the tokens are less than or equal to
+   * the token.
+   */
+  size_t upper_bound(const Token& token) const {
+    size_t k = 1;
+    while (k <= size_) {
+      k = 2 * k + !(token < tokens_[k]);
+    }
+    // Undo the right turns taken after the last left turn; the node where
+    // that left turn was taken is the result.
+    while (k & 1) {
+      k >>= 1;
+    }
+    k >>= 1;
+    return k == 0 ? size_ : positions_[k];
+  }
+
+private:
+  template <class TokenPairVec>
+  size_t fill(const TokenPairVec& sorted, size_t i, size_t k) {
+    if (k <= size_) {
+      i = fill(sorted, i, 2 * k);
+      tokens_[k] = sorted[i].first;
+      positions_[k] = static_cast<uint32_t>(i++);
+      i = fill(sorted, i, 2 * k + 1);
+    }
+    return i;
+  }
+
+private:
+  size_t size_;
+  Vector<Token> tokens_;
+  Vector<uint32_t> positions_;
+};
+
 template <class Partitioner>
 class ReplicationStrategy {
 public:
@@ -256,6 +364,36 @@ public:
     }
   };
 
+  // The number of tokens visited to find each token's replicas
+  typedef Vector<uint32_t> TokenSpanVec;
+
+  // The number of replicas and the replication of each datacenter for
+  // building a token map's replicas.
+  struct BuildState {
+    BuildState()
+        : num_replicas(0) {}
+
+    bool operator==(const BuildState& other) const {
+      if (num_replicas != other.num_replicas || dc_racks.size() != other.dc_racks.size()) {
+        return false;
+      }
+      for (typename DatacenterRackInfoMap::const_iterator i = dc_racks.begin(),
+                                                          end = dc_racks.end();
+           i != end; ++i) {
+        typename DatacenterRackInfoMap::const_iterator j = other.dc_racks.find(i->first);
+        if (j == other.dc_racks.end() ||
+            i->second.replication_factor != j->second.replication_factor ||
+            i->second.rack_count != j->second.rack_count) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    size_t num_replicas;
+    DatacenterRackInfoMap dc_racks;
+  };
+
   enum Type { NETWORK_TOPOLOGY_STRATEGY, SIMPLE_STRATEGY, NON_REPLICATED };
 
   ReplicationStrategy()
@@ -268,15 +406,48 @@ public:
   }
 
   void build_replicas(const TokenHostVec& tokens, const DatacenterMap& datacenters,
-                      TokenReplicasVec& result) const;
+                      TokenReplicasVec& result, TokenSpanVec* spans = NULL) const;
+
+  /**
+   * Update the replicas built for a previous version of the token map. A
+   * token's previous replicas are reused when the tokens visited to find them
+   * are unchanged, so only the tokens near added or removed tokens are
+   * rebuilt.
+   *
+   * @param tokens The updated tokens.
+   * @param datacenters The updated datacenters.
+   * @param old_token_count The number of tokens before the update.
+   * @param old_datacenters The datacenters before the update.
+   * @param old_result The replicas before the update.
+   * @param old_spans The spans of the replicas before the update.
+   * @param old_indexes The index of each token before the update.
+   * @param unchanged_counts The number of unchanged tokens starting at each
+   * token. Zero for the tokens that were added.
+   * @param result The updated replicas.
+   * @param spans The spans of the updated replicas.
+   * @return false if the replicas couldn't be updated because the number of
+   * replicas or the replication of a datacenter changed, otherwise true.
+   */
+  bool update_replicas(const TokenHostVec& tokens, const DatacenterMap& datacenters,
+                       size_t old_token_count, const DatacenterMap& old_datacenters,
+                       const TokenReplicasVec& old_result, const TokenSpanVec& old_spans,
+                       const Vector<size_t>& old_indexes, const Vector<size_t>& unchanged_counts,
+                       TokenReplicasVec& result, TokenSpanVec& spans) const;
 
 private:
-  void build_replicas_network_topology(const TokenHostVec& tokens, const DatacenterMap& datacenters,
-                                       TokenReplicasVec& result) const;
-  void build_replicas_simple(const TokenHostVec& tokens, const DatacenterMap& datacenters,
-                             TokenReplicasVec& result) const;
-  void build_replicas_non_replicated(const TokenHostVec& tokens, const DatacenterMap& datacenters,
-                                     TokenReplicasVec& result) const;
+  bool init_build(size_t token_count, const DatacenterMap& datacenters, bool log_missing_dcs,
+                  BuildState& state) const;
+
+  size_t build_token_replicas(const TokenHostVec& tokens,
+                              typename TokenHostVec::const_iterator token_it, BuildState& state,
+                              CopyOnWriteHostVec& replicas) const;
+  size_t build_token_replicas_network_topology(const TokenHostVec& tokens,
+                                               typename TokenHostVec::const_iterator token_it,
+                                               BuildState& state,
+                                               CopyOnWriteHostVec& replicas) const;
+  size_t build_token_replicas_simple(const TokenHostVec& tokens,
+                                     typename TokenHostVec::const_iterator token_it,
+                                     BuildState& state, CopyOnWriteHostVec& replicas) const;
 
 private:
   Type type_;
@@ -360,21 +531,143 @@ void ReplicationStrategy<Partitioner>::init(IdGenerator& dc_ids,
 template <class Partitioner>
 void ReplicationStrategy<Partitioner>::build_replicas(const TokenHostVec& tokens,
                                                       const DatacenterMap& datacenters,
-                                                      TokenReplicasVec& result) const {
+                                                      TokenReplicasVec& result,
+                                                      TokenSpanVec* spans) const {
   result.clear();
   result.reserve(tokens.size());
+  if (spans) {
+    spans->clear();
+    spans->reserve(tokens.size());
+  }
+
+  BuildState state;
+  if (!init_build(tokens.size(), datacenters, true, state)) {
+    return;
+  }
+
+  for (typename TokenHostVec::const_iterator i = tokens.begin(), end = tokens.end(); i != end;
+       ++i) {
+    CopyOnWriteHostVec replicas(new HostVec());
+    replicas->reserve(state.num_replicas);
+    size_t span = build_token_replicas(tokens, i, state, replicas);
+    result.push_back(TokenReplicas(i->first, replicas));
+    if (spans) spans->push_back(static_cast<uint32_t>(span));
+  }
+}
+
+template <class Partitioner>
+bool ReplicationStrategy<Partitioner>::update_replicas(
+    const TokenHostVec& tokens, const DatacenterMap& datacenters, size_t old_token_count,
+    const DatacenterMap& old_datacenters, const TokenReplicasVec& old_result,
+    const TokenSpanVec& old_spans, const Vector<size_t>& old_indexes,
+    const Vector<size_t>& unchanged_counts, TokenReplicasVec& result, TokenSpanVec& spans) const {
+  BuildState old_state;
+  bool has_old_replicas = init_build(old_token_count, old_datacenters, false, old_state);
+
+  BuildState state;
+  bool has_replicas = init_build(tokens.size(), datacenters, true, state);
+
+  // The replicas of the unchanged tokens are only the same if they were built
+  // using the same replication and from all of the previous tokens. Hosts
+  // added without building the token map are missing from the replicas.
+  if (has_old_replicas != has_replicas || !(old_state == state) ||
+      old_spans.size() != old_result.size() ||
+      (has_old_replicas && old_spans.size() != old_token_count)) {
+    return false;
+  }
+
+  result.clear();
+  spans.clear();
+  if (!has_replicas) {
+    return true;
+  }
+
+  result.reserve(tokens.size());
+  spans.reserve(tokens.size());
+
+  for (typename TokenHostVec::const_iterator i = tokens.begin(), end = tokens.end(); i != end;
+       ++i) {
+    size_t index = i - tokens.begin();
+    size_t unchanged_count = unchanged_counts[index];
+    if (unchanged_count > 0 && unchanged_count >= old_spans[old_indexes[index]]) {
+      result.push_back(old_result[old_indexes[index]]);
+      spans.push_back(old_spans[old_indexes[index]]);
+    } else {
+      CopyOnWriteHostVec replicas(new HostVec());
+      replicas->reserve(state.num_replicas);
+      size_t span = build_token_replicas(tokens, i, state, replicas);
+      result.push_back(TokenReplicas(i->first, replicas));
+      spans.push_back(static_cast<uint32_t>(span));
+    }
+  }
+  return true;
+}
 
+template <class Partitioner>
+bool ReplicationStrategy<Partitioner>::init_build(size_t token_count,
+                                                  const DatacenterMap& datacenters,
+                                                  bool log_missing_dcs, BuildState& state) const {
   switch (type_) {
-    case NETWORK_TOPOLOGY_STRATEGY:
-      build_replicas_network_topology(tokens, datacenters, result);
+    case NETWORK_TOPOLOGY_STRATEGY: {
+      if (replication_factors_.empty()) {
+        return false;
+      }
+
+      state.dc_racks.resize(datacenters.size());
+
+      // Populate the datacenter and rack information. Only considering valid
+      // datacenters that actually have hosts. If there's a replication factor
+      // for a datacenter that doesn't exist or has no node then it will not
+      // be counted.
+      for (ReplicationFactorMap::const_iterator i = replication_factors_.begin(),
+                                                end = replication_factors_.end();
+           i != end; ++i) {
+        DatacenterMap::const_iterator j = datacenters.find(i->first);
+        // Don't include datacenters that don't exist
+        if (j != datacenters.end()) {
+          // A replication factor cannot exceed the number of nodes in a datacenter
+          size_t replication_factor = std::min<size_t>(i->second.count, j->second.num_nodes);
+          state.num_replicas += replication_factor;
+          DatacenterRackInfo dc_rack_info;
+          dc_rack_info.replication_factor = replication_factor;
+          dc_rack_info.rack_count = j->second.racks.size();
+          state.dc_racks[j->first] = dc_rack_info;
+        } else if (log_missing_dcs) {
+          LOG_WARN("No nodes in datacenter '%s'. Check your replication strategies.",
+                   i->second.name.c_str());
+        }
+      }
       break;
-    case SIMPLE_STRATEGY:
-      build_replicas_simple(tokens, datacenters, result);
+    }
+    case SIMPLE_STRATEGY: {
+      ReplicationFactorMap::const_iterator it = replication_factors_.find(1);
+      if (it == replication_factors_.end()) {
+        return false;
+      }
+      state.num_replicas = std::min<size_t>(it->second.count, token_count);
       break;
+    }
     default:
-      build_replicas_non_replicated(tokens, datacenters, result);
+      state.num_replicas = 1;
       break;
   }
+
+  return state.num_replicas > 0;
+}
+
+template <class Partitioner>
+size_t ReplicationStrategy<Partitioner>::build_token_replicas(
+    const TokenHostVec& tokens, typename TokenHostVec::const_iterator token_it, BuildState& state,
+    CopyOnWriteHostVec& replicas) const {
+  switch (type_) {
+    case NETWORK_TOPOLOGY_STRATEGY:
+      return build_token_replicas_network_topology(tokens, token_it, state, replicas);
+    case SIMPLE_STRATEGY:
+      return build_token_replicas_simple(tokens, token_it, state, replicas);
+    default:
+      replicas->push_back(Host::Ptr(token_it->second));
+      return 1;
+  }
 }
 
 // Adds unique replica. It returns true if the replica was added.
@@ -389,158 +682,100 @@ inline bool add_replica(CopyOnWriteHostVec& hosts, const Host::Ptr& host) {
 }
 
 template <class Partitioner>
-void ReplicationStrategy<Partitioner>::build_replicas_network_topology(
-    const TokenHostVec& tokens, const DatacenterMap& datacenters, TokenReplicasVec& result) const {
-  if (replication_factors_.empty()) {
-    return;
+size_t ReplicationStrategy<Partitioner>::build_token_replicas_network_topology(
+    const TokenHostVec& tokens, typename TokenHostVec::const_iterator token_it, BuildState& state,
+    CopyOnWriteHostVec& replicas) const {
+  DatacenterRackInfoMap& dc_racks = state.dc_racks;
+  const size_t num_replicas = state.num_replicas;
+
+  // Clear datacenter and rack information for the next token
+  for (typename DatacenterRackInfoMap::iterator j = dc_racks.begin(), end = dc_racks.end();
+       j != end; ++j) {
+    j->second.replica_count = 0;
+    j->second.racks_observed.clear();
+    j->second.skipped_endpoints.clear();
   }
 
-  DatacenterRackInfoMap dc_racks;
-  dc_racks.resize(datacenters.size());
-
-  size_t num_replicas = 0;
-
-  // Populate the datacenter and rack information. Only considering valid
-  // datacenters that actually have hosts. If there's a replication factor
-  // for a datacenter that doesn't exist or has no node then it will not
-  // be counted.
-  for (ReplicationFactorMap::const_iterator i = replication_factors_.begin(),
-                                            end = replication_factors_.end();
-       i != end; ++i) {
-    DatacenterMap::const_iterator j = datacenters.find(i->first);
-    // Don't include datacenters that don't exist
-    if (j != datacenters.end()) {
-      // A replication factor cannot exceed the number of nodes in a datacenter
-      size_t replication_factor = std::min<size_t>(i->second.count, j->second.num_nodes);
-      num_replicas += replication_factor;
-      DatacenterRackInfo dc_rack_info;
-      dc_rack_info.replication_factor = replication_factor;
-      dc_rack_info.rack_count = j->second.racks.size();
-      dc_racks[j->first] = dc_rack_info;
-    } else {
-      LOG_WARN("No nodes in datacenter '%s'. Check your replication strategies.",
-               i->second.name.c_str());
+  size_t span = 0;
+  for (typename TokenHostVec::const_iterator j = tokens.begin(), end = tokens.end();
+       j != end && replicas->size() < num_replicas; ++j) {
+    typename TokenHostVec::const_iterator curr_token_it = token_it;
+    Host* host = curr_token_it->second;
+    uint32_t dc = host->dc_id();
+    uint32_t rack = host->rack_id();
+
+    ++span;
+    ++token_it;
+    if (token_it == tokens.end()) {
+      token_it = tokens.begin();
     }
-  }
 
-  if (num_replicas == 0) {
-    return;
-  }
+    typename DatacenterRackInfoMap::iterator dc_rack_it = dc_racks.find(dc);
+    if (dc_rack_it == dc_racks.end()) {
+      continue;
+    }
 
-  for (typename TokenHostVec::const_iterator i = tokens.begin(), end = tokens.end(); i != end;
-       ++i) {
-    Token token = i->first;
-    typename TokenHostVec::const_iterator token_it = i;
+    DatacenterRackInfo& dc_rack_info = dc_rack_it->second;
 
-    CopyOnWriteHostVec replicas(new HostVec());
-    replicas->reserve(num_replicas);
-
-    // Clear datacenter and rack information for the next token
-    for (typename DatacenterRackInfoMap::iterator j = dc_racks.begin(), end = dc_racks.end();
-         j != end; ++j) {
-      j->second.replica_count = 0;
-      j->second.racks_observed.clear();
-      j->second.skipped_endpoints.clear();
-    }
-
-    for (typename TokenHostVec::const_iterator j = tokens.begin(), end = tokens.end();
-         j != end && replicas->size() < num_replicas; ++j) {
-      typename TokenHostVec::const_iterator curr_token_it = token_it;
-      Host* host = curr_token_it->second;
-      uint32_t dc = host->dc_id();
-      uint32_t rack = host->rack_id();
-
-      ++token_it;
-      if (token_it == tokens.end()) {
-        token_it = tokens.begin();
-      }
+    size_t& replica_count_this_dc = dc_rack_info.replica_count;
+    const size_t replication_factor = dc_rack_info.replication_factor;
 
-      typename DatacenterRackInfoMap::iterator dc_rack_it = dc_racks.find(dc);
-      if (dc_rack_it == dc_racks.end()) {
-        continue;
-      }
+    if (replica_count_this_dc >= replication_factor) {
+      continue;
+    }
 
-      DatacenterRackInfo& dc_rack_info = dc_rack_it->second;
+    RackSet& racks_observed_this_dc = dc_rack_info.racks_observed;
+    const size_t rack_count_this_dc = dc_rack_info.rack_count;
 
-      size_t& replica_count_this_dc = dc_rack_info.replica_count;
-      const size_t replication_factor = dc_rack_info.replication_factor;
+    // First, attempt to distribute replicas over all possible racks in a
+    // datacenter only then consider hosts in the same rack
 
-      if (replica_count_this_dc >= replication_factor) {
-        continue;
+    if (rack == 0 || racks_observed_this_dc.size() == rack_count_this_dc) {
+      if (add_replica(replicas, Host::Ptr(host))) {
+        ++replica_count_this_dc;
       }
-
-      RackSet& racks_observed_this_dc = dc_rack_info.racks_observed;
-      const size_t rack_count_this_dc = dc_rack_info.rack_count;
-
-      // First, attempt to distribute replicas over all possible racks in a
-      // datacenter only then consider hosts in the same rack
-
-      if (rack == 0 || racks_observed_this_dc.size() == rack_count_this_dc) {
+    } else {
+      TokenHostQueue& skipped_endpoints_this_dc = dc_rack_info.skipped_endpoints;
+      if (racks_observed_this_dc.count(rack) > 0) {
+        skipped_endpoints_this_dc.push_back(curr_token_it);
+      } else {
         if (add_replica(replicas, Host::Ptr(host))) {
           ++replica_count_this_dc;
+          racks_observed_this_dc.insert(rack);
         }
-      } else {
-        TokenHostQueue& skipped_endpoints_this_dc = dc_rack_info.skipped_endpoints;
-        if (racks_observed_this_dc.count(rack) > 0) {
-          skipped_endpoints_this_dc.push_back(curr_token_it);
-        } else {
-          if (add_replica(replicas, Host::Ptr(host))) {
-            ++replica_count_this_dc;
-            racks_observed_this_dc.insert(rack);
-          }
 
-          // Once we visited every rack in the current datacenter then starting considering
-          // hosts we've already skipped.
-          if (racks_observed_this_dc.size() == rack_count_this_dc) {
-            while (!skipped_endpoints_this_dc.empty() &&
-                   replica_count_this_dc < replication_factor) {
-              if (add_replica(replicas, Host::Ptr(skipped_endpoints_this_dc.front()->second))) {
-                ++replica_count_this_dc;
-              }
-              skipped_endpoints_this_dc.pop_front();
+        // Once we visited every rack in the current datacenter then starting considering
+        // hosts we've already skipped.
+        if (racks_observed_this_dc.size() == rack_count_this_dc) {
+          while (!skipped_endpoints_this_dc.empty() &&
+                 replica_count_this_dc < replication_factor) {
+            if (add_replica(replicas, Host::Ptr(skipped_endpoints_this_dc.front()->second))) {
+              ++replica_count_this_dc;
             }
+            skipped_endpoints_this_dc.pop_front();
           }
         }
       }
     }
-
-    result.push_back(TokenReplicas(token, replicas));
   }
+
+  return span;
 }
 
 template <class Partitioner>
-void ReplicationStrategy<Partitioner>::build_replicas_simple(const TokenHostVec& tokens,
-                                                             const DatacenterMap& not_used,
-                                                             TokenReplicasVec& result) const {
-  ReplicationFactorMap::const_iterator it = replication_factors_.find(1);
-  if (it == replication_factors_.end()) {
-    return;
-  }
+size_t ReplicationStrategy<Partitioner>::build_token_replicas_simple(
+    const TokenHostVec& tokens, typename TokenHostVec::const_iterator token_it, BuildState& state,
+    CopyOnWriteHostVec& replicas) const {
   const size_t num_tokens = tokens.size();
-  const size_t num_replicas = std::min<size_t>(it->second.count, num_tokens);
-  for (typename TokenHostVec::const_iterator i = tokens.begin(), end = tokens.end(); i != end;
-       ++i) {
-    CopyOnWriteHostVec replicas(new HostVec());
-    replicas->reserve(num_replicas);
-    typename TokenHostVec::const_iterator token_it = i;
-    for (size_t j = 0; j < num_tokens && replicas->size() < num_replicas; ++j) {
-      add_replica(replicas, Host::Ptr(Host::Ptr(token_it->second)));
-      ++token_it;
-      if (token_it == tokens.end()) {
-        token_it = tokens.begin();
-      }
+  size_t span = 0;
+  for (; span < num_tokens && replicas->size() < state.num_replicas; ++span) {
+    add_replica(replicas, Host::Ptr(token_it->second));
+    ++token_it;
+    if (token_it == tokens.end()) {
+      token_it = tokens.begin();
     }
-    result.push_back(TokenReplicas(i->first, replicas));
-  }
-}
-
-template <class Partitioner>
-void ReplicationStrategy<Partitioner>::build_replicas_non_replicated(
-    const TokenHostVec& tokens, const DatacenterMap& not_used, TokenReplicasVec& result) const {
-  for (typename TokenHostVec::const_iterator i = tokens.begin(); i != tokens.end(); ++i) {
-    CopyOnWriteHostVec replicas(new HostVec(1, Host::Ptr(i->second)));
-    result.push_back(TokenReplicas(i->first, replicas));
   }
+  return span;
 }
 
 template <class Partitioner>
@@ -580,13 +815,49 @@ public:
     }
   };
 
-  typedef DenseHashMap<String, TokenReplicasVec> KeyspaceReplicaMap;
+  // The replicas for a replication strategy. Keyspaces with the same
+  // replication settings share a single instance.
+  struct SharedReplicas : public RefCounted<SharedReplicas> {
+    typedef SharedRefPtr<SharedReplicas> Ptr;
+    TokenReplicasVec replicas;
+    typename ReplicationStrategy<Partitioner>::TokenSpanVec spans;
+  };
+
+  typedef Vector<typename SharedReplicas::Ptr> SharedReplicasVec;
+  typedef FlatHashMap<InternedString, typename SharedReplicas::Ptr> KeyspaceReplicaMap;
   typedef DenseHashMap<String, ReplicationStrategy<Partitioner> > KeyspaceStrategyMap;
 
+  // Builds the replicas for distinct replication strategies. Threads take the
+  // next unbuilt strategy until there are none left.
+  struct ReplicasBuilder {
+    ReplicasBuilder(const Vector<const ReplicationStrategy<Partitioner>*>& strategies,
+                    const TokenHostVec& tokens, const DatacenterMap& datacenters,
+                    SharedReplicasVec& results)
+        : strategies(strategies)
+        , tokens(tokens)
+        , datacenters(datacenters)
+        , results(results)
+        , next(0) {}
+
+    static void on_run(void* arg) {
+      ReplicasBuilder* builder = static_cast<ReplicasBuilder*>(arg);
+      size_t i;
+      while ((i = builder->next.fetch_add(1)) < builder->strategies.size()) {
+        builder->strategies[i]->build_replicas(builder->tokens, builder->datacenters,
+                                               builder->results[i]->replicas,
+                                               &builder->results[i]->spans);
+      }
+    }
+
+    const Vector<const ReplicationStrategy<Partitioner>*>& strategies;
+    const TokenHostVec& tokens;
+    const DatacenterMap& datacenters;
+    SharedReplicasVec& results;
+    Atomic<size_t> next;
+  };
+
   TokenMapImpl()
       : no_replicas_dummy_(NULL) {
-    replicas_.set_empty_key(String());
-    replicas_.set_deleted_key(String(1, '\0'));
     strategies_.set_empty_key(String());
     strategies_.set_deleted_key(String(1, '\0'));
   }
@@ -598,8 +869,10 @@ public:
       , strategies_(other.strategies_)
       , rack_ids_(other.rack_ids_)
       , dc_ids_(other.dc_ids_)
+      , token_index_(other.token_index_)
       , no_replicas_dummy_(NULL) {}
 
+  virtual void reserve_tokens(size_t count);
   virtual void add_host(const Host::Ptr& host);
   virtual void update_host_and_build(const Host::Ptr& host);
   virtual void remove_host_and_build(const Host::Ptr& host);
@@ -616,8 +889,18 @@ public:
   virtual const CopyOnWriteHostVec& get_replicas(const String& keyspace_name,
                                                  const String& routing_key) const;
 
+  virtual const CopyOnWriteHostVec& get_replicas(const InternedString& keyspace_name,
+                                                 const String& routing_key) const;
+
+  virtual void get_replicas(const String& keyspace_name, const Vector<String>& routing_keys,
+                            Vector<CopyOnWriteHostVec>& replicas) const;
+
+  virtual void get_token_ranges(const String& keyspace_name, TokenRangeVec& ranges) const;
+
   virtual String dump(const String& keyspace_name) const;
 
+  virtual void get_metrics(TokenMapMetrics* metrics) const;
+
 public:
   // Testing only
 
@@ -636,7 +919,13 @@ private:
                        bool should_build_replicas);
   void remove_host_tokens(const Host::Ptr& host);
   void update_host_ids(const Host::Ptr& host);
+  const CopyOnWriteHostVec& find_replicas(const TokenReplicasVec& replicas,
+                                          const Token& token) const;
   void build_replicas();
+  void update_replicas(const TokenHostVec& old_tokens, const DatacenterMap& old_datacenters,
+                       const Host::Ptr& host);
+  void map_unchanged_tokens(const TokenHostVec& old_tokens, const Host::Ptr& host,
+                            Vector<size_t>& old_indexes, Vector<size_t>& unchanged_counts) const;
 
 private:
   TokenHostVec tokens_;
@@ -646,9 +935,15 @@ private:
   KeyspaceStrategyMap strategies_;
   IdGenerator rack_ids_;
   IdGenerator dc_ids_;
+  TokenSearchIndex<Token> token_index_;
   CopyOnWriteHostVec no_replicas_dummy_;
 };
 
+template <class Partitioner>
+void TokenMapImpl<Partitioner>::reserve_tokens(size_t count) {
+  tokens_.reserve(tokens_.size() + count);
+}
+
 template <class Partitioner>
 void TokenMapImpl<Partitioner>::add_host(const Host::Ptr& host) {
   update_host_ids(host);
@@ -664,6 +959,9 @@ void TokenMapImpl<Partitioner>::add_host(const Host::Ptr& host) {
 template <class Partitioner>
 void TokenMapImpl<Partitioner>::update_host_and_build(const Host::Ptr& host) {
   uint64_t start = uv_hrtime();
+  TokenHostVec old_tokens(tokens_);
+  DatacenterMap old_datacenters;
+  build_datacenters(hosts_, old_datacenters);
   remove_host_tokens(host);
 
   update_host_ids(host);
@@ -671,19 +969,20 @@ void TokenMapImpl<Partitioner>::update_host_and_build(const Host::Ptr& host) {
 
   TokenHostVec new_tokens;
   const Vector<String>& tokens(host->tokens());
+  new_tokens.reserve(tokens.size());
   for (Vector<String>::const_iterator it = tokens.begin(), end = tokens.end(); it != end; ++it) {
     Token token = Partitioner::from_string(*it);
     new_tokens.push_back(TokenHost(token, host.get()));
   }
 
-  std::sort(new_tokens.begin(), new_tokens.end());
+  sort_tokens(new_tokens);
 
   TokenHostVec merged(tokens_.size() + new_tokens.size());
   std::merge(tokens_.begin(), tokens_.end(), new_tokens.begin(), new_tokens.end(), merged.begin(),
              TokenHostCompare());
   tokens_ = merged;
 
-  build_replicas();
+  update_replicas(old_tokens, old_datacenters, host);
   LOG_DEBUG("Updated token map with host %s (%u tokens). Rebuilt token map with %u hosts and %u "
             "tokens in %f ms",
             host->address_string().c_str(), (unsigned int)new_tokens.size(),
@@ -695,9 +994,12 @@ template <class Partitioner>
 void TokenMapImpl<Partitioner>::remove_host_and_build(const Host::Ptr& host) {
   if (hosts_.find(host) == hosts_.end()) return;
   uint64_t start = uv_hrtime();
+  TokenHostVec old_tokens(tokens_);
+  DatacenterMap old_datacenters;
+  build_datacenters(hosts_, old_datacenters);
   remove_host_tokens(host);
   hosts_.erase(host);
-  build_replicas();
+  update_replicas(old_tokens, old_datacenters, host);
   LOG_DEBUG(
       "Removed host %s from token map. Rebuilt token map with %u hosts and %u tokens in %f ms",
       host->address_string().c_str(), (unsigned int)hosts_.size(), (unsigned int)tokens_.size(),
@@ -718,14 +1020,14 @@ void TokenMapImpl<Partitioner>::update_keyspaces_and_build(const VersionNumber&
 
 template <class Partitioner>
 void TokenMapImpl<Partitioner>::drop_keyspace(const String& keyspace_name) {
-  replicas_.erase(keyspace_name);
+  replicas_.erase(InternedString::find(keyspace_name));
   strategies_.erase(keyspace_name);
 }
 
 template <class Partitioner>
 void TokenMapImpl<Partitioner>::build() {
   uint64_t start = uv_hrtime();
-  std::sort(tokens_.begin(), tokens_.end());
+  sort_tokens(tokens_);
   build_replicas();
   LOG_DEBUG("Built token map with %u hosts and %u tokens in %f ms", (unsigned int)hosts_.size(),
             (unsigned int)tokens_.size(), (double)(uv_hrtime() - start) / (1000.0 * 1000.0));
@@ -739,29 +1041,95 @@ TokenMap::Ptr TokenMapImpl<Partitioner>::copy() const {
 template <class Partitioner>
 const CopyOnWriteHostVec& TokenMapImpl<Partitioner>::get_replicas(const String& keyspace_name,
                                                                   const String& routing_key) const {
+  return get_replicas(InternedString::find(keyspace_name), routing_key);
+}
+
+template <class Partitioner>
+const CopyOnWriteHostVec&
+TokenMapImpl<Partitioner>::get_replicas(const InternedString& keyspace_name,
+                                        const String& routing_key) const {
   typename KeyspaceReplicaMap::const_iterator ks_it = replicas_.find(keyspace_name);
 
   if (ks_it != replicas_.end()) {
-    Token token = Partitioner::hash(routing_key);
-    const TokenReplicasVec& replicas = ks_it->second;
-    typename TokenReplicasVec::const_iterator replicas_it =
-        std::upper_bound(replicas.begin(), replicas.end(), TokenReplicas(token, no_replicas_dummy_),
-                         TokenReplicasCompare());
-    if (replicas_it != replicas.end()) {
-      return replicas_it->second;
-    } else if (!replicas.empty()) {
-      return replicas.front().second;
-    }
+    return find_replicas(ks_it->second->replicas, Partitioner::hash(routing_key));
   }
 
   return no_replicas_dummy_;
 }
 
+template <class Partitioner>
+void TokenMapImpl<Partitioner>::get_replicas(const String& keyspace_name,
+                                             const Vector<String>& routing_keys,
+                                             Vector<CopyOnWriteHostVec>& replicas) const {
+  replicas.clear();
+  replicas.reserve(routing_keys.size());
+
+  typename KeyspaceReplicaMap::const_iterator ks_it =
+      replicas_.find(InternedString::find(keyspace_name));
+  if (ks_it == replicas_.end() || routing_keys.empty()) {
+    replicas.resize(routing_keys.size(), no_replicas_dummy_);
+    return;
+  }
+
+  Vector<Token> tokens(routing_keys.size());
+  Partitioner::hash_batch(routing_keys, &tokens[0]);
+  for (typename Vector<Token>::const_iterator i = tokens.begin(), end = tokens.end(); i != end;
+       ++i) {
+    replicas.push_back(find_replicas(ks_it->second->replicas, *i));
+  }
+}
+
+template <class Partitioner>
+const CopyOnWriteHostVec& TokenMapImpl<Partitioner>::find_replicas(const TokenReplicasVec& replicas,
+                                                                   const Token& token) const {
+  // The replicas are in the same order as the indexed tokens unless the
+  // keyspace was built from a different set of tokens
+  if (!replicas.empty() && replicas.size() == token_index_.size()) {
+    size_t index = token_index_.upper_bound(token);
+    return replicas[index < replicas.size() ? index : 0].second;
+  }
+  typename TokenReplicasVec::const_iterator replicas_it =
+      std::upper_bound(replicas.begin(), replicas.end(), TokenReplicas(token, no_replicas_dummy_),
+                       TokenReplicasCompare());
+  if (replicas_it != replicas.end()) {
+    return replicas_it->second;
+  } else if (!replicas.empty()) {
+    return replicas.front().second;
+  }
+  return no_replicas_dummy_;
+}
+
+template <class Partitioner>
+void TokenMapImpl<Partitioner>::get_token_ranges(const String& keyspace_name,
+                                                 TokenRangeVec& ranges) const {
+  ranges.clear();
+  typename KeyspaceReplicaMap::const_iterator ks_it =
+      replicas_.find(InternedString::find(keyspace_name));
+  if (ks_it == replicas_.end()) return;
+  const TokenReplicasVec& replicas = ks_it->second->replicas;
+  if (replicas.empty()) return;
+
+  // Each token owns the range from the previous token (exclusive) up to itself
+  // (inclusive). The first token also owns the range after the last token.
+  ranges.reserve(replicas.size() + 1);
+  String previous(Partitioner::to_cql(replicas.front().first));
+  ranges.push_back(TokenRange(String(), previous, replicas.front().second));
+  for (typename TokenReplicasVec::const_iterator it = replicas.begin() + 1, end = replicas.end();
+       it != end; ++it) {
+    String current(Partitioner::to_cql(it->first));
+    ranges.push_back(TokenRange(previous, current, it->second));
+    previous = current;
+  }
+  ranges.push_back(TokenRange(previous, String(), replicas.front().second));
+}
+
 template <class Partitioner>
 String TokenMapImpl<Partitioner>::dump(const String& keyspace_name) const {
   String result;
-  typename KeyspaceReplicaMap::const_iterator ks_it = replicas_.find(keyspace_name);
-  const TokenReplicasVec& replicas = ks_it->second;
+  typename KeyspaceReplicaMap::const_iterator ks_it =
+      replicas_.find(InternedString::find(keyspace_name));
+  if (ks_it == replicas_.end()) return result;
+  const TokenReplicasVec& replicas = ks_it->second->replicas;
 
   for (typename TokenReplicasVec::const_iterator it = replicas.begin(), end = replicas.end();
        it != end; ++it) {
@@ -781,9 +1149,36 @@ String TokenMapImpl<Partitioner>::dump(const String& keyspace_name) const {
 template <class Partitioner>
 const typename TokenMapImpl<Partitioner>::TokenReplicasVec&
 TokenMapImpl<Partitioner>::token_replicas(const String& keyspace_name) const {
-  typename KeyspaceReplicaMap::const_iterator ks_it = replicas_.find(keyspace_name);
+  typename KeyspaceReplicaMap::const_iterator ks_it =
+      replicas_.find(InternedString::find(keyspace_name));
   static TokenReplicasVec not_found;
-  return ks_it != replicas_.end() ? ks_it->second : not_found;
+  return ks_it != replicas_.end() ? ks_it->second->replicas : not_found;
+}
+
+template <class Partitioner>
+void TokenMapImpl<Partitioner>::get_metrics(TokenMapMetrics* metrics) const {
+  metrics->keyspaces = replicas_.size();
+  metrics->tokens = tokens_.size();
+  metrics->replica_vectors = 0;
+  metrics->memory_bytes = tokens_.capacity() * sizeof(TokenHost) + token_index_.memory_bytes();
+
+  DenseHashSet<const SharedReplicas*> counted;
+  counted.set_empty_key(NULL);
+  for (typename KeyspaceReplicaMap::const_iterator i = replicas_.begin(), end = replicas_.end();
+       i != end; ++i) {
+    metrics->memory_bytes +=
+        sizeof(typename KeyspaceReplicaMap::value_type) + i->first.str().capacity();
+    if (!counted.insert(i->second.get()).second) continue; // Shared with another keyspace
+
+    const TokenReplicasVec& replicas = i->second->replicas;
+    metrics->replica_vectors++;
+    metrics->memory_bytes += sizeof(SharedReplicas) + replicas.capacity() * sizeof(TokenReplicas) +
+                             i->second->spans.capacity() * sizeof(uint32_t);
+    for (typename TokenReplicasVec::const_iterator it = replicas.begin(), end = replicas.end();
+         it != end; ++it) {
+      metrics->memory_bytes += sizeof(HostVec) + it->second->capacity() * sizeof(Host::Ptr);
+    }
+  }
 }
 
 template <class Partitioner>
@@ -815,7 +1210,26 @@ void TokenMapImpl<Partitioner>::update_keyspace(const VersionNumber& cassandra_v
       if (should_build_replicas) {
         uint64_t start = uv_hrtime();
         build_datacenters(hosts_, datacenters_);
-        strategy.build_replicas(tokens_, datacenters_, replicas_[keyspace_name]);
+        // Reuse the replicas of a keyspace with the same replication settings
+        bool is_reused = false;
+        for (typename KeyspaceStrategyMap::const_iterator j = strategies_.begin(),
+                                                          end = strategies_.end();
+             j != end; ++j) {
+          if (j->first != keyspace_name && !(j->second != strategy)) {
+            typename KeyspaceReplicaMap::const_iterator replicas =
+                replicas_.find(InternedString::find(j->first));
+            if (replicas != replicas_.end()) {
+              replicas_[InternedString(keyspace_name)] = replicas->second; // Interned
+              is_reused = true;
+              break;
+            }
+          }
+        }
+        if (!is_reused) {
+          typename SharedReplicas::Ptr replicas(new SharedReplicas());
+          strategy.build_replicas(tokens_, datacenters_, replicas->replicas, &replicas->spans);
+          replicas_[InternedString(keyspace_name)] = replicas;
+        }
         LOG_DEBUG("Updated token map with keyspace '%s'. Rebuilt token map with %u hosts and %u "
                   "tokens in %f ms",
                   keyspace_name.c_str(), (unsigned int)hosts_.size(), (unsigned int)tokens_.size(),
@@ -834,21 +1248,156 @@ void TokenMapImpl<Partitioner>::remove_host_tokens(const Host::Ptr& host) {
 
 template <class Partitioner>
 void TokenMapImpl<Partitioner>::update_host_ids(const Host::Ptr& host) {
-  host->set_rack_and_dc_ids(rack_ids_.get(host->rack()), dc_ids_.get(host->dc()));
+  host->set_rack_and_dc_ids(rack_ids_.get(host->interned_rack()), dc_ids_.get(host->interned_dc()));
 }
 
 template <class Partitioner>
 void TokenMapImpl<Partitioner>::build_replicas() {
   build_datacenters(hosts_, datacenters_);
+  token_index_.build(tokens_);
+
+  // Keyspaces with the same replication settings have the same replicas so
+  // they're only built once for each distinct strategy.
+  Vector<const ReplicationStrategy<Partitioner>*> distinct;
+  Vector<size_t> indexes;
+  indexes.reserve(strategies_.size());
+  for (typename KeyspaceStrategyMap::const_iterator i = strategies_.begin(),
+                                                    end = strategies_.end();
+       i != end; ++i) {
+    size_t index = 0;
+    while (index < distinct.size() && *distinct[index] != i->second) {
+      ++index;
+    }
+    if (index == distinct.size()) {
+      distinct.push_back(&i->second);
+    }
+    indexes.push_back(index);
+  }
+
+  SharedReplicasVec results;
+  results.reserve(distinct.size());
+  for (size_t i = 0; i < distinct.size(); ++i) {
+    results.push_back(typename SharedReplicas::Ptr(new SharedReplicas()));
+  }
+  ReplicasBuilder builder(distinct, tokens_, datacenters_, results);
+  run_on_threads(replicas_build_thread_count(distinct.size(), tokens_.size()),
+                 ReplicasBuilder::on_run, &builder);
+
+  size_t index = 0;
   for (typename KeyspaceStrategyMap::const_iterator i = strategies_.begin(),
                                                     end = strategies_.end();
        i != end; ++i) {
     const String& keyspace_name = i->first;
-    const ReplicationStrategy<Partitioner>& strategy = i->second;
-    strategy.build_replicas(tokens_, datacenters_, replicas_[keyspace_name]);
+    replicas_[InternedString(keyspace_name)] = results[indexes[index++]];
     LOG_TRACE("Replicas for keyspace '%s':\n%s", keyspace_name.c_str(),
               dump(keyspace_name).c_str());
   }
+  LOG_DEBUG("Built replicas for %u keyspaces using %u distinct replication strategies",
+            (unsigned int)strategies_.size(), (unsigned int)distinct.size());
+}
+
+template <class Partitioner>
+void TokenMapImpl<Partitioner>::update_replicas(const TokenHostVec& old_tokens,
+                                                const DatacenterMap& old_datacenters,
+                                                const Host::Ptr& host) {
+  build_datacenters(hosts_, datacenters_);
+  token_index_.build(tokens_);
+
+  // Keyspaces that share replicas have the same replication strategy so each
+  // shared replicas is only updated once.
+  Vector<std::pair<const ReplicationStrategy<Partitioner>*, const SharedReplicas*> > distinct;
+  Vector<size_t> indexes;
+  indexes.reserve(strategies_.size());
+  for (typename KeyspaceStrategyMap::const_iterator i = strategies_.begin(),
+                                                    end = strategies_.end();
+       i != end; ++i) {
+    typename KeyspaceReplicaMap::const_iterator replicas =
+        replicas_.find(InternedString::find(i->first));
+    if (replicas == replicas_.end()) {
+      build_replicas(); // The keyspace's replicas have never been built
+      return;
+    }
+    size_t index = 0;
+    while (index < distinct.size() && distinct[index].second != replicas->second.get()) {
+      ++index;
+    }
+    if (index == distinct.size()) {
+      distinct.push_back(std::make_pair(&i->second, replicas->second.get()));
+    }
+    indexes.push_back(index);
+  }
+
+  Vector<size_t> old_indexes;
+  Vector<size_t> unchanged_counts;
+  map_unchanged_tokens(old_tokens, host, old_indexes, unchanged_counts);
+
+  SharedReplicasVec results;
+  results.reserve(distinct.size());
+  for (size_t i = 0; i < distinct.size(); ++i) {
+    const SharedReplicas* old_replicas = distinct[i].second;
+    typename SharedReplicas::Ptr replicas(new SharedReplicas());
+    if (!distinct[i].first->update_replicas(tokens_, datacenters_, old_tokens.size(),
+                                            old_datacenters, old_replicas->replicas,
+                                            old_replicas->spans, old_indexes, unchanged_counts,
+                                            replicas->replicas, replicas->spans)) {
+      distinct[i].first->build_replicas(tokens_, datacenters_, replicas->replicas,
+                                        &replicas->spans);
+    }
+    results.push_back(replicas);
+  }
+
+  size_t index = 0;
+  for (typename KeyspaceStrategyMap::const_iterator i = strategies_.begin(),
+                                                    end = strategies_.end();
+       i != end; ++i) {
+    const String& keyspace_name = i->first;
+    replicas_[InternedString(keyspace_name)] = results[indexes[index++]];
+    LOG_TRACE("Replicas for keyspace '%s':\n%s", keyspace_name.c_str(),
+              dump(keyspace_name).c_str());
+  }
+}
+
+template <class Partitioner>
+void TokenMapImpl<Partitioner>::map_unchanged_tokens(const TokenHostVec& old_tokens,
+                                                     const Host::Ptr& host,
+                                                     Vector<size_t>& old_indexes,
+                                                     Vector<size_t>& unchanged_counts) const {
+  const size_t num_tokens = tokens_.size();
+  old_indexes.assign(num_tokens, 0);
+  unchanged_counts.assign(num_tokens, 0);
+  if (num_tokens == 0) return;
+
+  // Both token vectors are sorted so the tokens that are in both can be
+  // matched in a single pass. All of the updated host's tokens are considered
+  // changed because its datacenter or rack could also have changed.
+  size_t j = 0;
+  for (size_t i = 0; i < num_tokens; ++i) {
+    const TokenHost& token = tokens_[i];
+    while (j < old_tokens.size() && old_tokens[j].first < token.first) {
+      ++j;
+    }
+    if (j < old_tokens.size() && !(token.first < old_tokens[j].first) &&
+        old_tokens[j].second == token.second && token.second->address() != host->address()) {
+      old_indexes[i] = j++;
+      unchanged_counts[i] = 1;
+    }
+  }
+
+  // Count the unchanged tokens that follow each token in the same order as
+  // before the update. This wraps around the ring so it's done twice to
+  // include the counts from the start of the ring at its end.
+  for (size_t pass = 0; pass < 2; ++pass) {
+    for (size_t i = num_tokens; i-- > 0;) {
+      if (unchanged_counts[i] == 0) continue; // Changed
+      size_t next = (i + 1) % num_tokens;
+      if (unchanged_counts[next] > 0 &&
+          old_indexes[next] == (old_indexes[i] + 1) % old_tokens.size()) {
+        unchanged_counts[i] = std::min(unchanged_counts[next] + 1, num_tokens);
+      } else {
+        unchanged_counts[i] = 1;
+      }
+    }
+  }
 }
 
 }}} // namespace datastax::internal::core
@@ -25,9 +25,14 @@ using namespace datastax::internal::core;
 TracingDataHandler::TracingDataHandler(const RequestHandler::Ptr& request_handler,
                                        const Host::Ptr& current_host, const Response::Ptr& response,
                                        CassConsistency consistency, uint64_t max_wait_time_ms,
-                                       uint64_t retry_wait_time_ms)
+                                       uint64_t retry_wait_time_ms,
+                                       const Future::Ptr& tracing_data_future)
     : WaitForHandler(request_handler, current_host, response, max_wait_time_ms, retry_wait_time_ms)
-    , consistency_(consistency) {}
+    , consistency_(consistency)
+    , tracing_data_future_(tracing_data_future)
+    , is_data_available_(false)
+    , error_code_(CASS_ERROR_LIB_REQUEST_TIMED_OUT)
+    , error_message_("Tracing data not available") {}
 
 ChainedRequestCallback::Ptr TracingDataHandler::callback() {
   WaitforRequestVec requests;
@@ -44,6 +49,7 @@ bool TracingDataHandler::on_set(const ChainedRequestCallback::Ptr& callback) {
   if (result && result->row_count() > 0) {
     LOG_DEBUG("Found tracing data in %llu ms",
               static_cast<unsigned long long>(get_time_since_epoch_ms() - start_time_ms()));
+    is_data_available_ = true;
     return true;
   } else {
     LOG_DEBUG("Tracing data still not available. Trying again in %llu ms",
@@ -53,23 +59,39 @@ bool TracingDataHandler::on_set(const ChainedRequestCallback::Ptr& callback) {
 }
 
 void TracingDataHandler::on_error(WaitForHandler::WaitForError code, const String& message) {
+  error_message_ = "Tracing data not available: " + message;
   switch (code) {
     case WAIT_FOR_ERROR_REQUEST_ERROR:
+      error_code_ = CASS_ERROR_LIB_UNEXPECTED_RESPONSE;
       LOG_ERROR("An error occurred waiting for tracing data to become available: %s",
                 message.c_str());
       break;
     case WAIT_FOR_ERROR_REQUEST_TIMEOUT:
+      error_code_ = CASS_ERROR_LIB_REQUEST_TIMED_OUT;
       LOG_WARN("A query timeout occurred waiting for tracing data to become available");
       break;
     case WAIT_FOR_ERROR_CONNECTION_CLOSED:
+      error_code_ = CASS_ERROR_LIB_WRITE_ERROR;
       LOG_WARN("Connection closed while attempting to wait for tracing data to become available");
       break;
     case WAIT_FOR_ERROR_NO_STREAMS:
+      error_code_ = CASS_ERROR_LIB_NO_STREAMS;
       LOG_WARN("No stream available when attempting to wait for tracing data to become available");
       break;
     case WAIT_FOR_ERROR_TIMEOUT:
+      error_code_ = CASS_ERROR_LIB_REQUEST_TIMED_OUT;
       LOG_WARN("Tracing data not available after %llu ms",
                static_cast<unsigned long long>(max_wait_time_ms()));
       break;
   }
 }
+
+void TracingDataHandler::on_finish() {
+  if (!tracing_data_future_) {
+    WaitForHandler::on_finish();
+  } else if (is_data_available_) {
+    tracing_data_future_->set();
+  } else {
+    tracing_data_future_->set_error(error_code_, error_message_);
+  }
+}
@@ -45,10 +45,14 @@ public:
    * become available.
    * @param retry_wait_time_ms The amount of time to wait between failed attempts
    * to retrieve tracing data.
+   * @param tracing_data_future The future to set once the data is available
+   * if the response has already been set. If null, the response is set on the
+   * request handler instead.
    */
   TracingDataHandler(const RequestHandler::Ptr& request_handler, const Host::Ptr& current_host,
                      const Response::Ptr& response, CassConsistency consistency,
-                     uint64_t max_wait_time_ms, uint64_t retry_wait_time_ms);
+                     uint64_t max_wait_time_ms, uint64_t retry_wait_time_ms,
+                     const Future::Ptr& tracing_data_future = Future::Ptr());
 
   /**
    * Gets a request callback for executing queries on behalf of the handler.
@@ -60,9 +64,14 @@ public:
 private:
   virtual bool on_set(const ChainedRequestCallback::Ptr& callback);
   virtual void on_error(WaitForError code, const String& message);
+  virtual void on_finish();
 
 private:
   CassConsistency consistency_;
+  Future::Ptr tracing_data_future_;
+  bool is_data_available_;
+  CassError error_code_;
+  String error_message_;
 };
 
 }}} // namespace datastax::internal::core
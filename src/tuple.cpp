@@ -21,6 +21,7 @@
 #include "encode.hpp"
 #include "external.hpp"
 #include "macros.hpp"
+#include "struct_encoder.hpp"
 #include "user_type_value.hpp"
 
 #include <string.h>
@@ -70,6 +71,8 @@ CASS_TUPLE_SET(decimal, THREE_PARAMS_(const cass_byte_t* varint, size_t varint_s
                CassDecimal(varint, varint_size, scale))
 CASS_TUPLE_SET(duration, THREE_PARAMS_(cass_int32_t months, cass_int32_t days, cass_int64_t nanos),
                CassDuration(months, days, nanos))
+CASS_TUPLE_SET(struct, TWO_PARAMS_(const CassStructEncoder* encoder, const void* data),
+               CassStruct(encoder->from(), data))
 
 #undef CASS_TUPLE_SET
 
@@ -101,6 +104,12 @@ CassError Tuple::set(size_t index, CassNull value) {
   return CASS_OK;
 }
 
+CassError Tuple::set(size_t index, CassStruct value) {
+  CASS_TUPLE_CHECK_INDEX_AND_TYPE(index, value);
+  items_[index] = value.encoder->encode_with_length(value.data);
+  return CASS_OK;
+}
+
 CassError Tuple::set(size_t index, const Tuple* value) {
   CASS_TUPLE_CHECK_INDEX_AND_TYPE(index, value);
   items_[index] = value->encode_with_length();
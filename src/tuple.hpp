@@ -76,6 +76,7 @@ public:
 #undef SET_TYPE
 
   CassError set(size_t index, CassNull value);
+  CassError set(size_t index, CassStruct value);
   CassError set(size_t index, const Collection* value);
   CassError set(size_t index, const Tuple* value);
   CassError set(size_t index, const UserTypeValue* value);
@@ -20,7 +20,13 @@
 #include "cassandra.h"
 #include "string_ref.hpp"
 
-namespace datastax { namespace internal { namespace core {
+namespace datastax { namespace internal {
+
+class ExternalBuffer;
+
+namespace core {
+
+class StructEncoder;
 
 struct CassNull {};
 
@@ -34,6 +40,29 @@ struct CassBytes {
   size_t size;
 };
 
+// [bytes] and [string] values that reference the application's memory
+// instead of copying it
+struct CassBytesRef {
+  CassBytesRef(ExternalBuffer* buffer)
+      : buffer(buffer) {}
+  ExternalBuffer* buffer;
+};
+
+struct CassStringRef {
+  CassStringRef(ExternalBuffer* buffer)
+      : buffer(buffer) {}
+  ExternalBuffer* buffer;
+};
+
+// A user defined type or tuple value encoded from an application's struct
+struct CassStruct {
+  CassStruct(const StructEncoder* encoder, const void* data)
+      : encoder(encoder)
+      , data(data) {}
+  const StructEncoder* encoder;
+  const void* data;
+};
+
 struct CassCustom {
   CassCustom(StringRef class_name, const cass_byte_t* data, size_t size)
       : class_name(class_name)
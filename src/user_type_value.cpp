@@ -19,6 +19,7 @@
 #include "collection.hpp"
 #include "external.hpp"
 #include "macros.hpp"
+#include "struct_encoder.hpp"
 #include "tuple.hpp"
 #include "utils.hpp"
 
@@ -77,6 +78,8 @@ CASS_USER_TYPE_SET(decimal, THREE_PARAMS_(const cass_byte_t* varint, size_t vari
 CASS_USER_TYPE_SET(duration,
                    THREE_PARAMS_(cass_int32_t months, cass_int32_t days, cass_int64_t nanos),
                    CassDuration(months, days, nanos))
+CASS_USER_TYPE_SET(struct, TWO_PARAMS_(const CassStructEncoder* encoder, const void* data),
+                   CassStruct(encoder->from(), data))
 
 #undef CASS_USER_TYPE_SET
 
@@ -0,0 +1,98 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "utf8.hpp"
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CASS_UTF8_SSE2
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define CASS_UTF8_NEON
+#endif
+
+using namespace datastax::internal;
+
+namespace {
+
+// Get the length of the run of ASCII characters at the start of the data
+size_t ascii_prefix(const unsigned char* data, size_t size) {
+  size_t i = 0;
+#if defined(CASS_UTF8_SSE2)
+  for (; i + 16 <= size; i += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    if (_mm_movemask_epi8(v) != 0) break; // A byte has its high bit set
+  }
+#elif defined(CASS_UTF8_NEON)
+  for (; i + 16 <= size; i += 16) {
+    if (vmaxvq_u8(vld1q_u8(data + i)) >= 0x80) break;
+  }
+#endif
+  for (; i + 8 <= size; i += 8) {
+    uint64_t word;
+    memcpy(&word, data + i, sizeof(word));
+    if ((word & 0x8080808080808080ULL) != 0) break;
+  }
+  while (i < size && data[i] < 0x80) {
+    ++i;
+  }
+  return i;
+}
+
+bool is_continuation(unsigned char c) { return (c & 0xC0) == 0x80; }
+
+} // namespace
+
+bool datastax::internal::is_ascii(const char* data, size_t size) {
+  return ascii_prefix(reinterpret_cast<const unsigned char*>(data), size) == size;
+}
+
+bool datastax::internal::is_valid_utf8(const char* data, size_t size) {
+  const unsigned char* pos = reinterpret_cast<const unsigned char*>(data);
+  const unsigned char* end = pos + size;
+
+  while (pos < end) {
+    pos += ascii_prefix(pos, end - pos);
+    if (pos == end) break;
+
+    unsigned char c = *pos;
+    size_t remaining = end - pos;
+    if (c >= 0xC2 && c <= 0xDF) { // 2 bytes
+      if (remaining < 2 || !is_continuation(pos[1])) return false;
+      pos += 2;
+    } else if (c >= 0xE0 && c <= 0xEF) { // 3 bytes
+      if (remaining < 3 || !is_continuation(pos[1]) || !is_continuation(pos[2])) return false;
+      if (c == 0xE0 && pos[1] < 0xA0) return false; // Overlong
+      if (c == 0xED && pos[1] > 0x9F) return false; // Surrogate
+      pos += 3;
+    } else if (c >= 0xF0 && c <= 0xF4) { // 4 bytes
+      if (remaining < 4 || !is_continuation(pos[1]) || !is_continuation(pos[2]) ||
+          !is_continuation(pos[3])) {
+        return false;
+      }
+      if (c == 0xF0 && pos[1] < 0x90) return false; // Overlong
+      if (c == 0xF4 && pos[1] > 0x8F) return false; // Above U+10FFFF
+      pos += 4;
+    } else { // Continuation byte, overlong 2 byte lead (0xC0, 0xC1) or 0xF5-0xFF
+      return false;
+    }
+  }
+
+  return true;
+}
@@ -0,0 +1,36 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_UTF8_HPP
+#define DATASTAX_INTERNAL_UTF8_HPP
+
+#include <stddef.h>
+
+namespace datastax { namespace internal {
+
+// Validate text. Runs of ASCII are skipped 16 bytes at a time using SIMD when
+// it's available at compile time (8 bytes at a time otherwise) and only the
+// multi-byte sequences are decoded.
+
+bool is_ascii(const char* data, size_t size);
+
+// Valid UTF-8 as defined by RFC 3629: no overlong encodings, surrogates or
+// code points above U+10FFFF.
+bool is_valid_utf8(const char* data, size_t size);
+
+}} // namespace datastax::internal
+
+#endif
@@ -21,6 +21,7 @@
 #include <algorithm>
 #include <assert.h>
 #include <functional>
+#include <stdio.h>
 #include <uv.h>
 
 #if (defined(WIN32) || defined(_WIN32))
@@ -68,6 +69,8 @@ String opcode_to_string(int opcode) {
       return "CQL_OPCODE_AUTH_RESPONSE";
     case CQL_OPCODE_AUTH_SUCCESS:
       return "CQL_OPCODE_AUTH_SUCCESS";
+    case CQL_OPCODE_CANCEL:
+      return "CQL_OPCODE_CANCEL";
   };
   assert(false);
   return "";
@@ -153,6 +156,37 @@ int32_t get_pid() {
 #endif
 }
 
+bool read_file(const String& path, String* output) {
+  FILE* file = fopen(path.c_str(), "rb");
+  if (file == NULL) return false;
+  char buf[4096];
+  size_t size;
+  while ((size = fread(buf, 1, sizeof(buf), file)) > 0) {
+    output->append(buf, size);
+  }
+  bool is_ok = ferror(file) == 0;
+  fclose(file);
+  return is_ok;
+}
+
+bool write_file(const String& path, const String& data) {
+  // Write a temporary file and rename it so a reader never sees a partially
+  // written file
+  String temp_path(path + ".tmp");
+  FILE* file = fopen(temp_path.c_str(), "wb");
+  if (file == NULL) return false;
+  bool is_ok = fwrite(data.data(), 1, data.size(), file) == data.size();
+  is_ok = fclose(file) == 0 && is_ok;
+#if defined(WIN32) || defined(_WIN32)
+  if (is_ok) remove(path.c_str()); // rename() doesn't replace existing files
+#endif
+  if (!is_ok || rename(temp_path.c_str(), path.c_str()) != 0) {
+    remove(temp_path.c_str());
+    return false;
+  }
+  return true;
+}
+
 void thread_yield() {
 #if defined(WIN32) || defined(_WIN32)
   SwitchToThread();
@@ -118,6 +118,25 @@ static void set_pointer_keys(C& container) {
 
 void thread_yield();
 
+/**
+ * Read a whole file.
+ *
+ * @param path The file's path.
+ * @param output The file's contents are appended to this.
+ * @return true if the file was read.
+ */
+bool read_file(const String& path, String* output);
+
+/**
+ * Replace a file's contents. The data is written to a temporary file that's
+ * renamed so that a reader never sees a partially written file.
+ *
+ * @param path The file's path.
+ * @param data The file's new contents.
+ * @return true if the file was written.
+ */
+bool write_file(const String& path, const String& data);
+
 }} // namespace datastax::internal
 
 #endif
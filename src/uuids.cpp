@@ -52,6 +52,18 @@ CassUuidGen* cass_uuid_gen_new_with_node(cass_uint64_t node) {
   return CassUuidGen::to(new UuidGen(node));
 }
 
+CassUuidGen* cass_uuid_gen_new_per_thread(unsigned batch_size) {
+  UuidGen* uuid_gen = new UuidGen();
+  uuid_gen->use_per_thread_timestamps(batch_size);
+  return CassUuidGen::to(uuid_gen);
+}
+
+CassUuidGen* cass_uuid_gen_new_per_thread_with_node(cass_uint64_t node, unsigned batch_size) {
+  UuidGen* uuid_gen = new UuidGen(node);
+  uuid_gen->use_per_thread_timestamps(batch_size);
+  return CassUuidGen::to(uuid_gen);
+}
+
 void cass_uuid_gen_free(CassUuidGen* uuid_gen) { delete uuid_gen->from(); }
 
 void cass_uuid_gen_time(CassUuidGen* uuid_gen, CassUuid* output) {
@@ -162,7 +174,8 @@ CassError cass_uuid_from_string_n(const char* str, size_t str_length, CassUuid*
 UuidGen::UuidGen()
     : clock_seq_and_node_(0)
     , last_timestamp_(0LL)
-    , ng_(get_random_seed(MT19937_64::DEFAULT_SEED)) {
+    , ng_(get_random_seed(MT19937_64::DEFAULT_SEED))
+    , batch_size_(0) {
   uv_mutex_init(&mutex_);
 
   Md5 md5;
@@ -223,15 +236,31 @@ UuidGen::UuidGen()
 UuidGen::UuidGen(uint64_t node)
     : clock_seq_and_node_(0)
     , last_timestamp_(0LL)
-    , ng_(get_random_seed(MT19937_64::DEFAULT_SEED)) {
+    , ng_(get_random_seed(MT19937_64::DEFAULT_SEED))
+    , batch_size_(0) {
   uv_mutex_init(&mutex_);
   set_clock_seq_and_node(node & 0x0000FFFFFFFFFFFFLL);
 }
 
-UuidGen::~UuidGen() { uv_mutex_destroy(&mutex_); }
+UuidGen::~UuidGen() {
+  if (batch_size_ > 0) {
+    uv_key_delete(&batch_key_);
+    for (ThreadBatchVec::iterator it = batches_.begin(), end = batches_.end(); it != end; ++it) {
+      delete *it;
+    }
+  }
+  uv_mutex_destroy(&mutex_);
+}
+
+void UuidGen::use_per_thread_timestamps(unsigned batch_size) {
+  assert(batch_size_ == 0 && "Per-thread timestamps are already used");
+  uv_key_create(&batch_key_);
+  batch_size_ = batch_size > 0 ? batch_size : DEFAULT_BATCH_SIZE;
+}
 
 void UuidGen::generate_time(CassUuid* output) {
-  output->time_and_version = set_version(monotonic_timestamp(), 1);
+  uint64_t timestamp = batch_size_ > 0 ? per_thread_timestamp() : monotonic_timestamp();
+  output->time_and_version = set_version(timestamp, 1);
   output->clock_seq_and_node = clock_seq_and_node_;
 }
 
@@ -279,3 +308,35 @@ uint64_t UuidGen::monotonic_timestamp() {
     }
   }
 }
+
+uint64_t UuidGen::per_thread_timestamp() {
+  ThreadBatch* batch = static_cast<ThreadBatch*>(uv_key_get(&batch_key_));
+  if (batch == NULL) {
+    batch = new ThreadBatch();
+    uv_key_set(&batch_key_, batch);
+    ScopedMutex lock(&mutex_);
+    batches_.push_back(batch);
+  }
+
+  // Only the clock is read on the common path. A new batch is reserved when
+  // the current one is used up or has fallen behind the clock.
+  uint64_t now = from_unix_timestamp(get_time_since_epoch_ms());
+  if (batch->next == batch->end || batch->next < now) {
+    reserve_timestamps(now, batch);
+  }
+  return batch->next++;
+}
+
+void UuidGen::reserve_timestamps(uint64_t now, ThreadBatch* batch) {
+  uint64_t last = last_timestamp_.load();
+  while (true) {
+    // The batch starts after every timestamp that's been handed out
+    uint64_t start = now > last ? now : last + 1;
+    uint64_t end = start + batch_size_;
+    if (last_timestamp_.compare_exchange_strong(last, end - 1)) {
+      batch->next = start;
+      batch->end = end;
+      return;
+    }
+  }
+}
@@ -22,6 +22,7 @@
 #include "cassandra.h"
 #include "external.hpp"
 #include "random.hpp"
+#include "vector.hpp"
 
 #include <assert.h>
 #include <string.h>
@@ -31,23 +32,54 @@ namespace datastax { namespace internal { namespace core {
 
 class UuidGen : public Allocated {
 public:
+  static const unsigned DEFAULT_BATCH_SIZE = 1024;
+
   UuidGen();
   UuidGen(uint64_t node);
   ~UuidGen();
 
+  /**
+   * Generate time-based UUIDs from timestamps reserved by each thread in
+   * batches. A thread only updates the shared timestamp once per batch, or
+   * when the clock has moved past its batch, so generating UUIDs from many
+   * threads doesn't contend on it. The UUIDs are unique and each thread's
+   * UUIDs are monotonic. This must be called before the generator is used.
+   *
+   * @param batch_size The number of timestamps reserved at a time. A value of
+   * 0 uses DEFAULT_BATCH_SIZE.
+   */
+  void use_per_thread_timestamps(unsigned batch_size);
+
   void generate_time(CassUuid* output);
   void from_time(uint64_t timestamp, CassUuid* output);
   void generate_random(CassUuid* output);
 
 private:
+  // A thread's batch of reserved timestamps [next, end)
+  struct ThreadBatch : public Allocated {
+    ThreadBatch()
+        : next(0)
+        , end(0) {}
+    uint64_t next;
+    uint64_t end;
+  };
+
+  typedef Vector<ThreadBatch*> ThreadBatchVec;
+
   void set_clock_seq_and_node(uint64_t node);
   uint64_t monotonic_timestamp();
+  uint64_t per_thread_timestamp();
+  void reserve_timestamps(uint64_t now, ThreadBatch* batch);
 
   uint64_t clock_seq_and_node_;
   Atomic<uint64_t> last_timestamp_;
 
   uv_mutex_t mutex_;
   MT19937_64 ng_;
+
+  unsigned batch_size_; // 0 if timestamps aren't reserved per thread
+  uv_key_t batch_key_;
+  ThreadBatchVec batches_; // Protected by "mutex_"
 };
 
 }}} // namespace datastax::internal::core
@@ -36,6 +36,87 @@ using namespace datastax;
 using namespace datastax::internal;
 using namespace datastax::internal::core;
 
+namespace {
+
+// Reads the next item ([bytes]) of an encoded collection. The data is NULL and
+// the size is -1 for a null item.
+inline bool next_item(const char*& pos, size_t& remaining, const char** data, int32_t* size) {
+  if (remaining < sizeof(int32_t)) return false;
+  pos = decode_int32(pos, *size);
+  remaining -= sizeof(int32_t);
+  if (*size < 0) {
+    *data = NULL;
+    return true;
+  }
+  if (remaining < static_cast<size_t>(*size)) return false;
+  *data = pos;
+  pos += *size;
+  remaining -= *size;
+  return true;
+}
+
+inline const char* decode_item(const char* input, cass_int32_t& output) {
+  return decode_int32(input, output);
+}
+
+inline const char* decode_item(const char* input, cass_int64_t& output) {
+  return decode_int64(input, output);
+}
+
+inline const char* decode_item(const char* input, cass_float_t& output) {
+  return decode_float(input, output);
+}
+
+inline const char* decode_item(const char* input, cass_double_t& output) {
+  return decode_double(input, output);
+}
+
+inline bool is_int32_type(CassValueType value_type) { return value_type == CASS_VALUE_TYPE_INT; }
+
+inline bool is_float_type(CassValueType value_type) { return value_type == CASS_VALUE_TYPE_FLOAT; }
+
+inline bool is_double_type(CassValueType value_type) {
+  return value_type == CASS_VALUE_TYPE_DOUBLE;
+}
+
+// Decodes the fixed width items of a list or set (or the values of a map)
+// directly from the encoded collection in a single pass, without creating a
+// decoder and value for each item.
+template <class T>
+CassError get_items(const Value* collection, bool (*is_valid_type)(CassValueType), T* output,
+                    size_t output_count, size_t* item_count) {
+  if (collection == NULL || collection->is_null()) return CASS_ERROR_LIB_NULL_VALUE;
+  if (!collection->is_collection()) return CASS_ERROR_LIB_INVALID_VALUE_TYPE;
+  const bool is_map = collection->is_map();
+  if (!is_valid_type(is_map ? collection->secondary_value_type()
+                            : collection->primary_value_type())) {
+    return CASS_ERROR_LIB_INVALID_VALUE_TYPE;
+  }
+
+  const size_t count = static_cast<size_t>(collection->count());
+  if (item_count != NULL) *item_count = count;
+  if (output_count < count) return CASS_ERROR_LIB_BAD_PARAMS;
+
+  // The encoded items follow the collection's item count
+  StringRef encoded_items(collection->to_string_ref());
+  const char* pos = encoded_items.data();
+  size_t remaining = encoded_items.size();
+  for (size_t i = 0; i < count; ++i) {
+    const char* data;
+    int32_t size;
+    if (is_map && !next_item(pos, remaining, &data, &size)) { // Skip the key
+      return CASS_ERROR_LIB_NOT_ENOUGH_DATA;
+    }
+    if (!next_item(pos, remaining, &data, &size)) return CASS_ERROR_LIB_NOT_ENOUGH_DATA;
+    if (data == NULL) return CASS_ERROR_LIB_NULL_VALUE;
+    if (static_cast<size_t>(size) < sizeof(T)) return CASS_ERROR_LIB_NOT_ENOUGH_DATA;
+    decode_item(data, output[i]);
+  }
+  return CASS_OK;
+}
+
+} // namespace
+
 extern "C" {
 
 const CassDataType* cass_value_data_type(const CassValue* value) {
@@ -190,6 +271,48 @@ CassValueType cass_value_secondary_sub_type(const CassValue* collection) {
   return collection->secondary_value_type();
 }
 
+CassError cass_value_get_int32_items(const CassValue* collection, cass_int32_t* output,
+                                     size_t output_count, size_t* item_count) {
+  return get_items(collection, is_int32_type, output, output_count, item_count);
+}
+
+CassError cass_value_get_int64_items(const CassValue* collection, cass_int64_t* output,
+                                     size_t output_count, size_t* item_count) {
+  return get_items(collection, is_int64_type, output, output_count, item_count);
+}
+
+CassError cass_value_get_float_items(const CassValue* collection, cass_float_t* output,
+                                     size_t output_count, size_t* item_count) {
+  return get_items(collection, is_float_type, output, output_count, item_count);
+}
+
+CassError cass_value_get_double_items(const CassValue* collection, cass_double_t* output,
+                                      size_t output_count, size_t* item_count) {
+  return get_items(collection, is_double_type, output, output_count, item_count);
+}
+
+CassError cass_value_get_item_refs(const CassValue* collection, const cass_byte_t** items,
+                                   cass_int32_t* item_sizes, size_t output_count,
+                                   size_t* item_count) {
+  if (collection == NULL || collection->is_null()) return CASS_ERROR_LIB_NULL_VALUE;
+  if (!collection->is_collection()) return CASS_ERROR_LIB_INVALID_VALUE_TYPE;
+
+  const size_t count = static_cast<size_t>(collection->count()) * (collection->is_map() ? 2 : 1);
+  if (item_count != NULL) *item_count = count;
+  if (output_count < count) return CASS_ERROR_LIB_BAD_PARAMS;
+
+  // The encoded items follow the collection's item count
+  StringRef encoded_items(collection->to_string_ref());
+  const char* pos = encoded_items.data();
+  size_t remaining = encoded_items.size();
+  for (size_t i = 0; i < count; ++i) {
+    const char* data;
+    if (!next_item(pos, remaining, &data, &item_sizes[i])) return CASS_ERROR_LIB_NOT_ENOUGH_DATA;
+    items[i] = reinterpret_cast<const cass_byte_t*>(data);
+  }
+  return CASS_OK;
+}
+
 } // extern "C"
 
 Value::Value(const DataType::ConstPtr& data_type, Decoder decoder)
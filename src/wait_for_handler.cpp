@@ -116,7 +116,7 @@ void WaitForHandler::schedule() {
 void WaitForHandler::finish() {
   assert(!is_finished_ && "This shouldn't be called more than once");
   is_finished_ = true;
-  request_handler_->set_response(current_host_, response_);
+  on_finish();
   if (connection_) {
     connection_.reset();
     retry_timer_.stop();
@@ -125,6 +125,8 @@ void WaitForHandler::finish() {
   }
 }
 
+void WaitForHandler::on_finish() { request_handler_->set_response(current_host_, response_); }
+
 void WaitForHandler::on_retry_timeout(Timer* timer) {
   if (is_finished_) return;
 
@@ -88,6 +88,13 @@ protected:
    */
   virtual void on_error(WaitForError code, const String& message) = 0;
 
+  /**
+   * A callback called once the handler is finished, either successfully or
+   * after an error. By default, this sets the original response on the
+   * request handler.
+   */
+  virtual void on_finish();
+
 protected:
   const Host::Ptr& host() const { return connection_->host(); }
 
@@ -101,6 +108,18 @@ protected:
 protected:
   WaitForRequest make_request(const String& key, const String& query);
 
+  /**
+   * Change the requests run by the following retries and the time to wait
+   * before them. This is called from on_set() before the retry is scheduled.
+   *
+   * @param requests The requests to run.
+   * @param retry_wait_time_ms The time to wait before the next retry.
+   */
+  void set_retry(const WaitforRequestVec& requests, uint64_t retry_wait_time_ms) {
+    requests_ = requests;
+    retry_wait_time_ms_ = retry_wait_time_ms;
+  }
+
 private:
   friend class WaitForCallback;
 
@@ -120,7 +139,7 @@ private:
   WaitforRequestVec requests_;
   const uint64_t start_time_ms_;
   const uint64_t max_wait_time_ms_;
-  const uint64_t retry_wait_time_ms_;
+  uint64_t retry_wait_time_ms_;
   const RequestHandler::Ptr request_handler_;
   const Host::Ptr current_host_;
   const Response::Ptr response_;
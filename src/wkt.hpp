@@ -75,6 +75,9 @@ public:
     }
   }
 
+private:
+  static double parse_number(const char* begin, const char* end);
+
 private:
   double number_;
   const char* position_;
@@ -57,7 +57,7 @@ WktLexer::Token WktLexer::next_token() {
       ',' => { token = TK_COMMA; fbreak; };
       number => {
                    if (!skip_number_) {
-                     number_ = atof(datastax::String(ts, te).c_str());
+                     number_ = parse_number(ts, te);
                    }
                    token = TK_NUMBER;
                    fbreak;
@@ -74,3 +74,59 @@ WktLexer::Token WktLexer::next_token() {
 
   return token;
 }
+
+// Numbers with at most 15 significant digits and a small decimal exponent are
+// exactly representable as a double scaled by an exact power of ten so a
+// single multiplication or division gives the correctly rounded result
+// (Clinger's fast path). That covers almost all coordinates and avoids
+// copying the token to a null-terminated string for atof().
+double WktLexer::parse_number(const char* begin, const char* end) {
+  static const double powers_of_ten[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                          1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                          1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+  const char* p = begin;
+  bool is_negative = false;
+  if (p < end && (*p == '+' || *p == '-')) {
+    is_negative = *p++ == '-';
+  }
+
+  unsigned long long mantissa = 0;
+  int num_digits = 0;
+  int exponent = 0;
+  bool is_fraction = false;
+  for (; p < end && *p != 'e' && *p != 'E'; ++p) {
+    if (*p == '.') {
+      is_fraction = true;
+      continue;
+    }
+    if (mantissa != 0 || *p != '0') {
+      if (++num_digits > 15) {
+        return atof(datastax::String(begin, end).c_str());
+      }
+      mantissa = 10 * mantissa + (*p - '0');
+    }
+    if (is_fraction) --exponent;
+  }
+
+  if (p < end) { // Exponent
+    ++p;
+    bool is_negative_exponent = false;
+    if (*p == '+' || *p == '-') {
+      is_negative_exponent = *p++ == '-';
+    }
+    int value = 0;
+    for (; p < end && value < 1000; ++p) {
+      value = 10 * value + (*p - '0');
+    }
+    exponent += is_negative_exponent ? -value : value;
+  }
+
+  if (exponent < -22 || exponent > 22) {
+    return atof(datastax::String(begin, end).c_str());
+  }
+
+  double number = static_cast<double>(mantissa);
+  number = exponent < 0 ? number / powers_of_ten[-exponent] : number * powers_of_ten[exponent];
+  return is_negative ? -number : number;
+}
@@ -0,0 +1,559 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+/*
+ * A closed-loop benchmark of the driver. A fixed number of requests are kept
+ * in flight, against a real cluster or an embedded mockssandra cluster, and
+ * the throughput and HDR latency distribution of the requests are reported so
+ * that the performance of driver versions can be compared.
+ */
+
+#include "cassandra.h"
+#include "mock_workload.hpp"
+#include "mockssandra.hpp"
+#include "scoped_lock.hpp"
+#include "scoped_ptr.hpp"
+#include "third_party/hdr_histogram/hdr_histogram.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <uv.h>
+
+// Latencies are recorded in microseconds up to an hour with 3 significant
+// digits
+#define HIGHEST_TRACKABLE_LATENCY_US (60LL * 60LL * 1000LL * 1000LL)
+#define SIGNIFICANT_DIGITS 3
+
+using datastax::String;
+using datastax::internal::ScopedMutex;
+using datastax::internal::ScopedPtr;
+
+struct Options {
+  Options()
+      : hosts("127.0.0.1")
+      , use_mock(false)
+      , mock_nodes(1)
+      , requests(100000)
+      , concurrency(128)
+      , io_threads(1)
+      , connections(1)
+      , read_ratio(0.5)
+      , value_size(64)
+      , use_prepared(false)
+      , batch_size(1)
+      , page_size(0)
+      , partitions(10000)
+      , rows_per_partition(1)
+      , print_distribution(true) {}
+
+  bool parse(int argc, char* argv[]);
+
+  String hosts;
+  bool use_mock;
+  unsigned mock_nodes;
+  unsigned requests;
+  unsigned concurrency;
+  unsigned io_threads;
+  unsigned connections;
+  double read_ratio;
+  unsigned value_size;
+  bool use_prepared;
+  unsigned batch_size;
+  int page_size;
+  unsigned partitions;
+  unsigned rows_per_partition;
+  bool print_distribution;
+};
+
+static void print_usage(const char* program) {
+  fprintf(stderr,
+          "Usage: %s [options]\n"
+          "\n"
+          "  --hosts <hosts>               Contact points (default: 127.0.0.1)\n"
+          "  --mock                        Run against an embedded mockssandra cluster\n"
+          "  --mock-nodes <n>              Number of mockssandra nodes (default: 1)\n"
+          "  --requests <n>                Number of requests (default: 100000)\n"
+          "  --concurrency <n>             Number of requests in flight (default: 128)\n"
+          "  --io-threads <n>              Number of I/O threads (default: 1)\n"
+          "  --connections <n>             Connections per host (default: 1)\n"
+          "  --read-ratio <ratio>          Ratio of reads to writes from 0.0 to 1.0 "
+          "(default: 0.5)\n"
+          "  --value-size <bytes>          Size of the written values (default: 64)\n"
+          "  --prepared                    Use prepared statements instead of simple "
+          "statements\n"
+          "  --batch-size <n>              Number of rows per write; more than 1 writes "
+          "unlogged batches (default: 1)\n"
+          "  --page-size <n>               Page size of the reads; all of a partition's pages "
+          "are read (default: 0, no paging)\n"
+          "  --partitions <n>              Number of partitions (default: 10000)\n"
+          "  --rows-per-partition <n>      Number of rows per partition (default: 1)\n"
+          "  --no-distribution             Don't print the latency distribution\n",
+          program);
+}
+
+static bool parse_unsigned(const char* value, unsigned* result) {
+  char* end;
+  unsigned long parsed = strtoul(value, &end, 10);
+  if (*value == '\0' || *end != '\0') return false;
+  *result = static_cast<unsigned>(parsed);
+  return true;
+}
+
+bool Options::parse(int argc, char* argv[]) {
+  for (int i = 1; i < argc; ++i) {
+    String arg(argv[i]);
+    const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+    bool is_valid = true;
+    if (arg == "--mock") {
+      use_mock = true;
+      continue;
+    } else if (arg == "--prepared") {
+      use_prepared = true;
+      continue;
+    } else if (arg == "--no-distribution") {
+      print_distribution = false;
+      continue;
+    } else if (arg.compare(0, 2, "--") != 0 || value == NULL) {
+      fprintf(stderr, "Unknown option or missing value for '%s'\n", arg.c_str());
+      return false;
+    } else if (arg == "--hosts") {
+      hosts = value;
+    } else if (arg == "--mock-nodes") {
+      is_valid = parse_unsigned(value, &mock_nodes) && mock_nodes > 0;
+    } else if (arg == "--requests") {
+      is_valid = parse_unsigned(value, &requests) && requests > 0;
+    } else if (arg == "--concurrency") {
+      is_valid = parse_unsigned(value, &concurrency) && concurrency > 0;
+    } else if (arg == "--io-threads") {
+      is_valid = parse_unsigned(value, &io_threads) && io_threads > 0;
+    } else if (arg == "--connections") {
+      is_valid = parse_unsigned(value, &connections) && connections > 0;
+    } else if (arg == "--read-ratio") {
+      char* end;
+      read_ratio = strtod(value, &end);
+      is_valid = *end == '\0' && read_ratio >= 0.0 && read_ratio <= 1.0;
+    } else if (arg == "--value-size") {
+      is_valid = parse_unsigned(value, &value_size);
+    } else if (arg == "--batch-size") {
+      is_valid = parse_unsigned(value, &batch_size) && batch_size > 0;
+    } else if (arg == "--page-size") {
+      unsigned size = 0;
+      is_valid = parse_unsigned(value, &size);
+      page_size = static_cast<int>(size);
+    } else if (arg == "--partitions") {
+      is_valid = parse_unsigned(value, &partitions) && partitions > 0;
+    } else if (arg == "--rows-per-partition") {
+      is_valid = parse_unsigned(value, &rows_per_partition) && rows_per_partition > 0;
+    } else {
+      fprintf(stderr, "Unknown option '%s'\n", arg.c_str());
+      return false;
+    }
+    if (!is_valid) {
+      fprintf(stderr, "Invalid value for option '%s'\n", arg.c_str());
+      return false;
+    }
+    ++i;
+  }
+  return true;
+}
+
+class MockCluster {
+public:
+  MockCluster(const Options& options)
+      : cluster_(benchmark::build_workload_handler(options.rows_per_partition,
+                                                   options.value_size),
+                 options.mock_nodes) {}
+
+  int start() { return cluster_.start_all(); }
+
+private:
+  mockssandra::SimpleCluster cluster_;
+};
+
+/**
+ * Keeps `concurrency` requests in flight: each request slot issues its next
+ * request from the callback of the previous one. A read's latency includes
+ * all of its pages.
+ */
+class Benchmark {
+public:
+  Benchmark(const Options& options, CassSession* session, const CassPrepared* read_prepared,
+            const CassPrepared* write_prepared);
+  ~Benchmark();
+
+  void run();
+  void print_results() const;
+
+private:
+  struct Slot {
+    Benchmark* benchmark;
+    uint64_t random; // Only used by the slot's current request
+    CassStatement* read; // The read that's being paged
+    uint64_t start_ns;
+  };
+
+  bool execute_next(Slot* slot);
+  void execute(Slot* slot, CassStatement* statement);
+  void execute_write(Slot* slot);
+  CassStatement* new_write_statement(Slot* slot);
+  static uint64_t next_random(Slot* slot);
+  static void on_result(CassFuture* future, void* data);
+  void finish(Slot* slot, CassFuture* future);
+
+private:
+  const Options& options_;
+  CassSession* const session_;
+  const CassPrepared* const read_prepared_;
+  const CassPrepared* const write_prepared_;
+  const String value_;
+  Slot* slots_;
+
+  mutable uv_mutex_t mutex_;
+  uv_cond_t cond_;
+  unsigned started_;
+  unsigned finished_;
+  unsigned errors_;
+  uint64_t reads_;
+  uint64_t writes_;
+  uint64_t pages_;
+  uint64_t start_ns_;
+  uint64_t elapsed_ns_;
+  hdr_histogram* latencies_;
+};
+
+Benchmark::Benchmark(const Options& options, CassSession* session,
+                     const CassPrepared* read_prepared, const CassPrepared* write_prepared)
+    : options_(options)
+    , session_(session)
+    , read_prepared_(read_prepared)
+    , write_prepared_(write_prepared)
+    , value_(options.value_size, 'v')
+    , slots_(new Slot[options.concurrency])
+    , started_(0)
+    , finished_(0)
+    , errors_(0)
+    , reads_(0)
+    , writes_(0)
+    , pages_(0)
+    , start_ns_(0)
+    , elapsed_ns_(0)
+    , latencies_(NULL) {
+  uv_mutex_init(&mutex_);
+  uv_cond_init(&cond_);
+  hdr_init(1LL, HIGHEST_TRACKABLE_LATENCY_US, SIGNIFICANT_DIGITS, &latencies_);
+  for (unsigned i = 0; i < options.concurrency; ++i) {
+    slots_[i].benchmark = this;
+    slots_[i].random = 88172645463325252ULL + i; // Any non-zero seed
+    slots_[i].read = NULL;
+    slots_[i].start_ns = 0;
+  }
+}
+
+Benchmark::~Benchmark() {
+  free(latencies_);
+  delete[] slots_;
+  uv_cond_destroy(&cond_);
+  uv_mutex_destroy(&mutex_);
+}
+
+void Benchmark::run() {
+  start_ns_ = uv_hrtime();
+  for (unsigned i = 0; i < options_.concurrency; ++i) {
+    if (!execute_next(&slots_[i])) break;
+  }
+  ScopedMutex l(&mutex_);
+  while (finished_ < options_.requests) {
+    uv_cond_wait(&cond_, &mutex_);
+  }
+  elapsed_ns_ = uv_hrtime() - start_ns_;
+}
+
+bool Benchmark::execute_next(Slot* slot) {
+  { // The requests are executed outside of the lock because the callback
+    // runs on the calling thread if the request fails immediately.
+    ScopedMutex l(&mutex_);
+    if (started_ >= options_.requests) return false;
+    started_++;
+  }
+
+  slot->start_ns = uv_hrtime();
+  // Compare a random value in [0, 1) with the read ratio
+  if (static_cast<double>(next_random(slot) >> 11) / 9007199254740992.0 < options_.read_ratio) {
+    CassStatement* read = read_prepared_ ? cass_prepared_bind(read_prepared_)
+                                         : cass_statement_new(READ_QUERY, 1);
+    cass_statement_bind_int64(read, 0, next_random(slot) % options_.partitions);
+    cass_statement_set_is_idempotent(read, cass_true);
+    if (options_.page_size > 0) {
+      cass_statement_set_paging_size(read, options_.page_size);
+    }
+    slot->read = read;
+    execute(slot, read);
+  } else {
+    execute_write(slot);
+  }
+  return true;
+}
+
+void Benchmark::execute(Slot* slot, CassStatement* statement) {
+  CassFuture* future = cass_session_execute(session_, statement);
+  cass_future_set_callback(future, on_result, slot);
+  cass_future_free(future);
+}
+
+void Benchmark::execute_write(Slot* slot) {
+  CassFuture* future;
+  if (options_.batch_size > 1) {
+    CassBatch* batch = cass_batch_new(CASS_BATCH_TYPE_UNLOGGED);
+    cass_batch_set_is_idempotent(batch, cass_true);
+    for (unsigned i = 0; i < options_.batch_size; ++i) {
+      CassStatement* statement = new_write_statement(slot);
+      cass_batch_add_statement(batch, statement);
+      cass_statement_free(statement);
+    }
+    future = cass_session_execute_batch(session_, batch);
+    cass_batch_free(batch);
+  } else {
+    CassStatement* statement = new_write_statement(slot);
+    future = cass_session_execute(session_, statement);
+    cass_statement_free(statement);
+  }
+  cass_future_set_callback(future, on_result, slot);
+  cass_future_free(future);
+}
+
+CassStatement* Benchmark::new_write_statement(Slot* slot) {
+  CassStatement* statement = write_prepared_ ? cass_prepared_bind(write_prepared_)
+                                             : cass_statement_new(WRITE_QUERY, 3);
+  cass_statement_bind_int64(statement, 0, next_random(slot) % options_.partitions);
+  cass_statement_bind_int32(statement, 1,
+                            static_cast<cass_int32_t>(next_random(slot) %
+                                                      options_.rows_per_partition));
+  cass_statement_bind_bytes(statement, 2, reinterpret_cast<const cass_byte_t*>(value_.data()),
+                            value_.size());
+  cass_statement_set_is_idempotent(statement, cass_true);
+  return statement;
+}
+
+uint64_t Benchmark::next_random(Slot* slot) {
+  // xorshift64
+  slot->random ^= slot->random << 13;
+  slot->random ^= slot->random >> 7;
+  slot->random ^= slot->random << 17;
+  return slot->random;
+}
+
+void Benchmark::on_result(CassFuture* future, void* data) {
+  Slot* slot = static_cast<Slot*>(data);
+  slot->benchmark->finish(slot, future);
+}
+
+void Benchmark::finish(Slot* slot, CassFuture* future) {
+  uint64_t end_ns = uv_hrtime();
+  CassError rc = cass_future_error_code(future);
+  bool is_read = slot->read != NULL;
+
+  if (rc == CASS_OK && is_read) {
+    const CassResult* result = cass_future_get_result(future);
+    bool has_more_pages = cass_result_has_more_pages(result);
+    if (has_more_pages) {
+      cass_statement_set_paging_state(slot->read, result);
+    }
+    cass_result_free(result);
+    if (has_more_pages) {
+      { // Count the page
+        ScopedMutex l(&mutex_);
+        pages_++;
+      }
+      execute(slot, slot->read);
+      return;
+    }
+  }
+
+  if (is_read) {
+    cass_statement_free(slot->read);
+    slot->read = NULL;
+  }
+
+  {
+    ScopedMutex l(&mutex_);
+    if (rc != CASS_OK && errors_++ == 0) {
+      const char* message;
+      size_t message_length;
+      cass_future_error_message(future, &message, &message_length);
+      fprintf(stderr, "First error: %.*s\n", static_cast<int>(message_length), message);
+    }
+    if (is_read) {
+      reads_++;
+      if (rc == CASS_OK) pages_++;
+    } else {
+      writes_++;
+    }
+    hdr_record_value(latencies_, static_cast<int64_t>((end_ns - slot->start_ns) / 1000));
+    if (++finished_ >= options_.requests) {
+      uv_cond_signal(&cond_);
+    }
+  }
+
+  execute_next(slot);
+}
+
+void Benchmark::print_results() const {
+  ScopedMutex l(&mutex_);
+  double elapsed_s = static_cast<double>(elapsed_ns_) / 1e9;
+
+  printf("Workload: %u requests, concurrency %u, read ratio %.2f, value size %u bytes, %s "
+         "statements, batch size %u, page size %d, %u I/O thread(s), %u connection(s) per host\n",
+         options_.requests, options_.concurrency, options_.read_ratio, options_.value_size,
+         options_.use_prepared ? "prepared" : "simple", options_.batch_size, options_.page_size,
+         options_.io_threads, options_.connections);
+  printf("Elapsed: %.3f s\n", elapsed_s);
+  printf("Throughput: %.1f requests/s (%.1f reads/s, %.1f pages/s, %.1f rows written/s)\n",
+         finished_ / elapsed_s, reads_ / elapsed_s, pages_ / elapsed_s,
+         writes_ * options_.batch_size / elapsed_s);
+  printf("Errors: %u\n", errors_);
+  printf("Latency (us): min %lld, mean %.1f, p50 %lld, p90 %lld, p99 %lld, p99.9 %lld, "
+         "p99.99 %lld, max %lld\n",
+         static_cast<long long>(hdr_min(latencies_)), hdr_mean(latencies_),
+         static_cast<long long>(hdr_value_at_percentile(latencies_, 50.0)),
+         static_cast<long long>(hdr_value_at_percentile(latencies_, 90.0)),
+         static_cast<long long>(hdr_value_at_percentile(latencies_, 99.0)),
+         static_cast<long long>(hdr_value_at_percentile(latencies_, 99.9)),
+         static_cast<long long>(hdr_value_at_percentile(latencies_, 99.99)),
+         static_cast<long long>(hdr_max(latencies_)));
+
+  if (options_.print_distribution) {
+    // The same layout as HdrHistogram's percentile output so it can be
+    // plotted and compared with HdrHistogram's tools
+    printf("\n%12s %14s %10s %14s\n\n", "Value", "Percentile", "TotalCount", "1/(1-Percentile)");
+    hdr_iter iter;
+    hdr_iter_percentile_init(&iter, latencies_, 5);
+    while (hdr_iter_next(&iter)) {
+      double percentile = iter.specifics.percentiles.percentile / 100.0;
+      if (percentile < 1.0) {
+        printf("%12lld %2.12f %10lld %14.2f\n",
+               static_cast<long long>(iter.highest_equivalent_value), percentile,
+               static_cast<long long>(iter.count_to_index), 1.0 / (1.0 - percentile));
+      } else {
+        printf("%12lld %2.12f %10lld\n", static_cast<long long>(iter.highest_equivalent_value),
+               percentile, static_cast<long long>(iter.count_to_index));
+      }
+    }
+    printf("#[Mean    = %12.3f, StdDeviation   = %12.3f]\n", hdr_mean(latencies_),
+           hdr_stddev(latencies_));
+    printf("#[Max     = %12lld, Total count    = %12lld]\n",
+           static_cast<long long>(hdr_max(latencies_)),
+           static_cast<long long>(latencies_->total_count));
+  }
+}
+
+static CassError wait_for(CassFuture* future, const char* what) {
+  CassError rc = cass_future_error_code(future);
+  if (rc != CASS_OK) {
+    const char* message;
+    size_t message_length;
+    cass_future_error_message(future, &message, &message_length);
+    fprintf(stderr, "Unable to %s: %.*s\n", what, static_cast<int>(message_length), message);
+  }
+  return rc;
+}
+
+static CassError execute_query(CassSession* session, const char* query) {
+  CassStatement* statement = cass_statement_new(query, 0);
+  CassFuture* future = cass_session_execute(session, statement);
+  CassError rc = wait_for(future, "create the schema");
+  cass_future_free(future);
+  cass_statement_free(statement);
+  return rc;
+}
+
+static const CassPrepared* prepare(CassSession* session, const char* query) {
+  CassFuture* future = cass_session_prepare(session, query);
+  const CassPrepared* prepared = NULL;
+  if (wait_for(future, "prepare") == CASS_OK) {
+    prepared = cass_future_get_prepared(future);
+  }
+  cass_future_free(future);
+  return prepared;
+}
+
+int main(int argc, char* argv[]) {
+  Options options;
+  if (!options.parse(argc, argv)) {
+    print_usage(argv[0]);
+    return 1;
+  }
+
+  ScopedPtr<MockCluster> mock_cluster;
+  if (options.use_mock) {
+    mock_cluster.reset(new MockCluster(options));
+    if (mock_cluster->start() != 0) {
+      fprintf(stderr, "Unable to start the mockssandra cluster\n");
+      return 1;
+    }
+    options.hosts = "127.0.0.1";
+  }
+
+  CassCluster* cluster = cass_cluster_new();
+  cass_cluster_set_contact_points(cluster, options.hosts.c_str());
+  cass_cluster_set_num_threads_io(cluster, options.io_threads);
+  cass_cluster_set_core_connections_per_host(cluster, options.connections);
+  cass_cluster_set_queue_size_io(cluster, std::max(8192u, 2 * options.concurrency));
+  if (options.use_mock) {
+    // The mock cluster only knows the benchmark's queries
+    cass_cluster_set_use_schema(cluster, cass_false);
+    cass_cluster_set_token_aware_routing(cluster, cass_false);
+  }
+
+  CassSession* session = cass_session_new();
+  CassFuture* connect_future = cass_session_connect(session, cluster);
+  CassError rc = wait_for(connect_future, "connect");
+  cass_future_free(connect_future);
+
+  if (rc == CASS_OK && !options.use_mock) {
+    rc = execute_query(session, "CREATE KEYSPACE IF NOT EXISTS " KEYSPACE " WITH replication = "
+                                "{ 'class': 'SimpleStrategy', 'replication_factor': '1' }");
+    if (rc == CASS_OK) {
+      rc = execute_query(session, "CREATE TABLE IF NOT EXISTS " KEYSPACE "." TABLE
+                                  " (pk bigint, ck int, value blob, PRIMARY KEY (pk, ck))");
+    }
+  }
+
+  const CassPrepared* read_prepared = NULL;
+  const CassPrepared* write_prepared = NULL;
+  if (rc == CASS_OK && options.use_prepared) {
+    read_prepared = prepare(session, READ_QUERY);
+    write_prepared = prepare(session, WRITE_QUERY);
+    if (!read_prepared || !write_prepared) rc = CASS_ERROR_LIB_UNEXPECTED_RESPONSE;
+  }
+
+  if (rc == CASS_OK) {
+    Benchmark benchmark(options, session, read_prepared, write_prepared);
+    benchmark.run();
+    benchmark.print_results();
+  }
+
+  if (read_prepared) cass_prepared_free(read_prepared);
+  if (write_prepared) cass_prepared_free(write_prepared);
+
+  CassFuture* close_future = cass_session_close(session);
+  cass_future_wait(close_future);
+  cass_future_free(close_future);
+  cass_session_free(session);
+  cass_cluster_free(cluster);
+
+  return rc == CASS_OK ? 0 : 1;
+}
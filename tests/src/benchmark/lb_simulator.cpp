@@ -0,0 +1,824 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+/*
+ * A deterministic discrete event simulation of the driver's request routing.
+ * Requests with random routing keys arrive at a fixed rate and are sent to the
+ * hosts of the driver's own query plans, retried using the default retry
+ * policy and speculatively executed using the constant speculative execution
+ * policy. The hosts of a synthetic token ring serve a limited number of
+ * requests at the same time with sampled latencies, queue the rest and can be
+ * configured to be slow, to fail requests or to never answer them. Everything
+ * is driven by a virtual clock and a seeded generator, so a run is repeatable
+ * and policies can be compared without a cluster (see cassandra-mock-server to
+ * benchmark the full driver).
+ */
+
+#include "dc_aware_policy.hpp"
+#include "deque.hpp"
+#include "latency_aware_policy.hpp"
+#include "query_request.hpp"
+#include "random.hpp"
+#include "request_handler.hpp"
+#include "retry_policy.hpp"
+#include "round_robin_policy.hpp"
+#include "speculative_execution.hpp"
+#include "token_aware_policy.hpp"
+
+#include "test_token_map_utils.hpp"
+
+#include <algorithm>
+#include <math.h>
+#include <queue>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define PI 3.14159265358979323846
+#define NS_PER_MS 1000000.0
+#define KEYSPACE "simulation"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+namespace {
+
+/**
+ * A distribution of service times in milliseconds (fractions are allowed):
+ *
+ * fixed:<ms>, uniform:<min ms>:<max ms>, exponential:<mean ms> or
+ * lognormal:<median ms>:<sigma>
+ */
+class Distribution {
+public:
+  enum Type { FIXED, UNIFORM, EXPONENTIAL, LOG_NORMAL };
+
+  Distribution()
+      : type_(FIXED)
+      , a_(0.0)
+      , b_(0.0) {}
+
+  static bool parse(const String& spec, Distribution* distribution) {
+    char name[16];
+    double a = 0.0, b = 0.0;
+    int count = sscanf(spec.c_str(), "%15[a-z]:%lf:%lf", name, &a, &b);
+    if (count < 2 || a < 0.0 || b < 0.0) return false;
+    String type(name);
+    if (type == "fixed" && count == 2) {
+      distribution->type_ = FIXED;
+    } else if (type == "uniform" && count == 3 && a <= b) {
+      distribution->type_ = UNIFORM;
+    } else if (type == "exponential" && count == 2) {
+      distribution->type_ = EXPONENTIAL;
+    } else if (type == "lognormal" && count == 3) {
+      distribution->type_ = LOG_NORMAL;
+    } else {
+      return false;
+    }
+    distribution->a_ = a;
+    distribution->b_ = b;
+    return true;
+  }
+
+  /**
+   * Sample a service time.
+   *
+   * @param u1 A uniform random value in [0, 1).
+   * @param u2 Another uniform random value in [0, 1).
+   * @return The service time in nanoseconds.
+   */
+  uint64_t sample(double u1, double u2) const {
+    double ms = a_;
+    switch (type_) {
+      case FIXED:
+        break;
+      case UNIFORM:
+        ms = a_ + (b_ - a_) * u1;
+        break;
+      case EXPONENTIAL:
+        ms = -a_ * log(1.0 - u1);
+        break;
+      case LOG_NORMAL: // Box-Muller
+        ms = a_ * exp(b_ * sqrt(-2.0 * log(1.0 - u1)) * cos(2.0 * PI * u2));
+        break;
+    }
+    return static_cast<uint64_t>(ms * NS_PER_MS);
+  }
+
+private:
+  Type type_;
+  double a_;
+  double b_;
+};
+
+/**
+ * The behavior of a simulated node. The ratios are the fraction of the
+ * requests that are never answered (so they time out on the client) and that
+ * fail with an OVERLOADED error.
+ */
+struct NodeModel {
+  NodeModel()
+      : timeout_ratio(0.0)
+      , overloaded_ratio(0.0) {}
+
+  Distribution latency;
+  double timeout_ratio;
+  double overloaded_ratio;
+};
+
+struct Settings {
+  Settings()
+      : num_dcs(2)
+      , nodes_per_dc(3)
+      , num_vnodes(256)
+      , replication_factor(3)
+      , num_keys(10000)
+      , num_requests(100000)
+      , rate(20000.0)
+      , policy("token-aware")
+      , shuffle_replicas(1)
+      , least_loaded_replicas(0)
+      , timeout_ms(12000.0)
+      , speculative_delay_ms(0)
+      , speculative_executions(0)
+      , concurrency(32)
+      , network_latency_ms(0.2)
+      , seed(1) {}
+
+  unsigned num_dcs;
+  unsigned nodes_per_dc;
+  unsigned num_vnodes;
+  unsigned replication_factor;
+  unsigned num_keys;
+  unsigned num_requests;
+  double rate;
+  String policy;
+  unsigned shuffle_replicas;
+  unsigned least_loaded_replicas;
+  double timeout_ms;
+  unsigned speculative_delay_ms;
+  unsigned speculative_executions;
+  unsigned concurrency;
+  double network_latency_ms;
+  unsigned seed;
+};
+
+enum EventType {
+  EVENT_ARRIVAL,               // A new request is started
+  EVENT_SPECULATIVE_EXECUTION, // The next speculative execution of a request is due
+  EVENT_NODE_RECEIVE,          // An attempt reaches its node
+  EVENT_SERVICE_DONE,          // A node finished serving an attempt
+  EVENT_RESPONSE,              // An attempt's response reaches the client
+  EVENT_ATTEMPT_TIMEOUT,       // An attempt that's never answered times out
+  EVENT_REQUEST_TIMEOUT,       // A request times out
+  EVENT_UPDATE                 // The latency aware policy's update timer
+};
+
+struct Event {
+  Event(uint64_t time, uint64_t sequence, EventType type, size_t index)
+      : time(time)
+      , sequence(sequence)
+      , type(type)
+      , index(index) {}
+
+  // Ordered by time and then by when they're scheduled so that a run is
+  // repeatable
+  bool operator>(const Event& other) const {
+    return time != other.time ? time > other.time : sequence > other.sequence;
+  }
+
+  uint64_t time;
+  uint64_t sequence;
+  EventType type;
+  size_t index; // The request or the attempt
+};
+
+struct Node {
+  Node()
+      : busy(0)
+      , num_attempts(0)
+      , num_errors(0)
+      , num_timeouts(0)
+      , max_queued(0)
+      , service_time_ns(0) {}
+
+  Host::Ptr host;
+  NodeModel model;
+  unsigned busy;
+  Deque<size_t> queued;
+
+  uint64_t num_attempts;
+  uint64_t num_errors;
+  uint64_t num_timeouts;
+  uint64_t max_queued;
+  uint64_t service_time_ns;
+};
+
+struct Attempt {
+  enum Outcome { SUCCESS, OVERLOADED, NO_RESPONSE };
+
+  Attempt(size_t request, size_t node, uint64_t start_ns)
+      : request(request)
+      , node(node)
+      , start_ns(start_ns)
+      , outcome(SUCCESS) {}
+
+  size_t request;
+  size_t node;
+  uint64_t start_ns;
+  Outcome outcome;
+};
+
+struct SimulatedRequest {
+  SimulatedRequest(size_t key, uint64_t start_ns)
+      : key(key)
+      , start_ns(start_ns)
+      , num_retries(0)
+      , num_outstanding(0)
+      , is_done(false) {}
+
+  size_t key;
+  uint64_t start_ns;
+  ScopedPtr<QueryPlan> query_plan;
+  ScopedPtr<SpeculativeExecutionPlan> speculative_plan;
+  int num_retries;
+  unsigned num_outstanding;
+  bool is_done;
+};
+
+class Simulation {
+public:
+  Simulation(const Settings& settings, const Vector<NodeModel>& models)
+      : settings_(settings)
+      , rng_(settings.seed)
+      , random_(settings.seed)
+      , token_map_(TokenMap::from_partitioner(Murmur3Partitioner::name()))
+      , retry_policy_(new DefaultRetryPolicy())
+      , now_(0)
+      , sequence_(0)
+      , num_finished_(0)
+      , num_failed_(0)
+      , num_timed_out_(0)
+      , num_retries_(0)
+      , num_speculative_executions_(0) {
+    build_cluster(models);
+    build_policy();
+    if (settings.speculative_executions > 0) {
+      speculative_policy_.reset(new ConstantSpeculativeExecutionPolicy(
+          settings.speculative_delay_ms, settings.speculative_executions));
+    }
+  }
+
+  ~Simulation() {
+    for (size_t i = 0; i < requests_.size(); ++i) {
+      delete requests_[i];
+    }
+  }
+
+  void run();
+  void report() const;
+
+private:
+  void build_cluster(const Vector<NodeModel>& models);
+  void build_policy();
+
+  double uniform() { return static_cast<double>(rng_() >> 11) * (1.0 / 9007199254740992.0); }
+
+  void schedule(uint64_t delay_ns, EventType type, size_t index) {
+    events_.push(Event(now_ + delay_ns, sequence_++, type, index));
+  }
+
+  uint64_t half_round_trip() const {
+    return static_cast<uint64_t>(settings_.network_latency_ms * NS_PER_MS / 2.0);
+  }
+
+  void on_arrival(size_t request_index);
+  bool start_execution(size_t request_index, const Host::Ptr& current_host = Host::Ptr());
+  void on_speculative_execution(size_t request_index);
+  void on_node_receive(size_t attempt_index);
+  void start_service(size_t attempt_index);
+  void on_service_done(size_t attempt_index);
+  void on_response(size_t attempt_index);
+  void on_attempt_timeout(size_t attempt_index);
+  void on_request_timeout(size_t request_index);
+  void finish(size_t request_index, bool is_success);
+
+private:
+  typedef std::priority_queue<Event, Vector<Event>, std::greater<Event> > EventQueue;
+
+  const Settings settings_;
+  MT19937_64 rng_;
+  Random random_;
+  TokenMap::Ptr token_map_;
+  HostMap hosts_;
+  Map<Address, size_t> node_indexes_;
+  Vector<Node> nodes_;
+  LoadBalancingPolicy::Ptr policy_;
+  LatencyAwarePolicy* latency_aware_policy_;
+  RetryPolicy::Ptr retry_policy_;
+  SpeculativeExecutionPolicy::Ptr speculative_policy_;
+  Vector<SharedRefPtr<RequestHandler> > request_handlers_; // One for each key
+
+  EventQueue events_;
+  uint64_t now_;
+  uint64_t sequence_;
+  Vector<SimulatedRequest*> requests_;
+  Vector<Attempt> attempts_;
+
+  size_t num_finished_;
+  uint64_t num_failed_;
+  uint64_t num_timed_out_;
+  uint64_t num_retries_;
+  uint64_t num_speculative_executions_;
+  Vector<uint64_t> latencies_;
+};
+
+void Simulation::build_cluster(const Vector<NodeModel>& models) {
+  ReplicationMap replication;
+  for (unsigned i = 0; i < settings_.num_dcs * settings_.nodes_per_dc; ++i) {
+    OStringStream dc;
+    dc << "dc" << (i / settings_.nodes_per_dc + 1);
+    OStringStream address;
+    address << "127.0." << (i / 250) << "." << (i % 250 + 1);
+    Host::Ptr host(create_host(address.str(), random_murmur3_tokens(rng_, settings_.num_vnodes),
+                               Murmur3Partitioner::name().to_string(), "rack", dc.str()));
+    // The latency aware policy's in-flight penalty is per connection
+    host->increment_connection_count();
+    hosts_[host->address()] = host;
+    token_map_->add_host(host);
+    replication[dc.str()] = "0";
+
+    node_indexes_[host->address()] = nodes_.size();
+    nodes_.push_back(Node());
+    nodes_.back().host = host;
+    nodes_.back().model = models[i];
+  }
+
+  for (ReplicationMap::iterator it = replication.begin(); it != replication.end(); ++it) {
+    OStringStream rf;
+    rf << settings_.replication_factor;
+    it->second = rf.str();
+  }
+  add_keyspace_network_topology(KEYSPACE, replication, token_map_.get());
+  token_map_->build();
+
+  for (size_t i = 0; i < settings_.num_keys; ++i) {
+    QueryRequest::Ptr request(new QueryRequest("", 1));
+    request->set(0, static_cast<cass_int64_t>(rng_()));
+    request->add_key_index(0);
+    request->set_consistency(CASS_CONSISTENCY_LOCAL_ONE);
+    request->set_is_idempotent(true);
+    request_handlers_.push_back(
+        SharedRefPtr<RequestHandler>(new RequestHandler(request, ResponseFuture::Ptr())));
+  }
+}
+
+void Simulation::build_policy() {
+  latency_aware_policy_ = NULL;
+  if (settings_.policy == "round-robin") {
+    policy_.reset(new RoundRobinPolicy());
+  } else if (settings_.policy == "dc-aware") {
+    policy_.reset(new DCAwarePolicy("dc1", settings_.nodes_per_dc, false));
+  } else {
+    LoadBalancingPolicy* token_aware_policy =
+        new TokenAwarePolicy(new DCAwarePolicy("dc1", settings_.nodes_per_dc, false),
+                             settings_.shuffle_replicas != 0, settings_.least_loaded_replicas != 0);
+    if (settings_.policy == "token-aware") {
+      policy_.reset(token_aware_policy);
+    } else { // "latency-aware"
+      latency_aware_policy_ =
+          new LatencyAwarePolicy(token_aware_policy, LatencyAwarePolicy::Settings());
+      policy_.reset(latency_aware_policy_);
+    }
+  }
+  policy_->init(Host::Ptr(), hosts_, &random_, "dc1", "");
+}
+
+void Simulation::run() {
+  if (settings_.num_requests > 0) {
+    schedule(0, EVENT_ARRIVAL, 0);
+  }
+  if (latency_aware_policy_ != NULL) {
+    schedule(LatencyAwarePolicy::Settings().update_rate_ms * NS_PER_MS, EVENT_UPDATE, 0);
+  }
+
+  while (!events_.empty()) {
+    Event event(events_.top());
+    events_.pop();
+    now_ = event.time;
+    switch (event.type) {
+      case EVENT_ARRIVAL:
+        on_arrival(event.index);
+        break;
+      case EVENT_SPECULATIVE_EXECUTION:
+        on_speculative_execution(event.index);
+        break;
+      case EVENT_NODE_RECEIVE:
+        on_node_receive(event.index);
+        break;
+      case EVENT_SERVICE_DONE:
+        on_service_done(event.index);
+        break;
+      case EVENT_RESPONSE:
+        on_response(event.index);
+        break;
+      case EVENT_ATTEMPT_TIMEOUT:
+        on_attempt_timeout(event.index);
+        break;
+      case EVENT_REQUEST_TIMEOUT:
+        on_request_timeout(event.index);
+        break;
+      case EVENT_UPDATE:
+        latency_aware_policy_->update_min_average();
+        if (num_finished_ < settings_.num_requests) {
+          schedule(LatencyAwarePolicy::Settings().update_rate_ms * NS_PER_MS, EVENT_UPDATE, 0);
+        }
+        break;
+    }
+  }
+}
+
+void Simulation::on_arrival(size_t request_index) {
+  size_t key = static_cast<size_t>(rng_() % settings_.num_keys);
+  SimulatedRequest* request = new SimulatedRequest(key, now_);
+  requests_.push_back(request);
+
+  RequestHandler* request_handler = request_handlers_[key].get();
+  request->query_plan.reset(
+      policy_->new_query_plan(KEYSPACE, request_handler, token_map_.get()));
+  if (speculative_policy_) {
+    request->speculative_plan.reset(
+        speculative_policy_->new_plan(KEYSPACE, request_handler->request()));
+  }
+
+  schedule(static_cast<uint64_t>(settings_.timeout_ms * NS_PER_MS), EVENT_REQUEST_TIMEOUT,
+           request_index);
+  if (!start_execution(request_index)) {
+    finish(request_index, false);
+  }
+
+  if (request_index + 1 < settings_.num_requests) {
+    double interval_s = -log(1.0 - uniform()) / settings_.rate;
+    schedule(static_cast<uint64_t>(interval_s * 1e9), EVENT_ARRIVAL, request_index + 1);
+  }
+}
+
+bool Simulation::start_execution(size_t request_index, const Host::Ptr& current_host) {
+  SimulatedRequest* request = requests_[request_index];
+  Host::Ptr host(current_host ? current_host : request->query_plan->compute_next());
+  if (!host) return false;
+
+  size_t node_index = node_indexes_[host->address()];
+  attempts_.push_back(Attempt(request_index, node_index, now_));
+  host->increment_inflight_requests();
+  nodes_[node_index].num_attempts++;
+  request->num_outstanding++;
+  schedule(half_round_trip(), EVENT_NODE_RECEIVE, attempts_.size() - 1);
+
+  if (request->speculative_plan) {
+    int64_t delay_ms = request->speculative_plan->next_execution(host);
+    if (delay_ms >= 0) {
+      schedule(static_cast<uint64_t>(delay_ms * NS_PER_MS), EVENT_SPECULATIVE_EXECUTION,
+               request_index);
+    }
+  }
+  return true;
+}
+
+void Simulation::on_speculative_execution(size_t request_index) {
+  if (requests_[request_index]->is_done) return;
+  if (start_execution(request_index)) {
+    num_speculative_executions_++;
+  }
+}
+
+void Simulation::on_node_receive(size_t attempt_index) {
+  Attempt& attempt = attempts_[attempt_index];
+  Node& node = nodes_[attempt.node];
+
+  double u = uniform();
+  if (u < node.model.timeout_ratio) {
+    attempt.outcome = Attempt::NO_RESPONSE;
+    node.num_timeouts++;
+    // The attempt is abandoned by the client when the request times out
+    uint64_t timeout_ns =
+        attempt.start_ns + static_cast<uint64_t>(settings_.timeout_ms * NS_PER_MS);
+    schedule(timeout_ns > now_ ? timeout_ns - now_ : 0, EVENT_ATTEMPT_TIMEOUT, attempt_index);
+    return;
+  }
+  if (u < node.model.timeout_ratio + node.model.overloaded_ratio) {
+    attempt.outcome = Attempt::OVERLOADED;
+  }
+
+  if (node.busy < settings_.concurrency) {
+    start_service(attempt_index);
+  } else {
+    node.queued.push_back(attempt_index);
+    node.max_queued = std::max(node.max_queued, static_cast<uint64_t>(node.queued.size()));
+  }
+}
+
+void Simulation::start_service(size_t attempt_index) {
+  Node& node = nodes_[attempts_[attempt_index].node];
+  node.busy++;
+  // Errors are returned right away
+  uint64_t service_time_ns = attempts_[attempt_index].outcome == Attempt::OVERLOADED
+                                 ? 0
+                                 : node.model.latency.sample(uniform(), uniform());
+  node.service_time_ns += service_time_ns;
+  schedule(service_time_ns, EVENT_SERVICE_DONE, attempt_index);
+}
+
+void Simulation::on_service_done(size_t attempt_index) {
+  Node& node = nodes_[attempts_[attempt_index].node];
+  node.busy--;
+  if (!node.queued.empty()) {
+    size_t next = node.queued.front();
+    node.queued.pop_front();
+    start_service(next);
+  }
+  schedule(half_round_trip(), EVENT_RESPONSE, attempt_index);
+}
+
+void Simulation::on_response(size_t attempt_index) {
+  const Attempt& attempt = attempts_[attempt_index];
+  Node& node = nodes_[attempt.node];
+  SimulatedRequest* request = requests_[attempt.request];
+  node.host->decrement_inflight_requests();
+  request->num_outstanding--;
+
+  if (attempt.outcome == Attempt::SUCCESS) {
+    node.host->update_latency(now_ - attempt.start_ns);
+    if (!request->is_done) {
+      finish(attempt.request, true);
+    }
+    return;
+  }
+
+  node.num_errors++;
+  if (request->is_done) return;
+
+  const RequestHandler* request_handler = request_handlers_[request->key].get();
+  RetryPolicy::RetryDecision decision =
+      retry_policy_->on_request_error(request_handler->request(), request_handler->consistency(),
+                                      NULL, request->num_retries++);
+  if (decision.type() == RetryPolicy::RetryDecision::RETRY) {
+    num_retries_++;
+    if (start_execution(attempt.request,
+                        decision.retry_current_host() ? node.host : Host::Ptr())) {
+      return;
+    }
+  }
+  if (request->num_outstanding == 0) {
+    finish(attempt.request, false);
+  }
+}
+
+void Simulation::on_attempt_timeout(size_t attempt_index) {
+  const Attempt& attempt = attempts_[attempt_index];
+  const Host::Ptr& host = nodes_[attempt.node].host;
+  host->update_latency(now_ - attempt.start_ns);
+  host->decrement_inflight_requests();
+  requests_[attempt.request]->num_outstanding--;
+}
+
+void Simulation::on_request_timeout(size_t request_index) {
+  if (requests_[request_index]->is_done) return;
+  num_timed_out_++;
+  finish(request_index, false);
+}
+
+void Simulation::finish(size_t request_index, bool is_success) {
+  SimulatedRequest* request = requests_[request_index];
+  request->is_done = true;
+  request->query_plan.reset();
+  request->speculative_plan.reset();
+  num_finished_++;
+  if (is_success) {
+    latencies_.push_back(now_ - request->start_ns);
+  } else {
+    num_failed_++;
+  }
+}
+
+static double percentile_ms(const Vector<uint64_t>& sorted, double percentile) {
+  if (sorted.empty()) return 0.0;
+  size_t index = static_cast<size_t>(percentile / 100.0 * static_cast<double>(sorted.size()));
+  return static_cast<double>(sorted[std::min(index, sorted.size() - 1)]) / NS_PER_MS;
+}
+
+void Simulation::report() const {
+  Vector<uint64_t> sorted(latencies_);
+  std::sort(sorted.begin(), sorted.end());
+
+  printf("Simulated %u request(s) over %.3f s using the %s policy (seed %u)\n",
+         settings_.num_requests, static_cast<double>(now_) / 1e9, settings_.policy.c_str(),
+         settings_.seed);
+  printf("Succeeded: %llu, failed: %llu (timed out: %llu)\n",
+         static_cast<unsigned long long>(latencies_.size()),
+         static_cast<unsigned long long>(num_failed_),
+         static_cast<unsigned long long>(num_timed_out_));
+  printf("Retries: %llu, speculative executions: %llu\n",
+         static_cast<unsigned long long>(num_retries_),
+         static_cast<unsigned long long>(num_speculative_executions_));
+  printf("Latency (ms): p50 %.3f, p90 %.3f, p99 %.3f, p99.9 %.3f, max %.3f\n",
+         percentile_ms(sorted, 50.0), percentile_ms(sorted, 90.0), percentile_ms(sorted, 99.0),
+         percentile_ms(sorted, 99.9), percentile_ms(sorted, 100.0));
+
+  uint64_t total_attempts = 0;
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    total_attempts += nodes_[i].num_attempts;
+  }
+
+  printf("\n%-14s %-5s %10s %7s %9s %8s %10s %12s\n", "Node", "DC", "Attempts", "Share",
+         "Errors", "Timeouts", "Max queued", "Utilization");
+  double elapsed_ns = std::max(static_cast<double>(now_), 1.0);
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    const Node& node = nodes_[i];
+    double share = total_attempts > 0 ? 100.0 * static_cast<double>(node.num_attempts) /
+                                            static_cast<double>(total_attempts)
+                                      : 0.0;
+    double utilization =
+        100.0 * static_cast<double>(node.service_time_ns) / (elapsed_ns * settings_.concurrency);
+    printf("%-14s %-5s %10llu %6.2f%% %9llu %8llu %10llu %11.2f%%\n",
+           node.host->address_string().c_str(), node.host->dc().c_str(),
+           static_cast<unsigned long long>(node.num_attempts), share,
+           static_cast<unsigned long long>(node.num_errors),
+           static_cast<unsigned long long>(node.num_timeouts),
+           static_cast<unsigned long long>(node.max_queued), utilization);
+  }
+}
+
+} // namespace
+
+static void print_usage(const char* program) {
+  fprintf(stderr,
+          "Usage: %s [options]\n"
+          "\n"
+          "Cluster and workload:\n"
+          "  --dcs <n>                        Number of datacenters (default: 2)\n"
+          "  --nodes-per-dc <n>               Number of nodes in each datacenter (default: 3)\n"
+          "  --vnodes <n>                     Number of tokens of each node (default: 256)\n"
+          "  --replication-factor <n>         Replicas in each datacenter (default: 3)\n"
+          "  --keys <n>                       Number of distinct routing keys (default: 10000)\n"
+          "  --requests <n>                   Number of requests (default: 100000)\n"
+          "  --rate <requests/s>              Poisson arrival rate (default: 20000)\n"
+          "  --seed <n>                       Random seed (default: 1)\n"
+          "\n"
+          "Driver:\n"
+          "  --policy <name>                  round-robin, dc-aware, token-aware or\n"
+          "                                   latency-aware (default: token-aware); the\n"
+          "                                   local datacenter is dc1\n"
+          "  --shuffle-replicas <0|1>         Shuffle the token aware replicas (default: 1)\n"
+          "  --least-loaded-replicas <0|1>    Order the replicas by load (default: 0)\n"
+          "  --timeout <ms>                   Request timeout (default: 12000)\n"
+          "  --speculative-executions <n>     Maximum speculative executions (default: 0)\n"
+          "  --speculative-delay <ms>         Delay of each speculative execution (default: 0)\n"
+          "\n"
+          "Nodes (use --node-<option> <node>=<value> to set a node's, e.g.\n"
+          "--node-latency 2=fixed:50; nodes are numbered from 1 in datacenter order):\n"
+          "  --concurrency <n>                Requests a node serves at the same time, the\n"
+          "                                   rest are queued (default: 32)\n"
+          "  --network-latency <ms>           Round trip time (default: 0.2)\n"
+          "  --latency <distribution>         Service time: fixed:<ms>, uniform:<min>:<max>,\n"
+          "                                   exponential:<mean> or lognormal:<median>:<sigma>\n"
+          "                                   (default: lognormal:1:0.5)\n"
+          "  --timeout-ratio <ratio>          Ratio of requests that are never answered\n"
+          "  --overloaded-ratio <ratio>       Ratio of requests that fail with OVERLOADED\n",
+          program);
+}
+
+static bool parse_ratio(const char* value, double* ratio) {
+  char* end;
+  *ratio = strtod(value, &end);
+  return *value != '\0' && *end == '\0' && *ratio >= 0.0 && *ratio <= 1.0;
+}
+
+static bool parse_double(const char* value, double* result) {
+  char* end;
+  *result = strtod(value, &end);
+  return *value != '\0' && *end == '\0' && *result >= 0.0;
+}
+
+static bool parse_unsigned(const char* value, unsigned* result) {
+  char* end;
+  unsigned long parsed = strtoul(value, &end, 10);
+  *result = static_cast<unsigned>(parsed);
+  return *value != '\0' && *end == '\0';
+}
+
+/**
+ * Set one of a node's options.
+ *
+ * @param name The option without the leading "--" or "--node-".
+ * @param value The option's value.
+ * @param model The node model that's updated.
+ * @return false if the option isn't a node option or the value is invalid.
+ */
+static bool set_node_option(const String& name, const char* value, NodeModel* model) {
+  if (name == "latency") {
+    return Distribution::parse(value, &model->latency);
+  } else if (name == "timeout-ratio") {
+    return parse_ratio(value, &model->timeout_ratio);
+  } else if (name == "overloaded-ratio") {
+    return parse_ratio(value, &model->overloaded_ratio);
+  }
+  return false;
+}
+
+int main(int argc, char* argv[]) {
+  Settings settings;
+  NodeModel default_model;
+  Distribution::parse("lognormal:1:0.5", &default_model.latency);
+  // The node specific options are applied after the options of all nodes
+  Vector<std::pair<String, String> > node_options;
+
+  for (int i = 1; i < argc; ++i) {
+    String arg(argv[i]);
+    if (arg.compare(0, 2, "--") != 0 || i + 1 >= argc) {
+      print_usage(argv[0]);
+      return 1;
+    }
+    const char* value = argv[++i];
+    bool is_valid = true;
+    if (arg == "--dcs") {
+      is_valid = parse_unsigned(value, &settings.num_dcs) && settings.num_dcs > 0;
+    } else if (arg == "--nodes-per-dc") {
+      is_valid = parse_unsigned(value, &settings.nodes_per_dc) && settings.nodes_per_dc > 0;
+    } else if (arg == "--vnodes") {
+      is_valid = parse_unsigned(value, &settings.num_vnodes) && settings.num_vnodes > 0;
+    } else if (arg == "--replication-factor") {
+      is_valid = parse_unsigned(value, &settings.replication_factor) &&
+                 settings.replication_factor > 0;
+    } else if (arg == "--keys") {
+      is_valid = parse_unsigned(value, &settings.num_keys) && settings.num_keys > 0;
+    } else if (arg == "--requests") {
+      is_valid = parse_unsigned(value, &settings.num_requests);
+    } else if (arg == "--rate") {
+      is_valid = parse_double(value, &settings.rate) && settings.rate > 0.0;
+    } else if (arg == "--seed") {
+      is_valid = parse_unsigned(value, &settings.seed);
+    } else if (arg == "--policy") {
+      settings.policy = value;
+      is_valid = settings.policy == "round-robin" || settings.policy == "dc-aware" ||
+                 settings.policy == "token-aware" || settings.policy == "latency-aware";
+    } else if (arg == "--shuffle-replicas") {
+      is_valid = parse_unsigned(value, &settings.shuffle_replicas);
+    } else if (arg == "--least-loaded-replicas") {
+      is_valid = parse_unsigned(value, &settings.least_loaded_replicas);
+    } else if (arg == "--timeout") {
+      is_valid = parse_double(value, &settings.timeout_ms) && settings.timeout_ms > 0.0;
+    } else if (arg == "--speculative-executions") {
+      is_valid = parse_unsigned(value, &settings.speculative_executions);
+    } else if (arg == "--speculative-delay") {
+      is_valid = parse_unsigned(value, &settings.speculative_delay_ms);
+    } else if (arg == "--concurrency") {
+      is_valid = parse_unsigned(value, &settings.concurrency) && settings.concurrency > 0;
+    } else if (arg == "--network-latency") {
+      is_valid = parse_double(value, &settings.network_latency_ms);
+    } else if (arg.compare(0, 7, "--node-") == 0) {
+      node_options.push_back(std::make_pair(arg.substr(7), String(value)));
+    } else {
+      is_valid = set_node_option(arg.substr(2), value, &default_model);
+    }
+    if (!is_valid) {
+      fprintf(stderr, "Invalid option or value '%s %s'\n", arg.c_str(), value);
+      print_usage(argv[0]);
+      return 1;
+    }
+  }
+
+  unsigned num_nodes = settings.num_dcs * settings.nodes_per_dc;
+  Vector<NodeModel> models(num_nodes, default_model);
+  for (size_t i = 0; i < node_options.size(); ++i) {
+    const String& name = node_options[i].first;
+    const String& option = node_options[i].second;
+    size_t pos = option.find('=');
+    unsigned node = 0;
+    if (pos == String::npos || !parse_unsigned(option.substr(0, pos).c_str(), &node) ||
+        node < 1 || node > num_nodes ||
+        !set_node_option(name, option.c_str() + pos + 1, &models[node - 1])) {
+      fprintf(stderr, "Invalid option or value '--node-%s %s'\n", name.c_str(), option.c_str());
+      print_usage(argv[0]);
+      return 1;
+    }
+  }
+
+  Simulation simulation(settings, models);
+  simulation.run();
+  simulation.report();
+  return 0;
+}
@@ -0,0 +1,242 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "micro_benchmark.hpp"
+
+#include "address.hpp"
+#include "dense_hash_map.hpp"
+#include "flat_hash_map.hpp"
+#include "mpmc_queue.hpp"
+#include "scoped_ptr.hpp"
+#include "small_vector.hpp"
+#include "stream_manager.hpp"
+#include "timer.hpp"
+#include "timer_wheel.hpp"
+
+#include <stdio.h>
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+#define NUM_ADDRESSES 64
+#define SMALL_VECTOR_SIZE 8
+#define QUEUE_SIZE 1024
+#define NUM_KEYSPACES 32
+#define NUM_TIMERS 1024
+
+// Acquire, lookup and release a stream on a connection with half of its
+// streams in flight
+static void StreamManagerHalfFull(micro::State& state) {
+  StreamManager<int> streams;
+  const size_t in_flight = streams.max_streams() / 2;
+  Vector<int> pending(in_flight);
+  for (size_t i = 0; i < in_flight; ++i) {
+    pending[i] = streams.acquire(i);
+  }
+
+  int item = 0;
+  size_t i = 0;
+  while (state.keep_running()) {
+    size_t index = i++ % in_flight;
+    streams.get(pending[index], item);
+    streams.release(pending[index]);
+    pending[index] = streams.acquire(item);
+  }
+  micro::do_not_optimize(item);
+}
+MICRO_BENCHMARK(StreamManagerHalfFull);
+
+static Vector<Address> test_addresses() {
+  Vector<Address> addresses;
+  for (int i = 0; i < NUM_ADDRESSES; ++i) {
+    char host[32];
+    sprintf(host, "10.0.%d.%d", i / 256, i % 256);
+    addresses.push_back(Address(host, 9042));
+  }
+  return addresses;
+}
+
+static Vector<String> test_keyspaces() {
+  Vector<String> keyspaces;
+  for (int i = 0; i < NUM_KEYSPACES; ++i) {
+    char keyspace[32];
+    sprintf(keyspace, "keyspace_%d", i);
+    keyspaces.push_back(keyspace);
+  }
+  return keyspaces;
+}
+
+// Connection pools and hosts are looked up by address
+template <class Map>
+static void FindAddress(micro::State& state, Map& map) {
+  Vector<Address> addresses(test_addresses());
+  for (int i = 0; i < NUM_ADDRESSES; ++i) {
+    map[addresses[i]] = i;
+  }
+
+  size_t i = 0;
+  int sum = 0;
+  while (state.keep_running()) {
+    sum += map.find(addresses[i++ % NUM_ADDRESSES])->second;
+  }
+  micro::do_not_optimize(sum);
+}
+
+static void DenseHashMapFindAddress(micro::State& state) {
+  DenseHashMap<Address, int> map;
+  map.set_empty_key(Address::EMPTY_KEY);
+  FindAddress(state, map);
+}
+MICRO_BENCHMARK(DenseHashMapFindAddress);
+
+static void FlatHashMapFindAddress(micro::State& state) {
+  FlatHashMap<Address, int> map;
+  FindAddress(state, map);
+}
+MICRO_BENCHMARK(FlatHashMapFindAddress);
+
+// Replicas and prepared metadata are looked up by string
+template <class Map>
+static void FindString(micro::State& state, Map& map) {
+  Vector<String> keyspaces(test_keyspaces());
+  for (int i = 0; i < NUM_KEYSPACES; ++i) {
+    map[keyspaces[i]] = i;
+  }
+
+  size_t i = 0;
+  int sum = 0;
+  while (state.keep_running()) {
+    sum += map.find(keyspaces[i++ % NUM_KEYSPACES])->second;
+  }
+  micro::do_not_optimize(sum);
+}
+
+static void DenseHashMapFindString(micro::State& state) {
+  DenseHashMap<String, int> map;
+  map.set_empty_key(String());
+  FindString(state, map);
+}
+MICRO_BENCHMARK(DenseHashMapFindString);
+
+static void FlatHashMapFindString(micro::State& state) {
+  FlatHashMap<String, int> map;
+  FindString(state, map);
+}
+MICRO_BENCHMARK(FlatHashMapFindString);
+
+// Pools are removed and added as hosts go down and come back up
+template <class Map>
+static void EraseInsertAddress(micro::State& state, Map& map) {
+  Vector<Address> addresses(test_addresses());
+  for (int i = 0; i < NUM_ADDRESSES / 2; ++i) {
+    map[addresses[i]] = i;
+  }
+
+  size_t i = 0;
+  while (state.keep_running()) {
+    map.erase(addresses[i % NUM_ADDRESSES]);
+    map[addresses[(i + NUM_ADDRESSES / 2) % NUM_ADDRESSES]] = static_cast<int>(i);
+    i++;
+  }
+  micro::do_not_optimize(map.size());
+}
+
+static void DenseHashMapEraseInsertAddress(micro::State& state) {
+  DenseHashMap<Address, int> map;
+  map.set_empty_key(Address::EMPTY_KEY);
+  map.set_deleted_key(Address::DELETED_KEY);
+  EraseInsertAddress(state, map);
+}
+MICRO_BENCHMARK(DenseHashMapEraseInsertAddress);
+
+static void FlatHashMapEraseInsertAddress(micro::State& state) {
+  FlatHashMap<Address, int> map;
+  EraseInsertAddress(state, map);
+}
+MICRO_BENCHMARK(FlatHashMapEraseInsertAddress);
+
+// Fill a small vector without exceeding its fixed buffer
+static void SmallVectorPushBack(micro::State& state) {
+  while (state.keep_running()) {
+    SmallVector<int, SMALL_VECTOR_SIZE> vec;
+    for (int i = 0; i < SMALL_VECTOR_SIZE; ++i) {
+      vec.push_back(i);
+    }
+    micro::do_not_optimize(vec);
+  }
+  state.set_items_per_iteration(SMALL_VECTOR_SIZE);
+}
+MICRO_BENCHMARK(SmallVectorPushBack);
+
+// The requests are passed to the I/O threads through a queue
+static void MPMCQueueEnqueueDequeue(micro::State& state) {
+  MPMCQueue<int> queue(QUEUE_SIZE);
+  int value = 0;
+  while (state.keep_running()) {
+    queue.enqueue(value);
+    queue.dequeue(value);
+  }
+  micro::do_not_optimize(value);
+}
+MICRO_BENCHMARK(MPMCQueueEnqueueDequeue);
+
+static void on_timer(Timer* timer) {}
+static void on_wheel_timer(WheelTimer* timer) {}
+
+// Every request starts a timeout when it's written and stops it when its
+// response is read, with many other requests in flight
+static void TimerStartStop(micro::State& state) {
+  uv_loop_t loop;
+  uv_loop_init(&loop);
+  {
+    ScopedArray<Timer> timers(new Timer[NUM_TIMERS]);
+    size_t i = 0;
+    while (state.keep_running()) {
+      Timer& timer = timers[i++ % NUM_TIMERS];
+      timer.stop();
+      timer.start(&loop, 12000, bind_callback(on_timer));
+      if (i % NUM_TIMERS == 0) {
+        uv_run(&loop, UV_RUN_NOWAIT); // Free the closed handles
+      }
+    }
+  }
+  uv_run(&loop, UV_RUN_DEFAULT);
+  uv_loop_close(&loop);
+}
+MICRO_BENCHMARK(TimerStartStop);
+
+static void TimerWheelStartStop(micro::State& state) {
+  uv_loop_t loop;
+  uv_loop_init(&loop);
+  {
+    TimerWheel wheel(&loop);
+    ScopedArray<WheelTimer> timers(new WheelTimer[NUM_TIMERS]);
+    size_t i = 0;
+    while (state.keep_running()) {
+      WheelTimer& timer = timers[i++ % NUM_TIMERS];
+      timer.stop();
+      timer.start(&wheel, 12000, bind_callback(on_wheel_timer));
+    }
+    for (size_t j = 0; j < NUM_TIMERS; ++j) {
+      timers[j].stop();
+    }
+    wheel.close();
+  }
+  uv_run(&loop, UV_RUN_DEFAULT);
+  uv_loop_close(&loop);
+}
+MICRO_BENCHMARK(TimerWheelStartStop);
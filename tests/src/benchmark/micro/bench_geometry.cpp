@@ -0,0 +1,81 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "micro_benchmark.hpp"
+
+#include "dse_line_string.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::enterprise;
+
+// A typical polygon ring or road segment
+#define NUM_POINTS 256
+
+namespace {
+
+Vector<cass_double_t> generate_points() {
+  Vector<cass_double_t> points;
+  for (size_t i = 0; i < 2 * NUM_POINTS; ++i) {
+    points.push_back(-122.4194 + 0.000123 * i);
+  }
+  return points;
+}
+
+} // namespace
+
+static void BuildLineString(micro::State& state) {
+  Vector<cass_double_t> points(generate_points());
+  LineString line_string;
+  while (state.keep_running()) {
+    line_string.reset();
+    line_string.reserve(NUM_POINTS);
+    for (size_t i = 0; i < NUM_POINTS; ++i) {
+      line_string.add_point(points[2 * i], points[2 * i + 1]);
+    }
+    micro::do_not_optimize(line_string.finish());
+  }
+  state.set_items_per_iteration(NUM_POINTS);
+}
+MICRO_BENCHMARK(BuildLineString);
+
+static void BuildLineStringBulk(micro::State& state) {
+  Vector<cass_double_t> points(generate_points());
+  LineString line_string;
+  while (state.keep_running()) {
+    line_string.reset();
+    line_string.add_points(points.data(), NUM_POINTS);
+    micro::do_not_optimize(line_string.finish());
+  }
+  state.set_items_per_iteration(NUM_POINTS);
+}
+MICRO_BENCHMARK(BuildLineStringBulk);
+
+static void ParseLineStringWkt(micro::State& state) {
+  Vector<cass_double_t> points(generate_points());
+  LineString line_string;
+  line_string.add_points(points.data(), NUM_POINTS);
+  String wkt(line_string.to_wkt());
+
+  Vector<cass_double_t> result(2 * NUM_POINTS);
+  LineStringIterator iterator;
+  while (state.keep_running()) {
+    iterator.reset_text(wkt.data(), wkt.size());
+    micro::do_not_optimize(iterator.next_points(result.data(), NUM_POINTS));
+  }
+  state.set_bytes_per_iteration(wkt.size());
+}
+MICRO_BENCHMARK(ParseLineStringWkt);
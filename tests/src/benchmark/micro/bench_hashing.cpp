@@ -0,0 +1,89 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "micro_benchmark.hpp"
+
+#include "murmur3.hpp"
+#include "string.hpp"
+#include "uuids.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+#define NUM_BATCH_KEYS 64
+
+static void GenerateTimeUuid(micro::State& state) {
+  UuidGen gen;
+  CassUuid uuid;
+  while (state.keep_running()) {
+    gen.generate_time(&uuid);
+    micro::do_not_optimize(uuid);
+  }
+}
+MICRO_BENCHMARK(GenerateTimeUuid);
+
+static void GenerateRandomUuid(micro::State& state) {
+  UuidGen gen;
+  CassUuid uuid;
+  while (state.keep_running()) {
+    gen.generate_random(&uuid);
+    micro::do_not_optimize(uuid);
+  }
+}
+MICRO_BENCHMARK(GenerateRandomUuid);
+
+static void murmur3(micro::State& state, size_t key_size) {
+  String key(key_size, 'k');
+  while (state.keep_running()) {
+    micro::do_not_optimize(MurmurHash3_x64_128(key.data(), static_cast<int>(key.size()), 0));
+  }
+  state.set_bytes_per_iteration(key_size);
+}
+
+// A bigint partition key
+static void Murmur3Key8(micro::State& state) { murmur3(state, 8); }
+MICRO_BENCHMARK(Murmur3Key8);
+
+// A UUID partition key
+static void Murmur3Key16(micro::State& state) { murmur3(state, 16); }
+MICRO_BENCHMARK(Murmur3Key16);
+
+// A composite or text partition key
+static void Murmur3Key64(micro::State& state) { murmur3(state, 64); }
+MICRO_BENCHMARK(Murmur3Key64);
+
+static void Murmur3Key1024(micro::State& state) { murmur3(state, 1024); }
+MICRO_BENCHMARK(Murmur3Key1024);
+
+// The routing keys of a batch's statements are hashed together
+static void Murmur3Batch(micro::State& state) {
+  String keys[NUM_BATCH_KEYS];
+  const char* data[NUM_BATCH_KEYS];
+  size_t lengths[NUM_BATCH_KEYS];
+  int64_t hashes[NUM_BATCH_KEYS];
+  for (size_t i = 0; i < NUM_BATCH_KEYS; ++i) {
+    keys[i] = String(16, static_cast<char>('a' + i % 26));
+    data[i] = keys[i].data();
+    lengths[i] = keys[i].size();
+  }
+  while (state.keep_running()) {
+    MurmurHash3_x64_128_batch(data, lengths, NUM_BATCH_KEYS, 0, hashes);
+    micro::do_not_optimize(hashes);
+  }
+  state.set_items_per_iteration(NUM_BATCH_KEYS);
+}
+MICRO_BENCHMARK(Murmur3Batch);
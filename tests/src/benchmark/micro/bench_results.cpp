@@ -0,0 +1,272 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "micro_benchmark.hpp"
+
+#include "encode.hpp"
+#include "result_response.hpp"
+#include "serialization.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+// The rows of the results are decoded and every value is read with the public
+// API, which is how an application consumes a result.
+
+#define NUM_ROWS 1000
+#define NUM_WIDE_COLUMNS 20
+#define NUM_ELEMENTS 10
+
+namespace {
+
+class BufferBuilder {
+public:
+  void append_rows_header(int32_t column_count) {
+    append_int32(CASS_RESULT_KIND_ROWS);
+    append_int32(CASS_RESULT_FLAG_GLOBAL_TABLESPEC);
+    append_int32(column_count);
+    append_string("keyspace");
+    append_string("table");
+  }
+
+  void append_int32(int32_t value) {
+    char buf[sizeof(int32_t)];
+    encode_int32(buf, value);
+    data_.append(buf, sizeof(buf));
+  }
+
+  void append_int64(int64_t value) {
+    char buf[sizeof(int64_t)];
+    encode_int64(buf, value);
+    data_.append(buf, sizeof(buf));
+  }
+
+  void append_uint16(uint16_t value) {
+    char buf[sizeof(uint16_t)];
+    encode_uint16(buf, value);
+    data_.append(buf, sizeof(buf));
+  }
+
+  void append_string(const String& value) {
+    append_uint16(value.size());
+    data_.append(value);
+  }
+
+  void append_bytes(const String& value) {
+    append_int32(value.size());
+    data_.append(value);
+  }
+
+  const String& data() const { return data_; }
+
+private:
+  String data_;
+};
+
+String column_name(size_t index) {
+  OStringStream ss;
+  ss << "c" << index;
+  return ss.str();
+}
+
+// Columns: key int, then alternating bigint and 32 character varchar values
+String wide_rows() {
+  BufferBuilder builder;
+  builder.append_rows_header(NUM_WIDE_COLUMNS);
+  for (size_t i = 0; i < NUM_WIDE_COLUMNS; ++i) {
+    builder.append_string(column_name(i));
+    if (i == 0) {
+      builder.append_uint16(CASS_VALUE_TYPE_INT);
+    } else {
+      builder.append_uint16(i % 2 == 1 ? CASS_VALUE_TYPE_BIGINT : CASS_VALUE_TYPE_VARCHAR);
+    }
+  }
+  builder.append_int32(NUM_ROWS);
+  for (int32_t row = 0; row < NUM_ROWS; ++row) {
+    builder.append_int32(sizeof(int32_t));
+    builder.append_int32(row);
+    for (size_t i = 1; i < NUM_WIDE_COLUMNS; ++i) {
+      if (i % 2 == 1) {
+        builder.append_int32(sizeof(int64_t));
+        builder.append_int64(row * 1000LL + i);
+      } else {
+        builder.append_bytes("abcdefghijklmnopqrstuvwxyz012345");
+      }
+    }
+  }
+  return builder.data();
+}
+
+// Columns: key int, list<int> and map<varchar, bigint>
+String collection_rows() {
+  BufferBuilder builder;
+  builder.append_rows_header(3);
+  builder.append_string("key");
+  builder.append_uint16(CASS_VALUE_TYPE_INT);
+  builder.append_string("list");
+  builder.append_uint16(CASS_VALUE_TYPE_LIST);
+  builder.append_uint16(CASS_VALUE_TYPE_INT);
+  builder.append_string("map");
+  builder.append_uint16(CASS_VALUE_TYPE_MAP);
+  builder.append_uint16(CASS_VALUE_TYPE_VARCHAR);
+  builder.append_uint16(CASS_VALUE_TYPE_BIGINT);
+
+  BufferBuilder list;
+  list.append_int32(NUM_ELEMENTS);
+  BufferBuilder map;
+  map.append_int32(NUM_ELEMENTS);
+  for (int32_t i = 0; i < NUM_ELEMENTS; ++i) {
+    list.append_int32(sizeof(int32_t));
+    list.append_int32(i);
+    map.append_bytes(column_name(i));
+    map.append_int32(sizeof(int64_t));
+    map.append_int64(i);
+  }
+
+  builder.append_int32(NUM_ROWS);
+  for (int32_t row = 0; row < NUM_ROWS; ++row) {
+    builder.append_int32(sizeof(int32_t));
+    builder.append_int32(row);
+    builder.append_bytes(list.data());
+    builder.append_bytes(map.data());
+  }
+  return builder.data();
+}
+
+// Columns: key int and a duration with multibyte months, days and nanoseconds
+String duration_rows() {
+  BufferBuilder builder;
+  builder.append_rows_header(2);
+  builder.append_string("key");
+  builder.append_uint16(CASS_VALUE_TYPE_INT);
+  builder.append_string("duration");
+  builder.append_uint16(CASS_VALUE_TYPE_DURATION);
+
+  builder.append_int32(NUM_ROWS);
+  for (int32_t row = 0; row < NUM_ROWS; ++row) {
+    builder.append_int32(sizeof(int32_t));
+    builder.append_int32(row);
+    Buffer buf(encode(CassDuration(row, -row, row * 1000000007LL)));
+    builder.append_bytes(String(buf.data(), buf.size()));
+  }
+  return builder.data();
+}
+
+void read_value(const CassValue* value, int64_t* sum) {
+  switch (cass_value_type(value)) {
+    case CASS_VALUE_TYPE_INT: {
+      cass_int32_t i;
+      cass_value_get_int32(value, &i);
+      *sum += i;
+    } break;
+    case CASS_VALUE_TYPE_BIGINT: {
+      cass_int64_t i;
+      cass_value_get_int64(value, &i);
+      *sum += i;
+    } break;
+    case CASS_VALUE_TYPE_VARCHAR: {
+      const char* s;
+      size_t length;
+      cass_value_get_string(value, &s, &length);
+      *sum += length;
+    } break;
+    case CASS_VALUE_TYPE_DURATION: {
+      cass_int32_t months, days;
+      cass_int64_t nanos;
+      cass_value_get_duration(value, &months, &days, &nanos);
+      *sum += months + days + nanos;
+    } break;
+    case CASS_VALUE_TYPE_LIST: {
+      CassIterator* iterator = cass_iterator_from_collection(value);
+      while (cass_iterator_next(iterator)) {
+        read_value(cass_iterator_get_value(iterator), sum);
+      }
+      cass_iterator_free(iterator);
+    } break;
+    case CASS_VALUE_TYPE_MAP: {
+      CassIterator* iterator = cass_iterator_from_map(value);
+      while (cass_iterator_next(iterator)) {
+        read_value(cass_iterator_get_map_key(iterator), sum);
+        read_value(cass_iterator_get_map_value(iterator), sum);
+      }
+      cass_iterator_free(iterator);
+    } break;
+    default:
+      break;
+  }
+}
+
+void decode(micro::State& state, const String& data) {
+  while (state.keep_running()) {
+    ResultResponse result;
+    Decoder decoder(data.data(), data.size(), ProtocolVersion(CASS_PROTOCOL_VERSION_V4));
+    result.decode(decoder);
+
+    int64_t sum = 0;
+    CassIterator* rows = cass_iterator_from_result(CassResult::to(&result));
+    while (cass_iterator_next(rows)) {
+      CassIterator* columns = cass_iterator_from_row(cass_iterator_get_row(rows));
+      while (cass_iterator_next(columns)) {
+        read_value(cass_iterator_get_column(columns), &sum);
+      }
+      cass_iterator_free(columns);
+    }
+    cass_iterator_free(rows);
+    micro::do_not_optimize(sum);
+  }
+  state.set_items_per_iteration(NUM_ROWS);
+  state.set_bytes_per_iteration(data.size());
+}
+
+} // namespace
+
+static void DecodeWideRows(micro::State& state) { decode(state, wide_rows()); }
+MICRO_BENCHMARK(DecodeWideRows);
+
+static void DecodeCollections(micro::State& state) { decode(state, collection_rows()); }
+MICRO_BENCHMARK(DecodeCollections);
+
+static void DecodeDurations(micro::State& state) { decode(state, duration_rows()); }
+MICRO_BENCHMARK(DecodeDurations);
+
+// The durations are decoded a column at a time
+static void DecodeDurationColumn(micro::State& state) {
+  String data(duration_rows());
+  Vector<cass_int32_t> months(NUM_ROWS), days(NUM_ROWS);
+  Vector<cass_int64_t> nanos(NUM_ROWS);
+  while (state.keep_running()) {
+    ResultResponse result;
+    Decoder decoder(data.data(), data.size(), ProtocolVersion(CASS_PROTOCOL_VERSION_V4));
+    result.decode(decoder);
+    micro::do_not_optimize(cass_result_column_get_duration(
+        CassResult::to(&result), 1, &months[0], &days[0], &nanos[0], NULL, NUM_ROWS));
+  }
+  state.set_items_per_iteration(NUM_ROWS);
+  state.set_bytes_per_iteration(data.size());
+}
+MICRO_BENCHMARK(DecodeDurationColumn);
+
+// Only the metadata and the first row are decoded by the result response
+static void DecodeResultMetadata(micro::State& state) {
+  String data(wide_rows());
+  while (state.keep_running()) {
+    ResultResponse result;
+    Decoder decoder(data.data(), data.size(), ProtocolVersion(CASS_PROTOCOL_VERSION_V4));
+    micro::do_not_optimize(result.decode(decoder));
+  }
+}
+MICRO_BENCHMARK(DecodeResultMetadata);
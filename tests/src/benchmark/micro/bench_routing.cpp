@@ -0,0 +1,151 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "micro_benchmark.hpp"
+
+#include "dc_aware_policy.hpp"
+#include "query_request.hpp"
+#include "request_handler.hpp"
+#include "round_robin_policy.hpp"
+#include "scoped_ptr.hpp"
+#include "token_aware_policy.hpp"
+
+#include "test_token_map_utils.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+// Two datacenters of 6 nodes with 256 vnodes each
+#define NUM_HOSTS_PER_DC 6
+#define NUM_VNODES 256
+#define NUM_KEYS 1024
+
+namespace {
+
+class Cluster {
+public:
+  Cluster()
+      : token_map(TokenMap::from_partitioner(Murmur3Partitioner::name())) {
+    MT19937_64 rng;
+    for (size_t i = 0; i < 2 * NUM_HOSTS_PER_DC; ++i) {
+      OStringStream ss;
+      ss << "127.0.0." << (i + 1);
+      Host::Ptr host(create_host(ss.str(), random_murmur3_tokens(rng, NUM_VNODES),
+                                 Murmur3Partitioner::name().to_string(), "rack",
+                                 i < NUM_HOSTS_PER_DC ? "dc1" : "dc2"));
+      hosts[host->address()] = host;
+      token_map->add_host(host);
+    }
+
+    add_keyspace_simple("simple", 3, token_map.get());
+    ReplicationMap replication;
+    replication["dc1"] = "3";
+    replication["dc2"] = "3";
+    add_keyspace_network_topology("network_topology", replication, token_map.get());
+    token_map->build();
+
+    for (size_t i = 0; i < NUM_KEYS; ++i) {
+      String key(sizeof(int64_t), 0);
+      encode_int64(&key[0], static_cast<int64_t>(rng()));
+      keys.push_back(key);
+    }
+  }
+
+  HostMap hosts;
+  TokenMap::Ptr token_map;
+  Vector<String> keys;
+};
+
+void get_replicas(micro::State& state, const String& keyspace_name) {
+  Cluster cluster;
+  size_t i = 0;
+  while (state.keep_running()) {
+    const CopyOnWriteHostVec& replicas =
+        cluster.token_map->get_replicas(keyspace_name, cluster.keys[i++ % NUM_KEYS]);
+    micro::do_not_optimize(replicas);
+  }
+}
+
+// Create a query plan and iterate over all of its hosts
+void query_plan(micro::State& state, LoadBalancingPolicy* policy, bool use_routing_key) {
+  Cluster cluster;
+  policy->init(Host::Ptr(), cluster.hosts, NULL, "dc1", "");
+
+  Vector<SharedRefPtr<RequestHandler> > request_handlers;
+  for (size_t i = 0; i < NUM_KEYS; ++i) {
+    QueryRequest::Ptr request(new QueryRequest("", 1));
+    if (use_routing_key) {
+      request->set(0, cass_int64_t(i));
+      request->add_key_index(0);
+    }
+    request_handlers.push_back(
+        SharedRefPtr<RequestHandler>(new RequestHandler(request, ResponseFuture::Ptr())));
+  }
+
+  size_t i = 0;
+  size_t count = 0;
+  while (state.keep_running()) {
+    ScopedPtr<QueryPlan> plan(policy->new_query_plan(
+        "network_topology", request_handlers[i++ % NUM_KEYS].get(), cluster.token_map.get()));
+    while (plan->compute_next()) {
+      ++count;
+    }
+  }
+  micro::do_not_optimize(count);
+  state.set_items_per_iteration(cluster.hosts.size());
+}
+
+} // namespace
+
+static void TokenMapSimpleStrategyReplicas(micro::State& state) {
+  get_replicas(state, "simple");
+}
+MICRO_BENCHMARK(TokenMapSimpleStrategyReplicas);
+
+static void TokenMapNetworkTopologyReplicas(micro::State& state) {
+  get_replicas(state, "network_topology");
+}
+MICRO_BENCHMARK(TokenMapNetworkTopologyReplicas);
+
+// The replicas are calculated when the token map is built
+static void TokenMapBuild(micro::State& state) {
+  Cluster cluster;
+  while (state.keep_running()) {
+    TokenMap::Ptr token_map(cluster.token_map->copy());
+    token_map->build();
+    micro::do_not_optimize(token_map);
+  }
+}
+MICRO_BENCHMARK(TokenMapBuild);
+
+static void QueryPlanRoundRobin(micro::State& state) {
+  RoundRobinPolicy policy;
+  query_plan(state, &policy, false);
+}
+MICRO_BENCHMARK(QueryPlanRoundRobin);
+
+static void QueryPlanDCAware(micro::State& state) {
+  DCAwarePolicy policy("dc1", NUM_HOSTS_PER_DC, false);
+  query_plan(state, &policy, false);
+}
+MICRO_BENCHMARK(QueryPlanDCAware);
+
+static void QueryPlanTokenAware(micro::State& state) {
+  TokenAwarePolicy policy(new DCAwarePolicy("dc1", NUM_HOSTS_PER_DC, false), false);
+  query_plan(state, &policy, true);
+}
+MICRO_BENCHMARK(QueryPlanTokenAware);
@@ -0,0 +1,165 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "micro_benchmark.hpp"
+
+#include "batch_request.hpp"
+#include "execute_request.hpp"
+#include "prepared.hpp"
+#include "query_request.hpp"
+#include "request_callback.hpp"
+#include "result_response.hpp"
+#include "serialization.hpp"
+
+#include <string.h>
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+// The number of bound values of the statements
+#define NUM_VALUES 8
+
+#define BATCH_SIZE 32
+
+namespace {
+
+class Callback : public SimpleRequestCallback {
+public:
+  Callback(const Request::ConstPtr& request)
+      : SimpleRequestCallback(request) {}
+
+  virtual void on_internal_set(ResponseMessage* response) {}
+  virtual void on_internal_error(CassError code, const String& message) {}
+  virtual void on_internal_timeout() {}
+};
+
+// Columns: key int, then alternating bigint and 32 character varchar values
+CassValueType column_type(size_t index) {
+  if (index == 0) return CASS_VALUE_TYPE_INT;
+  return index % 2 == 1 ? CASS_VALUE_TYPE_BIGINT : CASS_VALUE_TYPE_VARCHAR;
+}
+
+void bind_values(Statement* statement) {
+  statement->set(0, cass_int32_t(42));
+  for (size_t i = 1; i < NUM_VALUES; ++i) {
+    if (i % 2 == 1) {
+      statement->set(i, cass_int64_t(1234567890LL * i));
+    } else {
+      statement->set(i, CassString("abcdefghijklmnopqrstuvwxyz012345", 32));
+    }
+  }
+}
+
+Prepared::ConstPtr prepare() {
+  String data;
+  char buf[sizeof(int32_t)];
+  encode_int32(buf, CASS_RESULT_KIND_PREPARED);
+  data.append(buf, sizeof(int32_t));
+  encode_uint16(buf, 16);
+  data.append(buf, sizeof(uint16_t));
+  data.append("0123456789abcdef"); // Prepared ID
+  encode_int32(buf, CASS_RESULT_FLAG_GLOBAL_TABLESPEC);
+  data.append(buf, sizeof(int32_t));
+  encode_int32(buf, NUM_VALUES); // Column count
+  data.append(buf, sizeof(int32_t));
+  encode_int32(buf, 1); // Partition key count
+  data.append(buf, sizeof(int32_t));
+  encode_uint16(buf, 0); // Partition key index
+  data.append(buf, sizeof(uint16_t));
+  const char* names[] = { "keyspace", "table" };
+  for (size_t i = 0; i < 2; ++i) {
+    encode_uint16(buf, static_cast<uint16_t>(strlen(names[i])));
+    data.append(buf, sizeof(uint16_t));
+    data.append(names[i]);
+  }
+  for (size_t i = 0; i < NUM_VALUES; ++i) {
+    char name[] = { 'c', static_cast<char>('0' + i) };
+    encode_uint16(buf, sizeof(name));
+    data.append(buf, sizeof(uint16_t));
+    data.append(name, sizeof(name));
+    encode_uint16(buf, column_type(i));
+    data.append(buf, sizeof(uint16_t));
+  }
+  encode_int32(buf, CASS_RESULT_FLAG_NO_METADATA); // Result metadata
+  data.append(buf, sizeof(int32_t));
+  encode_int32(buf, 0);
+  data.append(buf, sizeof(int32_t));
+
+  ResultResponse::Ptr result(new ResultResponse());
+  Decoder decoder(data.data(), data.size(), ProtocolVersion(CASS_PROTOCOL_VERSION_V4));
+  result->decode(decoder);
+
+  Metadata::SchemaSnapshot schema(0, VersionNumber(),
+                                  KeyspaceMetadata::MapPtr(new KeyspaceMetadata::Map()));
+  return Prepared::ConstPtr(
+      new Prepared(result, PrepareRequest::ConstPtr(new PrepareRequest("query")), schema));
+}
+
+void encode(micro::State& state, const Request::ConstPtr& request) {
+  SharedRefPtr<Callback> callback(new Callback(request));
+  ProtocolVersion version(CASS_PROTOCOL_VERSION_V4);
+  int32_t length = 0;
+  while (state.keep_running()) {
+    BufferVec bufs;
+    length = request->encode(version, callback.get(), &bufs);
+    micro::do_not_optimize(bufs);
+  }
+  state.set_bytes_per_iteration(length);
+}
+
+} // namespace
+
+static void EncodeQuery(micro::State& state) {
+  SharedRefPtr<QueryRequest> request(
+      new QueryRequest("INSERT INTO keyspace.table (c0, c1, c2, c3, c4, c5, c6, c7) "
+                       "VALUES (?, ?, ?, ?, ?, ?, ?, ?)",
+                       NUM_VALUES));
+  bind_values(request.get());
+  encode(state, request);
+}
+MICRO_BENCHMARK(EncodeQuery);
+
+static void EncodeExecute(micro::State& state) {
+  SharedRefPtr<ExecuteRequest> request(new ExecuteRequest(prepare().get()));
+  bind_values(request.get());
+  encode(state, request);
+}
+MICRO_BENCHMARK(EncodeExecute);
+
+static void EncodeBatch(micro::State& state) {
+  Prepared::ConstPtr prepared(prepare());
+  SharedRefPtr<BatchRequest> request(new BatchRequest(CASS_BATCH_TYPE_UNLOGGED));
+  for (size_t i = 0; i < BATCH_SIZE; ++i) {
+    SharedRefPtr<ExecuteRequest> statement(new ExecuteRequest(prepared.get()));
+    bind_values(statement.get());
+    request->add_statement(statement.get());
+  }
+  encode(state, request);
+  state.set_items_per_iteration(BATCH_SIZE);
+}
+MICRO_BENCHMARK(EncodeBatch);
+
+// Binding is the application's side of encoding a statement
+static void BindExecute(micro::State& state) {
+  Prepared::ConstPtr prepared(prepare());
+  while (state.keep_running()) {
+    SharedRefPtr<ExecuteRequest> request(new ExecuteRequest(prepared.get()));
+    bind_values(request.get());
+    micro::do_not_optimize(request);
+  }
+}
+MICRO_BENCHMARK(BindExecute);
@@ -0,0 +1,145 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "micro_benchmark.hpp"
+
+#include "cassandra.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+// Stop increasing the iterations at this many, even if the minimum time
+// hasn't been reached
+#define MAX_ITERATIONS 1000000000ULL
+
+using namespace micro;
+
+struct Benchmark {
+  Benchmark(const char* name, Function function)
+      : name(name)
+      , function(function) {}
+  const char* name;
+  Function function;
+};
+
+// A function-local static so the benchmarks can be registered during static
+// initialization in any translation unit
+static std::vector<Benchmark>& benchmarks() {
+  static std::vector<Benchmark> benchmarks;
+  return benchmarks;
+}
+
+Registrar::Registrar(const char* name, Function function) {
+  benchmarks().push_back(Benchmark(name, function));
+}
+
+static void print_rate(double per_second, const char* unit) {
+  if (per_second >= 1e9) {
+    printf(" %10.2f G%s/s", per_second / 1e9, unit);
+  } else if (per_second >= 1e6) {
+    printf(" %10.2f M%s/s", per_second / 1e6, unit);
+  } else if (per_second >= 1e3) {
+    printf(" %10.2f k%s/s", per_second / 1e3, unit);
+  } else {
+    printf(" %10.2f  %s/s", per_second, unit);
+  }
+}
+
+static void run(const Benchmark& benchmark, double min_time_s) {
+  uint64_t min_time_ns = static_cast<uint64_t>(min_time_s * 1e9);
+  uint64_t iterations = 1;
+  while (true) {
+    State state(iterations);
+    benchmark.function(state);
+    uint64_t elapsed_ns = state.elapsed_ns();
+
+    if (elapsed_ns >= min_time_ns || iterations >= MAX_ITERATIONS) {
+      double ns_per_iteration = static_cast<double>(elapsed_ns) / iterations;
+      printf("%-40s %12llu %12.1f ns", benchmark.name, static_cast<unsigned long long>(iterations),
+             ns_per_iteration);
+      if (state.items_per_iteration() > 0) {
+        print_rate(state.items_per_iteration() * 1e9 / ns_per_iteration, "items");
+      }
+      if (state.bytes_per_iteration() > 0) {
+        print_rate(state.bytes_per_iteration() * 1e9 / ns_per_iteration, "B");
+      }
+      printf("\n");
+      fflush(stdout);
+      return;
+    }
+
+    // Aim past the minimum time using the measured rate, but grow by at most
+    // 10x per run because the first runs are noisy
+    uint64_t next = iterations * 10;
+    if (elapsed_ns > 0) {
+      uint64_t estimate = static_cast<uint64_t>(1.4 * min_time_ns * iterations / elapsed_ns);
+      if (estimate < next) next = estimate;
+    }
+    iterations = next > iterations ? next : iterations + 1;
+    if (iterations > MAX_ITERATIONS) iterations = MAX_ITERATIONS;
+  }
+}
+
+static void print_usage(const char* program) {
+  fprintf(stderr,
+          "Usage: %s [--filter <substring>] [--min-time <seconds>] [--list]\n"
+          "\n"
+          "  --filter <substring>   Only run the benchmarks with names containing the substring\n"
+          "  --min-time <seconds>   Minimum time of each benchmark's timed run (default: 0.5)\n"
+          "  --list                 List the benchmarks\n",
+          program);
+}
+
+int main(int argc, char* argv[]) {
+  const char* filter = NULL;
+  double min_time_s = 0.5;
+  bool list = false;
+
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+      filter = argv[++i];
+    } else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+      min_time_s = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--list") == 0) {
+      list = true;
+    } else {
+      print_usage(argv[0]);
+      return 1;
+    }
+  }
+
+  // Some of the benchmarks' setup logs warnings (e.g. hosts without an RPC
+  // address)
+  cass_log_set_level(CASS_LOG_DISABLED);
+
+  if (!list) {
+    printf("%-40s %12s %15s\n", "Benchmark", "Iterations", "Time");
+  }
+  for (std::vector<Benchmark>::const_iterator it = benchmarks().begin(),
+                                              end = benchmarks().end();
+       it != end; ++it) {
+    if (filter && strstr(it->name, filter) == NULL) continue;
+    if (list) {
+      printf("%s\n", it->name);
+    } else {
+      run(*it, min_time_s);
+    }
+  }
+
+  return 0;
+}
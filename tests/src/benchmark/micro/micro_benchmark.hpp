@@ -0,0 +1,113 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_MICRO_BENCHMARK_HPP
+#define DATASTAX_MICRO_BENCHMARK_HPP
+
+#include "get_time.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * A minimal microbenchmark harness in the style of Google Benchmark. A
+ * benchmark is a function that sets up its data and then runs the code being
+ * measured in a `while (state.keep_running())` loop. Only the loop is timed.
+ * The runner increases the number of iterations until the loop runs for at
+ * least the minimum time and reports the time per iteration.
+ *
+ * static void EncodeSomething(micro::State& state) {
+ *   Something something;
+ *   while (state.keep_running()) {
+ *     micro::do_not_optimize(something.encode());
+ *   }
+ * }
+ * MICRO_BENCHMARK(EncodeSomething);
+ */
+
+namespace micro {
+
+class State {
+public:
+  State(uint64_t iterations)
+      : iterations_(iterations)
+      , remaining_(iterations)
+      , start_ns_(0)
+      , elapsed_ns_(0)
+      , items_per_iteration_(0)
+      , bytes_per_iteration_(0) {}
+
+  bool keep_running() {
+    if (remaining_ == iterations_) {
+      start_ns_ = datastax::internal::get_time_monotonic_ns();
+    }
+    if (remaining_ == 0) {
+      elapsed_ns_ = datastax::internal::get_time_monotonic_ns() - start_ns_;
+      return false;
+    }
+    --remaining_;
+    return true;
+  }
+
+  uint64_t iterations() const { return iterations_; }
+  uint64_t elapsed_ns() const { return elapsed_ns_; }
+
+  /**
+   * Report a rate of items (e.g. rows or hosts) per second.
+   */
+  void set_items_per_iteration(uint64_t items) { items_per_iteration_ = items; }
+  uint64_t items_per_iteration() const { return items_per_iteration_; }
+
+  /**
+   * Report a rate of bytes per second.
+   */
+  void set_bytes_per_iteration(uint64_t bytes) { bytes_per_iteration_ = bytes; }
+  uint64_t bytes_per_iteration() const { return bytes_per_iteration_; }
+
+private:
+  const uint64_t iterations_;
+  uint64_t remaining_;
+  uint64_t start_ns_;
+  uint64_t elapsed_ns_;
+  uint64_t items_per_iteration_;
+  uint64_t bytes_per_iteration_;
+};
+
+typedef void (*Function)(State& state);
+
+struct Registrar {
+  Registrar(const char* name, Function function);
+};
+
+/**
+ * Keep the compiler from optimizing away the computation of a value.
+ */
+template <class T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &value;
+#endif
+}
+
+} // namespace micro
+
+#define MICRO_BENCHMARK(function) \
+  static micro::Registrar micro_benchmark_registrar_##function(#function, function)
+
+#endif
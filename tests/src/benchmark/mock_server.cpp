@@ -0,0 +1,201 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+/*
+ * A standalone mockssandra cluster for benchmarking the driver without a real
+ * cluster. It simulates N nodes, spread over a number of event loop threads,
+ * that answer the benchmark's queries (see cassandra-benchmark) with injected
+ * latencies, timeouts, OVERLOADED errors and slow reads. The faults can be set
+ * for all nodes and then overridden for each node, e.g. to make a single node
+ * slow to exercise the load balancing and speculative execution policies.
+ */
+
+#include "mock_workload.hpp"
+#include "mockssandra.hpp"
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+using benchmark::Faults;
+using benchmark::LatencyDistribution;
+using benchmark::NodeFaults;
+using datastax::String;
+using datastax::internal::Vector;
+
+static volatile sig_atomic_t is_stopped = 0;
+
+static void on_signal(int signal) { is_stopped = 1; }
+
+static void sleep_ms(unsigned ms) {
+#ifdef _WIN32
+  Sleep(ms);
+#else
+  usleep(ms * 1000);
+#endif
+}
+
+static void print_usage(const char* program) {
+  fprintf(stderr,
+          "Usage: %s [options]\n"
+          "\n"
+          "  --nodes <n>                   Number of nodes, listening on 127.0.0.1 to "
+          "127.0.0.<n> (default: 3)\n"
+          "  --threads <n>                 Number of event loop threads (default: 1)\n"
+          "  --rows-per-partition <n>      Number of rows returned by reads (default: 1)\n"
+          "  --value-size <bytes>          Size of the returned values (default: 64)\n"
+          "\n"
+          "Faults of all nodes (use --node-<option> <node>=<value> to set a node's, e.g.\n"
+          "--node-latency 2=fixed:50):\n"
+          "\n"
+          "  --latency <distribution>      Response latency: fixed:<ms>, uniform:<min>:<max>,\n"
+          "                                exponential:<mean> or lognormal:<median>:<sigma> "
+          "(default: fixed:0)\n"
+          "  --timeout-ratio <ratio>       Ratio of requests that are never answered\n"
+          "  --overloaded-ratio <ratio>    Ratio of requests that fail with OVERLOADED\n"
+          "  --slow-read-ratio <ratio>     Ratio of reads that are slow\n"
+          "  --slow-read-latency <ms>      Additional latency of slow reads (default: 1000)\n",
+          program);
+}
+
+static bool parse_ratio(const char* value, double* ratio) {
+  char* end;
+  *ratio = strtod(value, &end);
+  return *value != '\0' && *end == '\0' && *ratio >= 0.0 && *ratio <= 1.0;
+}
+
+static bool parse_unsigned(const char* value, unsigned* result) {
+  char* end;
+  unsigned long parsed = strtoul(value, &end, 10);
+  *result = static_cast<unsigned>(parsed);
+  return *value != '\0' && *end == '\0';
+}
+
+/**
+ * Set one of the faults.
+ *
+ * @param name The option without the leading "--" or "--node-".
+ * @param value The option's value.
+ * @param faults The faults that are updated.
+ * @return false if the option isn't a fault or the value is invalid.
+ */
+static bool set_fault(const String& name, const char* value, NodeFaults* faults) {
+  if (name == "latency") {
+    return LatencyDistribution::parse(value, &faults->latency);
+  } else if (name == "timeout-ratio") {
+    return parse_ratio(value, &faults->timeout_ratio);
+  } else if (name == "overloaded-ratio") {
+    return parse_ratio(value, &faults->overloaded_ratio);
+  } else if (name == "slow-read-ratio") {
+    return parse_ratio(value, &faults->slow_read_ratio);
+  } else if (name == "slow-read-latency") {
+    unsigned latency_ms;
+    if (!parse_unsigned(value, &latency_ms)) return false;
+    faults->slow_read_latency_ms = latency_ms;
+    return true;
+  }
+  return false;
+}
+
+int main(int argc, char* argv[]) {
+  unsigned num_nodes = 3;
+  unsigned num_threads = 1;
+  unsigned rows_per_partition = 1;
+  unsigned value_size = 64;
+  NodeFaults default_faults;
+  default_faults.slow_read_latency_ms = 1000;
+  // The node specific faults are applied after the faults of all nodes
+  Vector<std::pair<String, String> > node_options;
+
+  for (int i = 1; i < argc; ++i) {
+    String arg(argv[i]);
+    if (arg.compare(0, 2, "--") != 0 || i + 1 >= argc) {
+      print_usage(argv[0]);
+      return 1;
+    }
+    const char* value = argv[++i];
+    bool is_valid = true;
+    if (arg == "--nodes") {
+      is_valid = parse_unsigned(value, &num_nodes) && num_nodes > 0 && num_nodes < 255;
+    } else if (arg == "--threads") {
+      is_valid = parse_unsigned(value, &num_threads) && num_threads > 0;
+    } else if (arg == "--rows-per-partition") {
+      is_valid = parse_unsigned(value, &rows_per_partition);
+    } else if (arg == "--value-size") {
+      is_valid = parse_unsigned(value, &value_size);
+    } else if (arg.compare(0, 7, "--node-") == 0) {
+      node_options.push_back(std::make_pair(arg.substr(7), String(value)));
+    } else {
+      is_valid = set_fault(arg.substr(2), value, &default_faults);
+    }
+    if (!is_valid) {
+      fprintf(stderr, "Invalid option or value '%s %s'\n", arg.c_str(), value);
+      print_usage(argv[0]);
+      return 1;
+    }
+  }
+
+  Vector<NodeFaults> node_faults(num_nodes, default_faults);
+  for (size_t i = 0; i < node_options.size(); ++i) {
+    const String& name = node_options[i].first;
+    const String& option = node_options[i].second;
+    size_t pos = option.find('=');
+    unsigned node = 0;
+    if (pos == String::npos || !parse_unsigned(option.substr(0, pos).c_str(), &node) ||
+        node < 1 || node > num_nodes ||
+        !set_fault(name, option.c_str() + pos + 1, &node_faults[node - 1])) {
+      fprintf(stderr, "Invalid option or value '--node-%s %s'\n", name.c_str(), option.c_str());
+      print_usage(argv[0]);
+      return 1;
+    }
+  }
+
+  Faults faults;
+  mockssandra::SimpleCluster cluster(
+      benchmark::build_workload_handler(rows_per_partition, value_size, &faults), num_nodes, 0,
+      num_threads);
+  mockssandra::Hosts hosts(cluster.hosts());
+  for (size_t i = 0; i < hosts.size(); ++i) {
+    faults.set(hosts[i].address, node_faults[i]);
+  }
+
+  if (cluster.start_all() != 0) {
+    fprintf(stderr, "Unable to start the cluster\n");
+    return 1;
+  }
+
+  printf("Started %u node(s) on %u thread(s): ", num_nodes, num_threads);
+  for (size_t i = 0; i < hosts.size(); ++i) {
+    printf("%s%s", i > 0 ? ", " : "", hosts[i].address.to_string(true).c_str());
+  }
+  printf("\nPress Ctrl+C to stop\n");
+  fflush(stdout);
+
+  signal(SIGINT, on_signal);
+  signal(SIGTERM, on_signal);
+  while (!is_stopped) {
+    sleep_ms(100);
+  }
+
+  printf("Stopping\n");
+  return 0;
+}
@@ -0,0 +1,249 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "mock_workload.hpp"
+
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define PI 3.14159265358979323846
+
+using namespace benchmark;
+using namespace mockssandra;
+
+static bool is_read(const String& query) { return query.compare(0, 6, "SELECT") == 0; }
+
+static void encode_int16(int16_t value, String* output) {
+  output->push_back(static_cast<char>(value >> 8));
+  output->push_back(static_cast<char>(value & 0xFF));
+}
+
+static void encode_bytes(const String& value, String* output) {
+  encode_int32(static_cast<int32_t>(value.size()), output);
+  output->append(value);
+}
+
+static void encode_column(const String& name, int16_t type, String* output) {
+  encode_string(name, output);
+  encode_int16(type, output);
+}
+
+static String prepared_result(const String& query) {
+  String body;
+  encode_int32(RESULT_PREPARED, &body);
+  encode_string(query, &body); // Prepared ID
+  // Bind variables
+  encode_int32(RESULT_FLAG_GLOBAL_TABLESPEC, &body);
+  encode_int32(is_read(query) ? 1 : 3, &body); // Column count
+  encode_int32(1, &body);                      // Partition key count
+  encode_int16(0, &body);                      // Partition key index
+  encode_string(KEYSPACE, &body);
+  encode_string(TABLE, &body);
+  encode_column("pk", TYPE_BIGINT, &body);
+  if (!is_read(query)) {
+    encode_column("ck", TYPE_INT, &body);
+    encode_column("value", TYPE_BLOG, &body);
+  }
+  // Result metadata
+  if (is_read(query)) {
+    encode_int32(RESULT_FLAG_GLOBAL_TABLESPEC, &body);
+    encode_int32(2, &body); // Column count
+    encode_string(KEYSPACE, &body);
+    encode_string(TABLE, &body);
+    encode_column("ck", TYPE_INT, &body);
+    encode_column("value", TYPE_BLOG, &body);
+  } else {
+    encode_int32(RESULT_FLAG_NO_METADATA, &body);
+    encode_int32(0, &body); // Column count
+  }
+  return body;
+}
+
+void WorkloadQueries::on_run(Request* request) const {
+  String query;
+  QueryParameters params;
+  bool is_decoded = false;
+  switch (request->opcode()) {
+    case OPCODE_QUERY:
+      is_decoded = request->decode_query(&query, &params);
+      break;
+    case OPCODE_EXECUTE:
+      is_decoded = request->decode_execute(&query, &params);
+      break;
+    case OPCODE_PREPARE: {
+      PrepareParameters prepare_params;
+      if (request->decode_prepare(&query, &prepare_params)) {
+        request->write(OPCODE_RESULT, prepared_result(query));
+        return;
+      }
+    } break;
+    default:
+      break;
+  }
+
+  if (!is_decoded) {
+    request->error(ERROR_PROTOCOL_ERROR, "Invalid message");
+  } else if (is_read(query)) {
+    request->write(OPCODE_RESULT, rows_result(params));
+  } else {
+    String body;
+    encode_int32(RESULT_VOID, &body);
+    request->write(OPCODE_RESULT, body);
+  }
+}
+
+String WorkloadQueries::rows_result(const QueryParameters& params) const {
+  // The paging state is the index of the page's first row
+  unsigned first = params.paging_state.empty() ? 0 : atoi(params.paging_state.c_str());
+  unsigned count = rows_per_partition_ - std::min(first, rows_per_partition_);
+  if (params.result_page_size > 0) {
+    count = std::min(count, static_cast<unsigned>(params.result_page_size));
+  }
+  bool has_more_pages = first + count < rows_per_partition_;
+
+  String body;
+  encode_int32(RESULT_ROWS, &body);
+  int32_t flags = RESULT_FLAG_GLOBAL_TABLESPEC;
+  if (has_more_pages) flags |= RESULT_FLAG_HAS_MORE_PAGES;
+  encode_int32(flags, &body);
+  encode_int32(2, &body); // Column count
+  if (has_more_pages) {
+    char paging_state[16];
+    sprintf(paging_state, "%u", first + count);
+    encode_bytes(paging_state, &body);
+  }
+  encode_string(KEYSPACE, &body);
+  encode_string(TABLE, &body);
+  encode_column("ck", TYPE_INT, &body);
+  encode_column("value", TYPE_BLOG, &body);
+  encode_int32(static_cast<int32_t>(count), &body); // Row count
+  for (unsigned i = first; i < first + count; ++i) {
+    String ck;
+    encode_int32(static_cast<int32_t>(i), &ck);
+    encode_bytes(ck, &body);
+    encode_bytes(value_, &body);
+  }
+  return body;
+}
+
+bool LatencyDistribution::parse(const String& spec, LatencyDistribution* distribution) {
+  char name[16];
+  double a = 0.0, b = 0.0;
+  int count = sscanf(spec.c_str(), "%15[a-z]:%lf:%lf", name, &a, &b);
+  if (count < 2 || a < 0.0 || b < 0.0) return false;
+
+  String type(name);
+  if (type == "fixed" && count == 2) {
+    distribution->type_ = FIXED;
+  } else if (type == "uniform" && count == 3 && a <= b) {
+    distribution->type_ = UNIFORM;
+  } else if (type == "exponential" && count == 2) {
+    distribution->type_ = EXPONENTIAL;
+  } else if (type == "lognormal" && count == 3) {
+    distribution->type_ = LOG_NORMAL;
+  } else {
+    return false;
+  }
+  distribution->a_ = a;
+  distribution->b_ = b;
+  return true;
+}
+
+uint64_t LatencyDistribution::sample(double u1, double u2) const {
+  double latency = 0.0;
+  switch (type_) {
+    case FIXED:
+      latency = a_;
+      break;
+    case UNIFORM:
+      latency = a_ + u1 * (b_ - a_);
+      break;
+    case EXPONENTIAL:
+      latency = -a_ * log(1.0 - u1);
+      break;
+    case LOG_NORMAL: {
+      // Box-Muller transform of the uniform values into a standard normal value
+      double z = sqrt(-2.0 * log(1.0 - u1)) * cos(2.0 * PI * u2);
+      latency = a_ * exp(b_ * z);
+    } break;
+  }
+  return static_cast<uint64_t>(latency + 0.5);
+}
+
+double Faults::random() const {
+  // SplitMix64 of a shared counter so the event loop threads don't contend on
+  // a lock
+  const uint64_t increment = 0x9E3779B97F4A7C15ULL;
+  uint64_t z =
+      random_state_.fetch_add(increment, datastax::internal::MEMORY_ORDER_RELAXED) + increment;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  z = z ^ (z >> 31);
+  return static_cast<double>(z >> 11) / 9007199254740992.0; // 2^53
+}
+
+void InjectFaults::on_run(Request* request) const {
+  const NodeFaults* node = faults_->find(request->address());
+  if (node == NULL) {
+    run_next(request);
+    return;
+  }
+
+  double u = faults_->random();
+  if (u < node->timeout_ratio) {
+    return; // Never respond
+  }
+  if (u < node->timeout_ratio + node->overloaded_ratio) {
+    request->error(ERROR_OVERLOADED, "Overloaded (injected by the mock server)");
+    return;
+  }
+
+  uint64_t latency_ms = node->latency.sample(faults_->random(), faults_->random());
+  if (node->slow_read_ratio > 0.0 && faults_->random() < node->slow_read_ratio) {
+    String query;
+    QueryParameters params;
+    if ((request->opcode() == OPCODE_QUERY && request->decode_query(&query, &params)) ||
+        (request->opcode() == OPCODE_EXECUTE && request->decode_execute(&query, &params))) {
+      if (is_read(query)) latency_ms += node->slow_read_latency_ms;
+    }
+  }
+
+  if (latency_ms > 0) {
+    request->wait(latency_ms, this); // Runs the next action when the timer expires
+  } else {
+    run_next(request);
+  }
+}
+
+const RequestHandler* benchmark::build_workload_handler(unsigned rows_per_partition,
+                                                       unsigned value_size, const Faults* faults) {
+  SimpleRequestHandlerBuilder builder;
+  Action::Builder& query = builder.on(OPCODE_QUERY).system_local().system_peers();
+  Action::Builder& execute = builder.on(OPCODE_EXECUTE);
+  Action::Builder& batch = builder.on(OPCODE_BATCH);
+  if (faults) {
+    query.execute(new InjectFaults(faults));
+    execute.execute(new InjectFaults(faults));
+    batch.execute(new InjectFaults(faults));
+  }
+  query.execute(new WorkloadQueries(rows_per_partition, value_size));
+  execute.execute(new WorkloadQueries(rows_per_partition, value_size));
+  batch.void_result();
+  builder.on(OPCODE_PREPARE).execute(new WorkloadQueries(rows_per_partition, value_size));
+  return builder.build();
+}
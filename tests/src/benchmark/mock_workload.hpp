@@ -0,0 +1,164 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_BENCHMARK_MOCK_WORKLOAD_HPP
+#define DATASTAX_BENCHMARK_MOCK_WORKLOAD_HPP
+
+#include "atomic.hpp"
+#include "map.hpp"
+#include "mockssandra.hpp"
+
+#define KEYSPACE "benchmark"
+#define TABLE "kv"
+#define READ_QUERY "SELECT ck, value FROM " KEYSPACE "." TABLE " WHERE pk = ?"
+#define WRITE_QUERY "INSERT INTO " KEYSPACE "." TABLE " (pk, ck, value) VALUES (?, ?, ?)"
+
+namespace benchmark {
+
+using datastax::String;
+using datastax::internal::core::Address;
+
+/**
+ * Responds to the benchmark's queries, prepares and executes. The prepared IDs
+ * are the queries themselves. Reads return all the rows of a partition (a page
+ * at a time if paging is used) and writes return a void result.
+ */
+class WorkloadQueries : public mockssandra::Action {
+public:
+  WorkloadQueries(unsigned rows_per_partition, unsigned value_size)
+      : rows_per_partition_(rows_per_partition)
+      , value_(value_size, 'v') {}
+
+  virtual void on_run(mockssandra::Request* request) const;
+
+private:
+  String rows_result(const mockssandra::QueryParameters& params) const;
+
+private:
+  const unsigned rows_per_partition_;
+  const String value_;
+};
+
+/**
+ * A distribution of response latencies in milliseconds:
+ *
+ * fixed:<ms>, uniform:<min ms>:<max ms>, exponential:<mean ms> or
+ * lognormal:<median ms>:<sigma>
+ */
+class LatencyDistribution {
+public:
+  enum Type { FIXED, UNIFORM, EXPONENTIAL, LOG_NORMAL };
+
+  LatencyDistribution()
+      : type_(FIXED)
+      , a_(0.0)
+      , b_(0.0) {}
+
+  static bool parse(const String& spec, LatencyDistribution* distribution);
+
+  /**
+   * Sample a latency.
+   *
+   * @param u1 A uniform random value in [0, 1).
+   * @param u2 Another uniform random value in [0, 1).
+   * @return The latency in milliseconds.
+   */
+  uint64_t sample(double u1, double u2) const;
+
+private:
+  Type type_;
+  double a_;
+  double b_;
+};
+
+/**
+ * The faults injected into a node's responses. The ratios are the fraction of
+ * the requests that are never answered (so they time out on the client), that
+ * fail with an OVERLOADED error and, for reads, that are slow.
+ */
+struct NodeFaults {
+  NodeFaults()
+      : timeout_ratio(0.0)
+      , overloaded_ratio(0.0)
+      , slow_read_ratio(0.0)
+      , slow_read_latency_ms(0) {}
+
+  LatencyDistribution latency;
+  double timeout_ratio;
+  double overloaded_ratio;
+  double slow_read_ratio;
+  uint64_t slow_read_latency_ms;
+};
+
+/**
+ * The faults of each node, shared by the nodes' event loop threads. The random
+ * numbers come from a lock-free counter based generator (SplitMix64).
+ */
+class Faults {
+public:
+  Faults()
+      : random_state_(0) {}
+
+  void set(const Address& address, const NodeFaults& faults) { nodes_[address] = faults; }
+
+  const NodeFaults* find(const Address& address) const {
+    Map::const_iterator it = nodes_.find(address);
+    return it != nodes_.end() ? &it->second : NULL;
+  }
+
+  /**
+   * A uniform random value in [0, 1).
+   */
+  double random() const;
+
+private:
+  typedef datastax::internal::Map<Address, NodeFaults> Map;
+  Map nodes_;
+  mutable datastax::internal::Atomic<uint64_t> random_state_;
+};
+
+/**
+ * Injects the faults of the node that received a request before the request
+ * is passed to the next action. Delayed responses don't block the node's
+ * event loop.
+ */
+class InjectFaults : public mockssandra::Action {
+public:
+  InjectFaults(const Faults* faults)
+      : faults_(faults) {}
+
+  virtual void on_run(mockssandra::Request* request) const;
+
+private:
+  const Faults* const faults_;
+};
+
+/**
+ * Build a request handler for the benchmark's workload.
+ *
+ * @param rows_per_partition The number of rows returned by a read.
+ * @param value_size The size of the returned values.
+ * @param faults The faults injected into the responses to queries, executes
+ * and batches. This can be NULL to respond right away.
+ * @return The request handler.
+ */
+const mockssandra::RequestHandler* build_workload_handler(unsigned rows_per_partition,
+                                                          unsigned value_size,
+                                                          const Faults* faults = NULL);
+
+} // namespace benchmark
+
+#endif
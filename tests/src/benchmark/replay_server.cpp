@@ -0,0 +1,475 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+/*
+ * A standalone mockssandra cluster that replays the traffic recorded by the
+ * driver's frame capture (see cass_cluster_set_frame_capture()). The captured
+ * requests are paired with their responses and the responses are replayed,
+ * after the captured latencies, to the queries, prepares, executes and
+ * batches that match the captured requests: the same query string for
+ * queries and prepares, the same prepared ID for executes. The responses to a
+ * request are replayed in their captured order and then start over. The
+ * cluster's topology and the connection handshakes are the mock cluster's own.
+ *
+ * Compressed frames and frames with custom payloads, tracing or warnings are
+ * skipped, and the driver needs to use the protocol version of the capture.
+ */
+
+#include "atomic.hpp"
+#include "frame_capture.hpp"
+#include "map.hpp"
+#include "mockssandra.hpp"
+
+#include <math.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#define HEADER_SIZE 9 // Protocol v3 and above
+
+using datastax::String;
+using datastax::internal::Atomic;
+using datastax::internal::Map;
+using datastax::internal::Vector;
+using namespace mockssandra;
+
+static volatile sig_atomic_t is_stopped = 0;
+
+static void on_signal(int signal) { is_stopped = 1; }
+
+static void sleep_ms(unsigned ms) {
+#ifdef _WIN32
+  Sleep(ms);
+#else
+  usleep(ms * 1000);
+#endif
+}
+
+static uint32_t read_uint32(const char* input) {
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(input);
+  return (static_cast<uint32_t>(bytes[0]) << 24) | (static_cast<uint32_t>(bytes[1]) << 16) |
+         (static_cast<uint32_t>(bytes[2]) << 8) | static_cast<uint32_t>(bytes[3]);
+}
+
+static uint64_t read_uint64(const char* input) {
+  return (static_cast<uint64_t>(read_uint32(input)) << 32) | read_uint32(input + 4);
+}
+
+static int16_t read_int16(const char* input) {
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(input);
+  return static_cast<int16_t>((bytes[0] << 8) | bytes[1]);
+}
+
+/**
+ * The key that matches a request to the captured responses.
+ *
+ * @param opcode The request's opcode.
+ * @param query The query string of a query or prepare, or the prepared ID of
+ * an execute.
+ * @return The key.
+ */
+static String request_key(int8_t opcode, const String& query) {
+  String key(1, static_cast<char>(opcode));
+  return key.append(query);
+}
+
+/**
+ * The key of a captured request's body or an empty string if the request
+ * isn't replayed.
+ */
+static String captured_request_key(int8_t opcode, const char* body, size_t size) {
+  switch (opcode) {
+    case OPCODE_QUERY:
+    case OPCODE_PREPARE: // [long string]
+      if (size >= 4 && read_uint32(body) <= size - 4) {
+        return request_key(opcode, String(body + 4, read_uint32(body)));
+      }
+      break;
+    case OPCODE_EXECUTE: { // [short bytes]
+      if (size >= 2) {
+        size_t length = static_cast<uint16_t>(read_int16(body));
+        if (length <= size - 2) return request_key(opcode, String(body + 2, length));
+      }
+    } break;
+    case OPCODE_BATCH:
+      return request_key(opcode, String());
+    default:
+      break;
+  }
+  return String();
+}
+
+/**
+ * Writes a captured response.
+ */
+class SendCapturedResponse : public Action {
+public:
+  SendCapturedResponse(int8_t opcode, const String& body)
+      : opcode_(opcode)
+      , body_(body) {}
+
+  virtual void on_run(Request* request) const { request->write(opcode_, body_); }
+
+private:
+  const int8_t opcode_;
+  const String body_;
+};
+
+/**
+ * Writes a captured response after its captured latency. The response is
+ * written by the next action so the request's timer can run it.
+ */
+class CapturedResponse : public Action {
+public:
+  CapturedResponse(uint64_t latency_ms, int8_t opcode, const String& body)
+      : latency_ms_(latency_ms) {
+    next = new SendCapturedResponse(opcode, body);
+  }
+
+  virtual void on_run(Request* request) const {
+    if (latency_ms_ > 0) {
+      request->wait(latency_ms_, this);
+    } else {
+      run_next(request);
+    }
+  }
+
+private:
+  const uint64_t latency_ms_;
+};
+
+/**
+ * The captured responses to the requests with the same key, replayed in
+ * order by all the nodes' event loop threads.
+ */
+struct CapturedResponses {
+  CapturedResponses()
+      : next(0) {}
+
+  ~CapturedResponses() {
+    for (size_t i = 0; i < responses.size(); ++i) {
+      delete responses[i];
+    }
+  }
+
+  const Action* next_response() {
+    return responses[next.fetch_add(1, datastax::internal::MEMORY_ORDER_RELAXED) %
+                     responses.size()];
+  }
+
+  Vector<const Action*> responses;
+  Atomic<size_t> next;
+};
+
+/**
+ * The request/response pairs read from capture files.
+ */
+class Capture {
+public:
+  Capture()
+      : num_frames_(0)
+      , num_pairs_(0)
+      , num_skipped_(0) {}
+
+  ~Capture() {
+    for (ResponsesMap::iterator it = responses_.begin(); it != responses_.end(); ++it) {
+      delete it->second;
+    }
+  }
+
+  /**
+   * Read a capture file. The files of a ring are read oldest first.
+   *
+   * @param path The path of the capture file.
+   * @param time_scale The factor applied to the captured latencies.
+   * @return false if the file couldn't be read or isn't a capture.
+   */
+  bool read(const String& path, double time_scale);
+
+  CapturedResponses* find(Request* request) const;
+
+  size_t num_frames() const { return num_frames_; }
+  size_t num_pairs() const { return num_pairs_; }
+  size_t num_skipped() const { return num_skipped_; }
+  size_t num_keys() const { return responses_.size(); }
+
+private:
+  struct PendingRequest {
+    uint64_t timestamp;
+    String key;
+  };
+
+  void add_frame(uint64_t timestamp, int32_t connection_id, int8_t direction, const char* frame,
+                 size_t size, double time_scale);
+
+private:
+  typedef Map<String, CapturedResponses*> ResponsesMap;
+  typedef Map<std::pair<int32_t, int16_t>, PendingRequest> PendingMap;
+
+  ResponsesMap responses_;
+  PendingMap pending_; // By connection and stream
+  size_t num_frames_;
+  size_t num_pairs_;
+  size_t num_skipped_;
+};
+
+bool Capture::read(const String& path, double time_scale) {
+  FILE* file = fopen(path.c_str(), "rb");
+  if (file == NULL) return false;
+
+  String contents;
+  char buf[64 * 1024];
+  size_t count;
+  while ((count = fread(buf, 1, sizeof(buf), file)) > 0) {
+    contents.append(buf, count);
+  }
+  fclose(file);
+
+  if (contents.compare(0, FRAME_CAPTURE_MAGIC_SIZE, FRAME_CAPTURE_MAGIC) != 0) {
+    return false;
+  }
+
+  // The last record can be partial if the driver didn't flush the file
+  const char* pos = contents.data() + FRAME_CAPTURE_MAGIC_SIZE;
+  const char* end = contents.data() + contents.size();
+  while (end - pos >= FRAME_CAPTURE_RECORD_HEADER_SIZE) {
+    uint64_t timestamp = read_uint64(pos);
+    int32_t connection_id = static_cast<int32_t>(read_uint32(pos + 8));
+    int8_t direction = static_cast<int8_t>(pos[12]);
+    size_t size = read_uint32(pos + 13);
+    pos += FRAME_CAPTURE_RECORD_HEADER_SIZE;
+    if (static_cast<size_t>(end - pos) < size) break;
+    add_frame(timestamp, connection_id, direction, pos, size, time_scale);
+    pos += size;
+  }
+  return true;
+}
+
+void Capture::add_frame(uint64_t timestamp, int32_t connection_id, int8_t direction,
+                        const char* frame, size_t size, double time_scale) {
+  num_frames_++;
+  if (size < HEADER_SIZE || (frame[0] & 0x7F) < 3) {
+    num_skipped_++;
+    return;
+  }
+  int8_t flags = frame[1];
+  int16_t stream = read_int16(frame + 2);
+  int8_t opcode = frame[4];
+  const char* body = frame + HEADER_SIZE;
+  size_t body_size = size - HEADER_SIZE;
+  std::pair<int32_t, int16_t> id(connection_id, stream);
+
+  if (direction == datastax::internal::core::FrameCapture::DIRECTION_REQUEST) {
+    String key;
+    if (flags == 0) { // Not compressed, traced or with a custom payload
+      key = captured_request_key(opcode, body, body_size);
+    }
+    if (key.empty()) {
+      pending_.erase(id);
+      num_skipped_++;
+      return;
+    }
+    PendingRequest& request = pending_[id];
+    request.timestamp = timestamp;
+    request.key = key;
+    return;
+  }
+
+  PendingMap::iterator it = pending_.find(id);
+  if (it == pending_.end()) return; // The response to a skipped request or an event
+  if (flags != 0) {                 // Compressed, traced, with warnings or a custom payload
+    num_skipped_++;
+  } else {
+    uint64_t latency_ns = timestamp > it->second.timestamp ? timestamp - it->second.timestamp : 0;
+    uint64_t latency_ms = static_cast<uint64_t>(floor(latency_ns / 1e6 * time_scale + 0.5));
+    CapturedResponses*& responses = responses_[it->second.key];
+    if (responses == NULL) responses = new CapturedResponses();
+    responses->responses.push_back(
+        new CapturedResponse(latency_ms, opcode, String(body, body_size)));
+    num_pairs_++;
+  }
+  pending_.erase(it);
+}
+
+CapturedResponses* Capture::find(Request* request) const {
+  String query;
+  switch (request->opcode()) {
+    case OPCODE_QUERY: {
+      QueryParameters params;
+      if (!request->decode_query(&query, &params)) return NULL;
+    } break;
+    case OPCODE_PREPARE: {
+      PrepareParameters params;
+      if (!request->decode_prepare(&query, &params)) return NULL;
+    } break;
+    case OPCODE_EXECUTE: {
+      QueryParameters params;
+      if (!request->decode_execute(&query, &params)) return NULL;
+    } break;
+    case OPCODE_BATCH:
+      break;
+    default:
+      return NULL;
+  }
+  ResponsesMap::const_iterator it = responses_.find(request_key(request->opcode(), query));
+  return it != responses_.end() ? it->second : NULL;
+}
+
+/**
+ * Replays the captured responses to the requests that match them and passes
+ * the other requests to the next action.
+ */
+class ReplayCapture : public Action {
+public:
+  ReplayCapture(const Capture* capture)
+      : capture_(capture) {}
+
+  virtual void on_run(Request* request) const {
+    CapturedResponses* responses = capture_->find(request);
+    if (responses != NULL) {
+      responses->next_response()->run(request);
+    } else {
+      run_next(request);
+    }
+  }
+
+private:
+  const Capture* const capture_;
+};
+
+static void print_usage(const char* program) {
+  fprintf(stderr,
+          "Usage: %s --capture <path> [options]\n"
+          "\n"
+          "  --capture <path>              The capture file written by the driver. The\n"
+          "                                previous file of the ring (<path>.1) is also\n"
+          "                                replayed if it exists\n"
+          "  --nodes <n>                   Number of nodes, listening on 127.0.0.1 to "
+          "127.0.0.<n> (default: 1)\n"
+          "  --threads <n>                 Number of event loop threads (default: 1)\n"
+          "  --time-scale <factor>         Factor applied to the captured latencies, 0 to\n"
+          "                                respond right away (default: 1)\n",
+          program);
+}
+
+static bool parse_unsigned(const char* value, unsigned* result) {
+  char* end;
+  unsigned long parsed = strtoul(value, &end, 10);
+  *result = static_cast<unsigned>(parsed);
+  return *value != '\0' && *end == '\0';
+}
+
+int main(int argc, char* argv[]) {
+  String path;
+  unsigned num_nodes = 1;
+  unsigned num_threads = 1;
+  double time_scale = 1.0;
+
+  for (int i = 1; i < argc; ++i) {
+    String arg(argv[i]);
+    if (arg.compare(0, 2, "--") != 0 || i + 1 >= argc) {
+      print_usage(argv[0]);
+      return 1;
+    }
+    const char* value = argv[++i];
+    bool is_valid = true;
+    if (arg == "--capture") {
+      path = value;
+    } else if (arg == "--nodes") {
+      is_valid = parse_unsigned(value, &num_nodes) && num_nodes > 0 && num_nodes < 255;
+    } else if (arg == "--threads") {
+      is_valid = parse_unsigned(value, &num_threads) && num_threads > 0;
+    } else if (arg == "--time-scale") {
+      char* end;
+      time_scale = strtod(value, &end);
+      is_valid = *value != '\0' && *end == '\0' && time_scale >= 0.0;
+    } else {
+      is_valid = false;
+    }
+    if (!is_valid) {
+      fprintf(stderr, "Invalid option or value '%s %s'\n", arg.c_str(), value);
+      print_usage(argv[0]);
+      return 1;
+    }
+  }
+
+  if (path.empty()) {
+    print_usage(argv[0]);
+    return 1;
+  }
+
+  Capture capture;
+  String previous_path(path + ".1");
+  FILE* previous = fopen(previous_path.c_str(), "rb");
+  if (previous != NULL) {
+    fclose(previous);
+    if (!capture.read(previous_path, time_scale)) {
+      fprintf(stderr, "Unable to read the capture file '%s'\n", previous_path.c_str());
+      return 1;
+    }
+  }
+  if (!capture.read(path, time_scale)) {
+    fprintf(stderr, "Unable to read the capture file '%s'\n", path.c_str());
+    return 1;
+  }
+  printf("Read %u frame(s): %u replayed request/response pair(s) for %u distinct request(s), "
+         "%u frame(s) skipped\n",
+         static_cast<unsigned>(capture.num_frames()), static_cast<unsigned>(capture.num_pairs()),
+         static_cast<unsigned>(capture.num_keys()), static_cast<unsigned>(capture.num_skipped()));
+
+  SimpleRequestHandlerBuilder builder;
+  builder.on(OPCODE_QUERY)
+      .system_local()
+      .system_peers()
+      .execute(new ReplayCapture(&capture))
+      .error(ERROR_INVALID_QUERY, "No captured response for the query");
+  builder.on(OPCODE_PREPARE)
+      .execute(new ReplayCapture(&capture))
+      .error(ERROR_INVALID_QUERY, "No captured response for the query");
+  builder.on(OPCODE_EXECUTE)
+      .execute(new ReplayCapture(&capture))
+      .error(ERROR_INVALID_QUERY, "No captured response for the prepared statement");
+  builder.on(OPCODE_BATCH).execute(new ReplayCapture(&capture)).void_result();
+
+  mockssandra::SimpleCluster cluster(builder.build(), num_nodes, 0, num_threads);
+  if (cluster.start_all() != 0) {
+    fprintf(stderr, "Unable to start the cluster\n");
+    return 1;
+  }
+
+  mockssandra::Hosts hosts(cluster.hosts());
+  printf("Started %u node(s) on %u thread(s): ", num_nodes, num_threads);
+  for (size_t i = 0; i < hosts.size(); ++i) {
+    printf("%s%s", i > 0 ? ", " : "", hosts[i].address.to_string(true).c_str());
+  }
+  printf("\nPress Ctrl+C to stop\n");
+  fflush(stdout);
+
+  signal(SIGINT, on_signal);
+  signal(SIGTERM, on_signal);
+  while (!is_stopped) {
+    sleep_ms(100);
+  }
+
+  printf("Stopping\n");
+  return 0;
+}
@@ -65,6 +65,10 @@
 #define CASSANDRA_INTEGRATION_DISABLED_TYPED_TEST_P(test_case, test_name) \
   INTEGRATION_DISABLED_TYPED_TEST_P(Cassandra, test_case, test_name)
 
+// Macros to use for grouping performance integration tests together
+#define PERFORMANCE_INTEGRATION_TEST_F(test_case, test_name) \
+  INTEGRATION_TEST_F(Performance, test_case, test_name)
+
 // TODO: Create SKIP_SUITE macro; reduces noise and makes sense for certain suites
 
 #define SKIP_TEST(message)                                \
@@ -49,6 +49,7 @@ std::string Options::private_key_ = "private.key";
 bool Options::is_verbose_ccm_ = false;
 bool Options::is_verbose_integration_ = false;
 bool Options::is_beta_protocol_ = true;
+std::string Options::performance_results_ = "performance_results.json";
 
 // Static initialization is not guaranteed for the following types
 CCM::DseCredentialsType Options::dse_credentials_type_;
@@ -187,6 +188,13 @@ bool Options::initialize(int argc, char* argv[]) {
         }
       } else if (key == "--disable-beta-protocol") {
         is_beta_protocol_ = false;
+      } else if (key == "--performance-results") {
+        if (!value.empty()) {
+          performance_results_ = value;
+        } else {
+          std::cerr << "Missing Performance Results Filename: Using default "
+                    << performance_results_ << std::endl;
+        }
       }
 #ifdef CASS_USE_LIBSSH2
       else if (key == "--authentication") {
@@ -253,8 +261,11 @@ bool Options::initialize(int argc, char* argv[]) {
     if (categories_.empty()) {
       for (TestCategory::iterator iterator = TestCategory::begin(); iterator != TestCategory::end();
            ++iterator) {
-        // Only add the DSE test category if DSE is enabled
-        if (*iterator != TestCategory::DSE || is_dse()) {
+        // Only add the DSE test category if DSE is enabled and the performance
+        // test category if it's requested
+        if (*iterator == TestCategory::PERFORMANCE) {
+          continue;
+        } else if (*iterator != TestCategory::DSE || is_dse()) {
           categories_.insert(*iterator);
         } else {
           std::cerr << "DSE Category Will be Ignored: DSE is not enabled [--dse]" << std::endl;
@@ -309,7 +320,13 @@ void Options::print_help() {
             << "Run only the categories whose name matches one of the available" << std::endl
             << "      categories; ':' separates two categories. The default is all categories"
             << std::endl
-            << "      being executed." << std::endl;
+            << "      being executed except PERFORMANCE." << std::endl;
+  std::cout << "  --performance-results=[FILENAME]" << std::endl
+            << "      "
+            << "File the PERFORMANCE tests append their throughput and latency results"
+            << std::endl
+            << "      to, one JSON object per line. The default is " << performance_results()
+            << "." << std::endl;
   std::cout << "  --dse" << std::endl
             << "      "
             << "Indicate server version supplied is DSE." << std::endl;
@@ -439,6 +456,8 @@ void Options::print_settings() {
 
 bool Options::is_help() { return is_help_; }
 
+const std::string& Options::performance_results() { return performance_results_; }
+
 bool Options::keep_clusters() { return is_keep_clusters_; }
 
 bool Options::log_tests() { return is_log_tests_; }
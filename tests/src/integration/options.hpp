@@ -233,6 +233,12 @@ public:
    * @return True if beta protocol should be enabled; false otherwise
    */
   static bool is_beta_protocol();
+  /**
+   * Get the file the performance tests append their results to
+   *
+   * @return Performance results filename
+   */
+  static const std::string& performance_results();
   /**
    * Get a CCM instance based on the options
    *
@@ -357,6 +363,10 @@ private:
    * NOTE: Individual tests can still override this.
    */
   static bool is_beta_protocol_;
+  /**
+   * File the performance tests append their results to
+   */
+  static std::string performance_results_;
 
   /**
    * Hidden default constructor
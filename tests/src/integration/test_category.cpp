@@ -22,6 +22,7 @@
 // Constant value definitions for test type
 const TestCategory TestCategory::CASSANDRA("CASSANDRA", 0, "Cassandra", "*_Cassandra_*");
 const TestCategory TestCategory::DSE("DSE", 1, "DataStax Enterprise", "*_DSE_*");
+const TestCategory TestCategory::PERFORMANCE("PERFORMANCE", 2, "Performance", "*_Performance_*");
 
 // Static declarations for test type
 std::set<TestCategory> TestCategory::constants_;
@@ -97,6 +98,7 @@ const std::set<TestCategory>& TestCategory::get_constants() {
   if (constants_.empty()) {
     constants_.insert(CASSANDRA);
     constants_.insert(DSE);
+    constants_.insert(PERFORMANCE);
   }
 
   return constants_;
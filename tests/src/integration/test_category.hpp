@@ -44,6 +44,10 @@ public:
    * DataStax Enterprise category
    */
   static const TestCategory DSE;
+  /**
+   * Performance category (only run when requested)
+   */
+  static const TestCategory PERFORMANCE;
 
   /**
    * Default constructor to handle issues with static initialization of
@@ -0,0 +1,182 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "integration.hpp"
+
+#include <ctime>
+#include <fstream>
+
+#define NUMBER_OF_REQUESTS 100000u
+#define NUMBER_OF_WARMUP_REQUESTS 10000u
+#define NUMBER_OF_CONCURRENT_REQUESTS 256u
+#define NUMBER_OF_IO_THREADS 2u
+
+/**
+ * Performance integration tests
+ *
+ * Each test runs a fixed workload against the cluster and appends the
+ * throughput and latencies of the workload to the performance results file
+ * (`--performance-results`), one JSON object per line, so that they can be
+ * compared across commits. The workloads are measured using a new session so
+ * that its metrics only include the workload's requests.
+ */
+class PerformanceTests : public Integration {
+public:
+  PerformanceTests() { number_dc1_nodes_ = 3; }
+
+  void SetUp() {
+    // Call the parent setup function
+    Integration::SetUp();
+
+    // Create the table
+    session_.execute("CREATE TABLE " + table_name_ + " (key int PRIMARY KEY, value text)");
+  }
+
+  /**
+   * Insert the rows read by the select workloads
+   *
+   * @param session Session to insert the rows with
+   * @param count Number of rows
+   */
+  void insert_rows(Session session, size_t count) {
+    Prepared prepared =
+        session.prepare("INSERT INTO " + table_name_ + " (key, value) VALUES (?, ?)");
+    run_workload(session, prepared, count, true);
+  }
+
+  /**
+   * Run a workload keeping a fixed number of requests in-flight
+   *
+   * @param session Session to run the workload with
+   * @param prepared Prepared statement of the workload
+   * @param count Number of requests
+   * @param is_insert True if a value is bound after the key; false otherwise
+   * @return The duration of the workload in nanoseconds
+   */
+  uint64_t run_workload(Session session, Prepared prepared, size_t count, bool is_insert) {
+    std::vector<Future> futures;
+    futures.reserve(NUMBER_OF_CONCURRENT_REQUESTS);
+
+    uint64_t start = uv_hrtime();
+    for (size_t i = 0; i < count; ++i) {
+      if (futures.size() == NUMBER_OF_CONCURRENT_REQUESTS) {
+        Future& future = futures[i % NUMBER_OF_CONCURRENT_REQUESTS];
+        future.wait();
+      }
+
+      Statement statement = prepared.bind();
+      cass_int32_t key = static_cast<cass_int32_t>(i % NUMBER_OF_WARMUP_REQUESTS);
+      statement.bind<Integer>(0, Integer(key));
+      if (is_insert) {
+        statement.bind<Text>(1, Text(format_string("value-%d", static_cast<int>(i))));
+      }
+      statement.set_idempotent(true);
+
+      if (futures.size() < NUMBER_OF_CONCURRENT_REQUESTS) {
+        futures.push_back(session.execute_async(statement));
+      } else {
+        futures[i % NUMBER_OF_CONCURRENT_REQUESTS] = session.execute_async(statement);
+      }
+    }
+    for (std::vector<Future>::iterator it = futures.begin(); it != futures.end(); ++it) {
+      it->wait();
+    }
+    return uv_hrtime() - start;
+  }
+
+  /**
+   * Measure a workload and record its results
+   *
+   * @param name Name of the workload
+   * @param query Query of the workload
+   * @param is_insert True if a value is bound after the key; false otherwise
+   */
+  void measure(const std::string& name, const std::string& query, bool is_insert) {
+    // Warm up the server using the default session
+    Prepared prepared = session_.prepare(query);
+    run_workload(session_, prepared, NUMBER_OF_WARMUP_REQUESTS, is_insert);
+    CHECK_FAILURE;
+
+    Session session =
+        default_cluster().with_num_threads_io(NUMBER_OF_IO_THREADS).connect(keyspace_name_);
+    prepared = session.prepare(query);
+    uint64_t duration_ns = run_workload(session, prepared, NUMBER_OF_REQUESTS, is_insert);
+    CHECK_FAILURE;
+
+    CassMetrics metrics = session.metrics();
+    double throughput = NUMBER_OF_REQUESTS / (duration_ns / 1e9);
+    TEST_LOG(name << ": " << throughput << " requests/s, p99 " << metrics.requests.percentile_99th
+                  << " us");
+    record(name, duration_ns, throughput, metrics);
+  }
+
+  /**
+   * Append the results of a workload to the performance results file
+   *
+   * @param name Name of the workload
+   * @param duration_ns Duration of the workload in nanoseconds
+   * @param throughput Requests per second
+   * @param metrics Metrics of the session that ran the workload
+   */
+  void record(const std::string& name, uint64_t duration_ns, double throughput,
+              const CassMetrics& metrics) {
+    std::ofstream results(Options::performance_results().c_str(), std::ios::app);
+    ASSERT_TRUE(results.good()) << "Unable to open performance results file "
+                                << Options::performance_results();
+    results << "{\"test\":\"" << name << "\""
+            << ",\"timestamp\":" << static_cast<long long>(time(NULL))
+            << ",\"driver_version\":\"" << CASS_VERSION_MAJOR << "." << CASS_VERSION_MINOR << "."
+            << CASS_VERSION_PATCH << "\""
+            << ",\"server_type\":\"" << Options::server_type().to_string() << "\""
+            << ",\"server_version\":\"" << server_version_.to_string() << "\""
+            << ",\"nodes\":" << number_dc1_nodes_ << ",\"io_threads\":" << NUMBER_OF_IO_THREADS
+            << ",\"concurrency\":" << NUMBER_OF_CONCURRENT_REQUESTS
+            << ",\"requests\":" << NUMBER_OF_REQUESTS
+            << ",\"duration_ms\":" << duration_ns / 1000000
+            << ",\"throughput\":" << throughput << ",\"mean_us\":" << metrics.requests.mean
+            << ",\"median_us\":" << metrics.requests.median
+            << ",\"p99_us\":" << metrics.requests.percentile_99th
+            << ",\"p999_us\":" << metrics.requests.percentile_999th
+            << ",\"max_us\":" << metrics.requests.max << "}" << std::endl;
+  }
+};
+
+/**
+ * Measure inserts using a prepared statement
+ *
+ * @test_category performance
+ * @expected_result The throughput and latencies of the inserts are recorded
+ */
+PERFORMANCE_INTEGRATION_TEST_F(PerformanceTests, PreparedInserts) {
+  CHECK_FAILURE;
+
+  measure("PreparedInserts", "INSERT INTO " + table_name_ + " (key, value) VALUES (?, ?)", true);
+}
+
+/**
+ * Measure single partition selects using a prepared statement
+ *
+ * @test_category performance
+ * @expected_result The throughput and latencies of the selects are recorded
+ */
+PERFORMANCE_INTEGRATION_TEST_F(PerformanceTests, PreparedSelects) {
+  CHECK_FAILURE;
+
+  insert_rows(session_, NUMBER_OF_WARMUP_REQUESTS);
+  CHECK_FAILURE;
+
+  measure("PreparedSelects", "SELECT value FROM " + table_name_ + " WHERE key = ?", false);
+}
@@ -45,6 +45,8 @@ using datastax::internal::core::UuidGen;
 
 #define SSL_BUF_SIZE 8192
 #define CASSANDRA_VERSION "3.11.4"
+#define SCHEMA_VERSION_TIME_AND_VERSION 0x1b4db7eb4057c11eULL
+#define SCHEMA_VERSION_CLOCK_SEQ_AND_NODE 0x8f4e5c4d9a0b3f21ULL
 #define DSE_VERSION "6.7.1"
 #define DSE_CASSANDRA_VERSION "4.0.0.671"
 
@@ -452,13 +454,18 @@ void ClientConnection::on_ssl_read(const char* data, size_t len) {
     if (is_handshake_done() && data_written) {
       return; // Handshake is not completed; ingore remaining data
     }
-  } else {
-    char buf[SSL_BUF_SIZE];
-    while ((rc = SSL_read(ssl_, buf, sizeof(buf))) > 0) {
-      on_read(buf, rc);
+    // The client's data can follow the last message of the handshake (e.g.
+    // when resuming a session) so read any that's remaining
+    if (!is_handshake_done()) {
+      return;
     }
-    has_ssl_error(rc);
   }
+
+  char buf[SSL_BUF_SIZE];
+  while ((rc = SSL_read(ssl_, buf, sizeof(buf))) > 0) {
+    on_read(buf, rc);
+  }
+  has_ssl_error(rc);
 }
 
 ServerConnection::ServerConnection(const Address& address, const ClientConnectionFactory& factory)
@@ -1529,8 +1536,12 @@ void SendAuthSuccess::on_run(Request* request) const {
 }
 
 void SendSupported::on_run(Request* request) const {
+  Map<String, Vector<String> > options;
+  options["CQL_VERSION"].push_back("3.4.5");
+  options["PROTOCOL_VERSIONS"].push_back("3/v3");
+  options["PROTOCOL_VERSIONS"].push_back("4/v4");
   String body;
-  encode_uint16(0, &body);
+  encode_string_map(options, &body);
   request->write(OPCODE_SUPPORTED, body);
 }
 
@@ -1608,6 +1619,8 @@ void SystemLocal::on_run(Request* request) const {
     request->error(ERROR_PROTOCOL_ERROR, "Invalid query message");
   } else if (query.find(SELECT_LOCAL) != String::npos) {
     const Host& host(request->host(request->address()));
+    CassUuid schema_version = { SCHEMA_VERSION_TIME_AND_VERSION,
+                                SCHEMA_VERSION_CLOCK_SEQ_AND_NODE };
 
     ResultSet local_rs = ResultSet::Builder("system", "local")
                              .column("key", Type::text())
@@ -1617,6 +1630,7 @@ void SystemLocal::on_run(Request* request) const {
                              .column("rpc_address", Type::inet())
                              .column("partitioner", Type::text())
                              .column("tokens", Type::list(Type::text()))
+                             .column("schema_version", Type::uuid())
                              .row(Row::Builder()
                                       .text(request->client()->server()->address().to_string())
                                       .text(host.dc)
@@ -1625,6 +1639,7 @@ void SystemLocal::on_run(Request* request) const {
                                       .inet(request->client()->server()->address())
                                       .text(host.partitioner)
                                       .collection(Collection::text(host.tokens))
+                                      .uuid(schema_version)
                                       .build())
                              .build();
 
@@ -1971,6 +1986,7 @@ const RequestHandler* RequestHandler::Builder::build() {
   handler->actions_[OPCODE_QUERY].reset(actions_[OPCODE_QUERY].build());
   handler->actions_[OPCODE_PREPARE].reset(actions_[OPCODE_PREPARE].build());
   handler->actions_[OPCODE_EXECUTE].reset(actions_[OPCODE_EXECUTE].build());
+  handler->actions_[OPCODE_BATCH].reset(actions_[OPCODE_BATCH].build());
   handler->actions_[OPCODE_REGISTER].reset(actions_[OPCODE_REGISTER].build());
   handler->actions_[OPCODE_AUTH_RESPONSE].reset(actions_[OPCODE_AUTH_RESPONSE].build());
 
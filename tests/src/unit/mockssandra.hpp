@@ -1240,9 +1240,9 @@ public:
 class SimpleCluster : public Cluster {
 public:
   SimpleCluster(const RequestHandler* request_handler, size_t num_nodes_dc1 = 1,
-                size_t num_nodes_dc2 = 0)
+                size_t num_nodes_dc2 = 0, size_t num_threads = 1)
       : factory_(request_handler, this)
-      , event_loop_group_(1) {
+      , event_loop_group_(num_threads) {
     init(generator_, factory_, num_nodes_dc1, num_nodes_dc2);
   }
 
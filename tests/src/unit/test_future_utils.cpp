@@ -0,0 +1,33 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "test_future_utils.hpp"
+
+#include "future.hpp"
+
+using datastax::internal::core::Future;
+
+CassFuture* test::future_new() {
+  Future* future = new Future(Future::FUTURE_TYPE_GENERIC);
+  future->inc_ref();
+  return CassFuture::to(future);
+}
+
+void test::future_set(CassFuture* future) { future->from()->set(); }
+
+void test::future_set_error(CassFuture* future, CassError code) {
+  future->from()->set_error(code, cass_error_desc(code));
+}
@@ -0,0 +1,39 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_TEST_FUTURE_UTILS_HPP
+#define DATASTAX_TEST_FUTURE_UTILS_HPP
+
+#include "cassandra.h"
+
+// Futures that are completed by the tests themselves. These only use the
+// public API types so that tests compiled with another standard than the
+// driver's internal headers (e.g. the C++20 coroutine tests) can use them.
+namespace test {
+
+// Create a future that's pending until it's set. It's freed using
+// cass_future_free().
+CassFuture* future_new();
+
+// Complete a future successfully
+void future_set(CassFuture* future);
+
+// Complete a future with an error
+void future_set_error(CassFuture* future, CassError code);
+
+} // namespace test
+
+#endif
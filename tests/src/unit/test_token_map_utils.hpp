@@ -340,11 +340,8 @@ inline RandomPartitioner::Token create_random_token(const String& s) {
 }
 
 inline ByteOrderedPartitioner::Token create_byte_ordered_token(const String& s) {
-  ByteOrderedPartitioner::Token token;
-  for (String::const_iterator i = s.begin(), end = s.end(); i != end; ++i) {
-    token.push_back(static_cast<uint8_t>(*i));
-  }
-  return token;
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(s.data());
+  return ByteOrderedPartitioner::Token(data, data + s.size());
 }
 
 #endif
@@ -164,6 +164,24 @@ TEST(AddressUnitTest, Hash) {
   EXPECT_EQ(set.size(), 5u); // Added
 }
 
+TEST(AddressUnitTest, HashCode) {
+  // Equal addresses have equal hashes however they're created
+  Address address("127.0.0.1", 9042);
+  const uint8_t inet[] = { 127, 0, 0, 1 };
+  EXPECT_EQ(address, Address(inet, sizeof(inet), 9042));
+  EXPECT_EQ(address.hash_code(), Address(inet, sizeof(inet), 9042).hash_code());
+  Address::SocketStorage storage;
+  EXPECT_EQ(address.hash_code(), Address(address.to_sockaddr(&storage)).hash_code());
+
+  // The server name is part of the address
+  Address with_server_name(address, "server");
+  EXPECT_NE(address, with_server_name);
+  EXPECT_EQ(with_server_name, Address("127.0.0.1", 9042, "server"));
+  EXPECT_EQ(with_server_name.hash_code(), Address("127.0.0.1", 9042, "server").hash_code());
+  EXPECT_TRUE(Address(with_server_name, "").equals(address));
+  EXPECT_EQ(Address(with_server_name, "").hash_code(), address.hash_code());
+}
+
 TEST(AddressUnitTest, StrictWeakOrder) {
   { // Family
     Address a("localhost", 9042);
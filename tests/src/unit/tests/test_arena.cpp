@@ -0,0 +1,85 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "arena.hpp"
+#include "memory.hpp"
+#include "ref_counted.hpp"
+
+#include <stdlib.h>
+
+using namespace datastax::internal;
+
+static int arena_malloc_count = 0;
+static void* arena_malloc(size_t size) {
+  arena_malloc_count++;
+  return ::malloc(size);
+}
+
+static void* arena_realloc(void* ptr, size_t size) { return ::realloc(ptr, size); }
+
+static int arena_free_count = 0;
+static void arena_free(void* ptr) {
+  arena_free_count++;
+  ::free(ptr);
+}
+
+class ArenaObject : public RefCounted<ArenaObject> {
+public:
+  ARENA_ALLOCATED()
+
+  char data[100];
+};
+
+class ArenaUnitTest : public testing::Test {
+public:
+  void SetUp() {
+    arena_malloc_count = 0;
+    arena_free_count = 0;
+    Memory::set_functions(arena_malloc, arena_realloc, arena_free);
+  }
+
+  void TearDown() { Memory::set_functions(NULL, NULL, NULL); }
+};
+
+TEST_F(ArenaUnitTest, SingleAllocation) {
+  {
+    SharedRefPtr<Arena> arena(Arena::create(1024));
+    SharedRefPtr<ArenaObject> first(new (arena.get()) ArenaObject());
+    SharedRefPtr<ArenaObject> second(new (arena.get()) ArenaObject());
+    EXPECT_GT(arena->used(), 2 * sizeof(ArenaObject));
+
+    // The arena outlives its owner while objects are still using it
+    arena.reset();
+    first.reset();
+    EXPECT_EQ(0, arena_free_count);
+  }
+  EXPECT_EQ(1, arena_malloc_count);
+  EXPECT_EQ(1, arena_free_count);
+}
+
+TEST_F(ArenaUnitTest, FallbackToHeap) {
+  {
+    SharedRefPtr<Arena> arena(Arena::create(200));
+    SharedRefPtr<ArenaObject> first(new (arena.get()) ArenaObject());
+    EXPECT_LE(arena->used(), arena->capacity());
+    SharedRefPtr<ArenaObject> second(new (arena.get()) ArenaObject());
+    SharedRefPtr<ArenaObject> heap(new ArenaObject());
+  }
+  EXPECT_EQ(3, arena_malloc_count);
+  EXPECT_EQ(3, arena_free_count);
+}
@@ -0,0 +1,73 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "async_logger.hpp"
+#include "string.hpp"
+#include "vector.hpp"
+
+#include <stdio.h>
+
+using namespace datastax;
+using namespace datastax::internal;
+
+namespace {
+
+void on_log(const CassLogMessage* message, void* data) {
+  static_cast<Vector<String>*>(data)->push_back(message->message);
+}
+
+CassLogMessage new_message(const char* text) {
+  CassLogMessage message = { 0, CASS_LOG_ERROR, "file.cpp", 1, "function", "" };
+  snprintf(message.message, sizeof(message.message), "%s", text);
+  return message;
+}
+
+} // namespace
+
+TEST(AsyncLoggerUnitTest, Repeated) {
+  Vector<String> messages;
+  AsyncLogger logger(16, 0);
+  ASSERT_EQ(0, logger.init());
+
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_TRUE(logger.log(new_message("a"), on_log, &messages));
+  }
+  EXPECT_TRUE(logger.log(new_message("b"), on_log, &messages));
+  logger.flush();
+
+  ASSERT_EQ(3u, messages.size());
+  EXPECT_EQ("a", messages[0]);
+  EXPECT_EQ("Last message repeated 4 times", messages[1]);
+  EXPECT_EQ("b", messages[2]);
+}
+
+TEST(AsyncLoggerUnitTest, RateLimit) {
+  Vector<String> messages;
+  AsyncLogger logger(16, 2);
+  ASSERT_EQ(0, logger.init());
+
+  const char* texts[] = { "a", "b", "c", "d" };
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(logger.log(new_message(texts[i]), on_log, &messages));
+  }
+  logger.flush();
+
+  ASSERT_EQ(2u, messages.size());
+  EXPECT_EQ("a", messages[0]);
+  EXPECT_EQ("b", messages[1]);
+}
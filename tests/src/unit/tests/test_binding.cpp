@@ -0,0 +1,154 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "cassandra_binding.hpp"
+#include "execute_request.hpp"
+#include "prepared.hpp"
+#include "result_response.hpp"
+#include "serialization.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+class BindingUnitTest : public testing::Test {
+public:
+  void SetUp() {
+    append_int32(CASS_RESULT_KIND_PREPARED);
+    append_string("0123456789abcdef"); // Prepared ID
+    // Metadata
+    append_int32(CASS_RESULT_FLAG_GLOBAL_TABLESPEC);
+    append_int32(4); // Column count
+    append_int32(1); // Primary key count
+    append_uint16(0);
+    append_string("keyspace");
+    append_string("table");
+    append_column("id", CASS_VALUE_TYPE_UUID);
+    append_column("name", CASS_VALUE_TYPE_VARCHAR);
+    append_column("age", CASS_VALUE_TYPE_INT);
+    append_column("score", CASS_VALUE_TYPE_DOUBLE);
+    // Result metadata
+    append_int32(CASS_RESULT_FLAG_NO_METADATA);
+    append_int32(0); // Column count
+
+    ResultResponse::Ptr result(new ResultResponse());
+    result->set_buffer(data_.size());
+    memcpy(result->buffer()->data(), data_.data(), data_.size());
+    Decoder decoder(result->data(), data_.size(), ProtocolVersion(CASS_PROTOCOL_VERSION_V4));
+    EXPECT_TRUE(result->decode(decoder));
+
+    Metadata::SchemaSnapshot schema(0, VersionNumber(),
+                                    KeyspaceMetadata::MapPtr(new KeyspaceMetadata::Map()));
+    prepared_.reset(
+        new Prepared(result, PrepareRequest::ConstPtr(new PrepareRequest("query")), schema));
+  }
+
+  const CassPrepared* prepared() const { return CassPrepared::to(prepared_.get()); }
+
+  static String encode_values(const CassStatement* statement) {
+    Buffer buf(statement->from()->AbstractData::encode());
+    return String(buf.data(), buf.size());
+  }
+
+private:
+  void append_int32(int32_t value) {
+    char buf[sizeof(int32_t)];
+    encode_int32(buf, value);
+    data_.append(buf, sizeof(buf));
+  }
+
+  void append_uint16(uint16_t value) {
+    char buf[sizeof(uint16_t)];
+    encode_uint16(buf, value);
+    data_.append(buf, sizeof(buf));
+  }
+
+  void append_string(const String& value) {
+    append_uint16(value.size());
+    data_.append(value);
+  }
+
+  void append_column(const String& name, CassValueType type) {
+    append_string(name);
+    append_uint16(type);
+  }
+
+private:
+  String data_;
+  Prepared::ConstPtr prepared_;
+};
+
+TEST_F(BindingUnitTest, EncodesLikeBindFunctions) {
+  CassUuid id;
+  id.time_and_version = 0x0123456789ABCDEFULL;
+  id.clock_seq_and_node = 0xFEDCBA9876543210ULL;
+
+  cass::Binder<CassUuid, std::string, cass_int32_t, cass_double_t> binder(prepared());
+  ASSERT_EQ(CASS_OK, binder.error_code());
+  CassStatement* statement = binder.bind(id, "alice", 42, 1.5);
+  ASSERT_TRUE(statement != NULL);
+
+  CassStatement* expected = cass_prepared_bind(prepared());
+  EXPECT_EQ(CASS_OK, cass_statement_bind_uuid(expected, 0, id));
+  EXPECT_EQ(CASS_OK, cass_statement_bind_string(expected, 1, "alice"));
+  EXPECT_EQ(CASS_OK, cass_statement_bind_int32(expected, 2, 42));
+  EXPECT_EQ(CASS_OK, cass_statement_bind_double(expected, 3, 1.5));
+
+  EXPECT_EQ(encode_values(expected), encode_values(statement));
+
+  cass_statement_free(expected);
+  cass_statement_free(statement);
+}
+
+TEST_F(BindingUnitTest, NullAndUnset) {
+  CassUuid id = { 0, 0 };
+  // A NULL string binds null to the text parameter
+  cass::Binder<CassUuid, const char*, cass::Unset, cass::Null> binder(prepared());
+  ASSERT_EQ(CASS_OK, binder.error_code());
+  CassStatement* statement =
+      binder.bind(id, static_cast<const char*>(NULL), cass::Unset(), cass::Null());
+
+  const ExecuteRequest* request = static_cast<const ExecuteRequest*>(statement->from());
+  EXPECT_TRUE(request->elements()[1].is_null());
+  EXPECT_TRUE(request->elements()[2].is_unset());
+  EXPECT_TRUE(request->elements()[3].is_null());
+
+  cass_statement_free(statement);
+}
+
+TEST_F(BindingUnitTest, CheckedOncePerPrepared) {
+  // The types must match the parameters' types
+  cass::Binder<CassUuid, cass_int32_t, cass_int32_t, cass_double_t> wrong_type(prepared());
+  EXPECT_EQ(CASS_ERROR_LIB_INVALID_VALUE_TYPE, wrong_type.error_code());
+  EXPECT_TRUE(wrong_type.bind(CassUuid(), 1, 2, 3.0) == NULL);
+
+  // There must be a type for each parameter
+  cass::Binder<CassUuid, std::string> too_few(prepared());
+  EXPECT_EQ(CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS, too_few.error_code());
+  cass::Binder<CassUuid, std::string, cass_int32_t, cass_double_t, cass_int32_t> too_many(
+      prepared());
+  EXPECT_EQ(CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS, too_many.error_code());
+}
+
+TEST_F(BindingUnitTest, TruncatedEncodedValues) {
+  CassStatement* statement = cass_prepared_bind(prepared());
+  const cass_byte_t truncated[] = { 0, 0, 0, 4, 1, 2 };
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS,
+            cass_statement_bind_encoded_values(statement, truncated, sizeof(truncated)));
+  cass_statement_free(statement);
+}
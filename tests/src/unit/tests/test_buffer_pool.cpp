@@ -0,0 +1,111 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "buffer_pool.hpp"
+#include "metrics.hpp"
+
+#include <string.h>
+
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+TEST(BufferPoolUnitTest, ReuseReleasedBuffer) {
+  Metrics metrics(1);
+  BufferPool::Ptr pool(new BufferPool(&metrics));
+
+  RefBuffer* first = pool->acquire(100).get(); // Released immediately
+  EXPECT_EQ(0, metrics.buffer_pool_hits.sum());
+  EXPECT_EQ(1, metrics.buffer_pool_misses.sum());
+
+  RefBuffer::Ptr second(pool->acquire(200)); // Same size class
+  EXPECT_EQ(first, second.get());
+  EXPECT_EQ(1, metrics.buffer_pool_hits.sum());
+  EXPECT_EQ(1, metrics.buffer_pool_misses.sum());
+}
+
+TEST(BufferPoolUnitTest, SkipBuffersInUse) {
+  Metrics metrics(1);
+  BufferPool::Ptr pool(new BufferPool(&metrics));
+
+  RefBuffer::Ptr first(pool->acquire(64 * 1024));
+  RefBuffer::Ptr second(pool->acquire(64 * 1024));
+  EXPECT_NE(first.get(), second.get());
+  EXPECT_EQ(2, metrics.buffer_pool_misses.sum());
+
+  // Only the released buffer can be reused
+  RefBuffer* released = second.get();
+  second.reset();
+  RefBuffer::Ptr third(pool->acquire(64 * 1024));
+  EXPECT_EQ(released, third.get());
+  EXPECT_EQ(1, metrics.buffer_pool_hits.sum());
+}
+
+TEST(BufferPoolUnitTest, SizeClasses) {
+  BufferPool::Ptr pool(new BufferPool());
+
+  // Buffers are only reused for requests in the same size class
+  RefBuffer* small = pool->acquire(1024).get();
+  RefBuffer::Ptr large(pool->acquire(4 * 1024));
+  EXPECT_NE(small, large.get());
+
+  RefBuffer::Ptr reused(pool->acquire(512));
+  EXPECT_EQ(small, reused.get());
+}
+
+TEST(BufferPoolUnitTest, TooLargeToPool) {
+  Metrics metrics(1);
+  BufferPool::Ptr pool(new BufferPool(&metrics));
+
+  RefBuffer::Ptr buffer(pool->acquire(1024 * 1024));
+  EXPECT_EQ(1, buffer->ref_count()); // Not referenced by the pool
+  EXPECT_EQ(1, metrics.buffer_pool_misses.sum());
+}
+
+TEST(BufferPoolUnitTest, Preallocate) {
+  Metrics metrics(1);
+  BufferPool::Ptr pool(new BufferPool(&metrics));
+  pool->preallocate();
+
+  // Every size class is served from the preallocated buffers
+  RefBuffer::Ptr small(pool->acquire(100));
+  RefBuffer::Ptr large(pool->acquire(64 * 1024));
+  EXPECT_EQ(2, small->ref_count()); // Referenced by the pool
+  EXPECT_EQ(2, large->ref_count());
+  EXPECT_EQ(2, metrics.buffer_pool_hits.sum());
+  EXPECT_EQ(0, metrics.buffer_pool_misses.sum());
+}
+
+TEST(BufferPoolUnitTest, HugePages) {
+  Metrics metrics(1);
+  BufferPool::Ptr pool(new BufferPool(&metrics, true));
+  pool->preallocate();
+
+  // Buffers are pooled the same way whether or not huge pages are available:
+  // the preallocated buffers are handed out round-robin
+  RefBuffer::Ptr first(pool->acquire(1024));
+  RefBuffer::Ptr second(pool->acquire(1024));
+  EXPECT_NE(first.get(), second.get());
+  EXPECT_EQ(2, first->ref_count()); // Referenced by the pool
+  EXPECT_EQ(2, second->ref_count());
+  EXPECT_EQ(2, metrics.buffer_pool_hits.sum());
+  EXPECT_EQ(0, metrics.buffer_pool_misses.sum());
+
+  // Buffers that outlive the pool keep its memory mapped
+  pool.reset();
+  memset(second->data(), 0, 1024);
+}
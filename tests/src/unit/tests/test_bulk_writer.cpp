@@ -0,0 +1,50 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "bulk_writer.hpp"
+
+using namespace datastax::internal::core;
+
+TEST(BulkWriterUnitTest, Settings) {
+  BulkWriter::Ptr writer(new BulkWriter(Prepared::ConstPtr()));
+  EXPECT_EQ(CASS_OK, writer->set_batch_size(100));
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS, writer->set_batch_size(0));
+  EXPECT_EQ(CASS_OK, writer->set_max_requests_per_host(2));
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS, writer->set_max_requests_per_host(0));
+  EXPECT_EQ(CASS_OK, writer->set_max_pending_rows(1000));
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS, writer->set_max_pending_rows(0));
+  EXPECT_EQ(CASS_OK, writer->set_max_retries(0));
+
+  // A writer that was never started can't be used
+  EXPECT_EQ(CASS_ERROR_LIB_INVALID_STATE, writer->flush());
+  EXPECT_EQ(CASS_OK, writer->error_code());
+
+  CassBulkWriterMetrics metrics;
+  writer->get_metrics(&metrics);
+  EXPECT_EQ(0u, metrics.rows_written);
+  EXPECT_EQ(0u, metrics.inflight_batches);
+  EXPECT_EQ(0.0, metrics.rows_per_second);
+}
+
+TEST(BulkWriterUnitTest, Retryable) {
+  EXPECT_TRUE(BulkWriter::is_retryable(CASS_ERROR_LIB_REQUEST_TIMED_OUT));
+  EXPECT_TRUE(BulkWriter::is_retryable(CASS_ERROR_SERVER_WRITE_TIMEOUT));
+  EXPECT_TRUE(BulkWriter::is_retryable(CASS_ERROR_SERVER_OVERLOADED));
+  EXPECT_FALSE(BulkWriter::is_retryable(CASS_ERROR_SERVER_INVALID_QUERY));
+  EXPECT_FALSE(BulkWriter::is_retryable(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE));
+}
@@ -0,0 +1,51 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "byte_swap.hpp"
+#include "serialization.hpp"
+#include "vector.hpp"
+
+using namespace datastax::internal;
+
+// Cover the vectorized loops and the remaining values of every run length
+TEST(ByteSwapUnitTest, Swap32) {
+  for (size_t count = 0; count < 37; ++count) {
+    Vector<int32_t> values(count);
+    for (size_t i = 0; i < count; ++i) {
+      encode_int32(reinterpret_cast<char*>(&values[i]), static_cast<int32_t>(i * 0x01020304 + 1));
+    }
+    if (count > 0) swap_bytes_32(reinterpret_cast<char*>(&values[0]), count);
+    for (size_t i = 0; i < count; ++i) {
+      EXPECT_EQ(static_cast<int32_t>(i * 0x01020304 + 1), values[i]);
+    }
+  }
+}
+
+TEST(ByteSwapUnitTest, Swap64) {
+  for (size_t count = 0; count < 37; ++count) {
+    Vector<int64_t> values(count);
+    for (size_t i = 0; i < count; ++i) {
+      encode_int64(reinterpret_cast<char*>(&values[i]),
+                   static_cast<int64_t>(i * 0x0102030405060708LL - 1));
+    }
+    if (count > 0) swap_bytes_64(reinterpret_cast<char*>(&values[0]), count);
+    for (size_t i = 0; i < count; ++i) {
+      EXPECT_EQ(static_cast<int64_t>(i * 0x0102030405060708LL - 1), values[i]);
+    }
+  }
+}
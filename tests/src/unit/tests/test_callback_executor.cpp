@@ -0,0 +1,105 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "callback_executor.hpp"
+#include "vector.hpp"
+
+#include <uv.h>
+
+#define WAIT_FOR_TIME 5 * 1000 * 1000 // 5 seconds
+
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+namespace {
+
+struct CallbackState {
+  CallbackState()
+      : count(0)
+      , thread(uv_thread_self())
+      , done(new Future(Future::FUTURE_TYPE_GENERIC)) {}
+
+  int count;
+  uv_thread_t thread;
+  Future::Ptr done;
+};
+
+void on_callback(CassFuture* future, void* data) {
+  CallbackState* state = static_cast<CallbackState*>(data);
+  state->count++;
+  state->thread = uv_thread_self();
+  state->done->set();
+}
+
+void on_submit(CassCallbackTask* task, void* data) {
+  static_cast<Vector<CassCallbackTask*>*>(data)->push_back(task);
+}
+
+} // namespace
+
+TEST(CallbackExecutorUnitTest, External) {
+  Vector<CassCallbackTask*> tasks;
+  ExternalCallbackExecutor executor(on_submit, &tasks);
+
+  CallbackState state;
+  Future::Ptr future(new Future(Future::FUTURE_TYPE_GENERIC));
+  future->set_callback_executor(&executor);
+  ASSERT_TRUE(future->set_callback(on_callback, &state));
+
+  future->set();
+  EXPECT_TRUE(future->ready());
+  EXPECT_EQ(0, state.count); // Not run until the application runs the task
+  ASSERT_EQ(1u, tasks.size());
+
+  future.reset(); // The task keeps the future alive
+  cass_callback_task_run(tasks[0]);
+  EXPECT_EQ(1, state.count);
+}
+
+TEST(CallbackExecutorUnitTest, AlreadySet) {
+  Vector<CassCallbackTask*> tasks;
+  ExternalCallbackExecutor executor(on_submit, &tasks);
+
+  // Callbacks set on completed futures run in place, on the application's
+  // thread.
+  CallbackState state;
+  Future::Ptr future(new Future(Future::FUTURE_TYPE_GENERIC));
+  future->set_callback_executor(&executor);
+  future->set();
+  ASSERT_TRUE(future->set_callback(on_callback, &state));
+  EXPECT_EQ(1, state.count);
+  EXPECT_TRUE(tasks.empty());
+}
+
+TEST(CallbackExecutorUnitTest, ThreadPool) {
+  ThreadPoolCallbackExecutor executor(2);
+  ASSERT_EQ(0, executor.init());
+
+  CallbackState state;
+  Future::Ptr future(new Future(Future::FUTURE_TYPE_GENERIC));
+  future->set_callback_executor(&executor);
+  ASSERT_TRUE(future->set_callback(on_callback, &state));
+  future->set();
+
+  ASSERT_TRUE(state.done->wait_for(WAIT_FOR_TIME));
+  EXPECT_EQ(1, state.count);
+  uv_thread_t self = uv_thread_self();
+  EXPECT_EQ(0, uv_thread_equal(&state.thread, &self));
+
+  executor.close();
+}
@@ -0,0 +1,68 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "circuit_breaker.hpp"
+
+using namespace datastax::internal::core;
+
+#define OPEN_DURATION_NS (100LL * 1000LL * 1000LL) // 100 ms
+
+TEST(CircuitBreakerUnitTest, OpensAfterConsecutiveFailures) {
+  CircuitBreaker circuit_breaker(3, 100);
+  Host::Ptr host(new Host(Address("127.0.0.1", 9042)));
+  uint64_t now = 1000;
+
+  circuit_breaker.record_failure(host.get(), now);
+  circuit_breaker.record_failure(host.get(), now);
+  EXPECT_TRUE(circuit_breaker.try_acquire(host.get(), now));
+
+  // A success resets the consecutive failures
+  circuit_breaker.record_success(host.get());
+  circuit_breaker.record_failure(host.get(), now);
+  circuit_breaker.record_failure(host.get(), now);
+  EXPECT_TRUE(circuit_breaker.try_acquire(host.get(), now));
+
+  circuit_breaker.record_failure(host.get(), now);
+  EXPECT_FALSE(circuit_breaker.try_acquire(host.get(), now));
+  EXPECT_FALSE(circuit_breaker.try_acquire(host.get(), now + OPEN_DURATION_NS - 1));
+}
+
+TEST(CircuitBreakerUnitTest, HalfOpenProbe) {
+  CircuitBreaker circuit_breaker(1, 100);
+  Host::Ptr host(new Host(Address("127.0.0.1", 9042)));
+  uint64_t now = 1000;
+
+  circuit_breaker.record_failure(host.get(), now);
+  EXPECT_FALSE(circuit_breaker.try_acquire(host.get(), now));
+
+  // Only a single probe is allowed once the circuit is half-open
+  now += OPEN_DURATION_NS;
+  EXPECT_TRUE(circuit_breaker.try_acquire(host.get(), now));
+  EXPECT_FALSE(circuit_breaker.try_acquire(host.get(), now));
+
+  // A failed probe keeps the circuit open
+  circuit_breaker.record_failure(host.get(), now);
+  EXPECT_FALSE(circuit_breaker.try_acquire(host.get(), now + OPEN_DURATION_NS - 1));
+
+  // A successful probe closes it
+  now += OPEN_DURATION_NS;
+  EXPECT_TRUE(circuit_breaker.try_acquire(host.get(), now));
+  circuit_breaker.record_success(host.get());
+  EXPECT_TRUE(circuit_breaker.try_acquire(host.get(), now));
+  EXPECT_TRUE(circuit_breaker.try_acquire(host.get(), now));
+}
@@ -829,6 +829,33 @@ TEST_F(ClientInsightsUnitTest, StatusData) {
   }
 }
 
+TEST_F(ClientInsightsUnitTest, StatusDataDriverMetrics) {
+  mockssandra::SimpleCluster cluster(simple_dse_with_rpc_call(2));
+  ASSERT_EQ(cluster.start_all(), 0);
+  connect();
+
+  String message = status_message();
+  json::Document document;
+  document.Parse(message.c_str());
+
+  ASSERT_TRUE(document.IsObject());
+  ASSERT_TRUE(document.HasMember("data"));
+  const json::Value& data = document["data"];
+  ASSERT_TRUE(data.HasMember("driverMetrics"));
+  const json::Value& metrics = data["driverMetrics"];
+  ASSERT_TRUE(metrics.IsObject());
+
+  ASSERT_TRUE(metrics.HasMember("requestLatencies"));
+  const json::Value& latencies = metrics["requestLatencies"];
+  ASSERT_TRUE(latencies.IsObject());
+  ASSERT_TRUE(latencies.HasMember("percentile99th"));
+  ASSERT_TRUE(metrics.HasMember("requestMeanRate"));
+  ASSERT_TRUE(metrics.HasMember("totalConnections"));
+  ASSERT_GT(metrics["totalConnections"].GetInt64(), 0);
+  ASSERT_TRUE(metrics.HasMember("requestTimeouts"));
+  ASSERT_EQ(0, metrics["requestTimeouts"].GetInt64());
+}
+
 TEST_F(ClientInsightsUnitTest, StatusDataConnectedNodesRemovedNode) {
   mockssandra::SimpleCluster cluster(simple_dse_with_rpc_call(2), 3);
   ASSERT_EQ(cluster.start_all(), 0);
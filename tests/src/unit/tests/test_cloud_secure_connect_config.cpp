@@ -28,9 +28,11 @@
 #include "http_client.hpp"
 #include "json.hpp"
 #include "string.hpp"
+#include "utils.hpp"
 
 #include "zip.h"
 
+#include <stdio.h>
 #include <time.h>
 #include <uv.h>
 
@@ -363,6 +365,21 @@ public:
 
   const ClusterMetadataResolver::Ptr& resolver() const { return resolver_; }
 
+  ClusterMetadataResolver::Ptr new_resolver_with_cache_file(const String& cache_file) {
+    config_.set_cloud_metadata_cache_file(cache_file);
+    ClusterSettings settings(config_);
+    return config_.cluster_metadata_resolver_factory()->new_instance(settings);
+  }
+
+  static String metadata_cache_file() {
+    char tmp[260] = { 0 }; // Note: 260 is the maximum path on Windows
+    size_t tmp_length = 260;
+    uv_os_tmpdir(tmp, &tmp_length);
+    String path(String(tmp, tmp_length) + PATH_SEPARATOR + "cloud-metadata-cache");
+    remove(path.c_str());
+    return path;
+  }
+
   static void on_resolve_success(ClusterMetadataResolver* resolver, bool* flag) {
     *flag = true;
     EXPECT_EQ("dc1", resolver->local_dc());
@@ -396,7 +413,7 @@ public:
     EXPECT_EQ(0u, resolver->resolved_contact_points().size());
   }
 
-private:
+protected:
   static void response_v1(StringBuffer& buffer, bool is_contact_info = true,
                           bool is_local_dc = true, bool is_contact_points = true,
                           bool is_sni_proxy_address = true, bool is_port = true) {
@@ -477,6 +494,53 @@ TEST_F(CloudMetadataServerTest, InvalidMetadataServer) {
   EXPECT_TRUE(is_resolved);
 }
 
+TEST_F(CloudMetadataServerTest, ResolveUsingCachedMetadata) {
+  String cache_file(metadata_cache_file());
+
+  start_http_server();
+
+  { // The metadata retrieved from the server is cached
+    bool is_resolved = false;
+    AddressVec contact_points;
+    new_resolver_with_cache_file(cache_file)
+        ->resolve(loop(), contact_points, bind_callback(on_resolve_success, &is_resolved));
+    uv_run(loop(), UV_RUN_DEFAULT);
+    EXPECT_TRUE(is_resolved);
+  }
+
+  stop_http_server();
+
+  { // The cached metadata is used right away even though the server is down
+    bool is_resolved = false;
+    AddressVec contact_points;
+    new_resolver_with_cache_file(cache_file)
+        ->resolve(loop(), contact_points, bind_callback(on_resolve_success, &is_resolved));
+    EXPECT_TRUE(is_resolved);
+    uv_run(loop(), UV_RUN_DEFAULT);
+  }
+
+  remove(cache_file.c_str());
+}
+
+TEST_F(CloudMetadataServerTest, IgnoreCachedMetadataOfOtherBundle) {
+  String cache_file(metadata_cache_file());
+
+  StringBuffer buffer;
+  response_v1(buffer);
+  ASSERT_TRUE(datastax::internal::write_file(cache_file, String("other.datastax.com:443\n") +
+                                                             buffer.GetString()));
+
+  bool is_resolved = false;
+  AddressVec contact_points;
+  new_resolver_with_cache_file(cache_file)
+      ->resolve(loop(), contact_points, bind_callback(on_resolve_failed, &is_resolved));
+  EXPECT_FALSE(is_resolved); // Waits for the server
+  uv_run(loop(), UV_RUN_DEFAULT);
+  EXPECT_TRUE(is_resolved);
+
+  remove(cache_file.c_str());
+}
+
 TEST_F(CloudMetadataServerTest, ResolveV1InvalidContentTypeSsl) {
   start_http_server(false);
 
@@ -46,9 +46,10 @@ public:
     const Cluster::Ptr& cluster() const { return cluster_; }
 
     void set_cluster(const Cluster::Ptr& cluster) {
-      ScopedMutex lock(&mutex_);
-      cluster_ = cluster;
-      internal_set(lock);
+      if (internal_claim()) {
+        cluster_ = cluster;
+        internal_set();
+      }
     }
 
   private:
@@ -214,6 +215,21 @@ public:
     Future::Ptr recover_future_;
   };
 
+  class MaybeUpListener : public UpDownListener {
+  public:
+    typedef SharedRefPtr<MaybeUpListener> Ptr;
+
+    MaybeUpListener(const Future::Ptr& close_future, const Future::Ptr& down_future,
+                    const Future::Ptr& maybe_up_future)
+        : UpDownListener(close_future, Future::Ptr(), down_future)
+        , maybe_up_future_(maybe_up_future) {}
+
+    virtual void on_host_maybe_up(const Host::Ptr& host) { maybe_up_future_->set(); }
+
+  private:
+    Future::Ptr maybe_up_future_;
+  };
+
   class DisableEventsListener : public Listener {
   public:
     typedef SharedRefPtr<DisableEventsListener> Ptr;
@@ -692,6 +708,81 @@ TEST_F(ClusterUnitTest, NotifyDownUp) {
   ASSERT_TRUE(close_future->wait_for(WAIT_FOR_TIME));
 }
 
+TEST_F(ClusterUnitTest, ProbeDownHost) {
+  mockssandra::SimpleCluster mock_cluster(simple(), 3);
+  ASSERT_EQ(mock_cluster.start_all(), 0);
+
+  AddressVec contact_points;
+  contact_points.push_back(Address("127.0.0.1", 9042));
+
+  Future::Ptr close_future(new Future());
+  Future::Ptr connect_future(new Future());
+  Future::Ptr down_future(new Future());
+  Future::Ptr maybe_up_future(new Future());
+  ClusterConnector::Ptr connector(
+      new ClusterConnector(contact_points, PROTOCOL_VERSION,
+                           bind_callback(on_connection_reconnect, connect_future.get())));
+
+  MaybeUpListener::Ptr listener(new MaybeUpListener(close_future, down_future, maybe_up_future));
+
+  ClusterSettings settings;
+  settings.host_probe_interval_ms = 100;
+  connector->with_settings(settings)->with_listener(listener.get())->connect(event_loop());
+
+  ASSERT_TRUE(connect_future->wait_for(WAIT_FOR_TIME));
+  EXPECT_FALSE(connect_future->error());
+
+  Cluster::Ptr cluster(connect_future->cluster());
+
+  // The host is still running so the first probe succeeds and the connection
+  // pools are told to try to reconnect.
+  Address address("127.0.0.2", PORT);
+  cluster->notify_host_down(address);
+  ASSERT_TRUE(down_future->wait_for(WAIT_FOR_TIME));
+  EXPECT_EQ(address, listener->address());
+
+  ASSERT_TRUE(maybe_up_future->wait_for(WAIT_FOR_TIME));
+
+  cluster->close();
+  ASSERT_TRUE(close_future->wait_for(WAIT_FOR_TIME));
+}
+
+TEST_F(ClusterUnitTest, SharedHostTable) {
+  mockssandra::SimpleCluster mock_cluster(simple(), 3);
+  ASSERT_EQ(mock_cluster.start_all(), 0);
+
+  AddressVec contact_points;
+  contact_points.push_back(Address("127.0.0.1", 9042));
+
+  Future::Ptr close_future(new Future());
+  Future::Ptr connect_future(new Future());
+  Future::Ptr down_future(new Future());
+  Future::Ptr maybe_up_future(new Future());
+  ClusterConnector::Ptr connector(
+      new ClusterConnector(contact_points, PROTOCOL_VERSION,
+                           bind_callback(on_connection_reconnect, connect_future.get())));
+
+  MaybeUpListener::Ptr listener(new MaybeUpListener(close_future, down_future, maybe_up_future));
+
+  connector->with_listener(listener.get())->connect(event_loop());
+
+  ASSERT_TRUE(connect_future->wait_for(WAIT_FOR_TIME));
+  EXPECT_FALSE(connect_future->error());
+
+  Cluster::Ptr cluster(connect_future->cluster());
+
+  HostTable::ConstPtr host_table(cluster->host_table());
+  ASSERT_TRUE(host_table);
+  EXPECT_EQ(3u, host_table->hosts().size());
+  EXPECT_EQ(cluster->available_hosts().size(), host_table->hosts().size());
+
+  // The snapshot isn't rebuilt (or copied) until the hosts change
+  EXPECT_EQ(host_table.get(), cluster->host_table().get());
+
+  cluster->close();
+  ASSERT_TRUE(close_future->wait_for(WAIT_FOR_TIME));
+}
+
 TEST_F(ClusterUnitTest, ProtocolNegotiation) {
   mockssandra::SimpleRequestHandlerBuilder builder;
   builder.with_supported_protocol_versions(1, PROTOCOL_VERSION -
@@ -0,0 +1,81 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "collection.hpp"
+#include "serialization.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+TEST(CollectionUnitTest, AppendArrayMatchesAppend) {
+  const cass_int64_t values[] = { 1, -2, 3, 0x7FFFFFFFFFFFFFFFLL };
+  const size_t count = sizeof(values) / sizeof(values[0]);
+
+  Collection expected(CASS_COLLECTION_TYPE_LIST, count);
+  for (size_t i = 0; i < count; ++i) {
+    ASSERT_EQ(CASS_OK, expected.append(values[i]));
+  }
+
+  Collection actual(CASS_COLLECTION_TYPE_LIST, count);
+  ASSERT_EQ(CASS_OK, actual.append_array(values, 2));
+  ASSERT_EQ(CASS_OK, actual.append_array(values + 2, count - 2));
+
+  EXPECT_EQ(count, actual.item_count());
+  Buffer expected_buf(expected.encode_with_length());
+  Buffer actual_buf(actual.encode_with_length());
+  ASSERT_EQ(expected_buf.size(), actual_buf.size());
+  EXPECT_EQ(0, memcmp(expected_buf.data(), actual_buf.data(), actual_buf.size()));
+}
+
+TEST(CollectionUnitTest, AppendArrayInvalidType) {
+  CollectionType::ConstPtr data_type(
+      CollectionType::list(DataType::ConstPtr(new DataType(CASS_VALUE_TYPE_INT)), false));
+  Collection collection(data_type, 2);
+
+  const cass_int64_t values[] = { 1, 2 };
+  EXPECT_EQ(CASS_ERROR_LIB_INVALID_VALUE_TYPE, collection.append_array(values, 2));
+  EXPECT_EQ(0u, collection.item_count());
+
+  const cass_int32_t int_values[] = { 1, 2 };
+  EXPECT_EQ(CASS_OK, collection.append_array(int_values, 2));
+  EXPECT_EQ(2u, collection.item_count());
+}
+
+TEST(CollectionUnitTest, EncodeItems) {
+  Collection collection(CASS_COLLECTION_TYPE_MAP, 2);
+  ASSERT_EQ(CASS_OK, collection.append(CassString("key", 3)));
+  ASSERT_EQ(CASS_OK, collection.append(static_cast<cass_int32_t>(42)));
+
+  Buffer buf(collection.encode_with_length());
+  ASSERT_EQ(4u + 4u + (4u + 3u) + (4u + 4u), buf.size());
+
+  const char* pos = buf.data();
+  int32_t value;
+  pos = decode_int32(pos, value);
+  EXPECT_EQ(static_cast<int32_t>(buf.size() - sizeof(int32_t)), value);
+  pos = decode_int32(pos, value);
+  EXPECT_EQ(1, value); // Number of key/value pairs
+  pos = decode_int32(pos, value);
+  EXPECT_EQ(3, value);
+  EXPECT_EQ(0, memcmp("key", pos, 3));
+  pos = decode_int32(pos + 3, value);
+  EXPECT_EQ(4, value);
+  decode_int32(pos, value);
+  EXPECT_EQ(42, value);
+}
@@ -0,0 +1,111 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "column_handle.hpp"
+#include "result_metadata.hpp"
+#include "scoped_ptr.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+namespace {
+
+ResultMetadata::Ptr create_column_metadata(const char* column_names[]) {
+  size_t count = 0;
+  while (column_names[count] != NULL) {
+    count++;
+  }
+
+  ResultMetadata::Ptr metadata(new ResultMetadata(count, RefBuffer::Ptr()));
+
+  for (size_t i = 0; column_names[i] != NULL; ++i) {
+    ColumnDefinition def;
+    def.name = StringRef(column_names[i]);
+    def.index = i;
+    metadata->add(def);
+  }
+
+  return metadata;
+}
+
+} // namespace
+
+TEST(ColumnHandleUnitTest, Resolve) {
+  const char* column_names[] = { "abc", "def", "abc", "Xyz", NULL };
+  ResultMetadata::Ptr metadata(create_column_metadata(column_names));
+
+  ScopedPtr<ColumnHandle> handle(ColumnHandle::resolve(metadata, "ABC"));
+  ASSERT_TRUE(handle);
+  EXPECT_EQ(2u, handle->indices().size());
+
+  // The handle's indices are used directly with the same metadata
+  IndexVec indices;
+  EXPECT_EQ(&handle->indices(), handle->get_indices(metadata.get(), &indices));
+  EXPECT_TRUE(indices.empty());
+
+  ScopedPtr<ColumnHandle> quoted(ColumnHandle::resolve(metadata, "\"Xyz\""));
+  ASSERT_TRUE(quoted);
+  EXPECT_EQ(3u, quoted->indices()[0]);
+
+  // Unquoted names are case-insensitive but quoted names must match exactly
+  ScopedPtr<ColumnHandle> unquoted(ColumnHandle::resolve(metadata, "xyz"));
+  ASSERT_TRUE(unquoted);
+  EXPECT_EQ(3u, unquoted->indices()[0]);
+  EXPECT_FALSE(ColumnHandle::resolve(metadata, "\"xyz\""));
+  EXPECT_FALSE(ColumnHandle::resolve(metadata, "does_not_exist"));
+  EXPECT_FALSE(ColumnHandle::resolve(ResultMetadata::Ptr(), "abc"));
+}
+
+TEST(ColumnHandleUnitTest, OtherMetadata) {
+  const char* column_names[] = { "abc", "def", NULL };
+  ResultMetadata::Ptr metadata(create_column_metadata(column_names));
+  ScopedPtr<ColumnHandle> handle(ColumnHandle::resolve(metadata, "def"));
+  ASSERT_TRUE(handle);
+
+  { // The same columns (e.g. another page)
+    ResultMetadata::Ptr other(create_column_metadata(column_names));
+    size_t index = 0;
+    EXPECT_TRUE(handle->get_first_index(other.get(), &index));
+    EXPECT_EQ(1u, index);
+
+    IndexVec indices;
+    const IndexVec* result = handle->get_indices(other.get(), &indices);
+    ASSERT_EQ(&indices, result);
+    ASSERT_EQ(1u, indices.size());
+    EXPECT_EQ(1u, indices[0]);
+  }
+
+  { // The column has moved
+    const char* moved_column_names[] = { "xyz", "abc", "def", NULL };
+    ResultMetadata::Ptr moved(create_column_metadata(moved_column_names));
+    size_t index = 0;
+    EXPECT_TRUE(handle->get_first_index(moved.get(), &index));
+    EXPECT_EQ(2u, index);
+  }
+
+  { // The column has been removed
+    const char* removed_column_names[] = { "abc", NULL };
+    ResultMetadata::Ptr removed(create_column_metadata(removed_column_names));
+    size_t index = 0;
+    EXPECT_FALSE(handle->get_first_index(removed.get(), &index));
+
+    IndexVec indices;
+    EXPECT_TRUE(handle->get_indices(removed.get(), &indices) == NULL);
+  }
+}
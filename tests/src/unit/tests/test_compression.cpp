@@ -0,0 +1,99 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "compression.hpp"
+#include "driver_config.hpp"
+#include "scoped_ptr.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+static StringMultimap supported_compression(const char* name) {
+  StringMultimap options;
+  options["COMPRESSION"].push_back(name);
+  return options;
+}
+
+#if defined(HAVE_LZ4) || defined(HAVE_SNAPPY)
+static void round_trip(Compressor* compressor) {
+  String text;
+  for (int i = 0; i < 256; ++i) {
+    text.append("The quick brown fox jumps over the lazy dog. ");
+  }
+
+  // Split the body across several buffers to verify they're gathered
+  BufferVec bufs;
+  size_t half = text.size() / 2;
+  bufs.push_back(Buffer(text.data(), half));
+  bufs.push_back(Buffer(text.data() + half, text.size() - half));
+
+  Buffer compressed;
+  ASSERT_TRUE(compressor->compress(bufs.begin(), bufs.end(), text.size(), &compressed));
+  EXPECT_LT(compressed.size(), text.size());
+
+  RefBuffer::Ptr decompressed;
+  size_t decompressed_length = 0;
+  ASSERT_TRUE(compressor->decompress(compressed.data(), compressed.size(), &decompressed,
+                                     &decompressed_length));
+  ASSERT_EQ(text.size(), decompressed_length);
+  EXPECT_EQ(text, String(decompressed->data(), decompressed_length));
+}
+#endif
+
+TEST(CompressionUnitTest, NoneAlwaysAvailable) {
+  EXPECT_TRUE(Compressor::is_available(CASS_COMPRESSION_NONE));
+  EXPECT_TRUE(Compressor::negotiate(CASS_COMPRESSION_NONE, supported_compression("lz4")) == NULL);
+}
+
+TEST(CompressionUnitTest, NotSupportedByHost) {
+  EXPECT_TRUE(Compressor::negotiate(CASS_COMPRESSION_AUTO, StringMultimap()) == NULL);
+  EXPECT_TRUE(Compressor::negotiate(CASS_COMPRESSION_AUTO, supported_compression("deflate")) ==
+              NULL);
+}
+
+#ifdef HAVE_LZ4
+TEST(CompressionUnitTest, Lz4) {
+  ScopedPtr<Compressor> compressor(
+      Compressor::negotiate(CASS_COMPRESSION_AUTO, supported_compression("lz4")));
+  ASSERT_TRUE(compressor);
+  EXPECT_STREQ("lz4", compressor->name());
+  round_trip(compressor.get());
+}
+#endif
+
+#ifdef HAVE_SNAPPY
+TEST(CompressionUnitTest, Snappy) {
+  ScopedPtr<Compressor> compressor(
+      Compressor::negotiate(CASS_COMPRESSION_AUTO, supported_compression("snappy")));
+  ASSERT_TRUE(compressor);
+  EXPECT_STREQ("snappy", compressor->name());
+  round_trip(compressor.get());
+}
+#endif
+
+#if defined(HAVE_LZ4) && defined(HAVE_SNAPPY)
+TEST(CompressionUnitTest, PreferLz4) {
+  StringMultimap options;
+  options["COMPRESSION"].push_back("snappy");
+  options["COMPRESSION"].push_back("lz4");
+  ScopedPtr<Compressor> compressor(Compressor::negotiate(CASS_COMPRESSION_AUTO, options));
+  ASSERT_TRUE(compressor);
+  EXPECT_STREQ("lz4", compressor->name());
+}
+#endif
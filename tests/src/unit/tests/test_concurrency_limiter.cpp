@@ -0,0 +1,78 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "concurrency_limiter.hpp"
+
+using namespace datastax::internal::core;
+
+#define FAST_NS (1LL * 1000LL * 1000LL)   // 1 ms
+#define SLOW_NS (200LL * 1000LL * 1000LL) // 200 ms
+
+TEST(ConcurrencyLimiterUnitTest, LimitsInflightRequests) {
+  ConcurrencyLimiter limiter(2, 10, 100);
+  Host::Ptr host(new Host(Address("127.0.0.1", 9042)));
+
+  EXPECT_EQ(2, limiter.limit(host.get()));
+  EXPECT_TRUE(limiter.try_acquire(host.get()));
+  host->increment_inflight_requests();
+  EXPECT_TRUE(limiter.try_acquire(host.get()));
+  host->increment_inflight_requests();
+  EXPECT_FALSE(limiter.try_acquire(host.get()));
+
+  host->decrement_inflight_requests();
+  EXPECT_TRUE(limiter.try_acquire(host.get()));
+}
+
+TEST(ConcurrencyLimiterUnitTest, IncreasesAdditively) {
+  ConcurrencyLimiter limiter(2, 4, 100);
+  Host::Ptr host(new Host(Address("127.0.0.1", 9042)));
+
+  // An idle host's limit doesn't grow
+  limiter.record_success(host.get(), FAST_NS);
+  EXPECT_EQ(2, limiter.limit(host.get()));
+
+  host->increment_inflight_requests();
+  limiter.record_success(host.get(), FAST_NS);
+  EXPECT_EQ(3, limiter.limit(host.get()));
+
+  host->increment_inflight_requests();
+  limiter.record_success(host.get(), FAST_NS);
+  EXPECT_EQ(4, limiter.limit(host.get()));
+
+  // The limit doesn't grow past the maximum
+  limiter.record_success(host.get(), FAST_NS);
+  EXPECT_EQ(4, limiter.limit(host.get()));
+}
+
+TEST(ConcurrencyLimiterUnitTest, DecreasesMultiplicatively) {
+  ConcurrencyLimiter limiter(5, 1000, 100);
+  Host::Ptr host(new Host(Address("127.0.0.1", 9042)));
+  host->concurrency_limit().store(100);
+
+  limiter.record_success(host.get(), SLOW_NS);
+  EXPECT_EQ(90, limiter.limit(host.get()));
+
+  limiter.record_failure(host.get());
+  EXPECT_EQ(81, limiter.limit(host.get()));
+
+  // The limit doesn't shrink past the minimum
+  for (int i = 0; i < 100; ++i) {
+    limiter.record_failure(host.get());
+  }
+  EXPECT_EQ(5, limiter.limit(host.get()));
+}
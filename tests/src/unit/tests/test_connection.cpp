@@ -20,7 +20,10 @@
 #include "connector.hpp"
 #include "constants.hpp"
 #include "delayed_connector.hpp"
+#include "frame_capture.hpp"
+#include "query_request.hpp"
 #include "request_callback.hpp"
+#include "serialization.hpp"
 #include "ssl.hpp"
 
 #ifdef WIN32
@@ -111,6 +114,20 @@ public:
         RequestCallback::Ptr(new RequestCallback(state->connection.get(), state)));
   }
 
+  static void on_connection_idle(Connector* connector, State* state) {
+    ASSERT_TRUE(connector->is_ok());
+    state->status = STATUS_CONNECTED;
+    state->connection = connector->release_connection();
+    state->connection->start_heartbeats();
+  }
+
+  static void on_idle_timeout(Timer* timer, State* state) {
+    if (!state->connection->is_closing()) {
+      state->status = STATUS_SUCCESS;
+    }
+    state->connection->close();
+  }
+
   static void on_delayed_error_code(DelayedConnector* connector,
                                     Connector::ConnectionError* error_code) {
     if (!connector->is_ok()) {
@@ -135,6 +152,97 @@ TEST_F(ConnectionUnitTest, Simple) {
   EXPECT_EQ(state.status, STATUS_SUCCESS);
 }
 
+TEST_F(ConnectionUnitTest, Heartbeats) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  State state;
+  Connector::Ptr connector(new Connector(Host::Ptr(new Host(Address("127.0.0.1", PORT))),
+                                         PROTOCOL_VERSION,
+                                         bind_callback(on_connection_idle, &state)));
+
+  ConnectionSettings settings;
+  settings.heartbeat_interval_secs = 1;
+  settings.idle_timeout_secs = 2;
+
+  add_logging_critera("Heartbeat completed on host");
+
+  connector->with_settings(settings)->connect(loop());
+
+  // The heartbeats' responses keep the idle connection from being terminated
+  Timer timer;
+  timer.start(loop(), 3500, bind_callback(on_idle_timeout, &state));
+
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  EXPECT_EQ(state.status, STATUS_SUCCESS);
+  EXPECT_GE(logging_criteria_count(), 2);
+}
+
+TEST_F(ConnectionUnitTest, FrameCapture) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  char tmp[260] = { 0 }; // Note: 260 is the maximum path on Windows
+  size_t tmp_length = 260;
+  uv_os_tmpdir(tmp, &tmp_length);
+  String path(String(tmp, tmp_length) + "/cpp_driver_connection_capture.bin");
+
+  {
+    State state;
+    Connector::Ptr connector(new Connector(Host::Ptr(new Host(Address("127.0.0.1", PORT))),
+                                           PROTOCOL_VERSION,
+                                           bind_callback(on_connection_connected, &state)));
+
+    ConnectionSettings settings;
+    settings.frame_capture.reset(new FrameCapture(path, 1024 * 1024));
+    ASSERT_TRUE(settings.frame_capture->open());
+
+    connector->with_settings(settings)->connect(loop());
+
+    uv_run(loop(), UV_RUN_DEFAULT);
+
+    EXPECT_EQ(state.status, STATUS_SUCCESS);
+  } // The capture file is closed with the connection
+
+  String contents;
+  FILE* file = fopen(path.c_str(), "rb");
+  ASSERT_TRUE(file != NULL);
+  char buf[4096];
+  size_t count;
+  while ((count = fread(buf, 1, sizeof(buf), file)) > 0) {
+    contents.append(buf, count);
+  }
+  fclose(file);
+  remove(path.c_str());
+
+  // The startup requests and the query are each followed by their response
+  Vector<std::pair<int8_t, int8_t> > frames; // Direction and opcode
+  const char* pos = contents.data() + FRAME_CAPTURE_MAGIC_SIZE;
+  const char* end = contents.data() + contents.size();
+  while (pos < end) {
+    int64_t timestamp;
+    int32_t connection_id, size;
+    int8_t direction;
+    pos = decode_int64(pos, timestamp);
+    pos = decode_int32(pos, connection_id);
+    pos = decode_int8(pos, direction);
+    pos = decode_int32(pos, size);
+    ASSERT_GE(size, 9); // The envelope's header
+    frames.push_back(std::make_pair(direction, static_cast<int8_t>(pos[4])));
+    pos += size;
+  }
+
+  ASSERT_GE(frames.size(), 4u);
+  EXPECT_EQ(0, frames.size() % 2);
+  for (size_t i = 0; i < frames.size(); i += 2) {
+    EXPECT_EQ(FrameCapture::DIRECTION_REQUEST, frames[i].first);
+    EXPECT_EQ(FrameCapture::DIRECTION_RESPONSE, frames[i + 1].first);
+  }
+  EXPECT_EQ(CQL_OPCODE_QUERY, frames[frames.size() - 2].second);
+  EXPECT_EQ(CQL_OPCODE_RESULT, frames[frames.size() - 1].second);
+}
+
 TEST_F(ConnectionUnitTest, Keyspace) {
   mockssandra::SimpleRequestHandlerBuilder builder;
   builder.on(mockssandra::OPCODE_QUERY).use_keyspace("foo").validate_query().void_result();
@@ -155,6 +263,70 @@ TEST_F(ConnectionUnitTest, Keyspace) {
   EXPECT_EQ(state.connection->keyspace(), "foo");
 }
 
+TEST_F(ConnectionUnitTest, CachedSupportedOptions) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Host::Ptr host(new Host(Address("127.0.0.1", PORT)));
+
+  {
+    State state;
+    Connector::Ptr connector(
+        new Connector(host, PROTOCOL_VERSION, bind_callback(on_connection_connected, &state)));
+    connector->connect(loop());
+    uv_run(loop(), UV_RUN_DEFAULT);
+    EXPECT_EQ(state.status, STATUS_SUCCESS);
+  }
+
+  // The first connection caches the host's SUPPORTED response
+  StringMultimap options;
+  ASSERT_TRUE(host->supported_options(&options));
+  EXPECT_EQ(1u, options.count("CQL_VERSION"));
+
+  // An empty response is cached too
+  host->clear_supported_options();
+  EXPECT_FALSE(host->supported_options(&options));
+  host->set_supported_options(StringMultimap());
+  EXPECT_TRUE(host->supported_options(&options));
+  EXPECT_TRUE(options.empty());
+
+  // Later connections use the cached options instead of sending OPTIONS
+  options["CACHED"].push_back("true");
+  host->set_supported_options(options);
+
+  State state;
+  Connector::Ptr connector(
+      new Connector(host, PROTOCOL_VERSION, bind_callback(on_connection_connected, &state)));
+  connector->connect(loop());
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  EXPECT_EQ(state.status, STATUS_SUCCESS);
+  EXPECT_EQ(1u, connector->supported_options().count("CACHED"));
+}
+
+TEST_F(ConnectionUnitTest, PipelinedKeyspace) {
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(mockssandra::OPCODE_QUERY).use_keyspace("foo").validate_query().void_result();
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  State state;
+  Connector::Ptr connector(new Connector(Host::Ptr(new Host(Address("127.0.0.1", PORT))),
+                                         PROTOCOL_VERSION,
+                                         bind_callback(on_connection_connected, &state)));
+
+  // The USE request is written right after the STARTUP request
+  ConnectionSettings settings;
+  settings.pipelined_startup = true;
+  connector->with_settings(settings)->with_keyspace("foo")->connect(loop());
+
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  EXPECT_EQ(state.status, STATUS_SUCCESS);
+  ASSERT_TRUE(static_cast<bool>(state.connection));
+  EXPECT_EQ(state.connection->keyspace(), "foo");
+}
+
 TEST_F(ConnectionUnitTest, Auth) {
   mockssandra::SimpleCluster cluster(auth());
   ASSERT_EQ(cluster.start_all(), 0);
@@ -371,6 +543,39 @@ TEST_F(ConnectionUnitTest, DeprecatedProtocol) {
   EXPECT_EQ(Connector::CONNECTION_ERROR_INVALID_PROTOCOL, error_code);
 }
 
+TEST_F(ConnectionUnitTest, CachedProtocolVersion) {
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.with_supported_protocol_versions(1, PROTOCOL_VERSION - 1);
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Host::Ptr host(new Host(Address("127.0.0.1", PORT)));
+
+  {
+    // The rejected version isn't a critical error because there's a lower
+    // version for the next connection to try
+    Connector::ConnectionError error_code(Connector::CONNECTION_OK);
+    Connector::Ptr connector(new Connector(host, PROTOCOL_VERSION,
+                                           bind_callback(on_connection_error_code, &error_code)));
+    connector->connect(loop());
+    uv_run(loop(), UV_RUN_DEFAULT);
+    EXPECT_EQ(Connector::CONNECTION_ERROR_INVALID_PROTOCOL, error_code);
+    EXPECT_FALSE(connector->is_critical_error());
+    EXPECT_EQ(ProtocolVersion(PROTOCOL_VERSION - 1), host->protocol_version());
+  }
+
+  // The next connection starts with the host's lower version
+  State state;
+  Connector::Ptr connector(
+      new Connector(host, PROTOCOL_VERSION, bind_callback(on_connection_connected, &state)));
+  EXPECT_EQ(ProtocolVersion(PROTOCOL_VERSION - 1), connector->protocol_version());
+  connector->connect(loop());
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  EXPECT_EQ(state.status, STATUS_SUCCESS);
+  EXPECT_EQ(ProtocolVersion(PROTOCOL_VERSION - 1), host->protocol_version());
+}
+
 TEST_F(ConnectionUnitTest, InvalidAuth) {
   mockssandra::SimpleCluster cluster(auth());
   ASSERT_EQ(cluster.start_all(), 0);
@@ -490,3 +695,43 @@ TEST_F(ConnectionUnitTest, DelayedCancel) {
 
   EXPECT_EQ(Connector::CONNECTION_CANCELED, error_code);
 }
+
+class WriteErrorRequestCallback : public RequestCallback {
+public:
+  WriteErrorRequestCallback(bool is_idempotent)
+      : RequestCallback(RequestWrapper(make_request(is_idempotent)))
+      , retried_next_host(false)
+      , error_code(CASS_OK) {}
+
+  virtual void on_retry_current_host() {}
+  virtual void on_retry_next_host() { retried_next_host = true; }
+  virtual void on_write(Connection* connection) {}
+  virtual void on_set(ResponseMessage* response) {}
+  virtual void on_error(CassError code, const String& message) { error_code = code; }
+
+  bool retried_next_host;
+  CassError error_code;
+
+private:
+  static Request::ConstPtr make_request(bool is_idempotent) {
+    QueryRequest::Ptr request(new QueryRequest("SELECT * FROM blah"));
+    request->set_is_idempotent(is_idempotent);
+    return request;
+  }
+};
+
+TEST(ConnectionWriteErrorUnitTest, RetryIdempotentOnNextHost) {
+  { // An idempotent request is sent to the next host
+    SharedRefPtr<WriteErrorRequestCallback> write_error(new WriteErrorRequestCallback(true));
+    write_error->on_write_error();
+    EXPECT_TRUE(write_error->retried_next_host);
+    EXPECT_EQ(CASS_OK, write_error->error_code);
+  }
+
+  { // Otherwise, the request could have been applied so it fails
+    SharedRefPtr<WriteErrorRequestCallback> write_error(new WriteErrorRequestCallback(false));
+    write_error->on_write_error();
+    EXPECT_FALSE(write_error->retried_next_host);
+    EXPECT_EQ(CASS_ERROR_LIB_WRITE_ERROR, write_error->error_code);
+  }
+}
@@ -0,0 +1,112 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "continuous_paging.hpp"
+#include "result_response.hpp"
+#include "revise_request.hpp"
+#include "serialization.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+class ContinuousPagingUnitTest : public testing::Test {
+public:
+  void append_int32(String* data, int32_t value) {
+    char buf[sizeof(int32_t)];
+    encode_int32(buf, value);
+    data->append(buf, sizeof(buf));
+  }
+
+  String rows(int32_t flags, int32_t page_number) {
+    String data;
+    append_int32(&data, CASS_RESULT_KIND_ROWS);
+    append_int32(&data, flags | CASS_RESULT_FLAG_NO_METADATA);
+    append_int32(&data, 1); // Column count
+    if (flags & CASS_RESULT_FLAG_CONTINUOUS_PAGING) {
+      append_int32(&data, page_number);
+    }
+    append_int32(&data, 0); // Row count
+    return data;
+  }
+};
+
+TEST_F(ContinuousPagingUnitTest, DecodePages) {
+  {
+    String data(rows(0, 0));
+    Decoder decoder(data.data(), data.size(), ProtocolVersion(CASS_PROTOCOL_VERSION_DSEV2));
+    ResultResponse result;
+    ASSERT_TRUE(result.decode(decoder));
+    EXPECT_FALSE(result.is_continuous_page());
+    EXPECT_FALSE(result.is_last_continuous_page());
+  }
+
+  {
+    String data(rows(CASS_RESULT_FLAG_CONTINUOUS_PAGING, 3));
+    Decoder decoder(data.data(), data.size(), ProtocolVersion(CASS_PROTOCOL_VERSION_DSEV2));
+    ResultResponse result;
+    ASSERT_TRUE(result.decode(decoder));
+    EXPECT_TRUE(result.is_continuous_page());
+    EXPECT_EQ(3, result.continuous_page_number());
+    EXPECT_FALSE(result.is_last_continuous_page());
+  }
+
+  {
+    String data(rows(CASS_RESULT_FLAG_CONTINUOUS_PAGING | CASS_RESULT_FLAG_LAST_CONTINUOUS_PAGE, 4));
+    Decoder decoder(data.data(), data.size(), ProtocolVersion(CASS_PROTOCOL_VERSION_DSEV1));
+    ResultResponse result;
+    ASSERT_TRUE(result.decode(decoder));
+    EXPECT_TRUE(result.is_continuous_page());
+    EXPECT_EQ(4, result.continuous_page_number());
+    EXPECT_TRUE(result.is_last_continuous_page());
+  }
+}
+
+TEST_F(ContinuousPagingUnitTest, EncodeRevise) {
+  BufferVec bufs;
+  Request::ConstPtr more(new ReviseRequest(CASS_REVISION_TYPE_MORE_CONTINUOUS_PAGES, 42, 8));
+  EXPECT_EQ(12, more->encode(ProtocolVersion(CASS_PROTOCOL_VERSION_DSEV2), NULL, &bufs));
+  EXPECT_EQ(String("\x00\x00\x00\x02\x00\x00\x00\x2A\x00\x00\x00\x08", 12),
+            String(bufs.back().data(), bufs.back().size()));
+  EXPECT_EQ(CQL_OPCODE_CANCEL, more->opcode());
+
+  // Canceling doesn't have the number of pages
+  Request::ConstPtr cancel(new ReviseRequest(CASS_REVISION_TYPE_CANCEL_CONTINUOUS_PAGING, 42));
+  EXPECT_EQ(8, cancel->encode(ProtocolVersion(CASS_PROTOCOL_VERSION_DSEV2), NULL, &bufs));
+  EXPECT_EQ(String("\x00\x00\x00\x01\x00\x00\x00\x2A", 8),
+            String(bufs.back().data(), bufs.back().size()));
+}
+
+TEST_F(ContinuousPagingUnitTest, Options) {
+  DseContinuousPaging* paging = dse_continuous_paging_new();
+  EXPECT_EQ(CASS_OK, dse_continuous_paging_set_max_pages(paging, 100));
+  EXPECT_EQ(CASS_OK, dse_continuous_paging_set_pages_per_second(paging, 10));
+  EXPECT_EQ(CASS_OK, dse_continuous_paging_set_max_enqueued_pages(paging, 4));
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS, dse_continuous_paging_set_max_pages(paging, -1));
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS, dse_continuous_paging_set_max_enqueued_pages(paging, -1));
+
+  const ContinuousPagingOptions& options = paging->options();
+  EXPECT_EQ(100, options.max_pages);
+  EXPECT_EQ(10, options.pages_per_second);
+  EXPECT_EQ(4, options.max_enqueued_pages);
+
+  // There are no pages before the request is started
+  EXPECT_TRUE(dse_continuous_paging_next_page(paging) == NULL);
+  EXPECT_EQ(CASS_OK, dse_continuous_paging_error_code(paging));
+  dse_continuous_paging_free(paging);
+}
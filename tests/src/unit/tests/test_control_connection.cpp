@@ -193,6 +193,12 @@ public:
     }
   }
 
+  static void on_connection_schema(ControlConnector* connector, ControlConnectionSchema* schema) {
+    if (connector->is_ok()) {
+      *schema = connector->schema();
+    }
+  }
+
   static void on_connection_close(ControlConnector* connector, bool* is_closed) {
     if (connector->error_code() == ControlConnector::CONTROL_CONNECTION_ERROR_CLOSE) {
       *is_closed = true;
@@ -208,15 +214,16 @@ public:
 
   struct EventListener : public RecordingControlConnectionListener {
   public:
-    EventListener(mockssandra::SimpleCluster* cluster)
+    EventListener(mockssandra::SimpleCluster* cluster, int expected_events = -1)
         : remaining_(0)
+        , expected_events_(expected_events)
         , cluster_(cluster) {}
 
     void add_event(const mockssandra::Event::Ptr& event) { events_.push_back(event); }
 
     void trigger_events(const ControlConnection::Ptr& connection) {
       connection_ = connection;
-      remaining_ = events_.size();
+      remaining_ = expected_events_ >= 0 ? expected_events_ : static_cast<int>(events_.size());
       for (Vector<mockssandra::Event::Ptr>::const_iterator it = events_.begin(),
                                                            end = events_.end();
            it != end; ++it) {
@@ -261,6 +268,7 @@ public:
   private:
     Vector<mockssandra::Event::Ptr> events_;
     int remaining_;
+    int expected_events_;
     mockssandra::SimpleCluster* cluster_;
     ControlConnection::Ptr connection_;
   };
@@ -431,6 +439,53 @@ TEST_F(ControlConnectionUnitTest, TopologyChangeEvents) {
   EXPECT_EQ(address2, event2.host->address());
 }
 
+TEST_F(ControlConnectionUnitTest, DebouncedEvents) {
+  mockssandra::SimpleCluster cluster(simple(), 3);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Address address1("127.0.0.1", PORT);
+  Address address2("127.0.0.2", PORT);
+  Address address3("127.0.0.3", PORT);
+
+  // Duplicate events are coalesced into a single refresh
+  EventListener listener(&cluster, 3);
+
+  listener.add_event(TopologyChangeEvent::new_node(address2));
+  listener.add_event(TopologyChangeEvent::new_node(address3));
+  listener.add_event(TopologyChangeEvent::new_node(address2));
+  listener.add_event(SchemaChangeEvent::keyspace(SchemaChangeEvent::UPDATED, "keyspace1"));
+  listener.add_event(SchemaChangeEvent::keyspace(SchemaChangeEvent::UPDATED, "keyspace1"));
+
+  ControlConnectionSettings settings;
+  settings.event_debounce_window_ms = 100;
+
+  ControlConnector::Ptr connector(
+      new ControlConnector(Host::Ptr(new Host(address1)), PROTOCOL_VERSION,
+                           bind_callback(on_connection_event, &listener)));
+  connector->with_settings(settings)->with_listener(&listener)->connect(loop());
+
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  ASSERT_EQ(3u, listener.events().size());
+
+  unsigned added_count = 0;
+  unsigned keyspace_updated_count = 0;
+  for (RecordedEventVec::const_iterator it = listener.events().begin(),
+                                        end = listener.events().end();
+       it != end; ++it) {
+    if (it->type == RecordedEvent::NODE_ADDED) {
+      EXPECT_TRUE(it->host->address() == address2 || it->host->address() == address3);
+      EXPECT_GT(it->host->tokens().size(), 0u);
+      added_count++;
+    } else if (it->type == RecordedEvent::KEYSPACE_UPDATED) {
+      EXPECT_EQ("keyspace1", it->keyspace_name);
+      keyspace_updated_count++;
+    }
+  }
+  EXPECT_EQ(2u, added_count);
+  EXPECT_EQ(1u, keyspace_updated_count);
+}
+
 TEST_F(ControlConnectionUnitTest, SchemaChangeEvents) {
   mockssandra::SimpleCluster cluster(simple());
   ASSERT_EQ(cluster.start_all(), 0);
@@ -567,6 +622,76 @@ TEST_F(ControlConnectionUnitTest, EventDuringStartup) {
   EXPECT_EQ(address, event1.host->address());
 }
 
+TEST_F(ControlConnectionUnitTest, UnchangedSchemaVersion) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Address address("127.0.0.1", PORT);
+
+  ControlConnectionSchema schema;
+  ControlConnector::Ptr connector(
+      new ControlConnector(Host::Ptr(new Host(address)), PROTOCOL_VERSION,
+                           bind_callback(on_connection_schema, &schema)));
+  connector->connect(loop());
+
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  ASSERT_FALSE(schema.version.empty());
+  EXPECT_FALSE(schema.is_unchanged);
+  EXPECT_TRUE(schema.keyspaces);
+  EXPECT_TRUE(schema.tables);
+
+  // Reconnecting with the same schema version only queries the keyspaces
+  ControlConnectionSchema unchanged_schema;
+  ControlConnector::Ptr reconnector(
+      new ControlConnector(Host::Ptr(new Host(address)), PROTOCOL_VERSION,
+                           bind_callback(on_connection_schema, &unchanged_schema)));
+  reconnector->with_schema_version(schema.version, connector->server_version())->connect(loop());
+
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  EXPECT_EQ(schema.version, unchanged_schema.version);
+  EXPECT_TRUE(unchanged_schema.is_unchanged);
+  EXPECT_TRUE(unchanged_schema.keyspaces);
+  EXPECT_FALSE(unchanged_schema.tables);
+
+  // A different schema version requires a full refresh
+  ControlConnectionSchema changed_schema;
+  ControlConnector::Ptr changed_reconnector(
+      new ControlConnector(Host::Ptr(new Host(address)), PROTOCOL_VERSION,
+                           bind_callback(on_connection_schema, &changed_schema)));
+  changed_reconnector->with_schema_version("different", connector->server_version())
+      ->connect(loop());
+
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  EXPECT_FALSE(changed_schema.is_unchanged);
+  EXPECT_TRUE(changed_schema.tables);
+}
+
+TEST_F(ControlConnectionUnitTest, DeferredSchema) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  ControlConnectionSchema schema;
+  ControlConnector::Ptr connector(
+      new ControlConnector(Host::Ptr(new Host(Address("127.0.0.1", PORT))), PROTOCOL_VERSION,
+                           bind_callback(on_connection_schema, &schema)));
+  connector->with_deferred_schema(true)->connect(loop());
+
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  // Only the keyspaces are queried, the caller queries the rest of the schema
+  EXPECT_TRUE(schema.is_deferred);
+  EXPECT_TRUE(schema.keyspaces);
+  EXPECT_FALSE(schema.tables);
+  EXPECT_FALSE(schema.columns);
+
+  EXPECT_GT(connector->timings().control_connection, 0u);
+  EXPECT_GT(connector->timings().hosts_query, 0u);
+  EXPECT_GT(connector->timings().schema_query, 0u);
+}
+
 TEST_F(ControlConnectionUnitTest, InvalidProtocol) {
   mockssandra::SimpleCluster cluster(simple());
   ASSERT_EQ(cluster.start_all(), 0);
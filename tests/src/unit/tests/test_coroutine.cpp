@@ -0,0 +1,109 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+// This file is only compiled as C++20 when the compiler supports it (see the
+// unit tests' CMakeLists.txt)
+#if defined(__cpp_impl_coroutine) && __cplusplus >= 202002L
+
+#include <gtest/gtest.h>
+
+#include "cassandra_coroutine.hpp"
+#include "test_future_utils.hpp"
+
+#include <atomic>
+#include <thread>
+
+namespace {
+
+// An eagerly started coroutine that records the error code of the future it
+// awaits and the thread it was resumed on
+struct AwaitTask {
+  struct promise_type {
+    AwaitTask get_return_object() { return AwaitTask(); }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+struct AwaitResult {
+  AwaitResult()
+      : rc(CASS_OK)
+      , is_done(false) {}
+
+  CassError rc;
+  std::thread::id resumed_on;
+  std::atomic<bool> is_done;
+};
+
+AwaitTask await_future(const cass::Future& future, AwaitResult* result) {
+  result->rc = co_await future;
+  result->resumed_on = std::this_thread::get_id();
+  result->is_done.store(true);
+}
+
+// Keeps the coroutine's handle so that the test's thread resumes it
+struct HandleExecutor {
+  void operator()(std::coroutine_handle<> handle) const { handle_->store(handle.address()); }
+  std::atomic<void*>* handle_;
+};
+
+AwaitTask await_future_via(const cass::Future& future, HandleExecutor executor,
+                           AwaitResult* result) {
+  result->rc = co_await future.via(executor);
+  result->resumed_on = std::this_thread::get_id();
+  result->is_done.store(true);
+}
+
+} // namespace
+
+TEST(CoroutineUnitTest, AwaitCompletedFuture) {
+  cass::Future future(test::future_new());
+  test::future_set_error(future.get(), CASS_ERROR_LIB_REQUEST_TIMED_OUT);
+
+  // The coroutine isn't suspended so it completes on this thread
+  AwaitResult result;
+  await_future(future, &result);
+  EXPECT_TRUE(result.is_done.load());
+  EXPECT_EQ(CASS_ERROR_LIB_REQUEST_TIMED_OUT, result.rc);
+  EXPECT_EQ(std::this_thread::get_id(), result.resumed_on);
+}
+
+TEST(CoroutineUnitTest, AwaitFutureViaExecutor) {
+  cass::Future future(test::future_new());
+
+  std::atomic<void*> handle(nullptr);
+  AwaitResult result;
+  await_future_via(future, HandleExecutor{ &handle }, &result);
+  EXPECT_FALSE(result.is_done.load());
+  EXPECT_TRUE(handle.load() == nullptr);
+
+  // The thread that completes the future passes the coroutine to the
+  // executor instead of resuming it
+  CassFuture* pending = future.get();
+  std::thread thread([pending] { test::future_set(pending); });
+  thread.join();
+  ASSERT_TRUE(handle.load() != nullptr);
+  EXPECT_FALSE(result.is_done.load());
+
+  std::coroutine_handle<>::from_address(handle.load()).resume();
+  EXPECT_TRUE(result.is_done.load());
+  EXPECT_EQ(CASS_OK, result.rc);
+  EXPECT_EQ(std::this_thread::get_id(), result.resumed_on);
+}
+
+#endif
@@ -0,0 +1,82 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "query_request.hpp"
+#include "request.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+class CustomPayloadUnitTest : public testing::Test {
+public:
+  static CustomPayload* create_payload() {
+    CustomPayload* payload = new CustomPayload();
+    payload->set("tenant", 6, reinterpret_cast<const uint8_t*>("abc"), 3);
+    payload->set("routing", 7, reinterpret_cast<const uint8_t*>("a routing hint"), 14);
+    return payload;
+  }
+
+  static String encode(const Request& request, size_t* num_bufs = NULL) {
+    BufferVec bufs;
+    int32_t length = request.encode_custom_payload(&bufs);
+    String encoded;
+    for (BufferVec::const_iterator it = bufs.begin(), end = bufs.end(); it != end; ++it) {
+      encoded.append(it->data(), it->size());
+    }
+    EXPECT_EQ(static_cast<size_t>(length), encoded.size());
+    if (num_bufs) *num_bufs = bufs.size();
+    return encoded;
+  }
+};
+
+TEST_F(CustomPayloadUnitTest, Frozen) {
+  QueryRequest request("SELECT * FROM table");
+  request.set_custom_payload(create_payload());
+  size_t num_bufs;
+  String expected(encode(request, &num_bufs));
+  EXPECT_EQ(3u, num_bufs); // The count and an item per buffer
+
+  CustomPayload* payload = create_payload();
+  payload->freeze();
+  EXPECT_TRUE(payload->is_frozen());
+  QueryRequest frozen_request("SELECT * FROM table");
+  frozen_request.set_custom_payload(payload);
+  EXPECT_EQ(expected, encode(frozen_request, &num_bufs));
+  EXPECT_EQ(1u, num_bufs); // Referenced as a single, pre-encoded buffer
+
+  // Frozen payloads can't be changed
+  payload->set("other", 5, reinterpret_cast<const uint8_t*>("x"), 1);
+  payload->remove("tenant", 6);
+  EXPECT_EQ(2u, payload->size());
+  EXPECT_EQ(expected, encode(frozen_request));
+}
+
+TEST_F(CustomPayloadUnitTest, FrozenWithExtraItems) {
+  QueryRequest request("SELECT * FROM table");
+  request.set_custom_payload(create_payload());
+  request.set_custom_payload("ProxyExecute", reinterpret_cast<const uint8_t*>("user"), 4);
+
+  CustomPayload* payload = create_payload();
+  payload->freeze();
+  QueryRequest frozen_request("SELECT * FROM table");
+  frozen_request.set_custom_payload(payload);
+  frozen_request.set_custom_payload("ProxyExecute", reinterpret_cast<const uint8_t*>("user"), 4);
+
+  EXPECT_EQ(encode(request), encode(frozen_request));
+}
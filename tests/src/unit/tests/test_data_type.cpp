@@ -18,11 +18,14 @@
 
 #include "cassandra.h"
 #include "data_type.hpp"
+#include "result_response.hpp"
+#include "serialization.hpp"
 
 #include <algorithm>
 #include <ctype.h>
 
 using namespace datastax;
+using namespace datastax::internal;
 using namespace datastax::internal::core;
 
 class DataTypeWrapper {
@@ -437,3 +440,82 @@ TEST(DataTypeUnitTest, SimpleDataTypeCache) {
   EXPECT_EQ(by_class.get(), by_cql.get());
   EXPECT_EQ(by_class.get(), by_value_type.get());
 }
+
+TEST(DataTypeUnitTest, SimpleDataTypesAreShared) {
+  SimpleDataTypeCache cache1;
+  SimpleDataTypeCache cache2;
+  EXPECT_EQ(cache1.by_value_type(CASS_VALUE_TYPE_INT).get(),
+            cache2.by_value_type(CASS_VALUE_TYPE_INT).get());
+}
+
+static void append_uint16(String* data, uint16_t value) {
+  char buf[sizeof(uint16_t)];
+  encode_uint16(buf, value);
+  data->append(buf, sizeof(buf));
+}
+
+static void append_int32(String* data, int32_t value) {
+  char buf[sizeof(int32_t)];
+  encode_int32(buf, value);
+  data->append(buf, sizeof(buf));
+}
+
+static void append_string(String* data, const String& value) {
+  append_uint16(data, value.size());
+  data->append(value);
+}
+
+// Decode the type of a result's only column
+static DataType::ConstPtr decode_column_type(const String& encoded_type) {
+  String data;
+  append_int32(&data, CASS_RESULT_KIND_ROWS);
+  append_int32(&data, CASS_RESULT_FLAG_GLOBAL_TABLESPEC);
+  append_int32(&data, 1); // Column count
+  append_string(&data, "keyspace");
+  append_string(&data, "table");
+  append_string(&data, "column");
+  data.append(encoded_type);
+  append_int32(&data, 0); // Row count
+
+  ResultResponse result;
+  Decoder decoder(data.data(), data.size(), ProtocolVersion(CASS_PROTOCOL_VERSION_V4));
+  EXPECT_TRUE(result.decode(decoder));
+  return result.metadata()->get_column_definition(0).data_type;
+}
+
+TEST(DataTypeUnitTest, DataTypeCache) {
+  // map<text, tuple<int, list<int>>>
+  String encoded;
+  append_uint16(&encoded, CASS_VALUE_TYPE_MAP);
+  append_uint16(&encoded, CASS_VALUE_TYPE_VARCHAR);
+  append_uint16(&encoded, CASS_VALUE_TYPE_TUPLE);
+  append_uint16(&encoded, 2);
+  append_uint16(&encoded, CASS_VALUE_TYPE_INT);
+  append_uint16(&encoded, CASS_VALUE_TYPE_LIST);
+  append_uint16(&encoded, CASS_VALUE_TYPE_INT);
+
+  DataType::ConstPtr data_type(decode_column_type(encoded));
+  ASSERT_TRUE(data_type);
+  EXPECT_EQ("map<varchar, tuple<int, list<int>>>", data_type->to_string());
+
+  // The decoded types, including the nested types, are interned
+  EXPECT_EQ(data_type.get(), decode_column_type(encoded).get());
+  EXPECT_EQ(data_type.get(), DataTypeCache::get(encoded).get());
+
+  String list;
+  append_uint16(&list, CASS_VALUE_TYPE_LIST);
+  append_uint16(&list, CASS_VALUE_TYPE_INT);
+  DataType::ConstPtr list_type(decode_column_type(list));
+  ASSERT_TRUE(list_type);
+  EXPECT_EQ(list_type.get(), DataTypeCache::get(list).get());
+  EXPECT_TRUE(list_type->equals(list_type));
+
+  // Types are keyed by their whole structure
+  String set;
+  append_uint16(&set, CASS_VALUE_TYPE_SET);
+  append_uint16(&set, CASS_VALUE_TYPE_INT);
+  DataType::ConstPtr set_type(decode_column_type(set));
+  ASSERT_TRUE(set_type);
+  EXPECT_NE(list_type.get(), set_type.get());
+  EXPECT_FALSE(list_type->equals(set_type));
+}
@@ -81,6 +81,99 @@ TEST_F(LineStringUnitTest, BinaryMultiple) {
   ASSERT_EQ(5.0, y);
 }
 
+TEST_F(LineStringUnitTest, BinaryMultiplePoints) {
+  const cass_double_t points[] = { 0.0, 1.0, 2.0, 3.0, 4.0, 5.0 };
+  ASSERT_EQ(CASS_OK, dse_line_string_add_point(line_string, -1.0, -2.0));
+  ASSERT_EQ(CASS_OK, dse_line_string_add_points(line_string, points, 3));
+  ASSERT_EQ(CASS_OK, dse_line_string_finish(line_string));
+
+  ASSERT_EQ(CASS_OK, iterator.reset_binary(to_value()));
+  ASSERT_EQ(4u, iterator.num_points());
+
+  cass_double_t x, y;
+  ASSERT_EQ(CASS_OK, iterator.next_point(&x, &y));
+  ASSERT_EQ(-1.0, x);
+  ASSERT_EQ(-2.0, y);
+
+  cass_double_t result[6];
+  ASSERT_EQ(CASS_OK, iterator.next_points(result, 3));
+  for (size_t i = 0; i < 6; ++i) {
+    ASSERT_EQ(points[i], result[i]);
+  }
+
+  // No more points
+  ASSERT_EQ(CASS_ERROR_LIB_INVALID_STATE, iterator.next_points(result, 1));
+}
+
+TEST_F(LineStringUnitTest, BinaryOtherByteOrder) {
+  WkbByteOrder byte_order = native_byte_order() == WKB_BYTE_ORDER_LITTLE_ENDIAN
+                                ? WKB_BYTE_ORDER_BIG_ENDIAN
+                                : WKB_BYTE_ORDER_LITTLE_ENDIAN;
+  const cass_double_t points[] = { 0.5, 1.5, 2.5, 3.5 };
+
+  Bytes bytes;
+  bytes.push_back(byte_order);
+  encode_append(swap_uint32(WKB_GEOMETRY_TYPE_LINESTRING), bytes);
+  encode_append(swap_uint32(2), bytes);
+  for (size_t i = 0; i < 4; ++i) {
+    cass_uint64_t temp;
+    memcpy(&temp, &points[i], sizeof(cass_uint64_t));
+    encode_append(swap_uint64(temp), bytes);
+  }
+
+  value = Value(DataType::ConstPtr(new CustomType(DSE_LINE_STRING_TYPE)),
+                Decoder(reinterpret_cast<char*>(bytes.data()), bytes.size(), 0));
+  ASSERT_EQ(CASS_OK, iterator.reset_binary(CassValue::to(&value)));
+  ASSERT_EQ(2u, iterator.num_points());
+
+  cass_double_t x, y;
+  ASSERT_EQ(CASS_OK, iterator.next_point(&x, &y));
+  ASSERT_EQ(0.5, x);
+  ASSERT_EQ(1.5, y);
+
+  ASSERT_EQ(CASS_OK, iterator.next_points(&x, 0));
+
+  cass_double_t result[2];
+  ASSERT_EQ(CASS_OK, iterator.next_points(result, 1));
+  ASSERT_EQ(2.5, result[0]);
+  ASSERT_EQ(3.5, result[1]);
+}
+
+TEST_F(LineStringUnitTest, ValueGetPoints) {
+  const cass_double_t points[] = { 0.0, 1.0, 2.0, 3.0, 4.0, 5.0 };
+  ASSERT_EQ(CASS_OK, dse_line_string_add_points(line_string, points, 3));
+  ASSERT_EQ(CASS_OK, dse_line_string_finish(line_string));
+
+  cass_uint32_t num_points = 0;
+  ASSERT_EQ(CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS,
+            cass_value_get_dse_line_string(to_value(), NULL, 0, &num_points));
+  ASSERT_EQ(3u, num_points);
+
+  cass_double_t result[6];
+  ASSERT_EQ(CASS_OK, cass_value_get_dse_line_string(to_value(), result, 3, &num_points));
+  ASSERT_EQ(3u, num_points);
+  for (size_t i = 0; i < 6; ++i) {
+    ASSERT_EQ(points[i], result[i]);
+  }
+}
+
+TEST_F(LineStringUnitTest, ValueGetPointsNotEnoughData) {
+  const cass_double_t points[] = { 0.0, 1.0, 2.0, 3.0 };
+  ASSERT_EQ(CASS_OK, dse_line_string_add_points(line_string, points, 2));
+  ASSERT_EQ(CASS_OK, dse_line_string_finish(line_string));
+
+  // Claim more points than the value holds
+  Bytes bytes(line_string->bytes());
+  encode(0x80000000u, WKB_HEADER_SIZE, bytes);
+  value = Value(DataType::ConstPtr(new CustomType(DSE_LINE_STRING_TYPE)),
+                Decoder(reinterpret_cast<char*>(bytes.data()), bytes.size(), 0));
+
+  cass_double_t result[4];
+  cass_uint32_t num_points;
+  ASSERT_EQ(CASS_ERROR_LIB_NOT_ENOUGH_DATA,
+            cass_value_get_dse_line_string(CassValue::to(&value), result, 2, &num_points));
+}
+
 TEST_F(LineStringUnitTest, TextMissingY) {
   ASSERT_EQ(CASS_ERROR_LIB_BAD_PARAMS, RESET_ITERATOR_WITH("LINESTRING (1)"));
 }
@@ -194,3 +287,21 @@ TEST_F(LineStringUnitTest, TextTrailingSpace) {
   ASSERT_EQ(1.0, x);
   ASSERT_EQ(3.0, y);
 }
+
+TEST_F(LineStringUnitTest, TextMultiplePoints) {
+  ASSERT_EQ(CASS_OK,
+            RESET_ITERATOR_WITH("LINESTRING (0.1 -2.5e3, 1.2345678901234567 -0.0001, 1e-30 +7)"));
+  ASSERT_EQ(3u, iterator.num_points());
+
+  cass_double_t result[6];
+  ASSERT_EQ(CASS_OK, iterator.next_points(result, 3));
+  ASSERT_EQ(0.1, result[0]);
+  ASSERT_EQ(-2.5e3, result[1]);
+  ASSERT_EQ(1.2345678901234567, result[2]);
+  ASSERT_EQ(-0.0001, result[3]);
+  ASSERT_EQ(1e-30, result[4]);
+  ASSERT_EQ(7.0, result[5]);
+
+  // No more points
+  ASSERT_EQ(CASS_ERROR_LIB_INVALID_STATE, iterator.next_points(result, 1));
+}
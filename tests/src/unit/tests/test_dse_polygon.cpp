@@ -139,6 +139,73 @@ TEST_F(PolygonUnitTest, BinaryMultipleRings) {
   ASSERT_EQ(13.0, y);
 }
 
+TEST_F(PolygonUnitTest, BinaryMultipleRingsPoints) {
+  const cass_double_t ring1[] = { 0, 1, 2, 3, 4, 5 };
+  const cass_double_t ring2[] = { 6, 7, 8, 9, 10, 11, 12, 13 };
+  ASSERT_EQ(CASS_OK, dse_polygon_start_ring(polygon));
+  ASSERT_EQ(CASS_OK, dse_polygon_add_points(polygon, ring1, 3));
+  ASSERT_EQ(CASS_OK, dse_polygon_start_ring(polygon));
+  ASSERT_EQ(CASS_OK, dse_polygon_add_points(polygon, ring2, 2));
+  ASSERT_EQ(CASS_OK, dse_polygon_add_points(polygon, ring2 + 4, 2));
+  ASSERT_EQ(CASS_OK, dse_polygon_finish(polygon));
+
+  ASSERT_EQ(CASS_OK, iterator.reset_binary(to_value()));
+  ASSERT_EQ(2u, iterator.num_rings());
+
+  cass_double_t result[8];
+
+  // First ring
+  cass_uint32_t num_points;
+  ASSERT_EQ(CASS_OK, iterator.next_num_points(&num_points));
+  ASSERT_EQ(3u, num_points);
+  ASSERT_EQ(CASS_ERROR_LIB_INVALID_STATE, iterator.next_points(result, 4)); // Past the ring
+  ASSERT_EQ(CASS_OK, iterator.next_points(result, 3));
+  for (size_t i = 0; i < 6; ++i) {
+    ASSERT_EQ(ring1[i], result[i]);
+  }
+
+  // Second ring
+  ASSERT_EQ(CASS_ERROR_LIB_INVALID_STATE, iterator.next_points(result, 1));
+  ASSERT_EQ(CASS_OK, iterator.next_num_points(&num_points));
+  ASSERT_EQ(4u, num_points);
+  ASSERT_EQ(CASS_OK, iterator.next_points(result, 4));
+  for (size_t i = 0; i < 8; ++i) {
+    ASSERT_EQ(ring2[i], result[i]);
+  }
+}
+
+TEST_F(PolygonUnitTest, ValueGetPoints) {
+  const cass_double_t ring1[] = { 1, 2, 3, 4, 5, 6 };
+  const cass_double_t ring2[] = { 7, 8, 9, 10, 11, 12, 13, 14 };
+  ASSERT_EQ(CASS_OK, dse_polygon_start_ring(polygon));
+  ASSERT_EQ(CASS_OK, dse_polygon_add_points(polygon, ring1, 3));
+  ASSERT_EQ(CASS_OK, dse_polygon_start_ring(polygon));
+  ASSERT_EQ(CASS_OK, dse_polygon_add_points(polygon, ring2, 4));
+  ASSERT_EQ(CASS_OK, dse_polygon_finish(polygon));
+
+  cass_uint32_t num_rings = 0, num_points = 0;
+  ASSERT_EQ(CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS,
+            cass_value_get_dse_polygon(to_value(), NULL, 0, NULL, 0, &num_rings, &num_points));
+  ASSERT_EQ(2u, num_rings);
+  ASSERT_EQ(7u, num_points);
+
+  cass_double_t points[14];
+  cass_uint32_t ring_num_points[2];
+  ASSERT_EQ(CASS_OK, cass_value_get_dse_polygon(to_value(), points, 7, ring_num_points, 2,
+                                                &num_rings, &num_points));
+  ASSERT_EQ(3u, ring_num_points[0]);
+  ASSERT_EQ(4u, ring_num_points[1]);
+  for (size_t i = 0; i < 6; ++i) {
+    ASSERT_EQ(ring1[i], points[i]);
+  }
+  for (size_t i = 0; i < 8; ++i) {
+    ASSERT_EQ(ring2[i], points[6 + i]);
+  }
+
+  ASSERT_EQ(CASS_OK, iterator.reset_binary(to_value()));
+  ASSERT_EQ(7u, iterator.num_points());
+}
+
 TEST_F(PolygonUnitTest, TextMissingY) {
   ASSERT_EQ(CASS_ERROR_LIB_BAD_PARAMS, RESET_ITERATOR_WITH("POLYGON ((1))"));
 }
@@ -185,3 +185,135 @@ TEST_F(EventLoopUnitTest, IoTimeElapsed) {
    * io_time_elapsed() using a uv_prepare_t on the same uv_run() iteration.
    */
 }
+
+class SleepTask : public Task {
+public:
+  SleepTask(unsigned ms)
+      : ms_(ms) {}
+  virtual void run(EventLoop* event_loop) { test::Utils::msleep(ms_); }
+
+private:
+  unsigned ms_;
+};
+
+TEST_F(EventLoopUnitTest, Utilization) {
+  EventLoop event_loop;
+  ASSERT_EQ(0, event_loop.init("EventLoopUnitTest::Utilization"));
+  ASSERT_EQ(0, event_loop.run());
+
+  test::Utils::msleep(50); // Idle
+  event_loop.add(new SleepTask(50)); // Busy
+  test::Utils::msleep(100);
+
+  event_loop.close_handles();
+  event_loop.join();
+  EXPECT_GE(event_loop.busy_time(), 50u * 1000 * 1000);
+  EXPECT_GE(event_loop.idle_time(), 40u * 1000 * 1000);
+  EXPECT_EQ(1u, event_loop.tasks_run());
+  EXPECT_EQ(0u, event_loop.tasks_stolen());
+}
+
+TEST_F(EventLoopUnitTest, UtilizationBusy) {
+  EventLoop event_loop;
+  ASSERT_EQ(0, event_loop.init("EventLoopUnitTest::UtilizationBusy"));
+  ASSERT_EQ(0, event_loop.run());
+
+  event_loop.add(new SleepTask(250));
+  test::Utils::msleep(300);
+  EXPECT_GT(event_loop.utilization(), 500);
+
+  event_loop.close_handles();
+  event_loop.join();
+}
+
+class BlockTask : public Task {
+public:
+  BlockTask(Atomic<bool>* is_blocked)
+      : is_blocked_(is_blocked) {}
+  virtual void run(EventLoop* event_loop) {
+    while (is_blocked_->load()) {
+      test::Utils::msleep(1);
+    }
+  }
+
+private:
+  Atomic<bool>* is_blocked_;
+};
+
+TEST_F(EventLoopUnitTest, PendingTasks) {
+  EventLoop event_loop;
+  ASSERT_EQ(0, event_loop.init("EventLoopUnitTest::PendingTasks"));
+  ASSERT_EQ(0, event_loop.run());
+
+  // The tasks wait behind the blocked task
+  Atomic<bool> is_blocked(true);
+  event_loop.add(new BlockTask(&is_blocked));
+  test::Utils::msleep(5);
+  event_loop.add(new SleepTask(0));
+  event_loop.add(new SleepTask(0));
+  EXPECT_EQ(2u, event_loop.pending_task_count());
+
+  is_blocked.store(false);
+  event_loop.close_handles();
+  event_loop.join();
+  EXPECT_EQ(0u, event_loop.pending_task_count());
+  EXPECT_EQ(3u, event_loop.tasks_run());
+}
+
+class RecordLoopTask : public Task {
+public:
+  RecordLoopTask(Atomic<EventLoop*>* ran_on)
+      : ran_on_(ran_on) {}
+  virtual void run(EventLoop* event_loop) { ran_on_->store(event_loop); }
+
+private:
+  Atomic<EventLoop*>* ran_on_;
+};
+
+TEST_F(EventLoopUnitTest, WorkStealing) {
+  RoundRobinEventLoopGroup group(2);
+  group.set_work_stealing(true);
+  ASSERT_EQ(0, group.init("EventLoopUnitTest::WorkStealing"));
+  ASSERT_EQ(0, group.run());
+
+  // Keep the first event loop busy
+  Atomic<bool> is_blocked(true);
+  group.get(0)->add(new BlockTask(&is_blocked));
+
+  // Tasks round-robin between both event loops, but the idle event loop runs
+  // them all
+  for (int i = 0; i < 4; ++i) {
+    test::Utils::msleep(5); // Wait for the event loop to become idle
+    Atomic<EventLoop*> ran_on(NULL);
+    group.add_stealable(new RecordLoopTask(&ran_on));
+    for (int j = 0; j < 1000 && ran_on.load() == NULL; ++j) {
+      test::Utils::msleep(1);
+    }
+    EXPECT_EQ(group.get(1), ran_on.load());
+  }
+
+  is_blocked.store(false);
+  group.close_handles();
+  group.join();
+  EXPECT_EQ(4u, group.get(1)->tasks_run());
+  EXPECT_EQ(2u, group.get(1)->tasks_stolen());
+}
+
+TEST_F(EventLoopUnitTest, BusyPoll) {
+  EventLoop event_loop;
+  event_loop.set_busy_poll(true);
+  event_loop.set_cpu_affinity(Vector<unsigned>(1, 0u));
+  ASSERT_EQ(0, event_loop.init("EventLoopUnitTest::BusyPoll"));
+  ASSERT_TRUE(event_loop.is_busy_poll());
+  ASSERT_EQ(0, event_loop.run());
+
+  // The spinning event loop still runs tasks and exits once its handles close
+  event_loop.add(new MarkTaskCompleted(this));
+  for (int i = 0; i < 1000 && !is_task_completed(); ++i) {
+    test::Utils::msleep(1);
+  }
+  event_loop.close_handles();
+  event_loop.join();
+
+  ASSERT_TRUE(is_task_completed());
+}
@@ -18,6 +18,7 @@
 #include "config.hpp"
 
 using namespace datastax;
+using namespace datastax::internal;
 using namespace datastax::internal::core;
 
 bool execution_profile(const Config& config, const String& name, ExecutionProfile& profile) {
@@ -73,6 +74,21 @@ TEST(ExecutionProfileUnitTest, RequestTimeout) {
   ASSERT_EQ(CASS_DEFAULT_REQUEST_TIMEOUT_MS, copy_config.default_profile().request_timeout_ms());
 }
 
+TEST(ExecutionProfileUnitTest, ConnectionSelection) {
+  ExecutionProfile profile;
+  ASSERT_EQ(CASS_DEFAULT_CONNECTION_SELECTION, profile.connection_selection());
+  profile.set_connection_selection(CASS_CONNECTION_SELECTION_POWER_OF_TWO_CHOICES);
+
+  Config config;
+  config.set_execution_profile("profile", &profile);
+
+  Config copy_config = config.new_instance();
+  ExecutionProfile profile_lookup;
+  ASSERT_TRUE(execution_profile(copy_config, "profile", profile_lookup));
+  ASSERT_EQ(CASS_CONNECTION_SELECTION_POWER_OF_TWO_CHOICES, profile_lookup.connection_selection());
+  ASSERT_EQ(CASS_DEFAULT_CONNECTION_SELECTION, copy_config.default_profile().connection_selection());
+}
+
 TEST(ExecutionProfileUnitTest, NullLoadBalancingPolicy) {
   ExecutionProfile profile;
   profile.build_load_balancing_policy();
@@ -367,3 +383,62 @@ TEST(ExecutionProfileUnitTest, ClusterSpeculativeExecutionPolicies) {
           profile_1_speculative_execution_policy)
           ->max_speculative_executions_);
 }
+
+TEST(ExecutionProfileUnitTest, PercentileSpeculativeExecutionPolicy) {
+  Config config;
+  config.set_speculative_execution_policy(new PercentileSpeculativeExecutionPolicy(95.0, 2, 0.1));
+
+  Config copy_config = config.new_instance();
+  PercentileSpeculativeExecutionPolicy* policy =
+      dynamic_cast<PercentileSpeculativeExecutionPolicy*>(
+          copy_config.default_profile().speculative_execution_policy().get());
+  ASSERT_TRUE(policy != NULL);
+  ASSERT_NE(static_cast<const SpeculativeExecutionPolicy*>(policy),
+            config.default_profile().speculative_execution_policy().get());
+
+  // No speculative executions until enough latencies have been recorded
+  ScopedPtr<SpeculativeExecutionPlan> plan(policy->new_plan("", NULL));
+  EXPECT_EQ(-1, plan->next_execution(Host::Ptr()));
+
+  for (int i = 1; i <= PercentileSpeculativeExecutionPolicy::MIN_MEASURED; ++i) {
+    plan->record_latency(i * 1000LL * 1000LL); // i ms
+  }
+  policy->refresh_delay();
+  int64_t delay_ms = policy->delay_ms();
+  EXPECT_NEAR(95, delay_ms, 1); // Within the histogram's precision
+
+  plan.reset(policy->new_plan("", NULL));
+  EXPECT_EQ(delay_ms, plan->next_execution(Host::Ptr()));
+  EXPECT_EQ(delay_ms, plan->next_execution(Host::Ptr()));
+  EXPECT_EQ(-1, plan->next_execution(Host::Ptr()));
+
+  // Only one in ten requests can speculate (the earlier plans added 0.2)
+  for (int i = 0; i < 8; ++i) {
+    plan.reset(policy->new_plan("", NULL));
+  }
+  EXPECT_TRUE(plan->start_execution());
+  EXPECT_FALSE(plan->start_execution());
+}
+
+TEST(ExecutionProfileUnitTest, Handles) {
+  ExecutionProfile profile;
+  EXPECT_EQ(-1, profile.handle());
+
+  Config config;
+  config.set_execution_profile("profile1", &profile);
+  config.set_execution_profile("profile2", &profile);
+  config.set_execution_profile("profile1", &profile); // Replacing keeps the handle
+
+  Config copy_config = config.new_instance();
+  ExecutionProfile::ConstVec indexed;
+  ExecutionProfile::index(copy_config.profiles(), &indexed);
+  ASSERT_EQ(2u, indexed.size());
+
+  ExecutionProfile profile_lookup;
+  ASSERT_TRUE(execution_profile(copy_config, "profile1", profile_lookup));
+  EXPECT_EQ(0, profile_lookup.handle());
+  EXPECT_EQ(&copy_config.profiles().find("profile1")->second, indexed[0]);
+  ASSERT_TRUE(execution_profile(copy_config, "profile2", profile_lookup));
+  EXPECT_EQ(1, profile_lookup.handle());
+  EXPECT_EQ(&copy_config.profiles().find("profile2")->second, indexed[1]);
+}
@@ -0,0 +1,181 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "execute_request.hpp"
+#include "prepared.hpp"
+#include "result_response.hpp"
+#include "serialization.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+class ExecuteRequestUnitTest : public testing::Test {
+public:
+  void SetUp() {
+    insert_prepared_ = create_prepared(false);
+    select_prepared_ = create_prepared(true);
+  }
+
+  Prepared::ConstPtr create_prepared(bool has_result_metadata) {
+    data_.clear();
+    append_int32(CASS_RESULT_KIND_PREPARED);
+    append_string("0123456789abcdef"); // Prepared ID
+    // Metadata
+    append_int32(CASS_RESULT_FLAG_GLOBAL_TABLESPEC);
+    append_int32(1); // Column count
+    append_int32(1); // Primary key count
+    append_uint16(0);
+    append_string("keyspace");
+    append_string("table");
+    append_column("key", CASS_VALUE_TYPE_INT);
+    // Result metadata
+    if (has_result_metadata) {
+      append_int32(CASS_RESULT_FLAG_GLOBAL_TABLESPEC);
+      append_int32(1); // Column count
+      append_string("keyspace");
+      append_string("table");
+      append_column("value", CASS_VALUE_TYPE_VARCHAR);
+    } else {
+      append_int32(CASS_RESULT_FLAG_NO_METADATA);
+      append_int32(0); // Column count
+    }
+
+    ResultResponse::Ptr result(new ResultResponse());
+    result->set_buffer(data_.size());
+    memcpy(result->buffer()->data(), data_.data(), data_.size());
+    Decoder decoder(result->data(), data_.size(), ProtocolVersion(CASS_PROTOCOL_VERSION_V4));
+    EXPECT_TRUE(result->decode(decoder));
+
+    Metadata::SchemaSnapshot schema(0, VersionNumber(),
+                                    KeyspaceMetadata::MapPtr(new KeyspaceMetadata::Map()));
+    return Prepared::ConstPtr(
+        new Prepared(result, PrepareRequest::ConstPtr(new PrepareRequest("query")), schema));
+  }
+
+  SharedRefPtr<ExecuteRequest> create_select() {
+    SharedRefPtr<ExecuteRequest> request(new ExecuteRequest(select_prepared_.get()));
+    EXPECT_EQ(CASS_OK, request->set(0, cass_int32_t(42)));
+    return request;
+  }
+
+  static String result_cache_key(const ExecuteRequest* request) {
+    String key;
+    EXPECT_TRUE(request->result_cache_key(&key));
+    return key;
+  }
+
+  const Prepared* insert_prepared() const { return insert_prepared_.get(); }
+  const Prepared* select_prepared() const { return select_prepared_.get(); }
+
+private:
+  void append_int32(int32_t value) {
+    char buf[sizeof(int32_t)];
+    encode_int32(buf, value);
+    data_.append(buf, sizeof(buf));
+  }
+
+  void append_uint16(uint16_t value) {
+    char buf[sizeof(uint16_t)];
+    encode_uint16(buf, value);
+    data_.append(buf, sizeof(buf));
+  }
+
+  void append_string(const String& value) {
+    append_uint16(value.size());
+    data_.append(value);
+  }
+
+  void append_column(const String& name, CassValueType type) {
+    append_string(name);
+    append_uint16(type);
+  }
+
+private:
+  String data_;
+  Prepared::ConstPtr insert_prepared_;
+  Prepared::ConstPtr select_prepared_;
+};
+
+TEST_F(ExecuteRequestUnitTest, HasResultColumns) {
+  SharedRefPtr<ExecuteRequest> select(new ExecuteRequest(select_prepared()));
+  EXPECT_TRUE(select->has_result_columns());
+
+  SharedRefPtr<ExecuteRequest> insert(new ExecuteRequest(insert_prepared()));
+  EXPECT_FALSE(insert->has_result_columns());
+}
+
+TEST_F(ExecuteRequestUnitTest, ResultCacheKey) {
+  String key(result_cache_key(create_select().get()));
+  EXPECT_EQ(key, result_cache_key(create_select().get()));
+
+  SharedRefPtr<ExecuteRequest> request(create_select());
+  EXPECT_EQ(CASS_OK, request->set(0, cass_int32_t(43)));
+  EXPECT_NE(key, result_cache_key(request.get()));
+
+  request = create_select();
+  request->set_consistency(CASS_CONSISTENCY_QUORUM);
+  EXPECT_NE(key, result_cache_key(request.get()));
+
+  request = create_select();
+  request->set_page_size(100);
+  EXPECT_NE(key, result_cache_key(request.get()));
+
+  // A paged request isn't cached
+  request = create_select();
+  request->set_paging_state("abc");
+  String paged_key;
+  EXPECT_FALSE(request->result_cache_key(&paged_key));
+}
+
+TEST_F(ExecuteRequestUnitTest, ResultCacheKeyOptions) {
+  String key(result_cache_key(create_select().get()));
+
+  SharedRefPtr<ExecuteRequest> request(create_select());
+  request->set_serial_consistency(CASS_CONSISTENCY_LOCAL_SERIAL);
+  EXPECT_NE(key, result_cache_key(request.get()));
+
+  request = create_select();
+  request->set_tracing(true);
+  EXPECT_NE(key, result_cache_key(request.get()));
+
+  request = create_select();
+  request->set_execution_profile_name("profile");
+  String profile_key(result_cache_key(request.get()));
+  EXPECT_NE(key, profile_key);
+  request->set_execution_profile_name("other");
+  EXPECT_NE(profile_key, result_cache_key(request.get()));
+
+  request = create_select();
+  request->set_host(Address("127.0.0.1", 9042));
+  String host_key(result_cache_key(request.get()));
+  EXPECT_NE(key, host_key);
+  request->set_host(Address("127.0.0.2", 9042));
+  EXPECT_NE(host_key, result_cache_key(request.get()));
+
+  request = create_select();
+  const uint8_t value[] = { 1, 2, 3 };
+  request->set_custom_payload("key", value, sizeof(value));
+  String payload_key(result_cache_key(request.get()));
+  EXPECT_NE(key, payload_key);
+
+  request = create_select();
+  const uint8_t other_value[] = { 1, 2, 4 };
+  request->set_custom_payload("key", other_value, sizeof(other_value));
+  EXPECT_NE(payload_key, result_cache_key(request.get()));
+}
@@ -0,0 +1,114 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "abstract_data.hpp"
+#include "buffer.hpp"
+#include "cassandra.h"
+#include "ref_counted.hpp"
+
+#include <string.h>
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+namespace {
+
+void on_release(void* data) { (*static_cast<int*>(data))++; }
+
+} // namespace
+
+TEST(ExternalBufferUnitTest, ReferencedUntilLastBuffer) {
+  const char value[] = "a value that doesn't fit in a small buffer";
+  int release_count = 0;
+
+  {
+    ExternalBuffer::Ptr external(new ExternalBuffer(value, sizeof(value), on_release,
+                                                    &release_count));
+    Buffer buf(external.get());
+    EXPECT_EQ(value, buf.data()); // Not copied
+    EXPECT_EQ(sizeof(value), buf.size());
+
+    external.reset();
+    EXPECT_EQ(0, release_count);
+
+    Buffer copy(buf);
+    buf = Buffer();
+    EXPECT_EQ(0, release_count);
+    EXPECT_EQ(0, memcmp(value, copy.data(), sizeof(value)));
+  }
+
+  EXPECT_EQ(1, release_count);
+}
+
+TEST(ExternalBufferUnitTest, SmallValuesCopied) {
+  const char value[] = "small";
+  int release_count = 0;
+
+  ExternalBuffer::Ptr external(new ExternalBuffer(value, sizeof(value), on_release,
+                                                  &release_count));
+  Buffer buf(external.get());
+  EXPECT_NE(value, buf.data());
+  EXPECT_EQ(0, memcmp(value, buf.data(), sizeof(value)));
+
+  external.reset();
+  EXPECT_EQ(1, release_count); // The buffer doesn't reference the value
+}
+
+TEST(ExternalBufferUnitTest, AppendElement) {
+  const char value[] = "a value that doesn't fit in a small buffer";
+  int release_count = 0;
+
+  BufferVec bufs;
+  {
+    AbstractData::Element element(
+        new ExternalBuffer(value, sizeof(value), on_release, &release_count));
+    EXPECT_EQ(sizeof(int32_t) + sizeof(value), element.get_size());
+    EXPECT_EQ(sizeof(int32_t) + sizeof(value), element.append_buffers(&bufs));
+  }
+
+  ASSERT_EQ(2u, bufs.size());
+  EXPECT_EQ(sizeof(int32_t), bufs[0].size());
+  EXPECT_EQ(value, bufs[1].data()); // Not copied
+  EXPECT_EQ(0, release_count);
+
+  bufs.clear();
+  EXPECT_EQ(1, release_count);
+}
+
+TEST(ExternalBufferUnitTest, BindReleasedWhenStatementFreed) {
+  const char value[] = "a value that doesn't fit in a small buffer";
+  int release_count = 0;
+
+  CassStatement* statement = cass_statement_new("INSERT INTO t (k, v) VALUES (?, ?)", 2);
+  EXPECT_EQ(CASS_OK, cass_statement_bind_string_ref(statement, 0, value, strlen(value),
+                                                    on_release, &release_count));
+  EXPECT_EQ(CASS_OK,
+            cass_statement_bind_bytes_ref(statement, 1, reinterpret_cast<const cass_byte_t*>(value),
+                                          sizeof(value), on_release, &release_count));
+  EXPECT_EQ(0, release_count);
+
+  // A failed bind releases the value immediately
+  EXPECT_EQ(CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS,
+            cass_statement_bind_string_ref(statement, 2, value, strlen(value), on_release,
+                                           &release_count));
+  EXPECT_EQ(1, release_count);
+
+  cass_statement_free(statement);
+  EXPECT_EQ(3, release_count);
+}
@@ -0,0 +1,114 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "flat_hash_map.hpp"
+#include "string.hpp"
+
+#include <map>
+#include <stdlib.h>
+
+using namespace datastax;
+using namespace datastax::internal;
+
+TEST(FlatHashMapUnitTest, Simple) {
+  FlatHashMap<String, int> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_TRUE(map.find("abc") == map.end());
+
+  map["abc"] = 1;
+  EXPECT_TRUE(map.insert(std::make_pair(String("def"), 2)).second);
+  EXPECT_FALSE(map.insert(std::make_pair(String("def"), 3)).second);
+  EXPECT_EQ(2u, map.size());
+  EXPECT_EQ(1, map.find("abc")->second);
+  EXPECT_EQ(2, map["def"]);
+
+  EXPECT_EQ(1u, map.erase("abc"));
+  EXPECT_EQ(0u, map.erase("abc"));
+  EXPECT_TRUE(map.find("abc") == map.end());
+  EXPECT_EQ(1u, map.size());
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_TRUE(map.begin() == map.end());
+}
+
+TEST(FlatHashMapUnitTest, Copy) {
+  FlatHashMap<int, int> map;
+  for (int i = 0; i < 100; ++i) {
+    map[i] = i * 2;
+  }
+
+  FlatHashMap<int, int> copy(map);
+  FlatHashMap<int, int> assigned;
+  assigned = copy;
+  map.clear();
+
+  EXPECT_EQ(100u, assigned.size());
+  int count = 0;
+  for (FlatHashMap<int, int>::const_iterator it = assigned.begin(), end = assigned.end();
+       it != end; ++it) {
+    EXPECT_EQ(it->first * 2, it->second);
+    count++;
+  }
+  EXPECT_EQ(100, count);
+}
+
+// Erasing doesn't grow the map when its entries are replaced
+TEST(FlatHashMapUnitTest, EraseAndInsert) {
+  FlatHashMap<int, int> map;
+  for (int i = 0; i < 10; ++i) {
+    map[i] = i;
+  }
+  size_t bucket_count = map.bucket_count();
+
+  for (int i = 10; i < 100000; ++i) {
+    map.erase(i - 10);
+    map[i] = i;
+  }
+  EXPECT_EQ(10u, map.size());
+  EXPECT_EQ(bucket_count, map.bucket_count());
+}
+
+TEST(FlatHashMapUnitTest, Random) {
+  FlatHashMap<int, int> map;
+  std::map<int, int> expected;
+  srand(42);
+  for (int i = 0; i < 100000; ++i) {
+    int key = rand() % 1000;
+    switch (rand() % 3) {
+      case 0:
+        map[key] = i;
+        expected[key] = i;
+        break;
+      case 1:
+        ASSERT_EQ(expected.erase(key), map.erase(key));
+        break;
+      default:
+        ASSERT_EQ(expected.count(key), map.count(key));
+        break;
+    }
+    ASSERT_EQ(expected.size(), map.size());
+  }
+
+  for (std::map<int, int>::const_iterator it = expected.begin(), end = expected.end(); it != end;
+       ++it) {
+    FlatHashMap<int, int>::const_iterator i = map.find(it->first);
+    ASSERT_TRUE(i != map.end());
+    EXPECT_EQ(it->second, i->second);
+  }
+}
@@ -0,0 +1,124 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "frame_capture.hpp"
+#include "serialization.hpp"
+
+#include <stdio.h>
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+class FrameCaptureUnitTest : public testing::Test {
+public:
+  void SetUp() {
+    char tmp[260] = { 0 }; // Note: 260 is the maximum path on Windows
+    size_t tmp_length = 260;
+    uv_os_tmpdir(tmp, &tmp_length);
+    path_ = String(tmp, tmp_length) + "/cpp_driver_frame_capture.bin";
+  }
+
+  void TearDown() {
+    remove(path_.c_str());
+    remove((path_ + ".1").c_str());
+  }
+
+  static String read_file(const String& path) {
+    String contents;
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == NULL) return contents;
+    char buf[4096];
+    size_t count;
+    while ((count = fread(buf, 1, sizeof(buf), file)) > 0) {
+      contents.append(buf, count);
+    }
+    fclose(file);
+    return contents;
+  }
+
+protected:
+  String path_;
+};
+
+TEST_F(FrameCaptureUnitTest, Records) {
+  {
+    FrameCapture::Ptr capture(new FrameCapture(path_, 1024 * 1024));
+    ASSERT_TRUE(capture->open());
+    EXPECT_EQ(0, capture->next_connection_id());
+    EXPECT_EQ(1, capture->next_connection_id());
+    capture->record(1, FrameCapture::DIRECTION_REQUEST, "request", 7);
+    capture->record(1, FrameCapture::DIRECTION_RESPONSE, "response", 8);
+  } // Closes the file
+
+  String contents(read_file(path_));
+  ASSERT_EQ(static_cast<size_t>(FRAME_CAPTURE_MAGIC_SIZE + 2 * FRAME_CAPTURE_RECORD_HEADER_SIZE +
+                                7 + 8),
+            contents.size());
+  EXPECT_EQ(String(FRAME_CAPTURE_MAGIC), contents.substr(0, FRAME_CAPTURE_MAGIC_SIZE));
+
+  const char* pos = contents.data() + FRAME_CAPTURE_MAGIC_SIZE;
+  int64_t request_timestamp, response_timestamp;
+  int32_t connection_id, size;
+  int8_t direction;
+
+  pos = decode_int64(pos, request_timestamp);
+  pos = decode_int32(pos, connection_id);
+  pos = decode_int8(pos, direction);
+  pos = decode_int32(pos, size);
+  EXPECT_EQ(1, connection_id);
+  EXPECT_EQ(FrameCapture::DIRECTION_REQUEST, direction);
+  ASSERT_EQ(7, size);
+  EXPECT_EQ("request", String(pos, size));
+  pos += size;
+
+  pos = decode_int64(pos, response_timestamp);
+  pos = decode_int32(pos, connection_id);
+  pos = decode_int8(pos, direction);
+  pos = decode_int32(pos, size);
+  EXPECT_EQ(1, connection_id);
+  EXPECT_EQ(FrameCapture::DIRECTION_RESPONSE, direction);
+  ASSERT_EQ(8, size);
+  EXPECT_EQ("response", String(pos, size));
+  EXPECT_GE(response_timestamp, request_timestamp);
+}
+
+TEST_F(FrameCaptureUnitTest, Ring) {
+  const size_t max_size = 1024;
+  const String frame(100, 'f');
+  const size_t record_size = FRAME_CAPTURE_RECORD_HEADER_SIZE + frame.size();
+  const size_t num_records = 18;
+  {
+    FrameCapture::Ptr capture(new FrameCapture(path_, max_size));
+    ASSERT_TRUE(capture->open());
+    for (size_t i = 0; i < num_records; ++i) {
+      capture->record(0, FrameCapture::DIRECTION_REQUEST, frame.data(), frame.size());
+    }
+  }
+
+  // Each file holds as many records as fit in half of the maximum size, the
+  // previous file is full and the current file has the remaining records
+  size_t records_per_file = (max_size / 2 - FRAME_CAPTURE_MAGIC_SIZE) / record_size;
+  String previous(read_file(path_ + ".1"));
+  String current(read_file(path_));
+  EXPECT_EQ(FRAME_CAPTURE_MAGIC_SIZE + records_per_file * record_size, previous.size());
+  EXPECT_EQ(FRAME_CAPTURE_MAGIC_SIZE + ((num_records - 1) % records_per_file + 1) * record_size,
+            current.size());
+  EXPECT_LE(previous.size() + current.size(), max_size);
+  EXPECT_EQ(String(FRAME_CAPTURE_MAGIC), current.substr(0, FRAME_CAPTURE_MAGIC_SIZE));
+}
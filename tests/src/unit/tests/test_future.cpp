@@ -36,6 +36,11 @@ void on_future_callback(CassFuture* future, void* data) {
   *is_future_callback_called = true;
 }
 
+void on_future_callback_error_code(CassFuture* future, void* data) {
+  CassError* error_code = static_cast<CassError*>(data);
+  *error_code = cass_future_error_code(future);
+}
+
 void start_timer(void* arg) {
   Future* future = static_cast<Future*>(arg);
   test::Utils::msleep(DELAY_MS);
@@ -124,3 +129,43 @@ TEST(FutureUnitTest, CallbackAfterFutureIsSet) {
   ASSERT_TRUE(future.set_callback(&on_future_callback, &is_future_callback_called));
   ASSERT_TRUE(is_future_callback_called);
 }
+
+TEST(FutureUnitTest, CallbackAccessesResult) {
+  // The callback runs before the future is marked done so this would wait
+  // forever if the callback's thread had to wait on the future.
+  CassError error_code = CASS_OK;
+  Future future(Future::FUTURE_TYPE_GENERIC);
+  ASSERT_TRUE(future.set_callback(&on_future_callback_error_code, &error_code));
+
+  future.set_error(CASS_ERROR_LIB_REQUEST_TIMED_OUT, "FutureUnitTest error message");
+  EXPECT_EQ(CASS_ERROR_LIB_REQUEST_TIMED_OUT, error_code);
+}
+
+TEST(FutureUnitTest, SetOnlyOnce) {
+  Future future(Future::FUTURE_TYPE_GENERIC);
+  future.set();
+  ASSERT_FALSE(future.set_error(CASS_ERROR_LIB_BAD_PARAMS, "FutureUnitTest error message"));
+  ASSERT_TRUE(future.ready());
+  ASSERT_TRUE(future.error() == NULL);
+}
+
+void wait_for_future(void* arg) {
+  Future* future = static_cast<Future*>(arg);
+  future->wait();
+}
+
+TEST(FutureUnitTest, WaitMultipleThreads) {
+  Future future(Future::FUTURE_TYPE_GENERIC);
+  uv_thread_t threads[4];
+  for (size_t i = 0; i < 4; ++i) {
+    ASSERT_EQ(0, uv_thread_create(&threads[i], wait_for_future, &future));
+  }
+
+  test::Utils::msleep(DELAY_MS);
+  future.set();
+
+  for (size_t i = 0; i < 4; ++i) {
+    ASSERT_EQ(0, uv_thread_join(&threads[i]));
+  }
+  ASSERT_TRUE(future.ready());
+}
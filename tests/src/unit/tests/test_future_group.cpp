@@ -0,0 +1,143 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "future_group.hpp"
+#include "test_utils.hpp"
+
+#include <uv.h>
+
+#define DELAY_MS 100 // 100 milliseconds
+
+using namespace datastax::internal::core;
+
+static void free_futures(CassFuture** futures, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    cass_future_free(futures[i]);
+  }
+}
+
+TEST(FutureGroupUnitTest, DrainCompleted) {
+  FutureGroup::Ptr group(new FutureGroup(16));
+
+  Future::Ptr futures[3];
+  for (size_t i = 0; i < 3; ++i) {
+    futures[i].reset(new Future(Future::FUTURE_TYPE_GENERIC));
+    ASSERT_TRUE(group->add(futures[i].get()));
+  }
+
+  futures[2]->set();
+  futures[0]->set();
+
+  CassFuture* completed[4];
+  ASSERT_EQ(2u, group->wait(completed, 4, 0));
+  EXPECT_EQ(futures[2].get(), completed[0]->from());
+  EXPECT_EQ(futures[0].get(), completed[1]->from());
+  free_futures(completed, 2);
+
+  EXPECT_EQ(0u, group->wait(completed, 4, 0));
+  futures[1]->set();
+  ASSERT_EQ(1u, group->wait(completed, 4, 0));
+  EXPECT_EQ(futures[1].get(), completed[0]->from());
+  free_futures(completed, 1);
+}
+
+TEST(FutureGroupUnitTest, AlreadySet) {
+  FutureGroup::Ptr group(new FutureGroup(16));
+
+  Future::Ptr future(new Future(Future::FUTURE_TYPE_GENERIC));
+  future->set();
+  ASSERT_TRUE(group->add(future.get()));
+
+  CassFuture* completed[1];
+  ASSERT_EQ(1u, group->wait(completed, 1, 0));
+  free_futures(completed, 1);
+}
+
+TEST(FutureGroupUnitTest, CallbackAlreadySet) {
+  FutureGroup::Ptr group(new FutureGroup(16));
+
+  Future::Ptr future(new Future(Future::FUTURE_TYPE_GENERIC));
+  ASSERT_TRUE(group->add(future.get()));
+  EXPECT_FALSE(group->add(future.get()));
+  EXPECT_EQ(CASS_ERROR_LIB_CALLBACK_ALREADY_SET,
+            cass_future_group_add(CassFutureGroup::to(group.get()), CassFuture::to(future.get())));
+}
+
+TEST(FutureGroupUnitTest, Overflow) {
+  FutureGroup::Ptr group(new FutureGroup(2));
+
+  // More completions than the queue can hold
+  for (size_t i = 0; i < 8; ++i) {
+    Future::Ptr future(new Future(Future::FUTURE_TYPE_GENERIC));
+    ASSERT_TRUE(group->add(future.get()));
+    future->set();
+  }
+
+  CassFuture* completed[8];
+  size_t count = group->wait(completed, 3, 0);
+  EXPECT_EQ(3u, count);
+  count += group->wait(completed + count, 8 - count, 0);
+  EXPECT_EQ(8u, count);
+  free_futures(completed, count);
+}
+
+TEST(FutureGroupUnitTest, Timeout) {
+  FutureGroup::Ptr group(new FutureGroup(16));
+
+  Future::Ptr future(new Future(Future::FUTURE_TYPE_GENERIC));
+  ASSERT_TRUE(group->add(future.get()));
+
+  CassFuture* completed[1];
+  uint64_t start = uv_hrtime();
+  EXPECT_EQ(0u, group->wait(completed, 1, DELAY_MS * 1000));
+  EXPECT_GE(uv_hrtime() - start, static_cast<uint64_t>(DELAY_MS) * 1000 * 1000);
+}
+
+static void set_future_after_delay(void* arg) {
+  Future* future = static_cast<Future*>(arg);
+  test::Utils::msleep(DELAY_MS);
+  future->set();
+}
+
+TEST(FutureGroupUnitTest, WaitForCompletion) {
+  FutureGroup::Ptr group(new FutureGroup(16));
+
+  Future::Ptr future(new Future(Future::FUTURE_TYPE_GENERIC));
+  ASSERT_TRUE(group->add(future.get()));
+
+  uv_thread_t thread;
+  ASSERT_EQ(0, uv_thread_create(&thread, set_future_after_delay, future.get()));
+
+  CassFuture* completed[1];
+  ASSERT_EQ(1u, group->wait(completed, 1, 10 * DELAY_MS * 1000));
+  EXPECT_EQ(future.get(), completed[0]->from());
+  free_futures(completed, 1);
+
+  ASSERT_EQ(0, uv_thread_join(&thread));
+}
+
+TEST(FutureGroupUnitTest, FreeWithPendingFutures) {
+  Future::Ptr future(new Future(Future::FUTURE_TYPE_GENERIC));
+  {
+    FutureGroup::Ptr group(new FutureGroup(16));
+    ASSERT_TRUE(group->add(future.get()));
+  }
+  // The callback keeps the group alive until the future is set
+  future->set();
+  EXPECT_EQ(1, future->ref_count());
+}
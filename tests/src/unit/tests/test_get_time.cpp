@@ -19,6 +19,7 @@
 #include "get_time.hpp"
 #include "test_utils.hpp"
 
+using datastax::internal::get_time_monotonic_coarse_ns;
 using datastax::internal::get_time_monotonic_ns;
 
 TEST(GetTimeUnitTest, Monotonic) {
@@ -38,3 +39,23 @@ TEST(GetTimeUnitTest, MonotonicDuration) {
   EXPECT_GE(elapsed, static_cast<double>(NANOSECONDS_PER_SECOND));
   EXPECT_LE(elapsed, static_cast<double>(2 * NANOSECONDS_PER_SECOND));
 }
+
+TEST(GetTimeUnitTest, MonotonicCoarse) {
+  uint64_t prev = get_time_monotonic_coarse_ns();
+  for (int i = 0; i < 100; ++i) {
+    uint64_t current = get_time_monotonic_coarse_ns();
+    EXPECT_GE(current, prev);
+    prev = current;
+  }
+}
+
+TEST(GetTimeUnitTest, MonotonicCoarseDuration) {
+  uint64_t start = get_time_monotonic_coarse_ns();
+
+  test::Utils::msleep(1000); // 1 second
+  uint64_t elapsed = get_time_monotonic_coarse_ns() - start;
+  // Allow for the clock's resolution
+  EXPECT_GE(elapsed,
+            static_cast<double>(NANOSECONDS_PER_SECOND - 20 * NANOSECONDS_PER_MILLISECOND));
+  EXPECT_LE(elapsed, static_cast<double>(2 * NANOSECONDS_PER_SECOND));
+}
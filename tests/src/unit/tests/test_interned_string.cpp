@@ -0,0 +1,61 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "flat_hash_map.hpp"
+#include "interned_string.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+
+TEST(InternedStringUnitTest, Intern) {
+  InternedString a("keyspace1");
+  InternedString b(String("keyspace1"));
+  InternedString c("keyspace2");
+
+  EXPECT_EQ(a, b);
+  EXPECT_NE(a, c);
+  EXPECT_EQ(&a.str(), &b.str()); // Shared
+  EXPECT_EQ("keyspace1", a.str());
+  EXPECT_EQ(a.hash(), b.hash());
+}
+
+TEST(InternedStringUnitTest, Empty) {
+  InternedString empty;
+  EXPECT_TRUE(empty.empty());
+  EXPECT_EQ("", empty.str());
+  EXPECT_EQ(empty, InternedString(""));
+  EXPECT_NE(empty, InternedString("keyspace1"));
+}
+
+TEST(InternedStringUnitTest, Find) {
+  EXPECT_TRUE(InternedString::find("never_interned").empty());
+
+  InternedString interned("dc1");
+  EXPECT_EQ(interned, InternedString::find("dc1"));
+  EXPECT_TRUE(InternedString::find("never_interned").empty()); // Finding doesn't intern
+}
+
+TEST(InternedStringUnitTest, MapKey) {
+  FlatHashMap<InternedString, int> map;
+  map[InternedString("ks1")] = 1;
+  map[InternedString("ks2")] = 2;
+
+  EXPECT_EQ(1, map[InternedString::find("ks1")]);
+  EXPECT_EQ(2, map[InternedString::find("ks2")]);
+  EXPECT_TRUE(map.find(InternedString::find("ks3")) == map.end());
+}
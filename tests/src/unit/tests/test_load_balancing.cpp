@@ -25,6 +25,7 @@
 #include "rack_aware_policy.hpp"
 #include "event_loop.hpp"
 #include "latency_aware_policy.hpp"
+#include "memory.hpp"
 #include "murmur3.hpp"
 #include "query_request.hpp"
 #include "random.hpp"
@@ -99,6 +100,22 @@ QueryCounts run_policy(LoadBalancingPolicy& policy, int count) {
   return counts;
 }
 
+QueryCounts run_policy(LoadBalancingPolicy& policy, int count, CassConsistency consistency) {
+  QueryCounts counts;
+  for (int i = 0; i < count; ++i) {
+    QueryRequest::Ptr request(new QueryRequest("", 0));
+    request->set_consistency(consistency);
+    SharedRefPtr<RequestHandler> request_handler(
+        new RequestHandler(request, ResponseFuture::Ptr()));
+    ScopedPtr<QueryPlan> qp(policy.new_query_plan("ks", request_handler.get(), NULL));
+    Host::Ptr host(qp->compute_next());
+    if (host) {
+      counts[host->address()] += 1;
+    }
+  }
+  return counts;
+}
+
 void verify_dcs(const QueryCounts& counts, const HostMap& hosts, const String& expected_dc) {
   for (QueryCounts::const_iterator it = counts.begin(), end = counts.end(); it != end; ++it) {
     HostMap::const_iterator host_it = hosts.find(it->first);
@@ -167,9 +184,11 @@ uint64_t calculate_moving_average(uint64_t first_latency_ns, uint64_t second_lat
 
   for (uint64_t i = 0; i < threshold_to_account; ++i) {
     host.update_latency(0); // This can be anything because it's not recorded
+    host.merge_latencies();
   }
 
   host.update_latency(first_latency_ns);
+  host.merge_latencies();
 
   // Spin wait
   uint64_t start = uv_hrtime();
@@ -177,6 +196,7 @@ uint64_t calculate_moving_average(uint64_t first_latency_ns, uint64_t second_lat
   }
 
   host.update_latency(second_latency_ns);
+  host.merge_latencies();
   TimestampedAverage current = host.get_current_average();
   return current.average;
 }
@@ -484,6 +504,31 @@ TEST(DatacenterAwareLoadBalancingUnitTest, UsedHostsPerDatacenter) {
   }
 }
 
+TEST(DatacenterAwareLoadBalancingUnitTest, ComputeNextKeepsHostReferences) {
+  HostMap hosts;
+  populate_hosts(3, "rack", LOCAL_DC, &hosts);
+  populate_hosts(3, "rack", REMOTE_DC, &hosts);
+
+  TokenAwarePolicy policy(new DCAwarePolicy(LOCAL_DC, 3, false), false);
+  policy.init(SharedRefPtr<Host>(), hosts, NULL, "", "");
+
+  Map<Address, int> ref_counts;
+  for (HostMap::const_iterator it = hosts.begin(), end = hosts.end(); it != end; ++it) {
+    ref_counts[it->first] = it->second->ref_count();
+  }
+
+  // The chained plans return the hosts they reference without copying them
+  ScopedPtr<QueryPlan> qp(policy.new_query_plan("ks", NULL, NULL));
+  size_t count = 0;
+  while (true) {
+    const Host::Ptr& host(qp->compute_next());
+    if (!host) break;
+    EXPECT_EQ(ref_counts[host->address()], host->ref_count());
+    ++count;
+  }
+  EXPECT_EQ(6u, count);
+}
+
 TEST(DatacenterAwareLoadBalancingUnitTest, AllowRemoteDatacentersForLocalConsistencyLevel) {
   HostMap hosts;
   populate_hosts(3, "rack", LOCAL_DC, &hosts);
@@ -1140,6 +1185,50 @@ TEST(TokenAwareLoadBalancingUnitTest, NetworkTopology) {
   }
 }
 
+TEST(TokenAwareLoadBalancingUnitTest, RackAwareReplicas) {
+  const int64_t num_hosts = 4;
+  HostMap hosts;
+  TokenMap::Ptr token_map(TokenMap::from_partitioner(Murmur3Partitioner::name()));
+
+  // Tokens
+  // 1.0.0.0 local  rack2 -4611686018427387905
+  // 2.0.0.0 local  rack1 -2
+  // 3.0.0.0 remote rack1  4611686018427387901
+  // 4.0.0.0 local  rack1  9223372036854775804
+  const char* racks[] = { "rack2", "rack1", "rack1", "rack1" };
+  const String dcs[] = { LOCAL_DC, LOCAL_DC, REMOTE_DC, LOCAL_DC };
+
+  const uint64_t partition_size = CASS_UINT64_MAX / num_hosts;
+  Murmur3Partitioner::Token token = CASS_INT64_MIN + static_cast<int64_t>(partition_size);
+
+  for (size_t i = 1; i <= num_hosts; ++i) {
+    Host::Ptr host(create_host(addr_for_sequence(i), single_token(token),
+                               Murmur3Partitioner::name().to_string(), racks[i - 1], dcs[i - 1]));
+
+    hosts[host->address()] = host;
+    token_map->add_host(host);
+    token += partition_size;
+  }
+
+  add_keyspace_simple("test", 4, token_map.get());
+  token_map->build();
+
+  TokenAwarePolicy policy(new RackAwarePolicy(LOCAL_DC, "rack1"), false);
+  policy.init(SharedRefPtr<Host>(), hosts, NULL, "", "");
+
+  QueryRequest::Ptr request(new QueryRequest("", 1));
+  const char* value = "kjdfjkldsdjkl"; // hash: 9024137376112061887
+  request->set(0, CassString(value, strlen(value)));
+  request->add_key_index(0);
+  SharedRefPtr<RequestHandler> request_handler(new RequestHandler(request, ResponseFuture::Ptr()));
+
+  // The replicas (4, 1, 2, 3) are ordered local rack, local datacenter and then
+  // remote datacenter
+  ScopedPtr<QueryPlan> qp(policy.new_query_plan("test", request_handler.get(), token_map.get()));
+  const size_t seq[] = { 4, 2, 1, 3 };
+  verify_sequence(qp.get(), VECTOR_FROM(size_t, seq));
+}
+
 TEST(TokenAwareLoadBalancingUnitTest, ShuffleReplicas) {
   Random random;
 
@@ -1226,6 +1315,158 @@ TEST(TokenAwareLoadBalancingUnitTest, ShuffleReplicas) {
   }
 }
 
+class LwtQueryRequest : public QueryRequest {
+public:
+  LwtQueryRequest()
+      : QueryRequest("", 1) {}
+
+  virtual bool is_lwt() const { return true; }
+};
+
+TEST(TokenAwareLoadBalancingUnitTest, LwtUsesRingOrder) {
+  Random random;
+
+  const int64_t num_hosts = 4;
+  HostMap hosts;
+  TokenMap::Ptr token_map(TokenMap::from_partitioner(Murmur3Partitioner::name()));
+
+  const uint64_t partition_size = CASS_UINT64_MAX / num_hosts;
+  Murmur3Partitioner::Token token = CASS_INT64_MIN + static_cast<int64_t>(partition_size);
+
+  for (size_t i = 1; i <= num_hosts; ++i) {
+    Host::Ptr host(create_host(addr_for_sequence(i), single_token(token),
+                               Murmur3Partitioner::name().to_string(), "rack1", LOCAL_DC));
+
+    hosts[host->address()] = host;
+    token_map->add_host(host);
+    token += partition_size;
+  }
+
+  add_keyspace_simple("test", 3, token_map.get());
+  token_map->build();
+
+  QueryRequest::Ptr request(new LwtQueryRequest());
+  const char* value = "kjdfjkldsdjkl"; // hash: 9024137376112061887
+  request->set(0, CassString(value, strlen(value)));
+  request->add_key_index(0);
+  SharedRefPtr<RequestHandler> request_handler(new RequestHandler(request, ResponseFuture::Ptr()));
+
+  // Even when the replicas are shuffled, lightweight transactions always use
+  // the primary replica first followed by the other replicas in ring order
+  TokenAwarePolicy policy(new RoundRobinPolicy(), true);
+  policy.init(SharedRefPtr<Host>(), hosts, &random, "", "");
+  for (int i = 0; i < 10; ++i) {
+    ScopedPtr<QueryPlan> qp(policy.new_query_plan("test", request_handler.get(), token_map.get()));
+    EXPECT_EQ(addr_for_sequence(4), qp->compute_next()->address());
+    EXPECT_EQ(addr_for_sequence(1), qp->compute_next()->address());
+    EXPECT_EQ(addr_for_sequence(2), qp->compute_next()->address());
+  }
+}
+
+static int query_plan_malloc_count = 0;
+static void* query_plan_malloc(size_t size) {
+  query_plan_malloc_count++;
+  return ::malloc(size);
+}
+
+static void* query_plan_realloc(void* ptr, size_t size) { return ::realloc(ptr, size); }
+
+static void query_plan_free(void* ptr) { ::free(ptr); }
+
+TEST(TokenAwareLoadBalancingUnitTest, QueryPlanStorage) {
+  Random random;
+
+  const int64_t num_hosts = 4;
+  HostMap hosts;
+  TokenMap::Ptr token_map(TokenMap::from_partitioner(Murmur3Partitioner::name()));
+
+  const uint64_t partition_size = CASS_UINT64_MAX / num_hosts;
+  Murmur3Partitioner::Token token = CASS_INT64_MIN + static_cast<int64_t>(partition_size);
+
+  for (size_t i = 1; i <= num_hosts; ++i) {
+    Host::Ptr host(create_host(addr_for_sequence(i), single_token(token),
+                               Murmur3Partitioner::name().to_string(), "rack1", LOCAL_DC));
+
+    hosts[host->address()] = host;
+    token_map->add_host(host);
+    token += partition_size;
+  }
+
+  add_keyspace_simple("test", 3, token_map.get());
+  token_map->build();
+
+  TokenAwarePolicy policy(new DCAwarePolicy(LOCAL_DC, 0, false), true); // Shuffled
+  policy.init(SharedRefPtr<Host>(), hosts, &random, LOCAL_DC, "");
+
+  QueryRequest::Ptr request(new QueryRequest("", 1));
+  const char* value = "kjdfjkldsdjkl"; // hash: 9024137376112061887
+  request->set(0, CassString(value, strlen(value)));
+  request->add_key_index(0);
+  SharedRefPtr<RequestHandler> request_handler(new RequestHandler(request, ResponseFuture::Ptr()));
+
+  // The token-aware and DC-aware query plans are placed in the request
+  // handler and neither the plans nor the shuffled replicas use the heap
+  HostVec replicas;
+  replicas.reserve(num_hosts);
+  Memory::set_functions(query_plan_malloc, query_plan_realloc, query_plan_free);
+  {
+    ScopedPtr<QueryPlan> qp(policy.new_query_plan("test", request_handler.get(), token_map.get()));
+    Host::Ptr host;
+    while ((host = qp->compute_next())) {
+      replicas.push_back(host);
+    }
+  }
+  Memory::set_functions(NULL, NULL, NULL);
+  EXPECT_EQ(0, query_plan_malloc_count);
+  EXPECT_GT(request_handler->query_plan_storage()->used(), 0u);
+
+  // Replicas first, then the rest of the local datacenter
+  ASSERT_EQ(4u, replicas.size());
+  EXPECT_EQ(addr_for_sequence(3), replicas[3]->address());
+
+  // Without a request handler the query plans are allocated from the heap
+  ScopedPtr<QueryPlan> qp(policy.new_query_plan("test", NULL, token_map.get()));
+  EXPECT_TRUE(qp->compute_next());
+}
+
+TEST(TokenAwareLoadBalancingUnitTest, LeastLoadedReplicas) {
+  const uint64_t one_ms = 1000000LL;
+
+  CopyOnWriteHostVec replicas(new HostVec());
+  for (size_t i = 1; i <= 4; ++i) {
+    Host::Ptr host(host_for_addr(addr_for_sequence(i)));
+    host->enable_latency_tracking(100LL * one_ms, 1);
+    replicas->push_back(host);
+  }
+
+  // Equally loaded replicas keep their ring order
+  CopyOnWriteHostVec ordered(TokenAwarePolicy::order_by_load(replicas, NULL));
+  ASSERT_EQ(4u, ordered->size());
+  for (size_t i = 0; i < 4; ++i) {
+    EXPECT_EQ((*replicas)[i], (*ordered)[i]);
+  }
+
+  // Replicas with fewer in-flight requests come first
+  (*replicas)[0]->increment_inflight_requests();
+  (*replicas)[0]->increment_inflight_requests();
+  (*replicas)[1]->increment_inflight_requests();
+
+  // Latency breaks ties between replicas with the same number of in-flight requests
+  for (int i = 0; i < 100; ++i) {
+    (*replicas)[2]->update_latency(10 * one_ms);
+    (*replicas)[3]->update_latency(1 * one_ms);
+    (*replicas)[2]->merge_latencies();
+    (*replicas)[3]->merge_latencies();
+  }
+
+  ordered = TokenAwarePolicy::order_by_load(replicas, NULL);
+  ASSERT_EQ(4u, ordered->size());
+  EXPECT_EQ((*replicas)[3], (*ordered)[0]);
+  EXPECT_EQ((*replicas)[2], (*ordered)[1]);
+  EXPECT_EQ((*replicas)[1], (*ordered)[2]);
+  EXPECT_EQ((*replicas)[0], (*ordered)[3]);
+}
+
 TEST(LatencyAwareLoadBalancingUnitTest, ThreadholdToAccount) {
   const uint64_t scale = 100LL;
   const uint64_t min_measured = 15LL;
@@ -1238,12 +1479,14 @@ TEST(LatencyAwareLoadBalancingUnitTest, ThreadholdToAccount) {
   TimestampedAverage current = host.get_current_average();
   for (uint64_t i = 0; i < threshold_to_account; ++i) {
     host.update_latency(one_ms);
+    host.merge_latencies();
     current = host.get_current_average();
     EXPECT_EQ(current.num_measured, i + 1);
     EXPECT_EQ(current.average, -1);
   }
 
   host.update_latency(one_ms);
+  host.merge_latencies();
   current = host.get_current_average();
   EXPECT_EQ(current.num_measured, threshold_to_account + 1);
   EXPECT_EQ(current.average, static_cast<int64_t>(one_ms));
@@ -1381,6 +1624,58 @@ TEST(LatencyAwareLoadBalancingUnitTest, MinAverageUnderMinMeasured) {
   EXPECT_EQ(policy.min_average(), -1);
 }
 
+static void update_latencies(void* arg) {
+  Host* host = static_cast<Host*>(arg);
+  for (int i = 0; i < 1000; ++i) {
+    host->update_latency(1000000LL); // 1 ms
+  }
+}
+
+TEST(LatencyAwareLoadBalancingUnitTest, ShardedUpdates) {
+  const int num_threads = 4;
+
+  Host host(Address("0.0.0.0", 9042));
+  host.enable_latency_tracking(100LL, 0);
+  host.update_latency(1000000LL); // Start the average
+  host.merge_latencies();
+
+  uv_thread_t threads[num_threads];
+  for (int i = 0; i < num_threads; ++i) {
+    ASSERT_EQ(0, uv_thread_create(&threads[i], update_latencies, &host));
+  }
+  for (int i = 0; i < num_threads; ++i) {
+    uv_thread_join(&threads[i]);
+  }
+
+  // All the threads' latencies are accounted for after merging
+  host.merge_latencies();
+  TimestampedAverage current = host.get_current_average();
+  EXPECT_EQ(static_cast<uint64_t>(num_threads * 1000 + 1), current.num_measured);
+  EXPECT_EQ(1000000LL, current.average);
+}
+
+TEST(LatencyAwareLoadBalancingUnitTest, InflightPenalty) {
+  LatencyAwarePolicy::Settings settings;
+  settings.inflight_penalty = 0.1;
+  LatencyAwarePolicy policy(new RoundRobinPolicy(), settings);
+
+  Host::Ptr host(new Host(Address("0.0.0.0", 9042)));
+  TimestampedAverage latency;
+  latency.average = 1000;
+
+  // No penalty without in-flight requests
+  EXPECT_EQ(1000, policy.penalized_average(host, latency));
+
+  // Each in-flight request per connection adds 10% of the average
+  for (int i = 0; i < 4; ++i) {
+    host->increment_inflight_requests();
+  }
+  EXPECT_EQ(1400, policy.penalized_average(host, latency));
+  host->increment_connection_count();
+  host->increment_connection_count();
+  EXPECT_EQ(1200, policy.penalized_average(host, latency));
+}
+
 TEST(WhitelistLoadBalancingUnitTest, Hosts) {
   const int64_t num_hosts = 100;
   HostMap hosts;
@@ -1422,6 +1717,45 @@ TEST(WhitelistLoadBalancingUnitTest, Datacenters) {
   ASSERT_FALSE(qp.get()->compute_next(&next_address));
 }
 
+TEST(WhitelistLoadBalancingUnitTest, HostAddedAndRemoved) {
+  HostMap hosts;
+  populate_hosts(3, "rack1", LOCAL_DC, &hosts);
+  DcList whitelist_dcs;
+  whitelist_dcs.push_back(LOCAL_DC);
+  WhitelistDCPolicy policy(new RoundRobinPolicy(), whitelist_dcs);
+  policy.init(SharedRefPtr<Host>(), hosts, NULL, "", "");
+
+  Host::Ptr local_host(host_for_addr(addr_for_sequence(4), "rack1", LOCAL_DC));
+  Host::Ptr remote_host(host_for_addr(addr_for_sequence(5), "rack1", REMOTE_DC));
+  policy.on_host_added(local_host);
+  policy.on_host_added(remote_host);
+  policy.on_host_up(local_host);
+  policy.on_host_up(remote_host);
+  EXPECT_EQ(CASS_HOST_DISTANCE_LOCAL, policy.distance(local_host));
+  EXPECT_EQ(CASS_HOST_DISTANCE_IGNORE, policy.distance(remote_host));
+
+  {
+    ScopedPtr<QueryPlan> qp(policy.new_query_plan("ks", NULL, NULL));
+    const size_t seq[] = { 1, 2, 3, 4 };
+    verify_sequence(qp.get(), VECTOR_FROM(size_t, seq));
+  }
+
+  policy.on_host_removed(local_host);
+  EXPECT_EQ(CASS_HOST_DISTANCE_IGNORE, policy.distance(local_host));
+
+  {
+    ScopedPtr<QueryPlan> qp(policy.new_query_plan("ks", NULL, NULL));
+    Address next_address;
+    size_t count = 0;
+    while (qp->compute_next(&next_address)) {
+      EXPECT_NE(local_host->address(), next_address);
+      EXPECT_NE(remote_host->address(), next_address);
+      ++count;
+    }
+    EXPECT_EQ(3u, count);
+  }
+}
+
 TEST(BlacklistLoadBalancingUnitTest, Hosts) {
   const int64_t num_hosts = 5;
   HostMap hosts;
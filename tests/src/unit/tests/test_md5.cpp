@@ -19,6 +19,7 @@
 #include "md5.hpp"
 
 using datastax::internal::Md5;
+using datastax::internal::md5_batch;
 
 static bool hash_equal(uint8_t* hash, const char* hash_str) {
   const char* p = hash_str;
@@ -65,3 +66,33 @@ TEST(Md5UnitTest, Simple) {
 
   EXPECT_TRUE(check_hash(big_str, "15355dec7c48faeb01b46366d90be0be"));
 }
+
+TEST(Md5UnitTest, Batch) {
+  // Messages of different sizes, including ones that need an extra padding
+  // block and ones with several blocks, are hashed in the same batches
+  std::string messages[130];
+  const uint8_t* data[130];
+  size_t sizes[130];
+  for (size_t i = 0; i < 130; ++i) {
+    for (size_t j = 0; j < i; ++j) {
+      messages[i].push_back(static_cast<char>('a' + (i + j) % 26));
+    }
+    data[i] = reinterpret_cast<const uint8_t*>(messages[i].data());
+    sizes[i] = messages[i].size();
+  }
+
+  uint8_t digests[130 * 16];
+  md5_batch(data, sizes, 130, digests);
+  for (size_t i = 0; i < 130; ++i) {
+    Md5 m;
+    m.update(data[i], sizes[i]);
+    uint8_t hash[16];
+    m.final(hash);
+    EXPECT_EQ(0, memcmp(hash, digests + i * 16, 16)) << "Message of size " << i;
+  }
+
+  data[0] = reinterpret_cast<const uint8_t*>("abc");
+  sizes[0] = 3;
+  md5_batch(data, sizes, 1, digests);
+  EXPECT_TRUE(hash_equal(digests, "900150983cd24fb0d6963f7d28e17f72"));
+}
@@ -0,0 +1,57 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "buffer.hpp"
+#include "buffer_pool.hpp"
+#include "memory_accounting.hpp"
+#include "ring_buffer.hpp"
+
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+TEST(MemoryAccountingUnitTest, RequestBuffers) {
+  size_t start = MemoryAccounting::bytes(MEMORY_CATEGORY_REQUEST_BUFFERS);
+  {
+    Buffer buffer(64 * 1024);
+    EXPECT_GE(MemoryAccounting::bytes(MEMORY_CATEGORY_REQUEST_BUFFERS), start + 64 * 1024);
+    EXPECT_GE(MemoryAccounting::buffer_bytes(), 64u * 1024);
+  }
+  EXPECT_EQ(start, MemoryAccounting::bytes(MEMORY_CATEGORY_REQUEST_BUFFERS));
+}
+
+TEST(MemoryAccountingUnitTest, ResponseBuffers) {
+  size_t start = MemoryAccounting::bytes(MEMORY_CATEGORY_RESPONSE_BUFFERS);
+  {
+    BufferPool::Ptr pool(new BufferPool());
+    pool->acquire(1024);        // Kept by the pool
+    pool->acquire(1024 * 1024); // Too large to pool
+    EXPECT_GE(MemoryAccounting::bytes(MEMORY_CATEGORY_RESPONSE_BUFFERS), start + 1024);
+    EXPECT_LT(MemoryAccounting::bytes(MEMORY_CATEGORY_RESPONSE_BUFFERS), start + 1024 * 1024);
+  }
+  EXPECT_EQ(start, MemoryAccounting::bytes(MEMORY_CATEGORY_RESPONSE_BUFFERS));
+}
+
+TEST(MemoryAccountingUnitTest, SslBuffers) {
+  size_t start = MemoryAccounting::bytes(MEMORY_CATEGORY_SSL_BUFFERS);
+  {
+    rb::RingBuffer ring_buffer;
+    EXPECT_GE(MemoryAccounting::bytes(MEMORY_CATEGORY_SSL_BUFFERS),
+              start + rb::ChunkPool::MIN_CHUNK_SIZE);
+  }
+  EXPECT_EQ(start, MemoryAccounting::bytes(MEMORY_CATEGORY_SSL_BUFFERS));
+}
@@ -16,7 +16,10 @@
 
 #include <gtest/gtest.h>
 
+#include "metadata.hpp"
+#include "mockssandra.hpp"
 #include "result_metadata.hpp"
+#include "result_response.hpp"
 
 using namespace datastax;
 using namespace datastax::internal;
@@ -81,3 +84,134 @@ TEST(ResultMetadataUnitTest, CaseSensitive) {
     EXPECT_EQ(count, 7u);
   }
 }
+
+static ResultResponse::Ptr decode_result(const mockssandra::ResultSet& result_set) {
+  String body(result_set.encode(CASS_PROTOCOL_VERSION_V4));
+  ResultResponse::Ptr result(new ResultResponse());
+  result->set_buffer(body.size());
+  memcpy(result->buffer()->data(), body.data(), body.size());
+  Decoder decoder(result->data(), body.size(), ProtocolVersion(CASS_PROTOCOL_VERSION_V4));
+  EXPECT_TRUE(result->decode(decoder));
+  return result;
+}
+
+static mockssandra::Row table_row(const String& keyspace_name, const String& table_name) {
+  return mockssandra::Row::Builder().text(keyspace_name).text(table_name).build();
+}
+
+static mockssandra::Row column_row(const String& keyspace_name, const String& table_name,
+                                   const String& column_name, const String& kind) {
+  return mockssandra::Row::Builder()
+      .text(keyspace_name)
+      .text(table_name)
+      .text(column_name)
+      .text(kind)
+      .text("int")
+      .build();
+}
+
+TEST(MetadataUnitTest, LazyKeyspaces) {
+  VersionNumber server_version(3, 11, 0);
+  Metadata metadata;
+  metadata.clear_and_update_back(server_version);
+
+  metadata.update_keyspaces(
+      decode_result(mockssandra::ResultSet::Builder("system_schema", "keyspaces")
+                        .column("keyspace_name", mockssandra::Type::text())
+                        .row(mockssandra::Row::Builder().text("ks1").build())
+                        .row(mockssandra::Row::Builder().text("ks2").build())
+                        .build())
+          .get(),
+      false);
+
+  SchemaRows::Ptr rows(new SchemaRows(server_version));
+  rows->tables = decode_result(mockssandra::ResultSet::Builder("system_schema", "tables")
+                                   .column("keyspace_name", mockssandra::Type::text())
+                                   .column("table_name", mockssandra::Type::text())
+                                   .row(table_row("ks1", "t1"))
+                                   .row(table_row("ks2", "t2"))
+                                   .build());
+  rows->columns = decode_result(mockssandra::ResultSet::Builder("system_schema", "columns")
+                                    .column("keyspace_name", mockssandra::Type::text())
+                                    .column("table_name", mockssandra::Type::text())
+                                    .column("column_name", mockssandra::Type::text())
+                                    .column("kind", mockssandra::Type::text())
+                                    .column("type", mockssandra::Type::text())
+                                    .row(column_row("ks1", "t1", "key", "partition_key"))
+                                    .row(column_row("ks1", "t1", "value", "regular"))
+                                    .row(column_row("ks2", "t2", "key", "partition_key"))
+                                    .build());
+  metadata.set_lazy_keyspaces(rows);
+  metadata.swap_to_back_and_update_front();
+
+  Metadata::SchemaSnapshot snapshot(metadata.schema_snapshot());
+  const KeyspaceMetadata* ks1 = snapshot.get_keyspace("ks1");
+  const KeyspaceMetadata* ks2 = snapshot.get_keyspace("ks2");
+  ASSERT_TRUE(ks1 != NULL);
+  ASSERT_TRUE(ks2 != NULL);
+  EXPECT_FALSE(ks1->is_loaded());
+  EXPECT_FALSE(ks2->is_loaded());
+
+  // Only the accessed keyspace is built
+  const TableMetadata* t1 = ks1->get_table("t1");
+  ASSERT_TRUE(t1 != NULL);
+  EXPECT_TRUE(ks1->is_loaded());
+  EXPECT_FALSE(ks2->is_loaded());
+  EXPECT_EQ(2u, t1->columns().size());
+  ASSERT_EQ(1u, t1->partition_key().size());
+  EXPECT_EQ("key", t1->partition_key()[0]->name());
+  EXPECT_TRUE(ks1->get_table("t2") == NULL);
+
+  // Incremental updates keep the lazily built elements
+  metadata.update_tables(decode_result(mockssandra::ResultSet::Builder("system_schema", "tables")
+                                           .column("keyspace_name", mockssandra::Type::text())
+                                           .column("table_name", mockssandra::Type::text())
+                                           .row(table_row("ks2", "t3"))
+                                           .build())
+                             .get());
+
+  Metadata::SchemaSnapshot updated(metadata.schema_snapshot());
+  ks2 = updated.get_keyspace("ks2");
+  ASSERT_TRUE(ks2 != NULL);
+  EXPECT_TRUE(ks2->is_loaded());
+  EXPECT_TRUE(ks2->get_table("t2") != NULL);
+  EXPECT_TRUE(ks2->get_table("t3") != NULL);
+}
+
+TEST(MetadataUnitTest, SchemaSnapshotVersion) {
+  VersionNumber server_version(3, 11, 0);
+  Metadata metadata;
+  metadata.clear_and_update_back(server_version);
+
+  metadata.update_keyspaces(
+      decode_result(mockssandra::ResultSet::Builder("system_schema", "keyspaces")
+                        .column("keyspace_name", mockssandra::Type::text())
+                        .row(mockssandra::Row::Builder().text("ks1").build())
+                        .build())
+          .get(),
+      false);
+  metadata.swap_to_back_and_update_front();
+
+  Metadata::SchemaSnapshot snapshot(metadata.schema_snapshot());
+  EXPECT_EQ(snapshot.version(), metadata.schema_snapshot_version());
+
+  // Updates to the front buffer change the version once they're visible
+  metadata.update_tables(decode_result(mockssandra::ResultSet::Builder("system_schema", "tables")
+                                           .column("keyspace_name", mockssandra::Type::text())
+                                           .column("table_name", mockssandra::Type::text())
+                                           .row(table_row("ks1", "t1"))
+                                           .build())
+                             .get());
+  EXPECT_NE(snapshot.version(), metadata.schema_snapshot_version());
+  EXPECT_TRUE(snapshot.get_keyspace("ks1")->get_table("t1") == NULL); // Not changed
+
+  Metadata::SchemaSnapshot updated(metadata.schema_snapshot());
+  EXPECT_EQ(updated.version(), metadata.schema_snapshot_version());
+  EXPECT_TRUE(updated.get_keyspace("ks1")->get_table("t1") != NULL);
+
+  // Clearing never goes back to an older version
+  uint32_t version = metadata.schema_snapshot_version();
+  metadata.clear();
+  EXPECT_NE(version, metadata.schema_snapshot_version());
+  EXPECT_NE(snapshot.version(), metadata.schema_snapshot_version());
+}
@@ -25,6 +25,7 @@
 #define NUM_THREADS 2
 #define NUM_ITERATIONS 100
 
+using datastax::internal::Vector;
 using datastax::internal::core::Metrics;
 
 struct CounterThreadArgs {
@@ -144,6 +145,83 @@ TEST(MetricsUnitTest, HistogramEmpty) {
   EXPECT_EQ(snapshot.percentile_999th, 0);
 }
 
+TEST(MetricsUnitTest, HistogramPercentileAndReset) {
+  Metrics::ThreadState thread_state(1);
+  Metrics::Histogram histogram(&thread_state);
+
+  for (uint64_t i = 1; i <= 100; ++i) {
+    histogram.record_value(i);
+  }
+
+  // Not enough values so nothing is reset
+  EXPECT_EQ(histogram.value_at_percentile_and_reset(95.0, 101), -1);
+  EXPECT_EQ(histogram.value_at_percentile_and_reset(95.0, 100), 95);
+
+  // Only the values recorded after the reset are used
+  for (uint64_t i = 1; i <= 100; ++i) {
+    histogram.record_value(1000);
+  }
+  EXPECT_EQ(histogram.value_at_percentile_and_reset(50.0, 100), 1000);
+  EXPECT_EQ(histogram.value_at_percentile_and_reset(50.0, 1), -1);
+}
+
+TEST(MetricsUnitTest, HistogramInterval) {
+  Metrics::ThreadState thread_state(1);
+  Metrics::Histogram histogram(&thread_state);
+
+  for (uint64_t i = 1; i <= 100; ++i) {
+    histogram.record_value(1);
+  }
+
+  Metrics::Histogram::Snapshot snapshot;
+  Vector<Metrics::Histogram::Bucket> buckets;
+  histogram.get_interval_snapshot(&snapshot, &buckets);
+  EXPECT_EQ(snapshot.min, 1);
+  EXPECT_EQ(snapshot.max, 1);
+  ASSERT_EQ(buckets.size(), 1u);
+  EXPECT_EQ(buckets[0].value, 1);
+  EXPECT_EQ(buckets[0].count, 100);
+
+  // The next interval only has the values recorded since the last snapshot
+  histogram.record_value(1000);
+  buckets.clear();
+  histogram.get_interval_snapshot(&snapshot, &buckets);
+  EXPECT_EQ(snapshot.min, 1000);
+  EXPECT_EQ(snapshot.max, 1000);
+  ASSERT_EQ(buckets.size(), 1u);
+  EXPECT_EQ(buckets[0].count, 1);
+
+  histogram.get_interval_snapshot(&snapshot);
+  EXPECT_EQ(snapshot.max, 0);
+
+  // The lifetime snapshot isn't reset
+  histogram.get_snapshot(&snapshot);
+  EXPECT_EQ(snapshot.min, 1);
+  EXPECT_EQ(snapshot.max, 1000);
+}
+
+TEST(MetricsUnitTest, HistogramSnapshotMaxAge) {
+  Metrics::ThreadState thread_state(1);
+  Metrics::Histogram histogram(&thread_state);
+  histogram.set_snapshot_max_age_ms(60 * 1000);
+
+  histogram.record_value(1);
+  Metrics::Histogram::Snapshot snapshot;
+  histogram.get_snapshot(&snapshot);
+  EXPECT_EQ(snapshot.max, 1);
+
+  // The values merged since the last snapshot aren't used until it's too old
+  histogram.record_value(1000);
+  histogram.merge();
+  histogram.get_snapshot(&snapshot);
+  EXPECT_EQ(snapshot.max, 1);
+
+  histogram.set_snapshot_max_age_ms(0);
+  histogram.get_snapshot(&snapshot);
+  EXPECT_EQ(snapshot.min, 1);
+  EXPECT_EQ(snapshot.max, 1000);
+}
+
 TEST(MetricsUnitTest, HistogramWithThreads) {
   HistogramThreadArgs args[NUM_THREADS];
 
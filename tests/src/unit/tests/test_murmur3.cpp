@@ -0,0 +1,74 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "cassandra.h"
+#include "murmur3.hpp"
+#include "string.hpp"
+#include "vector.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+
+TEST(Murmur3UnitTest, HashBatch) {
+  // Keys of every length up to a few blocks so that the lanes have both
+  // common and different numbers of blocks and every tail length
+  Vector<String> strs;
+  for (size_t i = 0; i < 67; ++i) {
+    String str;
+    for (size_t j = 0; j < i; ++j) {
+      str.push_back(static_cast<char>('a' + (i * 7 + j) % 26));
+    }
+    strs.push_back(str);
+  }
+
+  Vector<const char*> keys;
+  Vector<size_t> lengths;
+  for (Vector<String>::const_iterator i = strs.begin(), end = strs.end(); i != end; ++i) {
+    keys.push_back(i->data());
+    lengths.push_back(i->size());
+  }
+
+  // Also cover batches smaller than the number of lanes
+  for (size_t count = 0; count <= keys.size(); count += (count < 9 ? 1 : 29)) {
+    Vector<int64_t> output(count + 1, 0);
+    MurmurHash3_x64_128_batch(&keys[0], &lengths[0], count, 0, &output[0]);
+    for (size_t i = 0; i < count; ++i) {
+      EXPECT_EQ(MurmurHash3_x64_128(keys[i], static_cast<int>(lengths[i]), 0), output[i])
+          << "key " << i << " of " << count;
+    }
+    EXPECT_EQ(0, output[count]);
+  }
+}
+
+TEST(Murmur3UnitTest, HashBatchPublicApi) {
+  // The java-driver was used as a reference for the hash value of this UUID
+  // routing key
+  const char uuid[] = { '\xd8', '\x77', '\x5a', '\x70', '\x6e', '\xa4', '\x11', '\xe4',
+                        '\x9f', '\xa7', '\x0d', '\xb2', '\x2d', '\x2a', '\x61', '\x40' };
+  const char* keys[] = { uuid, "", "abc", uuid, "abcdefghijklmnopqrstuvwxyz" };
+  size_t lengths[] = { sizeof(uuid), 0, 3, sizeof(uuid), 26 };
+
+  cass_int64_t output[5];
+  cass_murmur3_hash_batch(keys, lengths, 5, output);
+
+  EXPECT_EQ(6739078495667776670LL, output[0]);
+  EXPECT_EQ(output[0], output[3]);
+  for (size_t i = 0; i < 5; ++i) {
+    EXPECT_EQ(MurmurHash3_x64_128(keys[i], static_cast<int>(lengths[i]), 0), output[i]);
+  }
+}
@@ -0,0 +1,108 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "memory.hpp"
+#include "object_cache.hpp"
+
+#include <stdlib.h>
+#include <uv.h>
+
+using namespace datastax::internal;
+
+#define OBJECT_COUNT 1000
+
+static int cache_free_count = 0;
+static void* cache_malloc(size_t size) { return ::malloc(size); }
+static void* cache_realloc(void* ptr, size_t size) { return ::realloc(ptr, size); }
+static void cache_free(void* ptr) {
+  cache_free_count++;
+  ::free(ptr);
+}
+
+class ObjectCacheUnitTest : public testing::Test {
+public:
+  void SetUp() {
+    cache_free_count = 0;
+    Memory::set_functions(cache_malloc, cache_realloc, cache_free);
+  }
+
+  void TearDown() { Memory::set_functions(NULL, NULL, NULL); }
+
+  static CassObjectCacheStats stats() {
+    CassObjectCacheStats stats;
+    cass_alloc_get_object_cache_stats(&stats);
+    return stats;
+  }
+};
+
+static void free_objects(void* arg) {
+  void** objects = static_cast<void**>(arg);
+  for (int i = 0; i < OBJECT_COUNT; ++i) {
+    ObjectCache::deallocate(objects[i]);
+  }
+}
+
+TEST_F(ObjectCacheUnitTest, Reuse) {
+  void* first = ObjectCache::allocate(100);
+  memset(first, 0xFF, 100);
+  ObjectCache::deallocate(first);
+
+  CassObjectCacheStats before = stats();
+  void* second = ObjectCache::allocate(100);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(before.hits + 1, stats().hits);
+  EXPECT_EQ(before.misses, stats().misses);
+  ObjectCache::deallocate(second);
+  EXPECT_EQ(0, cache_free_count);
+}
+
+TEST_F(ObjectCacheUnitTest, Oversized) {
+  CassObjectCacheStats before = stats();
+  void* object = ObjectCache::allocate(64 * 1024);
+  memset(object, 0xFF, 64 * 1024);
+  ObjectCache::deallocate(object);
+  EXPECT_EQ(1, cache_free_count);
+  EXPECT_EQ(before.hits, stats().hits);
+  EXPECT_EQ(before.misses, stats().misses);
+}
+
+TEST_F(ObjectCacheUnitTest, CrossThreadFree) {
+  void* objects[OBJECT_COUNT];
+  for (int i = 0; i < OBJECT_COUNT; ++i) {
+    objects[i] = ObjectCache::allocate(200);
+  }
+
+  // Objects freed on another thread are returned to this thread through the
+  // depot's full magazines
+  uv_thread_t thread;
+  ASSERT_EQ(0, uv_thread_create(&thread, free_objects, objects));
+  uv_thread_join(&thread);
+  EXPECT_GT(stats().depot_magazines, 0u);
+  EXPECT_GE(stats().thread_caches, 2u);
+
+  CassObjectCacheStats before = stats();
+  for (int i = 0; i < OBJECT_COUNT / 2; ++i) {
+    objects[i] = ObjectCache::allocate(200);
+  }
+  EXPECT_EQ(before.hits + OBJECT_COUNT / 2, stats().hits);
+  EXPECT_EQ(before.misses, stats().misses);
+
+  for (int i = 0; i < OBJECT_COUNT / 2; ++i) {
+    ObjectCache::deallocate(objects[i]);
+  }
+}
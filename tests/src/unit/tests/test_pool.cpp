@@ -15,10 +15,13 @@
 
 #include "connection_pool_manager_initializer.hpp"
 #include "constants.hpp"
+#include "get_time.hpp"
+#include "metrics.hpp"
 #include "ssl.hpp"
 
 #define NUM_NODES 3u
 
+using namespace datastax::internal;
 using namespace datastax::internal::core;
 
 class PoolUnitTest : public LoopTest {
@@ -383,6 +386,49 @@ public:
     manager->flush();
   }
 
+  static void on_pool_connected_pressure(ConnectionPoolManagerInitializer* initializer,
+                                         RequestStatusWithManager* status) {
+    const Address address("127.0.0.1", 9042);
+    ConnectionPoolManager::Ptr manager = initializer->release_manager();
+    status->set_manager(manager);
+
+    for (size_t i = 0; i < 10; ++i) {
+      PooledConnection::Ptr connection = manager->find_least_busy(address);
+      if (connection) {
+        RequestCallback::Ptr callback(new RequestCallback(status));
+        if (connection->write(callback.get()) < 0) {
+          status->error_failed_write();
+        }
+      } else {
+        status->error_no_connection();
+      }
+    }
+    manager->flush();
+  }
+
+  static void on_pool_connected_remove(ConnectionPoolManagerInitializer* initializer,
+                                       RequestStatusWithManager* status) {
+    const Address address("127.0.0.1", 9042);
+    ConnectionPoolManager::Ptr manager = initializer->release_manager();
+    status->set_manager(manager);
+
+    for (size_t i = 0; i < 2; ++i) {
+      PooledConnection::Ptr connection = manager->find_least_busy(address);
+      if (connection) {
+        RequestCallback::Ptr callback(new RequestCallback(status));
+        if (connection->write(callback.get()) < 0) {
+          status->error_failed_write();
+        }
+      } else {
+        status->error_no_connection();
+      }
+    }
+    manager->flush();
+
+    manager->remove(address); // Remove the node while its requests are in-flight
+    EXPECT_FALSE(manager->find_least_busy(address));
+  }
+
   static void on_pool_nop(ConnectionPoolManagerInitializer* initializer,
                           RequestStatusWithManager* status) {
     ConnectionPoolManager::Ptr manager = initializer->release_manager();
@@ -843,6 +889,204 @@ TEST_F(PoolUnitTest, NoAvailableStreams) {
       << status.results();
 }
 
+TEST_F(PoolUnitTest, GrowUnderPressure) {
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(mockssandra::OPCODE_QUERY).wait(1000).void_result(); // Keep requests in-flight
+  mockssandra::SimpleCluster cluster(builder.build(), 1);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Metrics metrics(1);
+  RequestStatusWithManager status(loop(), 10);
+
+  ConnectionPoolManagerInitializer::Ptr initializer(new ConnectionPoolManagerInitializer(
+      PROTOCOL_VERSION, bind_callback(on_pool_connected_pressure, &status)));
+
+  ConnectionPoolSettings settings;
+  settings.num_connections_per_host = 1;
+  settings.max_connections_per_host = 2;
+  settings.max_concurrent_requests_threshold = 1;
+
+  initializer->with_settings(settings)->with_metrics(&metrics)->initialize(loop(), hosts(1));
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  EXPECT_EQ(status.count(RequestStatus::SUCCESS), 10u) << status.results();
+  EXPECT_EQ(2, metrics.total_connections.sum()); // Grown to the maximum
+}
+
+TEST_F(PoolUnitTest, DrainOnRemove) {
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(mockssandra::OPCODE_QUERY).wait(200).void_result(); // Keep requests in-flight
+  mockssandra::SimpleCluster cluster(builder.build(), 1);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  RequestStatusWithManager status(loop(), 2);
+
+  ConnectionPoolManagerInitializer::Ptr initializer(new ConnectionPoolManagerInitializer(
+      PROTOCOL_VERSION, bind_callback(on_pool_connected_remove, &status)));
+
+  ConnectionPoolSettings settings;
+  settings.drain_timeout_ms = 5000;
+
+  initializer->with_settings(settings)->initialize(loop(), hosts(1));
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  // The in-flight requests finish on the removed host's connections
+  EXPECT_EQ(status.count(RequestStatus::SUCCESS), 2u) << status.results();
+}
+
+TEST_F(PoolUnitTest, DrainTimeoutOnRemove) {
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(mockssandra::OPCODE_QUERY).wait(5000).void_result(); // Keep requests in-flight
+  mockssandra::SimpleCluster cluster(builder.build(), 1);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  RequestStatusWithManager status(loop(), 2);
+
+  ConnectionPoolManagerInitializer::Ptr initializer(new ConnectionPoolManagerInitializer(
+      PROTOCOL_VERSION, bind_callback(on_pool_connected_remove, &status)));
+
+  ConnectionPoolSettings settings;
+  settings.drain_timeout_ms = 200;
+
+  uint64_t start = get_time_monotonic_ns();
+  initializer->with_settings(settings)->initialize(loop(), hosts(1));
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  // The connections are closed once the drain timeout expires
+  EXPECT_EQ(status.count(RequestStatus::ERROR), 2u) << status.results();
+  EXPECT_LT(get_time_monotonic_ns() - start, 5000u * NANOSECONDS_PER_MILLISECOND);
+}
+
+TEST_F(PoolUnitTest, Warmup) {
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(mockssandra::OPCODE_QUERY)
+      .is_query("SELECT warmup")
+      .then(mockssandra::Action::Builder().wait(200).void_result()) // Slow warm-up requests
+      .empty_rows_result(1);
+  mockssandra::SimpleCluster cluster(builder.build(), NUM_NODES);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  RequestStatusWithManager status(loop());
+
+  ConnectionPoolManagerInitializer::Ptr initializer(new ConnectionPoolManagerInitializer(
+      PROTOCOL_VERSION, bind_callback(on_pool_connected, &status)));
+
+  ConnectionPoolSettings settings;
+  settings.warmup_requests_per_connection = 2;
+  settings.warmup_query = "SELECT warmup";
+
+  uint64_t start = get_time_monotonic_ns();
+  initializer->with_settings(settings)->initialize(loop(), hosts());
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  EXPECT_EQ(status.count(RequestStatus::SUCCESS), NUM_NODES) << status.results();
+  // The pools are only used once their warm-up requests have finished
+  EXPECT_GE(get_time_monotonic_ns() - start, 200u * NANOSECONDS_PER_MILLISECOND);
+}
+
+TEST_F(PoolUnitTest, WarmupOptions) {
+  mockssandra::SimpleCluster cluster(simple(), NUM_NODES);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  RequestStatusWithManager status(loop());
+
+  ConnectionPoolManagerInitializer::Ptr initializer(new ConnectionPoolManagerInitializer(
+      PROTOCOL_VERSION, bind_callback(on_pool_connected, &status)));
+
+  ConnectionPoolSettings settings;
+  settings.warmup_requests_per_connection = 4; // OPTIONS requests
+
+  initializer->with_settings(settings)->initialize(loop(), hosts());
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  EXPECT_EQ(status.count(RequestStatus::SUCCESS), NUM_NODES) << status.results();
+}
+
+TEST_F(PoolUnitTest, PowerOfTwoChoices) {
+  mockssandra::SimpleCluster cluster(simple(), NUM_NODES);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  RequestStatusWithManager status(loop());
+
+  ConnectionPoolManagerInitializer::Ptr initializer(new ConnectionPoolManagerInitializer(
+      PROTOCOL_VERSION, bind_callback(on_pool_connected, &status)));
+
+  HostMap hosts(this->hosts());
+  Address address(hosts.begin()->first);
+
+  ConnectionPoolSettings settings;
+  settings.num_connections_per_host = 4;
+
+  initializer->with_settings(settings)->initialize(loop(), hosts);
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  ASSERT_EQ(status.count(RequestStatus::SUCCESS), NUM_NODES) << status.results();
+
+  ConnectionPoolManager::Ptr manager(status.manager());
+
+  // Selections are spread over the pool's connections
+  DenseHashSet<PooledConnection*> selected;
+  selected.set_empty_key(NULL);
+  for (int i = 0; i < 100; ++i) {
+    PooledConnection::Ptr connection(
+        manager->find_least_busy(address, CASS_CONNECTION_SELECTION_POWER_OF_TWO_CHOICES));
+    ASSERT_TRUE(connection);
+    selected.insert(connection.get());
+  }
+  EXPECT_GT(selected.size(), 1u);
+
+  run_request(manager, address);
+}
+
+/**
+ * Compare the cost of scanning for the least busy connection to a power of two
+ * choices selection. This is disabled by default and can be run using:
+ *   cassandra-unit-tests --gtest_also_run_disabled_tests
+ *     --gtest_filter='PoolUnitTest.DISABLED_FindLeastBusyBenchmark'
+ */
+TEST_F(PoolUnitTest, DISABLED_FindLeastBusyBenchmark) {
+  const int num_iterations = 1024 * 1024;
+  const size_t connection_counts[] = { 2, 8, 32 };
+
+  mockssandra::SimpleCluster cluster(simple(), 1);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  const Address address("127.0.0.1", 9042);
+
+  for (size_t i = 0; i < sizeof(connection_counts) / sizeof(connection_counts[0]); ++i) {
+    RequestStatusWithManager status(loop(), 1);
+
+    ConnectionPoolManagerInitializer::Ptr initializer(new ConnectionPoolManagerInitializer(
+        PROTOCOL_VERSION, bind_callback(on_pool_connected, &status)));
+
+    ConnectionPoolSettings settings;
+    settings.num_connections_per_host = connection_counts[i];
+
+    initializer->with_settings(settings)->initialize(loop(), hosts(1));
+    uv_run(loop(), UV_RUN_DEFAULT);
+
+    ConnectionPoolManager::Ptr manager(status.manager());
+    ASSERT_TRUE(manager);
+
+    uint64_t start = get_time_monotonic_ns();
+    for (int n = 0; n < num_iterations; ++n) {
+      manager->find_least_busy(address, CASS_CONNECTION_SELECTION_LEAST_BUSY);
+    }
+    uint64_t least_busy = get_time_monotonic_ns() - start;
+
+    start = get_time_monotonic_ns();
+    for (int n = 0; n < num_iterations; ++n) {
+      manager->find_least_busy(address, CASS_CONNECTION_SELECTION_POWER_OF_TWO_CHOICES);
+    }
+    uint64_t power_of_two_choices = get_time_monotonic_ns() - start;
+
+    printf("%u connections: least busy %.2f ns/op, power of two choices %.2f ns/op\n",
+           static_cast<unsigned>(connection_counts[i]),
+           static_cast<double>(least_busy) / num_iterations,
+           static_cast<double>(power_of_two_choices) / num_iterations);
+  }
+}
+
 /**
  * Verify that connections start up correctly with a case-sensitive keyspace.
  */
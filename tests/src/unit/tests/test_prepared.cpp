@@ -16,17 +16,20 @@
 #include "execute_request.hpp"
 #include "md5.hpp"
 #include "prepared.hpp"
+#include "query_request.hpp"
 #include "session.hpp"
 #include "set.hpp"
 #include "uuids.hpp"
 
 using namespace mockssandra;
+using datastax::internal::OStringStream;
 using datastax::internal::ScopedMutex;
 using datastax::internal::Set;
 using datastax::internal::core::Config;
 using datastax::internal::core::ExecuteRequest;
 using datastax::internal::core::Future;
 using datastax::internal::core::Prepared;
+using datastax::internal::core::QueryRequest;
 using datastax::internal::core::ResponseFuture;
 using datastax::internal::core::ResultResponse;
 using datastax::internal::core::Session;
@@ -43,16 +46,31 @@ public:
    */
   class PrepareStatements {
   public:
-    PrepareStatements() { uv_mutex_init(&mutex_); }
+    PrepareStatements()
+        : prepare_count_(0) {
+      uv_mutex_init(&mutex_);
+    }
     ~PrepareStatements() { uv_mutex_destroy(&mutex_); }
 
     String put_query(const Address& address, const String& query) {
       ScopedMutex l(&mutex_);
       String id = generate_id(query);
       statements_.insert(to_key(address, id));
+      prepare_count_++;
       return id;
     }
 
+    // Forget all the prepared statements, like a restarted node
+    void clear() {
+      ScopedMutex l(&mutex_);
+      statements_.clear();
+    }
+
+    int prepare_count() const {
+      ScopedMutex l(&mutex_);
+      return prepare_count_;
+    }
+
     bool contains_id(const Address& address, const String& id) const {
       ScopedMutex l(&mutex_);
       return statements_.count(to_key(address, id)) > 0;
@@ -78,6 +96,7 @@ public:
   private:
     mutable uv_mutex_t mutex_;
     Set<String> statements_;
+    int prepare_count_;
   };
 
   /**
@@ -163,6 +182,28 @@ public:
     const String keyspace_;
   };
 
+  /**
+   * Action that responds to EXECUTE requests with a single row with an int column.
+   */
+  class ExecuteRow : public Action {
+  public:
+    void on_run(Request* request) const {
+      String body;
+      encode_int32(RESULT_ROWS, &body);                  // Result kind
+      encode_int32(RESULT_FLAG_GLOBAL_TABLESPEC, &body); // Flags
+      encode_int32(1, &body);                            // Column count
+      encode_string("ks", &body);
+      encode_string("table", &body);
+      encode_string("value", &body);
+      body.push_back(0); // Type (int)
+      body.push_back(CASS_VALUE_TYPE_INT);
+      encode_int32(1, &body); // Row count
+      encode_int32(sizeof(int32_t), &body);
+      encode_int32(42, &body);
+      request->write(OPCODE_RESULT, body);
+    }
+  };
+
   static void connect(const Config& config, Session* session, const String& keyspace = "",
                       uint64_t wait_for_time_us = WAIT_FOR_TIME) {
     Future::Ptr connect_future(session->connect(config, keyspace));
@@ -235,6 +276,69 @@ TEST_F(PreparedUnitTest, ReprepareOnUnpreparedNode) {
   close(&session);
 }
 
+/**
+ * Verify that all the cached statements are prepared again on a node that lost them after the node
+ * responds with UNPREPARED.
+ */
+TEST_F(PreparedUnitTest, ReprepareAllOnUnpreparedNode) {
+  PrepareStatements statements;
+
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(OPCODE_PREPARE).execute(new PrepareQuery(&statements));
+  builder.on(OPCODE_EXECUTE).execute(new ExecuteQuery(&statements));
+
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+
+  Session session;
+  connect(config, &session);
+
+  const char* queries[] = { "SELECT * FROM test1", "SELECT * FROM test2", "SELECT * FROM test3" };
+  Prepared::ConstPtr prepared;
+  for (size_t i = 0; i < 3; ++i) {
+    prepared = prepare(&session, queries[i]);
+    ASSERT_TRUE(prepared);
+  }
+
+  statements.clear(); // The node loses its prepared statements
+
+  {
+    Future::Ptr future =
+        session.execute(ExecuteRequest::ConstPtr(new ExecuteRequest(prepared.get())));
+    EXPECT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out waiting to execute prepared query ";
+    EXPECT_FALSE(future->error()) << cass_error_desc(future->error()->code) << ": "
+                                  << future->error()->message;
+  }
+
+  // The other statements are prepared in the background
+  for (int i = 0; i < 50 && !(statements.contains_query(Address("127.0.0.1", 9042), queries[0]) &&
+                              statements.contains_query(Address("127.0.0.1", 9042), queries[1]));
+       ++i) {
+    test::Utils::msleep(100);
+  }
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_TRUE(statements.contains_query(Address("127.0.0.1", 9042), queries[i]));
+  }
+
+  close(&session);
+}
+
+TEST(PreparedLwtUnitTest, DetectLwtQueries) {
+  EXPECT_TRUE(Prepared::is_lwt_query("INSERT INTO t (k, v) VALUES (?, ?) IF NOT EXISTS"));
+  EXPECT_TRUE(Prepared::is_lwt_query("update t SET v = ? WHERE k = ? if v = ?"));
+  EXPECT_TRUE(Prepared::is_lwt_query("DELETE FROM t WHERE k = ? IF EXISTS"));
+  EXPECT_TRUE(Prepared::is_lwt_query("  /* comment */ BEGIN BATCH UPDATE t SET v = 1 WHERE k = 1 "
+                                     "IF v = 0; APPLY BATCH"));
+
+  EXPECT_FALSE(Prepared::is_lwt_query("SELECT * FROM t WHERE k = ?"));
+  EXPECT_FALSE(Prepared::is_lwt_query("CREATE TABLE IF NOT EXISTS t (k int PRIMARY KEY)"));
+  EXPECT_FALSE(Prepared::is_lwt_query("INSERT INTO t (k, v) VALUES (?, 'IF NOT EXISTS')"));
+  EXPECT_FALSE(Prepared::is_lwt_query("UPDATE t SET \"if\" = ?, diff = ? WHERE k = ? -- IF"));
+}
+
 /**
  * Verify that preparing a host on "UP" properly switches case-sensitive keyspaces before preparing
  * statements.
@@ -289,3 +393,146 @@ TEST_F(PreparedUnitTest, PreparedOnUpWithCaseSensitiveKeyspace) {
 
   close(&session);
 }
+
+/**
+ * Verify that more statements than fit in the window of outstanding prepare requests are all
+ * prepared on a host when it comes up.
+ */
+TEST_F(PreparedUnitTest, PreparedOnUpPipelined) {
+  PrepareStatements statements;
+
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(OPCODE_PREPARE).execute(new PrepareQuery(&statements));
+  builder.on(OPCODE_EXECUTE).execute(new ExecuteQuery(&statements));
+
+  mockssandra::SimpleCluster cluster(builder.build(), 2); // Requires at least 2 nodes
+  ASSERT_EQ(cluster.start(1), 0);
+
+  Config config;
+  config.set_prepare_on_all_hosts(true); // Add prepared statements to node2 when it comes up
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+
+  Session session;
+  connect(config, &session);
+
+  const int num_queries = 3 * CASS_DEFAULT_MAX_PREPARES_PER_FLUSH + 1;
+  for (int i = 0; i < num_queries; ++i) {
+    OStringStream ss;
+    ss << PREPARED_QUERY << " WHERE k = " << i;
+    ASSERT_TRUE(prepare(&session, ss.str()));
+  }
+
+  ASSERT_EQ(cluster.start(2), 0);
+  cluster.event(StatusChangeEvent::up(Address("127.0.0.2", 9042)));
+
+  int prepared_count = 0;
+  for (int i = 0; i < 600 && prepared_count < num_queries; ++i) {
+    prepared_count = 0;
+    for (int j = 0; j < num_queries; ++j) {
+      OStringStream ss;
+      ss << PREPARED_QUERY << " WHERE k = " << j;
+      if (statements.contains_query(Address("127.0.0.2", 9042), ss.str())) {
+        prepared_count++;
+      }
+    }
+    test::Utils::msleep(100);
+  }
+  EXPECT_EQ(num_queries, prepared_count);
+
+  close(&session);
+}
+
+/**
+ * Verify that concurrent prepares of the same query only send one PREPARE request and that every
+ * prepare gets its own future.
+ */
+TEST_F(PreparedUnitTest, CoalesceConcurrentPrepares) {
+  PrepareStatements statements;
+
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(OPCODE_PREPARE)
+      .wait(100) // Keep the prepares in-flight
+      .execute(new PrepareQuery(&statements));
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+
+  Session session;
+  connect(config, &session);
+
+  String other_query(PREPARED_QUERY " WHERE k = 1");
+  Vector<Future::Ptr> futures;
+  for (int i = 0; i < 10; ++i) {
+    futures.push_back(session.prepare(PREPARED_QUERY, strlen(PREPARED_QUERY)));
+  }
+  futures.push_back(session.prepare(other_query.c_str(), other_query.length()));
+
+  for (size_t i = 0; i < futures.size(); ++i) {
+    ASSERT_TRUE(futures[i]->wait_for(WAIT_FOR_TIME)) << "Timed out waiting to prepare query";
+    ResponseFuture::Ptr future(static_cast<ResponseFuture*>(futures[i].get()));
+    ASSERT_FALSE(future->error());
+    ASSERT_TRUE(future->prepare_request);
+    ResultResponse::Ptr result(future->response());
+    ASSERT_TRUE(result);
+    EXPECT_EQ(CASS_RESULT_KIND_PREPARED, result->kind());
+    EXPECT_EQ(i < 10 ? PREPARED_QUERY : other_query, future->prepare_request->query());
+  }
+  EXPECT_EQ(2, statements.prepare_count());
+
+  // Prepares after the first prepare completes send a new request
+  ASSERT_TRUE(prepare(&session, PREPARED_QUERY));
+  EXPECT_EQ(3, statements.prepare_count());
+
+  close(&session);
+}
+
+/**
+ * Verify that the rows of statements executed together are concatenated into a single result.
+ */
+TEST_F(PreparedUnitTest, ExecuteMany) {
+  PrepareStatements statements;
+
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(OPCODE_PREPARE).execute(new PrepareQuery(&statements));
+  builder.on(OPCODE_EXECUTE).execute(new ExecuteRow());
+  mockssandra::SimpleCluster cluster(builder.build(), 2);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+
+  Session session;
+  connect(config, &session);
+
+  Prepared::ConstPtr prepared = prepare(&session, PREPARED_QUERY);
+  ASSERT_TRUE(prepared);
+
+  typedef datastax::internal::core::Request::ConstPtr RequestPtr;
+  Vector<RequestPtr> requests;
+  for (int i = 0; i < 20; ++i) {
+    requests.push_back(RequestPtr(new ExecuteRequest(prepared.get())));
+  }
+
+  {
+    Future::Ptr future = session.execute_many(requests);
+    ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out waiting to execute statements";
+    ASSERT_FALSE(future->error()) << cass_error_desc(future->error()->code) << ": "
+                                  << future->error()->message;
+    ResultResponse::Ptr result(static_cast<ResponseFuture*>(future.get())->response());
+    ASSERT_TRUE(result);
+    EXPECT_EQ(1, result->column_count());
+    EXPECT_EQ(20, result->row_count());
+  }
+
+  { // The statements must be bound from a prepared statement
+    Vector<RequestPtr> queries(1, RequestPtr(new QueryRequest(PREPARED_QUERY)));
+    Future::Ptr future = session.execute_many(queries);
+    ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME));
+    ASSERT_TRUE(future->error());
+    EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS, future->error()->code);
+  }
+
+  close(&session);
+}
@@ -0,0 +1,175 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "prepared_cache.hpp"
+#include "serialization.hpp"
+
+#include <stdio.h>
+#include <string.h>
+
+#define PREPARED_CACHE_FILE "prepared_cache_unit_test.bin"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+class PreparedCacheUnitTest : public testing::Test {
+public:
+  virtual void TearDown() { remove(PREPARED_CACHE_FILE); }
+
+  ResultResponse::Ptr create_prepared(const String& id, const String& keyspace) {
+    data_.clear();
+    append_int32(CASS_RESULT_KIND_PREPARED);
+    append_string(id); // Prepared ID
+    // Metadata
+    append_int32(CASS_RESULT_FLAG_GLOBAL_TABLESPEC);
+    append_int32(1); // Column count
+    append_int32(1); // Primary key count
+    append_uint16(0);
+    append_string(keyspace);
+    append_string("table");
+    append_column("key", CASS_VALUE_TYPE_INT);
+    // Result metadata
+    append_int32(CASS_RESULT_FLAG_GLOBAL_TABLESPEC);
+    append_int32(1); // Column count
+    append_string(keyspace);
+    append_string("table");
+    append_column("value", CASS_VALUE_TYPE_VARCHAR);
+
+    ResultResponse::Ptr result(new ResultResponse());
+    result->set_buffer(data_.size());
+    memcpy(result->buffer()->data(), data_.data(), data_.size());
+    Decoder decoder(result->data(), data_.size(), ProtocolVersion(CASS_PROTOCOL_VERSION_V4));
+    EXPECT_TRUE(result->decode(decoder));
+    return result;
+  }
+
+  PreparedMetadata::Entry::Ptr create_entry(const String& id, const String& query,
+                                            const String& keyspace) {
+    return PreparedMetadata::Entry::Ptr(
+        new PreparedMetadata::Entry(query, keyspace, "", create_prepared(id, keyspace)));
+  }
+
+  static void write_file(const String& data) {
+    FILE* file = fopen(PREPARED_CACHE_FILE, "wb");
+    ASSERT_TRUE(file != NULL);
+    fwrite(data.data(), 1, data.size(), file);
+    fclose(file);
+  }
+
+private:
+  void append_int32(int32_t value) {
+    char buf[sizeof(int32_t)];
+    encode_int32(buf, value);
+    data_.append(buf, sizeof(buf));
+  }
+
+  void append_uint16(uint16_t value) {
+    char buf[sizeof(uint16_t)];
+    encode_uint16(buf, value);
+    data_.append(buf, sizeof(buf));
+  }
+
+  void append_string(const String& value) {
+    append_uint16(value.size());
+    data_.append(value);
+  }
+
+  void append_column(const String& name, CassValueType type) {
+    append_string(name);
+    append_uint16(type);
+  }
+
+private:
+  String data_;
+};
+
+TEST_F(PreparedCacheUnitTest, SaveAndLoad) {
+  PreparedMetadata::Entry::Vec entries;
+  entries.push_back(create_entry("0123456789abcdef", "SELECT value FROM table WHERE key = ?", "ks1"));
+  entries.push_back(create_entry("fedcba9876543210", "SELECT value FROM table WHERE key = ?", "ks2"));
+
+  ProtocolVersion version(CASS_PROTOCOL_VERSION_V4);
+  EXPECT_EQ(2, PreparedCache::save(PREPARED_CACHE_FILE, version, entries));
+
+  PreparedCache::ConstPtr cache(PreparedCache::load(PREPARED_CACHE_FILE, version));
+  ASSERT_TRUE(cache);
+  EXPECT_EQ(2u, cache->size());
+
+  ResultResponse::Ptr result(cache->find("ks2", "SELECT value FROM table WHERE key = ?"));
+  ASSERT_TRUE(result);
+  EXPECT_EQ(CASS_RESULT_KIND_PREPARED, result->kind());
+  EXPECT_EQ("fedcba9876543210", result->prepared_id().to_string());
+  ASSERT_TRUE(result->result_metadata());
+  EXPECT_EQ(1u, result->result_metadata()->column_count());
+
+  EXPECT_FALSE(cache->find("ks3", "SELECT value FROM table WHERE key = ?"));
+  EXPECT_FALSE(cache->find("ks1", "SELECT key FROM table"));
+  // Ambiguous without a keyspace
+  EXPECT_FALSE(cache->find("", "SELECT value FROM table WHERE key = ?"));
+
+  Vector<std::pair<String, PreparedMetadata::Entry::Ptr> > cached_entries;
+  cache->entries(&cached_entries);
+  ASSERT_EQ(2u, cached_entries.size());
+  EXPECT_EQ("0123456789abcdef", cached_entries[0].first);
+  EXPECT_EQ("ks1", cached_entries[0].second->keyspace());
+  EXPECT_EQ("SELECT value FROM table WHERE key = ?", cached_entries[0].second->query());
+}
+
+TEST_F(PreparedCacheUnitTest, FindQualifiedWithoutKeyspace) {
+  PreparedMetadata::Entry::Vec entries;
+  entries.push_back(create_entry("0123456789abcdef", "SELECT value FROM ks.table", "ks"));
+
+  ProtocolVersion version(CASS_PROTOCOL_VERSION_V4);
+  EXPECT_EQ(1, PreparedCache::save(PREPARED_CACHE_FILE, version, entries));
+
+  PreparedCache::ConstPtr cache(PreparedCache::load(PREPARED_CACHE_FILE, version));
+  ASSERT_TRUE(cache);
+  EXPECT_TRUE(cache->find("", "SELECT value FROM ks.table"));
+  EXPECT_FALSE(cache->find("other", "SELECT value FROM ks.table"));
+}
+
+TEST_F(PreparedCacheUnitTest, ProtocolVersionMismatch) {
+  PreparedMetadata::Entry::Vec entries;
+  entries.push_back(create_entry("0123456789abcdef", "SELECT value FROM table", "ks"));
+
+  EXPECT_EQ(1, PreparedCache::save(PREPARED_CACHE_FILE, ProtocolVersion(CASS_PROTOCOL_VERSION_V4),
+                                   entries));
+  EXPECT_FALSE(PreparedCache::load(PREPARED_CACHE_FILE, ProtocolVersion(CASS_PROTOCOL_VERSION_V3)));
+}
+
+TEST_F(PreparedCacheUnitTest, MissingOrInvalidFile) {
+  ProtocolVersion version(CASS_PROTOCOL_VERSION_V4);
+  remove(PREPARED_CACHE_FILE);
+  EXPECT_FALSE(PreparedCache::load(PREPARED_CACHE_FILE, version));
+
+  write_file("not a prepared statement cache");
+  EXPECT_FALSE(PreparedCache::load(PREPARED_CACHE_FILE, version));
+
+  // Truncate a valid file
+  PreparedMetadata::Entry::Vec entries;
+  entries.push_back(create_entry("0123456789abcdef", "SELECT value FROM table", "ks"));
+  EXPECT_EQ(1, PreparedCache::save(PREPARED_CACHE_FILE, version, entries));
+  FILE* file = fopen(PREPARED_CACHE_FILE, "rb");
+  ASSERT_TRUE(file != NULL);
+  char buf[64];
+  size_t size = fread(buf, 1, sizeof(buf), file);
+  fclose(file);
+  write_file(String(buf, size));
+  EXPECT_FALSE(PreparedCache::load(PREPARED_CACHE_FILE, version));
+}
@@ -0,0 +1,107 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "prepared.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+namespace {
+
+PreparedMetadata::Entry::Ptr create_entry(const String& query) {
+  return PreparedMetadata::Entry::Ptr(
+      new PreparedMetadata::Entry(query, "keyspace", "", ResultResponse::ConstPtr()));
+}
+
+String to_id(int i) {
+  OStringStream ss;
+  ss << "id" << i;
+  return ss.str();
+}
+
+} // namespace
+
+TEST(PreparedMetadataUnitTest, Unbounded) {
+  PreparedMetadata prepared_metadata;
+
+  for (int i = 0; i < 1000; ++i) {
+    prepared_metadata.set(to_id(i), create_entry(to_id(i)));
+  }
+  for (int i = 0; i < 1000; ++i) {
+    PreparedMetadata::Entry::Ptr entry(prepared_metadata.get(to_id(i)));
+    ASSERT_TRUE(entry);
+    EXPECT_EQ(to_id(i), entry->query());
+  }
+  EXPECT_FALSE(prepared_metadata.get("does not exist"));
+  EXPECT_EQ(1000u, prepared_metadata.copy().size());
+
+  PreparedMetadataMetrics metrics;
+  prepared_metadata.get_metrics(&metrics);
+  EXPECT_EQ(1000u, metrics.entries);
+  EXPECT_EQ(0u, metrics.max_entries);
+  EXPECT_EQ(0u, metrics.evictions);
+}
+
+TEST(PreparedMetadataUnitTest, Replace) {
+  PreparedMetadata prepared_metadata(4);
+
+  prepared_metadata.set("id", create_entry("query1"));
+  prepared_metadata.set("id", create_entry("query2"));
+  EXPECT_EQ("query2", prepared_metadata.get("id")->query());
+  EXPECT_EQ(1u, prepared_metadata.copy().size());
+}
+
+TEST(PreparedMetadataUnitTest, Bounded) {
+  PreparedMetadata prepared_metadata(100);
+
+  for (int i = 0; i < 1000; ++i) {
+    prepared_metadata.set(to_id(i), create_entry(to_id(i)));
+  }
+
+  PreparedMetadataMetrics metrics;
+  prepared_metadata.get_metrics(&metrics);
+  EXPECT_EQ(100u, metrics.entries);
+  EXPECT_EQ(100u, metrics.max_entries);
+  EXPECT_EQ(900u, metrics.evictions);
+  EXPECT_EQ(100u, prepared_metadata.copy().size());
+}
+
+TEST(PreparedMetadataUnitTest, EvictLeastRecentlyUsed) {
+  // Fewer entries than shards use a single shard
+  PreparedMetadata prepared_metadata(3);
+
+  prepared_metadata.set("a", create_entry("a"));
+  prepared_metadata.set("b", create_entry("b"));
+  prepared_metadata.set("c", create_entry("c"));
+
+  // Use "a" and "c" so that "b" is evicted first
+  EXPECT_TRUE(prepared_metadata.get("a"));
+  EXPECT_TRUE(prepared_metadata.get("c"));
+
+  prepared_metadata.set("d", create_entry("d"));
+  EXPECT_TRUE(prepared_metadata.get("a"));
+  EXPECT_FALSE(prepared_metadata.get("b"));
+  EXPECT_TRUE(prepared_metadata.get("c"));
+  EXPECT_TRUE(prepared_metadata.get("d"));
+
+  PreparedMetadataMetrics metrics;
+  prepared_metadata.get_metrics(&metrics);
+  EXPECT_EQ(3u, metrics.entries);
+  EXPECT_EQ(1u, metrics.evictions);
+}
@@ -183,3 +183,23 @@ TEST_F(ProtocolVersionUnitTest, SupportsResultMetadataId) {
     }
   }
 }
+
+TEST_F(ProtocolVersionUnitTest, SupportsSegments) {
+  { // Supported
+    ProtocolVersion v5(CASS_PROTOCOL_VERSION_V5);
+    EXPECT_TRUE(v5.supports_segments());
+  }
+
+  { // Not supported
+    ProtocolVersion DSEv1(CASS_PROTOCOL_VERSION_DSEV1);
+    EXPECT_FALSE(DSEv1.supports_segments());
+
+    ProtocolVersion DSEv2(CASS_PROTOCOL_VERSION_DSEV2);
+    EXPECT_FALSE(DSEv2.supports_segments());
+
+    for (int i = CASS_PROTOCOL_VERSION_V1; i <= CASS_PROTOCOL_VERSION_V4; ++i) {
+      ProtocolVersion version(i);
+      EXPECT_FALSE(version.supports_segments());
+    }
+  }
+}
@@ -259,6 +259,21 @@ TEST(RandomUnitTest, RandomShuffle) {
   ASSERT_NE(count, max_iterations);
 }
 
+TEST(RandomUnitTest, SingleThreadedSeeded) {
+  // Generators used by a single event loop produce the same values for the
+  // same seed and values below the maximum
+  Random shared;
+  uint64_t seed = shared.next(CASS_UINT64_MAX);
+  Random r1(seed);
+  Random r2(seed);
+  for (int i = 0; i < 100; ++i) {
+    uint64_t value = r1.next(10);
+    EXPECT_LT(value, 10u);
+    EXPECT_EQ(value, r2.next(10));
+  }
+  EXPECT_EQ(0u, r1.next(0));
+}
+
 TEST(RandomUnitTest, RandomSeed) {
   const int max_iterations = 10;
   uint64_t previous = 0;
@@ -0,0 +1,52 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "rate_limiter.hpp"
+
+using namespace datastax::internal::core;
+
+#define INTERVAL_NS (10LL * 1000LL * 1000LL) // 100 requests per second
+
+TEST(RateLimiterUnitTest, Burst) {
+  RateLimiter rate_limiter(100.0, 3);
+  uint64_t now = 1000LL * INTERVAL_NS;
+
+  // The burst starts immediately
+  EXPECT_LE(rate_limiter.acquire(now), now);
+  EXPECT_LE(rate_limiter.acquire(now), now);
+  EXPECT_LE(rate_limiter.acquire(now), now);
+
+  // The following requests are spread out at the rate
+  EXPECT_EQ(now + INTERVAL_NS, rate_limiter.acquire(now));
+  EXPECT_EQ(now + 2 * INTERVAL_NS, rate_limiter.acquire(now));
+}
+
+TEST(RateLimiterUnitTest, Idle) {
+  RateLimiter rate_limiter(100.0, 2);
+  uint64_t now = 1000LL * INTERVAL_NS;
+
+  EXPECT_LE(rate_limiter.acquire(now), now);
+  EXPECT_LE(rate_limiter.acquire(now), now);
+  EXPECT_EQ(now + INTERVAL_NS, rate_limiter.acquire(now));
+
+  // Being idle only saves up a burst of requests
+  now += 100 * INTERVAL_NS;
+  EXPECT_LE(rate_limiter.acquire(now), now);
+  EXPECT_LE(rate_limiter.acquire(now), now);
+  EXPECT_EQ(now + INTERVAL_NS, rate_limiter.acquire(now));
+}
@@ -0,0 +1,81 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "reconnect_throttle.hpp"
+
+using namespace datastax::internal::core;
+
+#define WARMUP_DURATION_NS (1000LL * 1000LL * 1000LL) // 1 second
+
+TEST(ReconnectThrottleUnitTest, LimitConnectAttempts) {
+  ReconnectThrottle throttle(2, 0);
+  Host::Ptr host(new Host(Address("127.0.0.1", 9042)));
+  Host::Ptr other_host(new Host(Address("127.0.0.2", 9042)));
+
+  EXPECT_TRUE(throttle.try_start_connect_attempt(host.get()));
+  EXPECT_TRUE(throttle.try_start_connect_attempt(host.get()));
+  EXPECT_FALSE(throttle.try_start_connect_attempt(host.get()));
+
+  // The limit is per host
+  EXPECT_TRUE(throttle.try_start_connect_attempt(other_host.get()));
+
+  throttle.finish_connect_attempt(host.get());
+  EXPECT_TRUE(throttle.try_start_connect_attempt(host.get()));
+  EXPECT_FALSE(throttle.try_start_connect_attempt(host.get()));
+}
+
+TEST(ReconnectThrottleUnitTest, NoConnectAttemptLimit) {
+  ReconnectThrottle throttle(0, 1000);
+  Host::Ptr host(new Host(Address("127.0.0.1", 9042)));
+
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(throttle.try_start_connect_attempt(host.get()));
+  }
+}
+
+TEST(ReconnectThrottleUnitTest, Warmup) {
+  ReconnectThrottle throttle(0, 1000);
+  Host::Ptr host(new Host(Address("127.0.0.1", 9042)));
+  uint64_t now = 1000;
+
+  EXPECT_TRUE(throttle.try_admit(host.get(), now)); // Not warming up
+
+  throttle.start_warmup(host.get(), now);
+  EXPECT_FALSE(throttle.try_admit(host.get(), now));
+
+  // A quarter of the way through the warm-up a quarter of the requests are
+  // admitted
+  int admitted = 0;
+  for (int i = 0; i < 1000; ++i) {
+    if (throttle.try_admit(host.get(), now + WARMUP_DURATION_NS / 4)) admitted++;
+  }
+  EXPECT_EQ(250, admitted);
+
+  // Another pool coming up doesn't restart the warm-up
+  throttle.start_warmup(host.get(), now + WARMUP_DURATION_NS / 2);
+  admitted = 0;
+  for (int i = 0; i < 1000; ++i) {
+    if (throttle.try_admit(host.get(), now + 3 * WARMUP_DURATION_NS / 4)) admitted++;
+  }
+  EXPECT_EQ(750, admitted);
+
+  // All the requests are admitted once the warm-up is over
+  EXPECT_TRUE(throttle.try_admit(host.get(), now + WARMUP_DURATION_NS));
+  EXPECT_EQ(0u, host->warmup_start_ns().load());
+  EXPECT_TRUE(throttle.try_admit(host.get(), now));
+}
@@ -20,9 +20,13 @@
 #include "reconnection_policy.hpp"
 #include "scoped_ptr.hpp"
 
+#include <algorithm>
+#include <limits>
+
 using datastax::internal::ScopedPtr;
 using datastax::internal::core::ConstantReconnectionPolicy;
 using datastax::internal::core::ConstantReconnectionSchedule;
+using datastax::internal::core::DecorrelatedJitterReconnectionPolicy;
 using datastax::internal::core::ExponentialReconnectionPolicy;
 using datastax::internal::core::ExponentialReconnectionSchedule;
 using datastax::internal::core::ReconnectionPolicy;
@@ -122,3 +126,38 @@ TEST(ReconnectionPolicyUnitTest, ExponentialScheduleIndependent) {
   EXPECT_NEAR(2.0, static_cast<double>(schedule_2->next_delay_ms()), FIFTEEN_PERCENT(2));
   EXPECT_NEAR(4.0, static_cast<double>(schedule_2->next_delay_ms()), FIFTEEN_PERCENT(4));
 }
+
+TEST(ReconnectionPolicyUnitTest, DecorrelatedJitter) {
+  DecorrelatedJitterReconnectionPolicy policy(100u, 10000u);
+  EXPECT_EQ(ReconnectionPolicy::DECORRELATED_JITTER, policy.type());
+  EXPECT_EQ(100u, policy.base_delay_ms());
+  EXPECT_EQ(10000u, policy.max_delay_ms());
+  EXPECT_STREQ("decorrelated jitter", policy.name());
+}
+
+TEST(ReconnectionPolicyUnitTest, DecorrelatedJitterSchedule) {
+  DecorrelatedJitterReconnectionPolicy policy(100u, 10000u);
+  ScopedPtr<ReconnectionSchedule> schedule(policy.new_reconnection_schedule());
+
+  uint64_t previous_delay_ms = 100u;
+  bool is_max_reached = false;
+  for (int i = 0; i < 1000; ++i) {
+    uint64_t delay_ms = schedule->next_delay_ms();
+    EXPECT_GE(delay_ms, 100u);
+    EXPECT_LE(delay_ms, std::min(previous_delay_ms * 3, static_cast<uint64_t>(10000u)));
+    is_max_reached = is_max_reached || delay_ms > 5000u;
+    previous_delay_ms = delay_ms;
+  }
+  EXPECT_TRUE(is_max_reached);
+}
+
+TEST(ReconnectionPolicyUnitTest, DecorrelatedJitterScheduleOverflow) {
+  uint64_t max_delay_ms = std::numeric_limits<uint64_t>::max();
+  DecorrelatedJitterReconnectionPolicy policy(2u, max_delay_ms);
+  ScopedPtr<ReconnectionSchedule> schedule(policy.new_reconnection_schedule());
+  for (int i = 0; i < 1000; ++i) {
+    uint64_t delay_ms = schedule->next_delay_ms();
+    EXPECT_GE(delay_ms, 2u);
+    EXPECT_LE(delay_ms, max_delay_ms);
+  }
+}
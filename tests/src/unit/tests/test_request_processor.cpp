@@ -82,11 +82,11 @@ private:
         : index_(0)
         , hosts_(hosts) {}
 
-    virtual Host::Ptr compute_next() {
+    virtual const Host::Ptr& compute_next() {
       if (index_ < hosts_->size()) {
         return (*hosts_)[index_++];
       }
-      return Host::Ptr();
+      return NO_HOST;
     }
 
   private:
@@ -98,6 +98,15 @@ private:
   CopyOnWriteHostVec hosts_;
 };
 
+// Keeps the hosts that are down in its query plans like a policy that hasn't
+// been notified yet
+class IgnoreDownLoadBalancingPolicy : public InorderLoadBalancingPolicy {
+public:
+  virtual void on_host_down(const Address& address) {}
+
+  virtual LoadBalancingPolicy* new_instance() { return new IgnoreDownLoadBalancingPolicy(); }
+};
+
 class RequestProcessorUnitTest : public EventLoopTest {
 public:
   RequestProcessorUnitTest()
@@ -115,6 +124,10 @@ public:
     return hosts;
   }
 
+  HostTable::ConstPtr host_table(const HostMap& hosts) {
+    return HostTable::ConstPtr(new HostTable(hosts, 0));
+  }
+
   void try_request(const RequestProcessor::Ptr& processor,
                    uint64_t wait_for_time_us = WAIT_FOR_TIME) {
     ResponseFuture::Ptr response_future(new ResponseFuture());
@@ -146,9 +159,10 @@ public:
     const RequestProcessor::Ptr& processor() const { return processor_; }
 
     void set_processor(const RequestProcessor::Ptr& processor) {
-      ScopedMutex lock(&mutex_);
-      processor_ = processor;
-      internal_set(lock);
+      if (internal_claim()) {
+        processor_ = processor;
+        internal_set();
+      }
     }
 
   private:
@@ -277,7 +291,7 @@ TEST_F(RequestProcessorUnitTest, Simple) {
 
   Future::Ptr connect_future(new Future());
   RequestProcessorInitializer::Ptr initializer(new RequestProcessorInitializer(
-      hosts.begin()->second, PROTOCOL_VERSION, hosts, TokenMap::Ptr(), "", "",
+      hosts.begin()->second, PROTOCOL_VERSION, host_table(hosts), TokenMap::Ptr(), "", "",
       bind_callback(on_connected, connect_future.get())));
 
   initializer->initialize(event_loop());
@@ -296,7 +310,7 @@ TEST_F(RequestProcessorUnitTest, CloseWithRequestsPending) {
 
   Future::Ptr connect_future(new Future());
   RequestProcessorInitializer::Ptr initializer(new RequestProcessorInitializer(
-      hosts.begin()->second, PROTOCOL_VERSION, hosts, TokenMap::Ptr(), "", "",
+      hosts.begin()->second, PROTOCOL_VERSION, host_table(hosts), TokenMap::Ptr(), "", "",
       bind_callback(on_connected, connect_future.get())));
 
   initializer->initialize(event_loop());
@@ -334,7 +348,7 @@ TEST_F(RequestProcessorUnitTest, Auth) {
 
   Future::Ptr connect_future(new Future());
   RequestProcessorInitializer::Ptr initializer(new RequestProcessorInitializer(
-      hosts.begin()->second, PROTOCOL_VERSION, hosts, TokenMap::Ptr(), "", "",
+      hosts.begin()->second, PROTOCOL_VERSION, host_table(hosts), TokenMap::Ptr(), "", "",
       bind_callback(on_connected, connect_future.get())));
 
   RequestProcessorSettings settings;
@@ -359,7 +373,7 @@ TEST_F(RequestProcessorUnitTest, Ssl) {
 
   Future::Ptr connect_future(new Future());
   RequestProcessorInitializer::Ptr initializer(new RequestProcessorInitializer(
-      hosts.begin()->second, PROTOCOL_VERSION, hosts, TokenMap::Ptr(), "", "",
+      hosts.begin()->second, PROTOCOL_VERSION, host_table(hosts), TokenMap::Ptr(), "", "",
       bind_callback(on_connected, connect_future.get())));
 
   initializer->with_settings(settings)->initialize(event_loop());
@@ -383,7 +397,7 @@ TEST_F(RequestProcessorUnitTest, NotifyAddRemoveHost) {
   Future::Ptr up_future(new Future());
   Future::Ptr down_future(new Future());
   RequestProcessorInitializer::Ptr initializer(new RequestProcessorInitializer(
-      hosts.begin()->second, PROTOCOL_VERSION, hosts, TokenMap::Ptr(), "", "",
+      hosts.begin()->second, PROTOCOL_VERSION, host_table(hosts), TokenMap::Ptr(), "", "",
       bind_callback(on_connected, connect_future.get())));
 
   RequestProcessorSettings settings;
@@ -415,7 +429,7 @@ TEST_F(RequestProcessorUnitTest, CloseDuringReconnect) {
   Future::Ptr close_future(new Future());
   Future::Ptr connect_future(new Future());
   RequestProcessorInitializer::Ptr initializer(new RequestProcessorInitializer(
-      hosts.begin()->second, PROTOCOL_VERSION, hosts, TokenMap::Ptr(), "", "",
+      hosts.begin()->second, PROTOCOL_VERSION, host_table(hosts), TokenMap::Ptr(), "", "",
       bind_callback(on_connected, connect_future.get())));
 
   RequestProcessorSettings settings;
@@ -450,7 +464,7 @@ TEST_F(RequestProcessorUnitTest, CloseDuringAddNewHost) {
   Future::Ptr close_future(new Future());
   Future::Ptr connect_future(new Future());
   RequestProcessorInitializer::Ptr initializer(new RequestProcessorInitializer(
-      hosts.begin()->second, PROTOCOL_VERSION, hosts, TokenMap::Ptr(), "", "",
+      hosts.begin()->second, PROTOCOL_VERSION, host_table(hosts), TokenMap::Ptr(), "", "",
       bind_callback(on_connected, connect_future.get())));
 
   CloseListener::Ptr listener(new CloseListener(close_future));
@@ -480,7 +494,7 @@ TEST_F(RequestProcessorUnitTest, PoolDown) {
   Future::Ptr up_future(new Future());
   Future::Ptr down_future(new Future());
   RequestProcessorInitializer::Ptr initializer(new RequestProcessorInitializer(
-      hosts.begin()->second, PROTOCOL_VERSION, hosts, TokenMap::Ptr(), "", "",
+      hosts.begin()->second, PROTOCOL_VERSION, host_table(hosts), TokenMap::Ptr(), "", "",
       bind_callback(on_connected, connect_future.get())));
 
   UpDownListener::Ptr listener(new UpDownListener(up_future, down_future, target_host));
@@ -496,6 +510,56 @@ TEST_F(RequestProcessorUnitTest, PoolDown) {
   ASSERT_TRUE(down_future->wait_for(WAIT_FOR_TIME));
 }
 
+TEST_F(RequestProcessorUnitTest, SkipHostWithoutConnections) {
+  mockssandra::SimpleCluster cluster(simple(), NUM_NODES);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  HostMap hosts(generate_hosts());
+  Host::Ptr target_host(hosts.find(Address("127.0.0.1", PORT))->second);
+  ASSERT_TRUE(target_host);
+
+  ExecutionProfile profile;
+  profile.set_load_balancing_policy(new IgnoreDownLoadBalancingPolicy());
+  profile.set_speculative_execution_policy(new NoSpeculativeExecutionPolicy());
+  profile.set_retry_policy(new DefaultRetryPolicy());
+
+  RequestProcessorSettings settings;
+  settings.default_profile = profile;
+
+  Future::Ptr connect_future(new Future());
+  Future::Ptr up_future(new Future());
+  Future::Ptr down_future(new Future());
+  RequestProcessorInitializer::Ptr initializer(new RequestProcessorInitializer(
+      hosts.begin()->second, PROTOCOL_VERSION, host_table(hosts), TokenMap::Ptr(), "", "",
+      bind_callback(on_connected, connect_future.get())));
+
+  UpDownListener::Ptr listener(new UpDownListener(up_future, down_future, target_host));
+
+  initializer->with_settings(settings)->with_listener(listener.get())->initialize(event_loop());
+
+  ASSERT_TRUE(connect_future->wait_for(WAIT_FOR_TIME));
+  EXPECT_FALSE(connect_future->error());
+  RequestProcessor::Ptr processor(connect_future->processor());
+
+  cluster.stop(1);
+  ASSERT_TRUE(down_future->wait_for(WAIT_FOR_TIME));
+
+  // The first host of the query plan has no connections so the request is
+  // written to the next host
+  ResponseFuture::Ptr response_future(new ResponseFuture());
+  Statement::Ptr request(new QueryRequest("SELECT * FROM table"));
+  request->set_record_attempted_addresses(true);
+  processor->process_request(RequestHandler::Ptr(new RequestHandler(request, response_future)));
+
+  ASSERT_TRUE(response_future->wait_for(WAIT_FOR_TIME));
+  EXPECT_FALSE(response_future->error());
+  AddressVec attempted = response_future->attempted_addresses();
+  ASSERT_EQ(attempted.size(), 1u);
+  EXPECT_EQ(attempted[0], Address("127.0.0.2", PORT));
+
+  processor->close();
+}
+
 TEST_F(RequestProcessorUnitTest, PoolUp) {
   // Only start specific nodes
   mockssandra::SimpleCluster cluster(simple(), NUM_NODES);
@@ -510,7 +574,7 @@ TEST_F(RequestProcessorUnitTest, PoolUp) {
   Future::Ptr up_future(new Future());
   Future::Ptr down_future(new Future());
   RequestProcessorInitializer::Ptr initializer(new RequestProcessorInitializer(
-      hosts.begin()->second, PROTOCOL_VERSION, hosts, TokenMap::Ptr(), "", "",
+      hosts.begin()->second, PROTOCOL_VERSION, host_table(hosts), TokenMap::Ptr(), "", "",
       bind_callback(on_connected, connect_future.get())));
 
   RequestProcessorSettings settings;
@@ -538,7 +602,7 @@ TEST_F(RequestProcessorUnitTest, InvalidAuth) {
 
   Future::Ptr connect_future(new Future());
   RequestProcessorInitializer::Ptr initializer(new RequestProcessorInitializer(
-      hosts.begin()->second, PROTOCOL_VERSION, hosts, TokenMap::Ptr(), "", "",
+      hosts.begin()->second, PROTOCOL_VERSION, host_table(hosts), TokenMap::Ptr(), "", "",
       bind_callback(on_connected, connect_future.get())));
 
   RequestProcessorSettings settings;
@@ -564,7 +628,7 @@ TEST_F(RequestProcessorUnitTest, InvalidSsl) {
 
   Future::Ptr connect_future(new Future());
   RequestProcessorInitializer::Ptr initializer(new RequestProcessorInitializer(
-      hosts.begin()->second, PROTOCOL_VERSION, hosts, TokenMap::Ptr(), "", "",
+      hosts.begin()->second, PROTOCOL_VERSION, host_table(hosts), TokenMap::Ptr(), "", "",
       bind_callback(on_connected, connect_future.get())));
 
   SslContext::Ptr ssl_context(SslContextFactory::create()); // No trusted cert
@@ -600,7 +664,7 @@ TEST_F(RequestProcessorUnitTest, RollingRestart) {
   HostMap hosts(generate_hosts());
   Future::Ptr connect_future(new Future());
   RequestProcessorInitializer::Ptr initializer(new RequestProcessorInitializer(
-      hosts.begin()->second, PROTOCOL_VERSION, hosts, TokenMap::Ptr(), "", "",
+      hosts.begin()->second, PROTOCOL_VERSION, host_table(hosts), TokenMap::Ptr(), "", "",
       bind_callback(on_connected, connect_future.get())));
 
   RequestProcessorSettings settings;
@@ -632,7 +696,7 @@ TEST_F(RequestProcessorUnitTest, NoHostsAvailable) {
   HostMap hosts(generate_hosts());
   Future::Ptr connect_future(new Future());
   RequestProcessorInitializer::Ptr initializer(new RequestProcessorInitializer(
-      hosts.begin()->second, PROTOCOL_VERSION, hosts, TokenMap::Ptr(), "", "",
+      hosts.begin()->second, PROTOCOL_VERSION, host_table(hosts), TokenMap::Ptr(), "", "",
       bind_callback(on_connected, connect_future.get())));
 
   initializer->with_listener(listener.get())->initialize(event_loop());
@@ -668,7 +732,7 @@ TEST_F(RequestProcessorUnitTest, RequestTimeout) {
   HostMap hosts(generate_hosts());
   Future::Ptr connect_future(new Future());
   RequestProcessorInitializer::Ptr initializer(new RequestProcessorInitializer(
-      hosts.begin()->second, PROTOCOL_VERSION, hosts, TokenMap::Ptr(), "", "",
+      hosts.begin()->second, PROTOCOL_VERSION, host_table(hosts), TokenMap::Ptr(), "", "",
       bind_callback(on_connected, connect_future.get())));
 
   initializer->with_listener(listener.get())->initialize(event_loop());
@@ -718,7 +782,7 @@ TEST_F(RequestProcessorUnitTest, LowNumberOfStreams) {
   settings.request_queue_size = 2 * CASS_MAX_STREAMS + 1; // Create a request queue with enough room
 
   RequestProcessorInitializer::Ptr initializer(new RequestProcessorInitializer(
-      hosts.begin()->second, PROTOCOL_VERSION, hosts, TokenMap::Ptr(), "", "",
+      hosts.begin()->second, PROTOCOL_VERSION, host_table(hosts), TokenMap::Ptr(), "", "",
       bind_callback(on_connected, connect_future.get())));
   initializer->with_settings(settings)->with_listener(listener.get())->initialize(event_loop());
 
@@ -761,3 +825,154 @@ TEST_F(RequestProcessorUnitTest, LowNumberOfStreams) {
   processor->close();
   ASSERT_TRUE(close_future->wait_for(WAIT_FOR_TIME));
 }
+
+TEST_F(RequestProcessorUnitTest, ReservedStreams) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Future::Ptr close_future(new Future());
+  CloseListener::Ptr listener(new CloseListener(close_future));
+
+  HostMap hosts(generate_hosts(1));
+  Future::Ptr connect_future(new Future());
+
+  RequestProcessorSettings settings;
+  settings.reserved_streams = CASS_MAX_STREAMS; // Reserve all of the streams
+
+  RequestProcessorInitializer::Ptr initializer(new RequestProcessorInitializer(
+      hosts.begin()->second, PROTOCOL_VERSION, host_table(hosts), TokenMap::Ptr(), "", "",
+      bind_callback(on_connected, connect_future.get())));
+  initializer->with_settings(settings)->with_listener(listener.get())->initialize(event_loop());
+
+  ASSERT_TRUE(connect_future->wait_for(WAIT_FOR_TIME));
+  EXPECT_FALSE(connect_future->error());
+  RequestProcessor::Ptr processor(connect_future->processor());
+
+  { // Low priority requests can't use the reserved streams
+    ResponseFuture::Ptr response_future(new ResponseFuture());
+    RequestHandler::Ptr request_handler(new RequestHandler(
+        Statement::Ptr(new QueryRequest("SELECT * FROM table")), response_future));
+    request_handler->set_is_low_priority(true);
+    processor->process_request(request_handler);
+    ASSERT_TRUE(response_future->wait_for(WAIT_FOR_TIME));
+    ASSERT_TRUE(response_future->error());
+    EXPECT_EQ(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, response_future->error()->code);
+  }
+
+  try_request(processor);
+
+  processor->close();
+  ASSERT_TRUE(close_future->wait_for(WAIT_FOR_TIME));
+}
+
+TEST_F(RequestProcessorUnitTest, CancelLosingSpeculativeExecution) {
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(mockssandra::OPCODE_QUERY)
+      .system_local()
+      .system_peers()
+      .is_address("127.0.0.1")
+      .then(mockssandra::Action::Builder().wait(200).empty_rows_result(1))
+      .empty_rows_result(1);
+  mockssandra::SimpleCluster cluster(builder.build(), 2); // Two node cluster
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Future::Ptr close_future(new Future());
+  CloseListener::Ptr listener(new CloseListener(close_future));
+
+  HostMap hosts(generate_hosts(2));
+  Future::Ptr connect_future(new Future());
+
+  ExecutionProfile profile;
+  profile.set_load_balancing_policy(new InorderLoadBalancingPolicy());
+  profile.set_speculative_execution_policy(new ConstantSpeculativeExecutionPolicy(10, 1));
+  profile.set_retry_policy(new DefaultRetryPolicy());
+
+  RequestProcessorSettings settings;
+  settings.default_profile = profile;
+
+  RequestProcessorInitializer::Ptr initializer(new RequestProcessorInitializer(
+      hosts.begin()->second, PROTOCOL_VERSION, host_table(hosts), TokenMap::Ptr(), "", "",
+      bind_callback(on_connected, connect_future.get())));
+  initializer->with_settings(settings)->with_listener(listener.get())->initialize(event_loop());
+
+  ASSERT_TRUE(connect_future->wait_for(WAIT_FOR_TIME));
+  EXPECT_FALSE(connect_future->error());
+  RequestProcessor::Ptr processor(connect_future->processor());
+
+  ResponseFuture::Ptr response_future(new ResponseFuture());
+  QueryRequest::Ptr request(new QueryRequest("SELECT * FROM table"));
+  request->set_is_idempotent(true);
+  request->set_record_attempted_addresses(true);
+  processor->process_request(RequestHandler::Ptr(new RequestHandler(request, response_future)));
+
+  // The speculative execution on the second host wins
+  ASSERT_TRUE(response_future->wait_for(WAIT_FOR_TIME));
+  EXPECT_FALSE(response_future->error());
+  EXPECT_EQ(Address("127.0.0.2", PORT), response_future->address());
+  EXPECT_EQ(2u, response_future->attempted_addresses().size());
+
+  // The slow host's late response is dropped and it's no longer counted as
+  // in-flight once it arrives
+  const Host::Ptr& slow_host(hosts[Address("127.0.0.1", PORT)]);
+  for (int i = 0; i < 100 && slow_host->inflight_request_count() > 0; ++i) {
+    test::Utils::msleep(10);
+  }
+  EXPECT_EQ(0, slow_host->inflight_request_count());
+  EXPECT_EQ(0, hosts[Address("127.0.0.2", PORT)]->inflight_request_count());
+
+  processor->close();
+  ASSERT_TRUE(close_future->wait_for(WAIT_FOR_TIME));
+}
+
+TEST(CoalesceDelayUnitTest, Fixed) {
+  RequestProcessorSettings settings;
+  CoalesceDelay delay(settings);
+  EXPECT_EQ(settings.coalesce_delay_us, delay.delay_us());
+
+  delay.update(0, 0, true);
+  EXPECT_EQ(settings.coalesce_delay_us, delay.delay_us());
+  delay.update(0, 0, false);
+  EXPECT_EQ(settings.coalesce_delay_us, delay.delay_us());
+}
+
+TEST(CoalesceDelayUnitTest, AdaptiveLowLoad) {
+  RequestProcessorSettings settings;
+  settings.coalesce_mode = CASS_COALESCE_MODE_ADAPTIVE;
+  CoalesceDelay delay(settings);
+
+  // The delay shrinks to the minimum when there's nothing to coalesce
+  for (int i = 0; i < 10; ++i) {
+    delay.update(0, 1, false);
+  }
+  EXPECT_EQ(10u, delay.delay_us());
+}
+
+TEST(CoalesceDelayUnitTest, AdaptiveBacklog) {
+  RequestProcessorSettings settings;
+  settings.coalesce_mode = CASS_COALESCE_MODE_ADAPTIVE;
+  settings.coalesce_latency_budget_us = 1000;
+  CoalesceDelay delay(settings);
+
+  // The delay grows when requests are backing up, but stays within half the
+  // latency budget
+  delay.update(0, 64, true);
+  EXPECT_EQ(2 * settings.coalesce_delay_us, delay.delay_us());
+  for (int i = 0; i < 10; ++i) {
+    delay.update(0, 64, true);
+  }
+  EXPECT_EQ(500u, delay.delay_us());
+}
+
+TEST(CoalesceDelayUnitTest, AdaptiveIoTime) {
+  RequestProcessorSettings settings;
+  settings.coalesce_mode = CASS_COALESCE_MODE_ADAPTIVE;
+  CoalesceDelay delay(settings);
+
+  // Mostly busy with I/O
+  delay.update(150 * 1000, 10, false);
+  EXPECT_EQ(250u, delay.delay_us());
+
+  // Mostly idle
+  delay.update(0, 10, false);
+  EXPECT_LT(delay.delay_us(), 250u);
+}
@@ -0,0 +1,145 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "mpmc_queue.hpp"
+#include "request_queue.hpp"
+
+#include <algorithm>
+
+using namespace datastax::internal::core;
+
+namespace {
+
+RequestHandler* handler(intptr_t i) { return reinterpret_cast<RequestHandler*>(i); }
+
+void enqueue_from_thread(void* arg) {
+  RequestQueue* queue = static_cast<RequestQueue*>(arg);
+  for (intptr_t i = 11; i <= 14; ++i) {
+    EXPECT_TRUE(queue->enqueue(handler(i)));
+  }
+  EXPECT_FALSE(queue->enqueue(handler(15))); // The shared queue is full
+}
+
+} // namespace
+
+TEST(RequestQueueUnitTest, BatchEnqueueDequeue) {
+  MPMCQueue<int> queue(8);
+  int items[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+
+  EXPECT_EQ(5u, queue.enqueue(items, 5));
+  EXPECT_EQ(3u, queue.enqueue(items + 5, 5)); // Only three slots are left
+  EXPECT_EQ(0u, queue.enqueue(items + 8, 2));
+
+  int dequeued[10];
+  EXPECT_EQ(4u, queue.dequeue(dequeued, 4));
+  EXPECT_EQ(4u, queue.dequeue(dequeued + 4, 10));
+  EXPECT_EQ(0u, queue.dequeue(dequeued, 10));
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_EQ(items[i], dequeued[i]);
+  }
+
+  // Batches wrap around the end of the buffer
+  EXPECT_EQ(6u, queue.enqueue(items, 6));
+  EXPECT_EQ(6u, queue.dequeue(dequeued, 10));
+  EXPECT_TRUE(queue.is_empty());
+}
+
+TEST(RequestQueueUnitTest, Overflow) {
+  RequestQueue queue(4, true);
+  for (intptr_t i = 1; i <= 10; ++i) {
+    EXPECT_TRUE(queue.enqueue(handler(i)));
+  }
+  EXPECT_EQ(10u, queue.size());
+
+  // The overflow is dequeued in order after the bounded queue
+  RequestHandler* dequeued[10];
+  size_t count = 0;
+  while (!queue.is_empty()) {
+    count += queue.dequeue(dequeued + count, 3);
+  }
+  ASSERT_EQ(10u, count);
+  for (intptr_t i = 0; i < 10; ++i) {
+    EXPECT_EQ(handler(i + 1), dequeued[i]);
+  }
+}
+
+TEST(RequestQueueUnitTest, Full) {
+  RequestQueue queue(4, false);
+  for (intptr_t i = 1; i <= 4; ++i) {
+    EXPECT_TRUE(queue.enqueue(handler(i)));
+  }
+  EXPECT_FALSE(queue.enqueue(handler(5)));
+  EXPECT_EQ(4u, queue.size());
+}
+
+TEST(RequestQueueUnitTest, GroupEnqueue) {
+  RequestHandler* handlers[10];
+  for (intptr_t i = 0; i < 10; ++i) {
+    handlers[i] = handler(i + 1);
+  }
+
+  { // The requests that don't fit are rejected
+    RequestQueue queue(4, false);
+    EXPECT_EQ(3u, queue.enqueue(handlers, 3));
+    EXPECT_EQ(1u, queue.enqueue(handlers + 3, 3));
+    EXPECT_EQ(4u, queue.size());
+  }
+
+  { // The requests that don't fit overflow and are dequeued in order
+    RequestQueue queue(4, true);
+    EXPECT_EQ(6u, queue.enqueue(handlers, 6));
+    EXPECT_EQ(4u, queue.enqueue(handlers + 6, 4));
+    EXPECT_EQ(10u, queue.size());
+
+    RequestHandler* dequeued[10];
+    size_t count = 0;
+    while (!queue.is_empty()) {
+      count += queue.dequeue(dequeued + count, 3);
+    }
+    ASSERT_EQ(10u, count);
+    for (intptr_t i = 0; i < 10; ++i) {
+      EXPECT_EQ(handlers[i], dequeued[i]);
+    }
+  }
+}
+
+TEST(RequestQueueUnitTest, Lanes) {
+  RequestQueue queue(4, false, 1);
+
+  // The first thread is given a lane so it's not limited by the shared queue
+  for (intptr_t i = 1; i <= 10; ++i) {
+    EXPECT_TRUE(queue.enqueue(handler(i)));
+  }
+
+  // There are no lanes left for other threads
+  uv_thread_t thread;
+  ASSERT_EQ(0, uv_thread_create(&thread, enqueue_from_thread, &queue));
+  uv_thread_join(&thread);
+  EXPECT_EQ(14u, queue.size());
+
+  RequestHandler* dequeued[14];
+  size_t count = 0;
+  while (!queue.is_empty()) {
+    count += queue.dequeue(dequeued + count, 5);
+  }
+  ASSERT_EQ(14u, count);
+  std::sort(dequeued, dequeued + count);
+  for (intptr_t i = 0; i < 14; ++i) {
+    EXPECT_EQ(handler(i + 1), dequeued[i]);
+  }
+}
@@ -30,9 +30,10 @@ public:
   ResolverUnitTest()
       : status_(Resolver::NEW) {}
 
-  Resolver::Ptr create(const String& hostname, int port = 9042) {
+  Resolver::Ptr create(const String& hostname, int port = 9042,
+                       const ResolverCache::Ptr& cache = ResolverCache::Ptr()) {
     return Resolver::Ptr(
-        new Resolver(hostname, port, bind_callback(&ResolverUnitTest::on_resolve, this)));
+        new Resolver(hostname, port, bind_callback(&ResolverUnitTest::on_resolve, this), cache));
   }
 
   MultiResolver::Ptr create_multi() {
@@ -171,3 +172,77 @@ TEST_F(ResolverUnitTest, MultiCancel) {
     EXPECT_TRUE((*it)->addresses().empty());
   }
 }
+
+TEST_F(ResolverUnitTest, Cached) {
+  ResolverCache::Ptr cache(new ResolverCache(60000, 60000));
+
+  Resolver::Ptr resolver(create("localhost", 9042, cache));
+  resolver->resolve(loop(), RESOLVE_TIMEOUT);
+  run_loop();
+  ASSERT_EQ(Resolver::SUCCESS, status());
+  EXPECT_FALSE(resolver->is_cached());
+  EXPECT_EQ(1u, cache->size());
+
+  resolver = create("localhost", 9042, cache);
+  resolver->resolve(loop(), RESOLVE_TIMEOUT);
+  run_loop();
+  ASSERT_EQ(Resolver::SUCCESS, status());
+  EXPECT_TRUE(resolver->is_cached());
+  verify_addresses(addresses());
+
+  // The port is part of the cached lookup
+  resolver = create("localhost", 9043, cache);
+  resolver->resolve(loop(), RESOLVE_TIMEOUT);
+  run_loop();
+  ASSERT_EQ(Resolver::SUCCESS, status());
+  EXPECT_FALSE(resolver->is_cached());
+}
+
+TEST_F(ResolverUnitTest, CachedInvalid) {
+  ResolverCache::Ptr cache(new ResolverCache(60000, 60000));
+
+  Resolver::Ptr resolver(create("doesnotexist.dne", 9042, cache));
+  resolver->resolve(loop(), RESOLVE_TIMEOUT);
+  run_loop();
+  ASSERT_EQ(Resolver::FAILED_UNABLE_TO_RESOLVE, status());
+
+  resolver = create("doesnotexist.dne", 9042, cache);
+  resolver->resolve(loop(), RESOLVE_TIMEOUT);
+  run_loop();
+  ASSERT_EQ(Resolver::FAILED_UNABLE_TO_RESOLVE, status());
+  EXPECT_TRUE(resolver->is_cached());
+  EXPECT_TRUE(addresses().empty());
+}
+
+TEST_F(ResolverUnitTest, CachedCancel) {
+  ResolverCache::Ptr cache(new ResolverCache(60000, 60000));
+  AddressVec cached;
+  cached.push_back(Address("127.0.0.1", 9042));
+  cache->put_addresses("localhost", 9042, cached, 0);
+
+  Resolver::Ptr resolver(create("localhost", 9042, cache));
+  resolver->resolve(loop(), RESOLVE_TIMEOUT);
+  resolver->cancel();
+  run_loop();
+  EXPECT_EQ(Resolver::CANCELED, status());
+  EXPECT_TRUE(addresses().empty());
+}
+
+TEST(ResolverCacheUnitTest, Expire) {
+  ResolverCache::Ptr cache(new ResolverCache(60000, 0)); // Failed lookups aren't cached
+  AddressVec addresses;
+  addresses.push_back(Address("127.0.0.1", 9042));
+  cache->put_addresses("localhost", 9042, addresses, 0);
+  cache->put_addresses("doesnotexist.dne", 9042, AddressVec(), UV_EAI_NONAME);
+
+  AddressVec result;
+  int uv_status;
+  EXPECT_TRUE(cache->get_addresses("localhost", 9042, &result, &uv_status));
+  EXPECT_EQ(addresses, result);
+  EXPECT_FALSE(cache->get_addresses("doesnotexist.dne", 9042, &result, &uv_status));
+
+  cache.reset(new ResolverCache(1, 1));
+  cache->put_addresses("localhost", 9042, addresses, 0);
+  test::Utils::msleep(10);
+  EXPECT_FALSE(cache->get_addresses("localhost", 9042, &result, &uv_status));
+}
@@ -0,0 +1,328 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "mockssandra.hpp"
+#include "response.hpp"
+#include "result_response.hpp"
+#include "row_stream_decoder.hpp"
+#include "supported_response.hpp"
+
+#include <algorithm>
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+class ResponseMessageUnitTest : public testing::Test {
+public:
+  // A SUPPORTED response with a body of (at least) the given size
+  static String supported_frame(size_t body_size) {
+    StringMultimap supported;
+    supported["COMPRESSION"].push_back(String(body_size, 'a'));
+
+    String body;
+    mockssandra::encode_string_map(supported, &body);
+
+    char header[CASS_HEADER_SIZE_V3];
+    header[0] = CASS_PROTOCOL_VERSION_V4;
+    header[1] = 0;                         // Flags
+    encode_int16(header + 2, 0);           // Stream
+    header[4] = CQL_OPCODE_SUPPORTED;      // Opcode
+    encode_int32(header + 5, body.size()); // Length
+    return String(header, sizeof(header)) + body;
+  }
+
+  // A SET_KEYSPACE result with a keyspace of the given size
+  static String set_keyspace_frame(size_t keyspace_size) {
+    String body(sizeof(int32_t) + sizeof(uint16_t), '\0');
+    encode_int32(&body[0], CASS_RESULT_KIND_SET_KEYSPACE);
+    encode_uint16(&body[sizeof(int32_t)], keyspace_size);
+    body.append(keyspace_size, 'k');
+
+    char header[CASS_HEADER_SIZE_V3];
+    header[0] = CASS_PROTOCOL_VERSION_V4;
+    header[1] = 0;                         // Flags
+    encode_int16(header + 2, 0);           // Stream
+    header[4] = CQL_OPCODE_RESULT;         // Opcode
+    encode_int32(header + 5, body.size()); // Length
+    return String(header, sizeof(header)) + body;
+  }
+
+  // A ROWS result with an int column and the given number of rows
+  static String rows_frame(int32_t row_count, uint8_t flags = 0) {
+    String body;
+    append_int32(&body, CASS_RESULT_KIND_ROWS);
+    append_int32(&body, CASS_RESULT_FLAG_GLOBAL_TABLESPEC);
+    append_int32(&body, 1); // Column count
+    append_string(&body, "ks");
+    append_string(&body, "table");
+    append_string(&body, "value");
+    String type(sizeof(uint16_t), '\0');
+    encode_uint16(&type[0], CASS_VALUE_TYPE_INT);
+    body.append(type);
+    append_int32(&body, row_count);
+    for (int32_t i = 0; i < row_count; ++i) {
+      append_int32(&body, sizeof(int32_t));
+      append_int32(&body, i);
+    }
+
+    char header[CASS_HEADER_SIZE_V3];
+    header[0] = CASS_PROTOCOL_VERSION_V4;
+    header[1] = flags;                     // Flags
+    encode_int16(header + 2, 0);           // Stream
+    header[4] = CQL_OPCODE_RESULT;         // Opcode
+    encode_int32(header + 5, body.size()); // Length
+    return String(header, sizeof(header)) + body;
+  }
+
+  static void append_int32(String* output, int32_t value) {
+    char buf[sizeof(int32_t)];
+    encode_int32(buf, value);
+    output->append(buf, sizeof(buf));
+  }
+
+  static void append_string(String* output, const String& value) {
+    char buf[sizeof(uint16_t)];
+    encode_uint16(buf, value.size());
+    output->append(buf, sizeof(buf));
+    output->append(value);
+  }
+
+  static RefBuffer::Ptr read_buffer(const String& data) {
+    RefBuffer::Ptr buffer(RefBuffer::create(data.size()));
+    memcpy(buffer->data(), data.data(), data.size());
+    return buffer;
+  }
+
+  static void verify_body(ResponseMessage& response, size_t body_size) {
+    ASSERT_TRUE(response.is_body_ready());
+    SupportedResponse* supported =
+        static_cast<SupportedResponse*>(response.response_body().get());
+    StringMultimap::const_iterator it = supported->supported_options().find("COMPRESSION");
+    ASSERT_TRUE(it != supported->supported_options().end());
+    EXPECT_EQ(String(body_size, 'a'), it->second.front());
+  }
+};
+
+TEST_F(ResponseMessageUnitTest, ZeroCopyContainedBody) {
+  String frame(supported_frame(32 * 1024));
+  RefBuffer::Ptr buffer(read_buffer(frame));
+
+  ResponseMessage response;
+  EXPECT_EQ(static_cast<ssize_t>(frame.size()),
+            response.decode(buffer->data(), frame.size(), buffer.get()));
+  verify_body(response, 32 * 1024);
+
+  // The body references the read buffer instead of a copy
+  EXPECT_EQ(buffer.get(), response.response_body()->buffer().get());
+  EXPECT_EQ(buffer->data() + CASS_HEADER_SIZE_V3, response.response_body()->data());
+}
+
+TEST_F(ResponseMessageUnitTest, CopySmallBody) {
+  String frame(supported_frame(128));
+  RefBuffer::Ptr buffer(read_buffer(frame));
+
+  ResponseMessage response;
+  EXPECT_EQ(static_cast<ssize_t>(frame.size()),
+            response.decode(buffer->data(), frame.size(), buffer.get()));
+  verify_body(response, 128);
+
+  // Small bodies are copied so they don't keep the read buffer alive
+  EXPECT_NE(buffer.get(), response.response_body()->buffer().get());
+  EXPECT_EQ(1, buffer->ref_count());
+}
+
+TEST_F(ResponseMessageUnitTest, CopyStraddledBody) {
+  String frame(supported_frame(32 * 1024));
+  RefBuffer::Ptr buffer(read_buffer(frame));
+
+  // Split the frame across two reads
+  size_t half = frame.size() / 2;
+  ResponseMessage response;
+  EXPECT_EQ(static_cast<ssize_t>(half), response.decode(buffer->data(), half, buffer.get()));
+  EXPECT_FALSE(response.is_body_ready());
+  EXPECT_EQ(static_cast<ssize_t>(frame.size() - half),
+            response.decode(buffer->data() + half, frame.size() - half, buffer.get()));
+  verify_body(response, 32 * 1024);
+
+  EXPECT_NE(buffer.get(), response.response_body()->buffer().get());
+}
+
+TEST_F(ResponseMessageUnitTest, SplitAfterHeader) {
+  String frame(supported_frame(32 * 1024));
+  RefBuffer::Ptr header(read_buffer(frame.substr(0, CASS_HEADER_SIZE_V3)));
+  RefBuffer::Ptr body(read_buffer(frame.substr(CASS_HEADER_SIZE_V3)));
+
+  // A body that arrives in a single read after the header can still be
+  // referenced directly
+  ResponseMessage response;
+  EXPECT_EQ(CASS_HEADER_SIZE_V3,
+            response.decode(header->data(), CASS_HEADER_SIZE_V3, header.get()));
+  EXPECT_EQ(static_cast<ssize_t>(frame.size() - CASS_HEADER_SIZE_V3),
+            response.decode(body->data(), frame.size() - CASS_HEADER_SIZE_V3, body.get()));
+  verify_body(response, 32 * 1024);
+
+  EXPECT_EQ(body.get(), response.response_body()->buffer().get());
+}
+
+TEST_F(ResponseMessageUnitTest, DeferredResultBody) {
+  String frame(set_keyspace_frame(32 * 1024));
+  RefBuffer::Ptr buffer(read_buffer(frame));
+
+  ResponseMessage response;
+  response.set_deferred_body_threshold(1024);
+  EXPECT_EQ(static_cast<ssize_t>(frame.size()),
+            response.decode(buffer->data(), frame.size(), buffer.get()));
+  ASSERT_TRUE(response.is_body_ready());
+  EXPECT_TRUE(response.is_body_deferred());
+
+  // The body isn't decoded, but it keeps the read buffer alive
+  ResultResponse* result = static_cast<ResultResponse*>(response.response_body().get());
+  EXPECT_EQ(CASS_RESULT_KIND_VOID, result->kind());
+  EXPECT_EQ(2, buffer->ref_count());
+
+  EXPECT_TRUE(response.decode_deferred_body());
+  EXPECT_FALSE(response.is_body_deferred());
+  EXPECT_EQ(CASS_RESULT_KIND_SET_KEYSPACE, result->kind());
+  EXPECT_EQ(String(32 * 1024, 'k'), result->keyspace().to_string());
+}
+
+TEST_F(ResponseMessageUnitTest, DeferredSmallResultBodyCopied) {
+  String frame(set_keyspace_frame(128));
+  RefBuffer::Ptr buffer(read_buffer(frame));
+
+  ResponseMessage response;
+  response.set_deferred_body_threshold(64);
+  EXPECT_EQ(static_cast<ssize_t>(frame.size()),
+            response.decode(buffer->data(), frame.size(), buffer.get()));
+  EXPECT_TRUE(response.is_body_deferred());
+  EXPECT_EQ(1, buffer->ref_count()); // Copied before the read buffer is reused
+
+  EXPECT_TRUE(response.decode_deferred_body());
+  ResultResponse* result = static_cast<ResultResponse*>(response.response_body().get());
+  EXPECT_EQ(String(128, 'k'), result->keyspace().to_string());
+}
+
+TEST_F(ResponseMessageUnitTest, NotDeferredBelowThresholdOrOtherOpcodes) {
+  String frame(set_keyspace_frame(128));
+  RefBuffer::Ptr buffer(read_buffer(frame));
+
+  ResponseMessage response;
+  response.set_deferred_body_threshold(1024);
+  response.decode(buffer->data(), frame.size(), buffer.get());
+  ASSERT_TRUE(response.is_body_ready());
+  EXPECT_FALSE(response.is_body_deferred());
+
+  // Only RESULT bodies are deferred
+  String supported(supported_frame(32 * 1024));
+  RefBuffer::Ptr supported_buffer(read_buffer(supported));
+  ResponseMessage supported_response;
+  supported_response.set_deferred_body_threshold(1024);
+  supported_response.decode(supported_buffer->data(), supported.size(), supported_buffer.get());
+  EXPECT_FALSE(supported_response.is_body_deferred());
+  verify_body(supported_response, 32 * 1024);
+}
+
+TEST_F(ResponseMessageUnitTest, StreamRowsOfPartialBody) {
+  const int32_t row_count = 1000;
+  String frame(rows_frame(row_count));
+  RefBuffer::Ptr buffer(read_buffer(frame));
+
+  // Receive the frame in small reads and decode the rows as they arrive
+  const size_t read_size = 100;
+  ResponseMessage response;
+  RowStreamDecoder decoder;
+  Row row;
+  int32_t streamed_row_count = 0;
+  for (size_t pos = 0; pos < frame.size(); pos += read_size) {
+    size_t size = std::min(read_size, frame.size() - pos);
+    ASSERT_EQ(static_cast<ssize_t>(size), response.decode(buffer->data() + pos, size));
+    if (response.is_body_ready()) break;
+
+    ASSERT_TRUE(decoder.update(&response, ResultMetadata::Ptr()));
+    while (decoder.next_row(&row)) {
+      cass_int32_t value;
+      ASSERT_EQ(CASS_OK, cass_value_get_int32(CassValue::to(&row.values[0]), &value));
+      EXPECT_EQ(streamed_row_count, value);
+      streamed_row_count++;
+    }
+    EXPECT_EQ(streamed_row_count, decoder.row_index());
+  }
+
+  // All the rows, except the rows of the last read, are decoded before the
+  // whole body is received
+  ASSERT_TRUE(response.is_body_ready());
+  EXPECT_GE(streamed_row_count, row_count - static_cast<int32_t>(read_size / 8) - 1);
+  EXPECT_LT(streamed_row_count, row_count);
+
+  ResultResponse* result = static_cast<ResultResponse*>(response.response_body().get());
+  EXPECT_EQ(row_count, result->row_count());
+}
+
+TEST_F(ResponseMessageUnitTest, StreamRowsOfCompressedBodyUnsupported) {
+  String frame(rows_frame(100, CASS_FLAG_COMPRESSION));
+
+  // Compressed bodies can only be decoded once they've been received
+  ResponseMessage response;
+  size_t half = frame.size() / 2;
+  ASSERT_EQ(static_cast<ssize_t>(half), response.decode(frame.data(), half));
+  ASSERT_FALSE(response.is_body_ready());
+
+  RowStreamDecoder decoder;
+  EXPECT_FALSE(decoder.update(&response, ResultMetadata::Ptr()));
+}
+
+TEST_F(ResponseMessageUnitTest, ConcatRows) {
+  Vector<ResultResponse::ConstPtr> results;
+  const int32_t row_counts[] = { 3, 0, 2 };
+  Vector<ResponseMessage*> responses;
+  for (size_t i = 0; i < sizeof(row_counts) / sizeof(row_counts[0]); ++i) {
+    String frame(rows_frame(row_counts[i]));
+    ResponseMessage* response = new ResponseMessage();
+    responses.push_back(response);
+    ASSERT_EQ(static_cast<ssize_t>(frame.size()), response->decode(frame.data(), frame.size()));
+    ASSERT_TRUE(response->is_body_ready());
+    results.push_back(ResultResponse::ConstPtr(
+        static_cast<ResultResponse*>(response->response_body().get())));
+  }
+
+  // The rows are concatenated in the order of the results
+  ResultResponse::Ptr result(ResultResponse::concat_rows(results));
+  ASSERT_TRUE(result);
+  EXPECT_EQ(CASS_RESULT_KIND_ROWS, result->kind());
+  EXPECT_EQ(1, result->column_count());
+  ASSERT_EQ(5, result->row_count());
+
+  const int32_t expected[] = { 0, 1, 2, 0, 1 };
+  CassIterator* iterator = cass_iterator_from_result(CassResult::to(result.get()));
+  for (size_t i = 0; cass_iterator_next(iterator); ++i) {
+    cass_int32_t value;
+    const CassRow* row = cass_iterator_get_row(iterator);
+    ASSERT_EQ(CASS_OK, cass_value_get_int32(cass_row_get_column(row, 0), &value));
+    EXPECT_EQ(expected[i], value);
+  }
+  cass_iterator_free(iterator);
+
+  // Results with different columns can't be concatenated
+  results.push_back(ResultResponse::ConstPtr(new ResultResponse()));
+  EXPECT_FALSE(ResultResponse::concat_rows(results));
+
+  for (size_t i = 0; i < responses.size(); ++i) {
+    delete responses[i];
+  }
+}
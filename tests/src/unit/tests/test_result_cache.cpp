@@ -0,0 +1,76 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "result_cache.hpp"
+
+using namespace datastax::internal::core;
+
+#define TTL_MS 60 * 1000
+
+TEST(ResultCacheUnitTest, HitAndMiss) {
+  ResultCache::Ptr cache(new ResultCache(4));
+  ResultResponse::Ptr result(new ResultResponse());
+
+  EXPECT_FALSE(cache->get("a"));
+  cache->put("a", result, TTL_MS);
+  EXPECT_EQ(result.get(), cache->get("a").get()); // Shared, not copied
+
+  CassResultCacheMetrics metrics;
+  cache->get_metrics(&metrics);
+  EXPECT_EQ(1u, metrics.entries);
+  EXPECT_EQ(4u, metrics.max_entries);
+  EXPECT_EQ(1u, metrics.hits);
+  EXPECT_EQ(1u, metrics.misses);
+  EXPECT_EQ(0u, metrics.evictions);
+}
+
+TEST(ResultCacheUnitTest, Expired) {
+  ResultCache::Ptr cache(new ResultCache(4));
+
+  cache->put("a", ResultResponse::Ptr(new ResultResponse()), 0);
+  EXPECT_FALSE(cache->get("a"));
+
+  // Replacing an expired result makes it available again
+  cache->put("a", ResultResponse::Ptr(new ResultResponse()), TTL_MS);
+  EXPECT_TRUE(cache->get("a"));
+
+  CassResultCacheMetrics metrics;
+  cache->get_metrics(&metrics);
+  EXPECT_EQ(1u, metrics.entries);
+  EXPECT_EQ(1u, metrics.hits);
+  EXPECT_EQ(1u, metrics.misses);
+}
+
+TEST(ResultCacheUnitTest, EvictLeastRecentlyUsed) {
+  ResultCache::Ptr cache(new ResultCache(2));
+
+  cache->put("a", ResultResponse::Ptr(new ResultResponse()), TTL_MS);
+  cache->put("b", ResultResponse::Ptr(new ResultResponse()), TTL_MS);
+  EXPECT_TRUE(cache->get("a"));
+
+  // "b" hasn't been used since it was cached
+  cache->put("c", ResultResponse::Ptr(new ResultResponse()), TTL_MS);
+  EXPECT_TRUE(cache->get("a"));
+  EXPECT_FALSE(cache->get("b"));
+  EXPECT_TRUE(cache->get("c"));
+
+  CassResultCacheMetrics metrics;
+  cache->get_metrics(&metrics);
+  EXPECT_EQ(2u, metrics.entries);
+  EXPECT_EQ(1u, metrics.evictions);
+}
@@ -0,0 +1,280 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "result_columns.hpp"
+#include "result_response.hpp"
+#include "row_batch.hpp"
+#include "serialization.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+class ResultColumnsUnitTest : public testing::Test {
+public:
+  void SetUp() {
+    append_int32(CASS_RESULT_KIND_ROWS);
+    append_int32(CASS_RESULT_FLAG_GLOBAL_TABLESPEC);
+    append_int32(4); // Column count
+    append_string("keyspace");
+    append_string("table");
+    append_column("id", CASS_VALUE_TYPE_INT);
+    append_column("value", CASS_VALUE_TYPE_BIGINT);
+    append_column("name", CASS_VALUE_TYPE_VARCHAR);
+    append_column("score", CASS_VALUE_TYPE_DOUBLE);
+    append_int32(3); // Row count
+
+    for (int32_t i = 0; i < 3; ++i) {
+      append_int32(sizeof(int32_t));
+      append_int32(i);
+      if (i == 1) {
+        append_int32(-1); // Null
+      } else {
+        append_int32(sizeof(int64_t));
+        append_int64(i * 1000LL);
+      }
+      String name(static_cast<size_t>(i + 1), 'a');
+      append_int32(name.size());
+      data_.append(name);
+      append_int32(sizeof(double));
+      char buf[sizeof(double)];
+      encode_double(buf, i + 0.5);
+      data_.append(buf, sizeof(buf));
+    }
+
+    Decoder decoder(data_.data(), data_.size(), ProtocolVersion(CASS_PROTOCOL_VERSION_V4));
+    ASSERT_TRUE(result_.decode(decoder));
+  }
+
+  void append_int32(int32_t value) {
+    char buf[sizeof(int32_t)];
+    encode_int32(buf, value);
+    data_.append(buf, sizeof(buf));
+  }
+
+  void append_int64(int64_t value) {
+    char buf[sizeof(int64_t)];
+    encode_int64(buf, value);
+    data_.append(buf, sizeof(buf));
+  }
+
+  void append_string(const String& value) {
+    char buf[sizeof(uint16_t)];
+    encode_uint16(buf, value.size());
+    data_.append(buf, sizeof(buf));
+    data_.append(value);
+  }
+
+  void append_column(const String& name, CassValueType type) {
+    append_string(name);
+    char buf[sizeof(uint16_t)];
+    encode_uint16(buf, type);
+    data_.append(buf, sizeof(buf));
+  }
+
+  const CassResult* result() const { return CassResult::to(&result_); }
+
+  const ResultColumns* result_columns() const { return result_.columns(); }
+
+private:
+  String data_;
+  ResultResponse result_;
+};
+
+TEST_F(ResultColumnsUnitTest, FixedSizeColumns) {
+  cass_int32_t ids[3];
+  EXPECT_EQ(CASS_OK, cass_result_column_get_int32(result(), 0, ids, NULL, 3));
+  EXPECT_EQ(0, ids[0]);
+  EXPECT_EQ(1, ids[1]);
+  EXPECT_EQ(2, ids[2]);
+
+  cass_int64_t values[3];
+  cass_bool_t is_null[3];
+  EXPECT_EQ(CASS_OK, cass_result_column_get_int64(result(), 1, values, is_null, 3));
+  EXPECT_EQ(0, values[0]);
+  EXPECT_EQ(0, values[1]);
+  EXPECT_EQ(2000, values[2]);
+  EXPECT_EQ(cass_false, is_null[0]);
+  EXPECT_EQ(cass_true, is_null[1]);
+  EXPECT_EQ(cass_false, is_null[2]);
+
+  cass_double_t scores[3];
+  EXPECT_EQ(CASS_OK, cass_result_column_get_double(result(), 3, scores, NULL, 3));
+  EXPECT_EQ(0.5, scores[0]);
+  EXPECT_EQ(2.5, scores[2]);
+}
+
+TEST_F(ResultColumnsUnitTest, StringColumn) {
+  const char* names[3];
+  size_t name_lengths[3];
+  EXPECT_EQ(CASS_OK, cass_result_column_get_string(result(), 2, names, name_lengths, 3));
+  EXPECT_EQ("a", String(names[0], name_lengths[0]));
+  EXPECT_EQ("aa", String(names[1], name_lengths[1]));
+  EXPECT_EQ("aaa", String(names[2], name_lengths[2]));
+}
+
+TEST_F(ResultColumnsUnitTest, ValidUtf8Column) {
+  cass_bool_t is_valid = cass_false;
+  EXPECT_EQ(CASS_OK, cass_result_column_is_valid_utf8(result(), 2, &is_valid));
+  EXPECT_EQ(cass_true, is_valid);
+
+  // The cached result is returned the second time
+  is_valid = cass_false;
+  EXPECT_EQ(CASS_OK, cass_result_column_is_valid_utf8(result(), 2, &is_valid));
+  EXPECT_EQ(cass_true, is_valid);
+
+  EXPECT_EQ(CASS_ERROR_LIB_INVALID_VALUE_TYPE,
+            cass_result_column_is_valid_utf8(result(), 0, &is_valid));
+  EXPECT_EQ(CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS,
+            cass_result_column_is_valid_utf8(result(), 4, &is_valid));
+}
+
+TEST_F(ResultColumnsUnitTest, RowBatch) {
+  CassRowBatch* batch = cass_row_batch_new(2);
+  ASSERT_TRUE(batch != NULL);
+
+  EXPECT_EQ(CASS_OK, cass_row_batch_decode(batch, result(), 0));
+  ASSERT_EQ(2u, cass_row_batch_row_count(batch));
+
+  // Both rows are valid at the same time
+  const CassRow* rows[] = { cass_row_batch_get_row(batch, 0), cass_row_batch_get_row(batch, 1) };
+  for (int32_t i = 0; i < 2; ++i) {
+    cass_int32_t id;
+    EXPECT_EQ(CASS_OK, cass_value_get_int32(cass_row_get_column(rows[i], 0), &id));
+    EXPECT_EQ(i, id);
+  }
+  EXPECT_EQ(cass_true, cass_value_is_null(cass_row_get_column_by_name(rows[1], "value")));
+  EXPECT_TRUE(cass_row_batch_get_row(batch, 2) == NULL);
+
+  // The batch is reused starting at a row after the first
+  EXPECT_EQ(CASS_OK, cass_row_batch_decode(batch, result(), 2));
+  ASSERT_EQ(1u, cass_row_batch_row_count(batch));
+  const CassRow* row = cass_row_batch_get_row(batch, 0);
+  cass_int64_t value;
+  EXPECT_EQ(CASS_OK, cass_value_get_int64(cass_row_get_column(row, 1), &value));
+  EXPECT_EQ(2000, value);
+  const char* name;
+  size_t name_length;
+  EXPECT_EQ(CASS_OK, cass_value_get_string(cass_row_get_column(row, 2), &name, &name_length));
+  EXPECT_EQ(String("aaa"), String(name, name_length));
+
+  EXPECT_EQ(CASS_OK, cass_row_batch_decode(batch, result(), 3));
+  EXPECT_EQ(0u, cass_row_batch_row_count(batch));
+  EXPECT_EQ(CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS, cass_row_batch_decode(batch, result(), 4));
+
+  cass_row_batch_free(batch);
+
+  EXPECT_TRUE(cass_row_batch_new(0) == NULL);
+}
+
+TEST_F(ResultColumnsUnitTest, InvalidParameters) {
+  cass_int32_t ids[3];
+  EXPECT_EQ(CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS,
+            cass_result_column_get_int32(result(), 4, ids, NULL, 3));
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS, cass_result_column_get_int32(result(), 0, ids, NULL, 2));
+  EXPECT_EQ(CASS_ERROR_LIB_INVALID_VALUE_TYPE,
+            cass_result_column_get_int32(result(), 1, ids, NULL, 3));
+}
+
+TEST_F(ResultColumnsUnitTest, MatchesRowIterator) {
+  // The columnar index is built once and agrees with row-by-row decoding
+  const ResultColumns* columns = result_columns();
+  ASSERT_TRUE(columns != NULL);
+  EXPECT_EQ(columns, result_columns());
+
+  CassIterator* iterator = cass_iterator_from_result(result());
+  for (size_t row = 0; cass_iterator_next(iterator); ++row) {
+    const CassValue* value = cass_row_get_column(cass_iterator_get_row(iterator), 2);
+    const char* expected = NULL;
+    size_t expected_length = 0;
+    ASSERT_EQ(CASS_OK, cass_value_get_string(value, &expected, &expected_length));
+
+    int32_t size = 0;
+    EXPECT_EQ(expected, columns->cell(2, row, &size));
+    EXPECT_EQ(static_cast<int32_t>(expected_length), size);
+  }
+  cass_iterator_free(iterator);
+}
+
+TEST_F(ResultColumnsUnitTest, FixedWidthArrays) {
+  cass_int64_t values[3];
+  cass_uint8_t validity[1];
+  EXPECT_EQ(CASS_OK, cass_result_column_get_int64_array(result(), 1, values, validity, 3));
+  EXPECT_EQ(0, values[0]);
+  EXPECT_EQ(0, values[1]);
+  EXPECT_EQ(2000, values[2]);
+  EXPECT_EQ(0x5, validity[0]); // The second row is null
+
+  cass_int32_t ids[3];
+  EXPECT_EQ(CASS_OK, cass_result_column_get_int32_array(result(), 0, ids, NULL, 3));
+  EXPECT_EQ(0, ids[0]);
+  EXPECT_EQ(1, ids[1]);
+  EXPECT_EQ(2, ids[2]);
+
+  cass_double_t scores[3];
+  EXPECT_EQ(CASS_OK, cass_result_column_get_double_array(result(), 3, scores, NULL, 3));
+  EXPECT_EQ(0.5, scores[0]);
+  EXPECT_EQ(1.5, scores[1]);
+  EXPECT_EQ(2.5, scores[2]);
+
+  EXPECT_EQ(CASS_ERROR_LIB_INVALID_VALUE_TYPE,
+            cass_result_column_get_float_array(result(), 3, NULL, NULL, 3));
+  EXPECT_EQ(CASS_ERROR_LIB_INVALID_VALUE_TYPE,
+            cass_result_column_get_duration(result(), 1, NULL, NULL, NULL, NULL, 3));
+}
+
+TEST_F(ResultColumnsUnitTest, ExportArrow) {
+  ArrowArray array;
+  ArrowSchema schema;
+  ASSERT_EQ(CASS_OK, cass_result_export_arrow(result(), &array, &schema));
+
+  EXPECT_STREQ("+s", schema.format);
+  ASSERT_EQ(4, schema.n_children);
+  EXPECT_STREQ("i", schema.children[0]->format);
+  EXPECT_STREQ("id", schema.children[0]->name);
+  EXPECT_STREQ("l", schema.children[1]->format);
+  EXPECT_STREQ("u", schema.children[2]->format);
+  EXPECT_STREQ("g", schema.children[3]->format);
+
+  EXPECT_EQ(3, array.length);
+  ASSERT_EQ(4, array.n_children);
+
+  const ArrowArray* ids = array.children[0];
+  EXPECT_EQ(0, ids->null_count);
+  EXPECT_EQ(2, static_cast<const int32_t*>(ids->buffers[1])[2]);
+
+  const ArrowArray* values = array.children[1];
+  EXPECT_EQ(1, values->null_count);
+  EXPECT_EQ(0x5, static_cast<const uint8_t*>(values->buffers[0])[0]);
+  EXPECT_EQ(2000, static_cast<const int64_t*>(values->buffers[1])[2]);
+
+  const ArrowArray* names = array.children[2];
+  ASSERT_EQ(3, names->n_buffers);
+  const int32_t* offsets = static_cast<const int32_t*>(names->buffers[1]);
+  const char* chars = static_cast<const char*>(names->buffers[2]);
+  EXPECT_EQ("aa", String(chars + offsets[1], offsets[2] - offsets[1]));
+  EXPECT_EQ(6, offsets[3]);
+
+  const ArrowArray* scores = array.children[3];
+  EXPECT_EQ(1.5, static_cast<const double*>(scores->buffers[1])[1]);
+
+  array.release(&array);
+  schema.release(&schema);
+  EXPECT_TRUE(array.release == NULL);
+  EXPECT_TRUE(schema.release == NULL);
+}
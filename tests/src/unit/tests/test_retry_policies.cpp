@@ -173,3 +173,31 @@ TEST(RetryPoliciesUnitTest, Logging) {
   cass_log_set_level(CASS_LOG_INFO);
   check_default(logging_policy);
 }
+
+TEST(RetryPoliciesUnitTest, RetryBudget) {
+  RetryBudget budget(0.1);
+
+  // The budget starts with its reserve of retries
+  for (int i = 0; i < RetryBudget::RESERVE; ++i) {
+    EXPECT_TRUE(budget.try_withdraw());
+  }
+  EXPECT_FALSE(budget.try_withdraw());
+
+  // Ten requests earn a single retry
+  for (int i = 0; i < 9; ++i) {
+    budget.deposit();
+    EXPECT_FALSE(budget.try_withdraw());
+  }
+  budget.deposit();
+  EXPECT_TRUE(budget.try_withdraw());
+  EXPECT_FALSE(budget.try_withdraw());
+
+  // Deposits stop once the reserve is full
+  for (int i = 0; i < 1000; ++i) {
+    budget.deposit();
+  }
+  for (int i = 0; i < RetryBudget::RESERVE; ++i) {
+    EXPECT_TRUE(budget.try_withdraw());
+  }
+  EXPECT_FALSE(budget.try_withdraw());
+}
@@ -0,0 +1,141 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "ring_buffer.hpp"
+#include "string.hpp"
+
+#include <string.h>
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::rb;
+
+static String sequence(size_t size) {
+  String data(size, '\0');
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = static_cast<char>('a' + i % 26);
+  }
+  return data;
+}
+
+TEST(RingBufferUnitTest, WriteAndReadAcrossChunks) {
+  RingBuffer buffer;
+  EXPECT_EQ(static_cast<size_t>(ChunkPool::MIN_CHUNK_SIZE), buffer.chunk_size());
+
+  String data(sequence(3 * ChunkPool::MIN_CHUNK_SIZE + 100));
+  buffer.write(data.data(), data.size());
+  EXPECT_EQ(data.size(), buffer.length());
+
+  String result(data.size(), '\0');
+  EXPECT_EQ(data.size(), buffer.read(&result[0], result.size()));
+  EXPECT_EQ(data, result);
+  EXPECT_EQ(0u, buffer.length());
+}
+
+TEST(RingBufferUnitTest, MinimumChunkSize) {
+  ChunkPool::Ptr pool(new ChunkPool(1024));
+  EXPECT_EQ(static_cast<size_t>(ChunkPool::MIN_CHUNK_SIZE), pool->chunk_size());
+}
+
+TEST(RingBufferUnitTest, LargeChunks) {
+  ChunkPool::Ptr pool(new ChunkPool(256 * 1024));
+  RingBuffer buffer(pool);
+  RingBuffer::Position start = buffer.write_position();
+
+  // A whole chunk is available for a single read from the socket
+  size_t size = 0;
+  char* writable = buffer.peek_writable(&size);
+  ASSERT_EQ(256u * 1024u, size);
+
+  String data(sequence(200 * 1024));
+  memcpy(writable, data.data(), data.size());
+  buffer.commit(data.size());
+
+  // The data is still in a single chunk
+  SmallVector<uv_buf_t, 4> bufs;
+  EXPECT_EQ(data.size(), buffer.peek_multiple(start, &bufs));
+  EXPECT_EQ(1u, bufs.size());
+}
+
+TEST(RingBufferUnitTest, SharedPool) {
+  ChunkPool::Ptr pool(new ChunkPool());
+  String data(sequence(2 * ChunkPool::MIN_CHUNK_SIZE + 100));
+
+  {
+    RingBuffer buffer(pool);
+    buffer.write(data.data(), data.size());
+    EXPECT_EQ(0u, pool->free_count());
+  }
+
+  // The chunks are returned to the pool
+  size_t free_count = pool->free_count();
+  EXPECT_GE(free_count, 3u);
+
+  // and reused by the next ring buffer
+  {
+    RingBuffer buffer(pool);
+    buffer.write(data.data(), data.size());
+    EXPECT_EQ(free_count - 3, pool->free_count());
+
+    String result(data.size(), '\0');
+    EXPECT_EQ(data.size(), buffer.read(&result[0], result.size()));
+    EXPECT_EQ(data, result);
+  }
+  EXPECT_EQ(free_count, pool->free_count());
+}
+
+TEST(RingBufferUnitTest, MaxFreeChunks) {
+  ChunkPool::Ptr pool(new ChunkPool(ChunkPool::MIN_CHUNK_SIZE, 2));
+  String data(sequence(4 * ChunkPool::MIN_CHUNK_SIZE));
+
+  {
+    RingBuffer buffer(pool);
+    buffer.write(data.data(), data.size());
+  }
+
+  // The extra chunks are freed
+  EXPECT_EQ(2u, pool->free_count());
+}
+
+TEST(RingBufferUnitTest, Preallocate) {
+  ChunkPool::Ptr pool(new ChunkPool(ChunkPool::MIN_CHUNK_SIZE, 4));
+  pool->preallocate();
+  EXPECT_EQ(4u, pool->free_count());
+
+  {
+    RingBuffer buffer(pool); // Uses a preallocated chunk
+    EXPECT_EQ(3u, pool->free_count());
+  }
+  EXPECT_EQ(4u, pool->free_count());
+}
+
+TEST(RingBufferUnitTest, HugePages) {
+  ChunkPool::Ptr pool(new ChunkPool(ChunkPool::MIN_CHUNK_SIZE, 2, true));
+  String data(sequence(4 * ChunkPool::MIN_CHUNK_SIZE));
+
+  {
+    RingBuffer buffer(pool);
+    buffer.write(data.data(), data.size());
+
+    String read(data.size(), '\0');
+    EXPECT_EQ(data.size(), buffer.read(&read[0], read.size()));
+    EXPECT_EQ(data, read);
+  }
+
+  EXPECT_EQ(2u, pool->free_count());
+}
@@ -0,0 +1,152 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "cassandra_row_decoder.hpp"
+#include "result_response.hpp"
+#include "serialization.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+class RowDecoderUnitTest : public testing::Test {
+public:
+  void SetUp() {
+    append_int32(CASS_RESULT_KIND_ROWS);
+    append_int32(CASS_RESULT_FLAG_GLOBAL_TABLESPEC);
+    append_int32(4); // Column count
+    append_string("keyspace");
+    append_string("table");
+    append_column("id", CASS_VALUE_TYPE_UUID);
+    append_column("value", CASS_VALUE_TYPE_BIGINT);
+    append_column("name", CASS_VALUE_TYPE_VARCHAR);
+    append_column("score", CASS_VALUE_TYPE_DOUBLE);
+    append_int32(3); // Row count
+
+    for (int32_t i = 0; i < 3; ++i) {
+      CassUuid id;
+      id.time_and_version = 0x0123456789ABCDEFULL + i;
+      id.clock_seq_and_node = 0xFEDCBA9876543210ULL;
+      char uuid[16];
+      encode_uuid(uuid, id);
+      append_int32(sizeof(uuid));
+      data_.append(uuid, sizeof(uuid));
+      if (i == 1) {
+        append_int32(-1); // Null
+      } else {
+        append_int32(sizeof(int64_t));
+        append_int64(i * 1000LL);
+      }
+      String name(static_cast<size_t>(i + 1), 'a');
+      append_int32(name.size());
+      data_.append(name);
+      append_int32(sizeof(double));
+      char buf[sizeof(double)];
+      encode_double(buf, i + 0.5);
+      data_.append(buf, sizeof(buf));
+    }
+  }
+
+  bool decode() {
+    Decoder decoder(data_.data(), data_.size(), ProtocolVersion(CASS_PROTOCOL_VERSION_V4));
+    return result_.decode(decoder);
+  }
+
+  void truncate(size_t size) { data_.resize(data_.size() - size); }
+
+  const CassResult* result() const { return CassResult::to(&result_); }
+
+private:
+  void append_int32(int32_t value) {
+    char buf[sizeof(int32_t)];
+    encode_int32(buf, value);
+    data_.append(buf, sizeof(buf));
+  }
+
+  void append_int64(int64_t value) {
+    char buf[sizeof(int64_t)];
+    encode_int64(buf, value);
+    data_.append(buf, sizeof(buf));
+  }
+
+  void append_string(const String& value) {
+    char buf[sizeof(uint16_t)];
+    encode_uint16(buf, value.size());
+    data_.append(buf, sizeof(buf));
+    data_.append(value);
+  }
+
+  void append_column(const String& name, CassValueType type) {
+    append_string(name);
+    char buf[sizeof(uint16_t)];
+    encode_uint16(buf, type);
+    data_.append(buf, sizeof(buf));
+  }
+
+private:
+  String data_;
+  ResultResponse result_;
+};
+
+TEST_F(RowDecoderUnitTest, DecodesRows) {
+  ASSERT_TRUE(decode());
+
+  typedef cass::RowDecoder<CassUuid, cass_int64_t, std::string, cass_double_t> Decoder;
+  Decoder decoder(result());
+  ASSERT_EQ(CASS_OK, decoder.error_code());
+  EXPECT_EQ(3u, decoder.remaining());
+
+  Decoder::Row row;
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(decoder.next(&row));
+    EXPECT_EQ(0x0123456789ABCDEFULL + i, std::get<0>(row).time_and_version);
+    EXPECT_EQ(0xFEDCBA9876543210ULL, std::get<0>(row).clock_seq_and_node);
+    EXPECT_EQ(i == 1 ? 0 : i * 1000LL, std::get<1>(row)); // Null is decoded as zero
+    EXPECT_EQ(std::string(static_cast<size_t>(i + 1), 'a'), std::get<2>(row));
+    EXPECT_EQ(i + 0.5, std::get<3>(row));
+  }
+  EXPECT_FALSE(decoder.next(&row));
+  EXPECT_EQ(CASS_OK, decoder.error_code());
+}
+
+TEST_F(RowDecoderUnitTest, CheckedOncePerResult) {
+  ASSERT_TRUE(decode());
+
+  // The types must match the columns' types
+  cass::RowDecoder<CassUuid, cass_int32_t, std::string, cass_double_t> wrong_type(result());
+  EXPECT_EQ(CASS_ERROR_LIB_INVALID_VALUE_TYPE, wrong_type.error_code());
+  EXPECT_EQ(0u, wrong_type.remaining());
+
+  // There must be a type for each column
+  cass::RowDecoder<CassUuid, cass_int64_t> too_few(result());
+  EXPECT_EQ(CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS, too_few.error_code());
+}
+
+TEST_F(RowDecoderUnitTest, TruncatedRows) {
+  truncate(4);
+  ASSERT_TRUE(decode()); // Only the first row is decoded eagerly
+
+  cass::RowDecoder<CassUuid, cass_int64_t, std::string, cass_double_t> decoder(result());
+  ASSERT_EQ(CASS_OK, decoder.error_code());
+
+  std::tuple<CassUuid, cass_int64_t, std::string, cass_double_t> row;
+  EXPECT_TRUE(decoder.next(&row));
+  EXPECT_TRUE(decoder.next(&row));
+  EXPECT_FALSE(decoder.next(&row));
+  EXPECT_EQ(CASS_ERROR_LIB_INVALID_DATA, decoder.error_code());
+}
@@ -134,6 +134,92 @@ public:
     mutable UuidGen uuid_gen_;
   };
 
+  struct LaggingPeerCounts {
+    LaggingPeerCounts()
+        : peers_count(0)
+        , targeted_peers_count(0)
+        , other_targeted_peers_count(0) {}
+    Atomic<int> peers_count;
+    Atomic<int> targeted_peers_count;
+    Atomic<int> other_targeted_peers_count; // Targeted queries for peers that already agreed
+  };
+
+  /**
+   * A schema version action where a single peer lags behind the other nodes
+   * for a number of checks.
+   */
+  class LaggingPeerSchemaVersion : public Action {
+  public:
+    LaggingPeerSchemaVersion(const Address& lagging_address, int lagging_checks,
+                             LaggingPeerCounts* counts)
+        : lagging_address_(lagging_address)
+        , lagging_checks_(lagging_checks)
+        , counts_(counts) {
+      uuid_gen_.generate_random(&uuid_);
+      uuid_gen_.generate_random(&old_uuid_);
+    }
+
+    void on_run(Request* request) const {
+      String query;
+      QueryParameters params;
+      if (!request->decode_query(&query, &params)) {
+        request->error(ERROR_PROTOCOL_ERROR, "Invalid query message");
+      } else if (query.find(SELECT_LOCAL_SCHEMA_CHANGE) != String::npos) {
+        ResultSet local_rs = ResultSet::Builder("system", "local")
+                                 .column("schema_version", Type::uuid())
+                                 .row(Row::Builder().uuid(uuid_).build())
+                                 .build();
+        request->write(OPCODE_RESULT, local_rs.encode(request->version()));
+      } else if (query.find(SELECT_PEERS_SCHEMA_CHANGE) != String::npos) {
+        const String where_clause(" WHERE peer = '");
+        String ip;
+        size_t pos = query.find(where_clause);
+        if (pos != String::npos) {
+          pos += where_clause.size();
+          ip = query.substr(pos, query.find("'", pos) - pos);
+          counts_->targeted_peers_count.fetch_add(1);
+          if (Address(ip, lagging_address_.port()) != lagging_address_) {
+            counts_->other_targeted_peers_count.fetch_add(1);
+          }
+        }
+        bool is_lagging = counts_->peers_count.fetch_add(1) < lagging_checks_;
+
+        ResultSet::Builder peers_builder = ResultSet::Builder("system", "peers")
+                                               .column("peer", Type::inet())
+                                               .column("rpc_address", Type::inet())
+                                               .column("host_id", Type::uuid())
+                                               .column("schema_version", Type::uuid());
+        Hosts hosts(request->hosts());
+        for (Hosts::const_iterator it = hosts.begin(), end = hosts.end(); it != end; ++it) {
+          const Host& host(*it);
+          if (host.address == request->address() ||
+              (!ip.empty() && host.address != Address(ip, host.address.port()))) {
+            continue;
+          }
+          peers_builder.row(Row::Builder()
+                                .inet(host.address)
+                                .inet(host.address)
+                                .uuid(uuid_) // Doesn't matter
+                                .uuid(is_lagging && host.address == lagging_address_ ? old_uuid_
+                                                                                     : uuid_)
+                                .build());
+        }
+        ResultSet peers_rs = peers_builder.build();
+        request->write(OPCODE_RESULT, peers_rs.encode(request->version()));
+      } else {
+        run_next(request);
+      }
+    }
+
+  private:
+    Address lagging_address_;
+    int lagging_checks_;
+    CassUuid uuid_;
+    CassUuid old_uuid_;
+    LaggingPeerCounts* counts_;
+    mutable UuidGen uuid_gen_;
+  };
+
   class SchemaChange : public Action {
   public:
     void on_run(Request* request) const {
@@ -241,3 +327,34 @@ TEST_F(SchemaAgreementUnitTest, Timeout) {
 
   close(&session);
 }
+
+/**
+ * Verify that only the peers that don't agree are checked again.
+ */
+TEST_F(SchemaAgreementUnitTest, TargetedPeerChecks) {
+  LaggingPeerCounts counts;
+
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(OPCODE_QUERY)
+      .execute(new LaggingPeerSchemaVersion(Address("127.0.0.3", 9042), 3, &counts))
+      .execute(new SchemaChange())
+      .system_local()
+      .system_peers()
+      .empty_rows_result(1);
+
+  mockssandra::SimpleCluster cluster(builder.build(), 3);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  connect(&session);
+
+  add_logging_critera("Found schema agreement in");
+
+  execute(&session, "CREATE TABLE tbl (key text PRIMARY KEY, value text)");
+  EXPECT_EQ(logging_criteria_count(), 1);
+  EXPECT_EQ(counts.peers_count.load(), 4);
+  EXPECT_EQ(counts.targeted_peers_count.load(), 3); // Only the first check queries all peers
+  EXPECT_EQ(counts.other_targeted_peers_count.load(), 0);
+
+  close(&session);
+}
@@ -0,0 +1,141 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "segment.hpp"
+#include "string.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+static String envelope(size_t size, char c) { return String(size, c); }
+
+static String encode(const Vector<String>& envelopes, BufferVec* segments) {
+  String expected;
+  SizeVec sizes;
+  for (Vector<String>::const_iterator it = envelopes.begin(); it != envelopes.end(); ++it) {
+    // Split each envelope across two buffers to verify the buffers are gathered
+    size_t half = it->size() / 2;
+    segments->push_back(Buffer(it->data(), half));
+    segments->push_back(Buffer(it->data() + half, it->size() - half));
+    sizes.push_back(it->size());
+    expected.append(*it);
+  }
+  SegmentEncoder encoder;
+  encoder.encode(sizes, segments);
+  return expected;
+}
+
+static String flatten(const BufferVec& bufs) {
+  String result;
+  for (BufferVec::const_iterator it = bufs.begin(); it != bufs.end(); ++it) {
+    result.append(it->data(), it->size());
+  }
+  return result;
+}
+
+TEST(SegmentUnitTest, PackSmallEnvelopes) {
+  Vector<String> envelopes;
+  envelopes.push_back(envelope(10, 'a'));
+  envelopes.push_back(envelope(20, 'b'));
+  envelopes.push_back(envelope(30, 'c'));
+
+  BufferVec segments;
+  String expected = encode(envelopes, &segments);
+  ASSERT_EQ(1u, segments.size());
+  EXPECT_EQ(SEGMENT_HEADER_LENGTH + 60u + SEGMENT_TRAILER_LENGTH, segments[0].size());
+
+  SegmentDecoder decoder;
+  EXPECT_EQ(static_cast<ssize_t>(segments[0].size()),
+            decoder.decode(segments[0].data(), segments[0].size()));
+  ASSERT_TRUE(decoder.is_ready());
+  EXPECT_TRUE(decoder.is_self_contained());
+  EXPECT_EQ(expected, String(decoder.payload(), decoder.payload_length()));
+}
+
+TEST(SegmentUnitTest, SplitLargeEnvelope) {
+  Vector<String> envelopes;
+  envelopes.push_back(envelope(100, 'a'));
+  envelopes.push_back(envelope(SEGMENT_MAX_PAYLOAD_LENGTH + 10, 'b'));
+  envelopes.push_back(envelope(50, 'c'));
+
+  BufferVec segments;
+  String expected = encode(envelopes, &segments);
+  ASSERT_EQ(4u, segments.size());
+
+  const size_t lengths[] = { 100, SEGMENT_MAX_PAYLOAD_LENGTH, 10, 50 };
+  const bool self_contained[] = { true, false, false, true };
+
+  String decoded;
+  SegmentDecoder decoder;
+  for (size_t i = 0; i < segments.size(); ++i) {
+    decoder.decode(segments[i].data(), segments[i].size());
+    ASSERT_TRUE(decoder.is_ready());
+    EXPECT_EQ(lengths[i], decoder.payload_length());
+    EXPECT_EQ(self_contained[i], decoder.is_self_contained());
+    decoded.append(decoder.payload(), decoder.payload_length());
+  }
+  EXPECT_EQ(expected, decoded);
+}
+
+TEST(SegmentUnitTest, DecodeIncrementally) {
+  Vector<String> envelopes;
+  envelopes.push_back(envelope(1000, 'a'));
+  envelopes.push_back(envelope(SEGMENT_MAX_PAYLOAD_LENGTH, 'b'));
+
+  BufferVec segments;
+  String expected = encode(envelopes, &segments);
+  String data = flatten(segments);
+
+  // Feed the decoder a single byte at a time
+  String decoded;
+  SegmentDecoder decoder;
+  for (size_t i = 0; i < data.size(); ++i) {
+    ASSERT_EQ(1, decoder.decode(data.data() + i, 1));
+    if (decoder.is_ready()) {
+      decoded.append(decoder.payload(), decoder.payload_length());
+    }
+  }
+  EXPECT_EQ(expected, decoded);
+}
+
+TEST(SegmentUnitTest, InvalidHeaderChecksum) {
+  Vector<String> envelopes;
+  envelopes.push_back(envelope(10, 'a'));
+
+  BufferVec segments;
+  encode(envelopes, &segments);
+  String data = flatten(segments);
+  data[3] ^= 0x01;
+
+  SegmentDecoder decoder;
+  EXPECT_LT(decoder.decode(data.data(), data.size()), 0);
+}
+
+TEST(SegmentUnitTest, InvalidPayloadChecksum) {
+  Vector<String> envelopes;
+  envelopes.push_back(envelope(10, 'a'));
+
+  BufferVec segments;
+  encode(envelopes, &segments);
+  String data = flatten(segments);
+  data[SEGMENT_HEADER_LENGTH] ^= 0x01;
+
+  SegmentDecoder decoder;
+  EXPECT_LT(decoder.decode(data.data(), data.size()), 0);
+}
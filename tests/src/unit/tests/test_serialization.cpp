@@ -17,12 +17,46 @@
 #include <gtest/gtest.h>
 
 #include "buffer.hpp"
+#include "encode.hpp"
 #include "serialization.hpp"
 
+using namespace datastax;
 using namespace datastax::internal;
 
 TEST(SerializationTest, DecodeZigZag) { ASSERT_EQ(1LL << 63, decode_zig_zag((long)-1)); }
 
+TEST(SerializationTest, DecodeDuration) {
+  const core::CassDuration durations[] = {
+    core::CassDuration(0, 0, 0),
+    core::CassDuration(1, -2, 3),
+    core::CassDuration(-64, 63, 8191),
+    core::CassDuration(std::numeric_limits<int32_t>::max(), std::numeric_limits<int32_t>::min(),
+                       std::numeric_limits<int64_t>::max()),
+    core::CassDuration(std::numeric_limits<int32_t>::min(), 12345678,
+                       std::numeric_limits<int64_t>::min())
+  };
+
+  for (size_t i = 0; i < sizeof(durations) / sizeof(durations[0]); ++i) {
+    core::Buffer buf(core::encode(durations[i]));
+    // The vints are decoded one byte at a time near the end of the input and
+    // using a single load otherwise
+    String input(buf.data(), buf.size());
+    for (int padding = 0; padding < 2; ++padding) {
+      int32_t months = 0, days = 0;
+      int64_t nanos = 0;
+      ASSERT_TRUE(decode_duration(input.data(), input.size(), &months, &days, &nanos));
+      EXPECT_EQ(durations[i].months, months);
+      EXPECT_EQ(durations[i].days, days);
+      EXPECT_EQ(durations[i].nanos, nanos);
+
+      if (padding == 0) { // Truncated values aren't decoded
+        EXPECT_FALSE(decode_duration(input.data(), buf.size() - 1, &months, &days, &nanos));
+      }
+      input.append(16, '\0');
+    }
+  }
+}
+
 TEST(SerializationTest, DecodeByte) {
   const signed char input[2] = { -1, 0 };
   uint8_t value = 0;
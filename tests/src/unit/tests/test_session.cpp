@@ -15,12 +15,16 @@
 */
 
 #include "event_loop_test.hpp"
+#include "get_time.hpp"
+#include "paged_result_iterator.hpp"
 #include "query_request.hpp"
 #include "session.hpp"
 
 #define KEYSPACE "datastax"
 #define NUM_THREADS 2         // Number of threads to execute queries using a session
 #define OUTAGE_PLAN_DELAY 250 // Reduced delay to incorporate larger outage plan
+#define PAGED_QUERY "SELECT * FROM paged"
+#define PAGED_QUERY_PAGE_COUNT 3
 
 using namespace datastax::internal;
 using namespace datastax::internal::core;
@@ -149,16 +153,14 @@ public:
     Type type() { return event_.first; }
 
     void set_event(Type type, const Address& host) {
-      ScopedMutex lock(&mutex_);
-      if (!is_set()) {
+      if (internal_claim()) {
         event_ = Event(type, host);
-        internal_set(lock);
+        internal_set();
       }
     }
 
     Event wait_for_event(uint64_t timeout_us) {
-      ScopedMutex lock(&mutex_);
-      return internal_wait_for(lock, timeout_us) ? event_ : Event(INVALID, Address());
+      return internal_wait_for(timeout_us) ? event_ : Event(INVALID, Address());
     }
 
   private:
@@ -273,6 +275,42 @@ public:
       request->write(mockssandra::OPCODE_SUPPORTED, body);
     }
   };
+
+  // Returns PAGED_QUERY_PAGE_COUNT pages with two rows each. The paging state
+  // is the index of the next page.
+  class PagedRowsResult : public mockssandra::Action {
+  public:
+    PagedRowsResult(Atomic<int>* page_requests)
+        : page_requests_(page_requests) {}
+
+    virtual void on_run(mockssandra::Request* request) const {
+      String query;
+      mockssandra::QueryParameters params;
+      if (!request->decode_query(&query, &params) || query != PAGED_QUERY) {
+        run_next(request);
+        return;
+      }
+      page_requests_->fetch_add(1);
+
+      int page = params.paging_state.empty() ? 0 : params.paging_state[0] - '0';
+      bool has_more_pages = page + 1 < PAGED_QUERY_PAGE_COUNT;
+
+      String body;
+      mockssandra::encode_int32(mockssandra::RESULT_ROWS, &body);
+      mockssandra::encode_int32(has_more_pages ? mockssandra::RESULT_FLAG_HAS_MORE_PAGES : 0,
+                                &body);
+      mockssandra::encode_int32(0, &body); // Column count
+      if (has_more_pages) {
+        mockssandra::encode_int32(1, &body);
+        body.push_back(static_cast<char>('0' + page + 1));
+      }
+      mockssandra::encode_int32(2, &body); // Row count
+      request->write(mockssandra::OPCODE_RESULT, body);
+    }
+
+  private:
+    Atomic<int>* page_requests_;
+  };
 };
 
 TEST_F(SessionUnitTest, ExecuteQueryNotConnected) {
@@ -335,6 +373,30 @@ TEST_F(SessionUnitTest, InvalidLocalAddress) {
   ASSERT_TRUE(session.close()->wait_for(WAIT_FOR_TIME));
 }
 
+TEST_F(SessionUnitTest, LocalAddresses) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  // The connections are spread across the loopback addresses
+  AddressVec local_addresses;
+  local_addresses.push_back(Address("127.0.0.1", 0));
+  local_addresses.push_back(Address("127.0.0.2", 0));
+  local_addresses.push_back(Address("::1", 0)); // Not used for IPv4 hosts
+
+  Config config;
+  config.set_local_addresses(local_addresses);
+  config.set_core_connections_per_host(4);
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  Session session;
+  connect(config, &session);
+
+  for (int i = 0; i < 4; ++i) {
+    query(&session);
+  }
+
+  close(&session);
+}
+
 TEST_F(SessionUnitTest, ExecuteQueryReusingSession) {
   mockssandra::SimpleCluster cluster(simple());
   ASSERT_EQ(cluster.start_all(), 0);
@@ -466,6 +528,156 @@ TEST_F(SessionUnitTest, ExecuteQueryWithThreadsUsingSsl) {
   close(&session);
 }
 
+TEST_F(SessionUnitTest, ExecuteQueryWithThreadsUsingIoUring) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  // The sockets use libuv if the driver or the kernel doesn't support io_uring
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_thread_count_io(2);
+  config.set_io_uring_enabled(true);
+
+  Session session;
+  for (int i = 0; i < 2; ++i) {
+    connect(config, &session);
+    query_on_threads(&session);
+    close(&session);
+  }
+}
+
+TEST_F(SessionUnitTest, ExecuteQueryWithThreadsUsingBusyPoll) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_thread_count_io(2);
+  config.set_busy_poll(true, 0);
+
+  Session session;
+  connect(config, &session);
+  query_on_threads(&session);
+  close(&session);
+}
+
+TEST_F(SessionUnitTest, ExecuteQueryWithWorkStealing) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  // Every result body is decoded by a stealable task
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_thread_count_io(2);
+  config.set_work_stealing(true);
+  config.set_result_decode_offload_threshold(1);
+
+  Session session;
+  connect(config, &session);
+
+  uint64_t tasks_run = 0;
+  for (size_t i = 0; i < session.event_loop_group()->size(); ++i) {
+    tasks_run += session.event_loop_group()->get(i)->tasks_run();
+  }
+
+  const int num_queries = 10;
+  for (int i = 0; i < num_queries; ++i) {
+    query(&session);
+  }
+
+  // Each response is decoded by one task and handled by another on the
+  // connection's event loop
+  uint64_t tasks_run_after = 0;
+  for (size_t i = 0; i < session.event_loop_group()->size(); ++i) {
+    tasks_run_after += session.event_loop_group()->get(i)->tasks_run();
+  }
+  EXPECT_GE(tasks_run_after - tasks_run, 2u * num_queries);
+
+  close(&session);
+}
+
+TEST_F(SessionUnitTest, ExecuteQueryWithThreadsUsingNumaLocalPools) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_thread_count_io(2);
+  config.set_io_thread_numa_local(true);
+
+  Session session;
+  connect(config, &session);
+  query_on_threads(&session);
+  close(&session);
+}
+
+TEST_F(SessionUnitTest, ExecuteQueryUsingSharedRuntime) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_thread_count_io(2);
+  config.set_shared_runtime(true);
+
+  Session session1;
+  Session session2;
+  connect(config, &session1);
+  connect(config, &session2);
+
+  // Both sessions run on the same threads
+  ASSERT_TRUE(session1.event_loop_group() != NULL);
+  EXPECT_EQ(session1.event_loop_group(), session2.event_loop_group());
+  EXPECT_EQ(config.shared_runtime()->event_loop_group(), session1.event_loop_group());
+
+  query_on_threads(&session1);
+  query(&session2);
+
+  // The threads keep running for the other session
+  close(&session1);
+  query(&session2);
+  close(&session2);
+
+  // A closed session can connect again using the running threads
+  connect(config, &session1);
+  query(&session1);
+  close(&session1);
+}
+
+TEST_F(SessionUnitTest, ExecuteQueryUsingRuntimeOfSeveralClusterObjects) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  SharedRuntime::Ptr runtime(new SharedRuntime(2));
+
+  Config config1;
+  config1.contact_points().push_back(Address("127.0.0.1", 9042));
+  config1.set_thread_count_io(4);
+  config1.set_runtime(runtime.get());
+
+  Config config2;
+  config2.contact_points().push_back(Address("127.0.0.1", 9042));
+  config2.set_runtime(runtime.get());
+
+  Session session1;
+  Session session2;
+  connect(config1, &session1);
+  connect(config2, &session2);
+
+  // The runtime's number of IO threads is used by both sessions
+  EXPECT_EQ(runtime->event_loop_group(), session1.event_loop_group());
+  EXPECT_EQ(runtime->event_loop_group(), session2.event_loop_group());
+  EXPECT_EQ(2u, runtime->thread_count_io());
+  EXPECT_EQ(2u, session1.config().thread_count_io());
+  EXPECT_EQ(2u, session2.config().thread_count_io());
+
+  query_on_threads(&session1);
+  query_on_threads(&session2);
+
+  close(&session1);
+  close(&session2);
+}
+
 TEST_F(SessionUnitTest, ExecuteQueryWithThreadsChaotic) {
   mockssandra::SimpleCluster cluster(simple(), 4);
   ASSERT_EQ(cluster.start_all(), 0);
@@ -639,6 +851,78 @@ TEST_F(SessionUnitTest, HostListenerDCAwareRemote) {
   ASSERT_EQ(0u, listener->event_count());
 }
 
+TEST_F(SessionUnitTest, LazyRemotePools) {
+  mockssandra::SimpleCluster cluster(simple(), 1, 1);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_load_balancing_policy(new DCAwarePolicy("dc1", 1, false));
+  config.set_lazy_remote_pools(true, 1);
+
+  Session session;
+  connect(config, &session);
+
+  CassConnectionMetrics metrics;
+  EXPECT_EQ(CASS_OK, cass_session_get_connection_metrics(CassSession::to(&session), "127.0.0.2",
+                                                         9042, &metrics));
+  EXPECT_EQ(0u, metrics.connections); // The remote host isn't connected
+
+  // The remote host is connected on first use. The requests fail until its
+  // pool is connected.
+  bool is_connected = false;
+  for (int i = 0; i < 50 && !is_connected; ++i) {
+    SharedRefPtr<QueryRequest> request(new QueryRequest("blah", 0));
+    request->set_host(Address("127.0.0.2", 9042));
+    Future::Ptr future = session.execute(Request::ConstPtr(request));
+    ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+    is_connected = !future->error();
+    if (!is_connected) test::Utils::msleep(100);
+  }
+  ASSERT_TRUE(is_connected);
+  EXPECT_EQ(CASS_OK, cass_session_get_connection_metrics(CassSession::to(&session), "127.0.0.2",
+                                                         9042, &metrics));
+  EXPECT_GE(metrics.connections, 1u);
+
+  // The remote host's pool is closed once it's idle
+  for (int i = 0; i < 50 && metrics.connections > 0; ++i) {
+    test::Utils::msleep(100);
+    cass_session_get_connection_metrics(CassSession::to(&session), "127.0.0.2", 9042, &metrics);
+  }
+  EXPECT_EQ(0u, metrics.connections);
+
+  close(&session);
+}
+
+TEST_F(SessionUnitTest, RemoteConnectionsPerHost) {
+  mockssandra::SimpleCluster cluster(simple(), 1, 1);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_load_balancing_policy(new DCAwarePolicy("dc1", 1, false));
+  config.set_core_connections_per_host(4);
+  config.set_core_connections_per_remote_host(1);
+
+  Session session;
+  connect(config, &session);
+
+  // The remote host is connected once the request processor is initialized
+  CassConnectionMetrics metrics;
+  memset(&metrics, 0, sizeof(metrics));
+  for (int i = 0; i < 50 && metrics.connections == 0; ++i) {
+    cass_session_get_connection_metrics(CassSession::to(&session), "127.0.0.2", 9042, &metrics);
+    if (metrics.connections == 0) test::Utils::msleep(100);
+  }
+  EXPECT_EQ(1u, metrics.connections);
+
+  EXPECT_EQ(CASS_OK, cass_session_get_connection_metrics(CassSession::to(&session), "127.0.0.1",
+                                                         9042, &metrics));
+  EXPECT_GE(metrics.connections, 4u); // The control connection is also counted
+
+  close(&session);
+}
+
 TEST_F(SessionUnitTest, HostListenerNodeDown) {
   mockssandra::SimpleCluster cluster(simple(), 3);
   ASSERT_EQ(cluster.start(1), 0);
@@ -866,6 +1150,63 @@ TEST_F(SessionUnitTest, LocalDcNotOverriddenOnPolicyUsingExecutionProfiles) {
   ASSERT_EQ(0u, listener->event_count());
 }
 
+TEST_F(SessionUnitTest, UpdateExecutionProfile) {
+  mockssandra::SimpleCluster cluster(simple(), 3);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+
+  ExecutionProfile profile;
+  profile.set_load_balancing_policy(new RoundRobinPolicy());
+  profile.whitelist().push_back("127.0.0.1");
+  config.set_execution_profile("pinned", &profile);
+
+  Session session;
+  EXPECT_EQ(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE,
+            session.update_execution_profile("pinned", profile));
+  connect(config, &session);
+
+  for (int i = 0; i < 10; ++i) {
+    QueryRequest::Ptr request(new QueryRequest("blah", 0));
+    request->set_execution_profile_name("pinned");
+    ResponseFuture::Ptr future = session.execute(Request::ConstPtr(request));
+    EXPECT_TRUE(future->wait_for(WAIT_FOR_TIME));
+    EXPECT_FALSE(future->error());
+    EXPECT_EQ("127.0.0.1", future->address().to_string());
+  }
+
+  ExecutionProfile updated;
+  updated.set_load_balancing_policy(new RoundRobinPolicy());
+  updated.whitelist().push_back("127.0.0.2");
+  EXPECT_EQ(CASS_ERROR_LIB_EXECUTION_PROFILE_INVALID,
+            session.update_execution_profile("invalid", updated));
+  EXPECT_EQ(CASS_OK, session.update_execution_profile("pinned", updated));
+
+  // The profile is replaced asynchronously on the I/O thread
+  int attempts = 0;
+  String address;
+  do {
+    QueryRequest::Ptr request(new QueryRequest("blah", 0));
+    request->set_execution_profile_name("pinned");
+    ResponseFuture::Ptr future = session.execute(Request::ConstPtr(request));
+    EXPECT_TRUE(future->wait_for(WAIT_FOR_TIME));
+    EXPECT_FALSE(future->error());
+    address = future->address().to_string();
+  } while (address != "127.0.0.2" && ++attempts < 100);
+
+  for (int i = 0; i < 10; ++i) {
+    QueryRequest::Ptr request(new QueryRequest("blah", 0));
+    request->set_execution_profile_name("pinned");
+    ResponseFuture::Ptr future = session.execute(Request::ConstPtr(request));
+    EXPECT_TRUE(future->wait_for(WAIT_FOR_TIME));
+    EXPECT_FALSE(future->error());
+    EXPECT_EQ("127.0.0.2", future->address().to_string());
+  }
+
+  close(&session);
+}
+
 TEST_F(SessionUnitTest, NoContactPoints) {
   // No cluster needed
 
@@ -880,6 +1221,29 @@ TEST_F(SessionUnitTest, NoContactPoints) {
   EXPECT_EQ(connect_future->error()->code, CASS_ERROR_LIB_NO_HOSTS_AVAILABLE);
 }
 
+TEST_F(SessionUnitTest, ParallelStartup) {
+  mockssandra::SimpleCluster cluster(simple(), 3);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_use_parallel_startup(true);
+  connect(config, &session);
+
+  // The session is only connected after the deferred schema is retrieved
+  StartupTimings timings(session.startup_timings());
+  EXPECT_GT(timings.control_connection, 0u);
+  EXPECT_GT(timings.hosts_query, 0u);
+  EXPECT_GT(timings.schema_query, 0u);
+  EXPECT_GT(timings.connection_pools, 0u);
+  EXPECT_GE(timings.total, timings.connection_pools);
+
+  query(&session);
+
+  close(&session);
+}
+
 TEST_F(SessionUnitTest, DefaultConsistency) {
   mockssandra::SimpleCluster cluster(simple());
   ASSERT_EQ(cluster.start_all(), 0);
@@ -1011,3 +1375,778 @@ TEST_F(SessionUnitTest, DbaasDefaultConsistencyExecutionProfileNotUpdate) {
 
   close(&session);
 }
+
+TEST_F(SessionUnitTest, RackMetrics) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  connect(config, &session);
+
+  for (int i = 0; i < 3; ++i) {
+    Future::Ptr future(session.execute(Request::ConstPtr(new QueryRequest("blah", 0))));
+    ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+    EXPECT_FALSE(future->error());
+  }
+
+  // The local rack is the connected host's rack
+  CassRackMetrics metrics;
+  cass_session_get_rack_metrics(CassSession::to(&session), &metrics);
+  EXPECT_EQ(3u, metrics.local_rack_requests);
+  EXPECT_EQ(0u, metrics.local_dc_requests);
+  EXPECT_EQ(0u, metrics.remote_dc_requests);
+
+  close(&session);
+}
+
+TEST_F(SessionUnitTest, HostAndProfileMetrics) {
+  mockssandra::SimpleCluster cluster(simple(), 2);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_host_and_profile_metrics(true);
+  ExecutionProfile profile;
+  config.set_execution_profile("profile", &profile);
+  connect(config, &session);
+
+  for (int i = 0; i < 4; ++i) {
+    Statement::Ptr request(new QueryRequest("blah", 0));
+    request->set_execution_profile_name("profile");
+    Future::Ptr future(session.execute(Request::ConstPtr(request)));
+    ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+    EXPECT_FALSE(future->error());
+  }
+
+  CassLatencyMetrics metrics;
+  EXPECT_EQ(CASS_OK,
+            cass_session_get_execution_profile_metrics(CassSession::to(&session), "profile",
+                                                       &metrics));
+  EXPECT_GT(metrics.max, 0u);
+  EXPECT_EQ(CASS_ERROR_LIB_EXECUTION_PROFILE_INVALID,
+            cass_session_get_execution_profile_metrics(CassSession::to(&session), "invalid",
+                                                       &metrics));
+
+  // The requests are spread over both hosts
+  EXPECT_EQ(CASS_OK,
+            cass_session_get_host_metrics(CassSession::to(&session), "127.0.0.1", 9042, &metrics));
+  EXPECT_GT(metrics.max, 0u);
+  EXPECT_EQ(CASS_OK,
+            cass_session_get_host_metrics(CassSession::to(&session), "127.0.0.2", 9042, &metrics));
+  EXPECT_GT(metrics.max, 0u);
+  EXPECT_EQ(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE,
+            cass_session_get_host_metrics(CassSession::to(&session), "127.0.0.3", 9042, &metrics));
+
+  close(&session);
+}
+
+TEST_F(SessionUnitTest, RequestStageMetrics) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_request_stage_metrics(true);
+  connect(config, &session);
+
+  for (int i = 0; i < 4; ++i) {
+    Future::Ptr future(session.execute(Request::ConstPtr(new QueryRequest("blah", 0))));
+    ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+    EXPECT_FALSE(future->error());
+  }
+
+  CassRequestStageMetrics metrics;
+  cass_session_get_request_stage_metrics(CassSession::to(&session), &metrics);
+  // The request goes over a real socket to the server
+  EXPECT_GT(metrics.server.max, 0u);
+  EXPECT_GE(metrics.server.max, metrics.server.min);
+  EXPECT_GE(metrics.queue.max, metrics.queue.min);
+  EXPECT_GE(metrics.write.max, metrics.write.min);
+
+  close(&session);
+}
+
+TEST_F(SessionUnitTest, RequestStageMetricsDisabled) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  connect(config, &session);
+
+  Future::Ptr future(session.execute(Request::ConstPtr(new QueryRequest("blah", 0))));
+  ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+
+  CassRequestStageMetrics metrics;
+  cass_session_get_request_stage_metrics(CassSession::to(&session), &metrics);
+  EXPECT_EQ(0u, metrics.queue.max);
+  EXPECT_EQ(0u, metrics.server.max);
+
+  close(&session);
+}
+
+TEST_F(SessionUnitTest, ConnectionMetrics) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  connect(config, &session);
+
+  Vector<Future::Ptr> futures;
+  for (int i = 0; i < 10; ++i) {
+    futures.push_back(session.execute(Request::ConstPtr(new QueryRequest("blah", 0))));
+  }
+  for (Vector<Future::Ptr>::const_iterator it = futures.begin(); it != futures.end(); ++it) {
+    ASSERT_TRUE((*it)->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+  }
+
+  CassConnectionMetrics metrics;
+  EXPECT_EQ(CASS_OK, cass_session_get_connection_metrics(CassSession::to(&session), "127.0.0.1",
+                                                         9042, &metrics));
+  EXPECT_GE(metrics.connections, 1u);
+  EXPECT_GT(metrics.bytes_written, 0u);
+  EXPECT_GT(metrics.bytes_read, 0u);
+  EXPECT_GE(metrics.flushes, 1u);
+  // The startup messages are flushed too
+  EXPECT_GE(metrics.flushed_requests, 10u);
+  EXPECT_LE(metrics.flushes, metrics.flushed_requests);
+  EXPECT_GE(metrics.max_inflight_requests, 1u);
+
+  EXPECT_EQ(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE,
+            cass_session_get_connection_metrics(CassSession::to(&session), "127.0.0.2", 9042,
+                                                &metrics));
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS,
+            cass_session_get_connection_metrics(CassSession::to(&session), "invalid", 9042,
+                                                &metrics));
+
+  close(&session);
+}
+
+TEST_F(SessionUnitTest, OpenMetrics) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  EXPECT_EQ(0u, cass_session_get_open_metrics(CassSession::to(&session), NULL, 0));
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_host_and_profile_metrics(true);
+  connect(config, &session);
+
+  Future::Ptr future(session.execute(Request::ConstPtr(new QueryRequest("blah", 0))));
+  ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+
+  size_t length = cass_session_get_open_metrics(CassSession::to(&session), NULL, 0);
+  ASSERT_GT(length, 0u);
+  // Some of the values, like the event loops' busy time, change between calls
+  Vector<char> buffer(length + 1024);
+  length = cass_session_get_open_metrics(CassSession::to(&session), &buffer[0], buffer.size());
+  String metrics(&buffer[0]);
+  EXPECT_EQ(length, metrics.size());
+
+  EXPECT_NE(String::npos,
+            metrics.find("# TYPE cassandra_driver_request_latency_seconds summary\n"));
+  EXPECT_NE(String::npos, metrics.find("cassandra_driver_request_latency_seconds_count "));
+  EXPECT_NE(String::npos, metrics.find("cassandra_driver_connections 1\n"));
+  EXPECT_NE(String::npos, metrics.find("cassandra_driver_host_request_latency_seconds{host="
+                                       "\"127.0.0.1:9042\",quantile=\"0.99\"}"));
+  EXPECT_EQ(length - 6, metrics.rfind("# EOF\n"));
+
+  // The output is truncated to the buffer
+  char small[8];
+  EXPECT_GT(cass_session_get_open_metrics(CassSession::to(&session), small, sizeof(small)),
+            sizeof(small));
+  EXPECT_EQ(String("# TYPE "), String(small));
+
+  close(&session);
+}
+
+TEST_F(SessionUnitTest, RetryBudget) {
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(mockssandra::OPCODE_QUERY)
+      .system_local()
+      .system_peers()
+      .error(mockssandra::ERROR_OVERLOADED, "Overloaded");
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_retry_budget_ratio(0.01);
+  config.set_thread_count_io(2); // The budget is shared by the I/O threads
+  connect(config, &session);
+
+  for (int i = 0; i < 15; ++i) {
+    Statement::Ptr request(new QueryRequest("blah", 0));
+    request->set_is_idempotent(true);
+    Future::Ptr future(session.execute(Request::ConstPtr(request)));
+    ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+    EXPECT_TRUE(future->error());
+  }
+
+  // Only the reserve of retries is allowed because the requests haven't
+  // earned a whole retry
+  CassRetryMetrics metrics;
+  cass_session_get_retry_metrics(CassSession::to(&session), &metrics);
+  EXPECT_EQ(static_cast<cass_uint64_t>(RetryBudget::RESERVE), metrics.retries);
+  EXPECT_EQ(15u - RetryBudget::RESERVE, metrics.denied_retries);
+
+  close(&session);
+}
+
+TEST_F(SessionUnitTest, RateLimit) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_rate_limit(20.0, 1); // A request every 50 ms
+  connect(config, &session);
+
+  uint64_t start = uv_hrtime();
+  Vector<Future::Ptr> futures;
+  for (int i = 0; i < 5; ++i) {
+    futures.push_back(session.execute(Request::ConstPtr(new QueryRequest("blah", 0))));
+  }
+
+  // Requests over the rate are delayed, not failed
+  for (Vector<Future::Ptr>::const_iterator it = futures.begin(); it != futures.end(); ++it) {
+    ASSERT_TRUE((*it)->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+    EXPECT_FALSE((*it)->error());
+  }
+  EXPECT_GE(uv_hrtime() - start, 4LL * 50LL * 1000LL * 1000LL);
+
+  close(&session);
+}
+
+TEST_F(SessionUnitTest, InflightLimitWait) {
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(mockssandra::OPCODE_QUERY)
+      .wait(100) // Keep requests in-flight
+      .system_local()
+      .system_peers()
+      .empty_rows_result(1);
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_max_inflight_requests(2);
+  config.set_backpressure_mode(CASS_BACKPRESSURE_MODE_WAIT);
+  connect(config, &session);
+
+  Vector<Future::Ptr> futures;
+  for (int i = 0; i < 6; ++i) {
+    futures.push_back(session.execute(Request::ConstPtr(new QueryRequest("blah", 0))));
+  }
+  EXPECT_EQ(4u, cass_session_get_waiting_request_count(CassSession::to(&session)));
+
+  Vector<CassRequestProcessorMetrics> metrics(config.thread_count_io());
+  EXPECT_EQ(metrics.size(), cass_session_get_request_processor_metrics(
+                                CassSession::to(&session), &metrics[0], metrics.size()));
+  cass_uint64_t inflight_requests = 0;
+  for (size_t i = 0; i < metrics.size(); ++i) {
+    inflight_requests += metrics[i].inflight_requests + metrics[i].queued_requests;
+  }
+  EXPECT_EQ(2u, inflight_requests);
+
+  // Waiting requests are started, not failed, as running requests complete
+  for (Vector<Future::Ptr>::const_iterator it = futures.begin(); it != futures.end(); ++it) {
+    ASSERT_TRUE((*it)->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+    EXPECT_FALSE((*it)->error()) << cass_error_desc((*it)->error()->code) << ": "
+                                 << (*it)->error()->message;
+  }
+  EXPECT_EQ(0u, cass_session_get_waiting_request_count(CassSession::to(&session)));
+
+  close(&session);
+}
+
+TEST_F(SessionUnitTest, RequestProcessorBatches) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  connect(config, &session);
+
+  Vector<Future::Ptr> futures;
+  for (int i = 0; i < 10; ++i) {
+    futures.push_back(session.execute(Request::ConstPtr(new QueryRequest("blah", 0))));
+  }
+  for (Vector<Future::Ptr>::const_iterator it = futures.begin(); it != futures.end(); ++it) {
+    ASSERT_TRUE((*it)->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+  }
+
+  Vector<CassRequestProcessorMetrics> metrics(config.thread_count_io());
+  EXPECT_EQ(metrics.size(), cass_session_get_request_processor_metrics(
+                                CassSession::to(&session), &metrics[0], metrics.size()));
+  cass_uint64_t batches = 0, batched_requests = 0;
+  for (size_t i = 0; i < metrics.size(); ++i) {
+    batches += metrics[i].batches;
+    batched_requests += metrics[i].batched_requests;
+  }
+  EXPECT_GE(batches, 1u);
+  EXPECT_LE(batches, 10u);
+  EXPECT_EQ(10u, batched_requests);
+
+  close(&session);
+}
+
+TEST_F(SessionUnitTest, ExecuteAll) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_thread_count_io(2);
+  connect(config, &session);
+
+  Vector<Request::ConstPtr> requests;
+  for (int i = 0; i < 10; ++i) {
+    requests.push_back(Request::ConstPtr(new QueryRequest("blah", 0)));
+  }
+  Vector<Future::Ptr> futures;
+  session.execute_all(requests, &futures);
+  ASSERT_EQ(10u, futures.size());
+  for (Vector<Future::Ptr>::const_iterator it = futures.begin(); it != futures.end(); ++it) {
+    ASSERT_TRUE((*it)->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+    EXPECT_FALSE((*it)->error()) << cass_error_desc((*it)->error()->code) << ": "
+                                 << (*it)->error()->message;
+  }
+
+  // All of the requests were enqueued to the same request processor
+  Vector<CassRequestProcessorMetrics> metrics(config.thread_count_io());
+  EXPECT_EQ(metrics.size(), cass_session_get_request_processor_metrics(
+                                CassSession::to(&session), &metrics[0], metrics.size()));
+  size_t processors_used = 0;
+  for (size_t i = 0; i < metrics.size(); ++i) {
+    if (metrics[i].batched_requests > 0) {
+      EXPECT_EQ(10u, metrics[i].batched_requests);
+      processors_used++;
+    }
+  }
+  EXPECT_EQ(1u, processors_used);
+
+  close(&session);
+}
+
+TEST_F(SessionUnitTest, ExecuteAllNotConnected) {
+  Session session;
+  Vector<Request::ConstPtr> requests(2, Request::ConstPtr(new QueryRequest("blah", 0)));
+  Vector<Future::Ptr> futures;
+  session.execute_all(requests, &futures);
+  ASSERT_EQ(2u, futures.size());
+  for (Vector<Future::Ptr>::const_iterator it = futures.begin(); it != futures.end(); ++it) {
+    ASSERT_TRUE((*it)->error());
+    EXPECT_EQ(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, (*it)->error()->code);
+  }
+}
+
+TEST_F(SessionUnitTest, ExecutionProfileHandle) {
+  mockssandra::SimpleCluster cluster(simple(), 2);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  ExecutionProfile profile;
+  profile.set_load_balancing_policy(new RoundRobinPolicy());
+  profile.whitelist().push_back("127.0.0.2");
+  config.set_execution_profile("whitelist", &profile);
+
+  Session session;
+  cass_int32_t handle = -1;
+  EXPECT_EQ(CASS_ERROR_LIB_EXECUTION_PROFILE_INVALID,
+            cass_session_get_execution_profile_handle(CassSession::to(&session), "whitelist",
+                                                      &handle)); // Not connected
+  connect(config, &session);
+
+  EXPECT_EQ(CASS_ERROR_LIB_EXECUTION_PROFILE_INVALID,
+            cass_session_get_execution_profile_handle(CassSession::to(&session), "invalid",
+                                                      &handle));
+  ASSERT_EQ(CASS_OK, cass_session_get_execution_profile_handle(CassSession::to(&session),
+                                                               "whitelist", &handle));
+  EXPECT_EQ(0, handle);
+
+  for (int i = 0; i < 4; ++i) {
+    QueryRequest::Ptr request(new QueryRequest("blah", 0));
+    request->set_execution_profile_handle(handle);
+
+    ResponseFuture::Ptr future = session.execute(Request::ConstPtr(request));
+    ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+    EXPECT_FALSE(future->error());
+    EXPECT_EQ("127.0.0.2", future->address().to_string());
+  }
+
+  { // A handle that doesn't exist
+    QueryRequest::Ptr request(new QueryRequest("blah", 0));
+    request->set_execution_profile_handle(1);
+
+    ResponseFuture::Ptr future = session.execute(Request::ConstPtr(request));
+    ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+    ASSERT_TRUE(future->error());
+    EXPECT_EQ(CASS_ERROR_LIB_EXECUTION_PROFILE_INVALID, future->error()->code);
+  }
+
+  close(&session);
+}
+
+TEST_F(SessionUnitTest, InflightLimitFail) {
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(mockssandra::OPCODE_QUERY)
+      .wait(100) // Keep requests in-flight
+      .system_local()
+      .system_peers()
+      .empty_rows_result(1);
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_max_inflight_requests(1);
+  connect(config, &session);
+
+  Future::Ptr running(session.execute(Request::ConstPtr(new QueryRequest("blah", 0))));
+  Future::Ptr rejected(session.execute(Request::ConstPtr(new QueryRequest("blah", 0))));
+
+  ASSERT_TRUE(rejected->wait_for(WAIT_FOR_TIME));
+  ASSERT_TRUE(rejected->error());
+  EXPECT_EQ(CASS_ERROR_LIB_REQUEST_QUEUE_FULL, rejected->error()->code);
+
+  ASSERT_TRUE(running->wait_for(WAIT_FOR_TIME));
+  EXPECT_FALSE(running->error());
+
+  // The slot is released once the running request completes
+  query(&session);
+
+  close(&session);
+}
+
+TEST_F(SessionUnitTest, RequestDeadline) {
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(mockssandra::OPCODE_QUERY)
+      .wait(200) // Keep requests in-flight past their deadline
+      .system_local()
+      .system_peers()
+      .empty_rows_result(1);
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  connect(&session);
+
+  { // Expired requests are never written
+    Statement::Ptr request(new QueryRequest("blah", 0));
+    request->set_deadline_ms(get_time_since_epoch_ms() - 1);
+    Future::Ptr future(session.execute(Request::ConstPtr(request)));
+    ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME));
+    ASSERT_TRUE(future->error());
+    EXPECT_EQ(CASS_ERROR_LIB_REQUEST_TIMED_OUT, future->error()->code);
+  }
+
+  { // The request timeout is shortened to the deadline
+    Statement::Ptr request(new QueryRequest("blah", 0));
+    request->set_deadline_ms(get_time_since_epoch_ms() + 50);
+    Future::Ptr future(session.execute(Request::ConstPtr(request)));
+    ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME));
+    ASSERT_TRUE(future->error());
+    EXPECT_EQ(CASS_ERROR_LIB_REQUEST_TIMED_OUT, future->error()->code);
+  }
+
+  close(&session);
+}
+
+TEST_F(SessionUnitTest, CloseTimeout) {
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(mockssandra::OPCODE_QUERY)
+      .wait(2000) // Keep requests in-flight past the close timeout
+      .system_local()
+      .system_peers()
+      .empty_rows_result(1);
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_request_timeout(0);
+  config.set_close_timeout(100);
+
+  Session session;
+  connect(config, &session);
+
+  Future::Ptr future(session.execute(Request::ConstPtr(new QueryRequest("blah", 0))));
+
+  uint64_t start = uv_hrtime();
+  close(&session);
+  EXPECT_LT(uv_hrtime() - start, 1000ULL * 1000 * 1000) << "Close didn't use the close timeout";
+
+  // The in-flight request fails once its connection is closed
+  ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME));
+  EXPECT_TRUE(future->error());
+}
+
+TEST_F(SessionUnitTest, InflightLimitCloseWithWaitingRequests) {
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(mockssandra::OPCODE_QUERY)
+      .wait(100) // Keep requests in-flight
+      .system_local()
+      .system_peers()
+      .empty_rows_result(1);
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_max_inflight_requests(1);
+  config.set_backpressure_mode(CASS_BACKPRESSURE_MODE_WAIT);
+  connect(config, &session);
+
+  Future::Ptr running(session.execute(Request::ConstPtr(new QueryRequest("blah", 0))));
+  Future::Ptr waiting(session.execute(Request::ConstPtr(new QueryRequest("blah", 0))));
+
+  close(&session);
+
+  ASSERT_TRUE(running->wait_for(WAIT_FOR_TIME));
+  EXPECT_FALSE(running->error());
+
+  ASSERT_TRUE(waiting->wait_for(WAIT_FOR_TIME));
+  ASSERT_TRUE(waiting->error());
+  EXPECT_EQ(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, waiting->error()->code);
+}
+
+TEST_F(SessionUnitTest, PagingPrefetch) {
+  Atomic<int> page_requests(0);
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(mockssandra::OPCODE_QUERY)
+      .execute(new PagedRowsResult(&page_requests))
+      .system_local()
+      .system_peers()
+      .empty_rows_result(1);
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  connect(config, &session);
+
+  Statement::Ptr request(new QueryRequest(PAGED_QUERY, 0));
+  request->set_paging_prefetch(true);
+  ResponseFuture::Ptr first(
+      static_cast<ResponseFuture*>(session.execute(Request::ConstPtr(request)).get()));
+  ASSERT_TRUE(first->wait_for(WAIT_FOR_TIME));
+  EXPECT_FALSE(first->error());
+
+  // Only a single page is prefetched until the application takes it
+  uv_sleep(200);
+  EXPECT_EQ(2, page_requests.load());
+
+  ResponseFuture::Ptr second(session.take_next_page(first.get()));
+  ASSERT_TRUE(second);
+  ASSERT_TRUE(second->wait_for(WAIT_FOR_TIME));
+  EXPECT_FALSE(second->error());
+  EXPECT_FALSE(session.take_next_page(first.get())); // Already taken
+
+  ResponseFuture::Ptr third(session.take_next_page(second.get()));
+  ASSERT_TRUE(third);
+  ASSERT_TRUE(third->wait_for(WAIT_FOR_TIME));
+  EXPECT_FALSE(third->error());
+  EXPECT_FALSE(session.take_next_page(third.get())); // Last page
+  EXPECT_EQ(PAGED_QUERY_PAGE_COUNT, page_requests.load());
+
+  close(&session);
+}
+
+TEST_F(SessionUnitTest, PagedResultIterator) {
+  Atomic<int> page_requests(0);
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(mockssandra::OPCODE_QUERY)
+      .execute(new PagedRowsResult(&page_requests))
+      .system_local()
+      .system_peers()
+      .empty_rows_result(1);
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  connect(config, &session);
+
+  Statement::Ptr request(new QueryRequest(PAGED_QUERY, 0));
+  request->set_paging_prefetch(true);
+  Future::Ptr future(session.execute(Request::ConstPtr(request)));
+
+  CassIterator* iterator =
+      cass_iterator_from_paged_future(CassSession::to(&session), CassFuture::to(future.get()));
+  ASSERT_TRUE(iterator != NULL);
+  int row_count = 0;
+  while (cass_iterator_next(iterator)) {
+    EXPECT_TRUE(cass_iterator_get_row(iterator) != NULL);
+    row_count++;
+  }
+  EXPECT_EQ(2 * PAGED_QUERY_PAGE_COUNT, row_count);
+  EXPECT_EQ(CASS_OK, cass_iterator_get_paging_error(iterator));
+  cass_iterator_free(iterator);
+
+  close(&session);
+}
+
+TEST_F(SessionUnitTest, SlowRequestLog) {
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(mockssandra::OPCODE_QUERY)
+      .system_local()
+      .system_peers()
+      .wait(100)
+      .empty_rows_result(1);
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_slow_request_log(50, 2);
+  connect(config, &session);
+
+  for (int i = 0; i < 3; ++i) {
+    Future::Ptr future(session.execute(Request::ConstPtr(new QueryRequest("blah", 0))));
+    ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+    EXPECT_FALSE(future->error());
+  }
+
+  // The requests are logged after their futures are set
+  CassSession* cass_session = CassSession::to(&session);
+  for (int i = 0; i < 100 && cass_session_get_dropped_slow_request_count(cass_session) == 0; ++i) {
+    test::Utils::msleep(10);
+  }
+  // The log only has room for the first two requests
+  EXPECT_EQ(1u, cass_session_get_dropped_slow_request_count(cass_session));
+
+  CassSlowRequest* request = cass_session_get_slow_request(cass_session);
+  ASSERT_TRUE(request != NULL);
+
+  const char* query;
+  size_t query_length;
+  cass_slow_request_query(request, &query, &query_length);
+  EXPECT_EQ(String("blah"), String(query, query_length));
+  EXPECT_EQ(CASS_OK, cass_slow_request_error_code(request));
+  EXPECT_GE(cass_slow_request_latency(request), 50000u);
+  EXPECT_GE(cass_slow_request_server_time(request), 50000u);
+  EXPECT_EQ(0u, cass_slow_request_retries(request));
+
+  CassInet coordinator;
+  ASSERT_EQ(CASS_OK, cass_slow_request_coordinator(request, &coordinator));
+  EXPECT_EQ(Address("127.0.0.1", 9042),
+            Address(coordinator.address, coordinator.address_length, 9042));
+  ASSERT_EQ(1u, cass_slow_request_attempted_host_count(request));
+  CassInet attempted;
+  EXPECT_EQ(CASS_OK, cass_slow_request_attempted_host(request, 0, &attempted));
+  EXPECT_EQ(CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS,
+            cass_slow_request_attempted_host(request, 1, &attempted));
+  cass_slow_request_free(request);
+
+  request = cass_session_get_slow_request(cass_session);
+  ASSERT_TRUE(request != NULL);
+  cass_slow_request_free(request);
+  EXPECT_TRUE(cass_session_get_slow_request(cass_session) == NULL);
+
+  close(&session);
+}
+
+struct RecordedTraceEvent {
+  CassRequestTraceEventType type;
+  cass_uint64_t request_id;
+  bool has_host;
+  CassError error_code;
+  String query;
+  void* span;
+};
+
+struct RecordedTraceEvents {
+  RecordedTraceEvents() { uv_mutex_init(&mutex); }
+  ~RecordedTraceEvents() { uv_mutex_destroy(&mutex); }
+
+  Vector<RecordedTraceEvent> copy() {
+    ScopedMutex lock(&mutex);
+    return events;
+  }
+
+  uv_mutex_t mutex;
+  Vector<RecordedTraceEvent> events;
+};
+
+static void on_request_trace_event(CassRequestTraceEvent* event, void* data) {
+  RecordedTraceEvents* recorded = static_cast<RecordedTraceEvents*>(data);
+  if (cass_request_trace_event_type(event) == CASS_REQUEST_TRACE_EVENT_START) {
+    cass_request_trace_event_set_span(event, recorded);
+  }
+
+  RecordedTraceEvent copy;
+  copy.type = cass_request_trace_event_type(event);
+  copy.request_id = cass_request_trace_event_request_id(event);
+  CassInet host;
+  copy.has_host = cass_request_trace_event_host(event, &host) == CASS_OK;
+  copy.error_code = cass_request_trace_event_error_code(event);
+  const char* query;
+  size_t query_length;
+  cass_request_trace_event_query(event, &query, &query_length);
+  copy.query = String(query, query_length);
+  copy.span = cass_request_trace_event_span(event);
+
+  ScopedMutex lock(&recorded->mutex);
+  recorded->events.push_back(copy);
+}
+
+TEST_F(SessionUnitTest, RequestTracer) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  RecordedTraceEvents recorded;
+
+  Session session;
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_request_tracer(on_request_trace_event, &recorded);
+  connect(config, &session);
+
+  Future::Ptr future(session.execute(Request::ConstPtr(new QueryRequest("blah", 0))));
+  ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+  EXPECT_FALSE(future->error());
+
+  // The request is finished after its future is set
+  for (int i = 0; i < 100 && recorded.copy().size() < 3; ++i) {
+    test::Utils::msleep(10);
+  }
+
+  Vector<RecordedTraceEvent> events(recorded.copy());
+  ASSERT_EQ(3u, events.size());
+  EXPECT_EQ(CASS_REQUEST_TRACE_EVENT_START, events[0].type);
+  EXPECT_FALSE(events[0].has_host);
+  EXPECT_EQ(String("blah"), events[0].query);
+  EXPECT_EQ(CASS_REQUEST_TRACE_EVENT_ATTEMPT, events[1].type);
+  EXPECT_TRUE(events[1].has_host);
+  EXPECT_EQ(CASS_REQUEST_TRACE_EVENT_FINISH, events[2].type);
+  EXPECT_TRUE(events[2].has_host);
+  EXPECT_EQ(CASS_OK, events[2].error_code);
+
+  for (Vector<RecordedTraceEvent>::const_iterator it = events.begin(); it != events.end(); ++it) {
+    EXPECT_EQ(events[0].request_id, it->request_id);
+    EXPECT_EQ(&recorded, it->span); // The span set when the request started
+  }
+
+  close(&session);
+}
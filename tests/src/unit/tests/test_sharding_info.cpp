@@ -0,0 +1,92 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "sharding_info.hpp"
+
+using namespace datastax;
+using namespace datastax::internal::core;
+
+namespace {
+
+StringMultimap sharded_options(const String& shards_count, const String& ignore_msb) {
+  StringMultimap options;
+  options["SCYLLA_SHARD"].push_back("1");
+  options["SCYLLA_NR_SHARDS"].push_back(shards_count);
+  options["SCYLLA_PARTITIONER"].push_back("org.apache.cassandra.dht.Murmur3Partitioner");
+  options["SCYLLA_SHARDING_ALGORITHM"].push_back("biased-token-round-robin");
+  options["SCYLLA_SHARDING_IGNORE_MSB"].push_back(ignore_msb);
+  return options;
+}
+
+} // namespace
+
+TEST(ShardingInfoUnitTest, Parse) {
+  ShardingInfo info;
+  EXPECT_FALSE(ShardingInfo::parse(StringMultimap(), &info));
+  EXPECT_FALSE(info.is_valid());
+
+  StringMultimap options(sharded_options("4", "12"));
+  ASSERT_TRUE(ShardingInfo::parse(options, &info));
+  EXPECT_TRUE(info.is_valid());
+  EXPECT_EQ(1, info.shard_id());
+  EXPECT_EQ(4, info.shards_count());
+  EXPECT_EQ(0, info.shard_aware_port());
+
+  options["SCYLLA_SHARD_AWARE_PORT"].push_back("19042");
+  ASSERT_TRUE(ShardingInfo::parse(options, &info));
+  EXPECT_EQ(19042, info.shard_aware_port());
+}
+
+TEST(ShardingInfoUnitTest, ParseInvalid) {
+  ShardingInfo info;
+  EXPECT_FALSE(ShardingInfo::parse(sharded_options("0", "12"), &info));
+  EXPECT_FALSE(ShardingInfo::parse(sharded_options("1", "12"), &info)); // Shard out of range
+  EXPECT_FALSE(ShardingInfo::parse(sharded_options("4x", "12"), &info));
+
+  StringMultimap options(sharded_options("4", "12"));
+  options["SCYLLA_PARTITIONER"].front() = "org.apache.cassandra.dht.RandomPartitioner";
+  EXPECT_FALSE(ShardingInfo::parse(options, &info));
+  EXPECT_FALSE(info.is_valid());
+}
+
+TEST(ShardingInfoUnitTest, ShardOfToken) {
+  ShardingInfo info;
+  ASSERT_TRUE(ShardingInfo::parse(sharded_options("4", "0"), &info));
+  EXPECT_EQ(0, info.shard_id(CASS_INT64_MIN));
+  EXPECT_EQ(1, info.shard_id(-1));
+  EXPECT_EQ(2, info.shard_id(0));
+  EXPECT_EQ(3, info.shard_id(CASS_INT64_MAX));
+
+  // The most significant bits of the biased token are ignored
+  ASSERT_TRUE(ShardingInfo::parse(sharded_options("4", "12"), &info));
+  EXPECT_EQ(0, info.shard_id(0));
+  EXPECT_EQ(3, info.shard_id(-1));
+}
+
+TEST(ShardingInfoUnitTest, LocalPort) {
+  ShardingInfo info;
+  ASSERT_TRUE(ShardingInfo::parse(sharded_options("12", "12"), &info));
+  for (int shard_id = 0; shard_id < 12; ++shard_id) {
+    for (int start = 0; start < 70000; start += 997) {
+      int port = info.local_port(shard_id, start);
+      EXPECT_GE(port, 49152);
+      EXPECT_LE(port, 65535);
+      EXPECT_EQ(shard_id, port % 12);
+    }
+  }
+}
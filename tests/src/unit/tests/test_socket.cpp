@@ -17,9 +17,12 @@
 #include "loop_test.hpp"
 #
 #include "connector.hpp"
+#include "serialization.hpp"
 #include "socket_connector.hpp"
 #include "ssl.hpp"
 
+#include <openssl/evp.h>
+
 #define DNS_HOSTNAME "cpp-driver.hostname."
 #define DNS_IP_ADDRESS "127.254.254.254"
 
@@ -98,6 +101,22 @@ private:
   String* result_;
 };
 
+// Records the socket's outstanding bytes after each request is written
+class OutstandingBytesSocketHandler : public TestSocketHandler {
+public:
+  OutstandingBytesSocketHandler(String* result, Vector<size_t>* outstanding_bytes)
+      : TestSocketHandler(result)
+      , outstanding_bytes_(outstanding_bytes) {}
+
+  virtual void on_write(Socket* socket, int status, SocketRequest* request) {
+    outstanding_bytes_->push_back(socket->outstanding_write_bytes());
+    TestSocketHandler::on_write(socket, status, request);
+  }
+
+private:
+  Vector<size_t>* outstanding_bytes_;
+};
+
 class SslTestSocketHandler : public SslSocketHandler {
 public:
   SslTestSocketHandler(SslSession* ssl_session, String* result)
@@ -175,6 +194,164 @@ public:
     }
   }
 
+  struct BufferSizesResult {
+    String result;
+    int receive_buffer_size;
+    int send_buffer_size;
+  };
+
+  static void on_socket_connected_buffer_sizes(SocketConnector* connector,
+                                               BufferSizesResult* result) {
+    Socket::Ptr socket = connector->release_socket();
+    if (connector->error_code() == SocketConnector::SOCKET_OK) {
+      // A size of zero gets the socket's current buffer size
+      uv_handle_t* handle = reinterpret_cast<uv_handle_t*>(socket->handle());
+      result->receive_buffer_size = 0;
+      result->send_buffer_size = 0;
+      EXPECT_EQ(0, uv_recv_buffer_size(handle, &result->receive_buffer_size));
+      EXPECT_EQ(0, uv_send_buffer_size(handle, &result->send_buffer_size));
+      socket->set_handler(new TestSocketHandler(&result->result));
+      const char* data = "The socket is successfully connected and wrote data - ";
+      socket->write(new BufferSocketRequest(Buffer(data, strlen(data))));
+      socket->write(new BufferSocketRequest(Buffer("Closed", sizeof("Closed") - 1)));
+      socket->flush();
+    } else {
+      ASSERT_TRUE(false) << "Failed to connect: " << connector->error_message();
+    }
+  }
+
+  struct OutstandingBytesResult {
+    String result;
+    size_t before_flush;
+    Vector<size_t> after_write;
+  };
+
+  static void on_socket_connected_outstanding_bytes(SocketConnector* connector,
+                                                    OutstandingBytesResult* result) {
+    Socket::Ptr socket = connector->release_socket();
+    if (connector->error_code() == SocketConnector::SOCKET_OK) {
+      socket->set_handler(new OutstandingBytesSocketHandler(&result->result, &result->after_write));
+      const char* data = "The socket is successfully connected and wrote data - ";
+      socket->write(new BufferSocketRequest(Buffer(data, strlen(data))));
+      socket->write(new BufferSocketRequest(Buffer("Closed", sizeof("Closed") - 1)));
+      result->before_flush = socket->outstanding_write_bytes();
+      socket->flush();
+    } else {
+      ASSERT_TRUE(false) << "Failed to connect: " << connector->error_message();
+    }
+  }
+
+  // Small buffers are copied into the write's staging buffer and large buffers
+  // are written directly, so interleave both
+  static String mixed_buffers_data(BufferVec* bufs) {
+    String data;
+    for (int i = 0; i < 100; ++i) {
+      OStringStream ss;
+      ss << i << ",";
+      if (i % 25 == 0) {
+        ss << String(4096, 'a' + (i / 25));
+      }
+      bufs->push_back(Buffer(ss.str().data(), ss.str().size()));
+      data.append(ss.str());
+    }
+    bufs->push_back(Buffer("Closed", sizeof("Closed") - 1));
+    data.append("Closed");
+    return data;
+  }
+
+  // Request frames are queued as many small buffers, so write more small
+  // buffers than fit in the write's staging buffer
+  static String small_buffers_data(BufferVec* bufs) {
+    String data;
+    for (int i = 0; i < 4000; ++i) {
+      OStringStream ss;
+      ss << i << "," << String(32, static_cast<char>('a' + (i % 26)));
+      bufs->push_back(Buffer(ss.str().data(), ss.str().size()));
+      data.append(ss.str());
+    }
+    bufs->push_back(Buffer("Closed", sizeof("Closed") - 1));
+    data.append("Closed");
+    return data;
+  }
+
+  static void on_socket_connected_mixed_buffers(SocketConnector* connector, String* result) {
+    write_buffers(connector, result, mixed_buffers_data);
+  }
+
+  static void on_socket_connected_small_buffers(SocketConnector* connector, String* result) {
+    write_buffers(connector, result, small_buffers_data);
+  }
+
+  static void write_buffers(SocketConnector* connector, String* result,
+                            String (*buffers_data)(BufferVec*)) {
+    Socket::Ptr socket = connector->release_socket();
+    if (connector->error_code() == SocketConnector::SOCKET_OK) {
+      if (connector->ssl_session()) {
+        socket->set_handler(new SslTestSocketHandler(connector->ssl_session().release(), result));
+      } else {
+        socket->set_handler(new TestSocketHandler(result));
+      }
+      BufferVec bufs;
+      buffers_data(&bufs);
+      for (BufferVec::const_iterator it = bufs.begin(); it != bufs.end(); ++it) {
+        socket->write(new BufferSocketRequest(*it));
+      }
+      socket->flush();
+    } else {
+      ASSERT_TRUE(false) << "Failed to connect: " << connector->error_message();
+    }
+  }
+
+  // Encrypt a TLS 1.2 application data record using the outgoing keys the
+  // way the kernel does when kernel TLS is enabled
+  static String encrypt_record(const TlsTxKeys& keys, const String& data) {
+    char nonce[12];
+    memcpy(nonce, keys.salt, sizeof(keys.salt));
+    encode_int64(nonce + sizeof(keys.salt), keys.seq);
+
+    char aad[13];
+    encode_int64(aad, keys.seq);
+    aad[8] = 23; // Application data
+    aad[9] = 3;  // TLS 1.2
+    aad[10] = 3;
+    encode_uint16(aad + 11, data.size());
+
+    String record(5 + 8 + data.size() + 16, '\0');
+    memcpy(&record[0], aad + 8, 3);
+    encode_uint16(&record[3], 8 + data.size() + 16);
+    memcpy(&record[5], nonce + sizeof(keys.salt), 8);
+
+    int len = 0;
+    unsigned char* ciphertext = reinterpret_cast<unsigned char*>(&record[13]);
+    EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+    EVP_EncryptInit_ex(ctx, keys.key_size == 16 ? EVP_aes_128_gcm() : EVP_aes_256_gcm(), NULL,
+                       keys.key, reinterpret_cast<unsigned char*>(nonce));
+    EVP_EncryptUpdate(ctx, NULL, &len, reinterpret_cast<unsigned char*>(aad), sizeof(aad));
+    EVP_EncryptUpdate(ctx, ciphertext, &len, reinterpret_cast<const unsigned char*>(data.data()),
+                      data.size());
+    EVP_EncryptFinal_ex(ctx, ciphertext + len, &len);
+    EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, 16, ciphertext + data.size());
+    EVP_CIPHER_CTX_free(ctx);
+    return record;
+  }
+
+  static void on_socket_connected_tx_keys(SocketConnector* connector, String* result) {
+    Socket::Ptr socket = connector->release_socket();
+    ASSERT_EQ(SocketConnector::SOCKET_OK, connector->error_code());
+    TlsTxKeys keys;
+    bool has_keys = connector->ssl_session()->tx_keys(&keys);
+    socket->set_handler(new SslTestSocketHandler(connector->ssl_session().release(), result));
+    if (!has_keys) {
+      ADD_FAILURE() << "Unable to get the outgoing keys";
+      socket->close();
+      return;
+    }
+    String record(encrypt_record(keys, "Encrypted outside of the SSL library - Closed"));
+    uv_buf_t buf = uv_buf_init(&record[0], record.size());
+    EXPECT_EQ(static_cast<int>(record.size()),
+              uv_try_write(reinterpret_cast<uv_stream_t*>(socket->handle()), &buf, 1));
+  }
+
   static void on_socket_refused(SocketConnector* connector, bool* is_refused) {
     if (connector->error_code() == SocketConnector::SOCKET_ERROR_CONNECT) {
       *is_refused = true;
@@ -224,6 +401,29 @@ public:
     uv_freeaddrinfo(res);
   }
 
+#ifdef HAVE_IO_URING
+  bool init_io_uring(IoUring* io_uring) {
+    int rc = io_uring->init(loop());
+    if (rc != 0) {
+      io_uring->close();
+      uv_run(loop(), UV_RUN_DEFAULT);
+      return false;
+    }
+    return true;
+  }
+
+  // The io_uring keeps the loop running so it's closed once the result has
+  // been received
+  void run_io_uring(IoUring* io_uring, const String* results, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+      while (results[i].find("Closed") == String::npos && uv_run(loop(), UV_RUN_ONCE) != 0) {
+      }
+    }
+    io_uring->close();
+    uv_run(loop(), UV_RUN_DEFAULT);
+  }
+#endif
+
 private:
   void verify_dns_check() {
     uv_getaddrinfo_t request;
@@ -249,6 +449,80 @@ TEST_F(SocketUnitTest, Simple) {
   EXPECT_EQ(result, "The socket is successfully connected and wrote data - Closed");
 }
 
+TEST_F(SocketUnitTest, OutstandingWriteBytes) {
+  listen();
+
+  OutstandingBytesResult result;
+  SocketConnector::Ptr connector(
+      new SocketConnector(Address("127.0.0.1", 8888),
+                          bind_callback(on_socket_connected_outstanding_bytes, &result)));
+
+  connector->connect(loop());
+
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  EXPECT_EQ(result.result, "The socket is successfully connected and wrote data - Closed");
+  // Unflushed requests are outstanding until they're written to the network
+  EXPECT_EQ(result.before_flush, result.result.size());
+  ASSERT_EQ(result.after_write.size(), 2u);
+  EXPECT_EQ(result.after_write[0], 0u);
+  EXPECT_EQ(result.after_write[1], 0u);
+}
+
+TEST_F(SocketUnitTest, SocketBufferSizes) {
+  listen();
+
+  SocketSettings settings;
+  settings.receive_buffer_size = 4096;
+  settings.send_buffer_size = 4096;
+
+  BufferSizesResult result;
+  SocketConnector::Ptr connector(
+      new SocketConnector(Address("127.0.0.1", 8888),
+                          bind_callback(on_socket_connected_buffer_sizes, &result)));
+
+  connector->with_settings(settings)->connect(loop());
+
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  EXPECT_EQ(result.result, "The socket is successfully connected and wrote data - Closed");
+  // Linux doubles the requested sizes to account for its bookkeeping
+  EXPECT_GT(result.receive_buffer_size, 0);
+  EXPECT_LE(result.receive_buffer_size, 2 * 4096);
+  EXPECT_GT(result.send_buffer_size, 0);
+  EXPECT_LE(result.send_buffer_size, 2 * 4096);
+}
+
+TEST_F(SocketUnitTest, MixedBufferSizes) {
+  listen();
+
+  String result;
+  SocketConnector::Ptr connector(new SocketConnector(
+      Address("127.0.0.1", 8888), bind_callback(on_socket_connected_mixed_buffers, &result)));
+
+  connector->connect(loop());
+
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  BufferVec bufs;
+  EXPECT_EQ(result, mixed_buffers_data(&bufs));
+}
+
+TEST_F(SocketUnitTest, ManySmallBuffers) {
+  listen();
+
+  String result;
+  SocketConnector::Ptr connector(new SocketConnector(
+      Address("127.0.0.1", 8888), bind_callback(on_socket_connected_small_buffers, &result)));
+
+  connector->connect(loop());
+
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  BufferVec bufs;
+  EXPECT_EQ(result, small_buffers_data(&bufs));
+}
+
 TEST_F(SocketUnitTest, SimpleDns) {
   if (!verify_dns()) return;
 
@@ -281,6 +555,223 @@ TEST_F(SocketUnitTest, Ssl) {
   EXPECT_EQ(result, "The socket is successfully connected and wrote data - Closed");
 }
 
+TEST_F(SocketUnitTest, SslSharedChunkPool) {
+  SocketSettings settings(use_ssl());
+  settings.ssl_chunk_pool.reset(new rb::ChunkPool(64 * 1024));
+
+  listen();
+
+  String result1, result2;
+  SocketConnector::Ptr connector1(new SocketConnector(
+      Address("127.0.0.1", 8888), bind_callback(on_socket_connected_mixed_buffers, &result1)));
+  SocketConnector::Ptr connector2(new SocketConnector(
+      Address("127.0.0.1", 8888), bind_callback(on_socket_connected_mixed_buffers, &result2)));
+
+  connector1->with_settings(settings)->connect(loop());
+  connector2->with_settings(settings)->connect(loop());
+
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  BufferVec bufs;
+  String expected(mixed_buffers_data(&bufs));
+  EXPECT_EQ(result1, expected);
+  EXPECT_EQ(result2, expected);
+
+  // The sessions' buffers were returned to the shared pool
+  EXPECT_GE(settings.ssl_chunk_pool->free_count(), 4u);
+}
+
+#ifdef HAVE_IO_URING
+TEST_F(SocketUnitTest, IoUring) {
+  IoUring io_uring;
+  if (!init_io_uring(&io_uring)) return; // Not supported by the kernel
+
+  listen();
+
+  SocketSettings settings;
+  settings.io_uring = &io_uring;
+
+  String results[2];
+  SocketConnector::Ptr connector1(new SocketConnector(
+      Address("127.0.0.1", 8888), bind_callback(on_socket_connected, &results[0])));
+  SocketConnector::Ptr connector2(new SocketConnector(
+      Address("127.0.0.1", 8888), bind_callback(on_socket_connected_mixed_buffers, &results[1])));
+
+  connector1->with_settings(settings)->connect(loop());
+  connector2->with_settings(settings)->connect(loop());
+
+  run_io_uring(&io_uring, results, 2);
+
+  BufferVec bufs;
+  EXPECT_EQ(results[0], "The socket is successfully connected and wrote data - Closed");
+  EXPECT_EQ(results[1], mixed_buffers_data(&bufs));
+}
+
+TEST_F(SocketUnitTest, SslIoUring) {
+  IoUring io_uring;
+  if (!init_io_uring(&io_uring)) return; // Not supported by the kernel
+
+  SocketSettings settings(use_ssl());
+  settings.io_uring = &io_uring;
+
+  listen();
+
+  String results[2];
+  SocketConnector::Ptr connector1(new SocketConnector(
+      Address("127.0.0.1", 8888), bind_callback(on_socket_connected, &results[0])));
+  SocketConnector::Ptr connector2(new SocketConnector(
+      Address("127.0.0.1", 8888), bind_callback(on_socket_connected_mixed_buffers, &results[1])));
+
+  connector1->with_settings(settings)->connect(loop());
+  connector2->with_settings(settings)->connect(loop());
+
+  run_io_uring(&io_uring, results, 2);
+
+  BufferVec bufs;
+  EXPECT_EQ(results[0], "The socket is successfully connected and wrote data - Closed");
+  EXPECT_EQ(results[1], mixed_buffers_data(&bufs));
+}
+#endif
+
+TEST_F(SocketUnitTest, SslTxKeys) {
+  SocketSettings settings(use_ssl());
+
+  listen();
+
+  String result;
+  SocketConnector::Ptr connector(new SocketConnector(
+      Address("127.0.0.1", 8888), bind_callback(on_socket_connected_tx_keys, &result)));
+
+  connector->with_settings(settings)->connect(loop());
+
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  // The server is only able to decrypt and echo the record if the keys and
+  // the sequence number are correct
+  EXPECT_EQ(result, "Encrypted outside of the SSL library - Closed");
+}
+
+TEST_F(SocketUnitTest, SslSessionResumption) {
+  SocketSettings settings(use_ssl());
+
+  listen();
+
+  for (int i = 0; i < 2; ++i) {
+    String result;
+    SocketConnector::Ptr connector(new SocketConnector(
+        Address("127.0.0.1", 8888), bind_callback(on_socket_connected_tx_keys, &result)));
+
+    connector->with_settings(settings)->connect(loop());
+
+    uv_run(loop(), UV_RUN_DEFAULT);
+
+    // The outgoing keys are also valid for resumed sessions
+    EXPECT_EQ(result, "Encrypted outside of the SSL library - Closed");
+  }
+
+  CassSslSessionMetrics metrics;
+  settings.ssl_context->session_metrics(&metrics);
+  EXPECT_EQ(1u, metrics.full_handshakes);
+  EXPECT_EQ(1u, metrics.resumed_handshakes);
+}
+
+TEST_F(SocketUnitTest, SslSessionResumptionDisabled) {
+  SocketSettings settings(use_ssl());
+  settings.ssl_context->set_session_resumption_enabled(false);
+
+  listen();
+
+  for (int i = 0; i < 2; ++i) {
+    String result;
+    SocketConnector::Ptr connector(new SocketConnector(
+        Address("127.0.0.1", 8888), bind_callback(on_socket_connected, &result)));
+
+    connector->with_settings(settings)->connect(loop());
+
+    uv_run(loop(), UV_RUN_DEFAULT);
+
+    EXPECT_EQ(result, "The socket is successfully connected and wrote data - Closed");
+  }
+
+  CassSslSessionMetrics metrics;
+  settings.ssl_context->session_metrics(&metrics);
+  EXPECT_EQ(2u, metrics.full_handshakes);
+  EXPECT_EQ(0u, metrics.resumed_handshakes);
+}
+
+TEST_F(SocketUnitTest, SslSessionResumptionSniServerNames) {
+  SocketSettings settings(use_ssl());
+
+  listen();
+
+  // The hosts behind the same SNI proxy share their sessions
+  const char* server_names[] = { "host1", "host2", "host1" };
+  for (int i = 0; i < 3; ++i) {
+    String result;
+    SocketConnector::Ptr connector(
+        new SocketConnector(Address("127.0.0.1", 8888, server_names[i]),
+                            bind_callback(on_socket_connected, &result)));
+
+    connector->with_settings(settings)->connect(loop());
+
+    uv_run(loop(), UV_RUN_DEFAULT);
+
+    EXPECT_EQ(result, "The socket is successfully connected and wrote data - Closed");
+  }
+
+  CassSslSessionMetrics metrics;
+  settings.ssl_context->session_metrics(&metrics);
+  EXPECT_EQ(1u, metrics.full_handshakes);
+  EXPECT_EQ(2u, metrics.resumed_handshakes);
+}
+
+TEST_F(SocketUnitTest, SslMaxConcurrentHandshakes) {
+  SocketSettings settings(use_ssl());
+  settings.ssl_context->set_max_concurrent_handshakes(1);
+
+  listen();
+
+  // The connections wait for the first handshake and resume its session
+  String results[4];
+  Vector<SocketConnector::Ptr> connectors;
+  for (int i = 0; i < 4; ++i) {
+    SocketConnector::Ptr connector(
+        new SocketConnector(Address("127.0.0.1", 8888, i % 2 == 0 ? "host1" : "host2"),
+                            bind_callback(on_socket_connected, &results[i])));
+    connector->with_settings(settings)->connect(loop());
+    connectors.push_back(connector);
+  }
+
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(results[i], "The socket is successfully connected and wrote data - Closed");
+  }
+
+  CassSslSessionMetrics metrics;
+  settings.ssl_context->session_metrics(&metrics);
+  EXPECT_EQ(1u, metrics.full_handshakes);
+  EXPECT_EQ(3u, metrics.resumed_handshakes);
+}
+
+TEST_F(SocketUnitTest, SslKernelTls) {
+  SocketSettings settings(use_ssl());
+  // The driver encrypts the writes if kernel TLS is unavailable
+  settings.ssl_context->set_kernel_tls_enabled(true);
+
+  listen();
+
+  String result;
+  SocketConnector::Ptr connector(
+      new SocketConnector(Address("127.0.0.1", 8888), bind_callback(on_socket_connected, &result)));
+
+  connector->with_settings(settings)->connect(loop());
+
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  EXPECT_EQ(result, "The socket is successfully connected and wrote data - Closed");
+}
+
 TEST_F(SocketUnitTest, SslSniServerName) {
   SocketSettings settings(use_ssl());
 
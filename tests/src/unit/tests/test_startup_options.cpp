@@ -162,3 +162,21 @@ TEST_F(StartupRequestUnitTest, SetClientId) {
   ASSERT_EQ(driver_name(), options["DRIVER_NAME"]);
   ASSERT_EQ(driver_version(), options["DRIVER_VERSION"]);
 }
+
+TEST_F(StartupRequestUnitTest, CompressionNotSupportedByHost) {
+  mockssandra::SimpleCluster cluster(simple_with_client_options());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  // The mock server doesn't advertise any compression algorithms so the
+  // connection should fall back to sending uncompressed frames.
+  config().set_compression(CASS_COMPRESSION_AUTO);
+  connect();
+  Map<String, String> options = client_options();
+  ASSERT_EQ(4u, options.size());
+
+  ASSERT_TRUE(options.find("COMPRESSION") == options.end());
+  ASSERT_EQ(client_id(), options["CLIENT_ID"]);
+  ASSERT_EQ(CASS_DEFAULT_CQL_VERSION, options["CQL_VERSION"]);
+  ASSERT_EQ(driver_name(), options["DRIVER_NAME"]);
+  ASSERT_EQ(driver_version(), options["DRIVER_VERSION"]);
+}
@@ -19,6 +19,7 @@
 #include "batch_request.hpp"
 #include "constants.hpp"
 #include "control_connection.hpp"
+#include "prepare_request.hpp"
 #include "query_request.hpp"
 #include "session.hpp"
 
@@ -166,3 +167,139 @@ TEST_F(StatementUnitTest, ErrorParametersUnset) {
   ASSERT_TRUE(future->error());
   EXPECT_EQ(future->error()->code, CASS_ERROR_LIB_PARAMETER_UNSET);
 }
+
+class EncodeRequestCallback : public SimpleRequestCallback {
+public:
+  EncodeRequestCallback(const RequestWrapper& wrapper)
+      : SimpleRequestCallback(wrapper) {}
+
+  String encode(ProtocolVersion version) {
+    BufferVec bufs;
+    EXPECT_GT(request()->encode(version, this, &bufs), 0);
+    String result;
+    for (BufferVec::const_iterator it = bufs.begin(), end = bufs.end(); it != end; ++it) {
+      result.append(it->data(), it->size());
+    }
+    return result;
+  }
+
+private:
+  virtual void on_internal_set(ResponseMessage* response) {}
+  virtual void on_internal_error(CassError code, const String& message) {}
+  virtual void on_internal_timeout() {}
+};
+
+TEST(StatementEncodeUnitTest, SessionKeyspace) {
+  // The session's keyspace is sent with requests when the protocol supports a
+  // per-request keyspace
+  const String keyspace("\x00\x08keyspace", 10);
+  const Request::ConstPtr requests[] = {
+    Request::ConstPtr(new QueryRequest("SELECT * FROM table")),
+    Request::ConstPtr(new BatchRequest(CASS_BATCH_TYPE_LOGGED)),
+    Request::ConstPtr(new PrepareRequest("SELECT * FROM table"))
+  };
+  for (size_t i = 0; i < sizeof(requests) / sizeof(requests[0]); ++i) {
+    RequestWrapper wrapper(requests[i]);
+    wrapper.set_keyspace("keyspace");
+    EncodeRequestCallback callback(wrapper);
+
+    String encoded(callback.encode(ProtocolVersion(CASS_PROTOCOL_VERSION_V5)));
+    EXPECT_EQ(keyspace, encoded.substr(encoded.size() - keyspace.size()));
+    encoded = callback.encode(ProtocolVersion(CASS_PROTOCOL_VERSION_V4));
+    EXPECT_EQ(String::npos, encoded.find("keyspace"));
+  }
+
+  // The statement's keyspace takes precedence
+  Statement::Ptr statement(new QueryRequest("SELECT * FROM table"));
+  statement->set_keyspace("other");
+  RequestWrapper wrapper(statement);
+  wrapper.set_keyspace("keyspace");
+  EncodeRequestCallback callback(wrapper);
+  String encoded(callback.encode(ProtocolVersion(CASS_PROTOCOL_VERSION_V5)));
+  EXPECT_EQ(String("\x00\x05other", 7), encoded.substr(encoded.size() - 7));
+}
+
+TEST(StatementEncodeUnitTest, ContinuousPaging) {
+  ContinuousPagingOptions options;
+  options.max_pages = 10;
+  options.pages_per_second = 2;
+  options.max_enqueued_pages = 4;
+
+  const String query("SELECT * FROM table");
+  RequestWrapper wrapper(Request::ConstPtr(new QueryRequest(query)));
+  wrapper.set_continuous_paging_options(options);
+  EncodeRequestCallback callback(wrapper);
+
+  // <query><consistency><flags>...<max_pages><pages_per_second>[<next_pages>]
+  const size_t flags_pos = sizeof(int32_t) + query.size() + sizeof(uint16_t);
+  String encoded(callback.encode(ProtocolVersion(CASS_PROTOCOL_VERSION_DSEV2)));
+  EXPECT_EQ('\x80', encoded[flags_pos]);
+  EXPECT_EQ(String("\x00\x00\x00\x0A\x00\x00\x00\x02\x00\x00\x00\x04", 12),
+            encoded.substr(encoded.size() - 12));
+
+  // Page credits (<next_pages>) aren't supported by DSEv1
+  String encoded_v1(callback.encode(ProtocolVersion(CASS_PROTOCOL_VERSION_DSEV1)));
+  EXPECT_EQ('\x80', encoded_v1[flags_pos]);
+  EXPECT_EQ(encoded.size() - sizeof(int32_t), encoded_v1.size());
+  EXPECT_EQ(String("\x00\x00\x00\x0A\x00\x00\x00\x02", 8),
+            encoded_v1.substr(encoded_v1.size() - 8));
+}
+
+TEST(BatchRequestUnitTest, Split) {
+  BatchRequest batch(CASS_BATCH_TYPE_UNLOGGED);
+  batch.set_consistency(CASS_CONSISTENCY_LOCAL_QUORUM);
+  batch.set_is_idempotent(true);
+  batch.set_timestamp(1234);
+  batch.set_execution_profile_name("profile");
+  batch.set_tracing(true);
+
+  BatchRequest::StatementVec statements;
+  for (int i = 0; i < 4; ++i) {
+    Statement::Ptr statement(new QueryRequest("INSERT INTO table (key) VALUES (1)"));
+    statement->set_keyspace("keyspace1");
+    batch.add_statement(statement.get());
+    if (i % 2 == 0) {
+      statements.push_back(statement);
+    }
+  }
+
+  BatchRequest::Ptr split(batch.split(statements));
+  EXPECT_EQ(CASS_BATCH_TYPE_UNLOGGED, split->type());
+  ASSERT_EQ(2u, split->statements().size());
+  EXPECT_EQ(batch.statements()[0], split->statements()[0]);
+  EXPECT_EQ(batch.statements()[2], split->statements()[1]);
+
+  // The settings are inherited from the original batch
+  EXPECT_EQ(CASS_CONSISTENCY_LOCAL_QUORUM, split->consistency());
+  EXPECT_TRUE(split->is_idempotent());
+  EXPECT_EQ(1234, split->timestamp());
+  EXPECT_EQ("profile", split->execution_profile_name());
+  EXPECT_EQ("keyspace1", split->keyspace());
+  EXPECT_EQ(batch.flags(), split->flags());
+  EXPECT_TRUE((split->flags() & CASS_FLAG_TRACING) != 0);
+}
+
+TEST(BatchRequestUnitTest, SplitBySize) {
+  BatchRequest batch(CASS_BATCH_TYPE_UNLOGGED);
+  for (int i = 0; i < 5; ++i) {
+    Statement::Ptr statement(new QueryRequest("INSERT INTO table (key) VALUES (1)"));
+    batch.add_statement(statement.get());
+  }
+
+  // The encoded size is computed as the statements are added
+  size_t size = batch.statements()[0]->encoded_batch_size();
+  EXPECT_EQ(5 * size, batch.encoded_size());
+
+  Vector<BatchRequest::Ptr> batches;
+  batch.split_by_size(2 * size, &batches);
+  ASSERT_EQ(3u, batches.size());
+  EXPECT_EQ(2u, batches[0]->statements().size());
+  EXPECT_EQ(2u, batches[1]->statements().size());
+  EXPECT_EQ(1u, batches[2]->statements().size());
+  EXPECT_EQ(batch.statements()[2], batches[1]->statements()[0]);
+
+  // Statements larger than the limit are put in batches of their own
+  batches.clear();
+  batch.split_by_size(size - 1, &batches);
+  EXPECT_EQ(5u, batches.size());
+}
@@ -0,0 +1,252 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "execute_request.hpp"
+#include "prepared.hpp"
+#include "query_request.hpp"
+#include "request_callback.hpp"
+#include "result_response.hpp"
+#include "serialization.hpp"
+#include "statement_template.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+class StatementTemplateUnitTest : public testing::Test {
+public:
+  class RequestCallback : public SimpleRequestCallback {
+  public:
+    RequestCallback(const Request::ConstPtr& request)
+        : SimpleRequestCallback(request) {}
+
+    virtual void on_internal_set(ResponseMessage* response) {}
+    virtual void on_internal_error(CassError code, const String& message) {}
+    virtual void on_internal_timeout() {}
+  };
+
+  void SetUp() {
+    prepared_ = create_prepared(false);
+    select_prepared_ = create_prepared(true);
+  }
+
+  Prepared::ConstPtr create_prepared(bool has_result_metadata) {
+    data_.clear();
+    append_int32(CASS_RESULT_KIND_PREPARED);
+    append_string("0123456789abcdef"); // Prepared ID
+    // Metadata
+    append_int32(CASS_RESULT_FLAG_GLOBAL_TABLESPEC);
+    append_int32(2); // Column count
+    append_int32(1); // Primary key count
+    append_uint16(0);
+    append_string("keyspace");
+    append_string("table");
+    append_column("key", CASS_VALUE_TYPE_INT);
+    append_column("value", CASS_VALUE_TYPE_VARCHAR);
+    // Result metadata
+    if (has_result_metadata) {
+      append_int32(CASS_RESULT_FLAG_GLOBAL_TABLESPEC);
+      append_int32(1); // Column count
+      append_string("keyspace");
+      append_string("table");
+      append_column("value", CASS_VALUE_TYPE_VARCHAR);
+    } else {
+      append_int32(CASS_RESULT_FLAG_NO_METADATA);
+      append_int32(0); // Column count
+    }
+
+    ResultResponse::Ptr result(new ResultResponse());
+    result->set_buffer(data_.size());
+    memcpy(result->buffer()->data(), data_.data(), data_.size());
+    Decoder decoder(result->data(), data_.size(), ProtocolVersion(CASS_PROTOCOL_VERSION_V4));
+    EXPECT_TRUE(result->decode(decoder));
+
+    Metadata::SchemaSnapshot schema(0, VersionNumber(),
+                                    KeyspaceMetadata::MapPtr(new KeyspaceMetadata::Map()));
+    return Prepared::ConstPtr(
+        new Prepared(result, PrepareRequest::ConstPtr(new PrepareRequest("query")), schema));
+  }
+
+  const Prepared* prepared() const { return prepared_.get(); }
+  const Prepared* select_prepared() const { return select_prepared_.get(); }
+
+  static String encode(ProtocolVersion version, const ExecuteRequest* request) {
+    SharedRefPtr<RequestCallback> callback(new RequestCallback(Request::ConstPtr(request)));
+    BufferVec bufs;
+    EXPECT_GT(request->encode(version, callback.get(), &bufs), 0);
+    String encoded;
+    for (BufferVec::const_iterator it = bufs.begin(), end = bufs.end(); it != end; ++it) {
+      encoded.append(it->data(), it->size());
+    }
+    return encoded;
+  }
+
+private:
+  void append_int32(int32_t value) {
+    char buf[sizeof(int32_t)];
+    encode_int32(buf, value);
+    data_.append(buf, sizeof(buf));
+  }
+
+  void append_uint16(uint16_t value) {
+    char buf[sizeof(uint16_t)];
+    encode_uint16(buf, value);
+    data_.append(buf, sizeof(buf));
+  }
+
+  void append_string(const String& value) {
+    append_uint16(value.size());
+    data_.append(value);
+  }
+
+  void append_column(const String& name, CassValueType type) {
+    append_string(name);
+    append_uint16(type);
+  }
+
+private:
+  String data_;
+  Prepared::ConstPtr prepared_;
+  Prepared::ConstPtr select_prepared_;
+};
+
+TEST_F(StatementTemplateUnitTest, EncodesLikeBoundStatement) {
+  SharedRefPtr<ExecuteRequest> statement(new ExecuteRequest(prepared()));
+  statement->set_consistency(CASS_CONSISTENCY_QUORUM);
+  statement->set_serial_consistency(CASS_CONSISTENCY_LOCAL_SERIAL);
+  statement->set_page_size(100);
+  statement->set_timestamp(1234);
+  statement->set(1, CassString("abc", 3));
+
+  StatementTemplate::ConstPtr statement_template(new StatementTemplate(statement.get()));
+
+  SharedRefPtr<ExecuteRequest> bound(statement_template->bind());
+  EXPECT_EQ(CASS_OK, bound->set(0, cass_int32_t(42)));
+  EXPECT_EQ(CASS_OK, statement->set(0, cass_int32_t(42)));
+
+  // The template's values are copied, but the template isn't affected by
+  // later changes to the statement.
+  EXPECT_EQ(encode(CASS_PROTOCOL_VERSION_V4, statement.get()),
+            encode(CASS_PROTOCOL_VERSION_V4, bound.get()));
+  EXPECT_EQ(encode(CASS_PROTOCOL_VERSION_V5, statement.get()),
+            encode(CASS_PROTOCOL_VERSION_V5, bound.get()));
+
+  // Patched slots
+  statement->set_timestamp(5678);
+  bound->set_timestamp(5678);
+  statement->set_consistency(CASS_CONSISTENCY_ONE);
+  bound->set_consistency(CASS_CONSISTENCY_ONE);
+  EXPECT_EQ(encode(CASS_PROTOCOL_VERSION_V4, statement.get()),
+            encode(CASS_PROTOCOL_VERSION_V4, bound.get()));
+}
+
+TEST_F(StatementTemplateUnitTest, FallsBackWhenPagingChanges) {
+  SharedRefPtr<ExecuteRequest> statement(new ExecuteRequest(prepared()));
+  statement->set(0, cass_int32_t(1));
+  statement->set(1, CassString("a", 1));
+
+  StatementTemplate::ConstPtr statement_template(new StatementTemplate(statement.get()));
+  SharedRefPtr<ExecuteRequest> bound(statement_template->bind());
+
+  statement->set_page_size(10);
+  statement->set_paging_state("state");
+  bound->set_page_size(10);
+  bound->set_paging_state("state");
+  EXPECT_EQ(encode(CASS_PROTOCOL_VERSION_V4, statement.get()),
+            encode(CASS_PROTOCOL_VERSION_V4, bound.get()));
+}
+
+TEST_F(StatementTemplateUnitTest, OnlyBoundStatements) {
+  CassStatement* statement = cass_statement_new("SELECT * FROM table", 0);
+  EXPECT_TRUE(cass_statement_template_new(statement) == NULL);
+  cass_statement_free(statement);
+
+  CassStatement* bound = cass_prepared_bind(CassPrepared::to(prepared()));
+  CassStatementTemplate* statement_template = cass_statement_template_new(bound);
+  ASSERT_TRUE(statement_template != NULL);
+  CassStatement* from_template = cass_statement_template_bind(statement_template);
+  EXPECT_TRUE(from_template != NULL);
+  cass_statement_free(from_template);
+  cass_statement_template_free(statement_template);
+  cass_statement_free(bound);
+}
+
+TEST_F(StatementTemplateUnitTest, SkipMetadataWithoutCachedEntry) {
+  // The result metadata returned when the statement was prepared is used
+  // even if the session hasn't cached an entry for the prepared ID
+  SharedRefPtr<RequestCallback> callback(
+      new RequestCallback(Request::ConstPtr(new ExecuteRequest(select_prepared()))));
+  EXPECT_FALSE(callback->prepared_metadata_entry());
+  EXPECT_TRUE(callback->skip_metadata());
+  EXPECT_EQ(select_prepared()->result().get(), callback->prepared_result());
+
+  // Statements without result metadata (e.g. INSERT) and queries can't skip it
+  SharedRefPtr<RequestCallback> insert_callback(
+      new RequestCallback(Request::ConstPtr(new ExecuteRequest(prepared()))));
+  EXPECT_FALSE(insert_callback->skip_metadata());
+
+  SharedRefPtr<RequestCallback> query_callback(
+      new RequestCallback(Request::ConstPtr(new QueryRequest("SELECT * FROM table"))));
+  EXPECT_FALSE(query_callback->skip_metadata());
+  EXPECT_TRUE(query_callback->prepared_result() == NULL);
+}
+
+TEST_F(StatementTemplateUnitTest, ReusableStatementCopies) {
+  SharedRefPtr<ExecuteRequest> statement(new ExecuteRequest(prepared()));
+  statement->set_reusable(true);
+  statement->set_consistency(CASS_CONSISTENCY_QUORUM);
+  statement->set_page_size(100);
+  statement->set(0, cass_int32_t(1));
+  statement->set(1, CassString("a", 1));
+
+  Request::ConstPtr first(statement->execution_request());
+  ASSERT_NE(static_cast<const Request*>(statement.get()), first.get());
+  const ExecuteRequest* first_copy = static_cast<const ExecuteRequest*>(first.get());
+  String encoded(encode(CASS_PROTOCOL_VERSION_V4, statement.get()));
+  EXPECT_EQ(encoded, encode(CASS_PROTOCOL_VERSION_V4, first_copy));
+
+  // Rebinding doesn't affect the in-flight copy and a new copy is used
+  statement->set(0, cass_int32_t(2));
+  Request::ConstPtr second(statement->execution_request());
+  EXPECT_NE(first.get(), second.get());
+  EXPECT_EQ(encoded, encode(CASS_PROTOCOL_VERSION_V4, first_copy));
+  EXPECT_EQ(encode(CASS_PROTOCOL_VERSION_V4, statement.get()),
+            encode(CASS_PROTOCOL_VERSION_V4, static_cast<const ExecuteRequest*>(second.get())));
+
+  // Copies are reused once their executions complete
+  const Request* released = first.get();
+  first.reset();
+  Request::ConstPtr third(statement->execution_request());
+  EXPECT_EQ(released, third.get());
+  EXPECT_EQ(encode(CASS_PROTOCOL_VERSION_V4, statement.get()),
+            encode(CASS_PROTOCOL_VERSION_V4, static_cast<const ExecuteRequest*>(third.get())));
+
+  // Statements that aren't reusable are executed as-is
+  statement->set_reusable(false);
+  EXPECT_EQ(static_cast<const Request*>(statement.get()), statement->execution_request().get());
+}
+
+TEST_F(StatementTemplateUnitTest, ReusableOnlyBoundStatements) {
+  CassStatement* statement = cass_statement_new("SELECT * FROM table", 0);
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS, cass_statement_set_reusable(statement, cass_true));
+  cass_statement_free(statement);
+
+  CassStatement* bound = cass_prepared_bind(CassPrepared::to(prepared()));
+  EXPECT_EQ(CASS_OK, cass_statement_set_reusable(bound, cass_true));
+  cass_statement_free(bound);
+}
@@ -70,3 +70,63 @@ TEST(StreamManagerUnitTest, Release) {
   // Verify there are no more streams left
   ASSERT_LT(streams.acquire(streams.max_streams()), 0);
 }
+
+TEST(StreamManagerUnitTest, GetNotPending) {
+  StreamManager<int> streams;
+
+  int item = -1;
+  EXPECT_FALSE(streams.get(0, item));
+  EXPECT_FALSE(streams.get(-1, item));
+  EXPECT_FALSE(streams.get(streams.max_streams(), item));
+
+  int stream = streams.acquire(42);
+  ASSERT_GE(stream, 0);
+  EXPECT_TRUE(streams.get(stream, item));
+  EXPECT_EQ(42, item);
+  EXPECT_EQ(1u, streams.pending_streams());
+
+  streams.release(stream);
+  EXPECT_FALSE(streams.get(stream, item));
+  EXPECT_EQ(0u, streams.pending_streams());
+  EXPECT_EQ(streams.max_streams(), streams.available_streams());
+}
+
+TEST(StreamManagerUnitTest, AcquireNearSaturation) {
+  StreamManager<int> streams;
+
+  for (size_t i = 0; i < streams.max_streams(); ++i) {
+    ASSERT_GE(streams.acquire(i), 0);
+  }
+
+  // Free streams at the beginning and the end of the ID space so that the
+  // search has to wrap around
+  streams.release(0);
+  streams.release(streams.max_streams() - 1);
+
+  int first = streams.acquire(0);
+  int second = streams.acquire(0);
+  EXPECT_TRUE((first == 0 && second == static_cast<int>(streams.max_streams() - 1)) ||
+              (second == 0 && first == static_cast<int>(streams.max_streams() - 1)));
+  EXPECT_LT(streams.acquire(0), 0);
+}
+
+TEST(StreamManagerUnitTest, GrowsWithConcurrency) {
+  StreamManager<int> streams;
+
+  // New words are only used once the words in use are full so the streams
+  // stay at the beginning of the ID space
+  int acquired[100];
+  for (int i = 0; i < 100; ++i) {
+    acquired[i] = streams.acquire(i);
+    ASSERT_GE(acquired[i], 0);
+    EXPECT_LT(acquired[i], 128);
+  }
+
+  // Released streams are reused before new words are used
+  for (int i = 0; i < 1000; ++i) {
+    streams.release(acquired[i % 100]);
+    acquired[i % 100] = streams.acquire(i);
+    ASSERT_GE(acquired[i % 100], 0);
+    EXPECT_LT(acquired[i % 100], 128);
+  }
+}
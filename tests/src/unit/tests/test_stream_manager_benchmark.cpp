@@ -0,0 +1,96 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "get_time.hpp"
+#include "stream_manager.hpp"
+
+#include <stdio.h>
+
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+// Microbenchmarks for the stream manager. These are disabled by default and
+// can be run using:
+//   cassandra-unit-tests --gtest_also_run_disabled_tests --gtest_filter='StreamManagerBenchmark.*'
+
+#define NUM_ITERATIONS (1024 * 1024)
+
+static void report(const char* name, uint64_t start) {
+  uint64_t elapsed = get_time_monotonic_ns() - start;
+  printf("%s: %.2f ns/op\n", name, static_cast<double>(elapsed) / NUM_ITERATIONS);
+}
+
+// Acquire, lookup and release a single stream on an idle connection
+TEST(StreamManagerBenchmark, DISABLED_Idle) {
+  StreamManager<int> streams;
+
+  int item = 0;
+  uint64_t start = get_time_monotonic_ns();
+  for (int i = 0; i < NUM_ITERATIONS; ++i) {
+    int stream = streams.acquire(i);
+    streams.get(stream, item);
+    streams.release(stream);
+  }
+  report("Idle", start);
+  EXPECT_EQ(0u, streams.pending_streams());
+}
+
+// Acquire, lookup and release a stream on a connection with a single free
+// stream
+TEST(StreamManagerBenchmark, DISABLED_Saturated) {
+  StreamManager<int> streams;
+
+  for (size_t i = 0; i < streams.max_streams(); ++i) {
+    streams.acquire(i);
+  }
+
+  int item = 0;
+  int stream = static_cast<int>(streams.max_streams() / 2);
+  streams.release(stream);
+  uint64_t start = get_time_monotonic_ns();
+  for (int i = 0; i < NUM_ITERATIONS; ++i) {
+    stream = streams.acquire(i);
+    streams.get(stream, item);
+    streams.release(stream);
+  }
+  report("Saturated", start);
+  EXPECT_EQ(streams.max_streams() - 1, streams.pending_streams());
+}
+
+// Keep roughly half of the streams in flight, releasing the oldest stream
+// after each acquire
+TEST(StreamManagerBenchmark, DISABLED_HalfFull) {
+  StreamManager<int> streams;
+
+  const size_t in_flight = streams.max_streams() / 2;
+  Vector<int> pending(in_flight);
+  for (size_t i = 0; i < in_flight; ++i) {
+    pending[i] = streams.acquire(i);
+  }
+
+  int item = 0;
+  uint64_t start = get_time_monotonic_ns();
+  for (int i = 0; i < NUM_ITERATIONS; ++i) {
+    size_t index = i % in_flight;
+    streams.get(pending[index], item);
+    streams.release(pending[index]);
+    pending[index] = streams.acquire(i);
+  }
+  report("HalfFull", start);
+  EXPECT_EQ(in_flight, streams.pending_streams());
+}
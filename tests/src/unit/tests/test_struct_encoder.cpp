@@ -0,0 +1,143 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "collection.hpp"
+#include "struct_encoder.hpp"
+#include "user_type_value.hpp"
+
+#include <stddef.h>
+#include <string.h>
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+namespace {
+
+struct StreetAddress {
+  cass_int32_t number;
+  const char* street;
+  cass_bool_t verified;
+  cass_int64_t updated_at;
+  double latitude;
+};
+
+CassDataType* create_address_type() {
+  CassDataType* data_type = cass_data_type_new_udt(6);
+  cass_data_type_add_sub_value_type_by_name(data_type, "number", CASS_VALUE_TYPE_INT);
+  cass_data_type_add_sub_value_type_by_name(data_type, "street", CASS_VALUE_TYPE_TEXT);
+  cass_data_type_add_sub_value_type_by_name(data_type, "verified", CASS_VALUE_TYPE_BOOLEAN);
+  cass_data_type_add_sub_value_type_by_name(data_type, "updated_at", CASS_VALUE_TYPE_TIMESTAMP);
+  cass_data_type_add_sub_value_type_by_name(data_type, "latitude", CASS_VALUE_TYPE_DOUBLE);
+  cass_data_type_add_sub_value_type_by_name(data_type, "zip", CASS_VALUE_TYPE_BLOB);
+  return data_type;
+}
+
+CassStructEncoder* create_address_encoder(const CassDataType* data_type) {
+  CassStructEncoder* encoder = cass_struct_encoder_new(data_type);
+  EXPECT_EQ(CASS_OK,
+            cass_struct_encoder_set_field_by_name(encoder, "number", offsetof(StreetAddress, number)));
+  EXPECT_EQ(CASS_OK,
+            cass_struct_encoder_set_field_by_name(encoder, "street", offsetof(StreetAddress, street)));
+  EXPECT_EQ(CASS_OK, cass_struct_encoder_set_field_by_name(encoder, "verified",
+                                                          offsetof(StreetAddress, verified)));
+  EXPECT_EQ(CASS_OK, cass_struct_encoder_set_field_by_name(encoder, "updated_at",
+                                                          offsetof(StreetAddress, updated_at)));
+  EXPECT_EQ(CASS_OK, cass_struct_encoder_set_field_by_name(encoder, "latitude",
+                                                          offsetof(StreetAddress, latitude)));
+  return encoder;
+}
+
+void expect_equal(const Buffer& expected, const Buffer& actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+  EXPECT_EQ(0, memcmp(expected.data(), actual.data(), actual.size()));
+}
+
+} // namespace
+
+TEST(StructEncoderUnitTest, MatchesUserType) {
+  CassDataType* data_type = create_address_type();
+  CassStructEncoder* encoder = create_address_encoder(data_type);
+
+  StreetAddress addresses[] = { { 42, "Main Street", cass_true, 1234567890123LL, 47.6 },
+                          { 7, NULL, cass_false, -1, -122.3 } };
+
+  for (size_t i = 0; i < 2; ++i) {
+    const StreetAddress& address = addresses[i];
+    CassUserType* user_type = cass_user_type_new_from_data_type(data_type);
+    cass_user_type_set_int32_by_name(user_type, "number", address.number);
+    if (address.street) {
+      cass_user_type_set_string_by_name(user_type, "street", address.street);
+    } else {
+      cass_user_type_set_null_by_name(user_type, "street");
+    }
+    cass_user_type_set_bool_by_name(user_type, "verified", address.verified);
+    cass_user_type_set_int64_by_name(user_type, "updated_at", address.updated_at);
+    cass_user_type_set_double_by_name(user_type, "latitude", address.latitude);
+    cass_user_type_set_null_by_name(user_type, "zip");
+
+    expect_equal(user_type->from()->encode_with_length(),
+                 encoder->from()->encode_with_length(&address));
+    cass_user_type_free(user_type);
+  }
+
+  cass_struct_encoder_free(encoder);
+  cass_data_type_free(data_type);
+}
+
+TEST(StructEncoderUnitTest, InvalidFields) {
+  CassDataType* data_type = create_address_type();
+  CassStructEncoder* encoder = cass_struct_encoder_new(data_type);
+
+  EXPECT_EQ(CASS_ERROR_LIB_INVALID_VALUE_TYPE, cass_struct_encoder_set_field(encoder, 5, 0));
+  EXPECT_EQ(CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS, cass_struct_encoder_set_field(encoder, 6, 0));
+  EXPECT_EQ(CASS_ERROR_LIB_NAME_DOES_NOT_EXIST,
+            cass_struct_encoder_set_field_by_name(encoder, "does_not_exist", 0));
+
+  CassDataType* list_type = cass_data_type_new(CASS_VALUE_TYPE_LIST);
+  EXPECT_TRUE(cass_struct_encoder_new(list_type) == NULL);
+
+  cass_data_type_free(list_type);
+  cass_struct_encoder_free(encoder);
+  cass_data_type_free(data_type);
+}
+
+TEST(StructEncoderUnitTest, CollectionAppendArray) {
+  CassDataType* data_type = create_address_type();
+  CassStructEncoder* encoder = create_address_encoder(data_type);
+
+  StreetAddress addresses[] = { { 1, "First", cass_true, 1, 1.0 },
+                          { 2, "Second", cass_false, 2, 2.0 },
+                          { 3, NULL, cass_true, 3, 3.0 } };
+
+  Collection expected(CASS_COLLECTION_TYPE_LIST, 3);
+  for (size_t i = 0; i < 3; ++i) {
+    ASSERT_EQ(CASS_OK, cass_collection_append_struct(CassCollection::to(&expected), encoder,
+                                                     &addresses[i]));
+  }
+
+  Collection actual(CASS_COLLECTION_TYPE_LIST, 3);
+  ASSERT_EQ(CASS_OK, cass_collection_append_struct_array(CassCollection::to(&actual), encoder,
+                                                         addresses, sizeof(StreetAddress), 3));
+
+  EXPECT_EQ(3u, actual.item_count());
+  expect_equal(expected.encode_with_length(), actual.encode_with_length());
+
+  cass_struct_encoder_free(encoder);
+  cass_data_type_free(data_type);
+}
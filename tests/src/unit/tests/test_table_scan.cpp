@@ -0,0 +1,59 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "table_scan.hpp"
+
+using namespace datastax;
+using namespace datastax::internal::core;
+
+TEST(TableScanUnitTest, BuildQuery) {
+  StringVec partition_key;
+  partition_key.push_back("key");
+  CopyOnWriteHostVec replicas(new HostVec());
+
+  EXPECT_EQ("SELECT * FROM ks.tbl WHERE token(key) <= -100",
+            TableScan::build_query("ks", "tbl", "*", partition_key,
+                                   TokenRange("", "-100", replicas)));
+  EXPECT_EQ("SELECT * FROM ks.tbl WHERE token(key) > -100 AND token(key) <= 100",
+            TableScan::build_query("ks", "tbl", "*", partition_key,
+                                   TokenRange("-100", "100", replicas)));
+  EXPECT_EQ("SELECT * FROM ks.tbl WHERE token(key) > 100",
+            TableScan::build_query("ks", "tbl", "*", partition_key,
+                                   TokenRange("100", "", replicas)));
+
+  // Composite partition keys and names that need to be quoted
+  partition_key.push_back("Key2");
+  EXPECT_EQ("SELECT a, b FROM \"Ks\".tbl WHERE token(key, \"Key2\") > 1 AND "
+            "token(key, \"Key2\") <= 2",
+            TableScan::build_query("Ks", "tbl", "a, b", partition_key,
+                                   TokenRange("1", "2", replicas)));
+}
+
+TEST(TableScanUnitTest, Settings) {
+  TableScan::Ptr scan(new TableScan("ks", "tbl"));
+  EXPECT_EQ(CASS_OK, scan->set_columns("a, b"));
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS, scan->set_columns(""));
+  EXPECT_EQ(CASS_OK, scan->set_concurrency(8));
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS, scan->set_concurrency(0));
+  EXPECT_EQ(CASS_OK, scan->set_paging_size(100));
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS, scan->set_paging_size(0));
+
+  // A scan that was never started has no pages
+  EXPECT_FALSE(scan->next_page());
+  EXPECT_EQ(CASS_OK, scan->error_code());
+}
@@ -0,0 +1,165 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "loop_test.hpp"
+
+#include "scoped_ptr.hpp"
+#include "timer_wheel.hpp"
+#include "vector.hpp"
+
+using datastax::internal::bind_callback;
+using datastax::internal::ScopedPtr;
+using datastax::internal::Vector;
+using datastax::internal::core::TimerWheel;
+using datastax::internal::core::WheelTimer;
+
+class TimerWheelUnitTest : public LoopTest {
+public:
+  TimerWheelUnitTest()
+      : other_timer_(NULL)
+      , restart_count_(0) {}
+
+  WheelTimer::Callback callback() { return bind_callback(&TimerWheelUnitTest::on_timer, this); }
+
+  WheelTimer::Callback stop_other_callback() {
+    return bind_callback(&TimerWheelUnitTest::on_timer_stop_other, this);
+  }
+
+  void on_timer(WheelTimer* timer) {
+    EXPECT_FALSE(timer->is_running());
+    fired_.push_back(timer);
+  }
+
+  void on_timer_stop_other(WheelTimer* timer) {
+    EXPECT_TRUE(other_timer_->is_running());
+    other_timer_->stop();
+  }
+
+  void on_timer_restart(WheelTimer* timer) {
+    if (++restart_count_ < 10) {
+      timer->start(wheel_.get(), 1, bind_callback(&TimerWheelUnitTest::on_timer_restart, this));
+    }
+  }
+
+protected:
+  virtual void SetUp() {
+    LoopTest::SetUp();
+    wheel_.reset(new TimerWheel(loop()));
+  }
+
+  virtual void TearDown() {
+    wheel_->close();
+    wheel_.reset();
+    LoopTest::TearDown();
+  }
+
+  ScopedPtr<TimerWheel> wheel_;
+  Vector<WheelTimer*> fired_;
+  WheelTimer* other_timer_;
+  int restart_count_;
+};
+
+TEST_F(TimerWheelUnitTest, Once) {
+  WheelTimer timer;
+
+  uint64_t start = uv_now(loop());
+  timer.start(wheel_.get(), 10, callback());
+  EXPECT_TRUE(timer.is_running());
+  EXPECT_EQ(1u, wheel_->size());
+
+  run_loop();
+
+  EXPECT_FALSE(timer.is_running());
+  EXPECT_EQ(0u, wheel_->size());
+  ASSERT_EQ(1u, fired_.size());
+  EXPECT_GE(uv_now(loop()) - start, 10u);
+}
+
+TEST_F(TimerWheelUnitTest, Order) {
+  // The longer timeouts are in the higher levels and have to be cascaded
+  WheelTimer timers[5];
+  uint64_t timeouts[] = { 600, 0, 300, 5, 257 };
+  for (int i = 0; i < 5; ++i) {
+    timers[i].start(wheel_.get(), timeouts[i], callback());
+  }
+
+  uint64_t start = uv_now(loop());
+  run_loop();
+
+  EXPECT_GE(uv_now(loop()) - start, 600u);
+  ASSERT_EQ(5u, fired_.size());
+  EXPECT_EQ(&timers[1], fired_[0]);
+  EXPECT_EQ(&timers[3], fired_[1]);
+  EXPECT_EQ(&timers[4], fired_[2]);
+  EXPECT_EQ(&timers[2], fired_[3]);
+  EXPECT_EQ(&timers[0], fired_[4]);
+}
+
+TEST_F(TimerWheelUnitTest, MaxTimeout) {
+  // The expiration time of the maximum timeout doesn't wrap around so the
+  // timer is still running when a shorter timer fires
+  WheelTimer timer, check_timer;
+  timer.start(wheel_.get(), CASS_UINT64_MAX, callback());
+  other_timer_ = &timer;
+  check_timer.start(wheel_.get(), 10, stop_other_callback());
+
+  run_loop();
+
+  EXPECT_FALSE(timer.is_running());
+  EXPECT_TRUE(fired_.empty());
+}
+
+TEST_F(TimerWheelUnitTest, Stop) {
+  WheelTimer timer1, timer2;
+
+  timer1.start(wheel_.get(), 1, callback());
+  timer2.start(wheel_.get(), 300, callback());
+  EXPECT_EQ(2u, wheel_->size());
+
+  timer2.stop();
+  EXPECT_FALSE(timer2.is_running());
+  EXPECT_EQ(1u, wheel_->size());
+
+  run_loop();
+
+  ASSERT_EQ(1u, fired_.size());
+  EXPECT_EQ(&timer1, fired_[0]);
+}
+
+TEST_F(TimerWheelUnitTest, Restart) {
+  WheelTimer timer;
+
+  on_timer_restart(&timer);
+
+  run_loop();
+
+  EXPECT_FALSE(timer.is_running());
+  EXPECT_EQ(10, restart_count_);
+}
+
+TEST_F(TimerWheelUnitTest, Close) {
+  { // A timer that outlives the wheel is detached from it
+    WheelTimer timer;
+    timer.start(wheel_.get(), 1000, callback());
+    wheel_->close();
+    wheel_.reset(new TimerWheel(loop()));
+    EXPECT_FALSE(timer.is_running());
+  }
+
+  run_loop();
+
+  EXPECT_TRUE(fired_.empty());
+}
@@ -19,6 +19,7 @@
 #include "get_time.hpp"
 #include "timestamp_generator.hpp"
 
+#include <algorithm>
 #include <utility>
 
 using namespace datastax;
@@ -111,3 +112,61 @@ TEST_F(TimestampGenUnitTest, MonotonicWarningInterval) {
   // it had a shorter interval.
   EXPECT_GT(warn_count_100ms, warn_count_1000ms);
 }
+
+namespace {
+
+struct PerThreadArgs {
+  PerThreadMonotonicTimestampGenerator* gen;
+  Vector<int64_t> timestamps;
+};
+
+void generate_timestamps(void* arg) {
+  PerThreadArgs* args = static_cast<PerThreadArgs*>(arg);
+  for (size_t i = 0; i < args->timestamps.size(); ++i) {
+    args->timestamps[i] = args->gen->next();
+  }
+}
+
+} // namespace
+
+TEST_F(TimestampGenUnitTest, PerThreadMonotonic) {
+  PerThreadMonotonicTimestampGenerator gen(2);
+  EXPECT_EQ(4u, gen.lane_count());
+
+  int64_t prev = gen.next();
+  int64_t lane = prev & 3;
+  for (int i = 0; i < 100; ++i) {
+    int64_t now = gen.next();
+    EXPECT_GT(now, prev);
+    EXPECT_EQ(lane, now & 3); // The thread stays in its lane
+    prev = now;
+  }
+}
+
+TEST_F(TimestampGenUnitTest, PerThreadMonotonicUnique) {
+  const size_t num_threads = 8; // More threads than lanes
+  const size_t num_timestamps = 10000;
+
+  PerThreadMonotonicTimestampGenerator gen(2);
+
+  uv_thread_t threads[num_threads];
+  PerThreadArgs args[num_threads];
+  for (size_t i = 0; i < num_threads; ++i) {
+    args[i].gen = &gen;
+    args[i].timestamps.resize(num_timestamps);
+    ASSERT_EQ(0, uv_thread_create(&threads[i], generate_timestamps, &args[i]));
+  }
+
+  Vector<int64_t> all;
+  for (size_t i = 0; i < num_threads; ++i) {
+    uv_thread_join(&threads[i]);
+    const Vector<int64_t>& timestamps = args[i].timestamps;
+    for (size_t j = 1; j < timestamps.size(); ++j) {
+      EXPECT_GT(timestamps[j], timestamps[j - 1]);
+    }
+    all.insert(all.end(), timestamps.begin(), timestamps.end());
+  }
+
+  std::sort(all.begin(), all.end());
+  EXPECT_TRUE(std::adjacent_find(all.begin(), all.end()) == all.end());
+}
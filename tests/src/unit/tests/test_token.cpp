@@ -356,6 +356,18 @@ TEST(TokenUnitTest, RandomHash) {
   EXPECT_EQ(to_string(RandomPartitioner::hash("xyz")), "61893731502141497228477852773302439842");
 }
 
+TEST(TokenUnitTest, RandomHashBatch) {
+  Vector<String> keys;
+  for (size_t i = 0; i < 70; ++i) {
+    keys.push_back(String(i, 'k'));
+  }
+  Vector<RandomPartitioner::Token> tokens(keys.size());
+  RandomPartitioner::hash_batch(keys, &tokens[0]);
+  for (size_t i = 0; i < keys.size(); ++i) {
+    EXPECT_EQ(RandomPartitioner::hash(keys[i]), tokens[i]);
+  }
+}
+
 TEST(TokenUnitTest, RandomFromString) {
   EXPECT_EQ(to_string(RandomPartitioner::from_string("0")), "0");
   EXPECT_EQ(to_string(RandomPartitioner::from_string("1")), "1");
@@ -364,3 +376,97 @@ TEST(TokenUnitTest, RandomFromString) {
   EXPECT_EQ(to_string(RandomPartitioner::from_string("170141183460469231731687303715884105728")),
             "170141183460469231731687303715884105728");
 }
+
+TEST(TokenUnitTest, ToCql) {
+  EXPECT_EQ("-9223372036854775808", Murmur3Partitioner::to_cql(CASS_INT64_MIN));
+  EXPECT_EQ("42", Murmur3Partitioner::to_cql(42));
+
+  const char* random_tokens[] = { "0", "9", "10", "18446744073709551615", "18446744073709551616",
+                                  "170141183460469231731687303715884105728",
+                                  "340282366920938463463374607431768211455" };
+  for (size_t i = 0; i < sizeof(random_tokens) / sizeof(random_tokens[0]); ++i) {
+    EXPECT_EQ(random_tokens[i],
+              RandomPartitioner::to_cql(RandomPartitioner::from_string(random_tokens[i])));
+  }
+
+  const uint8_t bytes[] = { 0x00, 0x7f, 0xab, 0xff };
+  EXPECT_EQ("0x007fabff",
+            ByteOrderedPartitioner::to_cql(ByteOrderedPartitioner::Token(bytes, bytes + 4)));
+  EXPECT_EQ("0x", ByteOrderedPartitioner::to_cql(ByteOrderedPartitioner::Token()));
+}
+
+TEST(TokenUnitTest, Murmur3FromString) {
+  EXPECT_EQ(0, Murmur3Partitioner::from_string("0"));
+  EXPECT_EQ(-1, Murmur3Partitioner::from_string("-1"));
+  EXPECT_EQ(12345678, Murmur3Partitioner::from_string("12345678"));
+  EXPECT_EQ(-123456789, Murmur3Partitioner::from_string(" -123456789"));
+  EXPECT_EQ(1234567812345678LL, Murmur3Partitioner::from_string("1234567812345678"));
+  EXPECT_EQ(CASS_INT64_MAX, Murmur3Partitioner::from_string("9223372036854775807"));
+  EXPECT_EQ(CASS_INT64_MIN, Murmur3Partitioner::from_string("-9223372036854775808"));
+  EXPECT_EQ(1234567, Murmur3Partitioner::from_string("1234567x89"));
+
+  char buf[32];
+  uint64_t state = 1;
+  for (int i = 0; i < 1000; ++i) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    int64_t token = static_cast<int64_t>(state);
+    sprintf(buf, "%lld", static_cast<long long>(token));
+    EXPECT_EQ(token, Murmur3Partitioner::from_string(buf));
+  }
+}
+
+TEST(TokenUnitTest, Murmur3RadixSort) {
+  typedef std::pair<int64_t, Host*> TokenHost;
+  Vector<TokenHost> tokens;
+  uint64_t state = 1;
+  for (int i = 0; i < 10000; ++i) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    int64_t token = static_cast<int64_t>(state);
+    tokens.push_back(TokenHost(i % 7 == 0 ? token >> 40 : token, NULL));
+  }
+  tokens.push_back(TokenHost(CASS_INT64_MIN, NULL));
+  tokens.push_back(TokenHost(CASS_INT64_MAX, NULL));
+
+  Vector<TokenHost> expected(tokens);
+  std::sort(expected.begin(), expected.end());
+  sort_tokens(tokens);
+  EXPECT_TRUE(expected == tokens);
+}
+
+TEST(TokenUnitTest, ByteOrderedCompare) {
+  // Tokens shorter and longer than the prefix and the inline storage, with
+  // zero bytes that would be confused with the prefix's padding
+  const char* values[] = { "",
+                           "\0",
+                           "a",
+                           "a\0",
+                           "abcdefgh",
+                           "abcdefgh\0",
+                           "abcdefghi",
+                           "abcdefghij",
+                           "abcdefghijklmnopqrstuvwxyz",
+                           "abcdefghijklmnopqrstuvwxy\0",
+                           "abcdefghijklmnopqrstuvwxyzz",
+                           "b" };
+  const size_t sizes[] = { 0, 1, 1, 2, 8, 9, 9, 10, 26, 26, 27, 1 };
+  const size_t count = sizeof(sizes) / sizeof(sizes[0]);
+
+  for (size_t i = 0; i < count; ++i) {
+    const uint8_t* lhs_data = reinterpret_cast<const uint8_t*>(values[i]);
+    ByteOrderedPartitioner::Token lhs(lhs_data, lhs_data + sizes[i]);
+    ByteOrderedPartitioner::Token copy;
+    copy = lhs;
+    EXPECT_TRUE(copy == lhs);
+    EXPECT_EQ(std::string(values[i], sizes[i]),
+              std::string(reinterpret_cast<const char*>(copy.data()), copy.size()));
+
+    for (size_t j = 0; j < count; ++j) {
+      const uint8_t* rhs_data = reinterpret_cast<const uint8_t*>(values[j]);
+      ByteOrderedPartitioner::Token rhs(rhs_data, rhs_data + sizes[j]);
+      std::string lhs_str(values[i], sizes[i]);
+      std::string rhs_str(values[j], sizes[j]);
+      EXPECT_EQ(lhs_str < rhs_str, lhs < rhs) << i << " < " << j;
+      EXPECT_EQ(lhs_str == rhs_str, lhs == rhs) << i << " == " << j;
+    }
+  }
+}
@@ -492,3 +492,385 @@ TEST(TokenMapUnitTest, UniqueReplicas) {
   test_murmur3.build();
   test_murmur3.verify();
 }
+
+TEST(TokenMapUnitTest, SharedReplicationStrategies) {
+  TestTokenMap<Murmur3Partitioner> test_murmur3;
+
+  // Enough tokens for the distinct strategies to be built on multiple threads
+  const size_t num_hosts = 8;
+  const size_t tokens_per_host = 512;
+  MT19937_64 rng;
+
+  Vector<Host::Ptr> hosts;
+  for (size_t i = 1; i <= num_hosts; ++i) {
+    char ip[32];
+    sprintf(ip, "127.0.0.%d", (int)i);
+    char rack[32];
+    sprintf(rack, "rack%d", (int)(i % 2) + 1);
+    hosts.push_back(create_host(ip, random_murmur3_tokens(rng, tokens_per_host),
+                                Murmur3Partitioner::name().to_string(), rack, "dc1"));
+    test_murmur3.add_host(hosts.back());
+  }
+
+  ReplicationMap replication;
+  replication["dc1"] = "2";
+
+  // Many keyspaces sharing a few distinct replication strategies
+  TokenMap* token_map = test_murmur3.token_map.get();
+  for (int i = 0; i < 4; ++i) {
+    char name[32];
+    sprintf(name, "simple1_%d", i);
+    add_keyspace_simple(name, 1, token_map);
+    sprintf(name, "simple3_%d", i);
+    add_keyspace_simple(name, 3, token_map);
+    sprintf(name, "nts_%d", i);
+    add_keyspace_network_topology(name, replication, token_map);
+  }
+  token_map->build();
+
+  // Build each distinct strategy on its own for comparison
+  const char* keyspaces[] = { "simple1", "simple3", "nts" };
+  for (size_t i = 0; i < sizeof(keyspaces) / sizeof(keyspaces[0]); ++i) {
+    TokenMap::Ptr expected(TokenMap::from_partitioner(Murmur3Partitioner::name()));
+    for (Vector<Host::Ptr>::const_iterator it = hosts.begin(), end = hosts.end(); it != end;
+         ++it) {
+      expected->add_host(*it);
+    }
+    if (i == 2) {
+      add_keyspace_network_topology(keyspaces[i], replication, expected.get());
+    } else {
+      add_keyspace_simple(keyspaces[i], i == 0 ? 1 : 3, expected.get());
+    }
+    expected->build();
+
+    for (int j = 0; j < 4; ++j) {
+      char name[32];
+      sprintf(name, "%s_%d", keyspaces[i], j);
+      EXPECT_EQ(expected->dump(keyspaces[i]), token_map->dump(name));
+    }
+  }
+
+  test_murmur3.verify_unique_replica_count("simple3_0", 3);
+  test_murmur3.verify_unique_replica_count("nts_3", 2);
+}
+
+TEST(TokenMapUnitTest, SharedReplicaVectors) {
+  TestTokenMap<Murmur3Partitioner> test_murmur3;
+
+  test_murmur3.add_host(create_host("1.0.0.1", single_token(CASS_INT64_MIN / 2)));
+  test_murmur3.add_host(create_host("1.0.0.2", single_token(0)));
+  test_murmur3.add_host(create_host("1.0.0.3", single_token(CASS_INT64_MAX / 2)));
+
+  TokenMap* token_map = test_murmur3.token_map.get();
+  add_keyspace_simple("ks1", 2, token_map);
+  add_keyspace_simple("ks2", 2, token_map);
+  add_keyspace_simple("ks3", 3, token_map);
+  token_map->build();
+
+  TokenMapImpl<Murmur3Partitioner>* impl =
+      static_cast<TokenMapImpl<Murmur3Partitioner>*>(test_murmur3.token_map.get());
+  EXPECT_EQ(&impl->token_replicas("ks1"), &impl->token_replicas("ks2"));
+  EXPECT_NE(&impl->token_replicas("ks1"), &impl->token_replicas("ks3"));
+
+  TokenMapMetrics metrics;
+  token_map->get_metrics(&metrics);
+  EXPECT_EQ(3u, metrics.keyspaces);
+  EXPECT_EQ(2u, metrics.replica_vectors);
+  EXPECT_EQ(3u, metrics.tokens);
+  EXPECT_GT(metrics.memory_bytes, 0u);
+
+  // A keyspace updated with existing replication settings is interned
+  {
+    DataType::ConstPtr varchar_data_type(new DataType(CASS_VALUE_TYPE_VARCHAR));
+    ColumnMetadataVec column_metadata;
+    column_metadata.push_back(ColumnMetadata("keyspace_name", varchar_data_type));
+    column_metadata.push_back(ColumnMetadata(
+        "replication", CollectionType::map(varchar_data_type, varchar_data_type, true)));
+    RowResultResponseBuilder builder(column_metadata);
+    ReplicationMap replication;
+    replication["class"] = CASS_SIMPLE_STRATEGY;
+    replication["replication_factor"] = "3";
+    builder.append_keyspace_row_v3("ks4", replication);
+    token_map->update_keyspaces_and_build(VersionNumber(3, 0, 0), builder.finish());
+  }
+  EXPECT_EQ(&impl->token_replicas("ks3"), &impl->token_replicas("ks4"));
+
+  token_map->get_metrics(&metrics);
+  EXPECT_EQ(4u, metrics.keyspaces);
+  EXPECT_EQ(2u, metrics.replica_vectors);
+
+  test_murmur3.verify("ks4", 3);
+}
+
+namespace {
+
+struct HostSpec {
+  HostSpec(const String& address, const TokenVec& tokens, const String& rack, const String& dc)
+      : address(address)
+      , tokens(tokens)
+      , rack(rack)
+      , dc(dc) {}
+
+  Host::Ptr create() const {
+    return create_host(address, tokens, Murmur3Partitioner::name().to_string(), rack, dc);
+  }
+
+  String address;
+  TokenVec tokens;
+  String rack;
+  String dc;
+};
+
+typedef Vector<HostSpec> HostSpecVec;
+
+// A synthetic ring with hosts spread evenly over datacenters and racks
+HostSpecVec create_ring(MT19937_64& rng, size_t num_hosts, size_t num_dcs, size_t num_racks,
+                        size_t tokens_per_host) {
+  HostSpecVec specs;
+  for (size_t i = 0; i < num_hosts; ++i) {
+    char ip[32];
+    sprintf(ip, "127.%d.%d.%d", (int)((i + 1) >> 16) & 0xFF, (int)((i + 1) >> 8) & 0xFF,
+            (int)(i + 1) & 0xFF);
+    char rack[32];
+    sprintf(rack, "rack%d", (int)((i / num_dcs) % num_racks) + 1);
+    char dc[32];
+    sprintf(dc, "dc%d", (int)(i % num_dcs) + 1);
+    specs.push_back(HostSpec(ip, random_murmur3_tokens(rng, tokens_per_host), rack, dc));
+  }
+  return specs;
+}
+
+void add_ring_keyspaces(TokenMap* token_map) {
+  add_keyspace_simple("simple", 3, token_map);
+  ReplicationMap replication;
+  replication["dc1"] = "3";
+  replication["dc2"] = "2";
+  add_keyspace_network_topology("nts", replication, token_map);
+}
+
+// Hosts are created again for the expected token map because adding a host to
+// a token map assigns its datacenter and rack IDs.
+TokenMap::Ptr build_ring(const HostSpecVec& specs) {
+  TokenMap::Ptr token_map(TokenMap::from_partitioner(Murmur3Partitioner::name()));
+  for (HostSpecVec::const_iterator i = specs.begin(), end = specs.end(); i != end; ++i) {
+    token_map->add_host(i->create());
+  }
+  add_ring_keyspaces(token_map.get());
+  token_map->build();
+  return token_map;
+}
+
+void verify_ring(const TokenMap::Ptr& token_map, const HostSpecVec& specs) {
+  TokenMap::Ptr expected(build_ring(specs));
+  EXPECT_EQ(expected->dump("simple"), token_map->dump("simple"));
+  EXPECT_EQ(expected->dump("nts"), token_map->dump("nts"));
+}
+
+} // namespace
+
+TEST(TokenMapUnitTest, IncrementalHostUpdates) {
+  MT19937_64 rng;
+  HostSpecVec specs(create_ring(rng, 24, 3, 2, 16));
+
+  TokenMap::Ptr token_map(TokenMap::from_partitioner(Murmur3Partitioner::name()));
+  Vector<Host::Ptr> hosts;
+  for (HostSpecVec::const_iterator i = specs.begin(), end = specs.end(); i != end; ++i) {
+    hosts.push_back(i->create());
+    token_map->add_host(hosts.back());
+  }
+  add_ring_keyspaces(token_map.get());
+  token_map->build();
+  verify_ring(token_map, specs);
+
+  // Remove a host
+  token_map->remove_host_and_build(hosts[5]);
+  specs.erase(specs.begin() + 5);
+  hosts.erase(hosts.begin() + 5);
+  verify_ring(token_map, specs);
+
+  // Add a new host
+  specs.push_back(HostSpec("127.0.1.1", random_murmur3_tokens(rng, 16), "rack1", "dc2"));
+  hosts.push_back(specs.back().create());
+  token_map->update_host_and_build(hosts.back());
+  verify_ring(token_map, specs);
+
+  // Update an existing host with the same tokens
+  token_map->update_host_and_build(hosts[0]);
+  verify_ring(token_map, specs);
+
+  // Remove the only host in a rack which changes the rack count
+  specs.push_back(HostSpec("127.0.1.2", random_murmur3_tokens(rng, 16), "rack3", "dc1"));
+  hosts.push_back(specs.back().create());
+  token_map->update_host_and_build(hosts.back());
+  verify_ring(token_map, specs);
+  token_map->remove_host_and_build(hosts.back());
+  specs.pop_back();
+  hosts.pop_back();
+  verify_ring(token_map, specs);
+}
+
+// Compares rebuilding all of the replicas with incrementally updating them
+// when a host is removed and added back on a 1000 node ring. This is disabled
+// by default and can be run using:
+//   cassandra-unit-tests --gtest_also_run_disabled_tests \
+//     --gtest_filter='TokenMapUnitTest.DISABLED_IncrementalHostUpdatesBenchmark'
+TEST(TokenMapUnitTest, DISABLED_IncrementalHostUpdatesBenchmark) {
+  const size_t num_hosts = 1000;
+  const size_t num_updates = 10;
+
+  MT19937_64 rng;
+  HostSpecVec specs(create_ring(rng, num_hosts, 3, 3, 16));
+
+  TokenMap::Ptr token_map(TokenMap::from_partitioner(Murmur3Partitioner::name()));
+  Vector<Host::Ptr> hosts;
+  for (HostSpecVec::const_iterator i = specs.begin(), end = specs.end(); i != end; ++i) {
+    hosts.push_back(i->create());
+    token_map->add_host(hosts.back());
+  }
+  add_ring_keyspaces(token_map.get());
+  token_map->build();
+
+  uint64_t full = 0;
+  uint64_t incremental = 0;
+  for (size_t i = 0; i < num_updates; ++i) {
+    const Host::Ptr& host = hosts[(i * 97) % num_hosts];
+
+    uint64_t start = uv_hrtime();
+    token_map->remove_host_and_build(host);
+    token_map->update_host_and_build(host);
+    incremental += uv_hrtime() - start;
+
+    start = uv_hrtime();
+    token_map->build();
+    full += uv_hrtime() - start;
+  }
+
+  printf("Full: %.2f ms/update, incremental: %.2f ms/update\n",
+         static_cast<double>(full) / (num_updates * 1000 * 1000),
+         static_cast<double>(incremental) / (2 * num_updates * 1000 * 1000));
+  verify_ring(token_map, specs);
+}
+
+TEST(TokenMapUnitTest, TokenSearchIndex) {
+  MT19937_64 rng;
+
+  for (size_t size = 0; size < 64; ++size) {
+    Vector<std::pair<int64_t, int> > sorted;
+    for (size_t i = 0; i < size; ++i) {
+      sorted.push_back(std::pair<int64_t, int>(static_cast<int64_t>(rng() >> 48), 0));
+    }
+    std::sort(sorted.begin(), sorted.end());
+
+    TokenSearchIndex<int64_t> index;
+    index.build(sorted);
+    ASSERT_EQ(size, index.size());
+
+    Vector<int64_t> probes;
+    probes.push_back(CASS_INT64_MIN);
+    probes.push_back(CASS_INT64_MAX);
+    for (size_t i = 0; i < sorted.size(); ++i) {
+      probes.push_back(sorted[i].first); // Exact matches
+      probes.push_back(sorted[i].first - 1);
+      probes.push_back(sorted[i].first + 1);
+    }
+
+    for (Vector<int64_t>::const_iterator i = probes.begin(), end = probes.end(); i != end; ++i) {
+      size_t expected =
+          std::upper_bound(sorted.begin(), sorted.end(), std::pair<int64_t, int>(*i, INT_MAX)) -
+          sorted.begin();
+      ASSERT_EQ(expected, index.upper_bound(*i)) << "size " << size << ", token " << *i;
+    }
+  }
+}
+
+TEST(TokenMapUnitTest, SearchIndexLookup) {
+  TestTokenMap<Murmur3Partitioner> test_murmur3;
+
+  MT19937_64 rng;
+  test_murmur3.add_host(create_host("1.0.0.1", random_murmur3_tokens(rng, 64)));
+  test_murmur3.add_host(create_host("1.0.0.2", random_murmur3_tokens(rng, 64)));
+  test_murmur3.add_host(create_host("1.0.0.3", random_murmur3_tokens(rng, 64)));
+  test_murmur3.build("ks", 2);
+
+  const TokenMapImpl<Murmur3Partitioner>::TokenReplicasVec& replicas =
+      static_cast<TokenMapImpl<Murmur3Partitioner>*>(test_murmur3.token_map.get())
+          ->token_replicas("ks");
+
+  // Compare against searching the replicas directly
+  for (int i = 0; i < 1000; ++i) {
+    OStringStream ss;
+    ss << "key" << i;
+    String key(ss.str());
+    int64_t token = Murmur3Partitioner::hash(key);
+    TokenMapImpl<Murmur3Partitioner>::TokenReplicasVec::const_iterator it = replicas.begin();
+    while (it != replicas.end() && it->first <= token) {
+      ++it;
+    }
+    if (it == replicas.end()) it = replicas.begin();
+
+    const CopyOnWriteHostVec& hosts = test_murmur3.token_map->get_replicas("ks", key);
+    ASSERT_TRUE(hosts);
+    EXPECT_EQ(it->second.operator->(), hosts.operator->());
+  }
+}
+
+TEST(TokenMapUnitTest, GetReplicasBatch) {
+  TestTokenMap<Murmur3Partitioner> test_murmur3;
+
+  MT19937_64 rng;
+  test_murmur3.add_host(create_host("1.0.0.1", random_murmur3_tokens(rng, 16)));
+  test_murmur3.add_host(create_host("1.0.0.2", random_murmur3_tokens(rng, 16)));
+  test_murmur3.add_host(create_host("1.0.0.3", random_murmur3_tokens(rng, 16)));
+  test_murmur3.build("ks", 2);
+
+  Vector<String> keys;
+  for (int i = 0; i < 11; ++i) {
+    OStringStream ss;
+    ss << "key" << i;
+    keys.push_back(ss.str());
+  }
+
+  Vector<CopyOnWriteHostVec> replicas;
+  test_murmur3.token_map->get_replicas("ks", keys, replicas);
+  ASSERT_EQ(keys.size(), replicas.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    const CopyOnWriteHostVec& expected = test_murmur3.token_map->get_replicas("ks", keys[i]);
+    const CopyOnWriteHostVec& actual = replicas[i];
+    EXPECT_EQ(expected.operator->(), actual.operator->());
+  }
+
+  test_murmur3.token_map->get_replicas("invalid", keys, replicas);
+  ASSERT_EQ(keys.size(), replicas.size());
+  EXPECT_FALSE(replicas[0]);
+}
+
+TEST(TokenMapUnitTest, TokenRanges) {
+  TestTokenMap<Murmur3Partitioner> test_murmur3;
+
+  test_murmur3.add_host(create_host("1.0.0.1", single_token(-100)));
+  test_murmur3.add_host(create_host("1.0.0.2", single_token(0)));
+  test_murmur3.add_host(create_host("1.0.0.3", single_token(100)));
+  test_murmur3.build("ks", 2);
+
+  TokenRangeVec ranges;
+  test_murmur3.token_map->get_token_ranges("ks", ranges);
+  ASSERT_EQ(4u, ranges.size());
+
+  // The range wrapping around the ring is split into the first and last ranges
+  const char* expected[][2] = { { "", "-100" }, { "-100", "0" }, { "0", "100" }, { "100", "" } };
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    EXPECT_EQ(expected[i][0], ranges[i].start);
+    EXPECT_EQ(expected[i][1], ranges[i].end);
+
+    // The replicas of a range are the replicas of any token in the range
+    const CopyOnWriteHostVec& replicas = ranges[i].replicas;
+    const TokenMapImpl<Murmur3Partitioner>::TokenReplicasVec& token_replicas =
+        static_cast<TokenMapImpl<Murmur3Partitioner>*>(test_murmur3.token_map.get())
+            ->token_replicas("ks");
+    const CopyOnWriteHostVec& owner = token_replicas[i % token_replicas.size()].second;
+    EXPECT_EQ(owner.operator->(), replicas.operator->());
+  }
+
+  test_murmur3.token_map->get_token_ranges("invalid", ranges);
+  EXPECT_TRUE(ranges.empty());
+}
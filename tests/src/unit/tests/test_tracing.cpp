@@ -160,3 +160,128 @@ TEST_F(TracingUnitTest, QueryError) {
 
   EXPECT_GT(logging_criteria_count(), 0);
 }
+
+TEST_F(TracingUnitTest, WaitForDataInBackground) {
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(mockssandra::OPCODE_QUERY)
+      .system_local()
+      .system_peers()
+      .system_traces()
+      .empty_rows_result(1);
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.set_tracing_wait_for_data(false);
+  connect(config);
+
+  Statement::Ptr request(new QueryRequest("blah", 0));
+  request->set_tracing(true);
+
+  ResponseFuture::Ptr future(session.execute(Request::ConstPtr(request)));
+  ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME));
+
+  ASSERT_TRUE(future->response());
+  EXPECT_TRUE(future->response()->has_tracing_id());
+
+  Future::Ptr tracing_data_future(future->tracing_data_future());
+  ASSERT_TRUE(tracing_data_future);
+  ASSERT_TRUE(tracing_data_future->wait_for(WAIT_FOR_TIME));
+  EXPECT_FALSE(tracing_data_future->error());
+}
+
+TEST_F(TracingUnitTest, WaitForDataInBackgroundNotAvailable) {
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(mockssandra::OPCODE_QUERY)
+      .system_local()
+      .system_peers()
+      .is_query(SELECT_TRACES_SESSION)
+      .then(mockssandra::Action::Builder().empty_rows_result(0)) // Send back an empty row result
+      .empty_rows_result(1);
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.set_tracing_wait_for_data(false);
+  connect(config);
+
+  Statement::Ptr request(new QueryRequest("blah", 0));
+  request->set_tracing(true);
+
+  ResponseFuture::Ptr future(session.execute(Request::ConstPtr(request)));
+  ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME));
+  ASSERT_TRUE(future->response());
+  EXPECT_FALSE(future->error());
+
+  Future::Ptr tracing_data_future(future->tracing_data_future());
+  ASSERT_TRUE(tracing_data_future);
+  ASSERT_TRUE(tracing_data_future->wait_for(WAIT_FOR_TIME));
+  ASSERT_TRUE(tracing_data_future->error());
+  EXPECT_EQ(CASS_ERROR_LIB_REQUEST_TIMED_OUT, tracing_data_future->error()->code);
+}
+
+TEST_F(TracingUnitTest, TracingDataFutureAlreadySet) {
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(mockssandra::OPCODE_QUERY)
+      .system_local()
+      .system_peers()
+      .system_traces()
+      .empty_rows_result(1);
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  connect();
+
+  { // Waited for before the response was set
+    Statement::Ptr request(new QueryRequest("blah", 0));
+    request->set_tracing(true);
+
+    ResponseFuture::Ptr future(session.execute(Request::ConstPtr(request)));
+    Future::Ptr tracing_data_future(future->tracing_data_future());
+    ASSERT_TRUE(tracing_data_future);
+    EXPECT_TRUE(tracing_data_future->ready());
+    EXPECT_FALSE(tracing_data_future->error());
+  }
+
+  { // Not traced
+    Statement::Ptr request(new QueryRequest("blah", 0));
+
+    ResponseFuture::Ptr future(session.execute(Request::ConstPtr(request)));
+    EXPECT_FALSE(future->tracing_data_future());
+  }
+}
+
+TEST_F(TracingUnitTest, Sampled) {
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(mockssandra::OPCODE_QUERY)
+      .system_local()
+      .system_peers()
+      .system_traces()
+      .empty_rows_result(1);
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.set_tracing_probability(1.0);
+  ExecutionProfile never;
+  never.set_tracing_probability(0.0);
+  config.set_execution_profile("never", &never);
+  connect(config);
+
+  { // The cluster's probability
+    Statement::Ptr request(new QueryRequest("blah", 0));
+
+    ResponseFuture::Ptr future(session.execute(Request::ConstPtr(request)));
+    ASSERT_TRUE(future->response());
+    EXPECT_TRUE(future->response()->has_tracing_id());
+  }
+
+  { // The profile's probability
+    Statement::Ptr request(new QueryRequest("blah", 0));
+    request->set_execution_profile_name("never");
+
+    ResponseFuture::Ptr future(session.execute(Request::ConstPtr(request)));
+    ASSERT_TRUE(future->response());
+    EXPECT_FALSE(future->response()->has_tracing_id());
+  }
+}
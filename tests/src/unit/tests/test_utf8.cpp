@@ -0,0 +1,67 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "string.hpp"
+#include "utf8.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+
+namespace {
+
+bool is_valid(const String& str) { return is_valid_utf8(str.data(), str.size()); }
+
+} // namespace
+
+TEST(Utf8UnitTest, Ascii) {
+  String str("The quick brown fox jumps over the lazy dog");
+  EXPECT_TRUE(is_ascii(str.data(), str.size()));
+  EXPECT_TRUE(is_valid(str));
+  EXPECT_TRUE(is_ascii("", 0));
+  EXPECT_TRUE(is_valid(""));
+
+  // A non-ASCII byte at every position is found by the wide and narrow paths
+  for (size_t i = 0; i < str.size(); ++i) {
+    String temp(str);
+    temp[i] = static_cast<char>(0xC3);
+    EXPECT_FALSE(is_ascii(temp.data(), temp.size())) << "Position " << i;
+  }
+}
+
+TEST(Utf8UnitTest, Valid) {
+  EXPECT_TRUE(is_valid("caf\xC3\xA9"));                            // 2 bytes
+  EXPECT_TRUE(is_valid("\xE2\x82\xAC 100"));                       // 3 bytes
+  EXPECT_TRUE(is_valid("\xF0\x9F\x98\x80"));                       // 4 bytes
+  EXPECT_TRUE(is_valid("\xED\x9F\xBF"));                           // U+D7FF
+  EXPECT_TRUE(is_valid("\xF4\x8F\xBF\xBF"));                       // U+10FFFF
+  EXPECT_TRUE(is_valid("0123456789abcdef0123456789abcdef\xC3\xA9")); // After a wide run
+}
+
+TEST(Utf8UnitTest, Invalid) {
+  EXPECT_FALSE(is_valid("\x80"));                 // Lone continuation byte
+  EXPECT_FALSE(is_valid("\xC3"));                 // Truncated
+  EXPECT_FALSE(is_valid("\xE2\x82"));             // Truncated
+  EXPECT_FALSE(is_valid("\xC0\xAF"));             // Overlong
+  EXPECT_FALSE(is_valid("\xE0\x80\xAF"));         // Overlong
+  EXPECT_FALSE(is_valid("\xF0\x80\x80\xAF"));     // Overlong
+  EXPECT_FALSE(is_valid("\xED\xA0\x80"));         // Surrogate
+  EXPECT_FALSE(is_valid("\xF4\x90\x80\x80"));     // Above U+10FFFF
+  EXPECT_FALSE(is_valid("\xF5\x80\x80\x80"));     // Invalid lead byte
+  EXPECT_FALSE(is_valid("abc\xC3\x28"));          // Bad continuation byte
+  EXPECT_FALSE(is_valid("0123456789abcdef\xFF")); // After a wide run
+}
@@ -19,10 +19,12 @@
 #include "cassandra.h"
 #include "get_time.hpp"
 #include "scoped_ptr.hpp"
+#include "vector.hpp"
 
 #include <algorithm>
 #include <ctype.h>
 #include <string.h>
+#include <uv.h>
 
 using namespace datastax;
 using namespace datastax::internal;
@@ -110,6 +112,80 @@ TEST(UuidUnitTest, V1Node) {
   cass_uuid_gen_free(uuid_gen);
 }
 
+namespace {
+
+struct GenerateTimeArgs {
+  CassUuidGen* uuid_gen;
+  Vector<CassUuid> uuids;
+};
+
+void generate_time(void* arg) {
+  GenerateTimeArgs* args = static_cast<GenerateTimeArgs*>(arg);
+  for (size_t i = 0; i < args->uuids.size(); ++i) {
+    cass_uuid_gen_time(args->uuid_gen, &args->uuids[i]);
+  }
+}
+
+bool uuid_less(const CassUuid& u1, const CassUuid& u2) {
+  return u1.time_and_version < u2.time_and_version;
+}
+
+} // namespace
+
+TEST(UuidUnitTest, V1PerThread) {
+  CassUuidGen* uuid_gen = cass_uuid_gen_new_per_thread_with_node(0x0000112233445566LL, 16);
+
+  CassUuid prev_uuid;
+  cass_uuid_gen_time(uuid_gen, &prev_uuid);
+  EXPECT_EQ(cass_uuid_version(prev_uuid), 1);
+
+  for (int i = 0; i < 1000; ++i) {
+    CassUuid uuid;
+    uint64_t curr_ts = get_time_since_epoch_ms();
+    cass_uuid_gen_time(uuid_gen, &uuid);
+    cass_uint64_t ts = cass_uuid_timestamp(uuid);
+
+    EXPECT_EQ(cass_uuid_version(uuid), 1);
+    EXPECT_TRUE(ts == curr_ts || ts - 1 == curr_ts);
+    EXPECT_GT(uuid.time_and_version, prev_uuid.time_and_version);
+    prev_uuid = uuid;
+  }
+
+  cass_uuid_gen_free(uuid_gen);
+}
+
+TEST(UuidUnitTest, V1PerThreadUnique) {
+  const size_t num_threads = 4;
+  const size_t num_uuids = 10000;
+
+  CassUuidGen* uuid_gen = cass_uuid_gen_new_per_thread(0);
+
+  uv_thread_t threads[num_threads];
+  GenerateTimeArgs args[num_threads];
+  for (size_t i = 0; i < num_threads; ++i) {
+    args[i].uuid_gen = uuid_gen;
+    args[i].uuids.resize(num_uuids);
+    ASSERT_EQ(0, uv_thread_create(&threads[i], generate_time, &args[i]));
+  }
+
+  Vector<CassUuid> all;
+  for (size_t i = 0; i < num_threads; ++i) {
+    uv_thread_join(&threads[i]);
+    const Vector<CassUuid>& uuids = args[i].uuids;
+    for (size_t j = 1; j < uuids.size(); ++j) { // Monotonic per thread
+      EXPECT_GT(uuids[j].time_and_version, uuids[j - 1].time_and_version);
+    }
+    all.insert(all.end(), uuids.begin(), uuids.end());
+  }
+
+  std::sort(all.begin(), all.end(), uuid_less);
+  for (size_t i = 1; i < all.size(); ++i) {
+    EXPECT_NE(all[i], all[i - 1]);
+  }
+
+  cass_uuid_gen_free(uuid_gen);
+}
+
 TEST(UuidUnitTest, V4) {
   CassUuidGen* uuid_gen = cass_uuid_gen_new();
 
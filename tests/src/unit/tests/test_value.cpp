@@ -212,3 +212,100 @@ TEST(ValueUnitTest, NullElementInCollectionSet) {
   EXPECT_EQ(cass_true, cass_value_is_null(element));
   cass_iterator_free(it);
 }
+
+TEST(ValueUnitTest, CollectionItems) {
+  const signed char input[24] = {
+    0, 0, 0, 8, 0,  0,  0,  0,  0,  0,  0,  1, // Element 1 is 1
+    0, 0, 0, 8, -1, -1, -1, -1, -1, -1, -1, -2 // Element 2 is -2
+  };
+  Decoder decoder((const char*)input, 24);
+  DataType::ConstPtr element_data_type(new DataType(CASS_VALUE_TYPE_BIGINT));
+  CollectionType::ConstPtr data_type = CollectionType::list(element_data_type, false);
+  Value value(data_type, 2, decoder);
+
+  cass_int64_t items[2];
+  size_t item_count = 0;
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS,
+            cass_value_get_int64_items(CassValue::to(&value), items, 1, &item_count));
+  EXPECT_EQ(2u, item_count);
+  ASSERT_EQ(CASS_OK, cass_value_get_int64_items(CassValue::to(&value), items, 2, &item_count));
+  EXPECT_EQ(1, items[0]);
+  EXPECT_EQ(-2, items[1]);
+
+  cass_int32_t int32_items[2];
+  EXPECT_EQ(CASS_ERROR_LIB_INVALID_VALUE_TYPE,
+            cass_value_get_int32_items(CassValue::to(&value), int32_items, 2, NULL));
+  EXPECT_EQ(CASS_ERROR_LIB_INVALID_VALUE_TYPE,
+            cass_value_get_int64_items(s_text_value, items, 2, NULL));
+}
+
+TEST(ValueUnitTest, MapValueItems) {
+  const signed char input[23] = {
+    0, 0, 0, 1, 'a', 0, 0, 0, 4, 0, 0, 0, 1, // "a": 1
+    0, 0, 0, 0, 0,   0, 0, 4, 0, 0           // "": Truncated value
+  };
+  DataType::ConstPtr key_data_type(new DataType(CASS_VALUE_TYPE_TEXT));
+  DataType::ConstPtr value_data_type(new DataType(CASS_VALUE_TYPE_INT));
+  CollectionType::ConstPtr data_type = CollectionType::map(key_data_type, value_data_type, false);
+
+  cass_int32_t items[2];
+  Value value(data_type, 1, Decoder((const char*)input, 13));
+  ASSERT_EQ(CASS_OK, cass_value_get_int32_items(CassValue::to(&value), items, 2, NULL));
+  EXPECT_EQ(1, items[0]);
+
+  Value truncated(data_type, 2, Decoder((const char*)input, 23));
+  EXPECT_EQ(CASS_ERROR_LIB_NOT_ENOUGH_DATA,
+            cass_value_get_int32_items(CassValue::to(&truncated), items, 2, NULL));
+}
+
+TEST(ValueUnitTest, NullElementInCollectionItems) {
+  const signed char input[12] = {
+    0,  0,  0,  4,  0, 0, 0, 2, // Size (int32_t) and contents of element 1
+    -1, -1, -1, -1,             // Element 2 is NULL
+  };
+  DataType::ConstPtr element_data_type(new DataType(CASS_VALUE_TYPE_INT));
+  CollectionType::ConstPtr data_type = CollectionType::set(element_data_type, false);
+  Value value(data_type, 2, Decoder((const char*)input, 12));
+
+  cass_int32_t items[2];
+  EXPECT_EQ(CASS_ERROR_LIB_NULL_VALUE,
+            cass_value_get_int32_items(CassValue::to(&value), items, 2, NULL));
+
+  const cass_byte_t* refs[2];
+  cass_int32_t ref_sizes[2];
+  size_t item_count = 0;
+  ASSERT_EQ(CASS_OK,
+            cass_value_get_item_refs(CassValue::to(&value), refs, ref_sizes, 2, &item_count));
+  EXPECT_EQ(2u, item_count);
+  EXPECT_EQ(reinterpret_cast<const cass_byte_t*>(input + 4), refs[0]);
+  EXPECT_EQ(4, ref_sizes[0]);
+  EXPECT_TRUE(refs[1] == NULL);
+  EXPECT_EQ(-1, ref_sizes[1]);
+}
+
+TEST(ValueUnitTest, MapItemRefs) {
+  const signed char input[17] = {
+    0, 0, 0, 1, 'a', 0, 0, 0, 4, 0, 0, 0, 1, // "a": 1
+    -1, -1, -1, -1                           // Truncated
+  };
+  DataType::ConstPtr key_data_type(new DataType(CASS_VALUE_TYPE_TEXT));
+  DataType::ConstPtr value_data_type(new DataType(CASS_VALUE_TYPE_INT));
+  CollectionType::ConstPtr data_type = CollectionType::map(key_data_type, value_data_type, false);
+  Value value(data_type, 1, Decoder((const char*)input, 13));
+
+  const cass_byte_t* refs[4];
+  cass_int32_t ref_sizes[4];
+  size_t item_count = 0;
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS,
+            cass_value_get_item_refs(CassValue::to(&value), refs, ref_sizes, 1, &item_count));
+  EXPECT_EQ(2u, item_count); // A key and a value
+  ASSERT_EQ(CASS_OK,
+            cass_value_get_item_refs(CassValue::to(&value), refs, ref_sizes, 4, &item_count));
+  EXPECT_EQ("a", String(reinterpret_cast<const char*>(refs[0]), ref_sizes[0]));
+  EXPECT_EQ(reinterpret_cast<const cass_byte_t*>(input + 9), refs[1]);
+  EXPECT_EQ(4, ref_sizes[1]);
+
+  Value truncated(data_type, 2, Decoder((const char*)input, 17));
+  EXPECT_EQ(CASS_ERROR_LIB_NOT_ENOUGH_DATA,
+            cass_value_get_item_refs(CassValue::to(&truncated), refs, ref_sizes, 4, NULL));
+}